@@ -0,0 +1,178 @@
+#include <inttypes.h>
+
+#include "logger.h"
+#include "exec.h"
+#include "asynccmdexecutor.h"
+
+using namespace std;
+using namespace swss;
+
+AsyncCmdExecutor::AsyncCmdExecutor(Orch *orch, const string &name, size_t threads)
+    : Executor(new SelectableEvent(), orch, name)
+{
+    m_doneEvent = static_cast<SelectableEvent *>(getSelectable());
+
+    for (size_t i = 0; i < max(threads, (size_t)1); i++)
+    {
+        m_threads.emplace_back(&AsyncCmdExecutor::run, this);
+    }
+}
+
+AsyncCmdExecutor::~AsyncCmdExecutor()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cmdCv.notify_all();
+
+    for (auto &thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void AsyncCmdExecutor::submit(const string &key, const string &cmd, Callback callback)
+{
+    SWSS_LOG_INFO("Queue command '%s' for %s", cmd.c_str(), key.c_str());
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_commands.push_back({key, cmd, callback});
+        m_pending++;
+    }
+    m_cmdCv.notify_one();
+}
+
+bool AsyncCmdExecutor::popRunnable(Command &command)
+{
+    for (auto it = m_commands.begin(); it != m_commands.end(); it++)
+    {
+        if (m_runningKeys.find(it->key) == m_runningKeys.end())
+        {
+            command = move(*it);
+            m_commands.erase(it);
+            m_runningKeys.insert(command.key);
+            return true;
+        }
+    }
+    return false;
+}
+
+void AsyncCmdExecutor::run()
+{
+    while (true)
+    {
+        Command command;
+
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_cmdCv.wait(lock, [&] { return m_stop || popRunnable(command); });
+            if (m_stop)
+            {
+                return;
+            }
+        }
+
+        string output;
+        auto start = chrono::steady_clock::now();
+        int ret = swss::exec(command.cmd, output);
+        uint64_t usecs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+        if (usecs >= SLOW_CMD_MSECONDS * 1000)
+        {
+            SWSS_LOG_NOTICE("Command '%s' took %" PRIu64 " ms", command.cmd.c_str(), usecs / 1000);
+        }
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+
+            auto &stats = m_stats[command.cmd.substr(0, command.cmd.find(' '))];
+            stats.count++;
+            stats.failures += ret ? 1 : 0;
+            stats.totalUsecs += usecs;
+            stats.maxUsecs = max(stats.maxUsecs, usecs);
+
+            m_runningKeys.erase(command.key);
+            m_completions.push_back({move(command.callback), ret, move(output)});
+        }
+
+        /* The next command of this key may be runnable now */
+        m_cmdCv.notify_all();
+        m_doneCv.notify_all();
+        m_doneEvent->notify();
+    }
+}
+
+void AsyncCmdExecutor::runCompletions()
+{
+    deque<Completion> completions;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        completions.swap(m_completions);
+    }
+
+    for (auto &completion : completions)
+    {
+        if (completion.callback)
+        {
+            completion.callback(completion.ret, completion.output);
+        }
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_pending -= completions.size();
+    }
+    m_doneCv.notify_all();
+}
+
+void AsyncCmdExecutor::execute()
+{
+    runCompletions();
+}
+
+void AsyncCmdExecutor::drain()
+{
+    runCompletions();
+}
+
+void AsyncCmdExecutor::wait()
+{
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_doneCv.wait(lock, [&] { return !m_completions.empty() || m_pending == 0; });
+            if (m_pending == 0)
+            {
+                return;
+            }
+        }
+        runCompletions();
+    }
+}
+
+size_t AsyncCmdExecutor::getPending()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_pending;
+}
+
+map<string, AsyncCmdExecutor::CmdStats> AsyncCmdExecutor::getStats()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void AsyncCmdExecutor::dumpStats()
+{
+    for (const auto &it : getStats())
+    {
+        const auto &stats = it.second;
+        SWSS_LOG_NOTICE("%s: %s ran %" PRIu64 " times, %" PRIu64 " failed, avg %" PRIu64 " us, max %" PRIu64 " us",
+                        getName().c_str(), it.first.c_str(), stats.count, stats.failures,
+                        stats.count ? stats.totalUsecs / stats.count : 0, stats.maxUsecs);
+    }
+}
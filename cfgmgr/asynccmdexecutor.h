@@ -0,0 +1,108 @@
+#ifndef __ASYNCCMDEXECUTOR__
+#define __ASYNCCMDEXECUTOR__
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "selectableevent.h"
+#include "orch.h"
+
+namespace swss {
+
+/*
+ * Runs the shell commands of a cfgmgr daemon on a small pool of threads, so
+ * a slow command does not block the select loop and the other tables.
+ *
+ * Commands submitted with the same key run one after another in submission
+ * order, commands of different keys run concurrently, at most one per
+ * thread. The executor is added to the Orch as an Executor; when commands
+ * complete, the select loop wakes up and execute() runs their callbacks on
+ * the main thread, in completion order.
+ *
+ * Commands still queued when the executor is destroyed are dropped, call
+ * wait() first to run them.
+ *
+ * The latency of every command is accounted per program (the first word of
+ * the command), commands slower than SLOW_CMD_MSECONDS are logged.
+ */
+class AsyncCmdExecutor : public Executor
+{
+public:
+    static constexpr size_t DEFAULT_THREADS = 4;
+    static constexpr uint64_t SLOW_CMD_MSECONDS = 1000;
+
+    /* Called on the main thread with the swss::exec return code and output */
+    using Callback = std::function<void(int ret, const std::string &output)>;
+
+    struct CmdStats
+    {
+        uint64_t count = 0;
+        uint64_t failures = 0;
+        uint64_t totalUsecs = 0;
+        uint64_t maxUsecs = 0;
+    };
+
+    AsyncCmdExecutor(Orch *orch, const std::string &name, size_t threads = DEFAULT_THREADS);
+    ~AsyncCmdExecutor() override;
+
+    void submit(const std::string &key, const std::string &cmd, Callback callback = nullptr);
+
+    /* Run the callbacks of the completed commands, never waits */
+    void execute() override;
+    void drain() override;
+
+    /* Wait for all the submitted commands and run their callbacks */
+    void wait();
+
+    /* Commands submitted and not completed yet */
+    size_t getPending();
+    std::map<std::string, CmdStats> getStats();
+    void dumpStats();
+
+private:
+    struct Command
+    {
+        std::string key;
+        std::string cmd;
+        Callback callback;
+    };
+
+    struct Completion
+    {
+        Callback callback;
+        int ret;
+        std::string output;
+    };
+
+    void run();
+    /* Pop the first command whose key has no command running, with m_mutex held */
+    bool popRunnable(Command &command);
+    void runCompletions();
+
+    // Wakes the main thread up, owned by the Executor as its selectable
+    SelectableEvent *m_doneEvent;
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_cmdCv;
+    std::condition_variable m_doneCv;
+    std::deque<Command> m_commands;
+    std::set<std::string> m_runningKeys;
+    std::deque<Completion> m_completions;
+    std::map<std::string, CmdStats> m_stats;
+    size_t m_pending = 0;
+    bool m_stop = false;
+};
+
+}
+
+#endif /* __ASYNCCMDEXECUTOR__ */
@@ -181,8 +181,10 @@ int main(int argc, char **argv)
                 TableConnector(&cfgDb, CFG_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME),
                 TableConnector(&cfgDb, CFG_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME),
                 TableConnector(&cfgDb, CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER),
+                TableConnector(&cfgDb, CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME),
                 TableConnector(&stateDb, STATE_BUFFER_MAXIMUM_VALUE_TABLE),
-                TableConnector(&stateDb, STATE_PORT_TABLE_NAME)
+                TableConnector(&stateDb, STATE_PORT_TABLE_NAME),
+                TableConnector(&stateDb, STATE_BUFFER_ASIC_TABLE_NAME)
             };
             cfgOrchList.emplace_back(new BufferMgrDynamic(&cfgDb, &stateDb, &applDb, &applStateDb, buffer_table_connectors, peripherial_table_ptr, zero_profiles_ptr));
         }
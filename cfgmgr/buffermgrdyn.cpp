@@ -1,3 +1,4 @@
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <string.h>
@@ -50,12 +51,18 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
         m_stateBufferPoolTable(stateDb, STATE_BUFFER_POOL_TABLE_NAME),
         m_stateBufferProfileTable(stateDb, STATE_BUFFER_PROFILE_TABLE_NAME),
         m_applPortTable(applDb, APP_PORT_TABLE_NAME),
+        m_stateAsicTable(stateDb, STATE_BUFFER_ASIC_TABLE_NAME),
+        m_cfgLosslessTrafficPatternTable(cfgDb, CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME),
         m_portInitDone(false),
         m_bufferPoolReady(false),
         m_bufferObjectsPending(true),
         m_bufferCompletelyInitialized(false),
         m_bufferProfileApplDbWritten(false),
-        m_mmuSizeNumber(0)
+        m_mmuSizeNumber(0),
+        m_nativeHeadroomSupported(false),
+        m_headroomParamLoaded(false),
+        m_deferPoolSizeCheck(false),
+        m_poolSizeCheckPending(false)
 {
     SWSS_LOG_ENTER();
 
@@ -80,6 +87,8 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
     m_platform = platform;
     m_specific_platform = platform;     // default for non-Mellanox
     m_model_number = 0;
+    // The lua plugins of these vendors calculate the headroom by the same formula
+    m_nativeHeadroomSupported = (m_platform == "mellanox" || m_platform == "vs");
 
     // Retrieve the type of mellanox platform
     if (m_platform == "mellanox")
@@ -449,6 +458,8 @@ void BufferMgrDynamic::initTableHandlerMap()
     m_bufferTableHandlerMap.insert(buffer_handler_pair(CFG_PORT_TABLE_NAME, &BufferMgrDynamic::handlePortTable));
     m_bufferTableHandlerMap.insert(buffer_handler_pair(CFG_PORT_CABLE_LEN_TABLE_NAME, &BufferMgrDynamic::handleCableLenTable));
     m_bufferTableHandlerMap.insert(buffer_handler_pair(STATE_PORT_TABLE_NAME, &BufferMgrDynamic::handlePortStateTable));
+    m_bufferTableHandlerMap.insert(buffer_handler_pair(STATE_BUFFER_ASIC_TABLE_NAME, &BufferMgrDynamic::handleHeadroomParameterTable));
+    m_bufferTableHandlerMap.insert(buffer_handler_pair(CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME, &BufferMgrDynamic::handleHeadroomParameterTable));
 
     m_bufferSingleItemHandlerMap.insert(buffer_single_item_handler_pair(CFG_BUFFER_QUEUE_TABLE_NAME, &BufferMgrDynamic::handleSingleBufferQueueEntry));
     m_bufferSingleItemHandlerMap.insert(buffer_single_item_handler_pair(CFG_BUFFER_PG_TABLE_NAME, &BufferMgrDynamic::handleSingleBufferPgEntry));
@@ -600,7 +611,7 @@ bool BufferMgrDynamic::needRefreshPortDueToEffectiveSpeed(port_info_t &portInfo,
 }
 
 // Meta flows which are called by main flows
-void BufferMgrDynamic::calculateHeadroomSize(buffer_profile_t &headroom)
+bool BufferMgrDynamic::calculateHeadroomSizeByLua(const buffer_profile_t &headroom, headroom_result_t &result)
 {
     // Call vendor-specific lua plugin to calculate the xon, xoff, xon_offset, size and threshold
     vector<string> keys = {};
@@ -620,7 +631,7 @@ void BufferMgrDynamic::calculateHeadroomSize(buffer_profile_t &headroom)
         if (ret.empty())
         {
             SWSS_LOG_WARN("Failed to calculate headroom for %s", headroom.name.c_str());
-            return;
+            return false;
         }
 
         // The format of the result:
@@ -634,19 +645,247 @@ void BufferMgrDynamic::calculateHeadroomSize(buffer_profile_t &headroom)
         {
             auto pairs = tokenize(i, ':');
             if (pairs[0] == "xon")
-                headroom.xon = pairs[1];
+                result.xon = pairs[1];
             if (pairs[0] == "xoff")
-                headroom.xoff = pairs[1];
+                result.xoff = pairs[1];
             if (pairs[0] == "size")
-                headroom.size = pairs[1];
+                result.size = pairs[1];
             if (pairs[0] == "xon_offset")
-                headroom.xon_offset = pairs[1];
+                result.xon_offset = pairs[1];
         }
     }
     catch (...)
     {
         SWSS_LOG_WARN("Lua scripts for headroom calculation were not executed successfully");
+        return false;
+    }
+
+    return true;
+}
+
+// Fetch the vendor parameters the headroom lua plugin reads from the databases on every call
+// They are static once the system is up, so they are fetched once
+bool BufferMgrDynamic::loadHeadroomParameters()
+{
+    headroom_param_t param = {};
+    vector<string> keys;
+    vector<FieldValueTuple> fvs;
+    bool hasCellSize = false, hasPipelineLatency = false, hasMacPhyDelay = false;
+    bool hasLosslessMtu = false, hasSmallPacketPercentage = false;
+
+    try
+    {
+        // Only one key should exist
+        m_stateAsicTable.getKeys(keys);
+        if (keys.empty() || !m_stateAsicTable.get(keys[0], fvs))
+        {
+            return false;
+        }
+        param.asic = keys[0];
+        for (auto &fv : fvs)
+        {
+            if (fvField(fv) == "cell_size")
+            {
+                param.cell_size = stod(fvValue(fv));
+                hasCellSize = true;
+            }
+            else if (fvField(fv) == "pipeline_latency")
+            {
+                param.pipeline_latency = stod(fvValue(fv)) * 1024;
+                hasPipelineLatency = true;
+            }
+            else if (fvField(fv) == "mac_phy_delay")
+            {
+                param.mac_phy_delay = stod(fvValue(fv)) * 1024;
+                hasMacPhyDelay = true;
+            }
+            else if (fvField(fv) == "peer_response_time")
+            {
+                param.peer_response_time = stod(fvValue(fv)) * 1024;
+                param.has_peer_response_time = true;
+            }
+        }
+
+        keys.clear();
+        fvs.clear();
+        m_cfgLosslessTrafficPatternTable.getKeys(keys);
+        if (keys.empty() || !m_cfgLosslessTrafficPatternTable.get(keys[0], fvs))
+        {
+            return false;
+        }
+        for (auto &fv : fvs)
+        {
+            if (fvField(fv) == "mtu")
+            {
+                param.lossless_mtu = stod(fvValue(fv));
+                hasLosslessMtu = true;
+            }
+            else if (fvField(fv) == "small_packet_percentage")
+            {
+                param.small_packet_percentage = stod(fvValue(fv));
+                hasSmallPacketPercentage = true;
+            }
+        }
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_WARN("Invalid parameters for headroom calculation: %s", e.what());
+        return false;
+    }
+
+    if (!hasCellSize || !hasPipelineLatency || !hasMacPhyDelay || !hasLosslessMtu || !hasSmallPacketPercentage)
+    {
+        return false;
     }
+
+    m_headroomParam = param;
+    m_headroomParamLoaded = true;
+    SWSS_LOG_NOTICE("Headroom is calculated natively with the parameters of %s", param.asic.c_str());
+
+    return true;
+}
+
+// The memoized headroom was calculated from the vendor parameters which have changed
+// Both the native calculation and the lua plugin read them, so the cache is dropped in either case
+void BufferMgrDynamic::invalidateHeadroomCache()
+{
+    m_headroomCache.clear();
+    m_headroomParamLoaded = false;
+}
+
+// The headroom formula implemented by buffer_headroom_mellanox.lua and buffer_headroom_vs.lua,
+// operation by operation, so that the results are identical.
+bool BufferMgrDynamic::calculateHeadroomSizeNatively(const buffer_profile_t &headroom, headroom_result_t &result)
+{
+    // pause quanta should be taken for each operating speed is defined in IEEE 802.3 31B.3.7
+    static const map<string, double> pauseQuantaPerSpeed = {
+        {"800000", 905}, {"400000", 905}, {"200000", 453}, {"100000", 394}, {"50000", 147},
+        {"40000", 118}, {"25000", 80}, {"10000", 67}, {"1000", 2}, {"100", 1}
+    };
+    const double speedOfLight = 198000000;
+    const double minimalPacketSize = 64;
+    double portSpeed, cableLength, portMtu, gearboxDelay = 0;
+
+    if (!m_headroomParamLoaded && !loadHeadroomParameters())
+    {
+        return false;
+    }
+    auto &param = m_headroomParam;
+
+    try
+    {
+        portSpeed = stod(headroom.speed);
+        // The cable length is suffixed by its unit, "m"
+        cableLength = stod(headroom.cable_length.substr(0, headroom.cable_length.size() - 1));
+        portMtu = stod(headroom.port_mtu);
+    }
+    catch (const exception &)
+    {
+        return false;
+    }
+    try
+    {
+        gearboxDelay = stod(m_identifyGearboxDelay);
+    }
+    catch (const exception &)
+    {
+        // No gearbox delay
+    }
+
+    double peerResponseTime = param.peer_response_time;
+    auto pauseQuanta = pauseQuantaPerSpeed.find(headroom.speed);
+    if (pauseQuanta != pauseQuantaPerSpeed.end())
+    {
+        peerResponseTime = pauseQuanta->second * 512 / 8;
+    }
+    else if (!param.has_peer_response_time)
+    {
+        return false;
+    }
+
+    // Calculate kB on tile for Spectrum-4 and Spectrum-5
+    double kbOnTile = 0;
+    char generation = param.asic.empty() ? '\0' : param.asic.back();
+    if (generation == '4' || generation == '5')
+    {
+        kbOnTile = portSpeed / 1000 * 120 / 8;
+    }
+
+    bool shpEnabled = isNonZero(m_configuredSharedHeadroomPoolSize) || isNonZero(m_overSubscribeRatio);
+
+    // Adjustment for 8-lane port
+    double pipelineLatency = param.pipeline_latency;
+    double speedOverhead = 0;
+    if (headroom.lane_count == 8)
+    {
+        pipelineLatency = pipelineLatency * 2;
+        speedOverhead = portMtu;
+    }
+
+    double worstCaseFactor;
+    if (param.cell_size > 2 * minimalPacketSize)
+    {
+        worstCaseFactor = param.cell_size / minimalPacketSize;
+    }
+    else
+    {
+        worstCaseFactor = (2 * param.cell_size) / (1 + param.cell_size);
+    }
+    worstCaseFactor = ceil(worstCaseFactor);
+
+    double smallPacketPercentageByByte = 100 * minimalPacketSize /
+        ((param.small_packet_percentage * minimalPacketSize + (100 - param.small_packet_percentage) * param.lossless_mtu) / 100);
+    double cellOccupancy = (100 - smallPacketPercentageByByte + smallPacketPercentageByByte * worstCaseFactor) / 100;
+
+    double bytesOnGearbox = portSpeed * gearboxDelay / (8 * 1024);
+    double bytesOnCable = 2 * cableLength * portSpeed * 1000000000 / speedOfLight / (8 * 1000);
+    double propagationDelay = portMtu + bytesOnCable + 2 * bytesOnGearbox + param.mac_phy_delay + peerResponseTime + kbOnTile;
+
+    // Calculate the xoff and xon and then round up at 1024 bytes
+    double xoff = ceil((param.lossless_mtu + propagationDelay * cellOccupancy) / 1024) * 1024;
+    double xon = ceil(pipelineLatency / 1024) * 1024;
+    double size = shpEnabled ? xon : xoff + xon + speedOverhead;
+    size = ceil(size / 1024) * 1024;
+
+    result.xon = to_string(static_cast<long long>(xon));
+    result.xoff = to_string(static_cast<long long>(xoff));
+    result.size = to_string(static_cast<long long>(size));
+
+    return true;
+}
+
+// The headroom only depends on the parameters below and on whether the shared headroom pool is enabled.
+// It is memoized by them, so a profile shared by many ports or recalculated on a config reload costs
+// one calculation.
+void BufferMgrDynamic::calculateHeadroomSize(buffer_profile_t &headroom)
+{
+    bool shpEnabled = isNonZero(m_configuredSharedHeadroomPoolSize) || isNonZero(m_overSubscribeRatio);
+    string key = headroom.speed + ":" + headroom.cable_length + ":" + headroom.port_mtu + ":" +
+                 m_identifyGearboxDelay + ":" + to_string(headroom.lane_count) + (shpEnabled ? ":shp" : "");
+
+    auto cached = m_headroomCache.find(key);
+    if (cached == m_headroomCache.end())
+    {
+        headroom_result_t result;
+
+        // The lua plugin is the fallback in case the vendor parameters are not available yet
+        if (!(m_nativeHeadroomSupported && calculateHeadroomSizeNatively(headroom, result)) &&
+            !calculateHeadroomSizeByLua(headroom, result))
+        {
+            return;
+        }
+        cached = m_headroomCache.emplace(key, result).first;
+    }
+
+    auto &result = cached->second;
+    if (!result.xon.empty())
+        headroom.xon = result.xon;
+    if (!result.xoff.empty())
+        headroom.xoff = result.xoff;
+    if (!result.size.empty())
+        headroom.size = result.size;
+    if (!result.xon_offset.empty())
+        headroom.xon_offset = result.xon_offset;
 }
 
 // This function is designed to fetch the sizes of shared buffer pool and shared headroom pool
@@ -821,6 +1060,13 @@ void BufferMgrDynamic::recalculateSharedBufferPool()
 
 void BufferMgrDynamic::checkSharedBufferPoolSize(bool force_update_during_initialization = false)
 {
+    // Within a batch, the pool size is checked once, after all the entries are handled, see doTask
+    if (m_deferPoolSizeCheck && !force_update_during_initialization)
+    {
+        m_poolSizeCheckPending = true;
+        return;
+    }
+
     // PortInitDone indicates all steps of port initialization has been done
     // Only after that does the buffer pool size update starts
     if (!m_portInitDone && !force_update_during_initialization)
@@ -2031,6 +2277,22 @@ task_process_status BufferMgrDynamic::handleDefaultLossLessBufferParam(KeyOpFiel
 
     return task_process_status::task_success;
 }
+
+/*
+ * handleHeadroomParameterTable, handles STATE_DB.ASIC_TABLE and CONFIG_DB.LOSSLESS_TRAFFIC_PATTERN.
+ * Both tables hold vendor parameters of the headroom calculation.
+ * Headroom calculated with the old parameters is dropped so that new profiles are calculated with the new ones.
+ * Profiles which already exist are not updated, as it was when the lua plugin read the parameters on every call.
+ */
+task_process_status BufferMgrDynamic::handleHeadroomParameterTable(KeyOpFieldsValuesTuple &tuple)
+{
+    SWSS_LOG_INFO("Headroom parameters %s updated, dropping %zu memoized headroom results",
+                  kfvKey(tuple).c_str(), m_headroomCache.size());
+    invalidateHeadroomCache();
+
+    return task_process_status::task_success;
+}
+
 bool BufferMgrDynamic::isSharedHeadroomPoolEnabledInSai()
 {
     string xoff;
@@ -3585,6 +3847,8 @@ void BufferMgrDynamic::doTask(Consumer &consumer)
         return;
     }
 
+    m_deferPoolSizeCheck = true;
+
     while (it != consumer.m_toSync.end())
     {
         auto task_status = (this->*(m_bufferTableHandlerMap[table_name]))(it->second);
@@ -3607,6 +3871,13 @@ void BufferMgrDynamic::doTask(Consumer &consumer)
                 break;
         }
     }
+
+    m_deferPoolSizeCheck = false;
+    if (m_poolSizeCheckPending)
+    {
+        m_poolSizeCheckPending = false;
+        checkSharedBufferPoolSize();
+    }
 }
 
 /*
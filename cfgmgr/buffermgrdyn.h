@@ -16,6 +16,9 @@ namespace swss {
 
 #define BUFFERMGR_TIMER_PERIOD 10
 
+#define STATE_BUFFER_ASIC_TABLE_NAME            "ASIC_TABLE"
+#define CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME "LOSSLESS_TRAFFIC_PATTERN"
+
 typedef enum {
     BUFFER_INGRESS = 0,
     BUFFER_PG = BUFFER_INGRESS,
@@ -120,6 +123,27 @@ typedef struct {
     std::set<std::string> supported_but_not_configured_buffer_objects[BUFFER_DIR_MAX];
 } port_info_t;
 
+// Headroom calculated from a set of parameters, memoized by calculateHeadroomSize
+typedef struct {
+    std::string xon;
+    std::string xoff;
+    std::string size;
+    std::string xon_offset;
+} headroom_result_t;
+
+// Vendor parameters of the native headroom calculation
+// fetched from STATE_DB.ASIC_TABLE and CONFIG_DB.LOSSLESS_TRAFFIC_PATTERN
+typedef struct {
+    std::string asic;
+    double cell_size;
+    double pipeline_latency;
+    double mac_phy_delay;
+    bool has_peer_response_time;
+    double peer_response_time;
+    double lossless_mtu;
+    double small_packet_percentage;
+} headroom_param_t;
+
 //TODO:
 //add map to store all configured PGs
 //add map to store all configured profiles
@@ -248,6 +272,8 @@ private:
     Table m_stateBufferMaximumTable;
 
     Table m_applPortTable;
+    Table m_stateAsicTable;
+    Table m_cfgLosslessTrafficPatternTable;
 
     bool m_supportGearbox;
     gearbox_delay_t m_gearboxDelay;
@@ -267,6 +293,18 @@ private:
 
     std::string m_overSubscribeRatio;
 
+    // Headroom memoized by the parameters it is calculated from
+    // A config reload creates the same few profiles on every port, each used to run the lua plugin
+    std::map<std::string, headroom_result_t> m_headroomCache;
+    // The vendor lua plugin implements the generic formula, which is calculated natively
+    bool m_nativeHeadroomSupported;
+    bool m_headroomParamLoaded;
+    headroom_param_t m_headroomParam;
+
+    // The shared buffer pool size is checked once at the end of a batch instead of on every port event
+    bool m_deferPoolSizeCheck;
+    bool m_poolSizeCheckPending;
+
     // Profiles waiting for SAI sync in refreshSharedHeadroomPool
     std::vector<std::string> m_shpProfilesToCheck;
 
@@ -297,6 +335,10 @@ private:
     // Meta flows
     bool needRefreshPortDueToEffectiveSpeed(port_info_t &portInfo, std::string &portName);
     void calculateHeadroomSize(buffer_profile_t &headroom);
+    bool calculateHeadroomSizeByLua(const buffer_profile_t &headroom, headroom_result_t &result);
+    bool loadHeadroomParameters();
+    void invalidateHeadroomCache();
+    bool calculateHeadroomSizeNatively(const buffer_profile_t &headroom, headroom_result_t &result);
     void checkSharedBufferPoolSize(bool force_update_during_initialization);
     void recalculateSharedBufferPool();
     task_process_status allocateProfile(const std::string &speed, const std::string &cable, const std::string &mtu, const std::string &threshold, const std::string &gearbox_model, long lane_count, std::string &profile_name);
@@ -329,6 +371,7 @@ private:
     task_process_status handleDefaultLossLessBufferParam(KeyOpFieldsValuesTuple &tuple);
     task_process_status handleCableLenTable(KeyOpFieldsValuesTuple &tuple);
     task_process_status handlePortStateTable(KeyOpFieldsValuesTuple &tuple);
+    task_process_status handleHeadroomParameterTable(KeyOpFieldsValuesTuple &tuple);
     task_process_status handlePortTable(KeyOpFieldsValuesTuple &tuple);
     task_process_status handleBufferPoolTable(KeyOpFieldsValuesTuple &tuple);
     task_process_status handleBufferProfileTable(KeyOpFieldsValuesTuple &tuple);
@@ -12,6 +12,7 @@
 #include "subscriberstatetable.h"
 #include <swss/redisutility.h>
 #include "subintf.h"
+#include "orch_zmq_config.h"
 
 using namespace std;
 using namespace swss;
@@ -25,7 +26,7 @@ using namespace swss;
 #define VRF_PREFIX          "Vrf"
 #define VRF_MGMT            "mgmt"
 
-#define LOOPBACK_DEFAULT_MTU_STR "65536"
+#define LOOPBACK_DEFAULT_MTU 65536
 #define DEFAULT_MTU_STR 9100
 
 IntfMgr::IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames) :
@@ -39,7 +40,9 @@ IntfMgr::IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
         m_stateVlanTable(stateDb, STATE_VLAN_TABLE_NAME),
         m_stateVrfTable(stateDb, STATE_VRF_TABLE_NAME),
         m_stateIntfTable(stateDb, STATE_INTERFACE_TABLE_NAME),
-        m_appIntfTableProducer(appDb, APP_INTF_TABLE_NAME),
+        // When the feature ORCH_NORTHBOND_INTF_ZMQ_ENABLED is enabled, interface events must be sent to orchagent via the ZMQ channel.
+        m_zmqClient(create_local_zmq_client(ORCH_NORTHBOND_INTF_ZMQ_ENABLED, false)),
+        m_appIntfTableProducer(createProducerStateTable(appDb, APP_INTF_TABLE_NAME, m_zmqClient)),
         m_neighTable(appDb, APP_NEIGH_TABLE_NAME)
 {
     auto subscriberStateTable = new swss::SubscriberStateTable(stateDb,
@@ -78,21 +81,17 @@ IntfMgr::IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
 void IntfMgr::setIntfIp(const string &alias, const string &opCmd,
                         const IpPrefix &ipPrefix)
 {
-    stringstream    cmd;
-    string          res;
-    string          ipPrefixStr = ipPrefix.to_string();
-    string          broadcastIpStr = ipPrefix.getBroadcastIp().to_string();
     int             prefixLen = ipPrefix.getMaskLength();
+    bool            broadcast;
+    uint32_t        metric = 0;
+    int             ret;
 
     if (ipPrefix.isV4())
     {
-        (prefixLen < 31) ?
-        (cmd << IP_CMD << " address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " broadcast " << shellquote(broadcastIpStr) <<" dev " << shellquote(alias)) :
-        (cmd << IP_CMD << " address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " dev " << shellquote(alias));
+        broadcast = (prefixLen < 31);
     }
     else
     {
-        string metric = "";
         // Kernel adds connected route with default metric of 256. But the metric is not
         // communicated to frr unless the ip address is added with explicit metric
         // In voq system, We need the static route to the remote neighbor and connected
@@ -102,67 +101,59 @@ void IntfMgr::setIntfIp(const string &alias, const string &opCmd,
         // to set the metric explicitly.
         if(mySwitchType == "voq")
         {
-           metric = " metric 256";
+           metric = 256;
         }
+        broadcast = (prefixLen < 127);
+    }
 
-        (prefixLen < 127) ?
-        (cmd << IP_CMD << " -6 address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " broadcast " << shellquote(broadcastIpStr) <<
-         " dev " << shellquote(alias) << metric) :
-        (cmd << IP_CMD << " -6 address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " dev " << shellquote(alias) << metric);
+    if (opCmd == "add")
+    {
+        ret = m_netDev.addAddress(alias, ipPrefix, broadcast, metric);
+    }
+    else
+    {
+        ret = m_netDev.delAddress(alias, ipPrefix);
     }
 
-    int ret = swss::exec(cmd.str(), res);
     if (ret)
     {
         if (!ipPrefix.isV4() && opCmd == "add")
         {
-            SWSS_LOG_NOTICE("Failed to assign IPv6 on interface %s with return code %d, trying to enable IPv6 and retry", alias.c_str(), ret);
+            SWSS_LOG_NOTICE("Failed to assign IPv6 on interface %s with error '%s', trying to enable IPv6 and retry",
+                            alias.c_str(), nl_geterror(ret));
             if (!enableIpv6Flag(alias))
             {
                 SWSS_LOG_ERROR("Failed to enable IPv6 on interface %s", alias.c_str());
                 return;
             }
-            ret = swss::exec(cmd.str(), res);
+            ret = m_netDev.addAddress(alias, ipPrefix, broadcast, metric);
         }
 
         if (ret)
         {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+            SWSS_LOG_ERROR("Failed to %s address %s on interface %s, error '%s'",
+                           opCmd.c_str(), ipPrefix.to_string().c_str(), alias.c_str(), nl_geterror(ret));
         }
     }
 }
 
 void IntfMgr::setIntfMac(const string &alias, const string &mac_str)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD << " link set " << alias << " address " << mac_str;
-
-    int ret = swss::exec(cmd.str(), res);
+    int ret = m_netDev.setLinkMac(alias, MacAddress(mac_str));
     if (ret)
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Failed to set mac %s on interface %s, error '%s'",
+                       mac_str.c_str(), alias.c_str(), nl_geterror(ret));
     }
 }
 
 void IntfMgr::setIntfVrf(const string &alias, const string &vrfName)
 {
-    stringstream cmd;
-    string res;
-
-    if (!vrfName.empty())
-    {
-        cmd << IP_CMD << " link set " << shellquote(alias) << " master " << shellquote(vrfName);
-    }
-    else
-    {
-        cmd << IP_CMD << " link set " << shellquote(alias) << " nomaster";
-    }
-    int ret = swss::exec(cmd.str(), res);
+    int ret = m_netDev.setLinkMaster(alias, vrfName);
     if (ret)
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Failed to set master '%s' on interface %s, error '%s'",
+                       vrfName.c_str(), alias.c_str(), nl_geterror(ret));
     }
 }
 
@@ -195,27 +186,19 @@ bool IntfMgr::setIntfMpls(const string &alias, const string& mpls)
 
 void IntfMgr::addLoopbackIntf(const string &alias)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD << " link add " << alias << " mtu " << LOOPBACK_DEFAULT_MTU_STR << " type dummy";
-    int ret = swss::exec(cmd.str(), res);
+    int ret = m_netDev.addDummyLink(alias, LOOPBACK_DEFAULT_MTU);
     if (ret)
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Failed to create loopback device %s, error '%s'", alias.c_str(), nl_geterror(ret));
     }
 }
 
 void IntfMgr::delLoopbackIntf(const string &alias)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD << " link del " << alias;
-    int ret = swss::exec(cmd.str(), res);
+    int ret = m_netDev.delLink(alias);
     if (ret)
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Failed to remove loopback device %s, error '%s'", alias.c_str(), nl_geterror(ret));
     }
 }
 
@@ -330,11 +313,11 @@ bool IntfMgr::isIntfChangeVrf(const string &alias, const string &vrfName)
 
 void IntfMgr::addHostSubIntf(const string&intf, const string &subIntf, const string &vlan)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD " link add link " << shellquote(intf) << " name " << shellquote(subIntf) << " type vlan id " << shellquote(vlan);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    int ret = m_netDev.addVlanLink(intf, subIntf, (uint16_t)stoul(vlan));
+    if (ret)
+    {
+        throw runtime_error("Failed to create sub interface " + subIntf + " on " + intf + " : " + nl_geterror(ret));
+    }
 }
 
 
@@ -423,16 +406,13 @@ void IntfMgr::updateSubIntfMtu(const string &alias, const string &mtu)
 
             FieldValueTuple fvTuple("mtu", subintf_mtu);
             fvVector.push_back(fvTuple);
-            m_appIntfTableProducer.set(intf, fvVector);
+            m_appIntfTableProducer->set(intf, fvVector);
         }
     }
 }
 
 std::string IntfMgr::setHostSubIntfMtu(const string &alias, const string &mtu, const string &parent_mtu)
 {
-    stringstream cmd;
-    string res;
-
     string subifMtu = mtu;
     subIntf subIf(alias);
 
@@ -444,19 +424,17 @@ std::string IntfMgr::setHostSubIntfMtu(const string &alias, const string &mtu, c
         subifMtu = parent_mtu;
     }
     SWSS_LOG_INFO("subintf %s active mtu: %s", alias.c_str(), subifMtu.c_str());
-    cmd << IP_CMD " link set " << shellquote(alias) << " mtu " << shellquote(subifMtu);
-    std::string cmd_str = cmd.str();
-    int ret = swss::exec(cmd_str, res);
+    int ret = m_netDev.setLinkMtu(alias, (uint32_t)stoul(subifMtu));
 
     if (ret && !isIntfStateOk(alias))
     {
         // Can happen when a SET notification on the PORT_TABLE in the State DB
         // followed by a new DEL notification that send by portmgrd
-        SWSS_LOG_WARN("Setting mtu to %s netdev failed with cmd:%s, rc:%d, error:%s", alias.c_str(), cmd_str.c_str(), ret, res.c_str());
+        SWSS_LOG_WARN("Setting mtu %s to %s netdev failed, error:%s", subifMtu.c_str(), alias.c_str(), nl_geterror(ret));
     }
     else if (ret)
     {
-        throw runtime_error(cmd_str + " : " + res);
+        throw runtime_error("Failed to set mtu " + subifMtu + " on " + alias + " : " + nl_geterror(ret));
     }
     return subifMtu;
 }
@@ -481,30 +459,25 @@ void IntfMgr::updateSubIntfAdminStatus(const string &alias, const string &admin)
             m_subIntfList[intf].currAdminStatus = subintf_admin;
             FieldValueTuple fvTuple("admin_status", subintf_admin);
             fvVector.push_back(fvTuple);
-            m_appIntfTableProducer.set(intf, fvVector);
+            m_appIntfTableProducer->set(intf, fvVector);
         }
     }
 }
 
 bool IntfMgr::setIntfAdminStatus(const string &alias, const string &admin_status)
 {
-    stringstream cmd;
-    string res, cmd_str;
-
     SWSS_LOG_INFO("intf %s admin_status: %s", alias.c_str(), admin_status.c_str());
-    cmd << IP_CMD " link set " << shellquote(alias) << " " << shellquote(admin_status);
-    cmd_str = cmd.str();
-    int ret = swss::exec(cmd_str, res);
+    int ret = m_netDev.setLinkAdminStatus(alias, admin_status == "up");
     if (ret && !isIntfStateOk(alias))
     {
         // Can happen when a DEL notification is sent by portmgrd immediately followed by a new SET notification
-        SWSS_LOG_WARN("Setting admin_status to %s netdev failed with cmd:%s, rc:%d, error:%s",
-                      alias.c_str(), cmd_str.c_str(), ret, res.c_str());
+        SWSS_LOG_WARN("Setting admin_status %s to %s netdev failed, error:%s",
+                      admin_status.c_str(), alias.c_str(), nl_geterror(ret));
         return false;
     }
     else if (ret)
     {
-        throw runtime_error(cmd_str + " : " + res);
+        throw runtime_error("Failed to set admin_status " + admin_status + " on " + alias + " : " + nl_geterror(ret));
     }
     return true;
 }
@@ -532,11 +505,11 @@ std::string IntfMgr::setHostSubIntfAdminStatus(const string &alias, const string
 
 void IntfMgr::removeHostSubIntf(const string &subIntf)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD " link del " << shellquote(subIntf);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    int ret = m_netDev.delLink(subIntf);
+    if (ret)
+    {
+        throw runtime_error("Failed to remove sub interface " + subIntf + " : " + nl_geterror(ret));
+    }
 }
 
 void IntfMgr::setSubIntfStateOk(const string &alias)
@@ -1050,7 +1023,7 @@ bool IntfMgr::doIntfGeneralTask(const vector<string>& keys,
             }
         }
 
-        m_appIntfTableProducer.set(alias, data);
+        m_appIntfTableProducer->set(alias, data);
         m_stateIntfTable.hset(alias, "vrf", vrf_name);
     }
     else if (op == DEL_COMMAND)
@@ -1085,7 +1058,7 @@ bool IntfMgr::doIntfGeneralTask(const vector<string>& keys,
             SWSS_LOG_INFO("Erased ipv6 link local mode list for %s", alias.c_str());
         }
 
-        m_appIntfTableProducer.del(alias);
+        m_appIntfTableProducer->del(alias);
         m_stateIntfTable.del(alias);
     }
     else
@@ -1134,7 +1107,7 @@ bool IntfMgr::doIntfAddrTask(const vector<string>& keys,
             FieldValueTuple s("scope", "global");
             fvVector.push_back(s);
             fvVector.push_back(f);
-            m_appIntfTableProducer.set(appKey, fvVector);
+            m_appIntfTableProducer->set(appKey, fvVector);
             m_stateIntfTable.hset(keys[0] + state_db_key_delimiter + keys[1], "state", "ok");
         }
     }
@@ -1158,7 +1131,7 @@ bool IntfMgr::doIntfAddrTask(const vector<string>& keys,
         // Don't send ipv4 link local config to AppDB and Orchagent
         if ((ip_prefix.isV4() == false) || (ip_prefix.getIp().getAddrScope() != IpAddress::AddrScope::LINK_SCOPE))
         {
-            m_appIntfTableProducer.del(appKey);
+            m_appIntfTableProducer->del(appKey);
             m_stateIntfTable.del(keys[0] + state_db_key_delimiter + keys[1]);
         }
     }
@@ -1196,7 +1169,7 @@ void IntfMgr::doTask(Consumer &consumer)
                         (op == SET_COMMAND))
                 {
                     //No further processing needed. Just relay to orchagent
-                    m_appIntfTableProducer.set(keys[0], data);
+                    m_appIntfTableProducer->set(keys[0], data);
                     m_stateIntfTable.hset(keys[0], "vrf", "");
 
                     it = consumer.m_toSync.erase(it);
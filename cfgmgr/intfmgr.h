@@ -3,9 +3,12 @@
 
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "zmqclient.h"
 #include "orch.h"
+#include "netdevhelper.h"
 
 #include <map>
+#include <memory>
 #include <string>
 #include <set>
 
@@ -28,10 +31,13 @@ public:
     using Orch::doTask;
 
 private:
-    ProducerStateTable m_appIntfTableProducer;
+    /* Set when INTF_TABLE is sent to orchagent via the ZMQ channel */
+    std::shared_ptr<ZmqClient> m_zmqClient;
+    std::shared_ptr<ProducerStateTable> m_appIntfTableProducer;
     Table m_cfgIntfTable, m_cfgVlanIntfTable, m_cfgLagIntfTable, m_cfgLoopbackIntfTable;
     Table m_statePortTable, m_stateLagTable, m_stateVlanTable, m_stateVrfTable, m_stateIntfTable;
     Table m_neighTable;
+    NetDevHelper m_netDev;
 
     SubIntfMap m_subIntfList;
     std::set<std::string> m_loopbackIntfList;
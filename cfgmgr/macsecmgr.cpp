@@ -1,7 +1,5 @@
 #include "macsecmgr.h"
 
-#include <exec.h>
-#include <shellcmd.h>
 #include <swss/stringutility.h>
 #include <swss/redisutility.h>
 #include <boost/algorithm/string/predicate.hpp>
@@ -19,13 +17,14 @@
 #include <algorithm>
 #include <sstream>
 #include <cctype>
+#include <chrono>
+#include <thread>
 
 
 using namespace std;
 using namespace swss;
 
 #define WPA_SUPPLICANT_CMD "/sbin/wpa_supplicant"
-#define WPA_CLI_CMD        "/sbin/wpa_cli"
 #define WPA_CONF           "/etc/wpa_supplicant.conf"
 #define SOCK_DIR           "/var/run/"
 
@@ -34,6 +33,12 @@ constexpr std::uint64_t RETRY_TIME = 30;
 /* retry interval, in millisecond */
 constexpr std::uint64_t RETRY_INTERVAL = 100;
 
+/*
+ * The wpa_supplicant of this many ports are started at once, ahead of the
+ * port tasks, so that their start up overlaps instead of adding up.
+ */
+constexpr std::size_t WPA_SUPPLICANT_SPAWN_WINDOW = 16;
+
 /*
  * The input cipher_str is the encoded string which can be either of length 66 bytes or 130 bytes.
  *
@@ -174,95 +179,60 @@ static bool get_value(
     return true;
 }
 
-static void wpa_cli_commands(std::ostringstream & ostream)
+static void wpa_ctrl_args(std::ostringstream & ostream)
 {
     // Intentionally emtpy function to adapt
-    // the recursively calling of wpa_cli_commands
+    // the recursively calling of wpa_ctrl_args
 }
 
 template<typename T, typename...Args>
-static void wpa_cli_commands(
+static void wpa_ctrl_args(
     std::ostringstream & ostream,
     T && t,
     Args && ... args)
 {
     ostream << " " << t;
-    wpa_cli_commands(ostream, args...);
-}
-
-template<typename...Args>
-static void wpa_cli_commands(
-    std::ostringstream & ostream,
-    const std::string & t,
-    Args && ... args)
-{
-    ostream << shellquote(t) << " ";
-    wpa_cli_commands(ostream, args...);
+    wpa_ctrl_args(ostream, args...);
 }
 
-template<typename...Args>
-static void wpa_cli_commands(
-    std::ostringstream & ostream,
-    const std::string & sock,
+/*
+ * The command as wpa_cli would send it to the global control socket,
+ * "[IFNAME=<port> ][set_network <id> ]<args...>"
+ */
+template<typename T, typename...Args>
+static std::string wpa_ctrl_command(
     const std::string & port_name,
     const std::string & network_id,
+    T && t,
     Args && ... args)
 {
-    ostream << WPA_CLI_CMD;
-    wpa_cli_commands(ostream, "-g", sock);
+    std::ostringstream ostream;
     if (!port_name.empty())
     {
-        wpa_cli_commands(ostream, "IFNAME=" + port_name);
+        ostream << "IFNAME=" << port_name << " ";
     }
     if (!network_id.empty())
     {
-        wpa_cli_commands(ostream, "set_network", network_id);
+        ostream << "set_network " << network_id << " ";
     }
-    wpa_cli_commands(ostream, args...);
-}
-
-template<typename...Args>
-static std::string wpa_cli_exec(
-    const std::string & sock,
-    const std::string & port_name,
-    const std::string & network_id,
-    Args && ... args)
-{
-    std::ostringstream ostream;
-    std::string res;
-    wpa_cli_commands(
-        ostream,
-        sock,
-        port_name,
-        network_id,
-        std::forward<Args>(args)...);
-    EXEC_WITH_ERROR_THROW(ostream.str(), res);
-    return res;
+    ostream << t;
+    wpa_ctrl_args(ostream, args...);
+    return ostream.str();
 }
 
-template<typename...Args>
-static void wpa_cli_exec_and_check(
-    const std::string & sock,
-    const std::string & port_name,
-    const std::string & network_id,
-    Args && ... args)
+/* Send the commands pipelined and check each of them replied OK */
+static void wpa_ctrl_exec_and_check(
+    WpaCtrl & ctrl,
+    const std::vector<std::string> & cmds)
 {
-    std::string res = wpa_cli_exec(
-        sock,
-        port_name,
-        network_id,
-        std::forward<Args>(args)...);
-    if (res.find("OK") != 0)
-    {
-        std::ostringstream ostream;
-        wpa_cli_commands(
-            ostream,
-            sock,
-            port_name,
-            network_id,
-            std::forward<Args>(args)...);
-        throw std::runtime_error(
-            "Wpa_cli command : " + ostream.str() + " -> " +res);
+    const auto replies = ctrl.request(cmds);
+    for (size_t i = 0; i < cmds.size(); i++)
+    {
+        if (replies[i].find("OK") != 0)
+        {
+            throw std::runtime_error(
+                "Wpa_ctrl command : " + cmds[i] + " -> " + replies[i]);
+        }
     }
 }
 
@@ -300,9 +270,15 @@ void MACsecMgr::doTask(Consumer &consumer)
     };
 
     const std::string & table_name = consumer.getTableName();
+    std::size_t window = 0;
     auto itr = consumer.m_toSync.begin();
     while (itr != consumer.m_toSync.end())
     {
+        if (table_name == CFG_PORT_TABLE_NAME && window-- == 0)
+        {
+            window = spawnWPASupplicants(itr, consumer.m_toSync.end()) - 1;
+        }
+
         task_process_status task_done = task_failed;
         auto & message = itr->second;
         const std::string & op = kfvOp(message);
@@ -349,6 +325,8 @@ void MACsecMgr::doTask(Consumer &consumer)
             itr = consumer.m_toSync.erase(itr);
         }
     }
+
+    reapWPASupplicants();
 }
 
 #define GetValue(args, name) (get_value(args, #name, name))
@@ -540,7 +518,8 @@ task_process_status MACsecMgr::enableMACsec(
     ostringstream ostream;
     ostream << SOCK_DIR << port_name;
     session.sock = ostream.str();
-    session.wpa_supplicant_pid = startWPASupplicant(session.sock);
+    session.ctrl = std::make_shared<WpaCtrl>(session.sock);
+    session.wpa_supplicant_pid = startWPASupplicant(port_name, session);
     if (session.wpa_supplicant_pid < 0)
     {
         SWSS_LOG_WARN("Cannot start the wpa_supplicant of the port '%s' : %s",
@@ -632,7 +611,58 @@ bool MACsecMgr::isPortStateOk(const std::string & port_name)
     return false;
 }
 
-pid_t MACsecMgr::startWPASupplicant(const std::string & sock) const
+/*
+ * Start the wpa_supplicant of the next ports of the window that will be
+ * enabled, returns the number of tasks the window spans, at least one.
+ */
+std::size_t MACsecMgr::spawnWPASupplicants(SyncMap::iterator itr, SyncMap::iterator end)
+{
+    SWSS_LOG_ENTER();
+
+    std::size_t scanned = 0;
+    for (; itr != end && m_spawned_supplicants.size() < WPA_SUPPLICANT_SPAWN_WINDOW; ++itr, ++scanned)
+    {
+        const auto & port_name = kfvKey(itr->second);
+        std::string profile_name;
+        if (kfvOp(itr->second) != SET_COMMAND
+            || !get_value(kfvFieldsValues(itr->second), "macsec", profile_name)
+            || m_profiles.find(profile_name) == m_profiles.end()
+            || m_macsec_ports.find(port_name) != m_macsec_ports.end()
+            || m_spawned_supplicants.find(port_name) != m_spawned_supplicants.end()
+            || !isPortStateOk(port_name))
+        {
+            continue;
+        }
+
+        ostringstream ostream;
+        ostream << SOCK_DIR << port_name;
+        pid_t pid = spawnWPASupplicant(ostream.str());
+        if (pid > 0)
+        {
+            m_spawned_supplicants.emplace(port_name, pid);
+        }
+    }
+    if (!m_spawned_supplicants.empty())
+    {
+        SWSS_LOG_INFO("Started %zu wpa_supplicant ahead of their port",
+            m_spawned_supplicants.size());
+    }
+    return std::max<std::size_t>(scanned, 1);
+}
+
+/* Stop the wpa_supplicant started ahead whose task didn't take them */
+void MACsecMgr::reapWPASupplicants()
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto & spawned : m_spawned_supplicants)
+    {
+        stopWPASupplicant(spawned.second);
+    }
+    m_spawned_supplicants.clear();
+}
+
+pid_t MACsecMgr::spawnWPASupplicant(const std::string & sock) const
 {
     SWSS_LOG_ENTER();
 
@@ -647,7 +677,26 @@ pid_t MACsecMgr::startWPASupplicant(const std::string & sock) const
             "-g", sock.c_str(),
             NULL));
     }
-    else if (wpa_supplicant_pid > 0)
+    return wpa_supplicant_pid;
+}
+
+pid_t MACsecMgr::startWPASupplicant(const std::string & port_name, const MKASession & session)
+{
+    SWSS_LOG_ENTER();
+
+    pid_t wpa_supplicant_pid;
+    auto spawned = m_spawned_supplicants.find(port_name);
+    if (spawned != m_spawned_supplicants.end())
+    {
+        wpa_supplicant_pid = spawned->second;
+        m_spawned_supplicants.erase(spawned);
+    }
+    else
+    {
+        wpa_supplicant_pid = spawnWPASupplicant(session.sock);
+    }
+
+    if (wpa_supplicant_pid > 0)
     {
         // Wait wpa_supplicant ready
         bool wpa_supplicant_loading = false;
@@ -656,7 +705,7 @@ pid_t MACsecMgr::startWPASupplicant(const std::string & sock) const
         {
             try
             {
-                wpa_cli_exec(sock, "", "", "status");
+                session.ctrl->request("PING");
                 wpa_supplicant_loading = true;
             }
             catch(const std::runtime_error&)
@@ -706,20 +755,27 @@ bool MACsecMgr::configureMACsec(
 
     try
     {
-        wpa_cli_exec_and_check(
-            session.sock,
-            "",
-            "",
-            "interface_add",
-            port_name,
-            WPA_CONF,
-            "macsec_sonic");
+        const std::vector<std::string> add_cmds = {
+            wpa_ctrl_command(
+                "",
+                "",
+                "interface_add",
+                port_name,
+                WPA_CONF,
+                "macsec_sonic"),
+            wpa_ctrl_command(
+                port_name,
+                "",
+                "add_network"),
+        };
+        const auto add_res = session.ctrl->request(add_cmds);
+        if (add_res[0].find("OK") != 0)
+        {
+            throw std::runtime_error(
+                "Wpa_ctrl command : " + add_cmds[0] + " -> " + add_res[0]);
+        }
 
-        const std::string res = wpa_cli_exec(
-            session.sock,
-            port_name,
-            "",
-            "add_network");
+        const std::string & res = add_res[1];
         const std::string network_id(
             res.begin(),
             std::find_if_not(
@@ -736,102 +792,81 @@ bool MACsecMgr::configureMACsec(
             throw std::runtime_error("Cannot add network : " + res);
         }
 
-        wpa_cli_exec_and_check(
-            session.sock,
+        // The network settings go in one pipelined batch
+        std::vector<std::string> cmds;
+        cmds.push_back(wpa_ctrl_command(
             port_name,
             network_id,
             "key_mgmt",
-            "NONE");
-
-        wpa_cli_exec_and_check(
-            session.sock,
+            "NONE"));
+        cmds.push_back(wpa_ctrl_command(
             port_name,
             network_id,
             "eapol_flags",
-            0);
-
-        wpa_cli_exec_and_check(
-            session.sock,
+            0));
+        cmds.push_back(wpa_ctrl_command(
             port_name,
             network_id,
             "macsec_policy",
-            1);
-
-        wpa_cli_exec_and_check(
-            session.sock,
+            1));
+        cmds.push_back(wpa_ctrl_command(
             port_name,
             network_id,
             "macsec_integ_only",
-            (profile.policy == MACsecProfile::Policy::INTEGRITY_ONLY ? 1 : 0));
-
-        wpa_cli_exec_and_check(
-            session.sock,
+            (profile.policy == MACsecProfile::Policy::INTEGRITY_ONLY ? 1 : 0)));
+        cmds.push_back(wpa_ctrl_command(
             port_name,
             network_id,
             "mka_cak",
-            decodeKey(profile.primary_cak, profile.cipher_suite));
-
-        wpa_cli_exec_and_check(
-            session.sock,
+            decodeKey(profile.primary_cak, profile.cipher_suite)));
+        cmds.push_back(wpa_ctrl_command(
             port_name,
             network_id,
             "mka_ckn",
-            profile.primary_ckn);
-
-        wpa_cli_exec_and_check(
-            session.sock,
+            profile.primary_ckn));
+        cmds.push_back(wpa_ctrl_command(
             port_name,
             network_id,
             "mka_priority",
-            profile.priority);
-
+            profile.priority));
         if (profile.rekey_period)
         {
-            wpa_cli_exec_and_check(
-                session.sock,
+            cmds.push_back(wpa_ctrl_command(
                 port_name,
                 network_id,
                 "mka_rekey_period",
-                profile.rekey_period);
+                profile.rekey_period));
         }
-
-        wpa_cli_exec_and_check(
-            session.sock,
+        cmds.push_back(wpa_ctrl_command(
             port_name,
             network_id,
             "macsec_ciphersuite",
-            profile.cipher_suite);
-
-        wpa_cli_exec_and_check(
-            session.sock,
+            profile.cipher_suite));
+        cmds.push_back(wpa_ctrl_command(
             port_name,
             network_id,
             "macsec_include_sci",
-            (profile.send_sci ? 1 : 0));
-
-        wpa_cli_exec_and_check(
-            session.sock,
+            (profile.send_sci ? 1 : 0)));
+        cmds.push_back(wpa_ctrl_command(
             port_name,
             network_id,
             "macsec_replay_protect",
-            (profile.enable_replay_protect ? 1 : 0));
-
+            (profile.enable_replay_protect ? 1 : 0)));
         if (profile.enable_replay_protect)
         {
-            wpa_cli_exec_and_check(
-                session.sock,
+            cmds.push_back(wpa_ctrl_command(
                 port_name,
                 network_id,
                 "macsec_replay_window",
-                profile.replay_window);
+                profile.replay_window));
         }
-
-        wpa_cli_exec_and_check(
-            session.sock,
+        cmds.push_back(wpa_ctrl_command(
             port_name,
             "",
             "enable_network",
-            network_id);
+            network_id));
+
+        wpa_ctrl_exec_and_check(*session.ctrl, cmds);
     }
     catch(const std::runtime_error & e)
     {
@@ -856,12 +891,9 @@ bool MACsecMgr::unconfigureMACsec(
     {
         try
         {
-            wpa_cli_exec_and_check(
-                session.sock,
-                "",
-                "",
-                "interface_remove",
-                port_name);
+            wpa_ctrl_exec_and_check(
+                *session.ctrl,
+                {wpa_ctrl_command("", "", "interface_remove", port_name)});
 
             // Success on this attempt: no need to retry further.
             return true;
@@ -871,7 +903,7 @@ bool MACsecMgr::unconfigureMACsec(
             const std::string error_message = e.what();
             // Best-effort cleanup semantics for interface_remove:
             //
-            // 1. If wpa_cli returns "FAIL" for interface_remove, it typically means
+            // 1. If wpa_supplicant returns "FAIL" for interface_remove, it typically means
             //    the interface is already gone from wpa_supplicant. From
             //    macsecmgr's perspective this is equivalent to a successful
             //    unconfigure, so treat it as success to avoid spurious
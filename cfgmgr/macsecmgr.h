@@ -2,11 +2,13 @@
 #define __MACSECMGR__
 
 #include <orch.h>
+#include "wpactrl.h"
 #include <swss/schema.h>
 #include <swss/boolean.h>
 
 #include <cinttypes>
 #include <map>
+#include <memory>
 #include <vector>
 #include <sstream>
 
@@ -56,6 +58,8 @@ public:
         std::string profile_name;
         // wpa_supplicant communication socket
         std::string sock;
+        // Client kept connected to sock
+        std::shared_ptr<WpaCtrl> ctrl;
         // wpa_supplicant process id
         pid_t       wpa_supplicant_pid;
     };
@@ -63,6 +67,8 @@ public:
 private:
     std::map<std::string, struct MACsecProfile> m_profiles;
     std::map<std::string, MKASession>           m_macsec_ports;
+    // wpa_supplicant started ahead for the port tasks about to be processed
+    std::map<std::string, pid_t>                m_spawned_supplicants;
 
     task_process_status removeProfile(const std::string & profile_name, const TaskArgs & profile_attr);
     task_process_status loadProfile(const std::string & profile_name, const TaskArgs & profile_attr);
@@ -73,7 +79,10 @@ private:
     Table m_statePortTable;
 
     bool isPortStateOk(const std::string & port_name);
-    pid_t startWPASupplicant(const std::string & sock) const;
+    size_t spawnWPASupplicants(SyncMap::iterator itr, SyncMap::iterator end);
+    void reapWPASupplicants();
+    pid_t spawnWPASupplicant(const std::string & sock) const;
+    pid_t startWPASupplicant(const std::string & port_name, const MKASession & session);
     bool stopWPASupplicant(pid_t pid) const;
     bool configureMACsec(const std::string & port_name, const MKASession & session, const MACsecProfile & profile) const;
     bool unconfigureMACsec(const std::string & port_name, const MKASession & session) const;
@@ -15,6 +15,10 @@
  */
 
 #include <string.h>
+#include <stdio.h>
+#include <sys/wait.h>
+#include <map>
+#include <vector>
 #include "logger.h"
 #include "producerstatetable.h"
 #include "macaddress.h"
@@ -352,48 +356,175 @@ bool NatMgr::warmBootingInProgress(void)
     return false;
 }
 
-/* To flush all NAT entries */
-void NatMgr::flushAllNatEntries(void)
+/* To queue iptables commands, joined by " && ", for the iptables-restore transaction of this batch */
+void NatMgr::queueIptablesCmds(const string &cmds)
 {
-    std::string res;
-    const std::string cmds = std::string("") + CONNTRACK_CMD + FLUSH;
-    int ret = swss::exec(cmds, res);
+    m_iptablesCmds.push_back(cmds);
+}
+
+/* To queue a conntrack command, run after the iptables rules of this batch are committed */
+void NatMgr::queueConntrackCmd(const string &cmd)
+{
+    m_conntrackCmds.push_back(cmd);
+}
 
-    if (ret)
+/* To write the input to the stdin of a command, returns the command exit code */
+static int pipeToCommand(const string &cmd, const string &input)
+{
+    FILE *pipe = popen(cmd.c_str(), "w");
+    if (!pipe)
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
+        return -1;
     }
-    else
+
+    fwrite(input.data(), 1, input.size(), pipe);
+
+    int status = pclose(pipe);
+    if ((status == -1) || !WIFEXITED(status))
     {
-        SWSS_LOG_INFO("Cleared the All NAT Entries");
+        return -1;
     }
+    return WEXITSTATUS(status);
 }
 
-/* To Update a conntrack entry for the Dynamic Single NAT entry in the kernel */
-void NatMgr::updateDynamicSingleNatConnTrackTimeout(string key, int timeout)
+/* To split "iptables -t <table> <rule>" into the table and the iptables-restore rule line */
+static bool toIptablesRestoreRule(const string &cmd, string &table, string &rule)
 {
-    std::string res;
-    std::string cmds = std::string("") + CONNTRACK_CMD;
-    IpAddress   ip_address = IpAddress(key);
+    const string prefix = std::string(IPTABLES_CMD) + " -t ";
+    size_t start = cmd.find_first_not_of(' ');
 
-    cmds += (" -U -s " + ip_address.to_string() + " -t " + to_string(timeout) + REDIRECT_TO_DEV_NULL);
-    int ret = swss::exec(cmds, res);
+    if ((start == string::npos) || cmd.compare(start, prefix.size(), prefix))
+    {
+        return false;
+    }
 
-    if (ret)
+    size_t tableStart = start + prefix.size();
+    size_t tableEnd = cmd.find(' ', tableStart);
+    if (tableEnd == string::npos)
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
+        return false;
     }
-    else
+
+    table = cmd.substr(tableStart, tableEnd - tableStart);
+    rule = cmd.substr(tableEnd + 1);
+    return true;
+}
+
+/*
+ * Commit the iptables rules queued by this batch with one iptables-restore --noflush
+ * transaction instead of one iptables call (and xtables lock/table rewrite) per rule.
+ * If the transaction is rejected nothing has been applied, so the commands are replayed
+ * one by one to apply the valid ones and log the failing ones as before.
+ * The queued conntrack commands are then run by a single shell.
+ */
+void NatMgr::flush()
+{
+    if (!m_iptablesCmds.empty())
+    {
+        const string separator = " && ";
+        vector<string> tables;
+        map<string, string> rules;
+        bool valid = true;
+        int ret = -1;
+
+        for (const auto &cmds : m_iptablesCmds)
+        {
+            size_t start = 0;
+            while (valid)
+            {
+                size_t end = cmds.find(separator, start);
+                string table, rule;
+
+                valid = toIptablesRestoreRule(cmds.substr(start, end == string::npos ? string::npos : end - start), table, rule);
+                if (valid)
+                {
+                    if (rules.find(table) == rules.end())
+                    {
+                        tables.push_back(table);
+                    }
+                    rules[table] += rule + "\n";
+                }
+
+                if (end == string::npos)
+                {
+                    break;
+                }
+                start = end + separator.size();
+            }
+        }
+
+        if (valid)
+        {
+            string input;
+            for (const auto &table : tables)
+            {
+                input += "*" + table + "\n" + rules[table] + "COMMIT\n";
+            }
+            ret = pipeToCommand(std::string(IPTABLES_RESTORE_CMD) + " --noflush", input);
+        }
+
+        if (ret)
+        {
+            SWSS_LOG_WARN("iptables-restore of %zu rule sets failed with rc %d, applying them one by one",
+                          m_iptablesCmds.size(), ret);
+
+            for (const auto &cmds : m_iptablesCmds)
+            {
+                string res;
+                int rc = swss::exec(cmds, res);
+                if (rc)
+                {
+                    SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), rc);
+                }
+            }
+        }
+        else
+        {
+            SWSS_LOG_INFO("Committed %zu iptables rule sets", m_iptablesCmds.size());
+        }
+        m_iptablesCmds.clear();
+    }
+
+    if (!m_conntrackCmds.empty())
     {
-        SWSS_LOG_INFO("Updated the active NAT conntrack entry with src-ip %s, timeout %u",
-                      ip_address.to_string().c_str(), timeout);
+        string script;
+        for (const auto &cmd : m_conntrackCmds)
+        {
+            script += cmd + "\n";
+        }
+
+        if (pipeToCommand(BASH_CMD, script) < 0)
+        {
+            SWSS_LOG_ERROR("Failed to run %zu conntrack commands", m_conntrackCmds.size());
+        }
+        m_conntrackCmds.clear();
     }
 }
 
+/* To flush all NAT entries */
+void NatMgr::flushAllNatEntries(void)
+{
+    const std::string cmds = std::string("") + CONNTRACK_CMD + FLUSH;
+
+    queueConntrackCmd(cmds);
+    SWSS_LOG_INFO("Cleared the All NAT Entries");
+}
+
+/* To Update a conntrack entry for the Dynamic Single NAT entry in the kernel */
+void NatMgr::updateDynamicSingleNatConnTrackTimeout(string key, int timeout)
+{
+    std::string cmds = std::string("") + CONNTRACK_CMD;
+    IpAddress   ip_address = IpAddress(key);
+
+    cmds += (" -U -s " + ip_address.to_string() + " -t " + to_string(timeout) + REDIRECT_TO_DEV_NULL);
+    queueConntrackCmd(cmds);
+    SWSS_LOG_INFO("Updated the active NAT conntrack entry with src-ip %s, timeout %u",
+                  ip_address.to_string().c_str(), timeout);
+}
+
 /* To Update a conntrack entry for the Dynamic Single NAPT entry in the kernel */
 void NatMgr::updateDynamicSingleNaptConnTrackTimeout(string key, int timeout)
 {
-    std::string     res;
     vector<string>  keys = tokenize(key, ':');
     IpAddress       ip_address = IpAddress(keys[1]);
     int             l4_port = stoi(keys[2]);
@@ -401,23 +532,14 @@ void NatMgr::updateDynamicSingleNaptConnTrackTimeout(string key, int timeout)
     std::string     cmds = std::string("") + CONNTRACK_CMD;
     
     cmds += (" -U -s " + ip_address.to_string() + " -p " + prototype + " --orig-port-src " + to_string(l4_port) + " -t " + to_string(timeout) + REDIRECT_TO_DEV_NULL);
-    int ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_INFO("Updated active NAPT conntrack entry with protocol %s, src-ip %s, src-port %d, timeout %u",
-                      prototype.c_str(), ip_address.to_string().c_str(), l4_port, timeout);
-    }
+    queueConntrackCmd(cmds);
+    SWSS_LOG_INFO("Updated active NAPT conntrack entry with protocol %s, src-ip %s, src-port %d, timeout %u",
+                  prototype.c_str(), ip_address.to_string().c_str(), l4_port, timeout);
 }
 
 /* To Update a conntrack entry for the Dynamic Twice NAT entry in the kernel */
 void NatMgr::updateDynamicTwiceNatConnTrackTimeout(string key, int timeout)
 {
-    std::string     res;
     std::string     cmd = std::string("") + CONNTRACK_CMD;
     vector<string>  keys = tokenize(key, ':');
     IpAddress       src_ip = IpAddress(keys[1]);
@@ -425,7 +547,7 @@ void NatMgr::updateDynamicTwiceNatConnTrackTimeout(string key, int timeout)
 
     cmd += (" -U -s " + src_ip.to_string() + " -d " + dst_ip.to_string() + " -t " + std::to_string(timeout) + REDIRECT_TO_DEV_NULL);
 
-    swss::exec(cmd, res);
+    queueConntrackCmd(cmd);
 
     SWSS_LOG_INFO("Updated active Twice NAT conntrack entry with src-ip %s, dst-ip %s, timeout %u",
                   src_ip.to_string().c_str(), dst_ip.to_string().c_str(), timeout);
@@ -434,7 +556,6 @@ void NatMgr::updateDynamicTwiceNatConnTrackTimeout(string key, int timeout)
 /* To Update a conntrack entry for the Dynamic Twice NAPT entry in the kernel */
 void NatMgr::updateDynamicTwiceNaptConnTrackTimeout(string key, int timeout)
 {
-    std::string     res;
     std::string     cmd = std::string("") + CONNTRACK_CMD;
     vector<string>  keys = tokenize(key, ':');
     IpAddress       src_ip      = IpAddress(keys[1]);
@@ -447,7 +568,7 @@ void NatMgr::updateDynamicTwiceNaptConnTrackTimeout(string key, int timeout)
             " -d " + dst_ip.to_string() + " --orig-port-dst " + std::to_string(dst_l4_port) +
             " -t " + std::to_string(timeout) + REDIRECT_TO_DEV_NULL);
 
-    swss::exec(cmd, res);
+    queueConntrackCmd(cmd);
 
     SWSS_LOG_INFO("Updated active Twice NAPT conntrack entry with protocol %s, src-ip %s, src-port %d, dst-ip %s, dst-port %d, timeout %u",
                   prototype.c_str(), src_ip.to_string().c_str(), src_l4_port, dst_ip.to_string().c_str(), dst_l4_port, timeout);
@@ -456,7 +577,7 @@ void NatMgr::updateDynamicTwiceNaptConnTrackTimeout(string key, int timeout)
 /* To Add a dummy conntrack entry for the Static Single NAT entry in the kernel */
 void NatMgr::addConntrackStaticSingleNatEntry(const string &key)
 {
-    std::string res, cmds = std::string("") + CONNTRACK_CMD; 
+    std::string cmds = std::string("") + CONNTRACK_CMD; 
     int timeout = NAT_TIMEOUT_MAX;
 
     if (m_staticNatEntry[key].nat_type == DNAT_NAT_TYPE)
@@ -476,22 +597,14 @@ void NatMgr::addConntrackStaticSingleNatEntry(const string &key)
                  " --src " + key + " --sport 1 --dst 127.0.0.1 --dport 127 -u ASSURED " + REDIRECT_TO_DEV_NULL);
     }
 
-    int ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_INFO("Added the static NAT conntrack entry");
-    }
+    queueConntrackCmd(cmds);
+    SWSS_LOG_INFO("Added the static NAT conntrack entry");
 }
 
 /* To Add a dummy conntrack entry for the Static Twice NAT entry in the kernel */
 void NatMgr::addConntrackStaticTwiceNatEntry(const string &snatKey, const string &dnatKey)
 {
-    std::string res, cmds = std::string("") + CONNTRACK_CMD;
+    std::string cmds = std::string("") + CONNTRACK_CMD;
     int timeout = NAT_TIMEOUT_MAX;
 
     SWSS_LOG_INFO("Add static Twice NAT conntrack entry with src-ip %s, dst-ip %s, timeout %u",
@@ -501,16 +614,8 @@ void NatMgr::addConntrackStaticTwiceNatEntry(const string &snatKey, const string
              +  " -p udp" + " -t " + to_string(timeout) + " --src " + snatKey + " --sport 1" + " --dst " + dnatKey
              +  " --dport 1" + " -u ASSURED " + REDIRECT_TO_DEV_NULL);
 
-    int ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_INFO("Added the static Twice NAT conntrack entry");
-    }
+    queueConntrackCmd(cmds);
+    SWSS_LOG_INFO("Added the static Twice NAT conntrack entry");
 }
 
 /* To Add a dummy conntrack entry for the Static NAPT entry in the kernel,
@@ -518,7 +623,7 @@ void NatMgr::addConntrackStaticTwiceNatEntry(const string &snatKey, const string
 void NatMgr::addConntrackStaticSingleNaptEntry(const string &key)
 {
     int timeout = NAT_TIMEOUT_MAX;
-    std::string res, prototype, state, cmds = std::string("") + CONNTRACK_CMD;
+    std::string prototype, state, cmds = std::string("") + CONNTRACK_CMD;
     vector<string> keys = tokenize(key, config_db_key_delimiter);
 
     if (keys[1] == to_upper(IP_PROTOCOL_UDP))
@@ -551,23 +656,15 @@ void NatMgr::addConntrackStaticSingleNaptEntry(const string &key)
                  " --src " + keys[0] + " --sport " + keys[2] + " --dst 127.0.0.1 --dport 127 -u ASSURED " +  state + REDIRECT_TO_DEV_NULL);
     }
 
-    int ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_INFO("Added the static NAPT conntrack entry");
-    }
+    queueConntrackCmd(cmds);
+    SWSS_LOG_INFO("Added the static NAPT conntrack entry");
 }
 
 /* To Add a dummy conntrack entry for the Static Twice NAPT entry in the kernel */
 void NatMgr::addConntrackStaticTwiceNaptEntry(const string &snatKey, const string &dnatKey)
 {
     int timeout = NAT_TIMEOUT_MAX;
-    std::string res, prototype, state, cmds = std::string("") + CONNTRACK_CMD;
+    std::string prototype, state, cmds = std::string("") + CONNTRACK_CMD;
     vector<string> snatKeys = tokenize(snatKey, config_db_key_delimiter);
     vector<string> dnatKeys = tokenize(dnatKey, config_db_key_delimiter);
 
@@ -590,22 +687,14 @@ void NatMgr::addConntrackStaticTwiceNaptEntry(const string &snatKey, const strin
              + " --src " + snatKeys[0] + " --sport " + snatKeys[2] + " --dst " + dnatKeys[0] + " --dport " + dnatKeys[2] + " -u ASSURED " 
              +  state + REDIRECT_TO_DEV_NULL);
 
-    int ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_INFO("Added the static Twice NAPT conntrack entry");
-    }
+    queueConntrackCmd(cmds);
+    SWSS_LOG_INFO("Added the static Twice NAPT conntrack entry");
 }
 
 /* To Update a dummy conntrack entry for the Static Single NAT entry in the kernel */
 void NatMgr::updateConntrackStaticSingleNatEntry(const string &key)
 {
-    std::string res, cmds = std::string("") + CONNTRACK_CMD;
+    std::string cmds = std::string("") + CONNTRACK_CMD;
     int timeout = NAT_TIMEOUT_MAX;
 
     if (m_staticNatEntry[key].nat_type == DNAT_NAT_TYPE)
@@ -623,13 +712,13 @@ void NatMgr::updateConntrackStaticSingleNatEntry(const string &key)
         cmds += (" -U --src " + key + " -p udp -t " + to_string(timeout) + REDIRECT_TO_DEV_NULL);
     }
 
-    swss::exec(cmds, res);
+    queueConntrackCmd(cmds);
 }
 
 /* To Update a dummy conntrack entry for the Static Twice NAT entry in the kernel */
 void NatMgr::updateConntrackStaticTwiceNatEntry(const string &snatKey, const string &dnatKey)
 {
-    std::string res, cmds = std::string("") + CONNTRACK_CMD;
+    std::string cmds = std::string("") + CONNTRACK_CMD;
     int timeout = NAT_TIMEOUT_MAX;
 
     SWSS_LOG_INFO("Update static Twice NAT conntrack entry with src-ip %s, dst-ip %s, timeout %u",
@@ -637,14 +726,14 @@ void NatMgr::updateConntrackStaticTwiceNatEntry(const string &snatKey, const str
    
     cmds += (" -U --src " + snatKey + " -p udp -t " + to_string(timeout) + " --dst " + dnatKey + REDIRECT_TO_DEV_NULL);
 
-    swss::exec(cmds, res);
+    queueConntrackCmd(cmds);
 }
 
 /* To update a dummy conntrack entry for the Static NAPT entry in the kernel */
 void NatMgr::updateConntrackStaticSingleNaptEntry(const string &key)
 {
     int timeout = NAT_TIMEOUT_MAX;
-    std::string res, prototype, cmds = std::string("") + CONNTRACK_CMD;
+    std::string prototype, cmds = std::string("") + CONNTRACK_CMD;
     vector<string> keys = tokenize(key, config_db_key_delimiter);
 
     if (keys[1] == to_upper(IP_PROTOCOL_UDP))
@@ -673,14 +762,14 @@ void NatMgr::updateConntrackStaticSingleNaptEntry(const string &key)
         cmds += (" -U --src " + keys[0] + " -p " + prototype + " --sport " + keys[2] + " -t " + to_string(timeout) + REDIRECT_TO_DEV_NULL);
     }
 
-    swss::exec(cmds, res);
+    queueConntrackCmd(cmds);
 }
 
 /* To Update a dummy conntrack entry for the Static Twice NAPT entry in the kernel */
 void NatMgr::updateConntrackStaticTwiceNaptEntry(const string &snatKey, const string &dnatKey)
 {
     int timeout = NAT_TIMEOUT_MAX;
-    std::string res, prototype, cmds = std::string("") + CONNTRACK_CMD;
+    std::string prototype, cmds = std::string("") + CONNTRACK_CMD;
     vector<string> snatKeys = tokenize(snatKey, config_db_key_delimiter);
     vector<string> dnatKeys = tokenize(dnatKey, config_db_key_delimiter);
 
@@ -699,13 +788,13 @@ void NatMgr::updateConntrackStaticTwiceNaptEntry(const string &snatKey, const st
     cmds += (" -U --src " + snatKeys[0] + " --dst " + dnatKeys[0] + " -p udp " + " --sport " + snatKeys[2] + " --dport " + dnatKeys[2]
              + " -p udp -t " + to_string(timeout) + REDIRECT_TO_DEV_NULL);
 
-    swss::exec(cmds, res);
+    queueConntrackCmd(cmds);
 }
 
 /* To Delete conntrack entry for Static Single NAT entry */
 void NatMgr::deleteConntrackStaticSingleNatEntry(const string &key)
 {
-    std::string res, cmds = std::string("") + CONNTRACK_CMD;
+    std::string cmds = std::string("") + CONNTRACK_CMD;
 
     if (m_staticNatEntry[key].nat_type == DNAT_NAT_TYPE)
     {
@@ -720,43 +809,27 @@ void NatMgr::deleteConntrackStaticSingleNatEntry(const string &key)
         cmds += (" -D -s " + key + " -p udp" + REDIRECT_TO_DEV_NULL);
     }
 
-    int ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_INFO("Deleted the Static NAT conntrack entry");
-    }
+    queueConntrackCmd(cmds);
+    SWSS_LOG_INFO("Deleted the Static NAT conntrack entry");
 }
 
 /* To Delete conntrack entry for Static Twice NAT entry */
 void NatMgr::deleteConntrackStaticTwiceNatEntry(const string &snatKey, const string &dnatKey)
 {
-    std::string res, cmds = std::string("") + CONNTRACK_CMD;
+    std::string cmds = std::string("") + CONNTRACK_CMD;
 
     SWSS_LOG_INFO("Delete static Twice NAT conntrack entry with src-ip %s and dst-ip %s", snatKey.c_str(), dnatKey.c_str());
 
     cmds += (" -D -s " + snatKey + " -d " + dnatKey + REDIRECT_TO_DEV_NULL);
 
-    int ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_INFO("Deleted the Static Twice NAT conntrack entry");
-    }
+    queueConntrackCmd(cmds);
+    SWSS_LOG_INFO("Deleted the Static Twice NAT conntrack entry");
 }
 
 /* To Delete conntrack entry for Static Single NAPT entry */
 void NatMgr::deleteConntrackStaticSingleNaptEntry(const string &key)
 {
-    std::string res, prototype, cmds = std::string("") + CONNTRACK_CMD;
+    std::string prototype, cmds = std::string("") + CONNTRACK_CMD;
     vector<string> keys = tokenize(key, config_db_key_delimiter);
 
     if (keys[1] == to_upper(IP_PROTOCOL_UDP))
@@ -783,22 +856,14 @@ void NatMgr::deleteConntrackStaticSingleNaptEntry(const string &key)
         cmds += (" -D -s " + keys[0] + " -p " + prototype + " --sport " + keys[2] + REDIRECT_TO_DEV_NULL);
     }
 
-    int ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_INFO("Deleted the Static NAPT conntrack entry");
-    }
+    queueConntrackCmd(cmds);
+    SWSS_LOG_INFO("Deleted the Static NAPT conntrack entry");
 }
 
 /* To Delete conntrack entry for Static Twice NAPT entry */
 void NatMgr::deleteConntrackStaticTwiceNaptEntry(const string &snatKey, const string &dnatKey)
 {
-    std::string res, prototype, cmds = std::string("") + CONNTRACK_CMD;
+    std::string prototype, cmds = std::string("") + CONNTRACK_CMD;
     vector<string> snatKeys = tokenize(snatKey, config_db_key_delimiter);
     vector<string> dnatKeys = tokenize(dnatKey, config_db_key_delimiter);
 
@@ -816,22 +881,14 @@ void NatMgr::deleteConntrackStaticTwiceNaptEntry(const string &snatKey, const st
 
     cmds += (" -D -s " + snatKeys[0] + " -p " + prototype + " --orig-port-src " + snatKeys[2] + " -d " + dnatKeys[0] + " --orig-port-dst " + dnatKeys[2] + REDIRECT_TO_DEV_NULL);
 
-    int ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_INFO("Deleted the Static Twice NAPT conntrack entry");
-    }
+    queueConntrackCmd(cmds);
+    SWSS_LOG_INFO("Deleted the Static Twice NAPT conntrack entry");
 }
 
 /* To Delete conntrack entries for matching Pool ip address */
 void NatMgr::deleteConntrackDynamicEntries(const string &ip_range)
 {
-    std::string res, cmds;
+    std::string cmds;
 
     uint32_t ipv4_addr_low, ipv4_addr_high, ip, setIp;
     char ipAddr[INET_ADDRSTRLEN];
@@ -868,16 +925,8 @@ void NatMgr::deleteConntrackDynamicEntries(const string &ip_range)
 
         cmds = (std::string("") + CONNTRACK_CMD + " -D -q " + ipAddrString + REDIRECT_TO_DEV_NULL);
 
-        int ret = swss::exec(cmds, res);
-
-        if (ret)
-        {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        }
-        else
-        {
-            SWSS_LOG_INFO("Deleted the dynamic conntrack entry");
-        }
+        queueConntrackCmd(cmds);
+        SWSS_LOG_INFO("Deleted the dynamic conntrack entry");
     }
 }
 
@@ -899,8 +948,6 @@ bool NatMgr::setMangleIptablesRules(const string &opCmd, const string &interface
      * iptables -t mangle -opCmd PREROUTING -i port -j MARK --set-mark nat_zone
      * iptables -t mangle -opCmd POSTROUTING -o port -j MARK --set-mark nat_zone
      */
-    std::string res;
-    int ret;
 
     if (nat_zone.empty())
     {
@@ -912,13 +959,7 @@ bool NatMgr::setMangleIptablesRules(const string &opCmd, const string &interface
           + IPTABLES_CMD + " -t mangle " + "-" + opCmd + " PREROUTING -i " + interface + " -j MARK --set-mark " + nat_zone + " && "
           + IPTABLES_CMD + " -t mangle " + "-" + opCmd + " POSTROUTING -o " + interface + " -j MARK --set-mark " + nat_zone ;
 
-    ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
+    queueIptablesCmds(cmds);
 
     return true;
 }
@@ -929,21 +970,13 @@ bool NatMgr::setFullConeDnatIptablesRule(const string &opCmd)
     /* This rule in the PREROUTING chain should be the default rule at the end of the list
      * iptables -t nat -[A/D] PREROUTING -j DNAT --fullcone
      */
-    std::string res;
-    int ret;
 
     /* In case of fullcone, the --to-destination is ignored by the stack, giving an aribitrary value so that 
      * iptables doesn't fail for PREROUTING/DNAT rule */
     const std::string cmds = std::string("")
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING " + " -j DNAT --to-destination 1.1.1.1 --fullcone";
         
-    ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
+    queueIptablesCmds(cmds);
     return true;
 }
 
@@ -956,9 +989,7 @@ bool NatMgr::setStaticNatIptablesRules(const string &opCmd, const string &interf
      * iptables -t nat -opCmd PREROUTING -m mark --mark zone-value -j DNAT -d external_ip --to-destination internal_ip
      * iptables -t nat -opCmd POSTROUTING -m mark --mark zone-value -j SNAT -s internal_ip --to-source external_ip
      */
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
@@ -968,13 +999,7 @@ bool NatMgr::setStaticNatIptablesRules(const string &opCmd, const string &interf
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING " + markStr + " -j DNAT -d " + external_ip + " --to-destination " + internal_ip + " && "
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -j SNAT -s " + internal_ip + " --to-source " + external_ip ;
         
-        ret = swss::exec(cmds, res);
-
-        if (ret)
-        {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-            return false;
-        }
+        queueIptablesCmds(cmds);
     }
     else
     {
@@ -982,13 +1007,7 @@ bool NatMgr::setStaticNatIptablesRules(const string &opCmd, const string &interf
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING" + " -j DNAT -d " + internal_ip + " --to-destination " + external_ip + " && "
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING" + " -j SNAT -s " + external_ip + " --to-source " + internal_ip ;
 
-        ret = swss::exec(cmds, res);
-
-        if (ret)
-        {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-            return false;
-        }
+        queueIptablesCmds(cmds);
     }
 
     return true;
@@ -1004,9 +1023,7 @@ bool NatMgr::setStaticNaptIptablesRules(const string &opCmd, const string &inter
      * iptables -t nat -opCmd PREROUTING -m mark --mark zone-value -p prototype -j DNAT -d external_ip --dport external_port --to-destination internal_ip:internal_port
      * iptables -t nat -opCmd POSTROUTING -m mark --mark zone-value -p prototype -j SNAT -s internal_ip --sport internal_port --to-source external_ip:external_port
      */
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
@@ -1018,13 +1035,7 @@ bool NatMgr::setStaticNaptIptablesRules(const string &opCmd, const string &inter
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -p " + prototype + " -j SNAT -s " + internal_ip + " --sport " + internal_port + " --to-source " 
           + external_ip + ":" + external_port;
 
-        ret = swss::exec(cmds, res);
-
-        if (ret)
-        {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-            return false;
-        }
+        queueIptablesCmds(cmds);
     }
     else
     {
@@ -1034,13 +1045,7 @@ bool NatMgr::setStaticNaptIptablesRules(const string &opCmd, const string &inter
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING" + " -p " + prototype + " -j SNAT -s " + external_ip + " --sport " + external_port + " --to-source "
           + internal_ip + ":" + internal_port;
 
-        ret = swss::exec(cmds, res);
-
-        if (ret)
-        {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-            return false;
-        }
+        queueIptablesCmds(cmds);
     }
 
     return true;
@@ -1060,9 +1065,7 @@ bool NatMgr::setStaticTwiceNatIptablesRules(const string &opCmd, const string &i
      * iptables -t nat -opCmd POSTROUTING -m mark --mark zone-value -j SNAT -s translated_dst --to-source dst -d src 
      */
 
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
@@ -1076,13 +1079,7 @@ bool NatMgr::setStaticTwiceNatIptablesRules(const string &opCmd, const string &i
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -j SNAT -s " + translated_dest_ip
           + " --to-source " + dest_ip + " -d " + src_ip;
 
-    ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
+    queueIptablesCmds(cmds);
 
     return true;
 }
@@ -1106,9 +1103,7 @@ bool NatMgr::setStaticTwiceNaptIptablesRules(const string &opCmd, const string &
      * -d src --dport src_l4_port
      */
 
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
@@ -1122,13 +1117,7 @@ bool NatMgr::setStaticTwiceNaptIptablesRules(const string &opCmd, const string &
           + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -p " + prototype + " -j SNAT -s " + translated_dest_ip + " --sport " + translated_dest_port
           + " --to-source " + dest_ip + ":" + dest_port + " -d " + src_ip + " --dport " +src_port;
 
-    ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
+    queueIptablesCmds(cmds);
 
     return true;
 }
@@ -1145,7 +1134,7 @@ bool NatMgr::setDynamicNatIptablesRulesWithoutAcl(const string &opCmd, const str
      * iptables -t nat -opCmd POSTROUTING -p udp -j SNAT -m mark --mark zone-value --to-source external_ip:external_port_range --fullcone
      * iptables -t nat -opCmd POSTROUTING -p icmp -j SNAT -m mark --mark zone-value --to-source external_ip:external_port_range --fullcone
      */
-    std::string res, cmd;
+    std::string cmd;
     std::string externalString = EMPTY_STRING;
     std::string fullcone = EMPTY_STRING;
     std::string prototype = EMPTY_STRING;
@@ -1219,12 +1208,7 @@ bool NatMgr::setDynamicNatIptablesRulesWithoutAcl(const string &opCmd, const str
         }
     }
 
-    int ret = swss::exec(cmds, res);
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
+    queueIptablesCmds(cmds);
 
     return true;
 }
@@ -1247,7 +1231,7 @@ bool NatMgr::setDynamicNatIptablesRulesWithAcl(const string &opCmd, const string
      * iptables -t nat -opCmd POSTROUTING -p icmp srcIpAddressString -j SNAT -m mark --mark zone-value --to-source external_ip:external_port_range --fullcone
      */
 
-    std::string res, cmd;
+    std::string cmd;
     std::string srcIpAddressString = EMPTY_STRING, dstIpAddressString = EMPTY_STRING;
     std::string srcPortString = EMPTY_STRING, dstPortString = EMPTY_STRING;
     std::string externalString = EMPTY_STRING, fullcone = EMPTY_STRING;
@@ -1448,12 +1432,7 @@ bool NatMgr::setDynamicNatIptablesRulesWithAcl(const string &opCmd, const string
         }
     }
 
-    int ret = swss::exec(cmds, res);
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
+    queueIptablesCmds(cmds);
 
     return true;
 }
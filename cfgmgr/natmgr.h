@@ -252,6 +252,9 @@ public:
     void removeStaticNaptIptables(const std::string port = NONE_STRING);
     void removeDynamicNatRules(const std::string port = NONE_STRING, const std::string ipPrefix = NONE_STRING);
 
+    /* Commit the iptables rules and conntrack commands queued since the last flush */
+    void flush();
+
 private:
     /* Declare APPL_DB, CFG_DB and STATE_DB tables */
     ProducerStateTable m_appNatTableProducer, m_appNaptTableProducer, m_appNatGlobalTableProducer;
@@ -276,6 +279,10 @@ private:
     natDnatPool_map_t        m_natDnatPoolInfo;
     SelectableTimer          *m_natRefreshTimer;
 
+    /* Kernel commands queued by the current batch, committed by flush() */
+    std::vector<std::string> m_iptablesCmds;
+    std::vector<std::string> m_conntrackCmds;
+
     /* Declare doTask related functions */
     void doTask(Consumer &consumer);
     void doTask(SelectableTimer &timer);
@@ -294,6 +301,8 @@ private:
     void disableNatFeature(void);
     bool warmBootingInProgress(void);
     void flushAllNatEntries(void);
+    void queueIptablesCmds(const std::string &cmds);
+    void queueConntrackCmd(const std::string &cmd);
     void addAllStaticConntrackEntries(void);
     void addConntrackStaticSingleNatEntry(const std::string &key);
     void addConntrackStaticSingleNaptEntry(const std::string &key);
@@ -94,6 +94,7 @@ void cleanup()
 
         natmgr->cleanupMangleIpTables();
         natmgr->cleanupPoolIpTable();
+        natmgr->flush();
     }
 }
 
@@ -173,10 +174,8 @@ int main(int argc, char **argv)
 
                timeoutNotificationsConsumer->pop(op, data, values);
                natmgr->timeoutNotifications(op, data);
-               continue;
             }
-
-            if (sel == flushNotificationsConsumer)
+            else if (sel == flushNotificationsConsumer)
             {
                std::string op;
                std::string data;
@@ -184,17 +183,19 @@ int main(int argc, char **argv)
 
                flushNotificationsConsumer->pop(op, data, values);
                natmgr->flushNotifications(op, data);
-               continue;
             }
-
-            if (ret == Select::TIMEOUT)
+            else if (ret == Select::TIMEOUT)
             {
                 natmgr->doTask();
-                continue;
+            }
+            else
+            {
+                auto *c = (Executor *)sel;
+                c->execute();
             }
 
-            auto *c = (Executor *)sel;
-            c->execute();
+            /* Commit the iptables and conntrack changes of this batch at once */
+            natmgr->flush();
         }
 
         cleanup();
@@ -1,7 +1,9 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <net/if.h>
+#include <sys/socket.h>
 #include <unistd.h>
+#include <algorithm>
 #include <netlink/cache.h>
 
 #include "logger.h"
@@ -9,8 +11,6 @@
 #include "ipprefix.h"
 #include "macaddress.h"
 #include "nbrmgr.h"
-#include "exec.h"
-#include "shellcmd.h"
 #include "subscriberstatetable.h"
 
 using namespace swss;
@@ -51,6 +51,8 @@ NbrMgr::NbrMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, con
 {
     int err = 0;
 
+    m_resolveRefill = std::chrono::steady_clock::now();
+
     m_nl_sock = nl_socket_alloc();
     if (!m_nl_sock)
     {
@@ -110,25 +112,26 @@ bool NbrMgr::isNeighRestoreDone()
     return false;
 }
 
-bool NbrMgr::setNeighbor(const string& alias, const IpAddress& ip, const MacAddress& mac)
+/*
+ * Build a RTM_NEWNEIGH request, a permanent neighbor when mac is set or a
+ * request to resolve the neighbor when it is not.
+ */
+struct nl_msg *NbrMgr::buildNeighMsg(const string& alias, const IpAddress& ip, const MacAddress& mac,
+                                     uint32_t seq, int flags)
 {
-    SWSS_LOG_ENTER();
-
     struct nl_msg *msg = nlmsg_alloc();
     if (!msg)
     {
         SWSS_LOG_ERROR("Netlink message alloc failed for '%s'", ip.to_string().c_str());
-        return false;
+        return NULL;
     }
 
-    auto flags = (NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE | NLM_F_REPLACE);
-
-    struct nlmsghdr *hdr = nlmsg_put(msg, NL_AUTO_PORT, NL_AUTO_SEQ, RTM_NEWNEIGH, 0, flags);
+    struct nlmsghdr *hdr = nlmsg_put(msg, NL_AUTO_PORT, seq, RTM_NEWNEIGH, 0, flags);
     if (!hdr)
     {
         SWSS_LOG_ERROR("Netlink message header alloc failed for '%s'", ip.to_string().c_str());
         nlmsg_free(msg);
-        return false;
+        return NULL;
     }
 
     struct ndmsg *nd_msg = static_cast<struct ndmsg *>
@@ -137,7 +140,7 @@ bool NbrMgr::setNeighbor(const string& alias, const IpAddress& ip, const MacAddr
     {
         SWSS_LOG_ERROR("Netlink ndmsg reserve failed for '%s'", ip.to_string().c_str());
         nlmsg_free(msg);
-        return false;
+        return NULL;
     }
 
     memset(nd_msg, 0, sizeof(struct ndmsg));
@@ -152,7 +155,7 @@ bool NbrMgr::setNeighbor(const string& alias, const IpAddress& ip, const MacAddr
     {
         SWSS_LOG_ERROR("Netlink rtattr (IP) failed for '%s'", ip.to_string().c_str());
         nlmsg_free(msg);
-        return false;
+        return NULL;
     }
 
     rta->rta_type = NDA_DST;
@@ -197,7 +200,7 @@ bool NbrMgr::setNeighbor(const string& alias, const IpAddress& ip, const MacAddr
         {
             SWSS_LOG_ERROR("Netlink rtattr (MAC) failed for '%s'", ip.to_string().c_str());
             nlmsg_free(msg);
-            return false;
+            return NULL;
         }
 
         rta->rta_type = NDA_LLADDR;
@@ -205,9 +208,143 @@ bool NbrMgr::setNeighbor(const string& alias, const IpAddress& ip, const MacAddr
         memcpy(RTA_DATA(rta), mac_addr, mac_len);
     }
 
+    return msg;
+}
+
+bool NbrMgr::setNeighbor(const string& alias, const IpAddress& ip, const MacAddress& mac)
+{
+    SWSS_LOG_ENTER();
+
+    auto flags = (NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE | NLM_F_REPLACE);
+
+    struct nl_msg *msg = buildNeighMsg(alias, ip, mac, NL_AUTO_SEQ, flags);
+    if (!msg)
+    {
+        return false;
+    }
+
     return send_message(m_nl_sock, msg);
 }
 
+/*
+ * Append a resolve request to the pending batch, the batch is sent when
+ * full or by flushResolves(). The requests are not acked, only the errors
+ * are returned by the kernel.
+ */
+bool NbrMgr::queueResolve(const string& alias, const IpAddress& ip)
+{
+    SWSS_LOG_ENTER();
+
+    auto flags = (NLM_F_REQUEST | NLM_F_CREATE | NLM_F_REPLACE);
+
+    struct nl_msg *msg = buildNeighMsg(alias, ip, MacAddress(), ++m_resolveSeq, flags);
+    if (!msg)
+    {
+        return false;
+    }
+
+    struct nlmsghdr *hdr = nlmsg_hdr(msg);
+    size_t len = NLMSG_ALIGN(hdr->nlmsg_len);
+
+    bool rc = true;
+    if (m_resolveBatch.size() + len > NBR_RESOLVE_BATCH_BYTES)
+    {
+        rc = flushResolves();
+    }
+
+    auto data = reinterpret_cast<const uint8_t *>(hdr);
+    m_resolveBatch.insert(m_resolveBatch.end(), data, data + len);
+    nlmsg_free(msg);
+
+    return rc;
+}
+
+/* Send the pending resolve requests as one datagram */
+bool NbrMgr::flushResolves()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_resolveBatch.empty())
+    {
+        return true;
+    }
+
+    bool rc = true;
+    int err;
+
+    if (!m_nl_sock)
+    {
+        SWSS_LOG_ERROR("Netlink socket null pointer");
+        rc = false;
+    }
+    else if ((err = nl_sendto(m_nl_sock, m_resolveBatch.data(), m_resolveBatch.size())) < 0)
+    {
+        SWSS_LOG_ERROR("Netlink send of %zu bytes of resolve requests failed, error '%s'",
+                       m_resolveBatch.size(), nl_geterror(err));
+        rc = false;
+    }
+
+    m_resolveBatch.clear();
+    drainReplies();
+
+    return rc;
+}
+
+/* Discard the errors returned for the resolve requests, they would fill the socket buffer */
+void NbrMgr::drainReplies()
+{
+    if (!m_nl_sock)
+    {
+        return;
+    }
+
+    int fd = nl_socket_get_fd(m_nl_sock);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    char buf[8192];
+    size_t errors = 0;
+    ssize_t len;
+
+    while ((len = recv(fd, buf, sizeof(buf), MSG_DONTWAIT)) > 0)
+    {
+        int remaining = static_cast<int>(len);
+        for (auto hdr = reinterpret_cast<struct nlmsghdr *>(buf);
+             NLMSG_OK(hdr, remaining); hdr = NLMSG_NEXT(hdr, remaining))
+        {
+            if (hdr->nlmsg_type == NLMSG_ERROR &&
+                reinterpret_cast<struct nlmsgerr *>(NLMSG_DATA(hdr))->error != 0)
+            {
+                errors++;
+            }
+        }
+    }
+
+    if (errors)
+    {
+        SWSS_LOG_INFO("%zu neighbor requests were rejected by the kernel", errors);
+    }
+}
+
+/* Credit the resolve requests allowed since the last refill, at most one second worth */
+void NbrMgr::refillResolveTokens()
+{
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = now - m_resolveRefill;
+    m_resolveRefill = now;
+
+    m_resolveTokens = std::min(m_resolveRate, m_resolveTokens + elapsed.count() * m_resolveRate);
+}
+
+bool NbrMgr::hasPendingResolves()
+{
+    auto consumer = dynamic_cast<Consumer *>(getExecutor(APP_NEIGH_RESOLVE_TABLE_NAME));
+
+    return consumer && !consumer->m_toSync.empty();
+}
+
 /**
  * Parse APPL_DB neighbors resolve table.
  *
@@ -259,11 +396,10 @@ void NbrMgr::reconcileNeighResolveTable(DBConnector *appDb)
 
             vector<string> parsedKeys = parseAliasIp(key, tableSeparator.c_str());
 
-            MacAddress mac;
             IpAddress ip(parsedKeys[1]);
             string alias(parsedKeys[0]);
 
-            if (!setNeighbor(alias, ip, mac))
+            if (!queueResolve(alias, ip))
             {
                 SWSS_LOG_WARN("Neigh entry resolve failed for '%s' during reconciliation", key.c_str());
             }
@@ -279,12 +415,25 @@ void NbrMgr::reconcileNeighResolveTable(DBConnector *appDb)
             continue;
         }
     }
+
+    if (!flushResolves())
+    {
+        SWSS_LOG_WARN("Neigh entries resolve failed during reconciliation");
+    }
 }
 
+/*
+ * Send the resolve requests of the batch in as few netlink datagrams as
+ * possible, at the adaptive resolve rate. Requests above the rate are left
+ * in m_toSync and served on the next round.
+ */
 void NbrMgr::doResolveNeighTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    refillResolveTokens();
+
+    size_t queued = 0;
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -296,18 +445,38 @@ void NbrMgr::doResolveNeighTask(Consumer &consumer)
             continue;
         }
 
+        if (m_resolveTokens < 1)
+        {
+            break;
+        }
+
         vector<string>            keys = parseAliasIp(kfvKey(t), consumer.getConsumerTable()->getTableNameSeparator().c_str());
 
-        MacAddress                mac;
         IpAddress                 ip(keys[1]);
         string                    alias(keys[0]);
 
-        if (!setNeighbor(alias, ip, mac))
+        if (!queueResolve(alias, ip))
         {
             SWSS_LOG_ERROR("Neigh entry resolve failed for '%s'", kfvKey(t).c_str());
         }
+        m_resolveTokens -= 1;
+        queued++;
         it = consumer.m_toSync.erase(it);
     }
+
+    if (!flushResolves())
+    {
+        // The kernel does not keep up, slow down
+        m_resolveRate = std::max<double>(NBR_RESOLVE_RATE_MIN, m_resolveRate / 2);
+        m_resolveTokens = std::min(m_resolveTokens, m_resolveRate);
+        SWSS_LOG_NOTICE("Neigh resolve rate lowered to %.0f/s", m_resolveRate);
+    }
+    else if (it != consumer.m_toSync.end())
+    {
+        // Requests are held back, speed up
+        m_resolveRate = std::min<double>(NBR_RESOLVE_RATE_MAX, m_resolveRate * 5 / 4);
+        SWSS_LOG_INFO("Neigh resolve rate raised to %.0f/s, %zu requests sent", m_resolveRate, queued);
+    }
 }
 
 void NbrMgr::doSetNeighTask(Consumer &consumer)
@@ -469,7 +638,7 @@ void NbrMgr::doStateSystemNeighTask(Consumer &consumer)
                 SWSS_LOG_INFO("Route entry add on dev %s failed for '%s'", nbr_odev.c_str(), kfvKey(t).c_str());
                 delKernelNeigh(nbr_odev, ip_address);
                 // Delete route to take care of deletion of exiting route of nbr for mac change.
-                delKernelRoute(ip_address);
+                delKernelRoute(nbr_odev, ip_address);
                 it++;
                 continue;
             }
@@ -481,7 +650,7 @@ void NbrMgr::doStateSystemNeighTask(Consumer &consumer)
         }
         else if (op == DEL_COMMAND)
         {
-            if (!delKernelRoute(ip_address))
+            if (!delKernelRoute(nbr_odev, ip_address))
             {
                 SWSS_LOG_ERROR("Route entry on dev %s delete failed for '%s'", nbr_odev.c_str(), kfvKey(t).c_str());
             }
@@ -551,16 +720,15 @@ bool NbrMgr::getVoqInbandInterfaceName(string &ibif, string &type)
 
 bool NbrMgr::addKernelRoute(string odev, IpAddress ip_addr)
 {
-    string cmd, res;
-
     SWSS_LOG_ENTER();
 
     string ip_str = ip_addr.to_string();
+    int err;
 
     if(ip_addr.isV4())
     {
-        cmd = string("") + IP_CMD + " route add " + ip_str + "/32 dev " + odev;
-        SWSS_LOG_NOTICE("IPv4 Route Add cmd: %s",cmd.c_str());
+        SWSS_LOG_NOTICE("IPv4 Route Add: %s/32 dev %s", ip_str.c_str(), odev.c_str());
+        err = m_netDev.addRoute(IpPrefix(ip_str + "/32"), odev);
     }
     else
     {
@@ -569,16 +737,14 @@ bool NbrMgr::addKernelRoute(string odev, IpAddress ip_addr)
         // via eBGP and iBGP over the internal inband port be part of same ecmp group.
         // For v4 both the metrics (connected and static) are default 0 so we do not need
         // to set the metric explicitly.
-        cmd = string("") + IP_CMD + " -6 route add " + ip_str + "/128 dev " + odev + " metric 256";
-        SWSS_LOG_NOTICE("IPv6 Route Add cmd: %s",cmd.c_str());
+        SWSS_LOG_NOTICE("IPv6 Route Add: %s/128 dev %s metric 256", ip_str.c_str(), odev.c_str());
+        err = m_netDev.addRoute(IpPrefix(ip_str + "/128"), odev, 256);
     }
 
-    int32_t ret = swss::exec(cmd, res);
-
-    if(ret)
+    if(err < 0)
     {
         /* This failure the caller expects is due to mac move */
-        SWSS_LOG_INFO("Failed to add route for %s, error: %d", ip_str.c_str(), ret);
+        SWSS_LOG_INFO("Failed to add route for %s, error: %s", ip_str.c_str(), nl_geterror(err));
         return false;
     }
 
@@ -586,31 +752,21 @@ bool NbrMgr::addKernelRoute(string odev, IpAddress ip_addr)
     return true;
 }
 
-bool NbrMgr::delKernelRoute(IpAddress ip_addr)
+bool NbrMgr::delKernelRoute(string odev, IpAddress ip_addr)
 {
-    string cmd, res;
-
     SWSS_LOG_ENTER();
 
     string ip_str = ip_addr.to_string();
+    IpPrefix prefix(ip_str + (ip_addr.isV4() ? "/32" : "/128"));
 
-    if(ip_addr.isV4())
-    {
-        cmd = string("") + IP_CMD + " route del " + ip_str + "/32";
-        SWSS_LOG_NOTICE("IPv4 Route Del cmd: %s",cmd.c_str());
-    }
-    else
-    {
-        cmd = string("") + IP_CMD + " -6 route del " + ip_str + "/128";
-        SWSS_LOG_NOTICE("IPv6 Route Del cmd: %s",cmd.c_str());
-    }
+    SWSS_LOG_NOTICE("%s Route Del: %s", ip_addr.isV4() ? "IPv4" : "IPv6", prefix.to_string().c_str());
 
-    int32_t ret = swss::exec(cmd, res);
+    int err = m_netDev.delRoute(prefix, odev);
 
-    if(ret)
+    if(err < 0)
     {
         /* Just log error and return */
-        SWSS_LOG_ERROR("Failed to delete route for %s, error: %d", ip_str.c_str(), ret);
+        SWSS_LOG_ERROR("Failed to delete route for %s, error: %s", ip_str.c_str(), nl_geterror(err));
         return false;
     }
 
@@ -622,27 +778,18 @@ bool NbrMgr::addKernelNeigh(string odev, IpAddress ip_addr, MacAddress mac_addr)
 {
     SWSS_LOG_ENTER();
 
-    string cmd, res;
     string ip_str = ip_addr.to_string();
     string mac_str = mac_addr.to_string();
 
-    if(ip_addr.isV4())
-    {
-        cmd = string("") + IP_CMD + " neigh add " + ip_str + " lladdr " + mac_str + " dev " + odev;
-        SWSS_LOG_NOTICE("IPv4 Nbr Add cmd: %s",cmd.c_str());
-    }
-    else
-    {
-        cmd = string("") + IP_CMD + " -6 neigh add " + ip_str + " lladdr " + mac_str + " dev " + odev;
-        SWSS_LOG_NOTICE("IPv6 Nbr Add cmd: %s",cmd.c_str());
-    }
+    SWSS_LOG_NOTICE("%s Nbr Add: %s lladdr %s dev %s", ip_addr.isV4() ? "IPv4" : "IPv6",
+                    ip_str.c_str(), mac_str.c_str(), odev.c_str());
 
-    int32_t ret = swss::exec(cmd, res);
+    int err = m_netDev.addNeigh(odev, ip_addr, mac_addr);
 
-    if(ret)
+    if(err < 0)
     {
         /* This failure the caller expects is due to mac move */
-        SWSS_LOG_INFO("Failed to add Nbr for %s, error: %d", ip_str.c_str(), ret);
+        SWSS_LOG_INFO("Failed to add Nbr for %s, error: %s", ip_str.c_str(), nl_geterror(err));
         return false;
     }
 
@@ -652,29 +799,18 @@ bool NbrMgr::addKernelNeigh(string odev, IpAddress ip_addr, MacAddress mac_addr)
 
 bool NbrMgr::delKernelNeigh(string odev, IpAddress ip_addr)
 {
-    string cmd, res;
-
     SWSS_LOG_ENTER();
 
     string ip_str = ip_addr.to_string();
 
-    if(ip_addr.isV4())
-    {
-        cmd = string("") + IP_CMD + " neigh del " + ip_str + " dev " + odev;
-        SWSS_LOG_NOTICE("IPv4 Nbr Del cmd: %s",cmd.c_str());
-    }
-    else
-    {
-        cmd = string("") + IP_CMD + " -6 neigh del " + ip_str + " dev " + odev;
-        SWSS_LOG_NOTICE("IPv6 Nbr Del cmd: %s",cmd.c_str());
-    }
+    SWSS_LOG_NOTICE("%s Nbr Del: %s dev %s", ip_addr.isV4() ? "IPv4" : "IPv6", ip_str.c_str(), odev.c_str());
 
-    int32_t ret = swss::exec(cmd, res);
+    int err = m_netDev.delNeigh(odev, ip_addr);
 
-    if(ret)
+    if(err < 0)
     {
         /* Just log error and return */
-        SWSS_LOG_ERROR("Failed to delete Nbr for %s, error: %d", ip_str.c_str(), ret);
+        SWSS_LOG_ERROR("Failed to delete Nbr for %s, error: %s", ip_str.c_str(), nl_geterror(err));
         return false;
     }
 
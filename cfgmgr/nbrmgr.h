@@ -4,11 +4,26 @@
 #include <string>
 #include <map>
 #include <set>
+#include <vector>
+#include <chrono>
 
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
 #include "netmsg.h"
+#include "netdevhelper.h"
+
+/* Resolve requests sent to the kernel in one netlink datagram */
+#define NBR_RESOLVE_BATCH_BYTES     32768
+
+/*
+ * Bounds of the resolve rate, in requests per second. The rate starts at
+ * the initial value, grows while a backlog of requests is waiting and is
+ * halved when the kernel does not take a batch.
+ */
+#define NBR_RESOLVE_RATE_MIN        100
+#define NBR_RESOLVE_RATE_INITIAL    1000
+#define NBR_RESOLVE_RATE_MAX        16000
 
 using namespace std;
 
@@ -21,11 +36,19 @@ public:
     using Orch::doTask;
 
     bool isNeighRestoreDone();
+    /* Resolve requests held back by the rate limit, to be served shortly */
+    bool hasPendingResolves();
 
 private:
     void reconcileNeighResolveTable(DBConnector *appDb);
     bool isIntfStateOk(const std::string &alias);
     bool setNeighbor(const std::string& alias, const IpAddress& ip, const MacAddress& mac);
+    struct nl_msg *buildNeighMsg(const std::string& alias, const IpAddress& ip, const MacAddress& mac,
+                                 uint32_t seq, int flags);
+    bool queueResolve(const std::string& alias, const IpAddress& ip);
+    bool flushResolves();
+    void drainReplies();
+    void refillResolveTokens();
 
     vector<string> parseAliasIp(const string &app_db_nbr_tbl_key, const char *delimiter);
 
@@ -35,7 +58,7 @@ private:
     void doStateSystemNeighTask(Consumer &consumer);
     bool getVoqInbandInterfaceName(string &nbr_odev, string &ibiftype);
     bool addKernelRoute(string odev, IpAddress ip_addr);
-    bool delKernelRoute(IpAddress ip_addr);
+    bool delKernelRoute(string odev, IpAddress ip_addr);
     bool addKernelNeigh(string odev, IpAddress ip_addr, MacAddress mac_addr);
     bool delKernelNeigh(string odev, IpAddress ip_addr);
     bool isIntfOperUp(const std::string &alias);
@@ -43,6 +66,13 @@ private:
 
     Table m_statePortTable, m_stateLagTable, m_stateVlanTable, m_stateIntfTable, m_stateNeighRestoreTable;
     struct nl_sock *m_nl_sock;
+    NetDevHelper m_netDev;
+
+    std::vector<uint8_t> m_resolveBatch;
+    uint32_t m_resolveSeq = 0;
+    double m_resolveRate = NBR_RESOLVE_RATE_INITIAL;
+    double m_resolveTokens = NBR_RESOLVE_RATE_INITIAL;
+    std::chrono::steady_clock::time_point m_resolveRefill;
 };
 
 }
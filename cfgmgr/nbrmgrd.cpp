@@ -19,6 +19,8 @@ using namespace swss;
 
 /* select() function timeout retry time, in millisecond */
 #define SELECT_TIMEOUT 1000
+/* select() timeout while resolve requests are held back by the resolve rate */
+#define RESOLVE_SELECT_TIMEOUT 100
 
 int main(int argc, char **argv)
 {
@@ -74,7 +76,7 @@ int main(int argc, char **argv)
             Selectable *sel;
             int ret;
 
-            ret = s.select(&sel, SELECT_TIMEOUT);
+            ret = s.select(&sel, nbrmgr.hasPendingResolves() ? RESOLVE_SELECT_TIMEOUT : SELECT_TIMEOUT);
             if (ret == Select::ERROR)
             {
                 SWSS_LOG_NOTICE("Error: %s!", strerror(errno));
@@ -0,0 +1,1253 @@
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <linux/if_addr.h>
+#include <linux/if_bridge.h>
+#include <linux/rtnetlink.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+#include <netlink/addr.h>
+#include <netlink/route/addr.h>
+#include <netlink/route/neighbour.h>
+#include <netlink/route/route.h>
+#include <netlink/route/rule.h>
+#include <netlink/route/link/ipip.h>
+#include <netlink/route/link/vlan.h>
+#include <netlink/route/link/vrf.h>
+#include <netlink/route/link/vxlan.h>
+
+#include "logger.h"
+#include "ipaddress.h"
+#include "netdevhelper.h"
+
+using namespace std;
+using namespace swss;
+
+NetDevHelper::NetDevHelper()
+{
+    int err = 0;
+
+    m_nl_sock = nl_socket_alloc();
+    if (!m_nl_sock)
+    {
+        SWSS_LOG_ERROR("Netlink socket alloc failed");
+    }
+    else if ((err = nl_connect(m_nl_sock, NETLINK_ROUTE)) < 0)
+    {
+        SWSS_LOG_ERROR("Netlink socket connect failed, error '%s'", nl_geterror(err));
+        nl_socket_free(m_nl_sock);
+        m_nl_sock = NULL;
+    }
+}
+
+NetDevHelper::~NetDevHelper()
+{
+    if (m_nl_sock)
+    {
+        nl_socket_free(m_nl_sock);
+    }
+}
+
+int NetDevHelper::getIfIndex(const string &alias, int &ifindex)
+{
+    ifindex = (int)if_nametoindex(alias.c_str());
+    if (!ifindex)
+    {
+        SWSS_LOG_INFO("Netdev %s does not exist", alias.c_str());
+        return -NLE_OBJ_NOTFOUND;
+    }
+    return 0;
+}
+
+/*
+ * Send one request and wait for the kernel ack on the shared socket, so
+ * the caller sees the same per-operation result the ip command returned.
+ * Takes ownership of msg.
+ */
+int NetDevHelper::sendRequest(struct nl_msg *msg)
+{
+    int err;
+
+    if (!m_nl_sock)
+    {
+        nlmsg_free(msg);
+        return -NLE_BAD_SOCK;
+    }
+
+    err = nl_send_auto(m_nl_sock, msg);
+    nlmsg_free(msg);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return nl_wait_for_ack(m_nl_sock);
+}
+
+int NetDevHelper::changeLink(const string &alias, struct rtnl_link *changes)
+{
+    struct rtnl_link *orig;
+    struct nl_msg *msg = NULL;
+    int ifindex;
+    int err;
+
+    if ((err = getIfIndex(alias, ifindex)) < 0)
+    {
+        return err;
+    }
+
+    orig = rtnl_link_alloc();
+    if (!orig)
+    {
+        return -NLE_NOMEM;
+    }
+    rtnl_link_set_ifindex(orig, ifindex);
+
+    err = rtnl_link_build_change_request(orig, changes, 0, &msg);
+    rtnl_link_put(orig);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::addDummyLink(const string &alias, uint32_t mtu)
+{
+    struct rtnl_link *link;
+    struct nl_msg *msg = NULL;
+    int err;
+
+    link = rtnl_link_alloc();
+    if (!link)
+    {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_link_set_name(link, alias.c_str());
+    rtnl_link_set_mtu(link, mtu);
+    if ((err = rtnl_link_set_type(link, "dummy")) >= 0)
+    {
+        err = rtnl_link_build_add_request(link, NLM_F_EXCL, &msg);
+    }
+    rtnl_link_put(link);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::addBridgeLink(const string &alias)
+{
+    struct rtnl_link *link;
+    struct nl_msg *msg = NULL;
+    int err;
+
+    link = rtnl_link_alloc();
+    if (!link)
+    {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_link_set_name(link, alias.c_str());
+    if ((err = rtnl_link_set_type(link, "bridge")) >= 0)
+    {
+        err = rtnl_link_build_add_request(link, NLM_F_EXCL, &msg);
+    }
+    rtnl_link_put(link);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+static struct nl_addr *build_nl_addr(const IpAddress &ip, int prefixLen);
+
+static int parse_nl_addr(const string &str, struct nl_addr **addr)
+{
+    try
+    {
+        *addr = build_nl_addr(IpAddress(str), -1);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        SWSS_LOG_ERROR("Invalid IP address %s", str.c_str());
+        return -NLE_INVAL;
+    }
+
+    return *addr ? 0 : -NLE_NOMEM;
+}
+
+int NetDevHelper::addVxlanLink(const string &alias, uint32_t vni, const string &local,
+                               const string &remote, uint16_t dstPort, const string &master,
+                               const MacAddress &mac, bool learning)
+{
+    struct rtnl_link *link;
+    struct nl_addr *addr = NULL;
+    struct nl_msg *msg = NULL;
+    int masterIndex = 0;
+    int err;
+
+    if (!master.empty() && (err = getIfIndex(master, masterIndex)) < 0)
+    {
+        return err;
+    }
+
+    link = rtnl_link_vxlan_alloc();
+    if (!link)
+    {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_link_set_name(link, alias.c_str());
+    if (masterIndex)
+    {
+        rtnl_link_set_master(link, masterIndex);
+    }
+    if (mac)
+    {
+        addr = nl_addr_build(AF_LLC, mac.getMac(), ETHER_ADDR_LEN);
+        if (!addr)
+        {
+            rtnl_link_put(link);
+            return -NLE_NOMEM;
+        }
+        rtnl_link_set_addr(link, addr);
+        nl_addr_put(addr);
+    }
+
+    if ((err = rtnl_link_vxlan_set_id(link, vni)) >= 0 &&
+        (err = rtnl_link_vxlan_set_port(link, dstPort)) >= 0 &&
+        (err = rtnl_link_vxlan_set_learning(link, learning ? 1 : 0)) >= 0 &&
+        !local.empty() && (err = parse_nl_addr(local, &addr)) >= 0)
+    {
+        err = rtnl_link_vxlan_set_local(link, addr);
+        nl_addr_put(addr);
+    }
+    if (err >= 0 && !remote.empty() && (err = parse_nl_addr(remote, &addr)) >= 0)
+    {
+        /* A unicast remote goes in the same attribute as a multicast group */
+        err = rtnl_link_vxlan_set_group(link, addr);
+        nl_addr_put(addr);
+    }
+    if (err >= 0)
+    {
+        err = rtnl_link_build_add_request(link, NLM_F_EXCL, &msg);
+    }
+    rtnl_link_put(link);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::addVlanLink(const string &parent, const string &alias, uint16_t vlanId,
+                              const MacAddress &mac, bool up)
+{
+    struct rtnl_link *link;
+    struct nl_msg *msg = NULL;
+    int ifindex;
+    int err;
+
+    if ((err = getIfIndex(parent, ifindex)) < 0)
+    {
+        return err;
+    }
+
+    link = rtnl_link_vlan_alloc();
+    if (!link)
+    {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_link_set_name(link, alias.c_str());
+    rtnl_link_set_link(link, ifindex);
+    if (up)
+    {
+        rtnl_link_set_flags(link, IFF_UP);
+    }
+    if (mac)
+    {
+        struct nl_addr *addr = nl_addr_build(AF_LLC, mac.getMac(), ETHER_ADDR_LEN);
+        if (!addr)
+        {
+            rtnl_link_put(link);
+            return -NLE_NOMEM;
+        }
+        rtnl_link_set_addr(link, addr);
+        nl_addr_put(addr);
+    }
+    if ((err = rtnl_link_vlan_set_id(link, vlanId)) >= 0)
+    {
+        err = rtnl_link_build_add_request(link, NLM_F_EXCL, &msg);
+    }
+    rtnl_link_put(link);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::addVrfLink(const string &alias, uint32_t table, bool up)
+{
+    struct rtnl_link *link;
+    struct nl_msg *msg = NULL;
+    int err;
+
+    link = rtnl_link_vrf_alloc();
+    if (!link)
+    {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_link_set_name(link, alias.c_str());
+    if (up)
+    {
+        rtnl_link_set_flags(link, IFF_UP);
+    }
+    if ((err = rtnl_link_vrf_set_tableid(link, table)) >= 0)
+    {
+        err = rtnl_link_build_add_request(link, NLM_F_EXCL, &msg);
+    }
+    rtnl_link_put(link);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::addIpipLink(const string &alias, const string &local, const string &remote)
+{
+    struct rtnl_link *link;
+    struct nl_msg *msg = NULL;
+    IpAddress localIp, remoteIp;
+    int err;
+
+    try
+    {
+        localIp = IpAddress(local);
+        remoteIp = IpAddress(remote);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        SWSS_LOG_ERROR("Invalid tunnel %s address %s/%s", alias.c_str(), local.c_str(), remote.c_str());
+        return -NLE_INVAL;
+    }
+    if (!localIp.isV4() || !remoteIp.isV4())
+    {
+        return -NLE_AF_NOSUPPORT;
+    }
+
+    link = rtnl_link_ipip_alloc();
+    if (!link)
+    {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_link_set_name(link, alias.c_str());
+    if ((err = rtnl_link_ipip_set_local(link, localIp.getV4Addr())) >= 0 &&
+        (err = rtnl_link_ipip_set_remote(link, remoteIp.getV4Addr())) >= 0)
+    {
+        err = rtnl_link_build_add_request(link, NLM_F_EXCL, &msg);
+    }
+    rtnl_link_put(link);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::delLink(const string &alias)
+{
+    struct rtnl_link *link;
+    struct nl_msg *msg = NULL;
+    int err;
+
+    link = rtnl_link_alloc();
+    if (!link)
+    {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_link_set_name(link, alias.c_str());
+    err = rtnl_link_build_delete_request(link, &msg);
+    rtnl_link_put(link);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::setLinkAdminStatus(const string &alias, bool up)
+{
+    struct rtnl_link *changes;
+    int err;
+
+    changes = rtnl_link_alloc();
+    if (!changes)
+    {
+        return -NLE_NOMEM;
+    }
+
+    if (up)
+    {
+        rtnl_link_set_flags(changes, IFF_UP);
+    }
+    else
+    {
+        rtnl_link_unset_flags(changes, IFF_UP);
+    }
+    err = changeLink(alias, changes);
+    rtnl_link_put(changes);
+
+    return err;
+}
+
+int NetDevHelper::setLinkMtu(const string &alias, uint32_t mtu)
+{
+    struct rtnl_link *changes;
+    int err;
+
+    changes = rtnl_link_alloc();
+    if (!changes)
+    {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_link_set_mtu(changes, mtu);
+    err = changeLink(alias, changes);
+    rtnl_link_put(changes);
+
+    return err;
+}
+
+int NetDevHelper::setLinkMac(const string &alias, const MacAddress &mac)
+{
+    struct rtnl_link *changes;
+    struct nl_addr *addr;
+    int err;
+
+    addr = nl_addr_build(AF_LLC, mac.getMac(), ETHER_ADDR_LEN);
+    if (!addr)
+    {
+        return -NLE_NOMEM;
+    }
+
+    changes = rtnl_link_alloc();
+    if (!changes)
+    {
+        nl_addr_put(addr);
+        return -NLE_NOMEM;
+    }
+
+    rtnl_link_set_addr(changes, addr);
+    err = changeLink(alias, changes);
+    rtnl_link_put(changes);
+    nl_addr_put(addr);
+
+    return err;
+}
+
+int NetDevHelper::setLinkMaster(const string &alias, const string &master)
+{
+    struct rtnl_link *changes;
+    int masterIndex = 0;
+    int err;
+
+    if (!master.empty() && (err = getIfIndex(master, masterIndex)) < 0)
+    {
+        return err;
+    }
+
+    changes = rtnl_link_alloc();
+    if (!changes)
+    {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_link_set_master(changes, masterIndex);
+    err = changeLink(alias, changes);
+    rtnl_link_put(changes);
+
+    return err;
+}
+
+/* Set a bridge port flag, like "bridge link set dev <alias> learning on|off" */
+int NetDevHelper::setBridgePortLearning(const string &alias, bool learning)
+{
+    struct ifinfomsg ifi = {};
+    struct nl_msg *msg;
+    struct nlattr *protinfo;
+    int ifindex;
+    int err;
+
+    if ((err = getIfIndex(alias, ifindex)) < 0)
+    {
+        return err;
+    }
+
+    msg = nlmsg_alloc_simple(RTM_SETLINK, 0);
+    if (!msg)
+    {
+        return -NLE_NOMEM;
+    }
+
+    ifi.ifi_family = AF_BRIDGE;
+    ifi.ifi_index = ifindex;
+    if ((err = nlmsg_append(msg, &ifi, sizeof(ifi), NLMSG_ALIGNTO)) < 0)
+    {
+        nlmsg_free(msg);
+        return err;
+    }
+
+    if (!(protinfo = nla_nest_start(msg, IFLA_PROTINFO | NLA_F_NESTED)) ||
+        (err = nla_put_u8(msg, IFLA_BRPORT_LEARNING, learning ? 1 : 0)) < 0)
+    {
+        nlmsg_free(msg);
+        return -NLE_MSGSIZE;
+    }
+    nla_nest_end(msg, protinfo);
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::getLinksByType(const string &type, vector<string> &aliases)
+{
+    struct nl_cache *cache = NULL;
+    struct nl_object *obj;
+    int err;
+
+    if (!m_nl_sock)
+    {
+        return -NLE_BAD_SOCK;
+    }
+
+    if ((err = rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &cache)) < 0)
+    {
+        return err;
+    }
+
+    for (obj = nl_cache_get_first(cache); obj; obj = nl_cache_get_next(obj))
+    {
+        struct rtnl_link *link = (struct rtnl_link *)obj;
+        const char *kind = rtnl_link_get_type(link);
+
+        if (kind && type == kind)
+        {
+            aliases.push_back(rtnl_link_get_name(link));
+        }
+    }
+    nl_cache_free(cache);
+
+    return 0;
+}
+
+int NetDevHelper::getVrfLinks(map<string, uint32_t> &vrfs)
+{
+    struct nl_cache *cache = NULL;
+    struct nl_object *obj;
+    int err;
+
+    if (!m_nl_sock)
+    {
+        return -NLE_BAD_SOCK;
+    }
+
+    if ((err = rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &cache)) < 0)
+    {
+        return err;
+    }
+
+    for (obj = nl_cache_get_first(cache); obj; obj = nl_cache_get_next(obj))
+    {
+        struct rtnl_link *link = (struct rtnl_link *)obj;
+        uint32_t table;
+
+        if (rtnl_link_is_vrf(link) && rtnl_link_vrf_get_tableid(link, &table) >= 0)
+        {
+            vrfs[rtnl_link_get_name(link)] = table;
+        }
+    }
+    nl_cache_free(cache);
+
+    return 0;
+}
+
+static struct nl_addr *build_nl_addr(const IpAddress &ip, int prefixLen)
+{
+    struct nl_addr *addr;
+    ip_addr_t ip_addr = ip.getIp();
+
+    if (ip.isV4())
+    {
+        addr = nl_addr_build(AF_INET, &ip_addr.ip_addr.ipv4_addr, sizeof(ip_addr.ip_addr.ipv4_addr));
+    }
+    else
+    {
+        addr = nl_addr_build(AF_INET6, ip_addr.ip_addr.ipv6_addr, sizeof(ip_addr.ip_addr.ipv6_addr));
+    }
+
+    if (addr && prefixLen >= 0)
+    {
+        nl_addr_set_prefixlen(addr, prefixLen);
+    }
+    return addr;
+}
+
+/* Build the rtnl_addr object shared by address add and delete requests */
+static int build_rtnl_addr(int ifindex, const IpPrefix &prefix, bool broadcast, struct rtnl_addr **result)
+{
+    struct rtnl_addr *addr;
+    struct nl_addr *local, *brd;
+    int err;
+
+    addr = rtnl_addr_alloc();
+    if (!addr)
+    {
+        return -NLE_NOMEM;
+    }
+
+    local = build_nl_addr(prefix.getIp(), prefix.getMaskLength());
+    if (!local)
+    {
+        rtnl_addr_put(addr);
+        return -NLE_NOMEM;
+    }
+
+    rtnl_addr_set_ifindex(addr, ifindex);
+    rtnl_addr_set_family(addr, prefix.isV4() ? AF_INET : AF_INET6);
+    err = rtnl_addr_set_local(addr, local);
+    nl_addr_put(local);
+    if (err < 0)
+    {
+        rtnl_addr_put(addr);
+        return err;
+    }
+    rtnl_addr_set_prefixlen(addr, prefix.getMaskLength());
+
+    if (broadcast)
+    {
+        brd = build_nl_addr(prefix.getBroadcastIp(), -1);
+        if (!brd)
+        {
+            rtnl_addr_put(addr);
+            return -NLE_NOMEM;
+        }
+        err = rtnl_addr_set_broadcast(addr, brd);
+        nl_addr_put(brd);
+        if (err < 0)
+        {
+            rtnl_addr_put(addr);
+            return err;
+        }
+    }
+
+    *result = addr;
+    return 0;
+}
+
+int NetDevHelper::addAddress(const string &alias, const IpPrefix &prefix, bool broadcast, uint32_t metric)
+{
+    struct rtnl_addr *addr = NULL;
+    struct nl_msg *msg = NULL;
+    int ifindex;
+    int err;
+
+    if ((err = getIfIndex(alias, ifindex)) < 0)
+    {
+        return err;
+    }
+
+    if ((err = build_rtnl_addr(ifindex, prefix, broadcast, &addr)) < 0)
+    {
+        return err;
+    }
+
+    err = rtnl_addr_build_add_request(addr, NLM_F_EXCL, &msg);
+    rtnl_addr_put(addr);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    if (metric && (err = nla_put_u32(msg, IFA_RT_PRIORITY, metric)) < 0)
+    {
+        nlmsg_free(msg);
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::delAddress(const string &alias, const IpPrefix &prefix)
+{
+    struct rtnl_addr *addr = NULL;
+    struct nl_msg *msg = NULL;
+    int ifindex;
+    int err;
+
+    if ((err = getIfIndex(alias, ifindex)) < 0)
+    {
+        return err;
+    }
+
+    if ((err = build_rtnl_addr(ifindex, prefix, false, &addr)) < 0)
+    {
+        return err;
+    }
+
+    err = rtnl_addr_build_delete_request(addr, 0, &msg);
+    rtnl_addr_put(addr);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+/* Build the rtnl_route object shared by route replace and delete requests */
+static int build_rtnl_route(int ifindex, const IpPrefix &prefix, struct rtnl_route **result)
+{
+    struct rtnl_route *route;
+    struct rtnl_nexthop *nh;
+    struct nl_addr *dst;
+    int err;
+
+    route = rtnl_route_alloc();
+    if (!route)
+    {
+        return -NLE_NOMEM;
+    }
+
+    dst = build_nl_addr(prefix.getIp(), prefix.getMaskLength());
+    nh = rtnl_route_nh_alloc();
+    if (!dst || !nh)
+    {
+        if (dst)
+        {
+            nl_addr_put(dst);
+        }
+        if (nh)
+        {
+            rtnl_route_nh_free(nh);
+        }
+        rtnl_route_put(route);
+        return -NLE_NOMEM;
+    }
+
+    rtnl_route_set_family(route, (uint8_t)(prefix.isV4() ? AF_INET : AF_INET6));
+    err = rtnl_route_set_dst(route, dst);
+    nl_addr_put(dst);
+    if (err < 0)
+    {
+        rtnl_route_nh_free(nh);
+        rtnl_route_put(route);
+        return err;
+    }
+    rtnl_route_nh_set_ifindex(nh, ifindex);
+    rtnl_route_add_nexthop(route, nh);
+
+    *result = route;
+    return 0;
+}
+
+int NetDevHelper::replaceRoute(const IpPrefix &prefix, const string &alias)
+{
+    struct rtnl_route *route = NULL;
+    struct nl_msg *msg = NULL;
+    int ifindex;
+    int err;
+
+    if ((err = getIfIndex(alias, ifindex)) < 0)
+    {
+        return err;
+    }
+
+    if ((err = build_rtnl_route(ifindex, prefix, &route)) < 0)
+    {
+        return err;
+    }
+
+    /* Same protocol as the routes added by the ip command */
+    rtnl_route_set_protocol(route, RTPROT_BOOT);
+    err = rtnl_route_build_add_request(route, NLM_F_CREATE | NLM_F_REPLACE, &msg);
+    rtnl_route_put(route);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::addRoute(const IpPrefix &prefix, const string &alias, uint32_t metric)
+{
+    struct rtnl_route *route = NULL;
+    struct nl_msg *msg = NULL;
+    int ifindex;
+    int err;
+
+    if ((err = getIfIndex(alias, ifindex)) < 0)
+    {
+        return err;
+    }
+
+    if ((err = build_rtnl_route(ifindex, prefix, &route)) < 0)
+    {
+        return err;
+    }
+
+    rtnl_route_set_protocol(route, RTPROT_BOOT);
+    if (metric)
+    {
+        rtnl_route_set_priority(route, metric);
+    }
+    err = rtnl_route_build_add_request(route, NLM_F_EXCL, &msg);
+    rtnl_route_put(route);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::delRoute(const IpPrefix &prefix, const string &alias)
+{
+    struct rtnl_route *route = NULL;
+    struct nl_msg *msg = NULL;
+    int ifindex;
+    int err;
+
+    if ((err = getIfIndex(alias, ifindex)) < 0)
+    {
+        return err;
+    }
+
+    if ((err = build_rtnl_route(ifindex, prefix, &route)) < 0)
+    {
+        return err;
+    }
+
+    /* Match the route whatever protocol installed it */
+    rtnl_route_set_protocol(route, RTPROT_UNSPEC);
+    err = rtnl_route_build_del_request(route, 0, &msg);
+    rtnl_route_put(route);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+/* Build the rtnl_neigh object shared by neighbor add and delete requests */
+static int build_rtnl_neigh(int ifindex, const IpAddress &ip, struct rtnl_neigh **result)
+{
+    struct rtnl_neigh *neigh;
+    struct nl_addr *dst;
+    int err;
+
+    neigh = rtnl_neigh_alloc();
+    if (!neigh)
+    {
+        return -NLE_NOMEM;
+    }
+
+    dst = build_nl_addr(ip, -1);
+    if (!dst)
+    {
+        rtnl_neigh_put(neigh);
+        return -NLE_NOMEM;
+    }
+
+    rtnl_neigh_set_ifindex(neigh, ifindex);
+    err = rtnl_neigh_set_dst(neigh, dst);
+    nl_addr_put(dst);
+    if (err < 0)
+    {
+        rtnl_neigh_put(neigh);
+        return err;
+    }
+
+    *result = neigh;
+    return 0;
+}
+
+int NetDevHelper::addNeigh(const string &alias, const IpAddress &ip, const MacAddress &mac)
+{
+    struct rtnl_neigh *neigh = NULL;
+    struct nl_msg *msg = NULL;
+    struct nl_addr *lladdr;
+    int ifindex;
+    int err;
+
+    if ((err = getIfIndex(alias, ifindex)) < 0)
+    {
+        return err;
+    }
+
+    if ((err = build_rtnl_neigh(ifindex, ip, &neigh)) < 0)
+    {
+        return err;
+    }
+
+    lladdr = nl_addr_build(AF_LLC, mac.getMac(), ETHER_ADDR_LEN);
+    if (!lladdr)
+    {
+        rtnl_neigh_put(neigh);
+        return -NLE_NOMEM;
+    }
+    rtnl_neigh_set_lladdr(neigh, lladdr);
+    nl_addr_put(lladdr);
+
+    /* The default state of the ip command */
+    rtnl_neigh_set_state(neigh, NUD_PERMANENT);
+    err = rtnl_neigh_build_add_request(neigh, NLM_F_EXCL, &msg);
+    rtnl_neigh_put(neigh);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::delNeigh(const string &alias, const IpAddress &ip)
+{
+    struct rtnl_neigh *neigh = NULL;
+    struct nl_msg *msg = NULL;
+    int ifindex;
+    int err;
+
+    if ((err = getIfIndex(alias, ifindex)) < 0)
+    {
+        return err;
+    }
+
+    if ((err = build_rtnl_neigh(ifindex, ip, &neigh)) < 0)
+    {
+        return err;
+    }
+
+    err = rtnl_neigh_build_delete_request(neigh, 0, &msg);
+    rtnl_neigh_put(neigh);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::addRule(int family, uint32_t pref, uint32_t table)
+{
+    struct rtnl_rule *rule;
+    struct nl_msg *msg = NULL;
+    int err;
+
+    rule = rtnl_rule_alloc();
+    if (!rule)
+    {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_rule_set_family(rule, family);
+    rtnl_rule_set_prio(rule, pref);
+    rtnl_rule_set_table(rule, table);
+    rtnl_rule_set_action(rule, FR_ACT_TO_TBL);
+    err = rtnl_rule_build_add_request(rule, NLM_F_EXCL, &msg);
+    rtnl_rule_put(rule);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::delRule(int family, uint32_t pref)
+{
+    struct rtnl_rule *rule;
+    struct nl_msg *msg = NULL;
+    int err;
+
+    rule = rtnl_rule_alloc();
+    if (!rule)
+    {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_rule_set_family(rule, family);
+    rtnl_rule_set_prio(rule, pref);
+    err = rtnl_rule_build_delete_request(rule, 0, &msg);
+    rtnl_rule_put(rule);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::getRulePrefs(int family, vector<uint32_t> &prefs)
+{
+    struct nl_cache *cache = NULL;
+    struct nl_object *obj;
+    int err;
+
+    if (!m_nl_sock)
+    {
+        return -NLE_BAD_SOCK;
+    }
+
+    if ((err = rtnl_rule_alloc_cache(m_nl_sock, family, &cache)) < 0)
+    {
+        return err;
+    }
+
+    for (obj = nl_cache_get_first(cache); obj; obj = nl_cache_get_next(obj))
+    {
+        prefs.push_back(rtnl_rule_get_prio((struct rtnl_rule *)obj));
+    }
+    nl_cache_free(cache);
+
+    return 0;
+}
+
+/*
+ * Build one RTM_SETLINK/RTM_DELLINK AF_BRIDGE request carrying all VLANs.
+ * Untagged/tagged runs of consecutive VLAN ids collapse into a range
+ * begin/end pair; PVID entries cannot be part of a range and are appended
+ * last, in the order given, so the last PVID wins as it did when the VLANs
+ * were added one by one.
+ */
+int NetDevHelper::sendBridgeVlans(int type, const string &alias, const vector<BridgeVlan> &vlans, bool self)
+{
+    vector<BridgeVlan> sorted, pvids;
+    vector<struct bridge_vlan_info> infos;
+    struct ifinfomsg ifi = {};
+    struct nlmsghdr *hdr;
+    struct nl_msg *msg;
+    struct nlattr *spec;
+    int ifindex;
+    int err;
+
+    if (vlans.empty())
+    {
+        return 0;
+    }
+
+    if ((err = getIfIndex(alias, ifindex)) < 0)
+    {
+        return err;
+    }
+
+    for (const auto &vlan : vlans)
+    {
+        (vlan.pvid ? pvids : sorted).push_back(vlan);
+    }
+    sort(sorted.begin(), sorted.end(), [](const BridgeVlan &a, const BridgeVlan &b) { return a.vid < b.vid; });
+
+    for (size_t i = 0; i < sorted.size(); )
+    {
+        size_t j = i;
+        while (j + 1 < sorted.size() &&
+               sorted[j + 1].vid == sorted[j].vid + 1 &&
+               sorted[j + 1].untagged == sorted[i].untagged)
+        {
+            j++;
+        }
+
+        uint16_t flags = sorted[i].untagged ? BRIDGE_VLAN_INFO_UNTAGGED : 0;
+        if (j == i)
+        {
+            infos.push_back({flags, sorted[i].vid});
+        }
+        else
+        {
+            infos.push_back({(uint16_t)(flags | BRIDGE_VLAN_INFO_RANGE_BEGIN), sorted[i].vid});
+            infos.push_back({(uint16_t)(flags | BRIDGE_VLAN_INFO_RANGE_END), sorted[j].vid});
+        }
+        i = j + 1;
+    }
+    for (const auto &vlan : pvids)
+    {
+        uint16_t flags = BRIDGE_VLAN_INFO_PVID;
+        if (vlan.untagged)
+        {
+            flags |= BRIDGE_VLAN_INFO_UNTAGGED;
+        }
+        infos.push_back({flags, vlan.vid});
+    }
+
+    msg = nlmsg_alloc_size(NLMSG_HDRLEN + NLMSG_ALIGN(sizeof(ifi)) +
+                           nla_total_size(0) + nla_total_size(sizeof(uint16_t)) +
+                           infos.size() * nla_total_size(sizeof(struct bridge_vlan_info)));
+    if (!msg)
+    {
+        return -NLE_NOMEM;
+    }
+
+    hdr = nlmsg_put(msg, NL_AUTO_PORT, NL_AUTO_SEQ, type, sizeof(ifi), 0);
+    if (!hdr)
+    {
+        nlmsg_free(msg);
+        return -NLE_MSGSIZE;
+    }
+
+    ifi.ifi_family = AF_BRIDGE;
+    ifi.ifi_index = ifindex;
+    memcpy(nlmsg_data(hdr), &ifi, sizeof(ifi));
+
+    if (!(spec = nla_nest_start(msg, IFLA_AF_SPEC)) ||
+        (self && nla_put_u16(msg, IFLA_BRIDGE_FLAGS, BRIDGE_FLAGS_SELF) < 0))
+    {
+        nlmsg_free(msg);
+        return -NLE_MSGSIZE;
+    }
+    for (const auto &info : infos)
+    {
+        if ((err = nla_put(msg, IFLA_BRIDGE_VLAN_INFO, sizeof(info), &info)) < 0)
+        {
+            nlmsg_free(msg);
+            return err;
+        }
+    }
+    nla_nest_end(msg, spec);
+
+    return sendRequest(msg);
+}
+
+int NetDevHelper::addBridgeVlans(const string &alias, const vector<BridgeVlan> &vlans, bool self)
+{
+    return sendBridgeVlans(RTM_SETLINK, alias, vlans, self);
+}
+
+int NetDevHelper::delBridgeVlans(const string &alias, const vector<uint16_t> &vids, bool self)
+{
+    vector<BridgeVlan> vlans;
+
+    for (auto vid : vids)
+    {
+        vlans.push_back({vid, false, false});
+    }
+    return sendBridgeVlans(RTM_DELLINK, alias, vlans, self);
+}
+
+struct BridgeVlanDump
+{
+    int ifindex;
+    int count;
+};
+
+static int count_bridge_vlans(struct nl_msg *msg, void *arg)
+{
+    BridgeVlanDump *dump = static_cast<BridgeVlanDump *>(arg);
+    struct nlmsghdr *hdr = nlmsg_hdr(msg);
+    struct ifinfomsg *ifi;
+    struct nlattr *spec, *attr;
+    int rem;
+
+    if (hdr->nlmsg_type != RTM_NEWLINK)
+    {
+        return NL_OK;
+    }
+
+    ifi = static_cast<struct ifinfomsg *>(nlmsg_data(hdr));
+    if (ifi->ifi_index != dump->ifindex)
+    {
+        return NL_OK;
+    }
+
+    spec = nlmsg_find_attr(hdr, sizeof(*ifi), IFLA_AF_SPEC);
+    if (!spec)
+    {
+        return NL_OK;
+    }
+
+    nla_for_each_nested(attr, spec, rem)
+    {
+        if (nla_type(attr) == IFLA_BRIDGE_VLAN_INFO)
+        {
+            dump->count++;
+        }
+    }
+    return NL_OK;
+}
+
+/* Count the VLANs configured on a bridge port, like "bridge vlan show dev" */
+int NetDevHelper::getBridgeVlanCount(const string &alias, int &count)
+{
+    BridgeVlanDump dump = {0, 0};
+    struct ifinfomsg ifi = {};
+    struct nl_msg *msg;
+    struct nl_cb *cb;
+    int err;
+
+    if ((err = getIfIndex(alias, dump.ifindex)) < 0)
+    {
+        return err;
+    }
+
+    if (!m_nl_sock)
+    {
+        return -NLE_BAD_SOCK;
+    }
+
+    msg = nlmsg_alloc_simple(RTM_GETLINK, NLM_F_DUMP);
+    if (!msg)
+    {
+        return -NLE_NOMEM;
+    }
+
+    ifi.ifi_family = AF_BRIDGE;
+    if ((err = nlmsg_append(msg, &ifi, sizeof(ifi), NLMSG_ALIGNTO)) < 0 ||
+        (err = nla_put_u32(msg, IFLA_EXT_MASK, RTEXT_FILTER_BRVLAN)) < 0)
+    {
+        nlmsg_free(msg);
+        return err;
+    }
+
+    err = nl_send_auto(m_nl_sock, msg);
+    nlmsg_free(msg);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    cb = nl_cb_alloc(NL_CB_DEFAULT);
+    if (!cb)
+    {
+        return -NLE_NOMEM;
+    }
+    nl_cb_set(cb, NL_CB_VALID, NL_CB_CUSTOM, count_bridge_vlans, &dump);
+    err = nl_recvmsgs(m_nl_sock, cb);
+    nl_cb_put(cb);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    count = dump.count;
+    return 0;
+}
@@ -0,0 +1,108 @@
+#ifndef __NETDEVHELPER__
+#define __NETDEVHELPER__
+
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <netlink/netlink.h>
+#include <netlink/route/link.h>
+
+#include "ipaddress.h"
+#include "ipprefix.h"
+#include "macaddress.h"
+
+namespace swss {
+
+struct BridgeVlan
+{
+    uint16_t vid;
+    bool untagged;
+    bool pvid;
+};
+
+/*
+ * Thin libnl wrapper for the link/address operations the cfgmgr daemons
+ * used to fork /sbin/ip for. All requests of one helper go over a single
+ * NETLINK_ROUTE socket that is opened once and kept for the lifetime of
+ * the owner. Every method returns 0 on success or a negative libnl error
+ * code, which can be rendered with nl_geterror().
+ */
+class NetDevHelper
+{
+public:
+    NetDevHelper();
+    ~NetDevHelper();
+
+    NetDevHelper(const NetDevHelper&) = delete;
+    NetDevHelper& operator=(const NetDevHelper&) = delete;
+
+    int addDummyLink(const std::string &alias, uint32_t mtu);
+    int addBridgeLink(const std::string &alias);
+    /*
+     * Create a VXLAN link, optionally enslaved to master at creation time.
+     * Empty local/remote addresses leave the attribute unset.
+     */
+    int addVxlanLink(const std::string &alias, uint32_t vni, const std::string &local,
+                     const std::string &remote, uint16_t dstPort, const std::string &master = "",
+                     const MacAddress &mac = MacAddress(), bool learning = true);
+    int addVlanLink(const std::string &parent, const std::string &alias, uint16_t vlanId,
+                    const MacAddress &mac = MacAddress(), bool up = false);
+    int addVrfLink(const std::string &alias, uint32_t table, bool up = false);
+    /* Create an IPv4 in IPv4 tunnel, like "ip tunnel add <alias> mode ipip" */
+    int addIpipLink(const std::string &alias, const std::string &local, const std::string &remote);
+    int delLink(const std::string &alias);
+
+    int setLinkAdminStatus(const std::string &alias, bool up);
+    int setLinkMtu(const std::string &alias, uint32_t mtu);
+    int setLinkMac(const std::string &alias, const MacAddress &mac);
+    /* An empty master releases the link from its current master */
+    int setLinkMaster(const std::string &alias, const std::string &master);
+    int setBridgePortLearning(const std::string &alias, bool learning);
+
+    /* List the links of a kind ("vxlan", "bridge", ...), like "ip link show type" */
+    int getLinksByType(const std::string &type, std::vector<std::string> &aliases);
+    /* List the VRF links with their routing table */
+    int getVrfLinks(std::map<std::string, uint32_t> &vrfs);
+
+    /* A zero metric leaves the kernel default for the connected route */
+    int addAddress(const std::string &alias, const IpPrefix &prefix, bool broadcast, uint32_t metric = 0);
+    int delAddress(const std::string &alias, const IpPrefix &prefix);
+
+    /* Add or replace a directly connected route in the main table, like "ip route replace <prefix> dev <alias>" */
+    int replaceRoute(const IpPrefix &prefix, const std::string &alias);
+    /* Add a directly connected route, failing if it exists, like "ip route add <prefix> dev <alias> [metric]" */
+    int addRoute(const IpPrefix &prefix, const std::string &alias, uint32_t metric = 0);
+    int delRoute(const IpPrefix &prefix, const std::string &alias);
+
+    /* Add a permanent neighbor, failing if it exists, like "ip neigh add <ip> lladdr <mac> dev <alias>" */
+    int addNeigh(const std::string &alias, const IpAddress &ip, const MacAddress &mac);
+    int delNeigh(const std::string &alias, const IpAddress &ip);
+
+    /* Policy routing rules of an address family, identified by their preference */
+    int addRule(int family, uint32_t pref, uint32_t table);
+    int delRule(int family, uint32_t pref);
+    int getRulePrefs(int family, std::vector<uint32_t> &prefs);
+
+    /*
+     * Add or remove a set of VLANs on a bridge port (or on the bridge itself
+     * when self is set) with a single request. Consecutive VLANs with the
+     * same flags are sent as one range entry.
+     */
+    int addBridgeVlans(const std::string &alias, const std::vector<BridgeVlan> &vlans, bool self = false);
+    int delBridgeVlans(const std::string &alias, const std::vector<uint16_t> &vids, bool self = false);
+    int getBridgeVlanCount(const std::string &alias, int &count);
+
+private:
+    struct nl_sock *m_nl_sock;
+
+    int getIfIndex(const std::string &alias, int &ifindex);
+    int changeLink(const std::string &alias, struct rtnl_link *changes);
+    int sendRequest(struct nl_msg *msg);
+    int sendBridgeVlans(int type, const std::string &alias, const std::vector<BridgeVlan> &vlans, bool self);
+};
+
+}
+
+#endif
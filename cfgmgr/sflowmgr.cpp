@@ -4,7 +4,6 @@
 #include "tokenize.h"
 #include "ipprefix.h"
 #include "sflowmgr.h"
-#include "exec.h"
 #include "shellcmd.h"
 
 using namespace std;
@@ -19,6 +18,9 @@ SflowMgr::SflowMgr(DBConnector *appDb, const std::vector<TableConnector>& tableN
     m_gEnable = false;
     m_gDirection = "rx";
     m_intfAllDir = "rx";
+
+    m_cmdExecutor = new AsyncCmdExecutor(this, "SFLOW_CMD", 1);
+    Orch::addExecutor(m_cmdExecutor);
 }
 
 void SflowMgr::readPortConfig()
@@ -51,7 +53,6 @@ bool SflowMgr::isPortEnabled(const std::string& alias)
 void SflowMgr::sflowHandleService(bool enable)
 {
     stringstream cmd;
-    string res;
 
     SWSS_LOG_ENTER();
 
@@ -64,17 +65,20 @@ void SflowMgr::sflowHandleService(bool enable)
         cmd << "service hsflowd stop";
     }
 
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_NOTICE("Starting hsflowd service");
-        SWSS_LOG_INFO("Command '%s' succeeded", cmd.str().c_str());
-    }
-
+    /* A service restart takes seconds, keep serving the tables meanwhile.
+     * Restarts and stops are run in order, on the same key */
+    string cmd_str = cmd.str();
+    m_cmdExecutor->submit("hsflowd", cmd_str, [cmd_str](int ret, const string &res) {
+        if (ret)
+        {
+            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd_str.c_str(), ret);
+        }
+        else
+        {
+            SWSS_LOG_NOTICE("Starting hsflowd service");
+            SWSS_LOG_INFO("Command '%s' succeeded", cmd_str.c_str());
+        }
+    });
 }
 
 void SflowMgr::sflowUpdatePortInfo(Consumer &consumer)
@@ -3,6 +3,7 @@
 #include "dbconnector.h"
 #include "orch.h"
 #include "producerstatetable.h"
+#include "asynccmdexecutor.h"
 
 #include <map>
 #include <set>
@@ -43,6 +44,8 @@ private:
     bool                   m_gEnable;
     std::string            m_intfAllDir;
     std::string            m_gDirection;
+    /* Runs the hsflowd service commands off the select loop, owned by Orch */
+    AsyncCmdExecutor      *m_cmdExecutor;
 
     void doTask(Consumer &consumer);
     void sflowHandleService(bool enable);
@@ -5,6 +5,7 @@
 #include "tokenize.h"
 #include "warm_restart.h"
 #include "portmgr.h"
+#include "orch_zmq_config.h"
 #include <swss/redisutility.h>
 
 #include <algorithm>
@@ -26,14 +27,16 @@ using namespace swss;
 
 
 TeamMgr::TeamMgr(DBConnector *confDb, DBConnector *applDb, DBConnector *statDb,
-        const vector<TableConnector> &tables) :
+        const vector<TableConnector> &tables, size_t teamdStartThreads) :
     Orch(tables),
     m_cfgMetadataTable(confDb, CFG_DEVICE_METADATA_TABLE_NAME),
     m_cfgPortTable(confDb, CFG_PORT_TABLE_NAME),
     m_cfgLagTable(confDb, CFG_LAG_TABLE_NAME),
     m_cfgLagMemberTable(confDb, CFG_LAG_MEMBER_TABLE_NAME),
     m_appPortTable(applDb, APP_PORT_TABLE_NAME),
-    m_appLagTable(applDb, APP_LAG_TABLE_NAME),
+    // When the feature ORCH_NORTHBOND_LAG_ZMQ_ENABLED is enabled, LAG events must be sent to orchagent via the ZMQ channel.
+    m_zmqClient(create_local_zmq_client(ORCH_NORTHBOND_LAG_ZMQ_ENABLED, false)),
+    m_appLagTable(createProducerStateTable(applDb, APP_LAG_TABLE_NAME, m_zmqClient)),
     m_statePortTable(statDb, STATE_PORT_TABLE_NAME),
     m_stateLagTable(statDb, STATE_LAG_TABLE_NAME),
     m_stateMACsecIngressSATable(statDb, STATE_MACSEC_INGRESS_SA_TABLE_NAME)
@@ -62,6 +65,9 @@ TeamMgr::TeamMgr(DBConnector *confDb, DBConnector *applDb, DBConnector *statDb,
     }
 
     m_mac = MacAddress(it->second);
+
+    m_teamdExecutor = new AsyncCmdExecutor(this, "TEAMD_START", teamdStartThreads);
+    Orch::addExecutor(m_teamdExecutor);
 }
 
 bool TeamMgr::isPortStateOk(const string &alias)
@@ -166,6 +172,17 @@ void TeamMgr::doTask(Consumer &consumer)
     {
         doPortUpdateTask(consumer);
     }
+    else if (table == STATE_LAG_TABLE_NAME)
+    {
+        doLagStateTask(consumer);
+    }
+}
+
+void TeamMgr::waitTeamdStart()
+{
+    SWSS_LOG_ENTER();
+
+    m_teamdExecutor->wait();
 }
 
 void TeamMgr::cleanTeamProcesses()
@@ -173,6 +190,9 @@ void TeamMgr::cleanTeamProcesses()
     SWSS_LOG_ENTER();
     SWSS_LOG_NOTICE("Cleaning up LAGs during shutdown...");
 
+    // LAGs being started are cleaned up as well
+    waitTeamdStart();
+
     std::unordered_map<std::string, int> aliasPidMap;
 
     for (const auto& alias: m_lagList)
@@ -243,6 +263,13 @@ void TeamMgr::doLagTask(Consumer &consumer)
         string alias = kfvKey(t);
         string op = kfvOp(t);
 
+        // The entry is handled once teamd is started, see onLagStarted
+        if (m_lagStarting.find(alias) != m_lagStarting.end())
+        {
+            it++;
+            continue;
+        }
+
         if (op == SET_COMMAND)
         {
             int min_links = 0;
@@ -300,15 +327,9 @@ void TeamMgr::doLagTask(Consumer &consumer)
 
             if (m_lagList.find(alias) == m_lagList.end())
             {
-                if (addLag(alias, min_links, fallback, fast_rate) == task_need_retry)
-                {
-                    // If LAG creation fails, we need to clean up any potentially orphaned teamd processes
-                    removeLag(alias);
-                    it++;
-                    continue;
-                }
-
-                m_lagList.insert(alias);
+                addLag(alias, min_links, fallback, fast_rate);
+                it++;
+                continue;
             }
 
             setLagAdminStatus(alias, admin_status);
@@ -379,6 +400,33 @@ void TeamMgr::doLagMemberTask(Consumer &consumer)
     }
 }
 
+// teamsyncd adds the LAG into the state database once its teamd is up. The
+// members waiting for it are added right away instead of on the next retry.
+void TeamMgr::doLagStateTask(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    bool lagReady = false;
+
+    auto it = consumer.m_toSync.begin();
+    while (it != consumer.m_toSync.end())
+    {
+        if (kfvOp(it->second) == SET_COMMAND)
+        {
+            SWSS_LOG_INFO("Lag %s is ready", kfvKey(it->second).c_str());
+            lagReady = true;
+        }
+
+        it = consumer.m_toSync.erase(it);
+    }
+
+    auto *members = getExecutor(CFG_LAG_MEMBER_TABLE_NAME);
+    if (lagReady && members)
+    {
+        members->drain();
+    }
+}
+
 bool TeamMgr::checkPortIffUp(const string &port)
 {
     SWSS_LOG_ENTER();
@@ -512,7 +560,7 @@ bool TeamMgr::setLagMtu(const string &alias, const string &mtu)
     vector<FieldValueTuple> fvs;
     FieldValueTuple fv("mtu", mtu);
     fvs.push_back(fv);
-    m_appLagTable.set(alias, fvs);
+    m_appLagTable->set(alias, fvs);
 
     vector<string> keys;
     m_cfgLagMemberTable.getKeys(keys);
@@ -542,7 +590,7 @@ bool TeamMgr::setLagTpid(const string &alias, const string &tpid)
     vector<FieldValueTuple> fvs;
     FieldValueTuple fv("tpid", tpid);
     fvs.push_back(fv);
-    m_appLagTable.set(alias, fvs);
+    m_appLagTable->set(alias, fvs);
 
     SWSS_LOG_NOTICE("Set port channel %s TPID to %s", alias.c_str(), tpid.c_str());
 
@@ -556,17 +604,16 @@ bool TeamMgr::setLagLearnMode(const string &alias, const string &learn_mode)
     vector<FieldValueTuple> fvs;
     FieldValueTuple fv("learn_mode", learn_mode);
     fvs.push_back(fv);
-    m_appLagTable.set(alias, fvs);
+    m_appLagTable->set(alias, fvs);
 
     return true;
 }
 
-task_process_status TeamMgr::addLag(const string &alias, int min_links, bool fallback, bool fast_rate)
+void TeamMgr::addLag(const string &alias, int min_links, bool fallback, bool fast_rate)
 {
     SWSS_LOG_ENTER();
 
     stringstream cmd;
-    string res;
 
     stringstream conf;
 
@@ -637,16 +684,38 @@ task_process_status TeamMgr::addLag(const string &alias, int min_links, bool fal
         << " -L " << dump_path
         << " -g -d";
 
-    if (exec(cmd.str(), res) != 0)
+    // teamd -d returns once the daemon is up, the LAGs are started concurrently
+    // and each one is configured as soon as its teamd is ready
+    m_lagStarting.insert(alias);
+    m_teamdExecutor->submit(alias, cmd.str(), [this, alias](int ret, const string &) {
+        onLagStarted(alias, ret == 0);
+    });
+}
+
+void TeamMgr::onLagStarted(const string &alias, bool success)
+{
+    SWSS_LOG_ENTER();
+
+    m_lagStarting.erase(alias);
+
+    if (!success)
     {
         SWSS_LOG_INFO("Failed to start port channel %s with teamd, retry...",
                 alias.c_str());
-        return task_need_retry;
+        // If LAG creation fails, we need to clean up any potentially orphaned teamd processes
+        removeLag(alias);
+        return;
     }
 
     SWSS_LOG_NOTICE("Start port channel %s with teamd", alias.c_str());
+    m_lagList.insert(alias);
 
-    return task_success;
+    // Apply the rest of the LAG configuration
+    auto *lags = getExecutor(CFG_LAG_TABLE_NAME);
+    if (lags)
+    {
+        lags->drain();
+    }
 }
 
 bool TeamMgr::removeLag(const string &alias)
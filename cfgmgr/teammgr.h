@@ -1,12 +1,15 @@
 #pragma once
 
+#include <memory>
 #include <set>
 #include <string>
 
+#include "asynccmdexecutor.h"
 #include "dbconnector.h"
 #include "netmsg.h"
 #include "orch.h"
 #include "producerstatetable.h"
+#include "zmqclient.h"
 #include <sys/types.h>
 
 namespace swss {
@@ -14,11 +17,17 @@ namespace swss {
 class TeamMgr : public Orch
 {
 public:
+    // Number of teamd instances started concurrently
+    static constexpr size_t DEFAULT_TEAMD_START_THREADS = 8;
+
     TeamMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *staDb,
-            const std::vector<TableConnector> &tables);
+            const std::vector<TableConnector> &tables,
+            size_t teamdStartThreads = DEFAULT_TEAMD_START_THREADS);
 
     using Orch::doTask;
     void cleanTeamProcesses();
+    // Wait for the teamd instances being started and apply their LAG configuration
+    void waitTeamdStart();
 
 private:
     Table m_cfgMetadataTable;   // To retrieve MAC address
@@ -30,9 +39,15 @@ private:
     Table m_stateMACsecIngressSATable;
 
     ProducerStateTable m_appPortTable;
-    ProducerStateTable m_appLagTable;
+    /* Set when LAG_TABLE is sent to orchagent via the ZMQ channel */
+    std::shared_ptr<ZmqClient> m_zmqClient;
+    std::shared_ptr<ProducerStateTable> m_appLagTable;
 
     std::set<std::string> m_lagList;
+    // LAGs whose teamd is being started by m_teamdExecutor
+    std::set<std::string> m_lagStarting;
+
+    AsyncCmdExecutor *m_teamdExecutor;
 
     MacAddress m_mac;
 
@@ -40,8 +55,10 @@ private:
     void doLagTask(Consumer &consumer);
     void doLagMemberTask(Consumer &consumer);
     void doPortUpdateTask(Consumer &consumer);
+    void doLagStateTask(Consumer &consumer);
 
-    task_process_status addLag(const std::string &alias, int min_links, bool fall_back, bool fast_rate);
+    void addLag(const std::string &alias, int min_links, bool fall_back, bool fast_rate);
+    void onLagStarted(const std::string &alias, bool success);
     bool removeLag(const std::string &alias);
     task_process_status addLagMember(const std::string &lag, const std::string &member);
     bool removeLagMember(const std::string &lag, const std::string &member);
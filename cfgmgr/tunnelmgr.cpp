@@ -7,8 +7,6 @@
 #include "logger.h"
 #include "tunnelmgr.h"
 #include "tokenize.h"
-#include "shellcmd.h"
-#include "exec.h"
 #include "warm_restart.h"
 
 using namespace std;
@@ -18,91 +16,41 @@ using namespace swss;
 #define TUNIF "tun0"
 #define LOOPBACK_SRC "Loopback3"
 
-static int cmdIpTunnelIfCreate(const swss::TunnelInfo & info, std::string & res)
+static int cmdIpTunnelIfCreate(NetDevHelper & netDev, const swss::TunnelInfo & info)
 {
     // ip tunnel add {{tunnel intf}} mode ipip local {{dst ip}} remote {{remote ip}}
-    ostringstream cmd;
-    cmd << IP_CMD " tunnel add "
-        << TUNIF << " mode ipip local "
-        << shellquote(info.dst_ip)
-        << " remote "
-        << shellquote(info.remote_ip);
-    return swss::exec(cmd.str(), res);
+    return netDev.addIpipLink(TUNIF, info.dst_ip, info.remote_ip);
 }
 
-static int cmdIpTunnelIfRemove(std::string & res)
+static int cmdIpTunnelIfRemove(NetDevHelper & netDev)
 {
     // ip tunnel del {{tunnel intf}}
-    ostringstream cmd;
-    cmd << IP_CMD " tunnel del "
-        << TUNIF;
-    return swss::exec(cmd.str(), res);
+    return netDev.delLink(TUNIF);
 }
 
-static int cmdIpTunnelIfUp(std::string & res)
+static int cmdIpTunnelIfUp(NetDevHelper & netDev)
 {
     // ip link set dev {{tunnel intf}} up
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << TUNIF
-        << " up";
-    return swss::exec(cmd.str(), res);
+    return netDev.setLinkAdminStatus(TUNIF, true);
 }
 
-static int cmdIpTunnelIfAddress(const std::string& ip, std::string & res)
+static int cmdIpTunnelIfAddress(NetDevHelper & netDev, const IpPrefix& ip)
 {
     // ip addr add {{loopback3 ip}} dev {{tunnel intf}}
-    ostringstream cmd;
-    cmd << IP_CMD " addr add "
-        << shellquote(ip)
-        << " dev "
-        << TUNIF;
-    return swss::exec(cmd.str(), res);
+    return netDev.addAddress(TUNIF, ip, false);
 }
 
-static int cmdIpTunnelRouteAdd(const std::string& pfx, std::string & res)
+static int cmdIpTunnelRouteAdd(NetDevHelper & netDev, const std::string& pfx)
 {
     // ip route add/replace {{ip prefix}} dev {{tunnel intf}}
     // Replace route if route already exists
-    ostringstream cmd;
-    if (IpPrefix(pfx).isV4())
-    {
-        cmd << IP_CMD " route replace "
-            << shellquote(pfx)
-            << " dev "
-            << TUNIF;
-    }
-    else
-    {
-        cmd << IP_CMD " -6 route replace "
-            << shellquote(pfx)
-            << " dev "
-            << TUNIF;
-    }
-
-    return swss::exec(cmd.str(), res);
+    return netDev.replaceRoute(IpPrefix(pfx), TUNIF);
 }
 
-static int cmdIpTunnelRouteDel(const std::string& pfx, std::string & res)
+static int cmdIpTunnelRouteDel(NetDevHelper & netDev, const std::string& pfx)
 {
     // ip route del {{ip prefix}} dev {{tunnel intf}}
-    ostringstream cmd;
-    if (IpPrefix(pfx).isV4())
-    {
-        cmd << IP_CMD " route del "
-            << shellquote(pfx)
-            << " dev "
-            << TUNIF;
-    }
-    else
-    {
-        cmd << IP_CMD " -6 route del "
-            << shellquote(pfx)
-            << " dev "
-            << TUNIF;
-    }
-
-    return swss::exec(cmd.str(), res);
+    return netDev.delRoute(IpPrefix(pfx), TUNIF);
 }
 
 TunnelMgr::TunnelMgr(DBConnector *cfgDb, DBConnector *appDb, const std::vector<std::string> &tableNames) :
@@ -153,8 +101,7 @@ TunnelMgr::TunnelMgr(DBConnector *cfgDb, DBConnector *appDb, const std::vector<s
     Orch::addExecutor(consumer);
 
     // Cleanup any existing tunnel intf
-    std::string res;
-    cmdIpTunnelIfRemove(res);
+    cmdIpTunnelIfRemove(m_netDev);
 }
 
 void TunnelMgr::doTask(Consumer &consumer)
@@ -338,13 +285,11 @@ bool TunnelMgr::doLpbkIntfTask(const KeyOpFieldsValuesTuple & t)
 
     if (alias == LOOPBACK_SRC && !m_tunnelCache.empty())
     {
-        int ret = 0;
-        std::string res;
-        ret = cmdIpTunnelIfAddress(ipPrefix.to_string(), res);
-        if (ret != 0)
+        int ret = cmdIpTunnelIfAddress(m_netDev, ipPrefix);
+        if (ret < 0)
         {
-            SWSS_LOG_WARN("Failed to assign IP addr for tun if %s, res %s",
-                           ipPrefix.to_string().c_str(), res.c_str());
+            SWSS_LOG_WARN("Failed to assign IP addr for tun if %s, error %s",
+                           ipPrefix.to_string().c_str(), nl_geterror(ret));
         }
     }
 
@@ -360,21 +305,20 @@ bool TunnelMgr::doTunnelRouteTask(const KeyOpFieldsValuesTuple & t)
     const std::string & op = kfvOp(t);
 
     int ret = 0;
-    std::string res;
     if (op == SET_COMMAND)
     {
-        ret = cmdIpTunnelRouteAdd(prefix, res);
-        if (ret != 0)
+        ret = cmdIpTunnelRouteAdd(m_netDev, prefix);
+        if (ret < 0)
         {
-            SWSS_LOG_WARN("Failed to add route %s, res %s", prefix.c_str(), res.c_str());
+            SWSS_LOG_WARN("Failed to add route %s, error %s", prefix.c_str(), nl_geterror(ret));
         }
     }
     else
     {
-        ret = cmdIpTunnelRouteDel(prefix, res);
-        if (ret != 0)
+        ret = cmdIpTunnelRouteDel(m_netDev, prefix);
+        if (ret < 0)
         {
-            SWSS_LOG_WARN("Failed to del route %s, res %s", prefix.c_str(), res.c_str());
+            SWSS_LOG_WARN("Failed to del route %s, error %s", prefix.c_str(), nl_geterror(ret));
         }
     }
 
@@ -386,30 +330,29 @@ bool TunnelMgr::doTunnelRouteTask(const KeyOpFieldsValuesTuple & t)
 bool TunnelMgr::configIpTunnel(const TunnelInfo& tunInfo)
 {
     int ret = 0;
-    std::string res;
 
-    ret = cmdIpTunnelIfCreate(tunInfo, res);
-    if (ret != 0)
+    ret = cmdIpTunnelIfCreate(m_netDev, tunInfo);
+    if (ret < 0)
     {
-        SWSS_LOG_WARN("Failed to create IP tunnel if (dst ip: %s, peer ip %s), res %s",
-                       tunInfo.dst_ip.c_str(),tunInfo.remote_ip.c_str(), res.c_str());
+        SWSS_LOG_WARN("Failed to create IP tunnel if (dst ip: %s, peer ip %s), error %s",
+                       tunInfo.dst_ip.c_str(),tunInfo.remote_ip.c_str(), nl_geterror(ret));
     }
 
-    ret = cmdIpTunnelIfUp(res);
-    if (ret != 0)
+    ret = cmdIpTunnelIfUp(m_netDev);
+    if (ret < 0)
     {
-        SWSS_LOG_WARN("Failed to enable IP tunnel intf (dst ip: %s, peer ip %s), res %s",
-                       tunInfo.dst_ip.c_str(),tunInfo.remote_ip.c_str(), res.c_str());
+        SWSS_LOG_WARN("Failed to enable IP tunnel intf (dst ip: %s, peer ip %s), error %s",
+                       tunInfo.dst_ip.c_str(),tunInfo.remote_ip.c_str(), nl_geterror(ret));
     }
 
     auto it = m_intfCache.find(LOOPBACK_SRC);
     if (it != m_intfCache.end())
     {
-        ret = cmdIpTunnelIfAddress(it->second.to_string(), res);
-        if (ret != 0)
+        ret = cmdIpTunnelIfAddress(m_netDev, it->second);
+        if (ret < 0)
         {
-            SWSS_LOG_WARN("Failed to assign IP addr for tun if %s, res %s",
-                           it->second.to_string().c_str(), res.c_str());
+            SWSS_LOG_WARN("Failed to assign IP addr for tun if %s, error %s",
+                           it->second.to_string().c_str(), nl_geterror(ret));
         }
     }
 
@@ -3,6 +3,7 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "netdevhelper.h"
 
 #include <set>
 
@@ -32,6 +33,8 @@ private:
 
     void finalizeWarmReboot();
 
+    NetDevHelper m_netDev;
+
     ProducerStateTable m_appIpInIpTunnelTable;
     ProducerStateTable m_appIpInIpTunnelDecapTermTable;
     Table m_cfgPeerTable;
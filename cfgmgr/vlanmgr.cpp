@@ -119,24 +119,25 @@ bool VlanMgr::addHostVlan(int vlan_id)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/bridge vlan add vid {{vlan_id}} dev Bridge self &&
-    //               /sbin/ip link add link Bridge up name Vlan{{vlan_id}} address {{gMacAddress}} type vlan id {{vlan_id}}"
-    const std::string cmds = std::string("")
-      + BASH_CMD + " -c \""
-      + BRIDGE_CMD + " vlan add vid " + std::to_string(vlan_id) + " dev " + DOT1Q_BRIDGE_NAME + " self && "
-      + IP_CMD + " link add link " + DOT1Q_BRIDGE_NAME
-               + " up"
-               + " name " + VLAN_PREFIX + std::to_string(vlan_id)
-               + " address " + gMacAddress.to_string()
-               + " type vlan id " + std::to_string(vlan_id) + "\"";
+    // Equivalent of:
+    // /sbin/bridge vlan add vid {{vlan_id}} dev Bridge self &&
+    // /sbin/ip link add link Bridge up name Vlan{{vlan_id}} address {{gMacAddress}} type vlan id {{vlan_id}}
+    const std::string vlan_alias = VLAN_PREFIX + std::to_string(vlan_id);
+    int ret = m_netDev.addBridgeVlans(DOT1Q_BRIDGE_NAME, {{(uint16_t)vlan_id, false, false}}, true);
+    if (ret)
+    {
+        throw runtime_error("Failed to add vid " + std::to_string(vlan_id) + " to " DOT1Q_BRIDGE_NAME " : " + nl_geterror(ret));
+    }
 
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds, res);
+    ret = m_netDev.addVlanLink(DOT1Q_BRIDGE_NAME, vlan_alias, (uint16_t)vlan_id, gMacAddress, true);
+    if (ret)
+    {
+        throw runtime_error("Failed to create " + vlan_alias + " : " + nl_geterror(ret));
+    }
 
-    res.clear();
+    std::string res;
     const std::string echo_cmd = std::string("")
-      + ECHO_CMD + " 0 > /proc/sys/net/ipv4/conf/" + VLAN_PREFIX + std::to_string(vlan_id) + "/arp_evict_nocarrier";
+      + ECHO_CMD + " 0 > /proc/sys/net/ipv4/conf/" + vlan_alias + "/arp_evict_nocarrier";
     swss::exec(echo_cmd, res);
 
     return true;
@@ -146,16 +147,21 @@ bool VlanMgr::removeHostVlan(int vlan_id)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/ip link del Vlan{{vlan_id}} &&
-    //               /sbin/bridge vlan del vid {{vlan_id}} dev Bridge self"
-    const std::string cmds = std::string("")
-      + BASH_CMD + " -c \""
-      + IP_CMD + " link del " + VLAN_PREFIX + std::to_string(vlan_id) + " && "
-      + BRIDGE_CMD + " vlan del vid " + std::to_string(vlan_id) + " dev " + DOT1Q_BRIDGE_NAME + " self\"";
+    // Equivalent of:
+    // /sbin/ip link del Vlan{{vlan_id}} &&
+    // /sbin/bridge vlan del vid {{vlan_id}} dev Bridge self
+    const std::string vlan_alias = VLAN_PREFIX + std::to_string(vlan_id);
+    int ret = m_netDev.delLink(vlan_alias);
+    if (ret)
+    {
+        throw runtime_error("Failed to remove " + vlan_alias + " : " + nl_geterror(ret));
+    }
 
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds, res);
+    ret = m_netDev.delBridgeVlans(DOT1Q_BRIDGE_NAME, {(uint16_t)vlan_id}, true);
+    if (ret)
+    {
+        throw runtime_error("Failed to remove vid " + std::to_string(vlan_id) + " from " DOT1Q_BRIDGE_NAME " : " + nl_geterror(ret));
+    }
 
     return true;
 }
@@ -164,13 +170,12 @@ bool VlanMgr::setHostVlanAdminState(int vlan_id, const string &admin_status)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /sbin/ip link set Vlan{{vlan_id}} {{admin_status}}
-    ostringstream cmds;
-    cmds << IP_CMD " link set " VLAN_PREFIX + std::to_string(vlan_id) + " " << shellquote(admin_status);
-
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    const std::string vlan_alias = VLAN_PREFIX + std::to_string(vlan_id);
+    int ret = m_netDev.setLinkAdminStatus(vlan_alias, admin_status == "up");
+    if (ret)
+    {
+        throw runtime_error("Failed to set admin_status " + admin_status + " on " + vlan_alias + " : " + nl_geterror(ret));
+    }
 
     return true;
 }
@@ -179,13 +184,7 @@ bool VlanMgr::setHostVlanMtu(int vlan_id, uint32_t mtu)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /sbin/ip link set Vlan{{vlan_id}} mtu {{mtu}}
-    const std::string cmds = std::string("")
-      + IP_CMD + " link set " + VLAN_PREFIX + std::to_string(vlan_id) + " mtu " + std::to_string(mtu);
-
-    std::string res;
-    int ret = swss::exec(cmds, res);
+    int ret = m_netDev.setLinkMtu(VLAN_PREFIX + std::to_string(vlan_id), mtu);
     if (ret == 0)
     {
         return true;
@@ -199,112 +198,129 @@ bool VlanMgr::setHostVlanMac(int vlan_id, const string &mac)
 {
     SWSS_LOG_ENTER();
 
-    std::string res;
+    const std::string vlan_alias = VLAN_PREFIX + std::to_string(vlan_id);
+    MacAddress macAddress(mac);
 
     /*
      * Bring down the bridge before changing MAC addresses of the bridge and the VLAN interface.
      * This is done so that the IPv6 link-local addresses of the bridge and the VLAN interface
      * are updated after MAC change.
-     * /sbin/ip link set Bridge down
      */
-    string bridge_down(IP_CMD " link set " DOT1Q_BRIDGE_NAME " down");
-    EXEC_WITH_ERROR_THROW(bridge_down, res);
+    int ret = m_netDev.setLinkAdminStatus(DOT1Q_BRIDGE_NAME, false);
+    if (ret)
+    {
+        throw runtime_error("Failed to bring down " DOT1Q_BRIDGE_NAME " : " + string(nl_geterror(ret)));
+    }
 
-    // The command should be generated as:
-    // /sbin/ip link set Vlan{{vlan_id}} address {{mac}} &&
-    // /sbin/ip link set Bridge address {{mac}}
-    ostringstream cmds;
-    cmds << IP_CMD " link set " VLAN_PREFIX + std::to_string(vlan_id) + " address " << shellquote(mac) << " && "
-            IP_CMD " link set " DOT1Q_BRIDGE_NAME " address " << shellquote(mac);
-    res.clear();
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    if ((ret = m_netDev.setLinkMac(vlan_alias, macAddress)) ||
+        (ret = m_netDev.setLinkMac(DOT1Q_BRIDGE_NAME, macAddress)))
+    {
+        throw runtime_error("Failed to set mac " + mac + " on " + vlan_alias + " : " + nl_geterror(ret));
+    }
 
-    /*
-     * Start up the bridge again.
-     * /sbin/ip link set Bridge up
-     */
-    string bridge_up(IP_CMD " link set " DOT1Q_BRIDGE_NAME " up");
-    res.clear();
-    EXEC_WITH_ERROR_THROW(bridge_up, res);
+    /* Start up the bridge again. */
+    ret = m_netDev.setLinkAdminStatus(DOT1Q_BRIDGE_NAME, true);
+    if (ret)
+    {
+        throw runtime_error("Failed to bring up " DOT1Q_BRIDGE_NAME " : " + string(nl_geterror(ret)));
+    }
 
     return true;
 }
 
-bool VlanMgr::addHostVlanMember(int vlan_id, const string &port_alias, const string& tagging_mode)
+/*
+ * Equivalent of, for all given VLANs of the port at once:
+ * /sbin/ip link set {{port_alias}} master Bridge &&
+ * /sbin/bridge vlan del vid 1 dev {{port_alias}} &&
+ * /sbin/bridge vlan add vid {{vlan_id}} dev {{port_alias}} {{tagging_mode}}
+ */
+int VlanMgr::setHostVlanMembers(const string &port_alias, const vector<BridgeVlan> &vlans)
 {
-    SWSS_LOG_ENTER();
-
-    std::string tagging_cmd;
-    if (tagging_mode == "untagged" || tagging_mode == "priority_tagged")
+    int ret = m_netDev.setLinkMaster(port_alias, DOT1Q_BRIDGE_NAME);
+    if (ret == 0)
+    {
+        ret = m_netDev.delBridgeVlans(port_alias, {(uint16_t)stoi(DEFAULT_VLAN_ID)});
+    }
+    if (ret == 0)
     {
-        tagging_cmd = "pvid untagged";
+        ret = m_netDev.addBridgeVlans(port_alias, vlans);
     }
+    return ret;
+}
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/ip link set {{port_alias}} master Bridge &&
-    //               /sbin/bridge vlan del vid 1 dev {{ port_alias }} &&
-    //               /sbin/bridge vlan add vid {{vlan_id}} dev {{port_alias}} {{tagging_mode}}"
-    ostringstream cmds, inner;
-    inner << IP_CMD " link set " << shellquote(port_alias) << " master " DOT1Q_BRIDGE_NAME " && "
-      BRIDGE_CMD " vlan del vid " DEFAULT_VLAN_ID " dev " << shellquote(port_alias) << " && "
-      BRIDGE_CMD " vlan add vid " + std::to_string(vlan_id) + " dev " << shellquote(port_alias) << " " + tagging_cmd;
-    cmds << BASH_CMD " -c " << shellquote(inner.str());
+bool VlanMgr::addHostVlanMembers(const string &port_alias, const vector<pair<int, string>> &members)
+{
+    SWSS_LOG_ENTER();
 
-    std::string res;
-    try
+    vector<BridgeVlan> vlans;
+    for (const auto &member : members)
     {
-        EXEC_WITH_ERROR_THROW(cmds.str(), res);
+        const string &tagging_mode = member.second;
+        bool untagged = (tagging_mode == "untagged" || tagging_mode == "priority_tagged");
+        vlans.push_back({(uint16_t)member.first, untagged, untagged});
     }
-    catch (const std::runtime_error& e)
+
+    int ret = setHostVlanMembers(port_alias, vlans);
+    if (ret)
     {
         // Race conidtion can happen with portchannel removal might happen
-	// but state db is not updated yet so we can do retry instead of sending exception
-	if (!port_alias.compare(0, strlen(LAG_PREFIX), LAG_PREFIX))
-	{
+        // but state db is not updated yet so we can do retry instead of sending exception
+        if (!port_alias.compare(0, strlen(LAG_PREFIX), LAG_PREFIX))
+        {
             return false;
-	}
-        else
-	{
-            EXEC_WITH_ERROR_THROW(cmds.str(), res);
-	}
+        }
+
+        ret = setHostVlanMembers(port_alias, vlans);
+        if (ret)
+        {
+            throw runtime_error("Failed to add " + port_alias + " to " + to_string(members.size()) +
+                                " vlan(s) : " + nl_geterror(ret));
+        }
     }
 
     return true;
 }
 
-bool VlanMgr::removeHostVlanMember(int vlan_id, const string &port_alias)
+bool VlanMgr::addHostVlanMember(int vlan_id, const string &port_alias, const string& tagging_mode)
+{
+    return addHostVlanMembers(port_alias, {{vlan_id, tagging_mode}});
+}
+
+bool VlanMgr::removeHostVlanMembers(const string &port_alias, const vector<int> &vlan_ids)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c '/sbin/bridge vlan del vid {{vlan_id}} dev {{port_alias}} &&
-    //               ( vlanShow=$(/sbin/bridge vlan show dev {{port_alias}});
-    //               ret=$?;
-    //               if [ $ret -eq 0 ]; then
-    //               if (! echo "$vlanShow" | grep -q {{port_alias}})
-    //                 || (echo "$vlanShow" | grep -q None$)
-    //                 || (echo "$vlanShow" | grep -q {{port_alias}}$); then
-    //               /sbin/ip link set {{port_alias}} nomaster;
-    //               fi;
-    //               else exit $ret; fi )'
+    vector<uint16_t> vids(vlan_ids.begin(), vlan_ids.end());
+    int ret = m_netDev.delBridgeVlans(port_alias, vids);
+    if (ret)
+    {
+        SWSS_LOG_ERROR("Failed to remove %s from %zu vlan(s) : %s",
+                       port_alias.c_str(), vids.size(), nl_geterror(ret));
+        return false;
+    }
 
     // When port is not member of any VLAN, it shall be detached from Dot1Q bridge!
-    ostringstream cmds, inner;
-    inner << BRIDGE_CMD " vlan del vid " + std::to_string(vlan_id) + " dev " << shellquote(port_alias) << " && ( "
-      "vlanShow=$(" BRIDGE_CMD " vlan show dev " << shellquote(port_alias) << "); "
-      "ret=$?; "
-      "if [ $ret -eq 0 ]; then "
-      "if (! echo \"$vlanShow\" | " GREP_CMD " -q " << shellquote(port_alias) << ") "
-      " || (echo \"$vlanShow\" | " GREP_CMD " -q None$) "
-      " || (echo \"$vlanShow\" | " GREP_CMD " -q " << shellquote(port_alias) << "$); then "
-      IP_CMD " link set " << shellquote(port_alias) << " nomaster; "
-      "fi; "
-      "else exit $ret; fi )";
-    cmds << BASH_CMD " -c " << shellquote(inner.str());
+    int count = 0;
+    ret = m_netDev.getBridgeVlanCount(port_alias, count);
+    if (ret)
+    {
+        throw runtime_error("Failed to query vlans of " + port_alias + " : " + nl_geterror(ret));
+    }
 
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    if (count == 0 && (ret = m_netDev.setLinkMaster(port_alias, "")))
+    {
+        throw runtime_error("Failed to detach " + port_alias + " from " DOT1Q_BRIDGE_NAME " : " + nl_geterror(ret));
+    }
+
+    return true;
+}
 
+bool VlanMgr::removeHostVlanMember(int vlan_id, const string &port_alias)
+{
+    if (!removeHostVlanMembers(port_alias, {vlan_id}))
+    {
+        throw runtime_error("Failed to remove " + port_alias + " from Vlan" + to_string(vlan_id));
+    }
     return true;
 }
 
@@ -592,6 +608,24 @@ void VlanMgr::processUntaggedVlanMembers(string vlan, const string &members)
 
 void VlanMgr::doVlanMemberTask(Consumer &consumer)
 {
+    /*
+     * Kernel programming is coalesced per port: removals and additions are
+     * collected while walking the batch and each port gets one request for
+     * all of its VLANs once the walk is done. Removals go first so a
+     * DEL/SET pair of the same member is applied in order. A task leaves
+     * the queue only once the request of its port went through.
+     */
+    struct PendingMember
+    {
+        SyncMap::iterator it;
+        int vlan_id;
+        string tagging_mode;
+    };
+    map<string, vector<PendingMember>> pendingAdds;
+    map<string, vector<PendingMember>> pendingDels;
+    set<string> deletedMembers;
+    set<string> failedDelPorts;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -630,7 +664,7 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
        // TODO:  store port/lag/VLAN data in local data structure and perform more validations.
         if (op == SET_COMMAND)
         {
-             if (isVlanMemberStateOk(kfvKey(t)))
+             if (isVlanMemberStateOk(kfvKey(t)) && !deletedMembers.count(kfvKey(t)))
              {
                 SWSS_LOG_DEBUG("%s already set", kfvKey(t).c_str());
                 m_vlanMemberReplay.erase(kfvKey(t));
@@ -664,39 +698,20 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
                 continue;
             }
 
-            if (addHostVlanMember(vlan_id, port_alias, tagging_mode))
-            {
-                key = VLAN_PREFIX + to_string(vlan_id);
-                key += DEFAULT_KEY_SEPARATOR;
-                key += port_alias;
-                m_appVlanMemberTableProducer.set(key, kfvFieldsValues(t));
-
-                vector<FieldValueTuple> fvVector;
-                FieldValueTuple s("state", "ok");
-                fvVector.push_back(s);
-                m_stateVlanMemberTable.set(kfvKey(t), fvVector);
-
-                m_vlanMemberReplay.erase(kfvKey(t));
-                m_PortVlanMember[port_alias][vlan_alias] = tagging_mode;
-            }
-            else
-            {
-                SWSS_LOG_INFO("Netdevice for  %s not ready, delaying", kfvKey(t).c_str());
-                it++;
-                continue;
-            }
+            /* Programmed below together with the other VLANs of the port */
+            pendingAdds[port_alias].push_back({it, vlan_id, tagging_mode});
+            it++;
+            continue;
         }
         else if (op == DEL_COMMAND)
         {
-            if (isVlanMemberStateOk(kfvKey(t)))
+            if (isVlanMemberStateOk(kfvKey(t)) && !deletedMembers.count(kfvKey(t)))
             {
-                removeHostVlanMember(vlan_id, port_alias);
-                key = VLAN_PREFIX + to_string(vlan_id);
-                key += DEFAULT_KEY_SEPARATOR;
-                key += port_alias;
-                m_appVlanMemberTableProducer.del(key);
-                m_stateVlanMemberTable.del(kfvKey(t));
-                m_PortVlanMember[port_alias].erase(vlan_alias);
+                /* Removed below together with the other VLANs of the port */
+                pendingDels[port_alias].push_back({it, vlan_id, ""});
+                deletedMembers.insert(kfvKey(t));
+                it++;
+                continue;
             }
             else
             {
@@ -711,6 +726,77 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
         /* Other than the case of member port/lag is not ready, no retry will be performed */
         it = consumer.m_toSync.erase(it);
     }
+
+    for (const auto &entry : pendingDels)
+    {
+        const string &port_alias = entry.first;
+        vector<int> vlan_ids;
+        for (const auto &member : entry.second)
+        {
+            vlan_ids.push_back(member.vlan_id);
+        }
+
+        if (!removeHostVlanMembers(port_alias, vlan_ids))
+        {
+            /* Keep the additions of the port behind its removals */
+            SWSS_LOG_INFO("Retrying the removal of %s from %zu vlan(s)",
+                          port_alias.c_str(), vlan_ids.size());
+            failedDelPorts.insert(port_alias);
+            continue;
+        }
+
+        for (const auto &member : entry.second)
+        {
+            string vlan_alias = VLAN_PREFIX + to_string(member.vlan_id);
+            string key = vlan_alias + DEFAULT_KEY_SEPARATOR + port_alias;
+            m_appVlanMemberTableProducer.del(key);
+            m_stateVlanMemberTable.del(kfvKey(member.it->second));
+            m_PortVlanMember[port_alias].erase(vlan_alias);
+
+            consumer.m_toSync.erase(member.it);
+        }
+    }
+
+    for (const auto &entry : pendingAdds)
+    {
+        const string &port_alias = entry.first;
+        if (failedDelPorts.count(port_alias))
+        {
+            continue;
+        }
+
+        vector<pair<int, string>> members;
+        for (const auto &member : entry.second)
+        {
+            members.emplace_back(member.vlan_id, member.tagging_mode);
+        }
+
+        if (!addHostVlanMembers(port_alias, members))
+        {
+            SWSS_LOG_INFO("Netdevice for %s not ready, delaying %zu vlan member(s)",
+                          port_alias.c_str(), members.size());
+            continue;
+        }
+
+        for (const auto &member : entry.second)
+        {
+            auto &t = member.it->second;
+            string vlan_alias = VLAN_PREFIX + to_string(member.vlan_id);
+            string key = vlan_alias + DEFAULT_KEY_SEPARATOR + port_alias;
+            m_appVlanMemberTableProducer.set(key, kfvFieldsValues(t));
+
+            vector<FieldValueTuple> fvVector;
+            FieldValueTuple s("state", "ok");
+            fvVector.push_back(s);
+            m_stateVlanMemberTable.set(kfvKey(t), fvVector);
+
+            m_vlanMemberReplay.erase(kfvKey(t));
+            m_PortVlanMember[port_alias][vlan_alias] = member.tagging_mode;
+
+            consumer.m_toSync.erase(member.it);
+        }
+    }
+
     if (!replayDone && m_vlanMemberReplay.empty() &&
         WarmStart::isWarmStart())
     {
@@ -4,6 +4,7 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "netdevhelper.h"
 
 #include <set>
 #include <map>
@@ -29,6 +30,7 @@ private:
     std::set<std::string> m_vlanMemberReplay;
     bool replayDone;
     std::unordered_map<std::string, std::unordered_map<std::string, std::string>> m_PortVlanMember;
+    NetDevHelper m_netDev;
     
     void doTask(Consumer &consumer);
     void doVlanTask(Consumer &consumer);
@@ -42,6 +44,9 @@ private:
     bool setHostVlanMac(int vlan_id, const std::string &mac);
     bool addHostVlanMember(int vlan_id, const std::string &port_alias, const std::string& tagging_mode);
     bool removeHostVlanMember(int vlan_id, const std::string &port_alias);
+    bool addHostVlanMembers(const std::string &port_alias, const std::vector<std::pair<int, std::string>> &members);
+    bool removeHostVlanMembers(const std::string &port_alias, const std::vector<int> &vlan_ids);
+    int setHostVlanMembers(const std::string &port_alias, const std::vector<BridgeVlan> &vlans);
     bool isMemberStateOk(const std::string &alias);
     bool isVlanStateOk(const std::string &alias);
     bool isVlanMacOk();
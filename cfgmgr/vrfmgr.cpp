@@ -1,12 +1,13 @@
 #include <string.h>
+#include <algorithm>
+#include <sys/socket.h>
+#include <linux/rtnetlink.h>
 #include "logger.h"
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "tokenize.h"
 #include "ipprefix.h"
 #include "vrfmgr.h"
-#include "exec.h"
-#include "shellcmd.h"
 #include "warm_restart.h"
 
 #define VRF_TABLE_START 1001
@@ -31,78 +32,57 @@ VrfMgr::VrfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, con
     }
 
     /* Get existing VRFs from Linux */
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD << " -d link show type vrf";
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
-
-    enum IpShowRowType
+    map<string, uint32_t> vrfs;
+    int ret = m_netDev.getVrfLinks(vrfs);
+    if (ret < 0)
     {
-        LINK_ROW,
-        MAC_ROW,
-        DETAILS_ROW,
-    };
-
-    string vrfName;
-    uint32_t table;
-    IpShowRowType rowType = LINK_ROW;
-    const auto& rows = tokenize(res, '\n');
-    for (const auto& row : rows)
+        throw runtime_error(string("Failed to get VRF devices : ") + nl_geterror(ret));
+    }
+
+    for (const auto& vrf : vrfs)
     {
-        const auto& items = tokenize(row, ' ');
-        switch(rowType)
+        const auto& vrfName = vrf.first;
+
+        if (WarmStart::isWarmStart())
         {
-            case LINK_ROW:
-                vrfName = items[1];
-                vrfName.pop_back();
-                rowType = MAC_ROW;
-                break;
-            case MAC_ROW:
-                rowType = DETAILS_ROW;
-                break;
-            case DETAILS_ROW:
-                if (WarmStart::isWarmStart())
-                {
-                    table = static_cast<uint32_t>(stoul(items[6]));
-                    m_vrfTableMap[vrfName] = table;
-                    m_freeTables.erase(table);
-                }
-                else
-                {
-                    // No deletion of mgmt table from kernel
-                    if (vrfName.compare("mgmt") == 0)
-                    { 
-                        SWSS_LOG_NOTICE("Skipping remove vrf device %s", vrfName.c_str());
-                        rowType = LINK_ROW;
-                        break;
-                    }
+            m_vrfTableMap[vrfName] = vrf.second;
+            m_freeTables.erase(vrf.second);
+            continue;
+        }
 
-                    SWSS_LOG_NOTICE("Remove vrf device %s", vrfName.c_str());
-                    cmd.str("");
-                    cmd.clear();
-                    cmd << IP_CMD << " link del " << vrfName;
-                    int ret = swss::exec(cmd.str(), res);
-                    if (ret)
-                    {
-                        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
-                    }
-                }
-                rowType = LINK_ROW;
-                break;
+        // No deletion of mgmt table from kernel
+        if (vrfName == MGMT_VRF)
+        {
+            SWSS_LOG_NOTICE("Skipping remove vrf device %s", vrfName.c_str());
+            continue;
+        }
+
+        SWSS_LOG_NOTICE("Remove vrf device %s", vrfName.c_str());
+        ret = m_netDev.delLink(vrfName);
+        if (ret < 0)
+        {
+            SWSS_LOG_ERROR("Failed to remove vrf device %s: %s", vrfName.c_str(), nl_geterror(ret));
         }
     }
 
-    cmd.str("");
-    cmd.clear();
-    cmd << IP_CMD << " rule | grep '^0:'";
-    if (swss::exec(cmd.str(), res) == 0)
+    /* Move the local table lookup after the l3mdev rule */
+    vector<uint32_t> prefs;
+    ret = m_netDev.getRulePrefs(AF_INET, prefs);
+    if (ret < 0)
+    {
+        throw runtime_error(string("Failed to get ip rules : ") + nl_geterror(ret));
+    }
+    if (find(prefs.begin(), prefs.end(), 0) != prefs.end())
     {
-        cmd.str("");
-        cmd.clear();
-        cmd << IP_CMD << " rule add pref " << TABLE_LOCAL_PREF << " table local && " << IP_CMD << " rule del pref 0 && "
-            << IP_CMD << " -6 rule add pref " << TABLE_LOCAL_PREF << " table local && " << IP_CMD << " -6 rule del pref 0";
-        EXEC_WITH_ERROR_THROW(cmd.str(), res);
+        for (int family : {AF_INET, AF_INET6})
+        {
+            if ((ret = m_netDev.addRule(family, TABLE_LOCAL_PREF, RT_TABLE_LOCAL)) < 0 ||
+                (ret = m_netDev.delRule(family, 0)) < 0)
+            {
+                throw runtime_error(string("Failed to move ") + (family == AF_INET ? "ipv4" : "ipv6") +
+                                    " local table rule : " + nl_geterror(ret));
+            }
+        }
     }
 
     if (!WarmStart::isWarmStart())
@@ -137,9 +117,6 @@ bool VrfMgr::delLink(const string& vrfName)
 {
     SWSS_LOG_ENTER();
 
-    stringstream cmd;
-    string res;
-
     if (m_vrfTableMap.find(vrfName) == m_vrfTableMap.end())
     {
         return false;
@@ -152,8 +129,11 @@ bool VrfMgr::delLink(const string& vrfName)
         return true;
     }
 
-    cmd << IP_CMD << " link del " << shellquote(vrfName);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    int ret = m_netDev.delLink(vrfName);
+    if (ret < 0)
+    {
+        throw runtime_error("Failed to remove vrf device " + vrfName + " : " + nl_geterror(ret));
+    }
 
     recycleTable(m_vrfTableMap[vrfName]);
     m_vrfTableMap.erase(vrfName);
@@ -165,9 +145,6 @@ bool VrfMgr::setLink(const string& vrfName)
 {
     SWSS_LOG_ENTER();
 
-    stringstream cmd;
-    string res;
-
     if (m_vrfTableMap.find(vrfName) != m_vrfTableMap.end())
     {
         return true;
@@ -188,16 +165,16 @@ bool VrfMgr::setLink(const string& vrfName)
         return false;
     }
 
-    cmd << IP_CMD << " link add " << shellquote(vrfName) << " type vrf table " << table;
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    // Created up, like "ip link add <vrf> type vrf table <table>" followed by "ip link set <vrf> up"
+    int ret = m_netDev.addVrfLink(vrfName, table, true);
+    if (ret < 0)
+    {
+        recycleTable(table);
+        throw runtime_error("Failed to create vrf device " + vrfName + " : " + nl_geterror(ret));
+    }
 
     m_vrfTableMap.emplace(vrfName, table);
 
-    cmd.str("");
-    cmd.clear();
-    cmd << IP_CMD << " link set " << shellquote(vrfName) << " up";
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
-
     return true;
 }
 
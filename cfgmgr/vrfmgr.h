@@ -7,6 +7,7 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "netdevhelper.h"
 
 using namespace std;
 
@@ -38,6 +39,8 @@ private:
     void VrfVxlanTableSync(bool add);
     void doTask(Consumer &consumer);
 
+    NetDevHelper m_netDev;
+
     std::map<std::string, uint32_t> m_vrfTableMap;
     std::set<uint32_t> m_freeTables;
     VRFNameVNIMapTable m_vrfVniMapTable;
@@ -1,6 +1,5 @@
 #include <unistd.h>
 #include <algorithm>
-#include <regex>
 #include <sstream>
 #include <string>
 #include <net/if.h>
@@ -9,7 +8,6 @@
 #include "producerstatetable.h"
 #include "macaddress.h"
 #include "vxlanmgr.h"
-#include "exec.h"
 #include "tokenize.h"
 #include "shellcmd.h"
 #include "warm_restart.h"
@@ -50,132 +48,103 @@ static std::string getVxlanIfName(const swss::VxlanMgr::VxlanInfo & info)
 // Commands
 
 #define RET_SUCCESS 0
+#define VXLAN_DST_PORT 4789
+#define DOT1Q_BRIDGE_NAME "Bridge"
 
-static int cmdCreateVxlan(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+/* Map a NetDevHelper result to the positive return code callers expect from the commands */
+static int toNlResult(int err, const std::string &op, const std::string &alias)
+{
+    if (err < 0)
+    {
+        SWSS_LOG_INFO("Failed to %s %s: %s", op.c_str(), alias.c_str(), nl_geterror(err));
+        return -err;
+    }
+    return RET_SUCCESS;
+}
+
+static int cmdCreateVxlan(NetDevHelper & netDev, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link add {{VXLAN}} type vxlan id {{VNI}} [local {{SOURCE IP}}] dstport 4789
-    ostringstream cmd;
-    cmd << IP_CMD " link add "
-        << shellquote(info.m_vxlan)
-        << " type vxlan id "
-        << shellquote(info.m_vni)
-        << " ";
-    if (!info.m_sourceIp.empty())
-    {
-        cmd << " local " << shellquote(info.m_sourceIp);
-    }
-    cmd << " dstport 4789";
-    return swss::exec(cmd.str(), res);
+    uint32_t vni;
+    try
+    {
+        vni = static_cast<uint32_t>(std::stoul(info.m_vni));
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_ERROR("Invalid vni %s for %s", info.m_vni.c_str(), info.m_vxlan.c_str());
+        return NLE_INVAL;
+    }
+    return toNlResult(netDev.addVxlanLink(info.m_vxlan, vni, info.m_sourceIp, "", VXLAN_DST_PORT),
+                      "create vxlan", info.m_vxlan);
 }
 
-static int cmdUpVxlan(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdUpVxlan(NetDevHelper & netDev, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN}} up
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlan)
-        << " up";
-    return swss::exec(cmd.str(), res);
+    return toNlResult(netDev.setLinkAdminStatus(info.m_vxlan, true), "set up", info.m_vxlan);
 }
 
-static int cmdCreateVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdCreateVxlanIf(NetDevHelper & netDev, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link add {{VXLAN_IF}} type bridge
-    ostringstream cmd;
-    cmd << IP_CMD " link add "
-        << shellquote(info.m_vxlanIf)
-        << " type bridge";
-    return swss::exec(cmd.str(), res);
+    return toNlResult(netDev.addBridgeLink(info.m_vxlanIf), "create bridge", info.m_vxlanIf);
 }
 
-static int cmdAddVxlanIntoVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdAddVxlanIntoVxlanIf(NetDevHelper & netDev, const swss::VxlanMgr::VxlanInfo & info)
 {
     // brctl addif {{VXLAN_IF}} {{VXLAN}}
-    ostringstream cmd;
-    cmd << BRCTL_CMD " addif "
-        << shellquote(info.m_vxlanIf)
-        << " "
-        << shellquote(info.m_vxlan);
-    if (!info.m_macAddress.empty())
+    int ret = toNlResult(netDev.setLinkMaster(info.m_vxlan, info.m_vxlanIf), "add into " + info.m_vxlanIf, info.m_vxlan);
+    if (ret == RET_SUCCESS && !info.m_macAddress.empty())
     {
         // Change the MAC address of Vxlan bridge interface to ensure it's same with switch's.
         // Otherwise it will not response traceroute packets.
         // ip link set dev {{VXLAN_IF}} address {{MAC_ADDRESS}}
-        cmd << " && " IP_CMD " link set dev "
-            << shellquote(info.m_vxlanIf)
-            << " address "
-            << shellquote(info.m_macAddress);
+        ret = toNlResult(netDev.setLinkMac(info.m_vxlanIf, MacAddress(info.m_macAddress)), "set mac", info.m_vxlanIf);
     }
-    return swss::exec(cmd.str(), res);
+    return ret;
 }
 
-static int cmdAttachVxlanIfToVnet(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdAttachVxlanIfToVnet(NetDevHelper & netDev, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN_IF}} master {{VNET}}
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlanIf)
-        << " master "
-        << shellquote(info.m_vnet);
-    return swss::exec(cmd.str(), res);
+    return toNlResult(netDev.setLinkMaster(info.m_vxlanIf, info.m_vnet), "set master " + info.m_vnet, info.m_vxlanIf);
 }
 
-static int cmdUpVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdUpVxlanIf(NetDevHelper & netDev, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN_IF}} up
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlanIf)
-        << " up";
-    return swss::exec(cmd.str(), res);
+    return toNlResult(netDev.setLinkAdminStatus(info.m_vxlanIf, true), "set up", info.m_vxlanIf);
 }
 
-static int cmdDeleteVxlan(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdDeleteVxlan(NetDevHelper & netDev, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link del dev {{VXLAN}}
-    ostringstream cmd;
-    cmd << IP_CMD " link del dev "
-        << shellquote(info.m_vxlan);
-    return swss::exec(cmd.str(), res);
+    return toNlResult(netDev.delLink(info.m_vxlan), "delete", info.m_vxlan);
 }
 
-static int cmdVxlanLearningOff(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdVxlanLearningOff(NetDevHelper & netDev, const swss::VxlanMgr::VxlanInfo & info)
 {
     // bridge link set dev {{VXLAN}} learning off
-    ostringstream cmd;
-    cmd << BRIDGE_CMD << " link set dev "
-        << shellquote(info.m_vxlan) << " learning off";
-    return swss::exec(cmd.str(), res);
+    return toNlResult(netDev.setBridgePortLearning(info.m_vxlan, false), "disable learning on", info.m_vxlan);
 }
 
-static int cmdDeleteVxlanFromVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdDeleteVxlanFromVxlanIf(NetDevHelper & netDev, const swss::VxlanMgr::VxlanInfo & info)
 {
     // brctl delif {{VXLAN_IF}} {{VXLAN}}
-    ostringstream cmd;
-    cmd << BRCTL_CMD " delif "
-        << shellquote(info.m_vxlanIf)
-        << " " 
-        << shellquote(info.m_vxlan);
-    return swss::exec(cmd.str(), res);
+    return toNlResult(netDev.setLinkMaster(info.m_vxlan, ""), "remove from " + info.m_vxlanIf, info.m_vxlan);
 }
 
-static int cmdDeleteVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdDeleteVxlanIf(NetDevHelper & netDev, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link del {{VXLAN_IF}}
-    ostringstream cmd;
-    cmd << IP_CMD " link del "
-        << shellquote(info.m_vxlanIf);
-    return swss::exec(cmd.str(), res);
+    return toNlResult(netDev.delLink(info.m_vxlanIf), "delete", info.m_vxlanIf);
 }
 
-static int cmdDetachVxlanIfFromVnet(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdDetachVxlanIfFromVnet(NetDevHelper & netDev, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN_IF}} nomaster
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlanIf)
-        << " nomaster";
-    return swss::exec(cmd.str(), res);
+    return toNlResult(netDev.setLinkMaster(info.m_vxlanIf, ""), "set nomaster", info.m_vxlanIf);
 }
 
 // Vxlanmgr
@@ -808,11 +777,10 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
 {
     SWSS_LOG_ENTER();
     
-    std::string res;
     int ret = 0;
 
     // Create Vxlan
-    ret = cmdCreateVxlan(info, res);
+    ret = cmdCreateVxlan(m_netDev, info);
     if (ret != RET_SUCCESS)
     {
         SWSS_LOG_WARN(
@@ -824,10 +792,10 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
     }
 
     // Up Vxlan
-    ret = cmdUpVxlan(info, res);
+    ret = cmdUpVxlan(m_netDev, info);
     if (ret != RET_SUCCESS)
     {
-        cmdDeleteVxlan(info, res);
+        cmdDeleteVxlan(m_netDev, info);
         SWSS_LOG_WARN(
             "Fail to up vxlan %s",
             info.m_vxlan.c_str());
@@ -835,10 +803,10 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
     }
 
     // Create Vxlan Interface
-    ret = cmdCreateVxlanIf(info, res);
+    ret = cmdCreateVxlanIf(m_netDev, info);
     if (ret != RET_SUCCESS)
     {
-        cmdDeleteVxlan(info, res);
+        cmdDeleteVxlan(m_netDev, info);
         SWSS_LOG_WARN(
             "Fail to create vxlan interface %s",
             info.m_vxlanIf.c_str());
@@ -846,11 +814,11 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
     }
 
     // Add vxlan into vxlan interface
-    ret = cmdAddVxlanIntoVxlanIf(info, res);
+    ret = cmdAddVxlanIntoVxlanIf(m_netDev, info);
     if ( ret != RET_SUCCESS )
     {
-        cmdDeleteVxlanIf(info, res);
-        cmdDeleteVxlan(info, res);
+        cmdDeleteVxlanIf(m_netDev, info);
+        cmdDeleteVxlan(m_netDev, info);
         SWSS_LOG_WARN(
             "Fail to add %s into %s",
             info.m_vxlan.c_str(),
@@ -859,12 +827,12 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
     }
 
     // Attach vxlan interface to vnet
-    ret = cmdAttachVxlanIfToVnet(info, res);
+    ret = cmdAttachVxlanIfToVnet(m_netDev, info);
     if ( ret != RET_SUCCESS )
     {
-        cmdDeleteVxlanFromVxlanIf(info, res);
-        cmdDeleteVxlanIf(info, res);
-        cmdDeleteVxlan(info, res);
+        cmdDeleteVxlanFromVxlanIf(m_netDev, info);
+        cmdDeleteVxlanIf(m_netDev, info);
+        cmdDeleteVxlan(m_netDev, info);
         SWSS_LOG_WARN(
             "Fail to set %s master %s",
             info.m_vxlanIf.c_str(),
@@ -874,13 +842,13 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
     }
 
     // Up Vxlan Interface
-    ret = cmdUpVxlanIf(info, res);
+    ret = cmdUpVxlanIf(m_netDev, info);
     if ( ret != RET_SUCCESS )
     {
-        cmdDetachVxlanIfFromVnet(info, res);
-        cmdDeleteVxlanFromVxlanIf(info, res);
-        cmdDeleteVxlanIf(info, res);
-        cmdDeleteVxlan(info, res);
+        cmdDetachVxlanIfFromVnet(m_netDev, info);
+        cmdDeleteVxlanFromVxlanIf(m_netDev, info);
+        cmdDeleteVxlanIf(m_netDev, info);
+        cmdDeleteVxlan(m_netDev, info);
         SWSS_LOG_WARN(
             "Fail to up bridge %s",
             info.m_vxlanIf.c_str());
@@ -898,12 +866,10 @@ bool VxlanMgr::deleteVxlan(const VxlanInfo & info)
 {
     SWSS_LOG_ENTER();
 
-    std::string res;
-
-    cmdDetachVxlanIfFromVnet(info, res);
-    cmdDeleteVxlanFromVxlanIf(info, res);
-    cmdDeleteVxlanIf(info, res);
-    cmdDeleteVxlan(info, res);
+    cmdDetachVxlanIfFromVnet(m_netDev, info);
+    cmdDeleteVxlanFromVxlanIf(m_netDev, info);
+    cmdDeleteVxlanIf(m_netDev, info);
+    cmdDeleteVxlan(m_netDev, info);
 
     m_stateVxlanTable.del(info.m_vxlan);
 
@@ -954,11 +920,11 @@ int VxlanMgr::createVxlanNetdevice(std::string vxlanTunnelName, std::string vni_
                                    std::string src_ip, std::string dst_ip,
                                    std::string vlan_id)
 {
-    std::string res, cmds;
-    std::string link_add_cmd, link_set_master_cmd, link_up_cmd;
-    std::string bridge_add_cmd, bridge_untagged_add_cmd, bridge_del_vid_cmd, bridge_learn_off_cmd;
     std::string vxlan_dev_name;
     bool evpn_nvo = false;
+    uint32_t vni;
+    uint16_t vid;
+    int ret;
 
     vxlan_dev_name = std::string("") + std::string(vxlanTunnelName) + "-" +
                      std::string(vlan_id);
@@ -1000,120 +966,100 @@ int VxlanMgr::createVxlanNetdevice(std::string vxlanTunnelName, std::string vni_
         evpn_nvo = true;
     }
 
-    // ip link add <vxlan_dev_name> type vxlan id <vni> local <src_ip> remote <dst_ip> 
-    // dstport 4789
-    // ip link set <vxlan_dev_name> master DOT1Q_BRIDGE_NAME
-    // bridge vlan add vid <vlan_id> dev <vxlan_dev_name>
+    try
+    {
+        vni = static_cast<uint32_t>(std::stoul(vni_id));
+        vid = static_cast<uint16_t>(std::stoul(vlan_id));
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_ERROR("Invalid vni %s or vlan %s for %s", vni_id.c_str(), vlan_id.c_str(),
+                       vxlan_dev_name.c_str());
+        return NLE_INVAL;
+    }
+
+    // The steps below used to be one chain of ip/bridge commands run by a shell per VNI:
+    // ip link add <vxlan_dev_name> address <mac> type vxlan id <vni> local <src_ip> remote <dst_ip>
+    // nolearning dstport 4789 + ip link set <vxlan_dev_name> master DOT1Q_BRIDGE_NAME
     // bridge vlan add vid <vlan_id> untagged pvid dev <vxlan_dev_name>
+    // bridge vlan del vid 1 dev <vxlan_dev_name>
     // bridge link set dev <vxlan_dev_name> learning off
     // ip link set <vxlan_dev_name> up
+    // They are now netlink requests on one socket, stopping at the first failure as before.
 
-    link_add_cmd = std::string("") + IP_CMD + " link add " + vxlan_dev_name + 
-                   " address " + gMacAddress.to_string() + " type vxlan id " + 
-                   std::string(vni_id) + " local " + src_ip + 
-                   ((dst_ip  == "")? "":(" remote " + dst_ip)) + 
-                   " nolearning " + " dstport 4789 ";
-    
-    link_set_master_cmd = std::string("") + IP_CMD + " link set " + 
-                          vxlan_dev_name + " master Bridge ";
-
-    link_up_cmd = std::string("") + IP_CMD + " link set " + vxlan_dev_name + " up ";
-
-    bridge_add_cmd = std::string("") + BRIDGE_CMD + " vlan add vid " + 
-                     std::string(vlan_id) + " dev " + vxlan_dev_name;
-
-    bridge_untagged_add_cmd = std::string("") + BRIDGE_CMD + " vlan add vid " + 
-                              std::string(vlan_id) + " untagged pvid dev " + vxlan_dev_name;
+    ret = toNlResult(m_netDev.addVxlanLink(vxlan_dev_name, vni, src_ip, dst_ip, VXLAN_DST_PORT,
+                                           DOT1Q_BRIDGE_NAME, gMacAddress, false),
+                     "create vxlan", vxlan_dev_name);
+    if (ret != RET_SUCCESS)
+    {
+        return ret;
+    }
 
-    bridge_del_vid_cmd = std::string("") + BRIDGE_CMD + " vlan del vid 1 dev " + 
-                         vxlan_dev_name;
+    ret = toNlResult(m_netDev.addBridgeVlans(vxlan_dev_name, {{vid, true, true}}),
+                     "add vlan " + vlan_id + " on", vxlan_dev_name);
+    if (ret != RET_SUCCESS)
+    {
+        return ret;
+    }
 
-    bridge_learn_off_cmd = std::string("") + BRIDGE_CMD + " link set dev " +
-                           vxlan_dev_name + " learning off ";
-    
-    
-    cmds = std::string("") + BASH_CMD + " -c \"" + 
-           link_add_cmd + " && " + 
-           link_set_master_cmd + " && " + 
-           bridge_add_cmd + " && " + 
-           bridge_untagged_add_cmd + " && "; 
-        
-    if ( vlan_id != "1")
+    if (vid != 1)
     {
-        cmds += bridge_del_vid_cmd + " && ";
+        ret = toNlResult(m_netDev.delBridgeVlans(vxlan_dev_name, {1}), "del vlan 1 on", vxlan_dev_name);
+        if (ret != RET_SUCCESS)
+        {
+            return ret;
+        }
     }
 
     if (evpn_nvo)
     {
-        cmds += bridge_learn_off_cmd + " && ";
+        ret = toNlResult(m_netDev.setBridgePortLearning(vxlan_dev_name, false),
+                         "disable learning on", vxlan_dev_name);
+        if (ret != RET_SUCCESS)
+        {
+            return ret;
+        }
     }
 
-    cmds += link_up_cmd + "\"";
-
-    return swss::exec(cmds,res);
+    return toNlResult(m_netDev.setLinkAdminStatus(vxlan_dev_name, true), "set up", vxlan_dev_name);
 }
 
 int VxlanMgr::downVxlanNetdevice(std::string vxlan_dev_name)
 {
     int ret = 0;
-    std::string res;
-    const std::string cmd = std::string("") + IP_CMD + " link set dev " + vxlan_dev_name + " down";
-    exec(cmd, res);
+    toNlResult(m_netDev.setLinkAdminStatus(vxlan_dev_name, false), "set down", vxlan_dev_name);
     return ret;
 }
 
 int VxlanMgr::deleteVxlanNetdevice(std::string vxlan_dev_name)
 {    
-    std::string res;
-    const std::string cmd = std::string("") + IP_CMD  + " link del dev " + vxlan_dev_name;
-    return swss::exec(cmd, res);
-}
-
-std::vector<std::string> VxlanMgr::parseNetDev(const string& stdout){
-    std::vector<std::string> netdevs;
-    std::regex device_name_pattern("^\\d+:\\s+([^:]+)");
-    std::smatch match_result;
-    auto lines = tokenize(stdout, '\n');
-    for (const std::string & line : lines)
-    {
-        SWSS_LOG_DEBUG("line : %s\n",line.c_str());
-        if (!std::regex_search(line, match_result, device_name_pattern))
-        {
-            continue;
-        }
-        std::string dev_name = match_result[1];
-        netdevs.push_back(dev_name);
-    }
-    return netdevs;
+    return toNlResult(m_netDev.delLink(vxlan_dev_name), "delete", vxlan_dev_name);
 }
 
 void VxlanMgr::getAllVxlanNetDevices()
 {
-    std::string stdout;
+    std::vector<std::string> netdevs;
 
     // Get VxLan Netdev Interfaces
-    std::string cmd = std::string("") + IP_CMD + " link show type vxlan";
-    int ret = swss::exec(cmd, stdout);
-    if (ret != 0)
+    int ret = m_netDev.getLinksByType(VXLAN, netdevs);
+    if (ret < 0)
     {
-        SWSS_LOG_ERROR("Cannot get vxlan devices by command : %s", cmd.c_str());
-        stdout.clear();
+        SWSS_LOG_ERROR("Cannot get vxlan devices: %s", nl_geterror(ret));
+        netdevs.clear();
     }
-    std::vector<std::string> netdevs = parseNetDev(stdout);
     for (auto netdev : netdevs)
     {
         m_vxlanNetDevices[netdev] = VXLAN;
     }
 
     // Get VxLanIf Netdev Interfaces
-    cmd = std::string("") + IP_CMD + " link show type bridge";
-    ret = swss::exec(cmd, stdout);
-    if (ret != 0)
+    netdevs.clear();
+    ret = m_netDev.getLinksByType("bridge", netdevs);
+    if (ret < 0)
     {
-        SWSS_LOG_ERROR("Cannot get vxlanIf devices by command : %s", cmd.c_str());
-        stdout.clear();
+        SWSS_LOG_ERROR("Cannot get vxlanIf devices: %s", nl_geterror(ret));
+        netdevs.clear();
     }
-    netdevs = parseNetDev(stdout);
     for (auto netdev : netdevs)
     {
         if (netdev.find(VXLAN_IF_NAME_PREFIX) == 0)
@@ -1222,17 +1168,16 @@ void VxlanMgr::clearAllVxlanDevices()
         std::string netdev_type = it->second;
         SWSS_LOG_INFO("Deleting Stale NetDevice %s, type: %s\n", netdev_name.c_str(), netdev_type.c_str());
         VxlanInfo info;
-        std::string res;
         if (netdev_type.compare(VXLAN))
         {
             info.m_vxlan = netdev_name;
             downVxlanNetdevice(netdev_name);
-            cmdDeleteVxlan(info, res);
+            cmdDeleteVxlan(m_netDev, info);
         }
         else if(netdev_type.compare(VXLAN_IF))
         {
             info.m_vxlanIf = netdev_name;
-            cmdDeleteVxlanIf(info, res);
+            cmdDeleteVxlanIf(m_netDev, info);
         }
         it = m_vxlanNetDevices.erase(it);
     }
@@ -1244,12 +1189,11 @@ void VxlanMgr::disableLearningForAllVxlanNetdevices()
     {
         std::string netdev_name = it->second.vxlan_dev_name;
         VxlanInfo info;
-        std::string res;
         if (!netdev_name.empty())
         {
             SWSS_LOG_INFO("Disable learning for NetDevice %s\n", netdev_name.c_str());
             info.m_vxlan = netdev_name;
-            cmdVxlanLearningOff(info, res);
+            cmdVxlanLearningOff(m_netDev, info);
         }
     }
 }
@@ -4,6 +4,7 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "netdevhelper.h"
 
 #include <map>
 #include <vector>
@@ -72,7 +73,6 @@ private:
                              std::string src_ip, std::string dst_ip, std::string vlan_id);
     int downVxlanNetdevice(std::string vxlan_dev_name);
     int deleteVxlanNetdevice(std::string vxlan_dev_name);
-    std::vector<std::string> parseNetDev(const std::string& stdout);
     void getAllVxlanNetDevices();
 
     /*
@@ -115,6 +115,7 @@ private:
     std::map<std::string, VxlanInfo> m_vnetCache;
 
     DBConnector *m_app_db;
+    NetDevHelper m_netDev;
     bool m_in_reconcile;
     std::vector<std::string> m_appVxlanTunnelMapKeysRecon;
     std::map<std::string, std::string> m_vxlanNetDevices;
@@ -0,0 +1,178 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <chrono>
+#include <stdexcept>
+
+#include "logger.h"
+#include "wpactrl.h"
+
+using namespace std;
+using namespace swss;
+
+/* wpa_supplicant replies to the status commands with a few KB at most */
+#define WPA_CTRL_REPLY_SIZE 16384
+
+constexpr size_t WpaCtrl::MAX_INFLIGHT;
+constexpr int WpaCtrl::TIMEOUT_MS;
+
+WpaCtrl::WpaCtrl(const string &path) :
+    m_path(path),
+    m_fd(-1)
+{
+}
+
+WpaCtrl::~WpaCtrl()
+{
+    close();
+}
+
+bool WpaCtrl::connect()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_fd >= 0)
+    {
+        return true;
+    }
+
+    struct sockaddr_un remote;
+    if (m_path.size() >= sizeof(remote.sun_path))
+    {
+        SWSS_LOG_ERROR("Control socket path %s is too long", m_path.c_str());
+        return false;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        SWSS_LOG_ERROR("Cannot open a control socket: %s", strerror(errno));
+        return false;
+    }
+
+    // Autobind to an abstract address, wpa_supplicant replies to it and
+    // nothing is left in the filesystem, unlike the /tmp sockets of wpa_cli
+    struct sockaddr_un local;
+    memset(&local, 0, sizeof(local));
+    local.sun_family = AF_UNIX;
+    if (::bind(fd, (struct sockaddr *)&local, sizeof(sa_family_t)) < 0)
+    {
+        SWSS_LOG_ERROR("Cannot bind the control socket: %s", strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    memset(&remote, 0, sizeof(remote));
+    remote.sun_family = AF_UNIX;
+    strncpy(remote.sun_path, m_path.c_str(), sizeof(remote.sun_path) - 1);
+    if (::connect(fd, (struct sockaddr *)&remote, sizeof(remote)) < 0)
+    {
+        SWSS_LOG_DEBUG("Cannot connect to %s: %s", m_path.c_str(), strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    return true;
+}
+
+void WpaCtrl::close()
+{
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+string WpaCtrl::request(const string &cmd)
+{
+    return request(vector<string>{cmd}).front();
+}
+
+vector<string> WpaCtrl::request(const vector<string> &cmds)
+{
+    SWSS_LOG_ENTER();
+
+    if (!connect())
+    {
+        throw runtime_error("Cannot connect to wpa_supplicant at " + m_path);
+    }
+
+    vector<string> replies;
+    replies.reserve(cmds.size());
+
+    size_t sent = 0;
+    try
+    {
+        while (replies.size() < cmds.size())
+        {
+            while (sent < cmds.size() && sent - replies.size() < MAX_INFLIGHT)
+            {
+                send(cmds[sent++]);
+            }
+            replies.push_back(receive(cmds[replies.size()]));
+        }
+    }
+    catch (const runtime_error &)
+    {
+        // Replies still in flight would be taken for the ones of the next request
+        close();
+        throw;
+    }
+
+    return replies;
+}
+
+void WpaCtrl::send(const string &cmd)
+{
+    if (::send(m_fd, cmd.data(), cmd.size(), 0) < 0)
+    {
+        throw runtime_error("Cannot send '" + cmd + "' to " + m_path + ": " + strerror(errno));
+    }
+}
+
+string WpaCtrl::receive(const string &cmd)
+{
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(TIMEOUT_MS);
+    char buf[WPA_CTRL_REPLY_SIZE];
+
+    while (true)
+    {
+        auto left = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+        struct pollfd pfd = { m_fd, POLLIN, 0 };
+        int ret = left > 0 ? poll(&pfd, 1, static_cast<int>(left)) : 0;
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw runtime_error("Cannot poll " + m_path + ": " + strerror(errno));
+        }
+        if (ret == 0)
+        {
+            throw runtime_error("'" + cmd + "' command timed out.");
+        }
+
+        ssize_t len = recv(m_fd, buf, sizeof(buf), 0);
+        if (len < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+            {
+                continue;
+            }
+            throw runtime_error("Cannot receive from " + m_path + ": " + strerror(errno));
+        }
+
+        // Unsolicited event messages are "<level>text", never a reply
+        if (len > 0 && buf[0] == '<')
+        {
+            continue;
+        }
+        return string(buf, static_cast<size_t>(len));
+    }
+}
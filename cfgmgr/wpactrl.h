@@ -0,0 +1,53 @@
+#ifndef __WPACTRL__
+#define __WPACTRL__
+
+#include <string>
+#include <vector>
+
+namespace swss {
+
+/*
+ * Client of the wpa_supplicant control interface, the protocol wpa_cli
+ * speaks: one datagram per command over an AF_UNIX socket, one datagram
+ * per reply. The socket is connected once and kept, so the commands of a
+ * port don't fork wpa_cli each. Commands are pipelined, a batch is sent
+ * and its replies are read back in order. Failures throw
+ * std::runtime_error, a timeout with the "command timed out" message of
+ * wpa_cli, and close the socket, the next request reconnects.
+ */
+class WpaCtrl
+{
+public:
+    WpaCtrl(const std::string &path);
+    ~WpaCtrl();
+
+    WpaCtrl(const WpaCtrl&) = delete;
+    WpaCtrl& operator=(const WpaCtrl&) = delete;
+
+    /* Returns false if the control socket of wpa_supplicant isn't up */
+    bool connect();
+    void close();
+    bool isConnected() const
+    {
+        return m_fd >= 0;
+    }
+
+    std::string request(const std::string &cmd);
+    /* Send the commands pipelined, the replies are returned in order */
+    std::vector<std::string> request(const std::vector<std::string> &cmds);
+
+    /* Replies not yet read never exceed the receive queue of the socket */
+    static constexpr size_t MAX_INFLIGHT = 8;
+    static constexpr int TIMEOUT_MS = 10000;
+
+private:
+    void send(const std::string &cmd);
+    std::string receive(const std::string &cmd);
+
+    std::string m_path;
+    int m_fd;
+};
+
+}
+
+#endif
@@ -21,9 +21,22 @@ using namespace swss;
 
 #define VXLAN_BR_IF_NAME_PREFIX    "Brvxlan"
 
+/* Build the cache key of a MAC, returns false if the MAC string is malformed */
+static bool makeFdbMacKey(int vlan, const string &mac, FdbMacKey &key)
+{
+    key.vlan = (uint16_t)vlan;
+    return MacAddress::parseMacString(mac, key.mac);
+}
+
+/* The "Vlan<ID>:<mac>" form of a cache key, as used by the DB tables */
+static string fdbMacKeyToString(const FdbMacKey &key)
+{
+    return "Vlan" + to_string(key.vlan) + ":" + MacAddress::to_string(key.mac);
+}
+
 FdbSync::FdbSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb, DBConnector *config_db) :
-    m_fdbTable(pipelineAppDB, APP_VXLAN_FDB_TABLE_NAME),
-    m_imetTable(pipelineAppDB, APP_VXLAN_REMOTE_VNI_TABLE_NAME),
+    m_fdbTable(pipelineAppDB, APP_VXLAN_FDB_TABLE_NAME, true),
+    m_imetTable(pipelineAppDB, APP_VXLAN_REMOTE_VNI_TABLE_NAME, true),
     m_fdbStateTable(stateDb, STATE_FDB_TABLE_NAME),
     m_mclagRemoteFdbStateTable(stateDb, STATE_MCLAG_REMOTE_FDB_TABLE_NAME),
     m_cfgEvpnNvoTable(config_db, CFG_VXLAN_EVPN_NVO_TABLE_NAME)
@@ -92,27 +105,37 @@ void FdbSync::processCfgEvpnNvo()
             m_isEvpnNvoExist = false;
         }
 
-        if (lastNvoState != m_isEvpnNvoExist)
-        {
-            updateAllLocalMac();
-        }
+    }
+
+    if (lastNvoState != m_isEvpnNvoExist)
+    {
+        updateAllLocalMac();
     }
     return;
 }
 
+/*
+ * Only the local MACs whose kernel state differs from the NVO state are
+ * touched, the ones already added or deleted are skipped
+ */
 void FdbSync::updateAllLocalMac()
 {
-    for ( auto it = m_fdb_mac.begin(); it != m_fdb_mac.end(); ++it )
+    for (auto &it : m_fdb_mac)
     {
+        if (it.second.programmed == m_isEvpnNvoExist)
+        {
+            continue;
+        }
+
         if (m_isEvpnNvoExist)
         {
             /* Add the Local FDB entry into Kernel */
-            addLocalMac(it->first, "replace");
+            addLocalMac(it.first, it.second, "replace");
         }
         else
         {
             /* Delete the Local FDB entry from Kernel */
-            addLocalMac(it->first, "del");
+            addLocalMac(it.first, it.second, "del");
         }
     }
 }
@@ -138,6 +161,13 @@ void FdbSync::processStateFdb()
         info.vid = vlan_name;
         info.mac = mac_address;
 
+        if (vlan_name.size() <= 4 ||
+            !makeFdbMacKey(atoi(vlan_name.c_str() + 4), mac_address, info.key))
+        {
+            SWSS_LOG_ERROR("Invalid STATE FDB key %s", key.c_str());
+            continue;
+        }
+
         if(op == "SET")
         {
             info.op_type = FDB_OPER_ADD ;
@@ -201,6 +231,13 @@ void FdbSync::processStateMclagRemoteFdb()
         info.vid = vlan_name;
         info.mac = mac_address;
 
+        if (vlan_name.size() <= 4 ||
+            !makeFdbMacKey(atoi(vlan_name.c_str() + 4), mac_address, info.key))
+        {
+            SWSS_LOG_ERROR("Invalid STATE FDB key %s", key.c_str());
+            continue;
+        }
+
         if(op == "SET")
         {
             info.op_type = FDB_OPER_ADD ;
@@ -245,41 +282,40 @@ void FdbSync::processStateMclagRemoteFdb()
 
 void FdbSync::macUpdateCache(struct m_fdb_info *info)
 {
-    string key = info->vid + ":" + info->mac;
-    m_fdb_mac[key].port_name = info->port_name;
-    m_fdb_mac[key].type      = info->type;
+    auto &entry = m_fdb_mac[info->key];
+    entry.port_name = info->port_name;
+    entry.type      = info->type;
 
     return;
 }
 
 void FdbSync::macUpdateMclagRemoteCache(struct m_fdb_info *info)
 {
-    string key = info->vid + ":" + info->mac;
-    m_mclag_remote_fdb_mac[key].port_name = info->port_name;
-    m_mclag_remote_fdb_mac[key].type      = info->type;
+    auto &entry = m_mclag_remote_fdb_mac[info->key];
+    entry.port_name = info->port_name;
+    entry.type      = info->type;
 
     return;
 }
 
 bool FdbSync::macCheckSrcDB(struct m_fdb_info *info)
 {
-    string key = info->vid + ":" + info->mac;
-    if (m_fdb_mac.find(key) != m_fdb_mac.end())
+    if (m_fdb_mac.find(info->key) != m_fdb_mac.end())
     {
-        SWSS_LOG_INFO("DEL_KEY %s ", key.c_str());
+        SWSS_LOG_INFO("DEL_KEY %s:%s ", info->vid.c_str(), info->mac.c_str());
         return true;
     }
 
     return false;
 }
 
-void FdbSync::macDelVxlanEntry(string auxkey, struct m_fdb_info *info)
+void FdbSync::macDelVxlanEntry(const FdbMacKey &key, struct m_fdb_info *info)
 {
-    std::string vtep = m_mac[auxkey].vtep;
+    const m_mac_info &vxlan_mac = m_mac[key];
 
     const std::string cmds = std::string("")
         + " bridge fdb del " + info->mac + " dev " 
-        + m_mac[auxkey].ifname + " dst " + vtep + " vlan " + info->vid.substr(4);
+        + vxlan_mac.ifname + " dst " + vxlan_mac.vtep + " vlan " + info->vid.substr(4);
 
     std::string res;
     int ret = swss::exec(cmds, res);
@@ -307,13 +343,15 @@ void FdbSync::updateLocalMac (struct m_fdb_info *info)
         op = "replace";
         port_name = info->port_name;
         fdb_type = info->type;
+        m_fdb_mac[info->key].programmed = m_isEvpnNvoExist;
     }
     else
     {
+        auto it = m_fdb_mac.find(info->key);
         op = "del";
-        port_name = m_fdb_mac[key].port_name;
-        fdb_type = m_fdb_mac[key].type;
-        m_fdb_mac.erase(key);
+        port_name = it->second.port_name;
+        fdb_type = it->second.type;
+        m_fdb_mac.erase(it);
     }
 
     if (!m_isEvpnNvoExist)
@@ -343,67 +381,54 @@ void FdbSync::updateLocalMac (struct m_fdb_info *info)
     if (info->op_type == FDB_OPER_ADD)
     {
         /* Check if this vlan+key is also learned by vxlan neighbor then delete the dest entry */
-        if (m_mac.find(key) != m_mac.end())
+        if (m_mac.find(info->key) != m_mac.end())
         {
-            macDelVxlanEntry(key, info);
+            macDelVxlanEntry(info->key, info);
             SWSS_LOG_INFO("Local learn event deleting from VXLAN table DEL_KEY %s", key.c_str());
-            macDelVxlan(key);
+            macDelVxlan(info->key);
         }
     }
 
     return;
 }
 
-void FdbSync::addLocalMac(string key, string op)
+void FdbSync::addLocalMac(const FdbMacKey &key, m_local_fdb_info &entry, string op)
 {
     char *type;
-    string port_name = "";
-    string mac = "";
-    string vlan = "";
-    size_t str_loc = string::npos;
+    string vlan = to_string(key.vlan);
+    string mac = MacAddress::to_string(key.mac);
 
-    str_loc = key.find(":");
-    if (str_loc == string::npos)
+    SWSS_LOG_INFO("Local route Vlan:%s MAC:%s Op:%s", vlan.c_str(), mac.c_str(), op.c_str());
+
+    if (entry.port_name.empty())
     {
-        SWSS_LOG_ERROR("Local MAC issue with Key:%s", key.c_str());
+        SWSS_LOG_INFO("Port name not present MAC route Vlan:%s MAC:%s", vlan.c_str(), mac.c_str());
         return;
     }
-    vlan = key.substr(4,  str_loc-4);
-    mac = key.substr(str_loc+1,  std::string::npos);
-
-    SWSS_LOG_INFO("Local route Vlan:%s MAC:%s Key:%s Op:%s", vlan.c_str(), mac.c_str(), key.c_str(), op.c_str());
 
-    if (m_fdb_mac.find(key)!=m_fdb_mac.end())
+    if (entry.type == FDB_TYPE_DYNAMIC)
     {
-        port_name = m_fdb_mac[key].port_name;
-        if (port_name.empty())
-        {
-            SWSS_LOG_INFO("Port name not present MAC route Key:%s", key.c_str());
-            return;
-        }
+        type = "dynamic extern_learn";
+    }
+    else
+    {
+        type = "static";
+    }
 
-        if (m_fdb_mac[key].type == FDB_TYPE_DYNAMIC)
-        {
-            type = "dynamic extern_learn";
-        }
-        else
-        {
-            type = "static";
-        }
+    const std::string cmds = std::string("")
+            + " bridge fdb " + op + " " + mac + " dev "
+            + entry.port_name + " master " + type  + " vlan " + vlan;
 
-        const std::string cmds = std::string("")
-                + " bridge fdb " + op + " " + mac + " dev "
-                + port_name + " master " + type  + " vlan " + vlan;
+    std::string res;
+    int ret = swss::exec(cmds, res);
+    if (ret != 0)
+    {
+        SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+    }
 
-        std::string res;
-        int ret = swss::exec(cmds, res);
-        if (ret != 0)
-        {
-            SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
-        }
+    SWSS_LOG_INFO("Config triggered cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
 
-        SWSS_LOG_INFO("Config triggered cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
-    }
+    entry.programmed = (op != "del");
     return;
 }
 
@@ -424,10 +449,16 @@ void FdbSync::updateMclagRemoteMac (struct m_fdb_info *info)
     }
     else
     {
+        auto it = m_mclag_remote_fdb_mac.find(info->key);
+        if (it == m_mclag_remote_fdb_mac.end())
+        {
+            SWSS_LOG_INFO("MCLAG remote MAC %s not cached", key.c_str());
+            return;
+        }
         op = "del";
-        port_name = m_mclag_remote_fdb_mac[key].port_name;
-        fdb_type = m_mclag_remote_fdb_mac[key].type;
-        m_mclag_remote_fdb_mac.erase(key);
+        port_name = it->second.port_name;
+        fdb_type = it->second.type;
+        m_mclag_remote_fdb_mac.erase(it);
     }
 
     if (fdb_type == FDB_TYPE_DYNAMIC)
@@ -453,16 +484,22 @@ void FdbSync::updateMclagRemoteMac (struct m_fdb_info *info)
 
 void FdbSync::updateMclagRemoteMacPort(int ifindex, int vlan, std::string mac)
 {
-    string key = "Vlan" + to_string(vlan) + ":" + mac;
+    FdbMacKey key;
     int type = 0;
     string port_name = "";
 
-    SWSS_LOG_INFO("Updating Intf %d, Vlan:%d MAC:%s Key %s", ifindex, vlan, mac.c_str(), key.c_str());
+    SWSS_LOG_INFO("Updating Intf %d, Vlan:%d MAC:%s", ifindex, vlan, mac.c_str());
 
-    if (m_mclag_remote_fdb_mac.find(key) != m_mclag_remote_fdb_mac.end())
+    if (!makeFdbMacKey(vlan, mac, key))
     {
-        type = m_mclag_remote_fdb_mac[key].type;
-        port_name = m_mclag_remote_fdb_mac[key].port_name;
+        return;
+    }
+
+    auto it = m_mclag_remote_fdb_mac.find(key);
+    if (it != m_mclag_remote_fdb_mac.end())
+    {
+        type = it->second.type;
+        port_name = it->second.port_name;
         SWSS_LOG_INFO(" port %s, type %d\n", port_name.c_str(), type);
 
         if (type == FDB_TYPE_STATIC)
@@ -494,22 +531,28 @@ void FdbSync::updateMclagRemoteMacPort(int ifindex, int vlan, std::string mac)
  */
 void FdbSync::macRefreshStateDB(int vlan, string kmac)
 {
-    string key = "Vlan" + to_string(vlan) + ":" + kmac;
+    FdbMacKey key;
     char *type;
     string port_name = "";
 
-    SWSS_LOG_INFO("Refreshing Vlan:%d MAC route MAC:%s Key %s", vlan, kmac.c_str(), key.c_str());
+    SWSS_LOG_INFO("Refreshing Vlan:%d MAC route MAC:%s", vlan, kmac.c_str());
 
-    if (m_fdb_mac.find(key)!=m_fdb_mac.end())
+    if (!makeFdbMacKey(vlan, kmac, key))
     {
-        port_name = m_fdb_mac[key].port_name;
+        return;
+    }
+
+    auto it = m_fdb_mac.find(key);
+    if (it != m_fdb_mac.end())
+    {
+        port_name = it->second.port_name;
         if (port_name.empty())
         {
-            SWSS_LOG_INFO("Port name not present MAC route Key:%s", key.c_str());
+            SWSS_LOG_INFO("Port name not present MAC route Vlan:%d MAC:%s", vlan, kmac.c_str());
             return;
         }
 
-        if (m_fdb_mac[key].type == FDB_TYPE_DYNAMIC)
+        if (it->second.type == FDB_TYPE_DYNAMIC)
         {
             type = "dynamic extern_learn";
         }
@@ -616,12 +659,13 @@ void FdbSync::imetDelRoute(struct in_addr vtep, string vlan_str, uint32_t vni)
     return;
 }
 
-void FdbSync::macDelVxlanDB(string key)
+void FdbSync::macDelVxlanDB(const FdbMacKey &mac_key)
 {
-    string vtep = m_mac[key].vtep;
-    string type;
-    string vni = to_string(m_mac[key].vni);
-    type = m_mac[key].type;
+    const m_mac_info &vxlan_mac = m_mac[mac_key];
+    string key = fdbMacKeyToString(mac_key);
+    string vtep = vxlan_mac.vtep;
+    string type = vxlan_mac.type;
+    string vni = to_string(vxlan_mac.vni);
 
     std::vector<FieldValueTuple> fvVector;
     FieldValueTuple rv("remote_vtep", vtep);
@@ -647,13 +691,14 @@ void FdbSync::macDelVxlanDB(string key)
 
 }
 
-void FdbSync::macAddVxlan(string key, struct in_addr vtep, string type, uint32_t vni, string intf_name)
+void FdbSync::macAddVxlan(const FdbMacKey &mac_key, struct in_addr vtep, string type, uint32_t vni, string intf_name)
 {
+    string key = fdbMacKeyToString(mac_key);
     string svtep = inet_ntoa(vtep);
     string svni = to_string(vni);
 
     /* Update the DB with Vxlan MAC */
-    m_mac[key] = {svtep, type, vni, intf_name};
+    m_mac[mac_key] = {svtep, type, vni, intf_name};
 
     std::vector<FieldValueTuple> fvVector;
     FieldValueTuple rv("remote_vtep", svtep);
@@ -678,13 +723,15 @@ void FdbSync::macAddVxlan(string key, struct in_addr vtep, string type, uint32_t
     return;
 }
 
-void FdbSync::macDelVxlan(string key)
+void FdbSync::macDelVxlan(const FdbMacKey &key)
 {
-    if (m_mac.find(key) != m_mac.end())
+    auto it = m_mac.find(key);
+    if (it != m_mac.end())
     {
-        SWSS_LOG_INFO("DEL_KEY %s vtep:%s type:%s", key.c_str(), m_mac[key].vtep.c_str(), m_mac[key].type.c_str());
+        SWSS_LOG_INFO("DEL_KEY %s vtep:%s type:%s", fdbMacKeyToString(key).c_str(),
+                      it->second.vtep.c_str(), it->second.type.c_str());
         macDelVxlanDB(key);
-        m_mac.erase(key);
+        m_mac.erase(it);
     }
     return;
 }
@@ -698,7 +745,7 @@ void FdbSync::onMsgNbr(int nlmsg_type, struct nl_object *obj)
     uint32_t vni = 0;
     nl_addr *vtep_addr;
     string ifname;
-    string key;
+    FdbMacKey key;
     bool delete_key = false;
     size_t str_loc = string::npos;
     string type = "";
@@ -820,9 +867,11 @@ void FdbSync::onMsgNbr(int nlmsg_type, struct nl_object *obj)
         return;
     }
 
-    key+= vlan_id;
-    key+= ":";
-    key+= macStr;
+    if (!makeFdbMacKey(atoi(vlan_id.c_str() + 4), macStr, key))
+    {
+        SWSS_LOG_INFO("Invalid VXLAN MAC %s on %s", macStr, ifname.c_str());
+        return;
+    }
 
     if (!delete_key)
     {
@@ -2,6 +2,9 @@
 #define __FDBSYNC__
 
 #include <string>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
 #include <arpa/inet.h>
 #include "dbconnector.h"
 #include "producerstatetable.h"
@@ -33,8 +36,37 @@ enum FDB_TYPE {
     FDB_TYPE_DYNAMIC = 2,
 };
 
+/*
+ * A cached MAC, keyed by the VLAN id and the MAC address as binary values
+ * rather than by the "Vlan<ID>:<mac>" string
+ */
+struct FdbMacKey
+{
+    uint16_t vlan;
+    uint8_t mac[6];
+
+    bool operator==(const FdbMacKey &other) const
+    {
+        return vlan == other.vlan && memcmp(mac, other.mac, sizeof(mac)) == 0;
+    }
+};
+
+struct FdbMacKeyHash
+{
+    size_t operator()(const FdbMacKey &key) const
+    {
+        uint64_t value = key.vlan;
+        for (uint8_t byte : key.mac)
+        {
+            value = (value << 8) | byte;
+        }
+        return std::hash<uint64_t>()(value);
+    }
+};
+
 struct m_fdb_info
 {
+    FdbMacKey key;
     std::string  mac;
     std::string  vid;           /*Store as Vlan<ID> */
     std::string  port_name;
@@ -96,12 +128,13 @@ private:
     {
         std::string port_name;
         short type;/*dynamic or static*/
+        bool programmed = false;    /* present in the kernel */
     };
-    std::unordered_map<std::string, m_local_fdb_info> m_fdb_mac;
+    std::unordered_map<FdbMacKey, m_local_fdb_info, FdbMacKeyHash> m_fdb_mac;
 
-    std::unordered_map<std::string, m_local_fdb_info> m_mclag_remote_fdb_mac;
+    std::unordered_map<FdbMacKey, m_local_fdb_info, FdbMacKeyHash> m_mclag_remote_fdb_mac;
 
-    void macDelVxlanEntry(std::string auxkey, struct m_fdb_info *info);
+    void macDelVxlanEntry(const FdbMacKey &key, struct m_fdb_info *info);
 
     void macUpdateCache(struct m_fdb_info *info);
 
@@ -130,7 +163,7 @@ private:
         unsigned int vni;
         std::string  ifname;
     };
-    std::unordered_map<std::string, m_mac_info> m_mac;
+    std::unordered_map<FdbMacKey, m_mac_info, FdbMacKeyHash> m_mac;
 
     struct m_imet_info
     {
@@ -145,10 +178,10 @@ private:
     };
     std::unordered_map<int, intf> m_intf_info;
 
-    void addLocalMac(std::string key, std::string op);
-    void macAddVxlan(std::string key, struct in_addr vtep, std::string type, uint32_t vni, std::string intf_name);
-    void macDelVxlan(std::string auxkey);
-    void macDelVxlanDB(std::string key);
+    void addLocalMac(const FdbMacKey &key, m_local_fdb_info &entry, std::string op);
+    void macAddVxlan(const FdbMacKey &key, struct in_addr vtep, std::string type, uint32_t vni, std::string intf_name);
+    void macDelVxlan(const FdbMacKey &key);
+    void macDelVxlanDB(const FdbMacKey &key);
     void imetAddRoute(struct in_addr vtep, std::string ifname, uint32_t vni);
     void imetDelRoute(struct in_addr vtep, std::string ifname, uint32_t vni);
     void onMsgNbr(int nlmsg_type, struct nl_object *obj);
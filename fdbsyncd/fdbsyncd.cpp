@@ -147,6 +147,9 @@ int main(int argc, char **argv)
                         }
                     }
                 }
+
+                /* The VXLAN_FDB and VNI updates of a select round go together */
+                pipelineAppDB.flush();
             }
         }
         catch (const std::exception& e)
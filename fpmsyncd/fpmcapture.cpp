@@ -0,0 +1,88 @@
+#include "fpmsyncd/fpmcapture.h"
+
+#include <cstring>
+#include <system_error>
+
+using namespace std;
+using namespace swss;
+
+void FpmCaptureWriter::open(const string &path)
+{
+    m_file.open(path, ios::binary | ios::trunc);
+    if (!m_file.is_open())
+    {
+        throw system_error(errno, system_category(), "Cannot create FPM capture " + path);
+    }
+
+    fpm_capture_file_hdr_t hdr{};
+    memcpy(hdr.magic, FPM_CAPTURE_MAGIC, sizeof(hdr.magic));
+    hdr.version = FPM_CAPTURE_VERSION;
+    m_file.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+
+    m_start = chrono::steady_clock::now();
+    m_count = 0;
+}
+
+void FpmCaptureWriter::close()
+{
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+}
+
+void FpmCaptureWriter::write(const fpm_msg_hdr_t *hdr)
+{
+    if (!m_file.is_open())
+    {
+        return;
+    }
+
+    fpm_capture_rec_hdr_t rec{};
+    auto usec = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - m_start).count();
+    rec.time_usec = static_cast<uint64_t>(usec);
+    rec.len = static_cast<uint32_t>(fpm_msg_len(hdr));
+
+    m_file.write(reinterpret_cast<const char *>(&rec), sizeof(rec));
+    m_file.write(reinterpret_cast<const char *>(hdr), rec.len);
+    m_count++;
+}
+
+void FpmCaptureReader::open(const string &path)
+{
+    m_file.open(path, ios::binary);
+    if (!m_file.is_open())
+    {
+        throw system_error(errno, system_category(), "Cannot open FPM capture " + path);
+    }
+
+    fpm_capture_file_hdr_t hdr{};
+    if (!m_file.read(reinterpret_cast<char *>(&hdr), sizeof(hdr))
+        || memcmp(hdr.magic, FPM_CAPTURE_MAGIC, sizeof(hdr.magic)) != 0
+        || hdr.version != FPM_CAPTURE_VERSION)
+    {
+        throw system_error(make_error_code(errc::invalid_argument), path + " is not an FPM capture");
+    }
+}
+
+bool FpmCaptureReader::next(fpm_capture_rec_hdr_t &rec, vector<char> &msg)
+{
+    if (!m_file.read(reinterpret_cast<char *>(&rec), sizeof(rec)))
+    {
+        return false;
+    }
+
+    if (rec.len < FPM_MSG_HDR_LEN || rec.len > FPM_MAX_MSG_LEN)
+    {
+        throw system_error(make_error_code(errc::bad_message), "Malformed FPM capture record");
+    }
+
+    msg.resize(rec.len);
+    if (!m_file.read(msg.data(), rec.len))
+    {
+        /* Truncated by the capturing fpmsyncd being stopped */
+        return false;
+    }
+
+    return true;
+}
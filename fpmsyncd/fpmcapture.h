@@ -0,0 +1,81 @@
+#ifndef __FPMCAPTURE__
+#define __FPMCAPTURE__
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "fpm/fpm.h"
+
+namespace swss {
+
+/*
+ * FPM stream capture, as written by fpmsyncd -c and read by fpmreplay.
+ *
+ * The file starts with a fpm_capture_file_hdr_t, followed by one record per
+ * FPM message: a fpm_capture_rec_hdr_t, then the FPM message as received
+ * from zebra, fpm_msg_hdr_t included. Fields are in host byte order, the
+ * FPM message is kept in its network order framing.
+ */
+#define FPM_CAPTURE_MAGIC   "FPMCAP\0\0"
+#define FPM_CAPTURE_VERSION 1
+
+typedef struct fpm_capture_file_hdr_t_
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+} fpm_capture_file_hdr_t;
+
+typedef struct fpm_capture_rec_hdr_t_
+{
+    /* Time since the capture started */
+    uint64_t time_usec;
+    /* Length of the FPM message which follows */
+    uint32_t len;
+    uint32_t reserved;
+} fpm_capture_rec_hdr_t;
+
+class FpmCaptureWriter
+{
+public:
+    /* Throws system_error if path cannot be created */
+    void open(const std::string &path);
+    void close();
+
+    bool isOpen() const
+    {
+        return m_file.is_open();
+    }
+
+    void write(const fpm_msg_hdr_t *hdr);
+
+    uint64_t getCount() const
+    {
+        return m_count;
+    }
+
+private:
+    std::ofstream m_file;
+    std::chrono::steady_clock::time_point m_start;
+    uint64_t m_count = 0;
+};
+
+class FpmCaptureReader
+{
+public:
+    /* Throws system_error if path cannot be read or is not a capture */
+    void open(const std::string &path);
+
+    /* Reads the next record, returns false at the end of the capture */
+    bool next(fpm_capture_rec_hdr_t &rec, std::vector<char> &msg);
+
+private:
+    std::ifstream m_file;
+};
+
+}
+
+#endif
@@ -3,6 +3,8 @@
 #include <swss/selectable.h>
 #include <libnl3/netlink/netlink.h>
 
+#include <vector>
+
 #include "fpm/fpm.h"
 
 namespace swss
@@ -22,6 +24,23 @@ public:
      * @return True on success, otherwise false is returned
      */
     virtual bool send(nlmsghdr* nl_hdr) = 0;
+
+    /**
+     * @brief Send netlink messages through FPM socket, in as few writes as possible
+     * @param msgs Netlink messages
+     * @return True on success, otherwise false is returned
+     */
+    virtual bool sendBatch(const std::vector<nlmsghdr*>& msgs)
+    {
+        for (auto nl_hdr : msgs)
+        {
+            if (!send(nl_hdr))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 };
 
 }
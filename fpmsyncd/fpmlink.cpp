@@ -237,6 +237,11 @@ uint64_t FpmLink::readData()
             throw system_error(make_error_code(errc::bad_message), "Malformed FPM message received");
         }
 
+        if (m_capture)
+        {
+            m_capture->write(hdr);
+        }
+
         processFpmMessage(hdr);
 
         start += msg_len;
@@ -260,6 +265,15 @@ void FpmLink::processFpmMessage(fpm_msg_hdr_t* hdr)
     /* Read all netlink messages inside FPM message */
     for (; NLMSG_OK (nl_hdr, msg_len); nl_hdr = NLMSG_NEXT(nl_hdr, msg_len))
     {
+        /*
+         * Plain IPv4/IPv6 routes are parsed straight from the netlink msg,
+         * saving the libnl object conversion on full table loads.
+         */
+        if (m_routesync->onRouteMsgRaw(nl_hdr))
+        {
+            continue;
+        }
+
         /*
          * EVPN Type5 Add Routes need to be process in Raw mode as they contain
          * RMAC, VLAN and L3VNI information.
@@ -322,6 +336,49 @@ bool FpmLink::send(nlmsghdr* nl_hdr)
     memcpy(m_sendBuffer, &hdr, sizeof(hdr));
     memcpy(m_sendBuffer + sizeof(hdr), nl_hdr, nl_hdr->nlmsg_len);
 
+    return sendBuffer(len);
+}
+
+bool FpmLink::sendBatch(const std::vector<nlmsghdr*>& msgs)
+{
+    /* Each message keeps its own FPM header, the frames are packed back to back */
+    size_t pos = 0;
+
+    for (auto nl_hdr : msgs)
+    {
+        fpm_msg_hdr_t hdr{};
+
+        size_t len = fpm_msg_align(sizeof(hdr) + nl_hdr->nlmsg_len);
+
+        if (len > m_bufSize)
+        {
+            SWSS_LOG_THROW("Message length %zu is greater than the send buffer size %d", len, m_bufSize);
+        }
+
+        if (pos + len > m_bufSize)
+        {
+            if (!sendBuffer(pos))
+            {
+                return false;
+            }
+            pos = 0;
+        }
+
+        hdr.version = FPM_PROTO_VERSION;
+        hdr.msg_type = FPM_MSG_TYPE_NETLINK;
+        hdr.msg_len = htons(static_cast<uint16_t>(len));
+
+        memset(m_sendBuffer + pos, 0, len);
+        memcpy(m_sendBuffer + pos, &hdr, sizeof(hdr));
+        memcpy(m_sendBuffer + pos + sizeof(hdr), nl_hdr, nl_hdr->nlmsg_len);
+        pos += len;
+    }
+
+    return pos == 0 || sendBuffer(pos);
+}
+
+bool FpmLink::sendBuffer(size_t len)
+{
     size_t sent = 0;
     while (sent != len)
     {
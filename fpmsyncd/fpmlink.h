@@ -13,6 +13,7 @@
 
 #include "fpm/fpm.h"
 #include "fpmsyncd/fpminterface.h"
+#include "fpmsyncd/fpmcapture.h"
 #include "fpmsyncd/routesync.h"
 
 #define RTM_NEWSRV6LOCALSID		1000
@@ -48,10 +49,21 @@ public:
 
     void processFpmMessage(fpm_msg_hdr_t* hdr);
 
+    /* Record every FPM message received into capture, nullptr stops it */
+    void setCapture(FpmCaptureWriter *capture)
+    {
+        m_capture = capture;
+    }
+
     bool send(nlmsghdr* nl_hdr) override;
+    bool sendBatch(const std::vector<nlmsghdr*>& msgs) override;
 
 private:
+    /* Writes len bytes of the send buffer to the connection */
+    bool sendBuffer(size_t len);
+
     RouteSync *m_routesync;
+    FpmCaptureWriter *m_capture = nullptr;
     unsigned int m_bufSize;
     char *m_messageBuffer;
     char *m_sendBuffer;
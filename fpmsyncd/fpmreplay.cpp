@@ -0,0 +1,313 @@
+#include <getopt.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <linux/rtnetlink.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "dbconnector.h"
+#include "ipprefix.h"
+#include "logger.h"
+#include "schema.h"
+#include "fpmsyncd/fpmcapture.h"
+
+#include <netlink/route/route.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace swss;
+
+/*
+ * fpmreplay feeds an FPM capture recorded by fpmsyncd -c to fpmsyncd, in
+ * place of zebra, and reports how fast the routes make it to APPL_DB and to
+ * orchagent.
+ *
+ * Once the capture is sent, a marker blackhole route is sent after it. The
+ * routes go through fpmsyncd and orchagent in order, so the capture is
+ * written to APPL_DB once the marker shows up in ROUTE_TABLE, and consumed
+ * by orchagent once the marker left the producer side of the table. The
+ * marker is deleted at the end.
+ *
+ * zebra must not be connected to fpmsyncd, fpmsyncd takes one FPM client only.
+ */
+
+#define DEFAULT_MARKER_PREFIX   "198.51.100.255/32"
+#define DEFAULT_WAIT_TIMEOUT    600     // seconds
+#define SEND_BUFFER_SIZE        (FPM_MAX_MSG_LEN * 16)
+
+static void usage()
+{
+    cout << "Usage: fpmreplay [-p port] [-s speed] [-m marker_prefix] [-t timeout] capture_file" << endl;
+    cout << "    -p port: FPM port of fpmsyncd, " << FPM_DEFAULT_PORT << " by default" << endl;
+    cout << "    -s speed: 1 replays at the captured rate (default), 2 twice as fast, 0 as fast as possible" << endl;
+    cout << "    -m marker_prefix: prefix of the marker route, " << DEFAULT_MARKER_PREFIX << " by default" << endl;
+    cout << "    -t timeout: seconds to wait for the routes to reach orchagent, " << DEFAULT_WAIT_TIMEOUT << " by default" << endl;
+}
+
+/* Number of routes added or deleted by an FPM message */
+static uint64_t countRoutes(const vector<char> &msg)
+{
+    uint64_t routes = 0;
+    auto hdr = reinterpret_cast<const fpm_msg_hdr_t *>(msg.data());
+
+    if (hdr->msg_type != FPM_MSG_TYPE_NETLINK)
+    {
+        return 0;
+    }
+
+    size_t len = fpm_msg_data_len(hdr);
+    auto nl_hdr = reinterpret_cast<const nlmsghdr *>(msg.data() + FPM_MSG_HDR_LEN);
+    for (; NLMSG_OK(nl_hdr, len); nl_hdr = NLMSG_NEXT(nl_hdr, len))
+    {
+        if (nl_hdr->nlmsg_type == RTM_NEWROUTE || nl_hdr->nlmsg_type == RTM_DELROUTE)
+        {
+            routes++;
+        }
+    }
+    return routes;
+}
+
+/* FPM message of the marker route, a blackhole route of the default VRF */
+static vector<char> buildMarker(const IpPrefix &prefix, bool add)
+{
+    rtnl_route *route = rtnl_route_alloc();
+    nl_addr *dst = nullptr;
+    int family = prefix.isV4() ? AF_INET : AF_INET6;
+
+    nl_addr_parse(prefix.to_string().c_str(), family, &dst);
+    rtnl_route_set_dst(route, dst);
+    nl_addr_put(dst);
+    rtnl_route_set_family(route, static_cast<uint8_t>(family));
+    rtnl_route_set_type(route, RTN_BLACKHOLE);
+    rtnl_route_set_protocol(route, RTPROT_STATIC);
+    rtnl_route_set_scope(route, RT_SCOPE_UNIVERSE);
+    rtnl_route_set_table(route, 0);
+
+    nl_msg *nlMsg = nullptr;
+    int ret = add ? rtnl_route_build_add_request(route, NLM_F_CREATE, &nlMsg)
+                  : rtnl_route_build_del_request(route, 0, &nlMsg);
+    rtnl_route_put(route);
+    if (ret != 0 || nlMsg == nullptr)
+    {
+        throw runtime_error("Cannot build the marker route message");
+    }
+
+    nlmsghdr *nl_hdr = nlmsg_hdr(nlMsg);
+    size_t len = fpm_msg_align(FPM_MSG_HDR_LEN + nl_hdr->nlmsg_len);
+
+    vector<char> msg(len, 0);
+    auto hdr = reinterpret_cast<fpm_msg_hdr_t *>(msg.data());
+    hdr->version = FPM_PROTO_VERSION;
+    hdr->msg_type = FPM_MSG_TYPE_NETLINK;
+    hdr->msg_len = htons(static_cast<uint16_t>(len));
+    memcpy(msg.data() + FPM_MSG_HDR_LEN, nl_hdr, nl_hdr->nlmsg_len);
+    nlmsg_free(nlMsg);
+
+    return msg;
+}
+
+static int connectFpm(unsigned short port)
+{
+    int sock = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sock < 0)
+    {
+        throw system_error(errno, system_category(), "socket");
+    }
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        int err = errno;
+        close(sock);
+        throw system_error(err, system_category(), "Cannot connect to fpmsyncd");
+    }
+    return sock;
+}
+
+static void sendAll(int sock, const char *data, size_t len)
+{
+    size_t sent = 0;
+    while (sent != len)
+    {
+        auto rc = ::send(sock, data + sent, len - sent, 0);
+        if (rc == -1)
+        {
+            throw system_error(errno, system_category(), "Failed to send FPM message");
+        }
+        sent += static_cast<size_t>(rc);
+    }
+}
+
+/* Waits until done() holds, returns the time it took or -1 on timeout */
+template <typename F>
+static double waitFor(steady_clock::time_point start, steady_clock::time_point deadline, F done)
+{
+    while (!done())
+    {
+        if (steady_clock::now() >= deadline)
+        {
+            return -1;
+        }
+        this_thread::sleep_for(milliseconds(1));
+    }
+    return static_cast<double>(duration_cast<microseconds>(steady_clock::now() - start).count()) / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned short port = FPM_DEFAULT_PORT;
+    double speed = 1.0;
+    string markerPrefix = DEFAULT_MARKER_PREFIX;
+    int timeout = DEFAULT_WAIT_TIMEOUT;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:s:m:t:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'p':
+            port = static_cast<unsigned short>(atoi(optarg));
+            break;
+        case 's':
+            speed = atof(optarg);
+            break;
+        case 'm':
+            markerPrefix = optarg;
+            break;
+        case 't':
+            timeout = atoi(optarg);
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind != argc - 1 || speed < 0)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        /* Loaded up front, disk reads would skew the replay rate */
+        FpmCaptureReader reader;
+        reader.open(argv[optind]);
+
+        vector<fpm_capture_rec_hdr_t> recs;
+        vector<vector<char>> msgs;
+        uint64_t routes = 0;
+        fpm_capture_rec_hdr_t rec;
+        vector<char> msg;
+        while (reader.next(rec, msg))
+        {
+            routes += countRoutes(msg);
+            recs.push_back(rec);
+            msgs.push_back(move(msg));
+        }
+
+        IpPrefix marker(markerPrefix);
+        string markerKey = string(APP_ROUTE_TABLE_NAME) + ":" + marker.to_string();
+        string markerPendingKey = "_" + markerKey;
+
+        DBConnector db("APPL_DB", 0);
+        if (db.exists(markerKey) || db.exists(markerPendingKey))
+        {
+            cerr << "Marker route " << marker.to_string() << " is already in APPL_DB, pick another one with -m" << endl;
+            return EXIT_FAILURE;
+        }
+
+        int sock = connectFpm(port);
+
+        vector<char> buffer;
+        buffer.reserve(SEND_BUFFER_SIZE);
+        auto start = steady_clock::now();
+
+        for (size_t i = 0; i < msgs.size(); i++)
+        {
+            if (speed > 0)
+            {
+                auto due = start + microseconds(static_cast<int64_t>(static_cast<double>(recs[i].time_usec) / speed));
+                if (due > steady_clock::now())
+                {
+                    /* Everything due so far goes out before sleeping */
+                    sendAll(sock, buffer.data(), buffer.size());
+                    buffer.clear();
+                    this_thread::sleep_until(due);
+                }
+            }
+
+            if (buffer.size() + msgs[i].size() > SEND_BUFFER_SIZE)
+            {
+                sendAll(sock, buffer.data(), buffer.size());
+                buffer.clear();
+            }
+            buffer.insert(buffer.end(), msgs[i].begin(), msgs[i].end());
+        }
+
+        auto markerAdd = buildMarker(marker, true);
+        buffer.insert(buffer.end(), markerAdd.begin(), markerAdd.end());
+        sendAll(sock, buffer.data(), buffer.size());
+        double sendSec = static_cast<double>(duration_cast<microseconds>(steady_clock::now() - start).count()) / 1e6;
+
+        auto deadline = steady_clock::now() + seconds(timeout);
+        double applDbSec = waitFor(start, deadline, [&]()
+        {
+            return db.exists(markerPendingKey) || db.exists(markerKey);
+        });
+        double orchagentSec = applDbSec < 0 ? -1 : waitFor(start, deadline, [&]()
+        {
+            return db.exists(markerKey) && !db.exists(markerPendingKey);
+        });
+
+        auto markerDel = buildMarker(marker, false);
+        sendAll(sock, markerDel.data(), markerDel.size());
+        close(sock);
+
+        auto rate = [routes](double sec)
+        {
+            return sec > 0 ? static_cast<double>(routes) / sec : 0;
+        };
+
+        stringstream line;
+        line << "{\"capture\": \"" << argv[optind] << "\""
+             << ", \"speed\": " << speed
+             << ", \"messages\": " << msgs.size()
+             << ", \"routes\": " << routes
+             << ", \"send_sec\": " << sendSec
+             << ", \"appl_db_sec\": " << applDbSec
+             << ", \"appl_db_routes_per_sec\": " << rate(applDbSec)
+             << ", \"orchagent_sec\": " << orchagentSec
+             << ", \"orchagent_routes_per_sec\": " << rate(orchagentSec)
+             << "}";
+        cout << line.str() << endl;
+
+        if (orchagentSec < 0)
+        {
+            cerr << "Timed out waiting for the marker route" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return 0;
+}
@@ -1,7 +1,9 @@
+#include <getopt.h>
 #include <iostream>
 #include <inttypes.h>
 #include <sys/stat.h>
 #include "logger.h"
+#include "json.h"
 #include "routesync.h"
 #include "select.h"
 #include "selectabletimer.h"
@@ -50,6 +52,35 @@ const uint32_t DEFAULT_ROUTING_RESTART_INTERVAL = 120;
 // TODO: support eoiu hold interval config
 const uint32_t DEFAULT_EOIU_HOLD_INTERVAL = 3;
 
+/* Interval of the pending offload latency logs, in seconds */
+const uint32_t OFFLOAD_LATENCY_LOG_INTERVAL = 60;
+
+// DEVICE_METADATA|localhost fields of the route coalescing window, in milliseconds
+#define ROUTE_COALESCE_WINDOW_FIELD     "route-coalesce-window"
+#define ROUTE_COALESCE_MAX_DELAY_FIELD  "route-coalesce-max-delay"
+// DEVICE_METADATA|localhost field of the number of ROUTE_TABLE writer threads, read at startup
+#define ROUTE_WRITE_SHARDS_FIELD        "route-write-shards"
+
+static int parseMsec(const string &value)
+{
+    try
+    {
+        return value.empty() ? 0 : stoi(value);
+    }
+    catch (const std::exception &)
+    {
+        SWSS_LOG_ERROR("Invalid route coalescing interval %s, disabling it", value.c_str());
+        return 0;
+    }
+}
+
+static void usage()
+{
+    cout << "Usage: fpmsyncd [-c capture_file]" << endl;
+    cout << "    -c capture_file: record the FPM messages received from zebra into capture_file," << endl;
+    cout << "                     to be replayed by fpmreplay" << endl;
+}
+
 // Check if eoiu state reached by both ipv4 and ipv6
 static bool eoiuFlagsSet(Table &bgpStateTable)
 {
@@ -75,6 +106,26 @@ int main(int argc, char **argv)
 {
     swss::Logger::linkToDbNative("fpmsyncd");
 
+    FpmCaptureWriter capture;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'c':
+            capture.open(optarg);
+            SWSS_LOG_NOTICE("Recording FPM messages into %s", optarg);
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
     const auto routeResponseChannelName = std::string("APPL_DB_") + APP_ROUTE_TABLE_NAME + "_RESPONSE_CHANNEL";
 
     DBConnector db("APPL_DB", 0);
@@ -117,11 +168,42 @@ int main(int argc, char **argv)
         sync.setSuppressionEnabled(true);
     }
 
+    std::string coalesceWindowStr;
+    std::string coalesceMaxDelayStr;
+    deviceMetadataTable.hget("localhost", ROUTE_COALESCE_WINDOW_FIELD, coalesceWindowStr);
+    deviceMetadataTable.hget("localhost", ROUTE_COALESCE_MAX_DELAY_FIELD, coalesceMaxDelayStr);
+    if (parseMsec(coalesceWindowStr) > 0)
+    {
+        sync.setRouteCoalescing(parseMsec(coalesceWindowStr), parseMsec(coalesceMaxDelayStr));
+    }
+
+    std::string writeShardsStr;
+    deviceMetadataTable.hget("localhost", ROUTE_WRITE_SHARDS_FIELD, writeShardsStr);
+    if (!writeShardsStr.empty())
+    {
+        try
+        {
+            int shards = stoi(writeShardsStr);
+            if (shards > 0)
+            {
+                sync.setRouteShards(static_cast<size_t>(shards));
+            }
+        }
+        catch (const std::exception &)
+        {
+            SWSS_LOG_ERROR("Invalid route write shards %s, writing routes from the main thread", writeShardsStr.c_str());
+        }
+    }
+
     while (true)
     {
         try
         {
             FpmLink fpm(&sync);
+            if (capture.isOpen())
+            {
+                fpm.setCapture(&capture);
+            }
 
             Select s;
             SelectableTimer warmStartTimer(timespec{0, 0});
@@ -129,6 +211,7 @@ int main(int argc, char **argv)
             SelectableTimer eoiuCheckTimer(timespec{0, 0});
             // After eoiu flags are detected, start a hold timer before starting reconciliation.
             SelectableTimer eoiuHoldTimer(timespec{0, 0});
+            SelectableTimer offloadLatencyTimer(timespec{OFFLOAD_LATENCY_LOG_INTERVAL, 0});
            
             /*
              * Pipeline should be flushed right away to deal with state pending
@@ -143,6 +226,8 @@ int main(int argc, char **argv)
             s.addSelectable(&fpm);
             s.addSelectable(&netlink);
             s.addSelectable(&deviceMetadataTableSubscriber);
+            s.addSelectable(&offloadLatencyTimer);
+            offloadLatencyTimer.start();
 
             if (sync.isSuppressionEnabled())
             {
@@ -189,8 +274,18 @@ int main(int argc, char **argv)
             {
                 Selectable *temps;
 
+                /* Wake up in time for the coalesced route updates */
+                int selectTimeout = gSelectTimeout;
+                int coalesceTimeout = sync.getCoalesceTimeout();
+                if (coalesceTimeout >= 0 && (selectTimeout == INFINITE || coalesceTimeout < selectTimeout))
+                {
+                    selectTimeout = coalesceTimeout;
+                }
+
                 /* Reading FPM messages forever (and calling "readMe" to read them) */
-                s.select(&temps, gSelectTimeout);
+                s.select(&temps, selectTimeout);
+
+                sync.flushCoalescedRoutes();
 
                 /*
                  * Upon expiration of the warm-restart timer or eoiu Hold Timer, proceed to run the
@@ -249,6 +344,10 @@ int main(int argc, char **argv)
                         s.removeSelectable(&eoiuCheckTimer);
                     }
                 }
+                else if (temps == &offloadLatencyTimer)
+                {
+                    sync.logOffloadLatency();
+                }
                 else if (temps == &deviceMetadataTableSubscriber)
                 {
                     std::deque<KeyOpFieldsValuesTuple> keyOpFvsQueue;
@@ -270,11 +369,26 @@ int main(int argc, char **argv)
                             continue;
                         }
 
+                        /* Coalescing is off unless the hash has the window */
+                        int coalesceWindow = 0;
+                        int coalesceMaxDelay = 0;
+
                         for (const auto& fv: fvs)
                         {
                             const auto& field = fvField(fv);
                             const auto& value = fvValue(fv);
 
+                            if (field == ROUTE_COALESCE_WINDOW_FIELD)
+                            {
+                                coalesceWindow = parseMsec(value);
+                                continue;
+                            }
+                            if (field == ROUTE_COALESCE_MAX_DELAY_FIELD)
+                            {
+                                coalesceMaxDelay = parseMsec(value);
+                                continue;
+                            }
+
                             if (field != "suppress-fib-pending")
                             {
                                 continue;
@@ -302,6 +416,12 @@ int main(int argc, char **argv)
                                 routeResponseChannel.reset();
                             }
                         } // end for fvs
+
+                        if (coalesceWindow != sync.getRouteCoalescer().getWindowMsec()
+                            || (coalesceMaxDelay > 0 && coalesceMaxDelay != sync.getRouteCoalescer().getMaxDelayMsec()))
+                        {
+                            sync.setRouteCoalescing(coalesceWindow, coalesceMaxDelay);
+                        }
                     } // end for keyOpFvsQueue
                 }
                 else if (routeResponseChannel && (temps == routeResponseChannel.get()))
@@ -309,13 +429,29 @@ int main(int argc, char **argv)
                     std::deque<KeyOpFieldsValuesTuple> notifications;
                     routeResponseChannel->pops(notifications);
 
+                    /* The offload replies of all the responses go to zebra together */
+                    sync.beginOffloadReplies();
                     for (const auto& notification: notifications)
                     {
+                        /* orchagent aggregates the responses of a route bulk into one
+                         * message, a JSON encoded response per route key */
+                        if (kfvOp(notification) == "bulk")
+                        {
+                            for (const auto& response: kfvFieldsValues(notification))
+                            {
+                                std::vector<FieldValueTuple> fieldValues;
+                                JSon::readJson(fvValue(response), fieldValues);
+                                sync.onRouteResponse(fvField(response), fieldValues);
+                            }
+                            continue;
+                        }
+
                         const auto& key = kfvKey(notification);
                         const auto& fieldValues = kfvFieldsValues(notification);
 
                         sync.onRouteResponse(key, fieldValues);
                     }
+                    sync.flushOffloadReplies();
                 }
                 else if (!warmStartEnabled || sync.getWarmStartHelper().isReconciled())
                 {
@@ -325,6 +461,8 @@ int main(int argc, char **argv)
         }
         catch (FpmLink::FpmConnectionClosedException &e)
         {
+            /* Write what zebra sent before the connection is lost */
+            sync.flushCoalescedRoutes(true);
             cout << "Connection lost, reconnecting..." << endl;
         }
     }
@@ -0,0 +1,94 @@
+#ifndef __LINKNAMETABLE__
+#define __LINKNAMETABLE__
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace swss {
+
+/*
+ * Interface and VRF names of fpmsyncd by ifindex, kept up to date from the
+ * RTM_NEWLINK/RTM_DELLINK events, so that resolving the name of a route's
+ * VRF or next hop interface does not go through the libnl link cache.
+ *
+ * Ifindexes which could not be resolved are remembered until the next link
+ * event, a route storm for an unknown VRF then costs a single cache refill.
+ */
+class LinkNameTable
+{
+public:
+    /* Returns nullptr if ifindex is not known */
+    const std::string *getName(int ifindex) const
+    {
+        auto it = m_names.find(ifindex);
+        return it == m_names.end() ? nullptr : &it->second;
+    }
+
+    /* Returns 0 if name is not known */
+    int getIndex(const std::string &name) const
+    {
+        auto it = m_indexes.find(name);
+        return it == m_indexes.end() ? 0 : it->second;
+    }
+
+    void set(int ifindex, const std::string &name)
+    {
+        auto it = m_names.find(ifindex);
+        if (it != m_names.end())
+        {
+            if (it->second == name)
+            {
+                return;
+            }
+            m_indexes.erase(it->second);
+            it->second = name;
+        }
+        else
+        {
+            m_names.emplace(ifindex, name);
+        }
+        m_indexes[name] = ifindex;
+    }
+
+    void del(int ifindex)
+    {
+        auto it = m_names.find(ifindex);
+        if (it == m_names.end())
+        {
+            return;
+        }
+        m_indexes.erase(it->second);
+        m_names.erase(it);
+    }
+
+    bool isMissing(int ifindex) const
+    {
+        return m_missing.count(ifindex) != 0;
+    }
+
+    void setMissing(int ifindex)
+    {
+        m_missing.insert(ifindex);
+    }
+
+    /* A link came or went, the missing ifindexes may resolve now */
+    void clearMissing()
+    {
+        m_missing.clear();
+    }
+
+    size_t size() const
+    {
+        return m_names.size();
+    }
+
+private:
+    std::unordered_map<int, std::string> m_names;
+    std::unordered_map<std::string, int> m_indexes;
+    std::unordered_set<int> m_missing;
+};
+
+}
+
+#endif
@@ -0,0 +1,87 @@
+#include "fpmsyncd/routecoalescer.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace swss;
+
+constexpr int RouteCoalescer::DEFAULT_MAX_DELAY_WINDOWS;
+
+void RouteCoalescer::configure(int windowMsec, int maxDelayMsec)
+{
+    m_window = chrono::milliseconds(max(windowMsec, 0));
+    if (maxDelayMsec <= 0)
+    {
+        m_maxDelay = m_window * DEFAULT_MAX_DELAY_WINDOWS;
+    }
+    else
+    {
+        m_maxDelay = chrono::milliseconds(max(maxDelayMsec, windowMsec));
+    }
+}
+
+RouteCoalescer::Pending &RouteCoalescer::hold(const string &key, Clock::time_point now)
+{
+    uint64_t seq = ++m_seq;
+    m_stats.held++;
+
+    auto it = m_pending.find(key);
+    if (it == m_pending.end())
+    {
+        it = m_pending.emplace(key, Pending{{}, now, seq, seq}).first;
+        m_oldest.push_back({now, seq, key});
+    }
+    else
+    {
+        m_stats.coalesced++;
+        it->second.lastSeq = seq;
+    }
+
+    m_quiet.push_back({now, seq, key});
+    return it->second;
+}
+
+void RouteCoalescer::set(const string &key, vector<KeyOpFieldsValuesTuple> &&kfvs, Clock::time_point now)
+{
+    hold(key, now).kfvs = move(kfvs);
+}
+
+void RouteCoalescer::del(const string &key, Clock::time_point now)
+{
+    hold(key, now).kfvs.clear();
+}
+
+void RouteCoalescer::written(const Pending &pending, Clock::time_point now)
+{
+    auto held = chrono::duration_cast<chrono::microseconds>(now - pending.first).count();
+    m_stats.written++;
+    m_stats.maxHoldUsec = max(m_stats.maxHoldUsec, static_cast<uint64_t>(max<decltype(held)>(held, 0)));
+}
+
+int RouteCoalescer::timeout(Clock::time_point now) const
+{
+    if (m_pending.empty())
+    {
+        return -1;
+    }
+
+    /* Stale events at the front only wake the caller up early */
+    auto due = Clock::time_point::max();
+    if (!m_quiet.empty())
+    {
+        due = min(due, m_quiet.front().time + m_window);
+    }
+    if (!m_oldest.empty())
+    {
+        due = min(due, m_oldest.front().time + m_maxDelay);
+    }
+
+    if (due <= now)
+    {
+        return 0;
+    }
+
+    // Round up, waking up just before the deadline would only spin
+    auto msec = chrono::duration_cast<chrono::milliseconds>(due - now + chrono::milliseconds(1) - Clock::duration(1)).count();
+    return static_cast<int>(msec);
+}
@@ -0,0 +1,169 @@
+#ifndef __ROUTECOALESCER__
+#define __ROUTECOALESCER__
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "table.h"
+
+namespace swss {
+
+/*
+ * Holds the ROUTE_TABLE updates of fpmsyncd per prefix, so that the churn of
+ * BGP path hunting (add/del/add of the same prefix) reaches APPL_DB as the
+ * final state only.
+ *
+ * A key is written once it has been quiet for the window, or once its first
+ * held update is older than the max delay, whichever comes first. The callers
+ * pass the time, the tests drive it by hand.
+ */
+class RouteCoalescer
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /* Max delay used when none is configured, in windows */
+    static constexpr int DEFAULT_MAX_DELAY_WINDOWS = 10;
+
+    struct Stats
+    {
+        uint64_t held = 0;              // updates held
+        uint64_t coalesced = 0;         // updates replaced by a later one of the same key
+        uint64_t written = 0;           // updates written
+        uint64_t maxDelayWrites = 0;    // keys written on the max delay, while still churning
+        uint64_t maxHoldUsec = 0;       // longest time a key was held
+    };
+
+    /* A window of 0 disables coalescing, a max delay <= 0 picks DEFAULT_MAX_DELAY_WINDOWS */
+    void configure(int windowMsec, int maxDelayMsec);
+
+    bool isEnabled() const
+    {
+        return m_window.count() > 0;
+    }
+
+    int getWindowMsec() const
+    {
+        return static_cast<int>(m_window.count());
+    }
+
+    int getMaxDelayMsec() const
+    {
+        return static_cast<int>(m_maxDelay.count());
+    }
+
+    /* Holds a SET of key, the tuples are written as is */
+    void set(const std::string &key, std::vector<KeyOpFieldsValuesTuple> &&kfvs, Clock::time_point now);
+
+    /* Holds a DEL of key */
+    void del(const std::string &key, Clock::time_point now);
+
+    /*
+     * Calls f(key, kfvs) for the keys due at now, or for all of them when force
+     * is set. kfvs is empty for a DEL.
+     */
+    template <typename F>
+    size_t flush(Clock::time_point now, bool force, F f)
+    {
+        size_t count = 0;
+
+        if (force)
+        {
+            for (auto &it : m_pending)
+            {
+                written(it.second, now);
+                f(it.first, it.second.kfvs);
+                count++;
+            }
+            m_pending.clear();
+            m_quiet.clear();
+            m_oldest.clear();
+            return count;
+        }
+
+        while (!m_quiet.empty() && m_quiet.front().time + m_window <= now)
+        {
+            count += flushDue(m_quiet, false, now, f);
+        }
+        while (!m_oldest.empty() && m_oldest.front().time + m_maxDelay <= now)
+        {
+            count += flushDue(m_oldest, true, now, f);
+        }
+        return count;
+    }
+
+    /* Milliseconds until the next key may be due, -1 if nothing is held */
+    int timeout(Clock::time_point now) const;
+
+    size_t size() const
+    {
+        return m_pending.size();
+    }
+
+    const Stats &getStats() const
+    {
+        return m_stats;
+    }
+
+private:
+    struct Pending
+    {
+        std::vector<KeyOpFieldsValuesTuple> kfvs;
+        Clock::time_point first;
+        uint64_t firstSeq;
+        uint64_t lastSeq;
+    };
+
+    /* Update of a key in time order, stale once the key has a later one */
+    struct Event
+    {
+        Clock::time_point time;
+        uint64_t seq;
+        std::string key;
+    };
+
+    Pending &hold(const std::string &key, Clock::time_point now);
+    void written(const Pending &pending, Clock::time_point now);
+
+    template <typename F>
+    size_t flushDue(std::deque<Event> &events, bool oldest, Clock::time_point now, F &f)
+    {
+        Event event = std::move(events.front());
+        events.pop_front();
+
+        auto it = m_pending.find(event.key);
+        if (it == m_pending.end() || (oldest ? it->second.firstSeq : it->second.lastSeq) != event.seq)
+        {
+            return 0;
+        }
+
+        if (oldest)
+        {
+            m_stats.maxDelayWrites++;
+        }
+        written(it->second, now);
+        f(it->first, it->second.kfvs);
+        m_pending.erase(it);
+        return 1;
+    }
+
+    std::chrono::milliseconds m_window{0};
+    std::chrono::milliseconds m_maxDelay{0};
+
+    std::unordered_map<std::string, Pending> m_pending;
+    /* Every update, for the window */
+    std::deque<Event> m_quiet;
+    /* First update of every held key, for the max delay */
+    std::deque<Event> m_oldest;
+    uint64_t m_seq = 0;
+
+    Stats m_stats;
+};
+
+}
+
+#endif
@@ -0,0 +1,59 @@
+#include "fpmsyncd/routeoffloadtracker.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace swss;
+
+constexpr size_t RouteOffloadTracker::LATENCY_SAMPLES;
+
+bool RouteOffloadTracker::complete(const string &key, Clock::time_point now)
+{
+    auto it = m_inFlight.find(key);
+    if (it == m_inFlight.end())
+    {
+        return false;
+    }
+
+    auto usec = chrono::duration_cast<chrono::microseconds>(now - it->second).count();
+    m_inFlight.erase(it);
+
+    uint64_t sample = static_cast<uint64_t>(max<decltype(usec)>(usec, 0));
+    if (m_samples.size() < LATENCY_SAMPLES)
+    {
+        m_samples.push_back(sample);
+    }
+    else
+    {
+        m_samples[m_next] = sample;
+        m_next = (m_next + 1) % LATENCY_SAMPLES;
+    }
+    m_count++;
+    return true;
+}
+
+RouteOffloadTracker::Latency RouteOffloadTracker::getLatency() const
+{
+    Latency latency;
+    latency.count = m_count;
+    latency.inFlight = m_inFlight.size();
+
+    if (m_samples.empty())
+    {
+        return latency;
+    }
+
+    vector<uint64_t> sorted(m_samples);
+    sort(sorted.begin(), sorted.end());
+
+    auto percentile = [&sorted](size_t pct)
+    {
+        return sorted[(sorted.size() - 1) * pct / 100];
+    };
+
+    latency.p50Usec = percentile(50);
+    latency.p90Usec = percentile(90);
+    latency.p99Usec = percentile(99);
+    latency.maxUsec = sorted.back();
+    return latency;
+}
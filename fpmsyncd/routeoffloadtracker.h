@@ -0,0 +1,76 @@
+#ifndef __ROUTEOFFLOADTRACKER__
+#define __ROUTEOFFLOADTRACKER__
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace swss {
+
+/*
+ * Routes written to APPL_DB which wait for the orchagent response before
+ * fpmsyncd replies to zebra with RTM_F_OFFLOAD, keyed by their ROUTE_TABLE
+ * key, that is the VRF and the prefix.
+ *
+ * The time from the route being received to the response gives the pending
+ * offload latency, the percentiles are kept over the latest LATENCY_SAMPLES
+ * routes.
+ */
+class RouteOffloadTracker
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static constexpr size_t LATENCY_SAMPLES = 4096;
+
+    struct Latency
+    {
+        uint64_t count = 0;     // responses matched since startup
+        size_t inFlight = 0;    // routes still waiting for a response
+        uint64_t p50Usec = 0;
+        uint64_t p90Usec = 0;
+        uint64_t p99Usec = 0;
+        uint64_t maxUsec = 0;
+    };
+
+    /* The route is waiting for a response, an update of a waiting route keeps its first time */
+    void add(const std::string &key, Clock::time_point now)
+    {
+        m_inFlight.emplace(key, now);
+    }
+
+    /* The route was deleted, no response is expected anymore */
+    void remove(const std::string &key)
+    {
+        m_inFlight.erase(key);
+    }
+
+    /* Returns false if the route was not waiting for a response */
+    bool complete(const std::string &key, Clock::time_point now);
+
+    void clear()
+    {
+        m_inFlight.clear();
+    }
+
+    size_t size() const
+    {
+        return m_inFlight.size();
+    }
+
+    Latency getLatency() const;
+
+private:
+    std::unordered_map<std::string, Clock::time_point> m_inFlight;
+
+    /* Ring of the latest latencies, in usec */
+    std::vector<uint64_t> m_samples;
+    size_t m_next = 0;
+    uint64_t m_count = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,145 @@
+#include "fpmsyncd/routeshardpool.h"
+#include "fpmsyncd/fpmsyncd.h"
+
+#include "logger.h"
+#include "orch_zmq_config.h"
+
+using namespace std;
+using namespace swss;
+
+constexpr size_t RouteShardPool::MAX_QUEUED;
+
+RouteShardPool::RouteShardPool(size_t count, const string &tableName)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        auto shard = make_unique<Shard>();
+
+        shard->db = make_unique<DBConnector>("APPL_DB", 0);
+        shard->pipeline = make_unique<RedisPipeline>(shard->db.get(), ROUTE_SYNC_PPL_SIZE);
+        shard->zmqClient = create_local_zmq_client(ORCH_NORTHBOND_ROUTE_ZMQ_ENABLED, false);
+        shard->table = createProducerStateTable(shard->pipeline.get(), tableName, true, shard->zmqClient);
+
+        m_shards.push_back(move(shard));
+    }
+
+    /* The workers start once every shard is in place */
+    for (auto &shard : m_shards)
+    {
+        Shard *s = shard.get();
+        s->thread = thread([this, s]() { run(*s); });
+    }
+
+    SWSS_LOG_NOTICE("Writing %s from %zu shards", tableName.c_str(), count);
+}
+
+RouteShardPool::~RouteShardPool()
+{
+    for (auto &shard : m_shards)
+    {
+        {
+            lock_guard<mutex> lock(shard->mutex);
+            shard->stop = true;
+        }
+        shard->cv.notify_one();
+    }
+
+    /* What is queued is still written before the workers exit */
+    for (auto &shard : m_shards)
+    {
+        shard->thread.join();
+    }
+}
+
+void RouteShardPool::set(const string &key, vector<KeyOpFieldsValuesTuple> &&kfvs)
+{
+    push(Update{key, move(kfvs)});
+}
+
+void RouteShardPool::del(const string &key)
+{
+    push(Update{key, {}});
+}
+
+void RouteShardPool::push(Update &&update)
+{
+    Shard &shard = *m_shards[shardOf(update.key, m_shards.size())];
+
+    unique_lock<mutex> lock(shard.mutex);
+    shard.idleCv.wait(lock, [&shard]() { return shard.queue.size() < MAX_QUEUED; });
+
+    shard.queue.push_back(move(update));
+    if (shard.queue.size() == 1)
+    {
+        shard.cv.notify_one();
+    }
+}
+
+void RouteShardPool::drain()
+{
+    for (auto &shard : m_shards)
+    {
+        unique_lock<mutex> lock(shard->mutex);
+        shard->idleCv.wait(lock, [&shard]() { return shard->queue.empty() && !shard->busy; });
+    }
+}
+
+uint64_t RouteShardPool::getWritten() const
+{
+    uint64_t written = 0;
+    for (auto &shard : m_shards)
+    {
+        lock_guard<mutex> lock(shard->mutex);
+        written += shard->written;
+    }
+    return written;
+}
+
+void RouteShardPool::run(Shard &shard)
+{
+    vector<Update> batch;
+
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(shard.mutex);
+            shard.cv.wait(lock, [&shard]() { return shard.stop || !shard.queue.empty(); });
+            if (shard.queue.empty())
+            {
+                return;
+            }
+
+            batch.swap(shard.queue);
+            shard.busy = true;
+        }
+        shard.idleCv.notify_all();
+
+        try
+        {
+            for (auto &update : batch)
+            {
+                if (update.kfvs.empty())
+                {
+                    shard.table->del(update.key);
+                }
+                else
+                {
+                    shard.table->set(update.kfvs);
+                }
+            }
+            shard.pipeline->flush();
+        }
+        catch (const exception &e)
+        {
+            SWSS_LOG_ERROR("Failed to write %zu route updates: %s", batch.size(), e.what());
+        }
+
+        {
+            lock_guard<mutex> lock(shard.mutex);
+            shard.written += batch.size();
+            shard.busy = false;
+        }
+        shard.idleCv.notify_all();
+        batch.clear();
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef __ROUTESHARDPOOL__
+#define __ROUTESHARDPOOL__
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dbconnector.h"
+#include "producerstatetable.h"
+#include "zmqclient.h"
+
+namespace swss {
+
+/*
+ * Writes the ROUTE_TABLE updates of fpmsyncd from worker threads, each
+ * owning its APPL_DB connection, pipeline and producer table, or ZMQ client
+ * when the route ZMQ channel is enabled. The FPM messages are still decoded
+ * by the main thread, the shards take the encoding into APPL_DB or ZMQ and
+ * the writes, which are independent across prefixes.
+ *
+ * A key always goes to the same shard, the updates of a prefix are written
+ * in order.
+ */
+class RouteShardPool
+{
+public:
+    /* Updates a shard may hold before the caller waits for it */
+    static constexpr size_t MAX_QUEUED = 65536;
+
+    RouteShardPool(size_t count, const std::string &tableName);
+    ~RouteShardPool();
+
+    size_t size() const
+    {
+        return m_shards.size();
+    }
+
+    static size_t shardOf(const std::string &key, size_t count)
+    {
+        return std::hash<std::string>()(key) % count;
+    }
+
+    void set(const std::string &key, std::vector<KeyOpFieldsValuesTuple> &&kfvs);
+
+    void del(const std::string &key);
+
+    /* Waits until the updates queued so far are written */
+    void drain();
+
+    /* Updates written by all the shards */
+    uint64_t getWritten() const;
+
+private:
+    /* kfvs is empty for a DEL */
+    struct Update
+    {
+        std::string key;
+        std::vector<KeyOpFieldsValuesTuple> kfvs;
+    };
+
+    struct Shard
+    {
+        std::unique_ptr<DBConnector> db;
+        std::unique_ptr<RedisPipeline> pipeline;
+        std::shared_ptr<ZmqClient> zmqClient;
+        std::shared_ptr<ProducerStateTable> table;
+
+        std::mutex mutex;
+        std::condition_variable cv;         // the worker waits for updates
+        std::condition_variable idleCv;     // the callers wait for room, or for drain()
+        std::vector<Update> queue;
+        bool busy = false;
+        bool stop = false;
+        uint64_t written = 0;
+
+        std::thread thread;
+    };
+
+    void push(Update &&update);
+    void run(Shard &shard);
+
+    std::vector<std::unique_ptr<Shard>> m_shards;
+};
+
+}
+
+#endif
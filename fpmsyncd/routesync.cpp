@@ -7,12 +7,14 @@
 #include "ipprefix.h"
 #include "dbconnector.h"
 #include "lib/orch_zmq_config.h"
+#include "lib/routebinary.h"
 #include "producerstatetable.h"
 #include "fpmsyncd/fpmlink.h"
 #include "fpmsyncd/routesync.h"
 #include "macaddress.h"
 #include "converter.h"
 #include <string.h>
+#include <inttypes.h>
 #include <arpa/inet.h>
 #include <linux/nexthop.h>
 #include <linux/lwtunnel.h>
@@ -167,6 +169,11 @@ RouteSync::RouteSync(RedisPipeline *pipeline) :
     m_nl_sock = nl_socket_alloc();
     nl_connect(m_nl_sock, NETLINK_ROUTE);
     rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
+
+    if (isNbZmqEnabled())
+    {
+        m_routeBinary = get_feature_status(ORCH_NORTHBOND_ROUTE_ZMQ_BINARY, false);
+    }
 }
 
 void RouteSync::setRouteWithWarmRestart(FieldValueTupleWrapperBase & fvw,
@@ -174,8 +181,27 @@ void RouteSync::setRouteWithWarmRestart(FieldValueTupleWrapperBase & fvw,
 {
     bool warmRestartInProgress = m_warmStartHelper.inProgress();
 
+    if (&table == m_routeTable.get())
+    {
+        fvw.setBinary(m_routeBinary);
+    }
+
     if (!warmRestartInProgress)
     {
+        if (&table == m_routeTable.get() && isSuppressionEnabled())
+        {
+            m_offloadTracker.add(fvw.key, RouteOffloadTracker::Clock::now());
+        }
+        if (&table == m_routeTable.get() && m_routeCoalescer.isEnabled())
+        {
+            m_routeCoalescer.set(fvw.key, fvw.KeyOpFieldsValuesTupleVector(), RouteCoalescer::Clock::now());
+            return;
+        }
+        if (&table == m_routeTable.get())
+        {
+            writeRoute(fvw.key, fvw.KeyOpFieldsValuesTupleVector());
+            return;
+        }
         table.set(fvw.KeyOpFieldsValuesTupleVector());
     }
     else
@@ -199,12 +225,103 @@ void RouteSync::delWithWarmRestart(FieldValueTupleWrapperBase && fvw,
                                    ProducerStateTable & table) {
     bool warmRestartInProgress = m_warmStartHelper.inProgress();
     if (!warmRestartInProgress) {
+        if (&table == m_routeTable.get()) {
+            m_offloadTracker.remove(fvw.key);
+        }
+        if (&table == m_routeTable.get() && m_routeCoalescer.isEnabled()) {
+            m_routeCoalescer.del(fvw.key, RouteCoalescer::Clock::now());
+            return;
+        }
+        if (&table == m_routeTable.get()) {
+            deleteRoute(fvw.key);
+            return;
+        }
         table.del(fvw.key);
     } else {
         m_warmStartHelper.insertRefreshMap(fvw.KeyOpFieldsValuesTupleVectorForDel());
     }
 }
 
+void RouteSync::setRouteCoalescing(int windowMsec, int maxDelayMsec)
+{
+    SWSS_LOG_ENTER();
+
+    /* Nothing stays held across a reconfiguration */
+    flushCoalescedRoutes(true);
+
+    m_routeCoalescer.configure(windowMsec, maxDelayMsec);
+
+    const auto& stats = m_routeCoalescer.getStats();
+    SWSS_LOG_NOTICE("Route coalescing window %d ms, max delay %d ms (held %" PRIu64 " coalesced %" PRIu64
+                    " written %" PRIu64 " max delay writes %" PRIu64 " max hold %" PRIu64 " us)",
+                    m_routeCoalescer.getWindowMsec(), m_routeCoalescer.getMaxDelayMsec(),
+                    stats.held, stats.coalesced, stats.written, stats.maxDelayWrites, stats.maxHoldUsec);
+}
+
+void RouteSync::flushCoalescedRoutes(bool force)
+{
+    if (m_routeCoalescer.size() == 0)
+    {
+        return;
+    }
+
+    size_t count = m_routeCoalescer.flush(RouteCoalescer::Clock::now(), force,
+        [this](const string& key, vector<KeyOpFieldsValuesTuple>& kfvs)
+        {
+            if (kfvs.empty())
+            {
+                deleteRoute(key);
+            }
+            else
+            {
+                writeRoute(key, std::move(kfvs));
+            }
+        });
+
+    if (count)
+    {
+        SWSS_LOG_INFO("Wrote %zu coalesced routes, %zu still held", count, m_routeCoalescer.size());
+    }
+}
+
+int RouteSync::getCoalesceTimeout() const
+{
+    return m_routeCoalescer.timeout(RouteCoalescer::Clock::now());
+}
+
+void RouteSync::setRouteShards(size_t count)
+{
+    SWSS_LOG_ENTER();
+
+    /* What the current writers hold is written first */
+    if (m_routeShards)
+    {
+        m_routeShards->drain();
+    }
+
+    m_routeShards.reset(count ? new RouteShardPool(count, APP_ROUTE_TABLE_NAME) : nullptr);
+}
+
+void RouteSync::writeRoute(const string& key, vector<KeyOpFieldsValuesTuple>&& kfvs)
+{
+    if (m_routeShards)
+    {
+        m_routeShards->set(key, std::move(kfvs));
+        return;
+    }
+    m_routeTable->set(kfvs);
+}
+
+void RouteSync::deleteRoute(const string& key)
+{
+    if (m_routeShards)
+    {
+        m_routeShards->del(key);
+        return;
+    }
+    m_routeTable->del(key);
+}
+
 char *RouteSync::prefixMac2Str(char *mac, char *buf, int size)
 {
     char *ptr = buf;
@@ -1000,6 +1117,24 @@ bool RouteSync::getSrv6VpnRouteNextHop(struct nlmsghdr *h, int received_bytes,
 vector<FieldValueTuple>
 RouteTableFieldValueTupleWrapper::fieldValueTupleVector() {
     vector<FieldValueTuple> fvVector;
+    if (binary) {
+        RouteBinaryWriter bin;
+        bin.addValue(ROUTE_BIN_PROTOCOL, protocol);
+        if (blackhole == "true") {
+            bin.addFlag(ROUTE_BIN_BLACKHOLE);
+        }
+        bin.addValue(ROUTE_BIN_NEXTHOP_GROUP, nexthop_group);
+        bin.addList(ROUTE_BIN_NEXTHOP, nexthop);
+        bin.addList(ROUTE_BIN_IFNAME, ifname);
+        bin.addList(ROUTE_BIN_MPLS_NH, mpls_nh);
+        bin.addValue(ROUTE_BIN_WEIGHT, weight);
+        bin.addList(ROUTE_BIN_VNI_LABEL, vni_label);
+        bin.addList(ROUTE_BIN_ROUTER_MAC, router_mac);
+        bin.addList(ROUTE_BIN_SEGMENT, segment);
+        bin.addList(ROUTE_BIN_SEG_SRC, seg_src);
+        fvVector.push_back(FieldValueTuple(ROUTE_BINARY_FIELD, bin.str()));
+        return fvVector;
+    }
     // If Northbound ZMQ is enabled, simply send all the fields even if the value is
     // empty. The duplication of code between ZMQ and non-ZMQ is deliberate. This way
     // for the ZMQ case we can avoid an if check for every field attribute.
@@ -1056,9 +1191,42 @@ RouteTableFieldValueTupleWrapper::fieldValueTupleVector() {
 
 
 
+void RouteTableFieldValueTupleWrapper::reset(bool _nbZmqEnabled) {
+    nbZmqEnabled = _nbZmqEnabled;
+    protocol.clear();
+    blackhole = "false";
+    nexthop.clear();
+    ifname.clear();
+    nexthop_group.clear();
+    mpls_nh.clear();
+    weight.clear();
+    vni_label.clear();
+    router_mac.clear();
+    segment.clear();
+    seg_src.clear();
+}
+
 vector<FieldValueTuple>
 LabelRouteTableFieldValueTupleWrapper::fieldValueTupleVector() {
     vector<FieldValueTuple> fvVector;
+    if (binary) {
+        RouteBinaryWriter bin;
+        bin.addValue(ROUTE_BIN_PROTOCOL, protocol);
+        if (blackhole == "true") {
+            bin.addFlag(ROUTE_BIN_BLACKHOLE);
+        }
+        bin.addValue(ROUTE_BIN_NEXTHOP_GROUP, nexthop_group);
+        bin.addList(ROUTE_BIN_NEXTHOP, nexthop);
+        bin.addList(ROUTE_BIN_IFNAME, ifname);
+        bin.addList(ROUTE_BIN_MPLS_NH, mpls_nh);
+        bin.addValue(ROUTE_BIN_WEIGHT, weight);
+        bin.addList(ROUTE_BIN_VNI_LABEL, vni_label);
+        bin.addList(ROUTE_BIN_ROUTER_MAC, router_mac);
+        bin.addList(ROUTE_BIN_SEGMENT, segment);
+        bin.addList(ROUTE_BIN_SEG_SRC, seg_src);
+        fvVector.push_back(FieldValueTuple(ROUTE_BINARY_FIELD, bin.str()));
+        return fvVector;
+    }
     // If Northbound ZMQ is enabled, simply send all the fields even if the value is
     // empty. The duplication of code between ZMQ and non-ZMQ is deliberate. This way
     // for the ZMQ case we can avoid an if check for every field attribute.
@@ -1097,6 +1265,24 @@ LabelRouteTableFieldValueTupleWrapper::fieldValueTupleVector() {
 vector<FieldValueTuple>
 VnetRouteTableFieldValueTupleWrapper::fieldValueTupleVector() {
     vector<FieldValueTuple> fvVector;
+    if (binary) {
+        RouteBinaryWriter bin;
+        bin.addValue(ROUTE_BIN_PROTOCOL, protocol);
+        if (blackhole == "true") {
+            bin.addFlag(ROUTE_BIN_BLACKHOLE);
+        }
+        bin.addValue(ROUTE_BIN_NEXTHOP_GROUP, nexthop_group);
+        bin.addList(ROUTE_BIN_NEXTHOP, nexthop);
+        bin.addList(ROUTE_BIN_IFNAME, ifname);
+        bin.addList(ROUTE_BIN_MPLS_NH, mpls_nh);
+        bin.addValue(ROUTE_BIN_WEIGHT, weight);
+        bin.addList(ROUTE_BIN_VNI_LABEL, vni_label);
+        bin.addList(ROUTE_BIN_ROUTER_MAC, router_mac);
+        bin.addList(ROUTE_BIN_SEGMENT, segment);
+        bin.addList(ROUTE_BIN_SEG_SRC, seg_src);
+        fvVector.push_back(FieldValueTuple(ROUTE_BINARY_FIELD, bin.str()));
+        return fvVector;
+    }
     // If Northbound ZMQ is enabled, simply send all the fields even if the value is
     // empty. The duplication of code between ZMQ and non-ZMQ is deliberate. This way
     // for the ZMQ case we can avoid an if check for every field attribute.
@@ -1864,7 +2050,7 @@ void RouteSync::onSrv6VpnRouteMsg(struct nlmsghdr *h, int len)
                 FieldValueTuple wg("weight", weights.c_str());
                 fvVector.push_back(wg);
             }
-            m_routeTable->set(routeTableKey, fvVector);
+            writeRoute(routeTableKey, {KeyOpFieldsValuesTuple(routeTableKey, SET_COMMAND, fvVector)});
 
             SWSS_LOG_DEBUG("NextHop group id %d is a single nexthop address. Filling the route table %s with nexthop and ifname", nhg_id, destipprefix);
         }
@@ -1892,7 +2078,7 @@ void RouteSync::onSrv6VpnRouteMsg(struct nlmsghdr *h, int len)
             fvVectorVpnRoute.push_back(vpn_sid);
             fvVectorVpnRoute.push_back(seg_srcs_route);
             fvVectorVpnRoute.push_back(intf);
-            m_routeTable->set(routeTableKey, fvVectorVpnRoute);
+            writeRoute(routeTableKey, {KeyOpFieldsValuesTuple(routeTableKey, SET_COMMAND, fvVectorVpnRoute)});
         }
     }
 
@@ -2054,7 +2240,7 @@ void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
 {
     if (nlmsg_type == RTM_NEWLINK || nlmsg_type == RTM_DELLINK)
     {
-        nl_cache_refill(m_nl_sock, m_link_cache);
+        onLinkMsg(nlmsg_type, (struct rtnl_link *)obj);
         return;
     }
 
@@ -2192,13 +2378,35 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     }
 
     RouteTableFieldValueTupleWrapper fvw {destipprefix, std::move(proto_str), isNbZmqEnabled()};
-    string gw_list;
-    string intf_list;
-    string mpls_list;
-    string weights;
 
-    string nhg_id_key;
     uint32_t nhg_id = rtnl_route_get_nh_id(route_obj);
+    if (!nhg_id)
+    {
+        struct nl_list_head *nhs = rtnl_route_get_nexthops(route_obj);
+        if (!nhs)
+        {
+            SWSS_LOG_INFO("Nexthop list is empty for %s", destipprefix);
+            return;
+        }
+
+        /* Get nexthop lists */
+        getNextHopList(route_obj, fvw.nexthop, fvw.mpls_nh, fvw.ifname);
+        fvw.weight = getNextHopWt(route_obj);
+    }
+
+    setUnicastRoute(fvw, nhg_id, rtnl_route_get_family(route_obj));
+}
+
+/*
+ * Publish a unicast route once its next hops are parsed
+ * @arg fvw             Route fields, with the next hop lists unless the route uses a next hop group
+ * @arg nhg_id          Next hop group id of the route, 0 if none
+ * @arg family          Address family of the route
+ */
+void RouteSync::setUnicastRoute(RouteTableFieldValueTupleWrapper &fvw, uint32_t nhg_id, uint8_t family)
+{
+    const char *destipprefix = fvw.key.c_str();
+
     if(nhg_id)
     {
         const auto itg = m_nh_groups.find(nhg_id);
@@ -2211,10 +2419,10 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
         if(nhg.group.size() == 0)
         {
             // Using route-table only for single next-hop
-            string nexthops = nhg.nexthop.empty() ? (rtnl_route_get_family(route_obj) == AF_INET ? "0.0.0.0" : "::") : nhg.nexthop;
+            string nexthops = nhg.nexthop.empty() ? (family == AF_INET ? "0.0.0.0" : "::") : nhg.nexthop;
             string ifnames, weights;
 
-            getNextHopGroupFields(nhg, nexthops, ifnames, weights, rtnl_route_get_family(route_obj));
+            getNextHopGroupFields(nhg, nexthops, ifnames, weights, family);
             fvw.nexthop = std::move(nexthops);
             fvw.ifname = std::move(ifnames);
             if (!weights.empty())
@@ -2224,35 +2432,22 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
         }
         else
         {
-            nhg_id_key = getNextHopGroupKeyAsString(nhg_id);
-            fvw.nexthop_group = std::move(nhg_id_key);
+            fvw.nexthop_group = getNextHopGroupKeyAsString(nhg_id);
             installNextHopGroup(nhg_id);
         }
     }
     else
     {
-        struct nl_list_head *nhs = rtnl_route_get_nexthops(route_obj);
-        if (!nhs)
-        {
-            SWSS_LOG_INFO("Nexthop list is empty for %s", destipprefix);
-            return;
-        }
-
-        /* Get nexthop lists */
-
-        getNextHopList(route_obj, gw_list, mpls_list, intf_list);
-        weights = getNextHopWt(route_obj);
-
-        vector<string> alsv = tokenize(intf_list, NHG_DELIMITER);
+        vector<string> alsv = tokenize(fvw.ifname, NHG_DELIMITER);
 
         if (alsv.size() == 1)
         {
             if (alsv[0] == "eth0" || alsv[0] == "docker0" || alsv[0] == "eth1-midplane")
             {
                 SWSS_LOG_DEBUG("Skip routes to eth0 or docker0 or eth1-midplane: %s %s %s",
-                            destipprefix, gw_list.c_str(), intf_list.c_str());
+                            destipprefix, fvw.nexthop.c_str(), fvw.ifname.c_str());
                 SWSS_LOG_INFO("RouteTable del msg for eth0/docker0/eth1-midplane route: %s", destipprefix);
-                delWithWarmRestart(RouteTableFieldValueTupleWrapper{std::move(destipprefix), "", isNbZmqEnabled()},
+                delWithWarmRestart(RouteTableFieldValueTupleWrapper{fvw.key, "", isNbZmqEnabled()},
                                    *m_routeTable);
                 return;
             }
@@ -2268,38 +2463,170 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
                 if (alias == "eth0" || alias == "docker0" || alias == "eth1-midplane")
                 {
                     SWSS_LOG_DEBUG("Skip routes to eth0 or docker0 or eth1-midplane: %s %s %s",
-                                destipprefix, gw_list.c_str(), intf_list.c_str());
+                                destipprefix, fvw.nexthop.c_str(), fvw.ifname.c_str());
                     continue;
                 }
             }
         }
+    }
 
+    setRouteWithWarmRestart(fvw, *m_routeTable);
+    if (nhg_id)
+    {
+        SWSS_LOG_INFO("RouteTable set msg with NHG: %s nhg_id:%d", destipprefix, nhg_id);
+    }
+    else
+    {
+        SWSS_LOG_INFO("RouteTable set msg: %s nexthop:%s ifname:%s mpls:%s weight:%s",
+                      destipprefix, fvw.nexthop.c_str(), fvw.ifname.c_str(),
+                      fvw.mpls_nh.empty() ? "na" : fvw.mpls_nh.c_str(),
+                      fvw.weight.empty() ? "na" : fvw.weight.c_str());
+    }
+}
 
-        fvw.nexthop = std::move(gw_list);
-        fvw.ifname = std::move(intf_list);
+/*
+ * Handle regular route (include VRF route) straight from the netlink message
+ * @arg h               Netlink message header
+ *
+ * The fields are written into m_rawRoute as they are parsed, no libnl object
+ * is allocated. Routes this parser does not cover (MPLS, VNET, management VRF,
+ * encapsulation, RTA_VIA next hops...) are left untouched for onMsg().
+ *
+ * Return true if the message is handled
+ */
+bool RouteSync::onRouteMsgRaw(struct nlmsghdr *h)
+{
+    struct rtmsg *rtm;
+    struct rtattr *tb[RTA_MAX + 1] = {0};
+    char buf[MAX_ADDR_SIZE];
+    char destipprefix[IFNAMSIZ + MAX_ADDR_SIZE + 2] = {0};
+    unsigned int addr_len;
+    unsigned int vrf_index;
 
-        if (!mpls_list.empty())
-        {
-            fvw.mpls_nh = std::move(mpls_list);
-        }
-        if (!weights.empty())
+    if (h->nlmsg_type != RTM_NEWROUTE && h->nlmsg_type != RTM_DELROUTE)
+    {
+        return false;
+    }
+
+    int len = (int)(h->nlmsg_len - NLMSG_LENGTH(sizeof(struct rtmsg)));
+    if (len < 0)
+    {
+        return false;
+    }
+
+    rtm = (struct rtmsg *)NLMSG_DATA(h);
+
+    if (rtm->rtm_family == AF_INET)
+    {
+        addr_len = IPV4_MAX_BYTE;
+    }
+    else if (rtm->rtm_family == AF_INET6)
+    {
+        addr_len = IPV6_MAX_BYTE;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (rtm->rtm_dst_len > addr_len * 8)
+    {
+        return false;
+    }
+
+    netlink_parse_rtattr(tb, RTA_MAX, RTM_RTA(rtm), len);
+
+    if (!tb[RTA_DST] || (unsigned int)RTA_PAYLOAD(tb[RTA_DST]) != addr_len
+        || tb[RTA_ENCAP_TYPE] || tb[RTA_ENCAP] || tb[RTA_VIA])
+    {
+        return false;
+    }
+
+    /* Table corresponding to route. */
+    if (tb[RTA_TABLE])
+    {
+        vrf_index = *(uint32_t *)RTA_DATA(tb[RTA_TABLE]);
+    }
+    else
+    {
+        vrf_index = rtm->rtm_table;
+    }
+
+    if (vrf_index)
+    {
+        /* VNET routes and invalid VRF names are handled by onMsg() */
+        if (!getIfName(vrf_index, destipprefix, IFNAMSIZ)
+            || memcmp(destipprefix, VRF_PREFIX, strlen(VRF_PREFIX)))
         {
-            fvw.weight = std::move(weights);
+            return false;
         }
+        destipprefix[strlen(destipprefix)] = ':';
     }
 
-    setRouteWithWarmRestart(fvw, *m_routeTable);
-    if (nhg_id)
+    inet_ntop(rtm->rtm_family, RTA_DATA(tb[RTA_DST]), buf, MAX_ADDR_SIZE);
+    if (rtm->rtm_dst_len == addr_len * 8)
     {
-        SWSS_LOG_INFO("RouteTable set msg with NHG: %s nhg_id:%d", destipprefix, nhg_id);
+        snprintf(destipprefix + strlen(destipprefix), sizeof(destipprefix) - strlen(destipprefix), "%s", buf);
     }
     else
     {
-        SWSS_LOG_INFO("RouteTable set msg: %s nexthop:%s ifname:%s mpls:%s weight:%s",
-                      destipprefix, gw_list.c_str(), intf_list.c_str(),
-                      mpls_list.empty() ? "na" : mpls_list.c_str(),
-                      weights.empty() ? "na" : weights.c_str());
+        snprintf(destipprefix + strlen(destipprefix), sizeof(destipprefix) - strlen(destipprefix), "%s/%u",
+                 buf, rtm->rtm_dst_len);
+    }
+
+    /*
+     * Upon arrival of a delete msg we could either push the change right away,
+     * or we could opt to defer it if we are going through a warm-reboot cycle.
+     */
+    if (h->nlmsg_type == RTM_DELROUTE)
+    {
+        SWSS_LOG_INFO("RouteTable del msg: %s", destipprefix);
+        delWithWarmRestart(RouteTableFieldValueTupleWrapper{std::move(destipprefix), "", isNbZmqEnabled()},
+                           *m_routeTable);
+        return true;
+    }
+
+    RouteTableFieldValueTupleWrapper &fvw = m_rawRoute;
+    fvw.reset(isNbZmqEnabled());
+    fvw.key.assign(destipprefix);
+
+    uint32_t nhg_id = tb[RTA_NH_ID] ? *(uint32_t *)RTA_DATA(tb[RTA_NH_ID]) : 0;
+    if (rtm->rtm_type == RTN_UNICAST && !nhg_id
+        && !getNextHopListRaw(tb, rtm->rtm_family, fvw.nexthop, fvw.ifname, fvw.weight))
+    {
+        return false;
+    }
+
+    if (!isSuppressionEnabled())
+    {
+        sendOffloadReply(h);
     }
+    fvw.protocol = getProtocolString(rtm->rtm_protocol);
+
+    switch (rtm->rtm_type)
+    {
+        case RTN_BLACKHOLE:
+        {
+            SWSS_LOG_INFO("RouteTable set blackhole msg: %s", destipprefix);
+            fvw.blackhole = "true";
+            setRouteWithWarmRestart(fvw, *m_routeTable);
+            return true;
+        }
+        case RTN_UNICAST:
+            break;
+
+        case RTN_MULTICAST:
+        case RTN_BROADCAST:
+        case RTN_LOCAL:
+            SWSS_LOG_INFO("BUM routes aren't supported yet (%s)", destipprefix);
+            return true;
+
+        default:
+            return true;
+    }
+
+    setUnicastRoute(fvw, nhg_id, rtm->rtm_family);
+    return true;
 }
 
 /*
@@ -2859,20 +3186,66 @@ bool RouteSync::getIfName(int if_index, char *if_name, size_t name_len)
 
     memset(if_name, 0, name_len);
 
+    const string *name = m_linkNames.getName(if_index);
+    if (name)
+    {
+        strncpy(if_name, name->c_str(), name_len - 1);
+        return true;
+    }
+
+    /* Already looked up since the last link event */
+    if (m_linkNames.isMissing(if_index))
+    {
+        return false;
+    }
+
+    bool refilled = false;
+    if (m_linkCacheStale)
+    {
+        nl_cache_refill(m_nl_sock, m_link_cache);
+        m_linkCacheStale = false;
+        refilled = true;
+    }
+
     /* Cannot get interface name. Possibly the interface gets re-created. */
     if (!rtnl_link_i2name(m_link_cache, if_index, if_name, name_len))
     {
         /* Trying to refill cache */
+        if (refilled)
+        {
+            m_linkNames.setMissing(if_index);
+            return false;
+        }
         nl_cache_refill(m_nl_sock, m_link_cache);
         if (!rtnl_link_i2name(m_link_cache, if_index, if_name, name_len))
         {
+            m_linkNames.setMissing(if_index);
             return false;
         }
     }
 
+    m_linkNames.set(if_index, if_name);
     return true;
 }
 
+void RouteSync::onLinkMsg(int nlmsg_type, struct rtnl_link *link)
+{
+    int if_index = rtnl_link_get_ifindex(link);
+    const char *if_name = rtnl_link_get_name(link);
+
+    if (nlmsg_type == RTM_DELLINK || !if_name)
+    {
+        m_linkNames.del(if_index);
+    }
+    else
+    {
+        m_linkNames.set(if_index, if_name);
+    }
+
+    m_linkNames.clearMissing();
+    m_linkCacheStale = true;
+}
+
 rtnl_link* RouteSync::getLinkByName(const char *name)
 {
     auto link = rtnl_link_get_by_name(m_link_cache, name);
@@ -2989,6 +3362,94 @@ void RouteSync::getNextHopList(struct rtnl_route *route_obj, string& gw_list,
     }
 }
 
+/*
+ * getNextHopListRaw() - parses next hop list of a raw route message, the way
+ * getNextHopList() and getNextHopWt() do for libnl route objects
+ * @arg tb            (input) route attributes
+ * @arg family        (input) address family of the route
+ * @arg gw_list       (output) comma-separated list of NH IP gateways
+ * @arg intf_list     (output) comma-separated list of NH interfaces
+ * @arg weights       (output) comma-separated list of NH weights
+ *
+ * Return false if the next hops are left to getNextHopList() (no next hop, RTA_VIA, encap)
+ */
+bool RouteSync::getNextHopListRaw(struct rtattr *tb[], uint8_t family, string& gw_list,
+                                  string& intf_list, string& weights)
+{
+    auto addNextHop = [&](struct rtattr *gateway, int if_index, uint8_t weight)
+    {
+        if (!gw_list.empty())
+        {
+            gw_list += NHG_DELIMITER;
+            intf_list += NHG_DELIMITER;
+            weights += NHG_DELIMITER;
+        }
+
+        if (gateway)
+        {
+            char gw_ip[MAX_ADDR_SIZE + 1] = {0};
+            inet_ntop(family, RTA_DATA(gateway), gw_ip, MAX_ADDR_SIZE);
+            gw_list += gw_ip;
+        }
+        else
+        {
+            gw_list += family == AF_INET6 ? "::" : "0.0.0.0";
+        }
+
+        char if_name[IFNAMSIZ] = "0";
+        if (getIfName(if_index, if_name, IFNAMSIZ))
+        {
+            intf_list += if_name;
+        }
+        /* If we cannot get the interface name */
+        else
+        {
+            intf_list += "unknown";
+        }
+
+        /* default weight is 1 */
+        weights += to_string(weight ? weight : 1);
+    };
+
+    unsigned int addr_len = family == AF_INET ? IPV4_MAX_BYTE : IPV6_MAX_BYTE;
+
+    if (!tb[RTA_MULTIPATH])
+    {
+        if (!tb[RTA_GATEWAY] && !tb[RTA_OIF])
+        {
+            return false;
+        }
+        if (tb[RTA_GATEWAY] && (unsigned int)RTA_PAYLOAD(tb[RTA_GATEWAY]) != addr_len)
+        {
+            return false;
+        }
+
+        addNextHop(tb[RTA_GATEWAY], tb[RTA_OIF] ? *(int *)RTA_DATA(tb[RTA_OIF]) : 0, 0);
+        return true;
+    }
+
+    struct rtnexthop *rtnh = (struct rtnexthop *)RTA_DATA(tb[RTA_MULTIPATH]);
+    int len = (int)RTA_PAYLOAD(tb[RTA_MULTIPATH]);
+    struct rtattr *subtb[RTA_MAX + 1];
+
+    for (; RTNH_OK(rtnh, len); len -= NLMSG_ALIGN(rtnh->rtnh_len), rtnh = RTNH_NEXT(rtnh))
+    {
+        memset(subtb, 0, sizeof(subtb));
+        netlink_parse_rtattr(subtb, RTA_MAX, RTNH_DATA(rtnh),
+                             (int)(rtnh->rtnh_len - sizeof(*rtnh)));
+
+        if (subtb[RTA_VIA] || subtb[RTA_ENCAP] || subtb[RTA_ENCAP_TYPE]
+            || (subtb[RTA_GATEWAY] && (unsigned int)RTA_PAYLOAD(subtb[RTA_GATEWAY]) != addr_len))
+        {
+            return false;
+        }
+
+        addNextHop(subtb[RTA_GATEWAY], rtnh->rtnh_ifindex, rtnh->rtnh_hops);
+    }
+
+    return !gw_list.empty();
+}
+
 /*
  * Get next hop gateway IP addresses
  * @arg route_obj     route object
@@ -3120,6 +3581,16 @@ bool RouteSync::sendOffloadReply(struct nlmsghdr* hdr)
         return false;
     }
 
+    if (m_batchOffloadReplies)
+    {
+        // Keep the netlink alignment, flushOffloadReplies() points into the buffer
+        size_t offset = m_offloadReplies.size();
+        m_offloadReplies.resize(offset + NLMSG_ALIGN(hdr->nlmsg_len));
+        memcpy(m_offloadReplies.data() + offset, hdr, hdr->nlmsg_len);
+        m_offloadReplyOffsets.push_back(offset);
+        return true;
+    }
+
     // Send to zebra
     if (!m_fpmInterface->send(hdr))
     {
@@ -3153,6 +3624,64 @@ bool RouteSync::sendOffloadReply(struct rtnl_route* route_obj)
     return sendOffloadReply(nlmsg_hdr(nlMsg.get()));
 }
 
+void RouteSync::beginOffloadReplies()
+{
+    m_batchOffloadReplies = true;
+}
+
+void RouteSync::flushOffloadReplies()
+{
+    SWSS_LOG_ENTER();
+
+    m_batchOffloadReplies = false;
+
+    if (m_offloadReplyOffsets.empty())
+    {
+        return;
+    }
+
+    if (!m_fpmInterface)
+    {
+        SWSS_LOG_ERROR("Cannot send %zu offload replies to zebra: FPM is disconnected", m_offloadReplyOffsets.size());
+    }
+    else
+    {
+        vector<nlmsghdr*> msgs;
+        msgs.reserve(m_offloadReplyOffsets.size());
+        for (auto offset : m_offloadReplyOffsets)
+        {
+            msgs.push_back(reinterpret_cast<nlmsghdr*>(m_offloadReplies.data() + offset));
+        }
+
+        if (!m_fpmInterface->sendBatch(msgs))
+        {
+            SWSS_LOG_ERROR("Failed to send %zu replies to zebra", msgs.size());
+        }
+        else
+        {
+            SWSS_LOG_INFO("Sent %zu replies to zebra", msgs.size());
+        }
+    }
+
+    m_offloadReplies.clear();
+    m_offloadReplyOffsets.clear();
+}
+
+void RouteSync::logOffloadLatency()
+{
+    auto latency = m_offloadTracker.getLatency();
+    if (latency.count == m_offloadLatencyLogged)
+    {
+        return;
+    }
+    m_offloadLatencyLogged = latency.count;
+
+    SWSS_LOG_NOTICE("Pending offload latency p50 %" PRIu64 " us, p90 %" PRIu64 " us, p99 %" PRIu64 " us, max %" PRIu64
+                    " us (%" PRIu64 " responses, %zu routes in flight)",
+                    latency.p50Usec, latency.p90Usec, latency.p99Usec, latency.maxUsec,
+                    latency.count, latency.inFlight);
+}
+
 void RouteSync::setSuppressionEnabled(bool enabled)
 {
     SWSS_LOG_ENTER();
@@ -3204,6 +3733,20 @@ void RouteSync::onRouteResponse(const std::string& key, const std::vector<FieldV
             isSetOperation = true;
             protocol = value;
         }
+        else if (field == ROUTE_BINARY_FIELD)
+        {
+            // Routes read back from APPL_DB written in the binary form
+            isSetOperation = true;
+            parseRouteBinary(value,
+                [](RouteBinaryTag, size_t) {},
+                [&protocol](RouteBinaryTag tag, const char *data, size_t len)
+                {
+                    if (tag == ROUTE_BIN_PROTOCOL)
+                    {
+                        protocol.assign(data, len);
+                    }
+                });
+        }
     }
 
     if (!isSetOperation)
@@ -3213,6 +3756,9 @@ void RouteSync::onRouteResponse(const std::string& key, const std::vector<FieldV
         return;
     }
 
+    /* A failure answers the route as well, zebra keeps it pending */
+    m_offloadTracker.complete(key, RouteOffloadTracker::Clock::now());
+
     if (!isSuccessReply)
     {
         SWSS_LOG_INFO("Received failure response for prefix %s(%s)",
@@ -3245,15 +3791,21 @@ void RouteSync::onRouteResponse(const std::string& key, const std::vector<FieldV
     unsigned int vrfIfIndex = 0;
     if (!vrfName.empty())
     {
-        auto* link = getLinkByName(vrfName.c_str());
-        if (!link)
+        int linkIfIndex = m_linkNames.getIndex(vrfName);
+        if (!linkIfIndex)
         {
-            SWSS_LOG_DEBUG("Failed to find VRF when constructing response message for prefix %s(%s). "
-                "This message is probably outdated", prefix.to_string().c_str(),
-                vrfName.c_str());
-            return;
+            auto* link = getLinkByName(vrfName.c_str());
+            if (!link)
+            {
+                SWSS_LOG_DEBUG("Failed to find VRF when constructing response message for prefix %s(%s). "
+                    "This message is probably outdated", prefix.to_string().c_str(),
+                    vrfName.c_str());
+                return;
+            }
+            linkIfIndex = rtnl_link_get_ifindex(link);
+            m_linkNames.set(linkIfIndex, vrfName);
         }
-        vrfIfIndex = rtnl_link_get_ifindex(link);
+        vrfIfIndex = static_cast<unsigned int>(linkIfIndex);
     }
 
     rtnl_route_set_table(routeObject.get(), vrfIfIndex);
@@ -3278,6 +3830,7 @@ void RouteSync::sendOffloadReply(DBConnector& db, const std::string& tableName)
     std::vector<std::string> keys;
     routeTable.getKeys(keys);
 
+    beginOffloadReplies();
     for (const auto& key: keys)
     {
         std::vector<FieldValueTuple> fieldValues;
@@ -3286,12 +3839,19 @@ void RouteSync::sendOffloadReply(DBConnector& db, const std::string& tableName)
 
         onRouteResponse(key, fieldValues);
     }
+    flushOffloadReplies();
 }
 
 void RouteSync::markRoutesOffloaded(swss::DBConnector& db)
 {
     SWSS_LOG_ENTER();
 
+    /* The routes still queued by the shards are not in APPL_DB yet */
+    if (m_routeShards)
+    {
+        m_routeShards->drain();
+    }
+
     sendOffloadReply(db, APP_ROUTE_TABLE_NAME);
 }
 
@@ -3365,6 +3925,9 @@ void RouteSync::deleteNextHopGroup(uint32_t nh_id)
 
     if(nhg.installed)
     {
+        /* Held routes may still point to the group */
+        flushCoalescedRoutes(true);
+
         string key = getNextHopGroupKeyAsString(nh_id);
         SWSS_LOG_DEBUG("NextHopGroup table del: key [%s]", key.c_str());
         m_nexthop_groupTable.del(key);
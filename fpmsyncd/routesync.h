@@ -9,6 +9,10 @@
 #include "linkcache.h"
 #include "fpminterface.h"
 #include "warmRestartHelper.h"
+#include "routecoalescer.h"
+#include "routeoffloadtracker.h"
+#include "routeshardpool.h"
+#include "linknametable.h"
 #include <string.h>
 #include <bits/stdc++.h>
 #include <linux/version.h>
@@ -93,8 +97,14 @@ class FieldValueTupleWrapperBase {
 
     string key = string();
 
+    /* Encode the fields in ROUTE_BINARY_FIELD, honored by the route table only */
+    void setBinary(bool _binary) {
+        binary = _binary;
+    }
+
     protected:
     bool nbZmqEnabled = false;
+    bool binary = false;
 
 };
 
@@ -113,6 +123,9 @@ class RouteTableFieldValueTupleWrapper : public FieldValueTupleWrapperBase {
 
     vector<FieldValueTuple> fieldValueTupleVector() override;
 
+    /* Reset all the fields but the key, for one wrapper to serve many routes */
+    void reset(bool _nbZmqEnabled);
+
     string protocol = string();
     string blackhole = string("false");
     string nexthop = string();
@@ -225,6 +238,12 @@ public:
 
     virtual void onMsgRaw(struct nlmsghdr *obj);
 
+    /*
+     * Handle regular route (include VRF route) without converting it into a
+     * libnl object, returns false if the route is left to onMsg()
+     */
+    bool onRouteMsgRaw(struct nlmsghdr *h);
+
     void setSuppressionEnabled(bool enabled);
 
     bool isSuppressionEnabled() const
@@ -248,6 +267,43 @@ public:
 
     void onRouteResponse(const std::string& key, const std::vector<FieldValueTuple>& fieldValues);
 
+    /* Hold ROUTE_TABLE updates per prefix for windowMsec, 0 disables it */
+    void setRouteCoalescing(int windowMsec, int maxDelayMsec);
+
+    /* Write the coalesced route updates which are due, all of them when force is set */
+    void flushCoalescedRoutes(bool force = false);
+
+    /* Milliseconds until coalesced route updates are due, -1 if none */
+    int getCoalesceTimeout() const;
+
+    const RouteCoalescer& getRouteCoalescer() const
+    {
+        return m_routeCoalescer;
+    }
+
+    /* Write ROUTE_TABLE from count worker threads, 0 writes it from the caller */
+    void setRouteShards(size_t count);
+
+    const RouteShardPool* getRouteShards() const
+    {
+        return m_routeShards.get();
+    }
+
+    /*
+     * Offload replies sent after beginOffloadReplies() are queued, and written
+     * to zebra together by flushOffloadReplies()
+     */
+    void beginOffloadReplies();
+    void flushOffloadReplies();
+
+    const RouteOffloadTracker& getOffloadTracker() const
+    {
+        return m_offloadTracker;
+    }
+
+    /* Log the pending offload latency percentiles, if responses came since the last time */
+    void logOffloadLatency();
+
     void onWarmStartEnd(swss::DBConnector& applStateDb);
 
     /* Mark all routes from DB with offloaded flag */
@@ -261,6 +317,10 @@ public:
     void onFpmDisconnected()
     {
         m_fpmInterface = nullptr;
+        m_offloadReplies.clear();
+        m_offloadReplyOffsets.clear();
+        /* zebra sends all the routes again on the next connection */
+        m_offloadTracker.clear();
     }
 
     WarmStartHelper& getWarmStartHelper()
@@ -287,6 +347,10 @@ private:
     ProducerStateTable m_srv6SidListTable; 
     struct nl_cache    *m_link_cache;
     struct nl_sock     *m_nl_sock;
+    /* Names of the links by ifindex, the libnl link cache only serves the misses */
+    LinkNameTable       m_linkNames;
+    /* A link event came since the libnl link cache was last filled */
+    bool                m_linkCacheStale{false};
     /* nexthop group table */
     ProducerStateTable  m_nexthop_groupTable;
     ProducerStateTable  m_pic_context_groupTable;
@@ -295,11 +359,33 @@ private:
     map<string, uint32_t> m_srv6_sidlist_refcnt;
 
     bool                m_isSuppressionEnabled{false};
+    /* ROUTE_TABLE entries go in ROUTE_BINARY_FIELD, over ZMQ only */
+    bool                m_routeBinary{false};
     FpmInterface*       m_fpmInterface {nullptr};
+    /* ROUTE_TABLE updates held before they are written */
+    RouteCoalescer      m_routeCoalescer;
+    /* ROUTE_TABLE writers, when set */
+    unique_ptr<RouteShardPool> m_routeShards;
+    /* Routes waiting for the orchagent response */
+    RouteOffloadTracker m_offloadTracker;
+    uint64_t            m_offloadLatencyLogged{0};
+    /* Offload replies queued between beginOffloadReplies() and flushOffloadReplies() */
+    bool                m_batchOffloadReplies{false};
+    vector<char>        m_offloadReplies;
+    vector<size_t>      m_offloadReplyOffsets;
+    /* Fields of the route being parsed by onRouteMsgRaw() */
+    RouteTableFieldValueTupleWrapper m_rawRoute{string(), string(), false};
+
+    /* Write a ROUTE_TABLE key, through its shard if any */
+    void writeRoute(const string& key, vector<KeyOpFieldsValuesTuple>&& kfvs);
+    void deleteRoute(const string& key);
 
     /* Handle regular route (include VRF route) */
     void onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf);
 
+    /* Publish a unicast route once its next hops are parsed */
+    void setUnicastRoute(RouteTableFieldValueTupleWrapper &fvw, uint32_t nhg_id, uint8_t family);
+
     /* Handle label route */
     void onLabelRouteMsg(int nlmsg_type, struct nl_object *obj);
 
@@ -344,6 +430,9 @@ private:
     /* Get interface if_index based on interface name */
     rtnl_link* getLinkByName(const char *name);
 
+    /* Update the link name table from a RTM_NEWLINK/RTM_DELLINK event */
+    void onLinkMsg(int nlmsg_type, struct rtnl_link *link);
+
     void getEvpnNextHopSep(string& nexthops, string& vni_list,  
                        string& mac_list, string& intf_list);
 
@@ -365,6 +454,10 @@ private:
     void getNextHopList(struct rtnl_route *route_obj, string& gw_list,
                         string& mpls_list, string& intf_list);
 
+    /* Get next hop list of a raw route message */
+    bool getNextHopListRaw(struct rtattr *tb[], uint8_t family, string& gw_list,
+                           string& intf_list, string& weights);
+
     /* Get next hop gateway IP addresses */
     string getNextHopGw(struct rtnl_route *route_obj);
 
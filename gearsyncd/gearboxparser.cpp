@@ -24,9 +24,12 @@ void GearboxParser::notifyGearboxConfigDone(bool success)
     swss::ProducerStateTable *p = getProducerStateTable().get();
 
     swss::FieldValueTuple finish_notice("success", std::to_string(success));
-    std::vector<swss::FieldValueTuple> attrs = { finish_notice };
+    std::vector<swss::FieldValueTuple> attrs = { finish_notice, swss::GearboxUtils::makeConfigGeneration() };
 
     p->set("GearboxConfigDone", attrs);
+
+    // The entries go out with the notice, which must come last
+    flush();
 }
 
 bool GearboxParser::parse()
@@ -25,7 +25,8 @@ GearParserBase::init()
     m_writeToDb = false;
     m_rootInit = false;
     m_applDb = std::unique_ptr<swss::DBConnector>{new swss::DBConnector("APPL_DB", 0)};
-    m_producerStateTable = std::unique_ptr<swss::ProducerStateTable>{new swss::ProducerStateTable(m_applDb.get(), APP_GEARBOX_TABLE_NAME)};
+    m_pipeline = std::unique_ptr<swss::RedisPipeline>{new swss::RedisPipeline(m_applDb.get(), GEARBOX_PIPELINE_SIZE)};
+    m_producerStateTable = std::unique_ptr<swss::ProducerStateTable>{new swss::ProducerStateTable(m_pipeline.get(), APP_GEARBOX_TABLE_NAME, true)};
 }
 
 GearParserBase::GearParserBase() 
@@ -35,6 +36,12 @@ GearParserBase::GearParserBase()
 
 GearParserBase::~GearParserBase() 
 {
+    flush();
+}
+
+void GearParserBase::flush()
+{
+    m_producerStateTable->flush();
 }
 
 json & GearParserBase::getJSONRoot()
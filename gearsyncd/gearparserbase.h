@@ -18,6 +18,7 @@
 
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "redispipeline.h"
 #include <string>
 #include <memory>
 #include <vector>
@@ -30,6 +31,9 @@
 
 using json = nlohmann::json;
 
+/* Gearbox table entries queued on the pipeline before it is flushed */
+#define GEARBOX_PIPELINE_SIZE 128
+
 class GearParserBase
 {
 public:
@@ -41,6 +45,8 @@ public:
     void setConfigPath(std::string &path) {m_cfgPath = path;}
     const std::string getConfigPath() {return m_cfgPath;}
     std::unique_ptr<swss::ProducerStateTable> &getProducerStateTable() {return m_producerStateTable;}
+    /* Write the entries queued by writeToDb() */
+    void flush();
 
 protected:
     bool writeToDb(std::string &key, std::vector<swss::FieldValueTuple> &attrs);
@@ -51,6 +57,8 @@ private:
     std::unique_ptr<swss::DBConnector> m_cfgDb;
     std::unique_ptr<swss::DBConnector> m_applDb;
     std::unique_ptr<swss::DBConnector> m_stateDb;
+    // Entries are written in pipelined batches, flushed at the latest on destruction
+    std::unique_ptr<swss::RedisPipeline> m_pipeline;
     std::unique_ptr<swss::ProducerStateTable> m_producerStateTable;
     std::string m_cfgPath;
     bool m_writeToDb;
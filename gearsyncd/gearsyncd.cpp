@@ -45,9 +45,12 @@ static void notifyGearboxConfigDone(ProducerStateTable &p, bool success)
     /* Notify that gearbox config successfully written */
 
     FieldValueTuple finish_notice("success", to_string(success));
-    std::vector<FieldValueTuple> attrs = { finish_notice };
+    std::vector<FieldValueTuple> attrs = { finish_notice, GearboxUtils::makeConfigGeneration() };
 
     p.set("GearboxConfigDone", attrs);
+
+    // The entries go out with the notice, which must come last
+    p.flush();
 }
 
 int main(int argc, char **argv)
@@ -76,7 +79,8 @@ int main(int argc, char **argv)
 
     DBConnector cfgDb("CONFIG_DB", 0);
     DBConnector applDb("APPL_DB", 0);
-    ProducerStateTable producerStateTable(&applDb, APP_GEARBOX_TABLE_NAME);
+    RedisPipeline pipeline(&applDb, GEARBOX_PIPELINE_SIZE);
+    ProducerStateTable producerStateTable(&pipeline, APP_GEARBOX_TABLE_NAME, true);
 
     WarmStart::initialize("gearsyncd", "swss");
     WarmStart::checkWarmStart("gearsyncd", "swss");
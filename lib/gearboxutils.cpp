@@ -16,6 +16,9 @@
 
 #include "gearboxutils.h"
 
+#include <algorithm>
+#include <chrono>
+
 namespace swss {
 
 std::tuple <std::string, std::string, std::string> GearboxUtils::parseGearboxKey(std::string key_str)
@@ -113,102 +116,46 @@ bool GearboxUtils::isGearboxEnabled(Table *gearboxTable)
     return gearboxDone;
 }
 
-std::map<int, gearbox_phy_t> GearboxUtils::loadPhyMap(Table *gearboxTable)
+void GearboxUtils::invalidate()
 {
-    std::vector<FieldValueTuple> ovalues;
-    std::tuple <std::string, std::string, std::string> keyt;
-    std::vector<std::string> keys;
+    m_loadedVersion.clear();
+    gearboxPhyMap.clear();
+    gearboxInterfaceMap.clear();
+    gearboxLaneMap.clear();
+    gearboxPortMap.clear();
+}
 
-    SWSS_LOG_ENTER();
+FieldValueTuple GearboxUtils::makeConfigGeneration()
+{
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    return FieldValueTuple("generation", std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()));
+}
+
+/*
+ * The version of the table is its name, its sorted keys and the fields of
+ * GearboxConfigDone. It costs a single read besides the key scan.
+ */
+std::vector<std::string> GearboxUtils::getTableVersion(Table *gearboxTable, std::vector<std::string> &keys)
+{
+    std::vector<std::string> version;
+    std::vector<FieldValueTuple> done;
 
     gearboxTable->getKeys(keys);
+    std::sort(keys.begin(), keys.end());
 
-    if (keys.empty())
-    {
-        SWSS_LOG_ERROR("No Gearbox records in ApplDB!");
-        return gearboxPhyMap;
-    }
+    version.push_back(gearboxTable->getTableName());
+    version.insert(version.end(), keys.begin(), keys.end());
 
-    for (auto &k : keys)
+    gearboxTable->get("GearboxConfigDone", done);
+    for (auto &fv : done)
     {
-        keyt = parseGearboxKey(k);
-
-        if (std::get<0>(keyt).compare("phy") == 0)
-        {
-            gearbox_phy_t phy = {};
-
-            // default capability if absent
-            phy.macsec_supported = true;
-
-            gearboxTable->get(k, ovalues);
-            for (auto &val : ovalues)
-            {
-                if (val.first == "phy_id")
-                {
-                    phy.phy_id = std::stoi(val.second);
-                }
-                else if (val.first == "phy_oid")
-                {
-                    // oid is from create_switch (not config)
-                    phy.phy_oid = val.second;
-                }
-                else if (val.first == "name")
-                {
-                    phy.name = val.second;
-                }
-                else if (val.first == "lib_name")
-                {
-                    phy.lib_name = val.second;
-                }
-                else if (val.first == "firmware_path")
-                {
-                    phy.firmware = val.second;
-                }
-                else if (val.first == "config_file")
-                {
-                    phy.config_file = val.second;
-                }
-                else if (val.first == "sai_init_config_file")
-                {
-                    phy.sai_init_config_file = val.second;
-                }
-                else if (val.first == "phy_access")
-                {
-                    phy.access = val.second;
-                }
-                else if (val.first == "hwinfo")
-                {
-                    phy.hwinfo = val.second;
-                }
-                else if (val.first == "address")
-                {
-                    phy.address = std::stoi(val.second);
-                }
-                else if (val.first == "bus_id")
-                {
-                    phy.bus_id = std::stoi(val.second);
-                }
-                else if (val.first == "context_id")
-                {
-                    phy.context_id = std::stoi(val.second);
-                }
-                else if (val.first == "macsec_ipg")
-                {
-                    phy.macsec_ipg = std::stoi(val.second);
-                }
-                else if (val.first == "macsec_supported")
-                {
-                    phy.macsec_supported = (val.second == "true");
-                }
-            }
-            gearboxPhyMap[phy.phy_id] = phy;
-        }
+        version.push_back(fvField(fv) + "=" + fvValue(fv));
     }
 
-    return gearboxPhyMap;
+    return version;
 }
 
-std::map<int, gearbox_interface_t> GearboxUtils::loadInterfaceMap(Table *gearboxTable)
+bool GearboxUtils::load(Table *gearboxTable)
 {
     std::vector<FieldValueTuple> ovalues;
     std::tuple <std::string, std::string, std::string> keyt;
@@ -216,266 +163,344 @@ std::map<int, gearbox_interface_t> GearboxUtils::loadInterfaceMap(Table *gearbox
 
     SWSS_LOG_ENTER();
 
-    gearboxTable->getKeys(keys);
+    auto version = getTableVersion(gearboxTable, keys);
+    if (!m_loadedVersion.empty() && m_loadedVersion == version)
+    {
+        return true;
+    }
+
+    invalidate();
 
     if (keys.empty())
     {
         SWSS_LOG_ERROR("No Gearbox records in ApplDB!");
-        return gearboxInterfaceMap;
+        return false;
     }
 
+    // Each entry is read once, whichever of the maps it belongs to
     for (auto &k : keys)
     {
         keyt = parseGearboxKey(k);
+        const auto &type = std::get<0>(keyt);
 
-        if (std::get<0>(keyt).compare("interface") == 0)
+        if (type == "phy")
         {
-            gearbox_interface_t interface = {};
-
             gearboxTable->get(k, ovalues);
-            for (auto &val : ovalues)
-            {
-                if (val.first == "index")
-                {
-                    interface.index = std::stoi(val.second);
-                    SWSS_LOG_DEBUG("BOX interface = %d", interface.index);
-                }
-                else if (val.first == "phy_id")
-                {
-                    interface.phy_id = std::stoi(val.second);
-                    SWSS_LOG_DEBUG("BOX phy_id = %d", interface.phy_id);
-                }
-                else if (val.first == "line_lanes")
-                {
-                    std::stringstream ss(val.second);
-
-                    for (int i; ss >> i;)
-                    {
-                        SWSS_LOG_DEBUG("Parsed key:%s, val:%s,inserted %d", val.first.c_str(), val.second.c_str(), i);
-                        interface.line_lanes.insert(i);
-                        if (ss.peek() == ',')
-                        {
-                            ss.ignore();
-                        }
-                    }
-                }
-                else if (val.first == "system_lanes")
-                {
-                    std::stringstream ss(val.second);
-
-                    for (int i; ss >> i;)
-                    {
-                        SWSS_LOG_DEBUG("Parsed key:%s, val:%s,inserted %d", val.first.c_str(), val.second.c_str(), i);
-                        interface.system_lanes.insert(i);
-                        if (ss.peek() == ',')
-                        {
-                            ss.ignore();
-                        }
-                    }
-                }
-                else if (tx_fir_strings.find(val.first) != tx_fir_strings.end())
-                {
-                    SWSS_LOG_DEBUG("Parsed key:%s, val:%s", val.first.c_str(), val.second.c_str());
-                    interface.tx_firs[val.first] = val.second;
-                }
-            }
+            gearbox_phy_t phy = parsePhy(ovalues);
+            gearboxPhyMap[phy.phy_id] = phy;
+        }
+        else if (type == "interface")
+        {
+            gearboxTable->get(k, ovalues);
+            gearbox_interface_t interface = parseInterface(ovalues);
             gearboxInterfaceMap[interface.index] = interface;
         }
+        else if (type == "lanes")
+        {
+            gearboxTable->get(k, ovalues);
+            gearbox_lane_t lane = parseLane(ovalues);
+            gearboxLaneMap[lane.index] = lane;
+        }
+        else if (type == "ports")
+        {
+            gearboxTable->get(k, ovalues);
+            gearbox_port_t port = parsePort(ovalues);
+            gearboxPortMap[port.index] = port;
+        }
     }
 
-    return gearboxInterfaceMap;
+    m_loadedVersion = std::move(version);
+    return true;
 }
 
-std::map<int, gearbox_lane_t> GearboxUtils::loadLaneMap(Table *gearboxTable)
+gearbox_phy_t GearboxUtils::parsePhy(const std::vector<FieldValueTuple> &ovalues)
 {
-    std::vector<FieldValueTuple> ovalues;
-    std::tuple <std::string, std::string, std::string> keyt;
-    std::vector<std::string> keys;
+    gearbox_phy_t phy = {};
 
-    SWSS_LOG_ENTER();
+    // default capability if absent
+    phy.macsec_supported = true;
 
-    gearboxTable->getKeys(keys);
-
-    if (keys.empty())
+    for (auto &val : ovalues)
     {
-        SWSS_LOG_ERROR("No Gearbox records in ApplDB!");
-        return gearboxLaneMap;
+        if (val.first == "phy_id")
+        {
+            phy.phy_id = std::stoi(val.second);
+        }
+        else if (val.first == "phy_oid")
+        {
+            // oid is from create_switch (not config)
+            phy.phy_oid = val.second;
+        }
+        else if (val.first == "name")
+        {
+            phy.name = val.second;
+        }
+        else if (val.first == "lib_name")
+        {
+            phy.lib_name = val.second;
+        }
+        else if (val.first == "firmware_path")
+        {
+            phy.firmware = val.second;
+        }
+        else if (val.first == "config_file")
+        {
+            phy.config_file = val.second;
+        }
+        else if (val.first == "sai_init_config_file")
+        {
+            phy.sai_init_config_file = val.second;
+        }
+        else if (val.first == "phy_access")
+        {
+            phy.access = val.second;
+        }
+        else if (val.first == "hwinfo")
+        {
+            phy.hwinfo = val.second;
+        }
+        else if (val.first == "address")
+        {
+            phy.address = std::stoi(val.second);
+        }
+        else if (val.first == "bus_id")
+        {
+            phy.bus_id = std::stoi(val.second);
+        }
+        else if (val.first == "context_id")
+        {
+            phy.context_id = std::stoi(val.second);
+        }
+        else if (val.first == "macsec_ipg")
+        {
+            phy.macsec_ipg = std::stoi(val.second);
+        }
+        else if (val.first == "macsec_supported")
+        {
+            phy.macsec_supported = (val.second == "true");
+        }
     }
+    return phy;
+}
 
-    for (auto &k : keys)
-    {
-        keyt = parseGearboxKey(k);
+gearbox_interface_t GearboxUtils::parseInterface(const std::vector<FieldValueTuple> &ovalues)
+{
+    gearbox_interface_t interface = {};
 
-        if (std::get<0>(keyt).compare("lanes") == 0)
+    for (auto &val : ovalues)
+    {
+        if (val.first == "index")
+        {
+            interface.index = std::stoi(val.second);
+            SWSS_LOG_DEBUG("BOX interface = %d", interface.index);
+        }
+        else if (val.first == "phy_id")
         {
-            gearbox_lane_t lane = {};
+            interface.phy_id = std::stoi(val.second);
+            SWSS_LOG_DEBUG("BOX phy_id = %d", interface.phy_id);
+        }
+        else if (val.first == "line_lanes")
+        {
+            std::stringstream ss(val.second);
 
-            gearboxTable->get(k, ovalues);
-            for (auto &val : ovalues)
+            for (int i; ss >> i;)
             {
-                if (val.first == "index")
-                {
-                    lane.index = std::stoi(val.second);
-                }
-                else if (val.first == "tx_polarity")
-                {
-                    lane.tx_polarity = std::stoi(val.second);
-                }
-                else if (val.first == "rx_polarity")
-                {
-                    lane.rx_polarity = std::stoi(val.second);
-                }
-                else if (val.first == "line_tx_lanemap")
+                SWSS_LOG_DEBUG("Parsed key:%s, val:%s,inserted %d", val.first.c_str(), val.second.c_str(), i);
+                interface.line_lanes.insert(i);
+                if (ss.peek() == ',')
                 {
-                    lane.line_tx_lanemap = std::stoi(val.second);
+                    ss.ignore();
                 }
-                else if (val.first == "line_rx_lanemap")
-                {
-                    lane.line_rx_lanemap = std::stoi(val.second);
-                }
-                else if (val.first == "line_to_system_lanemap")
-                {
-                    lane.line_to_system_lanemap = std::stoi(val.second);
-                }
-                else if (val.first == "mdio_addr")
-                {
-                    lane.mdio_addr = val.second;
-                }
-                else if (val.first == "system_side")
+            }
+        }
+        else if (val.first == "system_lanes")
+        {
+            std::stringstream ss(val.second);
+
+            for (int i; ss >> i;)
+            {
+                SWSS_LOG_DEBUG("Parsed key:%s, val:%s,inserted %d", val.first.c_str(), val.second.c_str(), i);
+                interface.system_lanes.insert(i);
+                if (ss.peek() == ',')
                 {
-                    lane.system_side = (val.second == "true") ? true : false;
+                    ss.ignore();
                 }
             }
-            gearboxLaneMap[lane.index] = lane;
+        }
+        else if (tx_fir_strings.find(val.first) != tx_fir_strings.end())
+        {
+            SWSS_LOG_DEBUG("Parsed key:%s, val:%s", val.first.c_str(), val.second.c_str());
+            interface.tx_firs[val.first] = val.second;
         }
     }
-
-    return gearboxLaneMap;
+    return interface;
 }
 
-std::map<int, gearbox_port_t> GearboxUtils::loadPortMap(Table *gearboxTable)
+gearbox_lane_t GearboxUtils::parseLane(const std::vector<FieldValueTuple> &ovalues)
 {
-    std::vector<FieldValueTuple> ovalues;
-    std::tuple <std::string, std::string, std::string> keyt;
-    std::vector<std::string> keys;
+    gearbox_lane_t lane = {};
 
-    SWSS_LOG_ENTER();
-
-    gearboxTable->getKeys(keys);
-
-    if (keys.empty())
+    for (auto &val : ovalues)
     {
-        SWSS_LOG_ERROR("No Gearbox records in ApplDB!");
-        return gearboxPortMap;
+        if (val.first == "index")
+        {
+            lane.index = std::stoi(val.second);
+        }
+        else if (val.first == "tx_polarity")
+        {
+            lane.tx_polarity = std::stoi(val.second);
+        }
+        else if (val.first == "rx_polarity")
+        {
+            lane.rx_polarity = std::stoi(val.second);
+        }
+        else if (val.first == "line_tx_lanemap")
+        {
+            lane.line_tx_lanemap = std::stoi(val.second);
+        }
+        else if (val.first == "line_rx_lanemap")
+        {
+            lane.line_rx_lanemap = std::stoi(val.second);
+        }
+        else if (val.first == "line_to_system_lanemap")
+        {
+            lane.line_to_system_lanemap = std::stoi(val.second);
+        }
+        else if (val.first == "mdio_addr")
+        {
+            lane.mdio_addr = val.second;
+        }
+        else if (val.first == "system_side")
+        {
+            lane.system_side = (val.second == "true") ? true : false;
+        }
     }
+    return lane;
+}
 
-    for (auto &k : keys)
-    {
-        keyt = parseGearboxKey(k);
+gearbox_port_t GearboxUtils::parsePort(const std::vector<FieldValueTuple> &ovalues)
+{
+    gearbox_port_t port = {};
 
-        if (std::get<0>(keyt).compare("ports") == 0)
+    for (auto &val : ovalues)
+    {
+        if (val.first == "index")
         {
-            gearbox_port_t port = {};
-
-            gearboxTable->get(k, ovalues);
-            for (auto &val : ovalues)
+            port.index = std::stoi(val.second);
+        }
+        else if (val.first == "mdio_addr")
+        {
+            port.mdio_addr = val.second;
+        }
+        else if (val.first == "system_speed")
+        {
+            port.system_speed = std::stoi(val.second);
+        }
+        else if (val.first == "system_fec")
+        {
+            port.system_fec = val.second;
+        }
+        else if (val.first == "system_auto_neg")
+        {
+            port.system_auto_neg = (val.second == "true") ? true : false;
+        }
+        else if (val.first == "system_loopback")
+        {
+            port.system_loopback = val.second;
+        }
+        else if (val.first == "system_training")
+        {
+            port.system_training = (val.second == "true") ? true : false;
+        }
+        else if (val.first == "line_speed")
+        {
+            port.line_speed = std::stoi(val.second);
+        }
+        else if (val.first == "line_fec")
+        {
+            port.line_fec = val.second;
+        }
+        else if (val.first == "line_auto_neg")
+        {
+            port.line_auto_neg = (val.second == "true") ? true : false;
+        }
+        else if (val.first == "line_media_type")
+        {
+            port.line_media_type = val.second;
+        }
+        else if (val.first == "line_intf_type")
+        {
+            port.line_intf_type = val.second;
+        }
+        else if (val.first == "line_loopback")
+        {
+            port.line_loopback = val.second;
+        }
+        else if (val.first == "line_training")
+        {
+            port.line_training = (val.second == "true") ? true : false;
+        }
+        else if (val.first == "line_adver_speed")
+        {
+            std::stringstream ss(val.second);
+            for (int i; ss >> i;)
             {
-                if (val.first == "index")
-                {
-                    port.index = std::stoi(val.second);
-                }
-                else if (val.first == "mdio_addr")
-                {
-                    port.mdio_addr = val.second;
-                }
-                else if (val.first == "system_speed")
-                {
-                    port.system_speed = std::stoi(val.second);
-                }
-                else if (val.first == "system_fec")
-                {
-                    port.system_fec = val.second;
-                }
-                else if (val.first == "system_auto_neg")
-                {
-                    port.system_auto_neg = (val.second == "true") ? true : false;
-                }
-                else if (val.first == "system_loopback")
-                {
-                    port.system_loopback = val.second;
-                }
-                else if (val.first == "system_training")
-                {
-                    port.system_training = (val.second == "true") ? true : false;
-                }
-                else if (val.first == "line_speed")
-                {
-                    port.line_speed = std::stoi(val.second);
-                }
-                else if (val.first == "line_fec")
-                {
-                    port.line_fec = val.second;
-                }
-                else if (val.first == "line_auto_neg")
-                {
-                    port.line_auto_neg = (val.second == "true") ? true : false;
-                }
-                else if (val.first == "line_media_type")
+                port.line_adver_speed.insert(i);
+                if (ss.peek() == ',')
                 {
-                    port.line_media_type = val.second;
+                    ss.ignore();
                 }
-                else if (val.first == "line_intf_type")
-                {
-                    port.line_intf_type = val.second;
-                }
-                else if (val.first == "line_loopback")
-                {
-                    port.line_loopback = val.second;
-                }
-                else if (val.first == "line_training")
-                {
-                    port.line_training = (val.second == "true") ? true : false;
-                }
-                else if (val.first == "line_adver_speed")
-                {
-                    std::stringstream ss(val.second);
-                    for (int i; ss >> i;)
-                    {
-                        port.line_adver_speed.insert(i);
-                        if (ss.peek() == ',')
-                        {
-                            ss.ignore();
-                        }
-                    }
-                }
-                else if (val.first == "line_adver_fec")
-                {
-                    std::stringstream ss(val.second);
-                    for (int i; ss >> i;)
-                    {
-                        port.line_adver_fec.insert(i);
-                        if (ss.peek() == ',')
-                        {
-                            ss.ignore();
-                        }
-                    }
-                }
-                else if (val.first == "line_adver_auto_neg")
-                {
-                    port.line_adver_auto_neg = (val.second == "true") ? true : false;
-                }
-                else if (val.first == "line_adver_asym_pause")
-                {
-                    port.line_adver_asym_pause = (val.second == "true") ? true : false;
-                }
-                else if (val.first == "line_adver_media_type")
+            }
+        }
+        else if (val.first == "line_adver_fec")
+        {
+            std::stringstream ss(val.second);
+            for (int i; ss >> i;)
+            {
+                port.line_adver_fec.insert(i);
+                if (ss.peek() == ',')
                 {
-                    port.line_adver_media_type = val.second;
+                    ss.ignore();
                 }
             }
-            gearboxPortMap[port.index] = port;
+        }
+        else if (val.first == "line_adver_auto_neg")
+        {
+            port.line_adver_auto_neg = (val.second == "true") ? true : false;
+        }
+        else if (val.first == "line_adver_asym_pause")
+        {
+            port.line_adver_asym_pause = (val.second == "true") ? true : false;
+        }
+        else if (val.first == "line_adver_media_type")
+        {
+            port.line_adver_media_type = val.second;
         }
     }
+    return port;
+}
+
+std::map<int, gearbox_phy_t> GearboxUtils::loadPhyMap(Table *gearboxTable)
+{
+    load(gearboxTable);
+    return gearboxPhyMap;
+}
+
+std::map<int, gearbox_interface_t> GearboxUtils::loadInterfaceMap(Table *gearboxTable)
+{
+    load(gearboxTable);
+    return gearboxInterfaceMap;
+}
+
+std::map<int, gearbox_lane_t> GearboxUtils::loadLaneMap(Table *gearboxTable)
+{
+    load(gearboxTable);
+    return gearboxLaneMap;
+}
+
+std::map<int, gearbox_port_t> GearboxUtils::loadPortMap(Table *gearboxTable)
+{
+    load(gearboxTable);
     return gearboxPortMap;
 }
 
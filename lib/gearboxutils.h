@@ -111,6 +111,13 @@ typedef struct
     std::string line_adver_media_type;
 } gearbox_port_t;
 
+/*
+ * The gearbox table is read in a single pass by the first of the load*Map()
+ * calls, which parses every entry into its map. The next calls return the
+ * cached maps as long as the table has the same keys and the same generation
+ * of GearboxConfigDone, which gearsyncd stamps on every sync. A field written
+ * in place changes neither, so its writer must call invalidate().
+ */
 class GearboxUtils
 {
     private:
@@ -118,7 +125,15 @@ class GearboxUtils
         std::map<int, gearbox_interface_t> gearboxInterfaceMap;
         std::map<int, gearbox_lane_t> gearboxLaneMap;
         std::map<int, gearbox_port_t> gearboxPortMap;
+        // Version of the table the maps were loaded from, empty if they are not loaded
+        std::vector<std::string> m_loadedVersion;
         std::tuple <std::string, std::string, std::string> parseGearboxKey(std::string key_str);
+        std::vector<std::string> getTableVersion(Table *gearboxTable, std::vector<std::string> &keys);
+        bool load(Table *gearboxTable);
+        static gearbox_phy_t parsePhy(const std::vector<FieldValueTuple> &ovalues);
+        static gearbox_interface_t parseInterface(const std::vector<FieldValueTuple> &ovalues);
+        static gearbox_lane_t parseLane(const std::vector<FieldValueTuple> &ovalues);
+        static gearbox_port_t parsePort(const std::vector<FieldValueTuple> &ovalues);
     public:
         bool platformHasGearbox();
         bool isGearboxConfigDone(Table &gearboxTable);
@@ -128,6 +143,8 @@ class GearboxUtils
         std::map<int, gearbox_interface_t> loadInterfaceMap(Table *gearboxTable);
         std::map<int, gearbox_lane_t> loadLaneMap(Table *gearboxTable);
         std::map<int, gearbox_port_t> loadPortMap(Table *gearboxTable);
+        void invalidate();
+        static FieldValueTuple makeConfigGeneration();
 };
 
 }
@@ -25,6 +25,28 @@
  */
 #define ORCH_NORTHBOND_ROUTE_ZMQ_ENABLED "orch_northbond_route_zmq_enabled"
 
+/*
+ * Feature flag to encode the ROUTE events of fpmsyncd in the compact binary form of routebinary.h,
+ * only used over the ZMQ channel.
+ */
+#define ORCH_NORTHBOND_ROUTE_ZMQ_BINARY "orch_northbond_route_zmq_binary"
+
+/*
+ * Feature flag to enable the neighsyncd to send NEIGH events to orchagent via the ZMQ channel.
+ */
+#define ORCH_NORTHBOND_NEIGH_ZMQ_ENABLED "orch_northbond_neigh_zmq_enabled"
+
+/*
+ * Feature flag to enable the intfmgrd and mclagsyncd to send INTF events to orchagent via the ZMQ channel.
+ */
+#define ORCH_NORTHBOND_INTF_ZMQ_ENABLED "orch_northbond_intf_zmq_enabled"
+
+/*
+ * Feature flag to enable the teammgrd, teamsyncd and mclagsyncd to send LAG and LAG_MEMBER events to
+ * orchagent via the ZMQ channel.
+ */
+#define ORCH_NORTHBOND_LAG_ZMQ_ENABLED "orch_northbond_lag_zmq_enabled"
+
 namespace swss {
 
 std::set<std::string> load_zmq_tables();
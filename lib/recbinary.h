@@ -0,0 +1,388 @@
+#pragma once
+
+#include <sys/time.h>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "table.h"
+
+/*
+ * Compact encoding of the swss.rec records, written instead of the text
+ * lines when the binary swss recording is enabled. swssrecdump turns a
+ * binary file back into the text lines.
+ *
+ * Layout: the magic and version, then a sequence of
+ *   type (1 byte) | payload length (varint) | payload
+ * A payload cut short by a crash ends the file, unknown types are skipped.
+ * A new header may follow when the recording restarts on the same file.
+ *
+ * Table prefixes, operations and field names are interned: a NAME record
+ * gives the next id, from 1, to its string. A reference is the varint id,
+ * or 0 followed by the string once the dictionary is full. Strings are
+ * length (varint) | bytes. Each file starts with an empty dictionary so
+ * that a rotated file decodes on its own.
+ */
+#define REC_BINARY_MAGIC        "SWSSREC"
+#define REC_BINARY_VERSION      1
+#define REC_BINARY_MAX_NAMES    65536
+/* Bound of a record payload, a corrupted length does not allocate the world */
+#define REC_BINARY_MAX_RECORD   (1ULL << 30)
+
+namespace swss {
+
+enum RecBinaryType : uint8_t
+{
+    REC_BIN_NAME = 1,   // string
+    REC_BIN_TUPLE,      // sec | usec | prefix ref | key | op ref | count | count x (field ref | value)
+    REC_BIN_TEXT,       // timestamp | text, any other recorded line
+};
+
+/* Timestamp of a record line, as swss::getTimestamp() renders it */
+inline std::string formatRecTimestamp(const struct timeval &tv)
+{
+    char buffer[64];
+    struct tm tm_info;
+    time_t sec = tv.tv_sec;
+    localtime_r(&sec, &tm_info);
+
+    size_t size = strftime(buffer, 32, "%Y-%m-%d.%T.", &tm_info);
+    snprintf(&buffer[size], 32, "%06" PRIu64, static_cast<uint64_t>(tv.tv_usec));
+
+    return std::string(buffer);
+}
+
+class RecBinaryWriter
+{
+public:
+    /* Header of a new file, the dictionary starts over */
+    const std::string &begin()
+    {
+        m_names.clear();
+        m_buf.assign(REC_BINARY_MAGIC);
+        m_buf.push_back(static_cast<char>(REC_BINARY_VERSION));
+        return m_buf;
+    }
+
+    const std::string &tuple(const struct timeval &tv, const std::string &prefix, const KeyOpFieldsValuesTuple &tuple)
+    {
+        m_buf.clear();
+
+        // Names first, the tuple refers to them
+        size_t prefixRef = intern(prefix);
+        size_t opRef = intern(kfvOp(tuple));
+        m_refs.clear();
+        for (const auto &fv : kfvFieldsValues(tuple))
+        {
+            m_refs.push_back(intern(fvField(fv)));
+        }
+
+        m_payload.clear();
+        putVarint(m_payload, static_cast<uint64_t>(tv.tv_sec));
+        putVarint(m_payload, static_cast<uint64_t>(tv.tv_usec));
+        putRef(m_payload, prefixRef, prefix);
+        putString(m_payload, kfvKey(tuple));
+        putRef(m_payload, opRef, kfvOp(tuple));
+        putVarint(m_payload, kfvFieldsValues(tuple).size());
+        size_t i = 0;
+        for (const auto &fv : kfvFieldsValues(tuple))
+        {
+            putRef(m_payload, m_refs[i++], fvField(fv));
+            putString(m_payload, fvValue(fv));
+        }
+        putRecord(REC_BIN_TUPLE, m_payload);
+
+        return m_buf;
+    }
+
+    const std::string &text(const std::string &timestamp, const std::string &text)
+    {
+        m_buf.clear();
+        m_payload.clear();
+        putString(m_payload, timestamp);
+        putString(m_payload, text);
+        putRecord(REC_BIN_TEXT, m_payload);
+        return m_buf;
+    }
+
+private:
+    /* Returns the id of name, 0 if the dictionary is full. New names go out as NAME records */
+    size_t intern(const std::string &name)
+    {
+        auto it = m_names.find(name);
+        if (it != m_names.end())
+        {
+            return it->second;
+        }
+        if (m_names.size() >= REC_BINARY_MAX_NAMES)
+        {
+            return 0;
+        }
+
+        size_t id = m_names.size() + 1;
+        m_names.emplace(name, id);
+        m_name.clear();
+        m_name.append(name);
+        putRecord(REC_BIN_NAME, m_name);
+        return id;
+    }
+
+    static void putVarint(std::string &buf, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            buf.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        buf.push_back(static_cast<char>(value));
+    }
+
+    static void putString(std::string &buf, const std::string &s)
+    {
+        putVarint(buf, s.size());
+        buf.append(s);
+    }
+
+    static void putRef(std::string &buf, size_t id, const std::string &name)
+    {
+        putVarint(buf, id);
+        if (id == 0)
+        {
+            putString(buf, name);
+        }
+    }
+
+    void putRecord(RecBinaryType type, const std::string &payload)
+    {
+        m_buf.push_back(static_cast<char>(type));
+        putVarint(m_buf, payload.size());
+        m_buf.append(payload);
+    }
+
+    std::unordered_map<std::string, size_t> m_names;
+    std::vector<size_t> m_refs;
+    std::string m_buf;
+    std::string m_payload;
+    std::string m_name;
+};
+
+class RecBinaryReader
+{
+public:
+    explicit RecBinaryReader(std::istream &is) : m_is(is)
+    {
+    }
+
+    /* False if the stream does not start with a binary record header */
+    bool begin()
+    {
+        return m_is.get() == REC_BINARY_MAGIC[0] && header();
+    }
+
+    /*
+     * Sets line to the text line of the next record. Returns false at the
+     * end of the stream or at the first malformed record.
+     */
+    bool next(std::string &line)
+    {
+        while (true)
+        {
+            int type = m_is.get();
+            if (type == REC_BINARY_MAGIC[0])
+            {
+                if (!header())
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            if (type == EOF)
+            {
+                m_complete = true;
+                return false;
+            }
+
+            uint64_t len;
+            if (!getStreamVarint(len) || len > REC_BINARY_MAX_RECORD)
+            {
+                return false;
+            }
+
+            m_payload.resize(static_cast<size_t>(len));
+            if (len && !m_is.read(&m_payload[0], static_cast<std::streamsize>(len)))
+            {
+                return false;
+            }
+
+            m_pos = m_payload.data();
+            m_end = m_payload.data() + m_payload.size();
+
+            switch (type)
+            {
+                case REC_BIN_NAME:
+                    m_names.push_back(m_payload);
+                    continue;
+                case REC_BIN_TUPLE:
+                    return parseTuple(line);
+                case REC_BIN_TEXT:
+                    return parseText(line);
+                default:
+                    continue;
+            }
+        }
+    }
+
+    /* True once next() stopped at the end of the stream rather than at a malformed record */
+    bool complete() const
+    {
+        return m_complete;
+    }
+
+private:
+    /* Rest of a header whose first byte was read, the dictionary starts over */
+    bool header()
+    {
+        // The magic without its first byte and NUL, then the version
+        char rest[sizeof(REC_BINARY_MAGIC) - 1];
+        if (!m_is.read(rest, sizeof(rest)) ||
+            memcmp(rest, REC_BINARY_MAGIC + 1, sizeof(rest) - 1) != 0 ||
+            static_cast<uint8_t>(rest[sizeof(rest) - 1]) != REC_BINARY_VERSION)
+        {
+            return false;
+        }
+
+        m_names.clear();
+        return true;
+    }
+
+    bool getStreamVarint(uint64_t &value)
+    {
+        value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            int byte = m_is.get();
+            if (byte == EOF)
+            {
+                return false;
+            }
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool getVarint(uint64_t &value)
+    {
+        value = 0;
+        for (unsigned shift = 0; m_pos < m_end && shift < 64; shift += 7)
+        {
+            auto byte = static_cast<uint8_t>(*m_pos++);
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool appendString(std::string &out)
+    {
+        uint64_t len;
+        if (!getVarint(len) || len > static_cast<uint64_t>(m_end - m_pos))
+        {
+            return false;
+        }
+        out.append(m_pos, static_cast<size_t>(len));
+        m_pos += len;
+        return true;
+    }
+
+    bool appendRef(std::string &out)
+    {
+        uint64_t id;
+        if (!getVarint(id))
+        {
+            return false;
+        }
+        if (id == 0)
+        {
+            return appendString(out);
+        }
+        if (id > m_names.size())
+        {
+            return false;
+        }
+        out.append(m_names[static_cast<size_t>(id - 1)]);
+        return true;
+    }
+
+    bool parseTuple(std::string &line)
+    {
+        uint64_t sec, usec, count;
+        if (!getVarint(sec) || !getVarint(usec))
+        {
+            return false;
+        }
+
+        struct timeval tv;
+        tv.tv_sec = static_cast<time_t>(sec);
+        tv.tv_usec = static_cast<suseconds_t>(usec);
+        line = formatRecTimestamp(tv);
+        line += "|";
+
+        if (!appendRef(line) || !appendString(line))
+        {
+            return false;
+        }
+        line += "|";
+        if (!appendRef(line) || !getVarint(count))
+        {
+            return false;
+        }
+        for (uint64_t i = 0; i < count; i++)
+        {
+            line += "|";
+            if (!appendRef(line))
+            {
+                return false;
+            }
+            line += ":";
+            if (!appendString(line))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool parseText(std::string &line)
+    {
+        line.clear();
+        if (!appendString(line))
+        {
+            return false;
+        }
+        line += "|";
+        return appendString(line);
+    }
+
+    std::istream &m_is;
+    std::vector<std::string> m_names;
+    std::string m_payload;
+    const char *m_pos = nullptr;
+    const char *m_end = nullptr;
+    bool m_complete = false;
+};
+
+}
@@ -4,6 +4,8 @@
 #include <cstring>
 #include <inttypes.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <algorithm>
 
 using namespace swss;
 
@@ -30,6 +32,22 @@ void swss::dumpAsyncSwssRecorderSignalSafeStats(int fd, int signo)
     Recorder::Instance().swss.dumpAsyncSignalSafeStats(fd, signo);
 }
 
+void swss::dumpFlightRecorders(const std::string& reason)
+{
+    auto& recorder = Recorder::Instance();
+    recorder.swss.dumpFlightRecorder(reason);
+    recorder.respub.dumpFlightRecorder(reason);
+    recorder.retry.dumpFlightRecorder(reason);
+}
+
+void swss::dumpFlightRecordersSignalSafe(int signo)
+{
+    auto& recorder = Recorder::Instance();
+    recorder.swss.dumpFlightRecorderSignalSafe(signo);
+    recorder.respub.dumpFlightRecorderSignalSafe(signo);
+    recorder.retry.dumpFlightRecorderSignalSafe(signo);
+}
+
 
 RetryRec::RetryRec() 
 {
@@ -80,6 +98,13 @@ void SwSSRec::recordTupleAsync(const std::string& prefix, const KeyOpFieldsValue
 {
     if (!m_asyncEnabled.load(std::memory_order_relaxed))
     {
+        if (m_binary)
+        {
+            struct timeval now;
+            gettimeofday(&now, nullptr);
+            recordBinary({{now, prefix, tuple}});
+            return;
+        }
         AsyncSwssRecordEntry entry = {{}, prefix, tuple};
         record(serialize(entry));
         return;
@@ -121,6 +146,18 @@ void SwSSRec::recordTuplesAsync(const std::string& prefix, const std::deque<KeyO
 {
     if (!m_asyncEnabled.load(std::memory_order_relaxed))
     {
+        if (m_binary)
+        {
+            struct timeval now;
+            gettimeofday(&now, nullptr);
+            std::deque<AsyncSwssRecordEntry> pending;
+            for (const auto& entry : entries)
+            {
+                pending.push_back({now, prefix, entry});
+            }
+            recordBinary(pending);
+            return;
+        }
         for (const auto& entry : entries)
         {
             record(serialize({{}, prefix, entry}));
@@ -268,14 +305,7 @@ void SwSSRec::onDrain()
 
 std::string SwSSRec::formatTimestamp(const struct timeval& tv) const
 {
-    char buffer[64];
-    struct tm tm_info;
-    localtime_r(&tv.tv_sec, &tm_info);
-
-    size_t size = strftime(buffer, 32, "%Y-%m-%d.%T.", &tm_info);
-    snprintf(&buffer[size], 32, "%06" PRIu64, static_cast<uint64_t>(tv.tv_usec));
-
-    return std::string(buffer);
+    return formatRecTimestamp(tv);
 }
 
 std::string SwSSRec::serialize(const AsyncSwssRecordEntry& entry) const
@@ -307,6 +337,16 @@ void SwSSRec::drain()
             pending.swap(m_queue);
         }
 
+        if (m_binary)
+        {
+            recordBinary(pending);
+            for (size_t i = 0; i < pending.size(); i++)
+            {
+                onDrain();
+            }
+            continue;
+        }
+
         for (const auto& entry : pending)
         {
             record(formatTimestamp(entry.received_time), serialize(entry));
@@ -315,6 +355,54 @@ void SwSSRec::drain()
     }
 }
 
+void SwSSRec::record(const std::string& timestamp, const std::string& val)
+{
+    // The flight recorder ring keeps text lines, a binary file needs its names from the start
+    if (!m_binary || isFlightRecorder())
+    {
+        RecWriter::record(timestamp, val);
+        return;
+    }
+
+    recordRaw([&](std::ostream& os, bool fresh) {
+        if (fresh)
+        {
+            const auto& header = m_binWriter.begin();
+            os.write(header.data(), static_cast<std::streamsize>(header.size()));
+        }
+        const auto& bin = m_binWriter.text(timestamp, val);
+        os.write(bin.data(), static_cast<std::streamsize>(bin.size()));
+        os.flush();
+    });
+}
+
+void SwSSRec::recordBinary(const std::deque<AsyncSwssRecordEntry>& entries)
+{
+    if (isFlightRecorder())
+    {
+        for (const auto& entry : entries)
+        {
+            record(formatTimestamp(entry.received_time), serialize(entry));
+        }
+        return;
+    }
+
+    // One write and flush for the whole batch
+    recordRaw([&](std::ostream& os, bool fresh) {
+        if (fresh)
+        {
+            const auto& header = m_binWriter.begin();
+            os.write(header.data(), static_cast<std::streamsize>(header.size()));
+        }
+        for (const auto& entry : entries)
+        {
+            const auto& bin = m_binWriter.tuple(entry.received_time, entry.prefix, entry.tuple);
+            os.write(bin.data(), static_cast<std::streamsize>(bin.size()));
+        }
+        os.flush();
+    });
+}
+
 size_t SwSSRec::appendLiteral(char *buffer, size_t pos, const char *text, size_t capacity)
 {
     while (*text != '\0' && pos < capacity)
@@ -388,8 +476,14 @@ void RecWriter::startRec(bool exit_if_failure)
             setRecord(false);
         }
     }
-    record_ofs << swss::getTimestamp() << Recorder::REC_START << std::endl;
-    SWSS_LOG_NOTICE("%s Recorder: Recording started at %s", getName().c_str(), fname.c_str());
+    if (isFlightRecorder())
+    {
+        m_flightFd = open(fname.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    }
+    m_fresh = true;
+    record(swss::getTimestamp(), Recorder::REC_START.substr(1));
+    SWSS_LOG_NOTICE("%s Recorder: Recording started at %s%s", getName().c_str(), fname.c_str(),
+                    isFlightRecorder() ? " in flight recorder mode" : "");
 }
 
 
@@ -399,6 +493,10 @@ RecWriter::~RecWriter()
     {
         record_ofs.close();      
     }
+    if (m_flightFd >= 0)
+    {
+        close(m_flightFd);
+    }
 }
 
 
@@ -413,14 +511,169 @@ void RecWriter::record(const std::string& timestamp, const std::string& val)
     {
         return ;
     }
+
+    std::lock_guard<std::mutex> lock(record_mutex);
     if (isRotate())
     {
         setRotate(false);
         logfileReopen();
     }
+    if (isFlightRecorder())
+    {
+        appendFlight(timestamp.data(), timestamp.size());
+        appendFlight("|", 1);
+        appendFlight(val.data(), val.size());
+        appendFlight("\n", 1);
+        return;
+    }
+    m_fresh = false;
     record_ofs << timestamp << "|" << val << std::endl;
 }
 
+void RecWriter::setFlightRecorder(size_t bytes)
+{
+    m_flight.assign(bytes, '\0');
+    m_flightHead = 0;
+    m_flightWrapped = false;
+}
+
+void RecWriter::appendFlight(const char *data, size_t len)
+{
+    // Only the tail of a record larger than the ring fits
+    if (len > m_flight.size())
+    {
+        data += len - m_flight.size();
+        len = m_flight.size();
+    }
+
+    size_t first = std::min(len, m_flight.size() - m_flightHead);
+    memcpy(&m_flight[m_flightHead], data, first);
+    memcpy(&m_flight[0], data + first, len - first);
+
+    m_flightHead += len;
+    if (m_flightHead >= m_flight.size())
+    {
+        m_flightHead -= m_flight.size();
+        m_flightWrapped = true;
+    }
+}
+
+/* Calls write(data, len) with the ring contents from the oldest complete line */
+template <typename Write>
+void RecWriter::writeFlight(Write write) const
+{
+    const char *ring = m_flight.data();
+    if (!m_flightWrapped)
+    {
+        write(ring, m_flightHead);
+        return;
+    }
+
+    // The oldest line was partly overwritten, start after its end
+    const char *older = ring + m_flightHead;
+    size_t olderLen = m_flight.size() - m_flightHead;
+    auto eol = static_cast<const char *>(memchr(older, '\n', olderLen));
+    if (eol)
+    {
+        write(eol + 1, olderLen - static_cast<size_t>(eol + 1 - older));
+        write(ring, m_flightHead);
+        return;
+    }
+
+    eol = static_cast<const char *>(memchr(ring, '\n', m_flightHead));
+    if (eol)
+    {
+        write(eol + 1, m_flightHead - static_cast<size_t>(eol + 1 - ring));
+    }
+}
+
+void RecWriter::dumpFlightRecorder(const std::string& reason)
+{
+    if (!isRecord() || !isFlightRecorder())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(record_mutex);
+    if (isRotate())
+    {
+        setRotate(false);
+        logfileReopen();
+    }
+
+    record_ofs << swss::getTimestamp() << "|flight recorder dump: " << reason << std::endl;
+    writeFlight([this](const char *data, size_t len) {
+        record_ofs.write(data, static_cast<std::streamsize>(len));
+    });
+    record_ofs.flush();
+
+    m_flightHead = 0;
+    m_flightWrapped = false;
+    SWSS_LOG_NOTICE("%s Recorder: flight recorder dumped to %s: %s", getName().c_str(), fname.c_str(), reason.c_str());
+}
+
+void RecWriter::dumpFlightRecorderSignalSafe(int signo)
+{
+    if (m_flightFd < 0 || !isFlightRecorder())
+    {
+        return;
+    }
+
+    char marker[64];
+    size_t pos = 0;
+    for (const char *text = "flight recorder dump: fatal signal "; *text; text++)
+    {
+        marker[pos++] = *text;
+    }
+    char digits[16];
+    size_t count = 0;
+    unsigned value = static_cast<unsigned>(signo);
+    do
+    {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0 && count < sizeof(digits));
+    while (count > 0)
+    {
+        marker[pos++] = digits[--count];
+    }
+    marker[pos++] = '\n';
+
+    // Best effort, a record may be half written by the thread that crashed
+    int fd = m_flightFd;
+    auto write_all = [fd](const char *data, size_t len) {
+        while (len > 0)
+        {
+            ssize_t written = write(fd, data, len);
+            if (written <= 0)
+            {
+                return;
+            }
+            data += written;
+            len -= static_cast<size_t>(written);
+        }
+    };
+    write_all(marker, pos);
+    writeFlight(write_all);
+}
+
+void RecWriter::recordRaw(const std::function<void(std::ostream& os, bool fresh)>& write)
+{
+    if (!isRecord())
+    {
+        return ;
+    }
+
+    std::lock_guard<std::mutex> lock(record_mutex);
+    if (isRotate())
+    {
+        setRotate(false);
+        logfileReopen();
+    }
+    write(record_ofs, m_fresh);
+    m_fresh = false;
+}
+
 
 void RecWriter::logfileReopen()
 {
@@ -431,6 +684,13 @@ void RecWriter::logfileReopen()
      */
     record_ofs.close();
     record_ofs.open(fname, std::ofstream::out | std::ofstream::app);
+    m_fresh = true;
+
+    if (m_flightFd >= 0)
+    {
+        close(m_flightFd);
+        m_flightFd = open(fname.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    }
 
     if (!record_ofs.is_open())
     {
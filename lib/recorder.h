@@ -6,14 +6,17 @@
 #include <sstream>
 #include <memory>
 #include <deque>
+#include <vector>
 #include <mutex>
 #include <thread>
 #include <condition_variable>
 #include <atomic>
 #include <cstdint>
+#include <functional>
 #include <sys/time.h>
 
 #include "table.h"
+#include "recbinary.h"
 
 namespace swss {
 
@@ -48,14 +51,40 @@ public:
     virtual ~RecWriter();
     void startRec(bool exit_if_failure);
     void record(const std::string& val);
-    void record(const std::string& timestamp, const std::string& val);
+    virtual void record(const std::string& timestamp, const std::string& val);
+
+    /*
+     * Flight recorder mode, set before startRec(): the records only go to a
+     * ring of the last bytes in memory, written to the file on demand.
+     */
+    void setFlightRecorder(size_t bytes);
+    bool isFlightRecorder() const { return !m_flight.empty(); }
+    /* Appends the ring to the record file after a line giving reason, then empties it */
+    void dumpFlightRecorder(const std::string& reason);
+    /* Same from a fatal signal handler, without lock nor allocation */
+    void dumpFlightRecorderSignalSafe(int signo);
 
 protected:
     void logfileReopen();
+    /* Calls write with the file under the record lock, fresh if nothing was written since it was (re)opened */
+    void recordRaw(const std::function<void(std::ostream& os, bool fresh)>& write);
 
 private:
     std::ofstream record_ofs;
     std::string fname;
+    bool m_fresh = false;
+    // Records may be written by Orchs served on worker threads
+    std::mutex record_mutex;
+
+    void appendFlight(const char *data, size_t len);
+    template <typename Write>
+    void writeFlight(Write write) const;
+
+    std::vector<char> m_flight;
+    size_t m_flightHead = 0;
+    bool m_flightWrapped = false;
+    // Raw descriptor of the record file for the fatal signal dump
+    int m_flightFd = -1;
 };
 
 class RetryRec : public RecWriter {
@@ -76,8 +105,14 @@ public:
     SwSSRec();
     ~SwSSRec() override;
 
+    using RecWriter::record;
+    void record(const std::string& timestamp, const std::string& val) override;
+
     void setAsync(bool enabled);
     bool isAsyncEnabled() const;
+    /* Writes the recbinary.h encoding instead of text lines, set before startRec() */
+    void setBinary(bool enabled) { m_binary = enabled; }
+    bool isBinary() const { return m_binary; }
     void recordTupleAsync(const std::string& prefix, const KeyOpFieldsValuesTuple& tuple);
     void recordTuplesAsync(const std::string& prefix, const std::deque<KeyOpFieldsValuesTuple>& entries);
     AsyncSwssRecorderDebugStats getAsyncDebugStats() const;
@@ -97,12 +132,15 @@ private:
     void onDrain();
     std::string formatTimestamp(const struct timeval& tv) const;
     std::string serialize(const AsyncSwssRecordEntry& entry) const;
+    void recordBinary(const std::deque<AsyncSwssRecordEntry>& entries);
     void drain();
 
     static size_t appendLiteral(char *buffer, size_t pos, const char *text, size_t capacity);
     static size_t appendUnsigned(char *buffer, size_t pos, uint64_t value, size_t capacity);
 
     std::atomic<bool> m_asyncEnabled{false};
+    bool m_binary = false;
+    RecBinaryWriter m_binWriter; // Only used under the record lock
     bool m_shutdown = false;
     bool m_workerStarted = false;
     mutable std::atomic<uint64_t> m_pendingCount{0};
@@ -148,5 +186,7 @@ public:
 
 AsyncSwssRecorderDebugStats getAsyncSwssRecorderDebugStats();
 void dumpAsyncSwssRecorderSignalSafeStats(int fd, int signo);
+void dumpFlightRecorders(const std::string& reason);
+void dumpFlightRecordersSignalSafe(int signo);
 
 }
@@ -0,0 +1,136 @@
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <system_error>
+
+#include <netlink/msg.h>
+#include <netlink/route/rtnl.h>
+
+#include "logger.h"
+#include "netdispatcher.h"
+
+#include "resyncnetlink.h"
+
+using namespace std;
+using namespace swss;
+
+ResyncNetLink::ResyncNetLink(int pri) :
+    Selectable(pri), m_socket(NULL)
+{
+    m_socket = nl_socket_alloc();
+    if (!m_socket)
+    {
+        SWSS_LOG_ERROR("Unable to allocated netlink socket");
+        throw system_error(make_error_code(errc::address_not_available),
+                           "Unable to allocated netlink socket");
+    }
+
+    nl_socket_disable_seq_check(m_socket);
+    nl_socket_modify_cb(m_socket, NL_CB_VALID, NL_CB_CUSTOM, onNetlinkMsg, this);
+    nl_socket_modify_cb(m_socket, NL_CB_FINISH, NL_CB_CUSTOM, onDumpDone, this);
+
+    int err = nl_connect(m_socket, NETLINK_ROUTE);
+    if (err < 0)
+    {
+        SWSS_LOG_ERROR("Unable to connect netlink socket: %s", nl_geterror(err));
+        nl_socket_free(m_socket);
+        m_socket = NULL;
+        throw system_error(make_error_code(errc::address_not_available),
+                           "Unable to connect netlink socket");
+    }
+
+    nl_socket_set_nonblocking(m_socket);
+
+    /* SO_RCVBUFFORCE goes over rmem_max, it needs CAP_NET_ADMIN */
+    int size = RCVBUF_SIZE;
+    if (setsockopt(nl_socket_get_fd(m_socket), SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) < 0)
+    {
+        SWSS_LOG_WARN("Unable to force the netlink receive buffer to %d bytes: %s", size, strerror(errno));
+        nl_socket_set_buffer_size(m_socket, size, 0);
+    }
+}
+
+ResyncNetLink::~ResyncNetLink()
+{
+    nl_close(m_socket);
+    nl_socket_free(m_socket);
+}
+
+void ResyncNetLink::registerGroup(int rtnlGroup)
+{
+    int err = nl_socket_add_membership(m_socket, rtnlGroup);
+    if (err < 0)
+    {
+        SWSS_LOG_ERROR("Unable to register to group %d: %s", rtnlGroup, nl_geterror(err));
+        throw system_error(make_error_code(errc::address_not_available),
+                           "Unable to register group");
+    }
+}
+
+void ResyncNetLink::dumpRequest(int rtmGetCommand)
+{
+    int err = nl_rtgen_request(m_socket, rtmGetCommand, AF_UNSPEC, NLM_F_DUMP);
+    if (err < 0)
+    {
+        SWSS_LOG_ERROR("Unable to request dump on group %d: %s", rtmGetCommand, nl_geterror(err));
+        throw system_error(make_error_code(errc::address_not_available),
+                           "Unable to request dump");
+    }
+    m_dumping = true;
+}
+
+int ResyncNetLink::getFd()
+{
+    return nl_socket_get_fd(m_socket);
+}
+
+uint64_t ResyncNetLink::readData()
+{
+    int err;
+
+    do
+    {
+        err = nl_recvmsgs_default(m_socket);
+    }
+    while (err == -NLE_INTR); // Retry if the process was interrupted by a signal
+
+    /* libnl reports ENOBUFS, the receive buffer overflow, as NLE_NOMEM */
+    if (err == -NLE_NOMEM)
+    {
+        SWSS_LOG_WARN("Netlink receive buffer overflow, events were lost");
+        m_overflow = true;
+    }
+    else if (err < 0 && err != -NLE_AGAIN)
+    {
+        SWSS_LOG_ERROR("netlink reports an error=%d on reading a netlink socket", err);
+    }
+    return 0;
+}
+
+bool ResyncNetLink::checkOverflow()
+{
+    bool overflow = m_overflow;
+    m_overflow = false;
+    return overflow;
+}
+
+bool ResyncNetLink::checkDumpDone()
+{
+    bool done = m_dumpDone;
+    m_dumpDone = false;
+    return done;
+}
+
+int ResyncNetLink::onNetlinkMsg(struct nl_msg *msg, void *arg)
+{
+    NetDispatcher::getInstance().onNetlinkMessage(msg);
+    return NL_OK;
+}
+
+int ResyncNetLink::onDumpDone(struct nl_msg *msg, void *arg)
+{
+    ResyncNetLink *netlink = static_cast<ResyncNetLink *>(arg);
+    netlink->m_dumping = false;
+    netlink->m_dumpDone = true;
+    return NL_STOP;
+}
@@ -0,0 +1,55 @@
+#ifndef __RESYNCNETLINK__
+#define __RESYNCNETLINK__
+
+#include <netlink/netlink.h>
+
+#include "selectable.h"
+
+namespace swss {
+
+/*
+ * Netlink socket of the syncd daemons which resync from a kernel dump. Unlike
+ * swss::NetLink, it reports the receive buffer overflows, the kernel table
+ * must be dumped again then since events were lost, and the end of the dumps.
+ *
+ * The messages are handed to the NetDispatcher, like swss::NetLink does.
+ */
+class ResyncNetLink : public Selectable
+{
+public:
+    /* Receive buffer of the socket, the neighbor bursts of a ToR with 50k hosts fit in it */
+    static const int RCVBUF_SIZE = 32 * 1024 * 1024;
+
+    ResyncNetLink(int pri = 0);
+    ~ResyncNetLink() override;
+
+    void registerGroup(int rtnlGroup);
+    void dumpRequest(int rtmGetCommand);
+
+    int getFd() override;
+    uint64_t readData() override;
+
+    /* Whether an overflow was seen since the last call */
+    bool checkOverflow();
+
+    /* Whether a dump ended since the last call */
+    bool checkDumpDone();
+
+    bool isDumping() const
+    {
+        return m_dumping;
+    }
+
+private:
+    static int onNetlinkMsg(struct nl_msg *msg, void *arg);
+    static int onDumpDone(struct nl_msg *msg, void *arg);
+
+    struct nl_sock *m_socket;
+    bool m_overflow = false;
+    bool m_dumping = false;
+    bool m_dumpDone = false;
+};
+
+}
+
+#endif
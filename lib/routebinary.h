@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/*
+ * Compact encoding of a ROUTE_TABLE entry, carried in the single field
+ * ROUTE_BINARY_FIELD instead of one field per route attribute.
+ *
+ * fpmsyncd writes it over the ZMQ northbound channel when
+ * ORCH_NORTHBOND_ROUTE_ZMQ_BINARY is set, RouteOrch reads it into its route
+ * request without comparing field names or splitting comma separated lists.
+ *
+ * Layout: the version byte, then one record per attribute present:
+ *   tag (1 byte) | element count (varint) | count x (length (varint) | bytes)
+ * A flag has no element, a value has one, a list has one per list item.
+ */
+#define ROUTE_BINARY_FIELD      "route_bin"
+#define ROUTE_BINARY_VERSION    1
+
+namespace swss {
+
+enum RouteBinaryTag : uint8_t
+{
+    ROUTE_BIN_PROTOCOL = 1,     // value
+    ROUTE_BIN_BLACKHOLE,        // flag
+    ROUTE_BIN_NEXTHOP_GROUP,    // value
+    ROUTE_BIN_NEXTHOP,          // list
+    ROUTE_BIN_IFNAME,           // list
+    ROUTE_BIN_MPLS_NH,          // list
+    ROUTE_BIN_WEIGHT,           // value, kept comma separated
+    ROUTE_BIN_VNI_LABEL,        // list
+    ROUTE_BIN_ROUTER_MAC,       // list
+    ROUTE_BIN_SEGMENT,          // list
+    ROUTE_BIN_SEG_SRC,          // list
+    ROUTE_BIN_VPN_SID,          // list
+    ROUTE_BIN_PIC_CONTEXT_ID,   // value
+    ROUTE_BIN_FALLBACK,         // flag
+};
+
+class RouteBinaryWriter
+{
+public:
+    RouteBinaryWriter()
+    {
+        m_buf.push_back(static_cast<char>(ROUTE_BINARY_VERSION));
+    }
+
+    void addFlag(RouteBinaryTag tag)
+    {
+        m_buf.push_back(static_cast<char>(tag));
+        putVarint(0);
+    }
+
+    /* Skipped if empty */
+    void addValue(RouteBinaryTag tag, const std::string &value)
+    {
+        if (value.empty())
+        {
+            return;
+        }
+        m_buf.push_back(static_cast<char>(tag));
+        putVarint(1);
+        putBytes(value.data(), value.size());
+    }
+
+    /*
+     * Adds the items of a comma separated list, skipped if empty. The items
+     * are the ones swss::tokenize() would give, a trailing empty item is
+     * dropped.
+     */
+    void addList(RouteBinaryTag tag, const std::string &list)
+    {
+        if (list.empty())
+        {
+            return;
+        }
+
+        size_t count = 1;
+        for (char c : list)
+        {
+            count += (c == ',');
+        }
+        if (list.back() == ',')
+        {
+            count--;
+        }
+
+        m_buf.push_back(static_cast<char>(tag));
+        putVarint(count);
+
+        const char *item = list.data();
+        const char *end = list.data() + list.size();
+        for (size_t i = 0; i < count; i++)
+        {
+            auto comma = static_cast<const char *>(memchr(item, ',', static_cast<size_t>(end - item)));
+            const char *itemEnd = comma ? comma : end;
+            putBytes(item, static_cast<size_t>(itemEnd - item));
+            item = itemEnd + 1;
+        }
+    }
+
+    const std::string &str() const
+    {
+        return m_buf;
+    }
+
+private:
+    void putVarint(size_t value)
+    {
+        while (value >= 0x80)
+        {
+            m_buf.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        m_buf.push_back(static_cast<char>(value));
+    }
+
+    void putBytes(const char *data, size_t len)
+    {
+        putVarint(len);
+        m_buf.append(data, len);
+    }
+
+    std::string m_buf;
+};
+
+/*
+ * Calls begin(tag, count) for each record, then item(tag, data, len) for
+ * each of its elements. Returns false if bin is not a valid encoding.
+ */
+template <typename Begin, typename Item>
+bool parseRouteBinary(const std::string &bin, Begin begin, Item item)
+{
+    const char *pos = bin.data();
+    const char *end = bin.data() + bin.size();
+
+    auto getVarint = [&pos, end](size_t &value)
+    {
+        value = 0;
+        for (unsigned shift = 0; pos < end && shift < 64; shift += 7)
+        {
+            auto byte = static_cast<uint8_t>(*pos++);
+            value |= static_cast<size_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (pos == end || static_cast<uint8_t>(*pos++) != ROUTE_BINARY_VERSION)
+    {
+        return false;
+    }
+
+    while (pos < end)
+    {
+        auto tag = static_cast<RouteBinaryTag>(*pos++);
+        size_t count;
+        if (!getVarint(count) || count > static_cast<size_t>(end - pos))
+        {
+            return false;
+        }
+
+        begin(tag, count);
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t len;
+            if (!getVarint(len) || len > static_cast<size_t>(end - pos))
+            {
+                return false;
+            }
+            item(tag, pos, len);
+            pos += len;
+        }
+    }
+
+    return true;
+}
+
+}
@@ -1,68 +1,176 @@
 #include <cerrno>
 #include <cstring>
 #include <cstdint>
+#include <climits>
 #include <array>
+#include <mutex>
+#include <unordered_map>
 #include <net/if.h>
 #include <stdexcept>
 #include "subintf.h"
 
 using namespace swss;
 
-subIntf::subIntf(const std::string &ifName)
+/* Above this many aliases the cache is dropped and filled again */
+#define SUB_INTF_CACHE_MAX_SIZE 16384
+
+struct subIntf::Cache
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const Parsed>> entries;
+};
+
+static bool hasPrefix(const std::string &name, size_t len, const char *prefix, size_t prefixLen)
+{
+    return prefixLen <= len && !name.compare(0, prefixLen, prefix);
+}
+
+/*
+ * Same as the uint16_t cast of stoul() on the index, the leading digits are
+ * the index and -1 is returned when there is none or they overflow.
+ */
+static int parseIdx(const std::string &subIfIdx)
 {
-    alias = ifName;
-    size_t found = alias.find(VLAN_SUB_INTERFACE_SEPARATOR);
-    if (found != std::string::npos)
+    unsigned long id = 0;
+    size_t digits = 0;
+
+    for (char c : subIfIdx)
     {
-        parentIf = alias.substr(0, found);
-        if (!parentIf.compare(0, strlen("Eth"), "Eth"))
+        if (c < '0' || c > '9')
         {
-            std::string parentIfName;
-            if (!parentIf.compare(0, strlen("Ethernet"), "Ethernet"))
-            {
-                parentIfShortName = "Eth" + parentIf.substr(strlen("Ethernet"));
-                isCompressed = false;
-                parentIfName = "Ethernet" + parentIf.substr(strlen("Ethernet"));
-            }
-            else
-            {
-                parentIfShortName = "Eth" + parentIf.substr(strlen("Eth"));
-                isCompressed = true;
-                parentIfName = "Ethernet" + parentIf.substr(strlen("Eth"));
-            }
-            parentIf = parentIfName;
-            subIfIdx = alias.substr(found + 1);
+            break;
         }
-        else if (!parentIf.compare(0, strlen("Po"), "Po"))
+
+        unsigned long d = static_cast<unsigned long>(c - '0');
+        if (id > (ULONG_MAX - d) / 10)
         {
-            if (!parentIf.compare(0, strlen("PortChannel"), "PortChannel"))
-            {
-                isCompressed = false;
-                parentIfShortName = "Po" + parentIf.substr(strlen("PortChannel"));
-                parentIf = "PortChannel" + parentIf.substr(strlen("PortChannel"));
-            }
-            else
-            {
-                isCompressed = true;
-                parentIfShortName = "Po" + parentIf.substr(strlen("Po"));
-                parentIf = "PortChannel" + parentIf.substr(strlen("Po"));
-            }
-            subIfIdx = alias.substr(found + 1);
+            return -1;
         }
-        else
+        id = id * 10 + d;
+        digits++;
+    }
+
+    if (digits == 0)
+    {
+        return -1;
+    }
+
+    return static_cast<uint16_t>(id);
+}
+
+subIntf::subIntf(const std::string &ifName) : m_parsed(lookup(ifName))
+{
+}
+
+subIntf::Cache &subIntf::cache()
+{
+    static Cache c;
+    return c;
+}
+
+std::shared_ptr<const subIntf::Parsed> subIntf::lookup(const std::string &ifName)
+{
+    auto &c = cache();
+
+    {
+        std::lock_guard<std::mutex> lock(c.mutex);
+        auto it = c.entries.find(ifName);
+        if (it != c.entries.end())
         {
-            subIfIdx = "";
+            return it->second;
         }
     }
+
+    // Parse outside of the lock, a concurrent parse of the same alias is harmless
+    auto parsed = parse(ifName);
+
+    std::lock_guard<std::mutex> lock(c.mutex);
+    if (c.entries.size() >= SUB_INTF_CACHE_MAX_SIZE)
+    {
+        c.entries.clear();
+    }
+    return c.entries.emplace(ifName, parsed).first->second;
+}
+
+std::shared_ptr<const subIntf::Parsed> subIntf::parse(const std::string &ifName)
+{
+    auto p = std::make_shared<Parsed>();
+    p->alias = ifName;
+
+    size_t found = ifName.find(VLAN_SUB_INTERFACE_SEPARATOR);
+    if (found == std::string::npos)
+    {
+        return p;
+    }
+
+    static const char eth[] = "Eth";
+    static const char ethernet[] = "Ethernet";
+    static const char po[] = "Po";
+    static const char portChannel[] = "PortChannel";
+
+    size_t prefixLen;
+    if (hasPrefix(ifName, found, ethernet, strlen(ethernet)))
+    {
+        prefixLen = strlen(ethernet);
+        p->isCompressed = false;
+    }
+    else if (hasPrefix(ifName, found, eth, strlen(eth)))
+    {
+        prefixLen = strlen(eth);
+        p->isCompressed = true;
+    }
+    else if (hasPrefix(ifName, found, portChannel, strlen(portChannel)))
+    {
+        prefixLen = strlen(portChannel);
+        p->isCompressed = false;
+    }
+    else if (hasPrefix(ifName, found, po, strlen(po)))
+    {
+        prefixLen = strlen(po);
+        p->isCompressed = true;
+    }
+    else
+    {
+        p->parentIf = ifName.substr(0, found);
+        return p;
+    }
+
+    bool isEth = ifName[0] == 'E';
+    const char *longPrefix = isEth ? ethernet : portChannel;
+    const char *shortPrefix = isEth ? eth : po;
+    size_t suffixLen = found - prefixLen;
+
+    p->parentIf.reserve(strlen(longPrefix) + suffixLen);
+    p->parentIf.append(longPrefix).append(ifName, prefixLen, suffixLen);
+    p->parentIfShortName.reserve(strlen(shortPrefix) + suffixLen);
+    p->parentIfShortName.append(shortPrefix).append(ifName, prefixLen, suffixLen);
+    p->subIfIdx = ifName.substr(found + 1);
+    p->idx = parseIdx(p->subIfIdx);
+
+    return p;
+}
+
+void subIntf::clearCache()
+{
+    auto &c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    c.entries.clear();
+}
+
+size_t subIntf::cacheSize()
+{
+    auto &c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    return c.entries.size();
 }
 
 bool subIntf::isValid() const
 {
-    if (subIfIdx == "")
+    if (m_parsed->subIfIdx.empty())
     {
         return false;
     }
-    else if (alias.length() >= IFNAMSIZ)
+    else if (m_parsed->alias.length() >= IFNAMSIZ)
     {
         return false;
     }
@@ -72,25 +180,12 @@ bool subIntf::isValid() const
 
 std::string subIntf::parentIntf() const
 {
-    return parentIf;
+    return m_parsed->parentIf;
 }
 
 int subIntf::subIntfIdx() const
 {
-    uint16_t id;
-    try
-    {
-        id = static_cast<uint16_t>(stoul(subIfIdx));
-    }
-    catch (const std::invalid_argument &e)
-    {
-        return -1;
-    }
-    catch (const std::out_of_range &e)
-    {
-        return -1;
-    }
-    return id;
+    return m_parsed->idx;
 }
 
 std::string subIntf::longName() const
@@ -98,7 +193,7 @@ std::string subIntf::longName() const
     if (isValid() == false)
         return "";
 
-    return (parentIf + VLAN_SUB_INTERFACE_SEPARATOR + subIfIdx);
+    return (m_parsed->parentIf + VLAN_SUB_INTERFACE_SEPARATOR + m_parsed->subIfIdx);
 }
 
 std::string subIntf::shortName() const
@@ -106,10 +201,10 @@ std::string subIntf::shortName() const
     if (isValid() == false)
         return "";
 
-    return (parentIfShortName + VLAN_SUB_INTERFACE_SEPARATOR + subIfIdx);
+    return (m_parsed->parentIfShortName + VLAN_SUB_INTERFACE_SEPARATOR + m_parsed->subIfIdx);
 }
 
 bool subIntf::isShortName() const
 {
-    return ((isCompressed == true) ? true : false);
+    return m_parsed->isCompressed;
 }
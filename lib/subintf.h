@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #define VLAN_SUB_INTERFACE_SEPARATOR   "."
@@ -15,11 +16,32 @@ namespace swss {
 			std::string shortName() const;
 			bool isShortName() const;
 
-        private:
-			std::string alias;
-			std::string subIfIdx;
-			std::string parentIf;
-			std::string parentIfShortName;
-			bool isCompressed = false;
+			/* Drop the cached parse results, the next lookups parse again */
+			static void clearCache();
+			static size_t cacheSize();
+
+		private:
+			/*
+			 * Parse result of one alias. The results are interned in a process
+			 * wide cache keyed by alias and shared by every subIntf of that alias,
+			 * so the same name is parsed once however often it is looked up.
+			 */
+			struct Parsed
+			{
+				std::string alias;
+				std::string subIfIdx;
+				std::string parentIf;
+				std::string parentIfShortName;
+				bool isCompressed = false;
+				int idx = -1;
+			};
+
+			struct Cache;
+
+			static Cache &cache();
+			static std::shared_ptr<const Parsed> parse(const std::string &ifName);
+			static std::shared_ptr<const Parsed> lookup(const std::string &ifName);
+
+			std::shared_ptr<const Parsed> m_parsed;
 	};
 }
@@ -39,6 +39,7 @@
 #include <iostream>
 #include <sstream>
 #include "table.h"
+#include "lib/orch_zmq_config.h"
 
 using namespace swss;
 using namespace std;
@@ -61,12 +62,27 @@ void MclagLink::delVlanMbr(std::string vlan, std::string mbr_port)
 }
 
 
+/* Ports and bridge ports come and go with VLAN membership */
+void MclagLink::invalidateOidMaps()
+{
+    m_oid_to_port_name_valid = false;
+    m_bridge_port_to_port_id_valid = false;
+}
+
 void MclagLink::getOidToPortNameMap(std::unordered_map<std::string, std:: string> & port_map)
 {
-    auto hash = p_counters_db->hgetall("COUNTERS_PORT_NAME_MAP");
+    if (!m_oid_to_port_name_valid)
+    {
+        auto hash = p_counters_db->hgetall("COUNTERS_PORT_NAME_MAP");
 
-    for (auto it = hash.begin(); it != hash.end(); ++it)
-        port_map.insert(pair<string, string>(it->second, it->first));
+        m_oid_to_port_name.clear();
+        for (auto it = hash.begin(); it != hash.end(); ++it)
+            m_oid_to_port_name.insert(pair<string, string>(it->second, it->first));
+
+        m_oid_to_port_name_valid = true;
+    }
+
+    port_map.insert(m_oid_to_port_name.begin(), m_oid_to_port_name.end());
 
     return;
 }
@@ -76,8 +92,15 @@ void MclagLink::getBridgePortIdToAttrPortIdMap(std::map<std::string, std:: strin
     std::string bridge_port_id;
     size_t pos1 = 0;
 
+    if (m_bridge_port_to_port_id_valid)
+    {
+        oid_map->insert(m_bridge_port_to_port_id.begin(), m_bridge_port_to_port_id.end());
+        return;
+    }
+
     auto keys = p_asic_db->keys("ASIC_STATE:SAI_OBJECT_TYPE_BRIDGE_PORT:*");
 
+    m_bridge_port_to_port_id.clear();
     for (auto& key : keys)
     {
         pos1 = key.find("oid:", 0);
@@ -92,9 +115,12 @@ void MclagLink::getBridgePortIdToAttrPortIdMap(std::map<std::string, std:: strin
                 continue;
         }
 
-        oid_map->insert(pair<string, string>(bridge_port_id, attr_port_id->second));
+        m_bridge_port_to_port_id.insert(pair<string, string>(bridge_port_id, attr_port_id->second));
     }
 
+    m_bridge_port_to_port_id_valid = true;
+    oid_map->insert(m_bridge_port_to_port_id.begin(), m_bridge_port_to_port_id.end());
+
     return;
 }
 
@@ -424,6 +450,9 @@ void MclagLink::setFdbFlush()
 
     vector<FieldValueTuple> values;
 
+    /* The MCLAG FDB entries received before the flush go first */
+    flush();
+
     SWSS_LOG_NOTICE("send fdb flush notification");
 
     flushFdb.send("ALL", "ALL", values);
@@ -462,61 +491,62 @@ void MclagLink::setIntfMac(char *msg)
     return;
 }
 
+/* The entries are read in place from the ICCPd message, the writes are
+ * buffered until the next flush() */
 void MclagLink::setFdbEntry(char *msg, int msg_len)
 {
-    struct mclag_fdb_info * fdb_info = NULL;
-    struct mclag_fdb fdb;
+    const struct mclag_fdb_info *fdb_info = NULL;
+    const char *type = NULL;
     string fdb_key;
-    char key[64] = { 0 };
-    char *cur = NULL;
-    short count = 0;
-    int index = 0;
+    vector<FieldValueTuple> attrs;
+    size_t count = 0;
+    size_t index = 0;
 
-    cur = msg;           
-    count = (short)(msg_len/sizeof(struct mclag_fdb_info));
+    count = (size_t)msg_len / sizeof(struct mclag_fdb_info);
 
-    for (index =0; index < count; index ++)
+    for (index = 0; index < count; index++)
     {
-        memset(key, 0, 64);
+        fdb_info = reinterpret_cast<const struct mclag_fdb_info *>(
+                static_cast<const void *>(msg + index * sizeof(struct mclag_fdb_info)));
 
-        fdb_info = reinterpret_cast<struct mclag_fdb_info *>(static_cast<void *>(cur + index * sizeof(struct mclag_fdb_info)));
-
-        fdb.mac  = MacAddress::to_string(fdb_info->mac);
-        fdb.port_name = fdb_info->port_name;
-        fdb.vid = fdb_info->vid;
         if (fdb_info->type == MCLAG_FDB_TYPE_STATIC)
-            fdb.type = "static";
+            type = "static";
         else if (fdb_info->type == MCLAG_FDB_TYPE_DYNAMIC)
-            fdb.type = "dynamic";
+            type = "dynamic";
         else if (fdb_info->type == MCLAG_FDB_TYPE_DYNAMIC_LOCAL)
-            fdb.type = "dynamic_local";
+            type = "dynamic_local";
+        else
+            type = "";
 
-        snprintf(key, 64, "%s%d:%s", "Vlan", fdb_info->vid, fdb.mac.c_str());
-        fdb_key = key;
+        fdb_key = "Vlan" + to_string(fdb_info->vid) + ":" + MacAddress::to_string(fdb_info->mac);
 
-        SWSS_LOG_DEBUG("Received MAC key: %s, op_type: %d, mac type: %s , port: %s",
-                fdb_key.c_str(), fdb_info->op_type, fdb.type.c_str(), fdb.port_name.c_str());
+        SWSS_LOG_DEBUG("Received MAC key: %s, op_type: %d, mac type: %s , port: %.*s",
+                fdb_key.c_str(), fdb_info->op_type, type,
+                (int)sizeof(fdb_info->port_name), fdb_info->port_name);
 
         if (fdb_info->op_type == MCLAG_FDB_OPER_ADD)
         {
-            vector<FieldValueTuple> attrs;
+            attrs.clear();
 
             /*set port attr*/
-            FieldValueTuple port_attr("port", fdb.port_name);
-            attrs.push_back(port_attr);
+            attrs.emplace_back("port", string(fdb_info->port_name,
+                    strnlen(fdb_info->port_name, sizeof(fdb_info->port_name))));
 
             /*set type attr*/
-            FieldValueTuple type_attr("type", fdb.type);
-            attrs.push_back(type_attr);
+            attrs.emplace_back("type", type);
             p_fdb_tbl->set(fdb_key, attrs);
-            SWSS_LOG_NOTICE("add fdb entry into ASIC_DB:key =%s, type =%s", fdb_key.c_str(),  fdb.type.c_str());
+            SWSS_LOG_INFO("add fdb entry into ASIC_DB:key =%s, type =%s", fdb_key.c_str(), type);
         }
         else if (fdb_info->op_type == MCLAG_FDB_OPER_DEL)
         {
             p_fdb_tbl->del(fdb_key);
-            SWSS_LOG_NOTICE("del fdb entry from ASIC_DB:key =%s", fdb_key.c_str());
+            SWSS_LOG_INFO("del fdb entry from ASIC_DB:key =%s", fdb_key.c_str());
         }
     }
+
+    if (count)
+        SWSS_LOG_NOTICE("Received %zu MCLAG FDB entries", count);
+
     return;
 }
 
@@ -536,33 +566,35 @@ void MclagLink::mclagsyncdSendFdbEntries(std::deque<KeyOpFieldsValuesTuple> &ent
         return;
     }
 
-    for (auto entry: entries)
+    for (const auto &entry: entries)
     {
         memset(&info, 0, sizeof(struct mclag_fdb_info));
         count++;
-        std::string key = kfvKey(entry);
-        std::string op = kfvOp(entry);
+        const std::string &key = kfvKey(entry);
+        const std::string &op = kfvOp(entry);
 
         std::size_t delimiter = key.find_first_of(":");
-        auto vlan_name = key.substr(0, delimiter);
-        const auto mac_address_str = key.substr(delimiter+1);
-        uint8_t mac_address[ETHER_ADDR_LEN];
-
-        MacAddress::parseMacString(mac_address_str, mac_address);
+        if (delimiter == std::string::npos || delimiter <= 4 ||
+            !MacAddress::parseMacString(key.substr(delimiter+1), info.mac))
+        {
+            SWSS_LOG_ERROR("MCLAGSYNCD STATE FDB updates, invalid key %s", key.c_str());
+            continue;
+        }
 
-        info.vid = (unsigned int) stoi(vlan_name.substr(4));
-        memcpy(info.mac, mac_address , ETHER_ADDR_LEN);
+        /* Key is Vlan<vid>:<mac> */
+        info.vid = (unsigned int) strtoul(key.c_str() + 4, NULL, 10);
 
         if (op == "SET")
             info.op_type = MCLAG_FDB_OPER_ADD;
         else
             info.op_type = MCLAG_FDB_OPER_DEL;
 
-        for (auto i : kfvFieldsValues(entry))
+        for (const auto &i : kfvFieldsValues(entry))
         {
             if (fvField(i) == "port")
             {
-                memcpy(info.port_name, fvValue(i).c_str(), fvValue(i).length());
+                memcpy(info.port_name, fvValue(i).c_str(),
+                       min(fvValue(i).length(), sizeof(info.port_name) - 1));
             }
             if (fvField(i) == "type")
             {
@@ -574,7 +606,7 @@ void MclagLink::mclagsyncdSendFdbEntries(std::deque<KeyOpFieldsValuesTuple> &ent
                     SWSS_LOG_ERROR("MCLAGSYNCD STATE FDB updates key=%s, invalid MAC type %s\n", key.c_str(), fvValue(i).c_str());
             }
         }
-        SWSS_LOG_NOTICE("MCLAGSYNCD STATE FDB updates key=%s, operation=%s, type: %d, port: %s \n",
+        SWSS_LOG_INFO("MCLAGSYNCD STATE FDB updates key=%s, operation=%s, type: %d, port: %s \n",
                 key.c_str(), op.c_str(), info.type, info.port_name);
 
         if (MCLAG_MAX_SEND_MSG_LEN - infor_len < sizeof(struct mclag_fdb_info))
@@ -1481,6 +1513,12 @@ void MclagLink::processStateVlanMember(SubscriberStateTable *stateVlanMemberTbl)
     std::deque<KeyOpFieldsValuesTuple> entries;
     stateVlanMemberTbl->pops(entries);
     processVlanMemberTableUpdates(entries);
+    invalidateOidMaps();
+}
+
+void MclagLink::flush()
+{
+    p_appl_pipeline->flush();
 }
 
 /* Delete Mlag entry in the STATE_MCLAG_TABLE */
@@ -1807,12 +1845,16 @@ MclagLink::MclagLink(Select *select, int port) :
     p_mclag_remote_intf_tbl        = unique_ptr<Table>(new Table(p_state_db.get(), STATE_MCLAG_REMOTE_INTF_TABLE_NAME));
 
 
-    p_intf_tbl      = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_INTF_TABLE_NAME));
+    p_appl_pipeline = unique_ptr<RedisPipeline>(new RedisPipeline(p_appl_db.get()));
+
+    p_intf_zmq_client = create_local_zmq_client(ORCH_NORTHBOND_INTF_ZMQ_ENABLED, false);
+    p_intf_tbl      = createProducerStateTable(p_appl_db.get(), APP_INTF_TABLE_NAME, p_intf_zmq_client);
     p_iso_grp_tbl   = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_ISOLATION_GROUP_TABLE_NAME));
-    p_fdb_tbl       = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_MCLAG_FDB_TABLE_NAME));
+    p_fdb_tbl       = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_pipeline.get(), APP_MCLAG_FDB_TABLE_NAME, true));
     p_acl_table_tbl = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_ACL_TABLE_TABLE_NAME));
     p_acl_rule_tbl  = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_ACL_RULE_TABLE_NAME));
-    p_lag_tbl       = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_LAG_TABLE_NAME));
+    p_lag_zmq_client = create_local_zmq_client(ORCH_NORTHBOND_LAG_ZMQ_ENABLED, false);
+    p_lag_tbl       = createProducerStateTable(p_appl_db.get(), APP_LAG_TABLE_NAME, p_lag_zmq_client);
     p_port_tbl      = unique_ptr<ProducerStateTable>(new ProducerStateTable(p_appl_db.get(), APP_PORT_TABLE_NAME));
 
     p_state_fdb_tbl                   = NULL;
@@ -33,6 +33,7 @@
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <memory>
 #include <net/ethernet.h>
 
@@ -43,6 +44,7 @@
 #include "mclagsyncd/mclag.h"
 #include "notificationconsumer.h"
 #include "notificationproducer.h"
+#include "zmqclient.h"
 
 
 #ifndef INET_ADDRSTRLEN
@@ -221,6 +223,7 @@ namespace swss {
             unique_ptr<DBConnector> p_asic_db;
             unique_ptr<DBConnector> p_counters_db;
             unique_ptr<DBConnector> p_notificationsDb;
+            unique_ptr<RedisPipeline> p_appl_pipeline;
 
             unique_ptr<Table> p_mclag_tbl;
             unique_ptr<Table> p_mclag_local_intf_tbl;
@@ -229,11 +232,14 @@ namespace swss {
             unique_ptr<Table> p_mclag_cfg_table;
             unique_ptr<Table> p_mclag_intf_cfg_table;
 
+            shared_ptr<ZmqClient> p_intf_zmq_client;
+            shared_ptr<ZmqClient> p_lag_zmq_client;
+
             unique_ptr<ProducerStateTable> p_port_tbl;
-            unique_ptr<ProducerStateTable> p_intf_tbl;
+            shared_ptr<ProducerStateTable> p_intf_tbl;
             unique_ptr<ProducerStateTable> p_acl_table_tbl;
             unique_ptr<ProducerStateTable> p_acl_rule_tbl;
-            unique_ptr<ProducerStateTable> p_lag_tbl;
+            shared_ptr<ProducerStateTable> p_lag_tbl;
             unique_ptr<ProducerStateTable> p_iso_grp_tbl;
             unique_ptr<ProducerStateTable> p_fdb_tbl;
 
@@ -245,6 +251,12 @@ namespace swss {
 
             std::map<mclagDomainEntry, mclagDomainData> m_mclag_domains;
 
+            /* COUNTERS_DB and ASIC_DB OID maps, read again after invalidateOidMaps() */
+            std::unordered_map<std::string, std::string> m_oid_to_port_name;
+            std::map<std::string, std::string> m_bridge_port_to_port_id;
+            bool m_oid_to_port_name_valid = false;
+            bool m_bridge_port_to_port_id_valid = false;
+
 
             int getFd() override;
             char* getSendMsgBuffer();
@@ -269,6 +281,7 @@ namespace swss {
 
             void delDomainCfgDependentSelectables();
 
+            void invalidateOidMaps();
             void getOidToPortNameMap(std::unordered_map<std::string, std:: string> & port_map);
             void getBridgePortIdToAttrPortIdMap(std::map<std::string, std:: string> *oid_map);
             void getVidByBvid(std::string &bvid, std::string &vlanid);
@@ -305,6 +318,9 @@ namespace swss {
             void mclagsyncdFetchMclagConfigFromConfigdb();
             void mclagsyncdFetchMclagInterfaceConfigFromConfigdb();
 
+            /* Send the buffered MCLAG_FDB_TABLE writes */
+            void flush();
+
             SubscriberStateTable *getStateFdbTable()
             {
                 return p_state_fdb_tbl;
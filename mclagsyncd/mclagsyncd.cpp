@@ -107,6 +107,9 @@ int main(int argc, char **argv)
                     pipeline.flush();
                     SWSS_LOG_DEBUG("Pipeline flushed");
                 }
+
+                /* The MCLAG FDB entries of an ICCPd read go together */
+                mclag.flush();
             }
         }
         catch (MclagLink::MclagConnectionClosedException &e)
@@ -15,6 +15,7 @@
  */
 
 #include <string>
+#include <inttypes.h>
 #include <netinet/in.h>
 #include <netlink/netfilter/ct.h>
 #include <netlink/utils.h>
@@ -38,10 +39,10 @@ using namespace swss;
 #define CT_UDP_EXPIRY_TIMEOUT   600 /* Max conntrack timeout in the user configurable range */
 
 NatSync::NatSync(RedisPipeline *pipelineAppDB, DBConnector *appDb, DBConnector *stateDb, NfNetlink *nfnl) :
-    m_natTable(appDb, APP_NAT_TABLE_NAME),
-    m_naptTable(appDb, APP_NAPT_TABLE_NAME),
-    m_natTwiceTable(appDb, APP_NAT_TWICE_TABLE_NAME),
-    m_naptTwiceTable(appDb, APP_NAPT_TWICE_TABLE_NAME),
+    m_natTable(pipelineAppDB, APP_NAT_TABLE_NAME, true),
+    m_naptTable(pipelineAppDB, APP_NAPT_TABLE_NAME, true),
+    m_natTwiceTable(pipelineAppDB, APP_NAT_TWICE_TABLE_NAME, true),
+    m_naptTwiceTable(pipelineAppDB, APP_NAPT_TWICE_TABLE_NAME, true),
     m_natCheckTable(appDb, APP_NAT_TABLE_NAME),
     m_naptCheckTable(appDb, APP_NAPT_TABLE_NAME),
     m_twiceNatCheckTable(appDb, APP_NAT_TWICE_TABLE_NAME),
@@ -50,6 +51,7 @@ NatSync::NatSync(RedisPipeline *pipelineAppDB, DBConnector *appDb, DBConnector *
     m_stateNatRestoreTable(stateDb, STATE_NAT_RESTORE_TABLE_NAME)
 {
     nfsock = nfnl;
+    m_pipeline = pipelineAppDB;
 
     m_AppRestartAssist = new AppRestartAssist(pipelineAppDB, "natsyncd", "nat", DEFAULT_NATSYNC_WARMSTART_TIMER);
     if (m_AppRestartAssist)
@@ -319,7 +321,7 @@ bool NatSync::matchingSnaptEntryExists(const naptEntry &entry)
     string reverseEntryKey = entry.nat_src_ip.to_string() + ":" + to_string(entry.nat_src_l4_port);
     std::vector<FieldValueTuple> values;
 
-    if (m_naptCheckTable.get(key, values) || m_naptCheckTable.get(reverseEntryKey, values))
+    if (getNatEntry(m_naptCheckTable, key, values, true) || getNatEntry(m_naptCheckTable, reverseEntryKey, values, true))
     {
         SWSS_LOG_INFO("Matching SNAPT entry exists for key %s or reverse key %s",
                        key.c_str(), reverseEntryKey.c_str());
@@ -334,7 +336,7 @@ bool NatSync::matchingDnaptEntryExists(const naptEntry &entry)
     string reverseEntryKey = entry.nat_dest_ip.to_string() + ":" + to_string(entry.nat_dst_l4_port);
     std::vector<FieldValueTuple> values;
 
-    if (m_naptCheckTable.get(key, values) || m_naptCheckTable.get(reverseEntryKey, values))
+    if (getNatEntry(m_naptCheckTable, key, values, true) || getNatEntry(m_naptCheckTable, reverseEntryKey, values, true))
     {
         SWSS_LOG_INFO("Matching DNAPT entry exists for key %s or reverse key %s",
                        key.c_str(), reverseEntryKey.c_str());
@@ -401,7 +403,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
         string tmpReverseEntryKey = reverseEntryKey + entry.nat_dest_ip.to_string() + ":" + entry.nat_src_ip.to_string();
 
         std::vector<FieldValueTuple> values;
-        if (m_twiceNatCheckTable.get(tmpKey, values))
+        if (getNatEntry(m_twiceNatCheckTable, tmpKey, values, addFlag))
         {
             src_port_natted = dst_port_natted = false;
 
@@ -449,7 +451,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
             std::vector<FieldValueTuple> values;
             /* If a matching Static Twice NAPT entry exists in the APP_DB,
              * it has higher priority than the dynamic twice napt entry. */
-            if (m_twiceNaptCheckTable.get(key, values))
+            if (getNatEntry(m_twiceNaptCheckTable, key, values, addFlag))
             {
                 for (auto iter : values)
                 {
@@ -490,10 +492,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_naptTwiceTable.set(key, fvVector);
+                    setNatEntry(m_naptTwiceTable, key, fvVector);
                     SWSS_LOG_NOTICE("Twice NAPT entry with key %s added to APP_DB", key.c_str());
-                    setTimeoutNotifier->send("SET-TWICE-NAPT", key, fvVector);
-                    m_naptTwiceTable.set(reverseEntryKey, reverseFvVector);
+                    sendTimeoutNotification("SET-TWICE-NAPT", key, fvVector);
+                    setNatEntry(m_naptTwiceTable, reverseEntryKey, reverseFvVector);
                     SWSS_LOG_NOTICE("Twice NAPT entry with reverse key %s added to APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -506,9 +508,9 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_naptTwiceTable.del(key);
+                    delNatEntry(m_naptTwiceTable, key);
                     SWSS_LOG_NOTICE("Twice NAPT entry with key %s deleted from APP_DB", key.c_str());
-                    m_naptTwiceTable.del(reverseEntryKey);
+                    delNatEntry(m_naptTwiceTable, reverseEntryKey);
                     SWSS_LOG_NOTICE("Twice NAPT entry with reverse key %s deleted from APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -531,10 +533,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_natTwiceTable.set(key, fvVector);
+                    setNatEntry(m_natTwiceTable, key, fvVector);
                     SWSS_LOG_NOTICE("Twice NAT entry with key %s added to APP_DB", key.c_str());
-                    setTimeoutNotifier->send("SET-TWICE-NAT", key, fvVector);
-                    m_natTwiceTable.set(reverseEntryKey, reverseFvVector);
+                    sendTimeoutNotification("SET-TWICE-NAT", key, fvVector);
+                    setNatEntry(m_natTwiceTable, reverseEntryKey, reverseFvVector);
                     SWSS_LOG_NOTICE("Twice NAT entry with reverse key %s added to APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -547,9 +549,9 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 }
                 else
                 {
-                    m_natTwiceTable.del(key);
+                    delNatEntry(m_natTwiceTable, key);
                     SWSS_LOG_NOTICE("Twice NAT entry with key %s deleted from APP_DB", key.c_str());
-                    m_natTwiceTable.del(reverseEntryKey);
+                    delNatEntry(m_natTwiceTable, reverseEntryKey);
                     SWSS_LOG_NOTICE("Twice NAT entry with reverse key %s deleted from APP_DB", reverseEntryKey.c_str());
                 }
             }
@@ -593,7 +595,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                  * is matched by the iptables rules corresponding to the dnat static entry */
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_naptCheckTable.get(key, values)))
+                    if ((entryExists = getNatEntry(m_naptCheckTable, key, values, addFlag)))
                     {
                         for (auto iter : values)
                         {
@@ -621,12 +623,12 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_naptTable.del(key);
+                                delNatEntry(m_naptTable, key);
                                 SWSS_LOG_NOTICE("SNAPT entry with key %s deleted from APP_DB", key.c_str());
                             }
                         }
                     }
-                    if ((reverseEntryExists = m_naptCheckTable.get(reverseEntryKey, values)))
+                    if ((reverseEntryExists = getNatEntry(m_naptCheckTable, reverseEntryKey, values, addFlag)))
                     {
                         for (auto iter : values)
                         {
@@ -654,7 +656,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_naptTable.del(reverseEntryKey);
+                                delNatEntry(m_naptTable, reverseEntryKey);
                                 SWSS_LOG_NOTICE("Implicit DNAPT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                             }
                         }
@@ -684,10 +686,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_naptTable.set(key, fvVector);
+                            setNatEntry(m_naptTable, key, fvVector);
                             SWSS_LOG_NOTICE("SNAPT entry with key %s added to APP_DB", key.c_str());
-                            setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
-                            m_naptTable.set(reverseEntryKey, reverseFvVector);
+                            sendTimeoutNotification("SET-SINGLE-NAPT", key, fvVector);
+                            setNatEntry(m_naptTable, reverseEntryKey, reverseFvVector);
                             SWSS_LOG_NOTICE("Implicit DNAPT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -704,7 +706,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 std::vector<FieldValueTuple> values;
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_natCheckTable.get(key, values)))
+                    if ((entryExists = getNatEntry(m_natCheckTable, key, values, addFlag)))
                     {
                         for (auto iter : values)
                         {
@@ -732,12 +734,12 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_natTable.del(key);
+                                delNatEntry(m_natTable, key);
                                 SWSS_LOG_NOTICE("SNAT entry with key %s deleted from APP_DB", key.c_str());
                             }
                         }
                     }
-                    if ((reverseEntryExists = m_natCheckTable.get(reverseEntryKey, values)))
+                    if ((reverseEntryExists = getNatEntry(m_natCheckTable, reverseEntryKey, values, addFlag)))
                     {
                         for (auto iter : values)
                         {
@@ -765,7 +767,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                             }
                             else
                             {
-                                m_natTable.del(reverseEntryKey);
+                                delNatEntry(m_natTable, reverseEntryKey);
                                 SWSS_LOG_NOTICE("Implicit DNAT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                             }
                         }
@@ -789,10 +791,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_natTable.set(key, fvVector);
+                            setNatEntry(m_natTable, key, fvVector);
                             SWSS_LOG_NOTICE("SNAT entry with key %s added to APP_DB", key.c_str());
-                            setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
-                            m_natTable.set(reverseEntryKey, reverseFvVector);
+                            sendTimeoutNotification("SET-SINGLE-NAT", key, fvVector);
+                            setNatEntry(m_natTable, reverseEntryKey, reverseFvVector);
                             SWSS_LOG_NOTICE("Implicit DNAT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -832,7 +834,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 std::vector<FieldValueTuple> values;
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_naptCheckTable.get(key, values)))
+                    if ((entryExists = getNatEntry(m_naptCheckTable, key, values, addFlag)))
                     {
                         for (auto iter : values)
                         {
@@ -851,11 +853,11 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_naptTable.del(key);
+                            delNatEntry(m_naptTable, key);
                             SWSS_LOG_NOTICE("DNAPT entry with key %s deleted from APP_DB", key.c_str());
                         }
                      }
-                     if ((reverseEntryExists = m_naptCheckTable.get(reverseEntryKey, values)))
+                     if ((reverseEntryExists = getNatEntry(m_naptCheckTable, reverseEntryKey, values, addFlag)))
                      {
                         for (auto iter : values)
                         {
@@ -874,7 +876,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         {
-                            m_naptTable.del(reverseEntryKey);
+                            delNatEntry(m_naptTable, reverseEntryKey);
                             SWSS_LOG_NOTICE("Implicit SNAPT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -894,10 +896,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                     }
                     else
                     {
-                        m_naptTable.set(key, fvVector);
+                        setNatEntry(m_naptTable, key, fvVector);
                         SWSS_LOG_NOTICE("DNAPT entry with key %s added to APP_DB", key.c_str());
-                        setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
-                        m_naptTable.set(reverseEntryKey, reverseFvVector);
+                        sendTimeoutNotification("SET-SINGLE-NAPT", key, fvVector);
+                        setNatEntry(m_naptTable, reverseEntryKey, reverseFvVector);
                         SWSS_LOG_NOTICE("Implicit SNAPT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                     }
                 }
@@ -912,7 +914,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                 std::vector<FieldValueTuple> values;
                 if (! m_AppRestartAssist->isWarmStartInProgress())
                 {
-                    if ((entryExists = m_natCheckTable.get(key, values)))
+                    if ((entryExists = getNatEntry(m_natCheckTable, key, values, addFlag)))
                     {
                         for (auto iter : values)
                         {
@@ -931,11 +933,11 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         { 
-                            m_natTable.del(key);
+                            delNatEntry(m_natTable, key);
                             SWSS_LOG_NOTICE("DNAT entry with key %s deleted from APP_DB", key.c_str());
                         }
                     }
-                    if ((reverseEntryExists = m_natCheckTable.get(reverseEntryKey, values)))
+                    if ((reverseEntryExists = getNatEntry(m_natCheckTable, reverseEntryKey, values, addFlag)))
                     {
                         for (auto iter : values)
                         {
@@ -954,7 +956,7 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                         }
                         else
                         { 
-                            m_natTable.del(reverseEntryKey);
+                            delNatEntry(m_natTable, reverseEntryKey);
                             SWSS_LOG_NOTICE("Implicit SNAT entry with key %s deleted from APP_DB", reverseEntryKey.c_str());
                         }
                     }
@@ -968,10 +970,10 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
                     }
                     else
                     {
-                        m_natTable.set(key, fvVector);
+                        setNatEntry(m_natTable, key, fvVector);
                         SWSS_LOG_NOTICE("DNAT entry with key %s added to APP_DB", key.c_str());
-                        setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
-                        m_natTable.set(reverseEntryKey, reverseFvVector);
+                        sendTimeoutNotification("SET-SINGLE-NAT", key, fvVector);
+                        setNatEntry(m_natTable, reverseEntryKey, reverseFvVector);
                         SWSS_LOG_NOTICE("Implicit SNAT entry with key %s added to APP_DB", reverseEntryKey.c_str());
                     }
                 }
@@ -981,6 +983,88 @@ int NatSync::addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFl
     return 0;
 }
 
+/* Look up a NAT entry, taking the writes not flushed yet into account.
+ * A CREATE for a dynamic entry natsyncd has written is a duplicate, which
+ * is answered without reading APP_DB. Otherwise APP_DB is read, so that
+ * static entries keep their priority. */
+bool NatSync::getNatEntry(Table &checkTable, const string &key,
+                          std::vector<FieldValueTuple> &values, bool addFlag)
+{
+    const string &tableName = checkTable.getTableName();
+
+    if (m_deletedEntries[tableName].count(key))
+    {
+        return false;
+    }
+
+    bool tracked = (m_dynamicEntries[tableName].count(key) != 0);
+    if (tracked && addFlag)
+    {
+        m_duplicates++;
+        values = { FieldValueTuple("entry_type", "dynamic") };
+        return true;
+    }
+
+    if (checkTable.get(key, values))
+    {
+        return true;
+    }
+
+    /* Written in this batch, not in APP_DB yet */
+    if (tracked)
+    {
+        values = { FieldValueTuple("entry_type", "dynamic") };
+        return true;
+    }
+
+    return false;
+}
+
+void NatSync::setNatEntry(ProducerStateTable &table, const string &key,
+                          const std::vector<FieldValueTuple> &values)
+{
+    const string &tableName = table.getTableName();
+
+    table.set(key, values);
+    m_dynamicEntries[tableName].insert(key);
+    m_deletedEntries[tableName].erase(key);
+}
+
+void NatSync::delNatEntry(ProducerStateTable &table, const string &key)
+{
+    const string &tableName = table.getTableName();
+
+    table.del(key);
+    m_dynamicEntries[tableName].erase(key);
+    m_deletedEntries[tableName].insert(key);
+}
+
+/* The notification refers to the entry, it is sent once the entry is flushed */
+void NatSync::sendTimeoutNotification(const string &op, const string &key,
+                                      const std::vector<FieldValueTuple> &values)
+{
+    m_pendingNotifications.emplace_back(key, op, values);
+}
+
+void NatSync::flush()
+{
+    m_pipeline->flush();
+
+    for (const auto &it : m_pendingNotifications)
+    {
+        setTimeoutNotifier->send(kfvOp(it), kfvKey(it), kfvFieldsValues(it));
+    }
+
+    if (!m_pendingNotifications.empty())
+    {
+        SWSS_LOG_INFO("Flushed %zu new NAT entries, %" PRIu64 " duplicate notifications so far",
+                      m_pendingNotifications.size(), m_duplicates);
+    }
+
+    m_pendingNotifications.clear();
+    m_deletedEntries.clear();
+}
+
 /* This function is called only for updating the UDP connection entries
  * so as not to timeout early in the kernel. */
 void NatSync::updateConnTrackEntry(struct nfnl_ct *ct)
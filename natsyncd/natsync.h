@@ -27,6 +27,8 @@
 #include <linux/netfilter/nfnetlink_conntrack.h>
 #include <linux/netfilter/nf_conntrack_common.h>
 #include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
 
 // The timeout value (in seconds) for natsyncd reconcilation logic
 #define DEFAULT_NATSYNC_WARMSTART_TIMER 30
@@ -36,6 +38,10 @@
 
 #define RESTORE_NAT_WAIT_TIME_OUT 120
 
+/* Receive buffer forced on the conntrack socket, the startup dump of a
+ * CGNAT sized table overflows the default one */
+#define NATSYNC_CT_RCVBUF_SIZE (32 * 1024 * 1024)
+
 namespace swss {
 
 struct naptEntry;
@@ -56,6 +62,9 @@ public:
         return m_AppRestartAssist;
     }
 
+    /* Send the buffered NAT table writes, then the timeout notifications of the new entries */
+    void flush();
+
 private:
     static int  parseConnTrackMsg(const struct nfnl_ct *ct, struct naptEntry &entry);
     void        updateConnTrackEntry(struct nfnl_ct *ct);
@@ -66,6 +75,14 @@ private:
     bool        matchingDnaptEntryExists(const naptEntry &entry);
     int         addNatEntry(struct nfnl_ct *ct, struct naptEntry &entry, bool addFlag);
 
+    bool        getNatEntry(Table &checkTable, const std::string &key,
+                            std::vector<FieldValueTuple> &values, bool addFlag);
+    void        setNatEntry(ProducerStateTable &table, const std::string &key,
+                            const std::vector<FieldValueTuple> &values);
+    void        delNatEntry(ProducerStateTable &table, const std::string &key);
+    void        sendTimeoutNotification(const std::string &op, const std::string &key,
+                                        const std::vector<FieldValueTuple> &values);
+
     std::shared_ptr<swss::NotificationProducer> setTimeoutNotifier;
 
     ProducerStateTable m_natTable;
@@ -83,6 +100,14 @@ private:
     AppRestartAssist  *m_AppRestartAssist;
 
     NfNetlink          *nfsock;
+    RedisPipeline      *m_pipeline;
+
+    /* Dynamic entries written per table, a CREATE for one of them only refreshes the timeout */
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_dynamicEntries;
+    /* Entries deleted since the last flush, the check tables still have them */
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_deletedEntries;
+    std::vector<KeyOpFieldsValuesTuple> m_pendingNotifications;
+    uint64_t m_duplicates = 0;
 };
 
 struct naptEntry
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <chrono>
+#include <string.h>
+#include <errno.h>
+#include <sys/socket.h>
 #include "logger.h"
 #include "select.h"
 #include "netdispatcher.h"
@@ -67,6 +70,14 @@ int main(int argc, char **argv)
             nfnl.registerGroup(NFNLGRP_CONNTRACK_UPDATE);
             nfnl.registerGroup(NFNLGRP_CONNTRACK_DESTROY);
 
+            /* SO_RCVBUFFORCE goes over rmem_max, it needs CAP_NET_ADMIN */
+            int size = NATSYNC_CT_RCVBUF_SIZE;
+            if (setsockopt(nfnl.getFd(), SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) < 0)
+            {
+                SWSS_LOG_WARN("Unable to force the conntrack receive buffer to %d bytes: %s",
+                              size, strerror(errno));
+            }
+
             SWSS_LOG_INFO("Listens to conntrack messages...");
             nfnl.dumpRequest(IPCTNL_MSG_CT_GET);
 
@@ -87,6 +98,9 @@ int main(int argc, char **argv)
                         sync.getRestartAssist()->reconcile();
                     }
                 }
+
+                /* The NAT table updates of a conntrack read go together */
+                sync.flush();
             }
         }
         catch (const std::exception& e)
@@ -13,14 +13,18 @@
 
 #include "neighsync.h"
 #include "warm_restart.h"
+#include "lib/orch_zmq_config.h"
 #include <algorithm>
+#include <inttypes.h>
 #include <linux/neighbour.h>
 
 using namespace std;
 using namespace swss;
 
 NeighSync::NeighSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb, DBConnector *cfgDb) :
-    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME),
+    // When the feature ORCH_NORTHBOND_NEIGH_ZMQ_ENABLED is enabled, neighbor events must be sent to orchagent via the ZMQ channel.
+    m_zmqClient(create_local_zmq_client(ORCH_NORTHBOND_NEIGH_ZMQ_ENABLED, false)),
+    m_neighTable(createProducerStateTable(pipelineAppDB, APP_NEIGH_TABLE_NAME, true, m_zmqClient)),
     m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME),
     m_cfgInterfaceTable(cfgDb, CFG_INTF_TABLE_NAME),
     m_cfgLagInterfaceTable(cfgDb, CFG_LAG_INTF_TABLE_NAME),
@@ -30,7 +34,7 @@ NeighSync::NeighSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb, DBConne
     m_AppRestartAssist = new AppRestartAssist(pipelineAppDB, "neighsyncd", "swss", DEFAULT_NEIGHSYNC_WARMSTART_TIMER);
     if (m_AppRestartAssist)
     {
-        m_AppRestartAssist->registerAppTable(APP_NEIGH_TABLE_NAME, &m_neighTable);
+        m_AppRestartAssist->registerAppTable(APP_NEIGH_TABLE_NAME, m_neighTable.get());
     }
 }
 
@@ -182,11 +186,58 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
     {
         if (delete_key == true)
         {
-            m_neighTable.del(key);
+            m_neighEntries.erase(key);
+            m_neighTable->del(key);
             return;
         }
-        m_neighTable.set(key, fvVector);
+
+        /* STALE/REACHABLE/DELAY/PROBE transitions keep the MAC */
+        auto it = m_neighEntries.find(key);
+        if (it != m_neighEntries.end() && it->second.mac == macStr && it->second.family == family)
+        {
+            it->second.stale = false;
+            m_suppressed++;
+            SWSS_LOG_DEBUG("State only change of %s, not written", key.c_str());
+            return;
+        }
+
+        m_neighEntries[key] = NeighEntry{macStr, family, false};
+        m_neighTable->set(key, fvVector);
+    }
+}
+
+void NeighSync::startResync()
+{
+    SWSS_LOG_NOTICE("Resyncing %zu neighbors, %" PRIu64 " state only changes suppressed so far",
+                    m_neighEntries.size(), m_suppressed);
+
+    for (auto &it : m_neighEntries)
+    {
+        it.second.stale = true;
     }
+    m_resyncing = true;
+}
+
+void NeighSync::endResync()
+{
+    size_t deleted = 0;
+
+    for (auto it = m_neighEntries.begin(); it != m_neighEntries.end();)
+    {
+        if (!it->second.stale)
+        {
+            ++it;
+            continue;
+        }
+
+        SWSS_LOG_NOTICE("Neighbor %s is gone from the kernel, deleting it", it->first.c_str());
+        m_neighTable->del(it->first);
+        it = m_neighEntries.erase(it);
+        deleted++;
+    }
+
+    m_resyncing = false;
+    SWSS_LOG_NOTICE("Neighbor resync done, %zu deleted", deleted);
 }
 
 /* To check the ipv6 link local is enabled on a given port */
@@ -3,9 +3,12 @@
 
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "zmqclient.h"
 #include "netmsg.h"
 #include "warmRestartAssist.h"
 
+#include <unordered_map>
+
 // The timeout value (in seconds) for neighsyncd reconcilation logic
 #define DEFAULT_NEIGHSYNC_WARMSTART_TIMER 5
 
@@ -35,12 +38,40 @@ public:
         return m_AppRestartAssist;
     }
 
+    /*
+     * Resync after lost neighbor events: the neighbors written so far are
+     * stale until a kernel dump reports them again, endResync() deletes the
+     * ones it did not.
+     */
+    void startResync();
+    void endResync();
+
+    bool isResyncing() const
+    {
+        return m_resyncing;
+    }
+
 private:
+    /* What was last written to NEIGH_TABLE for a key */
+    struct NeighEntry
+    {
+        std::string mac;
+        std::string family;
+        bool stale;
+    };
+
     Table m_stateNeighRestoreTable, m_cfgPeerSwitchTable;
-    ProducerStateTable m_neighTable;
+    /* Set when NEIGH_TABLE is sent to orchagent via the ZMQ channel */
+    std::shared_ptr<swss::ZmqClient> m_zmqClient;
+    std::shared_ptr<ProducerStateTable> m_neighTable;
     AppRestartAssist  *m_AppRestartAssist;
     Table m_cfgVlanInterfaceTable, m_cfgLagInterfaceTable, m_cfgInterfaceTable;
 
+    /* Written neighbors, state only transitions of those are not written again */
+    std::unordered_map<std::string, NeighEntry> m_neighEntries;
+    bool m_resyncing = false;
+    uint64_t m_suppressed = 0;
+
     bool isLinkLocalEnabled(const std::string &port);
 };
 
@@ -7,6 +7,7 @@
 #include "netdispatcher.h"
 #include "netlink.h"
 #include "neighsyncd/neighsync.h"
+#include "lib/resyncnetlink.h"
 
 using namespace std;
 using namespace swss;
@@ -29,7 +30,7 @@ int main(int argc, char **argv)
     {
         try
         {
-            NetLink netlink;
+            ResyncNetLink netlink;
             Select s;
 
             using namespace std::chrono;
@@ -67,10 +68,39 @@ int main(int argc, char **argv)
             netlink.dumpRequest(RTM_GETNEIGH);
 
             s.addSelectable(&netlink);
+            bool resyncPending = false;
             while (true)
             {
                 Selectable *temps;
                 s.select(&temps);
+
+                if (temps == &netlink)
+                {
+                    /*
+                     * Neighbor events were lost, dump the kernel table again once
+                     * the dump in progress if any is done. The neighbors missing
+                     * from the dump are deleted at its end.
+                     */
+                    if (netlink.checkOverflow())
+                    {
+                        resyncPending = true;
+                    }
+                    if (netlink.checkDumpDone() && sync.isResyncing() && !resyncPending)
+                    {
+                        sync.endResync();
+                    }
+                    if (resyncPending && !netlink.isDumping())
+                    {
+                        /* The warm start reconciliation takes care of the stale neighbors */
+                        if (!sync.getRestartAssist()->isWarmStartInProgress())
+                        {
+                            sync.startResync();
+                        }
+                        netlink.dumpRequest(RTM_GETNEIGH);
+                        resyncPending = false;
+                    }
+                }
+
                 /*
                  * If warmstart is in progress, we check the reconcile timer,
                  * if timer expired, we stop the timer and start the reconcile process
@@ -83,6 +113,9 @@ int main(int argc, char **argv)
                         sync.getRestartAssist()->reconcile();
                     }
                 }
+
+                /* The NEIGH_TABLE updates of a netlink read go together */
+                pipelineAppDB.flush();
             }
         }
         catch (const std::exception& e)
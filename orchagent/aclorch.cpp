@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <algorithm>
 #include <sstream>
+#include <typeinfo>
 #include "aclorch.h"
 #include "logger.h"
 #include "schema.h"
@@ -14,16 +15,21 @@
 #include "sai_serialize.h"
 #include "directory.h"
 #include "saihelper.h"
+#include "saicapabilitycache.h"
+#include "redispipeline.h"
 
 using namespace std;
 using namespace swss;
 
-map<acl_range_properties_t, AclRange*> AclRange::m_ranges;
+unordered_map<acl_range_properties_t, AclRange*, AclRangeHash> AclRange::m_ranges;
+unordered_set<AclRange*> AclRange::m_unused;
+vector<AclRange*> AclRange::m_bulkRemoved;
 sai_uint32_t AclRule::m_minPriority = 0;
 sai_uint32_t AclRule::m_maxPriority = 0;
 
 swss::DBConnector AclOrch::m_countersDb("COUNTERS_DB", 0);
 swss::Table AclOrch::m_countersTable(&m_countersDb, "COUNTERS");
+bool AclOrch::m_bulkRules = false;
 
 extern sai_acl_api_t*    sai_acl_api;
 extern sai_port_api_t*   sai_port_api;
@@ -33,6 +39,7 @@ extern PortsOrch*        gPortsOrch;
 extern CrmOrch *gCrmOrch;
 extern SwitchOrch *gSwitchOrch;
 extern string gMySwitchType;
+extern size_t gMaxBulkSize;
 extern Directory<Orch*> gDirectory;
 
 #define MIN_VLAN_ID 1    // 0 is a reserved VLAN ID
@@ -95,6 +102,46 @@ acl_rule_attr_lookup_t aclMatchLookup =
     { MATCH_METADATA,          SAI_ACL_ENTRY_ATTR_FIELD_ACL_USER_META}
 };
 
+static const map<string, AclMatchFormat> aclMatchFormatLookup =
+{
+    { MATCH_IN_PORTS,          AclMatchFormat::PORT_LIST },
+    { MATCH_OUT_PORT,          AclMatchFormat::PORT },
+    { MATCH_OUT_PORTS,         AclMatchFormat::PORT_LIST },
+    { MATCH_SRC_IP,            AclMatchFormat::IPV4 },
+    { MATCH_DST_IP,            AclMatchFormat::IPV4 },
+    { MATCH_SRC_IPV6,          AclMatchFormat::IPV6 },
+    { MATCH_DST_IPV6,          AclMatchFormat::IPV6 },
+    { MATCH_L4_SRC_PORT,       AclMatchFormat::U16 },
+    { MATCH_L4_DST_PORT,       AclMatchFormat::U16 },
+    { MATCH_ETHER_TYPE,        AclMatchFormat::U16 },
+    { MATCH_VLAN_ID,           AclMatchFormat::VLAN_ID },
+    { MATCH_IP_PROTOCOL,       AclMatchFormat::U8 },
+    { MATCH_NEXT_HEADER,       AclMatchFormat::U8 },
+    { MATCH_TCP_FLAGS,         AclMatchFormat::U8_6BIT_MASKED },
+    { MATCH_IP_TYPE,           AclMatchFormat::IP_TYPE },
+    { MATCH_DSCP,              AclMatchFormat::U8_6BIT_MASKED },
+    { MATCH_TC,                AclMatchFormat::U8 },
+    { MATCH_ICMP_TYPE,         AclMatchFormat::U8 },
+    { MATCH_ICMP_CODE,         AclMatchFormat::U8 },
+    { MATCH_ICMPV6_TYPE,       AclMatchFormat::U8 },
+    { MATCH_ICMPV6_CODE,       AclMatchFormat::U8 },
+    { MATCH_L4_SRC_PORT_RANGE, AclMatchFormat::RANGE },
+    { MATCH_L4_DST_PORT_RANGE, AclMatchFormat::RANGE },
+    { MATCH_TUNNEL_VNI,        AclMatchFormat::U32 },
+    { MATCH_INNER_ETHER_TYPE,  AclMatchFormat::U16 },
+    { MATCH_INNER_IP_PROTOCOL, AclMatchFormat::U8 },
+    { MATCH_INNER_SRC_MAC,     AclMatchFormat::MAC },
+    { MATCH_INNER_DST_MAC,     AclMatchFormat::MAC },
+    { MATCH_INNER_SRC_IP,      AclMatchFormat::IPV4 },
+    { MATCH_INNER_SRC_IPV6,    AclMatchFormat::IPV6 },
+    { MATCH_INNER_L4_SRC_PORT, AclMatchFormat::U16 },
+    { MATCH_INNER_L4_DST_PORT, AclMatchFormat::U16 },
+    { MATCH_BTH_OPCODE,        AclMatchFormat::U8_MASKED },
+    { MATCH_AETH_SYNDROME,     AclMatchFormat::U8_MASKED },
+    { MATCH_TUNNEL_TERM,       AclMatchFormat::BOOL },
+    { MATCH_METADATA,          AclMatchFormat::METADATA }
+};
+
 static acl_range_type_lookup_t aclRangeTypeLookup =
 {
     { MATCH_L4_SRC_PORT_RANGE, SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE },
@@ -707,6 +754,45 @@ const set<sai_acl_action_type_t>& AclTableType::getActions() const
     return m_aclAcitons;
 }
 
+// The match templates shared by all table types, before their own adjustments
+static const acl_match_template_lookup_t& getAclMatchTemplates()
+{
+    static const acl_match_template_lookup_t templates = []()
+    {
+        acl_match_template_lookup_t lookup;
+        for (const auto& match: aclMatchLookup)
+        {
+            lookup.emplace(match.first, AclMatchTemplate{ match.second, aclMatchFormatLookup.at(match.first), false });
+        }
+        return lookup;
+    }();
+
+    return templates;
+}
+
+void AclTableType::compileMatchTemplates()
+{
+    m_matchTemplates = getAclMatchTemplates();
+
+    // TODO: For backwards compatibility, users can substitute IP_PROTOCOL for NEXT_HEADER.
+    // This should be removed in a future release.
+    if (m_name == TABLE_TYPE_MIRRORV6 || m_name == TABLE_TYPE_L3V6)
+    {
+        auto& ipProtocol = m_matchTemplates.at(MATCH_IP_PROTOCOL);
+        ipProtocol.attr = aclMatchLookup[MATCH_NEXT_HEADER];
+        ipProtocol.deprecated = true;
+    }
+}
+
+const AclMatchTemplate* AclTableType::getMatchTemplate(const string& name) const
+{
+    // A type not made by AclTableTypeBuilder has no templates of its own
+    const auto& templates = m_matchTemplates.empty() ? getAclMatchTemplates() : m_matchTemplates;
+    auto it = templates.find(name);
+
+    return it == templates.end() ? nullptr : &it->second;
+}
+
 bool AclTableType::addAction(sai_acl_action_type_t action)
 {
     m_aclAcitons.insert(action);
@@ -747,6 +833,7 @@ AclTableType AclTableTypeBuilder::build()
 {
     auto tableType = m_tableType;
     m_tableType = AclTableType();
+    tableType.compileMatchTemplates();
     return tableType;
 }
 
@@ -937,282 +1024,220 @@ bool AclRule::validateAddMatch(string attr_name, string attr_value)
     SWSS_LOG_ENTER();
 
     sai_acl_field_data_t matchData{};
-    vector<sai_object_id_t> inPorts;
-    vector<sai_object_id_t> outPorts;
+    vector<sai_object_id_t> ports;
 
     matchData.enable = true;
 
+    const AclMatchTemplate *match = m_pTable->type.getMatchTemplate(attr_name);
+    if (!match)
+    {
+        return false;
+    }
+
     try
     {
-        if (aclMatchLookup.find(attr_name) == aclMatchLookup.end())
-        {
-            return false;
-        }
-        else if (attr_name == MATCH_TUNNEL_TERM)
-        {
-            matchData.data.booldata = (to_upper(attr_value) == "TRUE");;
-        }
-        else if (attr_name == MATCH_INNER_DST_MAC || attr_name == MATCH_INNER_SRC_MAC)
-        {
-            swss::MacAddress mac(attr_value);
-            swss::MacAddress mask(MAC_EXACT_MATCH);
-            memcpy(matchData.data.mac, mac.getMac(), sizeof(sai_mac_t));
-            memcpy(matchData.mask.mac, mask.getMac(), sizeof(sai_mac_t));
-        }
-        else if (attr_name == MATCH_IN_PORTS)
+        switch (match->format)
         {
-            auto ports = tokenize(attr_value, ',');
-
-            if (ports.size() == 0)
+            case AclMatchFormat::BOOL:
             {
-                return false;
+                matchData.data.booldata = (to_upper(attr_value) == "TRUE");
+                break;
             }
-
-            for (auto alias : ports)
+            case AclMatchFormat::MAC:
             {
-                Port port;
-                if (!gPortsOrch->getPort(alias, port))
+                swss::MacAddress mac(attr_value);
+                swss::MacAddress mask(MAC_EXACT_MATCH);
+                memcpy(matchData.data.mac, mac.getMac(), sizeof(sai_mac_t));
+                memcpy(matchData.mask.mac, mask.getMac(), sizeof(sai_mac_t));
+                break;
+            }
+            case AclMatchFormat::PORT_LIST:
+            {
+                auto aliases = tokenize(attr_value, ',');
+
+                if (aliases.size() == 0)
                 {
-                    SWSS_LOG_ERROR("Failed to locate port %s", alias.c_str());
                     return false;
                 }
 
-                if (port.m_type != Port::PHY)
+                for (const auto &alias : aliases)
                 {
-                    SWSS_LOG_ERROR("Cannot bind rule to %s: IN_PORTS can only match physical interfaces", alias.c_str());
-                    return false;
-                }
+                    const Port *port = gPortsOrch->findPort(alias);
+                    if (!port)
+                    {
+                        SWSS_LOG_ERROR("Failed to locate port %s", alias.c_str());
+                        return false;
+                    }
 
-                inPorts.push_back(port.m_port_id);
-            }
+                    if (port->m_type != Port::PHY)
+                    {
+                        SWSS_LOG_ERROR("Cannot bind rule to %s: %s can only match physical interfaces",
+                                alias.c_str(), attr_name.c_str());
+                        return false;
+                    }
 
-            matchData.data.objlist.count = static_cast<uint32_t>(inPorts.size());
-            matchData.data.objlist.list = inPorts.data();
-        }
-        else if (attr_name == MATCH_OUT_PORTS)
-        {
-            auto ports = tokenize(attr_value, ',');
+                    ports.push_back(port->m_port_id);
+                }
 
-            if (ports.size() == 0)
-            {
-                return false;
+                matchData.data.objlist.count = static_cast<uint32_t>(ports.size());
+                matchData.data.objlist.list = ports.data();
+                break;
             }
-
-            for (auto alias : ports)
+            case AclMatchFormat::PORT:
             {
-                Port port;
-                if (!gPortsOrch->getPort(alias, port))
+                const auto &alias = attr_value;
+                const Port *port = gPortsOrch->findPort(alias);
+                if (!port)
                 {
                     SWSS_LOG_ERROR("Failed to locate port %s", alias.c_str());
                     return false;
                 }
-
-                if (port.m_type != Port::PHY)
+                if (port->m_type != Port::PHY)
                 {
-                    SWSS_LOG_ERROR("Cannot bind rule to %s: OUT_PORTS can only match physical interfaces", alias.c_str());
+                    SWSS_LOG_ERROR("Cannot bind rule to %s: %s can only match physical interfaces",
+                            alias.c_str(), attr_name.c_str());
                     return false;
                 }
 
-                outPorts.push_back(port.m_port_id);
-            }
-
-            matchData.data.objlist.count = static_cast<uint32_t>(outPorts.size());
-            matchData.data.objlist.list = outPorts.data();
-        }
-        else if (attr_name == MATCH_OUT_PORT)
-        {
-            auto alias = attr_value;
-            Port port;
-            if (!gPortsOrch->getPort(alias, port))
-            {
-                SWSS_LOG_ERROR("Failed to locate port %s", alias.c_str());
-                return false;
+                matchData.data.oid = port->m_port_id;
+                break;
             }
-            if (port.m_type != Port::PHY)
+            case AclMatchFormat::IP_TYPE:
             {
-                SWSS_LOG_ERROR("Cannot bind rule to %s: OUT_PORT can only match physical interfaces", alias.c_str());
-                return false;
-            }
+                if (!processIpType(attr_value, matchData.data.u32))
+                {
+                    SWSS_LOG_ERROR("Invalid IP type %s", attr_value.c_str());
+                    return false;
+                }
 
-            matchData.data.oid = port.m_port_id;
-        }
-        else if (attr_name == MATCH_IP_TYPE)
-        {
-            if (!processIpType(attr_value, matchData.data.u32))
-            {
-                SWSS_LOG_ERROR("Invalid IP type %s", attr_value.c_str());
-                return false;
+                matchData.mask.u32 = 0xFFFFFFFF;
+                break;
             }
+            case AclMatchFormat::U8_6BIT_MASKED:
+            {
+                // Support both exact value match and value/mask match
+                auto data = tokenize(attr_value, '/');
 
-            matchData.mask.u32 = 0xFFFFFFFF;
-        }
-        else if (attr_name == MATCH_TCP_FLAGS)
-        {
-            // Support both exact value match and value/mask match
-            auto flag_data = tokenize(attr_value, '/');
-
-            matchData.data.u8 = to_uint<uint8_t>(flag_data[0], 0, 0x3F);
+                matchData.data.u8 = to_uint<uint8_t>(data[0], 0, 0x3F);
 
-            if (flag_data.size() == 2)
-            {
-                matchData.mask.u8 = to_uint<uint8_t>(flag_data[1], 0, 0x3F);
-            }
-            else
-            {
-                matchData.mask.u8 = 0x3F;
+                if (data.size() == 2)
+                {
+                    matchData.mask.u8 = to_uint<uint8_t>(data[1], 0, 0x3F);
+                }
+                else
+                {
+                    matchData.mask.u8 = 0x3F;
+                }
+                break;
             }
-        }
-        else if (attr_name == MATCH_ETHER_TYPE || attr_name == MATCH_L4_SRC_PORT || attr_name == MATCH_L4_DST_PORT)
-        {
-            matchData.data.u16 = to_uint<uint16_t>(attr_value);
-            matchData.mask.u16 = 0xFFFF;
-        }
-        else if (attr_name == MATCH_VLAN_ID)
-        {
-            matchData.data.u16 = to_uint<uint16_t>(attr_value);
-            matchData.mask.u16 = 0xFFF;
-
-            if (matchData.data.u16 < MIN_VLAN_ID || matchData.data.u16 > MAX_VLAN_ID)
+            case AclMatchFormat::U8_MASKED:
             {
-                SWSS_LOG_ERROR("Invalid VLAN ID: %s", attr_value.c_str());
-                return false;
-            }
-        }
-        else if (attr_name == MATCH_DSCP)
-        {
-            /* Support both exact value match and value/mask match */
-            auto dscp_data = tokenize(attr_value, '/');
-
-            matchData.data.u8 = to_uint<uint8_t>(dscp_data[0], 0, 0x3F);
+                auto data = tokenize(attr_value, '/');
 
-            if (dscp_data.size() == 2)
-            {
-                matchData.mask.u8 = to_uint<uint8_t>(dscp_data[1], 0, 0x3F);
+                if (data.size() == 2)
+                {
+                    matchData.data.u8 = to_uint<uint8_t>(data[0]);
+                    matchData.mask.u8 = to_uint<uint8_t>(data[1]);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid %s configuration: %s, expected format <data>/<mask>",
+                            attr_name.c_str(), attr_value.c_str());
+                    return false;
+                }
+                break;
             }
-            else
+            case AclMatchFormat::U8:
             {
-                matchData.mask.u8 = 0x3F;
+                matchData.data.u8 = to_uint<uint8_t>(attr_value);
+                matchData.mask.u8 = 0xFF;
+                break;
             }
-        }
-        else if (attr_name == MATCH_IP_PROTOCOL || attr_name == MATCH_NEXT_HEADER)
-        {
-            matchData.data.u8 = to_uint<uint8_t>(attr_value);
-            matchData.mask.u8 = 0xFF;
-        }
-        else if (attr_name == MATCH_SRC_IP || attr_name == MATCH_DST_IP || attr_name == MATCH_INNER_SRC_IP)
-        {
-            IpPrefix ip(attr_value);
-
-            if (!ip.isV4())
+            case AclMatchFormat::U16:
             {
-                SWSS_LOG_ERROR("IP type is not v4 type");
-                return false;
+                matchData.data.u16 = to_uint<uint16_t>(attr_value);
+                matchData.mask.u16 = 0xFFFF;
+                break;
             }
-            matchData.data.ip4 = ip.getIp().getV4Addr();
-            matchData.mask.ip4 = ip.getMask().getV4Addr();
-        }
-        else if (attr_name == MATCH_SRC_IPV6 || attr_name == MATCH_DST_IPV6 || attr_name == MATCH_INNER_SRC_IPV6)
-        {
-            IpPrefix ip(attr_value);
-            if (ip.isV4())
+            case AclMatchFormat::VLAN_ID:
             {
-                SWSS_LOG_ERROR("IP type is not v6 type");
-                return false;
+                matchData.data.u16 = to_uint<uint16_t>(attr_value);
+                matchData.mask.u16 = 0xFFF;
+
+                if (matchData.data.u16 < MIN_VLAN_ID || matchData.data.u16 > MAX_VLAN_ID)
+                {
+                    SWSS_LOG_ERROR("Invalid VLAN ID: %s", attr_value.c_str());
+                    return false;
+                }
+                break;
             }
-            memcpy(matchData.data.ip6, ip.getIp().getV6Addr(), 16);
-            memcpy(matchData.mask.ip6, ip.getMask().getV6Addr(), 16);
-        }
-        else if ((attr_name == MATCH_L4_SRC_PORT_RANGE) || (attr_name == MATCH_L4_DST_PORT_RANGE))
-        {
-            AclRangeConfig rangeConfig{};
-            if (sscanf(attr_value.c_str(), "%d-%d", &rangeConfig.min, &rangeConfig.max) != 2)
+            case AclMatchFormat::U32:
             {
-                SWSS_LOG_ERROR("Range parse error. Attribute: %s, value: %s", attr_name.c_str(), attr_value.c_str());
-                return false;
+                matchData.data.u32 = to_uint<uint32_t>(attr_value);
+                matchData.mask.u32 = 0xFFFFFFFF;
+                break;
             }
-
-            rangeConfig.rangeType = aclRangeTypeLookup[attr_name];
-
-            // check boundaries
-            if ((rangeConfig.min > USHRT_MAX) ||
-                (rangeConfig.max > USHRT_MAX) ||
-                (rangeConfig.min > rangeConfig.max))
+            case AclMatchFormat::METADATA:
             {
-                SWSS_LOG_ERROR("Range parse error. Invalid range value. Attribute: %s, value: %s", attr_name.c_str(), attr_value.c_str());
-                return false;
-            }
-
-            m_rangeConfig.push_back(rangeConfig);
-
-            return m_pTable->validateAclRuleMatch(SAI_ACL_ENTRY_ATTR_FIELD_ACL_RANGE_TYPE, *this);
-        }
-        else if (attr_name == MATCH_TC)
-        {
-            matchData.data.u8 = to_uint<uint8_t>(attr_value);
-            matchData.mask.u8 = 0xFF;
-        }
-        else if (attr_name == MATCH_ICMP_TYPE || attr_name == MATCH_ICMP_CODE ||
-                attr_name == MATCH_ICMPV6_TYPE || attr_name == MATCH_ICMPV6_CODE)
-        {
-            matchData.data.u8 = to_uint<uint8_t>(attr_value);
-            matchData.mask.u8 = 0xFF;
-        }
-        else if (attr_name == MATCH_TUNNEL_VNI)
-        {
-            matchData.data.u32 = to_uint<uint32_t>(attr_value);
-            matchData.mask.u32 = 0xFFFFFFFF;
-        }
-        else if (attr_name == MATCH_INNER_ETHER_TYPE || attr_name == MATCH_INNER_L4_SRC_PORT ||
-            attr_name == MATCH_INNER_L4_DST_PORT)
-        {
-            matchData.data.u16 = to_uint<uint16_t>(attr_value);
-            matchData.mask.u16 = 0xFFFF;
-        }
-        else if (attr_name == MATCH_INNER_IP_PROTOCOL)
-        {
-            matchData.data.u8 = to_uint<uint8_t>(attr_value);
-            matchData.mask.u8 = 0xFF;
-        }
-        else if (attr_name == MATCH_BTH_OPCODE)
-        {
-            auto opcode_data = tokenize(attr_value, '/');
+                matchData.data.u32 = to_uint<uint32_t>(attr_value);
+                matchData.mask.u32 = 0xFFFFFFFF;
 
-            if (opcode_data.size() == 2)
-            {
-                matchData.data.u8 = to_uint<uint8_t>(opcode_data[0]);
-                matchData.mask.u8 = to_uint<uint8_t>(opcode_data[1]);
+                if (matchData.data.u32 < m_pAclOrch->getAclMetaDataMin() || matchData.data.u32 > m_pAclOrch->getAclMetaDataMax())
+                {
+                    SWSS_LOG_ERROR("Invalid MATCH_METADATA configuration: %s, expected value between %d - %d", attr_value.c_str(),
+                        m_pAclOrch->getAclMetaDataMin(), m_pAclOrch->getAclMetaDataMax());
+                    return false;
+                }
+                break;
             }
-            else
+            case AclMatchFormat::IPV4:
             {
-                SWSS_LOG_ERROR("Invalid BTH_OPCODE configuration: %s, expected format <data>/<mask>", attr_value.c_str());
-                return false;
-            }
-        }
-        else if (attr_name == MATCH_AETH_SYNDROME)
-        {
-            auto syndrome_data = tokenize(attr_value, '/');
+                IpPrefix ip(attr_value);
 
-            if (syndrome_data.size() == 2)
-            {
-                matchData.data.u8 = to_uint<uint8_t>(syndrome_data[0]);
-                matchData.mask.u8 = to_uint<uint8_t>(syndrome_data[1]);
+                if (!ip.isV4())
+                {
+                    SWSS_LOG_ERROR("IP type is not v4 type");
+                    return false;
+                }
+                matchData.data.ip4 = ip.getIp().getV4Addr();
+                matchData.mask.ip4 = ip.getMask().getV4Addr();
+                break;
             }
-            else
+            case AclMatchFormat::IPV6:
             {
-                SWSS_LOG_ERROR("Invalid AETH_SYNDROME configuration: %s, expected format <data>/<mask>", attr_value.c_str());
-                return false;
+                IpPrefix ip(attr_value);
+                if (ip.isV4())
+                {
+                    SWSS_LOG_ERROR("IP type is not v6 type");
+                    return false;
+                }
+                memcpy(matchData.data.ip6, ip.getIp().getV6Addr(), 16);
+                memcpy(matchData.mask.ip6, ip.getMask().getV6Addr(), 16);
+                break;
             }
-        }
-        else if (attr_name == MATCH_METADATA)
-        {
-            matchData.data.u32 = to_uint<uint32_t>(attr_value);
-            matchData.mask.u32 = 0xFFFFFFFF;
-
-            if (matchData.data.u32 < m_pAclOrch->getAclMetaDataMin() || matchData.data.u32 > m_pAclOrch->getAclMetaDataMax())
+            case AclMatchFormat::RANGE:
             {
-                SWSS_LOG_ERROR("Invalid MATCH_METADATA configuration: %s, expected value between %d - %d", attr_value.c_str(),
-                    m_pAclOrch->getAclMetaDataMin(), m_pAclOrch->getAclMetaDataMax());
-                return false;
+                AclRangeConfig rangeConfig{};
+                if (sscanf(attr_value.c_str(), "%d-%d", &rangeConfig.min, &rangeConfig.max) != 2)
+                {
+                    SWSS_LOG_ERROR("Range parse error. Attribute: %s, value: %s", attr_name.c_str(), attr_value.c_str());
+                    return false;
+                }
+
+                rangeConfig.rangeType = aclRangeTypeLookup[attr_name];
+
+                // check boundaries
+                if ((rangeConfig.min > USHRT_MAX) ||
+                    (rangeConfig.max > USHRT_MAX) ||
+                    (rangeConfig.min > rangeConfig.max))
+                {
+                    SWSS_LOG_ERROR("Range parse error. Invalid range value. Attribute: %s, value: %s", attr_name.c_str(), attr_value.c_str());
+                    return false;
+                }
+
+                m_rangeConfig.push_back(rangeConfig);
+
+                return m_pTable->validateAclRuleMatch(SAI_ACL_ENTRY_ATTR_FIELD_ACL_RANGE_TYPE, *this);
             }
         }
     }
@@ -1227,16 +1252,12 @@ bool AclRule::validateAddMatch(string attr_name, string attr_value)
         return false;
     }
 
-    // TODO: For backwards compatibility, users can substitute IP_PROTOCOL for NEXT_HEADER.
-    // This should be removed in a future release.
-    if ((m_pTable->type.getName() == TABLE_TYPE_MIRRORV6 || m_pTable->type.getName() == TABLE_TYPE_L3V6)
-            && attr_name == MATCH_IP_PROTOCOL)
+    if (match->deprecated)
     {
         SWSS_LOG_WARN("Support for IP protocol on IPv6 tables will be removed in a future release, please switch to using NEXT_HEADER instead!");
-        attr_name = MATCH_NEXT_HEADER;
     }
 
-    return setMatch(aclMatchLookup[attr_name], matchData);
+    return setMatch(match->attr, matchData);
 }
 
 bool AclRule::processIpType(string type, sai_uint32_t &ip_type)
@@ -1271,16 +1292,9 @@ bool AclRule::create()
     return true;
 }
 
-bool AclRule::createRule()
+void AclRule::getRuleAttrs(AclRuleAttrs &rule_attrs, const sai_object_list_t &range_object_list)
 {
-    SWSS_LOG_ENTER();
-
-    vector<sai_attribute_t> rule_attrs;
-    sai_object_id_t range_objects[2];
-    sai_object_list_t range_object_list = {0, range_objects};
-
     sai_attribute_t attr;
-    sai_status_t status;
 
     // store table oid this rule belongs to
     attr.id = SAI_ACL_ENTRY_ATTR_TABLE_ID;
@@ -1304,24 +1318,8 @@ bool AclRule::createRule()
         rule_attrs.push_back(attr);
     }
 
-    if (!m_rangeConfig.empty())
+    if (range_object_list.count)
     {
-        for (const auto& rangeConfig: m_rangeConfig)
-        {
-            SWSS_LOG_INFO("Creating range object %u..%u", rangeConfig.min, rangeConfig.max);
-
-            AclRange *range = AclRange::create(rangeConfig.rangeType, rangeConfig.min, rangeConfig.max);
-            if (!range)
-            {
-                // release already created range if any
-                AclRange::remove(range_objects, range_object_list.count);
-                return false;
-            }
-
-            m_ranges.push_back(range);
-            range_objects[range_object_list.count++] = range->getOid();
-        }
-
         attr.id = SAI_ACL_ENTRY_ATTR_FIELD_ACL_RANGE_TYPE;
         attr.value.aclfield.enable = true;
         attr.value.aclfield.data.objlist = range_object_list;
@@ -1341,6 +1339,38 @@ bool AclRule::createRule()
         attr = it.second.getSaiAttr();
         rule_attrs.push_back(attr);
     }
+}
+
+bool AclRule::createRule()
+{
+    SWSS_LOG_ENTER();
+
+    AclRuleAttrs rule_attrs;
+    sai_object_id_t range_objects[2];
+    sai_object_list_t range_object_list = {0, range_objects};
+
+    sai_status_t status;
+
+    if (!m_rangeConfig.empty())
+    {
+        for (const auto& rangeConfig: m_rangeConfig)
+        {
+            SWSS_LOG_INFO("Creating range object %u..%u", rangeConfig.min, rangeConfig.max);
+
+            AclRange *range = AclRange::create(rangeConfig.rangeType, rangeConfig.min, rangeConfig.max);
+            if (!range)
+            {
+                // release already created range if any
+                AclRange::remove(range_objects, range_object_list.count);
+                return false;
+            }
+
+            m_ranges.push_back(range);
+            range_objects[range_object_list.count++] = range->getOid();
+        }
+    }
+
+    getRuleAttrs(rule_attrs, range_object_list);
 
     status = sai_acl_api->create_acl_entry(&m_ruleOid, gSwitchId, (uint32_t)rule_attrs.size(), rule_attrs.data());
     m_lastSaiStatus = status;
@@ -1456,56 +1486,387 @@ bool AclRule::remove()
     return res;
 }
 
-void AclRule::updateInPorts()
+void AclRule::releaseRanges(ObjectBulker<sai_acl_api_t> *rangeBulker)
 {
-    SWSS_LOG_ENTER();
-    sai_status_t status;
-
-    auto attr = m_matches[SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS].getSaiAttr();
-    attr.value.aclfield.enable = true;
+    if (m_ranges.empty())
+    {
+        return;
+    }
 
-    status = sai_acl_api->set_acl_entry_attribute(m_ruleOid, &attr);
-    if (status != SAI_STATUS_SUCCESS)
+    for (auto *range: m_ranges)
     {
-        SWSS_LOG_ERROR("Failed to update ACL rule %s, rv:%d", m_id.c_str(), status);
+        AclRange::release(range, rangeBulker);
     }
+    m_ranges.clear();
 }
 
-bool AclRule::update(const AclRule& updatedRule)
+void AclRule::bulkCreateDependencies(ObjectBulker<sai_acl_api_t> &counterBulker, ObjectBulker<sai_acl_api_t> &rangeBulker)
 {
     SWSS_LOG_ENTER();
 
-    if (!m_rangeConfig.empty() || !updatedRule.m_rangeConfig.empty())
-    {
-        SWSS_LOG_ERROR("Updating range matches is currently not implemented");
-        return false;
-    }
+    m_bulkFailed = false;
+    m_bulkCounterQueued = false;
 
-    if (!updateCounter(updatedRule))
+    if (m_createCounter && m_counterOid == SAI_NULL_OBJECT_ID)
     {
-        return false;
+        SaiAttrList<> counter_attrs;
+        getCounterAttrs(counter_attrs);
+        counterBulker.create_entry(&m_counterOid, &m_bulkCounterStatus, (uint32_t)counter_attrs.size(), counter_attrs.data());
+        m_bulkCounterQueued = true;
     }
 
-    if (!updatePriority(updatedRule))
+    for (const auto& rangeConfig: m_rangeConfig)
     {
-        return false;
-    }
+        AclRange *range = AclRange::create(rangeConfig.rangeType, rangeConfig.min, rangeConfig.max, rangeBulker);
+        if (!range)
+        {
+            // The ranges already taken are released once the bulker is flushed
+            m_bulkFailed = true;
+            return;
+        }
 
-    if (!updateMatches(updatedRule))
-    {
-        return false;
+        m_ranges.push_back(range);
     }
+}
 
-    if (!updateActions(updatedRule))
-    {
-        return false;
+bool AclRule::bulkCreateRule(ObjectBulker<sai_acl_api_t> &entryBulker)
+{
+    SWSS_LOG_ENTER();
+
+    m_bulkEntryQueued = false;
+
+    if (m_bulkCounterQueued)
+    {
+        if (m_counterOid == SAI_NULL_OBJECT_ID)
+        {
+            SWSS_LOG_ERROR("Failed to create counter for the rule %s in table %s, rv:%d",
+                    m_id.c_str(), m_pTable->getId().c_str(), m_bulkCounterStatus);
+            m_lastSaiStatus = m_bulkCounterStatus;
+            m_bulkFailed = true;
+        }
+        else
+        {
+            gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_COUNTER, m_pTable->getOid());
+            SWSS_LOG_INFO("Created counter for the rule %s in table %s", m_id.c_str(), m_pTable->getId().c_str());
+        }
     }
 
+    m_bulkRangeOids.clear();
+    for (auto *range: m_ranges)
+    {
+        if (range->getOid() == SAI_NULL_OBJECT_ID)
+        {
+            SWSS_LOG_ERROR("Failed to create range object for the rule %s in table %s",
+                    m_id.c_str(), m_pTable->getId().c_str());
+            m_bulkFailed = true;
+            break;
+        }
+        m_bulkRangeOids.push_back(range->getOid());
+    }
+
+    if (m_bulkFailed)
+    {
+        releaseRanges(nullptr);
+        removeCounter();
+        decreaseNextHopRefCount();
+        return false;
+    }
+
+    AclRuleAttrs rule_attrs;
+    sai_object_list_t range_object_list = {(uint32_t)m_bulkRangeOids.size(), m_bulkRangeOids.data()};
+
+    getRuleAttrs(rule_attrs, range_object_list);
+
+    entryBulker.create_entry(&m_ruleOid, &m_bulkStatus, (uint32_t)rule_attrs.size(), rule_attrs.data());
+    m_bulkEntryQueued = true;
+
+    return true;
+}
+
+bool AclRule::bulkCreatePost()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_bulkEntryQueued)
+    {
+        return false;
+    }
+    m_bulkEntryQueued = false;
+
+    m_lastSaiStatus = m_bulkStatus;
+    if (m_bulkStatus == SAI_STATUS_SUCCESS)
+    {
+        gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, m_pTable->getOid());
+        return true;
+    }
+
+    if (m_bulkStatus == SAI_STATUS_ITEM_ALREADY_EXISTS)
+    {
+        SWSS_LOG_NOTICE("ACL rule %s already exists", m_id.c_str());
+        return true;
+    }
+
+    SWSS_LOG_ERROR("Failed to create ACL rule %s, rv:%d", m_id.c_str(), m_bulkStatus);
+    releaseRanges(nullptr);
+    decreaseNextHopRefCount();
+    removeCounter();
+
+    return false;
+}
+
+void AclRule::bulkRemoveRule(ObjectBulker<sai_acl_api_t> &entryBulker)
+{
+    SWSS_LOG_ENTER();
+
+    m_bulkEntryQueued = false;
+    m_bulkCounterQueued = false;
+
+    if (m_ruleOid == SAI_NULL_OBJECT_ID)
+    {
+        return;
+    }
+
+    entryBulker.remove_entry(&m_bulkStatus, m_ruleOid);
+    m_bulkEntryQueued = true;
+}
+
+bool AclRule::bulkRemoveDependencies(ObjectBulker<sai_acl_api_t> &counterBulker, ObjectBulker<sai_acl_api_t> &rangeBulker)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_bulkEntryQueued)
+    {
+        m_bulkEntryQueued = false;
+
+        if (m_bulkStatus == SAI_STATUS_ITEM_NOT_FOUND)
+        {
+            SWSS_LOG_NOTICE("ACL rule already deleted");
+            m_ruleOid = SAI_NULL_OBJECT_ID;
+        }
+        else if (m_bulkStatus != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to delete ACL rule, status %s", sai_serialize_status(m_bulkStatus).c_str());
+            return false;
+        }
+        else
+        {
+            gCrmOrch->decCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, m_pTable->getOid());
+            m_ruleOid = SAI_NULL_OBJECT_ID;
+            decreaseNextHopRefCount();
+        }
+    }
+
+    releaseRanges(&rangeBulker);
+
+    if (m_counterOid != SAI_NULL_OBJECT_ID)
+    {
+        counterBulker.remove_entry(&m_bulkCounterStatus, m_counterOid);
+        m_bulkCounterQueued = true;
+    }
+
+    return true;
+}
+
+bool AclRule::bulkRemovePost()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_bulkCounterQueued)
+    {
+        return true;
+    }
+    m_bulkCounterQueued = false;
+
+    if (m_bulkCounterStatus != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to remove ACL counter for rule %s in table %s", m_id.c_str(), m_pTable->getId().c_str());
+        return false;
+    }
+
+    gCrmOrch->decCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_COUNTER, m_pTable->getOid());
+
+    m_counterOid = SAI_NULL_OBJECT_ID;
+
+    SWSS_LOG_INFO("Removed counter for the rule %s in table %s", m_id.c_str(), m_pTable->getId().c_str());
+
+    return true;
+}
+
+void AclRule::updateInPorts()
+{
+    SWSS_LOG_ENTER();
+    sai_status_t status;
+
+    auto attr = m_matches[SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS].getSaiAttr();
+    attr.value.aclfield.enable = true;
+
+    status = sai_acl_api->set_acl_entry_attribute(m_ruleOid, &attr);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to update ACL rule %s, rv:%d", m_id.c_str(), status);
+    }
+}
+
+static bool isSameRangeConfig(const vector<AclRangeConfig>& a, const vector<AclRangeConfig>& b)
+{
+    return a.size() == b.size() &&
+           equal(a.begin(), a.end(), b.begin(), [](const AclRangeConfig& x, const AclRangeConfig& y)
+           {
+               return x.rangeType == y.rangeType && x.min == y.min && x.max == y.max;
+           });
+}
+
+// Attributes of updated which are new or differ from current, and those of current missing from updated
+static void getChangedAttrs(const map<sai_acl_entry_attr_t, SaiAttrWrapper>& current,
+                            const map<sai_acl_entry_attr_t, SaiAttrWrapper>& updated,
+                            SaiAttrList<>& changed, SaiAttrList<>& removed)
+{
+    for (const auto& it: updated)
+    {
+        auto cur = current.find(it.first);
+        if (cur == current.end() || cur->second < it.second || it.second < cur->second)
+        {
+            changed.push_back(it.second.getSaiAttr());
+        }
+    }
+
+    for (const auto& it: current)
+    {
+        if (!updated.count(it.first))
+        {
+            removed.push_back(it.second.getSaiAttr());
+        }
+    }
+}
+
+bool AclRule::update(const AclRule& updatedRule)
+{
+    SWSS_LOG_ENTER();
+
+    if (!updateCounter(updatedRule))
+    {
+        return false;
+    }
+
+    if (!updatePriority(updatedRule))
+    {
+        return false;
+    }
+
+    if (!updateMatches(updatedRule))
+    {
+        return false;
+    }
+
+    if (!updateRanges(updatedRule))
+    {
+        return false;
+    }
+
+    if (!updateActions(updatedRule))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool AclRule::isUpdateSupported(const AclRule& updatedRule) const
+{
+    // A redirect target is referenced by the rule object which resolved it
+    auto hasRedirectTarget = [](const AclRule& rule)
+    {
+        return !rule.m_redirect_target_next_hop.empty() ||
+               !rule.m_redirect_target_next_hop_group.empty() ||
+               rule.m_redirect_target_tun_nh.oid != SAI_NULL_OBJECT_ID;
+    };
+
+    return m_ruleOid != SAI_NULL_OBJECT_ID &&
+           typeid(*this) == typeid(updatedRule) &&
+           !hasRedirectTarget(*this) && !hasRedirectTarget(updatedRule);
+}
+
+bool AclRule::isBulkUpdateSupported(const AclRule& updatedRule) const
+{
+    return updatedRule.m_createCounter == hasCounter() &&
+           isSameRangeConfig(m_rangeConfig, updatedRule.m_rangeConfig);
+}
+
+void AclRule::bulkUpdateRule(const AclRule& updatedRule, ObjectBulker<sai_acl_api_t> &entryBulker)
+{
+    SWSS_LOG_ENTER();
+
+    AclRuleAttrs attrs;
+    SaiAttrList<> matchesUpdated, matchesDisabled;
+    SaiAttrList<> actionsUpdated, actionsDisabled;
+
+    getChangedAttrs(m_matches, updatedRule.m_matches, matchesUpdated, matchesDisabled);
+    getChangedAttrs(m_actions, updatedRule.m_actions, actionsUpdated, actionsDisabled);
+
+    if (m_priority != updatedRule.m_priority)
+    {
+        sai_attribute_t attr {};
+        attr.id = SAI_ACL_ENTRY_ATTR_PRIORITY;
+        attr.value.s32 = updatedRule.m_priority;
+        attrs.push_back(attr);
+    }
+
+    // Same order as update(), an attribute is disabled before the others are set
+    for (auto attr: matchesDisabled)
+    {
+        attr.value.aclfield.enable = false;
+        attrs.push_back(attr);
+    }
+    attrs.insert(attrs.end(), matchesUpdated.begin(), matchesUpdated.end());
+
+    for (auto attr: actionsDisabled)
+    {
+        attr.value.aclaction.enable = false;
+        attrs.push_back(attr);
+    }
+    attrs.insert(attrs.end(), actionsUpdated.begin(), actionsUpdated.end());
+
+    // The values refer to the attributes of both rules, which live until bulkUpdatePost()
+    m_bulkUpdateStatuses.assign(attrs.size(), SAI_STATUS_NOT_EXECUTED);
+    for (size_t i = 0; i < attrs.size(); i++)
+    {
+        entryBulker.set_entry_attribute(&m_bulkUpdateStatuses[i], m_ruleOid, &attrs[i]);
+    }
+}
+
+bool AclRule::bulkUpdatePost(const AclRule& updatedRule)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto status: m_bulkUpdateStatuses)
+    {
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to update ACL rule %s in table %s, rv:%d",
+                    m_id.c_str(), m_pTable->getId().c_str(), status);
+            m_lastSaiStatus = status;
+            m_bulkUpdateStatuses.clear();
+            return false;
+        }
+    }
+    m_bulkUpdateStatuses.clear();
+
+    m_priority = updatedRule.m_priority;
+    m_matches = updatedRule.m_matches;
+    m_actions = updatedRule.m_actions;
+
     return true;
 }
 
 bool AclRule::updateCounter(const AclRule& updatedRule)
 {
+    // Keep the counter values of a rule which keeps its counter
+    if (updatedRule.m_createCounter == hasCounter())
+    {
+        m_createCounter = updatedRule.m_createCounter;
+        return true;
+    }
+
     if (updatedRule.m_createCounter)
     {
         if (!enableCounter())
@@ -1652,6 +2013,53 @@ bool AclRule::updateActions(const AclRule& updatedRule)
     return true;
 }
 
+bool AclRule::updateRanges(const AclRule& updatedRule)
+{
+    if (isSameRangeConfig(m_rangeConfig, updatedRule.m_rangeConfig))
+    {
+        return true;
+    }
+
+    vector<AclRange*> ranges;
+    vector<sai_object_id_t> rangeOids;
+    for (const auto& rangeConfig: updatedRule.m_rangeConfig)
+    {
+        AclRange *range = AclRange::create(rangeConfig.rangeType, rangeConfig.min, rangeConfig.max);
+        if (!range)
+        {
+            for (auto *created: ranges)
+            {
+                AclRange::release(created, nullptr);
+            }
+            return false;
+        }
+
+        ranges.push_back(range);
+        rangeOids.push_back(range->getOid());
+    }
+
+    sai_attribute_t attr {};
+    attr.id = SAI_ACL_ENTRY_ATTR_FIELD_ACL_RANGE_TYPE;
+    attr.value.aclfield.enable = !rangeOids.empty();
+    attr.value.aclfield.data.objlist.count = static_cast<uint32_t>(rangeOids.size());
+    attr.value.aclfield.data.objlist.list = rangeOids.data();
+    if (!setAttribute(attr))
+    {
+        for (auto *created: ranges)
+        {
+            AclRange::release(created, nullptr);
+        }
+        return false;
+    }
+
+    // The entry no longer refers to the old ranges, the ones still in use are only dereferenced
+    releaseRanges(nullptr);
+    m_ranges = ranges;
+    m_rangeConfig = updatedRule.m_rangeConfig;
+
+    return true;
+}
+
 bool AclRule::setPriority(const sai_uint32_t &value)
 {
     if (!(value >= m_minPriority && value <= m_maxPriority))
@@ -1909,17 +2317,9 @@ bool AclRule::disableCounter()
     return true;
 }
 
-bool AclRule::createCounter()
+void AclRule::getCounterAttrs(SaiAttrList<> &counter_attrs) const
 {
-    SWSS_LOG_ENTER();
-
     sai_attribute_t attr;
-    vector<sai_attribute_t> counter_attrs;
-
-    if (m_counterOid != SAI_NULL_OBJECT_ID)
-    {
-        return true;
-    }
 
     attr.id = SAI_ACL_COUNTER_ATTR_TABLE_ID;
     attr.value.oid = m_pTable->getOid();
@@ -1931,6 +2331,19 @@ bool AclRule::createCounter()
         attr.value.booldata = true;
         counter_attrs.push_back(attr);
     }
+}
+
+bool AclRule::createCounter()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_counterOid != SAI_NULL_OBJECT_ID)
+    {
+        return true;
+    }
+
+    SaiAttrList<> counter_attrs;
+    getCounterAttrs(counter_attrs);
 
     if (sai_acl_api->create_acl_counter(&m_counterOid, gSwitchId, (uint32_t)counter_attrs.size(), counter_attrs.data()) != SAI_STATUS_SUCCESS)
     {
@@ -2082,16 +2495,15 @@ sai_object_id_t AclRulePacket::getRedirectObjectId(const string& redirect_value)
     string target = redirect_value;
 
     // Try to parse physical port and LAG first
-    Port port;
-    if (gPortsOrch->getPort(target, port))
+    if (const Port *port = gPortsOrch->findPort(target))
     {
-        if (port.m_type == Port::PHY)
+        if (port->m_type == Port::PHY)
         {
-            return port.m_port_id;
+            return port->m_port_id;
         }
-        else if (port.m_type == Port::LAG)
+        else if (port->m_type == Port::LAG)
         {
-            return port.m_lag_id;
+            return port->m_lag_id;
         }
         else
         {
@@ -3273,6 +3685,28 @@ bool AclRuleDTelWatchListEntry::deactivate()
     return true;
 }
 
+bool AclRuleDTelWatchListEntry::bulkRemovePost()
+{
+    SWSS_LOG_ENTER();
+
+    if (!AclRule::bulkRemovePost())
+    {
+        return false;
+    }
+
+    // The ACL entry is gone, release the INT session as deactivate() does
+    if (INT_enabled && INT_session_valid)
+    {
+        if (!m_pDTelOrch->decreaseINTSessionRefCount(m_intSessionId))
+        {
+            SWSS_LOG_ERROR("Could not decrement INT session %s reference count", m_intSessionId.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void AclRuleDTelWatchListEntry::onUpdate(SubjectType type, void *cntx)
 {
     sai_acl_action_data_t actionData;
@@ -3353,6 +3787,29 @@ AclRange::AclRange(sai_acl_range_type_t type, sai_object_id_t oid, int min, int
     SWSS_LOG_ENTER();
 }
 
+bool AclRange::maxRangesReached()
+{
+    // work around to avoid syncd termination on SAI error due to max count of ranges reached
+    // can be removed when syncd start passing errors to the SAI callers
+    char *platform = getenv("platform");
+    if (!platform ||
+        !((strstr(platform, MLNX_PLATFORM_SUBSTRING) && m_ranges.size() >= MLNX_MAX_RANGES_COUNT) ||
+          (strstr(platform, CLX_PLATFORM_SUBSTRING) && m_ranges.size() >= CLNX_MAX_RANGES_COUNT)))
+    {
+        return false;
+    }
+
+    // Make room with the ranges kept unused
+    if (!m_unused.empty())
+    {
+        removeUnused(nullptr);
+        return maxRangesReached();
+    }
+
+    SWSS_LOG_ERROR("Maximum numbers of ACL ranges reached");
+    return true;
+}
+
 AclRange *AclRange::create(sai_acl_range_type_t type, int min, int max)
 {
     SWSS_LOG_ENTER();
@@ -3366,17 +3823,9 @@ AclRange *AclRange::create(sai_acl_range_type_t type, int min, int max)
         sai_attribute_t attr;
         vector<sai_attribute_t> range_attrs;
 
-        // work around to avoid syncd termination on SAI error due to max count of ranges reached
-        // can be removed when syncd start passing errors to the SAI callers
-        char *platform = getenv("platform");
-        if (platform)
+        if (maxRangesReached())
         {
-            if ((strstr(platform, MLNX_PLATFORM_SUBSTRING) && m_ranges.size() >= MLNX_MAX_RANGES_COUNT) ||
-                (strstr(platform, CLX_PLATFORM_SUBSTRING) && m_ranges.size() >= CLNX_MAX_RANGES_COUNT))
-            {
-                SWSS_LOG_ERROR("Maximum numbers of ACL ranges reached");
-                return NULL;
-            }
+            return NULL;
         }
 
         attr.id = SAI_ACL_RANGE_ATTR_TYPE;
@@ -3396,12 +3845,11 @@ AclRange *AclRange::create(sai_acl_range_type_t type, int min, int max)
         }
 
         SWSS_LOG_INFO("Created ACL Range object. Type: %d, range %d-%d, oid: %" PRIx64, type, min, max, range_oid);
-        m_ranges[rangeProperties] = new AclRange(type, range_oid, min, max);
-
-        range_it = m_ranges.find(rangeProperties);
+        range_it = m_ranges.emplace(rangeProperties, new AclRange(type, range_oid, min, max)).first;
     }
     else
     {
+        m_unused.erase(range_it->second);
         SWSS_LOG_INFO("Reusing range object oid %" PRIx64 " ref count increased to %d", range_it->second->m_oid, range_it->second->m_refCnt);
     }
 
@@ -3443,33 +3891,135 @@ bool AclRange::remove(sai_object_id_t *oids, int oidsCnt)
     return false;
 }
 
-bool AclRange::remove()
+AclRange *AclRange::create(sai_acl_range_type_t type, int min, int max, ObjectBulker<sai_acl_api_t> &bulker)
+{
+    SWSS_LOG_ENTER();
+
+    acl_range_properties_t rangeProperties = make_tuple(type, min, max);
+    auto range_it = m_ranges.find(rangeProperties);
+    if (range_it == m_ranges.end())
+    {
+        sai_attribute_t attr;
+        vector<sai_attribute_t> range_attrs;
+
+        if (maxRangesReached())
+        {
+            return NULL;
+        }
+
+        attr.id = SAI_ACL_RANGE_ATTR_TYPE;
+        attr.value.s32 = type;
+        range_attrs.push_back(attr);
+
+        attr.id = SAI_ACL_RANGE_ATTR_LIMIT;
+        attr.value.u32range.min = min;
+        attr.value.u32range.max = max;
+        range_attrs.push_back(attr);
+
+        auto *range = new AclRange(type, SAI_NULL_OBJECT_ID, min, max);
+        bulker.create_entry(&range->m_oid, &range->m_bulkStatus, (uint32_t)range_attrs.size(), range_attrs.data());
+
+        SWSS_LOG_INFO("Queued ACL Range object creation. Type: %d, range %d-%d", type, min, max);
+        range_it = m_ranges.emplace(rangeProperties, range).first;
+    }
+    else
+    {
+        m_unused.erase(range_it->second);
+        SWSS_LOG_INFO("Reusing range object oid %" PRIx64 " ref count increased to %d", range_it->second->m_oid, range_it->second->m_refCnt);
+    }
+
+    range_it->second->m_refCnt++;
+
+    return range_it->second;
+}
+
+void AclRange::release(AclRange *range, ObjectBulker<sai_acl_api_t> * /* bulker */)
 {
     SWSS_LOG_ENTER();
 
+    range->unref();
+}
+
+void AclRange::unref()
+{
     if ((--m_refCnt) < 0)
     {
         throw runtime_error("Invalid ACL Range refCnt!");
     }
 
-    if (m_refCnt == 0)
+    if (m_refCnt > 0)
     {
-        SWSS_LOG_INFO("Range object oid %" PRIx64 " ref count is %d, removing..", m_oid, m_refCnt);
-        if (sai_acl_api->remove_acl_range(m_oid) != SAI_STATUS_SUCCESS)
+        SWSS_LOG_INFO("Range object oid %" PRIx64 " ref count decreased to %d", m_oid, m_refCnt);
+        return;
+    }
+
+    if (m_oid == SAI_NULL_OBJECT_ID)
+    {
+        // Its bulk creation failed
+        m_ranges.erase(make_tuple(m_type, m_min, m_max));
+        delete this;
+        return;
+    }
+
+    SWSS_LOG_INFO("Range object oid %" PRIx64 " ref count is 0, kept until unused ranges are removed", m_oid);
+    m_unused.insert(this);
+}
+
+void AclRange::removeUnused(ObjectBulker<sai_acl_api_t> *bulker)
+{
+    SWSS_LOG_ENTER();
+
+    auto unused = std::move(m_unused);
+    m_unused.clear();
+
+    for (auto *range: unused)
+    {
+        if (bulker)
         {
-            SWSS_LOG_ERROR("Failed to delete ACL Range object oid: %" PRIx64, m_oid);
-            return false;
+            SWSS_LOG_INFO("Range object oid %" PRIx64 " is unused, queued for removal", range->m_oid);
+            bulker->remove_entry(&range->m_bulkStatus, range->m_oid);
+            m_bulkRemoved.push_back(range);
+            continue;
         }
-        auto range_it = m_ranges.find(make_tuple(m_type, m_min, m_max));
 
-        m_ranges.erase(range_it);
-        delete this;
+        SWSS_LOG_INFO("Range object oid %" PRIx64 " is unused, removing..", range->m_oid);
+        if (sai_acl_api->remove_acl_range(range->m_oid) != SAI_STATUS_SUCCESS)
+        {
+            // Tried again on the next removal
+            SWSS_LOG_ERROR("Failed to delete ACL Range object oid: %" PRIx64, range->m_oid);
+            m_unused.insert(range);
+            continue;
+        }
+
+        m_ranges.erase(make_tuple(range->m_type, range->m_min, range->m_max));
+        delete range;
     }
-    else
+}
+
+void AclRange::postBulkRemove()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto *range: m_bulkRemoved)
     {
-        SWSS_LOG_INFO("Range object oid %" PRIx64 " ref count decreased to %d", m_oid, m_refCnt);
+        if (range->m_bulkStatus != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to delete ACL Range object oid: %" PRIx64, range->m_oid);
+            m_unused.insert(range);
+            continue;
+        }
+
+        m_ranges.erase(make_tuple(range->m_type, range->m_min, range->m_max));
+        delete range;
     }
+    m_bulkRemoved.clear();
+}
 
+bool AclRange::remove()
+{
+    SWSS_LOG_ENTER();
+
+    unref();
     return true;
 }
 
@@ -3588,7 +4138,7 @@ void AclOrch::init(vector<TableConnector>& connectors, PortsOrch *portOrch, Mirr
         m_switchMetaDataCapabilities[TABLE_ACL_ENTRY_ATTR_META_CAPABLE] = "false";
         m_switchMetaDataCapabilities[TABLE_ACL_ENTRY_ACTION_META_CAPABLE] = "false";
 
-        status = sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_ACL_USER_META_DATA_RANGE, &capability);
+        status = querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_ACL_USER_META_DATA_RANGE, &capability);
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_WARN("Could not query ACL_USER_META_DATA_RANGE %d", status);
@@ -3632,7 +4182,7 @@ void AclOrch::init(vector<TableConnector>& connectors, PortsOrch *portOrch, Mirr
             }
             SWSS_LOG_NOTICE("ACL_USER_META_DATA_RANGE capability %d", capability.get_implemented);
         }
-        status = sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_ACL_ENTRY, SAI_ACL_ENTRY_ATTR_FIELD_ACL_USER_META, &capability);
+        status = querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_ACL_ENTRY, SAI_ACL_ENTRY_ATTR_FIELD_ACL_USER_META, &capability);
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_WARN("Could not query ACL_ENTRY_ATTR_FIELD_ACL_USER_META %d", status);
@@ -3646,7 +4196,7 @@ void AclOrch::init(vector<TableConnector>& connectors, PortsOrch *portOrch, Mirr
             SWSS_LOG_NOTICE("ACL_ENTRY_ATTR_FIELD_ACL_USER_META capability %d", capability.set_implemented);
         }
 
-        status = sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_ACL_ENTRY, SAI_ACL_ENTRY_ATTR_ACTION_SET_ACL_META_DATA, &capability);
+        status = querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_ACL_ENTRY, SAI_ACL_ENTRY_ATTR_ACTION_SET_ACL_META_DATA, &capability);
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_WARN("Could not query ACL_ENTRY_ATTR_ACTION_SET_ACL_META_DATA %d", status);
@@ -4154,10 +4704,10 @@ void AclOrch::queryAclActionAttrEnumValues(const string &action_name,
         values.count = static_cast<uint32_t>(values_list.size());
         values.list = values_list.data();
 
-        auto status = sai_query_attribute_enum_values_capability(gSwitchId,
-                                                                 SAI_OBJECT_TYPE_ACL_ENTRY,
-                                                                 acl_attr,
-                                                                 &values);
+        auto status = querySaiAttributeEnumValuesCapability(gSwitchId,
+                                                            SAI_OBJECT_TYPE_ACL_ENTRY,
+                                                            acl_attr,
+                                                            &values);
         if (status == SAI_STATUS_SUCCESS)
         {
             for (size_t i = 0; i < values.count; i++)
@@ -4211,10 +4761,18 @@ AclOrch::AclOrch(vector<TableConnector>& connectors, DBConnector* stateDb, Switc
             StatsMode::READ,
             ACL_COUNTER_DEFAULT_POLLING_INTERVAL_MS,
             ACL_COUNTER_DEFAULT_ENABLED_STATE
-        )
+        ),
+        m_aclEntryBulker(sai_acl_api, gSwitchId, gMaxBulkSize, SAI_OBJECT_TYPE_ACL_ENTRY),
+        m_aclCounterBulker(sai_acl_api, gSwitchId, gMaxBulkSize, SAI_OBJECT_TYPE_ACL_COUNTER),
+        m_aclRangeBulker(sai_acl_api, gSwitchId, gMaxBulkSize, SAI_OBJECT_TYPE_ACL_RANGE)
 {
     SWSS_LOG_ENTER();
 
+    /* Rules fail one by one, a failed rule must not hold back the others of its bulk */
+    m_aclEntryBulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+    m_aclCounterBulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+    m_aclRangeBulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+
     init(connectors, portOrch, mirrorOrch, neighOrch, routeOrch);
 
     /* Initialize retry caches for rule consumers so that resource-exhaustion
@@ -4241,6 +4799,20 @@ AclOrch::~AclOrch()
     deleteDTelWatchListTables();
 }
 
+void AclOrch::getObjectCounts(vector<FieldValueTuple> &counts) const
+{
+    size_t rules = 0;
+    for (const auto &table : m_AclTables)
+    {
+        rules += table.second.rules.size();
+    }
+
+    counts.emplace_back("acl_tables", to_string(m_AclTables.size()));
+    counts.emplace_back("acl_rules", to_string(rules));
+    counts.emplace_back("acl_rule_updates", to_string(m_ruleUpdates));
+    counts.emplace_back("acl_rule_update_fallbacks", to_string(m_ruleUpdateFallbacks));
+}
+
 void AclOrch::update(SubjectType type, void *cntx)
 {
     SWSS_LOG_ENTER();
@@ -4281,6 +4853,8 @@ void AclOrch::doTask(Consumer &consumer)
 
     string table_name = consumer.getTableName();
 
+    m_batchCounters = true;
+
     if (table_name == CFG_ACL_TABLE_TABLE_NAME || table_name == APP_ACL_TABLE_TABLE_NAME)
     {
         doAclTableTask(consumer);
@@ -4297,6 +4871,25 @@ void AclOrch::doTask(Consumer &consumer)
     {
         SWSS_LOG_ERROR("Invalid table %s", table_name.c_str());
     }
+
+    m_batchCounters = false;
+    flushCounters();
+    removeUnusedRanges();
+}
+
+void AclOrch::removeUnusedRanges()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_bulkRules)
+    {
+        AclRange::removeUnused(nullptr);
+        return;
+    }
+
+    AclRange::removeUnused(&m_aclRangeBulker);
+    m_aclRangeBulker.flush();
+    AclRange::postBulkRemove();
 }
 
 void AclOrch::getAddDeletePorts(AclTable    &newT,
@@ -4990,6 +5583,68 @@ bool AclOrch::addAclRule(shared_ptr<AclRule> newRule, string table_id)
     return status;
 }
 
+void AclOrch::addAclRules(const vector<shared_ptr<AclRule>>& aclRules, vector<bool>& results)
+{
+    SWSS_LOG_ENTER();
+
+    results.assign(aclRules.size(), false);
+
+    // Rules replacing an existing one or using EGR_SET_DSCP are left to addAclRule()
+    vector<size_t> queued;
+    for (size_t i = 0; i < aclRules.size(); i++)
+    {
+        const auto& rule = aclRules[i];
+        const auto& table_id = rule->getTableId();
+        sai_object_id_t table_oid = getTableById(table_id);
+
+        if (!m_bulkRules || !rule->isBulkSupported() || isUsingEgrSetDscp(table_id) ||
+            table_oid == SAI_NULL_OBJECT_ID || m_AclTables[table_oid].rules.count(rule->getId()))
+        {
+            results[i] = addAclRule(rule, table_id);
+            continue;
+        }
+
+        rule->bulkCreateDependencies(m_aclCounterBulker, m_aclRangeBulker);
+        queued.push_back(i);
+    }
+
+    if (queued.empty())
+    {
+        return;
+    }
+
+    m_aclCounterBulker.flush();
+    m_aclRangeBulker.flush();
+
+    for (auto i: queued)
+    {
+        aclRules[i]->bulkCreateRule(m_aclEntryBulker);
+    }
+    m_aclEntryBulker.flush();
+
+    for (auto i: queued)
+    {
+        const auto& rule = aclRules[i];
+        const auto& table_id = rule->getTableId();
+
+        if (!rule->bulkCreatePost())
+        {
+            SWSS_LOG_ERROR("Failed to create ACL rule %s in table %s",
+                    rule->getId().c_str(), table_id.c_str());
+            continue;
+        }
+
+        m_AclTables[getTableById(table_id)].rules[rule->getId()] = rule;
+        SWSS_LOG_NOTICE("Successfully created ACL rule %s in table %s",
+                rule->getId().c_str(), table_id.c_str());
+        if (rule->hasCounter())
+        {
+            registerFlexCounter(*rule);
+        }
+        results[i] = true;
+    }
+}
+
 bool AclOrch::removeAclRule(string table_id, string rule_id)
 {
     string key = table_id + ":" + rule_id;
@@ -5047,7 +5702,6 @@ bool AclOrch::updateAclRule(string table_id, string rule_id, string attr_name, v
     SWSS_LOG_ENTER();
 
     sai_object_id_t table_oid = getTableById(table_id);
-    string attr_value;
 
     if (table_oid == SAI_NULL_OBJECT_ID)
     {
@@ -5067,47 +5721,74 @@ bool AclOrch::updateAclRule(string table_id, string rule_id, string attr_name, v
         case SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS:
         {
             sai_object_id_t port_oid = *(sai_object_id_t *)data;
-            vector<sai_object_id_t> in_ports = rule_it->second->getInPorts();
+            return updateAclRuleInPorts(table_id, rule_id, { port_oid }, oper);
+        }
 
-            if (oper == RULE_OPER_ADD)
-            {
-                in_ports.push_back(port_oid);
-            }
-            else
-            {
-                for (auto port_iter = in_ports.begin(); port_iter != in_ports.end(); port_iter++)
-                {
-                    if (*port_iter == port_oid)
-                    {
-                        in_ports.erase(port_iter);
-                        break;
-                    }
-                }
-            }
+        default:
+            SWSS_LOG_ERROR("Acl rule update not supported for attr name %s", attr_name.c_str());
+        break;
+    }
+
+    return true;
+}
+
+bool AclOrch::updateAclRuleInPorts(string table_id, string rule_id, const vector<sai_object_id_t> &ports, bool oper)
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_id_t table_oid = getTableById(table_id);
+    string attr_value;
+
+    if (table_oid == SAI_NULL_OBJECT_ID)
+    {
+        SWSS_LOG_ERROR("Failed to update ACL rule in ACL table %s. Table doesn't exist", table_id.c_str());
+        return false;
+    }
 
-            for (const auto& port_iter: in_ports)
-            {
-                Port p;
-                gPortsOrch->getPort(port_iter, p);
-                attr_value += p.m_alias;
-                attr_value += ',';
-            }
+    auto rule_it = m_AclTables[table_oid].rules.find(rule_id);
+    if (rule_it == m_AclTables[table_oid].rules.end())
+    {
+        SWSS_LOG_ERROR("Failed to update ACL rule in ACL table %s. Rule doesn't exist", rule_id.c_str());
+        return false;
+    }
+
+    // All the ports are applied with a single update of the rule
+    vector<sai_object_id_t> in_ports = rule_it->second->getInPorts();
+
+    for (auto port_oid: ports)
+    {
+        if (oper == RULE_OPER_ADD)
+        {
+            in_ports.push_back(port_oid);
+            continue;
+        }
 
-            if (!attr_value.empty())
+        for (auto port_iter = in_ports.begin(); port_iter != in_ports.end(); port_iter++)
+        {
+            if (*port_iter == port_oid)
             {
-                attr_value.pop_back();
+                in_ports.erase(port_iter);
+                break;
             }
-
-            rule_it->second->validateAddMatch(MATCH_IN_PORTS, attr_value);
-            rule_it->second->updateInPorts();
         }
-        break;
+    }
 
-        default:
-            SWSS_LOG_ERROR("Acl rule update not supported for attr name %s", attr_name.c_str());
-        break;
+    for (const auto& port_iter: in_ports)
+    {
+        Port p;
+        gPortsOrch->getPort(port_iter, p);
+        attr_value += p.m_alias;
+        attr_value += ',';
+    }
+
+    if (!attr_value.empty())
+    {
+        attr_value.pop_back();
     }
 
+    rule_it->second->validateAddMatch(MATCH_IN_PORTS, attr_value);
+    rule_it->second->updateInPorts();
+
     return true;
 }
 
@@ -5518,6 +6199,311 @@ void AclOrch::doAclTableTask(Consumer &consumer)
     }
 }
 
+bool AclOrch::handleRuleCreateFailure(Consumer &consumer, SyncMap::iterator task, const string &table_id,
+                                      const string &rule_id, sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
+    setAclRuleStatus(table_id, rule_id, AclObjectStatus::PENDING_CREATION);
+
+    if (!isSaiStatusResourceFull(status))
+    {
+        return false;
+    }
+
+    /* Park resource-exhaustion failures in the retry cache.
+     * They will be re-queued when resources are freed (i.e.,
+     * when an ACL rule is successfully removed from this table). */
+    SWSS_LOG_WARN("ACL rule %s in table %s failed due to resource exhaustion, parking for retry",
+            rule_id.c_str(), table_id.c_str());
+    auto cst = make_constraint(RETRY_CST_SAI_RESOURCE, table_id);
+    if (consumer.addToRetry(task->second, cst))
+    {
+        return true;
+    }
+
+    SWSS_LOG_ERROR("Failed to park ACL rule %s in table %s in retry cache",
+            rule_id.c_str(), table_id.c_str());
+    return false;
+}
+
+bool AclOrch::queueBulkRuleCreate(SyncMap::iterator task, const string &table_id,
+                                  const string &rule_id, shared_ptr<AclRule> rule)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_bulkRules || !rule->isBulkSupported() || isUsingEgrSetDscp(table_id))
+    {
+        return false;
+    }
+
+    // Overwriting a rule removes the old one first, leave that to AclTable::add()
+    sai_object_id_t table_oid = getTableById(table_id);
+    if (table_oid == SAI_NULL_OBJECT_ID || m_AclTables[table_oid].rules.count(rule_id))
+    {
+        return false;
+    }
+
+    AclRuleBulkContext ctx;
+    ctx.task = task;
+    ctx.table_id = table_id;
+    ctx.rule_id = rule_id;
+    ctx.rule = rule;
+    ctx.remove = false;
+    m_ruleBulk.push_back(ctx);
+    m_ruleBulkKeys.insert(table_id + ":" + rule_id);
+
+    return true;
+}
+
+bool AclOrch::queueBulkRuleRemove(SyncMap::iterator task, const string &table_id, const string &rule_id)
+{
+    SWSS_LOG_ENTER();
+
+    string key = table_id + ":" + rule_id;
+    if (!m_bulkRules || m_egrDscpRuleMetadata.find(key) != m_egrDscpRuleMetadata.end())
+    {
+        return false;
+    }
+
+    sai_object_id_t table_oid = getTableById(table_id);
+    if (table_oid == SAI_NULL_OBJECT_ID)
+    {
+        return false;
+    }
+
+    auto rule_it = m_AclTables[table_oid].rules.find(rule_id);
+    if (rule_it == m_AclTables[table_oid].rules.end() || !rule_it->second->isBulkSupported())
+    {
+        return false;
+    }
+
+    if (rule_it->second->hasCounter())
+    {
+        deregisterFlexCounter(*rule_it->second);
+    }
+
+    AclRuleBulkContext ctx;
+    ctx.task = task;
+    ctx.table_id = table_id;
+    ctx.rule_id = rule_id;
+    ctx.rule = rule_it->second;
+    ctx.remove = true;
+    m_ruleBulk.push_back(ctx);
+    m_ruleBulkKeys.insert(key);
+
+    return true;
+}
+
+bool AclOrch::queueBulkRuleUpdate(SyncMap::iterator task, const string &table_id,
+                                  const string &rule_id, shared_ptr<AclRule> rule)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_bulkRules)
+    {
+        return false;
+    }
+
+    sai_object_id_t table_oid = getTableById(table_id);
+    if (table_oid == SAI_NULL_OBJECT_ID)
+    {
+        return false;
+    }
+
+    // Counter and range changes create and remove objects, they are updated by updateRuleInPlace()
+    auto rule_it = m_AclTables[table_oid].rules.find(rule_id);
+    if (rule_it == m_AclTables[table_oid].rules.end() ||
+        !rule_it->second->isUpdateSupported(*rule) ||
+        !rule_it->second->isBulkUpdateSupported(*rule))
+    {
+        return false;
+    }
+
+    AclRuleBulkContext ctx;
+    ctx.task = task;
+    ctx.table_id = table_id;
+    ctx.rule_id = rule_id;
+    ctx.rule = rule_it->second;
+    ctx.remove = false;
+    ctx.update = true;
+    ctx.updatedRule = rule;
+    m_ruleBulk.push_back(ctx);
+    m_ruleBulkKeys.insert(table_id + ":" + rule_id);
+
+    return true;
+}
+
+bool AclOrch::updateRuleInPlace(const string &table_id, shared_ptr<AclRule> rule)
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_id_t table_oid = getTableById(table_id);
+    if (table_oid == SAI_NULL_OBJECT_ID)
+    {
+        return false;
+    }
+
+    auto& table = m_AclTables[table_oid];
+    auto rule_it = table.rules.find(rule->getId());
+    if (rule_it == table.rules.end())
+    {
+        return false;
+    }
+
+    if (!rule_it->second->isUpdateSupported(*rule) || !table.updateRule(rule))
+    {
+        // A partially updated rule is replaced as a whole
+        SWSS_LOG_INFO("ACL rule %s in table %s can't be updated in place, replacing it",
+                rule->getId().c_str(), table_id.c_str());
+        m_ruleUpdateFallbacks++;
+        return false;
+    }
+
+    SWSS_LOG_NOTICE("Successfully updated ACL rule %s in table %s",
+            rule->getId().c_str(), table_id.c_str());
+    m_ruleUpdates++;
+    return true;
+}
+
+void AclOrch::flushRuleBulk(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_ruleBulk.empty())
+    {
+        return;
+    }
+
+    // Removal: the ACL entries first, then the counters and ranges they referred to
+    for (auto& ctx: m_ruleBulk)
+    {
+        if (ctx.remove)
+        {
+            ctx.rule->bulkRemoveRule(m_aclEntryBulker);
+        }
+    }
+    m_aclEntryBulker.flush();
+
+    for (auto& ctx: m_ruleBulk)
+    {
+        if (ctx.remove)
+        {
+            ctx.entryRemoved = ctx.rule->bulkRemoveDependencies(m_aclCounterBulker, m_aclRangeBulker);
+        }
+    }
+    m_aclCounterBulker.flush();
+
+    // Update: the attributes which changed, set on the existing ACL entries
+    for (auto& ctx: m_ruleBulk)
+    {
+        if (ctx.update)
+        {
+            ctx.rule->bulkUpdateRule(*ctx.updatedRule, m_aclEntryBulker);
+        }
+    }
+    m_aclEntryBulker.flush();
+
+    // Creation: the counters and ranges first, then the ACL entries referring to them
+    for (auto& ctx: m_ruleBulk)
+    {
+        if (!ctx.remove && !ctx.update)
+        {
+            ctx.rule->bulkCreateDependencies(m_aclCounterBulker, m_aclRangeBulker);
+        }
+    }
+    m_aclCounterBulker.flush();
+    m_aclRangeBulker.flush();
+
+    for (auto& ctx: m_ruleBulk)
+    {
+        if (!ctx.remove && !ctx.update)
+        {
+            ctx.rule->bulkCreateRule(m_aclEntryBulker);
+        }
+    }
+    m_aclEntryBulker.flush();
+
+    for (auto& ctx: m_ruleBulk)
+    {
+        sai_object_id_t table_oid = getTableById(ctx.table_id);
+        auto& table = m_AclTables[table_oid];
+
+        if (ctx.update)
+        {
+            if (ctx.rule->bulkUpdatePost(*ctx.updatedRule))
+            {
+                SWSS_LOG_NOTICE("Successfully updated ACL rule %s in table %s",
+                        ctx.rule_id.c_str(), ctx.table_id.c_str());
+                m_ruleUpdates++;
+                setAclRuleStatus(ctx.table_id, ctx.rule_id, AclObjectStatus::ACTIVE);
+                consumer.m_toSync.erase(ctx.task);
+                continue;
+            }
+
+            // A partially updated rule is replaced as a whole
+            m_ruleUpdateFallbacks++;
+            if (addAclRule(ctx.updatedRule, ctx.table_id))
+            {
+                setAclRuleStatus(ctx.table_id, ctx.rule_id, AclObjectStatus::ACTIVE);
+                consumer.m_toSync.erase(ctx.task);
+            }
+            else if (handleRuleCreateFailure(consumer, ctx.task, ctx.table_id, ctx.rule_id,
+                                             ctx.updatedRule->getLastSaiStatus()))
+            {
+                consumer.m_toSync.erase(ctx.task);
+            }
+        }
+        else if (!ctx.remove)
+        {
+            if (ctx.rule->bulkCreatePost())
+            {
+                table.rules[ctx.rule_id] = ctx.rule;
+                SWSS_LOG_NOTICE("Successfully created ACL rule %s in table %s",
+                        ctx.rule_id.c_str(), ctx.table_id.c_str());
+                if (ctx.rule->hasCounter())
+                {
+                    registerFlexCounter(*ctx.rule);
+                }
+                setAclRuleStatus(ctx.table_id, ctx.rule_id, AclObjectStatus::ACTIVE);
+                consumer.m_toSync.erase(ctx.task);
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Failed to create ACL rule %s in table %s",
+                        ctx.rule_id.c_str(), ctx.table_id.c_str());
+                if (handleRuleCreateFailure(consumer, ctx.task, ctx.table_id, ctx.rule_id, ctx.rule->getLastSaiStatus()))
+                {
+                    consumer.m_toSync.erase(ctx.task);
+                }
+            }
+        }
+        else
+        {
+            if (ctx.entryRemoved && ctx.rule->bulkRemovePost())
+            {
+                table.rules.erase(ctx.rule_id);
+                SWSS_LOG_NOTICE("Successfully deleted ACL rule %s in table %s",
+                        ctx.rule_id.c_str(), ctx.table_id.c_str());
+                removeAclRuleStatus(ctx.table_id, ctx.rule_id);
+                consumer.m_toSync.erase(ctx.task);
+
+                notifyRetry(this, consumer.getTableName(), make_constraint(RETRY_CST_SAI_RESOURCE, ctx.table_id));
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Failed to delete ACL rule %s in table %s",
+                        ctx.rule_id.c_str(), ctx.table_id.c_str());
+                // Mark pending removal status if the removal fails
+                setAclRuleStatus(ctx.table_id, ctx.rule_id, AclObjectStatus::PENDING_REMOVAL);
+            }
+        }
+    }
+
+    m_ruleBulk.clear();
+    m_ruleBulkKeys.clear();
+}
+
 void AclOrch::doAclRuleTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
@@ -5534,6 +6520,12 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
 
         SWSS_LOG_INFO("OP: %s, TABLE_ID: %s, RULE_ID: %s", op.c_str(), table_id.c_str(), rule_id.c_str());
 
+        // Tasks of a rule are applied in order, program the pending ones of this rule first
+        if (m_ruleBulkKeys.count(table_id + ":" + rule_id))
+        {
+            flushRuleBulk(consumer);
+        }
+
         if (table_id.empty())
         {
             SWSS_LOG_WARN("ACL rule with RULE_ID: %s is not valid as TABLE_ID is empty", rule_id.c_str());
@@ -5582,6 +6574,7 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             {
                 SWSS_LOG_ERROR("Error while creating ACL rule %s: %s", rule_id.c_str(), e.what());
                 it = consumer.m_toSync.erase(it);
+                flushRuleBulk(consumer);
                 return;
             }
             bool bHasTCPFlag = false;
@@ -5666,35 +6659,32 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             // validate and create ACL rule
             if (bAllAttributesOk && newRule->validate())
             {
-                if (addAclRule(newRule, table_id))
+                if (queueBulkRuleUpdate(it, table_id, rule_id, newRule) ||
+                    queueBulkRuleCreate(it, table_id, rule_id, newRule))
+                {
+                    // Programmed by flushRuleBulk()
+                    it++;
+                    continue;
+                }
+
+                flushRuleBulk(consumer);
+
+                if (updateRuleInPlace(table_id, newRule))
                 {
                     setAclRuleStatus(table_id, rule_id, AclObjectStatus::ACTIVE);
                     it = consumer.m_toSync.erase(it);
                 }
-                else if (isSaiStatusResourceFull(newRule->getLastSaiStatus()))
+                else if (addAclRule(newRule, table_id))
                 {
-                    /* Park resource-exhaustion failures in the retry cache.
-                     * They will be re-queued when resources are freed (i.e.,
-                     * when an ACL rule is successfully removed from this table). */
-                    SWSS_LOG_WARN("ACL rule %s in table %s failed due to resource exhaustion, parking for retry",
-                            rule_id.c_str(), table_id.c_str());
-                    auto cst = make_constraint(RETRY_CST_SAI_RESOURCE, table_id);
-                    if (consumer.addToRetry(it->second, cst))
-                    {
-                        setAclRuleStatus(table_id, rule_id, AclObjectStatus::PENDING_CREATION);
-                        it = consumer.m_toSync.erase(it);
-                    }
-                    else
-                    {
-                        SWSS_LOG_ERROR("Failed to park ACL rule %s in table %s in retry cache",
-                                rule_id.c_str(), table_id.c_str());
-                        setAclRuleStatus(table_id, rule_id, AclObjectStatus::PENDING_CREATION);
-                        it++;
-                    }
+                    setAclRuleStatus(table_id, rule_id, AclObjectStatus::ACTIVE);
+                    it = consumer.m_toSync.erase(it);
+                }
+                else if (handleRuleCreateFailure(consumer, it, table_id, rule_id, newRule->getLastSaiStatus()))
+                {
+                    it = consumer.m_toSync.erase(it);
                 }
                 else
                 {
-                    setAclRuleStatus(table_id, rule_id, AclObjectStatus::PENDING_CREATION);
                     it++;
                 }
             }
@@ -5708,6 +6698,15 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
         }
         else if (op == DEL_COMMAND)
         {
+            if (queueBulkRuleRemove(it, table_id, rule_id))
+            {
+                // Removed by flushRuleBulk()
+                it++;
+                continue;
+            }
+
+            flushRuleBulk(consumer);
+
             bool ruleExisted = (getAclRule(table_id, rule_id) != nullptr);
             if (removeAclRule(table_id, rule_id))
             {
@@ -5734,6 +6733,8 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
         }
     }
+
+    flushRuleBulk(consumer);
 }
 
 void AclOrch::doAclTableTypeTask(Consumer &consumer)
@@ -6022,31 +7023,78 @@ void AclOrch::registerFlexCounter(const AclRule& rule)
 {
     SWSS_LOG_ENTER();
 
-    auto ruleIdentifier = generateAclRuleIdentifierInCountersDb(rule);
-    auto counterOidStr = sai_serialize_object_id(rule.getCounterOid());
-
-    unordered_set<string> serializedCounterStatAttrs;
-    for (const auto& counterAttrPair: aclCounterLookup)
+    static const unordered_set<string> serializedCounterStatAttrs = []()
     {
-        sai_acl_counter_attr_t id {};
-        tie(std::ignore, id) = counterAttrPair;
-        auto meta = sai_metadata_get_attr_metadata(SAI_OBJECT_TYPE_ACL_COUNTER, id);
-        if (!meta)
+        unordered_set<string> attrs;
+        for (const auto& counterAttrPair: aclCounterLookup)
         {
-            SWSS_LOG_THROW("SAI Bug: Failed to get metadata of attribute %d for SAI_OBJECT_TYPE_ACL_COUNTER", id);
+            sai_acl_counter_attr_t id {};
+            tie(std::ignore, id) = counterAttrPair;
+            auto meta = sai_metadata_get_attr_metadata(SAI_OBJECT_TYPE_ACL_COUNTER, id);
+            if (!meta)
+            {
+                SWSS_LOG_THROW("SAI Bug: Failed to get metadata of attribute %d for SAI_OBJECT_TYPE_ACL_COUNTER", id);
+            }
+            attrs.insert(sai_serialize_attr_id(*meta));
         }
-        serializedCounterStatAttrs.insert(sai_serialize_attr_id(*meta));
-    }
+        return attrs;
+    }();
 
     m_flex_counter_manager.setCounterIdList(rule.getCounterOid(), CounterType::ACL_COUNTER, serializedCounterStatAttrs);
-    m_countersDb.hset(COUNTERS_ACL_COUNTER_RULE_MAP, ruleIdentifier, counterOidStr);
+    m_counterRuleMapPending[generateAclRuleIdentifierInCountersDb(rule)] = sai_serialize_object_id(rule.getCounterOid());
+
+    if (!m_batchCounters)
+    {
+        flushCounters();
+    }
 }
 
 void AclOrch::deregisterFlexCounter(const AclRule& rule)
 {
-    auto ruleIdentifier = generateAclRuleIdentifierInCountersDb(rule);
-    m_countersDb.hdel(COUNTERS_ACL_COUNTER_RULE_MAP, ruleIdentifier);
+    m_counterRuleMapPending[generateAclRuleIdentifierInCountersDb(rule)] = "";
     m_flex_counter_manager.clearCounterIdList(rule.getCounterOid());
+
+    if (!m_batchCounters)
+    {
+        flushCounters();
+    }
+}
+
+void AclOrch::flushCounters()
+{
+    SWSS_LOG_ENTER();
+
+    m_flex_counter_manager.flush();
+
+    if (m_counterRuleMapPending.empty())
+    {
+        return;
+    }
+
+    // One HSET for the rules added, the removed ones sent along
+    vector<FieldValueTuple> added;
+    RedisPipeline pipeline(&m_countersDb);
+    Table writer(&pipeline, COUNTERS_ACL_COUNTER_RULE_MAP, true);
+
+    for (const auto& it: m_counterRuleMapPending)
+    {
+        if (it.second.empty())
+        {
+            writer.hdel("", it.first);
+        }
+        else
+        {
+            added.emplace_back(it.first, it.second);
+        }
+    }
+
+    if (!added.empty())
+    {
+        writer.set("", added);
+    }
+    pipeline.flush();
+
+    m_counterRuleMapPending.clear();
 }
 
 string AclOrch::generateAclRuleIdentifierInCountersDb(const AclRule& rule) const
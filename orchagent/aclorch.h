@@ -7,6 +7,8 @@
 #include <mutex>
 #include <tuple>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <condition_variable>
 
 #include "orch.h"
@@ -17,10 +19,13 @@
 #include "observer.h"
 #include "vxlanorch.h"
 #include "flex_counter_manager.h"
+#include "bulker.h"
 
 #include "acltable.h"
 
 #include "saiattr.h"
+#include "saiattrlist.h"
+#include "memaccounting.h"
 
 #define RULE_PRIORITY           "PRIORITY"
 #define MATCH_IN_PORTS          "IN_PORTS"
@@ -160,6 +165,36 @@ typedef map<string, acl_stage_action_list_t> acl_table_action_list_lookup_t;
 typedef map<acl_stage_type_t, set<sai_acl_table_attr_t> > acl_stage_match_field_t;
 typedef map<string, acl_stage_match_field_t> acl_table_match_field_lookup_t;
 
+// How the value of a rule match is parsed, see AclRule::validateAddMatch()
+enum class AclMatchFormat
+{
+    BOOL,
+    MAC,
+    PORT,
+    PORT_LIST,
+    IP_TYPE,
+    U8,
+    U8_6BIT_MASKED,
+    U8_MASKED,
+    U16,
+    VLAN_ID,
+    U32,
+    METADATA,
+    IPV4,
+    IPV6,
+    RANGE,
+};
+
+struct AclMatchTemplate
+{
+    sai_acl_entry_attr_t attr;
+    AclMatchFormat format;
+    // IP_PROTOCOL given to an IPv6 table, matched as NEXT_HEADER
+    bool deprecated;
+};
+
+typedef unordered_map<string, AclMatchTemplate> acl_match_template_lookup_t;
+
 class AclRule;
 
 class AclTableMatchInterface
@@ -224,13 +259,23 @@ public:
     bool addAction(sai_acl_action_type_t action);
     bool addMatch(shared_ptr<AclTableMatchInterface> match);
 
+    /*
+     * Rule match of the given name resolved to its SAI attribute and value format,
+     * compiled once per table type so building a rule doesn't compare the name of
+     * each of its matches against every known match. Null for an unknown match.
+     */
+    const AclMatchTemplate* getMatchTemplate(const string& name) const;
+
 private:
     friend class AclTableTypeBuilder;
 
+    void compileMatchTemplates();
+
     string m_name;
     set<sai_acl_bind_point_type_t> m_bpointTypes;
     map<sai_acl_table_attr_t, shared_ptr<AclTableMatchInterface>> m_matches;
     set<sai_acl_action_type_t> m_aclAcitons;
+    acl_match_template_lookup_t m_matchTemplates;
 };
 
 class AclTableTypeBuilder
@@ -268,12 +313,45 @@ struct AclRangeConfig
     uint32_t max;
 };
 
+struct AclRangeHash
+{
+    size_t operator()(const acl_range_properties_t &key) const
+    {
+        return hash<uint64_t>()((static_cast<uint64_t>(get<0>(key)) << 40) ^
+                                (static_cast<uint64_t>(static_cast<uint32_t>(get<1>(key))) << 20) ^
+                                static_cast<uint32_t>(get<2>(key)));
+    }
+};
+
+/*
+ * Range objects are shared by the rules matching on the same range and
+ * refcounted. A range no longer referred to is kept until removeUnused(), so
+ * a rule removed and added again, or updated, within a batch takes the same
+ * object back instead of removing and creating it again.
+ */
 class AclRange
 {
 public:
     static AclRange *create(sai_acl_range_type_t type, int min, int max);
     static bool remove(sai_acl_range_type_t type, int min, int max);
     static bool remove(sai_object_id_t *oids, int oidsCnt);
+
+    /*
+     * Bulk variants, a new range object is only created on flush of the
+     * bulker. The oid of a range whose creation failed is null after the
+     * flush. Release drops the reference right away.
+     */
+    static AclRange *create(sai_acl_range_type_t type, int min, int max, ObjectBulker<sai_acl_api_t> &bulker);
+    static void release(AclRange *range, ObjectBulker<sai_acl_api_t> *bulker);
+
+    /*
+     * Remove the ranges no longer referred to, on flush of the bulker or
+     * synchronously if no bulker is given
+     */
+    static void removeUnused(ObjectBulker<sai_acl_api_t> *bulker);
+    /* Drop the ranges removed by the last flush of the bulker given to removeUnused() */
+    static void postBulkRemove();
+
     sai_object_id_t getOid()
     {
         return m_oid;
@@ -282,16 +360,24 @@ public:
 private:
     AclRange(sai_acl_range_type_t type, sai_object_id_t oid, int min, int max);
     bool remove();
+    void unref();
+    static bool maxRangesReached();
     sai_object_id_t m_oid;
     int m_refCnt;
     int m_min;
     int m_max;
     sai_acl_range_type_t m_type;
-    static map<acl_range_properties_t, AclRange*> m_ranges;
+    sai_status_t m_bulkStatus = SAI_STATUS_SUCCESS;
+    static unordered_map<acl_range_properties_t, AclRange*, AclRangeHash> m_ranges;
+    static unordered_set<AclRange*> m_unused;
+    static vector<AclRange*> m_bulkRemoved;
 };
 
 class AclTable;
 
+/* Attributes of one ACL entry, the table, priority, admin state, counter and ranges, then the matches and actions */
+typedef SaiAttrList<32> AclRuleAttrs;
+
 class AclRule
 {
 public:
@@ -332,6 +418,32 @@ public:
     virtual bool enableCounter();
     virtual bool disableCounter();
 
+    /*
+     * Bulk creation and removal through the bulkers of AclOrch, see AclOrch::flushRuleBulk().
+     * Creation queues the counter and ranges, then the ACL entry once they exist.
+     * Removal queues the ACL entry, then the counter and ranges once it is gone.
+     * Rules doing more than that on create() or remove() must not support it, unless the
+     * rest can be done once the rule is gone, by an override of bulkRemovePost().
+     */
+    virtual bool isBulkSupported() const { return true; }
+    void bulkCreateDependencies(ObjectBulker<sai_acl_api_t> &counterBulker, ObjectBulker<sai_acl_api_t> &rangeBulker);
+    bool bulkCreateRule(ObjectBulker<sai_acl_api_t> &entryBulker);
+    bool bulkCreatePost();
+    void bulkRemoveRule(ObjectBulker<sai_acl_api_t> &entryBulker);
+    bool bulkRemoveDependencies(ObjectBulker<sai_acl_api_t> &counterBulker, ObjectBulker<sai_acl_api_t> &rangeBulker);
+    virtual bool bulkRemovePost();
+
+    /*
+     * In place update to the configuration of a rule set again, see AclOrch::updateRuleInPlace().
+     * Rules holding references beyond their SAI objects, e.g. to a redirect next hop, must not
+     * support it and are replaced instead. A bulk update only sets the priority, matches and
+     * actions which changed, the counter and ranges of the rule are left as they are.
+     */
+    virtual bool isUpdateSupported(const AclRule& updatedRule) const;
+    bool isBulkUpdateSupported(const AclRule& updatedRule) const;
+    void bulkUpdateRule(const AclRule& updatedRule, ObjectBulker<sai_acl_api_t> &entryBulker);
+    bool bulkUpdatePost(const AclRule& updatedRule);
+
     sai_status_t getLastSaiStatus() const { return m_lastSaiStatus; }
 
     string getId() const;
@@ -363,6 +475,7 @@ protected:
     virtual bool updateMatches(const AclRule& updatedRule);
     virtual bool updateActions(const AclRule& updatedRule);
     virtual bool updateCounter(const AclRule& updatedRule);
+    virtual bool updateRanges(const AclRule& updatedRule);
 
     virtual bool setPriority(const sai_uint32_t &value);
     virtual bool setAction(sai_acl_entry_attr_t actionId, sai_acl_action_data_t actionData);
@@ -372,6 +485,10 @@ protected:
 
     void decreaseNextHopRefCount();
 
+    void getCounterAttrs(SaiAttrList<> &counter_attrs) const;
+    void getRuleAttrs(AclRuleAttrs &rule_attrs, const sai_object_list_t &range_object_list);
+    void releaseRanges(ObjectBulker<sai_acl_api_t> *rangeBulker);
+
     bool isActionSupported(sai_acl_entry_attr_t) const;
 
     static sai_uint32_t m_minPriority;
@@ -392,6 +509,15 @@ protected:
     vector<AclRange*> m_ranges;
     sai_status_t m_lastSaiStatus = SAI_STATUS_SUCCESS;
 
+    // State of a pending bulk creation or removal
+    sai_status_t m_bulkStatus = SAI_STATUS_SUCCESS;
+    sai_status_t m_bulkCounterStatus = SAI_STATUS_SUCCESS;
+    bool m_bulkEntryQueued = false;
+    bool m_bulkCounterQueued = false;
+    bool m_bulkFailed = false;
+    vector<sai_object_id_t> m_bulkRangeOids;
+    vector<sai_status_t> m_bulkUpdateStatuses;
+
 private:
     bool m_createCounter;
 };
@@ -429,6 +555,8 @@ public:
     bool createRule();
     bool removeRule();
     void onUpdate(SubjectType, void *) override;
+    bool isBulkSupported() const override { return false; }
+    bool isUpdateSupported(const AclRule&) const override { return false; }
 
     bool activate();
     bool deactivate();
@@ -449,6 +577,10 @@ public:
     bool createRule();
     bool removeRule();
     void onUpdate(SubjectType, void *) override;
+    // An INT watchlist waiting for its session has no ACL entry to bulk
+    bool isBulkSupported() const override { return !INT_enabled || INT_session_valid; }
+    bool bulkRemovePost() override;
+    bool isUpdateSupported(const AclRule&) const override { return false; }
 
     bool activate();
     bool deactivate();
@@ -457,8 +589,8 @@ public:
 protected:
     DTelOrch *m_pDTelOrch;
     string m_intSessionId;
-    bool INT_enabled;
-    bool INT_session_valid;
+    bool INT_enabled {false};
+    bool INT_session_valid {false};
 };
 
 class AclRuleUnderlaySetDscp: public AclRule
@@ -469,6 +601,7 @@ public:
     bool validateAddAction(string attr_name, string attr_value);
     bool validate();
     void onUpdate(SubjectType, void *) override;
+    bool isUpdateSupported(const AclRule&) const override { return false; }
     uint32_t getDscpValue() const;
     uint32_t getMetadata() const;
 protected:
@@ -478,6 +611,8 @@ protected:
     MetaDataMgr* m_metaDataMgr;
 };
 
+MEM_ACCOUNTING_TAG(AclRuleMemTag, "AclOrch|rules");
+
 class AclTable
 {
 public:
@@ -546,7 +681,8 @@ public:
     // Map port oid to group member oid
     std::map<sai_object_id_t, sai_object_id_t> ports;
     // Map rule name to rule data
-    map<string, shared_ptr<AclRule>> rules;
+    map<string, shared_ptr<AclRule>, less<string>,
+        MemAccountingAllocator<pair<const string, shared_ptr<AclRule>>, AclRuleMemTag>> rules;
     // Set to store the ACL table port alias
     set<string> portSet;
     // Set to store the not configured ACL table port alias
@@ -560,6 +696,21 @@ private:
     AclOrch *m_pAclOrch = nullptr;
 };
 
+// A rule task deferred to the next flush of the AclOrch bulkers
+struct AclRuleBulkContext
+{
+    SyncMap::iterator task;
+    string table_id;
+    string rule_id;
+    shared_ptr<AclRule> rule;
+    bool remove;
+    // Update: rule is the installed one, set in place to updatedRule
+    bool update = false;
+    shared_ptr<AclRule> updatedRule;
+    // Removal: the ACL entry is gone, its counter and ranges are queued
+    bool entryRemoved = false;
+};
+
 class AclOrch : public Orch, public Observer
 {
 public:
@@ -604,9 +755,15 @@ public:
     bool updateAclTable(AclTable &currentTable, AclTable &newTable);
     bool updateAclTable(string table_id, AclTable &table);
     bool addAclRule(shared_ptr<AclRule> aclRule, string table_id);
+    /*
+     * Add rules to their tables through the bulkers when bulk programming is
+     * enabled, one by one otherwise. results[i] tells whether aclRules[i] was added.
+     */
+    void addAclRules(const vector<shared_ptr<AclRule>>& aclRules, vector<bool>& results);
     bool removeAclRule(string table_id, string rule_id);
     bool updateAclRule(shared_ptr<AclRule> updatedAclRule);
     bool updateAclRule(string table_id, string rule_id, string attr_name, void *data, bool oper);
+    bool updateAclRuleInPorts(string table_id, string rule_id, const vector<sai_object_id_t> &ports, bool oper);
     bool updateAclRule(string table_id, string rule_id, bool enableCounter);
     AclRule* getAclRule(string table_id, string rule_id);
 
@@ -634,18 +791,28 @@ public:
     map<acl_stage_type_t, bool> m_L3V4V6Capability;
     map<string, string> m_switchMetaDataCapabilities;
     
+    /*
+     * Rule counters are registered and written to ACL_COUNTER_RULE_MAP in batches while
+     * AclOrch drains its tables, see flushCounters(), right away when called from elsewhere.
+     */
     void registerFlexCounter(const AclRule& rule);
     void deregisterFlexCounter(const AclRule& rule);
+    void flushCounters();
 
     // Get the OID for the ACL bind point for a given port
     static bool getAclBindPortId(Port& port, sai_object_id_t& port_id);
 
+    // Program the rules of ACL_RULE tasks through bulk SAI calls, disabled by default
+    static void setBulkRules(bool enabled) { m_bulkRules = enabled; }
+
     using Orch::doTask;  // Allow access to the basic doTask
     map<sai_object_id_t, AclTable>  getAclTables()
     {
         return m_AclTables;
     }
 
+    void getObjectCounts(std::vector<FieldValueTuple> &counts) const override;
+
 private:
     SwitchOrch *m_switchOrch;
     void doTask(Consumer &consumer);
@@ -687,6 +854,21 @@ private:
 
     string generateAclRuleIdentifierInCountersDb(const AclRule& rule) const;
 
+    // Defer a rule task to flushRuleBulk(), false if the rule has to be programmed synchronously
+    bool queueBulkRuleCreate(SyncMap::iterator task, const string &table_id,
+                             const string &rule_id, shared_ptr<AclRule> rule);
+    bool queueBulkRuleRemove(SyncMap::iterator task, const string &table_id, const string &rule_id);
+    bool queueBulkRuleUpdate(SyncMap::iterator task, const string &table_id,
+                             const string &rule_id, shared_ptr<AclRule> rule);
+    // Set an existing rule to the configuration of rule, false if it has to be replaced instead
+    bool updateRuleInPlace(const string &table_id, shared_ptr<AclRule> rule);
+    void flushRuleBulk(Consumer &consumer);
+    // Remove the range objects left unused by the rules of the drain
+    void removeUnusedRanges();
+    // Park the task of a rule which failed to be created, returns true if it is to leave m_toSync
+    bool handleRuleCreateFailure(Consumer &consumer, SyncMap::iterator task, const string &table_id,
+                                 const string &rule_id, sai_status_t status);
+
     void setAclTableStatus(string table_name, AclObjectStatus status);
     void setAclRuleStatus(string table_name, string rule_name, AclObjectStatus status);
 
@@ -718,7 +900,23 @@ private:
 
     acl_capabilities_t m_aclCapabilities;
     acl_action_enum_values_capabilities_t m_aclEnumActionCapabilities;
-    FlexCounterManager m_flex_counter_manager;
+    FlexCounterTaggedCachedManager<void> m_flex_counter_manager;
+    // Pending ACL_COUNTER_RULE_MAP fields by rule identifier, an empty counter oid removes the field
+    map<string, string> m_counterRuleMapPending;
+    bool m_batchCounters = false;
+
+    static bool m_bulkRules;
+    ObjectBulker<sai_acl_api_t> m_aclEntryBulker;
+    ObjectBulker<sai_acl_api_t> m_aclCounterBulker;
+    ObjectBulker<sai_acl_api_t> m_aclRangeBulker;
+    // Rule tasks of the current doAclRuleTask() pass waiting for flushRuleBulk(), in m_toSync order
+    vector<AclRuleBulkContext> m_ruleBulk;
+    // "<table>:<rule>" of the rules in m_ruleBulk
+    set<string> m_ruleBulkKeys;
+
+    // Rules set again which were updated in place, and those which had to be replaced
+    uint64_t m_ruleUpdates = 0;
+    uint64_t m_ruleUpdateFallbacks = 0;
 };
 
 #endif /* SWSS_ACLORCH_H */
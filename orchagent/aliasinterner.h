@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Process wide table of the port, LAG, VLAN and sub-interface aliases.
+ *
+ * Every alias gets a small stable id on first use, the id and the name are
+ * both found in O(1). Aliases are never forgotten, their number is bounded by
+ * the interfaces the system ever had. Only to be used from the orchagent main
+ * thread.
+ */
+class AliasInterner
+{
+public:
+    typedef uint32_t Id;
+
+    /* Id 0 is the empty alias */
+    static constexpr Id EMPTY_ID = 0;
+
+    static AliasInterner& instance()
+    {
+        // Never destroyed, aliases may be held by static objects
+        static AliasInterner *interner = new AliasInterner();
+        return *interner;
+    }
+
+    Id intern(const std::string &alias)
+    {
+        if (alias.empty())
+        {
+            return EMPTY_ID;
+        }
+
+        auto rc = m_ids.emplace(alias, static_cast<Id>(m_names.size()));
+        if (rc.second)
+        {
+            m_names.push_back(&rc.first->first);
+        }
+        return rc.first->second;
+    }
+
+    const std::string& name(Id id) const
+    {
+        return *m_names[id];
+    }
+
+    /* Number of distinct aliases, the empty one included */
+    size_t size() const
+    {
+        return m_names.size();
+    }
+
+private:
+    AliasInterner()
+    {
+        auto rc = m_ids.emplace(std::string(), static_cast<Id>(EMPTY_ID));
+        m_names.push_back(&rc.first->first);
+    }
+
+    std::unordered_map<std::string, Id> m_ids;
+    // Names by id, pointing to the keys of m_ids
+    std::vector<const std::string *> m_names;
+};
+
+/*
+ * Interned alias, a drop-in replacement for the std::string aliases of the
+ * orch keys. Copies, equality and hashing work on the id, the order is the
+ * order of the names so ordered containers keep their iteration order.
+ */
+class AliasId
+{
+public:
+    AliasId() = default;
+    AliasId(const std::string &alias) : m_id(AliasInterner::instance().intern(alias)) {}
+    AliasId(const char *alias) : AliasId(std::string(alias)) {}
+
+    AliasId &operator=(const std::string &alias)
+    {
+        m_id = AliasInterner::instance().intern(alias);
+        return *this;
+    }
+
+    AliasId &operator=(const char *alias)
+    {
+        return *this = std::string(alias);
+    }
+
+    AliasInterner::Id id() const { return m_id; }
+
+    const std::string& str() const
+    {
+        return AliasInterner::instance().name(m_id);
+    }
+
+    operator const std::string&() const { return str(); }
+
+    const char *c_str() const { return str().c_str(); }
+    bool empty() const { return m_id == AliasInterner::EMPTY_ID; }
+    size_t size() const { return str().size(); }
+
+    int compare(const std::string &s) const { return str().compare(s); }
+    int compare(size_t pos, size_t len, const char *s) const { return str().compare(pos, len, s); }
+    int compare(size_t pos, size_t len, const std::string &s) const { return str().compare(pos, len, s); }
+
+    friend inline bool operator==(const AliasId &a, const AliasId &b) { return a.m_id == b.m_id; }
+    friend inline bool operator!=(const AliasId &a, const AliasId &b) { return a.m_id != b.m_id; }
+    friend inline bool operator==(const AliasId &a, const std::string &b) { return a.str() == b; }
+    friend inline bool operator==(const std::string &a, const AliasId &b) { return a == b.str(); }
+    friend inline bool operator!=(const AliasId &a, const std::string &b) { return a.str() != b; }
+    friend inline bool operator!=(const std::string &a, const AliasId &b) { return a != b.str(); }
+    friend inline bool operator==(const AliasId &a, const char *b) { return a.str() == b; }
+    friend inline bool operator==(const char *a, const AliasId &b) { return a == b.str(); }
+    friend inline bool operator!=(const AliasId &a, const char *b) { return a.str() != b; }
+    friend inline bool operator!=(const char *a, const AliasId &b) { return a != b.str(); }
+
+    friend inline bool operator<(const AliasId &a, const AliasId &b)
+    {
+        return a.m_id != b.m_id && a.str() < b.str();
+    }
+
+    friend inline std::string operator+(const AliasId &a, const std::string &b) { return a.str() + b; }
+    friend inline std::string operator+(const std::string &a, const AliasId &b) { return a + b.str(); }
+    friend inline std::string operator+(const AliasId &a, const char *b) { return a.str() + b; }
+    friend inline std::string operator+(const char *a, const AliasId &b) { return a + b.str(); }
+    friend inline std::string operator+(const AliasId &a, char b) { return a.str() + b; }
+    friend inline std::string operator+(char a, const AliasId &b) { return a + b.str(); }
+
+    friend inline std::ostream &operator<<(std::ostream &os, const AliasId &a) { return os << a.str(); }
+
+    friend inline std::size_t hash_value(const AliasId &a) { return std::hash<uint32_t>()(a.m_id); }
+
+private:
+    AliasInterner::Id m_id = AliasInterner::EMPTY_ID;
+};
+
+namespace std
+{
+    template<>
+    struct hash<AliasId> {
+        size_t operator()(const AliasId &a) const {
+            return hash_value(a);
+        }
+    };
+}
@@ -29,6 +29,7 @@ extern PortsOrch*           gPortsOrch;
 extern sai_switch_api_t*    sai_switch_api;
 extern Directory<Orch*>     gDirectory;
 extern string               gMySwitchType;
+extern size_t               gMaxBulkSize;
 
 const map<string, sai_bfd_session_type_t> session_type_map =
 {
@@ -56,7 +57,9 @@ const map<sai_bfd_session_state_t, string> session_state_lookup =
 
 BfdOrch::BfdOrch(DBConnector *db, string tableName, TableConnector stateDbBfdSessionTable):
     Orch(db, tableName),
-    m_stateBfdSessionTable(stateDbBfdSessionTable.first, stateDbBfdSessionTable.second)
+    m_statePipeline(new RedisPipeline(stateDbBfdSessionTable.first)),
+    m_stateBfdSessionTable(m_statePipeline.get(), stateDbBfdSessionTable.second, true),
+    m_sessionBulker(sai_bfd_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 
@@ -77,6 +80,7 @@ BfdOrch::BfdOrch(DBConnector *db, string tableName, TableConnector stateDbBfdSes
     {
         m_stateBfdSessionTable.del(alias);
     }
+    m_statePipeline->flush();
     // Clean up state database software BFD entries
     m_stateSoftBfdSessionTable->getKeys(keys);
     for (auto alias : keys)
@@ -119,6 +123,68 @@ void BfdOrch::doTask(Consumer &consumer)
         tsa_enabled = bgp_global_state_orch->getTsaState();
         use_software_bfd = bgp_global_state_orch->getSoftwareBfd();
     }
+
+    /*
+     * Hardware sessions of the round are created and removed in bulk. Pending
+     * removals are flushed before a creation is queued and the other way round,
+     * so a DEL and SET of one key still apply in order.
+     */
+    vector<BfdSessionCreate> creates;
+    vector<SyncMap::iterator> create_its;
+    vector<string> removes;
+    vector<SyncMap::iterator> remove_its;
+
+    auto flushCreates = [&]() {
+        vector<bool> done;
+        create_bfd_sessions(creates, done);
+        for (size_t i = 0; i < create_its.size(); i++)
+        {
+            if (done[i])
+            {
+                consumer.m_toSync.erase(create_its[i]);
+            }
+        }
+        creates.clear();
+        create_its.clear();
+    };
+    auto flushRemoves = [&]() {
+        vector<bool> done;
+        remove_bfd_sessions(removes, done);
+        for (size_t i = 0; i < remove_its.size(); i++)
+        {
+            if (done[i])
+            {
+                consumer.m_toSync.erase(remove_its[i]);
+            }
+        }
+        removes.clear();
+        remove_its.clear();
+    };
+    auto queueCreate = [&](SyncMap::iterator entry, const string& key, const vector<FieldValueTuple>& data) {
+        if (!removes.empty())
+        {
+            flushRemoves();
+        }
+
+        BfdSessionCreate session;
+        task_process_status status = build_bfd_session(key, data, session);
+        if (status == task_success)
+        {
+            creates.push_back(std::move(session));
+            create_its.push_back(entry);
+        }
+        return status;
+    };
+    auto queueRemove = [&](SyncMap::iterator entry, const string& key) {
+        if (!creates.empty())
+        {
+            flushCreates();
+        }
+
+        removes.push_back(key);
+        remove_its.push_back(entry);
+    };
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -133,7 +199,10 @@ void BfdOrch::doTask(Consumer &consumer)
             if (use_software_bfd)
             {
                 //program entry in software BFD table
-                m_stateSoftBfdSessionTable->set(createStateDBKey(key), data);
+                {
+                    std::lock_guard<std::mutex> lock(m_softBfdSessionMutex);
+                    m_stateSoftBfdSessionTable->set(createStateDBKey(key), data);
+                }
                 it = consumer.m_toSync.erase(it);
                 continue;
             }
@@ -155,26 +224,19 @@ void BfdOrch::doTask(Consumer &consumer)
             if (tsa_shutdown_enabled)
             {
                 bfd_session_cache[key] = data;
-                if (!tsa_enabled)
-                {
-                    if (!create_bfd_session(key, data))
-                    {
-                        it++;
-                        continue;
-                    }
-                }
-                else
+                if (tsa_enabled)
                 {
                     notify_session_state_down(key);
+                    it = consumer.m_toSync.erase(it);
+                    continue;
                 }
             }
-            else
+
+            task_process_status status = queueCreate(it, key, data);
+            if (status == task_success || status == task_need_retry)
             {
-                if (!create_bfd_session(key, data))
-                {
-                    it++;
-                    continue;
-                }
+                it++;
+                continue;
             }
         }
         else if (op == DEL_COMMAND)
@@ -182,7 +244,10 @@ void BfdOrch::doTask(Consumer &consumer)
             if (use_software_bfd)
             {
                 //delete entry from software BFD table
-                m_stateSoftBfdSessionTable->del(createStateDBKey(key));
+                {
+                    std::lock_guard<std::mutex> lock(m_softBfdSessionMutex);
+                    m_stateSoftBfdSessionTable->del(createStateDBKey(key));
+                }
                 it = consumer.m_toSync.erase(it);
                 continue;
             }
@@ -190,23 +255,16 @@ void BfdOrch::doTask(Consumer &consumer)
             if (bfd_session_cache.find(key) != bfd_session_cache.end() )
             {
                 bfd_session_cache.erase(key);
-                if (!tsa_enabled)
-                {
-                    if (!remove_bfd_session(key))
-                    {
-                        it++;
-                        continue;
-                    }
-                }
-            }
-            else
-            {
-                if (!remove_bfd_session(key))
+                if (tsa_enabled)
                 {
-                    it++;
+                    it = consumer.m_toSync.erase(it);
                     continue;
                 }
             }
+
+            queueRemove(it, key);
+            it++;
+            continue;
         }
         else
         {
@@ -215,29 +273,54 @@ void BfdOrch::doTask(Consumer &consumer)
 
         it = consumer.m_toSync.erase(it);
     }
+
+    if (!creates.empty())
+    {
+        flushCreates();
+    }
+    if (!removes.empty())
+    {
+        flushRemoves();
+    }
+
+    m_statePipeline->flush();
 }
 
 void BfdOrch::doTask(NotificationConsumer &consumer)
 {
     SWSS_LOG_ENTER();
 
-    std::string op;
-    std::string data;
-    std::vector<swss::FieldValueTuple> values;
-
-    consumer.pop(op, data, values);
+    std::deque<KeyOpFieldsValuesTuple> entries;
+    consumer.pops(entries);
 
     if (&consumer != m_bfdStateNotificationConsumer)
     {
         return;
     }
 
-    if (op == "bfd_session_state_change")
+    handle_bfd_state_notifications(entries);
+}
+
+/*
+ * The notifications queued since the last round are handled together and their
+ * STATE_DB writes are flushed once. Every state change is still written and
+ * notified in order, observers may act on a transient state.
+ */
+void BfdOrch::handle_bfd_state_notifications(const std::deque<KeyOpFieldsValuesTuple>& entries)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto& entry : entries)
     {
+        if (kfvOp(entry) != "bfd_session_state_change")
+        {
+            continue;
+        }
+
         uint32_t count;
         sai_bfd_session_state_notification_t *bfdSessionState = nullptr;
 
-        sai_deserialize_bfd_session_state_ntf(data, count, &bfdSessionState);
+        sai_deserialize_bfd_session_state_ntf(kfvKey(entry), count, &bfdSessionState);
 
         for (uint32_t i = 0; i < count; i++)
         {
@@ -246,25 +329,34 @@ void BfdOrch::doTask(NotificationConsumer &consumer)
 
             SWSS_LOG_INFO("Get BFD session state change notification id:%" PRIx64 " state: %s", id, session_state_lookup.at(state).c_str());
 
-            if (state != bfd_session_lookup[id].state)
+            auto session = bfd_session_lookup.find(id);
+            if (session == bfd_session_lookup.end())
             {
-                auto key = bfd_session_lookup[id].peer;
+                SWSS_LOG_INFO("BFD session id:%" PRIx64 " was removed before its state change was handled", id);
+                continue;
+            }
+
+            if (state != session->second.state)
+            {
+                auto key = session->second.peer;
                 m_stateBfdSessionTable.hset(key, "state", session_state_lookup.at(state));
 
                 SWSS_LOG_NOTICE("BFD session state for %s changed from %s to %s", key.c_str(),
-                            session_state_lookup.at(bfd_session_lookup[id].state).c_str(), session_state_lookup.at(state).c_str());
+                            session_state_lookup.at(session->second.state).c_str(), session_state_lookup.at(state).c_str());
 
                 BfdUpdate update;
                 update.peer = key;
                 update.state = state;
                 notify(SUBJECT_TYPE_BFD_SESSION_STATE_CHANGE, static_cast<void *>(&update));
 
-                bfd_session_lookup[id].state = state;
+                session->second.state = state;
             }
         }
 
         sai_deserialize_free_bfd_session_state_ntf(count, bfdSessionState);
     }
+
+    m_statePipeline->flush();
 }
 
 bool BfdOrch::register_bfd_state_change_notification(void)
@@ -302,35 +394,35 @@ bool BfdOrch::register_bfd_state_change_notification(void)
     return true;
 }
 
-bool BfdOrch::create_bfd_session(const string& key, const vector<FieldValueTuple>& data)
+task_process_status BfdOrch::build_bfd_session(const string& key, const vector<FieldValueTuple>& data, BfdSessionCreate& session)
 {
     if (!register_state_change_notif)
     {
         if (!register_bfd_state_change_notification())
         {
             SWSS_LOG_ERROR("BFD session for %s cannot be created", key.c_str());
-            return false;
+            return task_need_retry;
         }
         register_state_change_notif = true;
     }
     if (bfd_session_map.find(key) != bfd_session_map.end())
     {
         SWSS_LOG_ERROR("BFD session for %s already exists", key.c_str());
-        return true;
+        return task_duplicated;
     }
 
     size_t found_vrf = key.find(delimiter);
     if (found_vrf == string::npos)
     {
         SWSS_LOG_ERROR("Failed to parse key %s, no vrf is given", key.c_str());
-        return true;
+        return task_invalid_entry;
     }
 
     size_t found_ifname = key.find(delimiter, found_vrf + 1);
     if (found_ifname == string::npos)
     {
         SWSS_LOG_ERROR("Failed to parse key %s, no ifname is given", key.c_str());
-        return true;
+        return task_invalid_entry;
     }
 
     string vrf_name = key.substr(0, found_vrf);
@@ -409,7 +501,7 @@ bool BfdOrch::create_bfd_session(const string& key, const vector<FieldValueTuple
     if (!src_ip_provided)
     {
         SWSS_LOG_ERROR("Failed to create BFD session %s because source IP is not provided", key.c_str());
-        return true;
+        return task_invalid_entry;
     }
 
     attr.id = SAI_BFD_SESSION_ATTR_TYPE;
@@ -485,21 +577,21 @@ bool BfdOrch::create_bfd_session(const string& key, const vector<FieldValueTuple
         if (!gPortsOrch->getPort(alias, port))
         {
             SWSS_LOG_ERROR("Failed to locate port %s", alias.c_str());
-            return false;
+            return task_need_retry;
         }
 
         if (!dst_mac_provided)
         {
             SWSS_LOG_ERROR("Failed to create BFD session %s: destination MAC address required when hardware lookup not valid",
                             key.c_str());
-            return true;
+            return task_invalid_entry;
         }
 
         if (vrf_name != "default")
         {
             SWSS_LOG_ERROR("Failed to create BFD session %s: vrf is not supported when hardware lookup not valid",
                             key.c_str());
-            return true;
+            return task_invalid_entry;
         }
 
         attr.id = SAI_BFD_SESSION_ATTR_HW_LOOKUP_VALID;
@@ -524,7 +616,7 @@ bool BfdOrch::create_bfd_session(const string& key, const vector<FieldValueTuple
         {
             SWSS_LOG_ERROR("Failed to create BFD session %s: destination MAC address not supported when hardware lookup valid",
                             key.c_str());
-            return true;
+            return task_invalid_entry;
         }
 
         attr.id = SAI_BFD_SESSION_ATTR_VIRTUAL_ROUTER;
@@ -543,17 +635,69 @@ bool BfdOrch::create_bfd_session(const string& key, const vector<FieldValueTuple
 
     fvVector.emplace_back("state", session_state_lookup.at(SAI_BFD_SESSION_STATE_DOWN));
 
+    session.key = key;
+    session.state_db_key = get_state_db_key(vrf_name, alias, peer_address);
+    session.attrs = std::move(attrs);
+    session.fvs = std::move(fvVector);
+
+    return task_success;
+}
+
+bool BfdOrch::create_bfd_session(const string& key, const vector<FieldValueTuple>& data)
+{
+    BfdSessionCreate session;
+    task_process_status build_status = build_bfd_session(key, data, session);
+    if (build_status != task_success)
+    {
+        return build_status != task_need_retry;
+    }
+
     sai_object_id_t bfd_session_id = SAI_NULL_OBJECT_ID;
-    sai_status_t status = sai_bfd_api->create_bfd_session(&bfd_session_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    sai_status_t status = sai_bfd_api->create_bfd_session(&bfd_session_id, gSwitchId, (uint32_t)session.attrs.size(), session.attrs.data());
+
+    return add_bfd_session(session, bfd_session_id, status);
+}
 
+/*
+ * Sessions of one processing round are created with one bulk call, the ones
+ * the bulk fails are retried one by one with other UDP source ports. done
+ * tells for each whether its request is complete.
+ */
+void BfdOrch::create_bfd_sessions(vector<BfdSessionCreate>& sessions, vector<bool>& done)
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_object_id_t> ids(sessions.size(), SAI_NULL_OBJECT_ID);
+    vector<sai_status_t> statuses(sessions.size(), SAI_STATUS_NOT_EXECUTED);
+
+    for (size_t i = 0; i < sessions.size(); i++)
+    {
+        m_sessionBulker.create_entry(&ids[i], &statuses[i], (uint32_t)sessions[i].attrs.size(), sessions[i].attrs.data());
+    }
+    m_sessionBulker.flush();
+
+    done.assign(sessions.size(), false);
+    for (size_t i = 0; i < sessions.size(); i++)
+    {
+        if (is_bulk_unsupported(statuses[i]))
+        {
+            statuses[i] = sai_bfd_api->create_bfd_session(&ids[i], gSwitchId,
+                                                          (uint32_t)sessions[i].attrs.size(), sessions[i].attrs.data());
+        }
+        done[i] = add_bfd_session(sessions[i], ids[i], statuses[i]);
+    }
+}
+
+bool BfdOrch::add_bfd_session(const BfdSessionCreate& session, sai_object_id_t bfd_session_id, sai_status_t status)
+{
     if (status != SAI_STATUS_SUCCESS)
     {
-        status = retry_create_bfd_session(bfd_session_id, attrs);
+        status = retry_create_bfd_session(bfd_session_id, session.attrs);
     }
 
     if (status != SAI_STATUS_SUCCESS)
     {
-        SWSS_LOG_ERROR("Failed to create bfd session %s, rv:%d", key.c_str(), status);
+        SWSS_LOG_ERROR("Failed to create bfd session %s, rv:%d", session.key.c_str(), status);
         task_process_status handle_status = handleSaiCreateStatus(SAI_API_BFD, status);
         if (handle_status != task_success)
         {
@@ -561,13 +705,12 @@ bool BfdOrch::create_bfd_session(const string& key, const vector<FieldValueTuple
         }
     }
 
-    const string state_db_key = get_state_db_key(vrf_name, alias, peer_address);
-    m_stateBfdSessionTable.set(state_db_key, fvVector);
-    bfd_session_map[key] = bfd_session_id;
-    bfd_session_lookup[bfd_session_id] = {state_db_key, SAI_BFD_SESSION_STATE_DOWN};
+    m_stateBfdSessionTable.set(session.state_db_key, session.fvs);
+    bfd_session_map[session.key] = bfd_session_id;
+    bfd_session_lookup[bfd_session_id] = {session.state_db_key, SAI_BFD_SESSION_STATE_DOWN};
 
     BfdUpdate update;
-    update.peer = state_db_key;
+    update.peer = session.state_db_key;
     update.state = SAI_BFD_SESSION_STATE_DOWN;
     notify(SUBJECT_TYPE_BFD_SESSION_STATE_CHANGE, static_cast<void *>(&update));
 
@@ -614,8 +757,50 @@ bool BfdOrch::remove_bfd_session(const string& key)
         return true;
     }
 
-    sai_object_id_t bfd_session_id = bfd_session_map[key];
-    sai_status_t status = sai_bfd_api->remove_bfd_session(bfd_session_id);
+    sai_status_t status = sai_bfd_api->remove_bfd_session(bfd_session_map[key]);
+    return del_bfd_session(key, status);
+}
+
+/* Same as create_bfd_sessions(), for the removals of a processing round */
+void BfdOrch::remove_bfd_sessions(const vector<string>& keys, vector<bool>& done)
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_status_t> statuses(keys.size(), SAI_STATUS_SUCCESS);
+    vector<bool> queued(keys.size(), false);
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        auto it = bfd_session_map.find(keys[i]);
+        if (it == bfd_session_map.end())
+        {
+            continue;
+        }
+        m_sessionBulker.remove_entry(&statuses[i], it->second);
+        queued[i] = true;
+    }
+    m_sessionBulker.flush();
+
+    done.assign(keys.size(), false);
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        if (!queued[i])
+        {
+            SWSS_LOG_ERROR("BFD session for %s does not exist", keys[i].c_str());
+            done[i] = true;
+            continue;
+        }
+
+        if (is_bulk_unsupported(statuses[i]))
+        {
+            statuses[i] = sai_bfd_api->remove_bfd_session(bfd_session_map[keys[i]]);
+        }
+        done[i] = del_bfd_session(keys[i], statuses[i]);
+    }
+}
+
+bool BfdOrch::del_bfd_session(const string& key, sai_status_t status)
+{
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to remove bfd session %s, rv:%d", key.c_str(), status);
@@ -626,6 +811,7 @@ bool BfdOrch::remove_bfd_session(const string& key)
         }
     }
 
+    sai_object_id_t bfd_session_id = bfd_session_map[key];
     m_stateBfdSessionTable.del(bfd_session_lookup[bfd_session_id].peer);
     bfd_session_map.erase(key);
     bfd_session_lookup.erase(bfd_session_id);
@@ -701,16 +887,22 @@ void BfdOrch::handleTsaStateChange(bool tsaState)
             }
         }
     }
+
+    m_statePipeline->flush();
 }
 
 void BfdOrch::createSoftwareBfdSession(const string &key, const vector<swss::FieldValueTuple>& data)
 {
+    std::lock_guard<std::mutex> lock(m_softBfdSessionMutex);
+
     m_stateSoftBfdSessionTable->set(createStateDBKey(key), data);
     SWSS_LOG_NOTICE("Software BFD session created for %s", key.c_str());
 }
 
 void BfdOrch::removeSoftwareBfdSession(const string &key)
 {
+    std::lock_guard<std::mutex> lock(m_softBfdSessionMutex);
+
     m_stateSoftBfdSessionTable->del(createStateDBKey(key));
     SWSS_LOG_NOTICE("Software BFD session removed for %s", key.c_str());
 }
@@ -718,7 +910,10 @@ void BfdOrch::removeSoftwareBfdSession(const string &key)
 void BfdOrch::removeAllSoftwareBfdSessions()
 {
     vector<string> keys;
-    m_stateSoftBfdSessionTable->getKeys(keys);
+    {
+        std::lock_guard<std::mutex> lock(m_softBfdSessionMutex);
+        m_stateSoftBfdSessionTable->getKeys(keys);
+    }
 
     for (auto key : keys)
     {
@@ -1,8 +1,13 @@
 #ifndef SWSS_BFDORCH_H
 #define SWSS_BFDORCH_H
 
+#include <mutex>
+#include <vector>
+
 #include "orch.h"
 #include "observer.h"
+#include "bulker.h"
+#include "redispipeline.h"
 
 struct BfdUpdate
 {
@@ -10,6 +15,15 @@ struct BfdUpdate
     sai_bfd_session_state_t state;
 };
 
+/* A hardware BFD session whose attributes are built, pending its creation */
+struct BfdSessionCreate
+{
+    std::string key;
+    std::string state_db_key;
+    std::vector<sai_attribute_t> attrs;
+    std::vector<swss::FieldValueTuple> fvs;
+};
+
 class BfdOrch: public Orch, public Subject
 {
 public:
@@ -19,7 +33,7 @@ public:
     virtual ~BfdOrch(void);
     void handleTsaStateChange(bool tsaState);
 
-    /* APIs for HaOrch to create passive BFD sessions on DPU.*/
+    /* APIs for HaOrch to create passive BFD sessions on DPU, safe to call from any thread.*/
     virtual void createSoftwareBfdSession(
         const std::string& key,
         const std::vector<swss::FieldValueTuple>& data);
@@ -30,6 +44,12 @@ public:
 private:
     bool create_bfd_session(const std::string& key, const std::vector<swss::FieldValueTuple>& data);
     bool remove_bfd_session(const std::string& key);
+    task_process_status build_bfd_session(const std::string& key, const std::vector<swss::FieldValueTuple>& data, BfdSessionCreate& session);
+    void create_bfd_sessions(std::vector<BfdSessionCreate>& sessions, std::vector<bool>& done);
+    void remove_bfd_sessions(const std::vector<std::string>& keys, std::vector<bool>& done);
+    bool add_bfd_session(const BfdSessionCreate& session, sai_object_id_t bfd_session_id, sai_status_t status);
+    bool del_bfd_session(const std::string& key, sai_status_t status);
+    void handle_bfd_state_notifications(const std::deque<swss::KeyOpFieldsValuesTuple>& entries);
     std::string get_state_db_key(const std::string& vrf_name, const std::string& alias, const swss::IpAddress& peer_address);
 
     uint32_t bfd_gen_id(void);
@@ -44,10 +64,14 @@ private:
     std::map<std::string, sai_object_id_t> bfd_session_map;
     std::map<sai_object_id_t, BfdUpdate> bfd_session_lookup;
 
+    std::unique_ptr<swss::RedisPipeline> m_statePipeline;
     swss::Table m_stateBfdSessionTable;
 
+    ObjectBulker<sai_bfd_api_t> m_sessionBulker;
+
     std::unique_ptr<swss::DBConnector> m_stateDbConnector;
     std::unique_ptr<swss::Table> m_stateSoftBfdSessionTable;
+    std::mutex m_softBfdSessionMutex;
 
     swss::NotificationConsumer* m_bfdStateNotificationConsumer;
     bool register_state_change_notif;
@@ -0,0 +1,178 @@
+#include <cxxabi.h>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <typeinfo>
+#include <unordered_set>
+
+#include "boottimeline.h"
+#include "orch.h"
+#include "redispipeline.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+static int64_t toUsec(BootTimeline::Clock::duration d)
+{
+    return static_cast<int64_t>(chrono::duration_cast<chrono::microseconds>(d).count());
+}
+
+static void appendJsonString(string &out, const string &s)
+{
+    out += '"';
+    for (char c : s)
+    {
+        switch (c)
+        {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                    out += buf;
+                }
+                else
+                {
+                    out += c;
+                }
+                break;
+        }
+    }
+    out += '"';
+}
+
+string BootTimeline::orchName(const Orch *orch)
+{
+    const char *mangled = typeid(*orch).name();
+
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    string name = (status == 0 && demangled) ? demangled : mangled;
+    free(demangled);
+
+    return name;
+}
+
+void BootTimeline::addOrchConstruction(const vector<Orch *> &orchs)
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    // Orchs owned by other Orchs are not listed, their type can't be looked up safely
+    unordered_set<const Orch *> listed(orchs.begin(), orchs.end());
+    auto now = Clock::now();
+
+    for (size_t i = 0; i < m_orchMarks.size(); i++)
+    {
+        const Orch *orch = m_orchMarks[i].first;
+        auto start = m_orchMarks[i].second;
+        auto until = i + 1 < m_orchMarks.size() ? m_orchMarks[i + 1].second : now;
+
+        string name = listed.count(orch) ? orchName(orch) : "Orch";
+        m_events.push_back({ name, "construct", start, until - start, NO_OBJECTS });
+    }
+
+    m_orchMarks.clear();
+}
+
+string BootTimeline::toTraceJson() const
+{
+    string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    for (const auto &event : m_events)
+    {
+        if (!first)
+        {
+            out += ',';
+        }
+        first = false;
+
+        out += "\n{\"name\":";
+        appendJsonString(out, event.name);
+        out += ",\"cat\":";
+        appendJsonString(out, event.category);
+        out += ",\"ph\":\"X\",\"pid\":1,\"tid\":1";
+        out += ",\"ts\":" + to_string(toUsec(event.start - m_origin));
+        out += ",\"dur\":" + to_string(toUsec(event.duration));
+        if (event.objects != NO_OBJECTS)
+        {
+            out += ",\"args\":{\"objects\":" + to_string(event.objects) + "}";
+        }
+        out += '}';
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+void BootTimeline::finish(DBConnector *stateDb, const string &directory)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    m_events.push_back({ "orchagent", "boot", m_origin, Clock::now() - m_origin, NO_OBJECTS });
+    m_enabled = false;
+
+    if (stateDb)
+    {
+        // Stale entries from the previous boot would be misleading
+        Table table(stateDb, BOOT_TIMELINE_TABLE);
+        vector<string> keys;
+        table.getKeys(keys);
+        for (const auto &key : keys)
+        {
+            table.del(key);
+        }
+
+        RedisPipeline pipeline(stateDb);
+        Table writer(&pipeline, BOOT_TIMELINE_TABLE, true);
+        for (size_t i = 0; i < m_events.size(); i++)
+        {
+            const auto &event = m_events[i];
+
+            // Keys sort in recording order
+            char seq[24];
+            snprintf(seq, sizeof(seq), "%04zu", i);
+
+            vector<FieldValueTuple> fvs;
+            fvs.emplace_back("start_usec", to_string(toUsec(event.start - m_origin)));
+            fvs.emplace_back("duration_usec", to_string(toUsec(event.duration)));
+            if (event.objects != NO_OBJECTS)
+            {
+                fvs.emplace_back("objects", to_string(event.objects));
+            }
+            writer.set(string(seq) + "|" + event.category + "|" + event.name, fvs);
+        }
+        pipeline.flush();
+    }
+
+    if (!directory.empty())
+    {
+        string path = directory + "/" + BOOT_TIMELINE_TRACE_FILE;
+        ofstream file(path, ios::out | ios::trunc);
+        file << toTraceJson();
+        file.close();
+        if (!file)
+        {
+            SWSS_LOG_ERROR("Failed to write the boot timeline to %s", path.c_str());
+        }
+    }
+
+    SWSS_LOG_NOTICE("orchagent boot took %" PRId64 " ms, timeline of %zu phases in %s",
+                    toUsec(m_events.back().duration) / 1000, m_events.size(), BOOT_TIMELINE_TABLE);
+}
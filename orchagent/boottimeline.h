@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace swss {
+class DBConnector;
+}
+
+class Orch;
+
+#define BOOT_TIMELINE_TABLE         "ORCHAGENT_BOOT_TIMELINE"
+#define BOOT_TIMELINE_TRACE_FILE    "orchagent_boot_trace.json"
+
+/*
+ * Wall time of the orchagent startup phases: SAI initialization, switch
+ * creation, the construction of every Orch, and on warm boot the bake()
+ * and doTask() passes of each Orch and the APPLY_VIEW.
+ *
+ * Phases are recorded on the main thread between start() and finish(),
+ * which publishes them into STATE_DB:ORCHAGENT_BOOT_TIMELINE and writes a
+ * Chrome trace (chrome://tracing, Perfetto) of them. Outside of that
+ * window recording is a single branch.
+ *
+ * The recording side is header only, Orch marks its construction from
+ * every binary linking orch.cpp without further dependencies.
+ */
+class BootTimeline
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // No object count attached to the phase
+    static constexpr int64_t NO_OBJECTS = -1;
+
+    struct Event
+    {
+        std::string name;
+        std::string category;
+        Clock::time_point start;
+        Clock::duration duration;
+        int64_t objects;
+    };
+
+    static BootTimeline &instance()
+    {
+        static BootTimeline timeline;
+        return timeline;
+    }
+
+    void start()
+    {
+        m_events.clear();
+        m_orchMarks.clear();
+        m_origin = Clock::now();
+        m_enabled = true;
+    }
+
+    bool isEnabled() const { return m_enabled; }
+
+    /* Returns the id of the phase to pass to end() */
+    size_t begin(const std::string &name, const std::string &category)
+    {
+        if (!m_enabled)
+        {
+            return m_events.size();
+        }
+
+        m_events.push_back({ name, category, Clock::now(), Clock::duration::zero(), NO_OBJECTS });
+        return m_events.size() - 1;
+    }
+
+    void end(size_t id, int64_t objects = NO_OBJECTS)
+    {
+        if (!m_enabled || id >= m_events.size())
+        {
+            return;
+        }
+
+        auto &event = m_events[id];
+        event.duration = Clock::now() - event.start;
+        event.objects = objects;
+    }
+
+    /* Called as an Orch is constructed, its phase lasts until the next Orch */
+    void markOrch(const Orch *orch)
+    {
+        if (m_enabled)
+        {
+            m_orchMarks.emplace_back(orch, Clock::now());
+        }
+    }
+
+    /*
+     * Turn the Orch marks into construction phases, named after the dynamic
+     * type of the Orchs found in orchs. Call once they are all constructed.
+     */
+    void addOrchConstruction(const std::vector<Orch *> &orchs);
+
+    /* Stop recording, publish the phases and write the trace into directory */
+    void finish(swss::DBConnector *stateDb, const std::string &directory);
+
+    const std::vector<Event> &getEvents() const { return m_events; }
+
+    /* Chrome trace event format of the recorded phases */
+    std::string toTraceJson() const;
+
+    static std::string orchName(const Orch *orch);
+
+private:
+    BootTimeline() = default;
+
+    bool m_enabled = false;
+    Clock::time_point m_origin;
+    std::vector<Event> m_events;
+    std::vector<std::pair<const Orch *, Clock::time_point>> m_orchMarks;
+};
+
+/* Records the enclosing scope as a phase */
+class BootPhase
+{
+public:
+    BootPhase(const std::string &name, const std::string &category) :
+        m_id(BootTimeline::instance().begin(name, category))
+    {
+    }
+
+    ~BootPhase()
+    {
+        BootTimeline::instance().end(m_id, m_objects);
+    }
+
+    BootPhase(const BootPhase&) = delete;
+    BootPhase& operator=(const BootPhase&) = delete;
+
+    void setObjects(int64_t objects) { m_objects = objects; }
+
+private:
+    size_t m_id;
+    int64_t m_objects = BootTimeline::NO_OBJECTS;
+};
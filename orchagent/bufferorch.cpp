@@ -22,6 +22,7 @@ extern sai_buffer_api_t *sai_buffer_api;
 extern PortsOrch *gPortsOrch;
 extern Directory<Orch*> gDirectory;
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 extern string gMySwitchType;
 extern string gMyHostName;
 extern string gMyAsicName;
@@ -1233,6 +1234,44 @@ task_process_status BufferOrch::processQueuePost(const QueueTask& task)
     return task_process_status::task_success;
 }
 
+void BufferOrch::bulkSetAttribute(sai_api_t api, sai_bulk_object_set_attribute_fn bulkSet, set_attribute_fn setAttr,
+                                  const std::vector<sai_object_id_t> &oids, const std::vector<sai_attribute_t> &attrs,
+                                  std::vector<sai_status_t> &statuses)
+{
+    SWSS_LOG_ENTER();
+
+    const size_t count = oids.size();
+    const size_t bulkSize = std::max<size_t>(gMaxBulkSize, 1);
+    size_t done = 0;
+
+    if (bulkSet == nullptr)
+    {
+        m_bulkSetUnsupported.insert(api);
+    }
+
+    while (done < count && m_bulkSetUnsupported.find(api) == m_bulkSetUnsupported.end())
+    {
+        const auto objectCount = static_cast<uint32_t>(std::min(bulkSize, count - done));
+
+        auto status = bulkSet(objectCount, oids.data() + done, attrs.data() + done,
+            SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data() + done);
+        if (status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED)
+        {
+            SWSS_LOG_NOTICE("Bulk set is not supported by %s, setting objects one by one",
+                            sai_serialize_api(api).c_str());
+            m_bulkSetUnsupported.insert(api);
+            break;
+        }
+
+        done += objectCount;
+    }
+
+    for (size_t i = done; i < count; i++)
+    {
+        statuses[i] = setAttr(oids[i], &attrs[i]);
+    }
+}
+
 void BufferOrch::processQueueBulk(Consumer& consumer)
 {
     SWSS_LOG_ENTER();
@@ -1266,8 +1305,8 @@ void BufferOrch::processQueueBulk(Consumer& consumer)
         {
             SWSS_LOG_TIMER("Set %u queues buffer profile", objectCount);
 
-            sai_queue_api->set_queues_attribute(objectCount, oids.data(), attrs.data(),
-                SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            bulkSetAttribute(SAI_API_QUEUE, sai_queue_api->set_queues_attribute, sai_queue_api->set_queue_attribute,
+                oids, attrs, statuses);
         }
 
         size_t i = 0;
@@ -1623,8 +1662,8 @@ void BufferOrch::processPriorityGroupBulk(Consumer& consumer)
         {
             SWSS_LOG_TIMER("Set %u ingress priority groups buffer profile", objectCount);
 
-            sai_buffer_api->set_ingress_priority_groups_attribute(objectCount, oids.data(), attrs.data(),
-                SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            bulkSetAttribute(SAI_API_BUFFER, sai_buffer_api->set_ingress_priority_groups_attribute, sai_buffer_api->set_ingress_priority_group_attribute,
+                oids, attrs, statuses);
         }
 
         size_t i = 0;
@@ -1820,8 +1859,8 @@ void BufferOrch::processIngressBufferProfileListBulk(Consumer& consumer)
         {
             SWSS_LOG_TIMER("Set %u ports ingress buffer profile list", objectCount);
 
-            sai_port_api->set_ports_attribute(objectCount, oids.data(), attrs.data(),
-                SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            bulkSetAttribute(SAI_API_PORT, sai_port_api->set_ports_attribute, sai_port_api->set_port_attribute,
+                oids, attrs, statuses);
         }
 
         size_t i = 0;
@@ -2010,8 +2049,8 @@ void BufferOrch::processEgressBufferProfileListBulk(Consumer& consumer)
         {
             SWSS_LOG_TIMER("Set %u ports egress buffer profile list", objectCount);
 
-            sai_port_api->set_ports_attribute(objectCount, oids.data(), attrs.data(),
-                SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            bulkSetAttribute(SAI_API_PORT, sai_port_api->set_ports_attribute, sai_port_api->set_port_attribute,
+                oids, attrs, statuses);
         }
 
         size_t i = 0;
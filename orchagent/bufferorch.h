@@ -146,6 +146,13 @@ private:
     task_process_status processIngressBufferProfileListPost(const PortBufferProfileListTask& task);
     task_process_status processEgressBufferProfileListPost(const PortBufferProfileListTask& task);
 
+    // Sets the attributes of the *Bulk methods in bulks of at most gMaxBulkSize objects,
+    // one object at a time once the bulk set of the API turns out not to be supported.
+    typedef sai_status_t (*set_attribute_fn)(sai_object_id_t object_id, const sai_attribute_t *attr);
+    void bulkSetAttribute(sai_api_t api, sai_bulk_object_set_attribute_fn bulkSet, set_attribute_fn setAttr,
+                          const std::vector<sai_object_id_t> &oids, const std::vector<sai_attribute_t> &attrs,
+                          std::vector<sai_status_t> &statuses);
+
     buffer_table_handler_map m_bufferHandlerMap;
     buffer_table_flush_handler_map m_bufferFlushHandlerMap;
     std::unordered_map<std::string, bool> m_ready_list;
@@ -158,6 +165,7 @@ private:
 
     bool m_isBufferPoolWatermarkCounterIdListGenerated = false;
     set<string> m_partiallyAppliedQueues;
+    set<sai_api_t> m_bulkSetUnsupported;
 
     // Bulk task buffers per DB operation
     std::map<std::string, std::vector<PortBufferProfileListTask>> m_portIngressBufferProfileListBulk;
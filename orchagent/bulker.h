@@ -1,15 +1,21 @@
 #pragma once
 
 #include <assert.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <stdexcept>
+#include <cstring>
 #include <boost/functional/hash.hpp>
 #include <sairedis.h>
 #include "sai.h"
 #include "logger.h"
 #include "sai_serialize.h"
+#include "executorstats.h"
+#include "orchprobes.h"
 
 typedef sai_status_t (*sai_bulk_set_outbound_ca_to_pa_entry_attribute_fn) (
         _In_ uint32_t object_count,
@@ -111,6 +117,24 @@ static inline bool operator==(const sai_neighbor_entry_t& a, const sai_neighbor_
         ;
 }
 
+static inline bool operator==(const sai_nat_entry_t& a, const sai_nat_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && a.vr_id == b.vr_id
+        && a.nat_type == b.nat_type
+        && a.data.key.src_ip == b.data.key.src_ip
+        && a.data.key.dst_ip == b.data.key.dst_ip
+        && a.data.key.proto == b.data.key.proto
+        && a.data.key.l4_src_port == b.data.key.l4_src_port
+        && a.data.key.l4_dst_port == b.data.key.l4_dst_port
+        && a.data.mask.src_ip == b.data.mask.src_ip
+        && a.data.mask.dst_ip == b.data.mask.dst_ip
+        && a.data.mask.proto == b.data.mask.proto
+        && a.data.mask.l4_src_port == b.data.mask.l4_src_port
+        && a.data.mask.l4_dst_port == b.data.mask.l4_dst_port
+        ;
+}
+
 static inline bool operator==(const sai_inbound_routing_entry_t& a, const sai_inbound_routing_entry_t& b)
 {
     return a.switch_id == b.switch_id
@@ -122,6 +146,18 @@ static inline bool operator==(const sai_inbound_routing_entry_t& a, const sai_in
         ;
 }
 
+static inline bool operator==(const sai_my_sid_entry_t& a, const sai_my_sid_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && a.vr_id == b.vr_id
+        && a.locator_block_len == b.locator_block_len
+        && a.locator_node_len == b.locator_node_len
+        && a.function_len == b.function_len
+        && a.args_len == b.args_len
+        && memcmp(a.sid, b.sid, sizeof(a.sid)) == 0
+        ;
+}
+
 static inline bool operator==(const sai_outbound_ca_to_pa_entry_t& a, const sai_outbound_ca_to_pa_entry_t& b)
 {
     return a.switch_id == b.switch_id
@@ -240,6 +276,37 @@ namespace std
         }
     };
   
+    template <>
+    struct hash<sai_nat_entry_t>
+    {
+        size_t operator()(const sai_nat_entry_t& a) const noexcept
+        {
+            size_t seed = 0;
+            boost::hash_combine(seed, a.switch_id);
+            boost::hash_combine(seed, a.vr_id);
+            boost::hash_combine(seed, a.nat_type);
+            boost::hash_combine(seed, a.data.key.src_ip);
+            boost::hash_combine(seed, a.data.key.dst_ip);
+            boost::hash_combine(seed, a.data.key.proto);
+            boost::hash_combine(seed, a.data.key.l4_src_port);
+            boost::hash_combine(seed, a.data.key.l4_dst_port);
+            return seed;
+        }
+    };
+
+    template <>
+    struct hash<sai_my_sid_entry_t>
+    {
+        size_t operator()(const sai_my_sid_entry_t& a) const noexcept
+        {
+            size_t seed = 0;
+            boost::hash_combine(seed, a.switch_id);
+            boost::hash_combine(seed, a.vr_id);
+            boost::hash_range(seed, a.sid, a.sid + sizeof(a.sid));
+            return seed;
+        }
+    };
+
     template <>
     struct hash<sai_outbound_ca_to_pa_entry_t>
     {
@@ -329,6 +396,12 @@ typedef sai_status_t (*sai_bulk_set_fdb_entry_attribute_fn)(
         _In_ sai_bulk_op_error_mode_t mode,
         _Out_ sai_status_t *object_statuses);
 
+// Bulk call status telling that the SAI executed none of the objects
+static inline bool is_bulk_unsupported(sai_status_t status)
+{
+    return status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED;
+}
+
 template<typename T>
 struct SaiBulkerTraits { };
 
@@ -358,6 +431,19 @@ struct SaiBulkerTraits<sai_fdb_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_fdb_entry_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_nat_api_t>
+{
+    using entry_t = sai_nat_entry_t;
+    using api_t = sai_nat_api_t;
+    using create_entry_fn = sai_create_nat_entry_fn;
+    using remove_entry_fn = sai_remove_nat_entry_fn;
+    using set_entry_attribute_fn = sai_set_nat_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_create_nat_entry_fn;
+    using bulk_remove_entry_fn = sai_bulk_remove_nat_entry_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_set_nat_entry_attribute_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_next_hop_group_api_t>
 {
@@ -384,6 +470,32 @@ struct SaiBulkerTraits<sai_next_hop_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_router_interface_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_router_interface_api_t;
+    using create_entry_fn = sai_create_router_interface_fn;
+    using remove_entry_fn = sai_remove_router_interface_fn;
+    using set_entry_attribute_fn = sai_set_router_interface_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_port_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_port_api_t;
+    using create_entry_fn = sai_create_port_fn;
+    using remove_entry_fn = sai_remove_port_fn;
+    using set_entry_attribute_fn = sai_set_port_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_mpls_api_t>
 {
@@ -410,6 +522,19 @@ struct SaiBulkerTraits<sai_neighbor_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_neighbor_entry_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_srv6_api_t>
+{
+    using entry_t = sai_my_sid_entry_t;
+    using api_t = sai_srv6_api_t;
+    using create_entry_fn = sai_create_my_sid_entry_fn;
+    using remove_entry_fn = sai_remove_my_sid_entry_fn;
+    using set_entry_attribute_fn = sai_set_my_sid_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_create_my_sid_entry_fn;
+    using bulk_remove_entry_fn = sai_bulk_remove_my_sid_entry_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_set_my_sid_entry_attribute_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_dash_meter_api_t>
 {
@@ -423,6 +548,19 @@ struct SaiBulkerTraits<sai_dash_meter_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_dash_acl_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_dash_acl_api_t;
+    using create_entry_fn = sai_create_dash_acl_rule_fn;
+    using remove_entry_fn = sai_remove_dash_acl_rule_fn;
+    using set_entry_attribute_fn = sai_set_dash_acl_rule_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_dash_vnet_api_t>
 {
@@ -511,6 +649,321 @@ struct SaiBulkerTraits<sai_dash_outbound_port_map_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_outbound_port_map_port_range_entry_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_tunnel_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_tunnel_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_acl_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_acl_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_dtel_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_dtel_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_vlan_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_vlan_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_bfd_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_bfd_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_macsec_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_macsec_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_hostif_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_hostif_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_counter_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_counter_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_icmp_echo_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_icmp_echo_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_stp_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_stp_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_isolation_group_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_isolation_group_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_policer_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_policer_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_virtual_router_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_virtual_router_api_t;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+/*
+ * The ACL and DTel APIs and the tunnel map entries have no bulk functions of their own,
+ * bulk them through the generic SAI bulk API instead. One instance per object
+ * type, the object type is bound at compile time so the functions fit the
+ * ObjectBulker signatures.
+ */
+template <sai_object_type_t object_type>
+static inline sai_status_t sai_bulk_create_objects(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_create(switch_id, object_type, object_count, attr_count, attr_list, mode, object_id, object_statuses);
+}
+
+template <sai_object_type_t object_type>
+static inline sai_status_t sai_bulk_remove_objects(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_remove(object_type, object_count, object_id, mode, object_statuses);
+}
+
+template <sai_object_type_t object_type>
+static inline sai_status_t sai_bulk_set_objects_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_set_attribute(object_type, object_count, object_id, attr_list, mode, object_statuses);
+}
+
+/*
+ * Attribute array of a queued entry, the attributes are owned by the BulkAttrArena of the bulker
+ */
+struct BulkAttrs
+{
+    const sai_attribute_t *attrs = nullptr;
+    uint32_t count = 0;
+
+    const sai_attribute_t *data() const { return attrs; }
+    size_t size() const { return count; }
+    const sai_attribute_t& operator[](size_t i) const { return attrs[i]; }
+};
+
+/*
+ * Owns the attribute arrays of the entries queued for creation in a bulker.
+ *
+ * The arrays are copied back to back into slabs of SLAB_SIZE attributes, an
+ * array larger than that gets a slab of its own, so queueing an entry does not
+ * allocate by itself. Copies stay in place until reset(), which releases all of
+ * them at once after the flush and keeps the first slab for the next batch.
+ * As before, the list-typed attribute values are not copied, they keep pointing
+ * to the memory of the caller.
+ */
+class BulkAttrArena
+{
+public:
+    static constexpr size_t SLAB_SIZE = 1024;
+
+    BulkAttrArena() = default;
+    BulkAttrArena(BulkAttrArena&&) = default;
+    BulkAttrArena& operator=(BulkAttrArena&&) = default;
+
+    BulkAttrs copy(const sai_attribute_t *attr_list, uint32_t attr_count)
+    {
+        if (slabs.empty() || slabs.back().size - used < attr_count)
+        {
+            size_t size = attr_count > SLAB_SIZE ? size_t(attr_count) : size_t(SLAB_SIZE);
+            slabs.push_back({std::unique_ptr<sai_attribute_t[]>(new sai_attribute_t[size]), size});
+            slab_allocations++;
+            used = 0;
+        }
+
+        sai_attribute_t *attrs = slabs.back().attrs.get() + used;
+        std::copy(attr_list, attr_list + attr_count, attrs);
+        used += attr_count;
+
+        return BulkAttrs{attrs, attr_count};
+    }
+
+    void reset()
+    {
+        if (slabs.size() > 1)
+        {
+            slabs.resize(1);
+        }
+        used = 0;
+    }
+
+    /* Slabs allocated since the construction */
+    size_t get_slab_allocations() const { return slab_allocations; }
+
+private:
+    struct Slab
+    {
+        std::unique_ptr<sai_attribute_t[]> attrs;
+        size_t size;
+    };
+
+    std::vector<Slab> slabs;
+    // Attributes used in the last slab
+    size_t used = 0;
+    size_t slab_allocations = 0;
+};
+
+/*
+ * EntityBulker tuning, set from the command line before the Orchs are constructed.
+ *  chunkTargetUsec - latency target of a single bulk SAI call, 0 always
+ *                    sends chunks of max_bulk_size entries
+ *  highWaterMark   - pending entries at which a bulker flushes by itself,
+ *                    0 leaves flushing to the owner. Only bulkers whose
+ *                    owner does not query the pending entries enable it,
+ *                    see EntityBulker::enable_auto_flush()
+ */
+struct BulkerConfig
+{
+    static BulkerConfig& instance()
+    {
+        static BulkerConfig config;
+        return config;
+    }
+
+    uint64_t chunkTargetUsec = 0;
+    size_t highWaterMark = 0;
+};
+
+/*
+ * Sizes the chunks an EntityBulker hands to a single bulk SAI call.
+ *
+ * Without a latency target every chunk is max_size entries. With a target
+ * the size follows the observed call latency: it is halved when a call
+ * takes longer than the target, and grows by a quarter, up to max_size,
+ * when a full chunk completes in less than half of it.
+ */
+class BulkChunkSizer
+{
+public:
+    static constexpr size_t MIN_CHUNK_SIZE = 16;
+
+    BulkChunkSizer(size_t max_size, uint64_t target_usec) :
+        max_size(max_size),
+        target_usec(target_usec),
+        chunk_size(max_size)
+    {
+    }
+
+    bool is_adaptive() const { return target_usec != 0; }
+    size_t get_chunk_size() const { return chunk_size; }
+
+    /* Account a bulk call of count entries which took usec */
+    void record(size_t count, uint64_t usec)
+    {
+        if (!is_adaptive())
+        {
+            return;
+        }
+
+        size_t floor = max_size < MIN_CHUNK_SIZE ? max_size : size_t(MIN_CHUNK_SIZE);
+
+        if (usec > target_usec)
+        {
+            chunk_size = chunk_size / 2 < floor ? floor : chunk_size / 2;
+        }
+        else if (count >= chunk_size && usec * 2 < target_usec)
+        {
+            size_t step = chunk_size / 4 == 0 ? 1 : chunk_size / 4;
+            chunk_size = max_size - chunk_size < step ? max_size : chunk_size + step;
+        }
+    }
+
+private:
+    size_t max_size;
+    uint64_t target_usec;
+    size_t chunk_size;
+};
+
 template <typename T>
 class EntityBulker
 {
@@ -550,11 +1003,11 @@ public:
         }
 
         create_order.push_back(it->first);
-        auto& attrs = it->second.first;
-        attrs.insert(attrs.end(), attr_list, attr_list + attr_count);
+        it->second.first = attr_arena.copy(attr_list, attr_count);
         it->second.second = object_status;
         SWSS_LOG_INFO("EntityBulker.create_entry %zu, %zu, %d\n", creating_entries.size(), it->second.first.size(), inserted);
         *object_status = SAI_STATUS_NOT_EXECUTED;
+        auto_flush();
         return *object_status;
     }
 
@@ -600,6 +1053,7 @@ public:
         SWSS_LOG_INFO("EntityBulker.remove_entry %zu, %d\n", removing_entries.size(), inserted);
 
         *object_status = SAI_STATUS_NOT_EXECUTED;
+        auto_flush();
         return *object_status;
     }
 
@@ -629,6 +1083,18 @@ public:
                 std::forward_as_tuple(*attr),
                 std::forward_as_tuple(object_status));
         *object_status = SAI_STATUS_NOT_EXECUTED;
+        auto_flush();
+    }
+
+    /*
+     * Flush once the pending entries reach high_water_mark, 0 disables it.
+     * The statuses of the queued entries may then be final before flush()
+     * is called, and the pending entry queries below only cover the entries
+     * queued since the last auto flush.
+     */
+    void enable_auto_flush(size_t high_water_mark = BulkerConfig::instance().highWaterMark)
+    {
+        this->high_water_mark = high_water_mark;
     }
 
     void flush()
@@ -650,7 +1116,7 @@ public:
                 {
                     rs.push_back(entry);
 
-                    if (rs.size() >= max_bulk_size)
+                    if (rs.size() >= chunk_sizer.get_chunk_size())
                     {
                         flush_removing_entries(rs);
                     }
@@ -684,7 +1150,7 @@ public:
                     tss.push_back(attrs.data());
                     cs.push_back((uint32_t)attrs.size());
 
-                    if (rs.size() >= max_bulk_size)
+                    if (rs.size() >= chunk_sizer.get_chunk_size())
                     {
                         flush_creating_entries(rs, tss, cs);
                     }
@@ -694,6 +1160,7 @@ public:
 
             creating_entries.clear();
             create_order.clear();
+            attr_arena.reset();
         }
 
         // Setting
@@ -730,7 +1197,7 @@ public:
                         ts.push_back(attr);
                         status_vector.push_back(object_status);
 
-                        if (rs.size() >= max_bulk_size)
+                        if (rs.size() >= chunk_sizer.get_chunk_size())
                         {
                             flush_setting_entries(rs, ts, status_vector);
                         }
@@ -742,6 +1209,8 @@ public:
             setting_entries.clear();
             set_order.clear();
         }
+
+        report_pending();
     }
 
     void clear()
@@ -752,6 +1221,8 @@ public:
         remove_order.clear();
         create_order.clear();
         set_order.clear();
+        attr_arena.reset();
+        report_pending();
     }
 
     size_t creating_entries_count() const
@@ -789,7 +1260,7 @@ private:
     std::unordered_map<                                     // A map of
             Te,                                             // entry ->
             std::pair<
-                    std::vector<sai_attribute_t>,           // (attributes, OUT object_status)
+                    BulkAttrs,                              // (attributes, OUT object_status)
                     sai_status_t *
             >
     >                                                       creating_entries;
@@ -813,12 +1284,84 @@ private:
     std::vector<Te>                                         set_order;
     std::vector<Te>                                         remove_order;
 
+    BulkAttrArena                                           attr_arena;
+
     size_t max_bulk_size;
 
+    BulkChunkSizer                                          chunk_sizer{max_bulk_size, BulkerConfig::instance().chunkTargetUsec};
+    size_t                                                  high_water_mark = 0;
+    std::shared_ptr<BulkerStats>                            stats;
+    // Object type in the bulker probes, see orchprobes.h
+    std::string                                             object_type_name;
+    // Pending entries of this bulker included in stats->pending
+    size_t                                                  reported_pending = 0;
+
     typename Ts::bulk_create_entry_fn                       create_entries;
     typename Ts::bulk_remove_entry_fn                       remove_entries;
     typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute;
 
+    void attach_stats(sai_object_type_t object_type)
+    {
+        object_type_name = sai_serialize_object_type(object_type);
+        stats = ExecutorStatsRegistry::instance().attachBulkerStats(object_type_name);
+    }
+
+    /* Bulkers of an object type share their statistics, each one adds its own change */
+    void report_pending()
+    {
+        if (!stats)
+        {
+            return;
+        }
+
+        size_t pending = creating_entries.size() + removing_entries.size() + setting_entries.size();
+        if (pending != reported_pending)
+        {
+            // Wraps around on a decrease, which the unsigned addition undoes
+            stats->pending.fetch_add(static_cast<uint64_t>(pending) - static_cast<uint64_t>(reported_pending),
+                                     std::memory_order_relaxed);
+            reported_pending = pending;
+        }
+    }
+
+    void auto_flush()
+    {
+        report_pending();
+
+        if (high_water_mark == 0 ||
+            creating_entries.size() + removing_entries.size() + setting_entries.size() < high_water_mark)
+        {
+            return;
+        }
+
+        SWSS_LOG_INFO("EntityBulker.auto_flush at %zu pending entries\n", high_water_mark);
+        if (stats)
+        {
+            stats->totalAutoFlushes.fetch_add(1, std::memory_order_relaxed);
+        }
+        flush();
+    }
+
+    void record_call(BulkerStats::Op op, sai_status_t status, const std::vector<sai_status_t> &statuses,
+                     std::chrono::steady_clock::time_point start)
+    {
+        uint64_t usec = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+        chunk_sizer.record(statuses.size(), usec);
+
+        if (stats)
+        {
+            size_t failed = 0;
+            for (auto object_status : statuses)
+            {
+                failed += object_status != SAI_STATUS_SUCCESS;
+            }
+            stats->recordCall(op, statuses.size(), usec, failed, status != SAI_STATUS_SUCCESS);
+            stats->chunkSize.store(chunk_sizer.get_chunk_size(), std::memory_order_relaxed);
+        }
+    }
+
     sai_status_t flush_removing_entries(
         _Inout_ std::vector<Te> &rs)
     {
@@ -828,7 +1371,11 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
+        auto start = std::chrono::steady_clock::now();
+        ORCH_PROBE3(bulker__flush__entry, object_type_name.c_str(), static_cast<int>(BulkerStats::Op::REMOVE), count);
         sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+        record_call(BulkerStats::Op::REMOVE, status, statuses, start);
+        ORCH_PROBE4(bulker__flush__return, object_type_name.c_str(), static_cast<int>(BulkerStats::Op::REMOVE), count, status);
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("EntityBulker.flush removing_entries %zu\n", count);
@@ -865,8 +1412,12 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
+        auto start = std::chrono::steady_clock::now();
+        ORCH_PROBE3(bulker__flush__entry, object_type_name.c_str(), static_cast<int>(BulkerStats::Op::CREATE), count);
         sai_status_t status = (*create_entries)((uint32_t)count, rs.data(), cs.data(), tss.data()
             , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+        record_call(BulkerStats::Op::CREATE, status, statuses, start);
+        ORCH_PROBE4(bulker__flush__return, object_type_name.c_str(), static_cast<int>(BulkerStats::Op::CREATE), count, status);
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("EntityBulker.flush creating_entries %zu\n", count);
@@ -883,7 +1434,7 @@ private:
             sai_status_t *object_status = creating_entries[entry].second;
             if (object_status)
             {
-                *object_status = statuses[ir];
+                *object_status = is_bulk_unsupported(status) ? status : statuses[ir];
             }
         }
 
@@ -905,8 +1456,12 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
+        auto start = std::chrono::steady_clock::now();
+        ORCH_PROBE3(bulker__flush__entry, object_type_name.c_str(), static_cast<int>(BulkerStats::Op::SET), count);
         sai_status_t status = (*set_entries_attribute)((uint32_t)count, rs.data(), ts.data()
             , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+        record_call(BulkerStats::Op::SET, status, statuses, start);
+        ORCH_PROBE4(bulker__flush__return, object_type_name.c_str(), static_cast<int>(BulkerStats::Op::SET), count, status);
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("EntityBulker.flush setting_entries, count %zu\n", count);
@@ -942,19 +1497,27 @@ inline EntityBulker<sai_route_api_t>::EntityBulker(sai_route_api_t *api, size_t
     create_entries = api->create_route_entries;
     remove_entries = api->remove_route_entries;
     set_entries_attribute = api->set_route_entries_attribute;
+    attach_stats(SAI_OBJECT_TYPE_ROUTE_ENTRY);
 }
 
 template <>
 inline EntityBulker<sai_fdb_api_t>::EntityBulker(sai_fdb_api_t *api, size_t max_bulk_size) :
     max_bulk_size(max_bulk_size)
 {
-    // TODO: implement after create_fdb_entries() is available in SAI
-    throw std::logic_error("Not implemented");
-    /*
     create_entries = api->create_fdb_entries;
     remove_entries = api->remove_fdb_entries;
     set_entries_attribute = api->set_fdb_entries_attribute;
-    */
+    attach_stats(SAI_OBJECT_TYPE_FDB_ENTRY);
+}
+
+template <>
+inline EntityBulker<sai_nat_api_t>::EntityBulker(sai_nat_api_t *api, size_t max_bulk_size) :
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_nat_entries;
+    remove_entries = api->remove_nat_entries;
+    set_entries_attribute = api->set_nat_entries_attribute;
+    attach_stats(SAI_OBJECT_TYPE_NAT_ENTRY);
 }
 
 template <>
@@ -964,6 +1527,7 @@ inline EntityBulker<sai_mpls_api_t>::EntityBulker(sai_mpls_api_t *api, size_t ma
     create_entries = api->create_inseg_entries;
     remove_entries = api->remove_inseg_entries;
     set_entries_attribute = api->set_inseg_entries_attribute;
+    attach_stats(SAI_OBJECT_TYPE_INSEG_ENTRY);
 }
 
 template <>
@@ -973,6 +1537,17 @@ inline EntityBulker<sai_neighbor_api_t>::EntityBulker(sai_neighbor_api_t *api, s
     create_entries = api->create_neighbor_entries;
     remove_entries = api->remove_neighbor_entries;
     set_entries_attribute = api->set_neighbor_entries_attribute;
+    attach_stats(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
+}
+
+template <>
+inline EntityBulker<sai_srv6_api_t>::EntityBulker(sai_srv6_api_t *api, size_t max_bulk_size) :
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_my_sid_entries;
+    remove_entries = api->remove_my_sid_entries;
+    set_entries_attribute = api->set_my_sid_entries_attribute;
+    attach_stats(SAI_OBJECT_TYPE_MY_SID_ENTRY);
 }
 
 template <>
@@ -981,6 +1556,7 @@ inline EntityBulker<sai_dash_inbound_routing_api_t>::EntityBulker(sai_dash_inbou
     create_entries = api->create_inbound_routing_entries;
     remove_entries = api->remove_inbound_routing_entries;
     set_entries_attribute = nullptr;
+    attach_stats((sai_object_type_t)SAI_OBJECT_TYPE_INBOUND_ROUTING_ENTRY);
 }
 
 template <>
@@ -989,6 +1565,7 @@ inline EntityBulker<sai_dash_outbound_ca_to_pa_api_t>::EntityBulker(sai_dash_out
     create_entries = api->create_outbound_ca_to_pa_entries;
     remove_entries = api->remove_outbound_ca_to_pa_entries;
     set_entries_attribute = nullptr;
+    attach_stats((sai_object_type_t)SAI_OBJECT_TYPE_OUTBOUND_CA_TO_PA_ENTRY);
 }
 
 template <>
@@ -997,6 +1574,7 @@ inline EntityBulker<sai_dash_pa_validation_api_t>::EntityBulker(sai_dash_pa_vali
     create_entries = api->create_pa_validation_entries;
     remove_entries = api->remove_pa_validation_entries;
     set_entries_attribute = nullptr;
+    attach_stats((sai_object_type_t)SAI_OBJECT_TYPE_PA_VALIDATION_ENTRY);
 }
 
 template <>
@@ -1005,6 +1583,7 @@ inline EntityBulker<sai_dash_outbound_routing_api_t>::EntityBulker(sai_dash_outb
     create_entries = api->create_outbound_routing_entries;
     remove_entries = api->remove_outbound_routing_entries;
     set_entries_attribute = nullptr;
+    attach_stats((sai_object_type_t)SAI_OBJECT_TYPE_OUTBOUND_ROUTING_ENTRY);
 }
 
 template <>
@@ -1013,6 +1592,7 @@ inline EntityBulker<sai_dash_outbound_port_map_api_t>::EntityBulker(sai_dash_out
     create_entries = api->create_outbound_port_map_port_range_entries;
     remove_entries = api->remove_outbound_port_map_port_range_entries;
     set_entries_attribute = nullptr;
+    attach_stats((sai_object_type_t)SAI_OBJECT_TYPE_OUTBOUND_PORT_MAP_PORT_RANGE_ENTRY);
 }
 
 template <typename T>
@@ -1043,7 +1623,7 @@ public:
         assert(attr_list);
         if (!attr_list) throw std::invalid_argument("attr_list is null");
 
-        creating_entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(object_id), std::forward_as_tuple(attr_list, attr_list + attr_count));
+        creating_entries.emplace_back(object_id, attr_arena.copy(attr_list, attr_count));
 
         auto& last_attrs = std::get<1>(creating_entries.back());
         SWSS_LOG_INFO("ObjectBulker.create_entry %zu, %zu, %u\n", creating_entries.size(), last_attrs.size(), last_attrs[0].id);
@@ -1052,6 +1632,23 @@ public:
         return SAI_STATUS_NOT_EXECUTED;
     }
 
+    /* Same as above, the status of the creation is written to object_status on flush */
+    sai_status_t create_entry(
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_status,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        assert(object_status);
+        if (!object_status) throw std::invalid_argument("object_status is null");
+
+        auto status = create_entry(object_id, attr_count, attr_list);
+
+        creating_object_statuses[object_id] = object_status;
+        *object_status = SAI_STATUS_NOT_EXECUTED;
+        return status;
+    }
+
     sai_status_t remove_entry(
         _Out_ sai_status_t *object_status,
         _In_ sai_object_id_t object_id)
@@ -1064,6 +1661,14 @@ public:
         auto found_setting = setting_entries.find(object_id);
         if (found_setting != setting_entries.end())
         {
+            // Overridden by the removal
+            for (auto const& attr: found_setting->second)
+            {
+                if (attr.second)
+                {
+                    *attr.second = SAI_STATUS_SUCCESS;
+                }
+            }
             setting_entries.erase(found_setting);
         }
 
@@ -1080,7 +1685,7 @@ public:
         if (found_setting != setting_entries.end())
         {
             // For simplicity, just insert new attribute at the vector end, no merging
-            found_setting->second.emplace_back(*attr);
+            found_setting->second.emplace_back(*attr, nullptr);
         }
         else
         {
@@ -1089,12 +1694,28 @@ public:
                 std::forward_as_tuple(object_id),
                 std::forward_as_tuple()).first->second;
 
-            attrs.emplace_back(*attr);
+            attrs.emplace_back(*attr, nullptr);
         }
 
         return SAI_STATUS_SUCCESS;
     }
 
+    /* Same as above, the status of the set is written to object_status on flush */
+    sai_status_t set_entry_attribute(
+        _Out_ sai_status_t *object_status,
+        _In_ sai_object_id_t object_id,
+        _In_ const sai_attribute_t *attr)
+    {
+        assert(object_status);
+        if (!object_status) throw std::invalid_argument("object_status is null");
+
+        set_entry_attribute(object_id, attr);
+
+        setting_entries[object_id].back().second = object_status;
+        *object_status = SAI_STATUS_NOT_EXECUTED;
+        return *object_status;
+    }
+
     void flush()
     {
         // Removing
@@ -1147,12 +1768,15 @@ public:
             flush_creating_entries(rs, tss, cs);
 
             creating_entries.clear();
+            creating_object_statuses.clear();
+            attr_arena.reset();
         }
 
         if (!setting_entries.empty())
         {
             std::vector<sai_object_id_t> rs;
             std::vector<sai_attribute_t> ts;
+            std::vector<sai_status_t *> ss;
 
             for (auto const& i: setting_entries)
             {
@@ -1161,15 +1785,16 @@ public:
                 for (auto const& attr: attrs)
                 {
                     rs.push_back(entry);
-                    ts.push_back(attr);
+                    ts.push_back(attr.first);
+                    ss.push_back(attr.second);
 
                     if (rs.size() >= max_bulk_size)
                     {
-                        flush_setting_entries(rs, ts);
+                        flush_setting_entries(rs, ts, ss);
                     }
                 }
             }
-            flush_setting_entries(rs, ts);
+            flush_setting_entries(rs, ts, ss);
 
             setting_entries.clear();
         }
@@ -1179,7 +1804,9 @@ public:
     {
         removing_entries.clear();
         creating_entries.clear();
+        creating_object_statuses.clear();
         setting_entries.clear();
+        attr_arena.reset();
     }
 
     size_t creating_entries_count() const
@@ -1201,6 +1828,15 @@ public:
         return create_statuses[object];
     }
 
+    /*
+     * By default a failed entry stops the rest of its bulk, let the others go on
+     * when the caller handles failures per entry
+     */
+    void set_error_mode(sai_bulk_op_error_mode_t mode)
+    {
+        error_mode = mode;
+    }
+
 private:
     struct object_entry
     {
@@ -1218,14 +1854,21 @@ private:
 
     size_t max_bulk_size;
 
+    sai_bulk_op_error_mode_t error_mode = SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR;
+
     std::vector<std::pair<                                  // A vector of pair of
             sai_object_id_t *,                              // - object_id
-            std::vector<sai_attribute_t>                    // - attrs
+            BulkAttrs                                       // - attrs
     >>                                                      creating_entries;
 
+    BulkAttrArena                                           attr_arena;
+
     std::unordered_map<                                     // A map of
             sai_object_id_t,                                // object_id -> attrs
-            std::vector<sai_attribute_t>
+            std::vector<std::pair<
+                    sai_attribute_t,                        // - attr
+                    sai_status_t *                          // - object_status, may be null
+            >>
     >                                                       setting_entries;
 
                                                             // A map of
@@ -1238,6 +1881,10 @@ private:
 
     std::unordered_map<sai_object_id_t, sai_status_t>       create_statuses;
 
+                                                            // A map of
+                                                            // object_id pointer -> object_status of the creation
+    std::unordered_map<sai_object_id_t *, sai_status_t *>   creating_object_statuses;
+
     sai_status_t flush_removing_entries(
         _Inout_ std::vector<sai_object_id_t> &rs)
     {
@@ -1247,7 +1894,7 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
-        sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+        sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), error_mode, statuses.data());
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush removing_entries %zu rc=%d statuses[0]=%d\n", removing_entries.size(), status, statuses[0]);
@@ -1258,6 +1905,12 @@ private:
                             removing_entries.size(), sai_serialize_status(status).c_str());
         }
 
+        if (is_bulk_unsupported(status))
+        {
+            // Nothing was executed, report the call status so that callers can fall back
+            std::fill(statuses.begin(), statuses.end(), status);
+        }
+
         for (size_t i = 0; i < count; i++)
         {
             auto const& entry = rs[i];
@@ -1283,7 +1936,7 @@ private:
         std::vector<sai_object_id_t> object_ids(count);
         std::vector<sai_status_t> statuses(count);
         sai_status_t status = (*create_entries)(switch_id, (uint32_t)count, cs.data(), tss.data()
-            , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, object_ids.data(), statuses.data());
+            , error_mode, object_ids.data(), statuses.data());
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush creating_entries %zu\n", count);
@@ -1294,11 +1947,23 @@ private:
                             count, sai_serialize_status(status).c_str());
         }
 
+        if (is_bulk_unsupported(status))
+        {
+            // Nothing was executed, report the call status so that callers can fall back
+            std::fill(statuses.begin(), statuses.end(), status);
+        }
+
         for (size_t i = 0; i < count; i++)
         {
             create_statuses.emplace(object_ids[i], statuses[i]);
             sai_object_id_t *pid = rs[i];
             *pid = (statuses[i] == SAI_STATUS_SUCCESS) ? object_ids[i] : SAI_NULL_OBJECT_ID;
+
+            auto found = creating_object_statuses.find(pid);
+            if (found != creating_object_statuses.end())
+            {
+                *found->second = statuses[i];
+            }
         }
 
         rs.clear();
@@ -1310,16 +1975,18 @@ private:
 
     sai_status_t flush_setting_entries(
         _Inout_ std::vector<sai_object_id_t> &rs,
-        _Inout_ std::vector<sai_attribute_t> &ts)
+        _Inout_ std::vector<sai_attribute_t> &ts,
+        _Inout_ std::vector<sai_status_t *> &ss)
     {
         if (rs.empty())
         {
             return SAI_STATUS_SUCCESS;
         }
         size_t count = rs.size();
-        std::vector<sai_status_t> statuses(count);
+        // Entries the SAI does not get to are left NOT_EXECUTED
+        std::vector<sai_status_t> statuses(count, SAI_STATUS_NOT_EXECUTED);
         sai_status_t status = (*set_entries_attribute)((uint32_t)count, rs.data(), ts.data(),
-                               SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+                               error_mode, statuses.data());
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush setting_entries %zu\n", count);
@@ -1330,8 +1997,18 @@ private:
                             count, sai_serialize_status(status).c_str());
         }
 
+        for (size_t i = 0; i < count; i++)
+        {
+            if (ss[i])
+            {
+                // A bulk call which is not supported at all may leave the statuses alone
+                *ss[i] = is_bulk_unsupported(status) ? status : statuses[i];
+            }
+        }
+
         rs.clear();
         ts.clear();
+        ss.clear();
 
         return status;
     }
@@ -1357,6 +2034,145 @@ inline ObjectBulker<sai_next_hop_api_t>::ObjectBulker(SaiBulkerTraits<sai_next_h
     set_entries_attribute = api->set_next_hops_attribute;
 }
 
+template <>
+inline ObjectBulker<sai_port_api_t>::ObjectBulker(SaiBulkerTraits<sai_port_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_ports;
+    remove_entries = api->remove_ports;
+    set_entries_attribute = api->set_ports_attribute;
+}
+
+template <>
+inline ObjectBulker<sai_srv6_api_t>::ObjectBulker(SaiBulkerTraits<sai_srv6_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_srv6_sidlists;
+    remove_entries = api->remove_srv6_sidlists;
+    set_entries_attribute = nullptr;
+}
+
+template <>
+inline ObjectBulker<sai_router_interface_api_t>::ObjectBulker(SaiBulkerTraits<sai_router_interface_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_router_interfaces;
+    remove_entries = api->remove_router_interfaces;
+    set_entries_attribute = api->set_router_interfaces_attribute;
+}
+
+template <>
+inline ObjectBulker<sai_vlan_api_t>::ObjectBulker(SaiBulkerTraits<sai_vlan_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_vlan_members;
+    remove_entries = api->remove_vlan_members;
+    // The VLAN API has no bulk set, VLAN members are set through the generic bulk API
+    set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_VLAN_MEMBER>;
+}
+
+template <>
+inline ObjectBulker<sai_bfd_api_t>::ObjectBulker(SaiBulkerTraits<sai_bfd_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    // The BFD API has no bulk functions, sessions go through the generic bulk API
+    create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_BFD_SESSION>;
+    remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_BFD_SESSION>;
+    set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_BFD_SESSION>;
+}
+
+template <>
+inline ObjectBulker<sai_macsec_api_t>::ObjectBulker(SaiBulkerTraits<sai_macsec_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    // The MACsec API has no bulk functions, SAs go through the generic bulk API
+    create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_MACSEC_SA>;
+    remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_MACSEC_SA>;
+    set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_MACSEC_SA>;
+}
+
+template <>
+inline ObjectBulker<sai_hostif_api_t>::ObjectBulker(SaiBulkerTraits<sai_hostif_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    // The host interface API has no bulk functions, traps go through the generic bulk API
+    create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_HOSTIF_TRAP>;
+    remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_HOSTIF_TRAP>;
+    set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_HOSTIF_TRAP>;
+}
+
+template <>
+inline ObjectBulker<sai_counter_api_t>::ObjectBulker(SaiBulkerTraits<sai_counter_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_COUNTER>;
+    remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_COUNTER>;
+    set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_COUNTER>;
+}
+
+template <>
+inline ObjectBulker<sai_icmp_echo_api_t>::ObjectBulker(SaiBulkerTraits<sai_icmp_echo_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    // The ICMP echo API has no bulk functions, sessions go through the generic bulk API
+    create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_ICMP_ECHO_SESSION>;
+    remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_ICMP_ECHO_SESSION>;
+    set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_ICMP_ECHO_SESSION>;
+}
+
+template <>
+inline ObjectBulker<sai_stp_api_t>::ObjectBulker(SaiBulkerTraits<sai_stp_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_stp_ports;
+    remove_entries = api->remove_stp_ports;
+    // The STP API has no bulk set, STP ports are set through the generic bulk API
+    set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_STP_PORT>;
+}
+
+template <>
+inline ObjectBulker<sai_isolation_group_api_t>::ObjectBulker(SaiBulkerTraits<sai_isolation_group_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    // The isolation group API has no bulk functions, members go through the generic bulk API
+    create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_ISOLATION_GROUP_MEMBER>;
+    remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_ISOLATION_GROUP_MEMBER>;
+    set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_ISOLATION_GROUP_MEMBER>;
+}
+
+template <>
+inline ObjectBulker<sai_policer_api_t>::ObjectBulker(SaiBulkerTraits<sai_policer_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    // The policer API has no bulk functions, policers go through the generic bulk API
+    create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_POLICER>;
+    remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_POLICER>;
+    set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_POLICER>;
+}
+
+template <>
+inline ObjectBulker<sai_virtual_router_api_t>::ObjectBulker(SaiBulkerTraits<sai_virtual_router_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    // The virtual router API has no bulk functions, VRFs go through the generic bulk API
+    create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_VIRTUAL_ROUTER>;
+    remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_VIRTUAL_ROUTER>;
+    set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_VIRTUAL_ROUTER>;
+}
+
 template <>
 inline ObjectBulker<sai_dash_vnet_api_t>::ObjectBulker(SaiBulkerTraits<sai_dash_vnet_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
     switch_id(switch_id),
@@ -1367,6 +2183,16 @@ inline ObjectBulker<sai_dash_vnet_api_t>::ObjectBulker(SaiBulkerTraits<sai_dash_
     set_entries_attribute = nullptr;
 }
 
+template <>
+inline ObjectBulker<sai_dash_acl_api_t>::ObjectBulker(SaiBulkerTraits<sai_dash_acl_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_dash_acl_rules;
+    remove_entries = api->remove_dash_acl_rules;
+    set_entries_attribute = nullptr;
+}
+
 template <>
 inline ObjectBulker<sai_dash_meter_api_t>::ObjectBulker(SaiBulkerTraits<sai_dash_meter_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
     switch_id(switch_id),
@@ -1415,3 +2241,93 @@ inline ObjectBulker<sai_dash_outbound_port_map_api_t>::ObjectBulker(SaiBulkerTra
     create_entries = api->create_outbound_port_maps;
     remove_entries = api->remove_outbound_port_maps;
 }
+
+template <>
+inline ObjectBulker<sai_acl_api_t>::ObjectBulker(SaiBulkerTraits<sai_acl_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size, sai_object_type_extensions_t object_type) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    switch ((sai_object_type_t)object_type)
+    {
+        case SAI_OBJECT_TYPE_ACL_ENTRY:
+            create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_ACL_ENTRY>;
+            remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_ACL_ENTRY>;
+            set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_ACL_ENTRY>;
+            break;
+        case SAI_OBJECT_TYPE_ACL_COUNTER:
+            create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_ACL_COUNTER>;
+            remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_ACL_COUNTER>;
+            set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_ACL_COUNTER>;
+            break;
+        case SAI_OBJECT_TYPE_ACL_RANGE:
+            create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_ACL_RANGE>;
+            remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_ACL_RANGE>;
+            set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_ACL_RANGE>;
+            break;
+        default:
+            std::string type_str = sai_serialize_object_type((sai_object_type_t) object_type);
+            std::stringstream ss;
+            ss << "Invalid object type for sai_acl_api_t: " << type_str;
+            throw std::invalid_argument(ss.str());
+    }
+}
+
+template <>
+inline ObjectBulker<sai_dtel_api_t>::ObjectBulker(SaiBulkerTraits<sai_dtel_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size, sai_object_type_extensions_t object_type) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    switch ((sai_object_type_t)object_type)
+    {
+        case SAI_OBJECT_TYPE_DTEL_QUEUE_REPORT:
+            create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_DTEL_QUEUE_REPORT>;
+            remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_DTEL_QUEUE_REPORT>;
+            set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_DTEL_QUEUE_REPORT>;
+            break;
+        case SAI_OBJECT_TYPE_DTEL_INT_SESSION:
+            create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_DTEL_INT_SESSION>;
+            remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_DTEL_INT_SESSION>;
+            set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_DTEL_INT_SESSION>;
+            break;
+        case SAI_OBJECT_TYPE_DTEL_REPORT_SESSION:
+            create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_DTEL_REPORT_SESSION>;
+            remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_DTEL_REPORT_SESSION>;
+            set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_DTEL_REPORT_SESSION>;
+            break;
+        case SAI_OBJECT_TYPE_DTEL_EVENT:
+            create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_DTEL_EVENT>;
+            remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_DTEL_EVENT>;
+            set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_DTEL_EVENT>;
+            break;
+        default:
+            std::string type_str = sai_serialize_object_type((sai_object_type_t) object_type);
+            std::stringstream ss;
+            ss << "Invalid object type for sai_dtel_api_t: " << type_str;
+            throw std::invalid_argument(ss.str());
+    }
+}
+
+template <>
+inline ObjectBulker<sai_tunnel_api_t>::ObjectBulker(SaiBulkerTraits<sai_tunnel_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size, sai_object_type_extensions_t object_type) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    switch ((sai_object_type_t)object_type)
+    {
+        case SAI_OBJECT_TYPE_TUNNEL_MAP_ENTRY:
+            create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_TUNNEL_MAP_ENTRY>;
+            remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_TUNNEL_MAP_ENTRY>;
+            set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_TUNNEL_MAP_ENTRY>;
+            break;
+        case SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY:
+            create_entries = sai_bulk_create_objects<SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY>;
+            remove_entries = sai_bulk_remove_objects<SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY>;
+            set_entries_attribute = sai_bulk_set_objects_attribute<SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY>;
+            break;
+        default:
+            std::string type_str = sai_serialize_object_type((sai_object_type_t) object_type);
+            std::stringstream ss;
+            ss << "Invalid object type for sai_tunnel_api_t: " << type_str;
+            throw std::invalid_argument(ss.str());
+    }
+}
@@ -0,0 +1,203 @@
+#include "consumerprefetcher.h"
+#include "logger.h"
+
+#include <chrono>
+#include <cstring>
+
+using namespace std;
+using namespace swss;
+
+constexpr size_t ConsumerPrefetcher::MAX_QUEUED_BATCHES;
+constexpr int ConsumerPrefetcher::THROTTLE_WAIT_MSECONDS;
+
+ConsumerPrefetcher::ConsumerPrefetcher(Consumer *consumer, size_t maxSyncDepth)
+    : Executor(new SelectableEvent(consumer->getPri()), consumer->getOrch(), consumer->getName())
+    , m_consumer(consumer)
+    , m_maxSyncDepth(maxSyncDepth)
+{
+    m_readyEvent = static_cast<SelectableEvent *>(getSelectable());
+
+    m_select.addSelectable(m_consumer->getConsumerTable());
+    m_select.addSelectable(&m_stopEvent);
+}
+
+ConsumerPrefetcher::~ConsumerPrefetcher()
+{
+    stop();
+}
+
+void ConsumerPrefetcher::start()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = false;
+    }
+
+    m_thread = thread(&ConsumerPrefetcher::run, this);
+
+    SWSS_LOG_NOTICE("Prefetching %s on a reader thread, m_toSync depth limit %zu",
+                    getName().c_str(), m_maxSyncDepth);
+}
+
+void ConsumerPrefetcher::stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    m_stopEvent.notify();
+
+    m_thread.join();
+}
+
+void ConsumerPrefetcher::run()
+{
+    auto table = m_consumer->getConsumerTable();
+    auto stats = m_consumer->getStats();
+
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || m_batches.size() < MAX_QUEUED_BATCHES; });
+
+            if (m_throttled)
+            {
+                // The backlog may be waiting for new entries, so it only slows the reader down
+                m_cv.wait_for(lock, chrono::milliseconds(THROTTLE_WAIT_MSECONDS),
+                              [this]() { return m_stop || !m_throttled; });
+            }
+
+            if (m_stop)
+            {
+                return;
+            }
+        }
+
+        Selectable *s;
+        int ret = m_select.select(&s);
+        if (ret == Select::ERROR)
+        {
+            SWSS_LOG_ERROR("Failed to select on %s: %s", getName().c_str(), strerror(errno));
+            continue;
+        }
+        if (ret != Select::OBJECT || s == &m_stopEvent)
+        {
+            continue;
+        }
+
+        auto entries = make_shared<deque<KeyOpFieldsValuesTuple>>();
+        table->pops(*entries);
+        if (entries->empty())
+        {
+            continue;
+        }
+
+        if (stats)
+        {
+            stats->recordPop(entries->size());
+        }
+
+        enqueue(std::move(entries));
+    }
+}
+
+void ConsumerPrefetcher::enqueue(shared_ptr<deque<KeyOpFieldsValuesTuple>> entries)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_queuedEntries += entries->size();
+        m_batches.push_back(std::move(entries));
+    }
+    m_readyEvent->notify();
+}
+
+void ConsumerPrefetcher::execute()
+{
+    SWSS_LOG_ENTER();
+
+    decltype(m_batches) batches;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        batches.swap(m_batches);
+        m_queuedEntries = 0;
+    }
+    // The reader may fill the queue again while this batch is processed
+    m_cv.notify_one();
+
+    if (!batches.empty())
+    {
+        auto entries = batches.front();
+        for (size_t i = 1; i < batches.size(); i++)
+        {
+            entries->insert(entries->end(),
+                            make_move_iterator(batches[i]->begin()), make_move_iterator(batches[i]->end()));
+        }
+
+        m_consumer->execute(entries);
+    }
+
+    updateBackpressure();
+}
+
+void ConsumerPrefetcher::drain()
+{
+    m_consumer->drain();
+}
+
+void ConsumerPrefetcher::updateBackpressure()
+{
+    bool throttled = m_maxSyncDepth != 0 && m_consumer->m_toSync.size() >= m_maxSyncDepth;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_throttled == throttled)
+        {
+            return;
+        }
+        m_throttled = throttled;
+    }
+
+    if (!throttled)
+    {
+        m_cv.notify_one();
+    }
+}
+
+bool ConsumerPrefetcher::isThrottled()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_throttled;
+}
+
+size_t ConsumerPrefetcher::getQueuedEntries()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_queuedEntries;
+}
+
+void ConsumerPrefetcher::dumpPendingTasks(vector<string> &ts)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    for (const auto &batch : m_batches)
+    {
+        for (const auto &entry : *batch)
+        {
+            ts.push_back(m_consumer->dumpTuple(entry));
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "select.h"
+#include "selectableevent.h"
+#include "orch.h"
+
+/*
+ * Pops the table of a Consumer on a reader thread, so the Redis round trip
+ * and the deserialization of the next batch overlap with the doTask of the
+ * current one.
+ *
+ * The OrchDaemon selects on the prefetcher instead of the table. Popped
+ * batches are handed over to the main thread in pop order through a bounded
+ * queue, execute() feeds them to the Consumer as if they had just been
+ * popped. The reader pauses while the queue is full, and pops at most one
+ * batch per THROTTLE_WAIT_MSECONDS while the Consumer is backlogged, that is
+ * while its m_toSync holds more than the configured depth.
+ *
+ * Everything but the reader thread runs on the main thread. The Consumer
+ * must be created with a DB connection of its own, see Consumer::setPrefetchTables().
+ */
+class ConsumerPrefetcher : public Executor
+{
+public:
+    /* Batches popped ahead of the main thread, one being filled while the other is processed */
+    static constexpr size_t MAX_QUEUED_BATCHES = 2;
+    /* Pause between two pops while the Consumer is backlogged */
+    static constexpr int THROTTLE_WAIT_MSECONDS = 100;
+
+    ConsumerPrefetcher(Consumer *consumer, size_t maxSyncDepth);
+    ~ConsumerPrefetcher() override;
+
+    void start();
+    /* Stop popping, batches already popped are kept for execute() */
+    void stop();
+
+    void execute() override;
+    void drain() override;
+
+    /* Pause or resume the reader according to the m_toSync depth of the Consumer */
+    void updateBackpressure();
+
+    Consumer *getConsumer() const { return m_consumer; }
+
+    bool isThrottled();
+    size_t getQueuedEntries();
+    void dumpPendingTasks(std::vector<std::string> &ts);
+
+protected:
+    /* Queue a popped batch for execute(), called on the reader thread */
+    void enqueue(std::shared_ptr<std::deque<swss::KeyOpFieldsValuesTuple>> entries);
+
+private:
+    void run();
+
+    Consumer *m_consumer;
+    size_t m_maxSyncDepth;
+
+    // Wakes the main thread up, owned by the Executor as its selectable
+    swss::SelectableEvent *m_readyEvent;
+    // Wakes the reader thread up on stop
+    swss::SelectableEvent m_stopEvent;
+    // Used by the reader thread only, kept across restarts so no readiness already read is lost
+    swss::Select m_select;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::shared_ptr<std::deque<swss::KeyOpFieldsValuesTuple>>> m_batches;
+    size_t m_queuedEntries = 0;
+    bool m_throttled = false;
+    bool m_stop = false;
+};
@@ -15,6 +15,8 @@ extern "C" {
 #include "directory.h"
 #include "flow_counter_handler.h"
 #include "timer.h"
+#include "bulker.h"
+#include "saicapabilitycache.h"
 
 #include <inttypes.h>
 #include <sstream>
@@ -27,12 +29,14 @@ using namespace std;
 extern sai_hostif_api_t*    sai_hostif_api;
 extern sai_policer_api_t*   sai_policer_api;
 extern sai_switch_api_t*    sai_switch_api;
+extern sai_counter_api_t*   sai_counter_api;
 
 extern sai_object_id_t      gSwitchId;
 extern PortsOrch*           gPortsOrch;
 extern Directory<Orch*>     gDirectory;
 extern bool                 gIsNatSupported;
 extern bool                 gTraditionalFlexCounter;
+extern size_t               gMaxBulkSize;
 
 #define FLEX_COUNTER_UPD_INTERVAL 1
 
@@ -188,6 +192,21 @@ const vector<sai_hostif_trap_type_t> default_trap_ids = {
 
 const uint HOSTIF_TRAP_COUNTER_POLLING_INTERVAL_MS = 10000;
 
+/* Policer attribute value as it is compared against the applied one */
+static uint64_t getPolicerAttrValue(const sai_attribute_t &attr)
+{
+    switch (attr.id)
+    {
+        case SAI_POLICER_ATTR_CBS:
+        case SAI_POLICER_ATTR_CIR:
+        case SAI_POLICER_ATTR_PBS:
+        case SAI_POLICER_ATTR_PIR:
+            return attr.value.u64;
+        default:
+            return static_cast<uint64_t>(attr.value.s32);
+    }
+}
+
 CoppOrch::CoppOrch(DBConnector* db, string tableName) :
     Orch(db, tableName),
     m_counter_db(std::shared_ptr<DBConnector>(new DBConnector("COUNTERS_DB", 0))),
@@ -256,10 +275,10 @@ void CoppOrch::publishTrapIdsCapability()
     enum_values_capability.count = static_cast<uint32_t>(values_list.size());
     enum_values_capability.list = values_list.data();
 
-    sai_status_t status = sai_query_attribute_enum_values_capability(gSwitchId,
-                                                                     SAI_OBJECT_TYPE_HOSTIF_TRAP,
-                                                                     SAI_HOSTIF_TRAP_ATTR_TRAP_TYPE,
-                                                                     &enum_values_capability);
+    sai_status_t status = querySaiAttributeEnumValuesCapability(gSwitchId,
+                                                                SAI_OBJECT_TYPE_HOSTIF_TRAP,
+                                                                SAI_HOSTIF_TRAP_ATTR_TRAP_TYPE,
+                                                                &enum_values_capability);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_NOTICE("SAI capability query for SAI_HOSTIF_TRAP_ATTR_TRAP_TYPE is failed,"
@@ -500,36 +519,58 @@ bool CoppOrch::applyAttributesToTrapIds(sai_object_id_t trap_group_id,
                                         const vector<sai_hostif_trap_type_t> &trap_id_list,
                                         vector<sai_attribute_t> &trap_id_attribs)
 {
-    for (auto trap_id : trap_id_list)
+    vector<sai_object_id_t> hostif_trap_ids(trap_id_list.size(), SAI_NULL_OBJECT_ID);
+    vector<sai_status_t> statuses(trap_id_list.size(), SAI_STATUS_SUCCESS);
+    vector<vector<sai_attribute_t>> trap_attrs(trap_id_list.size());
+
+    // The traps of the group are created in one bulk, e.g. the whole default config at boot
+    ObjectBulker<sai_hostif_api_t> bulker(sai_hostif_api, gSwitchId, gMaxBulkSize);
+    for (size_t i = 0; i < trap_id_list.size(); i++)
     {
         sai_attribute_t attr;
-        vector<sai_attribute_t> attrs;
+        auto &attrs = trap_attrs[i];
 
         attr.id = SAI_HOSTIF_TRAP_ATTR_TRAP_TYPE;
-        attr.value.s32 = trap_id;
+        attr.value.s32 = trap_id_list[i];
         attrs.push_back(attr);
 
         attrs.insert(attrs.end(), trap_id_attribs.begin(), trap_id_attribs.end());
 
-        sai_object_id_t hostif_trap_id;
-        sai_status_t status = sai_hostif_api->create_hostif_trap(&hostif_trap_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+        bulker.create_entry(&hostif_trap_ids[i], &statuses[i], (uint32_t)attrs.size(), attrs.data());
+    }
+    bulker.flush();
+
+    vector<pair<sai_object_id_t, sai_hostif_trap_type_t>> counter_traps;
+    bool result = true;
+    for (size_t i = 0; i < trap_id_list.size(); i++)
+    {
+        auto trap_id = trap_id_list[i];
+        sai_status_t status = statuses[i];
+        if (is_bulk_unsupported(status))
+        {
+            auto &attrs = trap_attrs[i];
+            status = sai_hostif_api->create_hostif_trap(&hostif_trap_ids[i], gSwitchId, (uint32_t)attrs.size(), attrs.data());
+        }
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to create trap %d, rv:%d", trap_id, status);
             task_process_status handle_status = handleSaiCreateStatus(SAI_API_HOSTIF, status);
-            if (handle_status != task_success)
+            if (handle_status != task_success && !parseHandleSaiStatusFailure(handle_status))
             {
-                return parseHandleSaiStatusFailure(handle_status);
+                result = false;
+                continue;
             }
         }
 
         updateTrapOperStatus(trap_id, "installed");
         m_syncdTrapIds[trap_id].trap_group_obj = trap_group_id;
-        m_syncdTrapIds[trap_id].trap_obj = hostif_trap_id;
+        m_syncdTrapIds[trap_id].trap_obj = hostif_trap_ids[i];
         m_syncdTrapIds[trap_id].trap_type = trap_id;
-        bindTrapCounter(hostif_trap_id, trap_id);
+        counter_traps.emplace_back(hostif_trap_ids[i], trap_id);
     }
-    return true;
+
+    bindTrapCounters(counter_traps);
+    return result;
 }
 
 bool CoppOrch::removePolicer(string trap_group_name)
@@ -647,6 +688,7 @@ bool CoppOrch::createPolicer(string trap_group_name, vector<sai_attribute_t> &po
         {
             obj.color = (sai_policer_color_source_t)attr.value.s32;
         }
+        obj.values[attr.id] = getPolicerAttrValue(attr);
     }
 
     SWSS_LOG_NOTICE("Bind policer to trap group %s:", trap_group_name.c_str());
@@ -805,16 +847,34 @@ task_process_status CoppOrch::processCoppRule(Consumer& consumer)
             TrapIdAttribs trap_attr = m_trap_group_trap_id_attrs[trap_group_name];
             getTrapIdsFromTrapGroup(m_trap_group_map[trap_group_name],
                                     group_trap_ids);
-            for (auto trap_id : group_trap_ids)
+
+            ObjectBulker<sai_hostif_api_t> bulker(sai_hostif_api, gSwitchId, gMaxBulkSize);
+            vector<sai_status_t> statuses(group_trap_ids.size() * trap_id_attribs.size());
+            for (size_t t = 0; t < group_trap_ids.size(); t++)
             {
-                for (auto i: trap_id_attribs)
+                for (size_t a = 0; a < trap_id_attribs.size(); a++)
                 {
-                    sai_status = sai_hostif_api->set_hostif_trap_attribute(
-                                                   m_syncdTrapIds[trap_id].trap_obj, &i);
+                    bulker.set_entry_attribute(&statuses[t * trap_id_attribs.size() + a],
+                                               m_syncdTrapIds[group_trap_ids[t]].trap_obj, &trap_id_attribs[a]);
+                }
+            }
+            bulker.flush();
+
+            for (size_t t = 0; t < group_trap_ids.size(); t++)
+            {
+                for (size_t a = 0; a < trap_id_attribs.size(); a++)
+                {
+                    auto &i = trap_id_attribs[a];
+                    sai_status = statuses[t * trap_id_attribs.size() + a];
+                    if (is_bulk_unsupported(sai_status))
+                    {
+                        sai_status = sai_hostif_api->set_hostif_trap_attribute(
+                                                       m_syncdTrapIds[group_trap_ids[t]].trap_obj, &i);
+                    }
                     if (sai_status != SAI_STATUS_SUCCESS)
                     {
                         SWSS_LOG_ERROR("Failed to set attribute %d on trap %" PRIx64 ""
-                                " on group %s", i.id, m_syncdTrapIds[trap_id].trap_obj,
+                                " on group %s", i.id, m_syncdTrapIds[group_trap_ids[t]].trap_obj,
                                 trap_group_name.c_str());
                         task_process_status handle_status = handleSaiSetStatus(SAI_API_HOSTIF, sai_status);
                         if (handle_status != task_process_status::task_success)
@@ -955,6 +1015,7 @@ void CoppOrch::doTask(SelectableTimer &timer)
             ++it;
         }
     }
+    m_trap_counter_manager.flush();
 
     if (m_pendingAddToFlexCntr.empty())
     {
@@ -1349,6 +1410,13 @@ bool CoppOrch::trapGroupUpdatePolicer (string trap_group_name,
                 continue;
             }
 
+            /* The policer of the group is kept, only the changed rates and actions are set */
+            auto value = policer_object.values.find(policer_attr.id);
+            if (value != policer_object.values.end() && value->second == getPolicerAttrValue(policer_attr))
+            {
+                continue;
+            }
+
             sai_status_t sai_status = sai_policer_api->set_policer_attribute(policer_id,
                                                                              &policer_attr);
             if (sai_status != SAI_STATUS_SUCCESS)
@@ -1361,7 +1429,9 @@ bool CoppOrch::trapGroupUpdatePolicer (string trap_group_name,
                 {
                     return parseHandleSaiStatusFailure(handle_status);
                 }
+                continue;
             }
+            m_trap_group_policer_map[m_trap_group_map[trap_group_name]].values[policer_attr.id] = getPolicerAttrValue(policer_attr);
         }
     }
     return true;
@@ -1415,7 +1485,7 @@ bool CoppOrch::removeTrap(sai_object_id_t hostif_trap_id, sai_hostif_trap_type_t
     return true;
 }
 
-bool CoppOrch::bindTrapCounter(sai_object_id_t hostif_trap_id, sai_hostif_trap_type_t trap_type)
+bool CoppOrch::bindTrapCounters(const vector<pair<sai_object_id_t, sai_hostif_trap_type_t>> &traps)
 {
     auto flex_counters_orch = gDirectory.get<FlexCounterOrch*>();
 
@@ -1424,47 +1494,107 @@ bool CoppOrch::bindTrapCounter(sai_object_id_t hostif_trap_id, sai_hostif_trap_t
         return false;
     }
 
-    if (m_trap_obj_name_map.count(hostif_trap_id) > 0)
+    vector<pair<sai_object_id_t, sai_hostif_trap_type_t>> unbound;
+    for (const auto &trap : traps)
+    {
+        if (m_trap_obj_name_map.count(trap.first) == 0)
+        {
+            unbound.push_back(trap);
+        }
+    }
+    if (unbound.empty())
     {
         return true;
     }
 
     initTrapRatePlugin();
 
-    // Create generic counter
-    sai_object_id_t counter_id;
-    if (!FlowCounterHandler::createGenericCounter(counter_id))
+    // Create generic counters
+    sai_attribute_t counter_attr;
+    counter_attr.id = SAI_COUNTER_ATTR_TYPE;
+    counter_attr.value.s32 = SAI_COUNTER_TYPE_REGULAR;
+
+    vector<sai_object_id_t> counter_ids(unbound.size(), SAI_NULL_OBJECT_ID);
+    vector<sai_status_t> statuses(unbound.size(), SAI_STATUS_SUCCESS);
+    ObjectBulker<sai_counter_api_t> counter_bulker(sai_counter_api, gSwitchId, gMaxBulkSize);
+    for (size_t i = 0; i < unbound.size(); i++)
     {
-        return false;
+        counter_bulker.create_entry(&counter_ids[i], &statuses[i], 1, &counter_attr);
     }
+    counter_bulker.flush();
 
-    // Bind generic counter to trap
-    sai_attribute_t trap_attr;
-    trap_attr.id = SAI_HOSTIF_TRAP_ATTR_COUNTER_ID;
-    trap_attr.value.oid = counter_id;
-    sai_status_t sai_status = sai_hostif_api->set_hostif_trap_attribute(hostif_trap_id, &trap_attr);
-    if (sai_status != SAI_STATUS_SUCCESS)
+    // Bind generic counters to traps
+    ObjectBulker<sai_hostif_api_t> trap_bulker(sai_hostif_api, gSwitchId, gMaxBulkSize);
+    for (size_t i = 0; i < unbound.size(); i++)
     {
-        SWSS_LOG_WARN("Failed to bind trap %" PRId64 " to counter %" PRId64 "", hostif_trap_id, counter_id);
-        return false;
+        if (is_bulk_unsupported(statuses[i]))
+        {
+            statuses[i] = FlowCounterHandler::createGenericCounter(counter_ids[i]) ? SAI_STATUS_SUCCESS : SAI_STATUS_FAILURE;
+        }
+        else if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_WARN("Failed to create generic counter");
+        }
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            counter_ids[i] = SAI_NULL_OBJECT_ID;
+            continue;
+        }
+
+        sai_attribute_t trap_attr;
+        trap_attr.id = SAI_HOSTIF_TRAP_ATTR_COUNTER_ID;
+        trap_attr.value.oid = counter_ids[i];
+        trap_bulker.set_entry_attribute(&statuses[i], unbound[i].first, &trap_attr);
     }
+    trap_bulker.flush();
 
-    // Update COUNTERS_TRAP_NAME_MAP
-    auto trap_name = get_trap_name_by_type(trap_type);
+    bool result = true;
     vector<FieldValueTuple> nameMapFvs;
-    nameMapFvs.emplace_back(trap_name, sai_serialize_object_id(counter_id));
-    m_counter_table->set("", nameMapFvs);
-
     auto was_empty = m_pendingAddToFlexCntr.empty();
-    m_pendingAddToFlexCntr[counter_id] = trap_name;
+    for (size_t i = 0; i < unbound.size(); i++)
+    {
+        auto hostif_trap_id = unbound[i].first;
+        auto counter_id = counter_ids[i];
+        if (counter_id == SAI_NULL_OBJECT_ID)
+        {
+            result = false;
+            continue;
+        }
 
-    if (was_empty)
+        sai_status_t sai_status = statuses[i];
+        if (is_bulk_unsupported(sai_status))
+        {
+            sai_attribute_t trap_attr;
+            trap_attr.id = SAI_HOSTIF_TRAP_ATTR_COUNTER_ID;
+            trap_attr.value.oid = counter_id;
+            sai_status = sai_hostif_api->set_hostif_trap_attribute(hostif_trap_id, &trap_attr);
+        }
+        if (sai_status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_WARN("Failed to bind trap %" PRId64 " to counter %" PRId64 "", hostif_trap_id, counter_id);
+            FlowCounterHandler::removeGenericCounter(counter_id);
+            result = false;
+            continue;
+        }
+
+        auto trap_name = get_trap_name_by_type(unbound[i].second);
+        nameMapFvs.emplace_back(trap_name, sai_serialize_object_id(counter_id));
+        m_pendingAddToFlexCntr[counter_id] = trap_name;
+        m_trap_obj_name_map.emplace(hostif_trap_id, trap_name);
+    }
+
+    // Update COUNTERS_TRAP_NAME_MAP
+    if (!nameMapFvs.empty())
+    {
+        m_counter_table->set("", nameMapFvs);
+    }
+
+    if (was_empty && !m_pendingAddToFlexCntr.empty())
     {
         m_FlexCounterUpdTimer->start();
     }
 
-    m_trap_obj_name_map.emplace(hostif_trap_id, trap_name);
-    return true;
+    return result;
 }
 
 void CoppOrch::unbindTrapCounter(sai_object_id_t hostif_trap_id)
@@ -1512,10 +1642,12 @@ void CoppOrch::unbindTrapCounter(sai_object_id_t hostif_trap_id)
 
 void CoppOrch::generateHostIfTrapCounterIdList()
 {
+    vector<pair<sai_object_id_t, sai_hostif_trap_type_t>> traps;
     for (const auto &kv : m_syncdTrapIds)
     {
-        bindTrapCounter(kv.second.trap_obj, kv.second.trap_type);
+        traps.emplace_back(kv.second.trap_obj, kv.second.trap_type);
     }
+    bindTrapCounters(traps);
 }
 
 void CoppOrch::clearHostIfTrapCounterIdList()
@@ -59,6 +59,8 @@ struct policer_object
     sai_meter_type_t meter;
     sai_policer_mode_t mode;
     sai_policer_color_source_t color;
+    /* Applied attribute values by attribute ID, unchanged ones aren't set again */
+    std::map<sai_attr_id_t, uint64_t> values;
 
     policer_object() : policer_id(SAI_NULL_OBJECT_ID) {}
 };
@@ -114,7 +116,7 @@ protected:
 
     std::unordered_set<sai_hostif_trap_type_t> supported_trap_ids;    
 
-    FlexCounterManager m_trap_counter_manager;
+    FlexCounterTaggedCachedManager<void> m_trap_counter_manager;
 
     bool m_trap_rate_plugin_loaded = false;
 
@@ -165,7 +167,7 @@ protected:
 
     bool removeTrap(sai_object_id_t hostif_trap_id, sai_hostif_trap_type_t trap_type);
 
-    bool bindTrapCounter(sai_object_id_t hostif_trap_id, sai_hostif_trap_type_t trap_type);
+    bool bindTrapCounters(const std::vector<std::pair<sai_object_id_t, sai_hostif_trap_type_t>> &traps);
     void unbindTrapCounter(sai_object_id_t hostif_trap_id);
 
     virtual void doTask(Consumer& consumer);
@@ -3,14 +3,61 @@
 #include "select.h"
 #include "notifier.h"
 #include "sai_serialize.h"
+#include "schema.h"
+#include <hiredis/hiredis.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <inttypes.h>
 
-#define COUNTER_CHECK_POLL_TIMEOUT_SEC   (5 * 60)
+#define COUNTER_CHECK_POLL_TIMEOUT_SEC      (5 * 60)
+/* Checks back off up to this interval while no counter moves */
+#define COUNTER_CHECK_MAX_POLL_TIMEOUT_SEC  (40 * 60)
 
 extern sai_port_api_t *sai_port_api;
 
 extern PortsOrch *gPortsOrch;
 
+static const vector<string> pfcFrameCounterNames =
+{
+    "SAI_PORT_STAT_PFC_0_RX_PKTS",
+    "SAI_PORT_STAT_PFC_1_RX_PKTS",
+    "SAI_PORT_STAT_PFC_2_RX_PKTS",
+    "SAI_PORT_STAT_PFC_3_RX_PKTS",
+    "SAI_PORT_STAT_PFC_4_RX_PKTS",
+    "SAI_PORT_STAT_PFC_5_RX_PKTS",
+    "SAI_PORT_STAT_PFC_6_RX_PKTS",
+    "SAI_PORT_STAT_PFC_7_RX_PKTS"
+};
+
+static string formatCommand(const vector<string> &args)
+{
+    vector<const char *> argv;
+    vector<size_t> argvlen;
+
+    for (const auto &arg : args)
+    {
+        argv.push_back(arg.c_str());
+        argvlen.push_back(arg.size());
+    }
+
+    RedisCommand cmd;
+    cmd.formatArgv(static_cast<int>(args.size()), argv.data(), argvlen.data());
+
+    return string(cmd.c_str(), cmd.length());
+}
+
+/* Counter of a reply element, max when it is missing */
+static uint64_t parseCounter(const redisReply *reply)
+{
+    if (reply->type != REDIS_REPLY_STRING)
+    {
+        return numeric_limits<uint64_t>::max();
+    }
+
+    return strtoull(reply->str, nullptr, 10);
+}
+
 CounterCheckOrch& CounterCheckOrch::getInstance(DBConnector *db)
 {
     SWSS_LOG_ENTER();
@@ -24,15 +71,15 @@ CounterCheckOrch& CounterCheckOrch::getInstance(DBConnector *db)
 CounterCheckOrch::CounterCheckOrch(DBConnector *db, vector<string> &tableNames):
     Orch(db, tableNames),
     m_countersDb(new DBConnector("COUNTERS_DB", 0)),
-    m_countersTable(new Table(m_countersDb.get(), COUNTERS_TABLE))
+    m_pollInterval(COUNTER_CHECK_POLL_TIMEOUT_SEC)
 {
     SWSS_LOG_ENTER();
 
-    auto interv = timespec { .tv_sec = COUNTER_CHECK_POLL_TIMEOUT_SEC, .tv_nsec = 0 };
-    auto timer = new SelectableTimer(interv);
-    auto executor = new ExecutableTimer(timer, this, "MC_COUNTERS_POLL");
+    auto interv = timespec { .tv_sec = m_pollInterval, .tv_nsec = 0 };
+    m_timer = new SelectableTimer(interv);
+    auto executor = new ExecutableTimer(m_timer, this, "MC_COUNTERS_POLL");
     Orch::addExecutor(executor);
-    timer->start();
+    m_timer->start();
 }
 
 CounterCheckOrch::~CounterCheckOrch(void)
@@ -44,191 +91,328 @@ void CounterCheckOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    mcCounterCheck();
-    pfcFrameCounterCheck();
-}
+    if (m_ports.empty())
+    {
+        return;
+    }
 
-void CounterCheckOrch::mcCounterCheck()
-{
-    SWSS_LOG_ENTER();
+    resolveMcQueues();
 
-    for (auto& i : m_mcCountersMap)
+    vector<PfcFrameCounters> pfcCounters;
+    vector<QueueMcCounters> mcCounters;
+    if (!snapshot(pfcCounters, mcCounters))
     {
-        auto oid = i.first;
-        auto mcCounters = i.second;
-        uint8_t pfcMask = 0;
+        return;
+    }
 
-        Port port;
-        if (!gPortsOrch->getPort(oid, port))
+    // Most ports do not move between checks, only those that did are looked up
+    bool changed = false;
+    for (size_t i = 0; i < m_ports.size(); i++)
+    {
+        auto &checked = m_ports[i];
+
+        if (checked.hasLast)
         {
-            SWSS_LOG_ERROR("Invalid port oid 0x%" PRIx64, oid);
-            continue;
+            if (pfcCounters[i] == checked.pfcCounters && mcCounters[i] == checked.mcCounters)
+            {
+                continue;
+            }
+
+            changed = true;
+            checkPort(checked, pfcCounters[i], mcCounters[i]);
         }
 
-        auto newMcCounters = getQueueMcCounters(port);
+        checked.pfcCounters = pfcCounters[i];
+        checked.mcCounters = move(mcCounters[i]);
+        checked.hasLast = true;
+    }
 
-        if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
+    updateInterval(changed);
+}
+
+bool CounterCheckOrch::readBatch(const vector<const string *> &cmds, vector<redisReply *> &replies)
+{
+    redisContext *ctx = m_countersDb->getContext();
+
+    for (const auto cmd : cmds)
+    {
+        if (redisAppendFormattedCommand(ctx, cmd->data(), cmd->size()) != REDIS_OK)
         {
-            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
-            continue;
+            SWSS_LOG_ERROR("Failed to queue counters read: %s", ctx->errstr);
+            return false;
         }
+    }
 
-        for (size_t prio = 0; prio != mcCounters.size(); prio++)
+    replies.assign(cmds.size(), nullptr);
+    for (size_t i = 0; i < cmds.size(); i++)
+    {
+        void *reply = nullptr;
+        if (redisGetReply(ctx, &reply) != REDIS_OK || !reply)
         {
-            bool isLossy = ((1 << prio) & pfcMask) == 0;
-            if (newMcCounters[prio] == numeric_limits<uint64_t>::max())
-            {
-                SWSS_LOG_WARN("Could not retreive MC counters on queue %zu port %s",
-                        prio,
-                        port.m_alias.c_str());
-            }
-            else if (!isLossy && mcCounters[prio] < newMcCounters[prio])
+            SWSS_LOG_ERROR("Failed to read counters: %s", ctx->errstr);
+            for (auto r : replies)
             {
-                SWSS_LOG_WARN("Got Multicast %" PRIu64 " frame(s) on lossless queue %zu port %s",
-                        newMcCounters[prio] - mcCounters[prio],
-                        prio,
-                        port.m_alias.c_str());
+                if (r)
+                {
+                    freeReplyObject(r);
+                }
             }
+            replies.clear();
+            return false;
         }
-
-        i.second= newMcCounters;
+        replies[i] = static_cast<redisReply *>(reply);
     }
+
+    return true;
 }
 
-void CounterCheckOrch::pfcFrameCounterCheck()
+void CounterCheckOrch::resolveMcQueues()
 {
     SWSS_LOG_ENTER();
 
-    for (auto& i : m_pfcFrameCountersMap)
+    vector<size_t> pending;
+    vector<vector<sai_object_id_t>> queueIds;
+    vector<string> cmds;
+
+    for (size_t i = 0; i < m_ports.size(); i++)
     {
-        auto oid = i.first;
-        auto counters = i.second;
-        auto newCounters = getPfcFrameCounters(oid);
-        uint8_t pfcMask = 0;
+        if (m_ports[i].mcResolved)
+        {
+            continue;
+        }
 
         Port port;
-        if (!gPortsOrch->getPort(oid, port))
+        if (!gPortsOrch->getPort(m_ports[i].portId, port) || port.m_queue_ids.empty())
         {
-            SWSS_LOG_ERROR("Invalid port oid 0x%" PRIx64, oid);
             continue;
         }
 
-        if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
+        vector<string> args = { "HMGET", COUNTERS_QUEUE_TYPE_MAP };
+        for (auto queueId : port.m_queue_ids)
+        {
+            args.push_back(sai_serialize_object_id(queueId));
+        }
+
+        pending.push_back(i);
+        queueIds.push_back(port.m_queue_ids);
+        cmds.push_back(formatCommand(args));
+    }
+
+    if (pending.empty())
+    {
+        return;
+    }
+
+    vector<const string *> cmdPtrs;
+    for (const auto &cmd : cmds)
+    {
+        cmdPtrs.push_back(&cmd);
+    }
+
+    vector<redisReply *> replies;
+    if (!readBatch(cmdPtrs, replies))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+        auto reply = replies[i];
+        auto &checked = m_ports[pending[i]];
+
+        // Queue types are mapped along with the queue counters, retry at the next check until they all are
+        if (reply->type != REDIS_REPLY_ARRAY || reply->elements != queueIds[i].size() ||
+            any_of(reply->element, reply->element + reply->elements,
+                   [](const redisReply *e) { return e->type != REDIS_REPLY_STRING; }))
         {
-            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
             continue;
         }
 
-        for (size_t prio = 0; prio != counters.size(); prio++)
+        checked.mcCmds.clear();
+        for (size_t q = 0; q < reply->elements; q++)
         {
-            bool isLossy = ((1 << prio) & pfcMask) == 0;
-            if (newCounters[prio] == numeric_limits<uint64_t>::max())
+            if (strcmp(reply->element[q]->str, "SAI_QUEUE_TYPE_MULTICAST") == 0)
             {
-                SWSS_LOG_WARN("Could not retreive PFC frame count on queue %zu port %s",
-                        prio,
-                        port.m_alias.c_str());
-            }
-            else if (isLossy && counters[prio] < newCounters[prio])
-            {
-                SWSS_LOG_WARN("Got PFC %" PRIu64 " frame(s) on lossy queue %zu port %s",
-                        newCounters[prio] - counters[prio],
-                        prio,
-                        port.m_alias.c_str());
+                checked.mcCmds.push_back(formatCommand({ "HGET",
+                        string(COUNTERS_TABLE) + ":" + sai_serialize_object_id(queueIds[i][q]),
+                        "SAI_QUEUE_STAT_PACKETS" }));
             }
         }
 
-        i.second = newCounters;
+        // New baseline with the multicast queues
+        checked.mcResolved = true;
+        checked.hasLast = false;
     }
-}
 
+    for (auto reply : replies)
+    {
+        freeReplyObject(reply);
+    }
+}
 
-PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId)
+bool CounterCheckOrch::snapshot(vector<PfcFrameCounters> &pfcCounters, vector<QueueMcCounters> &mcCounters)
 {
     SWSS_LOG_ENTER();
 
-    vector<FieldValueTuple> fieldValues;
-    PfcFrameCounters counters;
-    counters.fill(numeric_limits<uint64_t>::max());
-
-    static const array<string, PFC_WD_TC_MAX> counterNames =
+    vector<const string *> cmds;
+    for (const auto &checked : m_ports)
     {
-        "SAI_PORT_STAT_PFC_0_RX_PKTS",
-        "SAI_PORT_STAT_PFC_1_RX_PKTS",
-        "SAI_PORT_STAT_PFC_2_RX_PKTS",
-        "SAI_PORT_STAT_PFC_3_RX_PKTS",
-        "SAI_PORT_STAT_PFC_4_RX_PKTS",
-        "SAI_PORT_STAT_PFC_5_RX_PKTS",
-        "SAI_PORT_STAT_PFC_6_RX_PKTS",
-        "SAI_PORT_STAT_PFC_7_RX_PKTS"
-    };
-
-    if (!m_countersTable->get(sai_serialize_object_id(portId), fieldValues))
-    {
-        return counters;
+        cmds.push_back(&checked.pfcCmd);
+        for (const auto &cmd : checked.mcCmds)
+        {
+            cmds.push_back(&cmd);
+        }
     }
 
-    for (const auto& fv : fieldValues)
+    vector<redisReply *> replies;
+    if (!readBatch(cmds, replies))
     {
-        const auto field = fvField(fv);
-        const auto value = fvValue(fv);
+        return false;
+    }
 
+    pfcCounters.resize(m_ports.size());
+    mcCounters.resize(m_ports.size());
 
-        for (size_t prio = 0; prio != counterNames.size(); prio++)
+    size_t r = 0;
+    for (size_t i = 0; i < m_ports.size(); i++)
+    {
+        auto pfcReply = replies[r++];
+        pfcCounters[i].fill(numeric_limits<uint64_t>::max());
+        if (pfcReply->type == REDIS_REPLY_ARRAY && pfcReply->elements == PFC_WD_TC_MAX)
         {
-            if (field == counterNames[prio])
+            for (size_t prio = 0; prio < PFC_WD_TC_MAX; prio++)
             {
-                counters[prio] = stoul(value);
+                pfcCounters[i][prio] = parseCounter(pfcReply->element[prio]);
             }
         }
+
+        auto &mc = mcCounters[i];
+        mc.resize(m_ports[i].mcCmds.size());
+        for (auto &pkts : mc)
+        {
+            pkts = parseCounter(replies[r++]);
+        }
+    }
+
+    for (auto reply : replies)
+    {
+        freeReplyObject(reply);
     }
 
-    return counters;
+    return true;
 }
 
-QueueMcCounters CounterCheckOrch::getQueueMcCounters(
-        const Port& port)
+void CounterCheckOrch::checkPort(const CheckedPort &checked, const PfcFrameCounters &pfcCounters,
+        const QueueMcCounters &mcCounters)
 {
     SWSS_LOG_ENTER();
 
-    vector<FieldValueTuple> fieldValues;
-    QueueMcCounters counters;
+    uint8_t pfcMask = 0;
 
-    for (uint8_t prio = 0; prio < port.m_queue_ids.size(); prio++)
+    Port port;
+    if (!gPortsOrch->getPort(checked.portId, port))
     {
-        sai_object_id_t queueId = port.m_queue_ids[prio];
-        auto queueIdStr = sai_serialize_object_id(queueId);
-        auto queueType = m_countersDb->hget(COUNTERS_QUEUE_TYPE_MAP, queueIdStr);
+        SWSS_LOG_ERROR("Invalid port oid 0x%" PRIx64, checked.portId);
+        return;
+    }
 
-        if (queueType.get() == nullptr || *queueType != "SAI_QUEUE_TYPE_MULTICAST" || !m_countersTable->get(queueIdStr, fieldValues))
+    if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
+    {
+        SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
+        return;
+    }
+
+    for (size_t prio = 0; prio != mcCounters.size() && prio != checked.mcCounters.size(); prio++)
+    {
+        bool isLossy = ((1 << prio) & pfcMask) == 0;
+        if (mcCounters[prio] == numeric_limits<uint64_t>::max())
         {
-            continue;
+            SWSS_LOG_WARN("Could not retreive MC counters on queue %zu port %s",
+                    prio,
+                    port.m_alias.c_str());
         }
-
-        uint64_t pkts = numeric_limits<uint64_t>::max();
-        for (const auto& fv : fieldValues)
+        else if (!isLossy && checked.mcCounters[prio] < mcCounters[prio])
         {
-            const auto field = fvField(fv);
-            const auto value = fvValue(fv);
+            SWSS_LOG_WARN("Got Multicast %" PRIu64 " frame(s) on lossless queue %zu port %s",
+                    mcCounters[prio] - checked.mcCounters[prio],
+                    prio,
+                    port.m_alias.c_str());
+        }
+    }
 
-            if (field == "SAI_QUEUE_STAT_PACKETS")
-            {
-                pkts = stoul(value);
-            }
+    for (size_t prio = 0; prio != pfcCounters.size(); prio++)
+    {
+        bool isLossy = ((1 << prio) & pfcMask) == 0;
+        if (pfcCounters[prio] == numeric_limits<uint64_t>::max())
+        {
+            SWSS_LOG_WARN("Could not retreive PFC frame count on queue %zu port %s",
+                    prio,
+                    port.m_alias.c_str());
+        }
+        else if (isLossy && checked.pfcCounters[prio] < pfcCounters[prio])
+        {
+            SWSS_LOG_WARN("Got PFC %" PRIu64 " frame(s) on lossy queue %zu port %s",
+                    pfcCounters[prio] - checked.pfcCounters[prio],
+                    prio,
+                    port.m_alias.c_str());
         }
-        counters.push_back(pkts);
+    }
+}
+
+void CounterCheckOrch::updateInterval(bool changed)
+{
+    SWSS_LOG_ENTER();
+
+    // The counters are cumulative, a slower check still reports every frame
+    time_t interval = changed ? COUNTER_CHECK_POLL_TIMEOUT_SEC
+                              : min<time_t>(m_pollInterval * 2, COUNTER_CHECK_MAX_POLL_TIMEOUT_SEC);
+    if (interval == m_pollInterval)
+    {
+        return;
     }
 
-    return counters;
+    m_pollInterval = interval;
+    auto interv = timespec { .tv_sec = m_pollInterval, .tv_nsec = 0 };
+    m_timer->setInterval(interv);
+    m_timer->reset();
 }
 
 void CounterCheckOrch::addPort(const Port& port)
 {
-    m_mcCountersMap.emplace(port.m_port_id, getQueueMcCounters(port));
-    m_pfcFrameCountersMap.emplace(port.m_port_id, getPfcFrameCounters(port.m_port_id));
+    CheckedPort checked;
+    checked.portId = port.m_port_id;
+
+    vector<string> args = { "HMGET", string(COUNTERS_TABLE) + ":" + sai_serialize_object_id(port.m_port_id) };
+    args.insert(args.end(), pfcFrameCounterNames.begin(), pfcFrameCounterNames.end());
+    checked.pfcCmd = formatCommand(args);
+
+    auto it = m_index.find(port.m_port_id);
+    if (it != m_index.end())
+    {
+        // Reconfigured, take a new baseline
+        m_ports[it->second] = move(checked);
+        return;
+    }
+
+    m_index[port.m_port_id] = m_ports.size();
+    m_ports.push_back(move(checked));
 }
 
 void CounterCheckOrch::removePort(const Port& port)
 {
-    m_mcCountersMap.erase(port.m_port_id);
-    m_pfcFrameCountersMap.erase(port.m_port_id);
+    auto it = m_index.find(port.m_port_id);
+    if (it == m_index.end())
+    {
+        return;
+    }
+
+    size_t pos = it->second;
+    m_index.erase(it);
+
+    if (pos != m_ports.size() - 1)
+    {
+        m_ports[pos] = move(m_ports.back());
+        m_index[m_ports[pos].portId] = pos;
+    }
+    m_ports.pop_back();
 }
@@ -5,6 +5,7 @@
 #include "port.h"
 #include "timer.h"
 #include <array>
+#include <unordered_map>
 
 #define PFC_WD_TC_MAX 8
 
@@ -25,18 +26,33 @@ public:
     void removePort(const swss::Port& port);
 
 private:
+    // Counters of one port as of the last check
+    struct CheckedPort
+    {
+        sai_object_id_t portId;
+        // Multicast queues are only known once all the queue types are in COUNTERS_DB
+        bool mcResolved = false;
+        bool hasLast = false;
+        PfcFrameCounters pfcCounters;
+        QueueMcCounters mcCounters;
+        std::string pfcCmd;
+        std::vector<std::string> mcCmds;
+    };
+
     CounterCheckOrch(swss::DBConnector *db, std::vector<std::string> &tableNames);
     virtual ~CounterCheckOrch(void);
-    QueueMcCounters getQueueMcCounters(const swss::Port& port);
-    PfcFrameCounters getPfcFrameCounters(sai_object_id_t portId);
-    void mcCounterCheck();
-    void pfcFrameCounterCheck();
+    bool readBatch(const std::vector<const std::string *> &cmds, std::vector<struct redisReply *> &replies);
+    void resolveMcQueues();
+    bool snapshot(std::vector<PfcFrameCounters> &pfcCounters, std::vector<QueueMcCounters> &mcCounters);
+    void checkPort(const CheckedPort &checked, const PfcFrameCounters &pfcCounters, const QueueMcCounters &mcCounters);
+    void updateInterval(bool changed);
 
-    std::map<sai_object_id_t, QueueMcCounters> m_mcCountersMap;
-    std::map<sai_object_id_t, PfcFrameCounters> m_pfcFrameCountersMap;
+    std::vector<CheckedPort> m_ports;
+    std::unordered_map<sai_object_id_t, size_t> m_index;
 
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
-    std::shared_ptr<swss::Table> m_countersTable = nullptr;
+    swss::SelectableTimer *m_timer = nullptr;
+    time_t m_pollInterval;
 };
 
 #endif
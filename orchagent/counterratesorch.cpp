@@ -0,0 +1,625 @@
+#include "counterratesorch.h"
+#include "select.h"
+#include "sai_serialize.h"
+#include "schema.h"
+#include <hiredis/hiredis.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <inttypes.h>
+
+#define RATES_TABLE     "RATES"
+#define INIT_DONE_FIELD "INIT_DONE"
+
+/* Statistical average used for the post FEC BER, as in port_rates.lua */
+#define RS_AVERAGE_FRAME_BER 1e-8
+
+#define FEC_CODEWORD_ERROR_BINS 16
+
+using namespace std;
+using namespace swss;
+
+static const vector<string> portRateCounters = {
+    "SAI_PORT_STAT_IF_IN_UCAST_PKTS",
+    "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS",
+    "SAI_PORT_STAT_IF_OUT_UCAST_PKTS",
+    "SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS",
+    "SAI_PORT_STAT_IF_IN_OCTETS",
+    "SAI_PORT_STAT_IF_OUT_OCTETS",
+};
+
+static const vector<string> rifRateCounters = {
+    "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS",
+    "SAI_ROUTER_INTERFACE_STAT_IN_PACKETS",
+    "SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS",
+    "SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS",
+};
+
+/* Port counter indexes following the rate counters */
+#define PORT_FEC_CORRECTED_BITS         6
+#define PORT_FEC_NOT_CORRECTABLE_FRAMES 7
+#define PORT_FEC_CODEWORD_ERRORS_S0     8
+
+/* Lua renders numbers with "%.14g", keep the same text in RATES */
+static string formatNumber(double value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.14g", value);
+    return buf;
+}
+
+static string formatCommand(const vector<string> &args)
+{
+    vector<const char *> argv;
+    vector<size_t> argvlen;
+
+    for (const auto &arg : args)
+    {
+        argv.push_back(arg.c_str());
+        argvlen.push_back(arg.size());
+    }
+
+    RedisCommand cmd;
+    cmd.formatArgv(static_cast<int>(args.size()), argv.data(), argvlen.data());
+
+    return string(cmd.c_str(), cmd.length());
+}
+
+/* Serdes speed in bits per second of a lane, 0 when unknown */
+static double getSerdesSpeed(uint32_t laneSpeed)
+{
+    switch (laneSpeed)
+    {
+        case 1000:
+            return 1.25e+9;
+        case 10000:
+            return 10.3125e+9;
+        case 25000:
+            return 25.78125e+9;
+        case 50000:
+            return 53.125e+9;
+        case 100000:
+            return 106.25e+9;
+        case 200000:
+            return 212.5e+9;
+        default:
+            return 0;
+    }
+}
+
+CounterRatesOrch& CounterRatesOrch::getInstance(DBConnector *db)
+{
+    SWSS_LOG_ENTER();
+
+    static vector<string> tableNames = {};
+    static CounterRatesOrch *orch = new CounterRatesOrch(db, tableNames);
+
+    return *orch;
+}
+
+CounterRatesOrch::CounterRatesOrch(DBConnector *db, vector<string> &tableNames):
+    Orch(db, tableNames),
+    m_countersDb(new DBConnector("COUNTERS_DB", 0)),
+    m_applDb(new DBConnector("APPL_DB", 0))
+{
+    SWSS_LOG_ENTER();
+
+    m_applPortTable = unique_ptr<Table>(new Table(m_applDb.get(), APP_PORT_TABLE_NAME));
+    m_pipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_countersDb.get()));
+    m_ratesTable = unique_ptr<Table>(new Table(m_pipeline.get(), RATES_TABLE, true));
+
+    vector<string> portFields = portRateCounters;
+    portFields.push_back("SAI_PORT_STAT_IF_IN_FEC_CORRECTED_BITS");
+    portFields.push_back("SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES");
+    for (int bin = 0; bin < FEC_CODEWORD_ERROR_BINS; bin++)
+    {
+        portFields.push_back("SAI_PORT_STAT_IF_IN_FEC_CODEWORD_ERRORS_S" + to_string(bin));
+    }
+
+    /* RX_BPS, RX_PPS, TX_BPS, TX_PPS */
+    initGroup(PORT_RATES, "PORT", "PORT_ALPHA", portFields, portRateCounters.size(),
+              {{ {4, -1}, {0, 1}, {5, -1}, {2, 3} }},
+              PORT_RATES_DEFAULT_POLL_MSECS, "PORT_RATES_POLL");
+    initGroup(RIF_RATES, "RIF", "RIF_ALPHA", rifRateCounters, rifRateCounters.size(),
+              {{ {0, -1}, {1, -1}, {2, -1}, {3, -1} }},
+              RIF_RATES_DEFAULT_POLL_MSECS, "RIF_RATES_POLL");
+}
+
+CounterRatesOrch::~CounterRatesOrch(void)
+{
+    SWSS_LOG_ENTER();
+}
+
+void CounterRatesOrch::initGroup(RateGroupId id, const string &name, const string &alphaField,
+                                 const vector<string> &fields, size_t rateCounters,
+                                 const array<array<int, 2>, RATE_FIELD_COUNT> &rateInputs,
+                                 uint32_t pollMsecs, const string &timerName)
+{
+    auto &group = m_groups[id];
+
+    group.name = name;
+    group.alphaField = alphaField;
+    group.alphaCmd = formatCommand({ "HGET", string(RATES_TABLE) + ":" + name, alphaField });
+    group.fields = fields;
+    group.rateCounters = rateCounters;
+    group.rateInputs = rateInputs;
+    group.pollMsecs = pollMsecs;
+    group.pollStats = ExecutorStatsRegistry::instance().attachCounterPollStats(name + "_RATES");
+
+    auto interv = timespec { .tv_sec = pollMsecs / 1000, .tv_nsec = (pollMsecs % 1000) * 1000000 };
+    group.timer = new SelectableTimer(interv);
+    auto executor = new ExecutableTimer(group.timer, this, timerName);
+    Orch::addExecutor(executor);
+}
+
+void CounterRatesOrch::addPort(const Port& port)
+{
+    SWSS_LOG_ENTER();
+
+    auto object = addObject(PORT_RATES, port.m_port_id);
+    if (!object)
+    {
+        return;
+    }
+
+    object->speed = port.m_speed;
+    object->laneCount = getPortLaneCount(port.m_alias);
+}
+
+void CounterRatesOrch::removePort(sai_object_id_t portId)
+{
+    SWSS_LOG_ENTER();
+
+    removeObject(PORT_RATES, portId);
+}
+
+void CounterRatesOrch::setPortSpeed(sai_object_id_t portId, uint32_t speed)
+{
+    SWSS_LOG_ENTER();
+
+    auto &group = m_groups[PORT_RATES];
+    auto it = group.index.find(portId);
+    if (it == group.index.end())
+    {
+        return;
+    }
+
+    group.objects[it->second].speed = speed;
+}
+
+void CounterRatesOrch::addRif(sai_object_id_t rifId)
+{
+    SWSS_LOG_ENTER();
+
+    addObject(RIF_RATES, rifId);
+}
+
+void CounterRatesOrch::removeRif(sai_object_id_t rifId)
+{
+    SWSS_LOG_ENTER();
+
+    removeObject(RIF_RATES, rifId);
+}
+
+void CounterRatesOrch::setPollInterval(RateGroupId id, const string &msecs)
+{
+    SWSS_LOG_ENTER();
+
+    auto &group = m_groups[id];
+    uint32_t interval;
+
+    try
+    {
+        interval = static_cast<uint32_t>(stoul(msecs));
+    }
+    catch (const exception &)
+    {
+        SWSS_LOG_ERROR("Invalid %s rates poll interval %s", group.name.c_str(), msecs.c_str());
+        return;
+    }
+
+    if (interval == 0 || interval == group.pollMsecs)
+    {
+        return;
+    }
+
+    group.pollMsecs = interval;
+    auto interv = timespec { .tv_sec = interval / 1000, .tv_nsec = (interval % 1000) * 1000000 };
+    group.timer->setInterval(interv);
+    if (group.running)
+    {
+        group.timer->reset();
+    }
+
+    SWSS_LOG_NOTICE("Set %s rates poll interval to %u ms", group.name.c_str(), interval);
+}
+
+void CounterRatesOrch::setState(RateGroupId id, bool enable)
+{
+    SWSS_LOG_ENTER();
+
+    auto &group = m_groups[id];
+
+    group.enabled = enable;
+    updateTimer(group);
+}
+
+CounterRatesOrch::RateObject *CounterRatesOrch::addObject(RateGroupId id, sai_object_id_t oid)
+{
+    auto &group = m_groups[id];
+
+    if (oid == SAI_NULL_OBJECT_ID || group.index.find(oid) != group.index.end())
+    {
+        return nullptr;
+    }
+
+    RateObject object;
+    object.oid = oid;
+    object.key = sai_serialize_object_id(oid);
+
+    vector<string> args = { "HMGET", string(COUNTERS_TABLE) + ":" + object.key };
+    args.insert(args.end(), group.fields.begin(), group.fields.end());
+    object.readCmd = formatCommand(args);
+
+    group.index[oid] = group.objects.size();
+    group.objects.push_back(move(object));
+    group.last.resize(group.last.size() + group.fields.size(), 0);
+    group.rates.resize(group.rates.size() + RATE_FIELD_COUNT, 0);
+
+    updateTimer(group);
+
+    return &group.objects.back();
+}
+
+void CounterRatesOrch::removeObject(RateGroupId id, sai_object_id_t oid)
+{
+    auto &group = m_groups[id];
+
+    auto it = group.index.find(oid);
+    if (it == group.index.end())
+    {
+        return;
+    }
+
+    /* Move the last object into the hole to keep the arrays contiguous */
+    size_t i = it->second;
+    size_t back = group.objects.size() - 1;
+    size_t fieldCount = group.fields.size();
+
+    group.index.erase(it);
+    if (i != back)
+    {
+        group.objects[i] = move(group.objects[back]);
+        copy_n(group.last.begin() + back * fieldCount, fieldCount, group.last.begin() + i * fieldCount);
+        copy_n(group.rates.begin() + back * RATE_FIELD_COUNT, RATE_FIELD_COUNT, group.rates.begin() + i * RATE_FIELD_COUNT);
+        group.index[group.objects[i].oid] = i;
+    }
+
+    group.objects.pop_back();
+    group.last.resize(back * fieldCount);
+    group.rates.resize(back * RATE_FIELD_COUNT);
+
+    updateTimer(group);
+}
+
+void CounterRatesOrch::updateTimer(RateGroup &group)
+{
+    bool run = group.enabled && !group.objects.empty();
+
+    if (run && !group.running)
+    {
+        group.timer->start();
+    }
+    else if (!run && group.running)
+    {
+        group.timer->stop();
+    }
+
+    group.running = run;
+}
+
+uint32_t CounterRatesOrch::getPortLaneCount(const string &alias)
+{
+    string lanes;
+
+    if (!m_applPortTable->hget(alias, "lanes", lanes) || lanes.empty())
+    {
+        return 0;
+    }
+
+    return static_cast<uint32_t>(count(lanes.begin(), lanes.end(), ',') + 1);
+}
+
+void CounterRatesOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t id = 0; id < m_groups.size(); id++)
+    {
+        if (m_groups[id].timer == &timer)
+        {
+            updateRates(static_cast<RateGroupId>(id));
+        }
+    }
+}
+
+bool CounterRatesOrch::readBatch(const vector<const string *> &cmds, vector<redisReply *> &replies)
+{
+    redisContext *ctx = m_countersDb->getContext();
+
+    for (const auto cmd : cmds)
+    {
+        if (redisAppendFormattedCommand(ctx, cmd->data(), cmd->size()) != REDIS_OK)
+        {
+            SWSS_LOG_ERROR("Failed to queue counters read: %s", ctx->errstr);
+            return false;
+        }
+    }
+
+    replies.assign(cmds.size(), nullptr);
+    for (size_t i = 0; i < cmds.size(); i++)
+    {
+        void *reply = nullptr;
+        if (redisGetReply(ctx, &reply) != REDIS_OK || !reply)
+        {
+            SWSS_LOG_ERROR("Failed to read counters: %s", ctx->errstr);
+            for (auto r : replies)
+            {
+                if (r)
+                {
+                    freeReplyObject(r);
+                }
+            }
+            replies.clear();
+            return false;
+        }
+        replies[i] = static_cast<redisReply *>(reply);
+    }
+
+    return true;
+}
+
+void CounterRatesOrch::updateRates(RateGroupId id)
+{
+    auto &group = m_groups[id];
+    size_t fieldCount = group.fields.size();
+    auto start = chrono::steady_clock::now();
+
+    /*
+     * One batch: the alpha of the group, the counters of every object, and
+     * for ports seen for the first time the FEC_PRE_BER_MAX kept in RATES.
+     */
+    vector<const string *> cmds;
+    vector<string> berMaxCmds;
+    vector<size_t> berMaxObjects;
+
+    cmds.reserve(group.objects.size() + 1);
+    cmds.push_back(&group.alphaCmd);
+    for (const auto &object : group.objects)
+    {
+        cmds.push_back(&object.readCmd);
+    }
+    if (id == PORT_RATES)
+    {
+        for (size_t i = 0; i < group.objects.size(); i++)
+        {
+            if (!group.objects[i].berMaxLoaded)
+            {
+                berMaxCmds.push_back(formatCommand({ "HGET", string(RATES_TABLE) + ":" + group.objects[i].key, "FEC_PRE_BER_MAX" }));
+                berMaxObjects.push_back(i);
+            }
+        }
+        for (const auto &cmd : berMaxCmds)
+        {
+            cmds.push_back(&cmd);
+        }
+    }
+
+    vector<redisReply *> replies;
+    if (!readBatch(cmds, replies))
+    {
+        return;
+    }
+
+    string alpha;
+    if (replies[0]->type == REDIS_REPLY_STRING)
+    {
+        alpha.assign(replies[0]->str, replies[0]->len);
+    }
+
+    size_t berMaxReply = group.objects.size() + 1;
+    for (size_t j = 0; j < berMaxObjects.size(); j++)
+    {
+        auto reply = replies[berMaxReply + j];
+        auto &object = group.objects[berMaxObjects[j]];
+
+        object.berMaxLoaded = true;
+        if (reply->type == REDIS_REPLY_STRING)
+        {
+            try
+            {
+                object.berMax = stod(string(reply->str, reply->len));
+            }
+            catch (const exception &)
+            {
+                object.berMax = 0;
+            }
+        }
+    }
+
+    vector<uint64_t> cur(fieldCount);
+    vector<uint8_t> present(fieldCount);
+
+    for (size_t i = 0; i < group.objects.size(); i++)
+    {
+        auto reply = replies[i + 1];
+
+        if (reply->type != REDIS_REPLY_ARRAY || reply->elements != fieldCount)
+        {
+            continue;
+        }
+
+        for (size_t f = 0; f < fieldCount; f++)
+        {
+            auto element = reply->element[f];
+            present[f] = element->type == REDIS_REPLY_STRING;
+            cur[f] = present[f] ? strtoull(element->str, nullptr, 10) : 0;
+        }
+
+        vector<FieldValueTuple> fvs;
+        computeRates(group, i, cur, present, alpha, fvs);
+        if (id == PORT_RATES)
+        {
+            computeBer(group, i, cur, present, fvs);
+        }
+
+        if (!fvs.empty())
+        {
+            m_ratesTable->set(group.objects[i].key, fvs);
+        }
+    }
+
+    for (auto reply : replies)
+    {
+        freeReplyObject(reply);
+    }
+
+    m_pipeline->flush();
+
+    if (group.pollStats)
+    {
+        group.pollStats->recordPoll(group.objects.size(), chrono::steady_clock::now() - start);
+    }
+}
+
+void CounterRatesOrch::computeRates(RateGroup &group, size_t i, const vector<uint64_t> &cur,
+                                    const vector<uint8_t> &present, const string &alpha,
+                                    vector<FieldValueTuple> &fvs)
+{
+    auto &object = group.objects[i];
+    uint64_t *last = group.last.data() + i * group.fields.size();
+    double *rates = group.rates.data() + i * RATE_FIELD_COUNT;
+
+    if (alpha.empty())
+    {
+        return;
+    }
+
+    for (size_t f = 0; f < group.rateCounters; f++)
+    {
+        if (!present[f])
+        {
+            return;
+        }
+    }
+
+    double a;
+    try
+    {
+        a = stod(alpha);
+    }
+    catch (const exception &)
+    {
+        SWSS_LOG_ERROR("Invalid %s %s", group.alphaField.c_str(), alpha.c_str());
+        return;
+    }
+
+    string stateKey = object.key + ":" + group.name;
+
+    if (object.state == RATE_INIT)
+    {
+        object.state = RATE_COUNTERS_LAST;
+        m_ratesTable->set(stateKey, { { INIT_DONE_FIELD, "COUNTERS_LAST" } });
+    }
+    else
+    {
+        static const array<string, RATE_FIELD_COUNT> rateNames = { "RX_BPS", "RX_PPS", "TX_BPS", "TX_PPS" };
+        double scale = 1000.0 / group.pollMsecs;
+
+        for (size_t r = 0; r < RATE_FIELD_COUNT; r++)
+        {
+            double delta = 0;
+            for (int input : group.rateInputs[r])
+            {
+                if (input >= 0)
+                {
+                    delta += static_cast<double>(cur[static_cast<size_t>(input)]) - static_cast<double>(last[input]);
+                }
+            }
+
+            double rate = delta * scale;
+            rates[r] = object.state == RATE_DONE ? a * rate + (1.0 - a) * rates[r] : rate;
+            fvs.emplace_back(rateNames[r], formatNumber(rates[r]));
+        }
+
+        if (object.state == RATE_COUNTERS_LAST)
+        {
+            object.state = RATE_DONE;
+            m_ratesTable->set(stateKey, { { INIT_DONE_FIELD, "DONE" } });
+        }
+    }
+
+    for (size_t f = 0; f < group.rateCounters; f++)
+    {
+        last[f] = cur[f];
+        fvs.emplace_back(group.fields[f] + "_last", to_string(cur[f]));
+    }
+}
+
+void CounterRatesOrch::computeBer(RateGroup &group, size_t i, const vector<uint64_t> &cur,
+                                  const vector<uint8_t> &present, vector<FieldValueTuple> &fvs)
+{
+    auto &object = group.objects[i];
+    uint64_t *last = group.last.data() + i * group.fields.size();
+
+    if (!present[PORT_FEC_CORRECTED_BITS] || !present[PORT_FEC_NOT_CORRECTABLE_FRAMES])
+    {
+        return;
+    }
+
+    double serdesRateTotal = 0;
+    if (object.laneCount != 0 && object.speed % object.laneCount == 0)
+    {
+        serdesRateTotal = object.laneCount * getSerdesSpeed(object.speed / object.laneCount) * group.pollMsecs / 1000;
+    }
+
+    /* The first poll only records the counters, there is no interval to compute a BER on yet */
+    if (object.fecLastValid && serdesRateTotal > 0)
+    {
+        double preBer = (static_cast<double>(cur[PORT_FEC_CORRECTED_BITS]) -
+                         static_cast<double>(last[PORT_FEC_CORRECTED_BITS])) / serdesRateTotal;
+        double postBer = (static_cast<double>(cur[PORT_FEC_NOT_CORRECTABLE_FRAMES]) -
+                          static_cast<double>(last[PORT_FEC_NOT_CORRECTABLE_FRAMES])) * RS_AVERAGE_FRAME_BER / serdesRateTotal;
+
+        /* Maximum FEC histogram bin with a non zero count */
+        int maxT = -1;
+        for (int bin = 0; bin < FEC_CODEWORD_ERROR_BINS; bin++)
+        {
+            if (present[PORT_FEC_CODEWORD_ERRORS_S0 + bin] && cur[PORT_FEC_CODEWORD_ERRORS_S0 + bin] > 0)
+            {
+                maxT = bin;
+            }
+        }
+
+        if (preBer > object.berMax)
+        {
+            object.berMax = preBer;
+            fvs.emplace_back("FEC_PRE_BER_MAX", formatNumber(preBer));
+        }
+        fvs.emplace_back("FEC_PRE_BER", formatNumber(preBer));
+        fvs.emplace_back("FEC_POST_BER", formatNumber(postBer));
+        fvs.emplace_back("FEC_MAX_T", to_string(maxT));
+    }
+    else if (serdesRateTotal <= 0)
+    {
+        SWSS_LOG_DEBUG("Lane info not found on port %s", object.key.c_str());
+    }
+
+    last[PORT_FEC_CORRECTED_BITS] = cur[PORT_FEC_CORRECTED_BITS];
+    last[PORT_FEC_NOT_CORRECTABLE_FRAMES] = cur[PORT_FEC_NOT_CORRECTABLE_FRAMES];
+    object.fecLastValid = true;
+
+    /* The historical field names of port_rates.lua, typo included */
+    fvs.emplace_back("SAI_PORT_STAT_IF_FEC_CORRECTED_BITS_last", to_string(cur[PORT_FEC_CORRECTED_BITS]));
+    fvs.emplace_back("SAI_PORT_STAT_IF_FEC_NOT_CORRECTABLE_FARMES_last", to_string(cur[PORT_FEC_NOT_CORRECTABLE_FRAMES]));
+}
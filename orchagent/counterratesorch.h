@@ -0,0 +1,147 @@
+#ifndef COUNTERRATES_ORCH_H
+#define COUNTERRATES_ORCH_H
+
+#include "orch.h"
+#include "port.h"
+#include "timer.h"
+#include "redispipeline.h"
+#include "table.h"
+#include <array>
+#include <memory>
+#include <unordered_map>
+
+extern "C" {
+#include "sai.h"
+}
+
+#define PORT_RATES_DEFAULT_POLL_MSECS   1000
+#define RIF_RATES_DEFAULT_POLL_MSECS    1000
+
+/*
+ * Computes the port and router interface rates of the RATES table in
+ * COUNTERS_DB, which port_rates.lua and rif_rates.lua used to compute inside
+ * redis on every flex counter poll with one HGET/HSET per counter.
+ *
+ * The objects are registered by PortsOrch and IntfsOrch when their counters
+ * are installed. Each group (PORT, RIF) polls on a timer following the poll
+ * interval of its flex counter group: the counters of all the objects are
+ * read with one pipelined batch of HMGET, the previous counters and rates
+ * are kept in memory, and the RATES entries are written back with one
+ * pipelined batch. The RATES layout, field names and INIT_DONE states are
+ * the ones of the Lua plugins, so the CLI keeps working unchanged.
+ *
+ * Gearbox BER is still computed by port_rates.lua on GB_COUNTERS_DB.
+ */
+class CounterRatesOrch: public Orch
+{
+public:
+    enum RateGroupId
+    {
+        PORT_RATES = 0,
+        RIF_RATES,
+        RATE_GROUP_COUNT
+    };
+
+    static CounterRatesOrch& getInstance(swss::DBConnector *db = nullptr);
+    virtual void doTask(swss::SelectableTimer &timer);
+    virtual void doTask(Consumer &consumer) {}
+
+    void addPort(const swss::Port& port);
+    void removePort(sai_object_id_t portId);
+    void setPortSpeed(sai_object_id_t portId, uint32_t speed);
+    void addRif(sai_object_id_t rifId);
+    void removeRif(sai_object_id_t rifId);
+
+    /* Follow the POLL_INTERVAL and FLEX_COUNTER_STATUS of the flex counter groups */
+    void setPollInterval(RateGroupId id, const std::string &msecs);
+    void setState(RateGroupId id, bool enable);
+
+private:
+    enum RateState : uint8_t
+    {
+        RATE_INIT,
+        RATE_COUNTERS_LAST,
+        RATE_DONE
+    };
+
+    enum RateField
+    {
+        RX_BPS = 0,
+        RX_PPS,
+        TX_BPS,
+        TX_PPS,
+        RATE_FIELD_COUNT
+    };
+
+    struct RateObject
+    {
+        sai_object_id_t oid;
+        std::string key;
+        /* Preformatted HMGET of the counters of the object */
+        std::string readCmd;
+        RateState state = RATE_INIT;
+
+        /* Port BER */
+        uint32_t speed = 0;
+        uint32_t laneCount = 0;
+        bool fecLastValid = false;
+        bool berMaxLoaded = false;
+        double berMax = 0;
+    };
+
+    struct RateGroup
+    {
+        std::string name;
+        std::string alphaField;
+        std::string alphaCmd;
+        /* COUNTERS fields read for every object, the first rateCounters feed the rates */
+        std::vector<std::string> fields;
+        size_t rateCounters;
+        /* Counter indexes summed into each rate, -1 when unused */
+        std::array<std::array<int, 2>, RATE_FIELD_COUNT> rateInputs;
+
+        swss::SelectableTimer *timer = nullptr;
+        uint32_t pollMsecs;
+        bool enabled = true;
+        bool running = false;
+        /* Null unless executor statistics are collected */
+        std::shared_ptr<CounterPollStats> pollStats;
+
+        std::vector<RateObject> objects;
+        /* fields.size() counters per object, in objects order */
+        std::vector<uint64_t> last;
+        /* RATE_FIELD_COUNT rates per object, in objects order */
+        std::vector<double> rates;
+        std::unordered_map<sai_object_id_t, size_t> index;
+    };
+
+    CounterRatesOrch(swss::DBConnector *db, std::vector<std::string> &tableNames);
+    virtual ~CounterRatesOrch(void);
+
+    void initGroup(RateGroupId id, const std::string &name, const std::string &alphaField,
+                   const std::vector<std::string> &fields, size_t rateCounters,
+                   const std::array<std::array<int, 2>, RATE_FIELD_COUNT> &rateInputs,
+                   uint32_t pollMsecs, const std::string &timerName);
+    RateObject *addObject(RateGroupId id, sai_object_id_t oid);
+    void removeObject(RateGroupId id, sai_object_id_t oid);
+    void updateTimer(RateGroup &group);
+    uint32_t getPortLaneCount(const std::string &alias);
+
+    bool readBatch(const std::vector<const std::string *> &cmds, std::vector<redisReply *> &replies);
+    void updateRates(RateGroupId id);
+    void computeRates(RateGroup &group, size_t i, const std::vector<uint64_t> &cur,
+                      const std::vector<uint8_t> &present, const std::string &alpha,
+                      std::vector<swss::FieldValueTuple> &fvs);
+    void computeBer(RateGroup &group, size_t i, const std::vector<uint64_t> &cur,
+                    const std::vector<uint8_t> &present, std::vector<swss::FieldValueTuple> &fvs);
+
+    std::array<RateGroup, RATE_GROUP_COUNT> m_groups;
+
+    std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
+    std::shared_ptr<swss::DBConnector> m_applDb = nullptr;
+    std::unique_ptr<swss::Table> m_applPortTable;
+    std::unique_ptr<swss::RedisPipeline> m_pipeline;
+    std::unique_ptr<swss::Table> m_ratesTable;
+};
+
+#endif
@@ -0,0 +1,310 @@
+#include "countersnapshotorch.h"
+#include "portsorch.h"
+#include "select.h"
+#include "sai_serialize.h"
+#include "schema.h"
+#include "redispipeline.h"
+#include <hiredis/hiredis.h>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+using namespace std;
+using namespace swss;
+
+string CounterSnapshotOrch::m_path;
+
+static string formatHmget(const string &key, const vector<string> &fields)
+{
+    vector<const char *> argv = { "HMGET", key.c_str() };
+    vector<size_t> argvlen = { 5, key.size() };
+
+    for (const auto &field : fields)
+    {
+        argv.push_back(field.c_str());
+        argvlen.push_back(field.size());
+    }
+
+    RedisCommand cmd;
+    cmd.formatArgv(static_cast<int>(argv.size()), argv.data(), argvlen.data());
+
+    return string(cmd.c_str(), cmd.length());
+}
+
+CounterSnapshotOrch& CounterSnapshotOrch::getInstance(DBConnector *db)
+{
+    SWSS_LOG_ENTER();
+
+    static vector<string> tableNames = {};
+    static CounterSnapshotOrch *orch = new CounterSnapshotOrch(db, tableNames);
+
+    return *orch;
+}
+
+void CounterSnapshotOrch::setPath(const string &path)
+{
+    m_path = path;
+}
+
+bool CounterSnapshotOrch::isEnabled()
+{
+    return !m_path.empty();
+}
+
+CounterSnapshotOrch::CounterSnapshotOrch(DBConnector *db, vector<string> &tableNames):
+    Orch(db, tableNames),
+    m_countersDb(new DBConnector("COUNTERS_DB", 0))
+{
+    SWSS_LOG_ENTER();
+
+    initSection(CounterSnapshotSection::PORT, PORT_STAT_COUNTER_FLEX_COUNTER_GROUP,
+                PORT_SNAPSHOT_DEFAULT_POLL_MSECS, "PORT_SNAPSHOT_POLL");
+    initSection(CounterSnapshotSection::QUEUE, QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP,
+                QUEUE_SNAPSHOT_DEFAULT_POLL_MSECS, "QUEUE_SNAPSHOT_POLL");
+    initSection(CounterSnapshotSection::PRIORITY_GROUP, PG_DROP_STAT_COUNTER_FLEX_COUNTER_GROUP,
+                PG_SNAPSHOT_DEFAULT_POLL_MSECS, "PG_SNAPSHOT_POLL");
+
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    try
+    {
+        m_writer = unique_ptr<CounterSnapshotWriter>(new CounterSnapshotWriter(m_path));
+    }
+    catch (const runtime_error &e)
+    {
+        SWSS_LOG_ERROR("Counter snapshot disabled: %s", e.what());
+        return;
+    }
+
+    FlexCounterManager::setListener(this);
+    SWSS_LOG_NOTICE("Publishing counter snapshot at %s", m_path.c_str());
+}
+
+CounterSnapshotOrch::~CounterSnapshotOrch(void)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounterManager::setListener(nullptr);
+}
+
+void CounterSnapshotOrch::initSection(CounterSnapshotSection id, const string &groupName,
+                                      uint32_t pollMsecs, const string &timerName)
+{
+    auto &section = m_sections[static_cast<size_t>(id)];
+
+    section.groupName = groupName;
+    section.pollMsecs = pollMsecs;
+    section.pollStats = ExecutorStatsRegistry::instance().attachCounterPollStats(groupName + "_SNAPSHOT");
+
+    auto interv = timespec { .tv_sec = pollMsecs / 1000, .tv_nsec = (pollMsecs % 1000) * 1000000 };
+    section.timer = new SelectableTimer(interv);
+    auto executor = new ExecutableTimer(section.timer, this, timerName);
+    Orch::addExecutor(executor);
+}
+
+CounterSnapshotOrch::SnapshotSection *CounterSnapshotOrch::getSection(const string &groupName, CounterSnapshotSection &id)
+{
+    for (size_t i = 0; i < m_sections.size(); i++)
+    {
+        if (m_sections[i].groupName == groupName)
+        {
+            id = static_cast<CounterSnapshotSection>(i);
+            return &m_sections[i];
+        }
+    }
+
+    return nullptr;
+}
+
+void CounterSnapshotOrch::onCounterIdListSet(const string &group_name, const sai_object_id_t object_id,
+                                             const unordered_set<string> &counter_stats)
+{
+    SWSS_LOG_ENTER();
+
+    CounterSnapshotSection id;
+    auto section = getSection(group_name, id);
+    if (!section || !m_writer)
+    {
+        return;
+    }
+
+    if (!m_writer->addObject(id, object_id))
+    {
+        return;
+    }
+
+    /* Keep the counters in a stable order so that objects share the name table */
+    vector<string> stats(counter_stats.begin(), counter_stats.end());
+    sort(stats.begin(), stats.end());
+
+    SnapshotObject object;
+    vector<string> fields;
+    for (const auto &stat : stats)
+    {
+        int index = m_writer->getCounterIndex(id, stat);
+        if (index < 0)
+        {
+            continue;
+        }
+        fields.push_back(stat);
+        object.indexes.push_back(index);
+    }
+
+    if (fields.empty())
+    {
+        m_writer->removeObject(id, object_id);
+        section->objects.erase(object_id);
+        updateTimer(*section);
+        return;
+    }
+
+    object.readCmd = formatHmget(string(COUNTERS_TABLE) + ":" + sai_serialize_object_id(object_id), fields);
+    section->objects[object_id] = move(object);
+
+    updateTimer(*section);
+}
+
+void CounterSnapshotOrch::onCounterIdListCleared(const string &group_name, const sai_object_id_t object_id)
+{
+    SWSS_LOG_ENTER();
+
+    CounterSnapshotSection id;
+    auto section = getSection(group_name, id);
+    if (!section || !m_writer)
+    {
+        return;
+    }
+
+    if (section->objects.erase(object_id))
+    {
+        m_writer->removeObject(id, object_id);
+        updateTimer(*section);
+    }
+}
+
+void CounterSnapshotOrch::setPollInterval(const string &group_name, const string &msecs)
+{
+    SWSS_LOG_ENTER();
+
+    CounterSnapshotSection id;
+    auto section = getSection(group_name, id);
+    if (!section)
+    {
+        return;
+    }
+
+    uint32_t interval;
+    try
+    {
+        interval = static_cast<uint32_t>(stoul(msecs));
+    }
+    catch (const exception &)
+    {
+        SWSS_LOG_ERROR("Invalid %s snapshot poll interval %s", group_name.c_str(), msecs.c_str());
+        return;
+    }
+
+    if (interval == 0 || interval == section->pollMsecs)
+    {
+        return;
+    }
+
+    section->pollMsecs = interval;
+    auto interv = timespec { .tv_sec = interval / 1000, .tv_nsec = (interval % 1000) * 1000000 };
+    section->timer->setInterval(interv);
+    if (section->running)
+    {
+        section->timer->reset();
+    }
+}
+
+void CounterSnapshotOrch::updateTimer(SnapshotSection &section)
+{
+    bool run = m_writer && !section.objects.empty();
+
+    if (run && !section.running)
+    {
+        section.timer->start();
+    }
+    else if (!run && section.running)
+    {
+        section.timer->stop();
+    }
+
+    section.running = run;
+}
+
+void CounterSnapshotOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t i = 0; i < m_sections.size(); i++)
+    {
+        if (m_sections[i].timer == &timer)
+        {
+            updateSnapshot(static_cast<CounterSnapshotSection>(i));
+        }
+    }
+}
+
+void CounterSnapshotOrch::updateSnapshot(CounterSnapshotSection id)
+{
+    auto &section = m_sections[static_cast<size_t>(id)];
+    redisContext *ctx = m_countersDb->getContext();
+    auto start = chrono::steady_clock::now();
+
+    /* Queue the reads of all the objects, then collect the replies in order */
+    for (const auto &it : section.objects)
+    {
+        const auto &cmd = it.second.readCmd;
+        if (redisAppendFormattedCommand(ctx, cmd.data(), cmd.size()) != REDIS_OK)
+        {
+            SWSS_LOG_ERROR("Failed to queue counter snapshot read: %s", ctx->errstr);
+            return;
+        }
+    }
+
+    vector<uint64_t> values;
+    vector<uint8_t> valid;
+
+    for (const auto &it : section.objects)
+    {
+        void *r = nullptr;
+        if (redisGetReply(ctx, &r) != REDIS_OK || !r)
+        {
+            SWSS_LOG_ERROR("Failed to read counter snapshot: %s", ctx->errstr);
+            return;
+        }
+        auto reply = static_cast<redisReply *>(r);
+        const auto &indexes = it.second.indexes;
+
+        if (reply->type == REDIS_REPLY_ARRAY && reply->elements == indexes.size())
+        {
+            size_t count = static_cast<size_t>(*max_element(indexes.begin(), indexes.end())) + 1;
+            values.assign(count, 0);
+            valid.assign(count, 0);
+
+            for (size_t f = 0; f < indexes.size(); f++)
+            {
+                auto element = reply->element[f];
+                if (element->type == REDIS_REPLY_STRING)
+                {
+                    values[indexes[f]] = strtoull(element->str, nullptr, 10);
+                    valid[indexes[f]] = 1;
+                }
+            }
+
+            m_writer->update(id, it.first, values, valid);
+        }
+
+        freeReplyObject(reply);
+    }
+
+    if (section.pollStats)
+    {
+        section.pollStats->recordPoll(section.objects.size(), chrono::steady_clock::now() - start);
+    }
+}
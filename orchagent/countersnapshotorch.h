@@ -0,0 +1,83 @@
+#ifndef COUNTERSNAPSHOT_ORCH_H
+#define COUNTERSNAPSHOT_ORCH_H
+
+#include "orch.h"
+#include "timer.h"
+#include "flex_counter/flex_counter_manager.h"
+#include "flex_counter/counter_snapshot.h"
+#include <array>
+#include <memory>
+#include <unordered_map>
+
+#define PORT_SNAPSHOT_DEFAULT_POLL_MSECS    1000
+#define QUEUE_SNAPSHOT_DEFAULT_POLL_MSECS   10000
+#define PG_SNAPSHOT_DEFAULT_POLL_MSECS      10000
+
+/*
+ * Publishes the port, queue and PG counters of COUNTERS_DB in a memory
+ * mapped snapshot (see flex_counter/counter_snapshot.h), so that local
+ * consumers polling many counters read them lock free instead of issuing
+ * one HGETALL per object to redis.
+ *
+ * The objects follow the counter id lists installed through the flex
+ * counter managers of PortsOrch. Each section polls on a timer following
+ * the poll interval of its flex counter group and reads the counters of
+ * all its objects with one pipelined batch of HMGET.
+ *
+ * Disabled unless orchagent is started with a snapshot path (-C).
+ */
+class CounterSnapshotOrch: public Orch, public FlexCounterListener
+{
+public:
+    static CounterSnapshotOrch& getInstance(swss::DBConnector *db = nullptr);
+    static void setPath(const std::string &path);
+    static bool isEnabled();
+
+    virtual void doTask(swss::SelectableTimer &timer);
+    virtual void doTask(Consumer &consumer) {}
+
+    virtual void onCounterIdListSet(const std::string &group_name, const sai_object_id_t object_id,
+                                    const std::unordered_set<std::string> &counter_stats);
+    virtual void onCounterIdListCleared(const std::string &group_name, const sai_object_id_t object_id);
+
+    /* Follow the POLL_INTERVAL of the flex counter group */
+    void setPollInterval(const std::string &group_name, const std::string &msecs);
+
+private:
+    struct SnapshotObject
+    {
+        /* Preformatted HMGET of the counters of the object */
+        std::string readCmd;
+        /* Snapshot counter index of every field of readCmd */
+        std::vector<int> indexes;
+    };
+
+    struct SnapshotSection
+    {
+        std::string groupName;
+        swss::SelectableTimer *timer = nullptr;
+        uint32_t pollMsecs;
+        bool running = false;
+        /* Null unless executor statistics are collected */
+        std::shared_ptr<CounterPollStats> pollStats;
+        std::unordered_map<sai_object_id_t, SnapshotObject> objects;
+    };
+
+    CounterSnapshotOrch(swss::DBConnector *db, std::vector<std::string> &tableNames);
+    virtual ~CounterSnapshotOrch(void);
+
+    void initSection(CounterSnapshotSection id, const std::string &groupName,
+                     uint32_t pollMsecs, const std::string &timerName);
+    SnapshotSection *getSection(const std::string &groupName, CounterSnapshotSection &id);
+    void updateTimer(SnapshotSection &section);
+    void updateSnapshot(CounterSnapshotSection id);
+
+    static std::string m_path;
+
+    std::array<SnapshotSection, static_cast<size_t>(CounterSnapshotSection::COUNT)> m_sections;
+
+    std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
+    std::unique_ptr<CounterSnapshotWriter> m_writer;
+};
+
+#endif
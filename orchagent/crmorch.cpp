@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <sstream>
 #include <inttypes.h>
 
@@ -15,6 +16,7 @@
 #define CRM_THRESHOLD_HIGH_DEFAULT 85
 #define CRM_EXCEEDED_MSG_MAX 10
 #define CRM_ACL_RESOURCE_COUNT 256
+#define CRM_AVAILABLE_REFRESH_POLLS 4
 
 using namespace std;
 using namespace swss;
@@ -477,6 +479,8 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     for (auto i : data)
     {
         const auto &field = fvField(i);
@@ -543,9 +547,12 @@ void CrmOrch::incCrmResUsedCounter(CrmResourceType resource)
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter++;
+        auto &res = m_resourcesMap.at(resource);
+        updateUsedCounter(res, res.countersMap[CRM_COUNTERS_TABLE_KEY], true);
     }
     catch (...)
     {
@@ -558,9 +565,12 @@ void CrmOrch::decCrmResUsedCounter(CrmResourceType resource)
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter--;
+        auto &res = m_resourcesMap.at(resource);
+        updateUsedCounter(res, res.countersMap[CRM_COUNTERS_TABLE_KEY], false);
     }
     catch (...)
     {
@@ -573,9 +583,12 @@ void CrmOrch::incCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter++;
+        auto &res = m_resourcesMap.at(resource);
+        updateUsedCounter(res, res.countersMap[getCrmAclKey(stage, point)], true);
     }
     catch (...)
     {
@@ -588,9 +601,12 @@ void CrmOrch::decCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter--;
+        auto &res = m_resourcesMap.at(resource);
+        updateUsedCounter(res, res.countersMap[getCrmAclKey(stage, point)], false);
 
         // remove acl_entry and acl_counter in this acl table
         if (resource == CrmResourceType::CRM_ACL_TABLE)
@@ -627,10 +643,14 @@ void CrmOrch::incCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter++;
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].id = tableId;
+        auto &res = m_resourcesMap.at(resource);
+        auto &cnt = res.countersMap[getCrmAclTableKey(tableId)];
+        cnt.id = tableId;
+        updateUsedCounter(res, cnt, true);
     }
     catch (...)
     {
@@ -643,9 +663,12 @@ void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter--;
+        auto &res = m_resourcesMap.at(resource);
+        updateUsedCounter(res, res.countersMap[getCrmAclTableKey(tableId)], false);
     }
     catch (...)
     {
@@ -654,13 +677,16 @@ void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
     }
 }
 
-void CrmOrch::incCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name)
+void CrmOrch::incCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name, uint32_t count)
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmP4rtTableKey(table_name)].usedCounter++;
+        auto &res = m_resourcesMap.at(resource);
+        updateUsedCounter(res, res.countersMap[getCrmP4rtTableKey(table_name)], true, count);
     }
     catch (...)
     {
@@ -669,13 +695,16 @@ void CrmOrch::incCrmExtTableUsedCounter(CrmResourceType resource, std::string ta
     }
 }
 
-void CrmOrch::decCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name)
+void CrmOrch::decCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name, uint32_t count)
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmP4rtTableKey(table_name)].usedCounter--;
+        auto &res = m_resourcesMap.at(resource);
+        updateUsedCounter(res, res.countersMap[getCrmP4rtTableKey(table_name)], false, count);
     }
     catch (...)
     {
@@ -688,6 +717,8 @@ void CrmOrch::incCrmDashAclUsedCounter(CrmResourceType resource, sai_object_id_t
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     try
     {
         if (resource == CrmResourceType::CRM_DASH_IPV4_ACL_GROUP)
@@ -706,8 +737,8 @@ void CrmOrch::incCrmDashAclUsedCounter(CrmResourceType resource, sai_object_id_t
         }
         else 
         {
-            auto &rule_cnt = m_resourcesMap.at(resource).countersMap[getCrmDashAclGroupKey(tableId)];
-            ++rule_cnt.usedCounter;
+            auto &res = m_resourcesMap.at(resource);
+            updateUsedCounter(res, res.countersMap[getCrmDashAclGroupKey(tableId)], true);
         }
     }
     catch (...)
@@ -721,6 +752,8 @@ void CrmOrch::decCrmDashAclUsedCounter(CrmResourceType resource, sai_object_id_t
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     try
     {
         if (resource == CrmResourceType::CRM_DASH_IPV4_ACL_GROUP)
@@ -737,8 +770,8 @@ void CrmOrch::decCrmDashAclUsedCounter(CrmResourceType resource, sai_object_id_t
         }
         else 
         {
-            auto &rule_cnt = m_resourcesMap.at(resource).countersMap[getCrmDashAclGroupKey(tableId)];
-            --rule_cnt.usedCounter;
+            auto &res = m_resourcesMap.at(resource);
+            updateUsedCounter(res, res.countersMap[getCrmDashAclGroupKey(tableId)], false);
         }
     }
     catch (...)
@@ -752,11 +785,66 @@ void CrmOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::recursive_mutex> lock(m_resourcesMutex);
+
     getResAvailableCounters();
     updateCrmCountersTable();
     checkCrmThresholds();
 }
 
+void CrmOrch::updateUsedCounter(CrmResourceEntry &res, CrmResourceCounter &cnt, bool inc, uint32_t count)
+{
+    if (inc)
+    {
+        cnt.usedCounter += count;
+    }
+    else
+    {
+        cnt.usedCounter -= count;
+    }
+
+    cnt.usageChanged = true;
+
+    if (!cnt.availableKnown)
+    {
+        return;
+    }
+
+    // Follow the used counter until the next query, so that thresholds are
+    // crossed as soon as the usage changes instead of at the next poll
+    if (inc)
+    {
+        cnt.availableCounter -= std::min(cnt.availableCounter, count);
+    }
+    else
+    {
+        cnt.availableCounter += count;
+    }
+
+    if (res.resStatus == CrmResourceStatus::CRM_RES_SUPPORTED)
+    {
+        checkCrmThreshold(res, cnt, true);
+    }
+}
+
+bool CrmOrch::needAvailabilityQuery(CrmResourceCounter &cnt)
+{
+    if (!cnt.availableKnown || cnt.usageChanged)
+    {
+        return true;
+    }
+
+    return ++cnt.pollsSinceQuery >= CRM_AVAILABLE_REFRESH_POLLS;
+}
+
+void CrmOrch::setAvailableCounter(CrmResourceCounter &cnt, uint32_t available)
+{
+    cnt.availableCounter = available;
+    cnt.availableKnown = true;
+    cnt.usageChanged = false;
+    cnt.pollsSinceQuery = 0;
+}
+
 bool CrmOrch::getResAvailability(CrmResourceType type, CrmResourceEntry &res)
 {
     sai_attribute_t attr;
@@ -829,7 +917,7 @@ bool CrmOrch::getResAvailability(CrmResourceType type, CrmResourceEntry &res)
         availCount = attr.value.u32;
     }
 
-    res.countersMap[CRM_COUNTERS_TABLE_KEY].availableCounter = static_cast<uint32_t>(availCount);
+    setAvailableCounter(res.countersMap[CRM_COUNTERS_TABLE_KEY], static_cast<uint32_t>(availCount));
 
     return true;
 }
@@ -846,6 +934,11 @@ bool CrmOrch::getDashAclGroupResAvailability(CrmResourceType type, CrmResourceEn
 
     for (auto &cnt : res.countersMap)
     { 
+        if (!needAvailabilityQuery(cnt.second))
+        {
+            continue;
+        }
+
         sai_attribute_t attr;
         attr.id = SAI_DASH_ACL_RULE_ATTR_DASH_ACL_GROUP_ID;
         attr.value.oid = cnt.second.id;
@@ -869,7 +962,7 @@ bool CrmOrch::getDashAclGroupResAvailability(CrmResourceType type, CrmResourceEn
             break;
         }
 
-        cnt.second.availableCounter = static_cast<uint32_t>(availCount);
+        setAvailableCounter(cnt.second, static_cast<uint32_t>(availCount));
     }
 
     return true;
@@ -982,7 +1075,7 @@ void CrmOrch::getResAvailableCounters()
                 for (uint32_t i = 0; i < attr.value.aclresource.count; i++)
                 {
                     string key = getCrmAclKey(attr.value.aclresource.list[i].stage, attr.value.aclresource.list[i].bind_point);
-                    res.second.countersMap[key].availableCounter = attr.value.aclresource.list[i].avail_num;
+                    setAvailableCounter(res.second.countersMap[key], attr.value.aclresource.list[i].avail_num);
                 }
 
                 break;
@@ -996,6 +1089,11 @@ void CrmOrch::getResAvailableCounters()
 
                 for (auto &cnt : res.second.countersMap)
                 {
+                    if (!needAvailabilityQuery(cnt.second))
+                    {
+                        continue;
+                    }
+
                     sai_status_t status = sai_acl_api->get_acl_table_attribute(cnt.second.id, 1, &attr);
                     if ((status == SAI_STATUS_NOT_SUPPORTED) ||
                         (status == SAI_STATUS_NOT_IMPLEMENTED) ||
@@ -1013,7 +1111,7 @@ void CrmOrch::getResAvailableCounters()
                         break;
                     }
 
-                    cnt.second.availableCounter = attr.value.u32;
+                    setAvailableCounter(cnt.second, attr.value.u32);
                 }
 
                 break;
@@ -1023,6 +1121,11 @@ void CrmOrch::getResAvailableCounters()
             {
                 for (auto &cnt : res.second.countersMap)
                 {
+                    if (!needAvailabilityQuery(cnt.second))
+                    {
+                        continue;
+                    }
+
                     std::string table_name = cnt.first;
                     sai_object_type_t objType = crmResSaiObjAttrMap.at(res.first);
                     sai_attribute_t attr;
@@ -1041,7 +1144,7 @@ void CrmOrch::getResAvailableCounters()
                         break;
                     }
 
-                    cnt.second.availableCounter = static_cast<uint32_t>(availCount);
+                    setAvailableCounter(cnt.second, static_cast<uint32_t>(availCount));
                 }
                 break;
             }
@@ -1064,22 +1167,31 @@ void CrmOrch::updateCrmCountersTable()
 {
     SWSS_LOG_ENTER();
 
+    // Only the counters that changed since they were last written are
+    // updated, with one write per COUNTERS_DB key
+    map<string, vector<FieldValueTuple>> updates;
+
     // Update CRM used counters in COUNTERS_DB
     for (const auto &i : crmUsedCntsTableMap)
     {
         try
         {
-            const auto &res = m_resourcesMap.at(i.second);
+            auto &res = m_resourcesMap.at(i.second);
             if (res.resStatus == CrmResourceStatus::CRM_RES_NOT_SUPPORTED)
             {
                 continue;
             }
 
-            for (const auto &cnt : res.countersMap)
+            for (auto &cnt : res.countersMap)
             {
-                FieldValueTuple attr(i.first, to_string(cnt.second.usedCounter));
-                vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                if (cnt.second.usedPublished && (cnt.second.publishedUsed == cnt.second.usedCounter))
+                {
+                    continue;
+                }
+
+                updates[cnt.first].emplace_back(i.first, to_string(cnt.second.usedCounter));
+                cnt.second.usedPublished = true;
+                cnt.second.publishedUsed = cnt.second.usedCounter;
             }
         }
         catch(const out_of_range &e)
@@ -1093,17 +1205,22 @@ void CrmOrch::updateCrmCountersTable()
     {
         try
         {
-            const auto &res = m_resourcesMap.at(i.second);
+            auto &res = m_resourcesMap.at(i.second);
             if (res.resStatus == CrmResourceStatus::CRM_RES_NOT_SUPPORTED)
             {
                 continue;
             }
 
-            for (const auto &cnt : res.countersMap)
+            for (auto &cnt : res.countersMap)
             {
-                FieldValueTuple attr(i.first, to_string(cnt.second.availableCounter));
-                vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                if (cnt.second.availablePublished && (cnt.second.publishedAvailable == cnt.second.availableCounter))
+                {
+                    continue;
+                }
+
+                updates[cnt.first].emplace_back(i.first, to_string(cnt.second.availableCounter));
+                cnt.second.availablePublished = true;
+                cnt.second.publishedAvailable = cnt.second.availableCounter;
             }
         }
         catch(const out_of_range &e)
@@ -1111,6 +1228,11 @@ void CrmOrch::updateCrmCountersTable()
             // expected when a resource is unavailable
         }
     }
+
+    for (const auto &update : updates)
+    {
+        m_countersCrmTable->set(update.first, update.second);
+    }
 }
 
 void CrmOrch::checkCrmThresholds()
@@ -1128,65 +1250,76 @@ void CrmOrch::checkCrmThresholds()
 
         for (auto &j : i.second.countersMap)
         {
-            auto &cnt = j.second;
-            uint64_t utilization = 0;
-            uint32_t percentageUtil = 0;
-            string threshType = "";
+            checkCrmThreshold(res, j.second, false);
+        }
+    }
+}
 
-            if (cnt.usedCounter != 0)
-            {
-                uint32_t dvsr = cnt.usedCounter + cnt.availableCounter;
-                if (dvsr != 0)
-                {
-                    percentageUtil = (cnt.usedCounter * 100) / dvsr;
-                }
-                else
-                {
-                    SWSS_LOG_WARN("%s Exception occurred (div by Zero): Used count %u free count %u",
-                                  res.name.c_str(), cnt.usedCounter, cnt.availableCounter);
-                }
-            }
+/*
+ * On the poll, an exceeded threshold is reported up to CRM_EXCEEDED_MSG_MAX
+ * times. On a usage change, only crossing the thresholds is reported, the
+ * poll keeps reporting while the threshold stays exceeded.
+ */
+void CrmOrch::checkCrmThreshold(CrmResourceEntry &res, CrmResourceCounter &cnt, bool onUsageChange)
+{
+    uint64_t utilization = 0;
+    uint32_t percentageUtil = 0;
+    string threshType = "";
 
-            switch (res.thresholdType)
-            {
-                case CrmThresholdType::CRM_PERCENTAGE:
-                    utilization = percentageUtil;
-                    threshType = "TH_PERCENTAGE";
-                    break;
-                case CrmThresholdType::CRM_USED:
-                    utilization = cnt.usedCounter;
-                    threshType = "TH_USED";
-                    break;
-                case CrmThresholdType::CRM_FREE:
-                    utilization = cnt.availableCounter;
-                    threshType = "TH_FREE";
-                    break;
-                default:
-                    throw runtime_error("Unknown threshold type for CRM resource");
-            }
+    if (cnt.usedCounter != 0)
+    {
+        uint32_t dvsr = cnt.usedCounter + cnt.availableCounter;
+        if (dvsr != 0)
+        {
+            percentageUtil = (cnt.usedCounter * 100) / dvsr;
+        }
+        else
+        {
+            SWSS_LOG_WARN("%s Exception occurred (div by Zero): Used count %u free count %u",
+                          res.name.c_str(), cnt.usedCounter, cnt.availableCounter);
+        }
+    }
 
-            if ((utilization >= res.highThreshold) && (cnt.exceededLogCounter < CRM_EXCEEDED_MSG_MAX))
-            {
-                event_params_t params = {
-                    { "percent", to_string(percentageUtil) },
-                    { "used_cnt", to_string(cnt.usedCounter) },
-                    { "free_cnt", to_string(cnt.availableCounter) }};
+    switch (res.thresholdType)
+    {
+        case CrmThresholdType::CRM_PERCENTAGE:
+            utilization = percentageUtil;
+            threshType = "TH_PERCENTAGE";
+            break;
+        case CrmThresholdType::CRM_USED:
+            utilization = cnt.usedCounter;
+            threshType = "TH_USED";
+            break;
+        case CrmThresholdType::CRM_FREE:
+            utilization = cnt.availableCounter;
+            threshType = "TH_FREE";
+            break;
+        default:
+            throw runtime_error("Unknown threshold type for CRM resource");
+    }
 
-                SWSS_LOG_WARN("%s THRESHOLD_EXCEEDED for %s %u%% Used count %u free count %u",
-                              res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+    uint32_t exceededLogMax = onUsageChange ? 1 : CRM_EXCEEDED_MSG_MAX;
 
-                event_publish(g_events_handle, "chk_crm_threshold", &params);
-                cnt.exceededLogCounter++;
-            }
-            else if ((utilization <= res.lowThreshold) && (cnt.exceededLogCounter > 0) && (res.highThreshold != res.lowThreshold))
-            {
-                SWSS_LOG_WARN("%s THRESHOLD_CLEAR for %s %u%% Used count %u free count %u",
-                              res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+    if ((utilization >= res.highThreshold) && (cnt.exceededLogCounter < exceededLogMax))
+    {
+        event_params_t params = {
+            { "percent", to_string(percentageUtil) },
+            { "used_cnt", to_string(cnt.usedCounter) },
+            { "free_cnt", to_string(cnt.availableCounter) }};
 
-                cnt.exceededLogCounter = 0;
-            }
-        } // end of counters loop
-    } // end of resources loop
+        SWSS_LOG_WARN("%s THRESHOLD_EXCEEDED for %s %u%% Used count %u free count %u",
+                      res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+
+        event_publish(g_events_handle, "chk_crm_threshold", &params);
+        cnt.exceededLogCounter++;
+    }
+    else if ((utilization <= res.lowThreshold) && (cnt.exceededLogCounter > 0) && (res.highThreshold != res.lowThreshold))
+    {
+        SWSS_LOG_WARN("%s THRESHOLD_CLEAR for %s %u%% Used count %u free count %u",
+                      res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+
+        cnt.exceededLogCounter = 0;
+    }
 }
 
 
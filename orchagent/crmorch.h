@@ -3,6 +3,7 @@
 #include <thread>
 #include <chrono>
 #include <map>
+#include <mutex>
 #include "orch.h"
 #include "port.h"
 #include "events.h"
@@ -84,10 +85,10 @@ public:
     void incCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_t tableId);
     // Decrement "used" counter for the per ACL table CRM resources (ACL entry/counter)
     void decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_t tableId);
-    // Increment "used" counter for the EXT table CRM resources
-    void incCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name);
-    // Decrement "used" counter for the EXT table CRM resources
-    void decCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name);
+    // Increment "used" counter for the EXT table CRM resources by count
+    void incCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name, uint32_t count = 1);
+    // Decrement "used" counter for the EXT table CRM resources by count
+    void decCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name, uint32_t count = 1);
     // Increment "used" counter for the per DASH ACL CRM resources (ACL group/rule)
     void incCrmDashAclUsedCounter(CrmResourceType resource, sai_object_id_t groupId);
     // Decrement "used" counter for the per DASH ACL CRM resources (ACL group/rule)
@@ -104,6 +105,21 @@ private:
         uint32_t availableCounter = 0;
         uint32_t usedCounter = 0;
         uint32_t exceededLogCounter = 0;
+
+        // The available counter has been queried at least once, and since
+        // then follows the used counter until it is queried again
+        bool availableKnown = false;
+
+        // Per-table counters are queried again only when their usage
+        // changed, or after CRM_AVAILABLE_REFRESH_POLLS polls
+        bool usageChanged = false;
+        uint32_t pollsSinceQuery = 0;
+
+        // Values last written to COUNTERS_DB
+        bool usedPublished = false;
+        bool availablePublished = false;
+        uint32_t publishedUsed = 0;
+        uint32_t publishedAvailable = 0;
     };
 
     struct CrmResourceEntry
@@ -124,6 +140,8 @@ private:
     std::chrono::seconds m_pollingInterval;
 
     std::map<CrmResourceType, CrmResourceEntry> m_resourcesMap;
+    // Usage counters are updated by Orchs served on worker threads too
+    std::recursive_mutex m_resourcesMutex;
 
     void doTask(Consumer &consumer);
     void handleSetCommand(const std::string& key, const std::vector<swss::FieldValueTuple>& data);
@@ -131,8 +149,12 @@ private:
     bool getResAvailability(CrmResourceType type, CrmResourceEntry &res);
     bool getDashAclGroupResAvailability(CrmResourceType type, CrmResourceEntry &res);
     void getResAvailableCounters();
+    bool needAvailabilityQuery(CrmResourceCounter &cnt);
+    void setAvailableCounter(CrmResourceCounter &cnt, uint32_t available);
+    void updateUsedCounter(CrmResourceEntry &res, CrmResourceCounter &cnt, bool inc, uint32_t count = 1);
     void updateCrmCountersTable();
     void checkCrmThresholds();
+    void checkCrmThreshold(CrmResourceEntry &res, CrmResourceCounter &cnt, bool onUsageChange);
     std::string getCrmAclKey(sai_acl_stage_t stage, sai_acl_bind_point_type_t bindPoint);
     std::string getCrmAclTableKey(sai_object_id_t id);
     std::string getCrmP4rtTableKey(std::string table_name);
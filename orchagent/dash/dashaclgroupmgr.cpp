@@ -15,6 +15,7 @@ extern sai_dash_acl_api_t* sai_dash_acl_api;
 extern sai_dash_eni_api_t* sai_dash_eni_api;
 extern sai_object_id_t gSwitchId;
 extern CrmOrch *gCrmOrch;
+extern size_t gMaxBulkSize;
 
 using namespace std;
 using namespace swss;
@@ -128,21 +129,21 @@ sai_attr_id_t getSaiStage(DashAclDirection d, sai_ip_addr_family_t f, DashAclSta
 }
 
 DashAclRuleInfo::DashAclRuleInfo(const DashAclRule &rule) :
-    m_src_tags(rule.m_src_tags),
-    m_dst_tags(rule.m_dst_tags)
+    m_rule(rule)
 {
     SWSS_LOG_ENTER();
 }
 
 bool DashAclRuleInfo::isTagUsed(const std::string &tag_id) const
 {
-    return (m_src_tags.find(tag_id) != end(m_src_tags)) || (m_dst_tags.find(tag_id) != end(m_dst_tags));
+    return (m_rule.m_src_tags.find(tag_id) != end(m_rule.m_src_tags)) || (m_rule.m_dst_tags.find(tag_id) != end(m_rule.m_dst_tags));
 }
 
 DashAclGroupMgr::DashAclGroupMgr(DBConnector *db, DashOrch *dashorch, DashAclOrch *aclorch) :
     m_dash_orch(dashorch),
     m_dash_acl_orch(aclorch),
-    m_dash_acl_rules_table(new Table(db, APP_DASH_ACL_RULE_TABLE_NAME))
+    m_dash_acl_rules_table(new Table(db, APP_DASH_ACL_RULE_TABLE_NAME)),
+    m_rule_bulker(sai_dash_acl_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 }
@@ -203,6 +204,14 @@ void DashAclGroupMgr::remove(DashAclGroup& group)
         return;
     }
 
+    vector<string> rule_ids;
+    rule_ids.reserve(group.m_dash_acl_rule_table.size());
+    for (const auto& rule_it : group.m_dash_acl_rule_table)
+    {
+        rule_ids.push_back(rule_it.first);
+    }
+    removeRules(group, rule_ids);
+
     sai_status_t status = sai_dash_acl_api->remove_dash_acl_group(group.m_dash_acl_group_id);
     if (status != SAI_STATUS_SUCCESS)
     {
@@ -239,8 +248,8 @@ task_process_status DashAclGroupMgr::remove(const string& group_id)
 
     remove(group);
 
-    m_groups_table.erase(group_id);
     detachTags(group_id, group.m_tags);
+    m_groups_table.erase(group_it);
     SWSS_LOG_INFO("Removed ACL group %s", group_id.c_str());
 
     return task_success;
@@ -253,15 +262,14 @@ bool DashAclGroupMgr::exists(const string& group_id) const
     return m_groups_table.find(group_id) != m_groups_table.end();
 }
 
-DashAclRuleInfo DashAclGroupMgr::createRule(DashAclGroup& group, DashAclRule& rule)
+void DashAclGroupMgr::getRuleAttrs(const DashAclGroup& group, const DashAclRule& rule, RuleAttrs& rule_attrs)
 {
     SWSS_LOG_ENTER();
 
-    vector<sai_attribute_t> attrs;
-    vector<sai_ip_prefix_t> src_prefixes = {};
-    vector<sai_ip_prefix_t> dst_prefixes = {};
-
-    DashAclRuleInfo rule_info = rule;
+    auto& attrs = rule_attrs.m_attrs;
+    auto& protocols = rule_attrs.m_protocols;
+    auto& src_prefixes = rule_attrs.m_src_prefixes;
+    auto& dst_prefixes = rule_attrs.m_dst_prefixes;
 
     auto any_ip = [] (const auto& g)
     {
@@ -291,7 +299,6 @@ DashAclRuleInfo DashAclGroupMgr::createRule(DashAclGroup& group, DashAclRule& ru
     attrs.emplace_back();
     attrs.back().id = SAI_DASH_ACL_RULE_ATTR_PROTOCOL;
 
-    vector<uint8_t> protocols;
     if (rule.m_protocols.size()) {
         protocols = rule.m_protocols;
     } else {
@@ -301,34 +308,20 @@ DashAclRuleInfo DashAclGroupMgr::createRule(DashAclGroup& group, DashAclRule& ru
     attrs.back().value.u8list.count = static_cast<uint32_t>(protocols.size());
     attrs.back().value.u8list.list = protocols.data();
 
-    if (!rule.m_src_prefixes.empty())
-    {
-        src_prefixes.insert(src_prefixes.end(),
-                 rule.m_src_prefixes.begin(),  rule.m_src_prefixes.end());
-    }
-
-    if (!rule.m_dst_prefixes.empty())
-    {
-        dst_prefixes.insert(dst_prefixes.end(),
-                rule.m_dst_prefixes.begin(), rule.m_dst_prefixes.end());
-    }
-
+    // Prefixes shared by the tags of the rule and its own prefixes are sent once
+    DashPrefixSet src_set(rule.m_src_prefixes);
     for (const auto &tag : rule.m_src_tags)
     {
-        const auto& prefixes = m_dash_acl_orch->getDashAclTagMgr().getPrefixes(tag);
-        src_prefixes.insert(src_prefixes.end(),
-            prefixes.begin(), prefixes.end());
-        group.m_tags.insert(tag);
+        src_set.insert(m_dash_acl_orch->getDashAclTagMgr().getPrefixes(tag));
     }
+    src_set.appendPrefixes(src_prefixes);
 
+    DashPrefixSet dst_set(rule.m_dst_prefixes);
     for (const auto &tag : rule.m_dst_tags)
     {
-        const auto& prefixes = m_dash_acl_orch->getDashAclTagMgr().getPrefixes(tag);
-
-        dst_prefixes.insert(dst_prefixes.end(),
-            prefixes.begin(), prefixes.end());
-        group.m_tags.insert(tag);
+        dst_set.insert(m_dash_acl_orch->getDashAclTagMgr().getPrefixes(tag));
     }
+    dst_set.appendPrefixes(dst_prefixes);
 
     if (src_prefixes.empty())
     {
@@ -353,29 +346,207 @@ DashAclRuleInfo DashAclGroupMgr::createRule(DashAclGroup& group, DashAclRule& ru
     attrs.emplace_back();
     attrs.back().id = SAI_DASH_ACL_RULE_ATTR_SRC_PORT;
     attrs.back().value.u16rangelist.count = static_cast<uint32_t>(rule.m_src_ports.size());
-    attrs.back().value.u16rangelist.list = rule.m_src_ports.data();
+    attrs.back().value.u16rangelist.list = const_cast<sai_u16_range_t *>(rule.m_src_ports.data());
 
     attrs.emplace_back();
     attrs.back().id = SAI_DASH_ACL_RULE_ATTR_DST_PORT;
     attrs.back().value.u16rangelist.count = static_cast<uint32_t>(rule.m_dst_ports.size());
-    attrs.back().value.u16rangelist.list = rule.m_dst_ports.data();
+    attrs.back().value.u16rangelist.list = const_cast<sai_u16_range_t *>(rule.m_dst_ports.data());
 
     attrs.emplace_back();
     attrs.back().id = SAI_DASH_ACL_RULE_ATTR_DASH_ACL_GROUP_ID;
     attrs.back().value.oid = group.m_dash_acl_group_id;
+}
 
-    auto status = sai_dash_acl_api->create_dash_acl_rule(&rule_info.m_dash_acl_rule_id, gSwitchId, static_cast<uint32_t>(attrs.size()), attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
+task_process_status DashAclGroupMgr::createRules(DashAclGroup& group, const vector<string>& rule_ids)
+{
+    SWSS_LOG_ENTER();
+
+    // The attribute lists are only read on flush, they have to outlive the queued entries
+    vector<RuleAttrs> rule_attrs(rule_ids.size());
+    vector<sai_status_t> statuses(rule_ids.size());
+
+    for (size_t i = 0; i < rule_ids.size(); i++)
     {
-        SWSS_LOG_ERROR("Failed to create ACL rule: %d, %s", status, sai_serialize_status(status).c_str());
-        handleSaiCreateStatus((sai_api_t)SAI_API_DASH_ACL, status);
+        auto& rule_info = group.m_dash_acl_rule_table.at(rule_ids[i]);
+        getRuleAttrs(group, rule_info.m_rule, rule_attrs[i]);
+        m_rule_bulker.create_entry(&rule_info.m_dash_acl_rule_id, &statuses[i],
+                                   static_cast<uint32_t>(rule_attrs[i].m_attrs.size()), rule_attrs[i].m_attrs.data());
     }
 
+    m_rule_bulker.flush();
+
     CrmResourceType crm_rtype = (group.m_ip_version == SAI_IP_ADDR_FAMILY_IPV4) ?
             CrmResourceType::CRM_DASH_IPV4_ACL_RULE : CrmResourceType::CRM_DASH_IPV6_ACL_RULE;
-    gCrmOrch->incCrmDashAclUsedCounter(crm_rtype, group.m_dash_acl_group_id);
+    task_process_status task_status = task_success;
+
+    for (size_t i = 0; i < rule_ids.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create ACL rule %s: %d, %s", rule_ids[i].c_str(), statuses[i], sai_serialize_status(statuses[i]).c_str());
+            auto handle_status = handleSaiCreateStatus((sai_api_t)SAI_API_DASH_ACL, statuses[i]);
+            if (task_status == task_success)
+            {
+                task_status = (handle_status == task_success) ? task_failed : handle_status;
+            }
+            continue;
+        }
+
+        gCrmOrch->incCrmDashAclUsedCounter(crm_rtype, group.m_dash_acl_group_id);
+    }
+
+    return task_status;
+}
+
+void DashAclGroupMgr::removeRules(DashAclGroup& group, const vector<string>& rule_ids)
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_status_t> statuses(rule_ids.size(), SAI_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < rule_ids.size(); i++)
+    {
+        const auto& rule_info = group.m_dash_acl_rule_table.at(rule_ids[i]);
+        if (rule_info.m_dash_acl_rule_id != SAI_NULL_OBJECT_ID)
+        {
+            m_rule_bulker.remove_entry(&statuses[i], rule_info.m_dash_acl_rule_id);
+        }
+    }
+
+    m_rule_bulker.flush();
+
+    CrmResourceType crm_rtype = (group.m_ip_version == SAI_IP_ADDR_FAMILY_IPV4) ?
+            CrmResourceType::CRM_DASH_IPV4_ACL_RULE : CrmResourceType::CRM_DASH_IPV6_ACL_RULE;
+
+    for (size_t i = 0; i < rule_ids.size(); i++)
+    {
+        auto& rule_info = group.m_dash_acl_rule_table.at(rule_ids[i]);
+        if (rule_info.m_dash_acl_rule_id == SAI_NULL_OBJECT_ID)
+        {
+            continue;
+        }
+
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove ACL rule %s: %d, %s", rule_ids[i].c_str(), statuses[i], sai_serialize_status(statuses[i]).c_str());
+            handleSaiRemoveStatus((sai_api_t)SAI_API_DASH_ACL, statuses[i]);
+        }
+
+        gCrmOrch->decCrmDashAclUsedCounter(crm_rtype, group.m_dash_acl_group_id);
+        rule_info.m_dash_acl_rule_id = SAI_NULL_OBJECT_ID;
+    }
+}
+
+bool DashAclGroupMgr::isRuleChanged(const DashAclRuleInfo& rule_info, const string& tag_id, const DashPrefixSet& changed) const
+{
+    SWSS_LOG_ENTER();
+
+    const auto& rule = rule_info.m_rule;
+    const auto& tag_mgr = m_dash_acl_orch->getDashAclTagMgr();
+
+    // The ranges of the tag that changed may already be covered by the rest of the rule
+    auto is_changed = [&](const vector<sai_ip_prefix_t>& prefixes, const unordered_set<string>& tags)
+    {
+        if (tags.find(tag_id) == tags.end())
+        {
+            return false;
+        }
+
+        DashPrefixSet rest(prefixes);
+        for (const auto& tag : tags)
+        {
+            if (tag != tag_id)
+            {
+                rest.insert(tag_mgr.getPrefixes(tag));
+            }
+        }
+
+        return !changed.subtract(rest).empty();
+    };
+
+    return is_changed(rule.m_src_prefixes, rule.m_src_tags) || is_changed(rule.m_dst_prefixes, rule.m_dst_tags);
+}
+
+void DashAclGroupMgr::refreshGroup(DashAclGroup& group)
+{
+    SWSS_LOG_ENTER();
+
+    // A bound group can't have its rules re-created in place without the ENIs seeing a
+    // partial rule set, a new version of the group is built aside and swapped in
+    DashAclGroup new_group = group;
+    create(new_group);
+
+    vector<string> rule_ids;
+    rule_ids.reserve(new_group.m_dash_acl_rule_table.size());
+    for (const auto& rule_it : new_group.m_dash_acl_rule_table)
+    {
+        rule_ids.push_back(rule_it.first);
+    }
+    createRules(new_group, rule_ids);
+
+    for (auto direction : { DashAclDirection::IN, DashAclDirection::OUT })
+    {
+        const auto& table = (direction == DashAclDirection::IN) ? new_group.m_in_tables : new_group.m_out_tables;
+        for (const auto& eni_it : table)
+        {
+            auto eni = m_dash_orch->getEni(eni_it.first);
+            if (!eni)
+            {
+                SWSS_LOG_WARN("eni %s cannot be found", eni_it.first.c_str());
+                continue;
+            }
+
+            for (auto stage : eni_it.second)
+            {
+                bind(new_group, *eni, direction, stage);
+            }
+        }
+    }
+
+    remove(group);
+    group = std::move(new_group);
+}
+
+void DashAclGroupMgr::onUpdate(const string& group_id, const string& tag_id, const DashPrefixSet& changed)
+{
+    SWSS_LOG_ENTER();
+
+    auto group_it = m_groups_table.find(group_id);
+    if (group_it == m_groups_table.end())
+    {
+        return;
+    }
+
+    auto& group = group_it->second;
+
+    vector<string> rule_ids;
+    for (const auto& rule_it : group.m_dash_acl_rule_table)
+    {
+        if (rule_it.second.isTagUsed(tag_id) && isRuleChanged(rule_it.second, tag_id, changed))
+        {
+            rule_ids.push_back(rule_it.first);
+        }
+    }
+
+    if (rule_ids.empty())
+    {
+        SWSS_LOG_INFO("No rule of ACL group %s is changed by tag %s", group_id.c_str(), tag_id.c_str());
+        return;
+    }
 
-    return rule_info;
+    if (isBound(group))
+    {
+        refreshGroup(group);
+    }
+    else
+    {
+        // Rule attributes are create only, the changed rules are re-created with the new prefixes
+        removeRules(group, rule_ids);
+        createRules(group, rule_ids);
+    }
+
+    SWSS_LOG_INFO("Updated %zu rules of ACL group %s for tag %s", rule_ids.size(), group_id.c_str(), tag_id.c_str());
 }
 
 task_process_status DashAclGroupMgr::createRule(const string& group_id, const string& rule_id, DashAclRule& rule)
@@ -408,16 +579,60 @@ task_process_status DashAclGroupMgr::createRule(const string& group_id, const st
         }
     }
 
-    auto rule_info = createRule(group, rule);
+    // An existing rule is replaced on its own, the rest of the group is left in place
+    auto rule_it = group.m_dash_acl_rule_table.find(rule_id);
+    if (rule_it != group.m_dash_acl_rule_table.end())
+    {
+        removeRules(group, { rule_id });
+        rule_it->second = rule;
+    }
+    else
+    {
+        group.m_dash_acl_rule_table.emplace(rule_id, rule);
+    }
 
-    group.m_rule_count++;
-    attachTags(group_id, group.m_tags);
+    auto status = createRules(group, { rule_id });
+    if (status != task_success)
+    {
+        group.m_dash_acl_rule_table.erase(rule_id);
+        updateTags(group_id, group);
+        return status;
+    }
+
+    updateTags(group_id, group);
 
     SWSS_LOG_INFO("Created ACL rule %s:%s", group_id.c_str(), rule_id.c_str());
 
     return task_success;
 }
 
+task_process_status DashAclGroupMgr::removeRule(const string& group_id, const string& rule_id)
+{
+    SWSS_LOG_ENTER();
+
+    auto group_it = m_groups_table.find(group_id);
+    if (group_it == m_groups_table.end())
+    {
+        SWSS_LOG_INFO("ACL group %s doesn't exist", group_id.c_str());
+        return task_success;
+    }
+    auto& group = group_it->second;
+
+    if (group.m_dash_acl_rule_table.find(rule_id) == group.m_dash_acl_rule_table.end())
+    {
+        SWSS_LOG_INFO("ACL rule %s:%s doesn't exist", group_id.c_str(), rule_id.c_str());
+        return task_success;
+    }
+
+    removeRules(group, { rule_id });
+    group.m_dash_acl_rule_table.erase(rule_id);
+    updateTags(group_id, group);
+
+    SWSS_LOG_INFO("Removed ACL rule %s:%s", group_id.c_str(), rule_id.c_str());
+
+    return task_success;
+}
+
 void DashAclGroupMgr::bind(const DashAclGroup& group, const EniEntry& eni, DashAclDirection direction, DashAclStage stage)
 {
     SWSS_LOG_ENTER();
@@ -448,7 +663,7 @@ task_process_status DashAclGroupMgr::bind(const string& group_id, const string&
 
     auto& group = group_it->second;
 
-    if (group.m_rule_count == 0)
+    if (group.m_dash_acl_rule_table.empty())
     {
         SWSS_LOG_INFO("Failed to bind ACL group %s to ENI %s. ACL group has no rules attached.", group_id.c_str(), eni_id.c_str());
         return task_failed;
@@ -574,3 +789,28 @@ void DashAclGroupMgr::detachTags(const string &group_id, const unordered_set<str
         m_dash_acl_orch->getDashAclTagMgr().detach(tag_id, group_id);
     }
 }
+
+void DashAclGroupMgr::updateTags(const string &group_id, DashAclGroup& group)
+{
+    SWSS_LOG_ENTER();
+
+    unordered_set<string> tags;
+    for (const auto& rule_it : group.m_dash_acl_rule_table)
+    {
+        tags.insert(rule_it.second.m_rule.m_src_tags.begin(), rule_it.second.m_rule.m_src_tags.end());
+        tags.insert(rule_it.second.m_rule.m_dst_tags.begin(), rule_it.second.m_rule.m_dst_tags.end());
+    }
+
+    unordered_set<string> unused;
+    for (const auto& tag_id : group.m_tags)
+    {
+        if (tags.find(tag_id) == tags.end())
+        {
+            unused.insert(tag_id);
+        }
+    }
+
+    detachTags(group_id, unused);
+    attachTags(group_id, tags);
+    group.m_tags = std::move(tags);
+}
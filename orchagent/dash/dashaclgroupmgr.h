@@ -10,6 +10,7 @@
 #include "dashorch.h"
 #include "dashtagmgr.h"
 #include "table.h"
+#include "bulker.h"
 
 #include "dash_api/acl_group.pb.h"
 #include "dash_api/acl_rule.pb.h"
@@ -55,8 +56,8 @@ struct DashAclRuleInfo
 {
     sai_object_id_t m_dash_acl_rule_id = SAI_NULL_OBJECT_ID;
 
-    std::unordered_set<std::string> m_src_tags;
-    std::unordered_set<std::string> m_dst_tags;
+    // Kept to re-create the rule when the prefixes of one of its tags change
+    DashAclRule m_rule;
 
     DashAclRuleInfo() = default;
     DashAclRuleInfo(const DashAclRule &rule);
@@ -69,7 +70,7 @@ struct DashAclGroup
     using EniTable = std::unordered_map<std::string, std::unordered_set<DashAclStage>>;
     sai_object_id_t m_dash_acl_group_id = SAI_NULL_OBJECT_ID;
     std::unordered_set<std::string> m_tags;
-    int m_rule_count = 0;
+    std::unordered_map<std::string, DashAclRuleInfo> m_dash_acl_rule_table;
 
     sai_ip_addr_family_t m_ip_version;
     
@@ -98,6 +99,7 @@ class DashAclGroupMgr
     DashAclOrch *m_dash_acl_orch;
     std::unordered_map<std::string, DashAclGroup> m_groups_table;
     std::unique_ptr<swss::Table> m_dash_acl_rules_table;
+    ObjectBulker<sai_dash_acl_api_t> m_rule_bulker;
 
 public:
     DashAclGroupMgr(swss::DBConnector *db, DashOrch *dashorch, DashAclOrch *aclorch);
@@ -108,20 +110,37 @@ public:
     bool isBound(const std::string& group_id);
 
     task_process_status createRule(const std::string& group_id, const std::string& rule_id, DashAclRule& rule);
+    task_process_status removeRule(const std::string& group_id, const std::string& rule_id);
 
     task_process_status bind(const std::string& group_id, const std::string& eni_id, DashAclDirection direction, DashAclStage stage);
     task_process_status unbind(const std::string& group_id, const std::string& eni_id, DashAclDirection direction, DashAclStage stage);
 
+    void onUpdate(const std::string& group_id, const std::string& tag_id, const DashPrefixSet& changed);
+
 private:
+    // SAI attributes of a rule, with the lists they point to
+    struct RuleAttrs
+    {
+        std::vector<uint8_t> m_protocols;
+        std::vector<sai_ip_prefix_t> m_src_prefixes;
+        std::vector<sai_ip_prefix_t> m_dst_prefixes;
+        std::vector<sai_attribute_t> m_attrs;
+    };
+
     void init(DashAclGroup& group);
     void create(DashAclGroup& group);
     void remove(DashAclGroup& group);
 
-    DashAclRuleInfo createRule(DashAclGroup& group, DashAclRule& rule);
+    void getRuleAttrs(const DashAclGroup& group, const DashAclRule& rule, RuleAttrs& rule_attrs);
+    task_process_status createRules(DashAclGroup& group, const std::vector<std::string>& rule_ids);
+    void removeRules(DashAclGroup& group, const std::vector<std::string>& rule_ids);
+    bool isRuleChanged(const DashAclRuleInfo& rule_info, const std::string& tag_id, const DashPrefixSet& changed) const;
+    void refreshGroup(DashAclGroup& group);
 
     void bind(const DashAclGroup& group, const EniEntry& eni, DashAclDirection direction, DashAclStage stage);
     void unbind(const DashAclGroup& group, const EniEntry& eni, DashAclDirection direction, DashAclStage stage);
     bool isBound(const DashAclGroup& group);
     void attachTags(const std::string &group_id, const std::unordered_set<std::string>& tags);
     void detachTags(const std::string &group_id, const std::unordered_set<std::string>& tags);
+    void updateTags(const std::string &group_id, DashAclGroup& group);
 };
@@ -108,6 +108,7 @@ void DashAclOrch::doTask(ConsumerBase &consumer)
         PbWorker<AclGroup>::makeMemberTask(APP_DASH_ACL_GROUP_TABLE_NAME, SET_COMMAND, &DashAclOrch::taskUpdateDashAclGroup, this),
         KeyOnlyWorker::makeMemberTask(APP_DASH_ACL_GROUP_TABLE_NAME, DEL_COMMAND, &DashAclOrch::taskRemoveDashAclGroup, this),
         PbWorker<AclRule>::makeMemberTask(APP_DASH_ACL_RULE_TABLE_NAME, SET_COMMAND, &DashAclOrch::taskUpdateDashAclRule, this),
+        KeyOnlyWorker::makeMemberTask(APP_DASH_ACL_RULE_TABLE_NAME, DEL_COMMAND, &DashAclOrch::taskRemoveDashAclRule, this),
         PbWorker<PrefixTag>::makeMemberTask(APP_DASH_PREFIX_TAG_TABLE_NAME, SET_COMMAND, &DashAclOrch::taskUpdateDashPrefixTag, this),
         KeyOnlyWorker::makeMemberTask(APP_DASH_PREFIX_TAG_TABLE_NAME, DEL_COMMAND, &DashAclOrch::taskRemoveDashPrefixTag, this),
      };
@@ -280,6 +281,27 @@ task_process_status DashAclOrch::taskUpdateDashAclRule(
     return m_group_mgr.createRule(group_id, rule_id, rule);
 }
 
+task_process_status DashAclOrch::taskRemoveDashAclRule(
+    const string &key)
+{
+    SWSS_LOG_ENTER();
+
+    string group_id, rule_id;
+    if (!extractVariables(key, ':', group_id, rule_id))
+    {
+        SWSS_LOG_ERROR("Failed to parse key %s", key.c_str());
+        return task_failed;
+    }
+
+    if (m_group_mgr.isBound(group_id))
+    {
+        SWSS_LOG_INFO("Failed to remove dash ACL rule %s:%s, ACL group is bound to the ENI", group_id.c_str(), rule_id.c_str());
+        return task_failed;
+    }
+
+    return m_group_mgr.removeRule(group_id, rule_id);
+}
+
 task_process_status DashAclOrch::taskUpdateDashPrefixTag(
     const std::string &tag_id,
     const PrefixTag &data)
@@ -0,0 +1,32 @@
+#include "dashbatchorch.h"
+
+using namespace std;
+using namespace swss;
+
+DashBatchOrch::DashBatchOrch(const vector<Stage> &stages) :
+    Orch(),
+    m_stages(stages)
+{
+    SWSS_LOG_ENTER();
+
+    vector<Orch *> orchs;
+    for (const auto &stage : m_stages)
+    {
+        if (stage.first->getDrainOwner() != this)
+        {
+            stage.first->setDrainOwner(this);
+            orchs.push_back(stage.first);
+        }
+    }
+
+    // The DASH orchs are only drained from here, they run where this orch runs
+    declareDependencies(orchs);
+}
+
+void DashBatchOrch::doTask()
+{
+    for (const auto &stage : m_stages)
+    {
+        stage.first->drainExecutor(stage.second);
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "orch.h"
+
+/*
+ * Drains the DASH tables of all DASH orchs in one pass, in dependency order.
+ *
+ * Left to themselves the DASH orchs drain their own tables in table name
+ * order whenever they are selected. An ENI provisioned together with its
+ * VNET, mappings, routes and ACLs then sees its dependents drained first,
+ * failed and retried over later rounds, each retry flushed as a small bulk.
+ *
+ * The orchs of the tables become drain owned by this orch, see
+ * Orch::setDrainOwner(). Executing their consumers only pops the tables, and
+ * the doTask round drains every table once, appliance before VNET before ENI
+ * before mappings, routes and ACLs, so each object type is flushed as one
+ * bulk of all its pending entries.
+ */
+class DashBatchOrch : public Orch
+{
+public:
+    using Stage = std::pair<Orch *, std::string>;
+
+    // Tables are drained in the order of stages, an orch of a stage may appear more than once
+    DashBatchOrch(const std::vector<Stage> &stages);
+
+    void doTask() override;
+
+private:
+    std::vector<Stage> m_stages;
+};
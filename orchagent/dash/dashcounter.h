@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_set>
 
@@ -8,16 +9,25 @@
 #include "logger.h"
 #include "flex_counter_manager.h"
 
+/*
+ * Counters are registered through a cached manager, objects added between
+ * two flush() calls are installed in FLEX_COUNTER_DB with one bulk request
+ * per counter profile, callers flush once per batch of tasks.
+ */
 template<CounterType CT, typename TableT>
 struct DashCounter
 {
-    FlexCounterManager stat_manager;
+    FlexCounterTaggedCachedManager<void> stat_manager;
     bool fc_status = false;
     std::unordered_set<std::string> counter_stats;
+    std::shared_ptr<const CounterProfile> counter_profile;
 
-    DashCounter() {}
     DashCounter(const std::string& group_name, StatsMode stats_mode, uint32_t polling_interval, bool enabled)
-        : stat_manager(group_name, stats_mode, polling_interval, enabled), fc_status(enabled) {fetchStats();}
+        : stat_manager(group_name, stats_mode, polling_interval, enabled), fc_status(enabled)
+    {
+        fetchStats();
+        counter_profile = stat_manager.registerCounterProfile(group_name, CT, counter_stats);
+    }
     void fetchStats();
 
     void addToFC(sai_object_id_t oid, const std::string& name)
@@ -32,7 +42,7 @@ struct DashCounter
             SWSS_LOG_WARN("Cannot add counter on NULL OID for %s", name.c_str());
             return;
         }
-        stat_manager.setCounterIdList(oid, CT, counter_stats);
+        stat_manager.setCounterIdList(oid, counter_profile);
     }
 
     void removeFromFC(sai_object_id_t oid, const std::string& name)
@@ -45,6 +55,11 @@ struct DashCounter
         stat_manager.clearCounterIdList(oid);
     }
 
+    void flush()
+    {
+        stat_manager.flush();
+    }
+
     void refreshStats(bool install, const TableT& entries)
     {
         for (auto it = entries.begin(); it != entries.end(); it++)
@@ -58,6 +73,7 @@ struct DashCounter
                 removeFromFC(it->second.getOid(), it->first);
             }
         }
+        flush();
     }
 
     void handleStatusUpdate(bool enabled, const TableT& entries)
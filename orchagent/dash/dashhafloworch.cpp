@@ -52,13 +52,68 @@ task_process_status FlowDumpFilterManager::addFilter(const string &key, const ve
 {
     SWSS_LOG_ENTER();
 
-    if (m_filter_cache.find(key) != m_filter_cache.end())
+    vector<task_process_status> statuses;
+    addFilters({ KeyOpFieldsValuesTuple(key, SET_COMMAND, attrs) }, statuses);
+    return statuses[0];
+}
+
+void FlowDumpFilterManager::addFilters(const vector<KeyOpFieldsValuesTuple> &filters, vector<task_process_status> &statuses)
+{
+    SWSS_LOG_ENTER();
+
+    statuses.assign(filters.size(), task_success);
+
+    // The whole batch is validated and its SAI attributes built before any filter is created
+    vector<size_t> pending;
+    vector<FlowDumpFilterEntry> entries;
+    vector<vector<sai_attribute_t>> filter_attrs;
+
+    for (size_t i = 0; i < filters.size(); i++)
     {
-        SWSS_LOG_NOTICE("Flow dump filter %s already exists, skipping add", key.c_str());
-        return task_success;
+        const string &key = kfvKey(filters[i]);
+
+        if (m_filter_cache.find(key) != m_filter_cache.end())
+        {
+            SWSS_LOG_NOTICE("Flow dump filter %s already exists, skipping add", key.c_str());
+            continue;
+        }
+
+        FlowDumpFilterEntry entry;
+        vector<sai_attribute_t> attrs;
+        if (!parseFilter(key, kfvFieldsValues(filters[i]), entry) || !getFilterAttrs(entry, attrs))
+        {
+            statuses[i] = task_failed;
+            continue;
+        }
+
+        pending.push_back(i);
+        entries.push_back(entry);
+        filter_attrs.push_back(attrs);
+    }
+
+    for (size_t j = 0; j < pending.size(); j++)
+    {
+        const string &key = kfvKey(filters[pending[j]]);
+
+        sai_object_id_t filter_id = createFilterSAI(filter_attrs[j]);
+        if (filter_id == SAI_NULL_OBJECT_ID)
+        {
+            SWSS_LOG_ERROR("Failed to create flow dump filter %s", key.c_str());
+            statuses[pending[j]] = task_failed;
+            continue;
+        }
+
+        entries[j].filter_id = filter_id;
+        m_filter_cache[key] = entries[j];
+
+        SWSS_LOG_NOTICE("Created flow dump filter %s with filter_id 0x%" PRIx64, key.c_str(), static_cast<uint64_t>(filter_id));
     }
+}
+
+bool FlowDumpFilterManager::parseFilter(const string &key, const vector<FieldValueTuple> &attrs, FlowDumpFilterEntry &entry)
+{
+    SWSS_LOG_ENTER();
 
-    FlowDumpFilterEntry entry;
     entry.filter_id = SAI_NULL_OBJECT_ID;
 
     for (auto i = attrs.begin(); i != attrs.end(); i++)
@@ -83,22 +138,10 @@ task_process_status FlowDumpFilterManager::addFilter(const string &key, const ve
     if (entry.key.empty() || entry.op.empty() || entry.value.empty())
     {
         SWSS_LOG_ERROR("Missing required fields for flow dump filter %s", key.c_str());
-        return task_failed;
-    }
-
-    sai_object_id_t filter_id = createFilterSAI(entry);
-    if (filter_id == SAI_NULL_OBJECT_ID)
-    {
-        SWSS_LOG_ERROR("Failed to create flow dump filter %s", key.c_str());
-        return task_failed;
+        return false;
     }
 
-    entry.filter_id = filter_id;
-    m_filter_cache[key] = entry;
-
-    SWSS_LOG_NOTICE("Created flow dump filter %s with filter_id 0x%" PRIx64, key.c_str(), static_cast<uint64_t>(filter_id));
-
-    return task_success;
+    return true;
 }
 
 task_process_status FlowDumpFilterManager::removeFilter(const string &key)
@@ -142,87 +185,93 @@ vector<sai_object_id_t> FlowDumpFilterManager::getFilterIds(const vector<string>
     return filter_ids;
 }
 
-sai_object_id_t FlowDumpFilterManager::createFilterSAI(const FlowDumpFilterEntry &filter)
+bool FlowDumpFilterManager::getFilterAttrs(const FlowDumpFilterEntry &filter, vector<sai_attribute_t> &attrs)
 {
     SWSS_LOG_ENTER();
 
     try
     {
-        sai_attribute_t attrs[3];
-        uint32_t attr_count = 0;
+        sai_attribute_t attr;
 
         auto filter_key_it = filter_key_map.find(filter.key);
         if (filter_key_it == filter_key_map.end())
         {
             SWSS_LOG_ERROR("Invalid filter key: %s", filter.key.c_str());
-            return SAI_NULL_OBJECT_ID;
+            return false;
         }
         sai_dash_flow_entry_bulk_get_session_filter_key_t filter_key = filter_key_it->second;
 
-        attrs[attr_count].id = SAI_FLOW_ENTRY_BULK_GET_SESSION_FILTER_ATTR_DASH_FLOW_ENTRY_BULK_GET_SESSION_FILTER_KEY;
-        attrs[attr_count].value.s32 = filter_key;
-        attr_count++;
+        attr.id = SAI_FLOW_ENTRY_BULK_GET_SESSION_FILTER_ATTR_DASH_FLOW_ENTRY_BULK_GET_SESSION_FILTER_KEY;
+        attr.value.s32 = filter_key;
+        attrs.push_back(attr);
 
         auto filter_op_it = filter_op_map.find(filter.op);
         if (filter_op_it == filter_op_map.end())
         {
             SWSS_LOG_ERROR("Invalid filter op: %s", filter.op.c_str());
-            return SAI_NULL_OBJECT_ID;
+            return false;
         }
         sai_dash_flow_entry_bulk_get_session_op_key_t filter_op = filter_op_it->second;
 
-        attrs[attr_count].id = SAI_FLOW_ENTRY_BULK_GET_SESSION_FILTER_ATTR_DASH_FLOW_ENTRY_BULK_GET_SESSION_OP_KEY;
-        attrs[attr_count].value.s32 = filter_op;
-        attr_count++;
+        attr.id = SAI_FLOW_ENTRY_BULK_GET_SESSION_FILTER_ATTR_DASH_FLOW_ENTRY_BULK_GET_SESSION_OP_KEY;
+        attr.value.s32 = filter_op;
+        attrs.push_back(attr);
 
         if (filter_key == SAI_DASH_FLOW_ENTRY_BULK_GET_SESSION_FILTER_KEY_ENI_ADDR)
         {
             MacAddress mac(filter.value);
-            attrs[attr_count].id = SAI_FLOW_ENTRY_BULK_GET_SESSION_FILTER_ATTR_MAC_VALUE;
-            memcpy(attrs[attr_count].value.mac, mac.getMac(), 6);
-            attr_count++;
+            attr.id = SAI_FLOW_ENTRY_BULK_GET_SESSION_FILTER_ATTR_MAC_VALUE;
+            memcpy(attr.value.mac, mac.getMac(), 6);
+            attrs.push_back(attr);
         }
         else if (filter_key == SAI_DASH_FLOW_ENTRY_BULK_GET_SESSION_FILTER_KEY_IP_PROTOCOL ||
                  filter_key == SAI_DASH_FLOW_ENTRY_BULK_GET_SESSION_FILTER_KEY_SRC_L4_PORT ||
                  filter_key == SAI_DASH_FLOW_ENTRY_BULK_GET_SESSION_FILTER_KEY_DST_L4_PORT ||
                  filter_key == SAI_DASH_FLOW_ENTRY_BULK_GET_SESSION_FILTER_KEY_KEY_VERSION)
         {
-            attrs[attr_count].id = SAI_FLOW_ENTRY_BULK_GET_SESSION_FILTER_ATTR_INT_VALUE;
-            attrs[attr_count].value.u32 = static_cast<uint32_t>(stoul(filter.value));
-            attr_count++;
+            attr.id = SAI_FLOW_ENTRY_BULK_GET_SESSION_FILTER_ATTR_INT_VALUE;
+            attr.value.u32 = static_cast<uint32_t>(stoul(filter.value));
+            attrs.push_back(attr);
         }
         else if (filter_key == SAI_DASH_FLOW_ENTRY_BULK_GET_SESSION_FILTER_KEY_SRC_IP_ADDR ||
                  filter_key == SAI_DASH_FLOW_ENTRY_BULK_GET_SESSION_FILTER_KEY_DST_IP_ADDR)
         {
             IpAddress ip(filter.value);
-            attrs[attr_count].id = SAI_FLOW_ENTRY_BULK_GET_SESSION_FILTER_ATTR_IP_VALUE;
-            swss::copy(attrs[attr_count].value.ipaddr, ip);
-            attr_count++;
-        }
-
-        sai_object_id_t filter_id = SAI_NULL_OBJECT_ID;
-        sai_status_t status = sai_dash_flow_api->create_flow_entry_bulk_get_session_filter(&filter_id, gSwitchId, attr_count, attrs);
-
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to create flow bulk get session filter, status: %d", status);
-            return SAI_NULL_OBJECT_ID;
+            attr.id = SAI_FLOW_ENTRY_BULK_GET_SESSION_FILTER_ATTR_IP_VALUE;
+            swss::copy(attr.value.ipaddr, ip);
+            attrs.push_back(attr);
         }
 
-        return filter_id;
+        return true;
     }
     catch (const exception &e)
     {
-        SWSS_LOG_ERROR("Exception in FlowDumpFilterManager::createFilterSAI for filter key %s, op %s, value %s: %s", 
+        SWSS_LOG_ERROR("Exception in FlowDumpFilterManager::getFilterAttrs for filter key %s, op %s, value %s: %s", 
                        filter.key.c_str(), filter.op.c_str(), filter.value.c_str(), e.what());
-        return SAI_NULL_OBJECT_ID;
+        return false;
     }
     catch (...)
     {
-        SWSS_LOG_ERROR("Unknown exception in FlowDumpFilterManager::createFilterSAI for filter key %s, op %s, value %s", 
+        SWSS_LOG_ERROR("Unknown exception in FlowDumpFilterManager::getFilterAttrs for filter key %s, op %s, value %s", 
                        filter.key.c_str(), filter.op.c_str(), filter.value.c_str());
+        return false;
+    }
+}
+
+sai_object_id_t FlowDumpFilterManager::createFilterSAI(vector<sai_attribute_t> &attrs)
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_id_t filter_id = SAI_NULL_OBJECT_ID;
+    sai_status_t status = sai_dash_flow_api->create_flow_entry_bulk_get_session_filter(&filter_id, gSwitchId, static_cast<uint32_t>(attrs.size()), attrs.data());
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create flow bulk get session filter, status: %d", status);
         return SAI_NULL_OBJECT_ID;
     }
+
+    return filter_id;
 }
 
 bool FlowDumpFilterManager::deleteFilterSAI(sai_object_id_t filter_id)
@@ -242,11 +291,64 @@ bool FlowDumpFilterManager::deleteFilterSAI(sai_object_id_t filter_id)
 
 FlowApiHandler::FlowApiHandler(DBConnector *dpu_state_db, SelectableTimer *timer) :
     m_session_id(SAI_NULL_OBJECT_ID),
-    m_timer(timer)
+    m_timer(timer),
+    m_progress_interval(DEFAULT_PROGRESS_INTERVAL),
+    m_flow_count(0),
+    m_reported_flow_count(0)
 {
     m_state_table = make_shared<Table>(dpu_state_db, STATE_DASH_FLOW_SYNC_SESSION_STATE_TABLE_NAME);
 }
 
+void FlowApiHandler::handleFlows(uint32_t count)
+{
+    SWSS_LOG_ENTER();
+
+    if (count == 0 || !isActive())
+    {
+        return;
+    }
+
+    if (m_flow_count == 0)
+    {
+        m_first_flow_time = chrono::steady_clock::now();
+    }
+    m_flow_count += count;
+
+    // Progress goes to STATE_DB in chunks, not once per event
+    if (m_flow_count - m_reported_flow_count < m_progress_interval)
+    {
+        return;
+    }
+    m_reported_flow_count = m_flow_count;
+
+    vector<FieldValueTuple> fvs;
+    appendCounters(fvs);
+    updateState("in_progress", m_key, fvs);
+    onProgress();
+}
+
+void FlowApiHandler::resetCounters()
+{
+    m_flow_count = 0;
+    m_reported_flow_count = 0;
+    m_first_flow_time = {};
+}
+
+void FlowApiHandler::appendCounters(vector<FieldValueTuple> &fvs) const
+{
+    auto now = chrono::steady_clock::now();
+    auto duration_ms = chrono::duration_cast<chrono::milliseconds>(now - m_creation_time).count();
+
+    fvs.push_back(FieldValueTuple("flows", to_string(m_flow_count)));
+    fvs.push_back(FieldValueTuple("duration_in_ms", to_string(duration_ms)));
+    fvs.push_back(FieldValueTuple("flows_per_sec", to_string(duration_ms > 0 ? m_flow_count * 1000 / static_cast<uint64_t>(duration_ms) : m_flow_count)));
+    if (m_flow_count > 0)
+    {
+        auto latency_ms = chrono::duration_cast<chrono::milliseconds>(m_first_flow_time - m_creation_time).count();
+        fvs.push_back(FieldValueTuple("first_flow_latency_in_ms", to_string(latency_ms)));
+    }
+}
+
 void FlowApiHandler::deleteSession()
 {
     SWSS_LOG_ENTER();
@@ -308,7 +410,9 @@ void FlowApiHandler::updateState(const string &state, const string &key, vector<
 }
 
 BulkSyncHandler::BulkSyncHandler(DBConnector *dpu_state_db, SelectableTimer *timer) :
-    FlowApiHandler(dpu_state_db, timer)
+    FlowApiHandler(dpu_state_db, timer),
+    m_streaming(false),
+    m_max_inflight(DEFAULT_MAX_INFLIGHT)
 {
 }
 
@@ -329,6 +433,9 @@ bool BulkSyncHandler::initialize(const string &key, const vector<FieldValueTuple
         m_target_server_ip = "";
         m_target_server_port = 0;
         m_timeout_sec = DEFAULT_TIMEOUT_SEC;
+        m_streaming = false;
+        m_max_inflight = DEFAULT_MAX_INFLIGHT;
+        m_progress_interval = DEFAULT_PROGRESS_INTERVAL;
 
         for (auto i = attrs.begin(); i != attrs.end(); i++)
         {
@@ -347,6 +454,24 @@ bool BulkSyncHandler::initialize(const string &key, const vector<FieldValueTuple
             {
                 m_timeout_sec = static_cast<uint32_t>(stoul(value));
             }
+            else if (attr == "mode")
+            {
+                m_streaming = (value == "streaming");
+            }
+            else if (attr == "max_inflight")
+            {
+                m_max_inflight = static_cast<uint32_t>(stoul(value));
+            }
+            else if (attr == "progress_interval")
+            {
+                m_progress_interval = static_cast<uint32_t>(stoul(value));
+            }
+        }
+
+        if (m_max_inflight == 0 || m_progress_interval == 0)
+        {
+            SWSS_LOG_ERROR("Invalid max_inflight %u or progress_interval %u for flow sync session %s", m_max_inflight, m_progress_interval, key.c_str());
+            return false;
         }
         return true;
     }
@@ -370,6 +495,9 @@ void BulkSyncHandler::reset()
     m_target_server_ip = "";
     m_target_server_port = 0;
     m_timeout_sec = BulkSyncHandler::DEFAULT_TIMEOUT_SEC;
+    m_streaming = false;
+    m_max_inflight = DEFAULT_MAX_INFLIGHT;
+    m_progress_interval = DEFAULT_PROGRESS_INTERVAL;
 }
 
 task_process_status BulkSyncHandler::handleSet(const string &table_name, const string &key, const vector<FieldValueTuple> &attrs)
@@ -449,22 +577,39 @@ task_process_status BulkSyncHandler::createSession()
     m_session_id = session_id;
     m_creation_time = chrono::steady_clock::now();
     m_last_state_time = m_creation_time;
+    resetCounters();
 
-    auto interval = timespec { .tv_sec = static_cast<time_t>(m_timeout_sec), .tv_nsec = 0 };
-    m_timer->setInterval(interval);
-    m_timer->start();
+    startTimer();
 
     FlowApiHandler::updateState("created", m_key, {{"type", DashHaFlowOrch::SESSION_TYPE_BULK_SYNC}});
-    SWSS_LOG_NOTICE("Created flow sync session %s with session_id 0x%" PRIx64 ", timeout %u sec", m_key.c_str(), static_cast<uint64_t>(session_id), m_timeout_sec);
+    SWSS_LOG_NOTICE("Created flow sync session %s with session_id 0x%" PRIx64 ", timeout %u sec%s", m_key.c_str(), static_cast<uint64_t>(session_id), m_timeout_sec, m_streaming ? " (streaming)" : "");
 
     return task_success;
 }
 
+void BulkSyncHandler::startTimer()
+{
+    auto interval = timespec { .tv_sec = static_cast<time_t>(m_timeout_sec), .tv_nsec = 0 };
+    m_timer->setInterval(interval);
+    m_timer->reset();
+}
+
+void BulkSyncHandler::onProgress()
+{
+    // A streaming sync only times out once flows stop arriving
+    if (m_streaming)
+    {
+        startTimer();
+    }
+}
+
 void BulkSyncHandler::handleFinished()
 {
     SWSS_LOG_ENTER();
-    FlowApiHandler::updateState("completed", m_key, {{"type", DashHaFlowOrch::SESSION_TYPE_BULK_SYNC}});
-    SWSS_LOG_NOTICE("Flow sync session %s completed successfully", m_key.c_str());
+    vector<FieldValueTuple> fvs = {{"type", DashHaFlowOrch::SESSION_TYPE_BULK_SYNC}};
+    appendCounters(fvs);
+    FlowApiHandler::updateState("completed", m_key, fvs);
+    SWSS_LOG_NOTICE("Flow sync session %s completed successfully, %" PRIu64 " flows", m_key.c_str(), m_flow_count);
     deleteSession();
     reset();
 }
@@ -472,8 +617,10 @@ void BulkSyncHandler::handleFinished()
 void BulkSyncHandler::handleTimeout()
 {
     SWSS_LOG_ENTER();
-    FlowApiHandler::updateState("failed", m_key, {{"type", DashHaFlowOrch::SESSION_TYPE_BULK_SYNC}});
-    SWSS_LOG_WARN("Flow sync session %s timed out", m_key.c_str());
+    vector<FieldValueTuple> fvs = {{"type", DashHaFlowOrch::SESSION_TYPE_BULK_SYNC}};
+    appendCounters(fvs);
+    FlowApiHandler::updateState("failed", m_key, fvs);
+    SWSS_LOG_WARN("Flow sync session %s timed out after %" PRIu64 " flows", m_key.c_str(), m_flow_count);
     deleteSession();
     reset();
 }
@@ -606,6 +753,9 @@ task_process_status FlowDumpHandler::createSession()
     }
 
     m_session_id = session_id;
+    m_creation_time = chrono::steady_clock::now();
+    m_last_state_time = m_creation_time;
+    resetCounters();
 
     auto interval = timespec { .tv_sec = static_cast<time_t>(m_timeout_sec), .tv_nsec = 0 };
     m_timer->setInterval(interval);
@@ -684,6 +834,7 @@ void FlowDumpHandler::handleFinished()
     vector<FieldValueTuple> fvs;
     fvs.push_back(FieldValueTuple("type", DashHaFlowOrch::SESSION_TYPE_FLOW_DUMP));
     fvs.push_back(FieldValueTuple("output_file", m_output_file));
+    appendCounters(fvs);
     FlowApiHandler::updateState("completed", m_key, fvs);
     SWSS_LOG_NOTICE("Flow dump session %s completed successfully, output file: %s", m_key.c_str(), m_output_file.c_str());
 
@@ -695,7 +846,9 @@ void FlowDumpHandler::handleTimeout()
 {
     SWSS_LOG_ENTER();
 
-    FlowApiHandler::updateState("failed", m_key, {{"type", DashHaFlowOrch::SESSION_TYPE_FLOW_DUMP}});
+    vector<FieldValueTuple> fvs = {{"type", DashHaFlowOrch::SESSION_TYPE_FLOW_DUMP}};
+    appendCounters(fvs);
+    FlowApiHandler::updateState("failed", m_key, fvs);
     deleteSession();
     reset();
 
@@ -848,20 +1001,46 @@ void DashHaFlowOrch::doTask(NotificationConsumer &consumer)
 {
     SWSS_LOG_ENTER();
 
-    std::string notification_name;
-    std::string data;
-    std::vector<FieldValueTuple> values;
-
-    consumer.pop(notification_name, data, values);
+    /*
+     * Session events are drained until max_inflight flow entries are handled,
+     * what is left stays queued for the next round so a bulk sync doesn't
+     * hold the event loop for the whole flow table.
+     */
+    uint32_t max_inflight = getMaxInflight();
+    uint32_t flows = 0;
 
-    if (notification_name == SAI_SWITCH_NOTIFICATION_NAME_FLOW_BULK_GET_SESSION_EVENT)
+    do
     {
-        handleSessionNotification(notification_name, data, values);
-    }
-    else
+        std::string notification_name;
+        std::string data;
+        std::vector<FieldValueTuple> values;
+
+        consumer.pop(notification_name, data, values);
+
+        if (notification_name == SAI_SWITCH_NOTIFICATION_NAME_FLOW_BULK_GET_SESSION_EVENT)
+        {
+            flows += handleSessionNotification(notification_name, data, values);
+        }
+        else
+        {
+            SWSS_LOG_WARN("Unknown notification: %s", notification_name.c_str());
+        }
+    } while (flows < max_inflight && consumer.hasData());
+}
+
+uint32_t DashHaFlowOrch::getMaxInflight() const
+{
+    uint32_t max_inflight = 0;
+    for (const auto &h_pair : m_handlers)
     {
-        SWSS_LOG_WARN("Unknown notification: %s", notification_name.c_str());
+        if (h_pair.second->isActive())
+        {
+            max_inflight = std::max(max_inflight, h_pair.second->getMaxInflight());
+        }
     }
+
+    // With no session running, events are handled one notification at a time
+    return max_inflight ? max_inflight : 1;
 }
 
 void DashHaFlowOrch::doTask(SelectableTimer &timer)
@@ -936,6 +1115,29 @@ void DashHaFlowOrch::doTaskFlowDumpFilterTable(ConsumerBase &consumer)
 {
     SWSS_LOG_ENTER();
 
+    vector<decltype(consumer.m_toSync.begin())> batch;
+    vector<KeyOpFieldsValuesTuple> filters;
+    vector<task_process_status> statuses;
+
+    // SETs are added as one batch, flushed before a DEL so a key removed and re-added keeps its order
+    auto flush = [&]() {
+        if (batch.empty())
+        {
+            return;
+        }
+
+        m_filter_manager->addFilters(filters, statuses);
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            if (statuses[i] != task_need_retry)
+            {
+                consumer.m_toSync.erase(batch[i]);
+            }
+        }
+        batch.clear();
+        filters.clear();
+    };
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -946,10 +1148,14 @@ void DashHaFlowOrch::doTaskFlowDumpFilterTable(ConsumerBase &consumer)
 
         if (op == SET_COMMAND)
         {
-            status = m_filter_manager->addFilter(key, kfvFieldsValues(t));
+            batch.push_back(it);
+            filters.push_back(t);
+            it++;
+            continue;
         }
         else if (op == DEL_COMMAND)
         {
+            flush();
             status = m_filter_manager->removeFilter(key);
         }
         else
@@ -966,6 +1172,8 @@ void DashHaFlowOrch::doTaskFlowDumpFilterTable(ConsumerBase &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flush();
 }
 
 string DashHaFlowOrch::getTypeFromAttrs(const vector<FieldValueTuple> &attrs)
@@ -983,7 +1191,7 @@ string DashHaFlowOrch::getTypeFromAttrs(const vector<FieldValueTuple> &attrs)
     return "";
 }
 
-void DashHaFlowOrch::handleSessionNotification(const string &notification_name, const string &data, const vector<FieldValueTuple> &values)
+uint32_t DashHaFlowOrch::handleSessionNotification(const string &notification_name, const string &data, const vector<FieldValueTuple> &values)
 {
     SWSS_LOG_ENTER();
 
@@ -993,15 +1201,41 @@ void DashHaFlowOrch::handleSessionNotification(const string &notification_name,
 
     sai_deserialize_flow_bulk_get_session_event_ntf(data, flow_bulk_session_id, count, &event_data);
 
+    // Flow entries ahead of FINISHED are counted against the session before it completes
+    uint32_t flows = 0;
+    uint32_t pending = 0;
     for (uint32_t i = 0; i < count; i++)
     {
         if (event_data[i].event_type == SAI_FLOW_BULK_GET_SESSION_EVENT_FINISHED)
         {
+            handleSessionFlows(flow_bulk_session_id, pending);
+            pending = 0;
             handleSessionFinished(flow_bulk_session_id);
         }
+        else
+        {
+            pending++;
+            flows++;
+        }
     }
+    handleSessionFlows(flow_bulk_session_id, pending);
 
     sai_deserialize_free_flow_bulk_get_session_event_ntf(count, event_data);
+    return flows;
+}
+
+void DashHaFlowOrch::handleSessionFlows(sai_object_id_t session_id, uint32_t count)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &h_pair : m_handlers)
+    {
+        if (h_pair.second->getSessionId() == session_id)
+        {
+            h_pair.second->handleFlows(count);
+            return;
+        }
+    }
 }
 
 void DashHaFlowOrch::handleSessionFinished(sai_object_id_t session_id)
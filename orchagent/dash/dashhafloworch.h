@@ -42,10 +42,14 @@ public:
 
 protected:
     task_process_status addFilter(const std::string &key, const std::vector<swss::FieldValueTuple> &attrs);
+    // Adds a batch of filters, statuses gets one result per entry in filters
+    void addFilters(const std::vector<swss::KeyOpFieldsValuesTuple> &filters, std::vector<task_process_status> &statuses);
     task_process_status removeFilter(const std::string &key);
 
 private:
-    sai_object_id_t createFilterSAI(const FlowDumpFilterEntry &filter);
+    bool parseFilter(const std::string &key, const std::vector<swss::FieldValueTuple> &attrs, FlowDumpFilterEntry &entry);
+    bool getFilterAttrs(const FlowDumpFilterEntry &filter, std::vector<sai_attribute_t> &attrs);
+    sai_object_id_t createFilterSAI(std::vector<sai_attribute_t> &attrs);
     bool deleteFilterSAI(sai_object_id_t filter_id);
 
     std::map<std::string, FlowDumpFilterEntry> m_filter_cache;
@@ -63,6 +67,10 @@ public:
 
     virtual void handleFinished() = 0;
     virtual void handleTimeout() = 0;
+    // Called with the number of flow entries a session event delivered
+    virtual void handleFlows(uint32_t count);
+    // Flow entries to handle for this session per event loop round
+    virtual uint32_t getMaxInflight() const { return DEFAULT_MAX_INFLIGHT; }
     virtual sai_object_id_t getSessionId() const { return m_session_id; }
     virtual std::string getKey() const { return m_key; }
     virtual bool isActive() const { return m_session_id != SAI_NULL_OBJECT_ID; }
@@ -76,6 +84,9 @@ protected:
     void deleteSession();
     bool deleteSessionSAI();
     void updateState(const std::string &state, const std::string &key, std::vector<swss::FieldValueTuple> fvs);
+    virtual void onProgress() {}
+    void resetCounters();
+    void appendCounters(std::vector<swss::FieldValueTuple> &fvs) const;
 
     std::string m_key;
     sai_object_id_t m_session_id;
@@ -83,6 +94,15 @@ protected:
     std::chrono::steady_clock::time_point m_creation_time;
     std::chrono::steady_clock::time_point m_last_state_time;
     std::shared_ptr<swss::Table> m_state_table;
+
+    // Progress is written to STATE_DB once per m_progress_interval flows
+    uint32_t m_progress_interval;
+    uint64_t m_flow_count;
+    uint64_t m_reported_flow_count;
+    std::chrono::steady_clock::time_point m_first_flow_time;
+
+    static constexpr uint32_t DEFAULT_PROGRESS_INTERVAL = 1000;
+    static constexpr uint32_t DEFAULT_MAX_INFLIGHT = 4096;
 };
 
 class BulkSyncHandler : public FlowApiHandler
@@ -96,17 +116,24 @@ public:
     task_process_status handleDel(const std::string &table_name, const std::string &key) override;
     void handleFinished() override;
     void handleTimeout() override;
+    uint32_t getMaxInflight() const override { return m_max_inflight; }
 
 protected:
     task_process_status createSession() override;
     sai_object_id_t createSessionSAI() override;
     void reset() override;
+    void onProgress() override;
 
 private:
+    void startTimer();
+
     sai_object_id_t m_ha_set_id;
     std::string m_target_server_ip;
     uint16_t m_target_server_port;
     uint32_t m_timeout_sec;
+    // In streaming mode the timeout is an idle timeout, restarted on progress
+    bool m_streaming;
+    uint32_t m_max_inflight;
 
     static constexpr uint32_t DEFAULT_TIMEOUT_SEC = 120;
 };
@@ -169,8 +196,11 @@ protected:
     
     std::string getTypeFromAttrs(const std::vector<swss::FieldValueTuple> &attrs);
 
-    void handleSessionNotification(const std::string &notification_name, const std::string &data, const std::vector<swss::FieldValueTuple> &values);
+    // Returns the number of flow entries in the notification
+    uint32_t handleSessionNotification(const std::string &notification_name, const std::string &data, const std::vector<swss::FieldValueTuple> &values);
     void handleSessionFinished(sai_object_id_t session_id);
+    void handleSessionFlows(sai_object_id_t session_id, uint32_t count);
+    uint32_t getMaxInflight() const;
     void handleTimerExpired(swss::SelectableTimer *timer);
 
     bool registerFlowBulkGetSessionNotifier();
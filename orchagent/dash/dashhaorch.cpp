@@ -466,6 +466,8 @@ void DashHaOrch::doTaskHaSetTable(ConsumerBase &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    HaSetCounter.flush();
 }
 
 bool DashHaOrch::addHaScopeEntry(const std::string &key, const dash::ha_scope::HaScope &entry)
@@ -20,6 +20,7 @@
 #include "saihelper.h"
 #include "directory.h"
 #include "flex_counter_manager.h"
+#include "redispipeline.h"
 
 #include "taskworker.h"
 #include "pbutils.h"
@@ -65,7 +66,6 @@ DashOrch::DashOrch(DBConnector *db, vector<string> &tableName, DBConnector *app_
     SWSS_LOG_ENTER();
 
     m_counter_db = std::shared_ptr<DBConnector>(new DBConnector("COUNTERS_DB", 0));
-    m_eni_name_table = make_unique<Table>(m_counter_db.get(), COUNTERS_ENI_NAME_MAP);
     dash_eni_result_table_ = make_unique<Table>(app_state_db, APP_DASH_ENI_TABLE_NAME);
     dash_eni_route_result_table_ = make_unique<Table>(app_state_db, APP_DASH_ENI_ROUTE_TABLE_NAME);
     dash_qos_result_table_ = make_unique<Table>(app_state_db, APP_DASH_QOS_TABLE_NAME);
@@ -1094,6 +1094,8 @@ void DashOrch::doTaskEniTable(ConsumerBase& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushEniCounters();
 }
 
 bool DashOrch::addQosEntry(const string& qos_name, const dash::qos::Qos &entry)
@@ -1377,9 +1379,7 @@ void DashOrch::addEniMapEntry(sai_object_id_t oid, const string &name)
 
     const auto id = sai_serialize_object_id(oid);
     SWSS_LOG_INFO("Adding ENI map entry for %s, id: %s", name.c_str(), id.c_str());
-    std::vector<FieldValueTuple> eniNameFvs;
-    eniNameFvs.emplace_back(name, id);
-    m_eni_name_table->set("", eniNameFvs);
+    m_eni_name_map_pending[name] = id;
 }
 
 void DashOrch::removeEniMapEntry(sai_object_id_t oid, const string &name) 
@@ -1392,10 +1392,48 @@ void DashOrch::removeEniMapEntry(sai_object_id_t oid, const string &name)
         return;
     }
 
-    m_eni_name_table->hdel("", name);
+    m_eni_name_map_pending[name] = "";
     SWSS_LOG_INFO("Removing ENI map entry for %s, id: %s", name.c_str(), sai_serialize_object_id(oid).c_str());
 }
 
+void DashOrch::flushEniCounters()
+{
+    SWSS_LOG_ENTER();
+
+    EniCounter.flush();
+    MeterCounter.flush();
+
+    if (m_eni_name_map_pending.empty())
+    {
+        return;
+    }
+
+    // One HSET for the ENIs added, the removed ones sent along
+    vector<FieldValueTuple> added;
+    RedisPipeline pipeline(m_counter_db.get());
+    Table writer(&pipeline, COUNTERS_ENI_NAME_MAP, true);
+
+    for (const auto& it: m_eni_name_map_pending)
+    {
+        if (it.second.empty())
+        {
+            writer.hdel("", it.first);
+        }
+        else
+        {
+            added.emplace_back(it.first, it.second);
+        }
+    }
+
+    if (!added.empty())
+    {
+        writer.set("", added);
+    }
+    pipeline.flush();
+
+    m_eni_name_map_pending.clear();
+}
+
 dash::types::IpAddress DashOrch::getApplianceVip()
 {
     SWSS_LOG_ENTER();
@@ -19,6 +19,7 @@
 #include "zmqserver.h"
 #include "flex_counter_manager.h"
 #include "dashcounter.h"
+#include "memaccounting.h"
 
 #include "dash_api/appliance.pb.h"
 #include "dash_api/eni.pb.h"
@@ -44,7 +45,10 @@ struct EniEntry
     sai_object_id_t getOid() const { return eni_id; }
 };
 
-typedef std::map<std::string, EniEntry> EniTable;
+MEM_ACCOUNTING_TAG(EniMemTag, "DashOrch|enis");
+
+typedef std::map<std::string, EniEntry, std::less<std::string>,
+                 MemAccountingAllocator<std::pair<const std::string, EniEntry>, EniMemTag>> EniTable;
 
 using DashEniCounter = DashCounter<CounterType::ENI, EniTable>;
 using DashMeterCounter = DashCounter<CounterType::DASH_METER, EniTable>;
@@ -112,8 +116,9 @@ protected:
     virtual bool isHaFlowOwnerAttrSupported();
 
 private:
-    std::unique_ptr<swss::Table> m_eni_name_table;
     std::shared_ptr<swss::DBConnector> m_counter_db;
+    // ENI name map fields to write on the next flush, empty OID for a removed ENI
+    std::map<std::string, std::string> m_eni_name_map_pending;
     std::shared_ptr<swss::DBConnector> m_asic_db;
     DashHaOrch* m_dash_ha_orch = nullptr;
     bool m_ha_flow_owner_attr_supported = false;
@@ -121,6 +126,7 @@ private:
 
     void addEniMapEntry(sai_object_id_t oid, const std::string& name);
     void removeEniMapEntry(sai_object_id_t oid, const std::string& name);
+    void flushEniCounters();
     DashEniCounter EniCounter;
     DashMeterCounter MeterCounter;
 
@@ -0,0 +1,3 @@
+#include "dashparsepool.h"
+
+size_t DashParsePool::m_threads = 0;
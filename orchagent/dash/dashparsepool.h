@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "orchworkerpool.h"
+#include "taskworker.h"
+
+/* SET tasks parsed per parse thread hand off */
+#define DASH_PARSE_CHUNK    256
+
+/*
+ * Threads parsing the protobuf messages of a DASH batch ahead of its
+ * processing, which is the bulk of the CPU work of a CA-to-PA mapping or a
+ * route. Only the messages are parsed there, validation, the bulkers and
+ * the SAI calls stay on the orch thread.
+ *
+ * The tasks are handed off in chunks of consecutive m_toSync entries. Those
+ * are in key order, so the mappings of a VNET and the routes of a route
+ * group, the tables of an ENI, mostly stay on the same thread.
+ */
+class DashParsePool
+{
+public:
+    static void setThreads(size_t threads) { m_threads = threads; }
+    static bool enabled() { return m_threads > 0; }
+
+    /*
+     * Parse the message of each task into its context, and set the context's
+     * parsed and parse_ok. The contexts must be distinct, and their messages
+     * may be on a PbArena, which is safe to allocate on from several threads.
+     */
+    template<typename Context>
+    void parse(const std::vector<std::pair<const swss::KeyOpFieldsValuesTuple *, Context *>> &tasks)
+    {
+        auto run = [&tasks](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                auto ctxt = tasks[i].second;
+                ctxt->parse_ok = parsePbMessage(kfvFieldsValues(*tasks[i].first), ctxt->metadata);
+                ctxt->parsed = true;
+            }
+        };
+
+        if (tasks.size() <= DASH_PARSE_CHUNK)
+        {
+            /* Not worth a hand off */
+            run(0, tasks.size());
+            return;
+        }
+
+        if (!m_pool)
+        {
+            m_pool.reset(new OrchWorkerPool(m_threads));
+        }
+
+        for (size_t begin = 0; begin < tasks.size(); begin += DASH_PARSE_CHUNK)
+        {
+            size_t end = std::min(begin + DASH_PARSE_CHUNK, tasks.size());
+            m_pool->submit([&run, begin, end]() { run(begin, end); });
+        }
+        m_pool->wait();
+    }
+
+    /*
+     * Create the bulk contexts of the SET tasks from begin to end, on arena,
+     * and parse their messages ahead of the batch
+     */
+    template<typename Iterator, typename Context>
+    void parse(Iterator begin, Iterator end,
+               std::map<std::pair<std::string, std::string>, Context> &toBulk, PbArena &arena)
+    {
+        std::vector<std::pair<const swss::KeyOpFieldsValuesTuple *, Context *>> tasks;
+        for (auto it = begin; it != end; it++)
+        {
+            const auto &tuple = it->second;
+            if (kfvOp(tuple) != SET_COMMAND)
+            {
+                continue;
+            }
+
+            auto rc = toBulk.emplace(std::piecewise_construct,
+                    std::forward_as_tuple(kfvKey(tuple), kfvOp(tuple)),
+                    std::forward_as_tuple(arena));
+            if (rc.second)
+            {
+                tasks.emplace_back(&tuple, &rc.first->second);
+            }
+        }
+
+        parse(tasks);
+    }
+
+private:
+    static size_t m_threads;
+    std::unique_ptr<OrchWorkerPool> m_pool;
+};
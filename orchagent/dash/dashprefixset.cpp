@@ -0,0 +1,203 @@
+#include <arpa/inet.h>
+
+#include <algorithm>
+
+#include "dashprefixset.h"
+
+using namespace std;
+
+using Address = DashPrefixSet::Address;
+using Range = DashPrefixSet::Range;
+
+static Address v6ToAddress(const sai_ip6_t &ip6)
+{
+    Address address = 0;
+    for (size_t i = 0; i < sizeof(sai_ip6_t); i++)
+    {
+        address = (address << 8) | ip6[i];
+    }
+    return address;
+}
+
+static void addressToV6(Address address, sai_ip6_t &ip6)
+{
+    for (size_t i = sizeof(sai_ip6_t); i > 0; i--)
+    {
+        ip6[i - 1] = static_cast<uint8_t>(address);
+        address >>= 8;
+    }
+}
+
+static unsigned countTrailingZeros(Address address)
+{
+    uint64_t low = static_cast<uint64_t>(address);
+    if (low)
+    {
+        return static_cast<unsigned>(__builtin_ctzll(low));
+    }
+    return 64 + static_cast<unsigned>(__builtin_ctzll(static_cast<uint64_t>(address >> 64)));
+}
+
+DashPrefixSet::DashPrefixSet(const vector<sai_ip_prefix_t> &prefixes)
+{
+    insert(prefixes);
+}
+
+void DashPrefixSet::insert(const vector<sai_ip_prefix_t> &prefixes)
+{
+    for (const auto &prefix : prefixes)
+    {
+        if (prefix.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        {
+            uint32_t mask = ntohl(prefix.mask.ip4);
+            uint32_t first = ntohl(prefix.addr.ip4) & mask;
+            m_v4.push_back({ first, first | ~mask });
+        }
+        else
+        {
+            Address mask = v6ToAddress(prefix.mask.ip6);
+            Address first = v6ToAddress(prefix.addr.ip6) & mask;
+            m_v6.push_back({ first, first | ~mask });
+        }
+    }
+
+    normalize(m_v4);
+    normalize(m_v6);
+}
+
+void DashPrefixSet::insert(const DashPrefixSet &other)
+{
+    m_v4.insert(m_v4.end(), other.m_v4.begin(), other.m_v4.end());
+    m_v6.insert(m_v6.end(), other.m_v6.begin(), other.m_v6.end());
+
+    normalize(m_v4);
+    normalize(m_v6);
+}
+
+DashPrefixSet DashPrefixSet::subtract(const DashPrefixSet &other) const
+{
+    DashPrefixSet diff;
+    diff.m_v4 = subtract(m_v4, other.m_v4);
+    diff.m_v6 = subtract(m_v6, other.m_v6);
+    return diff;
+}
+
+vector<sai_ip_prefix_t> DashPrefixSet::prefixes() const
+{
+    vector<sai_ip_prefix_t> prefixes;
+    appendPrefixes(prefixes);
+    return prefixes;
+}
+
+void DashPrefixSet::appendPrefixes(vector<sai_ip_prefix_t> &prefixes) const
+{
+    appendPrefixes(m_v4, SAI_IP_ADDR_FAMILY_IPV4, prefixes);
+    appendPrefixes(m_v6, SAI_IP_ADDR_FAMILY_IPV6, prefixes);
+}
+
+void DashPrefixSet::normalize(vector<Range> &ranges)
+{
+    if (ranges.size() < 2)
+    {
+        return;
+    }
+
+    sort(ranges.begin(), ranges.end(), [](const Range &a, const Range &b) { return a.first < b.first; });
+
+    // Overlapping and adjacent ranges are merged, written back in place
+    size_t last = 0;
+    for (size_t i = 1; i < ranges.size(); i++)
+    {
+        auto &merged = ranges[last];
+        if (ranges[i].first <= merged.last || ranges[i].first - 1 == merged.last)
+        {
+            merged.last = max(merged.last, ranges[i].last);
+        }
+        else
+        {
+            ranges[++last] = ranges[i];
+        }
+    }
+    ranges.resize(last + 1);
+}
+
+vector<Range> DashPrefixSet::subtract(const vector<Range> &a, const vector<Range> &b)
+{
+    vector<Range> diff;
+    size_t j = 0;
+
+    for (const auto &range : a)
+    {
+        while (j < b.size() && b[j].last < range.first)
+        {
+            j++;
+        }
+
+        Address first = range.first;
+        bool covered = false;
+        for (size_t k = j; k < b.size() && b[k].first <= range.last; k++)
+        {
+            if (b[k].first > first)
+            {
+                diff.push_back({ first, b[k].first - 1 });
+            }
+            if (b[k].last >= range.last)
+            {
+                covered = true;
+                break;
+            }
+            first = b[k].last + 1;
+        }
+
+        if (!covered)
+        {
+            diff.push_back({ first, range.last });
+        }
+    }
+
+    return diff;
+}
+
+void DashPrefixSet::appendPrefixes(const vector<Range> &ranges, sai_ip_addr_family_t family, vector<sai_ip_prefix_t> &prefixes)
+{
+    const unsigned width = (family == SAI_IP_ADDR_FAMILY_IPV4) ? 32 : 128;
+
+    for (const auto &range : ranges)
+    {
+        Address first = range.first;
+        while (true)
+        {
+            // The largest block aligned on first that doesn't go past the end of the range
+            unsigned bits = first ? min(countTrailingZeros(first), width) : width;
+            auto blockLast = [&first](unsigned b) {
+                return first + (b == 128 ? ~Address(0) : (Address(1) << b) - 1);
+            };
+            while (bits > 0 && blockLast(bits) > range.last)
+            {
+                bits--;
+            }
+
+            sai_ip_prefix_t prefix = {};
+            prefix.addr_family = family;
+            unsigned length = width - bits;
+            if (family == SAI_IP_ADDR_FAMILY_IPV4)
+            {
+                prefix.addr.ip4 = htonl(static_cast<uint32_t>(first));
+                prefix.mask.ip4 = htonl(length ? ~uint32_t(0) << (32 - length) : 0);
+            }
+            else
+            {
+                addressToV6(first, prefix.addr.ip6);
+                addressToV6(length ? ~Address(0) << (128 - length) : 0, prefix.mask.ip6);
+            }
+            prefixes.push_back(prefix);
+
+            Address last = blockLast(bits);
+            if (last >= range.last)
+            {
+                break;
+            }
+            first = last + 1;
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <saitypes.h>
+
+/*
+ * Set of IP prefixes kept as the sorted address ranges they cover.
+ *
+ * Duplicated, nested and adjacent prefixes collapse into one range, so a set
+ * built from a large prefix list is usually much smaller than the list, and
+ * prefixes() gives back the fewest prefixes covering exactly the same
+ * addresses. Two sets covering the same addresses compare equal whatever
+ * prefixes they were built from, and subtract() gives the ranges that differ.
+ */
+class DashPrefixSet
+{
+public:
+    using Address = unsigned __int128;
+
+    struct Range
+    {
+        Address first;
+        Address last;
+
+        bool operator==(const Range &other) const
+        {
+            return first == other.first && last == other.last;
+        }
+    };
+
+    DashPrefixSet() = default;
+    explicit DashPrefixSet(const std::vector<sai_ip_prefix_t> &prefixes);
+
+    void insert(const std::vector<sai_ip_prefix_t> &prefixes);
+    void insert(const DashPrefixSet &other);
+
+    // Addresses of this set that are not in other
+    DashPrefixSet subtract(const DashPrefixSet &other) const;
+
+    std::vector<sai_ip_prefix_t> prefixes() const;
+    void appendPrefixes(std::vector<sai_ip_prefix_t> &prefixes) const;
+
+    bool empty() const
+    {
+        return m_v4.empty() && m_v6.empty();
+    }
+
+    size_t rangeCount() const
+    {
+        return m_v4.size() + m_v6.size();
+    }
+
+    bool operator==(const DashPrefixSet &other) const
+    {
+        return m_v4 == other.m_v4 && m_v6 == other.m_v6;
+    }
+
+    bool operator!=(const DashPrefixSet &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    static void normalize(std::vector<Range> &ranges);
+    static std::vector<Range> subtract(const std::vector<Range> &a, const std::vector<Range> &b);
+    static void appendPrefixes(const std::vector<Range> &ranges, sai_ip_addr_family_t family, std::vector<sai_ip_prefix_t> &prefixes);
+
+    // IPv4 ranges are in the low 32 bits
+    std::vector<Range> m_v4;
+    std::vector<Range> m_v6;
+};
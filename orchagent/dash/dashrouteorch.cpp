@@ -288,6 +288,11 @@ void DashRouteOrch::doTaskRouteTable(ConsumerBase& consumer)
         std::map<std::pair<std::string, std::string>,
             OutboundRoutingBulkContext> toBulk;
 
+        if (DashParsePool::enabled())
+        {
+            parse_pool_.parse(it, consumer.m_toSync.end(), toBulk, pb_arena_);
+        }
+
         while (it != consumer.m_toSync.end())
         {
             KeyOpFieldsValuesTuple tuple = it->second;
@@ -295,7 +300,7 @@ void DashRouteOrch::doTaskRouteTable(ConsumerBase& consumer)
             auto op = kfvOp(tuple);
             auto rc = toBulk.emplace(std::piecewise_construct,
                     std::forward_as_tuple(key, op),
-                    std::forward_as_tuple());
+                    std::forward_as_tuple(pb_arena_));
             bool inserted = rc.second;
             auto &ctxt = rc.first->second;
             result = DASH_RESULT_SUCCESS;
@@ -317,7 +322,10 @@ void DashRouteOrch::doTaskRouteTable(ConsumerBase& consumer)
 
             if (op == SET_COMMAND)
             {
-                if (!parsePbMessage(kfvFieldsValues(tuple), ctxt.metadata))
+                // A later task of the same key and op is parsed here
+                bool parse_ok = ctxt.parsed ? ctxt.parse_ok : parsePbMessage(kfvFieldsValues(tuple), ctxt.metadata);
+                ctxt.parsed = false;
+                if (!parse_ok)
                 {
                     SWSS_LOG_WARN("Requires protobuff at OutboundRouting :%s", key.c_str());
                     it = consumer.m_toSync.erase(it);
@@ -415,6 +423,9 @@ void DashRouteOrch::doTaskRouteTable(ConsumerBase& consumer)
                 }
             }
         }
+
+        // The bulk contexts of this batch are done with their messages
+        pb_arena_.reset();
     }
 }
 
@@ -572,6 +583,11 @@ void DashRouteOrch::doTaskRouteRuleTable(ConsumerBase& consumer)
         std::map<std::pair<std::string, std::string>,
             InboundRoutingBulkContext> toBulk;
 
+        if (DashParsePool::enabled())
+        {
+            parse_pool_.parse(it, consumer.m_toSync.end(), toBulk, pb_arena_);
+        }
+
         while (it != consumer.m_toSync.end())
         {
             KeyOpFieldsValuesTuple tuple = it->second;
@@ -579,7 +595,7 @@ void DashRouteOrch::doTaskRouteRuleTable(ConsumerBase& consumer)
             auto op = kfvOp(tuple);
             auto rc = toBulk.emplace(std::piecewise_construct,
                     std::forward_as_tuple(key, op),
-                    std::forward_as_tuple());
+                    std::forward_as_tuple(pb_arena_));
             bool inserted = rc.second;
             auto &ctxt = rc.first->second;
             result = DASH_RESULT_SUCCESS;
@@ -628,7 +644,10 @@ void DashRouteOrch::doTaskRouteRuleTable(ConsumerBase& consumer)
 
             if (op == SET_COMMAND)
             {
-                if (!parsePbMessage(kfvFieldsValues(tuple), ctxt.metadata))
+                // A later task of the same key and op is parsed here
+                bool parse_ok = ctxt.parsed ? ctxt.parse_ok : parsePbMessage(kfvFieldsValues(tuple), ctxt.metadata);
+                ctxt.parsed = false;
+                if (!parse_ok)
                 {
                     SWSS_LOG_WARN("Requires protobuff at InboundRouting :%s", key.c_str());
                     it = consumer.m_toSync.erase(it);
@@ -717,6 +736,9 @@ void DashRouteOrch::doTaskRouteRuleTable(ConsumerBase& consumer)
                 }
             }
         }
+
+        // The bulk contexts of this batch are done with their messages
+        pb_arena_.reset();
     }
 }
 
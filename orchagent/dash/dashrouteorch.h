@@ -15,6 +15,8 @@
 #include "dashorch.h"
 #include "zmqorch.h"
 #include "zmqserver.h"
+#include "taskworker.h"
+#include "dashparsepool.h"
 
 #include "dash_api/route.pb.h"
 #include "dash_api/route_rule.pb.h"
@@ -24,9 +26,12 @@ struct OutboundRoutingBulkContext
 {
     std::string route_group;
     swss::IpPrefix destination;
-    dash::route::Route metadata;
+    dash::route::Route &metadata;
+    // Set when metadata was parsed ahead by the DashParsePool
+    bool parsed = false;
+    bool parse_ok = false;
     std::deque<sai_status_t> object_statuses;
-    OutboundRoutingBulkContext() {}
+    OutboundRoutingBulkContext(PbArena &arena) : metadata(arena.create<dash::route::Route>()) {}
     OutboundRoutingBulkContext(const OutboundRoutingBulkContext&) = delete;
     OutboundRoutingBulkContext(OutboundRoutingBulkContext&&) = delete;
 
@@ -43,9 +48,12 @@ struct InboundRoutingBulkContext
     swss::IpAddress sip;
     swss::IpAddress sip_mask;
     uint32_t priority;
-    dash::route_rule::RouteRule metadata;
+    dash::route_rule::RouteRule &metadata;
+    // Set when metadata was parsed ahead by the DashParsePool
+    bool parsed = false;
+    bool parse_ok = false;
     std::deque<sai_status_t> object_statuses;
-    InboundRoutingBulkContext() {}
+    InboundRoutingBulkContext(PbArena &arena) : metadata(arena.create<dash::route_rule::RouteRule>()) {}
     InboundRoutingBulkContext(const InboundRoutingBulkContext&) = delete;
     InboundRoutingBulkContext(InboundRoutingBulkContext&&) = delete;
 
@@ -73,6 +81,9 @@ private:
     std::unique_ptr<swss::Table> dash_route_result_table_;
     std::unique_ptr<swss::Table> dash_route_rule_result_table_;
     std::unique_ptr<swss::Table> dash_route_group_result_table_;
+    // Holds the messages of the bulk contexts, reset once per batch
+    PbArena pb_arena_;
+    DashParsePool parse_pool_;
 
     void doTask(ConsumerBase &consumer);
     void doTaskRouteTable(ConsumerBase &consumer);
@@ -13,11 +13,15 @@ bool from_pb(const dash::tag::PrefixTag& data, DashTag& tag)
         return false;
     }
 
-    if(!to_sai(data.prefix_list(), tag.m_prefixes))
+    vector<sai_ip_prefix_t> prefixes;
+    if(!to_sai(data.prefix_list(), prefixes))
     {
         return false;
     }
 
+    // Duplicated, nested and adjacent prefixes of large tags are collapsed once here
+    tag.m_prefixes = DashPrefixSet(prefixes);
+
     return true;
 }
 
@@ -64,9 +68,23 @@ task_process_status DashTagMgr::update(const string& tag_id, const DashTag& new_
         return task_failed;
     }
 
+    // Only the address ranges added or removed are looked at to find the rules to update
+    auto changed = new_tag.m_prefixes.subtract(tag.m_prefixes);
+    changed.insert(tag.m_prefixes.subtract(new_tag.m_prefixes));
+    if (changed.empty())
+    {
+        SWSS_LOG_INFO("Prefixes of tag %s are unchanged", tag_id.c_str());
+        return task_success;
+    }
+
     // Update tag prefixes
     tag.m_prefixes = new_tag.m_prefixes;
 
+    for (const auto& group_id : tag.m_groups)
+    {
+        m_dash_acl_orch->getDashAclGroupMgr().onUpdate(group_id, tag_id, changed);
+    }
+
     return task_success;
 }
 
@@ -99,7 +117,7 @@ bool DashTagMgr::exists(const string& tag_id) const
     return m_tag_table.find(tag_id) != m_tag_table.end();
 }
 
-const vector<sai_ip_prefix_t>& DashTagMgr::getPrefixes(const string& tag_id) const
+const DashPrefixSet& DashTagMgr::getPrefixes(const string& tag_id) const
 {
     SWSS_LOG_ENTER();
 
@@ -9,12 +9,13 @@
 
 #include "dashorch.h"
 #include "pbutils.h"
+#include "dashprefixset.h"
 
 #include "dash_api/prefix_tag.pb.h"
 
 struct DashTag {
     sai_ip_addr_family_t m_ip_version;
-    std::vector<sai_ip_prefix_t> m_prefixes;
+    DashPrefixSet m_prefixes;
     std::unordered_set<std::string> m_groups;
 };
 
@@ -33,7 +34,7 @@ public:
     task_process_status remove(const std::string& tag_id);
     bool exists(const std::string& tag_id) const;
 
-    const std::vector<sai_ip_prefix_t>& getPrefixes(const std::string& tag_id) const;
+    const DashPrefixSet& getPrefixes(const std::string& tag_id) const;
 
     task_process_status attach(const std::string& tag_id, const std::string& group_id);
     task_process_status detach(const std::string& tag_id, const std::string& group_id);
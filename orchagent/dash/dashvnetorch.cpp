@@ -189,7 +189,7 @@ void DashVnetOrch::doTaskVnetTable(ConsumerBase& consumer)
             auto op = kfvOp(tuple);
             auto rc = toBulk.emplace(std::piecewise_construct,
                     std::forward_as_tuple(key, op),
-                    std::forward_as_tuple());
+                    std::forward_as_tuple(pb_arena_));
             bool inserted = rc.second;
             auto& vnet_ctxt = rc.first->second;
             result = DASH_RESULT_SUCCESS;
@@ -295,6 +295,9 @@ void DashVnetOrch::doTaskVnetTable(ConsumerBase& consumer)
                 }
             }
         }
+
+        // The bulk contexts of this batch are done with their messages
+        pb_arena_.reset();
     }
 }
 
@@ -734,6 +737,11 @@ void DashVnetOrch::doTaskVnetMapTable(ConsumerBase& consumer)
         std::map<std::pair<std::string, std::string>,
             VnetMapBulkContext> toBulk;
 
+        if (DashParsePool::enabled())
+        {
+            parse_pool_.parse(it, consumer.m_toSync.end(), toBulk, pb_arena_);
+        }
+
         while (it != consumer.m_toSync.end())
         {
             KeyOpFieldsValuesTuple tuple = it->second;
@@ -741,7 +749,7 @@ void DashVnetOrch::doTaskVnetMapTable(ConsumerBase& consumer)
             auto op = kfvOp(tuple);
             auto rc = toBulk.emplace(std::piecewise_construct,
                     std::forward_as_tuple(key, op),
-                    std::forward_as_tuple());
+                    std::forward_as_tuple(pb_arena_));
             bool inserted = rc.second;
             auto& ctxt = rc.first->second;
             result = DASH_RESULT_SUCCESS;
@@ -762,7 +770,10 @@ void DashVnetOrch::doTaskVnetMapTable(ConsumerBase& consumer)
 
             if (op == SET_COMMAND)
             {
-                if (!parsePbMessage(kfvFieldsValues(tuple), ctxt.metadata))
+                // A later task of the same key and op is parsed here
+                bool parse_ok = ctxt.parsed ? ctxt.parse_ok : parsePbMessage(kfvFieldsValues(tuple), ctxt.metadata);
+                ctxt.parsed = false;
+                if (!parse_ok)
                 {
                     SWSS_LOG_WARN("Requires protobuff at VnetMap :%s", key.c_str());
                     it = consumer.m_toSync.erase(it);
@@ -863,6 +874,9 @@ void DashVnetOrch::doTaskVnetMapTable(ConsumerBase& consumer)
                 }
             }
         }
+
+        // The bulk contexts of this batch are done with their messages
+        pb_arena_.reset();
     }
 }
 
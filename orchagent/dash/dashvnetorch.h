@@ -13,6 +13,9 @@
 #include "timer.h"
 #include "zmqorch.h"
 #include "zmqserver.h"
+#include "taskworker.h"
+#include "dashparsepool.h"
+#include "memaccounting.h"
 
 #include "dash_api/vnet.pb.h"
 #include "dash_api/vnet_mapping.pb.h"
@@ -24,16 +27,19 @@ struct VnetEntry
     std::set<std::string> underlay_ips;
 };
 
-typedef std::unordered_map<std::string, VnetEntry> DashVnetTable;
+MEM_ACCOUNTING_TAG(DashVnetMemTag, "DashVnetOrch|vnets");
+
+typedef std::unordered_map<std::string, VnetEntry, std::hash<std::string>, std::equal_to<std::string>,
+                           MemAccountingAllocator<std::pair<const std::string, VnetEntry>, DashVnetMemTag>> DashVnetTable;
 
 struct DashVnetBulkContext
 {
     std::string vnet_name;
-    dash::vnet::Vnet metadata;
+    dash::vnet::Vnet &metadata;
     std::deque<sai_object_id_t> object_ids;
     std::deque<sai_status_t> vnet_statuses;
     std::deque<sai_status_t> pa_validation_statuses;
-    DashVnetBulkContext() {}
+    DashVnetBulkContext(PbArena &arena) : metadata(arena.create<dash::vnet::Vnet>()) {}
 
     DashVnetBulkContext(const DashVnetBulkContext&) = delete;
     DashVnetBulkContext(DashVnetBulkContext&&) = delete;
@@ -50,10 +56,13 @@ struct VnetMapBulkContext
 {
     std::string vnet_name;
     swss::IpAddress dip;
-    dash::vnet_mapping::VnetMapping metadata;
+    dash::vnet_mapping::VnetMapping &metadata;
+    // Set when metadata was parsed ahead by the DashParsePool
+    bool parsed = false;
+    bool parse_ok = false;
     std::deque<sai_status_t> outbound_ca_to_pa_object_statuses;
     std::deque<sai_status_t> pa_validation_object_statuses;
-    VnetMapBulkContext() {}
+    VnetMapBulkContext(PbArena &arena) : metadata(arena.create<dash::vnet_mapping::VnetMapping>()) {}
 
     VnetMapBulkContext(const VnetMapBulkContext&) = delete;
     VnetMapBulkContext(VnetMapBulkContext&&) = delete;
@@ -77,6 +86,9 @@ private:
     EntityBulker<sai_dash_pa_validation_api_t> pa_validation_bulker_;
     std::unique_ptr<swss::Table> dash_vnet_result_table_;
     std::unique_ptr<swss::Table> dash_vnet_map_result_table_;
+    // Holds the messages of the bulk contexts, reset once per batch
+    PbArena pb_arena_;
+    DashParsePool parse_pool_;
 
     void doTask(ConsumerBase &consumer);
     void doTaskVnetTable(ConsumerBase &consumer);
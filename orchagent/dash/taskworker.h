@@ -6,6 +6,7 @@
 #include <string>
 #include <tuple>
 
+#include <google/protobuf/arena.h>
 #include <google/protobuf/message.h>
 
 #include <swss/logger.h>
@@ -28,6 +29,7 @@ using TaskMap = std::map<TaskKey, TaskFunc>;
 
 #define PbIdentifier "pb"
 
+// Parses the message in place from the "pb" field, without copying the field out first
 template<typename MessageType>
 bool parsePbMessage(
     const std::vector<swss::FieldValueTuple> &data,
@@ -35,26 +37,70 @@ bool parsePbMessage(
 {
     SWSS_LOG_ENTER();
 
-    auto pb = swss::fvsGetValue(data, PbIdentifier);
-    if (pb)
+    for (const auto &fv : data)
     {
-        if (msg.ParseFromString(*pb))
+        if (fvField(fv) != PbIdentifier)
         {
-            return true;
+            continue;
         }
-        else
+
+        const auto &pb = fvValue(fv);
+        if (msg.ParseFromArray(pb.data(), static_cast<int>(pb.size())))
         {
-            SWSS_LOG_WARN("Failed to parse protobuf message from string: %s", pb->c_str());
+            return true;
         }
-    }
-    else
-    {
-        SWSS_LOG_WARN("Protobuf field cannot be found");
+
+        SWSS_LOG_WARN("Failed to parse protobuf message from string: %s", pb.c_str());
+        return false;
     }
 
+    SWSS_LOG_WARN("Protobuf field cannot be found");
     return false;
 }
 
+/*
+ * Arena for the protobuf messages of one doTask batch.
+ *
+ * Messages created on it are freed all at once by reset(), so the bulk
+ * contexts of a batch don't allocate and free every nested field on their
+ * own. The arena starts on an inline block that reset() keeps, a batch that
+ * fits in it doesn't touch the heap at all. Nothing created on the arena may
+ * be used after reset(), whatever outlives the batch has to be copied out.
+ */
+class PbArena
+{
+public:
+    PbArena() : m_arena(options()) {}
+
+    PbArena(const PbArena &) = delete;
+    PbArena &operator=(const PbArena &) = delete;
+
+    template<typename MessageType>
+    MessageType &create()
+    {
+        return *google::protobuf::Arena::CreateMessage<MessageType>(&m_arena);
+    }
+
+    void reset()
+    {
+        m_arena.Reset();
+    }
+
+private:
+    static constexpr size_t INITIAL_BLOCK_SIZE = 64 * 1024;
+
+    google::protobuf::ArenaOptions options()
+    {
+        google::protobuf::ArenaOptions opts;
+        opts.initial_block = m_block;
+        opts.initial_block_size = sizeof(m_block);
+        return opts;
+    }
+
+    alignas(8) char m_block[INITIAL_BLOCK_SIZE];
+    google::protobuf::Arena m_arena;
+};
+
 template<typename MessageType>
 class PbWorker : public TaskWorker
 {
@@ -69,17 +115,20 @@ public:
     {
         SWSS_LOG_ENTER();
 
-        MessageType msg;
+        auto status = task_process_status::task_invalid_entry;
+        auto &msg = m_arena.create<MessageType>();
         if (parsePbMessage(data, msg))
         {
-            return m_func(key, msg);
+            status = m_func(key, msg);
         }
         else
         {
             SWSS_LOG_WARN("This orch requires protobuff message at :%s", key.c_str());
         }
 
-        return task_process_status::task_invalid_entry;
+        // The task gets the message by reference for the call only
+        m_arena.reset();
+        return status;
     }
 
     template<typename MemberFunc, typename ObjType>
@@ -97,6 +146,7 @@ public:
 
 private:
      Task m_func;
+     PbArena m_arena;
 };
 
 class KeyOnlyWorker : public TaskWorker
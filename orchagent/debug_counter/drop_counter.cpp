@@ -2,6 +2,7 @@
 
 #include "logger.h"
 #include "sai_serialize.h"
+#include "saicapabilitycache.h"
 
 #include <vector>
 
@@ -87,9 +88,22 @@ const uint32_t maxDropReasons = 100;
 
 // If initialization fails, this constructor will throw a runtime error.
 DropCounter::DropCounter(const string& counter_name, const string& counter_type, const unordered_set<string>& drop_reasons)
-        : DebugCounter(counter_name, counter_type), drop_reasons(drop_reasons)
+        : DebugCounter(counter_name, counter_type)
 {
     SWSS_LOG_ENTER();
+
+    for (const auto& drop_reason: drop_reasons)
+    {
+        size_t index;
+        if (!getDropReasonIndex(drop_reason, &index))
+        {
+            SWSS_LOG_ERROR("Drop reason '%s' not found for counter type '%s'", drop_reason.c_str(), type.c_str());
+            throw runtime_error("Drop reason not found");
+        }
+
+        this->drop_reasons.set(index);
+    }
+
     initializeDropCounterInSAI();
 }
 
@@ -112,6 +126,11 @@ std::string DropCounter::getDebugCounterSAIStat() const
 {
     SWSS_LOG_ENTER();
 
+    if (!sai_stat.empty())
+    {
+        return sai_stat;
+    }
+
     sai_attribute_t index_attribute;
     index_attribute.id = SAI_DEBUG_COUNTER_ATTR_INDEX;
     if (sai_debug_counter_api->get_debug_counter_attribute(counter_id, 1, &index_attribute) != SAI_STATUS_SUCCESS)
@@ -123,51 +142,86 @@ std::string DropCounter::getDebugCounterSAIStat() const
     auto index = index_attribute.value.u32;
     if (type == PORT_INGRESS_DROPS)
     {
-        return sai_serialize_port_stat(static_cast<sai_port_stat_t>(SAI_PORT_STAT_IN_DROP_REASON_RANGE_BASE + index));
+        sai_stat = sai_serialize_port_stat(static_cast<sai_port_stat_t>(SAI_PORT_STAT_IN_DROP_REASON_RANGE_BASE + index));
     }
     else if (type == PORT_EGRESS_DROPS)
     {
-        return sai_serialize_port_stat(static_cast<sai_port_stat_t>(SAI_PORT_STAT_OUT_DROP_REASON_RANGE_BASE + index));
+        sai_stat = sai_serialize_port_stat(static_cast<sai_port_stat_t>(SAI_PORT_STAT_OUT_DROP_REASON_RANGE_BASE + index));
     }
     else if (type == SWITCH_INGRESS_DROPS)
     {
-        return sai_serialize_switch_stat(static_cast<sai_switch_stat_t>(SAI_SWITCH_STAT_IN_DROP_REASON_RANGE_BASE + index));
+        sai_stat = sai_serialize_switch_stat(static_cast<sai_switch_stat_t>(SAI_SWITCH_STAT_IN_DROP_REASON_RANGE_BASE + index));
     }
     else if (type == SWITCH_EGRESS_DROPS)
     {
-        return sai_serialize_switch_stat(static_cast<sai_switch_stat_t>(SAI_SWITCH_STAT_OUT_DROP_REASON_RANGE_BASE + index));
+        sai_stat = sai_serialize_switch_stat(static_cast<sai_switch_stat_t>(SAI_SWITCH_STAT_OUT_DROP_REASON_RANGE_BASE + index));
     }
     else
     {
         SWSS_LOG_ERROR("No stat found for debug counter '%s' of type '%s'", name.c_str(), type.c_str());
         throw runtime_error("No stat found for debug counter");
     }
+
+    return sai_stat;
 }
 
-// If the drop reason is already present on this counter, this method has no
-// effect.
+// getDropReasonIndex returns the position of the drop reason in the bitmap of
+// this counter, which is its SAI enum value for the direction of the counter.
 //
-// If the update fails, this method throws a runtime error.
-void DropCounter::addDropReason(const std::string& drop_reason)
+// Returns false if the drop reason does not apply to this counter.
+bool DropCounter::getDropReasonIndex(const std::string& drop_reason, size_t *index) const
 {
-    SWSS_LOG_ENTER();
+    int32_t value;
+    if (isIngressCounter())
+    {
+        auto reason_it = ingress_drop_reason_lookup.find(drop_reason);
+        if (reason_it == ingress_drop_reason_lookup.end())
+        {
+            return false;
+        }
 
-    if (drop_reasons.find(drop_reason) != drop_reasons.end())
+        value = static_cast<int32_t>(reason_it->second);
+    }
+    else
     {
-        SWSS_LOG_DEBUG("Drop reason '%s' already present on '%s'", drop_reason.c_str(), name.c_str());
-        return;
+        auto reason_it = egress_drop_reason_lookup.find(drop_reason);
+        if (reason_it == egress_drop_reason_lookup.end())
+        {
+            return false;
+        }
+
+        value = static_cast<int32_t>(reason_it->second);
     }
 
-    try
+    if (value < 0 || static_cast<size_t>(value) >= DROP_REASON_BITMAP_SIZE)
     {
-        drop_reasons.emplace(drop_reason);
-        updateDropReasonsInSAI();
+        SWSS_LOG_ERROR("Drop reason '%s' is out of the drop reason bitmap range", drop_reason.c_str());
+        return false;
     }
-    catch (const std::runtime_error& e)
+
+    *index = static_cast<size_t>(value);
+    return true;
+}
+
+// If the drop reason is already present on this counter, this method has no
+// effect.
+//
+// If the drop reason does not apply to this counter or the update fails, this
+// method throws a runtime error.
+void DropCounter::addDropReason(const std::string& drop_reason)
+{
+    SWSS_LOG_ENTER();
+
+    size_t index;
+    if (!getDropReasonIndex(drop_reason, &index))
     {
-        drop_reasons.erase(drop_reason);
-        throw;
+        SWSS_LOG_ERROR("Drop reason '%s' not found for counter '%s'", drop_reason.c_str(), name.c_str());
+        throw runtime_error("Drop reason not found");
     }
+
+    DropReasonBitmap reasons = drop_reasons;
+    reasons.set(index);
+    setDropReasons(reasons);
 }
 
 // If the drop reason is not present on this counter, this method has no
@@ -178,22 +232,44 @@ void DropCounter::removeDropReason(const std::string& drop_reason)
 {
     SWSS_LOG_ENTER();
 
-    auto drop_reason_it = drop_reasons.find(drop_reason);
-    if (drop_reason_it == drop_reasons.end())
+    size_t index;
+    if (!getDropReasonIndex(drop_reason, &index))
     {
         SWSS_LOG_DEBUG("Drop reason '%s' not present on '%s'", drop_reason.c_str(), name.c_str());
         return;
     }
 
+    DropReasonBitmap reasons = drop_reasons;
+    reasons.reset(index);
+    setDropReasons(reasons);
+}
+
+// setDropReasons replaces the drop reasons of this counter with a single
+// update of the drop reason list in the SAI. If the reasons are unchanged,
+// this method has no effect.
+//
+// If the update fails, the previous reasons are kept and this method throws
+// a runtime error.
+void DropCounter::setDropReasons(const DropReasonBitmap& reasons)
+{
+    SWSS_LOG_ENTER();
+
+    if (reasons == drop_reasons)
+    {
+        SWSS_LOG_DEBUG("Drop reasons of '%s' are unchanged", name.c_str());
+        return;
+    }
+
+    DropReasonBitmap previous_reasons = drop_reasons;
     try
     {
-        drop_reasons.erase(drop_reason_it);
+        drop_reasons = reasons;
         updateDropReasonsInSAI();
     }
     catch (const std::runtime_error& e)
     {
-        drop_reasons.emplace(drop_reason);
-        throw e;
+        drop_reasons = previous_reasons;
+        throw;
     }
 }
 
@@ -211,67 +287,53 @@ bool DropCounter::isEgressDropReasonValid(const std::string& drop_reason)
 void DropCounter::initializeDropCounterInSAI()
 {
     sai_attribute_t debug_counter_attributes[2];
-    vector<int32_t> drop_reason_list(drop_reasons.size());
+    vector<int32_t> drop_reason_list;
     DebugCounter::serializeDebugCounterType(debug_counter_attributes[0]);
-    DropCounter::serializeDropReasons(static_cast<uint32_t>(drop_reasons.size()), drop_reason_list.data(), debug_counter_attributes + 1);
+    DropCounter::serializeDropReasons(drop_reason_list, debug_counter_attributes + 1);
     DebugCounter::addDebugCounterToSAI(2, debug_counter_attributes);
 }
 
-// serializeDropReasons takes the list of drop reasons associated with this
-// counter and stores them in a SAI readable format in drop_reason_attribute.
-//
-// This method assumes that drop_reason_list points to a region in memory with
-// enough space for drop_reason_count drop reasons to be stored.
+bool DropCounter::isIngressCounter() const
+{
+    return type == PORT_INGRESS_DROPS || type == SWITCH_INGRESS_DROPS;
+}
+
+// serializeDropReasons takes the drop reasons associated with this counter
+// and stores them in a SAI readable format in drop_reason_attribute. The
+// attribute points into drop_reason_list, which must outlive it.
 //
-// If any of the provided drop reasons (or their serialization) is undefined,
-// then this method throws a runtime error.
-void DropCounter::serializeDropReasons(uint32_t drop_reason_count, int32_t *drop_reason_list, sai_attribute_t *drop_reason_attribute)
+// If the serialization is undefined for the type of this counter, then this
+// method throws a runtime error.
+void DropCounter::serializeDropReasons(vector<int32_t>& drop_reason_list, sai_attribute_t *drop_reason_attribute) const
 {
     SWSS_LOG_ENTER();
 
     if (type == PORT_INGRESS_DROPS || type == SWITCH_INGRESS_DROPS)
     {
         drop_reason_attribute->id = SAI_DEBUG_COUNTER_ATTR_IN_DROP_REASON_LIST;
-        drop_reason_attribute->value.s32list.count = drop_reason_count;
-        drop_reason_attribute->value.s32list.list = drop_reason_list;
-
-        int index = 0;
-        for (auto drop_reason: drop_reasons)
-        {
-            auto reason_it = ingress_drop_reason_lookup.find(drop_reason);
-            if (reason_it == ingress_drop_reason_lookup.end())
-            {
-                SWSS_LOG_ERROR("Ingress drop reason '%s' not found", drop_reason.c_str());
-                throw runtime_error("Ingress drop reason not found");
-            }
-
-            drop_reason_list[index++] = static_cast<int32_t>(reason_it->second);
-        }
     }
     else if (type == PORT_EGRESS_DROPS || type == SWITCH_EGRESS_DROPS)
     {
-            drop_reason_attribute->id = SAI_DEBUG_COUNTER_ATTR_OUT_DROP_REASON_LIST;
-            drop_reason_attribute->value.s32list.count = drop_reason_count;
-            drop_reason_attribute->value.s32list.list = drop_reason_list;
-
-            int index = 0;
-            for (auto drop_reason: drop_reasons)
-            {
-                auto reason_it = egress_drop_reason_lookup.find(drop_reason);
-                if (reason_it == egress_drop_reason_lookup.end())
-                {
-                    SWSS_LOG_ERROR("Egress drop reason '%s' not found", drop_reason.c_str());
-                    throw runtime_error("Egress drop reason not found");
-                }
-
-                drop_reason_list[index++] = static_cast<int32_t>(reason_it->second);
-            }
+        drop_reason_attribute->id = SAI_DEBUG_COUNTER_ATTR_OUT_DROP_REASON_LIST;
     }
     else
     {
         SWSS_LOG_ERROR("Serialization undefined for drop counter type '%s'", type.c_str());
         throw runtime_error("Failed to serialize drop counter attributes");
     }
+
+    drop_reason_list.clear();
+    drop_reason_list.reserve(drop_reasons.count());
+    for (size_t index = 0; index < drop_reasons.size(); index++)
+    {
+        if (drop_reasons.test(index))
+        {
+            drop_reason_list.push_back(static_cast<int32_t>(index));
+        }
+    }
+
+    drop_reason_attribute->value.s32list.count = static_cast<uint32_t>(drop_reason_list.size());
+    drop_reason_attribute->value.s32list.list = drop_reason_list.data();
 }
 
 // If the SAI update fails, this method throws a runtime error.
@@ -280,8 +342,8 @@ void DropCounter::updateDropReasonsInSAI()
     SWSS_LOG_ENTER();
 
     sai_attribute_t updated_drop_reasons;
-    vector<int32_t> drop_reason_list(drop_reasons.size());
-    serializeDropReasons(static_cast<uint32_t>(drop_reasons.size()), drop_reason_list.data(), &updated_drop_reasons);
+    vector<int32_t> drop_reason_list;
+    serializeDropReasons(drop_reason_list, &updated_drop_reasons);
     if (sai_debug_counter_api->set_debug_counter_attribute(counter_id, &updated_drop_reasons) != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Could not update drop reasons for drop counter '%s'", name.c_str());
@@ -302,10 +364,10 @@ unordered_set<string> DropCounter::getSupportedDropReasons(sai_debug_counter_att
     drop_reason_list.count = maxDropReasons;
     drop_reason_list.list = supported_reasons;
 
-    if (sai_query_attribute_enum_values_capability(gSwitchId,
-                                                   SAI_OBJECT_TYPE_DEBUG_COUNTER,
-                                                   drop_reason_type,
-                                                   &drop_reason_list) != SAI_STATUS_SUCCESS)
+    if (querySaiAttributeEnumValuesCapability(gSwitchId,
+                                              SAI_OBJECT_TYPE_DEBUG_COUNTER,
+                                              drop_reason_type,
+                                              &drop_reason_list) != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_NOTICE("This device does not support querying drop reasons");
         return {};
@@ -373,10 +435,10 @@ unordered_set<string> DropCounter::getSupportedCounterTypes()
     enumValuesCapabilities.count = static_cast<uint32_t>(saiCounterTypes.size());
     enumValuesCapabilities.list = saiCounterTypes.data();
 
-    status = sai_query_attribute_enum_values_capability(gSwitchId,
-                                                        SAI_OBJECT_TYPE_DEBUG_COUNTER,
-                                                        SAI_DEBUG_COUNTER_ATTR_TYPE,
-                                                        &enumValuesCapabilities);
+    status = querySaiAttributeEnumValuesCapability(gSwitchId,
+                                                   SAI_OBJECT_TYPE_DEBUG_COUNTER,
+                                                   SAI_DEBUG_COUNTER_ATTR_TYPE,
+                                                   &enumValuesCapabilities);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_NOTICE("This device does not support querying drop counters");
@@ -1,9 +1,11 @@
 #ifndef SWSS_UTIL_DROP_COUNTER_H_
 #define SWSS_UTIL_DROP_COUNTER_H_
 
+#include <bitset>
 #include <string>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 #include "debug_counter.h"
 #include "drop_reasons.h"
 
@@ -11,6 +13,11 @@ extern "C" {
 #include "sai.h"
 }
 
+// Drop reasons of a counter, indexed by their sai_in_drop_reason_t or
+// sai_out_drop_reason_t value depending on the direction of the counter.
+#define DROP_REASON_BITMAP_SIZE 256
+using DropReasonBitmap = std::bitset<DROP_REASON_BITMAP_SIZE>;
+
 // DropCounter represents a SAI debug counter object that track packet drops.
 class DropCounter : public DebugCounter
 {
@@ -22,12 +29,15 @@ class DropCounter : public DebugCounter
         DropCounter& operator=(const DropCounter&) = delete;
         virtual ~DropCounter();
 
-        const std::unordered_set<std::string>& getDropReasons() const { return drop_reasons; }
+        const DropReasonBitmap& getDropReasons() const { return drop_reasons; }
 
         virtual std::string getDebugCounterSAIStat() const noexcept(false);
 
+        bool getDropReasonIndex(const std::string& drop_reason, size_t *index) const;
+
         void addDropReason(const std::string& drop_reason) noexcept(false);
         void removeDropReason(const std::string& drop_reason) noexcept(false);
+        void setDropReasons(const DropReasonBitmap& reasons) noexcept(false);
 
         static bool isIngressDropReasonValid(const std::string& drop_reason);
         static bool isEgressDropReasonValid(const std::string& drop_reason);
@@ -39,13 +49,16 @@ class DropCounter : public DebugCounter
 
     private:
         void initializeDropCounterInSAI() noexcept(false);
+        bool isIngressCounter() const;
         void serializeDropReasons(
-                uint32_t drop_reason_count,
-                int32_t *drop_reason_list,
-                sai_attribute_t *drop_reason_attribute) noexcept(false);
+                std::vector<int32_t>& drop_reason_list,
+                sai_attribute_t *drop_reason_attribute) const noexcept(false);
         void updateDropReasonsInSAI() noexcept(false);
 
-        std::unordered_set<std::string> drop_reasons;
+        DropReasonBitmap drop_reasons;
+
+        // The counter index is fixed once the counter is created in the SAI
+        mutable std::string sai_stat;
 
         static const std::unordered_map<std::string, sai_in_drop_reason_t> ingress_drop_reason_lookup;
         static const std::unordered_map<std::string, sai_out_drop_reason_t> egress_drop_reason_lookup;
@@ -0,0 +1,323 @@
+#include "drop_monitor.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <hiredis/hiredis.h>
+
+#include "logger.h"
+#include "rediscommand.h"
+#include "sai_serialize.h"
+#include "schema.h"
+
+using std::shared_ptr;
+using std::string;
+using std::to_string;
+using std::vector;
+using swss::DBConnector;
+using swss::RedisCommand;
+
+static string formatCommand(const vector<string>& args)
+{
+    vector<const char *> argv;
+    vector<size_t> argvlen;
+
+    for (const auto& arg : args)
+    {
+        argv.push_back(arg.c_str());
+        argvlen.push_back(arg.size());
+    }
+
+    RedisCommand cmd;
+    cmd.formatArgv(static_cast<int>(args.size()), argv.data(), argvlen.data());
+
+    return string(cmd.c_str(), cmd.length());
+}
+
+DropMonitor::DropMonitor(shared_ptr<DBConnector> counters_db) :
+        m_countersDb(counters_db)
+{
+}
+
+void DropMonitor::setCounter(const string& counter_name, const string& counter_stat, const DropMonitorConfig& config)
+{
+    SWSS_LOG_ENTER();
+
+    if (!config.enabled)
+    {
+        removeCounter(counter_name);
+        return;
+    }
+
+    auto it = m_monitors.begin();
+    while (it != m_monitors.end() && it->counter_name != counter_name)
+    {
+        it++;
+    }
+
+    if (it != m_monitors.end() && it->counter_stat == counter_stat && it->config == config)
+    {
+        return;
+    }
+
+    if (it == m_monitors.end())
+    {
+        it = m_monitors.emplace(m_monitors.end());
+        it->counter_name = counter_name;
+    }
+
+    it->counter_stat = counter_stat;
+    it->config = config;
+    it->capacity = config.incident_count_threshold + 1;
+    it->last.clear();
+    it->has_last.clear();
+    it->head.clear();
+    it->count.clear();
+    it->incidents.clear();
+    resizePorts(*it);
+
+    m_readCmdsDirty = true;
+    SWSS_LOG_NOTICE("Monitoring persistent drops of counter %s", counter_name.c_str());
+}
+
+void DropMonitor::removeCounter(const string& counter_name)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto it = m_monitors.begin(); it != m_monitors.end(); it++)
+    {
+        if (it->counter_name == counter_name)
+        {
+            m_monitors.erase(it);
+            m_readCmdsDirty = true;
+            SWSS_LOG_NOTICE("Stopped monitoring persistent drops of counter %s", counter_name.c_str());
+            return;
+        }
+    }
+}
+
+void DropMonitor::addPort(const string& alias, sai_object_id_t port_id)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_portIndex.find(alias);
+    if (it != m_portIndex.end())
+    {
+        if (m_ports[it->second].port_id != port_id)
+        {
+            m_ports[it->second].port_id = port_id;
+            m_readCmdsDirty = true;
+        }
+        return;
+    }
+
+    m_portIndex[alias] = m_ports.size();
+    m_ports.push_back({ alias, port_id });
+    for (auto& monitor : m_monitors)
+    {
+        resizePorts(monitor);
+    }
+
+    m_readCmdsDirty = true;
+}
+
+void DropMonitor::removePort(const string& alias)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_portIndex.find(alias);
+    if (it == m_portIndex.end())
+    {
+        return;
+    }
+
+    size_t pos = it->second;
+    size_t back = m_ports.size() - 1;
+    m_portIndex.erase(it);
+
+    // The last port takes the place of the removed one
+    if (pos != back)
+    {
+        m_ports[pos] = m_ports[back];
+        m_portIndex[m_ports[pos].alias] = pos;
+
+        for (auto& monitor : m_monitors)
+        {
+            monitor.last[pos] = monitor.last[back];
+            monitor.has_last[pos] = monitor.has_last[back];
+            monitor.head[pos] = monitor.head[back];
+            monitor.count[pos] = monitor.count[back];
+            std::copy(monitor.incidents.begin() + back * monitor.capacity,
+                      monitor.incidents.begin() + (back + 1) * monitor.capacity,
+                      monitor.incidents.begin() + pos * monitor.capacity);
+        }
+    }
+
+    m_ports.pop_back();
+    for (auto& monitor : m_monitors)
+    {
+        resizePorts(monitor);
+    }
+
+    m_readCmdsDirty = true;
+}
+
+void DropMonitor::resizePorts(Monitor& monitor)
+{
+    size_t ports = m_ports.size();
+
+    monitor.last.resize(ports, 0);
+    monitor.has_last.resize(ports, 0);
+    monitor.head.resize(ports, 0);
+    monitor.count.resize(ports, 0);
+    monitor.incidents.resize(ports * monitor.capacity, 0);
+}
+
+bool DropMonitor::addSample(Monitor& monitor, size_t port, uint64_t drops, uint64_t now)
+{
+    // The first poll of a port only sets its reference count
+    if (!monitor.has_last[port])
+    {
+        monitor.last[port] = drops;
+        monitor.has_last[port] = 1;
+        return false;
+    }
+
+    // Counters cleared since the last poll do not count as drops
+    uint64_t delta = drops >= monitor.last[port] ? drops - monitor.last[port] : 0;
+    monitor.last[port] = drops;
+
+    uint64_t *incidents = monitor.incidents.data() + port * monitor.capacity;
+    uint32_t& head = monitor.head[port];
+    uint32_t& count = monitor.count[port];
+
+    // Incidents outside of the window, the oldest are at the head
+    while (count > 0 && now > incidents[head] + monitor.config.window)
+    {
+        head = static_cast<uint32_t>((head + 1) % monitor.capacity);
+        count--;
+    }
+
+    if (delta > monitor.config.drop_count_threshold)
+    {
+        incidents[(head + count) % monitor.capacity] = now;
+        count++;
+    }
+
+    if (count > monitor.config.incident_count_threshold)
+    {
+        // The incidents are cleared once reported
+        head = 0;
+        count = 0;
+        return true;
+    }
+
+    return false;
+}
+
+bool DropMonitor::readBatch(vector<redisReply *>& replies)
+{
+    if (!m_readDb)
+    {
+        m_readDb.reset(m_countersDb->newConnector(0));
+    }
+
+    redisContext *ctx = m_readDb->getContext();
+
+    for (const auto& cmd : m_readCmds)
+    {
+        if (redisAppendFormattedCommand(ctx, cmd.data(), cmd.size()) != REDIS_OK)
+        {
+            SWSS_LOG_ERROR("Failed to queue drop counters read: %s", ctx->errstr);
+            m_readDb.reset();
+            return false;
+        }
+    }
+
+    replies.assign(m_readCmds.size(), nullptr);
+    for (size_t i = 0; i < m_readCmds.size(); i++)
+    {
+        void *reply = nullptr;
+        if (redisGetReply(ctx, &reply) != REDIS_OK || !reply)
+        {
+            SWSS_LOG_ERROR("Failed to read drop counters: %s", ctx->errstr);
+            for (auto r : replies)
+            {
+                if (r)
+                {
+                    freeReplyObject(r);
+                }
+            }
+            replies.clear();
+            // The connection may still hold replies of the batch
+            m_readDb.reset();
+            return false;
+        }
+        replies[i] = static_cast<redisReply *>(reply);
+    }
+
+    return true;
+}
+
+void DropMonitor::poll(uint64_t now)
+{
+    SWSS_LOG_ENTER();
+
+    if (empty())
+    {
+        return;
+    }
+
+    if (m_readCmdsDirty)
+    {
+        m_readCmds.clear();
+        for (const auto& port : m_ports)
+        {
+            vector<string> args = { "HMGET", string(COUNTERS_TABLE) + ":" + sai_serialize_object_id(port.port_id) };
+            for (const auto& monitor : m_monitors)
+            {
+                args.push_back(monitor.counter_stat);
+            }
+            m_readCmds.push_back(formatCommand(args));
+        }
+        m_readCmdsDirty = false;
+    }
+
+    vector<redisReply *> replies;
+    if (!readBatch(replies))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < m_ports.size(); i++)
+    {
+        const redisReply *reply = replies[i];
+        if (reply->type != REDIS_REPLY_ARRAY || reply->elements != m_monitors.size())
+        {
+            continue;
+        }
+
+        for (size_t j = 0; j < m_monitors.size(); j++)
+        {
+            const redisReply *element = reply->element[j];
+            if (element->type != REDIS_REPLY_STRING)
+            {
+                continue;
+            }
+
+            auto& monitor = m_monitors[j];
+            if (addSample(monitor, i, strtoull(element->str, nullptr, 10), now))
+            {
+                SWSS_LOG_NOTICE("Persistent packet drops detected by counter %s on %s",
+                        monitor.counter_name.c_str(), m_ports[i].alias.c_str());
+                m_countersDb->hset(PERSISTENT_DROP_ALERTS_TABLE,
+                        monitor.counter_name + "|" + to_string(now),
+                        "Persistent packet drops detected on " + m_ports[i].alias);
+            }
+        }
+    }
+
+    for (auto r : replies)
+    {
+        freeReplyObject(r);
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef SWSS_UTIL_DROP_MONITOR_H_
+#define SWSS_UTIL_DROP_MONITOR_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "dbconnector.h"
+
+extern "C" {
+#include "sai.h"
+}
+
+#define PERSISTENT_DROP_ALERTS_TABLE "PERSISTENT_DROP_ALERTS"
+
+// Drop monitor configuration of a drop counter, from its DEBUG_COUNTER entry.
+struct DropMonitorConfig
+{
+    bool enabled = false;
+    uint64_t drop_count_threshold = 0;
+    uint64_t incident_count_threshold = 0;
+    // Seconds
+    uint64_t window = 0;
+
+    bool operator==(const DropMonitorConfig& other) const
+    {
+        return enabled == other.enabled &&
+            drop_count_threshold == other.drop_count_threshold &&
+            incident_count_threshold == other.incident_count_threshold &&
+            window == other.window;
+    }
+};
+
+// DropMonitor detects persistent drops on the ports, the native counterpart
+// of drop_monitor.lua. A poll over more than drop_count_threshold drops is an
+// incident, and more than incident_count_threshold incidents within the
+// window raise an alert in PERSISTENT_DROP_ALERTS.
+//
+// The drop counters of all the ports are read from COUNTERS_DB with one
+// pipelined batch per poll, on a connection of its own so that the replies
+// never mix with the commands of the other users of COUNTERS_DB. The last counts and the incident timestamps of
+// each port are kept in memory, in per counter arrays indexed by port, so
+// COUNTERS_DB is only written when an alert is raised.
+class DropMonitor
+{
+    public:
+        DropMonitor(std::shared_ptr<swss::DBConnector> counters_db);
+
+        // A disabled counter is no longer monitored, a new configuration
+        // restarts the detection of the counter.
+        void setCounter(const std::string& counter_name,
+                        const std::string& counter_stat,
+                        const DropMonitorConfig& config);
+        void removeCounter(const std::string& counter_name);
+
+        void addPort(const std::string& alias, sai_object_id_t port_id);
+        void removePort(const std::string& alias);
+
+        bool empty() const { return m_monitors.empty() || m_ports.empty(); }
+
+        // Reads the drop counters of the ports and raises the alerts, now is
+        // the unix time in seconds.
+        void poll(uint64_t now);
+
+    private:
+        struct Monitor
+        {
+            std::string counter_name;
+            std::string counter_stat;
+            DropMonitorConfig config;
+
+            // The incidents of a port are cleared by the alert they raise, so
+            // there are at most incident_count_threshold + 1 of them.
+            size_t capacity;
+
+            // Indexed by port
+            std::vector<uint64_t> last;
+            std::vector<uint8_t> has_last;
+            std::vector<uint32_t> head;
+            std::vector<uint32_t> count;
+            // Ring of capacity incident timestamps per port
+            std::vector<uint64_t> incidents;
+        };
+
+        struct MonitoredPort
+        {
+            std::string alias;
+            sai_object_id_t port_id;
+        };
+
+        // Feeds a drop count of a port, true when it raises an alert
+        bool addSample(Monitor& monitor, size_t port, uint64_t drops, uint64_t now);
+        void resizePorts(Monitor& monitor);
+        bool readBatch(std::vector<struct redisReply *>& replies);
+
+        std::shared_ptr<swss::DBConnector> m_countersDb;
+        // Connection of the batched reads, dropped after a failed batch so
+        // that none of its replies is left for the next one
+        std::unique_ptr<swss::DBConnector> m_readDb;
+
+        std::vector<Monitor> m_monitors;
+        std::vector<MonitoredPort> m_ports;
+        std::unordered_map<std::string, size_t> m_portIndex;
+
+        // Preformatted HMGET of the monitored counters of each port, rebuilt
+        // on the next poll when counters or ports change
+        std::vector<std::string> m_readCmds;
+        bool m_readCmdsDirty = true;
+};
+
+#endif // SWSS_UTIL_DROP_MONITOR_H_
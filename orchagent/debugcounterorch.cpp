@@ -4,6 +4,8 @@
 #include "sai_serialize.h"
 #include "schema.h"
 #include "drop_counter.h"
+#include <ctime>
+#include <cstdlib>
 #include <memory>
 #include "observer.h"
 
@@ -38,25 +40,18 @@ DebugCounterOrch::DebugCounterOrch(DBConnector *db, const vector<string>& table_
 
     gPortsOrch->attach(this);
 
-    // Add drop monitor lua script
-    string dropMonitorPluginName = "drop_monitor.lua";
-    string dropMonitorSha;
-
-    try
-    {
-        string dropMonitorLuaScript = swss::loadLuaScript(dropMonitorPluginName);
-        dropMonitorSha = swss::loadRedisScript(m_countersDb.get(), dropMonitorLuaScript);
-    }
-    catch (const runtime_error &e)
-    {
-        SWSS_LOG_ERROR("Drop monitor flex counter group was not set successfully: %s", e.what());
-    }
-
+    // The drop counters polled by this group are evaluated by the drop
+    // monitor on its own timer, at the same interval
     setFlexCounterGroupParameter(DEBUG_DROP_MONITOR_FLEX_COUNTER_GROUP,
                              DEBUG_DROP_MONITOR_FLEX_COUNTER_POLLING_INTERVAL_MS,
-                             STATS_MODE_READ,
-                             PORT_PLUGIN_FIELD,
-                             dropMonitorSha);
+                             STATS_MODE_READ);
+
+    drop_monitor.reset(new DropMonitor(m_countersDb));
+
+    int interval = std::stoi(DEBUG_DROP_MONITOR_FLEX_COUNTER_POLLING_INTERVAL_MS);
+    auto interv = timespec { .tv_sec = interval / 1000, .tv_nsec = (interval % 1000) * 1000000 };
+    drop_monitor_timer = new SelectableTimer(interv);
+    Orch::addExecutor(new ExecutableTimer(drop_monitor_timer, this, "DEBUG_DROP_MONITOR_POLL"));
 }
 
 DebugCounterOrch::~DebugCounterOrch(void)
@@ -79,6 +74,18 @@ void DebugCounterOrch::update(SubjectType type, void *cntx)
         PortUpdate *update = static_cast<PortUpdate *>(cntx);
         Port &port = update->port;
 
+        if (port.m_type == Port::Type::PHY)
+        {
+            if (update->add)
+            {
+                drop_monitor->addPort(port.m_alias, port.m_port_id);
+            }
+            else
+            {
+                drop_monitor->removePort(port.m_alias);
+            }
+        }
+
         if (update->add) 
         {
             for (const auto& debug_counter: debug_counters)
@@ -124,6 +131,9 @@ void DebugCounterOrch::update(SubjectType type, void *cntx)
 //  It is guaranteed that failed updates will not modify the state of the
 //  system.
 //
+// Drop reason updates to existing counters are coalesced, so that each counter
+// is reprogrammed in the SAI at most once per batch.
+//
 // In addition, updates are idempotent - repeating the same request any number
 // of times will always result in the same external behavior.
 void DebugCounterOrch::doTask(Consumer& consumer)
@@ -161,9 +171,19 @@ void DebugCounterOrch::doTask(Consumer& consumer)
                     SWSS_LOG_ERROR("Failed to create debug counter '%s'", key.c_str());
                     task_status = task_process_status::task_failed;
                 }
+
+                // The monitor fields can be updated on an existing counter
+                if (task_status == task_process_status::task_success)
+                {
+                    drop_monitor_configs[key] = parseDropMonitorConfig(values);
+                    updateDropMonitor(key);
+                }
             }
             else if (op == DEL_COMMAND)
             {
+                drop_monitor_configs.erase(key);
+                drop_monitor->removeCounter(key);
+
                 try
                 {
                     task_status = uninstallDebugCounter(key);
@@ -231,7 +251,6 @@ void DebugCounterOrch::doTask(Consumer& consumer)
                             {
                                 if (config_value == "enabled")
                                 {
-                                    debug_monitor_enabled = true;
                                     string monitored_debug_counter_stat = counterIdsToStr(portDebugMonitorStatIds);
                                     SWSS_LOG_DEBUG("Enabling debug drop monitor: %s", monitored_debug_counter_stat.c_str());
                                     setFlexCounterGroupOperation(DEBUG_DROP_MONITOR_FLEX_COUNTER_GROUP, "enable");
@@ -240,9 +259,19 @@ void DebugCounterOrch::doTask(Consumer& consumer)
                                         string key = string(DEBUG_DROP_MONITOR_FLEX_COUNTER_GROUP) + ":" + sai_serialize_object_id(curr.second.m_port_id);
                                         startFlexCounterPolling(gSwitchId, key, monitored_debug_counter_stat, PORT_COUNTER_ID_LIST);
                                     }
+                                    if (!debug_monitor_enabled)
+                                    {
+                                        setDropMonitorPorts();
+                                        drop_monitor_timer->start();
+                                    }
+                                    debug_monitor_enabled = true;
                                 }
                                 else if (config_value == "disabled")
                                 {
+                                    if (debug_monitor_enabled)
+                                    {
+                                        drop_monitor_timer->stop();
+                                    }
                                     debug_monitor_enabled = false;
                                     SWSS_LOG_DEBUG("Disabling debug drop monitor");
                                     setFlexCounterGroupOperation(DEBUG_DROP_MONITOR_FLEX_COUNTER_GROUP, "disable");
@@ -305,6 +334,8 @@ void DebugCounterOrch::doTask(Consumer& consumer)
                 break;
         }
     }
+
+    flushPendingDropReasons();
 }
 
 // Debug Capability Reporting Functions START HERE -------------------------------------------------
@@ -467,7 +498,14 @@ task_process_status DebugCounterOrch::addDropReason(const string& counter_name,
     }
 
     DropCounter *counter = dynamic_cast<DropCounter*>(it->second.get());
-    counter->addDropReason(drop_reason);
+    size_t index;
+    if (!counter->getDropReasonIndex(drop_reason, &index))
+    {
+        SWSS_LOG_ERROR("Drop reason '%s' does not apply to counter '%s'", drop_reason.c_str(), counter_name.c_str());
+        return task_process_status::task_failed;
+    }
+
+    getPendingDropReasons(counter_name, counter).set(index);
 
     SWSS_LOG_NOTICE("Added drop reason %s to drop counter %s", drop_reason.c_str(), counter_name.c_str());
     return task_process_status::task_success;
@@ -492,20 +530,65 @@ task_process_status DebugCounterOrch::removeDropReason(const string& counter_nam
     }
 
     DropCounter *counter = dynamic_cast<DropCounter*>(it->second.get());
-    const unordered_set<string>& drop_reasons = counter->getDropReasons();
+    DropReasonBitmap& drop_reasons = getPendingDropReasons(counter_name, counter);
 
-    if (drop_reasons.size() <= 1)
+    if (drop_reasons.count() <= 1)
     {
         SWSS_LOG_WARN("Attempted to remove all drop reasons from counter '%s'", counter_name.c_str());
         return task_ignore;
     }
 
-    counter->removeDropReason(drop_reason);
+    size_t index;
+    if (counter->getDropReasonIndex(drop_reason, &index))
+    {
+        drop_reasons.reset(index);
+    }
 
     SWSS_LOG_NOTICE("Removed drop reason %s from drop counter %s", drop_reason.c_str(), counter_name.c_str());
     return task_success;
 }
 
+// getPendingDropReasons returns the drop reasons of the counter as updated by
+// the current batch, starting from the reasons programmed in the SAI.
+DropReasonBitmap& DebugCounterOrch::getPendingDropReasons(const string& counter_name, DropCounter *counter)
+{
+    auto pending_it = pending_drop_reasons.find(counter_name);
+    if (pending_it == pending_drop_reasons.end())
+    {
+        pending_it = pending_drop_reasons.emplace(counter_name, counter->getDropReasons()).first;
+    }
+
+    return pending_it->second;
+}
+
+// flushPendingDropReasons programs the drop reasons updated by the current
+// batch with one SAI update per counter.
+void DebugCounterOrch::flushPendingDropReasons()
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto& pending: pending_drop_reasons)
+    {
+        auto it = debug_counters.find(pending.first);
+        if (it == debug_counters.end())
+        {
+            continue;
+        }
+
+        DropCounter *counter = dynamic_cast<DropCounter*>(it->second.get());
+        try
+        {
+            counter->setDropReasons(pending.second);
+        }
+        catch (const std::runtime_error& e)
+        {
+            SWSS_LOG_ERROR("Failed to update drop reasons of counter '%s'", pending.first.c_str());
+        }
+    }
+
+    pending_drop_reasons.clear();
+}
+
 // Free Table Management Functions START HERE ------------------------------------------------------
 
 // Note that entries will remain in the table until at least one drop reason is added to the counter.
@@ -670,9 +753,6 @@ void DebugCounterOrch::uninstallDebugFlexCounters(const string& counter_type,
     string monitored_debug_counter_stat = counterIdsToStr(portDebugMonitorStatIds);
     SWSS_LOG_DEBUG("Removed %s from: %s", counter_stat.c_str(), monitored_debug_counter_stat.c_str());
 
-    // Make a vector of keys to delete from COUNTERS_DB, these keys are used by drop counter monitor
-    std::vector<std::string> debug_drop_monitor_stats_fields;
-
     if (flex_counter_type == CounterType::SWITCH_DEBUG)
     {
         flex_counter_manager.removeFlexCounterStat(gSwitchId, flex_counter_type, counter_stat);
@@ -703,8 +783,6 @@ void DebugCounterOrch::uninstallDebugFlexCounters(const string& counter_type,
                 flex_counter_type,
                 counter_stat);
 
-            debug_drop_monitor_stats_fields.push_back("DEBUG_DROP_MONITOR_STATS|" + counter_name + "|" + curr.first);
-
             if (debug_monitor_enabled)
             {
                 string key = string(DEBUG_DROP_MONITOR_FLEX_COUNTER_GROUP) + ":" + sai_serialize_object_id(curr.second.m_port_id);
@@ -713,9 +791,6 @@ void DebugCounterOrch::uninstallDebugFlexCounters(const string& counter_type,
             }
         }
     }
-
-    // Delete DEBUG_DROP_MONITOR_STATS for this debug counter
-    m_countersDb->del(debug_drop_monitor_stats_fields);
 }
 
 // Debug Counter Initialization Helper Functions START HERE ----------------------------------------
@@ -731,7 +806,7 @@ std::string DebugCounterOrch::getDebugCounterType(const vector<FieldValueTuple>&
     for (auto attr : values)
     {
         std::string attr_name = fvField(attr);
-        auto supported_debug_counter_attributes = DebugCounter::getSupportedDebugCounterAttributes();
+        const auto& supported_debug_counter_attributes = DebugCounter::getSupportedDebugCounterAttributes();
         auto attr_name_it = supported_debug_counter_attributes.find(attr_name);
         if (attr_name_it == supported_debug_counter_attributes.end())
         {
@@ -742,7 +817,7 @@ std::string DebugCounterOrch::getDebugCounterType(const vector<FieldValueTuple>&
         std::string attr_value = fvValue(attr);
         if (attr_name == "type")
         {
-            auto debug_counter_type_lookup = DebugCounter::getDebugCounterTypeLookup();
+            const auto& debug_counter_type_lookup = DebugCounter::getDebugCounterTypeLookup();
             auto counter_type_it = debug_counter_type_lookup.find(attr_value);
             if (counter_type_it == debug_counter_type_lookup.end())
             {
@@ -777,6 +852,8 @@ void DebugCounterOrch::createDropCounter(const string& counter_name, const strin
     {
         m_counterNameToSwitchStatMap->set("", { FieldValueTuple(counter_name, counter_stat) });
     }
+
+    updateDropMonitor(counter_name);
 }
 
 bool DebugCounterOrch::getDebugMonitorStatus()
@@ -784,6 +861,106 @@ bool DebugCounterOrch::getDebugMonitorStatus()
     return debug_monitor_enabled;
 }
 
+// Drop Monitor Helper Functions START HERE --------------------------------------------------------
+
+void DebugCounterOrch::doTask(SelectableTimer& timer)
+{
+    SWSS_LOG_ENTER();
+
+    if (&timer != drop_monitor_timer || !debug_monitor_enabled)
+    {
+        return;
+    }
+
+    drop_monitor->poll(static_cast<uint64_t>(time(nullptr)));
+}
+
+void DebugCounterOrch::setDropMonitorPollInterval(const string& msecs)
+{
+    SWSS_LOG_ENTER();
+
+    int interval = atoi(msecs.c_str());
+    if (interval <= 0)
+    {
+        SWSS_LOG_ERROR("Invalid drop monitor poll interval %s", msecs.c_str());
+        return;
+    }
+
+    auto interv = timespec { .tv_sec = interval / 1000, .tv_nsec = (interval % 1000) * 1000000 };
+    drop_monitor_timer->setInterval(interv);
+    if (debug_monitor_enabled)
+    {
+        drop_monitor_timer->reset();
+    }
+}
+
+// parseDropMonitorConfig reads the drop monitor fields of a DEBUG_COUNTER
+// entry, missing or malformed thresholds are 0 as they were for drop_monitor.lua.
+DropMonitorConfig DebugCounterOrch::parseDropMonitorConfig(const vector<FieldValueTuple>& values) const
+{
+    DropMonitorConfig config;
+
+    for (const auto& value : values)
+    {
+        const auto& field = fvField(value);
+        const char *str = fvValue(value).c_str();
+
+        if (field == DROP_MONITOR_STATUS)
+        {
+            config.enabled = fvValue(value) == "enabled";
+        }
+        else if (field == DROP_MONITOR_DROP_COUNT_THRESHOLD)
+        {
+            config.drop_count_threshold = strtoull(str, nullptr, 10);
+        }
+        else if (field == DROP_MONITOR_INCIDENT_COUNT_THRESHOLD)
+        {
+            config.incident_count_threshold = strtoull(str, nullptr, 10);
+        }
+        else if (field == DROP_MONITOR_WINDOW)
+        {
+            config.window = strtoull(str, nullptr, 10);
+        }
+    }
+
+    return config;
+}
+
+// updateDropMonitor hands a port drop counter to the drop monitor once both
+// the counter and its configuration are known.
+void DebugCounterOrch::updateDropMonitor(const string& counter_name)
+{
+    SWSS_LOG_ENTER();
+
+    auto config_it = drop_monitor_configs.find(counter_name);
+    auto counter_it = debug_counters.find(counter_name);
+    if (config_it == drop_monitor_configs.end() || counter_it == debug_counters.end())
+    {
+        return;
+    }
+
+    DebugCounter *counter = counter_it->second.get();
+    if (getFlexCounterType(counter->getCounterType()) != CounterType::PORT_DEBUG)
+    {
+        return;
+    }
+
+    drop_monitor->setCounter(counter_name, counter->getDebugCounterSAIStat(), config_it->second);
+}
+
+void DebugCounterOrch::setDropMonitorPorts()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto const &curr : gPortsOrch->getAllPorts())
+    {
+        if (curr.second.m_type == Port::Type::PHY)
+        {
+            drop_monitor->addPort(curr.first, curr.second.m_port_id);
+        }
+    }
+}
+
 // Debug Counter Configuration Helper Functions START HERE -----------------------------------------
 
 // parseDropReasonUpdate takes a key from CONFIG_DB and returns the 1) the counter name being targeted and
@@ -10,7 +10,9 @@
 #include "flex_counter_stat_manager.h"
 #include "debug_counter.h"
 #include "drop_counter.h"
+#include "drop_monitor.h"
 #include "observer.h"
+#include "timer.h"
 
 extern "C" {
 #include "sai.h"
@@ -31,10 +33,14 @@ public:
     virtual ~DebugCounterOrch(void);
 
     void doTask(Consumer& consumer);
+    void doTask(swss::SelectableTimer& timer);
 
     void update(SubjectType, void *cntx);
 
     bool getDebugMonitorStatus();
+
+    // Follows the POLL_INTERVAL of the DEBUG_MONITOR_COUNTER flex counter group
+    void setDropMonitorPollInterval(const std::string& msecs);
 private:
     // Debug Capability Reporting Functions
     void publishDropCounterCapabilities();
@@ -44,6 +50,8 @@ private:
     task_process_status uninstallDebugCounter(const std::string& counter_name);
     task_process_status addDropReason(const std::string& counter_name, const std::string& drop_reason);
     task_process_status removeDropReason(const std::string& counter_name, const std::string& drop_reason);
+    DropReasonBitmap& getPendingDropReasons(const std::string& counter_name, DropCounter *counter);
+    void flushPendingDropReasons();
 
     // Free Table Management Functions
     void addFreeCounter(const std::string& counter_name, const std::string& counter_type);
@@ -81,6 +89,11 @@ private:
     bool isDropReasonValid(const std::string& drop_reason) const;
     std::string counterIdsToStr(const std::unordered_set<std::string>& ids) const;
 
+    // Drop Monitor Helper Functions
+    DropMonitorConfig parseDropMonitorConfig(const std::vector<swss::FieldValueTuple>& values) const;
+    void updateDropMonitor(const std::string& counter_name);
+    void setDropMonitorPorts();
+
     // Data Members
     std::shared_ptr<swss::DBConnector> m_stateDb = nullptr;
     std::shared_ptr<swss::Table> m_debugCapabilitiesTable = nullptr;
@@ -102,6 +115,12 @@ private:
     bool debug_monitor_enabled = false;
     std::unordered_set<std::string> portDebugMonitorStatIds;
 
+    // The drop monitor polls the drop counters on its timer while enabled,
+    // drop_monitor_configs holds the monitor fields of the DEBUG_COUNTER entries.
+    std::unique_ptr<DropMonitor> drop_monitor;
+    swss::SelectableTimer *drop_monitor_timer = nullptr;
+    std::unordered_map<std::string, DropMonitorConfig> drop_monitor_configs;
+
     // free_drop_counters are drop counters that have been created by a user
     // that do not have any drop reasons associated with them yet. Because
     // we cannot create a drop counter without any drop reasons, we keep track
@@ -113,6 +132,11 @@ private:
     // cannot add drop reasons to a counter that doesn't exist yet,
     // we keep track of the reasons in this table.
     std::unordered_map<std::string, std::unordered_set<std::string>> free_drop_reasons;
+
+    // pending_drop_reasons are the drop reasons of existing counters as
+    // updated by the current doTask batch. Each counter is reprogrammed once
+    // at the end of the batch instead of once per drop reason.
+    std::unordered_map<std::string, DropReasonBitmap> pending_drop_reasons;
 };
 
 #endif
@@ -15,6 +15,7 @@ extern sai_switch_api_t* sai_switch_api;
 extern sai_dtel_api_t* sai_dtel_api;
 extern sai_object_id_t gVirtualRouterId;
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 extern Directory<Orch*> gDirectory;
 
 dtelEventLookup_t dTelEventLookup =
@@ -29,11 +30,14 @@ dtelEventLookup_t dTelEventLookup =
 
 DTelOrch::DTelOrch(DBConnector *db, vector<string> tableNames, PortsOrch *portOrch) :
         Orch(db, tableNames),
-        m_portOrch(portOrch)
+        m_portOrch(portOrch),
+        m_queueReportBulker(sai_dtel_api, gSwitchId, gMaxBulkSize, SAI_OBJECT_TYPE_DTEL_QUEUE_REPORT)
 {
     SWSS_LOG_ENTER();
     sai_attribute_t attr;
 
+    m_queueReportBulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+
     sai_status_t status = sai_dtel_api->create_dtel(&dtelId, gSwitchId, 0, {});
     if (status != SAI_STATUS_SUCCESS)
     {
@@ -277,8 +281,7 @@ bool DTelOrch::addPortQueue(const string& port, const string& queue, DTelQueueRe
         return false;
     }
 
-    m_dTelPortTable[port] = DTelPortEntry();
-    m_dTelPortTable[port].queueTable[queue] = DTelQueueReportEntry();
+    // The other queues of the port are kept, creations may be queued for them
     *qreport = &m_dTelPortTable[port].queueTable[queue];
     return true;
 }
@@ -452,50 +455,38 @@ void DTelOrch::update(SubjectType type, void *cntx)
         return;
     }
 
-    dTelPortQueueTable_t qTable = port_entry_iter->second.queueTable;
+    if (update->add && update->port.m_type != Port::PHY)
+    {
+        SWSS_LOG_ERROR("DTEL ERROR: Queue reporting applies only to physical ports. %s is not a physical port", update->port.m_alias.c_str());
+        return;
+    }
 
-    for (auto it = qTable.begin(); it != qTable.end(); it++ )
+    /* The queue reports of all the queues of the port go in one bulk */
+    for (auto& it : port_entry_iter->second.queueTable)
     {
-        DTelQueueReportEntry qreport = it->second;
+        DTelQueueReportEntry& qreport = it.second;
         if (update->add)
         {
             if (qreport.queueReportOid != 0)
             {
                 SWSS_LOG_ERROR("DTEL ERROR: Queue report already enabled for port %s, queue %d", update->port.m_alias.c_str(), qreport.q_ind);
-                return;
-            }
-
-            if (update->port.m_type != Port::PHY)
-            {
-                SWSS_LOG_ERROR("DTEL ERROR: Queue reporting applies only to physical ports. %s is not a physical port", update->port.m_alias.c_str());
-                return;
+                continue;
             }
 
             qreport.queueOid = update->port.m_queue_ids[qreport.q_ind];
-
-            status = enableQueueReport(update->port.m_alias, qreport);
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("DTEL ERROR: Failed to update queue report for queue %d on port add %s", qreport.q_ind, update->port.m_alias.c_str());
-                return;
-            }
+            queueEnableQueueReport(update->port.m_alias, it.first, qreport);
         } else {
             if (qreport.queueReportOid == 0)
             {
                 SWSS_LOG_ERROR("DTEL ERROR: Queue report already disabled for port %s, queue %d", update->port.m_alias.c_str(), qreport.q_ind);
-                return;
+                continue;
             }
 
-            status = disableQueueReport(update->port.m_alias, it->first);
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("DTEL ERROR: Failed to update queue report for queue %d on port remove %s", qreport.q_ind, update->port.m_alias.c_str());
-                return;
-            }
-
-            qreport.queueOid = 0;
+            queueDisableQueueReport(update->port.m_alias, it.first, false);
         }
     }
+
+    flushQueueReports();
 }
 
 void DTelOrch::doDtelTableTask(Consumer &consumer)
@@ -1423,46 +1414,144 @@ bool DTelOrch::disableQueueReport(const string &port, const string &queue)
     return true;
 }
 
-sai_status_t DTelOrch::enableQueueReport(const string& port, DTelQueueReportEntry& qreport)
+vector<sai_attribute_t> DTelOrch::getQueueReportAttrs(const DTelQueueReportEntry& qreport)
 {
+    vector<sai_attribute_t> attrs = qreport.queue_report_attr;
     sai_attribute_t qr_attr;
-    sai_status_t status = SAI_STATUS_SUCCESS;
 
+    qr_attr.id = SAI_DTEL_QUEUE_REPORT_ATTR_QUEUE_ID;
+    qr_attr.value.oid = qreport.queueOid;
+    attrs.push_back(qr_attr);
+
+    return attrs;
+}
+
+bool DTelOrch::isQueueReportPending(const string& port, const string& queue)
+{
+    return m_pendingQueueReports.find(port + "|" + queue) != m_pendingQueueReports.end();
+}
+
+void DTelOrch::queueEnableQueueReport(const string& port, const string& queue, DTelQueueReportEntry& qreport)
+{
+    SWSS_LOG_ENTER();
+
+    /* Created once the queue exists */
     if (qreport.queueOid == 0)
     {
         qreport.queueReportOid = 0;
-        return status;
+        return;
     }
 
-    qr_attr.id = SAI_DTEL_QUEUE_REPORT_ATTR_QUEUE_ID;
-    qr_attr.value.oid = qreport.queueOid;
-    qreport.queue_report_attr.push_back(qr_attr);
+    vector<sai_attribute_t> attrs = getQueueReportAttrs(qreport);
 
-    status = sai_dtel_api->create_dtel_queue_report(&qreport.queueReportOid,
-                gSwitchId, (uint32_t)qreport.queue_report_attr.size(), qreport.queue_report_attr.data());
-    if (status != SAI_STATUS_SUCCESS)
+    m_queueReportRequests.push_back({ port, queue, false, false, SAI_NULL_OBJECT_ID, SAI_STATUS_NOT_EXECUTED });
+    m_queueReportBulker.create_entry(&qreport.queueReportOid, &m_queueReportRequests.back().status,
+                                     (uint32_t)attrs.size(), attrs.data());
+    m_pendingQueueReports.insert(port + "|" + queue);
+}
+
+void DTelOrch::queueDisableQueueReport(const string& port, const string& queue, bool erase)
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_id_t queue_report_oid = m_dTelPortTable[port].queueTable[queue].queueReportOid;
+
+    if (queue_report_oid == 0)
     {
-        SWSS_LOG_ERROR("DTEL ERROR: Failed to enable queue report on port %s, queue %d", port.c_str(), qreport.q_ind);
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_DTEL, status);
-        if (handle_status != task_success)
+        if (erase)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            removePortQueue(port, queue);
         }
+        return;
     }
 
-    return status;
+    m_queueReportRequests.push_back({ port, queue, true, erase, queue_report_oid, SAI_STATUS_NOT_EXECUTED });
+    m_queueReportBulker.remove_entry(&m_queueReportRequests.back().status, queue_report_oid);
+    m_pendingQueueReports.insert(port + "|" + queue);
 }
 
-void DTelOrch::doDtelQueueReportTableTask(Consumer &consumer)
+/*
+ * Runs the queued queue report removals and creations in one bulk call each,
+ * the ones the SAI cannot bulk are done one by one
+ */
+void DTelOrch::flushQueueReports()
 {
     SWSS_LOG_ENTER();
 
-    sai_status_t status;
+    if (m_queueReportRequests.empty())
+    {
+        return;
+    }
+
+    m_queueReportBulker.flush();
+
+    for (auto& request : m_queueReportRequests)
+    {
+        DTelQueueReportEntry& qreport = m_dTelPortTable[request.port].queueTable[request.queue];
+
+        if (request.remove)
+        {
+            if (is_bulk_unsupported(request.status))
+            {
+                request.status = sai_dtel_api->remove_dtel_queue_report(request.oid);
+            }
+
+            if (request.status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("DTEL ERROR: Failed to disable queue report for port %s, queue %s",
+                        request.port.c_str(), request.queue.c_str());
+                task_process_status handle_status = handleSaiRemoveStatus(SAI_API_DTEL, request.status);
+                if (handle_status != task_success)
+                {
+                    parseHandleSaiStatusFailure(handle_status);
+                }
+                continue;
+            }
+
+            if (request.erase)
+            {
+                removePortQueue(request.port, request.queue);
+            }
+            else
+            {
+                qreport.queueReportOid = 0;
+                qreport.queueOid = 0;
+            }
+        }
+        else
+        {
+            if (is_bulk_unsupported(request.status))
+            {
+                vector<sai_attribute_t> attrs = getQueueReportAttrs(qreport);
+                request.status = sai_dtel_api->create_dtel_queue_report(&qreport.queueReportOid,
+                        gSwitchId, (uint32_t)attrs.size(), attrs.data());
+            }
+
+            if (request.status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("DTEL ERROR: Failed to enable queue report on port %s, queue %d",
+                        request.port.c_str(), qreport.q_ind);
+                task_process_status handle_status = handleSaiCreateStatus(SAI_API_DTEL, request.status);
+                if (handle_status != task_success)
+                {
+                    parseHandleSaiStatusFailure(handle_status);
+                }
+            }
+        }
+    }
+
+    m_queueReportRequests.clear();
+    m_pendingQueueReports.clear();
+}
+
+void DTelOrch::doDtelQueueReportTableTask(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
 
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        const KeyOpFieldsValuesTuple &t = it->second;
         string key = kfvKey(t);
         size_t found = key.find('|');
         string port = key.substr(0, found);
@@ -1471,6 +1560,12 @@ void DTelOrch::doDtelQueueReportTableTask(Consumer &consumer)
         uint32_t q_ind = stoi(queue_id);
         string op = kfvOp(t);
 
+        /* The queue report is settled before it is configured again */
+        if (isQueueReportPending(port, queue_id))
+        {
+            flushQueueReports();
+        }
+
         if (op == SET_COMMAND)
         {
             vector<sai_attribute_t> queue_report_attr;
@@ -1540,28 +1635,24 @@ void DTelOrch::doDtelQueueReportTableTask(Consumer &consumer)
                 qreport->queueOid = 0;
             }
 
-            status = enableQueueReport(port, *qreport);
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                goto queue_report_table_continue;
-            }
+            queueEnableQueueReport(port, queue_id, *qreport);
         }
         else if (op == DEL_COMMAND)
         {
-            if (!disableQueueReport(port, queue_id))
+            if (!isQueueReportEnabled(port, queue_id))
             {
+                SWSS_LOG_ERROR("DTEL ERROR: queue report not enabled for port %s, queue %s", port.c_str(), queue_id.c_str());
                 goto queue_report_table_continue;
             }
 
-            if (!removePortQueue(port, queue_id))
-            {
-                goto queue_report_table_continue;
-            }
+            queueDisableQueueReport(port, queue_id, true);
         }
 
 queue_report_table_continue:
         it = consumer.m_toSync.erase(it);
     }
+
+    flushQueueReports();
 }
 
 bool DTelOrch::unConfigureEvent(string &event)
@@ -4,8 +4,11 @@
 #include "orch.h"
 #include "producerstatetable.h"
 #include "portsorch.h"
+#include "bulker.h"
 
+#include <deque>
 #include <map>
+#include <set>
 #include <inttypes.h>
 
 #define INT_ENDPOINT                   "INT_ENDPOINT"
@@ -88,6 +91,21 @@ struct DTelQueueReportEntry
 
 typedef map<string, DTelQueueReportEntry> dTelPortQueueTable_t;
 
+/*
+ * Queue report creation or removal queued in the bulker of DTelOrch, see
+ * DTelOrch::flushQueueReports()
+ */
+struct DTelQueueReportRequest
+{
+    string port;
+    string queue;
+    bool remove;
+    // Removal of a deleted queue report, its entry goes with it
+    bool erase;
+    sai_object_id_t oid;
+    sai_status_t status;
+};
+
 struct DTelPortEntry
 {
     dTelPortQueueTable_t queueTable;
@@ -161,7 +179,11 @@ private:
     sai_status_t updateSinkPortList();
     bool addSinkPortToCache(const Port& port);
     bool removeSinkPortFromCache(const string& port_alias);
-    sai_status_t enableQueueReport(const string& port, DTelQueueReportEntry& qreport);
+    vector<sai_attribute_t> getQueueReportAttrs(const DTelQueueReportEntry& qreport);
+    void queueEnableQueueReport(const string& port, const string& queue, DTelQueueReportEntry& qreport);
+    void queueDisableQueueReport(const string& port, const string& queue, bool erase);
+    bool isQueueReportPending(const string& port, const string& queue);
+    void flushQueueReports();
 
     PortsOrch *m_portOrch;
     dTelINTSessionTable_t m_dTelINTSessionTable;
@@ -170,6 +192,15 @@ private:
     dtelEventTable_t m_dtelEventTable;
     sai_object_id_t dtelId;
     dtelSinkPortList_t sinkPortList;
+
+    /*
+     * The queue reports of a processing round, or of all the queues of a port
+     * coming or going, are created and removed with one bulk call
+     */
+    ObjectBulker<sai_dtel_api_t> m_queueReportBulker;
+    // The statuses of the requests are written by the bulker, deque keeps them in place
+    deque<DTelQueueReportRequest> m_queueReportRequests;
+    set<string> m_pendingQueueReports;
 };
 
 #endif /* SWSS_DTELORCH_H */
@@ -1,30 +1,17 @@
 -- KEYS - None
--- ARGV - None
-
-local state_db = "6"
-local config_db = "4"
+-- ARGV - severity and max_events pairs, of the severities to check
 
 local result = {}
 
-redis.call('SELECT', config_db)
-local severity_keys = redis.call('KEYS', 'SUPPRESS_ASIC_SDK_HEALTH_EVENT*')
-if #severity_keys == 0 then
-    return result
-end
-
 local max_events = {}
-for i = 1, #severity_keys, 1 do
-    local max_event = redis.call('HGET', severity_keys[i], 'max_events')
-    if max_event then
-        max_events[string.sub(severity_keys[i], 32, -1)] = tonumber(max_event)
-    end
+for i = 1, #ARGV - 1, 2 do
+    max_events[ARGV[i]] = tonumber(ARGV[i + 1])
 end
 
 if not next (max_events) then
     return result
 end
 
-redis.call('SELECT', state_db)
 local events = {}
 
 local event_keys = redis.call('KEYS', 'ASIC_SDK_HEALTH_EVENT_TABLE*')
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Log-linear (HDR style) histogram.
+ *
+ * Values below 2^SUB_BUCKET_BITS are counted exactly, larger values fall
+ * into one of 2^SUB_BUCKET_BITS linear sub-buckets of their power of two
+ * magnitude, which bounds the relative error to 1 / 2^SUB_BUCKET_BITS.
+ * Recording is a handful of integer instructions and a relaxed atomic add,
+ * so it is cheap enough to be left enabled on the hot path.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 2;
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS;
+    static constexpr uint32_t BUCKET_COUNT = SUB_BUCKET_COUNT + (64 - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT;
+
+    LatencyHistogram()
+    {
+        reset();
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    static uint32_t bucketIndex(uint64_t value)
+    {
+        if (value < SUB_BUCKET_COUNT)
+        {
+            return static_cast<uint32_t>(value);
+        }
+
+        uint32_t magnitude = 63 - static_cast<uint32_t>(__builtin_clzll(value));
+        uint32_t shift = magnitude - SUB_BUCKET_BITS;
+        uint32_t sub = static_cast<uint32_t>((value >> shift) & (SUB_BUCKET_COUNT - 1));
+
+        return SUB_BUCKET_COUNT + shift * SUB_BUCKET_COUNT + sub;
+    }
+
+    /* Highest value that maps to the given bucket */
+    static uint64_t bucketUpperBound(uint32_t index)
+    {
+        if (index < SUB_BUCKET_COUNT)
+        {
+            return index;
+        }
+
+        uint32_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+        uint64_t sub = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+        uint64_t low = (SUB_BUCKET_COUNT | sub) << shift;
+
+        return low + ((uint64_t(1) << shift) - 1);
+    }
+
+    void record(uint64_t value)
+    {
+        m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t max = m_max.load(std::memory_order_relaxed);
+        while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return m_sum.load(std::memory_order_relaxed); }
+    uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+
+    /*
+     * Return the upper bound of the bucket holding the given percentile,
+     * percentile is in range [0, 100]. Returns 0 for an empty histogram.
+     */
+    uint64_t percentile(double pct) const
+    {
+        uint64_t total = count();
+        if (total == 0)
+        {
+            return 0;
+        }
+
+        uint64_t rank = static_cast<uint64_t>((pct / 100.0) * static_cast<double>(total) + 0.5);
+        if (rank == 0)
+        {
+            rank = 1;
+        }
+
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            seen += m_buckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank)
+            {
+                uint64_t bound = bucketUpperBound(i);
+                return bound < max() ? bound : max();
+            }
+        }
+
+        return max();
+    }
+
+    void reset()
+    {
+        for (auto &b : m_buckets)
+        {
+            b.store(0, std::memory_order_relaxed);
+        }
+        m_count.store(0, std::memory_order_relaxed);
+        m_sum.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_buckets;
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_max;
+};
+
+/*
+ * Per executor statistics:
+ *  popBatch   - number of entries returned by a single pops() call
+ *  toSyncDepth - m_toSync size after new entries have been merged
+ *  doTaskUsec - wall time spent in Orch::doTask(Consumer&) in microseconds
+ *  waitUsec   - time pending entries waited for the next drain in microseconds
+ *  retryWaitUsec - time failed tasks spent in the retry cache before being woken up
+ */
+struct ExecutorStats
+{
+    LatencyHistogram popBatch;
+    LatencyHistogram toSyncDepth;
+    LatencyHistogram doTaskUsec;
+    LatencyHistogram waitUsec;
+    LatencyHistogram retryWaitUsec;
+
+    /* Totals since the start of orchagent, histograms are reset per publish interval */
+    std::atomic<uint64_t> totalPops{0};
+    /* Entries returned by all the pops() calls */
+    std::atomic<uint64_t> totalPopEntries{0};
+    std::atomic<uint64_t> totalDoTasks{0};
+    std::atomic<uint64_t> totalDoTaskUsec{0};
+
+    /* Drains that yielded at the end of their time slice */
+    std::atomic<uint64_t> totalSliceExpired{0};
+    /* Scheduling rounds that ran out of budget while the executor had pending entries */
+    std::atomic<uint64_t> totalDeferred{0};
+
+    /* Retry cache: tasks parked, woken up by a resolved constraint, and evicted by a newer task */
+    std::atomic<uint64_t> totalRetryCached{0};
+    std::atomic<uint64_t> totalRetryWoken{0};
+    std::atomic<uint64_t> totalRetryEvicted{0};
+    std::atomic<uint64_t> retryPending{0};
+
+    /* m_toSync size after the last merge or drain */
+    std::atomic<uint64_t> toSyncPending{0};
+
+    void recordDoTask(std::chrono::steady_clock::duration elapsed)
+    {
+        uint64_t usec = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+
+        doTaskUsec.record(usec);
+        totalDoTasks.fetch_add(1, std::memory_order_relaxed);
+        totalDoTaskUsec.fetch_add(usec, std::memory_order_relaxed);
+    }
+
+    void recordPop(size_t batch)
+    {
+        popBatch.record(batch);
+        totalPops.fetch_add(1, std::memory_order_relaxed);
+        totalPopEntries.fetch_add(batch, std::memory_order_relaxed);
+    }
+};
+
+/*
+ * Statistics of the sairedis pipeline flushes of the OrchDaemon main loop:
+ *  flushOps          - ops queued between two flushes
+ *  flushIntervalUsec - time between two flushes in microseconds
+ *  flushDelayUsec    - time the oldest op of a flush waited for it in microseconds
+ */
+struct FlushStats
+{
+    LatencyHistogram flushOps;
+    LatencyHistogram flushIntervalUsec;
+    LatencyHistogram flushDelayUsec;
+
+    /* Flushes since the start of orchagent, in total and per reason, see FlushPolicy */
+    std::atomic<uint64_t> totalFlushes{0};
+    std::atomic<uint64_t> totalPeriodic{0};
+    std::atomic<uint64_t> totalBatch{0};
+    std::atomic<uint64_t> totalLatency{0};
+    std::atomic<uint64_t> totalIdle{0};
+    std::atomic<uint64_t> totalForced{0};
+};
+
+/*
+ * Statistics of the bulk SAI calls made by the EntityBulkers of one object type:
+ *  callObjects - entries sent in a single bulk call
+ *  callUsec    - latency of a single bulk call in microseconds
+ */
+struct BulkerStats
+{
+    enum class Op
+    {
+        CREATE,
+        REMOVE,
+        SET,
+    };
+
+    LatencyHistogram callObjects;
+    LatencyHistogram callUsec;
+
+    /* Totals since the start of orchagent */
+    std::atomic<uint64_t> totalCalls{0};
+    /* Calls which returned an error as a whole */
+    std::atomic<uint64_t> totalCallFailures{0};
+    std::atomic<uint64_t> totalCreated{0};
+    std::atomic<uint64_t> totalRemoved{0};
+    std::atomic<uint64_t> totalSet{0};
+    /* Entries with a per object error status */
+    std::atomic<uint64_t> totalFailed{0};
+    /* Flushes triggered by the high water mark, see EntityBulker::enable_auto_flush() */
+    std::atomic<uint64_t> totalAutoFlushes{0};
+    /* Chunk size after the last call, max_bulk_size unless chunks are sized adaptively */
+    std::atomic<uint64_t> chunkSize{0};
+    /* Entries queued in the bulkers and not flushed yet */
+    std::atomic<uint64_t> pending{0};
+
+    void recordCall(Op op, size_t objects, uint64_t usec, size_t failed, bool callFailed)
+    {
+        callObjects.record(objects);
+        callUsec.record(usec);
+        totalCalls.fetch_add(1, std::memory_order_relaxed);
+        totalFailed.fetch_add(failed, std::memory_order_relaxed);
+        if (callFailed)
+        {
+            totalCallFailures.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        switch (op)
+        {
+            case Op::CREATE:
+                totalCreated.fetch_add(objects, std::memory_order_relaxed);
+                break;
+            case Op::REMOVE:
+                totalRemoved.fetch_add(objects, std::memory_order_relaxed);
+                break;
+            case Op::SET:
+                totalSet.fetch_add(objects, std::memory_order_relaxed);
+                break;
+        }
+    }
+};
+
+/*
+ * Statistics of the counter polls orchagent runs itself for a flex counter group:
+ *  pollUsec    - duration of a single poll in microseconds
+ *  pollObjects - objects read by a single poll
+ */
+struct CounterPollStats
+{
+    LatencyHistogram pollUsec;
+    LatencyHistogram pollObjects;
+
+    /* Totals since the start of orchagent */
+    std::atomic<uint64_t> totalPolls{0};
+    std::atomic<uint64_t> totalPollUsec{0};
+
+    void recordPoll(size_t objects, std::chrono::steady_clock::duration elapsed)
+    {
+        uint64_t usec = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+
+        pollUsec.record(usec);
+        pollObjects.record(objects);
+        totalPolls.fetch_add(1, std::memory_order_relaxed);
+        totalPollUsec.fetch_add(usec, std::memory_order_relaxed);
+    }
+};
+
+/*
+ * Registry of executor statistics. Collection is disabled by default and
+ * must be enabled before the Orchs are constructed, consumers created while
+ * disabled carry a null statistics pointer and pay a single branch.
+ */
+class ExecutorStatsRegistry
+{
+public:
+    static ExecutorStatsRegistry& instance()
+    {
+        static ExecutorStatsRegistry registry;
+        return registry;
+    }
+
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    std::shared_ptr<ExecutorStats> attach(const std::string &executorName)
+    {
+        if (!m_enabled)
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto &stats = m_stats[executorName];
+        if (!stats)
+        {
+            stats = std::make_shared<ExecutorStats>();
+        }
+
+        return stats;
+    }
+
+    std::shared_ptr<FlushStats> attachFlushStats()
+    {
+        if (!m_enabled)
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_flushStats)
+        {
+            m_flushStats = std::make_shared<FlushStats>();
+        }
+
+        return m_flushStats;
+    }
+
+    std::shared_ptr<FlushStats> getFlushStats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_flushStats;
+    }
+
+    std::vector<std::pair<std::string, std::shared_ptr<ExecutorStats>>> getAll()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return std::vector<std::pair<std::string, std::shared_ptr<ExecutorStats>>>(m_stats.begin(), m_stats.end());
+    }
+
+    /* Bulkers of the same object type share their statistics */
+    std::shared_ptr<BulkerStats> attachBulkerStats(const std::string &objectType)
+    {
+        if (!m_enabled)
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto &stats = m_bulkerStats[objectType];
+        if (!stats)
+        {
+            stats = std::make_shared<BulkerStats>();
+        }
+
+        return stats;
+    }
+
+    std::vector<std::pair<std::string, std::shared_ptr<BulkerStats>>> getAllBulkerStats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return std::vector<std::pair<std::string, std::shared_ptr<BulkerStats>>>(m_bulkerStats.begin(), m_bulkerStats.end());
+    }
+
+    std::shared_ptr<CounterPollStats> attachCounterPollStats(const std::string &group)
+    {
+        if (!m_enabled)
+        {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto &stats = m_counterPollStats[group];
+        if (!stats)
+        {
+            stats = std::make_shared<CounterPollStats>();
+        }
+
+        return stats;
+    }
+
+    std::vector<std::pair<std::string, std::shared_ptr<CounterPollStats>>> getAllCounterPollStats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return std::vector<std::pair<std::string, std::shared_ptr<CounterPollStats>>>(m_counterPollStats.begin(), m_counterPollStats.end());
+    }
+
+private:
+    ExecutorStatsRegistry() = default;
+
+    bool m_enabled = false;
+    std::mutex m_mutex;
+    std::map<std::string, std::shared_ptr<ExecutorStats>> m_stats;
+    std::shared_ptr<FlushStats> m_flushStats;
+    std::map<std::string, std::shared_ptr<BulkerStats>> m_bulkerStats;
+    std::map<std::string, std::shared_ptr<CounterPollStats>> m_counterPollStats;
+};
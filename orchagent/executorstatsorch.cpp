@@ -0,0 +1,179 @@
+#include "executorstatsorch.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+ExecutorStatsOrch::ExecutorStatsOrch(int intervalSec) :
+    Orch(),
+    m_countersDb(new DBConnector("COUNTERS_DB", 0)),
+    m_statsTable(new Table(m_countersDb.get(), EXECUTOR_STATS_TABLE)),
+    m_lastPublish(chrono::steady_clock::now())
+{
+    SWSS_LOG_ENTER();
+
+    // Stale entries from the previous run would be misleading
+    vector<string> keys;
+    m_statsTable->getKeys(keys);
+    for (const auto &key : keys)
+    {
+        m_statsTable->del(key);
+    }
+
+    auto interv = timespec { .tv_sec = intervalSec, .tv_nsec = 0 };
+    m_timer = new SelectableTimer(interv);
+
+    // Note: ExecutableTimer will hold m_timer pointer and release the object later
+    auto executor = new ExecutableTimer(m_timer, this, "EXECUTOR_STATS_POLL");
+    Orch::addExecutor(executor);
+    m_timer->start();
+
+    SWSS_LOG_NOTICE("Executor statistics are published every %d seconds", intervalSec);
+}
+
+void ExecutorStatsOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    publish();
+}
+
+static void appendHistogram(vector<FieldValueTuple> &fvs, const string &prefix, LatencyHistogram &hist)
+{
+    fvs.emplace_back(prefix + "_count", to_string(hist.count()));
+    fvs.emplace_back(prefix + "_p50", to_string(hist.percentile(50)));
+    fvs.emplace_back(prefix + "_p90", to_string(hist.percentile(90)));
+    fvs.emplace_back(prefix + "_p99", to_string(hist.percentile(99)));
+    fvs.emplace_back(prefix + "_max", to_string(hist.max()));
+
+    hist.reset();
+}
+
+void ExecutorStatsOrch::publish()
+{
+    auto now = chrono::steady_clock::now();
+    uint64_t elapsedSec = static_cast<uint64_t>(chrono::duration_cast<chrono::seconds>(now - m_lastPublish).count());
+    m_lastPublish = now;
+
+    for (auto &it : ExecutorStatsRegistry::instance().getAll())
+    {
+        auto &stats = *it.second;
+
+        // Skip idle executors to keep the publish cost proportional to activity
+        uint64_t retryWoken = stats.totalRetryWoken.load(memory_order_relaxed);
+        uint64_t &lastRetryWoken = m_lastRetryWoken[it.first];
+        uint64_t popEntries = stats.totalPopEntries.load(memory_order_relaxed);
+        uint64_t &lastPopEntries = m_lastPopEntries[it.first];
+
+        if (stats.popBatch.count() == 0 && stats.doTaskUsec.count() == 0 && stats.toSyncDepth.count() == 0 &&
+            stats.waitUsec.count() == 0 && stats.retryWaitUsec.count() == 0)
+        {
+            lastRetryWoken = retryWoken;
+            lastPopEntries = popEntries;
+            continue;
+        }
+
+        vector<FieldValueTuple> fvs;
+
+        appendHistogram(fvs, "pop_batch", stats.popBatch);
+        appendHistogram(fvs, "to_sync_depth", stats.toSyncDepth);
+        appendHistogram(fvs, "dotask_usec", stats.doTaskUsec);
+        appendHistogram(fvs, "wait_usec", stats.waitUsec);
+        appendHistogram(fvs, "retry_wait_usec", stats.retryWaitUsec);
+
+        fvs.emplace_back("total_pops", to_string(stats.totalPops.load(memory_order_relaxed)));
+        fvs.emplace_back("total_pop_entries", to_string(popEntries));
+        fvs.emplace_back("pop_entries_per_sec", to_string(elapsedSec > 0 ? (popEntries - lastPopEntries) / elapsedSec : 0));
+        lastPopEntries = popEntries;
+        fvs.emplace_back("total_dotasks", to_string(stats.totalDoTasks.load(memory_order_relaxed)));
+        fvs.emplace_back("total_dotask_usec", to_string(stats.totalDoTaskUsec.load(memory_order_relaxed)));
+        fvs.emplace_back("total_slice_expired", to_string(stats.totalSliceExpired.load(memory_order_relaxed)));
+        fvs.emplace_back("total_deferred", to_string(stats.totalDeferred.load(memory_order_relaxed)));
+        fvs.emplace_back("total_retry_cached", to_string(stats.totalRetryCached.load(memory_order_relaxed)));
+        fvs.emplace_back("total_retry_woken", to_string(retryWoken));
+        fvs.emplace_back("total_retry_evicted", to_string(stats.totalRetryEvicted.load(memory_order_relaxed)));
+        fvs.emplace_back("retry_pending", to_string(stats.retryPending.load(memory_order_relaxed)));
+        fvs.emplace_back("retry_woken_per_sec", to_string(elapsedSec > 0 ? (retryWoken - lastRetryWoken) / elapsedSec : 0));
+        lastRetryWoken = retryWoken;
+
+        m_statsTable->set(it.first, fvs);
+    }
+
+    publishFlushStats();
+    publishBulkerStats();
+    publishCounterPollStats();
+}
+
+void ExecutorStatsOrch::publishFlushStats()
+{
+    auto stats = ExecutorStatsRegistry::instance().getFlushStats();
+    if (!stats || stats->flushOps.count() == 0)
+    {
+        return;
+    }
+
+    vector<FieldValueTuple> fvs;
+
+    appendHistogram(fvs, "flush_ops", stats->flushOps);
+    appendHistogram(fvs, "flush_interval_usec", stats->flushIntervalUsec);
+    appendHistogram(fvs, "flush_delay_usec", stats->flushDelayUsec);
+
+    fvs.emplace_back("total_flushes", to_string(stats->totalFlushes.load(memory_order_relaxed)));
+    fvs.emplace_back("total_periodic", to_string(stats->totalPeriodic.load(memory_order_relaxed)));
+    fvs.emplace_back("total_batch", to_string(stats->totalBatch.load(memory_order_relaxed)));
+    fvs.emplace_back("total_latency", to_string(stats->totalLatency.load(memory_order_relaxed)));
+    fvs.emplace_back("total_idle", to_string(stats->totalIdle.load(memory_order_relaxed)));
+    fvs.emplace_back("total_forced", to_string(stats->totalForced.load(memory_order_relaxed)));
+
+    m_statsTable->set(EXECUTOR_STATS_FLUSH_KEY, fvs);
+}
+
+void ExecutorStatsOrch::publishBulkerStats()
+{
+    for (auto &it : ExecutorStatsRegistry::instance().getAllBulkerStats())
+    {
+        auto &stats = *it.second;
+        if (stats.callObjects.count() == 0)
+        {
+            continue;
+        }
+
+        vector<FieldValueTuple> fvs;
+
+        appendHistogram(fvs, "call_objects", stats.callObjects);
+        appendHistogram(fvs, "call_usec", stats.callUsec);
+
+        fvs.emplace_back("total_calls", to_string(stats.totalCalls.load(memory_order_relaxed)));
+        fvs.emplace_back("total_call_failures", to_string(stats.totalCallFailures.load(memory_order_relaxed)));
+        fvs.emplace_back("total_created", to_string(stats.totalCreated.load(memory_order_relaxed)));
+        fvs.emplace_back("total_removed", to_string(stats.totalRemoved.load(memory_order_relaxed)));
+        fvs.emplace_back("total_set", to_string(stats.totalSet.load(memory_order_relaxed)));
+        fvs.emplace_back("total_failed", to_string(stats.totalFailed.load(memory_order_relaxed)));
+        fvs.emplace_back("total_auto_flushes", to_string(stats.totalAutoFlushes.load(memory_order_relaxed)));
+        fvs.emplace_back("chunk_size", to_string(stats.chunkSize.load(memory_order_relaxed)));
+
+        m_statsTable->set(EXECUTOR_STATS_BULK_PREFIX + it.first, fvs);
+    }
+}
+
+void ExecutorStatsOrch::publishCounterPollStats()
+{
+    for (auto &it : ExecutorStatsRegistry::instance().getAllCounterPollStats())
+    {
+        auto &stats = *it.second;
+        if (stats.pollUsec.count() == 0)
+        {
+            continue;
+        }
+
+        vector<FieldValueTuple> fvs;
+
+        appendHistogram(fvs, "poll_usec", stats.pollUsec);
+        appendHistogram(fvs, "poll_objects", stats.pollObjects);
+
+        fvs.emplace_back("total_polls", to_string(stats.totalPolls.load(memory_order_relaxed)));
+        fvs.emplace_back("total_poll_usec", to_string(stats.totalPollUsec.load(memory_order_relaxed)));
+
+        m_statsTable->set(EXECUTOR_STATS_COUNTER_POLL_PREFIX + it.first, fvs);
+    }
+}
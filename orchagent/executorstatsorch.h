@@ -0,0 +1,47 @@
+#ifndef SWSS_EXECUTORSTATSORCH_H
+#define SWSS_EXECUTORSTATSORCH_H
+
+#include "orch.h"
+#include "timer.h"
+#include "executorstats.h"
+
+#define EXECUTOR_STATS_TABLE                    "ORCH_EXECUTOR_STATS"
+#define EXECUTOR_STATS_POLL_INTERVAL_DEFAULT    10
+#define EXECUTOR_STATS_FLUSH_KEY                "SAIREDIS_FLUSH"
+#define EXECUTOR_STATS_BULK_PREFIX              "SAI_BULK|"
+#define EXECUTOR_STATS_COUNTER_POLL_PREFIX      "COUNTER_POLL|"
+
+/*
+ * Periodically publishes the per executor histograms collected by
+ * ExecutorStatsRegistry into COUNTERS_DB:ORCH_EXECUTOR_STATS:<executor>.
+ * Percentiles describe the last publish interval, totals are cumulative.
+ * The sairedis flushes of the main loop are published under EXECUTOR_STATS_FLUSH_KEY,
+ * the bulk SAI calls of the EntityBulkers under EXECUTOR_STATS_BULK_PREFIX<object type>,
+ * the counter polls of orchagent under EXECUTOR_STATS_COUNTER_POLL_PREFIX<group>.
+ */
+class ExecutorStatsOrch : public Orch
+{
+public:
+    ExecutorStatsOrch(int intervalSec = EXECUTOR_STATS_POLL_INTERVAL_DEFAULT);
+
+    void doTask(swss::SelectableTimer &timer) override;
+    void doTask(Consumer &consumer) override {}
+
+    void publish();
+
+private:
+    void publishFlushStats();
+    void publishBulkerStats();
+    void publishCounterPollStats();
+
+    std::shared_ptr<swss::DBConnector> m_countersDb;
+    std::shared_ptr<swss::Table> m_statsTable;
+    swss::SelectableTimer *m_timer = nullptr;
+
+    // Base of the per second rates
+    std::chrono::steady_clock::time_point m_lastPublish;
+    std::map<std::string, uint64_t> m_lastRetryWoken;
+    std::map<std::string, uint64_t> m_lastPopEntries;
+};
+
+#endif /* SWSS_EXECUTORSTATSORCH_H */
@@ -1,6 +1,8 @@
 #include "fabricportsorch.h"
 
 #include <inttypes.h>
+#include <hiredis/hiredis.h>
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <tuple>
@@ -94,6 +96,9 @@ FabricPortsOrch::FabricPortsOrch(DBConnector *appl_db, vector<table_name_with_pr
     m_state_db = shared_ptr<DBConnector>(new DBConnector("STATE_DB", 0));
     m_stateTable = unique_ptr<Table>(new Table(m_state_db.get(), APP_FABRIC_PORT_TABLE_NAME));
     m_fabricCapacityTable = unique_ptr<Table>(new Table(m_state_db.get(), STATE_FABRIC_CAPACITY_TABLE_NAME));
+    m_statePipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_state_db.get()));
+    m_stateWriter = unique_ptr<Table>(new Table(m_statePipeline.get(), APP_FABRIC_PORT_TABLE_NAME, true));
+    m_fabricCapacityWriter = unique_ptr<Table>(new Table(m_statePipeline.get(), STATE_FABRIC_CAPACITY_TABLE_NAME, true));
 
     m_counter_db = shared_ptr<DBConnector>(new DBConnector("COUNTERS_DB", 0));
     m_portNameQueueCounterTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_FABRIC_QUEUE_NAME_MAP));
@@ -411,7 +416,14 @@ void FabricPortsOrch::updateFabricPortState()
             values.emplace_back("PORT_DOWN_SEEN_LAST_TIME",
                                 to_string(m_portDownSeenLastTime[lane]));
         }
-        m_stateTable->set(key, values);
+
+        // Only the ports whose state changed since the last poll are written
+        auto &written = m_portStateWritten[lane];
+        if (written != values)
+        {
+            m_stateWriter->set(key, values);
+            written = values;
+        }
     }
 }
 
@@ -490,14 +502,14 @@ void FabricPortsOrch::updateFabricDebugCounters()
 
         string key = FABRIC_PORT_PREFIX + to_string(lane);
         // so basically port is the oid
-        vector<FieldValueTuple> fieldValues;
         static const array<string, 3> cntNames =
         {
             "SAI_PORT_STAT_IF_IN_ERRORS", // cells with crc errors
             "SAI_PORT_STAT_IF_IN_FABRIC_DATA_UNITS", // rx data cells
             "SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES"  // cell with uncorrectable errors
         };
-        if (!m_fabricCounterTable->get(sai_serialize_object_id(port), fieldValues))
+        const auto &fieldValues = m_counterSnapshot[key];
+        if (fieldValues.empty())
         {
            SWSS_LOG_INFO("no port %s", sai_serialize_object_id(port).c_str());
         }
@@ -585,9 +597,9 @@ void FabricPortsOrch::updateFabricDebugCounters()
 
         // Get appl_db values, and update state_db later with other attributes
         string applKey = APPL_FABRIC_PORT_PREFIX + to_string(lane);
-        std::vector<FieldValueTuple> applValues;
+        const auto &applValues = m_applSnapshot[key];
         string applResult = "False";
-        bool exist = m_applTable->get(applKey, applValues);
+        bool exist = !applValues.empty();
         if (!exist)
         {
             SWSS_LOG_INFO("No app infor for port %s", applKey.c_str());
@@ -614,9 +626,9 @@ void FabricPortsOrch::updateFabricDebugCounters()
         }
 
         // Get the consecutive polls from the state db
-        std::vector<FieldValueTuple> values;
+        const auto &values = m_stateSnapshot[key];
         string valuePt;
-        exist = m_stateTable->get(key, values);
+        exist = !values.empty();
         if (!exist)
         {
             SWSS_LOG_INFO("No state infor for port %s", key.c_str());
@@ -946,17 +958,17 @@ void FabricPortsOrch::updateFabricDebugCounters()
 
         // Update state_db with error rate
         valuePt = to_string(rxCells);
-        m_stateTable->hset(key, "RX_CELLS", valuePt.c_str());
+        setStateField(key, "RX_CELLS", valuePt);
         SWSS_LOG_INFO("port %s set RX_CELLS %s",
                       key.c_str(), valuePt.c_str());
 
         valuePt = to_string(prevCrcErrors);
-        m_stateTable->hset(key, "CRC_ERRORS", valuePt.c_str());
+        setStateField(key, "CRC_ERRORS", valuePt);
         SWSS_LOG_INFO("port %s set CRC_ERRORS %s",
                       key.c_str(), valuePt.c_str());
 
         valuePt = to_string(prevCodeErrors);
-        m_stateTable->hset(key, "CODE_ERRORS", valuePt.c_str());
+        setStateField(key, "CODE_ERRORS", valuePt);
         SWSS_LOG_INFO("port %s set CODE_ERRORS %s",
                       key.c_str(), valuePt.c_str());
     }
@@ -972,8 +984,15 @@ void FabricPortsOrch::updateStateDbTable(
     // Convert the integer value to a string
     std::string valueStr = std::to_string(value);
 
-    // Update the state table
-    stateTable->hset(key, field, valueStr.c_str());
+    // Update the state table, through the snapshot during a monitoring poll
+    if (m_stateSnapshot.find(key) != m_stateSnapshot.end())
+    {
+        setStateField(key, field, valueStr);
+    }
+    else
+    {
+        stateTable->hset(key, field, valueStr.c_str());
+    }
 
     // Log the update
     SWSS_LOG_INFO("%s updates %s to %s %lld",
@@ -1082,7 +1101,6 @@ void FabricPortsOrch::updateFabricCapacity()
     {
         int lane = p.first;
         string key = FABRIC_PORT_PREFIX + to_string(lane);
-        std::vector<FieldValueTuple> values;
         string valuePt;
         string lnkStatus = "down";
         string configIsolated = "0";
@@ -1090,7 +1108,8 @@ void FabricPortsOrch::updateFabricCapacity()
         string autoIsolated = "0";
 
         // Get fabric serdes link status from STATE_DB
-        bool exist = m_stateTable->get(key, values);
+        const auto &values = m_stateSnapshot[key];
+        bool exist = !values.empty();
         if (!exist)
         {
             SWSS_LOG_INFO("No state infor for port %s", key.c_str());
@@ -1222,13 +1241,21 @@ void FabricPortsOrch::updateFabricCapacity()
 
     // Update STATE_DB
     SWSS_LOG_INFO("FabricPortsOrch::updateFabricCapacity now update STATE_DB");
-    m_fabricCapacityTable->hset("FABRIC_CAPACITY_DATA", "fabric_capacity", to_string(capacity));
-    m_fabricCapacityTable->hset("FABRIC_CAPACITY_DATA", "missing_capacity", to_string(downCapacity));
-    m_fabricCapacityTable->hset("FABRIC_CAPACITY_DATA", "operating_links", to_string(operating_links));
-    m_fabricCapacityTable->hset("FABRIC_CAPACITY_DATA", "number_of_links", to_string(total_links));
-    m_fabricCapacityTable->hset("FABRIC_CAPACITY_DATA", "warning_threshold", to_string(threshold));
-    m_fabricCapacityTable->hset("FABRIC_CAPACITY_DATA", "last_event", event);
-    m_fabricCapacityTable->hset("FABRIC_CAPACITY_DATA", "last_event_time", lastTime);
+    vector<FieldValueTuple> capacityValues =
+    {
+        { "fabric_capacity", to_string(capacity) },
+        { "missing_capacity", to_string(downCapacity) },
+        { "operating_links", to_string(operating_links) },
+        { "number_of_links", to_string(total_links) },
+        { "warning_threshold", to_string(threshold) },
+        { "last_event", event },
+        { "last_event_time", lastTime }
+    };
+    if (capacityValues != m_fabricCapacityWritten)
+    {
+        m_fabricCapacityWriter->set("FABRIC_CAPACITY_DATA", capacityValues);
+        m_fabricCapacityWritten = capacityValues;
+    }
 }
 
 
@@ -1241,9 +1268,9 @@ void FabricPortsOrch::updateFabricRate()
         string key = FABRIC_PORT_PREFIX + to_string(lane);
 
         // get oldRateAverage, oldData, oldTime(time.time) from state db
-        std::vector<FieldValueTuple> values;
+        const auto &values = m_stateSnapshot[key];
         string valuePt;
-        bool exist = m_stateTable->get(key, values);
+        bool exist = !values.empty();
         double oldRxRate = 0;
         uint64_t oldRxData = 0;
         double oldTxRate = 0;
@@ -1295,14 +1322,14 @@ void FabricPortsOrch::updateFabricRate()
 
 
         // get the newData and newTime for this poll
-        vector<FieldValueTuple> fieldValues;
         sai_object_id_t port = p.second;
         static const array<string, 2> cntNames =
         {
             "SAI_PORT_STAT_IF_OUT_OCTETS", // snmpBcmTxDataBytes
             "SAI_PORT_STAT_IF_IN_OCTETS", // snmpBcmRxDataBytes
         };
-        if (!m_fabricCounterTable->get(sai_serialize_object_id(port), fieldValues))
+        const auto &fieldValues = m_counterSnapshot[key];
+        if (fieldValues.empty())
         {
             SWSS_LOG_INFO("no port %s", sai_serialize_object_id(port).c_str());
         }
@@ -1370,21 +1397,117 @@ void FabricPortsOrch::updateFabricRate()
                          (long long)newRxRate, (long long)rxBytes,
                          (long long)newTxRate, (long long)txBytes, newTime );
 
-        valuePt = to_string(newRxRate);
-        m_stateTable->hset(key, "OLD_RX_RATE_AVG", valuePt.c_str());
+        setStateField(key, "OLD_RX_RATE_AVG", to_string(newRxRate));
+        setStateField(key, "OLD_RX_DATA", to_string(rxBytes));
+        setStateField(key, "OLD_TX_RATE_AVG", to_string(newTxRate));
+        setStateField(key, "OLD_TX_DATA", to_string(txBytes));
+        setStateField(key, "LAST_TIME", to_string(newTime));
+    }
+}
+
+bool FabricPortsOrch::readHashes(DBConnector *db, Table &table, const vector<string> &keys,
+                                 vector<vector<FieldValueTuple>> &hashes)
+{
+    redisContext *ctx = db->getContext();
+
+    for (const auto &key : keys)
+    {
+        if (redisAppendCommand(ctx, "HGETALL %s", table.getKeyName(key).c_str()) != REDIS_OK)
+        {
+            SWSS_LOG_ERROR("Failed to queue fabric port read: %s", ctx->errstr);
+            return false;
+        }
+    }
+
+    hashes.assign(keys.size(), vector<FieldValueTuple>());
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        void *reply = nullptr;
+        if (redisGetReply(ctx, &reply) != REDIS_OK || !reply)
+        {
+            SWSS_LOG_ERROR("Failed to read fabric port: %s", ctx->errstr);
+            return false;
+        }
+
+        auto r = static_cast<redisReply *>(reply);
+        if (r->type == REDIS_REPLY_ARRAY)
+        {
+            for (size_t j = 0; j + 1 < r->elements; j += 2)
+            {
+                hashes[i].emplace_back(string(r->element[j]->str, r->element[j]->len),
+                                       string(r->element[j + 1]->str, r->element[j + 1]->len));
+            }
+        }
+        freeReplyObject(r);
+    }
+
+    return true;
+}
+
+// Read the state, config and counters of all the fabric ports, one pipelined
+// batch per database instead of one round trip per port and table
+bool FabricPortsOrch::loadMonitorSnapshot()
+{
+    vector<string> stateKeys;
+    vector<string> applKeys;
+    vector<string> counterKeys;
 
-        valuePt = to_string(rxBytes);
-        m_stateTable->hset(key, "OLD_RX_DATA", valuePt.c_str());
+    for (auto p : m_fabricLanePortMap)
+    {
+        stateKeys.push_back(FABRIC_PORT_PREFIX + to_string(p.first));
+        applKeys.push_back(APPL_FABRIC_PORT_PREFIX + to_string(p.first));
+        counterKeys.push_back(sai_serialize_object_id(p.second));
+    }
+
+    vector<vector<FieldValueTuple>> stateHashes;
+    vector<vector<FieldValueTuple>> applHashes;
+    vector<vector<FieldValueTuple>> counterHashes;
+    if (!readHashes(m_state_db.get(), *m_stateTable, stateKeys, stateHashes) ||
+        !readHashes(m_appl_db.get(), *m_applTable, applKeys, applHashes) ||
+        !readHashes(m_counter_db.get(), *m_fabricCounterTable, counterKeys, counterHashes))
+    {
+        SWSS_LOG_ERROR("Failed to read the fabric port monitoring data, skip this poll");
+        return false;
+    }
+
+    for (size_t i = 0; i < stateKeys.size(); i++)
+    {
+        m_stateSnapshot[stateKeys[i]] = move(stateHashes[i]);
+        m_applSnapshot[stateKeys[i]] = move(applHashes[i]);
+        m_counterSnapshot[stateKeys[i]] = move(counterHashes[i]);
+    }
 
-        valuePt = to_string(newTxRate);
-        m_stateTable->hset(key, "OLD_TX_RATE_AVG", valuePt.c_str());
+    return true;
+}
 
-        valuePt = to_string(txBytes);
-        m_stateTable->hset(key, "OLD_TX_DATA", valuePt.c_str());
+void FabricPortsOrch::clearMonitorSnapshot()
+{
+    m_stateSnapshot.clear();
+    m_applSnapshot.clear();
+    m_counterSnapshot.clear();
+}
 
-        valuePt = to_string(newTime);
-        m_stateTable->hset(key, "LAST_TIME", valuePt.c_str());
+// Set a STATE_DB field of a fabric port during a monitoring poll, the write
+// is skipped when the snapshot already holds the value
+void FabricPortsOrch::setStateField(const string &key, const string &field, const string &value)
+{
+    auto &fields = m_stateSnapshot[key];
+    auto it = find_if(fields.begin(), fields.end(),
+                      [&field](const FieldValueTuple &fv) { return fvField(fv) == field; });
+    if (it == fields.end())
+    {
+        fields.emplace_back(field, value);
     }
+    else if (it->second == value)
+    {
+        return;
+    }
+    else
+    {
+        it->second = value;
+    }
+
+    m_stateWriter->hset(key, field, value);
 }
 
 void FabricPortsOrch::doTask()
@@ -1573,6 +1696,7 @@ void FabricPortsOrch::doTask(swss::SelectableTimer &timer)
         if (m_getFabricPortListDone)
         {
             updateFabricPortState();
+            m_statePipeline->flush();
         }
         if (((gMySwitchType == "voq") || (gMySwitchType == "fabric")) && (!m_isSwitchStatsGenerated))
         {
@@ -1607,9 +1731,14 @@ void FabricPortsOrch::doTask(swss::SelectableTimer &timer)
         if (m_getFabricPortListDone)
         {
             SWSS_LOG_INFO("Fabric monitor enabled");
-            updateFabricDebugCounters();
-            updateFabricCapacity();
-            updateFabricRate();
+            if (loadMonitorSnapshot())
+            {
+                updateFabricDebugCounters();
+                updateFabricCapacity();
+                updateFabricRate();
+            }
+            clearMonitorSnapshot();
+            m_statePipeline->flush();
         }
     }
 }
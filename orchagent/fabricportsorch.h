@@ -7,6 +7,7 @@
 #include "observer.h"
 #include "observer.h"
 #include "producertable.h"
+#include "redispipeline.h"
 #include "flex_counter_manager.h"
 
 using Clock = std::chrono::system_clock;
@@ -32,6 +33,11 @@ private:
     shared_ptr<DBConnector> m_appl_db;
 
     unique_ptr<Table> m_stateTable;
+    unique_ptr<RedisPipeline> m_statePipeline;
+    // Buffered writer of the fabric port and capacity STATE_DB tables,
+    // flushed once per poll
+    unique_ptr<Table> m_stateWriter;
+    unique_ptr<Table> m_fabricCapacityWriter;
     unique_ptr<Table> m_portNameQueueCounterTable;
     unique_ptr<Table> m_portNamePortCounterTable;
     unique_ptr<Table> m_fabricCounterTable;
@@ -69,12 +75,28 @@ private:
     std::unordered_map<std::string, std::queue<TimePoint>> linkQueues;
     std::unordered_map<std::string, std::queue<TimePoint>> dnLkQueues;
 
+    // STATE_DB, APPL_DB and COUNTERS_DB entries of every fabric port, read
+    // with one pipelined batch per database at the start of a monitoring
+    // poll and keyed by the STATE_DB key of the port. Writes of the poll
+    // update the state snapshot and only changed fields reach STATE_DB.
+    std::unordered_map<std::string, vector<FieldValueTuple>> m_stateSnapshot;
+    std::unordered_map<std::string, vector<FieldValueTuple>> m_applSnapshot;
+    std::unordered_map<std::string, vector<FieldValueTuple>> m_counterSnapshot;
+    // Fields last written by updateFabricPortState and updateFabricCapacity
+    std::unordered_map<int, vector<FieldValueTuple>> m_portStateWritten;
+    vector<FieldValueTuple> m_fabricCapacityWritten;
+
     int getFabricPortList();
     void generatePortStats();
     void updateFabricPortState();
     void updateFabricDebugCounters();
     void updateFabricCapacity();
     bool checkFabricPortMonState();
+    bool readHashes(DBConnector *db, Table &table, const vector<string> &keys,
+                    vector<vector<FieldValueTuple>> &hashes);
+    bool loadMonitorSnapshot();
+    void clearMonitorSnapshot();
+    void setStateField(const string &key, const string &field, const string &value);
     void updateFabricRate();
     void createSwitchDropCounters();
     void clearFabricCnt(int lane, bool clearIsolation);
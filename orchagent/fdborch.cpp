@@ -23,6 +23,7 @@ extern sai_object_id_t  gSwitchId;
 extern CrmOrch *        gCrmOrch;
 extern MlagOrch*        gMlagOrch;
 extern Directory<Orch*> gDirectory;
+extern size_t           gMaxBulkSize;
 
 const int FdbOrch::fdborch_pri = 20;
 
@@ -31,8 +32,13 @@ FdbOrch::FdbOrch(DBConnector* applDbConnector, vector<table_name_with_pri_t> app
     Orch(applDbConnector, appFdbTables),
     m_portsOrch(port),
     m_fdbStateTable(stateDbFdbConnector.first, stateDbFdbConnector.second),
-    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second)
+    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second),
+    m_fdbBulker(sai_fdb_api, gMaxBulkSize),
+    m_fdbEvents([](const FdbUpdate &update) { return update.entry; })
 {
+    m_statePipeline = unique_ptr<RedisPipeline>(new RedisPipeline(stateDbFdbConnector.first));
+    m_fdbStateWriter = unique_ptr<Table>(new Table(m_statePipeline.get(), stateDbFdbConnector.second, true));
+
     for(auto it: appFdbTables)
     {
         m_appTables.push_back(new Table(applDbConnector, it.first));
@@ -66,6 +72,11 @@ bool FdbOrch::bake()
     return true;
 }
 
+void FdbOrch::getObjectCounts(vector<FieldValueTuple> &counts) const
+{
+    counts.emplace_back("fdb_entries", to_string(m_entries.size()));
+}
+
 
 bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
 {
@@ -75,10 +86,10 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
     const Port& port = update.port;
     const MacAddress& mac = entry.mac;
     string portName = port.m_alias;
-    Port vlan;
+    sai_vlan_id_t vlan_id;
 
     oldFdbData.origin = FDB_ORIGIN_INVALID;
-    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    if (!m_portsOrch->getVlanId(entry.bv_id, vlan_id))
     {
         SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate \
                          vlan port from bv_id 0x%" PRIx64, entry.bv_id);
@@ -86,7 +97,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
     }
 
     // ref: https://github.com/Azure/sonic-swss/blob/master/doc/swss-schema.md#fdb_table
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + mac.to_string();
+    string key = "Vlan" + to_string(vlan_id) + ":" + mac.to_string();
 
     if (update.add)
     {
@@ -117,11 +128,11 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
         fdbdata.esi = "";
         fdbdata.vni = 0;
 
-        m_entries[entry] = fdbdata;
+        m_entries.set(entry, fdbdata);
         SWSS_LOG_INFO("FdbOrch notification: mac %s was inserted in port %s into bv_id 0x%" PRIx64,
                         entry.mac.to_string().c_str(), portName.c_str(), entry.bv_id);
         SWSS_LOG_INFO("m_entries size=%zu mac=%s port=0x%" PRIx64,
-            m_entries.size(), entry.mac.to_string().c_str(),  m_entries[entry].bridge_port_id);
+            m_entries.size(), entry.mac.to_string().c_str(), fdbdata.bridge_port_id);
 
         if (mac_move && (oldFdbData.origin == FDB_ORIGIN_MCLAG_ADVERTIZED))
         {
@@ -134,7 +145,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
         std::vector<FieldValueTuple> fvs;
         fvs.push_back(FieldValueTuple("port", portName));
         fvs.push_back(FieldValueTuple("type", update.type));
-        m_fdbStateTable.set(key, fvs);
+        setFdbState(key, fvs);
 
         if (!mac_move)
         {
@@ -169,7 +180,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
                 (oldFdbData.origin == FDB_ORIGIN_PROVISIONED))
         {
             // Remove in StateDb for non advertised mac addresses
-            m_fdbStateTable.del(key);
+            delFdbState(key);
         }
 
         gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
@@ -187,10 +198,9 @@ void FdbOrch::clearFdbEntry(const FdbEntry& entry)
     update.add = false;
 
     /* Fetch Vlan and decrement the counter */
-    Port temp_vlan;
-    if (m_portsOrch->getPort(entry.bv_id, temp_vlan))
+    if (auto temp_vlan = m_portsOrch->findPort(entry.bv_id))
     {
-        m_portsOrch->decrFdbCount(temp_vlan.m_alias, 1);
+        m_portsOrch->decrFdbCount(temp_vlan->m_alias, 1);
     }
 
     /* Decrement port fdb_counter */
@@ -198,7 +208,7 @@ void FdbOrch::clearFdbEntry(const FdbEntry& entry)
 
     /* Remove the FdbEntry from the internal cache, update state DB and CRM counter */
     storeFdbEntryState(update);
-    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+    notifyFdbChange(update);
 
     SWSS_LOG_INFO("FdbEntry removed from internal cache, MAC: %s , port: %s, BVID: 0x%" PRIx64,
                    update.entry.mac.to_string().c_str(), update.entry.port_name.c_str(), update.entry.bv_id);
@@ -227,51 +237,19 @@ void FdbOrch::handleSyncdFlushNotif(const sai_object_id_t& bv_id,
             }
         }
     }
-    else if (bv_id == SAI_NULL_OBJECT_ID)
-    {
-        /* FLUSH based on PORT */
-        for (auto itr = m_entries.begin(); itr != m_entries.end();)
-        {
-            auto curr = itr++;
-            if (curr->second.bridge_port_id == bridge_port_id)
-            {
-                if (curr->second.sai_fdb_type == sai_fdb_type &&
-                    (curr->first.mac == mac || mac == flush_mac) && curr->second.is_flush_pending)
-                {
-                    clearFdbEntry(curr->first);
-                }
-            }
-        }
-    }
-    else if (bridge_port_id == SAI_NULL_OBJECT_ID)
-    {
-        /* FLUSH based on BV_ID */
-        for (auto itr = m_entries.begin(); itr != m_entries.end();)
-        {
-            auto curr = itr++;
-            if (curr->first.bv_id == bv_id)
-            {
-                if (curr->second.sai_fdb_type == sai_fdb_type &&
-                    (curr->first.mac == mac || mac == flush_mac) && curr->second.is_flush_pending)
-                {
-                    clearFdbEntry(curr->first);
-                }
-            }
-        }
-    }
     else
     {
-        /* FLUSH based on port and VLAN */
-        for (auto itr = m_entries.begin(); itr != m_entries.end();)
+        /* FLUSH based on PORT, BV_ID or both, only the entries they index are checked */
+        vector<FdbEntry> entries = (bridge_port_id == SAI_NULL_OBJECT_ID) ?
+            m_entries.getBridgeEntries(bv_id) : m_entries.getBridgePortEntries(bridge_port_id, bv_id);
+
+        for (const auto& entry : entries)
         {
-            auto curr = itr++;
-            if (curr->first.bv_id == bv_id && curr->second.bridge_port_id == bridge_port_id)
+            auto curr = m_entries.find(entry);
+            if (curr->second.sai_fdb_type == sai_fdb_type &&
+                (curr->first.mac == mac || mac == flush_mac) && curr->second.is_flush_pending)
             {
-                if (curr->second.sai_fdb_type == sai_fdb_type &&
-                    (curr->first.mac == mac || mac == flush_mac) && curr->second.is_flush_pending)
-                {
-                    clearFdbEntry(curr->first);
-                }
+                clearFdbEntry(curr->first);
             }
         }
     }
@@ -288,7 +266,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
     update.entry.mac = entry->mac_address;
     update.entry.bv_id = entry->bv_id;
     update.type = "dynamic";
-    Port vlan;
+    const Port *vlan = nullptr;
 
     SWSS_LOG_INFO("FDB event:%d, MAC: %s , BVID: 0x%" PRIx64 " , \
                    bridge port ID: 0x%" PRIx64 ".",
@@ -314,8 +292,12 @@ void FdbOrch::update(sai_fdb_event_t        type,
         }
     }
 
-    if (entry->bv_id &&
-        !m_portsOrch->getPort(entry->bv_id, vlan))
+    // The VLAN is only read, its FDB count is updated in place
+    if (entry->bv_id)
+    {
+        vlan = m_portsOrch->findPort(entry->bv_id);
+    }
+    if (entry->bv_id && !vlan)
     {
         SWSS_LOG_NOTICE("FdbOrch notification type %d: Failed to locate vlan port from bv_id 0x%" PRIx64, type, entry->bv_id);
         return;
@@ -348,8 +330,10 @@ void FdbOrch::update(sai_fdb_event_t        type,
                     {
                         port.m_fdb_count--;
                         m_portsOrch->setPort(port.m_alias, port);
-                        vlan.m_fdb_count--;
-                        m_portsOrch->setPort(vlan.m_alias, vlan);
+                        if (vlan)
+                        {
+                            m_portsOrch->decrFdbCount(vlan->m_alias, 1);
+                        }
                     }
                     // Continue to add (update/move) the MAC
                 }
@@ -390,7 +374,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
                     update.add = true;
                     update.type = "dynamic";
                     storeFdbEntryState(update);
-                    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+                    notifyFdbChange(update);
 
                     return;
                 }
@@ -410,11 +394,13 @@ void FdbOrch::update(sai_fdb_event_t        type,
         update.type = "dynamic";
         update.port.m_fdb_count++;
         m_portsOrch->setPort(update.port.m_alias, update.port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        if (vlan)
+        {
+            m_portsOrch->incrFdbCount(vlan->m_alias, 1);
+        }
 
         storeFdbEntryState(update);
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyFdbChange(update);
 
         break;
     }
@@ -449,7 +435,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
         {
             update.type = "static";
 
-            if (vlan.m_members.find(update.port.m_alias) == vlan.m_members.end())
+            if (!vlan || vlan->m_members.find(update.port.m_alias) == vlan->m_members.end())
             {
                 FdbData fdbData;
                 fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
@@ -458,8 +444,8 @@ void FdbOrch::update(sai_fdb_event_t        type,
                 fdbData.remote_ip = existing_entry->second.remote_ip;
                 fdbData.esi = existing_entry->second.esi;
                 fdbData.vni = existing_entry->second.vni;
-                saved_fdb_entries[update.port.m_alias].push_back(
-                        {existing_entry->first.mac, vlan.m_vlan_info.vlan_id, fdbData});
+                saveFdbEntry(update.port.m_alias,
+                        {existing_entry->first.mac, vlan ? vlan->m_vlan_info.vlan_id : sai_vlan_id_t(0), fdbData});
             }
             else
             {
@@ -517,7 +503,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
             SWSS_LOG_NOTICE("fdbEvent: MAC age event received, MAC is MCLAG origin, added back"
                 "to HW type %s FDB %s in %s on %s",
                 existing_entry->second.type.c_str(),
-                update.entry.mac.to_string().c_str(), vlan.m_alias.c_str(),
+                update.entry.mac.to_string().c_str(), vlan ? vlan->m_alias.c_str() : "",
                 update.port.m_alias.c_str());
 
             status = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
@@ -525,7 +511,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
             {
                 SWSS_LOG_ERROR("Failed to create %s FDB %s in %s on %s, rv:%d",
                         existing_entry->second.type.c_str(), update.entry.mac.to_string().c_str(),
-                        vlan.m_alias.c_str(), update.port.m_alias.c_str(), status);
+                        vlan ? vlan->m_alias.c_str() : "", update.port.m_alias.c_str(), status);
             }
             return;
         }
@@ -536,14 +522,13 @@ void FdbOrch::update(sai_fdb_event_t        type,
             update.port.m_fdb_count--;
             m_portsOrch->setPort(update.port.m_alias, update.port);
         }
-        if (!vlan.m_alias.empty())
+        if (vlan)
         {
-            vlan.m_fdb_count--;
-            m_portsOrch->setPort(vlan.m_alias, vlan);
+            m_portsOrch->decrFdbCount(vlan->m_alias, 1);
         }
         storeFdbEntryState(update);
 
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyFdbChange(update);
 
         notifyTunnelOrch(update.port);
         break;
@@ -618,7 +603,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
         update.sai_fdb_type = SAI_FDB_ENTRY_TYPE_DYNAMIC;
         storeFdbEntryState(update);
 
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyFdbChange(update);
 
         notifyTunnelOrch(port_old);
 
@@ -632,8 +617,8 @@ void FdbOrch::update(sai_fdb_event_t        type,
                        bridge_port_id);
 
         string vlanName = "-";
-        if (!vlan.m_alias.empty()) {
-            vlanName = "Vlan" + to_string(vlan.m_vlan_info.vlan_id);
+        if (vlan) {
+            vlanName = "Vlan" + to_string(vlan->m_vlan_info.vlan_id);
         }
 
         SWSS_LOG_INFO("FDB Flush: [ %s , %s ] = { port: %s }", update.entry.mac.to_string().c_str(),
@@ -731,193 +716,225 @@ void FdbOrch::doTask(Consumer& consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
-
-        /* format: <VLAN_name>:<MAC_address> */
-        vector<string> keys = tokenize(kfvKey(t), ':', 1);
-        string op = kfvOp(t);
+        // FDB entries added or removed with the FDB bulker, in m_toSync order
+        std::deque<std::pair<SyncMap::iterator, FdbBulkContext>> toBulk;
+        std::set<FdbEntry> bulkEntries;
 
-        Port vlan;
-        if (!m_portsOrch->getPort(keys[0], vlan))
+        while (it != consumer.m_toSync.end())
         {
-            SWSS_LOG_INFO("Failed to locate %s", keys[0].c_str());
-            if(op == DEL_COMMAND)
-            {
-                /* Delete if it is in saved_fdb_entry */
-                unsigned short vlan_id;
-                try {
-                    vlan_id = (unsigned short) stoi(keys[0].substr(4));
-                } catch(exception &e) {
-                    it = consumer.m_toSync.erase(it);
-                    continue;
-                }
-                deleteFdbEntryFromSavedFDB(MacAddress(keys[1]), vlan_id, origin);
-
-                it = consumer.m_toSync.erase(it);
-            }
-            else
-            {
-                it++;
-            }
-            continue;
-        }
+            KeyOpFieldsValuesTuple t = it->second;
 
-        FdbEntry entry;
-        entry.mac = MacAddress(keys[1]);
-        entry.bv_id = vlan.m_vlan_info.vlan_oid;
+            /* format: <VLAN_name>:<MAC_address> */
+            vector<string> keys = tokenize(kfvKey(t), ':', 1);
+            string op = kfvOp(t);
 
-        if (op == SET_COMMAND)
-        {
-            string port = "";
-            string type = "dynamic";
-            string remote_ip = "";
-            string esi = "";
-            unsigned int vni = 0;
-            string sticky = "";
-            string discard = "false";
-
-            for (auto i : kfvFieldsValues(t))
+            Port vlan;
+            if (!m_portsOrch->getPort(keys[0], vlan))
             {
-                if (fvField(i) == "port")
+                SWSS_LOG_INFO("Failed to locate %s", keys[0].c_str());
+                if(op == DEL_COMMAND)
                 {
-                    port = fvValue(i);
-                }
+                    /* Delete if it is in saved_fdb_entry */
+                    unsigned short vlan_id;
+                    try {
+                        vlan_id = (unsigned short) stoi(keys[0].substr(4));
+                    } catch(exception &e) {
+                        it = consumer.m_toSync.erase(it);
+                        continue;
+                    }
+                    deleteFdbEntryFromSavedFDB(MacAddress(keys[1]), vlan_id, origin);
 
-                if (fvField(i) == "type")
-                {
-                    type = fvValue(i);
+                    it = consumer.m_toSync.erase(it);
                 }
-                if (fvField(i) == "discard")
+                else
                 {
-                    discard = fvValue(i);
+                    it++;
                 }
+                continue;
+            }
 
-                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
+            FdbEntry entry;
+            entry.mac = MacAddress(keys[1]);
+            entry.bv_id = vlan.m_vlan_info.vlan_oid;
+
+            /* A second task of an entry waits for the result of the first one */
+            if (bulkEntries.count(entry))
+            {
+                break;
+            }
+
+            if (op == SET_COMMAND)
+            {
+                string port = "";
+                string type = "dynamic";
+                string remote_ip = "";
+                string esi = "";
+                unsigned int vni = 0;
+                string sticky = "";
+                string discard = "false";
+
+                for (auto i : kfvFieldsValues(t))
                 {
-                    if (fvField(i) == "remote_vtep")
+                    if (fvField(i) == "port")
                     {
-                        remote_ip = fvValue(i);
-                        // Creating an IpAddress object to validate if remote_ip is valid
-                        // if invalid it will throw the exception and we will ignore the
-                        // event
-                        try {
-                            IpAddress valid_ip = IpAddress(remote_ip);
-                            (void)valid_ip; // To avoid g++ warning
-                        } catch(exception &e) {
-                            SWSS_LOG_NOTICE("Invalid IP address in remote MAC %s", remote_ip.c_str());
-                            remote_ip = "";
-                            break;
-                        }
+                        port = fvValue(i);
                     }
 
-                    if (fvField(i) == "esi")
+                    if (fvField(i) == "type")
+                    {
+                        type = fvValue(i);
+                    }
+                    if (fvField(i) == "discard")
                     {
-                        esi = fvValue(i);
+                        discard = fvValue(i);
                     }
 
-                    if (fvField(i) == "vni")
+                    if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
                     {
-                        try {
-                            vni = (unsigned int) stoi(fvValue(i));
-                        } catch(exception &e) {
-                            SWSS_LOG_INFO("Invalid VNI in remote MAC %s", fvValue(i).c_str());
-                            vni = 0;
-                            break;
+                        if (fvField(i) == "remote_vtep")
+                        {
+                            remote_ip = fvValue(i);
+                            // Creating an IpAddress object to validate if remote_ip is valid
+                            // if invalid it will throw the exception and we will ignore the
+                            // event
+                            try {
+                                IpAddress valid_ip = IpAddress(remote_ip);
+                                (void)valid_ip; // To avoid g++ warning
+                            } catch(exception &e) {
+                                SWSS_LOG_NOTICE("Invalid IP address in remote MAC %s", remote_ip.c_str());
+                                remote_ip = "";
+                                break;
+                            }
+                        }
+
+                        if (fvField(i) == "esi")
+                        {
+                            esi = fvValue(i);
+                        }
+
+                        if (fvField(i) == "vni")
+                        {
+                            try {
+                                vni = (unsigned int) stoi(fvValue(i));
+                            } catch(exception &e) {
+                                SWSS_LOG_INFO("Invalid VNI in remote MAC %s", fvValue(i).c_str());
+                                vni = 0;
+                                break;
+                            }
                         }
                     }
                 }
-            }
 
-            /* FDB type is either dynamic or static */
-            assert(type == "dynamic" || type == "dynamic_local" || type == "static" );
-
-            if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
-            {
-                VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
+                /* FDB type is either dynamic or static */
+                assert(type == "dynamic" || type == "dynamic_local" || type == "static" );
 
-                if (tunnel_orch->isDipTunnelsSupported())
+                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
                 {
-                    if(!remote_ip.length())
+                    VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
+
+                    if (tunnel_orch->isDipTunnelsSupported())
                     {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
+                        if(!remote_ip.length())
+                        {
+                            it = consumer.m_toSync.erase(it);
+                            continue;
+                        }
+                        port = tunnel_orch->getTunnelPortName(remote_ip);
+                    }
+                    else
+                    {
+                        EvpnNvoOrch* evpn_nvo_orch = gDirectory.get<EvpnNvoOrch*>();
+                        VxlanTunnel* sip_tunnel = evpn_nvo_orch->getEVPNVtep();
+                        if (sip_tunnel == NULL)
+                        {
+                            it = consumer.m_toSync.erase(it);
+                            continue;
+                        }
+                        port = tunnel_orch->getTunnelPortName(sip_tunnel->getSrcIP().to_string(), true);
                     }
-                    port = tunnel_orch->getTunnelPortName(remote_ip);
+                }
+
+                // set entry port_name, which is used in mux fdb update logic
+                entry.port_name = port;
+
+                FdbData fdbData;
+                fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
+                fdbData.type = type;
+                fdbData.origin = origin;
+                fdbData.remote_ip = remote_ip;
+                fdbData.esi = esi;
+                fdbData.vni = vni;
+                fdbData.is_flush_pending = false;
+                fdbData.discard = discard;
+
+                toBulk.emplace_back(std::piecewise_construct, std::forward_as_tuple(it), std::forward_as_tuple(entry));
+                if (addFdbEntryPre(toBulk.back().second, port, fdbData, true))
+                {
+                    bulkEntries.insert(entry);
                 }
                 else
                 {
-                    EvpnNvoOrch* evpn_nvo_orch = gDirectory.get<EvpnNvoOrch*>();
-                    VxlanTunnel* sip_tunnel = evpn_nvo_orch->getEVPNVtep();
-                    if (sip_tunnel == NULL)
-                    {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
-                    }
-                    port = tunnel_orch->getTunnelPortName(sip_tunnel->getSrcIP().to_string(), true);
+                    toBulk.pop_back();
                 }
+                it++;
             }
-
-            // set entry port_name, which is used in mux fdb update logic
-            entry.port_name = port;
-
-            FdbData fdbData;
-            fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
-            fdbData.type = type;
-            fdbData.origin = origin;
-            fdbData.remote_ip = remote_ip;
-            fdbData.esi = esi;
-            fdbData.vni = vni;
-            fdbData.is_flush_pending = false;
-            fdbData.discard = discard;
-            if (addFdbEntry(entry, port, fdbData))
+            else if (op == DEL_COMMAND)
             {
-                if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
+                toBulk.emplace_back(std::piecewise_construct, std::forward_as_tuple(it), std::forward_as_tuple(entry));
+                if (removeFdbEntryPre(toBulk.back().second, origin, true))
                 {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-                    if (type == "dynamic_local")
-                    {
-                        m_mclagFdbStateTable.del(key);
-                    }
+                    bulkEntries.insert(entry);
                 }
-
-                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
+                else
                 {
-                    VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
-
-                    if(!remote_ip.length())
-                    {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
-                    }
-                    port = tunnel_orch->getTunnelPortName(remote_ip);
+                    toBulk.pop_back();
                 }
-                it = consumer.m_toSync.erase(it);
+                it++;
             }
             else
-                it++;
+            {
+                SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
+                it = consumer.m_toSync.erase(it);
+            }
         }
-        else if (op == DEL_COMMAND)
+
+        // Flush the FDB bulker, m_entries and saved_fdb_entries follow the results
+        m_fdbBulker.flush();
+
+        for (auto& bulk: toBulk)
         {
-            if (removeFdbEntry(entry, origin))
+            auto& ctx = bulk.second;
+            string op = kfvOp(bulk.first->second);
+            string key = "Vlan" + to_string(ctx.vlan_id) + ":" + ctx.entry.mac.to_string();
+
+            if (op == SET_COMMAND)
+            {
+                if (!addFdbEntryPost(ctx))
+                {
+                    continue;
+                }
+
+                if ((origin == FDB_ORIGIN_MCLAG_ADVERTIZED) && (ctx.fdbData.type == "dynamic_local"))
+                {
+                    m_mclagFdbStateTable.del(key);
+                }
+            }
+            else
             {
+                if (!removeFdbEntryPost(ctx))
+                {
+                    continue;
+                }
+
                 if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
                 {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
                     m_mclagFdbStateTable.del(key);
                     SWSS_LOG_NOTICE("fdbEvent: do Task Delete MCLAG FDB from state mclag remote fdb table: "
-                            "Mac: %s Vlan: %d ",entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id );
+                            "Mac: %s Vlan: %d ", ctx.entry.mac.to_string().c_str(), ctx.vlan_id);
                 }
-
-                it = consumer.m_toSync.erase(it);
             }
-            else
-                it++;
 
-        }
-        else
-        {
-            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            consumer.m_toSync.erase(bulk.first);
         }
     }
 }
@@ -940,6 +957,31 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
     Port port;
     Port vlanPort;
 
+    if (&consumer == m_fdbNotificationConsumer)
+    {
+        // After a topology change the MACs are learned faster than they are
+        // notified one by one. All the queued notifications make one batch:
+        // each MAC is written once to STATE_DB, in one pipelined write, and
+        // the observers get the changes once the batch is done.
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        consumer.pops(entries);
+
+        EventBatch batch;
+        m_batchStateWrites = true;
+
+        for (auto &entry : entries)
+        {
+            if (kfvOp(entry) == "fdb_event")
+            {
+                handleFdbEventNotification(kfvKey(entry));
+            }
+        }
+
+        m_batchStateWrites = false;
+        flushFdbState();
+        return;
+    }
+
     consumer.pop(op, data, values);
 
     if (&consumer == m_flushNotificationsConsumer)
@@ -958,7 +1000,7 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
             }
 
             if (status == SAI_STATUS_SUCCESS) {
-                for (map<FdbEntry, FdbData>::iterator it = m_entries.begin();
+                for (auto it = m_entries.begin();
                         it != m_entries.end(); it++)
                 {
                     it->second.is_flush_pending = true;
@@ -1047,34 +1089,35 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
             return;
         }
     }
-    else if (&consumer == m_fdbNotificationConsumer && op == "fdb_event")
+}
+
+void FdbOrch::handleFdbEventNotification(const string& data)
+{
+    uint32_t count;
+    sai_fdb_event_notification_data_t *fdbevent = nullptr;
+    sai_deserialize_fdb_event_ntf(data, count, &fdbevent);
+
+    for (uint32_t i = 0; i < count; ++i)
     {
-        uint32_t count;
-        sai_fdb_event_notification_data_t *fdbevent = nullptr;
-        sai_deserialize_fdb_event_ntf(data, count, &fdbevent);
+        sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+        sai_fdb_entry_type_t sai_fdb_type = SAI_FDB_ENTRY_TYPE_DYNAMIC;
 
-        for (uint32_t i = 0; i < count; ++i)
+        for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
         {
-            sai_object_id_t oid = SAI_NULL_OBJECT_ID;
-            sai_fdb_entry_type_t sai_fdb_type = SAI_FDB_ENTRY_TYPE_DYNAMIC;
-
-            for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
+            if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
             {
-                if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
-                {
-                    oid = fdbevent[i].attr[j].value.oid;
-                }
-                else if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_TYPE)
-                {
-                    sai_fdb_type = (sai_fdb_entry_type_t)fdbevent[i].attr[j].value.s32;
-                }
+                oid = fdbevent[i].attr[j].value.oid;
+            }
+            else if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_TYPE)
+            {
+                sai_fdb_type = (sai_fdb_entry_type_t)fdbevent[i].attr[j].value.s32;
             }
-
-            this->update(fdbevent[i].event_type, &fdbevent[i].fdb_entry, oid, sai_fdb_type);
         }
 
-        sai_deserialize_free_fdb_event_ntf(count, fdbevent);
+        this->update(fdbevent[i].event_type, &fdbevent[i].fdb_entry, oid, sai_fdb_type);
     }
+
+    sai_deserialize_free_fdb_event_ntf(count, fdbevent);
 }
 
 /*
@@ -1134,16 +1177,20 @@ void FdbOrch::flushFDBEntries(sai_object_id_t bridge_port_oid,
     }
 
     if (SAI_STATUS_SUCCESS == rv) {
-        for (map<FdbEntry, FdbData>::iterator it = m_entries.begin();
-                it != m_entries.end(); it++)
+        vector<FdbEntry> entries;
+        if (bridge_port_oid != SAI_NULL_OBJECT_ID)
         {
-            if ((bridge_port_oid != SAI_NULL_OBJECT_ID &&
-                    it->second.bridge_port_id == bridge_port_oid) ||
-                    (vlan_oid != SAI_NULL_OBJECT_ID &&
-                    it->first.bv_id == vlan_oid))
-            {
-                it->second.is_flush_pending = true;
-            }
+            entries = m_entries.getBridgePortEntries(bridge_port_oid);
+        }
+        if (vlan_oid != SAI_NULL_OBJECT_ID)
+        {
+            auto vlan_entries = m_entries.getBridgeEntries(vlan_oid);
+            entries.insert(entries.end(), vlan_entries.begin(), vlan_entries.end());
+        }
+
+        for (const auto& entry : entries)
+        {
+            m_entries[entry].is_flush_pending = true;
         }
     }
 }
@@ -1182,16 +1229,15 @@ void FdbOrch::notifyObserversFDBFlush(Port &port, sai_object_id_t& bvid)
     FdbFlushUpdate flushUpdate;
     flushUpdate.port = port;
 
-    for (auto itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+    for (const auto& itr : m_entries.getBridgeEntries(bvid))
     {
-        if ((itr->first.port_name == port.m_alias) &&
-            (itr->first.bv_id == bvid))
+        if (itr.port_name == port.m_alias)
         {
             SWSS_LOG_INFO("Adding MAC learnt on [ port:%s , bvid:0x%" PRIx64 "]\
                            to ARP flush", port.m_alias.c_str(), bvid);
             FdbEntry entry;
-            entry.mac = itr->first.mac;
-            entry.bv_id = itr->first.bv_id;
+            entry.mac = itr.mac;
+            entry.bv_id = itr.bv_id;
             flushUpdate.entries.push_back(entry);
         }
     }
@@ -1270,7 +1316,7 @@ void FdbOrch::updateVlanMember(const VlanMemberUpdate& update)
             }
             else
             {
-                saved_fdb_entries[port_name].push_back(fdb);
+                saveFdbEntry(port_name, fdb);
             }
         }
     }
@@ -1278,10 +1324,24 @@ void FdbOrch::updateVlanMember(const VlanMemberUpdate& update)
 
 bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         FdbData fdbData)
+{
+    FdbBulkContext ctx(entry);
+
+    if (!addFdbEntryPre(ctx, port_name, fdbData, false))
+    {
+        return false;
+    }
+
+    return addFdbEntryPost(ctx);
+}
+
+bool FdbOrch::addFdbEntryPre(FdbBulkContext& ctx, const string& port_name,
+        FdbData fdbData, bool bulk)
 {
     Port vlan;
     Port port;
     string end_point_ip = "";
+    const FdbEntry& entry = ctx.entry;
 
     VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
 
@@ -1296,12 +1356,15 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         return false;
     }
 
+    ctx.port_name = port_name;
+    ctx.vlan_id = vlan.m_vlan_info.vlan_id;
+    ctx.fdbData = fdbData;
+
     /* Retry until port is created */
     if (!m_portsOrch->getPort(port_name, port) || (port.m_bridge_port_id == SAI_NULL_OBJECT_ID))
     {
         SWSS_LOG_INFO("Saving a fdb entry until port %s becomes active", port_name.c_str());
-        saved_fdb_entries[port_name].push_back({entry.mac,
-                vlan.m_vlan_info.vlan_id, fdbData});
+        ctx.saved = true;
         return true;
     }
 
@@ -1315,12 +1378,10 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     if (!m_portsOrch->isVlanMember(vlan, port, end_point_ip))
     {
         SWSS_LOG_INFO("Saving a fdb entry until port %s becomes vlan %s member", port_name.c_str(), vlan.m_alias.c_str());
-        saved_fdb_entries[port_name].push_back({entry.mac,
-                vlan.m_vlan_info.vlan_id, fdbData});
+        ctx.saved = true;
         return true;
     }
 
-    sai_status_t status;
     sai_fdb_entry_t fdb_entry;
     fdb_entry.switch_id = gSwitchId;
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
@@ -1421,7 +1482,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     }
 
     sai_attribute_t attr;
-    vector<sai_attribute_t> attrs;
+    vector<sai_attribute_t>& attrs = ctx.attrs;
 
     attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
     if (fdbData.origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
@@ -1436,7 +1497,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     {
         attr.value.s32 = (fdbData.type == "dynamic") ? SAI_FDB_ENTRY_TYPE_DYNAMIC : SAI_FDB_ENTRY_TYPE_STATIC;
     }
-    fdbData.sai_fdb_type = (sai_fdb_entry_type_t)attr.value.s32;
+    ctx.fdbData.sai_fdb_type = (sai_fdb_entry_type_t)attr.value.s32;
 
     attrs.push_back(attr);
 
@@ -1504,59 +1565,132 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                 entry.mac.to_string().c_str(), vlan.m_alias.c_str(), oldPort.m_alias.c_str(),
                 port_name.c_str(), oldType.c_str(), fdbData.type.c_str(),
                 oldOrigin, fdbData.origin);
-        for (auto itr : attrs)
+
+        ctx.mac_update = true;
+        ctx.old_port = oldPort.m_alias;
+        ctx.old_type = oldType;
+        ctx.old_origin = oldOrigin;
+
+        for (const auto& itr : attrs)
+        {
+            ctx.object_statuses.emplace_back();
+            if (bulk)
+            {
+                m_fdbBulker.set_entry_attribute(&ctx.object_statuses.back(), &fdb_entry, &itr);
+                continue;
+            }
+
+            ctx.object_statuses.back() = sai_fdb_api->set_fdb_entry_attribute(&fdb_entry, &itr);
+            if (ctx.object_statuses.back() != SAI_STATUS_SUCCESS)
+            {
+                break;
+            }
+        }
+    }
+    else
+    {
+        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
+
+        ctx.object_statuses.emplace_back();
+        if (bulk)
+        {
+            m_fdbBulker.create_entry(&ctx.object_statuses.back(), &fdb_entry, (uint32_t)attrs.size(), attrs.data());
+        }
+        else
+        {
+            ctx.object_statuses.back() = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
+        }
+    }
+
+    return true;
+}
+
+bool FdbOrch::addFdbEntryPost(FdbBulkContext& ctx)
+{
+    const Port *vlan = nullptr;
+    const Port *port = nullptr;
+    const FdbEntry& entry = ctx.entry;
+    const FdbData& fdbData = ctx.fdbData;
+    const string& port_name = ctx.port_name;
+    const string& oldType = ctx.old_type;
+    FdbOrigin oldOrigin = ctx.old_origin;
+    bool macUpdate = ctx.mac_update;
+
+    SWSS_LOG_ENTER();
+
+    if (ctx.saved)
+    {
+        saveFdbEntry(port_name, {entry.mac, ctx.vlan_id, fdbData});
+        return true;
+    }
+
+    /* Duplicate or ignored update */
+    if (ctx.object_statuses.empty())
+    {
+        return true;
+    }
+
+    vlan = m_portsOrch->findPort(entry.bv_id);
+    port = m_portsOrch->findPort(port_name);
+    if (!vlan || !port)
+    {
+        SWSS_LOG_ERROR("Failed to locate vlan 0x%" PRIx64 " or port %s of FDB %s",
+                entry.bv_id, port_name.c_str(), entry.mac.to_string().c_str());
+        return false;
+    }
+
+    if (macUpdate)
+    {
+        auto attr_it = ctx.attrs.begin();
+        for (auto status : ctx.object_statuses)
         {
-            status = sai_fdb_api->set_fdb_entry_attribute(&fdb_entry, &itr);
             if (status != SAI_STATUS_SUCCESS)
             {
                 SWSS_LOG_ERROR("macUpdate-Failed for attr.id=0x%x for FDB %s in %s on %s, rv:%d",
-                            itr.id, entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str(), status);
+                            attr_it->id, entry.mac.to_string().c_str(), vlan->m_alias.c_str(), port_name.c_str(), status);
                 task_process_status handle_status = handleSaiSetStatus(SAI_API_FDB, status);
                 if (handle_status != task_success)
                 {
                     return parseHandleSaiStatusFailure(handle_status);
                 }
             }
+            attr_it++;
         }
-        if (oldPort.m_bridge_port_id != port.m_bridge_port_id)
+
+        auto oldPort = m_portsOrch->findPort(ctx.old_port);
+        if (oldPort && (oldPort->m_bridge_port_id != port->m_bridge_port_id))
         {
-            oldPort.m_fdb_count--;
-            m_portsOrch->setPort(oldPort.m_alias, oldPort);
-            port.m_fdb_count++;
-            m_portsOrch->setPort(port.m_alias, port);
+            m_portsOrch->decrFdbCount(oldPort->m_alias, 1);
+            m_portsOrch->incrFdbCount(port->m_alias, 1);
         }
     }
     else
     {
-        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
-
-        status = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
+        sai_status_t status = ctx.object_statuses.front();
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to create %s FDB %s in %s on %s, rv:%d",
                     fdbData.type.c_str(), entry.mac.to_string().c_str(),
-                    vlan.m_alias.c_str(), port_name.c_str(), status);
+                    vlan->m_alias.c_str(), port_name.c_str(), status);
             task_process_status handle_status = handleSaiCreateStatus(SAI_API_FDB, status); //FIXME: it should be based on status. Some could be retried, some not
             if (handle_status != task_success)
             {
                 return parseHandleSaiStatusFailure(handle_status);
             }
         }
-        port.m_fdb_count++;
-        m_portsOrch->setPort(port.m_alias, port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        m_portsOrch->incrFdbCount(port->m_alias, 1);
+        m_portsOrch->incrFdbCount(vlan->m_alias, 1);
     }
 
     FdbData storeFdbData = fdbData;
-    storeFdbData.bridge_port_id = port.m_bridge_port_id;
+    storeFdbData.bridge_port_id = port->m_bridge_port_id;
     // overwrite the type and origin
     if ((fdbData.origin == FDB_ORIGIN_MCLAG_ADVERTIZED) && (fdbData.type == "dynamic_local"))
     {
         //If the MAC is dynamic_local change the origin accordingly
         //MAC is added/updated as dynamic to allow aging.
         SWSS_LOG_INFO("MAC-Update Modify to dynamic FDB %s in %s on from-%s:to-%s from-%s:to-%s origin-%d-to-%d",
-                entry.mac.to_string().c_str(), vlan.m_alias.c_str(), oldPort.m_alias.c_str(),
+                entry.mac.to_string().c_str(), vlan->m_alias.c_str(), ctx.old_port.c_str(),
                 port_name.c_str(), oldType.c_str(), fdbData.type.c_str(), 
                 oldOrigin, fdbData.origin);
 
@@ -1564,9 +1698,9 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         storeFdbData.type = "dynamic";
     }
 
-    m_entries[entry] = storeFdbData;
+    m_entries.set(entry, storeFdbData);
 
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+    string key = "Vlan" + to_string(vlan->m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
 
     if (((fdbData.origin != FDB_ORIGIN_MCLAG_ADVERTIZED) &&
          (fdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED)) ||
@@ -1581,7 +1715,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
             fvs.push_back(FieldValueTuple("type", "dynamic"));
         else
             fvs.push_back(FieldValueTuple("type", fdbData.type));
-        m_fdbStateTable.set(key, fvs);
+        setFdbState(key, fvs);
     }
 
     else if (macUpdate && (oldOrigin != FDB_ORIGIN_MCLAG_ADVERTIZED) &&
@@ -1591,7 +1725,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
          * so delete from StateDb since we only keep local fdbs
          * in state-db
          */
-        m_fdbStateTable.del(key);
+        delFdbState(key);
     }
 
     if ((fdbData.origin == FDB_ORIGIN_MCLAG_ADVERTIZED) && (fdbData.type != "dynamic_local"))
@@ -1603,14 +1737,14 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
 
         SWSS_LOG_NOTICE("fdbEvent: AddFdbEntry: Add MCLAG MAC with state mclag remote fdb table "
               "Mac: %s Vlan: %d port:%s type:%s", entry.mac.to_string().c_str(),
-              vlan.m_vlan_info.vlan_id, port_name.c_str(), fdbData.type.c_str());
+              vlan->m_vlan_info.vlan_id, port_name.c_str(), fdbData.type.c_str());
     }
     else if (macUpdate && (oldOrigin == FDB_ORIGIN_MCLAG_ADVERTIZED) &&
             (fdbData.origin != FDB_ORIGIN_MCLAG_ADVERTIZED))
     {
         SWSS_LOG_NOTICE("fdbEvent: AddFdbEntry: del MCLAG MAC from state MCLAG remote fdb table "
                     "Mac: %s Vlan: %d port:%s type:%s", entry.mac.to_string().c_str(),
-                    vlan.m_vlan_info.vlan_id, port_name.c_str(), fdbData.type.c_str());
+                    vlan->m_vlan_info.vlan_id, port_name.c_str(), fdbData.type.c_str());
         m_mclagFdbStateTable.del(key);
     }
 
@@ -1621,42 +1755,57 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
 
     FdbUpdate update;
     update.entry = entry;
-    update.port = port;
+    update.port = *port;
     update.type = fdbData.type;
     update.add = true;
 
-    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+    notifyFdbChange(update);
 
     return true;
 }
 
 bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
 {
-    Port vlan;
-    Port port;
+    FdbBulkContext ctx(entry);
+
+    if (!removeFdbEntryPre(ctx, origin, false))
+    {
+        return false;
+    }
+
+    return removeFdbEntryPost(ctx);
+}
+
+bool FdbOrch::removeFdbEntryPre(FdbBulkContext& ctx, FdbOrigin origin, bool bulk)
+{
+    const Port *port = nullptr;
+    const FdbEntry& entry = ctx.entry;
 
     SWSS_LOG_ENTER();
 
     SWSS_LOG_INFO("FdbOrch RemoveFDBEntry: mac=%s bv_id=0x%" PRIx64 "origin %d", entry.mac.to_string().c_str(), entry.bv_id, origin);
 
-    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    if (!m_portsOrch->getVlanId(entry.bv_id, ctx.vlan_id))
     {
         SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry.bv_id);
         return false;
     }
 
+    ctx.origin = origin;
+
     auto it= m_entries.find(entry);
     if (it == m_entries.end())
     {
         SWSS_LOG_INFO("FdbOrch RemoveFDBEntry: FDB entry isn't found. mac=%s bv_id=0x%" PRIx64, entry.mac.to_string().c_str(), entry.bv_id);
 
         /* check whether the entry is in the saved fdb, if so delete it from there. */
-        deleteFdbEntryFromSavedFDB(entry.mac, vlan.m_vlan_info.vlan_id, origin);
+        ctx.saved = true;
         return true;
     }
 
     FdbData fdbData = it->second;
-    if (!m_portsOrch->getPortByBridgePortId(fdbData.bridge_port_id, port))
+    port = m_portsOrch->findPortByBridgePortId(fdbData.bridge_port_id);
+    if (!port)
     {
         SWSS_LOG_NOTICE("FdbOrch RemoveFDBEntry: Failed to locate port from bridge_port_id 0x%" PRIx64, fdbData.bridge_port_id);
         return false;
@@ -1665,12 +1814,12 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
     if (fdbData.origin != origin)
     {
         if ((origin == FDB_ORIGIN_MCLAG_ADVERTIZED) && (fdbData.origin == FDB_ORIGIN_LEARN) &&
-                        (port.m_oper_status == SAI_PORT_OPER_STATUS_DOWN) && (gMlagOrch->isMlagInterface(port.m_alias)))
+                        (port->m_oper_status == SAI_PORT_OPER_STATUS_DOWN) && (gMlagOrch->isMlagInterface(port->m_alias)))
         {
             //check if the local MCLAG port is down, if yes then continue delete the local MAC
-            origin = FDB_ORIGIN_LEARN;
+            ctx.origin = FDB_ORIGIN_LEARN;
             SWSS_LOG_INFO("FdbOrch RemoveFDBEntry: mac=%s fdb del origin is MCLAG; delete local mac as port %s is down",
-                entry.mac.to_string().c_str(), port.m_alias.c_str());
+                entry.mac.to_string().c_str(), port->m_alias.c_str());
         }
         else
         {
@@ -1686,21 +1835,53 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
             /* We may still have the mac in saved-fdb probably due to unavailability
              * of bridge-port. check whether the entry is in the saved fdb,
              * if so delete it from there. */
-            deleteFdbEntryFromSavedFDB(entry.mac, vlan.m_vlan_info.vlan_id, origin);
-
+            ctx.saved = true;
             return true;
         }
     }
 
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+    ctx.fdbData = fdbData;
+    ctx.port_name = port->m_alias;
 
-    sai_status_t status;
     sai_fdb_entry_t fdb_entry;
     fdb_entry.switch_id = gSwitchId;
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
-    status = sai_fdb_api->remove_fdb_entry(&fdb_entry);
+    ctx.object_statuses.emplace_back();
+    if (bulk)
+    {
+        m_fdbBulker.remove_entry(&ctx.object_statuses.back(), &fdb_entry);
+    }
+    else
+    {
+        ctx.object_statuses.back() = sai_fdb_api->remove_fdb_entry(&fdb_entry);
+    }
+
+    return true;
+}
+
+bool FdbOrch::removeFdbEntryPost(FdbBulkContext& ctx)
+{
+    const Port *vlan = nullptr;
+    const Port *port = nullptr;
+    const FdbEntry& entry = ctx.entry;
+    const FdbData& fdbData = ctx.fdbData;
+
+    SWSS_LOG_ENTER();
+
+    if (ctx.saved)
+    {
+        deleteFdbEntryFromSavedFDB(entry.mac, ctx.vlan_id, ctx.origin);
+        return true;
+    }
+
+    if (ctx.object_statuses.empty())
+    {
+        return true;
+    }
+
+    sai_status_t status = ctx.object_statuses.front();
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("FdbOrch RemoveFDBEntry: Failed to remove FDB entry. mac=%s, bv_id=0x%" PRIx64,
@@ -1712,40 +1893,54 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         }
     }
 
+    vlan = m_portsOrch->findPort(entry.bv_id);
+    port = m_portsOrch->findPort(ctx.port_name);
+    if (!vlan || !port)
+    {
+        SWSS_LOG_ERROR("Failed to locate vlan 0x%" PRIx64 " or port %s of removed FDB %s",
+                entry.bv_id, ctx.port_name.c_str(), entry.mac.to_string().c_str());
+        return false;
+    }
+
+    string key = "Vlan" + to_string(ctx.vlan_id) + ":" + entry.mac.to_string();
+
     SWSS_LOG_INFO("Removed mac=%s bv_id=0x%" PRIx64 " port:%s",
-            entry.mac.to_string().c_str(), entry.bv_id, port.m_alias.c_str());
+            entry.mac.to_string().c_str(), entry.bv_id, port->m_alias.c_str());
 
-    port.m_fdb_count--;
-    m_portsOrch->setPort(port.m_alias, port);
-    vlan.m_fdb_count--;
-    m_portsOrch->setPort(vlan.m_alias, vlan);
+    m_portsOrch->decrFdbCount(port->m_alias, 1);
+    m_portsOrch->decrFdbCount(vlan->m_alias, 1);
     (void)m_entries.erase(entry);
 
     // Remove in StateDb
     if ((fdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED) && (fdbData.origin != FDB_ORIGIN_MCLAG_ADVERTIZED))
     {
-        m_fdbStateTable.del(key);
+        delFdbState(key);
     }
 
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
 
     FdbUpdate update;
     update.entry = entry;
-    update.port = port;
+    update.port = *port;
     update.type = fdbData.type;
     update.add = false;
 
-    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+    notifyFdbChange(update);
 
     notifyTunnelOrch(update.port);
 
     return true;
 }
 
+void FdbOrch::saveFdbEntry(const string& port_name, const SavedFdbEntry& entry)
+{
+    saved_fdb_entries[port_name].push_back(entry);
+    m_savedFdbPorts[{entry.mac, entry.vlanId}].insert(port_name);
+}
+
 void FdbOrch::deleteFdbEntryFromSavedFDB(const MacAddress &mac,
         const unsigned short &vlanId, FdbOrigin origin, const string portName)
 {
-    bool found=false;
     SavedFdbEntry entry;
     entry.mac = mac;
     entry.vlanId = vlanId;
@@ -1753,43 +1948,119 @@ void FdbOrch::deleteFdbEntryFromSavedFDB(const MacAddress &mac,
     /* Below members are unused during delete compare */
     entry.fdbData.origin = origin;
 
-    for (auto& itr: saved_fdb_entries)
+    /* Only the ports the entry was saved on are searched */
+    auto ports = m_savedFdbPorts.find({mac, vlanId});
+    if (ports == m_savedFdbPorts.end())
     {
-        if (portName.empty() || (portName == itr.first))
+        return;
+    }
+
+    for (auto port = ports->second.begin(); port != ports->second.end();)
+    {
+        if (!portName.empty() && portName != *port)
+        {
+            port++;
+            continue;
+        }
+
+        bool found = false;
+        bool saved = false;
+        auto& fdb_list = saved_fdb_entries[*port];
+        auto iter = fdb_list.begin();
+        while (iter != fdb_list.end())
         {
-            auto iter = saved_fdb_entries[itr.first].begin();
-            while(iter != saved_fdb_entries[itr.first].end())
+            if (*iter == entry)
             {
-                if (*iter == entry)
+                if (!found && iter->fdbData.origin == origin)
                 {
-                    if (iter->fdbData.origin == origin)
-                    {
-                        SWSS_LOG_INFO("FDB entry found in saved fdb. deleting..."
-                                "mac=%s vlan_id=0x%x origin:%d port:%s",
-                                mac.to_string().c_str(), vlanId, origin,
-                                itr.first.c_str());
-                        saved_fdb_entries[itr.first].erase(iter);
-
-                        found=true;
-                        break;
-                    }
-                    else
-                    {
-                        SWSS_LOG_INFO("FDB entry found in saved fdb, but Origin is "
-                                "different mac=%s vlan_id=0x%x reqOrigin:%d "
-                                "foundOrigin:%d port:%s, IGNORED",
-                                mac.to_string().c_str(), vlanId, origin,
-                                iter->fdbData.origin, itr.first.c_str());
-                    }
+                    SWSS_LOG_INFO("FDB entry found in saved fdb. deleting..."
+                            "mac=%s vlan_id=0x%x origin:%d port:%s",
+                            mac.to_string().c_str(), vlanId, origin,
+                            port->c_str());
+                    iter = fdb_list.erase(iter);
+
+                    found = true;
+                    continue;
+                }
+                else if (!found)
+                {
+                    SWSS_LOG_INFO("FDB entry found in saved fdb, but Origin is "
+                            "different mac=%s vlan_id=0x%x reqOrigin:%d "
+                            "foundOrigin:%d port:%s, IGNORED",
+                            mac.to_string().c_str(), vlanId, origin,
+                            iter->fdbData.origin, port->c_str());
                 }
-                iter++;
+                saved = true;
             }
+            iter++;
         }
+
+        // Ports no longer holding the entry are dropped from the index
+        port = saved ? std::next(port) : ports->second.erase(port);
+
         if (found)
+        {
             break;
+        }
+    }
+
+    if (ports->second.empty())
+    {
+        m_savedFdbPorts.erase(ports);
     }
 }
 
+void FdbOrch::setFdbState(const string& key, const vector<FieldValueTuple>& fvs)
+{
+    if (m_batchStateWrites)
+    {
+        m_pendingFdbState[key].fvs = fvs;
+    }
+    else
+    {
+        m_fdbStateTable.set(key, fvs);
+    }
+}
+
+void FdbOrch::delFdbState(const string& key)
+{
+    if (m_batchStateWrites)
+    {
+        auto &pending = m_pendingFdbState[key];
+        pending.del = true;
+        pending.fvs.clear();
+    }
+    else
+    {
+        m_fdbStateTable.del(key);
+    }
+}
+
+void FdbOrch::flushFdbState()
+{
+    for (const auto &it : m_pendingFdbState)
+    {
+        // A MAC aged and learned again in the batch is replaced, not merged
+        if (it.second.del)
+        {
+            m_fdbStateWriter->del(it.first);
+        }
+        if (!it.second.fvs.empty())
+        {
+            m_fdbStateWriter->set(it.first, it.second.fvs);
+        }
+    }
+    m_pendingFdbState.clear();
+
+    m_statePipeline->flush();
+}
+
+void FdbOrch::notifyFdbChange(FdbUpdate& update)
+{
+    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+    m_fdbEvents.publish(update);
+}
+
 // Notify Tunnel Orch when the number of MAC entries
 void FdbOrch::notifyTunnelOrch(Port& port)
 {
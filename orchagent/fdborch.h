@@ -1,9 +1,19 @@
 #ifndef SWSS_FDBORCH_H
 #define SWSS_FDBORCH_H
 
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+
 #include "orch.h"
 #include "observer.h"
 #include "portsorch.h"
+#include "bulker.h"
+#include "redispipeline.h"
+#include "memaccounting.h"
+#include "aliasinterner.h"
 
 enum FdbOrigin
 {
@@ -79,7 +89,187 @@ struct SavedFdbEntry
     }
 };
 
-typedef unordered_map<string, vector<SavedFdbEntry>> fdb_entries_by_port_t;
+typedef unordered_map<AliasId, vector<SavedFdbEntry>> fdb_entries_by_port_t;
+
+MEM_ACCOUNTING_TAG(FdbMemTag, "FdbOrch|fdb_entries");
+
+/*
+ * FDB entries by MAC and bridge, a std::map with indices by bridge port and by
+ * bridge (VLAN) on top of it.
+ *
+ * Flushes and flush notifications pick the entries of a bridge port or a VLAN
+ * through the indices instead of walking every MAC. Entries are stored with
+ * set() for the bridge port index to follow their data, an index entry is
+ * checked against the stored data on lookup and dropped once stale.
+ */
+class FdbRegistry
+{
+public:
+    using container_type = std::map<FdbEntry, FdbData, std::less<FdbEntry>,
+                                    MemAccountingAllocator<std::pair<const FdbEntry, FdbData>, FdbMemTag>>;
+    using iterator = container_type::iterator;
+    using const_iterator = container_type::const_iterator;
+
+    // Existing entries only change fields other than bridge_port_id through it
+    FdbData &operator[](const FdbEntry &entry)
+    {
+        auto rc = m_entries.emplace(entry, FdbData());
+        if (rc.second)
+        {
+            m_bridgeIndex[entry.bv_id].insert(entry);
+        }
+        return rc.first->second;
+    }
+
+    void set(const FdbEntry &entry, const FdbData &data)
+    {
+        auto &stored = (*this)[entry];
+        stored = data;
+        m_bridgePortIndex[data.bridge_port_id].insert(entry);
+    }
+
+    iterator find(const FdbEntry &entry) { return m_entries.find(entry); }
+    const_iterator find(const FdbEntry &entry) const { return m_entries.find(entry); }
+    size_t count(const FdbEntry &entry) const { return m_entries.count(entry); }
+
+    iterator erase(iterator it)
+    {
+        unindex(it->first, it->second);
+        return m_entries.erase(it);
+    }
+
+    size_t erase(const FdbEntry &entry)
+    {
+        auto it = m_entries.find(entry);
+        if (it == m_entries.end())
+        {
+            return 0;
+        }
+
+        erase(it);
+        return 1;
+    }
+
+    /* Entries learnt on the bridge port, bv_id narrows them to one bridge unless null */
+    std::vector<FdbEntry> getBridgePortEntries(sai_object_id_t bridge_port_id, sai_object_id_t bv_id = SAI_NULL_OBJECT_ID)
+    {
+        std::vector<FdbEntry> entries;
+
+        auto index = m_bridgePortIndex.find(bridge_port_id);
+        if (index == m_bridgePortIndex.end())
+        {
+            return entries;
+        }
+
+        for (auto it = index->second.begin(); it != index->second.end();)
+        {
+            auto entry = m_entries.find(*it);
+            if (entry == m_entries.end() || entry->second.bridge_port_id != bridge_port_id)
+            {
+                it = index->second.erase(it);
+                continue;
+            }
+            if (bv_id == SAI_NULL_OBJECT_ID || entry->first.bv_id == bv_id)
+            {
+                entries.push_back(entry->first);
+            }
+            it++;
+        }
+
+        if (index->second.empty())
+        {
+            m_bridgePortIndex.erase(index);
+        }
+        return entries;
+    }
+
+    std::vector<FdbEntry> getBridgeEntries(sai_object_id_t bv_id) const
+    {
+        std::vector<FdbEntry> entries;
+
+        auto index = m_bridgeIndex.find(bv_id);
+        if (index != m_bridgeIndex.end())
+        {
+            for (const auto &entry : index->second)
+            {
+                entries.push_back(m_entries.find(entry)->first);
+            }
+        }
+        return entries;
+    }
+
+    iterator begin() { return m_entries.begin(); }
+    iterator end() { return m_entries.end(); }
+    const_iterator begin() const { return m_entries.begin(); }
+    const_iterator end() const { return m_entries.end(); }
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+private:
+    void unindex(const FdbEntry &entry, const FdbData &data)
+    {
+        auto bridge = m_bridgeIndex.find(entry.bv_id);
+        if (bridge != m_bridgeIndex.end())
+        {
+            bridge->second.erase(entry);
+            if (bridge->second.empty())
+            {
+                m_bridgeIndex.erase(bridge);
+            }
+        }
+
+        auto port = m_bridgePortIndex.find(data.bridge_port_id);
+        if (port != m_bridgePortIndex.end())
+        {
+            port->second.erase(entry);
+            if (port->second.empty())
+            {
+                m_bridgePortIndex.erase(port);
+            }
+        }
+    }
+
+    container_type m_entries;
+    std::unordered_map<sai_object_id_t, std::set<FdbEntry>> m_bridgePortIndex;
+    std::unordered_map<sai_object_id_t, std::set<FdbEntry>> m_bridgeIndex;
+};
+
+/*
+ * State of an FDB entry add or remove between its Pre and Post steps, see
+ * FdbOrch::addFdbEntryPre(). The SAI calls of the Pre step are either made right
+ * away or queued in the FDB bulker, the Post step applies their results.
+ */
+struct FdbBulkContext
+{
+    FdbEntry entry;
+    FdbData fdbData;
+    string port_name;
+    FdbOrigin origin;
+    unsigned short vlan_id;
+
+    // No SAI call, the entry is to be added to or removed from saved_fdb_entries
+    bool saved;
+
+    /* MAC update of an existing entry */
+    bool mac_update;
+    string old_port;
+    string old_type;
+    FdbOrigin old_origin;
+
+    vector<sai_attribute_t> attrs;
+    // Bulk statuses, one per attribute on MAC update
+    std::deque<sai_status_t> object_statuses;
+
+    FdbBulkContext(const FdbEntry &entry)
+        : entry(entry), origin(FDB_ORIGIN_INVALID), vlan_id(0), saved(false),
+          mac_update(false), old_origin(FDB_ORIGIN_INVALID)
+    {
+    }
+
+    // The bulker holds pointers to object_statuses
+    FdbBulkContext(const FdbBulkContext&) = delete;
+    FdbBulkContext(FdbBulkContext&&) = delete;
+};
 
 class FdbOrch: public Orch, public Subject, public Observer
 {
@@ -94,6 +284,11 @@ public:
     }
 
     bool bake() override;
+    void getObjectCounts(std::vector<FieldValueTuple> &counts) const override;
+
+    /* Batched SUBJECT_TYPE_FDB_CHANGE, coalesced by MAC and bridge */
+    EventBus<FdbEntry, FdbUpdate>& getFdbEvents() { return m_fdbEvents; }
+
     void update(sai_fdb_event_t, const sai_fdb_entry_t *, sai_object_id_t, const sai_fdb_entry_type_t &);
     void update(SubjectType type, void *cntx);
     bool getPort(const MacAddress&, uint16_t, Port&);
@@ -108,24 +303,51 @@ public:
 
 private:
     PortsOrch *m_portsOrch;
-    map<FdbEntry, FdbData> m_entries;
+    FdbRegistry m_entries;
     fdb_entries_by_port_t saved_fdb_entries;
+    // Ports a saved MAC and VLAN ID may be found on in saved_fdb_entries
+    map<pair<MacAddress, unsigned short>, set<AliasId>> m_savedFdbPorts;
     vector<Table*> m_appTables;
     Table m_fdbStateTable;
     Table m_mclagFdbStateTable;
+    // STATE_DB FDB writes of a batch of FDB events, coalesced by key and
+    // flushed at the end of the batch
+    struct PendingFdbState
+    {
+        bool del = false;
+        vector<FieldValueTuple> fvs;
+    };
+    unique_ptr<RedisPipeline> m_statePipeline;
+    unique_ptr<Table> m_fdbStateWriter;
+    bool m_batchStateWrites = false;
+    map<string, PendingFdbState> m_pendingFdbState;
     NotificationConsumer* m_flushNotificationsConsumer;
     NotificationConsumer* m_fdbNotificationConsumer;
     shared_ptr<DBConnector> m_notificationsDb;
+    EntityBulker<sai_fdb_api_t> m_fdbBulker;
+    EventBus<FdbEntry, FdbUpdate> m_fdbEvents;
 
     void doTask(Consumer& consumer);
     void doTask(NotificationConsumer& consumer);
+    void handleFdbEventNotification(const string& data);
 
     void updateVlanMember(const VlanMemberUpdate&);
     void updatePortOperState(const PortOperStateUpdate&);
 
     bool addFdbEntry(const FdbEntry&, const string&, FdbData fdbData);
+    /* With bulk the SAI calls are queued in m_fdbBulker, the Post step follows its flush */
+    bool addFdbEntryPre(FdbBulkContext& ctx, const string& port_name, FdbData fdbData, bool bulk);
+    bool addFdbEntryPost(FdbBulkContext& ctx);
+    bool removeFdbEntryPre(FdbBulkContext& ctx, FdbOrigin origin, bool bulk);
+    bool removeFdbEntryPost(FdbBulkContext& ctx);
+    void saveFdbEntry(const string& port_name, const SavedFdbEntry& entry);
     void deleteFdbEntryFromSavedFDB(const MacAddress &mac, const unsigned short &vlanId, FdbOrigin origin, const string portName="");
 
+    void setFdbState(const string& key, const vector<FieldValueTuple>& fvs);
+    void delFdbState(const string& key);
+    void flushFdbState();
+    void notifyFdbChange(FdbUpdate& update);
+
     bool storeFdbEntryState(const FdbUpdate& update);
     void notifyTunnelOrch(Port& port);
 
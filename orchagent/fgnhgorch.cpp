@@ -6,6 +6,7 @@
 #include "logger.h"
 #include "swssnet.h"
 #include "crmorch.h"
+#include "bulker.h"
 #include <array>
 #include <algorithm>
 
@@ -14,6 +15,7 @@
 
 extern sai_object_id_t gVirtualRouterId;
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 
 extern sai_next_hop_group_api_t*    sai_next_hop_group_api;
 extern sai_route_api_t*             sai_route_api;
@@ -227,30 +229,97 @@ void FgNhgOrch::setStateDbRouteEntry(const IpPrefix &ipPrefix, uint32_t index, N
                   key.c_str(), value.c_str(), index);
 }
 
-bool FgNhgOrch::writeHashBucketChange(FGNextHopGroupEntry *syncd_fg_route_entry, HashBucketIdx index, sai_object_id_t nh_oid,
-        const IpPrefix &ipPrefix, NextHopKey nextHop)
+void FgNhgOrch::queueHashBucketChange(HashBucketIdx index, sai_object_id_t nh_oid, const NextHopKey &nextHop)
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t nhgm_attr;
-    nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-    nhgm_attr.value.oid = nh_oid;
-    sai_status_t status = sai_next_hop_group_api->set_next_hop_group_member_attribute(
-                                                              syncd_fg_route_entry->nhopgroup_members[index],
-                                                              &nhgm_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    // A bucket moved more than once within one change only keeps its last next hop
+    auto &change = m_hashBucketChanges[index];
+    change.first = nh_oid;
+    change.second = nextHop;
+}
+
+/* flushHashBucketChanges: Applies the hash bucket rewrites queued for a route.
+ * Buckets which already point to their new next hop are skipped, the others are
+ * set through one bulk call on the next hop group member API and recorded in
+ * state db with one write.
+ */
+bool FgNhgOrch::flushHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry, const IpPrefix &ipPrefix)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<HashBucketChanges::const_iterator> moves;
+    for (auto it = m_hashBucketChanges.cbegin(); it != m_hashBucketChanges.cend(); ++it)
     {
-        SWSS_LOG_ERROR("Failed to set next hop oid %" PRIx64 " member %" PRIx64 ": %d",
-            syncd_fg_route_entry->nhopgroup_members[index], nh_oid, status);
-        task_process_status handle_status = handleSaiSetStatus(SAI_API_NEXT_HOP_GROUP, status);
-        if (handle_status != task_success)
+        if (syncd_fg_route_entry->bucket_next_hops[it->first] != it->second.first)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            moves.push_back(it);
         }
     }
 
-    setStateDbRouteEntry(ipPrefix, index, nextHop);
-    return true;
+    std::vector<sai_status_t> statuses(moves.size(), SAI_STATUS_NOT_SUPPORTED);
+    if (m_hashBucketBulkSupported && !moves.empty())
+    {
+        ObjectBulker<sai_next_hop_group_api_t> bulker(sai_next_hop_group_api, gSwitchId, gMaxBulkSize);
+        bulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+        for (size_t i = 0; i < moves.size(); i++)
+        {
+            sai_attribute_t nhgm_attr;
+            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+            nhgm_attr.value.oid = moves[i]->second.first;
+            bulker.set_entry_attribute(&statuses[i], syncd_fg_route_entry->nhopgroup_members[moves[i]->first], &nhgm_attr);
+        }
+        bulker.flush();
+    }
+
+    bool success = true;
+    vector<FieldValueTuple> fvs;
+    for (size_t i = 0; i < moves.size(); i++)
+    {
+        HashBucketIdx index = moves[i]->first;
+        sai_object_id_t nh_oid = moves[i]->second.first;
+        sai_object_id_t nhgm_id = syncd_fg_route_entry->nhopgroup_members[index];
+
+        if (is_bulk_unsupported(statuses[i]))
+        {
+            if (m_hashBucketBulkSupported)
+            {
+                SWSS_LOG_NOTICE("Bulk next hop group member set is not supported, rv:%d", statuses[i]);
+                m_hashBucketBulkSupported = false;
+            }
+
+            sai_attribute_t nhgm_attr;
+            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+            nhgm_attr.value.oid = nh_oid;
+            statuses[i] = sai_next_hop_group_api->set_next_hop_group_member_attribute(nhgm_id, &nhgm_attr);
+        }
+
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to set next hop oid %" PRIx64 " member %" PRIx64 ": %d",
+                nh_oid, nhgm_id, statuses[i]);
+            task_process_status handle_status = handleSaiSetStatus(SAI_API_NEXT_HOP_GROUP, statuses[i]);
+            if (handle_status != task_success)
+            {
+                success = parseHandleSaiStatusFailure(handle_status) && success;
+                continue;
+            }
+        }
+
+        syncd_fg_route_entry->bucket_next_hops[index] = nh_oid;
+        fvs.emplace_back(std::to_string(index), moves[i]->second.second.to_string());
+    }
+
+    if (!fvs.empty())
+    {
+        m_stateWarmRestartRouteTable.set(ipPrefix.to_string(), fvs);
+    }
+
+    SWSS_LOG_INFO("Moved %zu of %zu hash buckets for ip prefix %s",
+                  fvs.size(), m_hashBucketChanges.size(), ipPrefix.to_string().c_str());
+
+    m_hashBucketChanges.clear();
+    return success;
 }
 
 
@@ -309,6 +378,7 @@ bool FgNhgOrch::createFineGrainedNextHopGroup(FGNextHopGroupEntry &syncd_fg_rout
     }
     // Initialize the vector to store sai next hop group members
     syncd_fg_route_entry.nhopgroup_members.resize(fgNhgEntry->real_bucket_size, SAI_NULL_OBJECT_ID);
+    syncd_fg_route_entry.bucket_next_hops.assign(fgNhgEntry->real_bucket_size, SAI_NULL_OBJECT_ID);
     calculateBankHashBucketStartIndices(fgNhgEntry);
 
     SWSS_LOG_NOTICE("fgnhgorch created next hop group %s of size %d", nextHops.to_string().c_str(), fgNhgEntry->real_bucket_size);
@@ -383,7 +453,7 @@ bool FgNhgOrch::validNextHopInNextHopGroup(const NextHopKey& nexthop)
     {
         for (auto &route_table : route_tables.second)
         {
-            if (!(route_table.second.nhg_key.contains(nexthop)))
+            if (!(route_table.second.nhg_key->contains(nexthop)))
             {
                 continue;
             }
@@ -495,7 +565,7 @@ bool FgNhgOrch::invalidNextHopInNextHopGroup(const NextHopKey& nexthop)
     {
         for (auto &route_table : route_tables.second)
         {
-            if (!(route_table.second.nhg_key.contains(nexthop)))
+            if (!(route_table.second.nhg_key->contains(nexthop)))
             {
                 continue;
             }
@@ -593,12 +663,9 @@ bool FgNhgOrch::setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
         // fill the hash bucket indices with the added NHs
         for (uint32_t i = 0; i < hash_buckets->size(); i++)
         {
-            if (!writeHashBucketChange(syncd_fg_route_entry, hash_buckets->at(i),
-                        nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
-                        ipPrefix, bank_member_change.nhs_to_add[add_idx]))
-            {
-                return false;
-            }
+            queueHashBucketChange(hash_buckets->at(i),
+                    nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
+                    bank_member_change.nhs_to_add[add_idx]);
         }
 
         (*bank_fgnhg_map)[bank_member_change.nhs_to_add[add_idx]] =*hash_buckets;
@@ -681,11 +748,7 @@ bool FgNhgOrch::setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
 
                 if (move_bkt)
                 {
-                    if (!writeHashBucketChange(syncd_fg_route_entry, hash_buckets->at(bkt_idx),
-                                               nhopgroup_members_set[*it], ipPrefix, *it))
-                    {
-                        return false;
-                    }
+                    queueHashBucketChange(hash_buckets->at(bkt_idx), nhopgroup_members_set[*it], *it);
                     bank_fgnhg_map->at(*it).push_back(hash_buckets->at(bkt_idx));
                     bkt_idx++;
                 }
@@ -792,12 +855,9 @@ bool FgNhgOrch::setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
                 if (move_bkt)
                 {
                     HashBucketIdx last_elem = map_entry->at((*map_entry).size() - 1);
-                    if (!writeHashBucketChange(syncd_fg_route_entry, last_elem,
-                                               nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
-                                               ipPrefix, bank_member_change.nhs_to_add[add_idx]))
-                    {
-                        return false;
-                    }
+                    queueHashBucketChange(last_elem,
+                            nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
+                            bank_member_change.nhs_to_add[add_idx]);
 
                     (*bank_fgnhg_map)[bank_member_change.nhs_to_add[add_idx]].push_back(last_elem);
                     (*map_entry).erase((*map_entry).end() - 1);
@@ -847,11 +907,7 @@ bool FgNhgOrch::setInactiveBankToNextAvailableActiveBank(FGNextHopGroupEntry *sy
                 NextHopKey bank_nh_memb = bank_member_changes[new_bank_idx].
                          active_nhs[i % bank_member_changes[new_bank_idx].active_nhs.size()];
 
-                if (!writeHashBucketChange(syncd_fg_route_entry, i,
-                    nhopgroup_members_set[bank_nh_memb],ipPrefix, bank_nh_memb ))
-                {
-                    return false;
-                }
+                queueHashBucketChange(i, nhopgroup_members_set[bank_nh_memb], bank_nh_memb);
 
                 syncd_fg_route_entry->syncd_fgnhg_map[bank][bank_nh_memb].push_back(i);
             }
@@ -871,7 +927,7 @@ bool FgNhgOrch::setInactiveBankToNextAvailableActiveBank(FGNextHopGroupEntry *sy
          */
         if (!syncd_fg_route_entry->points_to_rif)
         {
-            std::string interface_alias = syncd_fg_route_entry->nhg_key.getNextHops().begin()->alias;
+            std::string interface_alias = syncd_fg_route_entry->nhg_key->getNextHops().begin()->alias;
             sai_object_id_t rif_next_hop_id = m_intfsOrch->getRouterIntfsId(interface_alias);
             if (rif_next_hop_id == SAI_NULL_OBJECT_ID)
             {
@@ -900,6 +956,9 @@ bool FgNhgOrch::setInactiveBankToNextAvailableActiveBank(FGNextHopGroupEntry *sy
             syncd_fg_route_entry->active_nexthops.clear();
             syncd_fg_route_entry->inactive_to_active_map.clear();
             syncd_fg_route_entry->nhopgroup_members.clear();
+            syncd_fg_route_entry->bucket_next_hops.clear();
+            // The members the queued rewrites were for are gone
+            m_hashBucketChanges.clear();
         }
     }
 
@@ -935,11 +994,7 @@ bool FgNhgOrch::setInactiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_r
             NextHopKey bank_nh_memb = bank_member_changes[bank].
                 nhs_to_add[i % bank_member_changes[bank].nhs_to_add.size()];
 
-            if (!writeHashBucketChange(syncd_fg_route_entry, i,
-                  nhopgroup_members_set[bank_nh_memb], ipPrefix, bank_nh_memb))
-            {
-                return false;
-            }
+            queueHashBucketChange(i, nhopgroup_members_set[bank_nh_memb], bank_nh_memb);
 
             syncd_fg_route_entry->syncd_fgnhg_map[bank][bank_nh_memb].push_back(i);
             syncd_fg_route_entry->active_nexthops.insert(bank_nh_memb);
@@ -1001,6 +1056,9 @@ bool FgNhgOrch::computeAndSetHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
 {
     SWSS_LOG_ENTER();
 
+    bool success = true;
+    m_hashBucketChanges.clear();
+
     for (uint32_t bank_idx = 0; bank_idx < bank_member_changes.size(); bank_idx++)
     {
         if (bank_member_changes[bank_idx].active_nhs.size() != 0 ||
@@ -1016,7 +1074,8 @@ bool FgNhgOrch::computeAndSetHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
             if (!setActiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry,
                         bank_idx, bank_member_changes[bank_idx], nhopgroup_members_set, ipPrefix))
             {
-                return false;
+                success = false;
+                break;
             }
         }
         else
@@ -1024,12 +1083,15 @@ bool FgNhgOrch::computeAndSetHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
             if (!setInactiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry,
                         bank_idx, bank_member_changes, nhopgroup_members_set, ipPrefix))
             {
-                return false;
+                success = false;
+                break;
             }
         }
     }
 
-    return true;
+    /* The bookkeeping above already follows the new assignment, so whatever was
+     * queued is applied even if a later bank failed */
+    return flushHashBucketChanges(syncd_fg_route_entry, ipPrefix) && success;
 }
 
 
@@ -1191,6 +1253,7 @@ bool FgNhgOrch::sprayBankNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, c
         syncd_fg_route_entry.syncd_fgnhg_map[bank][nh_memb_key].push_back(bucket_idx);
         syncd_fg_route_entry.active_nexthops.insert(nh_memb_key);
         syncd_fg_route_entry.nhopgroup_members[bucket_idx] = next_hop_group_member_id;
+        syncd_fg_route_entry.bucket_next_hops[bucket_idx] = nhopgroup_members_set[nh_memb_key];
         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
     }
 
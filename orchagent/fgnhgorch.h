@@ -29,9 +29,10 @@ struct FGNextHopGroupEntry
 {
     sai_object_id_t         next_hop_group_id;      // next hop group id
     FGNextHopGroupMembers   nhopgroup_members;      // sai_object_ids of nexthopgroup members(0 - real_bucket_size - 1)
+    std::vector<sai_object_id_t> bucket_next_hops;  // next hop oid each nexthopgroup member currently points to
     ActiveNextHops          active_nexthops;        // The set of nexthops(ip+alias)
     BankFGNextHopGroupMap   syncd_fgnhg_map;        // Map of (bank) -> (nexthops) -> (index in nhopgroup_members)
-    NextHopGroupKey         nhg_key;                // Full next hop group key
+    NextHopGroupKeyRef      nhg_key;                // Full next hop group key, interned
     InactiveBankMapsToBank  inactive_to_active_map; // Maps an inactive bank to an active one in terms of hash bkts
     bool                    points_to_rif;          // Flag to identify that route is currently pointing to a rif
 };
@@ -98,6 +99,9 @@ typedef struct
     std::vector<NextHopKey> active_nhs;
 } BankMemberChanges;
 
+/* Hash bucket rewrites of a route: bucket -> (next hop oid, next hop), applied together */
+typedef std::map<HashBucketIdx, std::pair<sai_object_id_t, NextHopKey>> HashBucketChanges;
+
 typedef std::vector<string> NextHopIndexMap;
 typedef map<string, NextHopIndexMap> WarmBootRecoveryMap;
 
@@ -140,6 +144,10 @@ private:
     // < ip_prefix, < HashBuckets, nh_ip>>
     WarmBootRecoveryMap m_recoveryMap;
 
+    // Hash bucket rewrites queued by computeAndSetHashBucketChanges
+    HashBucketChanges m_hashBucketChanges;
+    bool m_hashBucketBulkSupported = true;
+
     bool setNewNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
                     std::vector<BankMemberChanges> &bank_member_changes,
                     std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix&);
@@ -162,8 +170,8 @@ private:
                     std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix&);
     void calculateBankHashBucketStartIndices(FgNhgEntry *fgNhgEntry);
     void setStateDbRouteEntry(const IpPrefix&, uint32_t index, NextHopKey nextHop);
-    bool writeHashBucketChange(FGNextHopGroupEntry *syncd_fg_route_entry, uint32_t index, sai_object_id_t nh_oid,
-                    const IpPrefix &ipPrefix, NextHopKey nextHop);
+    void queueHashBucketChange(HashBucketIdx index, sai_object_id_t nh_oid, const NextHopKey &nextHop);
+    bool flushHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry, const IpPrefix &ipPrefix);
     bool modifyRoutesNextHopId(sai_object_id_t vrf_id, const IpPrefix &ipPrefix, sai_object_id_t next_hop_id);
     bool createFineGrainedNextHopGroup(FGNextHopGroupEntry &syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
                     const NextHopGroupKey &nextHops);
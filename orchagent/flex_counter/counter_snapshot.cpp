@@ -0,0 +1,434 @@
+#include "counter_snapshot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <inttypes.h>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "logger.h"
+
+using std::string;
+using std::vector;
+
+namespace
+{
+
+struct SectionLayout
+{
+    const char *name;
+    uint32_t capacity;
+    uint32_t stride;
+};
+
+// Records and counters per record of each section
+const SectionLayout section_layouts[] =
+{
+    { "PORT", 1024, 256 },
+    { "QUEUE", 16384, 32 },
+    { "PG", 8192, 16 },
+};
+
+static_assert(sizeof(section_layouts) / sizeof(section_layouts[0]) == static_cast<size_t>(CounterSnapshotSection::COUNT),
+        "one layout per counter snapshot section");
+
+const size_t SNAPSHOT_ALIGNMENT = 64;
+
+size_t align(size_t offset)
+{
+    return (offset + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+}
+
+CounterSnapshotHeader *getHeader(void *base)
+{
+    return static_cast<CounterSnapshotHeader *>(base);
+}
+
+CounterSnapshotSectionHeader *getSection(void *base, CounterSnapshotSection section)
+{
+    auto sections = reinterpret_cast<CounterSnapshotSectionHeader *>(static_cast<char *>(base) + sizeof(CounterSnapshotHeader));
+    return &sections[static_cast<size_t>(section)];
+}
+
+CounterSnapshotRecord *getRecord(void *base, const CounterSnapshotSectionHeader *section, uint32_t slot)
+{
+    return reinterpret_cast<CounterSnapshotRecord *>(static_cast<char *>(base) +
+            section->records_offset + static_cast<size_t>(slot) * section->record_size);
+}
+
+uint64_t *getValues(CounterSnapshotRecord *record)
+{
+    return reinterpret_cast<uint64_t *>(record + 1);
+}
+
+char *getName(void *base, const CounterSnapshotSectionHeader *section, uint32_t index)
+{
+    return static_cast<char *>(base) + section->names_offset + static_cast<size_t>(index) * COUNTER_SNAPSHOT_NAME_SIZE;
+}
+
+}
+
+CounterSnapshotWriter::CounterSnapshotWriter(const string& path) :
+    path(path)
+{
+    SWSS_LOG_ENTER();
+
+    struct SectionOffsets
+    {
+        uint64_t names_offset;
+        uint64_t records_offset;
+        uint32_t record_size;
+    };
+
+    size_t offset = align(sizeof(CounterSnapshotHeader) +
+            static_cast<size_t>(CounterSnapshotSection::COUNT) * sizeof(CounterSnapshotSectionHeader));
+    vector<SectionOffsets> layouts(static_cast<size_t>(CounterSnapshotSection::COUNT));
+
+    for (size_t i = 0; i < layouts.size(); i++)
+    {
+        auto& layout = layouts[i];
+        auto stride = section_layouts[i].stride;
+        layout.record_size = static_cast<uint32_t>(sizeof(CounterSnapshotRecord) + stride * sizeof(uint64_t));
+        layout.names_offset = offset;
+        offset = align(offset + static_cast<size_t>(stride) * COUNTER_SNAPSHOT_NAME_SIZE);
+        layout.records_offset = offset;
+        offset = align(offset + static_cast<size_t>(section_layouts[i].capacity) * layout.record_size);
+    }
+    size = offset;
+
+    // Build the snapshot aside and rename it, readers never map a partial one
+    string tmp_path = path + ".tmp";
+    int fd = open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Failed to create counter snapshot " + tmp_path + ": " + strerror(errno));
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        int err = errno;
+        close(fd);
+        unlink(tmp_path.c_str());
+        throw std::runtime_error("Failed to size counter snapshot " + tmp_path + ": " + strerror(err));
+    }
+
+    base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        base = nullptr;
+        unlink(tmp_path.c_str());
+        throw std::runtime_error("Failed to map counter snapshot " + tmp_path + ": " + strerror(errno));
+    }
+
+    // The file is zero filled, so are the sequences, counts and records
+    auto header = getHeader(base);
+    header->magic = COUNTER_SNAPSHOT_MAGIC;
+    header->version = COUNTER_SNAPSHOT_VERSION;
+    header->section_count = static_cast<uint32_t>(CounterSnapshotSection::COUNT);
+    for (size_t i = 0; i < layouts.size(); i++)
+    {
+        auto section = getSection(base, static_cast<CounterSnapshotSection>(i));
+        strncpy(section->name, section_layouts[i].name, sizeof(section->name) - 1);
+        section->names_offset = layouts[i].names_offset;
+        section->records_offset = layouts[i].records_offset;
+        section->capacity = section_layouts[i].capacity;
+        section->stride = section_layouts[i].stride;
+        section->record_size = layouts[i].record_size;
+    }
+    header->active.store(1, std::memory_order_release);
+
+    if (rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        int err = errno;
+        munmap(base, size);
+        base = nullptr;
+        unlink(tmp_path.c_str());
+        throw std::runtime_error("Failed to publish counter snapshot " + path + ": " + strerror(err));
+    }
+
+    SWSS_LOG_NOTICE("Publishing counter snapshot %s of %zu bytes", path.c_str(), size);
+}
+
+CounterSnapshotWriter::~CounterSnapshotWriter()
+{
+    if (!base)
+    {
+        return;
+    }
+
+    getHeader(base)->active.store(0, std::memory_order_release);
+    munmap(base, size);
+    unlink(path.c_str());
+}
+
+bool CounterSnapshotWriter::addObject(CounterSnapshotSection section, uint64_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    auto& state = sections[static_cast<size_t>(section)];
+    if (state.slots.find(oid) != state.slots.end())
+    {
+        return true;
+    }
+
+    auto header = getSection(base, section);
+    uint32_t slot;
+    if (!state.free_slots.empty())
+    {
+        slot = state.free_slots.back();
+        state.free_slots.pop_back();
+    }
+    else
+    {
+        slot = header->record_count.load(std::memory_order_relaxed);
+        if (slot >= header->capacity)
+        {
+            SWSS_LOG_WARN("Counter snapshot section %s is full, 0x%" PRIx64 " is not published", header->name, oid);
+            return false;
+        }
+    }
+
+    auto record = getRecord(base, header, slot);
+    uint64_t seq = record->seq.load(std::memory_order_relaxed);
+    record->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    record->oid = oid;
+    record->timestamp_usec = 0;
+    memset(getValues(record), 0, header->stride * sizeof(uint64_t));
+    record->seq.store(seq + 2, std::memory_order_release);
+
+    if (slot >= header->record_count.load(std::memory_order_relaxed))
+    {
+        header->record_count.store(slot + 1, std::memory_order_release);
+    }
+    state.slots[oid] = slot;
+    getHeader(base)->generation.fetch_add(1, std::memory_order_release);
+
+    return true;
+}
+
+void CounterSnapshotWriter::removeObject(CounterSnapshotSection section, uint64_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    auto& state = sections[static_cast<size_t>(section)];
+    auto it = state.slots.find(oid);
+    if (it == state.slots.end())
+    {
+        return;
+    }
+
+    auto record = getRecord(base, getSection(base, section), it->second);
+    uint64_t seq = record->seq.load(std::memory_order_relaxed);
+    record->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    record->oid = 0;
+    record->seq.store(seq + 2, std::memory_order_release);
+
+    state.free_slots.push_back(it->second);
+    state.slots.erase(it);
+    getHeader(base)->generation.fetch_add(1, std::memory_order_release);
+}
+
+int CounterSnapshotWriter::getCounterIndex(CounterSnapshotSection section, const string& name)
+{
+    auto& state = sections[static_cast<size_t>(section)];
+    auto it = state.counters.find(name);
+    if (it != state.counters.end())
+    {
+        return it->second;
+    }
+
+    auto header = getSection(base, section);
+    uint32_t index = header->name_count.load(std::memory_order_relaxed);
+    if (index >= header->stride || name.size() >= COUNTER_SNAPSHOT_NAME_SIZE)
+    {
+        SWSS_LOG_WARN("Counter %s does not fit in counter snapshot section %s", name.c_str(), header->name);
+        state.counters[name] = -1;
+        return -1;
+    }
+
+    // Names are append only, publish the name before the count
+    memcpy(getName(base, header, index), name.c_str(), name.size() + 1);
+    header->name_count.store(index + 1, std::memory_order_release);
+    state.counters[name] = static_cast<int>(index);
+
+    return static_cast<int>(index);
+}
+
+void CounterSnapshotWriter::update(CounterSnapshotSection section, uint64_t oid,
+        const vector<uint64_t>& values, const vector<uint8_t>& valid)
+{
+    auto& state = sections[static_cast<size_t>(section)];
+    auto it = state.slots.find(oid);
+    if (it == state.slots.end())
+    {
+        return;
+    }
+
+    auto header = getSection(base, section);
+    auto record = getRecord(base, header, it->second);
+    auto record_values = getValues(record);
+    size_t count = std::min(values.size(), static_cast<size_t>(header->stride));
+    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+    uint64_t seq = record->seq.load(std::memory_order_relaxed);
+    record->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < count; i++)
+    {
+        if (valid[i])
+        {
+            record_values[i] = values[i];
+        }
+    }
+    record->timestamp_usec = static_cast<uint64_t>(now);
+    record->seq.store(seq + 2, std::memory_order_release);
+}
+
+CounterSnapshotReader::CounterSnapshotReader(const string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Failed to open counter snapshot " + path + ": " + strerror(errno));
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(CounterSnapshotHeader))
+    {
+        close(fd);
+        throw std::runtime_error("Invalid counter snapshot " + path);
+    }
+
+    size = static_cast<size_t>(st.st_size);
+    base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        base = nullptr;
+        throw std::runtime_error("Failed to map counter snapshot " + path + ": " + strerror(errno));
+    }
+
+    auto header = getHeader(base);
+    if (header->magic != COUNTER_SNAPSHOT_MAGIC || header->version != COUNTER_SNAPSHOT_VERSION ||
+        header->section_count != static_cast<uint32_t>(CounterSnapshotSection::COUNT))
+    {
+        munmap(base, size);
+        base = nullptr;
+        throw std::runtime_error("Unsupported counter snapshot " + path);
+    }
+}
+
+CounterSnapshotReader::~CounterSnapshotReader()
+{
+    if (base)
+    {
+        munmap(base, size);
+    }
+}
+
+bool CounterSnapshotReader::isActive() const
+{
+    return getHeader(base)->active.load(std::memory_order_acquire) != 0;
+}
+
+vector<string> CounterSnapshotReader::getCounterNames(CounterSnapshotSection section) const
+{
+    auto header = getSection(base, section);
+    uint32_t count = header->name_count.load(std::memory_order_acquire);
+
+    vector<string> names;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        names.emplace_back(getName(base, header, i));
+    }
+
+    return names;
+}
+
+void CounterSnapshotReader::buildIndex()
+{
+    index_generation = getHeader(base)->generation.load(std::memory_order_acquire);
+
+    for (size_t s = 0; s < static_cast<size_t>(CounterSnapshotSection::COUNT); s++)
+    {
+        auto header = getSection(base, static_cast<CounterSnapshotSection>(s));
+        uint32_t count = header->record_count.load(std::memory_order_acquire);
+
+        index[s].clear();
+        for (uint32_t slot = 0; slot < count; slot++)
+        {
+            auto record = getRecord(base, header, slot);
+            uint64_t seq, oid;
+            do
+            {
+                seq = record->seq.load(std::memory_order_acquire);
+                oid = record->oid;
+                std::atomic_thread_fence(std::memory_order_acquire);
+            } while ((seq & 1) || seq != record->seq.load(std::memory_order_relaxed));
+
+            if (oid)
+            {
+                index[s][oid] = slot;
+            }
+        }
+    }
+
+    index_valid = true;
+}
+
+bool CounterSnapshotReader::read(CounterSnapshotSection section, uint64_t oid,
+        vector<uint64_t>& values, uint64_t *timestamp_usec)
+{
+    auto header = getSection(base, section);
+    auto& section_index = index[static_cast<size_t>(section)];
+
+    // Retry once on a stale index, the object may have moved
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        if (!index_valid || getHeader(base)->generation.load(std::memory_order_acquire) != index_generation)
+        {
+            buildIndex();
+        }
+
+        auto it = section_index.find(oid);
+        if (it == section_index.end())
+        {
+            return false;
+        }
+
+        auto record = getRecord(base, header, it->second);
+        values.resize(header->name_count.load(std::memory_order_acquire));
+
+        uint64_t seq, record_oid, timestamp;
+        do
+        {
+            seq = record->seq.load(std::memory_order_acquire);
+            record_oid = record->oid;
+            timestamp = record->timestamp_usec;
+            memcpy(values.data(), getValues(record), values.size() * sizeof(uint64_t));
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((seq & 1) || seq != record->seq.load(std::memory_order_relaxed));
+
+        if (record_oid == oid)
+        {
+            if (timestamp_usec)
+            {
+                *timestamp_usec = timestamp;
+            }
+            return true;
+        }
+
+        index_valid = false;
+    }
+
+    return false;
+}
@@ -0,0 +1,143 @@
+#ifndef ORCHAGENT_COUNTER_SNAPSHOT_H
+#define ORCHAGENT_COUNTER_SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Memory mapped snapshot of the port, queue and PG counters of COUNTERS_DB,
+// so local readers get them without going through redis.
+//
+// The snapshot is one file, usually under /dev/shm, made of a header, one
+// descriptor per section and, per section, a table of counter names
+// followed by fixed stride records:
+//
+//   | header | sections | names | records | names | records | ...
+//
+// A record holds the counters of one object (a port, a queue or a PG):
+// value i is the counter of name i of its section, names are only ever
+// appended. Every record is protected by its own sequence lock: the writer
+// makes the sequence odd while it updates the record and even again
+// afterwards, readers retry until they copied the record with the same
+// even sequence before and after, so readers never block the writer.
+// Adding or removing an object bumps the generation of the snapshot so
+// readers rebuild their index.
+//
+// Objects are looked up by SAI object id, which readers resolve from the
+// object names through the COUNTERS_*_NAME_MAP tables.
+
+#define COUNTER_SNAPSHOT_MAGIC      0x534e4150
+#define COUNTER_SNAPSHOT_VERSION    1
+#define COUNTER_SNAPSHOT_NAME_SIZE  64
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "counter snapshot needs address free 64 bit atomics");
+
+enum class CounterSnapshotSection : uint32_t
+{
+    PORT = 0,
+    QUEUE,
+    PRIORITY_GROUP,
+    COUNT
+};
+
+struct CounterSnapshotHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t section_count;
+    // Cleared by the writer when it goes away, readers should reopen the snapshot
+    std::atomic<uint32_t> active;
+    std::atomic<uint64_t> generation;
+};
+
+struct CounterSnapshotSectionHeader
+{
+    char name[16];
+    uint64_t names_offset;
+    uint64_t records_offset;
+    uint32_t capacity;
+    uint32_t stride;
+    uint32_t record_size;
+    std::atomic<uint32_t> name_count;
+    // High water mark of the records in use
+    std::atomic<uint32_t> record_count;
+    uint32_t reserved;
+};
+
+// Followed by stride uint64_t counter values
+struct CounterSnapshotRecord
+{
+    std::atomic<uint64_t> seq;
+    uint64_t oid;
+    uint64_t timestamp_usec;
+};
+
+class CounterSnapshotWriter
+{
+    public:
+        // Creates the snapshot at path, throws std::runtime_error on failure
+        CounterSnapshotWriter(const std::string& path);
+        ~CounterSnapshotWriter();
+
+        CounterSnapshotWriter(const CounterSnapshotWriter&) = delete;
+        CounterSnapshotWriter& operator=(const CounterSnapshotWriter&) = delete;
+
+        // Reserves a record for the object, false when the section is full
+        bool addObject(CounterSnapshotSection section, uint64_t oid);
+        void removeObject(CounterSnapshotSection section, uint64_t oid);
+
+        // Index of the counter in the records of the section, adding the
+        // name when needed; -1 once the stride of the section is used up
+        int getCounterIndex(CounterSnapshotSection section, const std::string& name);
+
+        // Publishes the counters of the object, values[i] for counter index i
+        void update(CounterSnapshotSection section, uint64_t oid,
+                const std::vector<uint64_t>& values, const std::vector<uint8_t>& valid);
+
+    private:
+        struct SectionState
+        {
+            std::unordered_map<uint64_t, uint32_t> slots;
+            std::vector<uint32_t> free_slots;
+            std::unordered_map<std::string, int> counters;
+        };
+
+        std::string path;
+        void *base = nullptr;
+        size_t size = 0;
+        SectionState sections[static_cast<size_t>(CounterSnapshotSection::COUNT)];
+};
+
+class CounterSnapshotReader
+{
+    public:
+        // Maps the snapshot at path, throws std::runtime_error on failure
+        CounterSnapshotReader(const std::string& path);
+        ~CounterSnapshotReader();
+
+        CounterSnapshotReader(const CounterSnapshotReader&) = delete;
+        CounterSnapshotReader& operator=(const CounterSnapshotReader&) = delete;
+
+        // False once the writer went away, the snapshot has to be reopened
+        bool isActive() const;
+
+        std::vector<std::string> getCounterNames(CounterSnapshotSection section) const;
+
+        // Copies the counters of the object, lock free; values[i] is the
+        // counter of name i, false when the object is not in the snapshot
+        bool read(CounterSnapshotSection section, uint64_t oid,
+                std::vector<uint64_t>& values, uint64_t *timestamp_usec = nullptr);
+
+    private:
+        void buildIndex();
+
+        void *base = nullptr;
+        size_t size = 0;
+        uint64_t index_generation = 0;
+        bool index_valid = false;
+        std::unordered_map<uint64_t, uint32_t> index[static_cast<size_t>(CounterSnapshotSection::COUNT)];
+};
+
+#endif // ORCHAGENT_COUNTER_SNAPSHOT_H
@@ -22,6 +22,8 @@ extern sai_switch_api_t *sai_switch_api;
 const string FLEX_COUNTER_ENABLE("enable");
 const string FLEX_COUNTER_DISABLE("disable");
 
+FlexCounterListener *FlexCounterManager::listener = nullptr;
+
 const unordered_map<StatsMode, string> FlexCounterManager::stats_mode_lookup =
 {
     { StatsMode::READ, STATS_MODE_READ },
@@ -224,12 +226,43 @@ void FlexCounterManager::setCounterIdList(
 
     startFlexCounterPolling(effective_switch_id, key, counter_ids, counter_type_it->second);
     installed_counters[object_id] = effective_switch_id;
+    notifyCounterIdListSet(object_id, counter_stats);
 
     SWSS_LOG_DEBUG("Updated flex counter id list for object '%" PRIu64 "' in group '%s'.",
             object_id,
             group_name.c_str());
 }
 
+// setCounterIdList configures a flex counter to poll the stats of the given
+// counter profile for the given object.
+void FlexCounterManager::setCounterIdList(
+        const sai_object_id_t object_id,
+        const shared_ptr<const CounterProfile>& profile,
+        const sai_object_id_t switch_id)
+{
+    SWSS_LOG_ENTER();
+
+    auto counter_type_it = counter_id_field_lookup.find(profile->counter_type);
+    if (counter_type_it == counter_id_field_lookup.end())
+    {
+        SWSS_LOG_ERROR("Could not update flex counter id list for group '%s': counter type not found.",
+                group_name.c_str());
+        return;
+    }
+
+    auto key = getFlexCounterTableKey(group_name, object_id);
+    auto effective_switch_id = switch_id == SAI_NULL_OBJECT_ID ? gSwitchId : switch_id;
+
+    startFlexCounterPolling(effective_switch_id, key, profile->counter_ids, counter_type_it->second);
+    installed_counters[object_id] = effective_switch_id;
+    notifyCounterIdListSet(object_id, profile->counter_stats);
+
+    SWSS_LOG_DEBUG("Updated flex counter id list for object '%" PRIu64 "' in group '%s' with profile '%s'.",
+            object_id,
+            group_name.c_str(),
+            profile->name.c_str());
+}
+
 // clearCounterIdList clears all stats that are currently being polled from
 // the given object.
 void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
@@ -248,12 +281,31 @@ void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
     auto key = getFlexCounterTableKey(group_name, object_id);
     stopFlexCounterPolling(installed_counters[object_id], key);
     installed_counters.erase(counter_it);
+    notifyCounterIdListCleared(object_id);
 
     SWSS_LOG_DEBUG("Cleared flex counter id list for object '%" PRIu64 "' in group '%s'.",
             object_id,
             group_name.c_str());
 }
 
+void FlexCounterManager::notifyCounterIdListSet(
+        const sai_object_id_t object_id,
+        const unordered_set<string>& counter_stats)
+{
+    if (listener && !is_gearbox)
+    {
+        listener->onCounterIdListSet(group_name, object_id, counter_stats);
+    }
+}
+
+void FlexCounterManager::notifyCounterIdListCleared(const sai_object_id_t object_id)
+{
+    if (listener && !is_gearbox)
+    {
+        listener->onCounterIdListCleared(group_name, object_id);
+    }
+}
+
 string FlexCounterManager::getFlexCounterTableKey(
         const string& group_name,
         const sai_object_id_t object_id) const
@@ -263,6 +315,40 @@ string FlexCounterManager::getFlexCounterTableKey(
     return group_name + ":" + sai_serialize_object_id(object_id);
 }
 
+shared_ptr<const CounterProfile> FlexCounterManager::registerCounterProfile(
+        const string& profile_name,
+        const CounterType counter_type,
+        const unordered_set<string>& counter_stats)
+{
+    SWSS_LOG_ENTER();
+
+    auto profile = make_shared<CounterProfile>();
+    profile->name = profile_name;
+    profile->counter_type = counter_type;
+    profile->counter_stats = counter_stats;
+    profile->counter_ids = serializeCounterStats(counter_stats);
+
+    counter_profiles[profile_name] = profile;
+
+    SWSS_LOG_INFO("Registered counter profile '%s' of %zu counters in group '%s'.",
+            profile_name.c_str(),
+            counter_stats.size(),
+            group_name.c_str());
+
+    return profile;
+}
+
+shared_ptr<const CounterProfile> FlexCounterManager::getCounterProfile(const string& profile_name) const
+{
+    auto it = counter_profiles.find(profile_name);
+    if (it == counter_profiles.end())
+    {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
 // serializeCounterStats turns a set of stats into a format suitable for FLEX_COUNTER_DB.
 string FlexCounterManager::serializeCounterStats(
         const unordered_set<string>& counter_stats)
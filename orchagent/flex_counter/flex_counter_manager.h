@@ -1,6 +1,8 @@
 #ifndef ORCHAGENT_FLEX_COUNTER_MANAGER_H
 #define ORCHAGENT_FLEX_COUNTER_MANAGER_H
 
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <unordered_map>
@@ -51,6 +53,34 @@ enum class CounterType
 extern bool gTraditionalFlexCounter;
 extern sai_object_id_t gSwitchId;
 
+// FlexCounterListener is told about the objects installed in and removed from
+// the flex counter groups, e.g. to publish their counters somewhere else.
+class FlexCounterListener
+{
+    public:
+        virtual ~FlexCounterListener() {}
+
+        virtual void onCounterIdListSet(
+                const std::string& group_name,
+                const sai_object_id_t object_id,
+                const std::unordered_set<std::string>& counter_stats) = 0;
+        virtual void onCounterIdListCleared(
+                const std::string& group_name,
+                const sai_object_id_t object_id) = 0;
+};
+
+// CounterProfile is a named counter id list shared by the objects of a group
+// polling the same counters, e.g. all the queues of the switch. The list is
+// serialized once when the profile is registered, and cached objects are
+// batched by profile instead of by hashing their whole counter set.
+struct CounterProfile
+{
+    std::string name;
+    CounterType counter_type;
+    std::unordered_set<std::string> counter_stats;
+    std::string counter_ids;
+};
+
 struct CachedObjects;
 // FlexCounterManager allows users to manage a group of flex counters.
 //
@@ -92,8 +122,21 @@ class FlexCounterManager
                 const CounterType counter_type,
                 const std::unordered_set<std::string>& counter_stats,
                 const sai_object_id_t switch_id=SAI_NULL_OBJECT_ID);
+        virtual void setCounterIdList(
+                const sai_object_id_t object_id,
+                const std::shared_ptr<const CounterProfile>& profile,
+                const sai_object_id_t switch_id=SAI_NULL_OBJECT_ID);
         virtual void clearCounterIdList(const sai_object_id_t object_id);
 
+        // Registers the named counter profile of the group, replacing the
+        // previous one; objects already set keep the counters they poll
+        std::shared_ptr<const CounterProfile> registerCounterProfile(
+                const std::string& profile_name,
+                const CounterType counter_type,
+                const std::unordered_set<std::string>& counter_stats);
+        // Null when no such profile is registered
+        std::shared_ptr<const CounterProfile> getCounterProfile(const std::string& profile_name) const;
+
         const std::string& getGroupName() const
         {
             return group_name;
@@ -114,8 +157,18 @@ class FlexCounterManager
             return enabled;
         }
 
+        // The listener is not told about gearbox counters
+        static void setListener(FlexCounterListener *flex_counter_listener)
+        {
+            listener = flex_counter_listener;
+        }
+
     protected:
         void applyGroupConfiguration();
+        void notifyCounterIdListSet(
+                const sai_object_id_t object_id,
+                const std::unordered_set<std::string>& counter_stats);
+        void notifyCounterIdListCleared(const sai_object_id_t object_id);
 
         std::string getFlexCounterTableKey(
                 const std::string& group_name,
@@ -132,9 +185,12 @@ class FlexCounterManager
         static std::string serializeCounterStats(
                 const std::unordered_set<std::string>& counter_stats);
 
+        std::unordered_map<std::string, std::shared_ptr<const CounterProfile>> counter_profiles;
+
         static const std::unordered_map<StatsMode, std::string> stats_mode_lookup;
         static const std::unordered_map<bool, std::string> status_lookup;
         static const std::unordered_map<CounterType, std::string> counter_id_field_lookup;
+        static FlexCounterListener *listener;
 };
 
 struct CachedObjects
@@ -166,6 +222,10 @@ struct CachedObjects
 
     std::unordered_map<PendingMapKey, std::unordered_set<sai_object_id_t>, PendingMapHash> pending_objects_map;
 
+    /* Objects set with a counter profile, by profile and switch */
+    typedef std::pair<std::shared_ptr<const CounterProfile>, sai_object_id_t> ProfileMapKey;
+    std::map<ProfileMapKey, std::unordered_set<sai_object_id_t>> pending_profile_objects_map;
+
     void cache(const sai_object_id_t object_id,
                    const CounterType counter_type,
                    const std::unordered_set<std::string>& counter_stats,
@@ -175,40 +235,86 @@ struct CachedObjects
         pending_objects_map[key].emplace(object_id);
     }
 
-    void flush(const std::string &group_name)
+    void cache(const sai_object_id_t object_id,
+                   const std::shared_ptr<const CounterProfile>& profile,
+                   sai_object_id_t switch_id)
     {
-        if (pending_objects_map.empty())
+        pending_profile_objects_map[ProfileMapKey(profile, switch_id)].emplace(object_id);
+    }
+
+    // Returns true if the object was pending
+    bool erase(const sai_object_id_t object_id)
+    {
+        for (auto entry = pending_objects_map.begin(); entry != pending_objects_map.end(); ++entry)
         {
-            return;
+            if (entry->second.erase(object_id))
+            {
+                if (entry->second.empty())
+                {
+                    pending_objects_map.erase(entry);
+                }
+                return true;
+            }
         }
 
-        for (const auto& entry : pending_objects_map)
+        for (auto entry = pending_profile_objects_map.begin(); entry != pending_profile_objects_map.end(); ++entry)
         {
-            const auto& counter_stats = entry.first.counter_stats;
-            const auto& counter_type = entry.first.counter_type;
-            const auto& switch_id = entry.first.switch_id;
-            const auto& pending_sai_objects = entry.second;
-
-            if (pending_sai_objects.empty())
+            if (entry->second.erase(object_id))
             {
-                continue;
+                if (entry->second.empty())
+                {
+                    pending_profile_objects_map.erase(entry);
+                }
+                return true;
             }
+        }
+
+        return false;
+    }
 
+    void flush(const std::string &group_name)
+    {
+        for (const auto& entry : pending_objects_map)
+        {
+            const auto& counter_stats = entry.first.counter_stats;
             auto counter_ids = FlexCounterManager::serializeCounterStats(counter_stats);
-            auto counter_type_it = FlexCounterManager::counter_id_field_lookup.find(counter_type);
 
-            auto counter_keys = group_name + ":";
-            for (const auto& oid: pending_sai_objects)
-            {
-                counter_keys += sai_serialize_object_id(oid) + ",";
-            }
-            counter_keys.pop_back();
+            flushObjects(group_name, entry.second, counter_ids, entry.first.counter_type, entry.first.switch_id);
+        }
+
+        for (const auto& entry : pending_profile_objects_map)
+        {
+            const auto& profile = *entry.first.first;
 
-            startFlexCounterPolling(switch_id, counter_keys, counter_ids, counter_type_it->second);
+            flushObjects(group_name, entry.second, profile.counter_ids, profile.counter_type, entry.first.second);
         }
 
         /* Clear all cached entries after flush */
         pending_objects_map.clear();
+        pending_profile_objects_map.clear();
+    }
+
+    void flushObjects(const std::string &group_name,
+                      const std::unordered_set<sai_object_id_t>& pending_sai_objects,
+                      const std::string& counter_ids,
+                      const CounterType counter_type,
+                      sai_object_id_t switch_id)
+    {
+        if (pending_sai_objects.empty())
+        {
+            return;
+        }
+
+        auto counter_type_it = FlexCounterManager::counter_id_field_lookup.find(counter_type);
+
+        auto counter_keys = group_name + ":";
+        for (const auto& oid: pending_sai_objects)
+        {
+            counter_keys += sai_serialize_object_id(oid) + ",";
+        }
+        counter_keys.pop_back();
+
+        startFlexCounterPolling(switch_id, counter_keys, counter_ids, counter_type_it->second);
     }
 };
 
@@ -252,38 +358,41 @@ class FlexCounterCachedManager : public FlexCounterManager
             auto effective_switch_id = switch_id == SAI_NULL_OBJECT_ID ? gSwitchId : switch_id;
             installed_counters[object_id] = effective_switch_id;
             cached_objects.cache(object_id, counter_type, counter_stats, effective_switch_id);
+            notifyCounterIdListSet(object_id, counter_stats);
         }
 
-        void clearCounterIdList(
+        void setCounterIdList(
             struct CachedObjects &cached_objects,
-            const sai_object_id_t object_id)
+            const sai_object_id_t object_id,
+            const std::shared_ptr<const CounterProfile>& profile,
+            const sai_object_id_t switch_id=SAI_NULL_OBJECT_ID)
         {
-            bool found = false;
-            for (auto entry = cached_objects.pending_objects_map.begin(); entry != cached_objects.pending_objects_map.end(); )
+            if (gTraditionalFlexCounter)
             {
-                if (entry->second.find(object_id) != entry->second.end())
-                {
-                    found = true;
-                    installed_counters.erase(object_id);
-                    entry->second.erase(object_id);
-                }
-
-                if (found && entry->second.empty())
-                {
-                    entry = cached_objects.pending_objects_map.erase(entry);
-                    break;
-                }
-                else
-                {
-                    ++entry;
-                }
+                FlexCounterManager::setCounterIdList(object_id, profile, switch_id);
+                return;
             }
 
-            if (!found)
+            auto effective_switch_id = switch_id == SAI_NULL_OBJECT_ID ? gSwitchId : switch_id;
+            installed_counters[object_id] = effective_switch_id;
+            cached_objects.cache(object_id, profile, effective_switch_id);
+            notifyCounterIdListSet(object_id, profile->counter_stats);
+        }
+
+        void clearCounterIdList(
+            struct CachedObjects &cached_objects,
+            const sai_object_id_t object_id)
+        {
+            if (!cached_objects.erase(object_id))
             {
                 /* If the object is not found in the cached objects, clear the counter id list assuming it is already installed */
                 FlexCounterManager::clearCounterIdList(object_id);
             }
+            else
+            {
+                installed_counters.erase(object_id);
+                notifyCounterIdListCleared(object_id);
+            }
         }
 };
 
@@ -318,6 +427,17 @@ class FlexCounterTaggedCachedManager : public FlexCounterCachedManager
                                                        counter_stats);
         }
 
+        virtual void setCounterIdList(
+            const sai_object_id_t object_id,
+            const std::shared_ptr<const CounterProfile>& profile,
+            const sai_object_id_t switch_id=SAI_NULL_OBJECT_ID)
+        {
+            FlexCounterCachedManager::setCounterIdList(cached_objects,
+                                                       object_id,
+                                                       profile,
+                                                       switch_id);
+        }
+
         virtual void clearCounterIdList(
             const sai_object_id_t object_id)
         {
@@ -363,6 +483,18 @@ class FlexCounterTaggedCachedManager<TagType, typename std::enable_if_t<std::is_
                                                        counter_stats);
         }
 
+        void setCounterIdList(
+            const sai_object_id_t object_id,
+            const std::shared_ptr<const CounterProfile>& profile,
+            const TagType tag,
+            const sai_object_id_t switch_id=SAI_NULL_OBJECT_ID)
+        {
+            FlexCounterCachedManager::setCounterIdList(cached_objects[tag],
+                                                       object_id,
+                                                       profile,
+                                                       switch_id);
+        }
+
         void clearCounterIdList(
             const sai_object_id_t object_id,
             const TagType tag)
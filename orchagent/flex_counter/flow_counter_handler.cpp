@@ -3,6 +3,7 @@
 #include "flow_counter_handler.h"
 #include "logger.h"
 #include "sai_serialize.h"
+#include "saicapabilitycache.h"
 
 extern sai_object_id_t      gSwitchId;
 extern sai_counter_api_t*   sai_counter_api;
@@ -51,7 +52,7 @@ void FlowCounterHandler::getGenericCounterStatIdList(std::unordered_set<std::str
 bool FlowCounterHandler::queryRouteFlowCounterCapability()
 {
     sai_attr_capability_t capability;
-    sai_status_t status = sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_ROUTE_ENTRY, SAI_ROUTE_ENTRY_ATTR_COUNTER_ID, &capability);
+    sai_status_t status = querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_ROUTE_ENTRY, SAI_ROUTE_ENTRY_ATTR_COUNTER_ID, &capability);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_WARN("Could not query route entry attribute SAI_ROUTE_ENTRY_ATTR_COUNTER_ID %d", status);
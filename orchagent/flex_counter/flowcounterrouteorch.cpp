@@ -94,11 +94,17 @@ void FlowCounterRouteOrch::doTask(Consumer &consumer)
         }
         consumer.m_toSync.erase(it++);
     }
+
+    processRouteFlowCounterBinding();
 }
 
 void FlowCounterRouteOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
+
+    // Bindings queued by a caller that did not flush them must be settled before registering their counters
+    processRouteFlowCounterBinding();
+
     SWSS_LOG_NOTICE("Add flex counters, pending in queue: %zu", mPendingAddToFlexCntr.size());
     string value;
     std::string nameMapKey;
@@ -186,15 +192,19 @@ void FlowCounterRouteOrch::generateRouteFlowStats()
         return;
     }
 
-    for (const auto &route_pattern : mRoutePatternSet)
+    for (const auto &entry : mRoutePatternIndex)
     {
-        createRouteFlowCounterByPattern(route_pattern, 0);
+        createRouteFlowCounterByVrf(entry.first);
     }
+
+    processRouteFlowCounterBinding();
 }
 
 void FlowCounterRouteOrch::clearRouteFlowStats()
 {
     SWSS_LOG_ENTER();
+    processRouteFlowCounterBinding();
+
     if (!mBoundRouteCounters.empty() || !mPendingAddToFlexCntr.empty())
     {
         for (auto &entry : mBoundRouteCounters)
@@ -218,6 +228,7 @@ void FlowCounterRouteOrch::clearRouteFlowStats()
 
         mBoundRouteCounters.clear();
         mPendingAddToFlexCntr.clear();
+        processRouteFlowCounterBinding();
     }
 }
 
@@ -242,6 +253,7 @@ void FlowCounterRouteOrch::addRoutePattern(const std::string &pattern, size_t ma
             return;
         }
 
+        indexRoutePattern(*insert_result.first);
         createRouteFlowCounterByPattern(*insert_result.first, 0);
     }
     else
@@ -272,6 +284,7 @@ void FlowCounterRouteOrch::removeRoutePattern(const std::string& pattern)
         SWSS_LOG_ERROR("Trying to remove route pattern %s, but it does not exist", pattern.c_str());
         return;
     }
+    unindexRoutePattern(*iter);
     mRoutePatternSet.erase(iter);
 
     removeRoutePattern(route_pattern);
@@ -346,6 +359,7 @@ void FlowCounterRouteOrch::onAddMiscRouteEntry(sai_object_id_t vrf_id, const IpP
     }
 
     handleRouteAdd(vrf_id, ip_prefix);
+    processRouteFlowCounterBinding();
 }
 
 void FlowCounterRouteOrch::onRemoveMiscRouteEntry(sai_object_id_t vrf_id, const sai_ip_prefix_t& ip_pfx, bool remove_from_cache)
@@ -425,10 +439,13 @@ void FlowCounterRouteOrch::onAddVR(sai_object_id_t vrf_id)
         {
             RoutePattern &existing = const_cast<RoutePattern &>(route_pattern);
             existing.vrf_id = vrf_id;
+            indexRoutePattern(existing);
             createRouteFlowCounterByPattern(existing, 0);
             break;
         }
     }
+
+    processRouteFlowCounterBinding();
 }
 
 void FlowCounterRouteOrch::onRemoveVR(sai_object_id_t vrf_id)
@@ -444,13 +461,18 @@ void FlowCounterRouteOrch::onRemoveVR(sai_object_id_t vrf_id)
         if (route_pattern.vrf_id == vrf_id)
         {
             SWSS_LOG_NOTICE("Removing route pattern %s and all related counters due to VRF %s has been removed", route_pattern.to_string().c_str(), route_pattern.vrf_name.c_str());
+            unindexRoutePattern(route_pattern);
             removeRoutePattern(route_pattern);
             RoutePattern &existing = const_cast<RoutePattern &>(route_pattern);
             existing.vrf_id = SAI_NULL_OBJECT_ID;
         }
     }
+
+    processRouteFlowCounterBinding();
 }
 
+// The counter attribute is queued in the bulker and set by processRouteFlowCounterBinding. The
+// counter is accounted to the pattern right away, and released if the binding fails.
 bool FlowCounterRouteOrch::bindFlowCounter(const RoutePattern &route_pattern, sai_object_id_t vrf_id, const IpPrefix& ip_prefix)
 {
     SWSS_LOG_ENTER();
@@ -472,18 +494,14 @@ bool FlowCounterRouteOrch::bindFlowCounter(const RoutePattern &route_pattern, sa
     attr.id = SAI_ROUTE_ENTRY_ATTR_COUNTER_ID;
     attr.value.oid = counter_oid;
 
-    auto status = sai_route_api->set_route_entry_attribute(&route_entry, &attr);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        FlowCounterHandler::removeGenericCounter(counter_oid);
-        SWSS_LOG_WARN("Failed to bind route entry vrf=%s prefix=%s to flow counter", route_pattern.vrf_name.c_str(), ip_prefix.to_string().c_str());
-        return false;
-    }
+    mPendingBindings.emplace_back(route_pattern, ip_prefix, counter_oid);
+    gRouteBulker.set_entry_attribute(&mPendingBindings.back().status, &route_entry, &attr);
 
     pendingUpdateFlexDb(route_pattern, ip_prefix, counter_oid);
     return true;
 }
 
+// The counter is removed by processRouteFlowCounterBinding once the route entry no longer uses it.
 void FlowCounterRouteOrch::unbindFlowCounter(const RoutePattern &route_pattern, sai_object_id_t vrf_id, const IpPrefix& ip_prefix, sai_object_id_t counter_oid)
 {
     SWSS_LOG_ENTER();
@@ -498,13 +516,63 @@ void FlowCounterRouteOrch::unbindFlowCounter(const RoutePattern &route_pattern,
     attr.id = SAI_ROUTE_ENTRY_ATTR_COUNTER_ID;
     attr.value.oid = SAI_NULL_OBJECT_ID;
 
-    auto status = sai_route_api->set_route_entry_attribute(&route_entry, &attr);
-    if (status != SAI_STATUS_SUCCESS)
+    mPendingUnbindings.emplace_back(route_pattern, ip_prefix, counter_oid);
+    gRouteBulker.set_entry_attribute(&mPendingUnbindings.back().status, &route_entry, &attr);
+}
+
+void FlowCounterRouteOrch::processRouteFlowCounterBinding()
+{
+    SWSS_LOG_ENTER();
+
+    if (mPendingBindings.empty() && mPendingUnbindings.empty())
+    {
+        return;
+    }
+
+    gRouteBulker.flush();
+
+    for (const auto &binding : mPendingBindings)
+    {
+        if (binding.status == SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        SWSS_LOG_WARN("Failed to bind route entry vrf=%s prefix=%s to flow counter", binding.route_pattern.vrf_name.c_str(), binding.ip_prefix.to_string().c_str());
+
+        // Release the counter unless the route entry was unbound or removed meanwhile, which released it already
+        auto pending_iter = mPendingAddToFlexCntr.find(binding.route_pattern);
+        if (pending_iter == mPendingAddToFlexCntr.end())
+        {
+            continue;
+        }
+
+        auto iter_prefix = pending_iter->second.find(binding.ip_prefix);
+        if (iter_prefix == pending_iter->second.end() || iter_prefix->second != binding.counter_oid)
+        {
+            continue;
+        }
+
+        pending_iter->second.erase(iter_prefix);
+        if (pending_iter->second.empty())
+        {
+            mPendingAddToFlexCntr.erase(pending_iter);
+        }
+        FlowCounterHandler::removeGenericCounter(binding.counter_oid);
+    }
+
+    for (const auto &unbinding : mPendingUnbindings)
     {
-        SWSS_LOG_WARN("Failed to unbind route entry vrf=%s prefix=%s from flow counter", route_pattern.vrf_name.c_str(), ip_prefix.to_string().c_str());
+        if (unbinding.status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_WARN("Failed to unbind route entry vrf=%s prefix=%s from flow counter", unbinding.route_pattern.vrf_name.c_str(), unbinding.ip_prefix.to_string().c_str());
+        }
+
+        FlowCounterHandler::removeGenericCounter(unbinding.counter_oid);
     }
 
-    FlowCounterHandler::removeGenericCounter(counter_oid);
+    mPendingBindings.clear();
+    mPendingUnbindings.clear();
 }
 
 bool FlowCounterRouteOrch::removeRouteFlowCounter(const RoutePattern &route_pattern, sai_object_id_t vrf_id, const IpPrefix& ip_prefix)
@@ -587,6 +655,55 @@ bool FlowCounterRouteOrch::validateRoutePattern(const RoutePattern &route_patter
     return true;
 }
 
+void FlowCounterRouteOrch::indexRoutePattern(const RoutePattern &route_pattern)
+{
+    SWSS_LOG_ENTER();
+
+    // A pattern of an unresolved VRF cannot match any route
+    if (route_pattern.vrf_id == SAI_NULL_OBJECT_ID)
+    {
+        return;
+    }
+
+    mRoutePatternIndex[route_pattern.vrf_id].insert(route_pattern.ip_prefix, &route_pattern);
+}
+
+void FlowCounterRouteOrch::unindexRoutePattern(const RoutePattern &route_pattern)
+{
+    SWSS_LOG_ENTER();
+
+    auto iter = mRoutePatternIndex.find(route_pattern.vrf_id);
+    if (iter == mRoutePatternIndex.end())
+    {
+        return;
+    }
+
+    iter->second.erase(route_pattern.ip_prefix);
+    if (iter->second.empty())
+    {
+        mRoutePatternIndex.erase(iter);
+    }
+}
+
+// Patterns of a VRF do not overlap, so a route matches at most one of them: the longest one covering
+// the route, unless that one is the exact default route pattern.
+const RoutePattern *FlowCounterRouteOrch::findRoutePattern(sai_object_id_t vrf_id, const IpPrefix &ip_prefix) const
+{
+    auto iter = mRoutePatternIndex.find(vrf_id);
+    if (iter == mRoutePatternIndex.end())
+    {
+        return nullptr;
+    }
+
+    auto match = iter->second.longestMatch(ip_prefix);
+    if (!match || !(*match)->is_match(vrf_id, ip_prefix))
+    {
+        return nullptr;
+    }
+
+    return *match;
+}
+
 size_t FlowCounterRouteOrch::getRouteFlowCounterSizeByPattern(const RoutePattern &route_pattern) const
 {
     SWSS_LOG_ENTER();
@@ -689,6 +806,84 @@ void FlowCounterRouteOrch::createRouteFlowCounterByPattern(const RoutePattern &r
     }
 }
 
+// Binds the routes of a VRF to all its patterns in one pass over the routes, each route looking up its
+// pattern in the index instead of every pattern going through all the routes.
+void FlowCounterRouteOrch::createRouteFlowCounterByVrf(sai_object_id_t vrf_id)
+{
+    SWSS_LOG_ENTER();
+    if (!isRouteFlowCounterEnabled())
+    {
+        return;
+    }
+
+    std::map<const RoutePattern *, size_t> bound_counts;
+    size_t open_patterns = 0;
+    for (const auto &route_pattern : mRoutePatternSet)
+    {
+        if (route_pattern.vrf_id != vrf_id)
+        {
+            continue;
+        }
+
+        auto current_bound_count = getRouteFlowCounterSizeByPattern(route_pattern);
+        bound_counts[&route_pattern] = current_bound_count;
+        if (current_bound_count < route_pattern.max_match_count)
+        {
+            ++open_patterns;
+        }
+    }
+
+    auto bind_route = [&](const IpPrefix &ip_prefix) {
+        auto route_pattern = findRoutePattern(vrf_id, ip_prefix);
+        if (!route_pattern)
+        {
+            return;
+        }
+
+        auto &current_bound_count = bound_counts[route_pattern];
+        if (current_bound_count >= route_pattern->max_match_count || isRouteAlreadyBound(*route_pattern, ip_prefix))
+        {
+            return;
+        }
+
+        if (bindFlowCounter(*route_pattern, vrf_id, ip_prefix) && ++current_bound_count == route_pattern->max_match_count)
+        {
+            --open_patterns;
+        }
+    };
+
+    auto &syncdRoutes = gRouteOrch->getSyncdRoutes();
+    auto iter = syncdRoutes.find(vrf_id);
+    if (iter != syncdRoutes.end())
+    {
+        SWSS_LOG_NOTICE("Creating route flow counter for VRF %s", sai_serialize_object_id(vrf_id).c_str());
+
+        for (auto &entry : iter->second)
+        {
+            if (open_patterns == 0)
+            {
+                return;
+            }
+
+            bind_route(entry.first);
+        }
+    }
+
+    for (auto &entry : bound_counts)
+    {
+        createRouteFlowCounterFromVnetRoutes(*entry.first, entry.second);
+    }
+
+    auto misc_iter = mMiscRoutes.find(vrf_id);
+    if (misc_iter != mMiscRoutes.end())
+    {
+        for (const auto &ip_prefix : misc_iter->second)
+        {
+            bind_route(ip_prefix);
+        }
+    }
+}
+
 void FlowCounterRouteOrch::createRouteFlowCounterFromVnetRoutes(const RoutePattern &route_pattern, size_t& current_bound_count)
 {
     SWSS_LOG_ENTER();
@@ -808,6 +1003,7 @@ void FlowCounterRouteOrch::onRoutePatternMaxMatchCountChange(RoutePattern &route
             return;
         }
 
+        processRouteFlowCounterBinding();
         auto current_bound_count = getRouteFlowCounterSizeByPattern(route_pattern);
         SWSS_LOG_NOTICE("Current bound route flow counter count is %zu, new limit is %zu, old limit is %zu", current_bound_count, new_max_match_count, old_max_match_count);
         if (new_max_match_count > old_max_match_count)
@@ -867,16 +1063,13 @@ void FlowCounterRouteOrch::handleRouteAdd(sai_object_id_t vrf_id, const IpPrefix
         return;
     }
 
-    for (const auto &route_pattern : mRoutePatternSet)
+    auto route_pattern = findRoutePattern(vrf_id, ip_prefix);
+    if (route_pattern)
     {
-        if (route_pattern.is_match(vrf_id, ip_prefix))
+        auto current_bound_count = getRouteFlowCounterSizeByPattern(*route_pattern);
+        if (current_bound_count < route_pattern->max_match_count)
         {
-            auto current_bound_count = getRouteFlowCounterSizeByPattern(route_pattern);
-            if (current_bound_count < route_pattern.max_match_count)
-            {
-                bindFlowCounter(route_pattern, vrf_id, ip_prefix);
-            }
-            break;
+            bindFlowCounter(*route_pattern, vrf_id, ip_prefix);
         }
     }
 }
@@ -893,22 +1086,25 @@ void FlowCounterRouteOrch::handleRouteRemove(sai_object_id_t vrf_id, const IpPre
         return;
     }
 
-    for (const auto &route_pattern : mRoutePatternSet)
+    auto route_pattern = findRoutePattern(vrf_id, ip_prefix);
+    if (!route_pattern)
+    {
+        return;
+    }
+
+    // The route entry is gone, a binding still queued for it must not outlive its counter
+    processRouteFlowCounterBinding();
+
+    if (isRouteAlreadyBound(*route_pattern, ip_prefix))
     {
-        if (route_pattern.is_match(vrf_id, ip_prefix))
+        if (removeRouteFlowCounter(*route_pattern, vrf_id, ip_prefix))
         {
-            if (isRouteAlreadyBound(route_pattern, ip_prefix))
+            auto current_bound_count = getRouteFlowCounterSizeByPattern(*route_pattern);
+            if (current_bound_count == route_pattern->max_match_count - 1)
             {
-                if (removeRouteFlowCounter(route_pattern, vrf_id, ip_prefix))
-                {
-                    auto current_bound_count = getRouteFlowCounterSizeByPattern(route_pattern);
-                    if (current_bound_count == route_pattern.max_match_count - 1)
-                    {
-                        createRouteFlowCounterByPattern(route_pattern, current_bound_count);
-                    }
-                }
+                createRouteFlowCounterByPattern(*route_pattern, current_bound_count);
+                processRouteFlowCounterBinding();
             }
-            break;
         }
     }
 }
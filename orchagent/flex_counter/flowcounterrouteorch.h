@@ -4,6 +4,8 @@
 #include "dbconnector.h"
 #include "ipprefix.h"
 #include "orch.h"
+#include "prefixtrie.h"
+#include <deque>
 #include <map>
 #include <memory>
 #include <set>
@@ -101,6 +103,22 @@ typedef std::set<RoutePattern> RoutePatternSet;
 typedef std::map<RoutePattern, std::map<IpPrefix, sai_object_id_t>> RouterFlowCounterCache;
 /* IP2ME, MUX, VNET route entries */
 typedef std::map<sai_object_id_t, std::set<IpPrefix>> MiscRouteEntryMap;
+/* VRF id to the route patterns of the VRF, patterns are owned by RoutePatternSet */
+typedef std::map<sai_object_id_t, PrefixTrie<const RoutePattern *>> RoutePatternIndex;
+
+/* Route entry counter attribute queued in the bulker */
+struct RouteFlowCounterBinding
+{
+    RouteFlowCounterBinding(const RoutePattern &pattern, const IpPrefix &prefix, sai_object_id_t counter)
+        :route_pattern(pattern), ip_prefix(prefix), counter_oid(counter)
+    {
+    }
+
+    RoutePattern                        route_pattern;
+    IpPrefix                            ip_prefix;
+    sai_object_id_t                     counter_oid;
+    sai_status_t                        status = SAI_STATUS_NOT_EXECUTED;
+};
 
 class FlowCounterRouteOrch : public Orch
 {
@@ -137,6 +155,8 @@ private:
     bool mRouteFlowCounterSupported = false;
     /* Route pattern set, store configured route patterns */
     RoutePatternSet mRoutePatternSet;
+    /* Resolved route patterns by VRF and prefix, to find the pattern of a route */
+    RoutePatternIndex mRoutePatternIndex;
     /* Cache for those bound route flow counters*/
     RouterFlowCounterCache mBoundRouteCounters;
     /* Cache for those route flow counters pending update to FLEX DB */
@@ -149,6 +169,9 @@ private:
     SelectableTimer *mFlexCounterUpdTimer = nullptr;
 
     EntityBulker<sai_route_api_t> gRouteBulker;
+    /* Counter bindings and unbindings queued in gRouteBulker, their statuses are referenced by the bulker */
+    std::deque<RouteFlowCounterBinding> mPendingBindings;
+    std::deque<RouteFlowCounterBinding> mPendingUnbindings;
 
     void initRouteFlowCounterCapability();
     void removeRoutePattern(const RoutePattern &route_pattern);
@@ -162,9 +185,13 @@ private:
         sai_object_id_t counter_oid,
         RouterFlowCounterCache &cache);
     bool validateRoutePattern(const RoutePattern &route_pattern) const;
+    void indexRoutePattern(const RoutePattern &route_pattern);
+    void unindexRoutePattern(const RoutePattern &route_pattern);
+    const RoutePattern *findRoutePattern(sai_object_id_t vrf_id, const IpPrefix &ip_prefix) const;
     void onRoutePatternMaxMatchCountChange(RoutePattern &route_pattern, size_t new_max_match_count);
     bool isRouteAlreadyBound(const RoutePattern &route_pattern, const IpPrefix &ip_prefix) const;
     void createRouteFlowCounterByPattern(const RoutePattern &route_pattern, size_t currentBoundCount);
+    void createRouteFlowCounterByVrf(sai_object_id_t vrf_id);
     /* Return true if it actaully removed a counter so that caller need to fill the hole if possible*/
     bool removeRouteFlowCounter(const RoutePattern &route_pattern, sai_object_id_t vrf_id, const IpPrefix& ip_prefix);
     void createRouteFlowCounterFromVnetRoutes(const RoutePattern &route_pattern, size_t& current_bound_count);
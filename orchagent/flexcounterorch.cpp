@@ -1,4 +1,5 @@
 #include <unordered_map>
+#include <cmath>
 
 #include <select.h>
 #include <tokenize.h>
@@ -18,6 +19,8 @@
 #include "switchorch.h"
 #include "debugcounterorch.h"
 #include "fabricportsorch.h"
+#include "counterratesorch.h"
+#include "countersnapshotorch.h"
 
 #include "dash/dashorch.h"
 #include "dash/dashmeterorch.h"
@@ -32,6 +35,7 @@ extern sai_switch_api_t *sai_switch_api;
 extern PortsOrch *gPortsOrch;
 extern FabricPortsOrch *gFabricPortsOrch;
 extern IntfsOrch *gIntfsOrch;
+extern DebugCounterOrch *gDebugCounterOrch;
 extern BufferOrch *gBufferOrch;
 extern Directory<Orch*> gDirectory;
 extern CoppOrch *gCoppOrch;
@@ -65,6 +69,14 @@ extern string gMySwitchType;
 #define SWITCH_KEY                  "SWITCH"
 #define HA_SET_KEY                  "HA_SET"
 
+/* Polling schedule, see FlexCounterOrch::GroupSchedule */
+#define GLOBAL_KEY                  "GLOBAL"
+#define POLL_PHASE_OFFSET_FIELD     "POLL_PHASE_OFFSET"
+#define POLL_STAGGER_FIELD          "POLL_STAGGER"
+#define POLL_BUDGET_FIELD           "POLL_BUDGET"
+/* Per port queue and PG counters of the ports in use only, see PortsOrch::setCountersOperUpOnly() */
+#define OPER_UP_ONLY_FIELD          "OPER_UP_ONLY"
+
 unordered_map<string, string> flexCounterGroupMap =
 {
     {"PORT", PORT_STAT_COUNTER_FLEX_COUNTER_GROUP},
@@ -99,6 +111,21 @@ unordered_map<string, string> flexCounterGroupMap =
 };
 
 
+static bool parseMsecs(const string &value, uint32_t &msecs)
+{
+    try
+    {
+        msecs = static_cast<uint32_t>(stoul(value));
+    }
+    catch (const exception &)
+    {
+        SWSS_LOG_ERROR("Invalid flex counter polling value %s", value.c_str());
+        return false;
+    }
+
+    return true;
+}
+
 FlexCounterOrch::FlexCounterOrch(DBConnector *db, vector<string> &tableNames):
     Orch(db, tableNames),
     m_bufferQueueConfigTable(db, CFG_BUFFER_QUEUE_TABLE_NAME),
@@ -135,6 +162,10 @@ FlexCounterOrch::FlexCounterOrch(DBConnector *db, vector<string> &tableNames):
     {
         m_delayTimerExpired = true;
     }
+
+    m_phaseTimer = new SelectableTimer(timespec{.tv_sec = 1, .tv_nsec = 0});
+    auto executor = new ExecutableTimer(m_phaseTimer, this, "FLEX_COUNTER_PHASE");
+    Orch::addExecutor(executor);
 }
 
 FlexCounterOrch::~FlexCounterOrch(void)
@@ -180,6 +211,13 @@ void FlexCounterOrch::doTask(Consumer &consumer)
         string op = kfvOp(t);
         auto data = kfvFieldsValues(t);
 
+        if (key == GLOBAL_KEY)
+        {
+            handleGlobalConfig(op, data);
+            consumer.m_toSync.erase(it++);
+            continue;
+        }
+
         if (!flexCounterGroupMap.count(key))
         {
             SWSS_LOG_NOTICE("Invalid flex counter group input, %s", key.c_str());
@@ -192,6 +230,17 @@ void FlexCounterOrch::doTask(Consumer &consumer)
             string bulk_chunk_size;
             string bulk_chunk_size_per_counter;
 
+            // The phase offset has to be known when FLEX_COUNTER_STATUS is handled
+            auto &schedule = m_groupSchedules[key];
+            schedule.hasPhaseOffset = false;
+            for (const auto &valuePair : data)
+            {
+                if (fvField(valuePair) == POLL_PHASE_OFFSET_FIELD)
+                {
+                    schedule.hasPhaseOffset = parseMsecs(fvValue(valuePair), schedule.phaseOffset);
+                }
+            }
+
             for (auto valuePair:data)
             {
                 const auto &field = fvField(valuePair);
@@ -199,20 +248,17 @@ void FlexCounterOrch::doTask(Consumer &consumer)
 
                 if (field == POLL_INTERVAL_FIELD)
                 {
-                    setFlexCounterGroupPollInterval(flexCounterGroupMap[key], value);
-
-                    if (gPortsOrch && gPortsOrch->isGearboxEnabled())
-                    {
-                        if (key == PORT_KEY || key.rfind("MACSEC", 0) == 0)
-                        {
-                            setFlexCounterGroupPollInterval(flexCounterGroupMap[key], value, true);
-                        }
-                    }
-                    // PORT_PHY_ATTR_KEY and PORT_PHY_SERDES_ATTR_KEY share the 'counterpoll phy' knob
-                    if (key == PORT_PHY_ATTR_KEY)
+                    // Rescaled by applyPollBudget() once the whole table is handled
+                    if (!parseMsecs(value, schedule.pollInterval))
                     {
-                        setFlexCounterGroupPollInterval(flexCounterGroupMap[PORT_PHY_SERDES_ATTR_KEY], value);
+                        schedule.pollInterval = 0;
                     }
+                    schedule.appliedInterval = schedule.pollInterval;
+                    setGroupPollInterval(key, value);
+                }
+                else if (field == POLL_PHASE_OFFSET_FIELD)
+                {
+                    // Already taken into account
                 }
                 else if (field == BULK_CHUNK_SIZE_FIELD)
                 {
@@ -284,6 +330,14 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                     {
                         gIntfsOrch->generateInterfaceMap();
                     }
+                    if (key == PORT_KEY)
+                    {
+                        CounterRatesOrch::getInstance().setState(CounterRatesOrch::PORT_RATES, (value == "enable"));
+                    }
+                    else if (key == RIF_KEY)
+                    {
+                        CounterRatesOrch::getInstance().setState(CounterRatesOrch::RIF_RATES, (value == "enable"));
+                    }
                     if (gBufferOrch && (key == BUFFER_POOL_WATERMARK_KEY) && (value == "enable"))
                     {
                         gBufferOrch->generateBufferPoolWatermarkCounterIdList();
@@ -377,20 +431,7 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                         gPortsOrch->flushCounters();
                     }
 
-                    setFlexCounterGroupOperation(flexCounterGroupMap[key], value);
-
-                    if (gPortsOrch && gPortsOrch->isGearboxEnabled())
-                    {
-                        if (key == PORT_KEY || key.rfind("MACSEC", 0) == 0)
-                        {
-                            setFlexCounterGroupOperation(flexCounterGroupMap[key], value, true);
-                        }
-                    }
-                    // PORT_PHY_ATTR_KEY and PORT_PHY_SERDES_ATTR_KEY share the 'counterpoll phy' knob
-                    if (key == PORT_PHY_ATTR_KEY)
-                    {
-                        setFlexCounterGroupOperation(flexCounterGroupMap[PORT_PHY_SERDES_ATTR_KEY], value);
-                    }
+                    scheduleGroupOperation(key, value);
                 }
                 else
                 {
@@ -414,12 +455,20 @@ void FlexCounterOrch::doTask(Consumer &consumer)
 
         consumer.m_toSync.erase(it++);
     }
+
+    applyPollBudget();
 }
 
-void FlexCounterOrch::doTask(SelectableTimer&)
+void FlexCounterOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    if (&timer == m_phaseTimer)
+    {
+        applyPendingOperations();
+        return;
+    }
+
     if (m_delayTimerExpired)
     {
         return;
@@ -430,6 +479,242 @@ void FlexCounterOrch::doTask(SelectableTimer&)
     m_delayTimerExpired = true;
 }
 
+void FlexCounterOrch::handleGlobalConfig(const string &op, const vector<FieldValueTuple> &data)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t stagger = 0;
+    uint32_t budget = 0;
+    bool operUpOnly = false;
+
+    if (op == SET_COMMAND)
+    {
+        for (const auto &valuePair : data)
+        {
+            const auto &field = fvField(valuePair);
+            const auto &value = fvValue(valuePair);
+
+            if (field == POLL_STAGGER_FIELD)
+            {
+                parseMsecs(value, stagger);
+            }
+            else if (field == POLL_BUDGET_FIELD)
+            {
+                parseMsecs(value, budget);
+            }
+            else if (field == OPER_UP_ONLY_FIELD)
+            {
+                operUpOnly = value == "true";
+            }
+            else
+            {
+                SWSS_LOG_NOTICE("Unsupported field %s", field.c_str());
+            }
+        }
+    }
+
+    if (stagger != m_pollStagger || budget != m_pollBudget)
+    {
+        SWSS_LOG_NOTICE("Flex counter polling stagger %u ms, budget %u polls per second", stagger, budget);
+    }
+
+    m_pollStagger = stagger;
+    m_pollBudget = budget;
+
+    if (gPortsOrch)
+    {
+        gPortsOrch->setCountersOperUpOnly(operUpOnly);
+    }
+}
+
+void FlexCounterOrch::setGroupPollInterval(const string &key, const string &value)
+{
+    setFlexCounterGroupPollInterval(flexCounterGroupMap[key], value);
+
+    if (gPortsOrch && gPortsOrch->isGearboxEnabled())
+    {
+        if (key == PORT_KEY || key.rfind("MACSEC", 0) == 0)
+        {
+            setFlexCounterGroupPollInterval(flexCounterGroupMap[key], value, true);
+        }
+    }
+    // PORT_PHY_ATTR_KEY and PORT_PHY_SERDES_ATTR_KEY share the 'counterpoll phy' knob
+    if (key == PORT_PHY_ATTR_KEY)
+    {
+        setFlexCounterGroupPollInterval(flexCounterGroupMap[PORT_PHY_SERDES_ATTR_KEY], value);
+    }
+    // Port and RIF rates are computed on the poll interval of their counters
+    if (key == PORT_KEY)
+    {
+        CounterRatesOrch::getInstance().setPollInterval(CounterRatesOrch::PORT_RATES, value);
+    }
+    else if (key == RIF_KEY)
+    {
+        CounterRatesOrch::getInstance().setPollInterval(CounterRatesOrch::RIF_RATES, value);
+    }
+    // Persistent drops are detected on the poll interval of the drop counters
+    if (gDebugCounterOrch && flexCounterGroupMap[key] == DEBUG_DROP_MONITOR_FLEX_COUNTER_GROUP)
+    {
+        gDebugCounterOrch->setDropMonitorPollInterval(value);
+    }
+    if (CounterSnapshotOrch::isEnabled())
+    {
+        CounterSnapshotOrch::getInstance().setPollInterval(flexCounterGroupMap[key], value);
+    }
+}
+
+void FlexCounterOrch::setGroupOperation(const string &key, const string &value)
+{
+    setFlexCounterGroupOperation(flexCounterGroupMap[key], value);
+
+    if (gPortsOrch && gPortsOrch->isGearboxEnabled())
+    {
+        if (key == PORT_KEY || key.rfind("MACSEC", 0) == 0)
+        {
+            setFlexCounterGroupOperation(flexCounterGroupMap[key], value, true);
+        }
+    }
+    // PORT_PHY_ATTR_KEY and PORT_PHY_SERDES_ATTR_KEY share the 'counterpoll phy' knob
+    if (key == PORT_PHY_ATTR_KEY)
+    {
+        setFlexCounterGroupOperation(flexCounterGroupMap[PORT_PHY_SERDES_ATTR_KEY], value);
+    }
+}
+
+/*
+ * syncd polls a group every interval from the time it is enabled, so groups
+ * enabled together keep polling on the same ticks. Enabling a group after its
+ * phase offset, explicit or given by POLL_STAGGER, spreads the polls apart.
+ */
+void FlexCounterOrch::scheduleGroupOperation(const string &key, const string &value)
+{
+    SWSS_LOG_ENTER();
+
+    auto &schedule = m_groupSchedules[key];
+    bool wasEnabled = schedule.enabled;
+
+    schedule.enabled = (value == "enable");
+    if (!schedule.enabled)
+    {
+        schedule.enablePending = false;
+        setGroupOperation(key, value);
+        return;
+    }
+
+    if (schedule.enablePending)
+    {
+        return;
+    }
+
+    uint32_t phase = 0;
+    if (!wasEnabled)
+    {
+        if (schedule.hasPhaseOffset)
+        {
+            phase = schedule.phaseOffset;
+        }
+        else if (m_pollStagger)
+        {
+            phase = m_pollStagger * m_staggerSlot++;
+            if (schedule.pollInterval)
+            {
+                phase %= schedule.pollInterval;
+            }
+        }
+    }
+
+    if (phase == 0)
+    {
+        setGroupOperation(key, value);
+        return;
+    }
+
+    SWSS_LOG_INFO("Enabling flex counter group %s in %u ms", key.c_str(), phase);
+    schedule.enablePending = true;
+    schedule.enableAt = chrono::steady_clock::now() + chrono::milliseconds(phase);
+    applyPendingOperations();
+}
+
+void FlexCounterOrch::applyPendingOperations()
+{
+    auto now = chrono::steady_clock::now();
+    auto next = chrono::steady_clock::time_point::max();
+
+    for (auto &it : m_groupSchedules)
+    {
+        auto &schedule = it.second;
+        if (!schedule.enablePending)
+        {
+            continue;
+        }
+
+        if (schedule.enableAt <= now)
+        {
+            schedule.enablePending = false;
+            setGroupOperation(it.first, "enable");
+        }
+        else
+        {
+            next = min(next, schedule.enableAt);
+        }
+    }
+
+    m_phaseTimer->stop();
+    if (next == chrono::steady_clock::time_point::max())
+    {
+        return;
+    }
+
+    auto usecs = chrono::duration_cast<chrono::microseconds>(next - now).count();
+    m_phaseTimer->setInterval(timespec{.tv_sec = usecs / 1000000, .tv_nsec = (usecs % 1000000) * 1000});
+    m_phaseTimer->start();
+}
+
+/*
+ * Stretch the poll intervals of the enabled groups by the same factor when
+ * they add up to more polls per second than POLL_BUDGET allows
+ */
+void FlexCounterOrch::applyPollBudget()
+{
+    double rate = 0;
+    for (const auto &it : m_groupSchedules)
+    {
+        if (it.second.enabled && it.second.pollInterval)
+        {
+            rate += 1000.0 / it.second.pollInterval;
+        }
+    }
+
+    double scale = 1.0;
+    if (m_pollBudget && rate > m_pollBudget)
+    {
+        scale = rate / m_pollBudget;
+    }
+
+    for (auto &it : m_groupSchedules)
+    {
+        auto &schedule = it.second;
+        if (!schedule.pollInterval)
+        {
+            continue;
+        }
+
+        uint32_t interval = schedule.pollInterval;
+        if (schedule.enabled)
+        {
+            interval = static_cast<uint32_t>(ceil(schedule.pollInterval * scale));
+        }
+
+        if (interval != schedule.appliedInterval)
+        {
+            SWSS_LOG_NOTICE("Polling flex counter group %s every %u ms instead of %u ms to stay in the poll budget",
+                            it.first.c_str(), interval, schedule.pollInterval);
+            schedule.appliedInterval = interval;
+            setGroupPollInterval(it.first, to_string(interval));
+        }
+    }
+}
+
 bool FlexCounterOrch::getPortCountersState() const
 {
     return m_port_counter_enabled;
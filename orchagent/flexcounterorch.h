@@ -6,6 +6,7 @@
 #include "producertable.h"
 #include "selectabletimer.h"
 #include "table.h"
+#include <chrono>
 
 extern "C" {
 #include "sai.h"
@@ -62,7 +63,29 @@ public:
     bool bake() override;
 
 private:
+    /*
+     * Polling schedule of a flex counter group: the poll interval set in
+     * FLEX_COUNTER_TABLE, the one applied once the global poll budget is
+     * enforced, and the phase offset applied to its enable
+     */
+    struct GroupSchedule
+    {
+        uint32_t pollInterval = 0;
+        uint32_t appliedInterval = 0;
+        bool hasPhaseOffset = false;
+        uint32_t phaseOffset = 0;
+        bool enabled = false;
+        bool enablePending = false;
+        std::chrono::steady_clock::time_point enableAt;
+    };
+
     void handleDeviceMetadataTable(Consumer &consumer);
+    void handleGlobalConfig(const std::string &op, const std::vector<swss::FieldValueTuple> &data);
+    void setGroupPollInterval(const std::string &key, const std::string &value);
+    void setGroupOperation(const std::string &key, const std::string &value);
+    void scheduleGroupOperation(const std::string &key, const std::string &value);
+    void applyPendingOperations();
+    void applyPollBudget();
     bool m_port_counter_enabled = false;
     bool m_port_phy_attr_enabled = false;
     bool m_port_phy_serdes_attr_enabled = false;
@@ -83,6 +106,14 @@ private:
     std::unique_ptr<Executor> m_delayExecutor;
     std::unordered_set<std::string> m_groupsWithBulkChunkSize;
 
+    std::map<std::string, GroupSchedule> m_groupSchedules;
+    /* Spacing of the phases given to groups without POLL_PHASE_OFFSET, 0 to enable them right away */
+    uint32_t m_pollStagger = 0;
+    uint32_t m_staggerSlot = 0;
+    /* Group polls per second allowed across the enabled groups, 0 for no limit */
+    uint32_t m_pollBudget = 0;
+    SelectableTimer *m_phaseTimer = nullptr;
+
     bool m_createOnlyConfigDbBuffers = false;
 };
 
@@ -0,0 +1,141 @@
+#include "flushpolicy.h"
+
+using namespace std;
+
+constexpr double FlushPolicy::IDLE_FRACTION;
+constexpr double FlushPolicy::RATE_WEIGHT;
+
+FlushPolicy::FlushPolicy()
+    : m_lastFlush(Clock::now())
+{
+}
+
+void FlushPolicy::configure(int latencyMsec, size_t batchOps)
+{
+    m_latency = chrono::milliseconds(max(latencyMsec, 0));
+    m_batchOps = batchOps;
+}
+
+void FlushPolicy::addOps(size_t ops, Clock::time_point now)
+{
+    if (ops == 0)
+    {
+        return;
+    }
+
+    if (m_pendingOps == 0)
+    {
+        m_oldestOp = now;
+    }
+    m_pendingOps += ops;
+}
+
+void FlushPolicy::recordWait(Clock::duration wait)
+{
+    m_waited += wait;
+}
+
+FlushPolicy::Reason FlushPolicy::check(Clock::time_point now) const
+{
+    if (!isAdaptive() || m_pendingOps == 0)
+    {
+        return Reason::NONE;
+    }
+
+    if (m_batchOps != 0 && m_pendingOps >= m_batchOps)
+    {
+        return Reason::BATCH;
+    }
+
+    auto deadline = m_oldestOp + m_latency;
+    if (now >= deadline)
+    {
+        return Reason::LATENCY;
+    }
+
+    auto elapsed = now - m_lastFlush;
+    if (elapsed.count() <= 0 ||
+        static_cast<double>(m_waited.count()) < IDLE_FRACTION * static_cast<double>(elapsed.count()))
+    {
+        return Reason::NONE;
+    }
+
+    if (m_batchOps == 0)
+    {
+        return Reason::IDLE;
+    }
+
+    // Ops expected until the deadline, holding the batch only pays off if it fills up by then
+    double remainingUsec = static_cast<double>(chrono::duration_cast<chrono::microseconds>(deadline - now).count());
+    if (static_cast<double>(m_pendingOps) + m_opsPerUsec * remainingUsec < static_cast<double>(m_batchOps))
+    {
+        return Reason::IDLE;
+    }
+
+    return Reason::NONE;
+}
+
+int FlushPolicy::timeout(Clock::time_point now, int maxMsec) const
+{
+    if (!isAdaptive() || m_pendingOps == 0)
+    {
+        return maxMsec;
+    }
+
+    auto left = m_oldestOp + m_latency - now;
+    if (left.count() <= 0)
+    {
+        return 0;
+    }
+
+    // Round up, waking up just before the deadline would only spin
+    auto msec = chrono::duration_cast<chrono::milliseconds>(left + chrono::milliseconds(1) - Clock::duration(1)).count();
+
+    return static_cast<int>(min<long long>(msec, maxMsec));
+}
+
+void FlushPolicy::flushed(Clock::time_point now, Reason reason)
+{
+    auto interval = chrono::duration_cast<chrono::microseconds>(now - m_lastFlush).count();
+
+    if (interval > 0)
+    {
+        double rate = static_cast<double>(m_pendingOps) / static_cast<double>(interval);
+        m_opsPerUsec = RATE_WEIGHT * rate + (1 - RATE_WEIGHT) * m_opsPerUsec;
+    }
+
+    if (m_stats)
+    {
+        m_stats->flushOps.record(m_pendingOps);
+        m_stats->flushIntervalUsec.record(static_cast<uint64_t>(max<decltype(interval)>(interval, 0)));
+        if (m_pendingOps != 0)
+        {
+            m_stats->flushDelayUsec.record(static_cast<uint64_t>(
+                chrono::duration_cast<chrono::microseconds>(now - m_oldestOp).count()));
+        }
+        m_stats->totalFlushes.fetch_add(1, memory_order_relaxed);
+
+        switch (reason)
+        {
+            case Reason::PERIODIC:
+                m_stats->totalPeriodic.fetch_add(1, memory_order_relaxed);
+                break;
+            case Reason::BATCH:
+                m_stats->totalBatch.fetch_add(1, memory_order_relaxed);
+                break;
+            case Reason::LATENCY:
+                m_stats->totalLatency.fetch_add(1, memory_order_relaxed);
+                break;
+            case Reason::IDLE:
+                m_stats->totalIdle.fetch_add(1, memory_order_relaxed);
+                break;
+            default:
+                m_stats->totalForced.fetch_add(1, memory_order_relaxed);
+                break;
+        }
+    }
+
+    m_pendingOps = 0;
+    m_waited = Clock::duration(0);
+    m_lastFlush = now;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include "executorstats.h"
+
+/*
+ * Decides when the OrchDaemon main loop flushes the sairedis pipeline.
+ *
+ * Without a latency target the loop keeps its fixed cadence, a flush every
+ * SELECT_TIMEOUT and on every select timeout. With a latency target the ops
+ * queued since the last flush are flushed as soon as
+ *  - BATCH:   batchOps of them are pending, a full pipeline gains nothing by waiting
+ *  - LATENCY: the oldest of them has waited for the latency target
+ *  - IDLE:    the loop is mostly waiting in select and, at the current op
+ *             rate, the batch would not fill before the latency target anyway
+ *
+ * Ops are the tasks completed by the main loop, see ConsumerBase::takeDrainedTasks().
+ * Everything runs on the main thread.
+ */
+class FlushPolicy
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Reason
+    {
+        NONE,
+        PERIODIC,
+        BATCH,
+        LATENCY,
+        IDLE,
+        // Flush requested outside of the policy, e.g. before the warm restart freeze
+        FORCED,
+    };
+
+    /* Share of the time since the last flush spent in select above which the loop is idle */
+    static constexpr double IDLE_FRACTION = 0.5;
+    /* Weight of the last flush interval in the op rate estimate */
+    static constexpr double RATE_WEIGHT = 0.25;
+
+    FlushPolicy();
+
+    /**
+     * @param latencyMsec - longest time an op may wait for a flush, 0 keeps the fixed cadence
+     * @param batchOps - pending ops flushed at once, 0 flushes on age and idleness only
+     */
+    void configure(int latencyMsec, size_t batchOps);
+    void setStats(std::shared_ptr<FlushStats> stats) { m_stats = std::move(stats); }
+
+    bool isAdaptive() const { return m_latency.count() > 0; }
+
+    void addOps(size_t ops, Clock::time_point now);
+    /* Account time the main loop spent waiting for events */
+    void recordWait(Clock::duration wait);
+
+    /* Reason to flush now, or NONE */
+    Reason check(Clock::time_point now) const;
+
+    /* Select timeout in milliseconds which wakes the loop up at the latency deadline */
+    int timeout(Clock::time_point now, int maxMsec) const;
+
+    /* Account a flush and start a new interval */
+    void flushed(Clock::time_point now, Reason reason);
+
+    size_t getPendingOps() const { return m_pendingOps; }
+    double getOpsPerUsec() const { return m_opsPerUsec; }
+
+private:
+    std::chrono::milliseconds m_latency{0};
+    size_t m_batchOps = 0;
+
+    size_t m_pendingOps = 0;
+    Clock::time_point m_oldestOp;
+    Clock::time_point m_lastFlush;
+    // Time spent in select since m_lastFlush
+    Clock::duration m_waited{0};
+    // Moving average of the op rate over the flush intervals
+    double m_opsPerUsec = 0;
+
+    std::shared_ptr<FlushStats> m_stats;
+};
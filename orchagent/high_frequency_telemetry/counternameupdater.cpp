@@ -19,20 +19,7 @@ void CounterNameMapUpdater::setCounterNameMap(const std::string &counter_name, s
 {
     SWSS_LOG_ENTER();
 
-    if (gHFTOrch)
-    {
-        std::string unified_counter_name = unify_counter_name(counter_name);
-        Message msg{
-            .m_table_name = m_table_name.c_str(),
-            .m_operation = OPERATION::SET,
-            .m_set{
-                .m_counter_name = unified_counter_name.c_str(),
-                .m_oid = oid,
-            },
-        };
-        gHFTOrch->locallyNotify(msg);
-    }
-
+    notify(counter_name, oid);
     m_counters_table.hset("", counter_name, sai_serialize_object_id(oid));
 }
 
@@ -40,6 +27,10 @@ void CounterNameMapUpdater::setCounterNameMap(const std::vector<swss::FieldValue
 {
     SWSS_LOG_ENTER();
 
+    // The whole map goes to the counters DB in a single HSET
+    std::vector<swss::FieldValueTuple> values;
+    values.reserve(counter_name_maps.size());
+
     for (const auto& map : counter_name_maps)
     {
         const std::string& counter_name = fvField(map);
@@ -48,7 +39,13 @@ void CounterNameMapUpdater::setCounterNameMap(const std::vector<swss::FieldValue
         {
             sai_deserialize_object_id(fvValue(map), oid);
         }
-        setCounterNameMap(counter_name, oid);
+        notify(counter_name, oid);
+        values.emplace_back(counter_name, sai_serialize_object_id(oid));
+    }
+
+    if (!values.empty())
+    {
+        m_counters_table.set("", values);
     }
 }
 
@@ -72,6 +69,25 @@ void CounterNameMapUpdater::delCounterNameMap(const std::string &counter_name)
     m_counters_table.hdel("", counter_name);
 }
 
+void CounterNameMapUpdater::notify(const std::string &counter_name, sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    if (gHFTOrch)
+    {
+        std::string unified_counter_name = unify_counter_name(counter_name);
+        Message msg{
+            .m_table_name = m_table_name.c_str(),
+            .m_operation = OPERATION::SET,
+            .m_set{
+                .m_counter_name = unified_counter_name.c_str(),
+                .m_oid = oid,
+            },
+        };
+        gHFTOrch->locallyNotify(msg);
+    }
+}
+
 std::string CounterNameMapUpdater::unify_counter_name(const std::string &counter_name)
 {
     SWSS_LOG_ENTER();
@@ -53,5 +53,6 @@ private:
     swss::DBConnector m_connector;
     swss::Table m_counters_table;
 
+    void notify(const std::string &counter_name, sai_object_id_t oid);
     std::string unify_counter_name(const std::string &counter_name);
 };
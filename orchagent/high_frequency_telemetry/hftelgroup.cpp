@@ -14,11 +14,37 @@ void HFTelGroup::updateObjects(const set<string> &object_names)
 {
     SWSS_LOG_ENTER();
 
-    m_objects.clear();
-    sai_uint16_t lable = 1;
-    for (auto &name : object_names)
+    // Objects that stay in the group keep their label, so the records of
+    // the running stream still map to the same object after the update
+    set<sai_uint16_t> used_labels;
+    for (auto itr = m_objects.begin(); itr != m_objects.end();)
     {
-        m_objects[name] = lable++;
+        if (object_names.find(itr->first) == object_names.end())
+        {
+            itr = m_objects.erase(itr);
+        }
+        else
+        {
+            used_labels.insert(itr->second);
+            ++itr;
+        }
+    }
+
+    // New objects take the lowest free labels
+    sai_uint16_t label = 1;
+    auto used = used_labels.begin();
+    for (const auto &name : object_names)
+    {
+        if (m_objects.find(name) != m_objects.end())
+        {
+            continue;
+        }
+        while (used != used_labels.end() && *used == label)
+        {
+            ++used;
+            ++label;
+        }
+        m_objects[name] = label++;
     }
 }
 
@@ -387,14 +387,8 @@ task_process_status HFTelOrch::groupTableSet(const std::string &profile_name, co
         profile->setStatsIDs(group_name, object_counters);
     }
 
-    if (profile->getStreamState(type) != SAI_TAM_TEL_TYPE_STATE_STOP_STREAM)
-    {
-        SWSS_LOG_WARN("The high frequency telemetry group %s:%s is not in the stop stream state, it means no new configuration needs to be applied",
-                    profile_name.c_str(),
-                    group_name.c_str());
-        return task_process_status::task_success;
-    }
-
+    // A running stream keeps its templates until the ones of the updated
+    // subscriptions are generated
     profile->tryCommitConfig(type);
 
     m_type_profile_mapping[type].insert(profile);
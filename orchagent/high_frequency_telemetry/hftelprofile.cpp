@@ -6,6 +6,9 @@
 #include <swss/redisutility.h>
 #include <sai_serialize.h>
 
+#include <algorithm>
+#include <iterator>
+
 #include <boost/tokenizer.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -123,8 +126,12 @@ void HFTelProfile::setStreamState(sai_object_type_t type, sai_tam_tel_type_state
             }
             else if (state == SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG)
             {
-                // TODO: Implement the transition from started to config generating in Phase2
-                SWSS_LOG_THROW("Transfer from start to create config hasn't been implemented yet");
+                if (!isMonitoringObjectReady(type))
+                {
+                    return;
+                }
+                // The stream keeps running with the current templates,
+                // they are swapped once the new ones are ready
             }
             else
             {
@@ -292,16 +299,23 @@ void HFTelProfile::setObjectNames(const string &group_name, set<string> &&object
         {
             return;
         }
+        // Only the subscriptions of the removed objects are withdrawn,
+        // the kept objects stay subscribed with the same label
+        vector<string> removed_names;
         for (const auto &obj : itr->second.getObjects())
         {
-            delObjectSAIID(sai_object_type, obj.first.c_str());
+            if (object_names.find(obj.first) == object_names.end())
+            {
+                removed_names.push_back(obj.first);
+            }
+        }
+        for (const auto &name : removed_names)
+        {
+            delObjectSAIID(sai_object_type, name.c_str());
         }
         itr->second.updateObjects(object_names);
     }
     loadCounterNameCache(sai_object_type);
-
-    // TODO: In the phase 2, we don't need to stop the stream before update the object names
-    setStreamState(sai_object_type, SAI_TAM_TEL_TYPE_STATE_STOP_STREAM);
 }
 
 void HFTelProfile::setStatsIDs(const string &group_name, const set<string> &object_counters)
@@ -324,12 +338,16 @@ void HFTelProfile::setStatsIDs(const string &group_name, const set<string> &obje
         {
             return;
         }
+        set<sai_stat_id_t> removed_stats;
+        set_difference(
+            itr->second.getStatsIDs().begin(), itr->second.getStatsIDs().end(),
+            stats_ids_set.begin(), stats_ids_set.end(),
+            inserter(removed_stats, removed_stats.begin()));
         itr->second.updateStatsIDs(stats_ids_set);
+        removeCounterSubscriptions(sai_object_type, removed_stats);
     }
 
-    // TODO: In the phase 2, we don't need to stop the stream before update the stats
-    setStreamState(sai_object_type, SAI_TAM_TEL_TYPE_STATE_STOP_STREAM);
-
+    // Subscriptions of the kept stats already exist, only the new ones are created
     deployCounterSubscriptions(sai_object_type);
 }
 
@@ -350,14 +368,13 @@ void HFTelProfile::setObjectSAIID(sai_object_type_t object_type, const char *obj
         {
             return;
         }
+        // The object was recreated, drop the subscriptions of the stale ID
+        removeCounterSubscriptions(object_type, itr->second);
     }
     objs[object_name] = object_id;
 
     SWSS_LOG_DEBUG("Set object %s with ID %s in the name sai map", object_name, sai_serialize_object_id(object_id).c_str());
 
-    // TODO: In the phase 2, we don't need to stop the stream before update the object
-    setStreamState(object_type, SAI_TAM_TEL_TYPE_STATE_STOP_STREAM);
-
     // Update the counter subscription
     deployCounterSubscriptions(object_type, object_id, m_groups.at(object_type).getObjects().at(object_name));
 }
@@ -378,19 +395,8 @@ void HFTelProfile::delObjectSAIID(sai_object_type_t object_type, const char *obj
         return;
     }
 
-    // TODO: In the phase 2, we don't need to stop the stream before removing the object
-    setStreamState(object_type, SAI_TAM_TEL_TYPE_STATE_STOP_STREAM);
-
     // Remove all counters bounded to the object
-    auto counter_itr = m_sai_tam_counter_subscription_objs.find(object_type);
-    if (counter_itr != m_sai_tam_counter_subscription_objs.end())
-    {
-        counter_itr->second.erase(itr->second);
-        if (counter_itr->second.empty())
-        {
-            m_sai_tam_counter_subscription_objs.erase(counter_itr);
-        }
-    }
+    removeCounterSubscriptions(object_type, itr->second);
 
     objs.erase(itr);
     if (objs.empty())
@@ -451,6 +457,7 @@ void HFTelProfile::clearGroup(const std::string &group_name)
         m_groups.erase(itr);
     }
     m_sai_tam_tel_type_templates.erase(sai_object_type);
+    m_pending_config_types.erase(sai_object_type);
     m_sai_tam_tel_type_states.erase(m_sai_tam_tel_type_objs[sai_object_type]);
     m_sai_tam_tel_type_objs.erase(sai_object_type);
     m_sai_tam_report_objs.erase(sai_object_type);
@@ -584,7 +591,17 @@ bool HFTelProfile::tryCommitConfig(sai_object_type_t object_type)
             return false;
         }
     }
+    if (getStreamState(object_type) == SAI_TAM_TEL_TYPE_STATE_START_STREAM
+        && m_pending_config_types.find(object_type) == m_pending_config_types.end())
+    {
+        // The running templates already cover all the subscriptions
+        return true;
+    }
     setStreamState(object_type, SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG);
+    if (getStreamState(object_type) == SAI_TAM_TEL_TYPE_STATE_CREATE_CONFIG)
+    {
+        m_pending_config_types.erase(object_type);
+    }
     return true;
 }
 
@@ -836,113 +853,209 @@ void HFTelProfile::initTelemetry()
             }));
 }
 
-void HFTelProfile::deployCounterSubscription(sai_object_type_t object_type, sai_object_id_t sai_obj, sai_stat_id_t stat_id, uint16_t label)
+bool HFTelProfile::isCounterSubscribed(sai_object_type_t object_type, sai_object_id_t sai_obj, sai_stat_id_t stat_id) const
 {
     SWSS_LOG_ENTER();
 
-    vector<sai_attribute_t> attrs;
-    sai_attribute_t attr;
+    auto type_itr = m_sai_tam_counter_subscription_objs.find(object_type);
+    if (type_itr == m_sai_tam_counter_subscription_objs.end())
+    {
+        return false;
+    }
+    auto obj_itr = type_itr->second.find(sai_obj);
+    if (obj_itr == type_itr->second.end())
+    {
+        return false;
+    }
+
+    return obj_itr->second.find(stat_id) != obj_itr->second.end();
+}
+
+void HFTelProfile::deployCounterSubscriptions(sai_object_type_t object_type, const vector<CounterSubscription> &subscriptions)
+{
+    SWSS_LOG_ENTER();
 
-    auto itr = m_sai_tam_counter_subscription_objs[object_type].find(sai_obj);
-    if (itr != m_sai_tam_counter_subscription_objs[object_type].end())
+    if (subscriptions.empty())
     {
-        auto itr2 = itr->second.find(stat_id);
-        if (itr2 != itr->second.end())
-        {
-            return;
-        }
+        return;
     }
 
-    attr.id = SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_TEL_TYPE;
-    attr.value.oid = getTAMTelTypeObjID(object_type);
-    attrs.push_back(attr);
+    // The TAM API has no bulk entry point for the counter subscriptions,
+    // they are created back to back and the batch invalidates the
+    // templates once, whatever its size
+    sai_object_id_t tel_type_obj = getTAMTelTypeObjID(object_type);
+    auto &subscription_objs = m_sai_tam_counter_subscription_objs[object_type];
 
-    attr.id = SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_OBJECT_ID;
-    attr.value.oid = sai_obj;
-    attrs.push_back(attr);
+    for (const auto &subscription : subscriptions)
+    {
+        vector<sai_attribute_t> attrs;
+        sai_attribute_t attr;
 
-    attr.id = SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_STAT_ID;
-    attr.value.oid = stat_id;
-    attrs.push_back(attr);
+        attr.id = SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_TEL_TYPE;
+        attr.value.oid = tel_type_obj;
+        attrs.push_back(attr);
 
-    attr.id = SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_LABEL;
-    attr.value.u64 = static_cast<uint64_t>(label);
-    attrs.push_back(attr);
+        attr.id = SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_OBJECT_ID;
+        attr.value.oid = subscription.sai_obj;
+        attrs.push_back(attr);
 
-    attr.id = SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_STATS_MODE;
-    attr.value.s32 = HFTelUtils::get_stats_mode(object_type, stat_id);
-    attrs.push_back(attr);
+        attr.id = SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_STAT_ID;
+        attr.value.oid = subscription.stat_id;
+        attrs.push_back(attr);
 
-    sai_object_id_t counter_id;
+        attr.id = SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_LABEL;
+        attr.value.u64 = static_cast<uint64_t>(subscription.label);
+        attrs.push_back(attr);
 
-    handleSaiCreateStatus(
-        SAI_API_TAM,
-        sai_tam_api->create_tam_counter_subscription(
-            &counter_id,
-            gSwitchId,
-            static_cast<uint32_t>(attrs.size()),
-            attrs.data()));
+        attr.id = SAI_TAM_COUNTER_SUBSCRIPTION_ATTR_STATS_MODE;
+        attr.value.s32 = HFTelUtils::get_stats_mode(object_type, subscription.stat_id);
+        attrs.push_back(attr);
 
-    m_sai_tam_counter_subscription_objs[object_type][sai_obj][stat_id] = move(
-        sai_guard_t(
-            new sai_object_id_t(counter_id),
-            [](sai_object_id_t *p)
-            {
-                handleSaiRemoveStatus(
-                    SAI_API_TAM,
-                    sai_tam_api->remove_tam_counter_subscription(*p));
-                delete p;
-            }));
+        sai_object_id_t counter_id;
+
+        handleSaiCreateStatus(
+            SAI_API_TAM,
+            sai_tam_api->create_tam_counter_subscription(
+                &counter_id,
+                gSwitchId,
+                static_cast<uint32_t>(attrs.size()),
+                attrs.data()));
+
+        subscription_objs[subscription.sai_obj][subscription.stat_id] = move(
+            sai_guard_t(
+                new sai_object_id_t(counter_id),
+                [](sai_object_id_t *p)
+                {
+                    handleSaiRemoveStatus(
+                        SAI_API_TAM,
+                        sai_tam_api->remove_tam_counter_subscription(*p));
+                    delete p;
+                }));
+    }
+
+    m_pending_config_types.insert(object_type);
+
+    SWSS_LOG_INFO("Deployed %zu counter subscriptions for object type %s",
+                  subscriptions.size(),
+                  sai_serialize_object_type(object_type).c_str());
 }
 
 void HFTelProfile::deployCounterSubscriptions(sai_object_type_t object_type, sai_object_id_t sai_obj, std::uint16_t label)
 {
     SWSS_LOG_ENTER();
 
-    // TODO: Bulk create the counter subscriptions
     auto group = m_groups.find(object_type);
     if (group == m_groups.end())
     {
         return;
     }
 
+    vector<CounterSubscription> subscriptions;
     for (const auto &stat_id : group->second.getStatsIDs())
     {
-        deployCounterSubscription(object_type, sai_obj, stat_id, label);
+        if (!isCounterSubscribed(object_type, sai_obj, stat_id))
+        {
+            subscriptions.push_back({sai_obj, stat_id, label});
+        }
     }
+    deployCounterSubscriptions(object_type, subscriptions);
 }
 
 void HFTelProfile::deployCounterSubscriptions(sai_object_type_t object_type)
 {
     SWSS_LOG_ENTER();
 
-    // TODO: Bulk create the counter subscriptions
-
     auto group = m_groups.find(object_type);
     if (group == m_groups.end())
     {
         return;
     }
+    auto name_itr = m_name_sai_map.find(object_type);
+    if (name_itr == m_name_sai_map.end())
+    {
+        return;
+    }
+
+    // Only the (object, stat) pairs missing a subscription are created
+    vector<CounterSubscription> subscriptions;
     for (const auto &obj : group->second.getObjects())
     {
-        auto itr = m_name_sai_map[object_type].find(obj.first);
-        if (itr == m_name_sai_map[object_type].end())
+        auto itr = name_itr->second.find(obj.first);
+        if (itr == name_itr->second.end())
         {
             continue;
         }
         for (const auto &stat_id : group->second.getStatsIDs())
         {
-            deployCounterSubscription(object_type, itr->second, stat_id, obj.second);
+            if (!isCounterSubscribed(object_type, itr->second, stat_id))
+            {
+                subscriptions.push_back({itr->second, stat_id, obj.second});
+            }
+        }
+    }
+    deployCounterSubscriptions(object_type, subscriptions);
+}
+
+void HFTelProfile::removeCounterSubscriptions(sai_object_type_t object_type, sai_object_id_t sai_obj)
+{
+    SWSS_LOG_ENTER();
+
+    auto type_itr = m_sai_tam_counter_subscription_objs.find(object_type);
+    if (type_itr == m_sai_tam_counter_subscription_objs.end())
+    {
+        return;
+    }
+    // Releasing the guards removes the subscriptions
+    if (type_itr->second.erase(sai_obj) == 0)
+    {
+        return;
+    }
+    if (type_itr->second.empty())
+    {
+        m_sai_tam_counter_subscription_objs.erase(type_itr);
+    }
+
+    m_pending_config_types.insert(object_type);
+}
+
+void HFTelProfile::removeCounterSubscriptions(sai_object_type_t object_type, const set<sai_stat_id_t> &stats_ids)
+{
+    SWSS_LOG_ENTER();
+
+    auto type_itr = m_sai_tam_counter_subscription_objs.find(object_type);
+    if (type_itr == m_sai_tam_counter_subscription_objs.end() || stats_ids.empty())
+    {
+        return;
+    }
+
+    size_t removed = 0;
+    for (auto &obj : type_itr->second)
+    {
+        for (const auto &stat_id : stats_ids)
+        {
+            removed += obj.second.erase(stat_id);
         }
     }
+    if (removed == 0)
+    {
+        return;
+    }
+
+    m_pending_config_types.insert(object_type);
+
+    SWSS_LOG_INFO("Removed %zu counter subscriptions for object type %s",
+                  removed,
+                  sai_serialize_object_type(object_type).c_str());
 }
 
 void HFTelProfile::undeployCounterSubscriptions(sai_object_type_t object_type)
 {
     SWSS_LOG_ENTER();
 
-    // TODO: Bulk remove the counter subscriptions
-    m_sai_tam_counter_subscription_objs.erase(object_type);
+    if (m_sai_tam_counter_subscription_objs.erase(object_type) != 0)
+    {
+        m_pending_config_types.insert(object_type);
+    }
 }
 
 void HFTelProfile::updateTemplates(sai_object_id_t tam_tel_type_obj)
@@ -95,6 +95,15 @@ private:
     std::unordered_map<sai_object_type_t, sai_guard_t> m_sai_tam_tel_type_objs;
     std::unordered_map<sai_object_type_t, sai_guard_t> m_sai_tam_report_objs;
     std::unordered_map<sai_object_type_t, std::vector<std::uint8_t>> m_sai_tam_tel_type_templates;
+    // Object types whose subscriptions changed since their templates were generated
+    std::set<sai_object_type_t> m_pending_config_types;
+
+    struct CounterSubscription
+    {
+        sai_object_id_t sai_obj;
+        sai_stat_id_t stat_id;
+        std::uint16_t label;
+    };
 
     bool isObjectTypeInProfile(sai_object_type_t object_type, const std::string &object_name) const;
     bool isMonitoringObjectReady(sai_object_type_t object_type) const;
@@ -103,9 +112,12 @@ private:
     sai_object_id_t getTAMReportObjID(sai_object_type_t object_type);
     sai_object_id_t getTAMTelTypeObjID(sai_object_type_t object_type);
     void initTelemetry();
-    void deployCounterSubscription(sai_object_type_t object_type, sai_object_id_t sai_obj, sai_stat_id_t stat_id, std::uint16_t label);
+    bool isCounterSubscribed(sai_object_type_t object_type, sai_object_id_t sai_obj, sai_stat_id_t stat_id) const;
+    void deployCounterSubscriptions(sai_object_type_t object_type, const std::vector<CounterSubscription> &subscriptions);
     void deployCounterSubscriptions(sai_object_type_t object_type, sai_object_id_t sai_obj, std::uint16_t label);
     void deployCounterSubscriptions(sai_object_type_t object_type);
+    void removeCounterSubscriptions(sai_object_type_t object_type, sai_object_id_t sai_obj);
+    void removeCounterSubscriptions(sai_object_type_t object_type, const std::set<sai_stat_id_t> &stats_ids);
     void undeployCounterSubscriptions(sai_object_type_t object_type);
     void updateTemplates(sai_object_id_t tam_tel_type_obj);
 };
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "ipaddress.h"
+#include "ipprefix.h"
+
+/*
+ * Host addresses of one VRF indexed by their bits, one binary trie per
+ * address family.
+ *
+ * Finding the hosts a prefix covers walks the prefix bits down to the
+ * subtree of the prefix and visits that subtree only, so the cost follows
+ * the prefix length and the number of covered hosts instead of the total
+ * number of hosts.
+ */
+template <typename T>
+class HostTrie
+{
+public:
+    HostTrie() = default;
+
+    HostTrie(const HostTrie&) = delete;
+    HostTrie& operator=(const HostTrie&) = delete;
+
+    bool empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
+
+    /* Returns false if the host is already present, its value is left as is */
+    bool insert(const swss::IpAddress &host, const T &value)
+    {
+        auto node = &root(host.isV4());
+        for (unsigned bit = 0; bit < width(host.isV4()); bit++)
+        {
+            auto &child = (*node)->child[bitAt(host, bit)];
+            if (!child)
+            {
+                child.reset(new Node());
+            }
+            node = &child;
+        }
+
+        if ((*node)->present)
+        {
+            return false;
+        }
+
+        (*node)->present = true;
+        (*node)->value = value;
+        m_size++;
+        return true;
+    }
+
+    /* Returns false if the host is not present */
+    bool erase(const swss::IpAddress &host)
+    {
+        if (!eraseFrom(root(host.isV4()), host, 0))
+        {
+            return false;
+        }
+
+        m_size--;
+        return true;
+    }
+
+    /* Calls f(host, value) for each host inside prefix */
+    template <typename F>
+    void forEachCovered(const swss::IpPrefix &prefix, F f) const
+    {
+        bool v4 = prefix.isV4();
+        auto ip = prefix.getIp();
+        const Node *node = (v4 ? m_v4 : m_v6).get();
+
+        unsigned len = static_cast<unsigned>(prefix.getMaskLength());
+        for (unsigned bit = 0; node && bit < len && bit < width(v4); bit++)
+        {
+            node = node->child[bitAt(ip, bit)].get();
+        }
+
+        if (node)
+        {
+            // Host bits below the prefix are rebuilt on the way down
+            ip_addr_t addr = ip.getIp();
+            visit(node, addr, len, width(v4), f);
+        }
+    }
+
+private:
+    struct Node
+    {
+        std::unique_ptr<Node> child[2];
+        bool present = false;
+        T value{};
+    };
+
+    static unsigned width(bool v4) { return v4 ? 32 : 128; }
+
+    static const uint8_t *bytes(const ip_addr_t &addr)
+    {
+        return addr.family == AF_INET ? reinterpret_cast<const uint8_t *>(&addr.ip_addr.ipv4_addr)
+                                      : addr.ip_addr.ipv6_addr;
+    }
+
+    static uint8_t *bytes(ip_addr_t &addr)
+    {
+        return addr.family == AF_INET ? reinterpret_cast<uint8_t *>(&addr.ip_addr.ipv4_addr)
+                                      : addr.ip_addr.ipv6_addr;
+    }
+
+    static unsigned bitAt(const swss::IpAddress &ip, unsigned bit)
+    {
+        ip_addr_t addr = ip.getIp();
+        return (bytes(addr)[bit / 8] >> (7 - bit % 8)) & 1u;
+    }
+
+    static void setBit(ip_addr_t &addr, unsigned bit, unsigned value)
+    {
+        uint8_t mask = static_cast<uint8_t>(1u << (7 - bit % 8));
+        uint8_t &byte = bytes(addr)[bit / 8];
+        byte = static_cast<uint8_t>(value ? (byte | mask) : (byte & ~mask));
+    }
+
+    std::unique_ptr<Node> &root(bool v4)
+    {
+        auto &node = v4 ? m_v4 : m_v6;
+        if (!node)
+        {
+            node.reset(new Node());
+        }
+        return node;
+    }
+
+    bool eraseFrom(std::unique_ptr<Node> &node, const swss::IpAddress &host, unsigned bit)
+    {
+        if (!node)
+        {
+            return false;
+        }
+
+        if (bit == width(host.isV4()))
+        {
+            if (!node->present)
+            {
+                return false;
+            }
+            node->present = false;
+            node->value = T{};
+        }
+        else if (!eraseFrom(node->child[bitAt(host, bit)], host, bit + 1))
+        {
+            return false;
+        }
+
+        // Prune the branch once nothing is left below it
+        if (!node->present && !node->child[0] && !node->child[1])
+        {
+            node.reset();
+        }
+        return true;
+    }
+
+    template <typename F>
+    static void visit(const Node *node, ip_addr_t &addr, unsigned bit, unsigned width, F &f)
+    {
+        if (bit == width)
+        {
+            if (node->present)
+            {
+                f(swss::IpAddress(addr), node->value);
+            }
+            return;
+        }
+
+        for (unsigned b = 0; b < 2; b++)
+        {
+            if (node->child[b])
+            {
+                setBit(addr, bit, b);
+                visit(node->child[b].get(), addr, bit + 1, width, f);
+            }
+        }
+    }
+
+    std::unique_ptr<Node> m_v4;
+    std::unique_ptr<Node> m_v6;
+    size_t m_size = 0;
+};
@@ -13,6 +13,7 @@
 #include "notifications.h"
 #include "icmporch.h"
 #include "switchorch.h"
+#include <deque>
 #include <string>
 
 using namespace std;
@@ -36,7 +37,8 @@ const std::map<std::string, sai_icmp_echo_session_state_t> IcmpOrch::m_session_s
 
 IcmpOrch::IcmpOrch(DBConnector *db, string tableName, TableConnector stateDbIcmpSessionTable):
     Orch(db, tableName),
-    m_stateIcmpSessionTable(stateDbIcmpSessionTable.first, stateDbIcmpSessionTable.second),
+    m_icmp_sessions(sai_icmp_echo_api, IcmpSaiSessionHandler::m_name, stateDbIcmpSessionTable.first, stateDbIcmpSessionTable.second,
+                    IcmpSaiSessionHandler::m_state_fname, m_session_state_lkup, SAI_ICMP_ECHO_SESSION_STATE_DOWN),
     m_register_state_change_notif{false}
 {
     SWSS_LOG_ENTER();
@@ -55,13 +57,15 @@ IcmpOrch::IcmpOrch(DBConnector *db, string tableName, TableConnector stateDbIcmp
 
     // Clean up state database ICMP entries
     vector<string> keys;
+    auto& stateIcmpSessionTable = m_icmp_sessions.get_state_table();
 
-    m_stateIcmpSessionTable.getKeys(keys);
+    stateIcmpSessionTable.getKeys(keys);
 
     for (auto alias : keys)
     {
-        m_stateIcmpSessionTable.del(alias);
+        stateIcmpSessionTable.del(alias);
     }
+    m_icmp_sessions.flush_state_db();
 
     auto icmpStateNotifier = new Notifier(m_icmpStateNotificationConsumer, this, "ICMP_STATE_NOTIFICATIONS");
     Orch::addExecutor(icmpStateNotifier);
@@ -77,6 +81,35 @@ void IcmpOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    /*
+     * Sessions of the round are created and removed in bulk. Pending removals
+     * are flushed before a SET is handled and pending creations before a DEL,
+     * so a DEL and SET of one key still apply in order.
+     */
+    vector<pair<string, SyncMap::iterator>> creates;
+    vector<pair<string, SyncMap::iterator>> removes;
+
+    auto flush = [&](vector<pair<string, SyncMap::iterator>>& entries, bool create) {
+        vector<sai_status_t> statuses;
+        if (create)
+        {
+            m_icmp_sessions.flush_creates(statuses);
+        }
+        else
+        {
+            m_icmp_sessions.flush_removes(statuses);
+        }
+
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (handle_icmp_session_status(entries[i].first, statuses[i], create))
+            {
+                consumer.m_toSync.erase(entries[i].second);
+            }
+        }
+        entries.clear();
+    };
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -88,7 +121,12 @@ void IcmpOrch::doTask(Consumer &consumer)
 
         if (op == SET_COMMAND)
         {
-            if (m_icmp_session_map.find(key) != m_icmp_session_map.end())
+            if (!removes.empty())
+            {
+                flush(removes, false);
+            }
+
+            if (m_icmp_sessions.exists(key))
             {
                 if (!update_icmp_session(key, data))
                 {
@@ -96,7 +134,13 @@ void IcmpOrch::doTask(Consumer &consumer)
                     continue;
                 }
             } else {
-                if (!create_icmp_session(key, data))
+                auto status = queue_icmp_session(key, data);
+                if (status == task_success)
+                {
+                    creates.emplace_back(key, it++);
+                    continue;
+                }
+                if (status == task_need_retry)
                 {
                     it++;
                     continue;
@@ -105,11 +149,19 @@ void IcmpOrch::doTask(Consumer &consumer)
         }
         else if (op == DEL_COMMAND)
         {
-            if (!remove_icmp_session(key))
+            if (!creates.empty())
             {
-                it++;
+                flush(creates, true);
+            }
+
+            if (m_icmp_sessions.exists(key))
+            {
+                m_icmp_sessions.queue_remove(key);
+                removes.emplace_back(key, it++);
                 continue;
             }
+
+            SWSS_LOG_WARN("Request to remove non-existing ICMP session for %s", key.c_str());
         }
         else
         {
@@ -118,29 +170,45 @@ void IcmpOrch::doTask(Consumer &consumer)
 
         it = consumer.m_toSync.erase(it);
     }
+
+    if (!creates.empty())
+    {
+        flush(creates, true);
+    }
+    if (!removes.empty())
+    {
+        flush(removes, false);
+    }
+
+    m_icmp_sessions.flush_state_db();
 }
 
 void IcmpOrch::doTask(NotificationConsumer &consumer)
 {
     SWSS_LOG_ENTER();
 
-    std::string op;
-    std::string data;
-    std::vector<swss::FieldValueTuple> values;
-
-    consumer.pop(op, data, values);
+    std::deque<KeyOpFieldsValuesTuple> entries;
+    consumer.pops(entries);
 
     if (&consumer != m_icmpStateNotificationConsumer)
     {
         return;
     }
 
-    if (op == "icmp_echo_session_state_change")
+    // the notifications queued since the last round are coalesced per session
+    vector<SaiOffloadSessionTable<sai_icmp_echo_api_t>::state_update_t> updates;
+
+    for (auto& entry : entries)
     {
+        if (kfvOp(entry) != "icmp_echo_session_state_change")
+        {
+            continue;
+        }
+
         uint32_t count = 0;
         sai_icmp_echo_session_state_notification_t *icmpSessionState = nullptr;
 
-        sai_deserialize_icmp_echo_session_state_ntf(data, count, &icmpSessionState);
+        sai_deserialize_icmp_echo_session_state_ntf(kfvKey(entry), count, &icmpSessionState);
 
         for (uint32_t i = 0; i < count; i++)
         {
@@ -149,44 +217,24 @@ void IcmpOrch::doTask(NotificationConsumer &consumer)
 
             SWSS_LOG_INFO("Got ICMP session state change notification id:%" PRIx64 " state: %s", id, m_session_state_lkup.at(state).c_str());
 
-            if (m_icmp_session_lookup.find(id) == m_icmp_session_lookup.end())
-            {
-                SWSS_LOG_NOTICE("ICMP session missing for state change notification id:%" PRIx64 " state: %s", id, m_session_state_lkup.at(state).c_str());
-                continue;
-            }
-
-            // handle state update
-            if (state != m_icmp_session_lookup[id].state || m_icmp_session_lookup[id].init_state)
-            {
-                auto key = m_icmp_session_lookup[id].db_key;
-                vector<FieldValueTuple> fvVector;
-                m_stateIcmpSessionTable.get(key, fvVector);
-
-                fvVector.push_back({IcmpSaiSessionHandler::m_state_fname, m_session_state_lkup.at(state)});
-
-                m_stateIcmpSessionTable.set(key, fvVector);
-
-                SWSS_LOG_NOTICE("ICMP session state for %s changed from %s to %s", key.c_str(),
-                            m_session_state_lkup.at(m_icmp_session_lookup[id].state).c_str(), m_session_state_lkup.at(state).c_str());
-
-                m_icmp_session_lookup[id].state = state;
-                m_icmp_session_lookup[id].init_state = false;
-            }
+            updates.emplace_back(id, state);
         }
 
         sai_deserialize_free_icmp_echo_session_state_ntf(count, icmpSessionState);
     }
+
+    m_icmp_sessions.update_states(updates);
+    m_icmp_sessions.flush_state_db();
 }
 
-bool IcmpOrch::create_icmp_session(const string& key, const vector<FieldValueTuple>& data)
+task_process_status IcmpOrch::queue_icmp_session(const string& key, const vector<FieldValueTuple>& data)
 {
     IcmpSaiSessionHandler sai_session_handler(*this);
 
-    if (m_num_sessions == m_max_sessions)
+    if (m_icmp_sessions.size() + m_icmp_sessions.pending_creates() >= m_max_sessions)
     {
-        SWSS_LOG_ERROR("ICMP session creation failed, limit (%u) reached", m_num_sessions);
-        // return false to retry
-        return false;
+        SWSS_LOG_ERROR("ICMP session creation failed, limit (%u) reached", m_max_sessions);
+        return task_need_retry;
     }
 
     // initialize the sai session handler
@@ -195,42 +243,52 @@ bool IcmpOrch::create_icmp_session(const string& key, const vector<FieldValueTup
     {
         SWSS_LOG_INFO("ICMP session creation failed key(%s), init_status(%s)", key.c_str(),
                 SaiOffloadStatusStrMap.at(init_status).c_str());
-        return true;
+        return task_failed;
     }
 
     if (!m_register_state_change_notif)
     {
         if (!sai_session_handler.register_state_change_notification())
         {
-            // return false to retry registration
-            return false;
+            // retry registration
+            return task_need_retry;
         }
         m_register_state_change_notif = true;
     }
 
-    auto create_status = sai_session_handler.create(data);
-    if (create_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
+    auto prepare_status = sai_session_handler.prepare(data);
+    if (prepare_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
     {
         SWSS_LOG_INFO("ICMP session creation failed key(%s), create_status(%s)", key.c_str(),
-                SaiOffloadStatusStrMap.at(create_status).c_str());
+                SaiOffloadStatusStrMap.at(prepare_status).c_str());
         // do not consume the entry for retries
-        bool skip_entry = create_status != SaiOffloadHandlerStatus::RETRY_VALID_ENTRY;
-        return skip_entry;
+        return prepare_status == SaiOffloadHandlerStatus::RETRY_VALID_ENTRY ? task_need_retry : task_failed;
     }
 
-    // update the STATE DB and local session maps
-    auto& fvVector = sai_session_handler.get_fv_vector();
-    auto& state_db_key = sai_session_handler.get_state_db_key();
+    m_icmp_sessions.queue_create(key, sai_session_handler.get_state_db_key(), sai_session_handler.get_attrs(),
+                                 sai_session_handler.get_fv_vector(), sai_session_handler.get_fv_map());
 
-    m_stateIcmpSessionTable.set(state_db_key, fvVector);
-    auto session_id = sai_session_handler.get_session_id();
-    IcmpSessionDataCache session_cache{session_id, sai_session_handler.get_fv_map()};
-    m_icmp_session_map[key] = session_cache;
-    m_icmp_session_lookup[session_id] = {state_db_key, SAI_ICMP_ECHO_SESSION_STATE_DOWN, true};
+    return task_success;
+}
 
-    m_num_sessions++;
+bool IcmpOrch::handle_icmp_session_status(const string& key, sai_status_t status, bool create)
+{
+    if (status == SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_NOTICE("%s ICMP offload session key(%s)", create ? "Created" : "Removed", key.c_str());
+        return true;
+    }
+
+    SWSS_LOG_INFO("ICMP session %s failed key(%s), rv:%d", create ? "creation" : "removal", key.c_str(), status);
+
+    task_process_status handle_status = create ? handleSaiCreateStatus(SAI_API_ICMP_ECHO, status)
+                                               : handleSaiRemoveStatus(SAI_API_ICMP_ECHO, status);
+    if (handle_status != task_success)
+    {
+        // do not consume the entry for retries
+        return parseHandleSaiStatusFailure(handle_status);
+    }
 
-    SWSS_LOG_NOTICE("Created ICMP offload session key(%s)", key.c_str());
     return true;
 }
 
@@ -247,8 +305,8 @@ bool IcmpOrch::update_icmp_session(const string& key, const fv_vector_t& data)
         return true;
     }
 
-    auto session_id = m_icmp_session_map[key].session_id;
-    auto& fv_map = m_icmp_session_map[key].fv_map;
+    auto session_id = m_icmp_sessions.get_session_id(key);
+    auto& fv_map = m_icmp_sessions.get_fv_map(key);
     auto update_status = sai_session_handler.update(session_id, data, fv_map);
     if (update_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
     {
@@ -263,57 +321,14 @@ bool IcmpOrch::update_icmp_session(const string& key, const fv_vector_t& data)
     auto& fvVector = sai_session_handler.get_fv_vector();
     if (fvVector.size()) {
         auto& state_db_key = sai_session_handler.get_state_db_key();
-        auto& fv_map_upd = sai_session_handler.get_fv_map();
-        m_stateIcmpSessionTable.set(state_db_key, fvVector);
-        IcmpSessionDataCache session_cache{session_id, fv_map_upd};
-        m_icmp_session_map[key] = session_cache;
+        m_icmp_sessions.get_state_table().set(state_db_key, fvVector);
+        m_icmp_sessions.set_fv_map(key, sai_session_handler.get_fv_map());
 
         SWSS_LOG_NOTICE("Updated ICMP offload session key(%s)", key.c_str());
     }
     return true;
 }
 
-bool IcmpOrch::remove_icmp_session(const string& key)
-{
-    if (m_icmp_session_map.find(key) == m_icmp_session_map.end())
-    {
-        SWSS_LOG_WARN("Request to remove non-existing ICMP session for %s", key.c_str());
-        return true;
-    }
-
-    IcmpSaiSessionHandler sai_session_handler(*this);
-
-    // initialize the sai session handler
-    auto init_status = sai_session_handler.init(sai_icmp_echo_api, key);
-    if (init_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
-    {
-        SWSS_LOG_INFO("ICMP session removal failed key(%s), init_status(%s)", key.c_str(),
-                SaiOffloadStatusStrMap.at(init_status).c_str());
-        return true;
-    }
-
-    sai_object_id_t icmp_session_id = m_icmp_session_map[key].session_id;
-    auto remove_status = sai_session_handler.remove(icmp_session_id);
-    if ( remove_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
-    {
-        // do not consume the entry for retries
-        SWSS_LOG_INFO("ICMP session removal failed key(%s), remove_status(%s)", key.c_str(),
-                SaiOffloadStatusStrMap.at(remove_status).c_str());
-        bool skip_entry = remove_status != SaiOffloadHandlerStatus::RETRY_VALID_ENTRY;
-        return skip_entry;
-    }
-
-    // delete the session from state db and remove them from local maps
-    m_stateIcmpSessionTable.del(m_icmp_session_lookup[icmp_session_id].db_key);
-
-    m_icmp_session_map.erase(key);
-    m_icmp_session_lookup.erase(icmp_session_id);
-    m_num_sessions--;
-
-    SWSS_LOG_NOTICE("Removed ICMP offload session key(%s)", key.c_str());
-    return true;
-}
-
 const std::string IcmpSaiSessionHandler::m_name = "IcmpOffload";
 
 const std::string IcmpSaiSessionHandler::m_tx_interval_fname        = "tx_interval";
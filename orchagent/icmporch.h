@@ -26,29 +26,6 @@ constexpr uint32_t time_msec_to_usec(const uint32_t val)
     return val * 1000;
 }
 
-/**
- *@struct IcmpUpdate
- *
- *@brief structure used for mapping icmp session id and state
- */
-struct IcmpUpdate
-{
-    std::string db_key;
-    sai_icmp_echo_session_state_t state;
-    bool init_state;
-};
-
-/**
- *@struct IcmpSessionDataCache
- *
- *@brief structure used for mapping icmp session key and session data
- */
-struct IcmpSessionDataCache
-{
-    sai_object_id_t session_id;
-    fv_map_t fv_map;
-};
-
 // forward declaration of icmp sai handler
 struct IcmpSaiSessionHandler;
 
@@ -109,30 +86,33 @@ public:
 
 private:
     /**
-     *@method create_icmp_session
+     *@method queue_icmp_session
      *
-     *@brief creates icmp echo sessions in hardware
+     *@brief builds an icmp echo session and queues its creation in hardware
      *
      *@param key(in)  reference to session key
      *@param data(in) vector of session parameters from APP_DB
      *                table as field value tuples
      *
-     *@return false for retries
-     *        true for all other cases where session entry is consumed
+     *@return task_success when the session is queued
+     *        task_need_retry for retries
+     *        task_failed for all other cases where session entry is consumed
      */
-    bool create_icmp_session(const string& key, const vector<FieldValueTuple>& data);
+    task_process_status queue_icmp_session(const string& key, const vector<FieldValueTuple>& data);
 
     /**
-     *@method remove_icmp_session
+     *@method handle_icmp_session_status
      *
-     *@brief removes icmp echo sessions from hardware
+     *@brief handles the SAI status of a queued session creation or removal
      *
-     *@param key(in)  reference to session key
+     *@param key(in)     reference to session key
+     *@param status(in)  SAI status of the creation or removal
+     *@param create(in)  true for a creation, false for a removal
      *
      *@return false for retries
-     *        true for all other cases
+     *        true for all other cases where session entry is consumed
      */
-    bool remove_icmp_session(const string& key);
+    bool handle_icmp_session_status(const string& key, sai_status_t status, bool create);
 
     /**
      *@method update_icmp_session
@@ -148,22 +128,14 @@ private:
      */
     bool update_icmp_session(const string& key, const vector<FieldValueTuple>& data);
 
-    // map of session key to session data cache
-    std::map<std::string, IcmpSessionDataCache> m_icmp_session_map;
-    // map of session object id to update data for handling notification from asic db 
-    std::map<sai_object_id_t, IcmpUpdate> m_icmp_session_lookup;
-
-    // Icmp session state table produced by IcmpOrch
-    swss::Table m_stateIcmpSessionTable;
+    // icmp echo sessions, created and removed in bulk, and their state db table
+    SaiOffloadSessionTable<sai_icmp_echo_api_t> m_icmp_sessions;
 
     // ASIC_DB ICMP state notification consumer
     swss::NotificationConsumer* m_icmpStateNotificationConsumer;
     // indicates notification registration is done
     bool m_register_state_change_notif;
 
-    // keeps track of number of sessions
-    uint32_t m_num_sessions = 0;
-
     // max number of sessions
     static const uint32_t m_max_sessions;
 
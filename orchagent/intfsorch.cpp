@@ -18,6 +18,7 @@
 #include "directory.h"
 #include "vnetorch.h"
 #include "subscriberstatetable.h"
+#include "counterratesorch.h"
 
 extern sai_object_id_t gVirtualRouterId;
 extern Directory<Orch*> gDirectory;
@@ -39,6 +40,7 @@ extern string gMySwitchType;
 extern int32_t gVoqMySwitchId;
 extern bool gTraditionalFlexCounter;
 extern bool isChassisDbInUse();
+extern size_t gMaxBulkSize;
 
 const int intfsorch_pri = 35;
 
@@ -58,11 +60,18 @@ static const vector<sai_router_interface_stat_t> rifStatIds =
     SAI_ROUTER_INTERFACE_STAT_OUT_ERROR_OCTETS,
 };
 
-IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBConnector *chassisAppDb) :
-        Orch(db, tableName, intfsorch_pri), m_vrfOrch(vrf_orch)
+IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBConnector *chassisAppDb, ZmqServer *zmqServer) :
+        ZmqOrch(db, vector<table_name_with_pri_t>{ { tableName, intfsorch_pri } }, zmqServer), m_vrfOrch(vrf_orch),
+        m_rifBulker(sai_router_intfs_api, gSwitchId, gMaxBulkSize),
+        m_routeBulker(sai_route_api, gMaxBulkSize),
+        m_rifBulkSupported(true),
+        m_ip2meBulkMode(false)
 {
     SWSS_LOG_ENTER();
 
+    /* IP2ME routes only need their own flush status, they don't query the bulker */
+    m_routeBulker.enable_auto_flush();
+
     /* Initialize DB connectors */
     m_counter_db = shared_ptr<DBConnector>(new DBConnector("COUNTERS_DB", 0));
     m_asic_db = shared_ptr<DBConnector>(new DBConnector("ASIC_DB", 0));
@@ -80,24 +89,10 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBCon
     auto executorT = new ExecutableTimer(m_updateMapsTimer, this, "UPDATE_MAPS_TIMER");
     Orch::addExecutor(executorT);
 
-    string rifRatePluginName = "rif_rates.lua";
-    string rifRateSha;
-
-    try
-    {
-        string rifRateLuaScript = swss::loadLuaScript(rifRatePluginName);
-        rifRateSha = swss::loadRedisScript(m_counter_db.get(), rifRateLuaScript);
-    }
-    catch (const runtime_error &e)
-    {
-        SWSS_LOG_WARN("RIF flex counter group plugins was not set successfully: %s", e.what());
-    }
-
+    /* RIF rates are computed by CounterRatesOrch, the group has no plugin */
     setFlexCounterGroupParameter(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP,
                                  RIF_FLEX_STAT_COUNTER_POLL_MSECS,
-                                 STATS_MODE_READ,
-                                 RIF_PLUGIN_FIELD,
-                                 rifRateSha);
+                                 STATS_MODE_READ);
 
     if(isChassisDbInUse())
     {
@@ -118,18 +113,20 @@ sai_object_id_t IntfsOrch::getRouterIntfsId(const string &alias)
 
 bool IntfsOrch::isPrefixSubnet(const IpPrefix &ip_prefix, const string &alias)
 {
-    if (m_syncdIntfses.find(alias) == m_syncdIntfses.end())
+    auto it_intfs = m_syncdIntfses.find(alias);
+    if (it_intfs == m_syncdIntfses.end() || !(ip_prefix.getSubnet() == ip_prefix))
     {
         return false;
     }
-    for (auto &prefixIt: m_syncdIntfses[alias].ip_addresses)
+
+    auto subnets = m_intfSubnets.find(it_intfs->second.vrf_id);
+    if (subnets == m_intfSubnets.end())
     {
-        if (prefixIt.getSubnet() == ip_prefix)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+
+    auto aliases = subnets->second.find(ip_prefix);
+    return aliases && aliases->count(alias);
 }
 
 string IntfsOrch::getRouterIntfsAlias(const IpAddress &ip, const string &vrf_name)
@@ -141,21 +138,70 @@ string IntfsOrch::getRouterIntfsAlias(const IpAddress &ip, const string &vrf_nam
         vrf_id = m_vrfOrch->getVRFid(vrf_name);
     }
 
-    for (const auto &it_intfs: m_syncdIntfses)
+    auto subnets = m_intfSubnets.find(vrf_id);
+    if (subnets == m_intfSubnets.end())
+    {
+        return string();
+    }
+
+    auto aliases = subnets->second.longestMatch(ip);
+    return aliases ? *aliases->begin() : string();
+}
+
+bool IntfsOrch::addIntfAddress(const string &alias, const IpPrefix &ip_prefix)
+{
+    auto &intfs = m_syncdIntfses[alias];
+    if (!intfs.ip_addresses.insert(ip_prefix).second)
+    {
+        return false;
+    }
+
+    auto &subnets = m_intfSubnets[intfs.vrf_id];
+    auto aliases = subnets.find(ip_prefix);
+    if (aliases)
+    {
+        aliases->insert(alias);
+    }
+    else
+    {
+        subnets.insert(ip_prefix, {alias});
+    }
+    return true;
+}
+
+bool IntfsOrch::removeIntfAddress(const string &alias, const IpPrefix &ip_prefix)
+{
+    auto &intfs = m_syncdIntfses[alias];
+    if (!intfs.ip_addresses.erase(ip_prefix))
     {
-        if (it_intfs.second.vrf_id != vrf_id)
+        return false;
+    }
+
+    auto subnets = m_intfSubnets.find(intfs.vrf_id);
+    if (subnets == m_intfSubnets.end())
+    {
+        return true;
+    }
+
+    auto aliases = subnets->second.find(ip_prefix);
+    if (aliases)
+    {
+        auto it = aliases->find(alias);
+        if (it != aliases->end())
         {
-            continue;
+            aliases->erase(it);
         }
-        for (const auto &prefixIt: it_intfs.second.ip_addresses)
+        if (aliases->empty())
         {
-            if (prefixIt.isAddressInSubnet(ip))
-            {
-                return it_intfs.first;
-            }
+            subnets->second.erase(ip_prefix);
         }
     }
-    return string();
+
+    if (subnets->second.empty())
+    {
+        m_intfSubnets.erase(subnets);
+    }
+    return true;
 }
 
 bool IntfsOrch::isInbandIntfInMgmtVrf(const string& alias)
@@ -495,13 +541,7 @@ bool IntfsOrch::setIntf(const string& alias, sai_object_id_t vrf_id, const IpPre
     {
         if (!ip_prefix && addRouterIntfs(vrf_id, port, loopbackAction))
         {
-            gPortsOrch->increasePortRefCount(alias);
-            IntfsEntry intfs_entry;
-            intfs_entry.ref_count = 0;
-            intfs_entry.proxy_arp = false;
-            intfs_entry.vrf_id = vrf_id;
-            m_syncdIntfses[alias] = intfs_entry;
-            m_vrfOrch->increaseVrfRefCount(vrf_id);
+            addSyncdIntf(alias, vrf_id);
         }
         else
         {
@@ -553,30 +593,17 @@ bool IntfsOrch::setIntf(const string& alias, sai_object_id_t vrf_id, const IpPre
      * we should wait until entry with /8 netmask will be removed.
      * Time frame between those event is quite small.*/
     /* NOTE: Overlap checking in this interface is not enough.
-     * So extend to check in all interfaces of this VRF */
-    bool overlaps = false;
-    for (const auto &intfsIt: m_syncdIntfses)
+     * So extend to check in all interfaces of this VRF.
+     * A subnet either covers the new address or lies within the new subnet */
+    auto subnets = m_intfSubnets.find(port.m_vr_id);
+    if (subnets != m_intfSubnets.end())
     {
-        if (port.m_vr_id != intfsIt.second.vrf_id)
-        {
-            continue;
-        }
-
-        for (const auto &prefixIt: intfsIt.second.ip_addresses)
-        {
-            if (prefixIt.isAddressInSubnet(ip_prefix->getIp()) ||
-                    ip_prefix->isAddressInSubnet(prefixIt.getIp()))
-            {
-                overlaps = true;
-                SWSS_LOG_NOTICE("Router interface %s IP %s overlaps with %s.", port.m_alias.c_str(),
-                        prefixIt.to_string().c_str(), ip_prefix->to_string().c_str());
-                break;
-            }
-        }
-
-        if (overlaps)
+        auto aliases = subnets->second.longestMatch(ip_prefix->getIp());
+        if (aliases || subnets->second.hasWithin(*ip_prefix))
         {
             /* Overlap of IP address network */
+            SWSS_LOG_NOTICE("Router interface %s IP %s overlaps with a subnet of %s.", port.m_alias.c_str(),
+                    ip_prefix->to_string().c_str(), aliases ? aliases->begin()->c_str() : "its VRF");
             return false;
         }
     }
@@ -597,7 +624,7 @@ bool IntfsOrch::setIntf(const string& alias, sai_object_id_t vrf_id, const IpPre
         addDirectedBroadcast(port, *ip_prefix);
     }
 
-    m_syncdIntfses[alias].ip_addresses.insert(*ip_prefix);
+    addIntfAddress(alias, *ip_prefix);
     return true;
 }
 
@@ -628,7 +655,7 @@ bool IntfsOrch::removeIntf(const string& alias, sai_object_id_t vrf_id, const Ip
             removeDirectedBroadcast(port, *ip_prefix);
         }
 
-        m_syncdIntfses[alias].ip_addresses.erase(*ip_prefix);
+        removeIntfAddress(alias, *ip_prefix);
     }
 
     if (!ip_prefix)
@@ -658,7 +685,7 @@ bool IntfsOrch::removeIntf(const string& alias, sai_object_id_t vrf_id, const Ip
     return true;
 }
 
-void IntfsOrch::doTask(Consumer &consumer)
+void IntfsOrch::doTask(ConsumerBase &consumer)
 {
     SWSS_LOG_ENTER();
 
@@ -669,6 +696,13 @@ void IntfsOrch::doTask(Consumer &consumer)
 
     string table_name = consumer.getTableName();
 
+    if (table_name == APP_INTF_TABLE_NAME)
+    {
+        bulkAddRouterIntfs(consumer);
+    }
+
+    m_ip2meBulkMode = true;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -868,9 +902,8 @@ void IntfsOrch::doTask(Consumer &consumer)
                         it++;
                         continue;
                     }
-                    if (m_syncdIntfses[alias].ip_addresses.count(ip_prefix) == 0)
+                    if (addIntfAddress(alias, ip_prefix))
                     {
-                        m_syncdIntfses[alias].ip_addresses.insert(ip_prefix);
                         addIp2MeRoute(m_syncdIntfses[alias].vrf_id, ip_prefix);
                     }
                 }
@@ -1068,9 +1101,8 @@ void IntfsOrch::doTask(Consumer &consumer)
                 {
                     if (m_syncdIntfses.find(alias) != m_syncdIntfses.end())
                     {
-                        if (m_syncdIntfses[alias].ip_addresses.count(ip_prefix))
+                        if (removeIntfAddress(alias, ip_prefix))
                         {
-                            m_syncdIntfses[alias].ip_addresses.erase(ip_prefix);
                             removeIp2MeRoute(m_syncdIntfses[alias].vrf_id, ip_prefix);
                         }
                     }
@@ -1141,6 +1173,9 @@ void IntfsOrch::doTask(Consumer &consumer)
             }
         }
     }
+
+    m_ip2meBulkMode = false;
+    flushIp2MeRoutes();
 }
 
 bool IntfsOrch::getSaiLoopbackAction(const string &actionStr, sai_packet_action_t &action)
@@ -1177,8 +1212,17 @@ bool IntfsOrch::addRouterIntfs(sai_object_id_t vrf_id, Port &port, string loopba
     }
 
     /* Create router interface if the router interface doesn't exist */
-    sai_attribute_t attr;
     vector<sai_attribute_t> attrs;
+    getRouterIntfsAttrs(vrf_id, port, loopbackActionStr, attrs);
+
+    sai_status_t status = sai_router_intfs_api->create_router_interface(&port.m_rif_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+
+    return addRouterIntfsPost(vrf_id, port, status);
+}
+
+void IntfsOrch::getRouterIntfsAttrs(sai_object_id_t vrf_id, const Port &port, const string &loopbackActionStr, vector<sai_attribute_t> &attrs)
+{
+    sai_attribute_t attr;
 
     attr.id = SAI_ROUTER_INTERFACE_ATTR_VIRTUAL_ROUTER_ID;
     attr.value.oid = vrf_id;
@@ -1292,8 +1336,10 @@ bool IntfsOrch::addRouterIntfs(sai_object_id_t vrf_id, Port &port, string loopba
         SWSS_LOG_INFO("Assigning NAT zone id %d to interface %s\n", attr.value.u32, port.m_alias.c_str());
         attrs.push_back(attr);
     }
+}
 
-    sai_status_t status = sai_router_intfs_api->create_router_interface(&port.m_rif_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+bool IntfsOrch::addRouterIntfsPost(sai_object_id_t vrf_id, Port &port, sai_status_t status)
+{
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to create router interface %s, rv:%d",
@@ -1320,6 +1366,184 @@ bool IntfsOrch::addRouterIntfs(sai_object_id_t vrf_id, Port &port, string loopba
     return true;
 }
 
+void IntfsOrch::addSyncdIntf(const string &alias, sai_object_id_t vrf_id)
+{
+    gPortsOrch->increasePortRefCount(alias);
+    IntfsEntry intfs_entry;
+    intfs_entry.ref_count = 0;
+    intfs_entry.proxy_arp = false;
+    intfs_entry.vrf_id = vrf_id;
+    m_syncdIntfses[alias] = intfs_entry;
+    m_vrfOrch->increaseVrfRefCount(vrf_id);
+}
+
+/*
+ * Create in bulk the RIFs the SET entries of the batch would create one by one
+ * through setIntf(). Only plain interface entries qualify; loopbacks, VNET and
+ * inband interfaces, interfaces being removed and keys with a pending DEL are
+ * left to doTask. The entries stay in m_toSync, doTask then finds their RIF in
+ * place and applies the rest of the entry.
+ */
+void IntfsOrch::bulkAddRouterIntfs(ConsumerBase &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_rifBulkSupported)
+    {
+        return;
+    }
+
+    std::deque<RifBulkContext> contexts;
+
+    for (auto it = consumer.m_toSync.begin(); it != consumer.m_toSync.end(); it++)
+    {
+        const KeyOpFieldsValuesTuple &t = it->second;
+        const string &alias = kfvKey(t);
+
+        if (kfvOp(t) != SET_COMMAND || alias.find(':') != string::npos ||
+            consumer.m_toSync.count(alias) > 1)
+        {
+            continue;
+        }
+
+        if (!alias.compare(0, strlen(LOOPBACK_PREFIX), LOOPBACK_PREFIX) ||
+            alias == "eth0" || alias == "docker0" || alias == "usb0")
+        {
+            continue;
+        }
+
+        if (m_syncdIntfses.find(alias) != m_syncdIntfses.end() ||
+            m_removingIntfses.find(alias) != m_removingIntfses.end() ||
+            m_vnetInfses.find(alias) != m_vnetInfses.end())
+        {
+            continue;
+        }
+
+        string vrf_name, vnet_name, inband_type, vlan, loopbackAction;
+        uint32_t mtu = 0;
+        bool adminUp = false;
+        bool adminStateChanged = false;
+        for (const auto &fv : kfvFieldsValues(t))
+        {
+            const auto &field = fvField(fv);
+            const auto &value = fvValue(fv);
+            if (field == "vrf_name")
+            {
+                vrf_name = value;
+            }
+            else if (field == "vnet_name")
+            {
+                vnet_name = value;
+            }
+            else if (field == "inband_type")
+            {
+                inband_type = value;
+            }
+            else if (field == "vlan")
+            {
+                vlan = value;
+            }
+            else if (field == "loopback_action")
+            {
+                loopbackAction = value;
+            }
+            else if (field == "admin_status")
+            {
+                adminUp = (value == "up");
+                adminStateChanged = true;
+            }
+            else if (field == "mtu")
+            {
+                try
+                {
+                    mtu = static_cast<uint32_t>(stoul(value));
+                }
+                catch (...)
+                {
+                    /* Ignored like in doTask, which reports it */
+                }
+            }
+        }
+
+        if (!vnet_name.empty() || !inband_type.empty())
+        {
+            continue;
+        }
+
+        sai_object_id_t vrf_id = gVirtualRouterId;
+        if (!vrf_name.empty())
+        {
+            if (!m_vrfOrch->isVRFexists(vrf_name))
+            {
+                continue;
+            }
+            vrf_id = m_vrfOrch->getVRFid(vrf_name);
+        }
+
+        Port port;
+        if (!gPortsOrch->getPort(alias, port))
+        {
+            if (alias.find(VLAN_SUB_INTERFACE_SEPARATOR) == string::npos)
+            {
+                continue;
+            }
+
+            if (!adminStateChanged)
+            {
+                adminUp = port.m_admin_state_up;
+            }
+
+            if (!gPortsOrch->addSubPort(port, alias, vlan, adminUp, mtu))
+            {
+                continue;
+            }
+        }
+
+        if (port.m_rif_id)
+        {
+            continue;
+        }
+
+        contexts.push_back({port, vrf_id, loopbackAction, SAI_STATUS_NOT_EXECUTED});
+    }
+
+    if (contexts.empty())
+    {
+        return;
+    }
+
+    m_rifBulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+    for (auto &ctx : contexts)
+    {
+        vector<sai_attribute_t> attrs;
+        getRouterIntfsAttrs(ctx.vrf_id, ctx.port, ctx.loopbackAction, attrs);
+        m_rifBulker.create_entry(&ctx.port.m_rif_id, &ctx.status, (uint32_t)attrs.size(), attrs.data());
+    }
+    m_rifBulker.flush();
+
+    SWSS_LOG_INFO("Created %zu router interfaces in bulk", contexts.size());
+
+    for (auto &ctx : contexts)
+    {
+        if (ctx.status == SAI_STATUS_NOT_IMPLEMENTED || ctx.status == SAI_STATUS_NOT_SUPPORTED)
+        {
+            if (m_rifBulkSupported)
+            {
+                SWSS_LOG_NOTICE("Bulk router interface creation is not supported, rv:%d", ctx.status);
+                m_rifBulkSupported = false;
+            }
+
+            /* Left to setIntf() */
+            continue;
+        }
+
+        if (addRouterIntfsPost(ctx.vrf_id, ctx.port, ctx.status))
+        {
+            addSyncdIntf(ctx.port.m_alias, ctx.vrf_id);
+        }
+    }
+}
+
 bool IntfsOrch::removeRouterIntfs(Port &port)
 {
     SWSS_LOG_ENTER();
@@ -1394,7 +1618,20 @@ void IntfsOrch::addIp2MeRoute(sai_object_id_t vrf_id, const IpPrefix &ip_prefix)
     attr.value.oid = cpu_port.m_port_id;
     attrs.push_back(attr);
 
+    if (m_ip2meBulkMode)
+    {
+        m_ip2meRouteOps.push_back({unicast_route_entry, vrf_id, ip_prefix, true, SAI_STATUS_NOT_EXECUTED});
+        auto &op = m_ip2meRouteOps.back();
+        m_routeBulker.create_entry(&op.status, &op.route_entry, (uint32_t)attrs.size(), attrs.data());
+        return;
+    }
+
     sai_status_t status = sai_route_api->create_route_entry(&unicast_route_entry, (uint32_t)attrs.size(), attrs.data());
+    addIp2MeRoutePost(vrf_id, ip_prefix, status);
+}
+
+void IntfsOrch::addIp2MeRoutePost(sai_object_id_t vrf_id, const IpPrefix &ip_prefix, sai_status_t status)
+{
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to create IP2me route ip:%s, rv:%d", ip_prefix.getIp().to_string().c_str(), status);
@@ -1406,7 +1643,7 @@ void IntfsOrch::addIp2MeRoute(sai_object_id_t vrf_id, const IpPrefix &ip_prefix)
 
     SWSS_LOG_NOTICE("Create IP2me route ip:%s", ip_prefix.getIp().to_string().c_str());
 
-    if (unicast_route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    if (ip_prefix.isV4())
     {
         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
     }
@@ -1425,7 +1662,20 @@ void IntfsOrch::removeIp2MeRoute(sai_object_id_t vrf_id, const IpPrefix &ip_pref
     unicast_route_entry.vr_id = vrf_id;
     copy(unicast_route_entry.destination, ip_prefix.getIp());
 
+    if (m_ip2meBulkMode)
+    {
+        m_ip2meRouteOps.push_back({unicast_route_entry, vrf_id, ip_prefix, false, SAI_STATUS_NOT_EXECUTED});
+        auto &op = m_ip2meRouteOps.back();
+        m_routeBulker.remove_entry(&op.status, &op.route_entry);
+        return;
+    }
+
     sai_status_t status = sai_route_api->remove_route_entry(&unicast_route_entry);
+    removeIp2MeRoutePost(vrf_id, ip_prefix, status);
+}
+
+void IntfsOrch::removeIp2MeRoutePost(sai_object_id_t vrf_id, const IpPrefix &ip_prefix, sai_status_t status)
+{
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to remove IP2me route ip:%s, rv:%d", ip_prefix.getIp().to_string().c_str(), status);
@@ -1437,7 +1687,7 @@ void IntfsOrch::removeIp2MeRoute(sai_object_id_t vrf_id, const IpPrefix &ip_pref
 
     SWSS_LOG_NOTICE("Remove packet action trap route ip:%s", ip_prefix.getIp().to_string().c_str());
 
-    if (unicast_route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    if (ip_prefix.isV4())
     {
         gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
     }
@@ -1449,6 +1699,34 @@ void IntfsOrch::removeIp2MeRoute(sai_object_id_t vrf_id, const IpPrefix &ip_pref
     gFlowCounterRouteOrch->onRemoveMiscRouteEntry(vrf_id, IpPrefix(ip_prefix.getIp().to_string()));
 }
 
+void IntfsOrch::flushIp2MeRoutes()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_ip2meRouteOps.empty())
+    {
+        return;
+    }
+
+    m_routeBulker.flush();
+
+    /* Take the ops over first, a failure below throws */
+    std::deque<Ip2MeRouteBulkContext> ops;
+    ops.swap(m_ip2meRouteOps);
+
+    for (const auto &op : ops)
+    {
+        if (op.add)
+        {
+            addIp2MeRoutePost(op.vrf_id, op.ip_prefix, op.status);
+        }
+        else
+        {
+            removeIp2MeRoutePost(op.vrf_id, op.ip_prefix, op.status);
+        }
+    }
+}
+
 void IntfsOrch::addDirectedBroadcast(const Port &port, const IpPrefix &ip_prefix)
 {
     sai_status_t status;
@@ -1550,6 +1828,10 @@ void IntfsOrch::addRifToFlexCounter(const string &id, const string &name, const
     /* check the state of intf, if registering the intf to FC will result in runtime error */
     startFlexCounterPolling(gSwitchId, key, counters_str.c_str(), RIF_COUNTER_ID_LIST);
 
+    sai_object_id_t rif_id;
+    sai_deserialize_object_id(id, rif_id);
+    CounterRatesOrch::getInstance().addRif(rif_id);
+
     SWSS_LOG_DEBUG("Registered interface %s to Flex counter", name.c_str());
 }
 
@@ -1565,6 +1847,10 @@ void IntfsOrch::removeRifFromFlexCounter(const string &id, const string &name)
 
     stopFlexCounterPolling(gSwitchId, key);
 
+    sai_object_id_t rif_id;
+    sai_deserialize_object_id(id, rif_id);
+    CounterRatesOrch::getInstance().removeRif(rif_id);
+
     SWSS_LOG_DEBUG("Unregistered interface %s from Flex counter", name.c_str());
 }
 
@@ -1580,19 +1866,7 @@ void IntfsOrch::generateInterfaceMap()
 
 bool IntfsOrch::updateSyncdIntfPfx(const string &alias, const IpPrefix &ip_prefix, bool add)
 {
-    if (add && m_syncdIntfses[alias].ip_addresses.count(ip_prefix) == 0)
-    {
-        m_syncdIntfses[alias].ip_addresses.insert(ip_prefix);
-        return true;
-    }
-
-    if (!add && m_syncdIntfses[alias].ip_addresses.count(ip_prefix) > 0)
-    {
-        m_syncdIntfses[alias].ip_addresses.erase(ip_prefix);
-        return true;
-    }
-
-    return false;
+    return add ? addIntfAddress(alias, ip_prefix) : removeIntfAddress(alias, ip_prefix);
 }
 
 void IntfsOrch::doTask(SelectableTimer &timer)
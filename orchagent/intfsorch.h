@@ -2,14 +2,19 @@
 #define SWSS_INTFSORCH_H
 
 #include "orch.h"
+#include "zmqorch.h"
+#include "zmqserver.h"
 #include "portsorch.h"
 #include "vrforch.h"
 #include "timer.h"
+#include "bulker.h"
+#include "prefixtrie.h"
 
 #include "ipaddresses.h"
 #include "ipprefix.h"
 #include "macaddress.h"
 
+#include <deque>
 #include <map>
 #include <set>
 
@@ -30,10 +35,31 @@ struct IntfsEntry
 
 typedef map<string, IntfsEntry> IntfsTable;
 
-class IntfsOrch : public Orch
+/* Subnets of the interface addresses of each VRF, with the interfaces holding an address in them */
+typedef map<sai_object_id_t, PrefixTrie<multiset<string>>> IntfSubnetIndex;
+
+struct RifBulkContext
+{
+    // Copy of the port, m_rif_id is written on flush
+    Port port;
+    sai_object_id_t vrf_id;
+    string loopbackAction;
+    sai_status_t status;
+};
+
+struct Ip2MeRouteBulkContext
+{
+    sai_route_entry_t route_entry;
+    sai_object_id_t vrf_id;
+    IpPrefix ip_prefix;
+    bool add;
+    sai_status_t status;
+};
+
+class IntfsOrch : public ZmqOrch
 {
 public:
-    IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBConnector *chassisAppDb);
+    IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBConnector *chassisAppDb, swss::ZmqServer *zmqServer = nullptr);
 
     sai_object_id_t getRouterIntfsId(const string&);
     bool isPrefixSubnet(const IpPrefix&, const string&);
@@ -81,8 +107,9 @@ private:
 
     VRFOrch *m_vrfOrch;
     IntfsTable m_syncdIntfses;
+    IntfSubnetIndex m_intfSubnets;
     map<string, string> m_vnetInfses;
-    void doTask(Consumer &consumer);
+    void doTask(ConsumerBase &consumer) override;
     void doTask(SelectableTimer &timer);
 
     shared_ptr<DBConnector> m_counter_db;
@@ -95,6 +122,10 @@ private:
 
     std::string getRifFlexCounterTableKey(std::string s);
 
+    /* Add or remove an address of an interface and its subnet, false if nothing changed */
+    bool addIntfAddress(const string &alias, const IpPrefix &ip_prefix);
+    bool removeIntfAddress(const string &alias, const IpPrefix &ip_prefix);
+
     bool addRouterIntfs(sai_object_id_t vrf_id, Port &port, string loopbackAction);
     bool removeRouterIntfs(Port &port);
 
@@ -108,6 +139,25 @@ private:
     void voqSyncAddIntf(string &alias);
     void voqSyncDelIntf(string &alias);
 
+    /*
+     * doTask creates the RIFs of a batch in bulk before handling its entries,
+     * so the IP2ME routes, neighbors and attributes of the same batch find
+     * their RIF. The IP2ME routes of the batch are queued and flushed at its end.
+     */
+    ObjectBulker<sai_router_interface_api_t> m_rifBulker;
+    EntityBulker<sai_route_api_t> m_routeBulker;
+    bool m_rifBulkSupported;
+    bool m_ip2meBulkMode;
+    std::deque<Ip2MeRouteBulkContext> m_ip2meRouteOps;
+
+    void bulkAddRouterIntfs(ConsumerBase &consumer);
+    void getRouterIntfsAttrs(sai_object_id_t vrf_id, const Port &port, const string &loopbackActionStr, vector<sai_attribute_t> &attrs);
+    bool addRouterIntfsPost(sai_object_id_t vrf_id, Port &port, sai_status_t status);
+    void addSyncdIntf(const string &alias, sai_object_id_t vrf_id);
+
+    void addIp2MeRoutePost(sai_object_id_t vrf_id, const IpPrefix &ip_prefix, sai_status_t status);
+    void removeIp2MeRoutePost(sai_object_id_t vrf_id, const IpPrefix &ip_prefix, sai_status_t status);
+    void flushIp2MeRoutes();
 };
 
 #endif /* SWSS_INTFSORCH_H */
@@ -19,8 +19,10 @@
 #include "converter.h"
 #include "tokenize.h"
 #include "portsorch.h"
+#include "bulker.h"
 
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 extern PortsOrch *gPortsOrch;
 extern sai_isolation_group_api_t*  sai_isolation_group_api;
 extern sai_bridge_api_t *sai_bridge_api;
@@ -242,6 +244,15 @@ IsoGrpOrch::update(SubjectType type, void *cntx)
 }
 
 
+IsolationGroup::IsolationGroup(string name, isolation_group_type_t type, string description):
+    m_description(description),
+    m_name(name),
+    m_type(type),
+    m_oid(SAI_NULL_OBJECT_ID),
+    m_memberBulker(sai_isolation_group_api, gSwitchId, gMaxBulkSize)
+{
+}
+
 isolation_group_status_t
 IsolationGroup::create()
 {
@@ -315,25 +326,12 @@ IsolationGroup::destroy()
     m_pending_bind_ports.clear();
 
     // Remove all members
+    vector<string> members;
     for (auto &kv : m_members)
     {
-        if (SAI_STATUS_SUCCESS != sai_isolation_group_api->remove_isolation_group_member(kv.second))
-        {
-            SWSS_LOG_ERROR("Unable to delete isolation group member 0x%" PRIx64 " from %s: 0x%" PRIx64 " for port %s",
-                           kv.second,
-                           m_name.c_str(),
-                           m_oid,
-                           kv.first.c_str());
-        }
-        else
-        {
-            SWSS_LOG_NOTICE("Isolation group member 0x%" PRIx64 " deleted from %s: 0x%" PRIx64 " for port %s",
-                            kv.second,
-                            m_name.c_str(),
-                            m_oid,
-                            kv.first.c_str());
-        }
+        members.push_back(kv.first);
     }
+    delMembers(members);
     m_members.clear();
 
     sai_status_t status = sai_isolation_group_api->remove_isolation_group(m_oid);
@@ -354,113 +352,189 @@ isolation_group_status_t
 IsolationGroup::addMember(Port &port)
 {
     SWSS_LOG_ENTER();
-    sai_object_id_t port_id = SAI_NULL_OBJECT_ID;
 
-    if (m_type == ISOLATION_GROUP_TYPE_BRIDGE_PORT)
-    {
-        port_id = port.m_bridge_port_id;
-    }
-    else if (m_type == ISOLATION_GROUP_TYPE_PORT)
-    {
-        port_id = (port.m_type == Port::PHY ? port.m_port_id : port.m_lag_id);
-    }
+    vector<Port> ports = { port };
+    return addMembers(ports);
+}
 
-    if (SAI_NULL_OBJECT_ID == port_id)
-    {
-        SWSS_LOG_NOTICE("Port %s not ready for for isolation group %s of type %d",
-                        port.m_alias.c_str(),
-                        m_name.c_str(),
-                        m_type);
+isolation_group_status_t
+IsolationGroup::delMember(Port &port, bool do_fwd_ref)
+{
+    SWSS_LOG_ENTER();
 
-        m_pending_members.push_back(port.m_alias);
+    return delMembers({ port.m_alias }, do_fwd_ref);
+}
 
-        return ISO_GRP_STATUS_SUCCESS;
-    }
+isolation_group_status_t
+IsolationGroup::addMembers(vector<Port> &ports)
+{
+    SWSS_LOG_ENTER();
 
-    if (m_members.find(port.m_alias) != m_members.end())
-    {
-        SWSS_LOG_DEBUG("Port %s: 0x%" PRIx64 "already a member of %s", port.m_alias.c_str(), port_id, m_name.c_str());
-    }
-    else
+    vector<Port *> queued;
+    vector<sai_object_id_t> port_ids;
+    // Written by the bulker on flush, sized up front so they don't move
+    vector<sai_object_id_t> mem_ids(ports.size(), SAI_NULL_OBJECT_ID);
+    vector<sai_status_t> statuses(ports.size(), SAI_STATUS_NOT_EXECUTED);
+
+    for (auto &port : ports)
     {
-        sai_object_id_t mem_id = SAI_NULL_OBJECT_ID;
+        sai_object_id_t port_id = SAI_NULL_OBJECT_ID;
+
+        if (m_type == ISOLATION_GROUP_TYPE_BRIDGE_PORT)
+        {
+            port_id = port.m_bridge_port_id;
+        }
+        else if (m_type == ISOLATION_GROUP_TYPE_PORT)
+        {
+            port_id = (port.m_type == Port::PHY ? port.m_port_id : port.m_lag_id);
+        }
+
+        if (SAI_NULL_OBJECT_ID == port_id)
+        {
+            SWSS_LOG_NOTICE("Port %s not ready for for isolation group %s of type %d",
+                            port.m_alias.c_str(),
+                            m_name.c_str(),
+                            m_type);
+
+            m_pending_members.push_back(port.m_alias);
+            continue;
+        }
+
+        if (m_members.find(port.m_alias) != m_members.end())
+        {
+            SWSS_LOG_DEBUG("Port %s: 0x%" PRIx64 "already a member of %s", port.m_alias.c_str(), port_id, m_name.c_str());
+            continue;
+        }
+
         sai_attribute_t mem_attr[2];
-        sai_status_t status = SAI_STATUS_SUCCESS;
 
         mem_attr[0].id = SAI_ISOLATION_GROUP_MEMBER_ATTR_ISOLATION_GROUP_ID;
         mem_attr[0].value.oid = m_oid;
         mem_attr[1].id = SAI_ISOLATION_GROUP_MEMBER_ATTR_ISOLATION_OBJECT;
         mem_attr[1].value.oid = port_id;
 
-        status = sai_isolation_group_api->create_isolation_group_member(&mem_id, gSwitchId, 2, mem_attr);
-        if (SAI_STATUS_SUCCESS != status)
+        size_t idx = queued.size();
+        m_memberBulker.create_entry(&mem_ids[idx], &statuses[idx], 2, mem_attr);
+        queued.push_back(&port);
+        port_ids.push_back(port_id);
+    }
+
+    if (queued.empty())
+    {
+        return ISO_GRP_STATUS_SUCCESS;
+    }
+    m_memberBulker.flush();
+    m_memberBulker.clear();
+
+    isolation_group_status_t ret = ISO_GRP_STATUS_SUCCESS;
+    for (size_t i = 0; i < queued.size(); i++)
+    {
+        Port &port = *queued[i];
+        sai_status_t status = statuses[i];
+
+        if (is_bulk_unsupported(status))
         {
-            SWSS_LOG_ERROR("Unable to add %s:  0x%" PRIx64 " as member of %s:0x%" PRIx64 , port.m_alias.c_str(), port_id,
-                           m_name.c_str(), m_oid);
-            return ISO_GRP_STATUS_FAIL;
+            sai_attribute_t mem_attr[2];
+
+            mem_attr[0].id = SAI_ISOLATION_GROUP_MEMBER_ATTR_ISOLATION_GROUP_ID;
+            mem_attr[0].value.oid = m_oid;
+            mem_attr[1].id = SAI_ISOLATION_GROUP_MEMBER_ATTR_ISOLATION_OBJECT;
+            mem_attr[1].value.oid = port_ids[i];
+
+            status = sai_isolation_group_api->create_isolation_group_member(&mem_ids[i], gSwitchId, 2, mem_attr);
         }
-        else
+
+        if (SAI_STATUS_SUCCESS != status)
         {
-            m_members[port.m_alias] = mem_id;
-            SWSS_LOG_NOTICE("Port %s: 0x%" PRIx64 " added as member of %s: 0x%" PRIx64 "with oid 0x%" PRIx64,
-                            port.m_alias.c_str(),
-                            port_id,
-                            m_name.c_str(),
-                            m_oid,
-                            mem_id);
+            SWSS_LOG_ERROR("Unable to add %s:  0x%" PRIx64 " as member of %s:0x%" PRIx64 , port.m_alias.c_str(), port_ids[i],
+                           m_name.c_str(), m_oid);
+            ret = ISO_GRP_STATUS_FAIL;
+            continue;
         }
+
+        m_members[port.m_alias] = mem_ids[i];
+        SWSS_LOG_NOTICE("Port %s: 0x%" PRIx64 " added as member of %s: 0x%" PRIx64 "with oid 0x%" PRIx64,
+                        port.m_alias.c_str(),
+                        port_ids[i],
+                        m_name.c_str(),
+                        m_oid,
+                        mem_ids[i]);
     }
 
-    return ISO_GRP_STATUS_SUCCESS;
+    return ret;
 }
 
 isolation_group_status_t
-IsolationGroup::delMember(Port &port, bool do_fwd_ref)
+IsolationGroup::delMembers(const vector<string> &aliases, bool do_fwd_ref)
 {
     SWSS_LOG_ENTER();
 
-    if (m_members.find(port.m_alias) == m_members.end())
+    vector<const string *> queued;
+    vector<sai_status_t> statuses(aliases.size(), SAI_STATUS_NOT_EXECUTED);
+
+    for (auto &alias : aliases)
     {
-        auto node = find(m_pending_members.begin(), m_pending_members.end(), port.m_alias);
-        if (node != m_pending_members.end())
+        auto member = m_members.find(alias);
+        if (member == m_members.end())
         {
-            m_pending_members.erase(node);
+            auto node = find(m_pending_members.begin(), m_pending_members.end(), alias);
+            if (node != m_pending_members.end())
+            {
+                m_pending_members.erase(node);
+            }
+            continue;
         }
 
-        return ISO_GRP_STATUS_SUCCESS;
+        m_memberBulker.remove_entry(&statuses[queued.size()], member->second);
+        queued.push_back(&alias);
     }
 
-    sai_object_id_t mem_id = m_members[port.m_alias];
-    sai_status_t status = SAI_STATUS_SUCCESS;
-
-    status = sai_isolation_group_api->remove_isolation_group_member(mem_id);
-    if (SAI_STATUS_SUCCESS != status)
+    if (queued.empty())
     {
-        SWSS_LOG_ERROR("Unable to delete isolation group member 0x%" PRIx64 " for port %s and iso group %s 0x%" PRIx64 ,
-                       mem_id,
-                       port.m_alias.c_str(),
-                       m_name.c_str(),
-                       m_oid);
-
-        return ISO_GRP_STATUS_FAIL;
+        return ISO_GRP_STATUS_SUCCESS;
     }
-    else
+    m_memberBulker.flush();
+    m_memberBulker.clear();
+
+    isolation_group_status_t ret = ISO_GRP_STATUS_SUCCESS;
+    for (size_t i = 0; i < queued.size(); i++)
     {
+        const string &alias = *queued[i];
+        sai_object_id_t mem_id = m_members[alias];
+        sai_status_t status = statuses[i];
+
+        if (is_bulk_unsupported(status))
+        {
+            status = sai_isolation_group_api->remove_isolation_group_member(mem_id);
+        }
+
+        if (SAI_STATUS_SUCCESS != status)
+        {
+            SWSS_LOG_ERROR("Unable to delete isolation group member 0x%" PRIx64 " for port %s and iso group %s 0x%" PRIx64 ,
+                           mem_id,
+                           alias.c_str(),
+                           m_name.c_str(),
+                           m_oid);
+
+            ret = ISO_GRP_STATUS_FAIL;
+            continue;
+        }
+
         SWSS_LOG_NOTICE("Deleted isolation group member 0x%" PRIx64 "for port %s and iso group %s 0x%" PRIx64 ,
                        mem_id,
-                       port.m_alias.c_str(),
+                       alias.c_str(),
                        m_name.c_str(),
                        m_oid);
 
-        m_members.erase(port.m_alias);
-    }
+        m_members.erase(alias);
 
-    if (do_fwd_ref)
-    {
-        m_pending_members.push_back(port.m_alias);
+        if (do_fwd_ref)
+        {
+            m_pending_members.push_back(alias);
+        }
     }
 
-    return ISO_GRP_STATUS_SUCCESS;
+    return ret;
 }
 
 isolation_group_status_t
@@ -476,6 +550,8 @@ IsolationGroup::setMembers(string ports)
         old_members.emplace_back(mem.first);
     }
 
+    // Only the difference with the current members is programmed, in bulk
+    vector<Port> new_members;
     for (auto alias : portList)
     {
         if ((0 == alias.find("Ethernet")) || (0 == alias.find("PortChannel")))
@@ -495,7 +571,7 @@ IsolationGroup::setMembers(string ports)
                     m_pending_members.emplace_back(alias);
                     continue;
                 }
-                addMember(port);
+                new_members.push_back(port);
             }
         }
         else
@@ -504,21 +580,10 @@ IsolationGroup::setMembers(string ports)
             continue;
         }
     }
+    addMembers(new_members);
 
     // Remove all the ports which are no longer needed
-    for (auto alias : old_members)
-    {
-        Port port;
-        if (!gPortsOrch->getPort(alias, port))
-        {
-            SWSS_LOG_ERROR("Port %s not found", alias.c_str());
-            m_pending_members.erase(find(m_pending_members.begin(), m_pending_members.end(), port.m_alias));
-        }
-        else
-        {
-            delMember(port);
-        }
-    }
+    delMembers(old_members);
 
     return ISO_GRP_STATUS_SUCCESS;
 }
@@ -21,6 +21,7 @@
 #include "orch.h"
 #include "port.h"
 #include "observer.h"
+#include "bulker.h"
 
 #define ISOLATION_GRP_DESCRIPTION       "DESCRIPTION"
 #define ISOLATION_GRP_TYPE              "TYPE"
@@ -49,13 +50,7 @@ class IsolationGroup: public Observer, public Subject
 public:
     string m_description;
 
-    IsolationGroup(string name, isolation_group_type_t type = ISOLATION_GROUP_TYPE_PORT, string description=""):
-        m_name(name),
-        m_description(description),
-        m_type(type),
-        m_oid(SAI_NULL_OBJECT_ID)
-    {
-    }
+    IsolationGroup(string name, isolation_group_type_t type = ISOLATION_GROUP_TYPE_PORT, string description="");
 
     // Create Isolation group in SAI
     isolation_group_status_t create();
@@ -69,6 +64,12 @@ public:
     // Delete Isolation group member
     isolation_group_status_t delMember(Port &port, bool do_fwd_ref=false);
 
+    // Add Isolation group members with one bulk call
+    isolation_group_status_t addMembers(vector<Port> &ports);
+
+    // Delete Isolation group members with one bulk call
+    isolation_group_status_t delMembers(const vector<string> &aliases, bool do_fwd_ref=false);
+
     // Set Isolation group members to the input. May involve adding or deleting members
     isolation_group_status_t setMembers(string ports);
 
@@ -102,6 +103,7 @@ protected:
     vector<string> m_bind_ports; // Ports in which this Iso Group is applied.
     vector<string> m_pending_members;
     vector<string> m_pending_bind_ports;
+    ObjectBulker<sai_isolation_group_api_t> m_memberBulker;
 };
 
 class IsoGrpOrch : public Orch, public Observer
@@ -15,20 +15,14 @@ LagIdAllocator::LagIdAllocator(
     m_shaLagId = loadRedisScript(m_dbConnector, luaScript);
 }
 
-int32_t LagIdAllocator::lagIdAdd(
-        _In_ const string &pcname,
-        _In_ int32_t lag_id)
+int32_t LagIdAllocator::runScript(
+        _In_ const vector<string> &args)
 {
     SWSS_LOG_ENTER();
 
     // No keys
     vector<string> keys;
 
-    vector<string> args;
-    args.push_back("add");
-    args.push_back(pcname);
-    args.push_back(to_string(lag_id));
-
     set<string> ret = runRedisScript(*m_dbConnector, m_shaLagId, keys, args);
 
     if (!ret.empty())
@@ -43,30 +37,41 @@ int32_t LagIdAllocator::lagIdAdd(
     return LAG_ID_ALLOCATOR_ERROR_DB_ERROR;
 }
 
-int32_t LagIdAllocator::lagIdDel(
-        _In_ const string &pcname)
+int32_t LagIdAllocator::lagIdAdd(
+        _In_ const string &pcname,
+        _In_ int32_t lag_id)
 {
     SWSS_LOG_ENTER();
 
-    // No keys
-    vector<string> keys;
-
-    vector<string> args;
-    args.push_back("del");
-    args.push_back(pcname);
+    auto it = m_lagIds.find(pcname);
+    if (it != m_lagIds.end() && (lag_id == 0 || lag_id == it->second))
+    {
+        return it->second;
+    }
 
-    set<string> ret = runRedisScript(*m_dbConnector, m_shaLagId, keys, args);
+    int32_t rv = runScript({ "add", pcname, to_string(lag_id) });
 
-    if (!ret.empty())
+    if (rv > 0)
     {
-        // We expect only one value in the set returned
+        m_lagIds[pcname] = rv;
+    }
 
-        auto rv_lag_id = ret.begin();
+    return rv;
+}
 
-        return (stoi(*rv_lag_id));
+int32_t LagIdAllocator::lagIdDel(
+        _In_ const string &pcname)
+{
+    SWSS_LOG_ENTER();
+
+    int32_t rv = runScript({ "del", pcname });
+
+    if (rv != LAG_ID_ALLOCATOR_ERROR_DB_ERROR)
+    {
+        m_lagIds.erase(pcname);
     }
 
-    return LAG_ID_ALLOCATOR_ERROR_DB_ERROR;
+    return rv;
 }
 
 int32_t LagIdAllocator::lagIdGet(
@@ -74,23 +79,75 @@ int32_t LagIdAllocator::lagIdGet(
 {
     SWSS_LOG_ENTER();
 
-    // No keys
-    vector<string> keys;
-
-    vector<string> args;
-    args.push_back("get");
-    args.push_back(pcname);
+    auto it = m_lagIds.find(pcname);
+    if (it != m_lagIds.end())
+    {
+        return it->second;
+    }
 
-    set<string> ret = runRedisScript(*m_dbConnector, m_shaLagId, keys, args);
+    int32_t rv = runScript({ "get", pcname });
 
-    if (!ret.empty())
+    if (rv > 0)
     {
-        // We expect only one value in the set returned
+        m_lagIds[pcname] = rv;
+    }
 
-        auto rv_lag_id = ret.begin();
+    return rv;
+}
 
-        return (stoi(*rv_lag_id));
+size_t LagIdAllocator::lagIdAddBulk(
+        _In_ const vector<string> &pcnames)
+{
+    SWSS_LOG_ENTER();
+
+    size_t allocated = 0;
+    vector<string> args;
+
+    for (size_t i = 0; i < pcnames.size(); i++)
+    {
+        if (m_lagIds.find(pcnames[i]) == m_lagIds.end())
+        {
+            if (args.empty())
+            {
+                args.push_back("add_bulk");
+            }
+            args.push_back(pcnames[i]);
+        }
+
+        bool last = (i + 1 == pcnames.size());
+        if (args.empty() || (args.size() <= LAG_ID_ALLOCATOR_BULK_SIZE && !last))
+        {
+            continue;
+        }
+
+        // No keys
+        vector<string> keys;
+
+        // Each lag comes back as "<lag name>:<lag id>", the lag name may contain ':'
+        set<string> ret = runRedisScript(*m_dbConnector, m_shaLagId, keys, args);
+        for (const auto &lag : ret)
+        {
+            auto pos = lag.rfind(':');
+            if (pos == string::npos)
+            {
+                continue;
+            }
+
+            int32_t lag_id = stoi(lag.substr(pos + 1));
+            if (lag_id <= 0)
+            {
+                SWSS_LOG_ERROR("Failed to allocate a lag id for %s rv:%d", lag.substr(0, pos).c_str(), lag_id);
+                continue;
+            }
+
+            m_lagIds[lag.substr(0, pos)] = lag_id;
+            allocated++;
+        }
+
+        args.clear();
     }
 
-    return LAG_ID_ALLOCATOR_ERROR_DB_ERROR;
+    SWSS_LOG_INFO("Allocated %zu lag ids of %zu lags", allocated, pcnames.size());
+
+    return allocated;
 }
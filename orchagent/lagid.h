@@ -6,6 +6,9 @@
 #include "schema.h"
 #include "redisapi.h"
 
+#include <map>
+#include <vector>
+
 using namespace swss;
 using namespace std;
 
@@ -15,6 +18,9 @@ using namespace std;
 #define LAG_ID_ALLOCATOR_ERROR_INVALID_OP             -3
 #define LAG_ID_ALLOCATOR_ERROR_DB_ERROR               -4
 
+// Lags allocated per run of the script by lagIdAddBulk, bounds the time the chassis db is held
+#define LAG_ID_ALLOCATOR_BULK_SIZE                    128
+
 class LagIdAllocator
 {
 public:
@@ -34,11 +40,24 @@ public:
     int32_t lagIdGet(
             _In_ const string &pcname);
 
+    // Allocate the lag ids of the lags in as few script runs as possible,
+    // the later lagIdAdd of these lags are served from the cache.
+    // Returns the number of lag ids allocated.
+    size_t lagIdAddBulk(
+            _In_ const vector<string> &pcnames);
+
 private:
 
+    int32_t runScript(
+            _In_ const vector<string> &args);
+
     DBConnector* m_dbConnector;
 
     string m_shaLagId;
+
+    // Lag ids of the lags of this asic. The system lag names include the
+    // host and asic names, only this allocator changes their lag ids.
+    map<string, int32_t> m_lagIds;
 };
 
 #endif // SWSS_LAGID_H
@@ -1,9 +1,10 @@
 -- KEYS - None
--- ARGV[1] - operation (add/del/get)
--- ARGV[2] - lag name
+-- ARGV[1] - operation (add/add_bulk/del/get)
+-- ARGV[2] - lag name, ARGV[2..n] lag names for "add_bulk"
 -- ARGV[3] - current lag id (for "add" operation only)
 
 -- return lagid if success for "add"/"del"
+-- return "<lag name>:<lagid>" of each lag for "add_bulk"
 -- return 0 if lag does not exist for "del"
 -- return -1 if lag table full for "add"
 -- return -2 if lag does not exist for "get"
@@ -15,9 +16,7 @@ local pcname = ARGV[2]
 local lagid_start = tonumber(redis.call("get", "SYSTEM_LAG_ID_START"))
 local lagid_end = tonumber(redis.call("get", "SYSTEM_LAG_ID_END"))
 
-if op == "add" then
-
-    local plagid = tonumber(ARGV[3])
+local function add_lag(pcname, plagid)
 
     local dblagid = redis.call("hget", "SYSTEM_LAG_ID_TABLE", pcname)
 
@@ -85,6 +84,23 @@ if op == "add" then
     return tonumber(lagid)
 end
 
+if op == "add" then
+    return add_lag(pcname, tonumber(ARGV[3]))
+end
+
+if op == "add_bulk" then
+
+    -- Allocate the lag ids of many lags in one run, no lag id proposed.
+    -- Each lag is returned as "<lag name>:<lag id>", with lag id -1 if the table is full
+    local result = {}
+    for i = 2, #ARGV do
+        local lagid = add_lag(ARGV[i], 0)
+        table.insert(result, ARGV[i] .. ":" .. tostring(lagid))
+    end
+    return result
+
+end
+
 if op == "del" then
 
     if redis.call("hexists", "SYSTEM_LAG_ID_TABLE", pcname) == 1 then
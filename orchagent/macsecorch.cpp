@@ -36,6 +36,7 @@ extern sai_macsec_api_t *sai_macsec_api;
 extern sai_acl_api_t *sai_acl_api;
 extern sai_port_api_t *sai_port_api;
 extern sai_switch_api_t *sai_switch_api;
+extern size_t gMaxBulkSize;
 
 constexpr bool DEFAULT_ENABLE_ENCRYPT = true;
 constexpr bool DEFAULT_SCI_IN_SECTAG = false;
@@ -630,11 +631,12 @@ MACsecOrch::MACsecOrch(
     PortsOrch *port_orch) : Orch(app_db, tables),
                             m_port_orch(port_orch),
                             m_state_db(state_db),
+                            m_state_pipeline(new RedisPipeline(state_db)),
                             m_state_macsec_port(state_db, STATE_MACSEC_PORT_TABLE_NAME),
                             m_state_macsec_egress_sc(state_db, STATE_MACSEC_EGRESS_SC_TABLE_NAME),
                             m_state_macsec_ingress_sc(state_db, STATE_MACSEC_INGRESS_SC_TABLE_NAME),
-                            m_state_macsec_egress_sa(state_db, STATE_MACSEC_EGRESS_SA_TABLE_NAME),
-                            m_state_macsec_ingress_sa(state_db, STATE_MACSEC_INGRESS_SA_TABLE_NAME),
+                            m_state_macsec_egress_sa(m_state_pipeline.get(), STATE_MACSEC_EGRESS_SA_TABLE_NAME, true),
+                            m_state_macsec_ingress_sa(m_state_pipeline.get(), STATE_MACSEC_INGRESS_SA_TABLE_NAME, true),
                             m_applPortTable(app_db, APP_PORT_TABLE_NAME),
                             m_counter_db("COUNTERS_DB", 0),
                             m_macsec_counters_map(&m_counter_db, COUNTERS_MACSEC_NAME_MAP),
@@ -737,6 +739,7 @@ MACsecOrch::~MACsecOrch()
         const MACsecOrch::TaskArgs temp;
         taskDisableMACsecPort(port->first, temp);
     }
+    m_state_pipeline->flush();
 }
 
 void MACsecOrch::doTask(NotificationConsumer &consumer)
@@ -892,12 +895,47 @@ void MACsecOrch::doTask(Consumer &consumer)
     };
 
     const std::string &table_name = consumer.getTableName();
+
+    // SAs of the round are created together by flushMACsecSAs(), their tasks
+    // are completed with the result of their request afterwards
+    m_batch_sas = table_name == APP_MACSEC_EGRESS_SA_TABLE_NAME
+        || table_name == APP_MACSEC_INGRESS_SA_TABLE_NAME;
+    std::vector<std::pair<decltype(consumer.m_toSync.begin()), size_t>> queued_sas;
+
+    auto isTaskDone = [&table_name](const std::string &op, task_process_status task_done)
+    {
+        if (task_done == task_need_retry)
+        {
+            SWSS_LOG_DEBUG(
+                "Task %s - %s need retry",
+                table_name.c_str(),
+                op.c_str());
+            return false;
+        }
+
+        if (task_done != task_success)
+        {
+            SWSS_LOG_WARN("Task %s - %s fail",
+                          table_name.c_str(),
+                          op.c_str());
+        }
+        else
+        {
+            SWSS_LOG_DEBUG(
+                "Task %s - %s success",
+                table_name.c_str(),
+                op.c_str());
+        }
+        return true;
+    };
+
     auto itr = consumer.m_toSync.begin();
     while (itr != consumer.m_toSync.end())
     {
         task_process_status task_done = task_failed;
         auto &message = itr->second;
         const std::string &op = kfvOp(message);
+        size_t pending_sas = m_sa_requests.size();
 
         auto task = TaskMap.find(std::make_tuple(table_name, op));
         if (task != TaskMap.end())
@@ -914,33 +952,36 @@ void MACsecOrch::doTask(Consumer &consumer)
                 op.c_str());
         }
 
-        if (task_done == task_need_retry)
+        if (m_sa_requests.size() > pending_sas)
         {
-            SWSS_LOG_DEBUG(
-                "Task %s - %s need retry",
-                table_name.c_str(),
-                op.c_str());
+            queued_sas.emplace_back(itr, pending_sas);
             ++itr;
         }
+        else if (isTaskDone(op, task_done))
+        {
+            itr = consumer.m_toSync.erase(itr);
+        }
         else
         {
-            if (task_done != task_success)
-            {
-                SWSS_LOG_WARN("Task %s - %s fail",
-                              table_name.c_str(),
-                              op.c_str());
-            }
-            else
+            ++itr;
+        }
+    }
+
+    if (m_batch_sas)
+    {
+        m_batch_sas = false;
+        flushMACsecSAs();
+        for (const auto &sa : queued_sas)
+        {
+            if (isTaskDone(kfvOp(sa.first->second), m_sa_requests[sa.second].m_result))
             {
-                SWSS_LOG_DEBUG(
-                    "Task %s - %s success",
-                    table_name.c_str(),
-                    op.c_str());
+                consumer.m_toSync.erase(sa.first);
             }
-
-            itr = consumer.m_toSync.erase(itr);
         }
+        m_sa_requests.clear();
     }
+
+    m_state_pipeline->flush();
 }
 
 task_process_status MACsecOrch::taskUpdateMACsecPort(
@@ -2323,63 +2364,148 @@ task_process_status MACsecOrch::createMACsecSA(
         }
     }
 
-    RecoverStack recover;
+    MACsecSARequest request;
+    request.m_port_sci_an = port_sci_an;
+    request.m_direction = direction;
+    request.m_switch_id = *ctx.get_switch_id();
+    getMACsecSAAttrs(
+        request.m_attrs,
+        direction,
+        sc->m_sc_id,
+        an,
+        sak.m_sak,
+        salt.m_salt,
+        ssci,
+        auth_key.m_auth_key,
+        pn);
 
-    // If this SA is the first SA
-    // change the ACL entry action from packet action to MACsec flow
-    if (ctx.get_macsec_port()->m_enable && sc->m_sa_ids.empty())
+    if (m_batch_sas)
     {
-        if (!setMACsecFlowActive(sc->m_entry_id, sc->m_flow_id, true))
+        m_sa_requests.push_back(std::move(request));
+        return task_success;
+    }
+
+    request.m_status = sai_macsec_api->create_macsec_sa(
+                                &request.m_sa_id,
+                                request.m_switch_id,
+                                static_cast<uint32_t>(request.m_attrs.size()),
+                                request.m_attrs.data());
+    return finishMACsecSA(request);
+}
+
+ObjectBulker<sai_macsec_api_t> &MACsecOrch::getMACsecSABulker(sai_object_id_t switch_id)
+{
+    auto bulker = m_sa_bulkers.find(switch_id);
+    if (bulker == m_sa_bulkers.end())
+    {
+        bulker = m_sa_bulkers.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(switch_id),
+            std::forward_as_tuple(sai_macsec_api, switch_id, gMaxBulkSize)).first;
+    }
+    return bulker->second;
+}
+
+void MACsecOrch::flushMACsecSAs()
+{
+    SWSS_LOG_ENTER();
+
+    // SAs at gearbox PHYs are created at the PHY switch, one bulk per switch
+    std::map<sai_object_id_t, std::vector<size_t>> switch_requests;
+    for (size_t i = 0; i < m_sa_requests.size(); i++)
+    {
+        if (!m_sa_requests[i].m_done)
         {
-            SWSS_LOG_WARN("Cannot change the ACL entry action from packet action to MACsec flow");
-            return task_failed;
+            switch_requests[m_sa_requests[i].m_switch_id].push_back(i);
         }
-        recover.add_action([this, sc]() {
-            this->setMACsecFlowActive(
-                sc->m_entry_id,
-                sc->m_flow_id,
-                false);
-        });
     }
 
-    if (!createMACsecSA(
-            sc->m_sa_ids[an],
-            *ctx.get_switch_id(),
-            direction,
-            sc->m_sc_id,
-            an,
-            sak.m_sak,
-            salt.m_salt,
-            ssci,
-            auth_key.m_auth_key,
-            pn))
+    for (const auto &requests : switch_requests)
     {
+        auto &bulker = getMACsecSABulker(requests.first);
+        for (auto i : requests.second)
+        {
+            auto &request = m_sa_requests[i];
+            bulker.create_entry(
+                &request.m_sa_id,
+                &request.m_status,
+                static_cast<uint32_t>(request.m_attrs.size()),
+                request.m_attrs.data());
+        }
+        bulker.flush();
+
+        for (auto i : requests.second)
+        {
+            auto &request = m_sa_requests[i];
+            if (is_bulk_unsupported(request.m_status))
+            {
+                request.m_status = sai_macsec_api->create_macsec_sa(
+                                            &request.m_sa_id,
+                                            request.m_switch_id,
+                                            static_cast<uint32_t>(request.m_attrs.size()),
+                                            request.m_attrs.data());
+            }
+            finishMACsecSA(request);
+        }
+    }
+}
+
+task_process_status MACsecOrch::finishMACsecSA(MACsecSARequest &request)
+{
+    SWSS_LOG_ENTER();
+
+    const std::string &port_sci_an = request.m_port_sci_an;
+    request.m_done = true;
+    request.m_result = task_failed;
+
+    // The key has been checked when the request was built
+    std::string port_name;
+    MACsecSCI sci;
+    macsec_an_t an = 0;
+    extract_variables(port_sci_an, ':', port_name, sci, an);
+    MACsecOrchContext ctx(this, port_name, request.m_direction, sci, an);
+    auto sc = ctx.get_macsec_sc();
+
+    if (request.m_status != SAI_STATUS_SUCCESS)
+    {
+        // Without the SA the SC flow must stay on the packet action
+        handleSaiCreateStatus(SAI_API_MACSEC, request.m_status);
         SWSS_LOG_WARN("Cannot create the SA %s", port_sci_an.c_str());
-        return task_failed;
+        return request.m_result;
     }
-    recover.add_action([this, sc, an]() {
-        this->deleteMACsecSA(sc->m_sa_ids[an]);
-        sc->m_sa_ids.erase(an);
-    });
+    sc->m_sa_ids[an] = request.m_sa_id;
 
-    installCounter(ctx, CounterType::MACSEC_SA_ATTR, direction, port_sci_an, sc->m_sa_ids[an], macsec_sa_attrs);
+    // If this SA is the first SA
+    // change the ACL entry action from packet action to MACsec flow
+    if (ctx.get_macsec_port()->m_enable && sc->m_sa_ids.size() == 1)
+    {
+        if (!setMACsecFlowActive(sc->m_entry_id, sc->m_flow_id, true))
+        {
+            SWSS_LOG_WARN("Cannot change the ACL entry action from packet action to MACsec flow");
+            deleteMACsecSA(sc->m_sa_ids[an]);
+            sc->m_sa_ids.erase(an);
+            return request.m_result;
+        }
+    }
+
+    installCounter(ctx, CounterType::MACSEC_SA_ATTR, request.m_direction, port_sci_an, sc->m_sa_ids[an], macsec_sa_attrs);
     std::vector<FieldValueTuple> fvVector;
     fvVector.emplace_back("state", "ok");
-    if (direction == SAI_MACSEC_DIRECTION_EGRESS)
+    if (request.m_direction == SAI_MACSEC_DIRECTION_EGRESS)
     {
-        installCounter(ctx, CounterType::MACSEC_SA, direction, port_sci_an, sc->m_sa_ids[an], macsec_sa_egress_stats);
+        installCounter(ctx, CounterType::MACSEC_SA, request.m_direction, port_sci_an, sc->m_sa_ids[an], macsec_sa_egress_stats);
         m_state_macsec_egress_sa.set(swss::join('|', port_name, sci, an), fvVector);
     }
     else
     {
-        installCounter(ctx, CounterType::MACSEC_SA, direction, port_sci_an, sc->m_sa_ids[an], macsec_sa_ingress_stats);
+        installCounter(ctx, CounterType::MACSEC_SA, request.m_direction, port_sci_an, sc->m_sa_ids[an], macsec_sa_ingress_stats);
         m_state_macsec_ingress_sa.set(swss::join('|', port_name, sci, an), fvVector);
     }
 
     SWSS_LOG_NOTICE("MACsec SA %s is created.", port_sci_an.c_str());
 
-    recover.clear();
-    return task_success;
+    request.m_result = task_success;
+    return request.m_result;
 }
 
 task_process_status MACsecOrch::deleteMACsecSA(
@@ -2388,6 +2514,9 @@ task_process_status MACsecOrch::deleteMACsecSA(
 {
     SWSS_LOG_ENTER();
 
+    // An SA deleted in the round it was set in must be created first
+    flushMACsecSAs();
+
     std::string port_name = "";
     MACsecSCI sci;
     macsec_an_t an = 0;
@@ -2441,9 +2570,8 @@ task_process_status MACsecOrch::deleteMACsecSA(
     return result;
 }
 
-bool MACsecOrch::createMACsecSA(
-    sai_object_id_t &sa_id,
-    sai_object_id_t switch_id,
+void MACsecOrch::getMACsecSAAttrs(
+    std::vector<sai_attribute_t> &attrs,
     sai_macsec_direction_t direction,
     sai_object_id_t sc_id,
     macsec_an_t an,
@@ -2456,7 +2584,6 @@ bool MACsecOrch::createMACsecSA(
     SWSS_LOG_ENTER();
 
     sai_attribute_t attr;
-    std::vector<sai_attribute_t> attrs;
 
     attr.id = SAI_MACSEC_SA_ATTR_MACSEC_DIRECTION;
     attr.value.s32 = direction;
@@ -2500,21 +2627,6 @@ bool MACsecOrch::createMACsecSA(
         attr.value.u64 = pn;
         attrs.push_back(attr);
     }
-
-    sai_status_t status = sai_macsec_api->create_macsec_sa(
-                                &sa_id,
-                                switch_id,
-                                static_cast<uint32_t>(attrs.size()),
-                                attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_MACSEC, status);
-        if (handle_status != task_success)
-        {
-            return parseHandleSaiStatusFailure(handle_status);
-        }
-    }
-    return true;
 }
 
 bool MACsecOrch::deleteMACsecSA(sai_object_id_t sa_id)
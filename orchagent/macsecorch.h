@@ -5,8 +5,10 @@
 
 #include "portsorch.h"
 #include "flex_counter_manager.h"
+#include "bulker.h"
 
 #include <dbconnector.h>
+#include <redispipeline.h>
 #include <swss/schema.h>
 
 #include <map>
@@ -66,6 +68,8 @@ private:
 
     PortsOrch * m_port_orch;
 
+    // SA states are written through the pipeline, flushed at the end of each round
+    std::unique_ptr<RedisPipeline> m_state_pipeline;
     Table m_state_macsec_port;
     Table m_state_macsec_egress_sc;
     Table m_state_macsec_ingress_sc;
@@ -209,9 +213,8 @@ private:
     task_process_status deleteMACsecSA(
         const std::string &port_sci_an,
         sai_macsec_direction_t direction);
-    bool createMACsecSA(
-        sai_object_id_t &sa_id,
-        sai_object_id_t switch_id,
+    void getMACsecSAAttrs(
+        std::vector<sai_attribute_t> &attrs,
         sai_macsec_direction_t direction,
         sai_object_id_t sc_id,
         macsec_an_t an,
@@ -222,6 +225,30 @@ private:
         sai_uint64_t pn);
     bool deleteMACsecSA(sai_object_id_t sa_id);
 
+    /*
+     * SA creations of an SA table round, e.g. a rekey of many ports. They are
+     * created with one bulk call per switch once the round is read, or before
+     * an SA is deleted so the SC flow keeps track of its SAs in order.
+     */
+    struct MACsecSARequest
+    {
+        std::string                         m_port_sci_an;
+        sai_macsec_direction_t              m_direction;
+        sai_object_id_t                     m_switch_id;
+        std::vector<sai_attribute_t>        m_attrs;
+        sai_object_id_t                     m_sa_id = SAI_NULL_OBJECT_ID;
+        sai_status_t                        m_status = SAI_STATUS_NOT_EXECUTED;
+        task_process_status                 m_result = task_need_retry;
+        bool                                m_done = false;
+    };
+    std::vector<MACsecSARequest> m_sa_requests;
+    bool m_batch_sas = false;
+    std::map<sai_object_id_t, ObjectBulker<sai_macsec_api_t>> m_sa_bulkers;
+
+    ObjectBulker<sai_macsec_api_t> &getMACsecSABulker(sai_object_id_t switch_id);
+    void flushMACsecSAs();
+    task_process_status finishMACsecSA(MACsecSARequest &request);
+
     /* Counter */
     void installCounter(
         MACsecOrchContext &ctx,
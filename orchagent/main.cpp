@@ -33,6 +33,10 @@ extern "C" {
 #include "warm_restart.h"
 #include "gearboxutils.h"
 #include "macsecpost.h"
+#include "tokenize.h"
+#include "boottimeline.h"
+#include "saicapabilitycache.h"
+#include "memaccounting.h"
 
 using namespace std;
 using namespace swss;
@@ -52,11 +56,15 @@ MacAddress gMacAddress;
 MacAddress gVxlanMacAddress;
 bool gOrchUnhealthy = false;
 extern volatile sig_atomic_t gOrchShutdownRequested;
+extern volatile sig_atomic_t gFlightRecorderDumpRequested;
+extern volatile sig_atomic_t gMemAccountingDumpRequested;
 string gSaiErrorString;
 
 extern size_t gMaxBulkSize;
 
 #define DEFAULT_BATCH_SIZE  128
+/* A prefetched table is popped ahead as long as its Consumer backlog is below this many pop batches */
+#define PREFETCH_DEPTH_BATCHES 8
 extern int gBatchSize;
 
 bool gRingMode = false;
@@ -92,7 +100,7 @@ bool isChassisDbInUse()
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-A] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-q zmq_server_address] [-c mode] [-t create_switch_timeout] [-v VRF] [-I heart_beat_interval] [-R] [-M]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-A] [-O] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-q zmq_server_address] [-c mode] [-t create_switch_timeout] [-v VRF] [-I heart_beat_interval] [-R ring_size] [-M] [-E executor_stats_interval] [-S time_slice_msec] [-B round_budget_msec] [-W worker_threads] [-P prefetch_tables] [-F flush_latency_msec[,flush_batch_ops]] [-L] [-K bulk_target_usec[,bulk_high_water_mark]] [-N route_parse_threads] [-C counter_snapshot_path] [-G flight_recorder_kb] [-X orchagent_stats_interval] [-T bake_threads] [-V warm_validation_path] [-D dash_parse_threads] [-Y capability_cache_path] [-H]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    Bit 0: sairedis.rec, Bit 1: swss.rec, Bit 2: responsepublisher.rec. For example:" << endl;
@@ -106,6 +114,7 @@ void usage()
     cout << "    -m MAC: set switch MAC address" << endl;
     cout << "    -i INST_ID: set the ASIC instance_id in multi-asic platform" << endl;
     cout << "    -A: enable async swss.rec recording path" << endl;
+    cout << "    -O: record swss.rec in the compact binary format, decoded with swssrecdump" << endl;
     cout << "    -s enable synchronous mode (deprecated, use -z)" << endl;
     cout << "    -z redis communication mode (redis_async|redis_sync|zmq_sync), default: redis_async" << endl;
     cout << "    -f swss_rec_filename: swss record log filename(default 'swss.rec')" << endl;
@@ -116,8 +125,34 @@ void usage()
     cout << "    -t Override create switch timeout, in sec" << endl;
     cout << "    -v vrf: VRF name (default empty)" << endl;
     cout << "    -I heart_beat_interval: Heart beat interval in millisecond (default 10)" << endl;
-    cout << "    -R enable the ring thread feature" << endl;
+    cout << "    -R ring_size: enable the ring thread feature, ring_size is the number of ring slots (default 30)" << endl;
     cout << "    -M enable SAI MACSec POST" << endl;
+    cout << "    -E executor_stats_interval: collect per executor latency/backlog histograms and publish them" << endl;
+    cout << "                                to COUNTERS_DB every executor_stats_interval seconds (default 0, disabled)" << endl;
+    cout << "    -S time_slice_msec: yield long running drains after time_slice_msec and resume them in the next round (default 0, disabled)" << endl;
+    cout << "    -B round_budget_msec: serve pending tasks in Orch priority order for at most round_budget_msec per round (default 0, unbounded)" << endl;
+    cout << "    -W worker_threads: serve Orchs with declared independent dependencies on worker_threads threads (default 0, disabled)" << endl;
+    cout << "    -P prefetch_tables: comma separated APPL_DB tables popped on reader threads ahead of their doTask (default none)" << endl;
+    cout << "    -F flush_latency_msec[,flush_batch_ops]: flush sairedis once flush_batch_ops ops are pending, their age reaches flush_latency_msec or the loop is idle (default 0, flush every second and on idle)" << endl;
+    cout << "    -L program ACL rules through bulk SAI calls" << endl;
+    cout << "    -K bulk_target_usec[,bulk_high_water_mark]: shrink or grow the bulk SAI calls to keep them under bulk_target_usec, up to the max bulk size," << endl;
+    cout << "                                               and flush bulkers which allow it once bulk_high_water_mark entries are pending (default 0, disabled)" << endl;
+    cout << "    -N route_parse_threads: parse batches of route tasks on route_parse_threads threads ahead of RouteOrch and the P4 route manager (default 0, disabled)" << endl;
+    cout << "    -C counter_snapshot_path: publish the port, queue and PG counters in a shared memory snapshot at counter_snapshot_path, e.g. /dev/shm/counters (default none)" << endl;
+    cout << "    -G flight_recorder_kb: keep the last flight_recorder_kb KB of the swss, responsepublisher and retry records in memory," << endl;
+    cout << "                           written to their files on a fatal signal, SIGUSR1 or a SAI failure (default 0, write records as they come)" << endl;
+    cout << "    -X orchagent_stats_interval: publish the consumer, retry, ring and bulker backlogs and the object counts" << endl;
+    cout << "                                 to STATE_DB every orchagent_stats_interval seconds (default 0, disabled)" << endl;
+    cout << "    -T bake_threads: read the tables of the warm restore bake with SCAN on bake_threads threads (default 0, each bake reads its tables)" << endl;
+    cout << "    -V warm_validation_path: warm restart validation aid, record the table digests and object counts to warm_validation_path" << endl;
+    cout << "                             on warm shutdown and log the objects the next warm restore rebuilt differently." << endl;
+    cout << "                             The restore replays every object either way (default disabled)" << endl;
+    cout << "    -D dash_parse_threads: parse the protobuf messages of DASH CA-to-PA mapping and route batches" << endl;
+    cout << "                           on dash_parse_threads threads (default 0, disabled)" << endl;
+    cout << "    -Y capability_cache_path: persist the SAI capability query results to capability_cache_path" << endl;
+    cout << "                              and restore them on warm restart (default not persisted)" << endl;
+    cout << "    -H account the memory of the route, next hop group, neighbor, FDB, ACL rule, P4 OID and DASH tables," << endl;
+    cout << "       published to STATE_DB with the heap statistics on SIGUSR2 (default disabled)" << endl;
 }
 
 void sighup_handler(int signo)
@@ -140,6 +175,7 @@ void fatal_signal_handler(int signo)
      * the expected core dump.
      */
     dumpAsyncSwssRecorderSignalSafeStats(STDERR_FILENO, signo);
+    dumpFlightRecordersSignalSafe(signo);
 
     /*
      * The handler is registered with SA_RESETHAND, so only the handled
@@ -158,6 +194,18 @@ void graceful_shutdown_signal_handler(int signo)
     gOrchShutdownRequested = signo;
 }
 
+void flight_recorder_signal_handler(int signo)
+{
+    /* Dumped from the main loop, the recorders take locks */
+    gFlightRecorderDumpRequested = 1;
+}
+
+void memory_accounting_signal_handler(int signo)
+{
+    /* Published from the main loop, the DB writes take locks */
+    gMemAccountingDumpRequested = 1;
+}
+
 void register_fatal_signal_handler(int signo)
 {
     struct sigaction sigact = {};
@@ -190,6 +238,8 @@ void syncd_apply_view()
 {
     SWSS_LOG_NOTICE("Notify syncd APPLY_VIEW");
 
+    BootPhase phase("syncd_apply_view", "sai");
+
     sai_status_t status;
     sai_attribute_t attr;
     attr.id = SAI_REDIS_SWITCH_ATTR_NOTIFY_SYNCD;
@@ -235,6 +285,7 @@ void init_gearbox_phys(DBConnector *applDb)
                 tmpGearboxTable->hset("phy:"+to_string(it->second.phy_id), "firmware_major_version", it->second.firmware_major_version.c_str());
             }
         }
+        gearbox.invalidate();
     }
     delete tmpGearboxTable;
 }
@@ -429,6 +480,8 @@ int main(int argc, char **argv)
 
     SWSS_LOG_ENTER();
 
+    BootTimeline::instance().start();
+
     gOrchUnhealthy = false;
     WarmStart::initialize("orchagent", "swss");
     WarmStart::checkWarmStart("orchagent", "swss");
@@ -445,6 +498,18 @@ int main(int argc, char **argv)
         exit(1);
     }
 
+    if (signal(SIGUSR1, flight_recorder_signal_handler) == SIG_ERR)
+    {
+        SWSS_LOG_ERROR("failed to setup SIGUSR1 action");
+        exit(1);
+    }
+
+    if (signal(SIGUSR2, memory_accounting_signal_handler) == SIG_ERR)
+    {
+        SWSS_LOG_ERROR("failed to setup SIGUSR2 action");
+        exit(1);
+    }
+
     register_fatal_signal_handler(SIGABRT);
     register_fatal_signal_handler(SIGSEGV);
     register_fatal_signal_handler(SIGBUS);
@@ -470,7 +535,38 @@ int main(int argc, char **argv)
     // Disable SAI MACSec POST by default. Use option -M to enable it.
     bool macsec_post_enabled = false;
 
-    while ((opt = getopt(argc, argv, "b:m:r:Af:j:d:i:hsz:k:q:c:t:v:I:R:M")) != -1)
+    int ring_size = RING_SIZE;
+
+    // Executor statistics are disabled by default. Use option -E to enable them.
+    int executor_stats_interval = 0;
+
+    // Backlog statistics are disabled by default. Use option -X to enable them.
+    int orchagent_stats_interval = 0;
+
+    // Drains run to completion and doTask rounds are unbounded by default. Use options -S and -B to bound them.
+    int time_slice_msec = 0;
+    int round_budget_msec = 0;
+
+    // All Orchs are served on the main thread by default. Use option -W to enable worker threads.
+    int worker_threads = 0;
+
+    // Warm restore tables are read by each bake by default. Use option -T to preload them.
+    int bake_threads = 0;
+
+    // Warm restarts are not validated by default. Use option -V to check the restore.
+    string warm_validation_path;
+
+    // SAI capabilities are queried again on every start by default. Use option -Y to persist them.
+    string capability_cache_path;
+
+    // All tables are popped on the main thread by default. Use option -P to prefetch them.
+    set<string> prefetch_tables;
+
+    // sairedis is flushed on a fixed cadence by default. Use option -F to flush on latency and batch targets.
+    int flush_latency_msec = 0;
+    size_t flush_batch_ops = 0;
+
+    while ((opt = getopt(argc, argv, "b:m:r:AOf:j:d:i:hsz:k:q:c:t:v:I:R:ME:S:B:W:P:F:LK:N:C:G:X:T:V:D:Y:H")) != -1)
     {
         switch (opt)
         {
@@ -507,6 +603,10 @@ int main(int argc, char **argv)
             Recorder::Instance().swss.setAsync(true);
             SWSS_LOG_NOTICE("Async swss recorder enabled");
             break;
+        case 'O':
+            Recorder::Instance().swss.setBinary(true);
+            SWSS_LOG_NOTICE("Binary swss recorder enabled");
+            break;
         case 'd':
             record_location = optarg;
             if (access(record_location.c_str(), W_OK))
@@ -591,10 +691,241 @@ int main(int argc, char **argv)
             break;
         case 'R':
             gRingMode = true;
+            if (optarg)
+            {
+                auto size = atoi(optarg);
+                if (size > 1)
+                {
+                    ring_size = size;
+                    SWSS_LOG_NOTICE("Setting ring size as %d", ring_size);
+                }
+            }
             break;
          case 'M':
             macsec_post_enabled = true;
             break;
+        case 'E':
+            if (optarg)
+            {
+                auto interval = atoi(optarg);
+                if (interval > 0)
+                {
+                    executor_stats_interval = interval;
+                    ExecutorStatsRegistry::instance().setEnabled(true);
+                    SWSS_LOG_NOTICE("Enabling executor statistics, publish interval %d seconds", executor_stats_interval);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for executor statistics interval: %d. Ignoring.", interval);
+                }
+            }
+            break;
+        case 'S':
+            if (optarg)
+            {
+                auto slice = atoi(optarg);
+                if (slice > 0)
+                {
+                    time_slice_msec = slice;
+                    SWSS_LOG_NOTICE("Setting drain time slice as %d ms", time_slice_msec);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for drain time slice: %d. Ignoring.", slice);
+                }
+            }
+            break;
+        case 'B':
+            if (optarg)
+            {
+                auto budget = atoi(optarg);
+                if (budget > 0)
+                {
+                    round_budget_msec = budget;
+                    SWSS_LOG_NOTICE("Setting doTask round budget as %d ms", round_budget_msec);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for doTask round budget: %d. Ignoring.", budget);
+                }
+            }
+            break;
+        case 'W':
+            if (optarg)
+            {
+                auto threads = atoi(optarg);
+                if (threads > 0)
+                {
+                    worker_threads = threads;
+                    SWSS_LOG_NOTICE("Setting orch worker threads as %d", worker_threads);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for orch worker threads: %d. Ignoring.", threads);
+                }
+            }
+            break;
+        case 'T':
+            if (optarg)
+            {
+                auto threads = atoi(optarg);
+                if (threads > 0)
+                {
+                    bake_threads = threads;
+                    SWSS_LOG_NOTICE("Setting bake threads as %d", bake_threads);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for bake threads: %d. Ignoring.", threads);
+                }
+            }
+            break;
+        case 'V':
+            if (optarg)
+            {
+                warm_validation_path = optarg;
+                SWSS_LOG_NOTICE("Setting warm restart validation path as %s", warm_validation_path.c_str());
+            }
+            break;
+        case 'P':
+            if (optarg)
+            {
+                for (const auto &table : tokenize(optarg, ','))
+                {
+                    if (!table.empty())
+                    {
+                        prefetch_tables.insert(table);
+                        SWSS_LOG_NOTICE("Prefetching table %s", table.c_str());
+                    }
+                }
+            }
+            break;
+        case 'F':
+            if (optarg)
+            {
+                auto targets = tokenize(optarg, ',');
+                auto latency = targets.empty() ? 0 : atoi(targets[0].c_str());
+                auto batch = targets.size() > 1 ? atoi(targets[1].c_str()) : 0;
+                if (latency > 0 && batch >= 0)
+                {
+                    flush_latency_msec = latency;
+                    flush_batch_ops = static_cast<size_t>(batch);
+                    SWSS_LOG_NOTICE("Setting sairedis flush latency target as %d ms, batch target as %d ops",
+                                    flush_latency_msec, batch);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for sairedis flush targets: %s. Ignoring.", optarg);
+                }
+            }
+            break;
+        case 'H':
+            MemAccounting::setEnabled(true);
+            SWSS_LOG_NOTICE("Enabling the memory accounting of the Orch tables");
+            break;
+        case 'L':
+            AclOrch::setBulkRules(true);
+            SWSS_LOG_NOTICE("Programming ACL rules through bulk SAI calls");
+            break;
+        case 'K':
+            if (optarg)
+            {
+                auto targets = tokenize(optarg, ',');
+                auto target = targets.empty() ? 0 : atoi(targets[0].c_str());
+                auto mark = targets.size() > 1 ? atoi(targets[1].c_str()) : 0;
+                if (target >= 0 && mark >= 0)
+                {
+                    BulkerConfig::instance().chunkTargetUsec = static_cast<uint64_t>(target);
+                    BulkerConfig::instance().highWaterMark = static_cast<size_t>(mark);
+                    SWSS_LOG_NOTICE("Setting bulk call latency target as %d us, bulk high water mark as %d entries",
+                                    target, mark);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for bulk targets: %s. Ignoring.", optarg);
+                }
+            }
+            break;
+        case 'N':
+            if (optarg)
+            {
+                auto threads = atoi(optarg);
+                if (threads > 0)
+                {
+                    RouteOrch::setParseThreads(static_cast<size_t>(threads));
+                    RouteManager::setParseThreads(static_cast<size_t>(threads));
+                    SWSS_LOG_NOTICE("Setting route parse threads as %d", threads);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for route parse threads: %d. Ignoring.", threads);
+                }
+            }
+            break;
+        case 'D':
+            if (optarg)
+            {
+                auto threads = atoi(optarg);
+                if (threads > 0)
+                {
+                    DashParsePool::setThreads(static_cast<size_t>(threads));
+                    SWSS_LOG_NOTICE("Setting DASH parse threads as %d", threads);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for DASH parse threads: %d. Ignoring.", threads);
+                }
+            }
+            break;
+        case 'C':
+            if (optarg)
+            {
+                CounterSnapshotOrch::setPath(optarg);
+                SWSS_LOG_NOTICE("Setting counter snapshot path as %s", optarg);
+            }
+            break;
+        case 'G':
+            if (optarg)
+            {
+                auto kb = atoi(optarg);
+                if (kb > 0)
+                {
+                    auto bytes = static_cast<size_t>(kb) * 1024;
+                    Recorder::Instance().swss.setFlightRecorder(bytes);
+                    Recorder::Instance().respub.setFlightRecorder(bytes);
+                    Recorder::Instance().retry.setFlightRecorder(bytes);
+                    SWSS_LOG_NOTICE("Setting flight recorder size as %d KB", kb);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for flight recorder size: %d. Ignoring.", kb);
+                }
+            }
+            break;
+        case 'X':
+            if (optarg)
+            {
+                auto interval = atoi(optarg);
+                if (interval > 0)
+                {
+                    orchagent_stats_interval = interval;
+                    // The backlog gauges are kept with the executor statistics
+                    ExecutorStatsRegistry::instance().setEnabled(true);
+                    SWSS_LOG_NOTICE("Enabling orchagent statistics, publish interval %d seconds", orchagent_stats_interval);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for orchagent statistics interval: %d. Ignoring.", interval);
+                }
+            }
+            break;
+        case 'Y':
+            if (optarg)
+            {
+                capability_cache_path = optarg;
+                SWSS_LOG_NOTICE("Setting SAI capability cache path as %s", capability_cache_path.c_str());
+            }
+            break;
         default: /* '?' */
             exit(EXIT_FAILURE);
         }
@@ -602,6 +933,9 @@ int main(int argc, char **argv)
 
     SWSS_LOG_NOTICE("--- Starting Orchestration Agent ---");
 
+    /* Prefetched tables get their own DB connection when the Orchs create them */
+    Consumer::setPrefetchTables(prefetch_tables);
+
     /* Initialize sairedis recording parameters */
     Recorder::Instance().sairedis.setRecord(
         (record_type & SAIREDIS_RECORD_ENABLE) == SAIREDIS_RECORD_ENABLE
@@ -610,8 +944,14 @@ int main(int argc, char **argv)
     Recorder::Instance().sairedis.setFileName(sairedis_rec_filename);
 
     /* Initialize sairedis */
-    initSaiApi();
-    initSaiRedis();
+    {
+        BootPhase phase("initSaiApi", "sai");
+        initSaiApi();
+    }
+    {
+        BootPhase phase("initSaiRedis", "sai");
+        initSaiRedis();
+    }
     initFlexCounterTables();
 
     /* Initialize remaining recorder parameters  */
@@ -846,7 +1186,10 @@ int main(int argc, char **argv)
         }
     }
 
-    status = sai_switch_api->create_switch(&gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    {
+        BootPhase phase("create_switch", "sai");
+        status = sai_switch_api->create_switch(&gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    }
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to create a switch, rv:%d", status);
@@ -854,6 +1197,12 @@ int main(int argc, char **argv)
     }
     SWSS_LOG_NOTICE("Create a switch, id:%" PRIu64, gSwitchId);
 
+    if (!capability_cache_path.empty())
+    {
+        SaiCapabilityCache::instance().setPersistence(capability_cache_path, SaiCapabilityCache::platformSignature(),
+                                                      WarmStart::isWarmStart());
+    }
+
     if (gMySwitchType == "voq" || gMySwitchType == "fabric" || gMySwitchType == "chassis-packet" || gMySwitchType == "dpu" || create_switch_timeout)
     {
         /* Set syncd response timeout back to the default value */
@@ -1009,16 +1358,33 @@ int main(int argc, char **argv)
         orchDaemon = make_shared<FabricOrchDaemon>(&appl_db, &config_db, &state_db, chassis_db, zmq_server.get());
     }
 
+    orchDaemon->setExecutorStatsInterval(executor_stats_interval);
+    orchDaemon->setOrchAgentStatsInterval(orchagent_stats_interval);
+    orchDaemon->setSchedulerConfig(time_slice_msec, round_budget_msec);
+    orchDaemon->setWorkerThreads(worker_threads);
+    orchDaemon->setBakeThreads(bake_threads);
+    orchDaemon->setWarmValidation(warm_validation_path);
+    orchDaemon->setPrefetchDepth(static_cast<size_t>(gBatchSize) * PREFETCH_DEPTH_BATCHES);
+    orchDaemon->setFlushPolicy(flush_latency_msec, flush_batch_ops);
+
     if (gRingMode) {
         /* Initialize the ring before OrchDaemon initializing Orchs */
-        orchDaemon->enableRingBuffer();
+        orchDaemon->enableRingBuffer(ring_size);
     }
 
-    if (!orchDaemon->init())
     {
-        SWSS_LOG_ERROR("Failed to initialize orchestration daemon");
-        exit(EXIT_FAILURE);
+        BootPhase phase("OrchDaemon::init", "init");
+        if (!orchDaemon->init())
+        {
+            SWSS_LOG_ERROR("Failed to initialize orchestration daemon");
+            exit(EXIT_FAILURE);
+        }
     }
+    // Orchs constructed after the base OrchDaemon::init(), e.g. the DASH ones
+    BootTimeline::instance().addOrchConstruction(orchDaemon->getOrchList());
+
+    // The Orchs query their capabilities at init, persisted for the next warm restart
+    SaiCapabilityCache::instance().save();
 
     /*
     * In syncd view comparison solution, apply view has been sent
@@ -1037,6 +1403,8 @@ int main(int argc, char **argv)
         SWSS_LOG_NOTICE("ZMQ channel on the northbound side of Orchagent successfully bound: %s, %s", zmq_server_address.c_str(), vrf.c_str());
     }
 
+    BootTimeline::instance().finish(&state_db, record_location);
+
     orchDaemon->start(heartBeatInterval);
 
     return 0;
@@ -0,0 +1,141 @@
+#include "memaccounting.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+/* tcmalloc and jemalloc entry points, null unless one of them is linked in */
+extern "C" {
+int MallocExtension_GetNumericProperty(const char *property, size_t *value) __attribute__((weak));
+int IsHeapProfilerRunning() __attribute__((weak));
+void HeapProfilerDump(const char *reason) __attribute__((weak));
+int mallctl(const char *name, void *oldp, size_t *oldlenp, void *newp, size_t newlen) __attribute__((weak));
+}
+
+atomic<bool> MemAccounting::s_enabled{false};
+
+MemAccounting &MemAccounting::instance()
+{
+    static MemAccounting accounting;
+    return accounting;
+}
+
+void MemAccounting::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, memory_order_relaxed);
+}
+
+MemTagStats &MemAccounting::tag(const string &name)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    auto &stats = m_tags[name];
+    if (!stats)
+    {
+        stats.reset(new MemTagStats());
+    }
+    return *stats;
+}
+
+map<string, MemTagStats *> MemAccounting::getAll()
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    map<string, MemTagStats *> tags;
+    for (auto &it : m_tags)
+    {
+        tags.emplace(it.first, it.second.get());
+    }
+    return tags;
+}
+
+vector<FieldValueTuple> MemAccounting::heapStats()
+{
+    vector<FieldValueTuple> fvs;
+
+    if (MallocExtension_GetNumericProperty)
+    {
+        size_t allocated = 0;
+        size_t heap = 0;
+        MallocExtension_GetNumericProperty("generic.current_allocated_bytes", &allocated);
+        MallocExtension_GetNumericProperty("generic.heap_size", &heap);
+
+        fvs.emplace_back("allocator", "tcmalloc");
+        fvs.emplace_back("allocated_bytes", to_string(allocated));
+        fvs.emplace_back("heap_bytes", to_string(heap));
+    }
+    else if (mallctl)
+    {
+        // The statistics are cached by jemalloc until the epoch is advanced
+        uint64_t epoch = 1;
+        size_t size = sizeof(epoch);
+        mallctl("epoch", &epoch, &size, &epoch, size);
+
+        size_t allocated = 0;
+        size_t resident = 0;
+        size = sizeof(size_t);
+        mallctl("stats.allocated", &allocated, &size, nullptr, 0);
+        mallctl("stats.resident", &resident, &size, nullptr, 0);
+
+        fvs.emplace_back("allocator", "jemalloc");
+        fvs.emplace_back("allocated_bytes", to_string(allocated));
+        fvs.emplace_back("heap_bytes", to_string(resident));
+    }
+    else
+    {
+        fvs.emplace_back("allocator", "libc");
+    }
+
+    return fvs;
+}
+
+bool MemAccounting::dumpHeapProfile(const string &reason)
+{
+    SWSS_LOG_ENTER();
+
+    if (IsHeapProfilerRunning && HeapProfilerDump && IsHeapProfilerRunning())
+    {
+        HeapProfilerDump(reason.c_str());
+        SWSS_LOG_NOTICE("Dumped a tcmalloc heap profile on %s", reason.c_str());
+        return true;
+    }
+
+    // Fails unless jemalloc was started with profiling, opt.prof in MALLOC_CONF
+    if (mallctl && mallctl("prof.dump", nullptr, nullptr, nullptr, 0) == 0)
+    {
+        SWSS_LOG_NOTICE("Dumped a jemalloc heap profile on %s", reason.c_str());
+        return true;
+    }
+
+    return false;
+}
+
+void MemAccounting::dump(DBConnector *stateDb, const string &reason)
+{
+    SWSS_LOG_ENTER();
+
+    Table table(stateDb, ORCHAGENT_MEMORY_TABLE);
+
+    auto tags = getAll();
+    int64_t total = 0;
+    for (auto &it : tags)
+    {
+        auto &stats = *it.second;
+        auto bytes = stats.bytes.load(memory_order_relaxed);
+        total += bytes;
+
+        vector<FieldValueTuple> fvs;
+        fvs.emplace_back("bytes", to_string(bytes));
+        fvs.emplace_back("allocations", to_string(stats.allocations.load(memory_order_relaxed)));
+        fvs.emplace_back("deallocations", to_string(stats.deallocations.load(memory_order_relaxed)));
+        table.set(it.first, fvs);
+    }
+
+    auto fvs = heapStats();
+    fvs.emplace_back("accounted_bytes", to_string(total));
+    fvs.emplace_back("accounting", isEnabled() ? "enabled" : "disabled");
+    fvs.emplace_back("heap_profile", dumpHeapProfile(reason) ? "dumped" : "not running");
+    table.set(ORCHAGENT_MEMORY_HEAP_KEY, fvs);
+
+    SWSS_LOG_NOTICE("Published the memory accounting of %zu containers on %s", tags.size(), reason.c_str());
+}
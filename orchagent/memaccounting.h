@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dbconnector.h"
+#include "table.h"
+
+#define ORCHAGENT_MEMORY_TABLE          "ORCHAGENT_MEMORY"
+#define ORCHAGENT_MEMORY_HEAP_KEY       "HEAP"
+
+/* Bytes held by the containers of one tag, and their allocation counts */
+struct MemTagStats
+{
+    std::atomic<int64_t> bytes{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+
+    void allocate(size_t size)
+    {
+        bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void deallocate(size_t size)
+    {
+        bytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+        deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/*
+ * Process wide memory accounting of the major Orch containers.
+ *
+ * The containers are declared with MemAccountingAllocator and a tag naming
+ * the Orch and the table, "<orch>|<table>". When accounting is enabled every
+ * allocation of a tagged container is counted against its tag: the node of a
+ * map, the bucket array of a hash table, the buffer of a vector. Memory the
+ * elements own themselves, the strings of a key or the vectors of an entry,
+ * is not counted. Accounting is enabled once at startup, before the Orchs are
+ * constructed, so that every deallocation counted had its allocation counted.
+ *
+ * dump() publishes the tags to STATE_DB:ORCHAGENT_MEMORY|<tag>, along with
+ * the heap statistics of tcmalloc or jemalloc when either is linked in, and
+ * asks their heap profiler for a profile when it is running. The allocators
+ * are looked up through weak symbols, orchagent doesn't depend on them.
+ */
+class MemAccounting
+{
+public:
+    static MemAccounting &instance();
+
+    static bool isEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static void setEnabled(bool enabled);
+
+    /* Stats of the tag, created on first use and kept for the process lifetime */
+    MemTagStats &tag(const std::string &name);
+
+    std::map<std::string, MemTagStats *> getAll();
+
+    /* Fields of the heap key: the allocator found and its statistics */
+    static std::vector<swss::FieldValueTuple> heapStats();
+
+    /*
+     * Dump a heap profile with the heap profiler of tcmalloc or jemalloc,
+     * returns false if none is running.
+     */
+    static bool dumpHeapProfile(const std::string &reason);
+
+    /* Publish the tags and the heap statistics to STATE_DB */
+    void dump(swss::DBConnector *stateDb, const std::string &reason);
+
+private:
+    MemAccounting() = default;
+
+    static std::atomic<bool> s_enabled;
+
+    std::mutex m_mutex;
+    // Stats are never erased, the allocators keep references to them
+    std::map<std::string, std::unique_ptr<MemTagStats>> m_tags;
+};
+
+/* Declare a tag type for MemAccountingAllocator */
+#define MEM_ACCOUNTING_TAG(type, tagName)                 \
+    struct type                                           \
+    {                                                     \
+        static const char *name() { return tagName; }     \
+    }
+
+/*
+ * std::allocator counting against the stats of Tag when accounting is enabled.
+ * The allocator is stateless, containers keep their size and are swappable
+ * with any container of the same tag.
+ */
+template <typename T, typename Tag>
+class MemAccountingAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = MemAccountingAllocator<U, Tag>;
+    };
+
+    MemAccountingAllocator() noexcept = default;
+
+    template <typename U>
+    MemAccountingAllocator(const MemAccountingAllocator<U, Tag> &) noexcept
+    {
+    }
+
+    T *allocate(size_t n)
+    {
+        T *p = std::allocator<T>().allocate(n);
+        if (MemAccounting::isEnabled())
+        {
+            stats().allocate(n * sizeof(T));
+        }
+        return p;
+    }
+
+    void deallocate(T *p, size_t n) noexcept
+    {
+        if (MemAccounting::isEnabled())
+        {
+            stats().deallocate(n * sizeof(T));
+        }
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    static MemTagStats &stats()
+    {
+        static MemTagStats &s = MemAccounting::instance().tag(Tag::name());
+        return s;
+    }
+};
+
+template <typename T, typename U, typename Tag>
+bool operator==(const MemAccountingAllocator<T, Tag> &, const MemAccountingAllocator<U, Tag> &) noexcept
+{
+    return true;
+}
+
+template <typename T, typename U, typename Tag>
+bool operator!=(const MemAccountingAllocator<T, Tag> &, const MemAccountingAllocator<U, Tag> &) noexcept
+{
+    return false;
+}
@@ -91,8 +91,8 @@ MirrorOrch::MirrorOrch(TableConnector stateDbConnector, TableConnector confDbCon
     sai_attribute_t attr;
 
     m_portsOrch->attach(this);
-    m_neighOrch->attach(this);
-    m_fdbOrch->attach(this);
+    m_neighOrch->getNeighborEvents().subscribe(this);
+    m_fdbOrch->getFdbEvents().subscribe(this);
 
     // Retrieve the number of valid values for queue, starting at 0
     attr.id = SAI_SWITCH_ATTR_QOS_MAX_NUMBER_OF_TRAFFIC_CLASSES;
@@ -170,18 +170,6 @@ void MirrorOrch::update(SubjectType type, void *cntx)
         updateNextHop(*update);
         break;
     }
-    case SUBJECT_TYPE_NEIGH_CHANGE:
-    {
-        NeighborUpdate *update = static_cast<NeighborUpdate *>(cntx);
-        updateNeighbor(*update);
-        break;
-    }
-    case SUBJECT_TYPE_FDB_CHANGE:
-    {
-        FdbUpdate *update = static_cast<FdbUpdate *>(cntx);
-        updateFdb(*update);
-        break;
-    }
     case SUBJECT_TYPE_LAG_MEMBER_CHANGE:
     {
         LagMemberUpdate *update = static_cast<LagMemberUpdate *>(cntx);
@@ -504,6 +492,7 @@ task_process_status MirrorOrch::createEntry(const string& key, const vector<Fiel
     }
 
     m_syncdMirrors.emplace(key, entry);
+    indexSession(key, entry);
     setSessionState(key, entry);
 
     if (entry.type == MIRROR_SESSION_SPAN && !entry.dst_port.empty())
@@ -644,6 +633,33 @@ void MirrorOrch::removeSessionState(const string& name)
 	m_mirrorTable.del(name);
 }
 
+void MirrorOrch::indexSession(const string& name, const MirrorEntry& session)
+{
+    m_ipSessions[session.dstIp].insert(name);
+    if (!session.nexthopInfo.nexthop.ip_address.isZero())
+    {
+        m_ipSessions[session.nexthopInfo.nexthop.ip_address].insert(name);
+    }
+
+    if (!session.neighborInfo.port.m_alias.empty())
+    {
+        m_neighborPortSessions[session.neighborInfo.port.m_alias].insert(name);
+    }
+
+    if (session.neighborInfo.port.m_type == Port::VLAN)
+    {
+        m_fdbSessions[{ session.neighborInfo.port.m_vlan_info.vlan_oid, session.neighborInfo.mac }].insert(name);
+    }
+
+    if (!session.src_port.empty())
+    {
+        for (const auto& port : tokenize(session.src_port, ','))
+        {
+            m_srcPortSessions[port].insert(name);
+        }
+    }
+}
+
 bool MirrorOrch::getNeighborInfo(const string& name, MirrorEntry& session)
 {
     SWSS_LOG_ENTER();
@@ -668,6 +684,7 @@ bool MirrorOrch::getNeighborInfo(const string& name, MirrorEntry& session)
     // Get mirror session monitor port information
     m_portsOrch->getPort(session.neighborInfo.neighbor.alias,
             session.neighborInfo.port);
+    indexSession(name, session);
 
     switch (session.neighborInfo.port.m_type)
     {
@@ -1294,10 +1311,13 @@ void MirrorOrch::updateNextHop(const NextHopUpdate& update)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_syncdMirrors.begin(); it != m_syncdMirrors.end(); it++)
+    auto names = findSessions(m_ipSessions, update.destination, [&update](const MirrorEntry& session) {
+        return session.dstIp == update.destination || session.nexthopInfo.nexthop.ip_address == update.destination;
+    });
+
+    for (const auto& name : names)
     {
-        const auto& name = it->first;
-        auto& session = it->second;
+        auto& session = m_syncdMirrors.at(name);
 
         // Check if mirror session's destination IP is the update's destination IP
         if (session.dstIp != update.destination)
@@ -1359,6 +1379,8 @@ void MirrorOrch::updateNextHop(const NextHopUpdate& update)
             session.nexthopInfo.nexthop = session.dstIp.isV4() ? NextHopKey("0.0.0.0", alias) : NextHopKey("::", alias);
         }
 
+        indexSession(name, session);
+
         // Update State DB Nexthop
         setSessionState(name, session, MIRROR_SESSION_NEXT_HOP_IP);
 
@@ -1371,16 +1393,34 @@ void MirrorOrch::updateNextHop(const NextHopUpdate& update)
     }
 }
 
-// The function is called when SUBJECT_TYPE_NEIGH_CHANGE is received.
+// The neighbor changes are received batched from NeighOrch, a session
+// depending on several of them is only updated once.
+void MirrorOrch::onEvents(const vector<NeighborUpdate>& updates)
+{
+    SWSS_LOG_ENTER();
+
+    set<string> updated;
+    for (const auto& update : updates)
+    {
+        updateNeighbor(update, updated);
+    }
+}
+
+// The function is called for each neighbor change of a batch.
 // This function will handle the case when the neighbor is created or removed.
-void MirrorOrch::updateNeighbor(const NeighborUpdate& update)
+// The sessions updated are added to updated and skipped afterwards.
+void MirrorOrch::updateNeighbor(const NeighborUpdate& update, set<string>& updated)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_syncdMirrors.begin(); it != m_syncdMirrors.end(); it++)
+    const auto& ip = update.entry.ip_address;
+    auto names = findSessions(m_ipSessions, ip, [&ip](const MirrorEntry& session) {
+        return session.dstIp == ip || session.nexthopInfo.nexthop.ip_address == ip;
+    });
+
+    for (const auto& name : names)
     {
-        const auto& name = it->first;
-        auto& session = it->second;
+        auto& session = m_syncdMirrors.at(name);
 
         // Check if the session's destination IP matches the neighbor's update IP
         // or if the session's next hop IP matches the neighbor's update IP
@@ -1390,6 +1430,12 @@ void MirrorOrch::updateNeighbor(const NeighborUpdate& update)
             continue;
         }
 
+        // The session resolves its neighbor again, once is enough for the batch
+        if (!updated.insert(name).second)
+        {
+            continue;
+        }
+
         SWSS_LOG_NOTICE("Updating mirror session %s with neighbor %s",
                 name.c_str(), update.entry.alias.c_str());
 
@@ -1397,7 +1443,18 @@ void MirrorOrch::updateNeighbor(const NeighborUpdate& update)
     }
 }
 
-// The function is called when SUBJECT_TYPE_FDB_CHANGE is received.
+// The FDB changes are received batched from FdbOrch, at most one per MAC
+void MirrorOrch::onEvents(const vector<FdbUpdate>& updates)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto& update : updates)
+    {
+        updateFdb(update);
+    }
+}
+
+// The function is called for each FDB change of a batch.
 // This function will handle the case when new FDB entry is learned/added in the VLAN,
 // or when the old FDB entry gets removed. Only when the neighbor is VLAN will the case
 // be handled.
@@ -1405,10 +1462,15 @@ void MirrorOrch::updateFdb(const FdbUpdate& update)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_syncdMirrors.begin(); it != m_syncdMirrors.end(); it++)
+    auto names = findSessions(m_fdbSessions, make_pair(update.entry.bv_id, update.entry.mac), [&update](const MirrorEntry& session) {
+        return session.neighborInfo.port.m_type == Port::VLAN &&
+                session.neighborInfo.port.m_vlan_info.vlan_oid == update.entry.bv_id &&
+                session.neighborInfo.mac == update.entry.mac;
+    });
+
+    for (const auto& name : names)
     {
-        const auto& name = it->first;
-        auto& session = it->second;
+        auto& session = m_syncdMirrors.at(name);
 
         // Check the following three conditions:
         // 1) mirror session is pointing to a VLAN
@@ -1456,10 +1518,20 @@ void MirrorOrch::updateLagMember(const LagMemberUpdate& update)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_syncdMirrors.begin(); it != m_syncdMirrors.end(); it++)
+    const auto& lag = update.lag.m_alias;
+    auto sources = findSessions(m_srcPortSessions, lag, [&lag](const MirrorEntry& session) {
+        return session.src_port.find(lag.c_str()) != std::string::npos;
+    });
+    auto neighbors = findSessions(m_neighborPortSessions, lag, [&lag](const MirrorEntry& session) {
+        return session.neighborInfo.port.m_alias == lag;
+    });
+
+    set<string> names(sources.begin(), sources.end());
+    names.insert(neighbors.begin(), neighbors.end());
+
+    for (const auto& name : names)
     {
-        const auto& name = it->first;
-        auto& session = it->second;
+        auto& session = m_syncdMirrors.at(name);
 
         // Check the following conditions:
         // 1) Session is active
@@ -1542,10 +1614,14 @@ void MirrorOrch::updateVlanMember(const VlanMemberUpdate& update)
         return;
     }
 
-    for (auto it = m_syncdMirrors.begin(); it != m_syncdMirrors.end(); it++)
+    const auto& vlan = update.vlan.m_alias;
+    auto names = findSessions(m_neighborPortSessions, vlan, [&vlan](const MirrorEntry& session) {
+        return session.neighborInfo.port.m_alias == vlan;
+    });
+
+    for (const auto& name : names)
     {
-        const auto& name = it->first;
-        auto& session = it->second;
+        auto& session = m_syncdMirrors.at(name);
 
         // Check the following three conditions:
         // 1) mirror session is pointing to a VLAN
@@ -15,7 +15,10 @@
 
 #include "table.h"
 
+#include <functional>
 #include <map>
+#include <set>
+#include <vector>
 #include <inttypes.h>
 
 #define MIRROR_RX_DIRECTION      "RX"
@@ -73,7 +76,8 @@ struct MirrorSessionUpdate
 /* MirrorTable: mirror session name, mirror session data */
 typedef map<string, MirrorEntry> MirrorTable;
 
-class MirrorOrch : public Orch, public Observer, public Subject
+class MirrorOrch : public Orch, public Observer, public Subject, public EventSubscriber<NeighborUpdate>,
+                   public EventSubscriber<FdbUpdate>
 {
 public:
     MirrorOrch(TableConnector appDbConnector, TableConnector confDbConnector,
@@ -81,6 +85,8 @@ public:
 
     bool bake() override;
     void update(SubjectType, void *);
+    void onEvents(const vector<NeighborUpdate>&) override;
+    void onEvents(const vector<FdbUpdate>&) override;
     bool sessionExists(const string&);
     bool getSessionStatus(const string&, bool&);
     bool getSessionOid(const string&, sai_object_id_t&);
@@ -102,6 +108,17 @@ private:
     Table m_mirrorTable;
 
     MirrorTable m_syncdMirrors;
+
+    /*
+     * Session names by what the observed updates are about: destination and
+     * next hop IPs, the neighbor port, the VLAN and MAC of a VLAN neighbor, and
+     * the source ports. Keys are added as sessions resolve, names that no
+     * longer match are dropped on lookup.
+     */
+    map<IpAddress, set<string>> m_ipSessions;
+    map<string, set<string>> m_neighborPortSessions;
+    map<pair<sai_object_id_t, MacAddress>, set<string>> m_fdbSessions;
+    map<string, set<string>> m_srcPortSessions;
     // session_name -> VLAN | monitor_port_alias | next_hop_ip
     map<string, string> m_recoverySessionMap;
 
@@ -126,8 +143,42 @@ private:
 
     bool getNeighborInfo(const string&, MirrorEntry&);
 
+    void indexSession(const string&, const MirrorEntry&);
+
+    template <typename K>
+    vector<string> findSessions(map<K, set<string>>& index, const K& key,
+                                const std::function<bool(const MirrorEntry&)>& matches)
+    {
+        vector<string> names;
+
+        auto it = index.find(key);
+        if (it == index.end())
+        {
+            return names;
+        }
+
+        for (auto name = it->second.begin(); name != it->second.end();)
+        {
+            auto session = m_syncdMirrors.find(*name);
+            if (session == m_syncdMirrors.end() || !matches(session->second))
+            {
+                name = it->second.erase(name);
+                continue;
+            }
+            names.push_back(*name);
+            name++;
+        }
+
+        if (it->second.empty())
+        {
+            index.erase(it);
+        }
+
+        return names;
+    }
+
     void updateNextHop(const NextHopUpdate&);
-    void updateNeighbor(const NeighborUpdate&);
+    void updateNeighbor(const NeighborUpdate&, set<string>&);
     void updateFdb(const FdbUpdate&);
     void updateLagMember(const LagMemberUpdate&);
     void updateVlanMember(const VlanMemberUpdate&);
@@ -17,10 +17,93 @@ extern CrmOrch *gCrmOrch;
 extern NhgOrch *gNhgOrch;
 extern CbfNhgOrch *gCbfNhgOrch;
 
+/*
+ * Create in one bulk the labeled next hops the pending label routes point to
+ * and which are missing while their IP neighbor is resolved. The routes then
+ * find them, a next hop the bulk did not create is created by its route.
+ */
+void RouteOrch::addLabelRouteNextHops(ConsumerBase& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_resync)
+    {
+        return;
+    }
+
+    set<NextHopKey> nexthops;
+    for (const auto& task : consumer.m_toSync)
+    {
+        const KeyOpFieldsValuesTuple& t = task.second;
+        if (kfvOp(t) != SET_COMMAND)
+        {
+            continue;
+        }
+
+        string ips;
+        string aliases;
+        string mpls_nhs;
+
+        for (const auto& i : kfvFieldsValues(t))
+        {
+            if (fvField(i) == "nexthop")
+                ips = fvValue(i);
+
+            if (fvField(i) == "ifname")
+                aliases = fvValue(i);
+
+            if (fvField(i) == "mpls_nh")
+                mpls_nhs = fvValue(i);
+        }
+
+        vector<string> ipv = tokenize(ips, ',');
+        vector<string> alsv = tokenize(aliases, ',');
+        vector<string> mpls_nhv = tokenize(mpls_nhs, ',');
+
+        for (size_t i = 0; i < min({ ipv.size(), alsv.size(), mpls_nhv.size() }); i++)
+        {
+            if (mpls_nhv[i] == "na")
+            {
+                continue;
+            }
+
+            try
+            {
+                NextHopKey nexthop(mpls_nhv[i] + LABELSTACK_DELIMITER + ipv[i] + NH_DELIMITER + alsv[i]);
+                if (nexthop.isMplsNextHop() && !m_neighOrch->hasNextHop(nexthop) &&
+                    m_neighOrch->isNeighborResolved(nexthop))
+                {
+                    nexthops.insert(nexthop);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                /* Reported when the route is processed */
+                continue;
+            }
+        }
+    }
+
+    if (nexthops.empty())
+    {
+        return;
+    }
+
+    std::list<NeighborContext> bulk_ctx_list;
+    for (const auto& nexthop : nexthops)
+    {
+        bulk_ctx_list.emplace_back(nexthop);
+    }
+
+    m_neighOrch->addNextHops(bulk_ctx_list);
+}
+
 void RouteOrch::doLabelTask(ConsumerBase& consumer)
 {
     SWSS_LOG_ENTER();
 
+    addLabelRouteNextHops(consumer);
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -565,9 +648,9 @@ bool RouteOrch::addLabelRoute(LabelRouteBulkContext& ctx, const NextHopGroupKey
                 /* If the current next hop is part of the next hop group to sync,
                  * then return false and no need to add another temporary route. */
                 if (it_route != m_syncdLabelRoutes.at(vrf_id).end() &&
-                    it_route->second.nhg_key.getSize() == 1)
+                    it_route->second.nhg_key->getSize() == 1)
                 {
-                    const NextHopKey& nexthop = *it_route->second.nhg_key.getNextHops().begin();
+                    const NextHopKey& nexthop = *it_route->second.nhg_key->getNextHops().begin();
                     if (nextHops.contains(nexthop))
                     {
                         return false;
@@ -635,7 +718,7 @@ bool RouteOrch::addLabelRoute(LabelRouteBulkContext& ctx, const NextHopGroupKey
     else
     {
         /* Set the packet action to forward when there was no next hop (dropped) */
-        if (it_route->second.nhg_key.getSize() == 0 && !blackhole)
+        if (it_route->second.nhg_key->getSize() == 0 && !blackhole)
         {
             inseg_attr.id = SAI_INSEG_ENTRY_ATTR_PACKET_ACTION;
             inseg_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
@@ -771,7 +854,7 @@ bool RouteOrch::addLabelRoutePost(const LabelRouteBulkContext& ctx, const NextHo
         sai_status_t status;
 
         /* Set the packet action to forward when there was no next hop (dropped) and not pointing to blackhole */
-        if (it_route->second.nhg_key.getSize() == 0 && !blackhole)
+        if (it_route->second.nhg_key->getSize() == 0 && !blackhole)
         {
             status = *it_status++;
             if (status != SAI_STATUS_SUCCESS)
@@ -802,7 +885,7 @@ bool RouteOrch::addLabelRoutePost(const LabelRouteBulkContext& ctx, const NextHo
         if (it_route->second.nhg_index.empty())
         {
             decreaseNextHopRefCount(it_route->second.nhg_key);
-            if (it_route->second.nhg_key.getSize() > 1
+            if (it_route->second.nhg_key->getSize() > 1
                 && m_syncdNextHopGroups[it_route->second.nhg_key].ref_count == 0)
             {
                 m_bulkNhgReducedRefCnt.emplace(it_route->second.nhg_key, 0);
@@ -922,7 +1005,7 @@ bool RouteOrch::removeLabelRoutePost(const LabelRouteBulkContext& ctx)
          * Decrease the reference count only when the route is pointing to a next hop.
          */
         decreaseNextHopRefCount(it_route->second.nhg_key);
-        if (it_route->second.nhg_key.getSize() > 1
+        if (it_route->second.nhg_key->getSize() > 1
             && m_syncdNextHopGroups[it_route->second.nhg_key].ref_count == 0)
         {
             m_bulkNhgReducedRefCnt.emplace(it_route->second.nhg_key, 0);
@@ -931,9 +1014,9 @@ bool RouteOrch::removeLabelRoutePost(const LabelRouteBulkContext& ctx)
          * Additionally check if the NH has label and its ref count == 0, then
          * remove the label next hop.
          */
-        else if (it_route->second.nhg_key.getSize() == 1)
+        else if (it_route->second.nhg_key->getSize() == 1)
         {
-            const NextHopKey& nexthop = *it_route->second.nhg_key.getNextHops().begin();
+            const NextHopKey& nexthop = *it_route->second.nhg_key->getNextHops().begin();
             if (nexthop.isMplsNextHop() &&
                 (m_neighOrch->getNextHopRefCount(nexthop) == 0))
             {
@@ -947,7 +1030,7 @@ bool RouteOrch::removeLabelRoutePost(const LabelRouteBulkContext& ctx)
     }
 
     SWSS_LOG_INFO("Remove label route %u with next hop(s) %s",
-                  label, it_route->second.nhg_key.to_string().c_str());
+                  label, it_route->second.nhg_key->to_string().c_str());
 
     it_route_table->second.erase(label);
 
@@ -7,6 +7,7 @@
 #include <inttypes.h>
 #include <math.h>
 #include <chrono>
+#include <functional>
 #include <time.h>
 
 #include "sai.h"
@@ -563,6 +564,126 @@ void MuxCable::setState(string new_state)
     return;
 }
 
+bool MuxCable::canBatchState(const string& new_state) const
+{
+    auto ns = muxStateStringToVal.find(new_state);
+    if (!nbr_handler_->isBatchable() || ns == muxStateStringToVal.end())
+    {
+        return false;
+    }
+
+    return muxStateTransition.find(make_pair(state_, ns->second)) != muxStateTransition.end();
+}
+
+bool MuxCable::beginState(const string& new_state, MuxToggleBatch& batch)
+{
+    MuxState ns = muxStateStringToVal.at(new_state);
+
+    SWSS_LOG_NOTICE("[%s] Set MUX state from %s to %s in batch", mux_name_.c_str(),
+                     muxStateValToString.at(state_).c_str(), new_state.c_str());
+
+    batch_change_ = muxStateTransition.at(make_pair(state_, ns));
+
+    mux_cb_orch_->updateMuxMetricState(mux_name_, new_state, true);
+
+    prev_state_ = state_;
+    state_ = ns;
+
+    st_chg_in_progress_ = true;
+
+    Port port;
+    if (batch_change_ != MUX_STATE_INIT_ACTIVE && !gPortsOrch->getPort(mux_name_, port))
+    {
+        SWSS_LOG_NOTICE("Port %s not found in port table", mux_name_.c_str());
+        return false;
+    }
+
+    std::list<NeighborContext> neigh_ctx_list;
+    std::list<MuxRouteBulkContext> route_ctx_list;
+
+    if (state_ == MuxState::MUX_STATE_ACTIVE)
+    {
+        if (batch_change_ == MUX_STATE_STANDBY_ACTIVE && !aclHandler(port.m_port_id, mux_name_, false))
+        {
+            SWSS_LOG_INFO("Remove ACL drop rule failed for %s", mux_name_.c_str());
+            return false;
+        }
+    }
+    else
+    {
+        sai_object_id_t tnh = mux_orch_->createNextHopTunnel(MUX_TUNNEL, peer_ip4_);
+        if (tnh == SAI_NULL_OBJECT_ID)
+        {
+            SWSS_LOG_INFO("Null NH object id, retry for %s", peer_ip4_.to_string().c_str());
+            return false;
+        }
+        // Loop through all routes with nexthops through this mux cable when changing state
+        updateRoutes();
+        if (!nbr_handler_->disableNextHops(tnh, route_ctx_list))
+        {
+            return false;
+        }
+    }
+
+    nbr_handler_->getNeighborContexts(neigh_ctx_list);
+
+    batch.neigh_ctx_list.splice(batch.neigh_ctx_list.end(), neigh_ctx_list);
+    batch.route_ctx_list.splice(batch.route_ctx_list.end(), route_ctx_list);
+
+    return true;
+}
+
+bool MuxCable::continueState(MuxToggleBatch& batch)
+{
+    std::list<MuxRouteBulkContext> route_ctx_list;
+
+    if (!nbr_handler_->enableNextHops(batch_change_ != MUX_STATE_INIT_ACTIVE, route_ctx_list))
+    {
+        return false;
+    }
+
+    batch.route_ctx_list.splice(batch.route_ctx_list.end(), route_ctx_list);
+
+    return true;
+}
+
+bool MuxCable::endState(bool success)
+{
+    if (success && state_ == MuxState::MUX_STATE_ACTIVE)
+    {
+        // Loop through all routes with nexthops through this mux cable when changing state
+        updateRoutes();
+    }
+    else if (success)
+    {
+        Port port;
+        if (!gPortsOrch->getPort(mux_name_, port) || !aclHandler(port.m_port_id, mux_name_))
+        {
+            SWSS_LOG_INFO("Add ACL drop rule failed for %s", mux_name_.c_str());
+            success = false;
+        }
+    }
+
+    if (!success)
+    {
+        //Reset back to original state
+        state_ = prev_state_;
+        st_chg_in_progress_ = false;
+        st_chg_failed_ = true;
+        return false;
+    }
+
+    string new_state = muxStateValToString.at(state_);
+    mux_cb_orch_->updateMuxMetricState(mux_name_, new_state, false);
+
+    st_chg_in_progress_ = false;
+    st_chg_failed_ = false;
+    SWSS_LOG_INFO("Changed state to %s", new_state.c_str());
+
+    mux_cb_orch_->updateMuxState(mux_name_, new_state);
+    return true;
+}
+
 void MuxCable::rollbackStateChange()
 {
     if (prev_state_ == MuxState::MUX_STATE_FAILED || prev_state_ == MuxState::MUX_STATE_PENDING)
@@ -795,44 +916,104 @@ void MuxNbrHandler::update(NextHopKey nh, sai_object_id_t tunnelId, bool add, Mu
 
 bool MuxNbrHandler::enable(bool update_rt)
 {
-    NeighborEntry neigh;
     std::list<NeighborContext> neigh_ctx_list;
     std::list<MuxRouteBulkContext> route_ctx_list;
 
-    auto it = neighbors_.begin();
-    while (it != neighbors_.end())
+    getNeighborContexts(neigh_ctx_list);
+
+    if (!gNeighOrch->enableNeighbors(neigh_ctx_list))
     {
-        SWSS_LOG_INFO("Enabling neigh %s on %s", it->first.to_string().c_str(), alias_.c_str());
+        return false;
+    }
 
-        neigh = NeighborEntry(it->first, alias_);
-        // Create neighbor context with bulk_op enabled
-        neigh_ctx_list.push_back(NeighborContext(neigh, true));
-        it++;
+    if (!enableNextHops(update_rt, route_ctx_list))
+    {
+        return false;
     }
 
-    if (!gNeighOrch->enableNeighbors(neigh_ctx_list))
+    if (update_rt && !removeRoutes(route_ctx_list))
     {
         return false;
     }
 
-    it = neighbors_.begin();
-    while (it != neighbors_.end())
+    return true;
+}
+
+bool MuxNbrHandler::disable(sai_object_id_t tnh)
+{
+    std::list<NeighborContext> neigh_ctx_list;
+    std::list<MuxRouteBulkContext> route_ctx_list;
+
+    if (!disableNextHops(tnh, route_ctx_list))
     {
+        return false;
+    }
+
+    getNeighborContexts(neigh_ctx_list);
+
+    if (!addRoutes(route_ctx_list))
+    {
+        return false;
+    }
+
+    if (!gNeighOrch->disableNeighbors(neigh_ctx_list))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void MuxNbrHandler::getNeighborContexts(std::list<NeighborContext>& neigh_ctx_list)
+{
+    for (auto it = neighbors_.begin(); it != neighbors_.end(); it++)
+    {
+        NeighborEntry neigh = NeighborEntry(it->first, alias_);
+        // Create neighbor context with bulk_op enabled
+        neigh_ctx_list.push_back(NeighborContext(neigh, true));
+    }
+}
+
+/**
+ * @brief Points the neighbors' routes and nexthop groups at the enabled neighbors,
+ *        the neighbors must be enabled in NeighOrch first
+ * @param update_rt Collect the tunnel routes of the neighbors for removal
+ * @param route_ctx_list Tunnel routes to remove
+ * @return true on success, false on failure
+ */
+bool MuxNbrHandler::enableNextHops(bool update_rt, std::list<MuxRouteBulkContext>& route_ctx_list)
+{
+    NeighborEntry neigh;
+
+    for (auto it = neighbors_.begin(); it != neighbors_.end(); it++)
+    {
+        SWSS_LOG_INFO("Enabling neigh %s on %s", it->first.to_string().c_str(), alias_.c_str());
+
         /* Update NH to point to learned neighbor */
         neigh = NeighborEntry(it->first, alias_);
         it->second = gNeighOrch->getLocalNextHopId(neigh);
+    }
 
-        /* Reprogram route */
-        NextHopKey nh_key = NextHopKey(it->first, alias_);
-        uint32_t num_routes = 0;
-        if (!gRouteOrch->updateNextHopRoutes(nh_key, num_routes))
-        {
-            SWSS_LOG_INFO("Update route failed for NH %s", nh_key.ip_address.to_string().c_str());
-            return false;
-        }
+    /* Reprogram the routes of all the neighbors */
+    std::vector<uint32_t> num_routes;
+    bool routes_updated = updateNextHopRoutes(num_routes);
+
+    /* Increment ref count for new NHs, also when the update failed */
+    size_t i = 0;
+    for (auto it = neighbors_.begin(); it != neighbors_.end(); it++)
+    {
+        gNeighOrch->increaseNextHopRefCount(NextHopKey(it->first, alias_), num_routes[i++]);
+    }
+
+    if (!routes_updated)
+    {
+        return false;
+    }
 
-        /* Increment ref count for new NHs */
-        gNeighOrch->increaseNextHopRefCount(nh_key, num_routes);
+    auto it = neighbors_.begin();
+    while (it != neighbors_.end())
+    {
+        NextHopKey nh_key = NextHopKey(it->first, alias_);
 
         /*
          * Invalidate current nexthop group and update with new NH
@@ -864,39 +1045,46 @@ bool MuxNbrHandler::enable(bool update_rt)
         it++;
     }
 
-    if (update_rt && !removeRoutes(route_ctx_list))
-    {
-        return false;
-    }
-
     return true;
 }
 
-bool MuxNbrHandler::disable(sai_object_id_t tnh)
+/**
+ * @brief Points the neighbors' routes and nexthop groups at the tunnel nexthop,
+ *        the neighbors are disabled in NeighOrch after the tunnel routes are added
+ * @param tnh Tunnel nexthop
+ * @param route_ctx_list Tunnel routes to add
+ * @return true on success, false on failure
+ */
+bool MuxNbrHandler::disableNextHops(sai_object_id_t tnh, std::list<MuxRouteBulkContext>& route_ctx_list)
 {
-    NeighborEntry neigh;
-    std::list<NeighborContext> neigh_ctx_list;
-    std::list<MuxRouteBulkContext> route_ctx_list;
-
-    auto it = neighbors_.begin();
-    while (it != neighbors_.end())
+    for (auto it = neighbors_.begin(); it != neighbors_.end(); it++)
     {
         SWSS_LOG_INFO("Disabling neigh %s on %s", it->first.to_string().c_str(), alias_.c_str());
 
         /* Update NH to point to Tunnel nexhtop */
         it->second = tnh;
+    }
 
-        /* Reprogram route */
-        NextHopKey nh_key = NextHopKey(it->first, alias_);
-        uint32_t num_routes = 0;
-        if (!gRouteOrch->updateNextHopRoutes(nh_key, num_routes))
-        {
-            SWSS_LOG_INFO("Update route failed for NH %s", nh_key.ip_address.to_string().c_str());
-            return false;
-        }
+    /* Reprogram the routes of all the neighbors */
+    std::vector<uint32_t> num_routes;
+    bool routes_updated = updateNextHopRoutes(num_routes);
 
-        /* Decrement ref count for old NHs */
-        gNeighOrch->decreaseNextHopRefCount(nh_key, num_routes);
+    /* Decrement ref count for old NHs, also when the update failed */
+    size_t i = 0;
+    for (auto it = neighbors_.begin(); it != neighbors_.end(); it++)
+    {
+        gNeighOrch->decreaseNextHopRefCount(NextHopKey(it->first, alias_), num_routes[i++]);
+    }
+
+    if (!routes_updated)
+    {
+        return false;
+    }
+
+    auto it = neighbors_.begin();
+    while (it != neighbors_.end())
+    {
+        NextHopKey nh_key = NextHopKey(it->first, alias_);
 
         /* Invalidate current nexthop group and update with new NH */
         uint32_t nh_removed, nh_added;
@@ -920,23 +1108,9 @@ bool MuxNbrHandler::disable(sai_object_id_t tnh)
         IpPrefix pfx = it->first.to_string();
         route_ctx_list.push_back(MuxRouteBulkContext(pfx, it->second));
 
-        neigh = NeighborEntry(it->first, alias_);
-        // Create neighbor context with bulk_op enabled
-        neigh_ctx_list.push_back(NeighborContext(neigh, true));
-
         it++;
     }
 
-    if (!addRoutes(route_ctx_list))
-    {
-        return false;
-    }
-
-    if (!gNeighOrch->disableNeighbors(neigh_ctx_list))
-    {
-        return false;
-    }
-
     return true;
 }
 
@@ -951,6 +1125,42 @@ sai_object_id_t MuxNbrHandler::getNextHopId(const NextHopKey nhKey)
     return SAI_NULL_OBJECT_ID;
 }
 
+/**
+ * @brief Reprograms the routes through every neighbor of the handler in one
+ *        route bulk, each neighbor's NH must already be updated
+ * @param num_routes Number of routes to move the NH ref counts for, per neighbor
+ *        in neighbors_ order
+ * @return true on success, false on failure
+ */
+bool MuxNbrHandler::updateNextHopRoutes(std::vector<uint32_t>& num_routes)
+{
+    std::vector<NextHopKey> nh_keys;
+    nh_keys.reserve(neighbors_.size());
+    for (const auto& neighbor : neighbors_)
+    {
+        nh_keys.push_back(NextHopKey(neighbor.first, alias_));
+    }
+
+    std::vector<uint32_t> num_failed;
+    if (!gRouteOrch->updateNextHopRoutes(nh_keys, num_routes, num_failed))
+    {
+        SWSS_LOG_INFO("Update route failed for NHs on %s", alias_.c_str());
+
+        /*
+         * A failed toggle is rolled back, which points every route back at
+         * the previous NH and moves its ref count again, so the routes that
+         * failed are counted as if they had moved
+         */
+        for (size_t i = 0; i < num_routes.size(); i++)
+        {
+            num_routes[i] += num_failed[i];
+        }
+        return false;
+    }
+
+    return true;
+}
+
 bool MuxNbrHandler::addRoutes(std::list<MuxRouteBulkContext>& bulk_ctx_list)
 {
     sai_status_t status;
@@ -1271,27 +1481,28 @@ bool MuxPrefixBasedNbrHandler::enable(bool update_rt)
         return false;
     }
 
-    it = neighbors_.begin();
-    while (it != neighbors_.end())
-    {
-        neigh = NeighborEntry(it->first, alias_);
-        /* Update NH to point to learned neighbor */
-        it->second = gNeighOrch->getLocalNextHopId(neigh);
+    /* Reprogram the routes of all the neighbors */
+    std::vector<uint32_t> num_routes;
+    bool routes_updated = updateNextHopRoutes(num_routes);
 
-        /* Reprogram route */
+    /* Increment ref count for new NHs, also when the update failed */
+    size_t i = 0;
+    for (it = neighbors_.begin(); it != neighbors_.end(); it++)
+    {
         NextHopKey nh_key = NextHopKey(it->first, alias_);
+        SWSS_LOG_INFO("Update route for NH %s num_route: %u", nh_key.ip_address.to_string().c_str(), num_routes[i]);
+        gNeighOrch->increaseNextHopRefCount(nh_key, num_routes[i++]);
+    }
 
-        uint32_t num_routes = 0;
-        if (!gRouteOrch->updateNextHopRoutes(nh_key, num_routes))
-        {
-            SWSS_LOG_INFO("Update route failed for NH %s", nh_key.ip_address.to_string().c_str());
-            return false;
-        }
-        SWSS_LOG_INFO("Update route for NH %s num_route: %u", nh_key.ip_address.to_string().c_str(), num_routes);
-
-        /* Increment ref count for new NHs */
-        gNeighOrch->increaseNextHopRefCount(nh_key, num_routes);
+    if (!routes_updated)
+    {
+        return false;
+    }
 
+    it = neighbors_.begin();
+    while (it != neighbors_.end())
+    {
+        NextHopKey nh_key = NextHopKey(it->first, alias_);
         uint32_t nh_added;
         // We do not need to remove tunnel nh as it was not added in the ECMP group.
         // Just add the active nbr nh.
@@ -1343,21 +1554,28 @@ bool MuxPrefixBasedNbrHandler::disable(sai_object_id_t tnh)
         return false;
     }
 
-    it = neighbors_.begin();
-    while (it != neighbors_.end())
+    /* Reprogram the routes of all the neighbors */
+    std::vector<uint32_t> num_routes;
+    bool routes_updated = updateNextHopRoutes(num_routes);
+
+    /* Decrement ref count for old NHs, also when the update failed */
+    size_t i = 0;
+    for (it = neighbors_.begin(); it != neighbors_.end(); it++)
     {
         NextHopKey nh_key = NextHopKey(it->first, alias_);
-        uint32_t num_routes = 0;
+        SWSS_LOG_INFO("Update route for NH %s, num_routes: %u", nh_key.ip_address.to_string().c_str(), num_routes[i]);
+        gNeighOrch->decreaseNextHopRefCount(nh_key, num_routes[i++]);
+    }
 
-        if (!gRouteOrch->updateNextHopRoutes(nh_key, num_routes))
-        {
-            SWSS_LOG_INFO("Update route failed for NH %s", nh_key.ip_address.to_string().c_str());
-            return false;
-        }
-        SWSS_LOG_INFO("Update route for NH %s, num_routes: %u", nh_key.ip_address.to_string().c_str(), num_routes);
+    if (!routes_updated)
+    {
+        return false;
+    }
 
-        /* Decrement ref count for old NHs */
-        gNeighOrch->decreaseNextHopRefCount(nh_key, num_routes);
+    it = neighbors_.begin();
+    while (it != neighbors_.end())
+    {
+        NextHopKey nh_key = NextHopKey(it->first, alias_);
 
         /* Invalidate current nexthop group by removing the neighbor NH */
         uint32_t nh_removed;
@@ -1675,7 +1893,7 @@ MuxCable* MuxOrch::findMuxCableInSubnet(IpAddress ip)
     return nullptr;
 }
 
-bool MuxOrch::isMuxPortPrefixNbr(const IpAddress& nbr, const MacAddress& mac, string& alias)
+bool MuxOrch::isMuxPortPrefixNbr(const IpAddress& nbr, const MacAddress& mac, const string& alias)
 {
     // If prefix nbrs are not supported, return false
     if (!prefix_nbrs_supported_)
@@ -1738,7 +1956,7 @@ bool MuxOrch::isMuxPortPrefixNbr(const IpAddress& nbr, const MacAddress& mac, st
     return false;
 }
 
-bool MuxOrch::isNeighborActive(const IpAddress& nbr, const MacAddress& mac, string& alias)
+bool MuxOrch::isNeighborActive(const IpAddress& nbr, const MacAddress& mac, const string& alias)
 {
     if (mux_cable_tb_.empty())
     {
@@ -2158,19 +2376,6 @@ void MuxOrch::update(SubjectType type, void *cntx)
             }
             break;
         }
-        case SUBJECT_TYPE_FDB_CHANGE:
-        {
-            FdbUpdate *update = static_cast<FdbUpdate *>(cntx);
-            try
-            {
-                updateFdb(*update);
-            }
-            catch (const std::exception& e)
-            {
-                SWSS_LOG_ERROR("Exception caught while updating FDB. Error: %s", e.what());
-            }
-            break;
-        }
         default:
             /* Received update in which we are not interested
              * Ignore it
@@ -2179,6 +2384,24 @@ void MuxOrch::update(SubjectType type, void *cntx)
     }
 }
 
+// The FDB changes are received batched from FdbOrch, at most one per MAC
+void MuxOrch::onEvents(const vector<FdbUpdate>& updates)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto& update : updates)
+    {
+        try
+        {
+            updateFdb(update);
+        }
+        catch (const std::exception& e)
+        {
+            SWSS_LOG_ERROR("Exception caught while updating FDB. Error: %s", e.what());
+        }
+    }
+}
+
 MuxOrch::MuxOrch(DBConnector *db, const std::vector<std::string> &tables,
          TunnelDecapOrch* decapOrch, NeighOrch* neighOrch, FdbOrch* fdbOrch) :
          Orch2(db, tables, request_),
@@ -2193,7 +2416,7 @@ MuxOrch::MuxOrch(DBConnector *db, const std::vector<std::string> &tables,
     SWSS_LOG_NOTICE("MuxOrch: prefix_nbrs_supported_ = %s", prefix_nbrs_supported_ ? "true" : "false");
 
     neigh_orch_->attach(this);
-    fdb_orch_->attach(this);
+    fdb_orch_->getFdbEvents().subscribe(this);
 
     std::unique_ptr<DBConnector> state_db = std::make_unique<DBConnector>("STATE_DB", 0);
     state_mux_cable_table_ = std::make_unique<Table>(state_db.get(), STATE_MUX_CABLE_TABLE_NAME);
@@ -2570,6 +2793,17 @@ void MuxCableOrch::removeTunnelRoute(const NextHopKey &nhKey)
     app_tunnel_route_table_.del(key);
 }
 
+void MuxCableOrch::doTask(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    batch_toggles_ = true;
+    Orch2::doTask(consumer);
+    batch_toggles_ = false;
+
+    toggleCables();
+}
+
 bool MuxCableOrch::addOperation(const Request& request)
 {
     SWSS_LOG_ENTER();
@@ -2586,6 +2820,19 @@ bool MuxCableOrch::addOperation(const Request& request)
     auto state = request.getAttrString("state");
     auto mux_obj = mux_orch->getMuxCable(port_name);
 
+    if (batch_toggles_ && mux_obj->canBatchState(state))
+    {
+        pending_toggles_.emplace_back(port_name, state);
+        return true;
+    }
+
+    setState(mux_obj, port_name, state);
+
+    return true;
+}
+
+void MuxCableOrch::setState(MuxCable* mux_obj, const string& port_name, const string& state)
+{
     try
     {
         mux_obj->setState(state);
@@ -2595,26 +2842,173 @@ bool MuxCableOrch::addOperation(const Request& request)
         SWSS_LOG_ERROR("Mux Error setting state %s for port %s. Error: %s",
                         state.c_str(), port_name.c_str(), e.what());
         mux_obj->rollbackStateChange();
-        return true;
+        return;
     }
     catch (const std::logic_error& e)
     {
         SWSS_LOG_ERROR("Logic error while setting state %s for port %s. Error: %s",
                         state.c_str(), port_name.c_str(), e.what());
         mux_obj->rollbackStateChange();
-        return true;
+        return;
     }
     catch (const std::exception& e)
     {
         SWSS_LOG_ERROR("Exception caught while setting state %s for port %s. Error: %s",
                         state.c_str(), port_name.c_str(), e.what());
         mux_obj->rollbackStateChange();
-        return true;
+        return;
     }
 
     SWSS_LOG_NOTICE("Mux State set to %s for port %s", state.c_str(), port_name.c_str());
+}
 
-    return true;
+/**
+ * @brief Applies the state changes collected in a drain. A ToR-wide switchover
+ *        toggles every cable at once, their neighbors are enabled or disabled
+ *        and their tunnel routes added or removed in one bulk per direction
+ *        instead of one per cable.
+ */
+void MuxCableOrch::toggleCables()
+{
+    SWSS_LOG_ENTER();
+
+    if (pending_toggles_.empty())
+    {
+        return;
+    }
+
+    MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
+
+    if (pending_toggles_.size() == 1)
+    {
+        auto& toggle = pending_toggles_.front();
+        setState(mux_orch->getMuxCable(toggle.first), toggle.first, toggle.second);
+        pending_toggles_.clear();
+        return;
+    }
+
+    std::vector<std::pair<string, string>> active, standby;
+    for (auto& toggle : pending_toggles_)
+    {
+        if (muxStateStringToVal.at(toggle.second) == MuxState::MUX_STATE_ACTIVE)
+        {
+            active.push_back(toggle);
+        }
+        else
+        {
+            standby.push_back(toggle);
+        }
+    }
+    pending_toggles_.clear();
+
+    toggleCables(standby, false);
+    toggleCables(active, true);
+}
+
+void MuxCableOrch::toggleCables(const std::vector<std::pair<string, string>>& toggles, bool active)
+{
+    SWSS_LOG_ENTER();
+
+    if (toggles.empty())
+    {
+        return;
+    }
+
+    MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
+    MuxToggleBatch batch;
+    std::vector<std::pair<MuxCable*, string>> cables;
+
+    auto step = [](const string& port_name, const string& state, std::function<bool()> fn) {
+        try
+        {
+            return fn();
+        }
+        catch (const std::exception& e)
+        {
+            SWSS_LOG_ERROR("Exception caught while setting state %s for port %s. Error: %s",
+                            state.c_str(), port_name.c_str(), e.what());
+            return false;
+        }
+    };
+
+    auto fail = [](MuxCable* mux_obj, const string& port_name, const string& state) {
+        SWSS_LOG_ERROR("Mux Error setting state %s for port %s", state.c_str(), port_name.c_str());
+        mux_obj->endState(false);
+        mux_obj->rollbackStateChange();
+    };
+
+    for (const auto& toggle : toggles)
+    {
+        auto mux_obj = mux_orch->getMuxCable(toggle.first);
+        if (step(toggle.first, toggle.second, [&]() { return mux_obj->beginState(toggle.second, batch); }))
+        {
+            cables.emplace_back(mux_obj, toggle.first);
+        }
+        else
+        {
+            fail(mux_obj, toggle.first, toggle.second);
+        }
+    }
+
+    if (cables.empty())
+    {
+        return;
+    }
+
+    const string state = toggles.front().second;
+    string port_names;
+    for (const auto& cable : cables)
+    {
+        port_names += (port_names.empty() ? "" : ",") + cable.second;
+    }
+    MuxNbrHandler* route_handler = cables.front().first->getNbrHandler();
+    bool success = true;
+
+    SWSS_LOG_NOTICE("Setting %zu mux cables to %s, %zu neighbors", cables.size(), state.c_str(), batch.neigh_ctx_list.size());
+
+    if (active)
+    {
+        success = step(port_names, state, [&]() { return gNeighOrch->enableNeighbors(batch.neigh_ctx_list); });
+
+        auto it = cables.begin();
+        while (success && it != cables.end())
+        {
+            auto mux_obj = it->first;
+            if (step(it->second, state, [&]() { return mux_obj->continueState(batch); }))
+            {
+                it++;
+            }
+            else
+            {
+                fail(mux_obj, it->second, state);
+                it = cables.erase(it);
+            }
+        }
+
+        // Route entries don't depend on the cable, one cable's bulker flushes them all
+        success = success && step(port_names, state, [&]() { return route_handler->removeRoutes(batch.route_ctx_list); });
+    }
+    else
+    {
+        success = step(port_names, state, [&]() {
+            return route_handler->addRoutes(batch.route_ctx_list) &&
+                   gNeighOrch->disableNeighbors(batch.neigh_ctx_list);
+        });
+    }
+
+    for (auto& cable : cables)
+    {
+        auto mux_obj = cable.first;
+        if (step(cable.second, state, [&]() { return mux_obj->endState(success); }))
+        {
+            SWSS_LOG_NOTICE("Mux State set to %s for port %s", state.c_str(), cable.second.c_str());
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Mux Error setting state %s for port %s", state.c_str(), cable.second.c_str());
+            mux_obj->rollbackStateChange();
+        }
+    }
 }
 
 bool MuxCableOrch::delOperation(const Request& request)
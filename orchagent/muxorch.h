@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <set>
 #include <memory>
+#include <vector>
 
 #include "request_parser.h"
 #include "portsorch.h"
@@ -59,6 +60,16 @@ struct MuxRouteBulkContext
     }
 };
 
+/*
+ * Neighbor and tunnel route changes of the cables toggled in one drain,
+ * flushed once for all of them, see MuxCableOrch::toggleCables
+ */
+struct MuxToggleBatch
+{
+    std::list<NeighborContext>          neigh_ctx_list;
+    std::list<MuxRouteBulkContext>      route_ctx_list;
+};
+
 extern size_t gMaxBulkSize;
 extern sai_route_api_t* sai_route_api;
 
@@ -103,10 +114,17 @@ public:
     string getAlias() const { return alias_; };
     void clearBulkers() { gRouteBulker.clear(); };
 
-protected:
+    // enable() and disable() in steps, for the neighbor and route bulks to be shared between cables
+    virtual bool isBatchable() const { return true; }
+    void getNeighborContexts(std::list<NeighborContext>& neigh_ctx_list);
+    bool enableNextHops(bool update_rt, std::list<MuxRouteBulkContext>& route_ctx_list);
+    bool disableNextHops(sai_object_id_t tnh, std::list<MuxRouteBulkContext>& route_ctx_list);
     bool removeRoutes(std::list<MuxRouteBulkContext>& bulk_ctx_list);
     bool addRoutes(std::list<MuxRouteBulkContext>& bulk_ctx_list);
+
+protected:
     bool setBulkRouteNH(std::list<MuxRouteBulkContext>& bulk_ctx_list);
+    bool updateNextHopRoutes(std::vector<uint32_t>& num_routes);
 
     inline void updateTunnelRoute(NextHopKey, bool = true);
 
@@ -126,6 +144,7 @@ public:
     bool enable(bool update_rt) override;
     bool disable(sai_object_id_t) override;
     void update(NextHopKey nh, sai_object_id_t, bool = true, MuxState = MuxState::MUX_STATE_INIT) override;
+    bool isBatchable() const override { return false; }
 };
 
 // Mux Cable object
@@ -162,6 +181,22 @@ public:
         return nbr_handler_type_;
     }
 
+    MuxNbrHandler* getNbrHandler() const
+    {
+        return nbr_handler_.get();
+    }
+
+    /*
+     * setState() in steps for cables toggled together: beginState() up to the
+     * neighbor bulk, continueState() between the neighbor and route bulks of
+     * a switch to active, endState() after both. A false return is a failed
+     * state change, to be rolled back.
+     */
+    bool canBatchState(const string& new_state) const;
+    bool beginState(const string& new_state, MuxToggleBatch& batch);
+    bool continueState(MuxToggleBatch& batch);
+    bool endState(bool success);
+
 private:
     bool stateActive();
     bool stateInitActive();
@@ -176,6 +211,7 @@ private:
 
     MuxState state_ = MuxState::MUX_STATE_INIT;
     MuxState prev_state_;
+    MuxStateChange batch_change_ = MuxStateChange::MUX_STATE_UNKNOWN_STATE;
     bool st_chg_in_progress_ = false;
     bool st_chg_failed_ = false;
 
@@ -226,7 +262,7 @@ public:
 };
 
 
-class MuxOrch : public Orch2, public Observer, public Subject
+class MuxOrch : public Orch2, public Observer, public Subject, public EventSubscriber<FdbUpdate>
 {
 public:
     MuxOrch(DBConnector *db, const std::vector<std::string> &tables, TunnelDecapOrch*, NeighOrch*, FdbOrch*);
@@ -270,9 +306,10 @@ public:
     }
 
     MuxCable* findMuxCableInSubnet(IpAddress);
-    bool isMuxPortPrefixNbr(const IpAddress&, const MacAddress&, string&);
-    bool isNeighborActive(const IpAddress&, const MacAddress&, string&);
+    bool isMuxPortPrefixNbr(const IpAddress&, const MacAddress&, const string&);
+    bool isNeighborActive(const IpAddress&, const MacAddress&, const string&);
     void update(SubjectType, void *);
+    void onEvents(const vector<FdbUpdate>&) override;
 
     void addNexthop(NextHopKey, string = "");
     void removeNexthop(NextHopKey);
@@ -381,6 +418,9 @@ class MuxCableOrch : public Orch2
 public:
     MuxCableOrch(DBConnector *db, DBConnector *sdb, const std::string& tableName);
 
+    using Orch2::doTask;
+    void doTask(Consumer &consumer) override;
+
     void updateMuxState(string portName, string muxState);
     void updateMuxMetricState(string portName, string muxState, bool start);
     void addTunnelRoute(const NextHopKey &nhKey);
@@ -390,6 +430,14 @@ private:
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
 
+    void setState(MuxCable* mux_obj, const string& port_name, const string& state);
+    void toggleCables();
+    void toggleCables(const std::vector<std::pair<string, string>>& toggles, bool active);
+
+    // State changes of the drain in progress, applied together once it ends
+    bool batch_toggles_ = false;
+    std::vector<std::pair<string, string>> pending_toggles_;
+
     unique_ptr<Table> mux_table_;
     MuxCableRequest request_;
     swss::Table mux_metric_table_;
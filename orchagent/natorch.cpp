@@ -19,6 +19,7 @@
 #include <iostream>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "exec.h"
@@ -37,6 +38,7 @@ extern sai_object_id_t     gVirtualRouterId;
 extern sai_nat_api_t      *sai_nat_api;
 extern sai_hostif_api_t   *sai_hostif_api;
 extern bool               gIsNatSupported;
+extern size_t             gMaxBulkSize;
 #ifdef DEBUG_FRAMEWORK
 extern DebugDumpOrch      *gDebugDumpOrch;
 #endif
@@ -49,17 +51,26 @@ NatOrch::NatOrch(DBConnector *appDb, DBConnector *stateDb, vector<table_name_wit
          m_neighOrch(neighOrch),
          m_routeOrch(routeOrch),
          m_countersDb("COUNTERS_DB", 0),
-         m_countersNatTable(&m_countersDb, COUNTERS_NAT_TABLE),
-         m_countersNaptTable(&m_countersDb, COUNTERS_NAPT_TABLE),
-         m_countersTwiceNatTable(&m_countersDb, COUNTERS_TWICE_NAT_TABLE),
-         m_countersTwiceNaptTable(&m_countersDb, COUNTERS_TWICE_NAPT_TABLE),
+         m_countersPipeline(new RedisPipeline(&m_countersDb)),
+         m_countersNatTable(m_countersPipeline.get(), COUNTERS_NAT_TABLE, true),
+         m_countersNaptTable(m_countersPipeline.get(), COUNTERS_NAPT_TABLE, true),
+         m_countersTwiceNatTable(m_countersPipeline.get(), COUNTERS_TWICE_NAT_TABLE, true),
+         m_countersTwiceNaptTable(m_countersPipeline.get(), COUNTERS_TWICE_NAPT_TABLE, true),
          m_countersGlobalNatTable(&m_countersDb, COUNTERS_GLOBAL_NAT_TABLE),
          m_natQueryTable(appDb, APP_NAT_TABLE_NAME),
          m_naptQueryTable(appDb, APP_NAPT_TABLE_NAME),
          m_twiceNatQueryTable(appDb, APP_NAT_TWICE_TABLE_NAME),
          m_twiceNaptQueryTable(appDb, APP_NAPT_TWICE_TABLE_NAME),
-         nullIpv4Addr(0)
+         nullIpv4Addr(0),
+         m_natBulker(sai_nat_api, gMaxBulkSize),
+         m_natBulkMode(false),
+         m_bulkGetSupported(true),
+         m_hitBitRecord(false),
+         m_counterRecord(false)
 {
+    /* Queued NAT entries only need their own flush status, they don't query the bulker */
+    m_natBulker.enable_auto_flush();
+
     /* Set NAT admin mode to disabled */
     admin_mode = "disabled";
 
@@ -178,6 +189,8 @@ void NatOrch::update(SubjectType type, void *cntx)
              */
             return;
     }
+
+    m_countersPipeline->flush();
 }
 
 bool NatOrch::isNextHopResolved(const NextHopUpdate &update)
@@ -740,7 +753,6 @@ bool NatOrch::addHwDnatEntry(const IpAddress &ip_address)
     uint32_t        attr_count;
     sai_nat_entry_t dnat_entry = {};
     sai_attribute_t nat_entry_attr[4] = {};
-    sai_status_t    status;
 
     SWSS_LOG_ENTER();
     SWSS_LOG_INFO("Create DNAT entry for ip %s, as nexthop is resolved", ip_address.to_string().c_str());
@@ -770,41 +782,43 @@ bool NatOrch::addHwDnatEntry(const IpAddress &ip_address)
     dnat_entry.data.key.dst_ip = ip_address.getV4Addr();
     dnat_entry.data.mask.dst_ip = 0xffffffff;
 
-    status = sai_nat_api->create_nat_entry(&dnat_entry, attr_count, nat_entry_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    return createHwNatEntry(dnat_entry, attr_count, nat_entry_attr, [this, ip_address, entry](sai_status_t status)
     {
-        SWSS_LOG_ERROR("Failed to create %s DNAT NAT entry with ip %s and it's translated ip %s",
-                       entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
-
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_ERROR("Failed to create %s DNAT NAT entry with ip %s and it's translated ip %s",
+                           entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
+
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-    }
 
-    SWSS_LOG_NOTICE("Created %s DNAT NAT entry with ip %s and it's translated ip %s",
-                    entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
+        SWSS_LOG_NOTICE("Created %s DNAT NAT entry with ip %s and it's translated ip %s",
+                        entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
 
-    updateNatCounters(ip_address, 0, 0);
-    m_natEntries[ip_address].addedToHw = true; 
-    gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
+        updateNatCounters(ip_address, 0, 0);
+        m_natEntries[ip_address].addedToHw = true; 
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
 
-    if (entry.entry_type == "static")
-    {
-        totalStaticNatEntries++;
-        updateStaticNatCounters(totalStaticNatEntries);
-    }
-    else
-    {
-        totalDynamicNatEntries++;
-        updateDynamicNatCounters(totalDynamicNatEntries);
-    }
-    totalDnatEntries++;
-    updateDnatCounters(totalDnatEntries);
-    totalEntries++;
+        if (entry.entry_type == "static")
+        {
+            totalStaticNatEntries++;
+            updateStaticNatCounters(totalStaticNatEntries);
+        }
+        else
+        {
+            totalDynamicNatEntries++;
+            updateDynamicNatCounters(totalDynamicNatEntries);
+        }
+        totalDnatEntries++;
+        updateDnatCounters(totalDnatEntries);
+        totalEntries++;
 
-    return true;
+        return true;
+    });
 }
 
 // Add the DNAPT entry after nexthop resolution, to the hardware
@@ -814,7 +828,6 @@ bool NatOrch::addHwDnaptEntry(const NaptEntryKey &key)
     sai_nat_entry_t dnat_entry = {};
     sai_attribute_t nat_entry_attr[5] = {};
     uint8_t         ip_protocol = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    sai_status_t    status;
 
     SWSS_LOG_ENTER();
     SWSS_LOG_INFO("Create DNAPT entry for proto %s, dest-ip %s, l4-port %d, as nexthop is resolved",
@@ -852,49 +865,50 @@ bool NatOrch::addHwDnaptEntry(const NaptEntryKey &key)
     dnat_entry.data.key.proto = ip_protocol;
     dnat_entry.data.mask.proto = 0xff;
 
-    status = sai_nat_api->create_nat_entry(&dnat_entry, attr_count, nat_entry_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    return createHwNatEntry(dnat_entry, attr_count, nat_entry_attr, [this, key, entry](sai_status_t status)
     {
-        SWSS_LOG_ERROR("Failed to create %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                       entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
-                       entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_ERROR("Failed to create %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                           entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
+                           entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-    }
 
-    SWSS_LOG_NOTICE("Created %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                    entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
-                    entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+        SWSS_LOG_NOTICE("Created %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                        entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
+                        entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
 
-    m_naptEntries[key].addedToHw = true;
-    updateNaptCounters(key.prototype.c_str(), key.ip_address, key.l4_port, 0, 0);
-    gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
+        m_naptEntries[key].addedToHw = true;
+        updateNaptCounters(key.prototype.c_str(), key.ip_address, key.l4_port, 0, 0);
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
 
-    if (entry.entry_type == "static")
-    {
-        totalStaticNaptEntries++;
-        updateStaticNaptCounters(totalStaticNaptEntries);
-    }
-    else
-    {
-        totalDynamicNaptEntries++;
-        updateDynamicNaptCounters(totalDynamicNaptEntries);
-    }
-    totalDnatEntries++;
-    updateDnatCounters(totalDnatEntries);
-    totalEntries++;
+        if (entry.entry_type == "static")
+        {
+            totalStaticNaptEntries++;
+            updateStaticNaptCounters(totalStaticNaptEntries);
+        }
+        else
+        {
+            totalDynamicNaptEntries++;
+            updateDynamicNaptCounters(totalDynamicNaptEntries);
+        }
+        totalDnatEntries++;
+        updateDnatCounters(totalDnatEntries);
+        totalEntries++;
 
-    return true;
+        return true;
+    });
 }
 
 // Remove the DNAT entry from the hardware
 bool NatOrch::removeHwDnatEntry(const IpAddress &dstIp)
 {
     sai_nat_entry_t dnat_entry = {};
-    sai_status_t    status;
 
     SWSS_LOG_ENTER();
     SWSS_LOG_INFO("Deleting DNAT entry ip %s from hardware", dstIp.to_string().c_str());
@@ -924,61 +938,62 @@ bool NatOrch::removeHwDnatEntry(const IpAddress &dstIp)
     dnat_entry.data.key.dst_ip = dstIp.getV4Addr();
     dnat_entry.data.mask.dst_ip = 0xffffffff;
 
-    status = sai_nat_api->remove_nat_entry(&dnat_entry);
-    if (status != SAI_STATUS_SUCCESS)
+    return removeHwNatEntry(dnat_entry, [this, dstIp, entry](sai_status_t status)
     {
-        SWSS_LOG_INFO("Failed to remove %s DNAT NAT entry with ip %s and it's translated ip %s",
-                      entry.entry_type.c_str(), dstIp.to_string().c_str(), entry.translated_ip.to_string().c_str());
-
-        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_INFO("Failed to remove %s DNAT NAT entry with ip %s and it's translated ip %s",
+                          entry.entry_type.c_str(), dstIp.to_string().c_str(), entry.translated_ip.to_string().c_str());
+
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-    }
 
-    SWSS_LOG_NOTICE("Removed %s DNAT NAT entry with ip %s and it's translated ip %s",
-                    entry.entry_type.c_str(), dstIp.to_string().c_str(), entry.translated_ip.to_string().c_str());
+        SWSS_LOG_NOTICE("Removed %s DNAT NAT entry with ip %s and it's translated ip %s",
+                        entry.entry_type.c_str(), dstIp.to_string().c_str(), entry.translated_ip.to_string().c_str());
   
-    deleteNatCounters(dstIp);
-    gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
+        deleteNatCounters(dstIp);
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
 
-    if (entry.entry_type == "static")
-    {
-        if (totalStaticNatEntries)
+        if (entry.entry_type == "static")
         {
-            totalStaticNatEntries--;
-            updateStaticNatCounters(totalStaticNatEntries);
+            if (totalStaticNatEntries)
+            {
+                totalStaticNatEntries--;
+                updateStaticNatCounters(totalStaticNatEntries);
+            }
         }
-    }
-    else
-    {
-        if (totalDynamicNatEntries)
+        else
         {
-           totalDynamicNatEntries--;
-           updateDynamicNatCounters(totalDynamicNatEntries);
+            if (totalDynamicNatEntries)
+            {
+               totalDynamicNatEntries--;
+               updateDynamicNatCounters(totalDynamicNatEntries);
+            }
         }
-    }
 
-    if (totalDnatEntries)
-    {
-        totalDnatEntries--;
-        updateDnatCounters(totalDnatEntries);
-    }
+        if (totalDnatEntries)
+        {
+            totalDnatEntries--;
+            updateDnatCounters(totalDnatEntries);
+        }
 
-    if (totalEntries)
-    {
-        totalEntries--;
-    }
+        if (totalEntries)
+        {
+            totalEntries--;
+        }
  
-    return true;
+        return true;
+    });
 }
 
 // Remove the Twice NAT entry from the hardware
 bool NatOrch::removeHwTwiceNatEntry(const TwiceNatEntryKey &key)
 {
     sai_nat_entry_t dbl_nat_entry = {};
-    sai_status_t    status;
 
     SWSS_LOG_ENTER();
     SWSS_LOG_INFO("Deleting Twice NAT entry src ip %s, dst ip %s from the hardware",
@@ -1013,67 +1028,70 @@ bool NatOrch::removeHwTwiceNatEntry(const TwiceNatEntryKey &key)
     dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
 
 
-    status = sai_nat_api->remove_nat_entry(&dbl_nat_entry);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_INFO("Failed to remove Twice NAT entry with src-ip %s, dst-ip %s",
-                      key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str());
+    // The entry leaves the cache right away, its removal may be queued in the NAT bulker
+    m_twiceNatEntries.erase(key);
 
-        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+    return removeHwNatEntry(dbl_nat_entry, [this, key, value](sai_status_t status)
+    {
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_INFO("Failed to remove Twice NAT entry with src-ip %s, dst-ip %s",
+                          key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str());
+
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-    }
-    SWSS_LOG_NOTICE("Removed Twice NAT entry with src-ip %s, dst-ip %s",
-                    key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str());
+        SWSS_LOG_NOTICE("Removed Twice NAT entry with src-ip %s, dst-ip %s",
+                        key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str());
   
-    deleteTwiceNatCounters(key);
-    m_twiceNatEntries.erase(key);
+        deleteTwiceNatCounters(key);
 
-    if (value.entry_type == "static")
-    {
-        if (totalStaticTwiceNatEntries)
+        if (value.entry_type == "static")
         {
-            totalStaticTwiceNatEntries--;
-            updateStaticTwiceNatCounters(totalStaticTwiceNatEntries);
+            if (totalStaticTwiceNatEntries)
+            {
+                totalStaticTwiceNatEntries--;
+                updateStaticTwiceNatCounters(totalStaticTwiceNatEntries);
+            }
         }
-    }
-    else
-    {
-        if (totalDynamicTwiceNatEntries)
+        else
         {
-           totalDynamicTwiceNatEntries--;
-           updateDynamicTwiceNatCounters(totalDynamicTwiceNatEntries);
+            if (totalDynamicTwiceNatEntries)
+            {
+               totalDynamicTwiceNatEntries--;
+               updateDynamicTwiceNatCounters(totalDynamicTwiceNatEntries);
+            }
         }
-    }
 
-    if (totalSnatEntries)
-    {
-        totalSnatEntries--;
-        updateSnatCounters(totalSnatEntries);
-    }
+        if (totalSnatEntries)
+        {
+            totalSnatEntries--;
+            updateSnatCounters(totalSnatEntries);
+        }
 
-    if (totalDnatEntries)
-    {
-        totalDnatEntries--;
-        updateDnatCounters(totalDnatEntries);
-    }
+        if (totalDnatEntries)
+        {
+            totalDnatEntries--;
+            updateDnatCounters(totalDnatEntries);
+        }
 
-    if (totalEntries >= 2)
-    {
-        // Each Twice NAT entry is equivalent to 1 SNAT and 1 DNAT entry together
-        totalEntries -= 2;
-    }
+        if (totalEntries >= 2)
+        {
+            // Each Twice NAT entry is equivalent to 1 SNAT and 1 DNAT entry together
+            totalEntries -= 2;
+        }
  
-    return true;
+        return true;
+    });
 }
 
 // Remove the DNAPT entry from the hardware
 bool NatOrch::removeHwDnaptEntry(const NaptEntryKey &key)
 {
     sai_nat_entry_t dnat_entry = {};
-    sai_status_t    status;
     uint8_t         ip_protocol = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
 
     SWSS_LOG_ENTER();
@@ -1109,64 +1127,65 @@ bool NatOrch::removeHwDnaptEntry(const NaptEntryKey &key)
     dnat_entry.data.key.proto = ip_protocol;
     dnat_entry.data.mask.proto = 0xff;
 
-    status = sai_nat_api->remove_nat_entry(&dnat_entry);
-    if (status != SAI_STATUS_SUCCESS)
+    return removeHwNatEntry(dnat_entry, [this, key, entry](sai_status_t status)
     {
-        SWSS_LOG_INFO("Failed to remove %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                      entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
-                      entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_INFO("Failed to remove %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                          entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
+                          entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
 
 
-        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
-        {
-            return parseHandleSaiStatusFailure(handle_status);
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-    }
 
-    SWSS_LOG_NOTICE("Removed %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                    entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(), 
-                    entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+        SWSS_LOG_NOTICE("Removed %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                        entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(), 
+                        entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
 
-    deleteNaptCounters(key.prototype.c_str(), key.ip_address, key.l4_port);
-    gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
+        deleteNaptCounters(key.prototype.c_str(), key.ip_address, key.l4_port);
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
 
-    if (entry.entry_type == "static")
-    {
-        if (totalStaticNaptEntries)
+        if (entry.entry_type == "static")
         {
-            totalStaticNaptEntries--;
-            updateStaticNaptCounters(totalStaticNaptEntries);
+            if (totalStaticNaptEntries)
+            {
+                totalStaticNaptEntries--;
+                updateStaticNaptCounters(totalStaticNaptEntries);
+            }
         }
-    }
-    else
-    {
-        if (totalDynamicNaptEntries)
+        else
         {
-            totalDynamicNaptEntries--;
-            updateDynamicNaptCounters(totalDynamicNaptEntries);
+            if (totalDynamicNaptEntries)
+            {
+                totalDynamicNaptEntries--;
+                updateDynamicNaptCounters(totalDynamicNaptEntries);
+            }
         }
-    }
 
-    if (totalDnatEntries)
-    {
-        totalDnatEntries--;
-        updateDnatCounters(totalDnatEntries);
-    }
+        if (totalDnatEntries)
+        {
+            totalDnatEntries--;
+            updateDnatCounters(totalDnatEntries);
+        }
 
-    if (totalEntries)
-    {
-        totalEntries--;
-    }
+        if (totalEntries)
+        {
+            totalEntries--;
+        }
 
-    return true;
+        return true;
+    });
 }
 
 // Remove the Twice NAPT entry from the hardware
 bool NatOrch::removeHwTwiceNaptEntry(const TwiceNaptEntryKey &key)
 {
     sai_nat_entry_t dbl_nat_entry = {};
-    sai_status_t    status;
     uint8_t         protoType = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
 
     SWSS_LOG_ENTER();
@@ -1209,62 +1228,66 @@ bool NatOrch::removeHwTwiceNaptEntry(const TwiceNaptEntryKey &key)
     dbl_nat_entry.data.key.proto = protoType;
     dbl_nat_entry.data.mask.proto = 0xff;
 
-    status = sai_nat_api->remove_nat_entry(&dbl_nat_entry);
-    if (status != SAI_STATUS_SUCCESS)
+    // The entry leaves the cache right away, its removal may be queued in the NAT bulker
+    m_twiceNaptEntries.erase(key);
+
+    return removeHwNatEntry(dbl_nat_entry, [this, key, value](sai_status_t status)
     {
-        SWSS_LOG_INFO("Failed to remove Twice NAPT entry with prototype %s, src-ip %s, src port %d, dst-ip %s, dst port %d",
-                       key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port,
-                       key.dst_ip.to_string().c_str(), key.dst_l4_port);
-        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_INFO("Failed to remove Twice NAPT entry with prototype %s, src-ip %s, src port %d, dst-ip %s, dst port %d",
+                           key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port,
+                           key.dst_ip.to_string().c_str(), key.dst_l4_port);
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-    }
 
-    SWSS_LOG_NOTICE("Removed Twice NAPT entry with prototype %s, src-ip %s, src port %d, dst-ip %s, dst port %d",
-                    key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port,
-                    key.dst_ip.to_string().c_str(), key.dst_l4_port);
+        SWSS_LOG_NOTICE("Removed Twice NAPT entry with prototype %s, src-ip %s, src port %d, dst-ip %s, dst port %d",
+                        key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port,
+                        key.dst_ip.to_string().c_str(), key.dst_l4_port);
 
-    deleteTwiceNaptCounters(key);
-    m_twiceNaptEntries.erase(key);
+        deleteTwiceNaptCounters(key);
 
-    if (value.entry_type == "static")
-    {
-        if (totalStaticTwiceNaptEntries)
+        if (value.entry_type == "static")
         {
-            totalStaticTwiceNaptEntries--;
-            updateStaticTwiceNaptCounters(totalStaticTwiceNaptEntries);
+            if (totalStaticTwiceNaptEntries)
+            {
+                totalStaticTwiceNaptEntries--;
+                updateStaticTwiceNaptCounters(totalStaticTwiceNaptEntries);
+            }
         }
-    }
-    else
-    {
-        if (totalDynamicTwiceNaptEntries)
+        else
         {
-            totalDynamicTwiceNaptEntries--;
-            updateDynamicTwiceNaptCounters(totalDynamicTwiceNaptEntries);
+            if (totalDynamicTwiceNaptEntries)
+            {
+                totalDynamicTwiceNaptEntries--;
+                updateDynamicTwiceNaptCounters(totalDynamicTwiceNaptEntries);
+            }
         }
-    }
 
-    if (totalSnatEntries)
-    {
-        totalSnatEntries--;
-        updateSnatCounters(totalSnatEntries);
-    }
+        if (totalSnatEntries)
+        {
+            totalSnatEntries--;
+            updateSnatCounters(totalSnatEntries);
+        }
 
-    if (totalDnatEntries)
-    {
-        totalDnatEntries--;
-        updateDnatCounters(totalDnatEntries);
-    }
+        if (totalDnatEntries)
+        {
+            totalDnatEntries--;
+            updateDnatCounters(totalDnatEntries);
+        }
 
-    if (totalEntries >= 2)
-    {
-        // Each Twice NAT entry is equivalent to 1 SNAT and 1 DNAT entry together
-        totalEntries -= 2;
-    }
+        if (totalEntries >= 2)
+        {
+            // Each Twice NAT entry is equivalent to 1 SNAT and 1 DNAT entry together
+            totalEntries -= 2;
+        }
 
-    return true;
+        return true;
+    });
 }
 
 // Add the SNAT entry to the hardware
@@ -1273,7 +1296,6 @@ bool NatOrch::addHwSnatEntry(const IpAddress &ip_address)
     uint32_t        attr_count;
     sai_nat_entry_t snat_entry = {};
     sai_attribute_t nat_entry_attr[4] = {};
-    sai_status_t    status;
     struct timespec  time_now;
 
     SWSS_LOG_ENTER();
@@ -1303,40 +1325,42 @@ bool NatOrch::addHwSnatEntry(const IpAddress &ip_address)
     snat_entry.data.key.src_ip = ip_address.getV4Addr();
     snat_entry.data.mask.src_ip = 0xffffffff;
 
-    status = sai_nat_api->create_nat_entry(&snat_entry, attr_count, nat_entry_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    return createHwNatEntry(snat_entry, attr_count, nat_entry_attr, [this, ip_address, entry, time_now](sai_status_t status)
     {
-        SWSS_LOG_ERROR("Failed to create %s SNAT NAT entry with ip %s and it's translated ip %s",
-                       entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
-
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_ERROR("Failed to create %s SNAT NAT entry with ip %s and it's translated ip %s",
+                           entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
+
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-    }
 
-    SWSS_LOG_NOTICE("Created %s SNAT NAT entry with ip %s and it's translated ip %s",
-                    entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
+        SWSS_LOG_NOTICE("Created %s SNAT NAT entry with ip %s and it's translated ip %s",
+                        entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
 
-    updateNatCounters(ip_address, 0, 0);
-    m_natEntries[ip_address].addedToHw = true;
-    m_natEntries[ip_address].activeTime = time_now.tv_sec;
-    gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_SNAT_ENTRY);
+        updateNatCounters(ip_address, 0, 0);
+        m_natEntries[ip_address].addedToHw = true;
+        m_natEntries[ip_address].activeTime = time_now.tv_sec;
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_SNAT_ENTRY);
 
-    if (entry.entry_type == "static")
-    {
-        totalStaticNatEntries++;
-        updateStaticNatCounters(totalStaticNatEntries);
-    }
-    else
-    {
-        totalDynamicNatEntries++;
-        updateDynamicNatCounters(totalDynamicNatEntries);
-    }
-    totalEntries++;
+        if (entry.entry_type == "static")
+        {
+            totalStaticNatEntries++;
+            updateStaticNatCounters(totalStaticNatEntries);
+        }
+        else
+        {
+            totalDynamicNatEntries++;
+            updateDynamicNatCounters(totalDynamicNatEntries);
+        }
+        totalEntries++;
 
-    return true;
+        return true;
+    });
 }
 
 // Add the Twice NAT entry to the hardware
@@ -1346,7 +1370,6 @@ bool NatOrch::addHwTwiceNatEntry(const TwiceNatEntryKey &key)
     sai_nat_entry_t dbl_nat_entry = {};
     sai_attribute_t nat_entry_attr[6] = {};
 
-    sai_status_t    status;
     struct timespec  time_now;
 
     SWSS_LOG_ENTER();
@@ -1382,49 +1405,50 @@ bool NatOrch::addHwTwiceNatEntry(const TwiceNatEntryKey &key)
     dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
     dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
 
-    status = sai_nat_api->create_nat_entry(&dbl_nat_entry, attr_count, nat_entry_attr);
-
-    if (status != SAI_STATUS_SUCCESS)
+    return createHwNatEntry(dbl_nat_entry, attr_count, nat_entry_attr, [this, key, value, time_now](sai_status_t status)
     {
-        SWSS_LOG_ERROR("Failed to create %s Twice NAT entry with src ip %s, dst ip %s, translated src ip %s, translated dst ip %s",
-                       value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str(),
-                       value.translated_src_ip.to_string().c_str(), value.translated_dst_ip.to_string().c_str());
-
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_ERROR("Failed to create %s Twice NAT entry with src ip %s, dst ip %s, translated src ip %s, translated dst ip %s",
+                           value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str(),
+                           value.translated_src_ip.to_string().c_str(), value.translated_dst_ip.to_string().c_str());
+
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-    }
 
-    SWSS_LOG_NOTICE("Created %s Twice NAT entry with src ip %s, dst ip %s, translated src ip %s, translated dst ip %s",
-                    value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str(),
-                    value.translated_src_ip.to_string().c_str(), value.translated_dst_ip.to_string().c_str());
+        SWSS_LOG_NOTICE("Created %s Twice NAT entry with src ip %s, dst ip %s, translated src ip %s, translated dst ip %s",
+                        value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str(),
+                        value.translated_src_ip.to_string().c_str(), value.translated_dst_ip.to_string().c_str());
 
-    updateTwiceNatCounters(key, 0, 0);
-    m_twiceNatEntries[key].addedToHw = true; 
-    m_twiceNatEntries[key].activeTime = time_now.tv_sec;
+        updateTwiceNatCounters(key, 0, 0);
+        m_twiceNatEntries[key].addedToHw = true; 
+        m_twiceNatEntries[key].activeTime = time_now.tv_sec;
 
-    totalDnatEntries++;
-    updateDnatCounters(totalDnatEntries);
-    totalEntries++;
+        totalDnatEntries++;
+        updateDnatCounters(totalDnatEntries);
+        totalEntries++;
 
-    totalSnatEntries++;
-    updateSnatCounters(totalSnatEntries);
-    totalEntries++;
+        totalSnatEntries++;
+        updateSnatCounters(totalSnatEntries);
+        totalEntries++;
 
-    if (value.entry_type == "static")
-    {
-        totalStaticTwiceNatEntries++;
-        updateStaticTwiceNatCounters(totalStaticTwiceNatEntries);
-    }
-    else
-    {
-        totalDynamicTwiceNatEntries++;
-        updateDynamicTwiceNatCounters(totalDynamicTwiceNatEntries);
-    }
+        if (value.entry_type == "static")
+        {
+            totalStaticTwiceNatEntries++;
+            updateStaticTwiceNatCounters(totalStaticTwiceNatEntries);
+        }
+        else
+        {
+            totalDynamicTwiceNatEntries++;
+            updateDynamicTwiceNatCounters(totalDynamicTwiceNatEntries);
+        }
 
-    return true;
+        return true;
+    });
 }
 
 // Add the SNAPT entry to the hardware
@@ -1434,7 +1458,6 @@ bool NatOrch::addHwSnaptEntry(const NaptEntryKey &keyEntry)
     sai_nat_entry_t snat_entry = {};
     sai_attribute_t nat_entry_attr[5] = {};
     uint8_t         ip_protocol = ((keyEntry.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    sai_status_t    status;
     struct timespec  time_now;
 
     SWSS_LOG_ENTER();
@@ -1471,43 +1494,45 @@ bool NatOrch::addHwSnaptEntry(const NaptEntryKey &keyEntry)
     snat_entry.data.key.proto = ip_protocol;
     snat_entry.data.mask.proto = 0xff;
 
-    status = sai_nat_api->create_nat_entry(&snat_entry, attr_count, nat_entry_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    return createHwNatEntry(snat_entry, attr_count, nat_entry_attr, [this, keyEntry, entry, time_now](sai_status_t status)
     {
-        SWSS_LOG_ERROR("Failed to create %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                       entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
-                       entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
-
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
-        }
-     }
-
-     SWSS_LOG_NOTICE("Created %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                     entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
-                     entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+            SWSS_LOG_ERROR("Failed to create %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                           entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
+                           entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
 
-     m_naptEntries[keyEntry].addedToHw = true;
-     m_naptEntries[keyEntry].activeTime = time_now.tv_sec;
-
-     updateNaptCounters(keyEntry.prototype.c_str(), keyEntry.ip_address, keyEntry.l4_port, 0, 0);
-     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_SNAT_ENTRY);
-
-     if (entry.entry_type == "static")
-     {
-         totalStaticNaptEntries++;
-         updateStaticNaptCounters(totalStaticNaptEntries);
-     }
-     else
-     {
-         totalDynamicNaptEntries++;
-         updateDynamicNaptCounters(totalDynamicNaptEntries);
-     }
-     totalEntries++;
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
+         }
+
+         SWSS_LOG_NOTICE("Created %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                         entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
+                         entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+
+         m_naptEntries[keyEntry].addedToHw = true;
+         m_naptEntries[keyEntry].activeTime = time_now.tv_sec;
+
+         updateNaptCounters(keyEntry.prototype.c_str(), keyEntry.ip_address, keyEntry.l4_port, 0, 0);
+         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_SNAT_ENTRY);
+
+         if (entry.entry_type == "static")
+         {
+             totalStaticNaptEntries++;
+             updateStaticNaptCounters(totalStaticNaptEntries);
+         }
+         else
+         {
+             totalDynamicNaptEntries++;
+             updateDynamicNaptCounters(totalDynamicNaptEntries);
+         }
+         totalEntries++;
 
-    return true;
+        return true;
+    });
 }
 
 // Add the Twice NAPT entry to the hardware
@@ -1517,7 +1542,6 @@ bool NatOrch::addHwTwiceNaptEntry(const TwiceNaptEntryKey &key)
     sai_nat_entry_t dbl_nat_entry = {};
     sai_attribute_t nat_entry_attr[8] = {};
     uint8_t         protoType = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    sai_status_t    status;
     struct timespec  time_now;
 
     SWSS_LOG_ENTER();
@@ -1565,60 +1589,61 @@ bool NatOrch::addHwTwiceNaptEntry(const TwiceNaptEntryKey &key)
     dbl_nat_entry.data.key.proto = protoType;
     dbl_nat_entry.data.mask.proto = 0xff;
 
-    status = sai_nat_api->create_nat_entry(&dbl_nat_entry, attr_count, nat_entry_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    return createHwNatEntry(dbl_nat_entry, attr_count, nat_entry_attr, [this, key, value, time_now](sai_status_t status)
     {
-        SWSS_LOG_ERROR("Failed to create %s Twice NAPT entry with src ip %s, src port %d, dst ip %s dst port %d, prototype %s and \
-                       it's translated src ip %s, translated src port %d, translated dst ip %s, translated dst port %d ",
-                       value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
-                       key.dst_l4_port, key.prototype.c_str(), value.translated_src_ip.to_string().c_str(), value.translated_src_l4_port,
-                       value.translated_dst_ip.to_string().c_str(), value.translated_dst_l4_port);
-
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
-        }
-     }
-
-
-     SWSS_LOG_NOTICE("Created %s Twice NAPT entry with src ip %s, src port %d, dst ip %s dst port %d, prototype %s and \
-                     it's translated src ip %s, translated src port %d, translated dst ip %s, translated dst port %d ",
-                     value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
-                     key.dst_l4_port, key.prototype.c_str(), value.translated_src_ip.to_string().c_str(), value.translated_src_l4_port,
-                     value.translated_dst_ip.to_string().c_str(), value.translated_dst_l4_port);
-
-     updateTwiceNaptCounters(key, 0, 0);
-     m_twiceNaptEntries[key].addedToHw = true;
-     m_twiceNaptEntries[key].activeTime = time_now.tv_sec;
-
-     totalDnatEntries++;
-     updateDnatCounters(totalDnatEntries);
-     totalEntries++;
-
-     totalSnatEntries++;
-     updateSnatCounters(totalSnatEntries);
-     totalEntries++;
-
-     if (value.entry_type == "static")
-     {
-         totalStaticTwiceNaptEntries++;
-         updateStaticTwiceNaptCounters(totalStaticTwiceNaptEntries);
-     }
-     else
-     {
-         totalDynamicTwiceNaptEntries++;
-         updateDynamicTwiceNaptCounters(totalDynamicTwiceNaptEntries);
-     }
+            SWSS_LOG_ERROR("Failed to create %s Twice NAPT entry with src ip %s, src port %d, dst ip %s dst port %d, prototype %s and \
+                           it's translated src ip %s, translated src port %d, translated dst ip %s, translated dst port %d ",
+                           value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
+                           key.dst_l4_port, key.prototype.c_str(), value.translated_src_ip.to_string().c_str(), value.translated_src_l4_port,
+                           value.translated_dst_ip.to_string().c_str(), value.translated_dst_l4_port);
+
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
+         }
+
+
+         SWSS_LOG_NOTICE("Created %s Twice NAPT entry with src ip %s, src port %d, dst ip %s dst port %d, prototype %s and \
+                         it's translated src ip %s, translated src port %d, translated dst ip %s, translated dst port %d ",
+                         value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
+                         key.dst_l4_port, key.prototype.c_str(), value.translated_src_ip.to_string().c_str(), value.translated_src_l4_port,
+                         value.translated_dst_ip.to_string().c_str(), value.translated_dst_l4_port);
+
+         updateTwiceNaptCounters(key, 0, 0);
+         m_twiceNaptEntries[key].addedToHw = true;
+         m_twiceNaptEntries[key].activeTime = time_now.tv_sec;
+
+         totalDnatEntries++;
+         updateDnatCounters(totalDnatEntries);
+         totalEntries++;
+
+         totalSnatEntries++;
+         updateSnatCounters(totalSnatEntries);
+         totalEntries++;
+
+         if (value.entry_type == "static")
+         {
+             totalStaticTwiceNaptEntries++;
+             updateStaticTwiceNaptCounters(totalStaticTwiceNaptEntries);
+         }
+         else
+         {
+             totalDynamicTwiceNaptEntries++;
+             updateDynamicTwiceNaptCounters(totalDynamicTwiceNaptEntries);
+         }
 
-    return true;
+        return true;
+    });
 }
 
 // Remove the SNAT entry from the hardware
 bool NatOrch::removeHwSnatEntry(const IpAddress &ip_address)
 {
     sai_nat_entry_t snat_entry = {};
-    sai_status_t    status;
 
     SWSS_LOG_ENTER();
     SWSS_LOG_INFO("Deleting SNAT entry ip %s from hardware", ip_address.to_string().c_str());
@@ -1631,17 +1656,20 @@ bool NatOrch::removeHwSnatEntry(const IpAddress &ip_address)
     snat_entry.data.key.src_ip = ip_address.getV4Addr();
     snat_entry.data.mask.src_ip = 0xffffffff;
 
-    status = sai_nat_api->remove_nat_entry(&snat_entry);
-    if (status != SAI_STATUS_SUCCESS)
+    removeHwNatEntry(snat_entry, [ip_address, entry](sai_status_t status)
     {
-        SWSS_LOG_INFO("Failed to removed %s SNAT NAT entry with ip %s and it's translated ip %s",
-                      entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
-    }
-    else
-    {
-        SWSS_LOG_NOTICE("Removed %s SNAT NAT entry with ip %s and it's translated ip %s",
-                        entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
-    }
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_INFO("Failed to removed %s SNAT NAT entry with ip %s and it's translated ip %s",
+                          entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
+        }
+        else
+        {
+            SWSS_LOG_NOTICE("Removed %s SNAT NAT entry with ip %s and it's translated ip %s",
+                            entry.entry_type.c_str(), ip_address.to_string().c_str(), entry.translated_ip.to_string().c_str());
+        }
+        return true;
+    });
     deleteNatCounters(ip_address);
     m_natEntries.erase(ip_address);
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_SNAT_ENTRY);
@@ -1691,7 +1719,6 @@ bool NatOrch::removeHwSnatEntry(const IpAddress &ip_address)
 bool NatOrch::removeHwSnaptEntry(const NaptEntryKey &keyEntry)
 {
     sai_nat_entry_t snat_entry = {};
-    sai_status_t    status;
     uint8_t         ip_protocol = ((keyEntry.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
 
     SWSS_LOG_ENTER();
@@ -1718,19 +1745,22 @@ bool NatOrch::removeHwSnaptEntry(const NaptEntryKey &keyEntry)
     snat_entry.data.key.proto = ip_protocol;
     snat_entry.data.mask.proto = 0xff;
 
-    status = sai_nat_api->remove_nat_entry(&snat_entry);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_INFO("Failed to removed %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                      entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
-                      entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
-    }
-    else
-    {
-        SWSS_LOG_NOTICE("Removed %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                      entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
-                      entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
-    }
+    removeHwNatEntry(snat_entry, [keyEntry, entry](sai_status_t status)
+    {
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_INFO("Failed to removed %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                          entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
+                          entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+        }
+        else
+        {
+            SWSS_LOG_NOTICE("Removed %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                          entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
+                          entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+        }
+        return true;
+    });
     deleteNaptCounters(keyEntry.prototype.c_str(), keyEntry.ip_address, keyEntry.l4_port);
     m_naptEntries.erase(keyEntry);
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_SNAT_ENTRY);
@@ -1776,6 +1806,58 @@ bool NatOrch::removeHwSnaptEntry(const NaptEntryKey &keyEntry)
     return true;
 }
 
+/* Create a NAT entry in the hardware and run its bookkeeping with the status.
+ * In bulk mode the create is queued in the NAT bulker and the bookkeeping
+ * follows flushHwNatEntries().
+ */
+bool NatOrch::createHwNatEntry(const sai_nat_entry_t &nat_entry, uint32_t attr_count, const sai_attribute_t *attr_list,
+                               std::function<bool(sai_status_t)> post)
+{
+    if (!m_natBulkMode)
+    {
+        return post(sai_nat_api->create_nat_entry(&nat_entry, attr_count, attr_list));
+    }
+
+    m_natBulkOps.push_back({SAI_STATUS_NOT_EXECUTED, std::move(post)});
+    m_natBulker.create_entry(&m_natBulkOps.back().status, &nat_entry, attr_count, attr_list);
+
+    return true;
+}
+
+// Remove a NAT entry from the hardware, see createHwNatEntry()
+bool NatOrch::removeHwNatEntry(const sai_nat_entry_t &nat_entry, std::function<bool(sai_status_t)> post)
+{
+    if (!m_natBulkMode)
+    {
+        return post(sai_nat_api->remove_nat_entry(&nat_entry));
+    }
+
+    m_natBulkOps.push_back({SAI_STATUS_NOT_EXECUTED, std::move(post)});
+    m_natBulker.remove_entry(&m_natBulkOps.back().status, &nat_entry);
+
+    return true;
+}
+
+// Flush the NAT bulker and run the bookkeeping of the queued entries in queue order
+void NatOrch::flushHwNatEntries(void)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_natBulkOps.empty())
+    {
+        return;
+    }
+
+    m_natBulker.flush();
+
+    std::deque<NatBulkOp> ops;
+    ops.swap(m_natBulkOps);
+    for (auto &op : ops)
+    {
+        op.post(op.status);
+    }
+}
+
 // Add the DNAT Pool entry to the hardware
 bool NatOrch::addHwDnatPoolEntry(const IpAddress &ip_address)
 {
@@ -2616,12 +2698,25 @@ void NatOrch::disableNatFeature(void)
 
 void NatOrch::doNatTableTask(Consumer& consumer)
 {
+    /* NAT entries are created and removed in bulk, a second task
+     * for a key waits for the flush of the first one */
+    std::set<string> bulkKeys;
+    m_natBulkMode = true;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
         KeyOpFieldsValuesTuple t = it->second;
         string key = kfvKey(t);
         string op = kfvOp(t);
+
+        if (!bulkKeys.insert(key).second)
+        {
+            flushHwNatEntries();
+            bulkKeys.clear();
+            bulkKeys.insert(key);
+        }
+
         vector<string> keys = tokenize(key, ':');
         /* Example : APPL_DB
          * NAT_TABLE:65.55.45.1
@@ -2678,16 +2773,32 @@ void NatOrch::doNatTableTask(Consumer& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushHwNatEntries();
+    m_natBulkMode = false;
 }
 
 void NatOrch::doNaptTableTask(Consumer& consumer)
 {
+    /* NAT entries are created and removed in bulk, a second task
+     * for a key waits for the flush of the first one */
+    std::set<string> bulkKeys;
+    m_natBulkMode = true;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
         KeyOpFieldsValuesTuple t = it->second;
         string key = kfvKey(t);
         string op = kfvOp(t);
+
+        if (!bulkKeys.insert(key).second)
+        {
+            flushHwNatEntries();
+            bulkKeys.clear();
+            bulkKeys.insert(key);
+        }
+
         vector<string> keys = tokenize(key, ':');
 
         /* Example : APPL_DB
@@ -2752,16 +2863,32 @@ void NatOrch::doNaptTableTask(Consumer& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushHwNatEntries();
+    m_natBulkMode = false;
 }
 
 void NatOrch::doTwiceNatTableTask(Consumer& consumer)
 {
+    /* NAT entries are created and removed in bulk, a second task
+     * for a key waits for the flush of the first one */
+    std::set<string> bulkKeys;
+    m_natBulkMode = true;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
         KeyOpFieldsValuesTuple t = it->second;
         string key = kfvKey(t);
         string op = kfvOp(t);
+
+        if (!bulkKeys.insert(key).second)
+        {
+            flushHwNatEntries();
+            bulkKeys.clear();
+            bulkKeys.insert(key);
+        }
+
         vector<string> keys = tokenize(key, ':');
         /* Example : APPL_DB
          * NAT_TWICE_TABLE:91.91.91.91:65.55.45.1
@@ -2820,16 +2947,32 @@ void NatOrch::doTwiceNatTableTask(Consumer& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushHwNatEntries();
+    m_natBulkMode = false;
 }
 
 void NatOrch::doTwiceNaptTableTask(Consumer& consumer)
 {
+    /* NAT entries are created and removed in bulk, a second task
+     * for a key waits for the flush of the first one */
+    std::set<string> bulkKeys;
+    m_natBulkMode = true;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
         KeyOpFieldsValuesTuple t = it->second;
         string key = kfvKey(t);
         string op = kfvOp(t);
+
+        if (!bulkKeys.insert(key).second)
+        {
+            flushHwNatEntries();
+            bulkKeys.clear();
+            bulkKeys.insert(key);
+        }
+
         vector<string> keys = tokenize(key, ':');
 
         /* Example : APPL_DB
@@ -2899,6 +3042,9 @@ void NatOrch::doTwiceNaptTableTask(Consumer& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushHwNatEntries();
+    m_natBulkMode = false;
 }
 
 void NatOrch::doNatGlobalTableTask(Consumer& consumer)
@@ -3073,6 +3219,8 @@ void NatOrch::doTask(Consumer& consumer)
         SWSS_LOG_INFO("Received unknown NAT Table - %s notification", table_name.c_str());
         return;
     }
+
+    m_countersPipeline->flush();
 }
 
 struct timespec getTimeDiff(const struct timespec &begin, const struct timespec &end)
@@ -3098,11 +3246,13 @@ void NatOrch::doTask(SelectableTimer &timer)
 
     if (timer.getFd() == m_natQueryTimer->getFd())
     {
-        if (((natTimerTickCntr++) % NAT_HITBIT_QUERY_MULTIPLE) == 0)
+        /* A hit bit walk started every NAT_HITBIT_QUERY_MULTIPLE ticks goes on over the following ticks */
+        if (((natTimerTickCntr++) % NAT_HITBIT_QUERY_MULTIPLE) == 0 || !m_hitBitWalk.done())
         {
             queryHitBits();
         }
         queryCounters();
+        m_countersPipeline->flush();
     }
     else if (timer.getFd() == m_natTimeoutTimer->getFd())
     {
@@ -3127,40 +3277,40 @@ void NatOrch::queryCounters(void)
         return;
     }
 
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
+    /* Each tick queries the next chunk of the walk, a new walk starts once all the entries are queried */
+    if (m_counterWalk.done())
     {
-        getNatCounters(natIter);
+        startQueryWalk(m_counterWalk);
+    }
 
+    NatQueryChunk chunk;
+    nextQueryChunk(m_counterWalk, chunk);
+    bulkGetCounters(chunk);
+
+    for (const auto &natIter : chunk.nat)
+    {
+        getNatCounters(natIter);
         queried_entries++;
-        natIter++;
     }
 
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+    for (const auto &naptIter : chunk.napt)
     {
         getNaptCounters(naptIter);
-
         queried_entries++;
-        naptIter++;
     }
-    TwiceNatEntry::iterator tnatIter = m_twiceNatEntries.begin();
-    while (tnatIter != m_twiceNatEntries.end())
+
+    for (const auto &tnatIter : chunk.twiceNat)
     {
         getTwiceNatCounters(tnatIter);
-
         queried_entries++;
-        tnatIter++;
     }
 
-    TwiceNaptEntry::iterator tnaptIter = m_twiceNaptEntries.begin();
-    while (tnaptIter != m_twiceNaptEntries.end())
+    for (const auto &tnaptIter : chunk.twiceNapt)
     {
         getTwiceNaptCounters(tnaptIter);
-
         queried_entries++;
-        tnaptIter++;
     }
+    m_counters.clear();
 
     if (clock_gettime (CLOCK_MONOTONIC, &time_end) < 0)
     {
@@ -3313,11 +3463,19 @@ void NatOrch::queryHitBits(void)
         return;
     }
 
+    if (m_hitBitWalk.done())
+    {
+        startQueryWalk(m_hitBitWalk);
+    }
+
+    NatQueryChunk chunk;
+    nextQueryChunk(m_hitBitWalk, chunk);
+    bulkGetHitBits(chunk, time_now.tv_sec);
+
     /* Remove the NAT entries that are aged out.
      * Query the NAT entries for their activity in the hardware
      * and update the active timeout. */
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
+    for (const auto &natIter : chunk.nat)
     {
         if (checkIfNatEntryIsActive(natIter, time_now.tv_sec))
         {
@@ -3338,14 +3496,12 @@ void NatOrch::queryHitBits(void)
             } 
         }
         queried_entries++;
-        natIter++;
     }
 
     /* Remove the NAPT entries that are aged out.
      * Query the NAPT entries for their activity in the hardware
      * and update the active timeout. */
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+    for (const auto &naptIter : chunk.napt)
     {
         if (checkIfNaptEntryIsActive(naptIter, time_now.tv_sec))
         {
@@ -3367,14 +3523,12 @@ void NatOrch::queryHitBits(void)
             }
         }
         queried_entries++;
-        naptIter++;
     }
 
     /* Remove the Twice NAT entries that are aged out.
      * Query the Twice NAT entries for their activity in the hardware
      * and update the active timeout. */
-    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
-    while (twiceNatIter != m_twiceNatEntries.end())
+    for (const auto &twiceNatIter : chunk.twiceNat)
     {
         if (checkIfTwiceNatEntryIsActive(twiceNatIter, time_now.tv_sec))
         {
@@ -3395,14 +3549,12 @@ void NatOrch::queryHitBits(void)
             }
         }
         queried_entries++;
-        twiceNatIter++;
     }
 
     /* Remove the Twice NAPT entries that are aged out.
      * Query the Twice NAPT entries for their activity in the hardware
      * and update the active timeout. */
-    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
-    while (twiceNaptIter != m_twiceNaptEntries.end())
+    for (const auto &twiceNaptIter : chunk.twiceNapt)
     {
         if (checkIfTwiceNaptEntryIsActive(twiceNaptIter, time_now.tv_sec))
         {
@@ -3425,8 +3577,9 @@ void NatOrch::queryHitBits(void)
             }
         }
         queried_entries++;
-        twiceNaptIter++;
     }
+    m_hitBits.clear();
+
     if (clock_gettime (CLOCK_MONOTONIC, &time_end) < 0)
     {
         return;
@@ -3440,6 +3593,288 @@ void NatOrch::queryHitBits(void)
     }
 }
 
+/* Keep the keys of all the entries for a new walk, queried over the next ticks */
+void NatOrch::startQueryWalk(NatQueryWalk &walk)
+{
+    walk = NatQueryWalk();
+    for (const auto &natEntry : m_natEntries)
+    {
+        walk.natKeys.push_back(natEntry.first);
+    }
+    for (const auto &naptEntry : m_naptEntries)
+    {
+        walk.naptKeys.push_back(naptEntry.first);
+    }
+    for (const auto &twiceNatEntry : m_twiceNatEntries)
+    {
+        walk.twiceNatKeys.push_back(twiceNatEntry.first);
+    }
+    for (const auto &twiceNaptEntry : m_twiceNaptEntries)
+    {
+        walk.twiceNaptKeys.push_back(twiceNaptEntry.first);
+    }
+
+    size_t ticks = NAT_HITBIT_QUERY_MULTIPLE;
+    walk.entriesPerTick = max((size_t)NAT_QUERY_MIN_ENTRIES_PER_TICK, (walk.size() + ticks - 1) / ticks);
+}
+
+/* The entries of the walk to query on this tick, skipping the ones removed since the walk started */
+void NatOrch::nextQueryChunk(NatQueryWalk &walk, NatQueryChunk &chunk)
+{
+    size_t end = min(walk.size(), walk.next + walk.entriesPerTick);
+    for (; walk.next < end; walk.next++)
+    {
+        size_t index = walk.next;
+        if (index < walk.natKeys.size())
+        {
+            auto natIter = m_natEntries.find(walk.natKeys[index]);
+            if (natIter != m_natEntries.end())
+            {
+                chunk.nat.push_back(natIter);
+            }
+            continue;
+        }
+        index -= walk.natKeys.size();
+
+        if (index < walk.naptKeys.size())
+        {
+            auto naptIter = m_naptEntries.find(walk.naptKeys[index]);
+            if (naptIter != m_naptEntries.end())
+            {
+                chunk.napt.push_back(naptIter);
+            }
+            continue;
+        }
+        index -= walk.naptKeys.size();
+
+        if (index < walk.twiceNatKeys.size())
+        {
+            auto twiceNatIter = m_twiceNatEntries.find(walk.twiceNatKeys[index]);
+            if (twiceNatIter != m_twiceNatEntries.end())
+            {
+                chunk.twiceNat.push_back(twiceNatIter);
+            }
+            continue;
+        }
+        index -= walk.twiceNatKeys.size();
+
+        auto twiceNaptIter = m_twiceNaptEntries.find(walk.twiceNaptKeys[index]);
+        if (twiceNaptIter != m_twiceNaptEntries.end())
+        {
+            chunk.twiceNapt.push_back(twiceNaptIter);
+        }
+    }
+
+    if (walk.done())
+    {
+        walk = NatQueryWalk();
+    }
+}
+
+/* Get the attributes of the NAT entries in chunks of gMaxBulkSize, attr_count attributes
+ * per entry in attrs. Returns false if the SAI doesn't support the bulk get.
+ */
+bool NatOrch::bulkGetNatEntries(const std::vector<sai_nat_entry_t> &nat_entries, uint32_t attr_count,
+                                std::vector<sai_attribute_t> &attrs, std::vector<sai_status_t> &statuses)
+{
+    SWSS_LOG_ENTER();
+
+    statuses.assign(nat_entries.size(), SAI_STATUS_NOT_EXECUTED);
+    if (!m_bulkGetSupported || !sai_nat_api->get_nat_entries_attribute)
+    {
+        return false;
+    }
+
+    size_t bulkSize = max(gMaxBulkSize, (size_t)1);
+    for (size_t begin = 0; begin < nat_entries.size(); begin += bulkSize)
+    {
+        uint32_t count = (uint32_t)min(bulkSize, nat_entries.size() - begin);
+
+        std::vector<uint32_t> attr_counts(count, attr_count);
+        std::vector<sai_attribute_t *> attr_lists(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            attr_lists[i] = &attrs[(begin + i) * attr_count];
+        }
+
+        sai_status_t status = sai_nat_api->get_nat_entries_attribute(count, &nat_entries[begin], attr_counts.data(),
+                attr_lists.data(), SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, &statuses[begin]);
+        if (status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED)
+        {
+            SWSS_LOG_NOTICE("Bulk get of NAT entries is not supported, querying one entry at a time");
+            m_bulkGetSupported = false;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Read the hit bits of the dynamic entries in bulk ahead of the activity checks.
+ * A dry run of the checks records the NAT entries they query, see getHwHitBit().
+ */
+void NatOrch::bulkGetHitBits(const NatQueryChunk &chunk, time_t now)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_bulkGetSupported || !sai_nat_api->get_nat_entries_attribute)
+    {
+        return;
+    }
+
+    m_hitBitRecord = true;
+    for (const auto &natIter : chunk.nat)
+    {
+        checkIfNatEntryIsActive(natIter, now);
+    }
+    for (const auto &naptIter : chunk.napt)
+    {
+        checkIfNaptEntryIsActive(naptIter, now);
+    }
+    for (const auto &twiceNatIter : chunk.twiceNat)
+    {
+        checkIfTwiceNatEntryIsActive(twiceNatIter, now);
+    }
+    for (const auto &twiceNaptIter : chunk.twiceNapt)
+    {
+        checkIfTwiceNaptEntryIsActive(twiceNaptIter, now);
+    }
+    m_hitBitRecord = false;
+
+    // A query clears the hit bit, an entry checked twice is read once
+    std::vector<sai_nat_entry_t> queries;
+    std::unordered_set<sai_nat_entry_t> queried;
+    for (const auto &nat_entry : m_hitBitQueries)
+    {
+        if (queried.insert(nat_entry).second)
+        {
+            queries.push_back(nat_entry);
+        }
+    }
+    m_hitBitQueries.clear();
+
+    std::vector<sai_attribute_t> attrs(2 * queries.size());
+    std::vector<sai_status_t> statuses;
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        attrs[2 * i].id                 = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
+        attrs[2 * i].value.booldata     = 0;
+        attrs[2 * i + 1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
+        attrs[2 * i + 1].value.booldata = 1;
+    }
+
+    if (!bulkGetNatEntries(queries, 2, attrs, statuses))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        if (statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            m_hitBits[queries[i]] = attrs[2 * i].value.booldata;
+        }
+    }
+}
+
+/* Hit bit of a NAT entry, from the bulk results of bulkGetHitBits() if any.
+ * During the dry run the entry is only recorded and treated as not hit.
+ */
+sai_status_t NatOrch::getHwHitBit(const sai_nat_entry_t &nat_entry, uint32_t attr_count, sai_attribute_t *attr_list)
+{
+    if (m_hitBitRecord)
+    {
+        m_hitBitQueries.push_back(nat_entry);
+        attr_list[0].value.booldata = false;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    auto hitBit = m_hitBits.find(nat_entry);
+    if (hitBit != m_hitBits.end())
+    {
+        attr_list[0].value.booldata = hitBit->second;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    return sai_nat_api->get_nat_entry_attribute(&nat_entry, attr_count, attr_list);
+}
+
+/* Read the counters of the chunk's entries in bulk, recorded by a dry run of the counter queries */
+void NatOrch::bulkGetCounters(const NatQueryChunk &chunk)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_bulkGetSupported || !sai_nat_api->get_nat_entries_attribute)
+    {
+        return;
+    }
+
+    m_counterRecord = true;
+    for (const auto &natIter : chunk.nat)
+    {
+        getNatCounters(natIter);
+    }
+    for (const auto &naptIter : chunk.napt)
+    {
+        getNaptCounters(naptIter);
+    }
+    for (const auto &tnatIter : chunk.twiceNat)
+    {
+        getTwiceNatCounters(tnatIter);
+    }
+    for (const auto &tnaptIter : chunk.twiceNapt)
+    {
+        getTwiceNaptCounters(tnaptIter);
+    }
+    m_counterRecord = false;
+
+    std::vector<sai_nat_entry_t> queries;
+    queries.swap(m_counterQueries);
+
+    std::vector<sai_attribute_t> attrs(2 * queries.size());
+    std::vector<sai_status_t> statuses;
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        attrs[2 * i].id     = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
+        attrs[2 * i + 1].id = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
+    }
+
+    if (!bulkGetNatEntries(queries, 2, attrs, statuses))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        if (statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            m_counters[queries[i]] = make_pair(attrs[2 * i].value.u64, attrs[2 * i + 1].value.u64);
+        }
+    }
+}
+
+/* Byte and packet counts of a NAT entry, from the bulk results of bulkGetCounters() if any.
+ * During the dry run the entry is only recorded, and SAI_STATUS_NOT_EXECUTED returned.
+ */
+sai_status_t NatOrch::getHwCounters(const sai_nat_entry_t &nat_entry, uint32_t attr_count, sai_attribute_t *attr_list)
+{
+    if (m_counterRecord)
+    {
+        m_counterQueries.push_back(nat_entry);
+        return SAI_STATUS_NOT_EXECUTED;
+    }
+
+    auto counters = m_counters.find(nat_entry);
+    if (counters != m_counters.end())
+    {
+        attr_list[0].value.u64 = counters->second.first;
+        attr_list[1].value.u64 = counters->second.second;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    return sai_nat_api->get_nat_entry_attribute(&nat_entry, attr_count, attr_list);
+}
+
 void NatOrch::updateAllConntrackEntries(void)
 {
     SWSS_LOG_ENTER();
@@ -3542,7 +3977,12 @@ bool NatOrch::getNatCounters(const NatEntry::iterator &iter)
         nat_entry.data.mask.src_ip = 0xffffffff;
     }
 
-    status = sai_nat_api->get_nat_entry_attribute(&nat_entry, attr_count, nat_entry_attr);
+    status = getHwCounters(nat_entry, attr_count, nat_entry_attr);
+    if (status == SAI_STATUS_NOT_EXECUTED)
+    {
+        /* Recorded for the bulk get */
+        return 0;
+    }
     if (entry.nat_type == "snat")
     {
         if (status != SAI_STATUS_SUCCESS)
@@ -3606,7 +4046,12 @@ bool NatOrch::getTwiceNatCounters(const TwiceNatEntry::iterator &iter)
     dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
     dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
 
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
+    status = getHwCounters(dbl_nat_entry, attr_count, nat_entry_attr);
+    if (status == SAI_STATUS_NOT_EXECUTED)
+    {
+        /* Recorded for the bulk get */
+        return 0;
+    }
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to get Counters for Twice NAT entry [src-ip %s, dst-ip %s], bytes = %" PRIu64 ", pkts = %" PRIu64 "",
@@ -3749,7 +4194,12 @@ bool NatOrch::getNaptCounters(const NaptEntry::iterator &iter)
     nat_entry.data.key.proto        = protoType;
     nat_entry.data.mask.proto       = 0xff;
 
-    status = sai_nat_api->get_nat_entry_attribute(&nat_entry, attr_count, nat_entry_attr);
+    status = getHwCounters(nat_entry, attr_count, nat_entry_attr);
+    if (status == SAI_STATUS_NOT_EXECUTED)
+    {
+        /* Recorded for the bulk get */
+        return 0;
+    }
 
     if (entry.nat_type == "snat")
     { 
@@ -3824,7 +4274,12 @@ bool NatOrch::getTwiceNaptCounters(const TwiceNaptEntry::iterator &iter)
     dbl_nat_entry.data.key.proto = protoType;
     dbl_nat_entry.data.mask.proto = 0xff;
 
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
+    status = getHwCounters(dbl_nat_entry, attr_count, nat_entry_attr);
+    if (status == SAI_STATUS_NOT_EXECUTED)
+    {
+        /* Recorded for the bulk get */
+        return 0;
+    }
 
     if (status != SAI_STATUS_SUCCESS)
     {
@@ -4177,7 +4632,7 @@ bool NatOrch::checkIfNatEntryIsActive(const NatEntry::iterator &iter, time_t now
     snat_entry.data.key.src_ip   = srcIp.getV4Addr();
     snat_entry.data.mask.src_ip  = 0xffffffff;
 
-    status = sai_nat_api->get_nat_entry_attribute(&snat_entry, attr_count, nat_entry_attr);
+    status = getHwHitBit(snat_entry, attr_count, nat_entry_attr);
     if (status == SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_DEBUG("SNAT HIT BIT for src-ip %s = %d", srcIp.to_string().c_str(),
@@ -4209,7 +4664,7 @@ bool NatOrch::checkIfNatEntryIsActive(const NatEntry::iterator &iter, time_t now
             dnat_entry.data.key.dst_ip   = entry.translated_ip.getV4Addr();
             dnat_entry.data.mask.dst_ip  = 0xffffffff;
 
-            status = sai_nat_api->get_nat_entry_attribute(&dnat_entry, attr_count, nat_entry_attr);
+            status = getHwHitBit(dnat_entry, attr_count, nat_entry_attr);
             if (status == SAI_STATUS_SUCCESS)
             {
                 SWSS_LOG_DEBUG("DNAT HIT BIT for dst-ip %s = %d", entry.translated_ip.to_string().c_str(),
@@ -4278,7 +4733,7 @@ bool NatOrch::checkIfNaptEntryIsActive(const NaptEntry::iterator &iter, time_t n
     snat_entry.data.key.proto        = (uint8_t)protoType;
     snat_entry.data.mask.proto       = 0xff;
 
-    status = sai_nat_api->get_nat_entry_attribute(&snat_entry, attr_count, nat_entry_attr);
+    status = getHwHitBit(snat_entry, attr_count, nat_entry_attr);
     if (status == SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_DEBUG("SNAPT HIT BIT for proto %s, src-ip %s, src-port %d = %d", naptKey.prototype.c_str(),
@@ -4321,7 +4776,7 @@ bool NatOrch::checkIfNaptEntryIsActive(const NaptEntry::iterator &iter, time_t n
             dnat_entry.data.key.proto        = (uint8_t)protoType;
             dnat_entry.data.mask.proto       = 0xff;
 
-            status = sai_nat_api->get_nat_entry_attribute(&dnat_entry, attr_count, nat_entry_attr);
+            status = getHwHitBit(dnat_entry, attr_count, nat_entry_attr);
             if (status == SAI_STATUS_SUCCESS)
             {
                 SWSS_LOG_DEBUG("DNAPT HIT BIT for proto %s, dst-ip %s, dst-port %d = %d", naptKey.prototype.c_str(),
@@ -4374,7 +4829,7 @@ bool NatOrch::checkIfTwiceNatEntryIsActive(const TwiceNatEntry::iterator &iter,
     dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
     dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
 
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
+    status = getHwHitBit(dbl_nat_entry, attr_count, nat_entry_attr);
     if (status == SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_DEBUG("Twice NAT HIT BIT for src-ip %s, dst-ip %s = %d",
@@ -4432,7 +4887,7 @@ bool NatOrch::checkIfTwiceNaptEntryIsActive(const TwiceNaptEntry::iterator &iter
     dbl_nat_entry.data.key.proto = protoType;
     dbl_nat_entry.data.mask.proto = 0xff;
 
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
+    status = getHwHitBit(dbl_nat_entry, attr_count, nat_entry_attr);
     if (status == SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_DEBUG("Twice NAPT HIT BIT for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d] = %d",
@@ -4476,6 +4931,8 @@ void NatOrch::doTask(NotificationConsumer& consumer)
         SWSS_LOG_NOTICE("Received RedisDB and ASIC  cleanup notification on NAT docker stop");
         cleanupAppDbEntries();
     }
+
+    m_countersPipeline->flush();
 }
 
 void NatOrch::updateStaticNatCounters(int count)
@@ -17,6 +17,11 @@
 #ifndef SWSS_NATORCH_H
 #define SWSS_NATORCH_H
 
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "orch.h"
 #include "observer.h"
 #include "portsorch.h"
@@ -29,6 +34,8 @@
 #include "routeorch.h"
 #include "nexthopgroupkey.h"
 #include "notificationproducer.h"
+#include "bulker.h"
+#include "redispipeline.h"
 #ifdef DEBUG_FRAMEWORK
 #include "debugdumporch.h"
 #endif
@@ -37,6 +44,7 @@
 #define NAT_HITBIT_N_CNTRS_QUERY_PERIOD   5        // 5 secs
 #define NAT_CONNTRACK_TIMEOUT_PERIOD      86400    // 1 day
 #define NAT_HITBIT_QUERY_MULTIPLE         6        // Hit bits are queried every 30 secs
+#define NAT_QUERY_MIN_ENTRIES_PER_TICK    1024     // Entries queried per tick at least, a walk takes up to NAT_HITBIT_QUERY_MULTIPLE ticks
 
 struct NatEntryValue
 {
@@ -176,6 +184,46 @@ struct DnatEntries
 
 typedef std::map<IpAddress, DnatEntries> DnatNhResolvCache;
 
+/* NAT entry create or remove queued in the NAT bulker */
+struct NatBulkOp
+{
+    sai_status_t                        status;
+    // Bookkeeping of the entry, run with its status after the flush
+    std::function<bool(sai_status_t)>   post;
+};
+
+/* Keys of the entries a hit bit or counter query walks, the walk is spread
+ * across timer ticks and visits the entries still there when reached.
+ */
+struct NatQueryWalk
+{
+    std::vector<IpAddress>             natKeys;
+    std::vector<NaptEntryKey>          naptKeys;
+    std::vector<TwiceNatEntryKey>      twiceNatKeys;
+    std::vector<TwiceNaptEntryKey>     twiceNaptKeys;
+    size_t                             next = 0;
+    size_t                             entriesPerTick = 0;
+
+    size_t size() const
+    {
+        return natKeys.size() + naptKeys.size() + twiceNatKeys.size() + twiceNaptKeys.size();
+    }
+
+    bool done() const
+    {
+        return next >= size();
+    }
+};
+
+/* Entries of a walk queried on one timer tick */
+struct NatQueryChunk
+{
+    std::vector<NatEntry::iterator>        nat;
+    std::vector<NaptEntry::iterator>       napt;
+    std::vector<TwiceNatEntry::iterator>   twiceNat;
+    std::vector<TwiceNaptEntry::iterator>  twiceNapt;
+};
+
 class NatOrch: public Orch, public Subject, public Observer
 {
 public:
@@ -203,6 +251,8 @@ private:
     SelectableTimer        *m_natQueryTimer;
     SelectableTimer        *m_natTimeoutTimer;
     DBConnector             m_countersDb;
+    // Entry counters are written through the pipeline, flushed at the end of each task
+    std::unique_ptr<RedisPipeline> m_countersPipeline;
     Table                   m_countersNatTable;
     Table                   m_countersNaptTable;
     Table                   m_countersTwiceNatTable;
@@ -225,6 +275,25 @@ private:
      * or indirect NextHop (via route) to reach the DNAT IP is changed. */
     DnatNhResolvCache       m_nhResolvCache;
 
+    /* While a NAT table task is processed the NAT entries are created and removed
+     * in bulk, see createHwNatEntry() */
+    EntityBulker<sai_nat_api_t> m_natBulker;
+    bool                    m_natBulkMode;
+    std::deque<NatBulkOp>   m_natBulkOps;
+
+    /* Hit bits and counters read in bulk by queryHitBits() and queryCounters(),
+     * see getHwHitBit() and getHwCounters() */
+    bool                    m_bulkGetSupported;
+    bool                    m_hitBitRecord;
+    std::vector<sai_nat_entry_t> m_hitBitQueries;
+    std::unordered_map<sai_nat_entry_t, bool> m_hitBits;
+    bool                    m_counterRecord;
+    std::vector<sai_nat_entry_t> m_counterQueries;
+    // Byte and packet counts
+    std::unordered_map<sai_nat_entry_t, std::pair<uint64_t, uint64_t>> m_counters;
+    NatQueryWalk            m_hitBitWalk;
+    NatQueryWalk            m_counterWalk;
+
     int              timeout;
     int              tcp_timeout;
     int              udp_timeout;
@@ -288,11 +357,23 @@ private:
     bool removeHwDnaptEntry(const NaptEntryKey &key);
     bool addHwDnatPoolEntry(const IpAddress &dstIp);
     bool removeHwDnatPoolEntry(const IpAddress &dstIp);
+    bool createHwNatEntry(const sai_nat_entry_t &nat_entry, uint32_t attr_count, const sai_attribute_t *attr_list,
+                          std::function<bool(sai_status_t)> post);
+    bool removeHwNatEntry(const sai_nat_entry_t &nat_entry, std::function<bool(sai_status_t)> post);
+    void flushHwNatEntries(void);
 
     bool checkIfNatEntryIsActive(const NatEntry::iterator &iter, time_t now);
     bool checkIfNaptEntryIsActive(const NaptEntry::iterator &iter, time_t now);
     bool checkIfTwiceNatEntryIsActive(const TwiceNatEntry::iterator &iter, time_t now);
     bool checkIfTwiceNaptEntryIsActive(const TwiceNaptEntry::iterator &iter, time_t now);
+    void bulkGetHitBits(const NatQueryChunk &chunk, time_t now);
+    sai_status_t getHwHitBit(const sai_nat_entry_t &nat_entry, uint32_t attr_count, sai_attribute_t *attr_list);
+    void bulkGetCounters(const NatQueryChunk &chunk);
+    sai_status_t getHwCounters(const sai_nat_entry_t &nat_entry, uint32_t attr_count, sai_attribute_t *attr_list);
+    bool bulkGetNatEntries(const std::vector<sai_nat_entry_t> &nat_entries, uint32_t attr_count,
+                           std::vector<sai_attribute_t> &attrs, std::vector<sai_status_t> &statuses);
+    void startQueryWalk(NatQueryWalk &walk);
+    void nextQueryChunk(NatQueryWalk &walk, NatQueryChunk &chunk);
 
     void enableNatFeature(void);
     void disableNatFeature(void);
@@ -29,17 +29,21 @@ extern bool isChassisDbInUse();
 
 const int neighorch_pri = 30;
 
-NeighOrch::NeighOrch(DBConnector *appDb, string tableName, IntfsOrch *intfsOrch, FdbOrch *fdbOrch, PortsOrch *portsOrch, DBConnector *chassisAppDb) :
+NeighOrch::NeighOrch(DBConnector *appDb, string tableName, IntfsOrch *intfsOrch, FdbOrch *fdbOrch, PortsOrch *portsOrch, DBConnector *chassisAppDb, ZmqServer *zmqServer) :
+        ZmqOrch(appDb, vector<table_name_with_pri_t>{ { tableName, neighorch_pri } }, zmqServer),
         gNeighBulker(sai_neighbor_api, gMaxBulkSize),
         gNextHopBulker(sai_next_hop_api, gSwitchId, gMaxBulkSize),
-        Orch(appDb, tableName, neighorch_pri),
         m_intfsOrch(intfsOrch),
         m_fdbOrch(fdbOrch),
         m_portsOrch(portsOrch),
-        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME)
+        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME),
+        m_neighborEvents([](const NeighborUpdate &update) { return update.entry; })
 {
     SWSS_LOG_ENTER();
 
+    /* Neighbor processing is independent of the key order, use the hashed task store */
+    setTaskStoreMode(tableName, SyncMap::Mode::Hashed);
+
     m_fdbOrch->attach(this);
 
     // Some UTs instantiate NeighOrch but gBfdOrch is null, it is not null in orchagent
@@ -54,11 +58,15 @@ NeighOrch::NeighOrch(DBConnector *appDb, string tableName, IntfsOrch *intfsOrch,
         tableName = CHASSIS_APP_SYSTEM_NEIGH_TABLE_NAME;
         Orch::addExecutor(new Consumer(new SubscriberStateTable(chassisAppDb, tableName, TableConsumable::DEFAULT_POP_BATCH_SIZE, 0), this, tableName));
         m_tableVoqSystemNeighTable = unique_ptr<Table>(new Table(chassisAppDb, CHASSIS_APP_SYSTEM_NEIGH_TABLE_NAME));
+        m_chassisAppPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(chassisAppDb));
+        m_voqSystemNeighWriter = unique_ptr<Table>(new Table(m_chassisAppPipeline.get(), CHASSIS_APP_SYSTEM_NEIGH_TABLE_NAME, true));
+        loadVoqSyncedNeighs(chassisAppDb);
 
         //STATE DB connection for setting state of the remote neighbor SAI programming
         unique_ptr<DBConnector> stateDb;
         stateDb = make_unique<DBConnector>("STATE_DB", 0);
-        m_stateSystemNeighTable = unique_ptr<Table>(new Table(stateDb.get(), STATE_SYSTEM_NEIGH_TABLE_NAME));
+        m_stateSystemNeighPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(stateDb.get()));
+        m_stateSystemNeighTable = unique_ptr<Table>(new Table(m_stateSystemNeighPipeline.get(), STATE_SYSTEM_NEIGH_TABLE_NAME, true));
     }
 }
 
@@ -70,6 +78,12 @@ NeighOrch::~NeighOrch()
     }
 }
 
+void NeighOrch::getObjectCounts(vector<FieldValueTuple> &counts) const
+{
+    counts.emplace_back("neighbors", to_string(m_syncdNeighbors.size()));
+    counts.emplace_back("next_hops", to_string(m_syncdNextHops.size()));
+}
+
 /**
  * @brief Checks SAI layer's capability to support NO_HOST_ROUTE neighbor attribute.
  *        Used for programming mux neighbors in prefix-route mode.
@@ -234,21 +248,37 @@ bool NeighOrch::isNeighborResolved(const NextHopKey &nexthop)
     return hasNextHop(base_nexthop);
 }
 
+/*
+ * Wake up the routes parked in the RouteOrch RetryCache until the next hop
+ * of this neighbor exists
+ */
+void NeighOrch::notifyNextHopAdded(const NextHopKey &nexthop)
+{
+    if (gRouteOrch == nullptr || nexthop.isMplsNextHop())
+    {
+        return;
+    }
+
+    notifyRetry(gRouteOrch, APP_ROUTE_TABLE_NAME,
+                make_constraint(RETRY_CST_NEIGH, NextHopKey(nexthop.ip_address, nexthop.alias).to_string()));
+}
+
 bool NeighOrch::addNextHop(NeighborContext& ctx)
 {
     SWSS_LOG_ENTER();
     const NextHopKey nh = ctx.neighborEntry;
 
-    Port p;
-    if (!gPortsOrch->getPort(nh.alias, p))
+    const Port *p = gPortsOrch->findPort(nh.alias);
+    if (!p)
     {
         SWSS_LOG_ERROR("Neighbor %s seen on port %s which doesn't exist",
                         nh.ip_address.to_string().c_str(), nh.alias.c_str());
         return false;
     }
-    if (p.m_type == Port::SUBPORT)
+    if (p->m_type == Port::SUBPORT)
     {
-        if (!gPortsOrch->getPort(p.m_parent_port_id, p))
+        p = gPortsOrch->findPort(p->m_parent_port_id);
+        if (!p)
         {
             SWSS_LOG_ERROR("Neighbor %s seen on sub interface %s whose parent port doesn't exist",
                             nh.ip_address.to_string().c_str(), nh.alias.c_str());
@@ -270,9 +300,10 @@ bool NeighOrch::addNextHop(NeighborContext& ctx)
     assert(!hasNextHop(nexthop));
     sai_object_id_t rif_id = m_intfsOrch->getRouterIntfsId(nh.alias);
 
-    vector<sai_attribute_t> next_hop_attrs;
+    SaiAttrList<> next_hop_attrs;
 
-    vector<Label> label_stack;
+    // The bulker keeps the attributes only, the label list lives in the context
+    vector<Label>& label_stack = ctx.label_stack;
     sai_attribute_t next_hop_attr;
     if (nexthop.isMplsNextHop())
     {
@@ -346,6 +377,8 @@ bool NeighOrch::addNextHop(NeighborContext& ctx)
     next_hop_entry.nh_flags = 0;
     m_syncdNextHops[nexthop] = next_hop_entry;
 
+    notifyNextHopAdded(nexthop);
+
     m_intfsOrch->increaseRouterIntfsRefCount(nh.alias);
 
     if (nexthop.isMplsNextHop())
@@ -370,7 +403,7 @@ bool NeighOrch::addNextHop(NeighborContext& ctx)
     // flag should be set on it.
     // This scenario may happen under race condition where buffered neighbor event
     // is processed after incoming port is down.
-    if (p.m_oper_status == SAI_PORT_OPER_STATUS_DOWN)
+    if (p->m_oper_status == SAI_PORT_OPER_STATUS_DOWN)
     {
         if (setNextHopFlag(nexthop, NHFLAGS_IFDOWN) == false)
         {
@@ -381,22 +414,62 @@ bool NeighOrch::addNextHop(NeighborContext& ctx)
     return true;
 }
 
+/*
+ * Create next hops in bulk. A next hop the bulk did not create is left to
+ * the single create of its user, which reports and retries the failure.
+ */
+void NeighOrch::addNextHops(std::list<NeighborContext>& bulk_ctx_list)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto ctx = bulk_ctx_list.begin(); ctx != bulk_ctx_list.end(); )
+    {
+        ctx->bulk_op = true;
+        ctx->next_hop_id = SAI_NULL_OBJECT_ID;
+
+        if (!addNextHop(*ctx))
+        {
+            ctx = bulk_ctx_list.erase(ctx);
+            continue;
+        }
+        ctx++;
+    }
+
+    if (bulk_ctx_list.empty())
+    {
+        return;
+    }
+
+    gNextHopBulker.flush();
+
+    for (auto& ctx : bulk_ctx_list)
+    {
+        if (ctx.next_hop_id != SAI_NULL_OBJECT_ID)
+        {
+            processBulkAddNextHop(ctx);
+        }
+    }
+
+    gNextHopBulker.clear();
+}
+
 bool NeighOrch::processBulkAddNextHop(NeighborContext& ctx)
 {
     SWSS_LOG_ENTER();
 
     const NextHopKey nh = ctx.neighborEntry;
 
-    Port p;
-    if (!gPortsOrch->getPort(nh.alias, p))
+    const Port *p = gPortsOrch->findPort(nh.alias);
+    if (!p)
     {
         SWSS_LOG_ERROR("Neighbor %s seen on port %s which doesn't exist",
                         nh.ip_address.to_string().c_str(), nh.alias.c_str());
         return false;
     }
-    if (p.m_type == Port::SUBPORT)
+    if (p->m_type == Port::SUBPORT)
     {
-        if (!gPortsOrch->getPort(p.m_parent_port_id, p))
+        p = gPortsOrch->findPort(p->m_parent_port_id);
+        if (!p)
         {
             SWSS_LOG_ERROR("Neighbor %s seen on sub interface %s whose parent port doesn't exist",
                             nh.ip_address.to_string().c_str(), nh.alias.c_str());
@@ -405,6 +478,16 @@ bool NeighOrch::processBulkAddNextHop(NeighborContext& ctx)
     }
 
     NextHopKey nexthop(nh);
+    if (m_intfsOrch->isRemoteSystemPortIntf(nh.alias))
+    {
+        //For remote system ports kernel nexthops are always on inband. Change the key
+        Port inbp;
+        gPortsOrch->getInbandPort(inbp);
+        assert(inbp.m_alias.length());
+
+        nexthop.alias = inbp.m_alias;
+    }
+
     if (ctx.next_hop_id == SAI_NULL_OBJECT_ID)
     {
         sai_status_t bulker_status = gNextHopBulker.create_status(ctx.next_hop_id);
@@ -438,6 +521,8 @@ bool NeighOrch::processBulkAddNextHop(NeighborContext& ctx)
     next_hop_entry.nh_flags = 0;
     m_syncdNextHops[nexthop] = next_hop_entry;
 
+    notifyNextHopAdded(nexthop);
+
     m_intfsOrch->increaseRouterIntfsRefCount(nh.alias);
 
     if (nexthop.isMplsNextHop())
@@ -462,7 +547,7 @@ bool NeighOrch::processBulkAddNextHop(NeighborContext& ctx)
     // flag should be set on it.
     // This scenario may happen under race condition where buffered neighbor event
     // is processed after incoming port is down.
-    if (p.m_oper_status == SAI_PORT_OPER_STATUS_DOWN)
+    if (p->m_oper_status == SAI_PORT_OPER_STATUS_DOWN)
     {
         if (setNextHopFlag(nexthop, NHFLAGS_IFDOWN) == false)
         {
@@ -874,7 +959,7 @@ bool NeighOrch::getNeighborEntry(const IpAddress &ipAddress, NeighborEntry &neig
     return getNeighborEntry(nexthop, neighborEntry, macAddress);
 }
 
-void NeighOrch::doTask(Consumer &consumer)
+void NeighOrch::doTask(ConsumerBase &consumer)
 {
     SWSS_LOG_ENTER();
 
@@ -890,10 +975,12 @@ void NeighOrch::doTask(Consumer &consumer)
         return;
     }
 
+    m_batchVoqSync = isChassisDbInUse();
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        const KeyOpFieldsValuesTuple &t = it->second;
 
         string key = kfvKey(t);
         string op = kfvOp(t);
@@ -1041,6 +1128,8 @@ void NeighOrch::doTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushVoqSync();
 }
 
 /* Gets all neighbor entries tied to a given mux port */
@@ -1213,7 +1302,7 @@ bool NeighOrch::addNeighbor(NeighborContext& ctx)
     neighbor_entry.switch_id = gSwitchId;
     copy(neighbor_entry.ip_address, ip_address);
 
-    vector<sai_attribute_t> neighbor_attrs;
+    SaiAttrList<> neighbor_attrs;
     sai_attribute_t neighbor_attr;
 
     neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS;
@@ -1312,7 +1401,7 @@ bool NeighOrch::addNeighbor(NeighborContext& ctx)
 
     if (gMySwitchType == "voq")
     {
-        if (!addVoqEncapIndex(alias, ip_address, neighbor_attrs))
+        if (!addVoqEncapIndex(alias, ip_address, neighbor_attrs, ctx.voq_encap_index))
         {
             return false;
         }
@@ -1429,6 +1518,7 @@ bool NeighOrch::addNeighbor(NeighborContext& ctx)
 
     NeighborUpdate update = { neighborEntry, macAddress, true };
     notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+    m_neighborEvents.publish(update);
 
     if(isChassisDbInUse())
     {
@@ -1598,6 +1688,7 @@ bool NeighOrch::removeNeighbor(NeighborContext& ctx, bool disable)
 
     NeighborUpdate update = { neighborEntry, MacAddress(), false };
     notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+    m_neighborEvents.publish(update);
 
     if(isChassisDbInUse())
     {
@@ -1712,6 +1803,7 @@ bool NeighOrch::processBulkEnableNeighbor(NeighborContext& ctx)
 
     NeighborUpdate update = { neighborEntry, macAddress, true };
     notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+    m_neighborEvents.publish(update);
 
     return true;
 }
@@ -2045,7 +2137,7 @@ bool NeighOrch::removeTunnelNextHop(const NextHopKey& nh)
     return true;
 }
 
-void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
+void NeighOrch::doVoqSystemNeighTask(ConsumerBase &consumer)
 {
     SWSS_LOG_ENTER();
 
@@ -2067,6 +2159,123 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
         }
     }
 
+    //MAC of the neighbor for kernel programming by neighbor manager, set in STATE DB
+    auto setStateSystemNeigh = [&](const string &state_key, MacAddress mac_address) {
+        //If the inband interface type is not VLAN, same MAC can be used for the inband interface for
+        //kernel programming.
+        if(ibif.m_type != Port::VLAN)
+        {
+            string platform = getenv("ASIC_VENDOR") ? getenv("ASIC_VENDOR") : "";
+            // For VS platform, use the original MAC address
+            if (platform != VS_PLATFORM_SUBSTRING)
+            {
+                mac_address = gMacAddress;
+            }
+        }
+        vector<FieldValueTuple> fvVector;
+        FieldValueTuple mac("neigh", mac_address.to_string());
+        fvVector.push_back(mac);
+        m_stateSystemNeighTable->set(state_key, fvVector);
+    };
+
+    /* Remove remaining DEL operation in m_toSync for the same neighbor.
+     * Since DEL operation is supposed to be executed before SET for the same neighbor
+     * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
+     */
+    auto eraseSetTask = [&](SyncMap::iterator task) {
+        string key = task->first;
+        auto next_task = consumer.m_toSync.erase(task);
+        auto rit = make_reverse_iterator(next_task);
+        while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+        {
+            consumer.m_toSync.erase(next(rit).base());
+            SWSS_LOG_NOTICE("Removed pending system neighbor DEL operation for %s after SET operation", key.c_str());
+        }
+        return next_task;
+    };
+
+    /*
+     * New remote neighbors are created in bulk along with their next hops.
+     * The pending creations are flushed before any other operation of the
+     * round, so the operations on a neighbor still apply in order.
+     */
+    std::list<NeighborContext> bulk_ctx_list;
+    vector<SyncMap::iterator> bulk_tasks;
+
+    auto flushBulkNeighbors = [&]() {
+        if (bulk_ctx_list.empty())
+        {
+            return;
+        }
+
+        gNeighBulker.flush();
+
+        //Without bulk neighbor support nothing was created, the neighbors and their next hops are added one by one
+        bool bulk_unsupported = false;
+        for (const auto &ctx : bulk_ctx_list)
+        {
+            if (!ctx.object_statuses.empty())
+            {
+                bulk_unsupported = is_bulk_unsupported(ctx.object_statuses.front());
+                break;
+            }
+        }
+
+        if (bulk_unsupported)
+        {
+            gNextHopBulker.clear();
+        }
+        else
+        {
+            gNextHopBulker.flush();
+        }
+
+        auto task = bulk_tasks.begin();
+        for (auto ctx = bulk_ctx_list.begin(); ctx != bulk_ctx_list.end(); ctx++, task++)
+        {
+            const NeighborEntry &neighbor_entry = ctx->neighborEntry;
+            if (bulk_unsupported)
+            {
+                NeighborContext single_ctx = NeighborContext(neighbor_entry);
+                single_ctx.mac = ctx->mac;
+                single_ctx.voq_encap_index = ctx->voq_encap_index;
+                if (!addNeighbor(single_ctx))
+                {
+                    SWSS_LOG_INFO("Failed to create system neighbor %s", (*task)->first.c_str());
+                    continue;
+                }
+            }
+            else if (!ctx->object_statuses.empty() && !processBulkEnableNeighbor(*ctx))
+            {
+                SWSS_LOG_INFO("Failed to create system neighbor %s", (*task)->first.c_str());
+
+                //The next hop of a neighbor that failed is not tracked, remove it so that the retry creates it again
+                if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end() &&
+                    ctx->next_hop_id != SAI_NULL_OBJECT_ID &&
+                    sai_next_hop_api->remove_next_hop(ctx->next_hop_id) != SAI_STATUS_SUCCESS)
+                {
+                    SWSS_LOG_ERROR("Failed to remove next hop of system neighbor %s", (*task)->first.c_str());
+                }
+                continue;
+            }
+
+            //The neighbor was created with this encap index, no need to read it back from SAI
+            auto neigh = m_syncdNeighbors.find(neighbor_entry);
+            if (neigh != m_syncdNeighbors.end())
+            {
+                neigh->second.voq_encap_index = ctx->voq_encap_index;
+            }
+
+            //neigh successfully added to SAI. Set STATE DB to signal kernel programming by neighbor manager
+            setStateSystemNeigh(neighbor_entry.alias + state_db_key_delimiter + neighbor_entry.ip_address.to_string(), ctx->mac);
+            eraseSetTask(*task);
+        }
+
+        gNeighBulker.clear();
+        bulk_ctx_list.clear();
+        bulk_tasks.clear();
+    };
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -2116,7 +2325,7 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
                 continue;
             }
 
-            MacAddress mac_address, original_mac_address;
+            MacAddress mac_address;
             uint32_t encap_index = 0;
             for (auto i = kfvFieldsValues(t).begin();
                  i  != kfvFieldsValues(t).end(); i++)
@@ -2137,7 +2346,9 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
                 it++;
                 continue;
             }
-            if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end())
+
+            auto neigh = m_syncdNeighbors.find(neighbor_entry);
+            if (neigh == m_syncdNeighbors.end())
             {
                 NextHopKey nexthop = { ip_address, ibif.m_alias};
                 if (hasNextHop(nexthop))
@@ -2145,15 +2356,29 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
                     it++;
                     continue;
                 }
+
+                //Queue the new neigh for bulk creation in SAI
+                bulk_ctx_list.emplace_back(neighbor_entry, true);
+                NeighborContext &ctx = bulk_ctx_list.back();
+                ctx.mac = mac_address;
+                ctx.voq_encap_index = encap_index;
+                ctx.next_hop_id = SAI_NULL_OBJECT_ID;
+                if (!addNeighbor(ctx))
+                {
+                    bulk_ctx_list.pop_back();
+                    it++;
+                    continue;
+                }
+
+                bulk_tasks.push_back(it++);
+                continue;
             }
 
-            if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end() ||
-                    m_syncdNeighbors[neighbor_entry].mac != mac_address ||
-                    m_syncdNeighbors[neighbor_entry].voq_encap_index != encap_index)
-            {
+            flushBulkNeighbors();
 
-                if (m_syncdNeighbors.find(neighbor_entry) != m_syncdNeighbors.end() &&
-                    m_syncdNeighbors[neighbor_entry].voq_encap_index != encap_index)
+            if (neigh->second.mac != mac_address || neigh->second.voq_encap_index != encap_index)
+            {
+                if (neigh->second.voq_encap_index != encap_index)
                 {
 
                     // Encap index changed. Set encap index attribute with new encap index
@@ -2181,48 +2406,19 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
                     else
                     {
                         SWSS_LOG_NOTICE("VOQ encap index updated for neighbor %s", kfvKey(t).c_str());
-                        it = consumer.m_toSync.erase(it);
-
-                       /* Remove remaining DEL operation in m_toSync for the same neighbor.
-                        * Since DEL operation is supposed to be executed before SET for the same neighbor
-                        * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
-                        */
-                       auto rit = make_reverse_iterator(it);
-                       while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
-                       {
-                           consumer.m_toSync.erase(next(rit).base());
-                           SWSS_LOG_NOTICE("Removed pending system neighbor DEL operation for %s after SET operation", key.c_str());
-                       }
+                        it = eraseSetTask(it);
                     }
                     continue;
                 }
 
-                //Add neigh to SAI
+                //Update neigh in SAI
                 NeighborContext ctx = NeighborContext(neighbor_entry);
                 ctx.mac = mac_address;
+                ctx.voq_encap_index = encap_index;
                 if (addNeighbor(ctx))
                 {
-                    //neigh successfully added to SAI. Set STATE DB to signal kernel programming by neighbor manager
-
-                    //If the inband interface type is not VLAN, same MAC can be used for the inband interface for
-                    //kernel programming.
-                    if(ibif.m_type != Port::VLAN)
-                    {
-                        original_mac_address = mac_address;
-                        mac_address = gMacAddress;
-                        string platform = getenv("ASIC_VENDOR") ? getenv("ASIC_VENDOR") : "";
-                        // For VS platform, use the original MAC address
-                        if (platform == VS_PLATFORM_SUBSTRING)
-                        {
-                            mac_address = original_mac_address;
-                        }
-                    }
-                    vector<FieldValueTuple> fvVector;
-                    FieldValueTuple mac("neigh", mac_address.to_string());
-                    fvVector.push_back(mac);
-                    m_stateSystemNeighTable->set(state_key, fvVector);
-
-                    it = consumer.m_toSync.erase(it);
+                    //neigh successfully updated in SAI. Set STATE DB to signal kernel programming by neighbor manager
+                    setStateSystemNeigh(state_key, mac_address);
                 }
                 else
                 {
@@ -2234,22 +2430,14 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
             {
                 /* Duplicate entry */
                 SWSS_LOG_INFO("System neighbor %s already exists", kfvKey(t).c_str());
-                it = consumer.m_toSync.erase(it);
             }
 
-            /* Remove remaining DEL operation in m_toSync for the same neighbor.
-             * Since DEL operation is supposed to be executed before SET for the same neighbor
-             * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
-             */
-            auto rit = make_reverse_iterator(it);
-            while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
-            {
-                consumer.m_toSync.erase(next(rit).base());
-                SWSS_LOG_NOTICE("Removed pending system neighbor DEL operation for %s after SET operation", key.c_str());
-            }
+            it = eraseSetTask(it);
         }
         else if (op == DEL_COMMAND)
         {
+            flushBulkNeighbors();
+
             if (m_syncdNeighbors.find(neighbor_entry) != m_syncdNeighbors.end())
             {
                 //Remove neigh from SAI
@@ -2276,6 +2464,9 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushBulkNeighbors();
+    m_stateSystemNeighPipeline->flush();
 }
 
 bool NeighOrch::addInbandNeighbor(string alias, IpAddress ip_address)
@@ -2556,14 +2747,13 @@ bool NeighOrch::getSystemPortNeighEncapIndex(string &alias, IpAddress &ip, uint3
     return false;
 }
 
-bool NeighOrch::addVoqEncapIndex(string &alias, IpAddress &ip, vector<sai_attribute_t> &neighbor_attrs)
+bool NeighOrch::addVoqEncapIndex(string &alias, IpAddress &ip, SaiAttrList<> &neighbor_attrs, uint32_t encap_index)
 {
     sai_attribute_t attr;
-    uint32_t encap_index = 0;
 
     if(gIntfsOrch->isRemoteSystemPortIntf(alias))
     {
-        if(getSystemPortNeighEncapIndex(alias, ip, encap_index))
+        if(encap_index || getSystemPortNeighEncapIndex(alias, ip, encap_index))
         {
             attr.id = SAI_NEIGHBOR_ENTRY_ATTR_ENCAP_INDEX;
             attr.value.u32 = encap_index;
@@ -2651,7 +2841,24 @@ void NeighOrch::voqSyncAddNeigh(string &alias, IpAddress &ip_address, const MacA
     attrs.push_back(macFv);
 
     string key = alias + m_tableVoqSystemNeighTable->getTableNameSeparator().c_str() + ip_address.to_string();
-    m_tableVoqSystemNeighTable->set(key, attrs);
+
+    //Skip the neighbors already in CHASSIS_APP_DB with the same contents, e.g. on a resync
+    string digest = fvValue(eiFv) + "," + fvValue(macFv);
+    auto synced = m_voqSyncedNeighs.find(key);
+    if (synced != m_voqSyncedNeighs.end() && synced->second == digest)
+    {
+        return;
+    }
+    m_voqSyncedNeighs[key] = digest;
+
+    if (m_batchVoqSync)
+    {
+        m_voqSystemNeighWriter->set(key, attrs);
+    }
+    else
+    {
+        m_tableVoqSystemNeighTable->set(key, attrs);
+    }
 }
 
 void NeighOrch::voqSyncDelNeigh(string &alias, IpAddress &ip_address)
@@ -2685,7 +2892,67 @@ void NeighOrch::voqSyncDelNeigh(string &alias, IpAddress &ip_address)
     }
 
     string key = alias + m_tableVoqSystemNeighTable->getTableNameSeparator().c_str() + ip_address.to_string();
-    m_tableVoqSystemNeighTable->del(key);
+    m_voqSyncedNeighs.erase(key);
+
+    if (m_batchVoqSync)
+    {
+        m_voqSystemNeighWriter->del(key);
+    }
+    else
+    {
+        m_tableVoqSystemNeighTable->del(key);
+    }
+}
+
+void NeighOrch::loadVoqSyncedNeighs(DBConnector *chassisAppDb)
+{
+    SWSS_LOG_ENTER();
+
+    //The local neighbors synced before a restart are still in CHASSIS_APP_DB, so only
+    //the ones that changed meanwhile are synced again. Their keys start with the hostname.
+    if (gMyHostName.empty())
+    {
+        return;
+    }
+
+    string separator = m_tableVoqSystemNeighTable->getTableNameSeparator();
+    string prefix = string(CHASSIS_APP_SYSTEM_NEIGH_TABLE_NAME) + separator;
+
+    for (const auto &dbKey : chassisAppDb->keys(prefix + gMyHostName + separator + "*"))
+    {
+        string key = dbKey.substr(prefix.size());
+        vector<FieldValueTuple> fvs;
+        if (!m_tableVoqSystemNeighTable->get(key, fvs))
+        {
+            continue;
+        }
+
+        string encap_index, mac;
+        for (const auto &fv : fvs)
+        {
+            if (fvField(fv) == "encap_index")
+            {
+                encap_index = fvValue(fv);
+            }
+            else if (fvField(fv) == "neigh")
+            {
+                mac = fvValue(fv);
+            }
+        }
+        m_voqSyncedNeighs[key] = encap_index + "," + mac;
+    }
+
+    SWSS_LOG_NOTICE("Loaded %zu local neighbors synced to CHASSIS_APP_DB", m_voqSyncedNeighs.size());
+}
+
+void NeighOrch::flushVoqSync()
+{
+    m_batchVoqSync = false;
+
+    if (m_chassisAppPipeline)
+    {
+        m_chassisAppPipeline->flush();
+    }
 }
 
 bool NeighOrch::updateVoqNeighborEncapIndex(const NeighborEntry &neighborEntry, uint32_t encap_index)
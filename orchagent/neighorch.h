@@ -2,6 +2,8 @@
 #define SWSS_NEIGHORCH_H
 
 #include "orch.h"
+#include "zmqorch.h"
+#include "zmqserver.h"
 #include "observer.h"
 #include "portsorch.h"
 #include "intfsorch.h"
@@ -13,6 +15,11 @@
 #include "schema.h"
 #include "bfdorch.h"
 #include "bulker.h"
+#include "redispipeline.h"
+#include "memaccounting.h"
+#include "saiattrlist.h"
+
+#include <unordered_map>
 
 #define NHFLAGS_IFDOWN                  0x1 // nexthop's outbound i/f is down
 
@@ -33,8 +40,11 @@ struct NeighborData
     bool          prefix_route = false; // True means full prefix route is created for this neighbor
 };
 
+MEM_ACCOUNTING_TAG(NeighborMemTag, "NeighOrch|neighbors");
+
 /* NeighborTable: NeighborEntry, neighbor MAC address */
-typedef map<NeighborEntry, NeighborData> NeighborTable;
+typedef map<NeighborEntry, NeighborData, less<NeighborEntry>,
+            MemAccountingAllocator<pair<const NeighborEntry, NeighborData>, NeighborMemTag>> NeighborTable;
 /* NextHopTable: NextHopKey, NextHopEntry */
 typedef map<NextHopKey, NextHopEntry> NextHopTable;
 
@@ -56,6 +66,8 @@ struct NeighborContext
     bool                                bulk_op = false;            // use bulker (only for mux use for now)
     sai_object_id_t                     next_hop_id;                // next hop id
     sai_status_t                        nexthop_status;             // next hop status
+    uint32_t                            voq_encap_index = 0;        // encap index of a remote neighbor, looked up in CHASSIS_APP_DB if 0
+    std::vector<Label>                  label_stack;                // MPLS next hop label stack, kept until the bulk is flushed
 
     NeighborContext(NeighborEntry neighborEntry)
         : neighborEntry(neighborEntry)
@@ -68,15 +80,16 @@ struct NeighborContext
     }
 };
 
-class NeighOrch : public Orch, public Subject, public Observer
+class NeighOrch : public ZmqOrch, public Subject, public Observer
 {
 public:
-    NeighOrch(DBConnector *db, string tableName, IntfsOrch *intfsOrch, FdbOrch *fdbOrch, PortsOrch *portsOrch, DBConnector *chassisAppDb);
+    NeighOrch(DBConnector *db, string tableName, IntfsOrch *intfsOrch, FdbOrch *fdbOrch, PortsOrch *portsOrch, DBConnector *chassisAppDb, swss::ZmqServer *zmqServer = nullptr);
     ~NeighOrch();
 
     bool hasNextHop(const NextHopKey&);
     bool isNeighborResolved(const NextHopKey&);
     bool addNextHop(NeighborContext& ctx);
+    void addNextHops(std::list<NeighborContext>&);
     bool removeMplsNextHop(const NextHopKey&);
 
     sai_object_id_t getNextHopId(const NextHopKey&);
@@ -91,6 +104,11 @@ public:
 
     const NeighborTable& getNeighborTable() const { return m_syncdNeighbors; }
 
+    /* Batched SUBJECT_TYPE_NEIGH_CHANGE, coalesced by neighbor */
+    EventBus<NeighborEntry, NeighborUpdate>& getNeighborEvents() { return m_neighborEvents; }
+
+    void getObjectCounts(std::vector<FieldValueTuple> &counts) const override;
+
     bool enableNeighbor(const NeighborEntry&);
     bool disableNeighbor(const NeighborEntry&);
     bool enableNeighbors(std::list<NeighborContext>&);
@@ -127,6 +145,7 @@ private:
     IntfsOrch *m_intfsOrch;
     FdbOrch *m_fdbOrch;
     ProducerStateTable m_appNeighResolveProducer;
+    EventBus<NeighborEntry, NeighborUpdate> m_neighborEvents;
 
     NeighborTable m_syncdNeighbors;
     NextHopTable m_syncdNextHops;
@@ -138,6 +157,7 @@ private:
 
     bool removeNextHop(const IpAddress&, const string&);
     bool processBulkAddNextHop(NeighborContext&);
+    void notifyNextHopAdded(const NextHopKey&);
 
     bool addNeighbor(NeighborContext& ctx);
     bool removeNeighbor(NeighborContext& ctx, bool disable = false);
@@ -152,13 +172,25 @@ private:
     bool removePrefixRouteForNeighbor(const IpAddress& ip_address, sai_object_id_t vrf_id);
     void processFDBFlushUpdate(const FdbFlushUpdate &);
 
-    void doTask(Consumer &consumer);
-    void doVoqSystemNeighTask(Consumer &consumer);
+    void doTask(ConsumerBase &consumer) override;
+    void doVoqSystemNeighTask(ConsumerBase &consumer);
 
     unique_ptr<Table> m_tableVoqSystemNeighTable;
+    unique_ptr<RedisPipeline> m_stateSystemNeighPipeline;
     unique_ptr<Table> m_stateSystemNeighTable;
+
+    /* Local neighbors are synced to CHASSIS_APP_DB through a pipeline while m_batchVoqSync is set */
+    unique_ptr<RedisPipeline> m_chassisAppPipeline;
+    unique_ptr<Table> m_voqSystemNeighWriter;
+    bool m_batchVoqSync = false;
+
+    /* Contents of the local neighbors in CHASSIS_APP_DB by key, unchanged neighbors are not synced again */
+    std::unordered_map<string, string> m_voqSyncedNeighs;
+
+    void loadVoqSyncedNeighs(DBConnector *chassisAppDb);
+    void flushVoqSync();
     bool getSystemPortNeighEncapIndex(string &alias, IpAddress &ip, uint32_t &encap_index);
-    bool addVoqEncapIndex(string &alias, IpAddress &ip, vector<sai_attribute_t> &neighbor_attrs);
+    bool addVoqEncapIndex(string &alias, IpAddress &ip, SaiAttrList<> &neighbor_attrs, uint32_t encap_index = 0);
     void voqSyncAddNeigh(string &alias, IpAddress &ip_address, const MacAddress &mac, sai_neighbor_entry_t &neighbor_entry);
     void voqSyncDelNeigh(string &alias, IpAddress &ip_address);
     bool updateVoqNeighborEncapIndex(const NeighborEntry &neighborEntry, uint32_t encap_index);
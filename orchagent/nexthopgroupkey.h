@@ -2,6 +2,10 @@
 #define SWSS_NEXTHOPGROUPKEY_H
 
 #include "nexthopkey.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <boost/functional/hash.hpp>
 
 class NextHopGroupKey
@@ -260,4 +264,191 @@ namespace std {
     };
 }
 
+/*
+ * Reference to an interned, immutable NextHopGroupKey.
+ *
+ * Tables holding a key per entry, e.g. the syncd routes, the FG NHG routes
+ * and the route bulk contexts, keep a reference instead of a copy of the
+ * key, so entries with the same next hops share one key. The hash of an
+ * interned key is computed once, and parse() maps the next hop strings
+ * seen in APPL_DB to their key without tokenizing them again. A key is
+ * released with its last reference. Not thread safe, the keys are interned
+ * on the orchagent main thread.
+ */
+class NextHopGroupKeyRef
+{
+public:
+    NextHopGroupKeyRef() = default;
+    NextHopGroupKeyRef(const NextHopGroupKey &key) : m_node(intern(key)) {}
+
+    NextHopGroupKeyRef &operator=(const NextHopGroupKey &key)
+    {
+        if (&key != &get())
+        {
+            m_node = intern(key);
+        }
+        return *this;
+    }
+
+    /* Key of ip_string@if_alias next hops separated by ',', see NextHopGroupKey() */
+    static NextHopGroupKeyRef parse(const std::string &nexthops, bool overlay_nh = false, bool srv6_nh = false)
+    {
+        std::string alias = (overlay_nh ? "o" : (srv6_nh ? "s" : "n")) + std::string(1, '\0') + nexthops;
+        return lookup(alias, [&]() { return NextHopGroupKey(nexthops, overlay_nh, srv6_nh); });
+    }
+
+    static NextHopGroupKeyRef parse(const std::string &nexthops, const std::string &weights)
+    {
+        std::string alias = "w" + std::string(1, '\0') + weights + std::string(1, '\0') + nexthops;
+        return lookup(alias, [&]() { return NextHopGroupKey(nexthops, weights); });
+    }
+
+    const NextHopGroupKey &get() const
+    {
+        return m_node ? m_node->key : empty();
+    }
+
+    size_t hash() const
+    {
+        return m_node ? m_node->hash : std::hash<NextHopGroupKey>()(empty());
+    }
+
+    operator const NextHopGroupKey &() const { return get(); }
+    const NextHopGroupKey &operator*() const { return get(); }
+    const NextHopGroupKey *operator->() const { return &get(); }
+
+    inline bool operator==(const NextHopGroupKeyRef &o) const
+    {
+        return m_node == o.m_node || (hash() == o.hash() && get() == o.get());
+    }
+
+    inline bool operator!=(const NextHopGroupKeyRef &o) const
+    {
+        return !(*this == o);
+    }
+
+    friend inline bool operator==(const NextHopGroupKeyRef &a, const NextHopGroupKey &b) { return a.get() == b; }
+    friend inline bool operator==(const NextHopGroupKey &a, const NextHopGroupKeyRef &b) { return a == b.get(); }
+    friend inline bool operator!=(const NextHopGroupKeyRef &a, const NextHopGroupKey &b) { return !(a.get() == b); }
+    friend inline bool operator!=(const NextHopGroupKey &a, const NextHopGroupKeyRef &b) { return !(a == b.get()); }
+
+    /* Number of distinct keys currently interned */
+    static size_t internedCount()
+    {
+        return pool().keys.size();
+    }
+
+private:
+    struct Node
+    {
+        Node(const NextHopGroupKey &key) : key(key), hash(std::hash<NextHopGroupKey>()(key)) {}
+
+        const NextHopGroupKey key;
+        const size_t hash;
+        // Strings parsed to this key
+        std::vector<std::string> aliases;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const NextHopGroupKey *key) const
+        {
+            return std::hash<NextHopGroupKey>()(*key);
+        }
+    };
+
+    struct KeyEqual
+    {
+        bool operator()(const NextHopGroupKey *a, const NextHopGroupKey *b) const
+        {
+            return *a == *b
+                && a->is_overlay_nexthop() == b->is_overlay_nexthop()
+                && a->is_srv6_nexthop() == b->is_srv6_nexthop()
+                && a->is_srv6_vpn() == b->is_srv6_vpn();
+        }
+    };
+
+    struct Pool
+    {
+        std::unordered_map<const NextHopGroupKey *, std::weak_ptr<Node>, KeyHash, KeyEqual> keys;
+        // Interned keys by address, callers often pass a key they got from a reference
+        std::unordered_map<const NextHopGroupKey *, std::weak_ptr<Node>> nodes;
+        std::unordered_map<std::string, std::weak_ptr<Node>> aliases;
+    };
+
+    static Pool &pool()
+    {
+        // Never destroyed, references in static tables may outlive it otherwise
+        static Pool *p = new Pool();
+        return *p;
+    }
+
+    static const NextHopGroupKey &empty()
+    {
+        static const NextHopGroupKey key;
+        return key;
+    }
+
+    static std::shared_ptr<Node> intern(const NextHopGroupKey &key)
+    {
+        auto &p = pool();
+
+        auto node = p.nodes.find(&key);
+        if (node != p.nodes.end())
+        {
+            return node->second.lock();
+        }
+
+        auto it = p.keys.find(&key);
+        if (it != p.keys.end())
+        {
+            return it->second.lock();
+        }
+
+        std::shared_ptr<Node> interned(new Node(key), [](Node *n) {
+            auto &p = pool();
+            p.keys.erase(&n->key);
+            p.nodes.erase(&n->key);
+            for (const auto &alias : n->aliases)
+            {
+                p.aliases.erase(alias);
+            }
+            delete n;
+        });
+        p.keys.emplace(&interned->key, interned);
+        p.nodes.emplace(&interned->key, interned);
+        return interned;
+    }
+
+    template <typename F>
+    static NextHopGroupKeyRef lookup(const std::string &alias, F &&make)
+    {
+        auto &p = pool();
+        NextHopGroupKeyRef ref;
+
+        auto it = p.aliases.find(alias);
+        if (it != p.aliases.end())
+        {
+            ref.m_node = it->second.lock();
+            return ref;
+        }
+
+        ref.m_node = intern(make());
+        ref.m_node->aliases.push_back(alias);
+        p.aliases.emplace(alias, ref.m_node);
+        return ref;
+    }
+
+    std::shared_ptr<Node> m_node;
+};
+
+namespace std {
+    template <>
+    struct hash<NextHopGroupKeyRef> {
+        size_t operator()(const NextHopGroupKeyRef& obj) const {
+            return obj.hash();
+        }
+    };
+}
+
 #endif /* SWSS_NEXTHOPGROUPKEY_H */
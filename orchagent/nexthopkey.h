@@ -13,6 +13,7 @@ extern "C"
 #include "tokenize.h"
 #include "label.h"
 #include "intfsorch.h"
+#include "aliasinterner.h"
 
 #define LABELSTACK_DELIMITER '+'
 #define NH_DELIMITER '@'
@@ -25,7 +26,7 @@ struct NextHopKey
     // Note: When adding a new field to NextHopKey, make sure to also update
     // the hash_value method to incorporate the new field into the hash calculation.
     IpAddress           ip_address;     // neighbor IP address
-    string              alias;          // incoming interface alias
+    AliasId             alias;          // incoming interface alias, interned
     uint32_t            vni;            // Encap VNI overlay nexthop
     MacAddress          mac_address;    // Overlay Nexthop MAC.
     LabelStack          label_stack;    // MPLS label stack
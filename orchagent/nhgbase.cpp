@@ -3,6 +3,7 @@
 #include "rediscommand.h"
 
 extern sai_object_id_t gSwitchId;
+extern RouteOrch *gRouteOrch;
 
 unsigned NhgBase::m_syncdCount = 0;
 
@@ -41,4 +42,10 @@ void NhgBase::decSyncedCount()
     }
 
     --m_syncdCount;
+
+    /* Routes waiting for a next hop group may now get one */
+    if (gRouteOrch)
+    {
+        gRouteOrch->notifyNextHopGroupReleased();
+    }
 }
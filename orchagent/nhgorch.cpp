@@ -110,7 +110,7 @@ void NhgOrch::doTask(Consumer& consumer)
 
             /* Create the next hop group key. */
             string nhg_str;
-            NextHopGroupKey nhg_key;
+            NextHopGroupKeyRef nhg_key;
 
             /* Keeps track of any non-existing member of a recursive nexthop group */
             bool non_existent_member = false;
@@ -198,9 +198,9 @@ void NhgOrch::doTask(Consumer& consumer)
                 }
 
                 if (srv6_nh)
-                    nhg_key = NextHopGroupKey(nhg_str, overlay_nh, srv6_nh);
+                    nhg_key = NextHopGroupKeyRef::parse(nhg_str, overlay_nh, srv6_nh);
                 else
-                    nhg_key = NextHopGroupKey(nhg_str, weights);
+                    nhg_key = NextHopGroupKeyRef::parse(nhg_str, weights);
             }
             else
             {
@@ -220,7 +220,7 @@ void NhgOrch::doTask(Consumer& consumer)
                         nhg_str += srv6_srcv[i] + NH_DELIMITER; // srv6 source
                         nhg_str += NH_DELIMITER;                // srv6 vpn sid
                     }
-                    nhg_key = NextHopGroupKey(nhg_str, overlay_nh, srv6_nh);
+                    nhg_key = NextHopGroupKeyRef::parse(nhg_str, overlay_nh, srv6_nh);
                 }
                 else
                 {
@@ -233,7 +233,7 @@ void NhgOrch::doTask(Consumer& consumer)
                         }
                         nhg_str += ipv[i] + NH_DELIMITER + alsv[i];
                     }
-                    nhg_key = NextHopGroupKey(nhg_str, weights);
+                    nhg_key = NextHopGroupKeyRef::parse(nhg_str, weights);
                 }
             }
 
@@ -254,7 +254,7 @@ void NhgOrch::doTask(Consumer& consumer)
                     SWSS_LOG_DEBUG("Next hop group count reached its limit.");
 
                     // don't create temp nhg for srv6
-                    if (nhg_key.is_srv6_nexthop())
+                    if (nhg_key->is_srv6_nexthop())
                     {
                         ++it;
                         continue;
@@ -271,14 +271,14 @@ void NhgOrch::doTask(Consumer& consumer)
                         {
                             SWSS_LOG_INFO("Failed to sync temporary NHG %s with %s",
                                 index.c_str(),
-                                nhg_key.to_string().c_str());
+                                nhg_key->to_string().c_str());
                         }
                     }
                     catch (const std::exception& e)
                     {
                         SWSS_LOG_INFO("Got exception: %s while adding temp group %s",
                             e.what(),
-                            nhg_key.to_string().c_str());
+                            nhg_key->to_string().c_str());
                     }
                 }
                 else
@@ -300,6 +300,7 @@ void NhgOrch::doTask(Consumer& consumer)
                             success = false;
                         }
                         m_syncdNextHopGroups.emplace(index, NhgEntry<NextHopGroup>(std::move(nhg)));
+                        indexShareableNhg(index);
                     }
                 }
             }
@@ -326,7 +327,7 @@ void NhgOrch::doTask(Consumer& consumer)
                      * the new key.  Otherwise, this will be a no-op as we have
                      * to wait for resources in order to promote the group.
                      */
-                    if (!nhg_key.contains(nhg_ptr->getKey()))
+                    if (!nhg_key->contains(nhg_ptr->getKey()))
                     {
                         try
                         {
@@ -347,14 +348,14 @@ void NhgOrch::doTask(Consumer& consumer)
                             {
                                 SWSS_LOG_INFO("Failed to sync updated temp NHG %s with %s",
                                   index.c_str(),
-                                  nhg_key.to_string().c_str());
+                                  nhg_key->to_string().c_str());
                             }
                         }
                         catch (const std::exception& e)
                         {
                             SWSS_LOG_INFO("Got exception: %s while adding temp group %s",
                                 e.what(),
-                                nhg_key.to_string().c_str());
+                                nhg_key->to_string().c_str());
                         }
                     }
                 }
@@ -374,12 +375,22 @@ void NhgOrch::doTask(Consumer& consumer)
                          * it to be removed and freed.
                          */
                         nhg_it->second.nhg = std::move(nhg);
+                        indexShareableNhg(index);
                     }
                 }
+                /*
+                 * Routes sharing the group have to get a group of their own
+                 * before its next hops change.
+                 */
+                else if (nhg_ptr->getKey() != nhg_key && !unshareNhg(index))
+                {
+                    SWSS_LOG_INFO("Unable to unshare group %s, skip updating it", index.c_str());
+                }
                 /* Common update, when all the requirements are met. */
                 else
                 {
                     success = nhg_ptr->update(nhg_key);
+                    indexShareableNhg(index);
 
                     /* Keep the msg in loop if any member path is not available yet */
                     if (is_recursive && non_existent_member)
@@ -410,6 +421,11 @@ void NhgOrch::doTask(Consumer& consumer)
                 /* Mark the operation as successful to consume it. */
                 success = true;
             }
+            /* Routes only sharing the group get a group of their own. */
+            else if (!unshareNhg(index))
+            {
+                SWSS_LOG_INFO("Unable to unshare group %s, skip removing it", index.c_str());
+            }
             /* If the group does exist, but it's still referenced, skip. */
             else if (nhg_it->second.ref_count > 0)
             {
@@ -447,6 +463,88 @@ void NhgOrch::doTask(Consumer& consumer)
     }
 }
 
+/*
+ * Purpose:     Get a group which routes with the given next hops may share.
+ * Description: Routes listing the next hops of a NEXTHOP_GROUP_TABLE group
+ *              reuse that group instead of having RouteOrch sync another one
+ *              with the same members.
+ * Params:      IN  nhg_key - The next hops of the route.
+ * Returns:     The index of the group, empty if there is none.
+ */
+string NhgOrch::getShareableNhg(const NextHopGroupKey& nhg_key) const
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_shareableNhgs.find(nhg_key);
+
+    if ((it == m_shareableNhgs.end()) || !getNhg(it->second).isSynced())
+    {
+        return string();
+    }
+
+    return it->second;
+}
+
+/*
+ * Purpose:     Index a group by its next hops if routes may share it.
+ * Params:      IN  index - The index of the group.
+ * Returns:     Nothing.
+ */
+void NhgOrch::indexShareableNhg(const string& index)
+{
+    SWSS_LOG_ENTER();
+
+    const auto& nhg = getNhg(index);
+
+    /*
+     * Groups of a single member are the member's next hop and temporary
+     * groups do not hold all the next hops of their key, so neither can
+     * stand for a route's next hop group.
+     */
+    if (!nhg.isSynced() || nhg.isTemp() || nhg.isRecursive() || (nhg.getSize() <= 1))
+    {
+        return;
+    }
+
+    /* Keep the first group indexed if several have the same next hops. */
+    m_shareableNhgs.emplace(nhg.getKey(), index);
+}
+
+/*
+ * Purpose:     Remove a group from the shareable groups index.
+ * Params:      IN  index - The index of the group.
+ * Returns:     Nothing.
+ */
+void NhgOrch::unindexShareableNhg(const string& index)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_shareableNhgs.find(getNhg(index).getKey());
+
+    if ((it != m_shareableNhgs.end()) && (it->second == index))
+    {
+        m_shareableNhgs.erase(it);
+    }
+}
+
+/*
+ * Purpose:     Stop sharing a group with RouteOrch.
+ * Description: The group is no more given to new routes.  The routes already
+ *              sharing it are moved to a group synced by RouteOrch, so the
+ *              group can be updated or removed without changing them.
+ * Params:      IN  index - The index of the group.
+ * Returns:     true, if no route shares the group anymore;
+ *              false, otherwise.
+ */
+bool NhgOrch::unshareNhg(const string& index)
+{
+    SWSS_LOG_ENTER();
+
+    unindexShareableNhg(index);
+
+    return gRouteOrch->unshareNextHopGroup(index, getNhg(index).getKey());
+}
+
 /*
  * Purpose:     Validate a next hop for any groups that contains it.
  * Description: Iterate over all next hop groups and validate the next hop in
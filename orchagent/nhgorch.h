@@ -129,6 +129,25 @@ public:
     bool validateNextHop(const NextHopKey& nh_key);
     bool invalidateNextHop(const NextHopKey& nh_key);
 
+    /*
+     * Get the index of a synced group with the given next hops which routes
+     * listing the same next hops may share, empty if there is none.
+     */
+    string getShareableNhg(const NextHopGroupKey& nhg_key) const;
+
 private:
+    /*
+     * Groups which routes may share, indexed by their next hops.  Only the
+     * synced, non temporary, non recursive groups of more than one member
+     * are indexed.
+     */
+    unordered_map<NextHopGroupKey, string> m_shareableNhgs;
+
+    void indexShareableNhg(const string& index);
+    void unindexShareableNhg(const string& index);
+
+    /* Stop sharing a group which is about to change with RouteOrch. */
+    bool unshareNhg(const string& index);
+
     void doTask(Consumer& consumer) override;
 };
@@ -101,6 +101,9 @@ void on_switch_shutdown_request(sai_object_id_t switch_id)
     /* TODO: Later a better restart story will be told here */
     SWSS_LOG_ERROR("Syncd stopped");
 
+    // The ASIC/SDK health events not flushed yet would be lost on exit
+    gSwitchOrch->flushPendingAsicSdkHealthEvents();
+
     if (gSwitchOrch->isFatalEventReceived())
     {
         SWSS_LOG_ERROR("Orchagent aborted due to fatal SAI error received");
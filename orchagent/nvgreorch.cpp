@@ -384,7 +384,7 @@ bool NvgreTunnelOrch::delOperation(const Request& request)
     return true;
 }
 
-/** @brief Creates tunnel map entry in SAI.
+/** @brief Builds the SAI attributes of a tunnel map entry.
  *
  *  @param map_type      map type - VLAN or BRIDGE.
  *  @param vsid          Virtual Subnet ID value.
@@ -392,9 +392,9 @@ bool NvgreTunnelOrch::delOperation(const Request& request)
  *  @param bridge_obj_id SAI bridge object.
  *  @param encap         encapsulation flag.
  *
- *  @return SAI tunnel map entry ID.
+ *  @return SAI tunnel map entry attributes.
  */
-sai_object_id_t NvgreTunnel::sai_create_tunnel_map_entry(
+std::vector<sai_attribute_t> NvgreTunnel::get_tunnel_map_entry_attrs(
     map_type_t map_type,
     sai_uint32_t vsid,
     sai_vlan_id_t vlan_id,
@@ -402,7 +402,6 @@ sai_object_id_t NvgreTunnel::sai_create_tunnel_map_entry(
     bool encap)
 {
     sai_attribute_t attr;
-    sai_object_id_t tunnel_map_entry_id;
     std::vector<sai_attribute_t> tunnel_map_entry_attrs;
 
     attr.id = SAI_TUNNEL_MAP_ENTRY_ATTR_TUNNEL_MAP_TYPE;
@@ -429,36 +428,52 @@ sai_object_id_t NvgreTunnel::sai_create_tunnel_map_entry(
     attr.value.u32 = vsid;
     tunnel_map_entry_attrs.push_back(attr);
 
-    sai_status_t status = sai_tunnel_api->create_tunnel_map_entry(&tunnel_map_entry_id, gSwitchId,
-                                            static_cast<uint32_t> (tunnel_map_entry_attrs.size()),
-                                            tunnel_map_entry_attrs.data());
-
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        throw std::runtime_error("Can't create the NVGRE tunnel map entry object");
-    }
-
-    return tunnel_map_entry_id;
+    return tunnel_map_entry_attrs;
 }
 
-
-bool NvgreTunnel::addDecapMapperEntry(
+void NvgreTunnel::addDecapMapperEntry(
+    TunnelMapEntryBulker &bulker,
     map_type_t map_type,
     uint32_t vsid,
     sai_vlan_id_t vlan_id,
     std::string tunnel_map_entry_name,
     sai_object_id_t bridge_obj)
 {
-    auto tunnel_map_entry_id = sai_create_tunnel_map_entry(map_type, vsid, vlan_id, bridge_obj);
-
-    nvgre_tunnel_map_table_[tunnel_map_entry_name].map_entry_id = tunnel_map_entry_id;
+    bulker.create(get_tunnel_map_entry_attrs(map_type, vsid, vlan_id, bridge_obj),
+        [this, tunnel_map_entry_name](sai_object_id_t tunnel_map_entry_id)
+        {
+            auto it = nvgre_tunnel_map_table_.find(tunnel_map_entry_name);
+            if (it == nvgre_tunnel_map_table_.end())
+            {
+                return;
+            }
+
+            if (tunnel_map_entry_id == SAI_NULL_OBJECT_ID)
+            {
+                // Forgotten so that the entry is created again when it is set again
+                SWSS_LOG_ERROR("Can't create the NVGRE decap tunnel map entry '%s' for tunnel '%s'",
+                    tunnel_map_entry_name.c_str(), tunnel_name_.c_str());
+                nvgre_tunnel_map_table_.erase(it);
+                return;
+            }
+
+            it->second.map_entry_id = tunnel_map_entry_id;
+
+            SWSS_LOG_INFO("NVGRE decap tunnel map entry '%s' for tunnel '%s' was created",
+                tunnel_map_entry_name.c_str(), tunnel_name_.c_str());
+        });
+
+    nvgre_tunnel_map_table_[tunnel_map_entry_name].map_entry_id = SAI_NULL_OBJECT_ID;
     nvgre_tunnel_map_table_[tunnel_map_entry_name].vlan_id = vlan_id;
     nvgre_tunnel_map_table_[tunnel_map_entry_name].vsid = vsid;
+}
 
-    SWSS_LOG_INFO("NVGRE decap tunnel map entry '%s' for tunnel '%s' was created",
-        tunnel_map_entry_name.c_str(), tunnel_name_.c_str());
+void NvgreTunnelMapOrch::doTask(Consumer& consumer)
+{
+    SWSS_LOG_ENTER();
 
-    return true;
+    Orch2::doTask(consumer);
+    map_entry_bulker_.flush();
 }
 
 bool NvgreTunnelMapOrch::addOperation(const Request& request)
@@ -499,56 +514,33 @@ bool NvgreTunnelMapOrch::addOperation(const Request& request)
         return true;
     }
 
-    if (!tunnel_obj->addDecapMapperEntry(MAP_T_VLAN, vsid, vlan_id, full_tunnel_map_entry_name))
-    {
-        return true;
-    }
+    tunnel_obj->addDecapMapperEntry(map_entry_bulker_, MAP_T_VLAN, vsid, vlan_id, full_tunnel_map_entry_name);
 
     return true;
 }
 
-/** @brief Removes tunnel map entry in SAI.
- *
- *  @param obj_id SAI tunnel map identifier.
- *
- *  @return void.
- */
-void NvgreTunnel::sai_remove_tunnel_map_entry(sai_object_id_t obj_id)
+void NvgreTunnel::delMapperEntry(TunnelMapEntryBulker &bulker, std::string tunnel_map_entry_name)
 {
-    sai_status_t status = SAI_STATUS_SUCCESS;
-
-    if (obj_id != SAI_NULL_OBJECT_ID)
-    {
-        status = sai_tunnel_api->remove_tunnel_map_entry(obj_id);
-    }
-
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        throw std::runtime_error("Can't delete the NVGRE tunnel map entry object");
-    }
-}
-
-bool NvgreTunnel::delMapperEntry(std::string tunnel_map_entry_name)
-{
-    auto tunnel_map_entry_id = getMapEntryId(tunnel_map_entry_name);
-
-    try
-    {
-        sai_remove_tunnel_map_entry(tunnel_map_entry_id);
-    }
-    catch (const std::runtime_error& error)
-    {
-        SWSS_LOG_ERROR("Error while removing decap tunnel map %s: %s",
-            tunnel_map_entry_name.c_str(), error.what());
-        return false;
-    }
+    auto entry = nvgre_tunnel_map_table_.at(tunnel_map_entry_name);
 
+    // Forgotten right away so that the entry can be set again in the same batch
     nvgre_tunnel_map_table_.erase(tunnel_map_entry_name);
 
-    SWSS_LOG_INFO("NVGRE tunnel map entry '%s' for tunnel '%s' was removed",
-        tunnel_map_entry_name.c_str(), tunnel_name_.c_str());
-
-    return true;
+    bulker.remove(entry.map_entry_id,
+        [this, tunnel_map_entry_name, entry](bool removed)
+        {
+            if (!removed)
+            {
+                // Kept so that deleting the entry again retries the removal
+                SWSS_LOG_ERROR("Can't remove the NVGRE decap tunnel map entry '%s' for tunnel '%s'",
+                    tunnel_map_entry_name.c_str(), tunnel_name_.c_str());
+                nvgre_tunnel_map_table_.emplace(tunnel_map_entry_name, entry);
+                return;
+            }
+
+            SWSS_LOG_INFO("NVGRE tunnel map entry '%s' for tunnel '%s' was removed",
+                tunnel_map_entry_name.c_str(), tunnel_name_.c_str());
+        });
 }
 
 bool NvgreTunnelMapOrch::delOperation(const Request& request)
@@ -573,10 +565,7 @@ bool NvgreTunnelMapOrch::delOperation(const Request& request)
         return true;
     }
 
-    if (!tunnel_obj->delMapperEntry(full_tunnel_map_entry_name))
-    {
-        return true;
-    }
+    tunnel_obj->delMapperEntry(map_entry_bulker_, full_tunnel_map_entry_name);
 
     return true;
 }
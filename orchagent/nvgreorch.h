@@ -6,6 +6,7 @@
 #include "orch.h"
 #include "request_parser.h"
 #include "portsorch.h"
+#include "vxlanorch.h"
 
 typedef enum {
     MAP_T_VLAN = 0,
@@ -74,9 +75,11 @@ public:
         return nvgre_tunnel_map_table_.at(tunnel_map_entry_name).vsid;
     }
 
-    bool addDecapMapperEntry(map_type_t map_type, uint32_t vsid, sai_vlan_id_t vlan_id, std::string tunnel_map_entry_name, sai_object_id_t bridge_obj=SAI_NULL_OBJECT_ID);
+    /* The entry is queued in the bulker, its id is set on flush */
+    void addDecapMapperEntry(TunnelMapEntryBulker &bulker, map_type_t map_type, uint32_t vsid, sai_vlan_id_t vlan_id, std::string tunnel_map_entry_name, sai_object_id_t bridge_obj=SAI_NULL_OBJECT_ID);
 
-    bool delMapperEntry(std::string tunnel_map_entry_name);
+    /* The entry is forgotten, and restored on flush if it could not be removed */
+    void delMapperEntry(TunnelMapEntryBulker &bulker, std::string tunnel_map_entry_name);
 
 private:
     void createNvgreMappers();
@@ -94,8 +97,7 @@ private:
     sai_object_id_t sai_create_tunnel_termination(sai_object_id_t tunnel_id, const sai_ip_address_t &src_ip, sai_object_id_t default_vrid);
     void sai_remove_tunnel_termination(sai_object_id_t tunnel_term_id);
 
-    sai_object_id_t sai_create_tunnel_map_entry(map_type_t map_type, sai_uint32_t vsid, sai_vlan_id_t vlan_id, sai_object_id_t bridge_obj_id, bool encap=false);
-    void sai_remove_tunnel_map_entry(sai_object_id_t obj_id);
+    std::vector<sai_attribute_t> get_tunnel_map_entry_attrs(map_type_t map_type, sai_uint32_t vsid, sai_vlan_id_t vlan_id, sai_object_id_t bridge_obj_id, bool encap=false);
 
     std::string tunnel_name_;
     IpAddress src_ip_;
@@ -160,8 +162,11 @@ public:
     {}
 
 private:
+    virtual void doTask(Consumer& consumer);
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
 
     NvgreTunnelMapRequest request_;
+    // The map entries of all the tunnels, flushed at the end of doTask()
+    TunnelMapEntryBulker map_entry_bulker_;
 };
\ No newline at end of file
@@ -1,7 +1,13 @@
 #ifndef SWSS_OBSERVER_H
 #define SWSS_OBSERVER_H
 
+#include <exception>
+#include <functional>
 #include <list>
+#include <map>
+#include <vector>
+
+#include "logger.h"
 
 using namespace std;
 using namespace swss;
@@ -61,4 +67,204 @@ protected:
     }
 };
 
+/*
+ * Batched notifications, an opt-in alternative to Subject::notify().
+ *
+ * Subject::notify() runs every observer in the middle of the publisher's
+ * doTask(), and whatever the observers notify in turn nests deeper still.
+ * An EventBus instead queues the events published while an EventBatch is
+ * open, keeps the last event of each key, and hands them to each subscriber
+ * as one vector once the outermost batch of the thread is closed. Events
+ * published while a batch is delivered are queued behind it rather than
+ * nested in it.
+ *
+ * Consumer::drain() opens a batch around doTask(), so the events of a table
+ * reach the subscribers once the table is served. Outside of a batch events
+ * are delivered right away. Like Subject::notify(), a bus is published to
+ * and delivered on the thread serving its Orch.
+ */
+class EventBusBase
+{
+public:
+    virtual ~EventBusBase() {}
+
+    /* Hand the queued events to the subscribers */
+    virtual void deliver() = 0;
+};
+
+class EventBatch
+{
+public:
+    EventBatch()
+    {
+        state().depth++;
+    }
+
+    ~EventBatch()
+    {
+        if (--state().depth == 0)
+        {
+            flush();
+        }
+    }
+
+    EventBatch(const EventBatch &) = delete;
+    EventBatch &operator=(const EventBatch &) = delete;
+
+    static bool isOpen()
+    {
+        return state().depth != 0;
+    }
+
+    /* Deliver the bus when the outermost batch is closed */
+    static void schedule(EventBusBase *bus)
+    {
+        state().pending.push_back(bus);
+    }
+
+    static void cancel(EventBusBase *bus)
+    {
+        for (auto &pending : state().pending)
+        {
+            if (pending == bus)
+            {
+                pending = nullptr;
+            }
+        }
+    }
+
+private:
+    struct State
+    {
+        unsigned depth = 0;
+        vector<EventBusBase *> pending;
+    };
+
+    static State &state()
+    {
+        thread_local State s;
+        return s;
+    }
+
+    static void flush()
+    {
+        auto &s = state();
+
+        // What the subscribers publish is appended and delivered in this same loop
+        s.depth++;
+        for (size_t i = 0; i < s.pending.size(); i++)
+        {
+            if (!s.pending[i])
+            {
+                continue;
+            }
+
+            try
+            {
+                s.pending[i]->deliver();
+            }
+            catch (const std::exception &e)
+            {
+                SWSS_LOG_ERROR("Exception caught delivering batched events: %s", e.what());
+            }
+        }
+        s.pending.clear();
+        s.depth--;
+    }
+};
+
+template <typename Event>
+class EventSubscriber
+{
+public:
+    /* The events of one batch, at most one per key, in publishing order */
+    virtual void onEvents(const vector<Event> &events) = 0;
+    virtual ~EventSubscriber() {}
+};
+
+template <typename Key, typename Event>
+class EventBus : public EventBusBase
+{
+public:
+    explicit EventBus(function<Key(const Event &)> keyOf) : m_keyOf(keyOf)
+    {
+    }
+
+    ~EventBus() override
+    {
+        if (!m_pending.empty())
+        {
+            EventBatch::cancel(this);
+        }
+    }
+
+    void subscribe(EventSubscriber<Event> *subscriber)
+    {
+        m_subscribers.push_back(subscriber);
+    }
+
+    void unsubscribe(EventSubscriber<Event> *subscriber)
+    {
+        m_subscribers.remove(subscriber);
+    }
+
+    void publish(const Event &event)
+    {
+        if (m_subscribers.empty())
+        {
+            return;
+        }
+
+        if (!EventBatch::isOpen())
+        {
+            deliverEvents(vector<Event>{ event });
+            return;
+        }
+
+        // A later event of a key replaces the queued one and keeps its place
+        auto it = m_index.find(m_keyOf(event));
+        if (it != m_index.end())
+        {
+            m_pending[it->second] = event;
+            return;
+        }
+
+        if (m_pending.empty())
+        {
+            EventBatch::schedule(this);
+        }
+        m_index.emplace(m_keyOf(event), m_pending.size());
+        m_pending.push_back(event);
+    }
+
+    size_t getPendingCount() const
+    {
+        return m_pending.size();
+    }
+
+    void deliver() override
+    {
+        vector<Event> events;
+        events.swap(m_pending);
+        m_index.clear();
+        deliverEvents(events);
+    }
+
+private:
+    function<Key(const Event &)> m_keyOf;
+    list<EventSubscriber<Event> *> m_subscribers;
+    vector<Event> m_pending;
+    map<Key, size_t> m_index;
+
+    void deliverEvents(const vector<Event> &events)
+    {
+        // A subscriber may unsubscribe while handling its events
+        auto subscribers = m_subscribers;
+        for (auto subscriber : subscribers)
+        {
+            subscriber->onEvents(events);
+        }
+    }
+};
+
 #endif /* SWSS_OBSERVER_H */
@@ -1,7 +1,15 @@
 #include <stdexcept>
 #include <thread>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 #include "timestamp.h"
 #include "orch.h"
+#include "orchprobes.h"
+#include "boottimeline.h"
+#include "observer.h"
 
 #include "subscriberstatetable.h"
 #include "portsorch.h"
@@ -18,32 +26,142 @@ int gBatchSize = 0;
 
 std::shared_ptr<RingBuffer> Orch::gRingBuffer = nullptr;
 std::shared_ptr<RingBuffer> Executor::gRingBuffer = nullptr;
+bool Executor::m_inheritPriority = false;
 
-RingBuffer::RingBuffer(int size): buffer(size)
+std::chrono::milliseconds ConsumerBase::m_defaultTimeSlice{0};
+std::atomic<bool> ConsumerBase::m_drainPending{false};
+std::atomic<size_t> ConsumerBase::m_drainedTasks{0};
+std::set<std::string> Consumer::m_prefetchTables;
+
+RingBuffer::RingBuffer(int size)
 {
     if (size <= 1) {
         throw std::invalid_argument("Buffer size must be greater than 1");
     }
+
+    // Keep the historical semantic of holding at most size - 1 tasks
+    m_capacity = static_cast<size_t>(size) - 1;
+
+    size_t slots = 2;
+    while (slots < m_capacity)
+    {
+        slots <<= 1;
+    }
+    m_mask = slots - 1;
+
+    m_slots.reset(new Slot[slots]);
+    for (size_t i = 0; i < slots; i++)
+    {
+        m_slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    m_wakeFd = eventfd(0, EFD_CLOEXEC);
+    m_progressFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_wakeFd < 0 || m_progressFd < 0)
+    {
+        SWSS_LOG_THROW("Failed to create ring buffer eventfd: %s", strerror(errno));
+    }
+}
+
+RingBuffer::~RingBuffer()
+{
+    if (m_wakeFd >= 0)
+    {
+        close(m_wakeFd);
+    }
+    if (m_progressFd >= 0)
+    {
+        close(m_progressFd);
+    }
+}
+
+static void signalEventFd(int fd)
+{
+    uint64_t one = 1;
+    ssize_t ret;
+    do
+    {
+        ret = write(fd, &one, sizeof(one));
+    } while (ret < 0 && errno == EINTR);
+}
+
+static void consumeEventFd(int fd)
+{
+    uint64_t value;
+    ssize_t ret;
+    do
+    {
+        ret = read(fd, &value, sizeof(value));
+    } while (ret < 0 && errno == EINTR);
 }
 
 void RingBuffer::pauseThread()
 {
-    std::unique_lock<std::mutex> lock(mtx);
-    cv.wait(lock, [&](){ return !IsEmpty() || thread_exited; });
+    while (IsEmpty() && !thread_exited)
+    {
+        struct pollfd pfd = { m_wakeFd, POLLIN, 0 };
+        if (poll(&pfd, 1, -1) > 0)
+        {
+            consumeEventFd(m_wakeFd);
+        }
+    }
 }
 
 void RingBuffer::notify()
 {
-    // buffer not empty but rthread idle
-    bool task_pending = !IsEmpty() && IsIdle();
+    // buffer not empty, the ring thread may be sleeping
+    if (thread_exited || !IsEmpty())
+    {
+        signalEventFd(m_wakeFd);
+    }
+}
+
+void RingBuffer::signalProgress()
+{
+    if (m_waiters.load() > 0)
+    {
+        signalEventFd(m_progressFd);
+    }
+}
+
+void RingBuffer::waitProgress()
+{
+    struct pollfd pfd = { m_progressFd, POLLIN, 0 };
+    if (poll(&pfd, 1, RING_WAIT_MSECONDS) > 0)
+    {
+        consumeEventFd(m_progressFd);
+    }
+}
+
+void RingBuffer::waitUntilDrained()
+{
+    m_waiters++;
+    while ((!IsEmpty() || !IsIdle()) && !thread_exited)
+    {
+        notify();
+        waitProgress();
+    }
+    m_waiters--;
+}
 
-    if (thread_exited || task_pending)
-        cv.notify_all();
+void RingBuffer::waitForSpace()
+{
+    m_waiters++;
+    while (IsFull() && !thread_exited)
+    {
+        notify();
+        waitProgress();
+    }
+    m_waiters--;
 }
 
 void RingBuffer::setIdle(bool idle)
 {
     idle_status = idle;
+    if (idle)
+    {
+        signalProgress();
+    }
 }
 
 bool RingBuffer::IsIdle() const
@@ -53,29 +171,63 @@ bool RingBuffer::IsIdle() const
 
 bool RingBuffer::IsFull() const
 {
-    return (tail + 1) % static_cast<int>(buffer.size()) == head;
+    return m_tail.load() - m_head.load() >= m_capacity;
 }
 
 bool RingBuffer::IsEmpty() const
 {
-    return tail == head;
+    return m_tail.load() == m_head.load();
 }
 
 bool RingBuffer::push(AnyTask ringEntry)
 {
-    if (IsFull())
-        return false;
-    buffer[tail] = std::move(ringEntry);
-    tail = (tail + 1) % static_cast<int>(buffer.size());
-    return true;
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+        if (pos - m_head.load(std::memory_order_acquire) >= m_capacity)
+            return false;
+
+        Slot &slot = m_slots[pos & m_mask];
+        size_t seq = slot.seq.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (diff == 0)
+        {
+            // claim the slot, other producers move on to the next one
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                slot.task = std::move(ringEntry);
+                slot.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            // slot still holds a task which has not been consumed
+            return false;
+        }
+        else
+        {
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
 }
 
 bool RingBuffer::pop(AnyTask& ringEntry)
 {
-    if (IsEmpty())
+    // single consumer, only the ring thread advances m_head
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    Slot &slot = m_slots[pos & m_mask];
+
+    if (slot.seq.load(std::memory_order_acquire) != pos + 1)
         return false;
-    ringEntry = std::move(buffer[head]);
-    head = (head + 1) % static_cast<int>(buffer.size());
+
+    ringEntry = std::move(slot.task);
+    slot.task = nullptr;
+    slot.seq.store(pos + m_mask + 1, std::memory_order_release);
+    m_head.store(pos + 1, std::memory_order_release);
+
+    signalProgress();
     return true;
 }
 
@@ -91,11 +243,13 @@ bool RingBuffer::serves(const std::string& tableName)
 
 Orch::Orch(DBConnector *db, const string tableName, int pri)
 {
+    BootTimeline::instance().markOrch(this);
     addConsumer(db, tableName, pri);
 }
 
 Orch::Orch(DBConnector *db, const vector<string> &tableNames)
 {
+    BootTimeline::instance().markOrch(this);
     for (auto it : tableNames)
     {
         addConsumer(db, it, default_orch_pri);
@@ -105,6 +259,7 @@ Orch::Orch(DBConnector *db, const vector<string> &tableNames)
 Orch::Orch(swss::DBConnector *db1, swss::DBConnector *db2, 
     const std::vector<std::string> &tableNames_1, const std::vector<std::string> &tableNames_2)
 {
+    BootTimeline::instance().markOrch(this);
     for(auto it : tableNames_1)
     {
         addConsumer(db1, it, default_orch_pri);
@@ -118,6 +273,7 @@ Orch::Orch(swss::DBConnector *db1, swss::DBConnector *db2,
 
 Orch::Orch(DBConnector *db, const vector<table_name_with_pri_t> &tableNames_with_pri)
 {
+    BootTimeline::instance().markOrch(this);
     for (const auto& it : tableNames_with_pri)
     {
         addConsumer(db, it.first, it.second);
@@ -126,6 +282,7 @@ Orch::Orch(DBConnector *db, const vector<table_name_with_pri_t> &tableNames_with
 
 Orch::Orch(const vector<TableConnector>& tables)
 {
+    BootTimeline::instance().markOrch(this);
     for (auto it : tables)
     {
         addConsumer(it.first, it.second);
@@ -134,6 +291,7 @@ Orch::Orch(const vector<TableConnector>& tables)
 
 Orch::Orch()
 {
+    BootTimeline::instance().markOrch(this);
 }
 
 vector<Selectable *> Orch::getSelectables()
@@ -166,6 +324,292 @@ ConsumerBase* Orch::getConsumerBase(const std::string &executorName)
     return dynamic_cast<ConsumerBase*>(m_consumerMap[executorName].get());
 }
 
+void Orch::setTaskStoreMode(const std::string &executorName, SyncMap::Mode mode)
+{
+    auto consumer = getConsumerBase(executorName);
+    if (consumer == nullptr)
+    {
+        SWSS_LOG_ERROR("No consumer %s in Orch", executorName.c_str());
+        return;
+    }
+
+    consumer->setTaskStoreMode(mode);
+    SWSS_LOG_NOTICE("Consumer %s uses %s task store", executorName.c_str(),
+                    mode == SyncMap::Mode::Hashed ? "hashed" : "ordered");
+}
+
+void Orch::setTimeSlice(const std::string &executorName, std::chrono::milliseconds slice)
+{
+    auto consumer = getConsumerBase(executorName);
+    if (consumer == nullptr)
+    {
+        SWSS_LOG_ERROR("No consumer %s in Orch", executorName.c_str());
+        return;
+    }
+
+    consumer->setTimeSlice(slice);
+    SWSS_LOG_NOTICE("Consumer %s drain time slice is %ld ms", executorName.c_str(), (long)slice.count());
+}
+
+int Orch::getPriority() const
+{
+    int pri = default_orch_pri;
+    bool first = true;
+
+    for (const auto &it : m_consumerMap)
+    {
+        if (first || it.second->getPri() > pri)
+        {
+            pri = it.second->getPri();
+            first = false;
+        }
+    }
+
+    return pri;
+}
+
+void Orch::recordDeferred()
+{
+    for (const auto &it : m_consumerMap)
+    {
+        auto consumer = dynamic_cast<ConsumerBase *>(it.second.get());
+        if (consumer && consumer->getStats() && !consumer->m_toSync.empty())
+        {
+            consumer->getStats()->totalDeferred.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Orch::declareDependencies(const std::vector<Orch *> &dependencies)
+{
+    for (auto orch : dependencies)
+    {
+        if (orch && orch != this)
+        {
+            m_dependencies.insert(orch);
+        }
+    }
+
+    m_dependenciesDeclared = true;
+}
+
+void Orch::setDeferredDrain(bool deferred)
+{
+    for (const auto &it : m_consumerMap)
+    {
+        auto consumer = dynamic_cast<ConsumerBase *>(it.second.get());
+        if (consumer)
+        {
+            consumer->setDeferredDrain(deferred || m_drainOwner != nullptr);
+        }
+    }
+}
+
+void Orch::setDrainOwner(Orch *owner)
+{
+    m_drainOwner = owner;
+    setDeferredDrain(owner != nullptr);
+}
+
+void Orch::drainExecutor(const std::string &executorName)
+{
+    auto it = m_consumerMap.find(executorName);
+    if (it == m_consumerMap.end())
+    {
+        SWSS_LOG_ERROR("Executor %s not found in %s", executorName.c_str(), typeid(*this).name());
+        return;
+    }
+
+    drainExecutor(it->first, it->second.get(), gBatchSize == 0 ? 30000 : static_cast<size_t>(gBatchSize));
+}
+
+bool Orch::hasPendingTasks() const
+{
+    for (const auto &it : m_consumerMap)
+    {
+        auto consumer = dynamic_cast<ConsumerBase *>(it.second.get());
+        if (consumer && consumer->hasPendingTasks())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t Orch::getPendingTaskCount() const
+{
+    size_t count = 0;
+    for (const auto &it : m_consumerMap)
+    {
+        auto consumer = dynamic_cast<ConsumerBase *>(it.second.get());
+        if (consumer)
+        {
+            count += consumer->m_toSync.size();
+        }
+    }
+
+    return count;
+}
+
+bool Orch::hasResolvedRetries() const
+{
+    for (const auto &it : m_retryCaches)
+    {
+        if (it.second && !it.second->getResolvedConstraints().empty())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// DB of the table refillToSync() reads, null for a SubscriberStateTable which is popped instead
+static const DBConnector *refillDb(Selectable *selectable)
+{
+    if (auto consumerTable = dynamic_cast<ConsumerTableBase *>(selectable))
+    {
+        return consumerTable->getDbConnector();
+    }
+    if (auto zmqTable = dynamic_cast<ZmqConsumerStateTable *>(selectable))
+    {
+        return zmqTable->getDbConnector();
+    }
+    return nullptr;
+}
+
+void Orch::getRefillConsumers(vector<ConsumerBase *> &consumers) const
+{
+    for (const auto &it : m_consumerMap)
+    {
+        auto consumer = dynamic_cast<ConsumerBase *>(it.second.get());
+        if (consumer && refillDb(consumer->getSelectable()))
+        {
+            consumers.push_back(consumer);
+        }
+    }
+}
+
+void Orch::clearPreloaded()
+{
+    for (const auto &it : m_consumerMap)
+    {
+        auto consumer = dynamic_cast<ConsumerBase *>(it.second.get());
+        if (consumer)
+        {
+            consumer->clearPreloaded();
+        }
+    }
+}
+
+bool Orch::hasYieldedDrains() const
+{
+    for (const auto &it : m_consumerMap)
+    {
+        auto consumer = dynamic_cast<ConsumerBase *>(it.second.get());
+        if (consumer && consumer->lastDrainYielded())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::chrono::milliseconds ConsumerBase::getTimeSlice() const
+{
+    return m_timeSlice.count() < 0 ? m_defaultTimeSlice : m_timeSlice;
+}
+
+bool ConsumerBase::sliceExpired()
+{
+    if (m_sliceDeadline == std::chrono::steady_clock::time_point::max() ||
+        std::chrono::steady_clock::now() < m_sliceDeadline)
+    {
+        return false;
+    }
+
+    m_sliceYielded = true;
+    return true;
+}
+
+std::chrono::steady_clock::time_point ConsumerBase::beginDrain()
+{
+    auto now = std::chrono::steady_clock::now();
+    auto slice = getTimeSlice();
+
+    m_sliceDeadline = slice.count() > 0 ? now + slice : std::chrono::steady_clock::time_point::max();
+    m_sliceYielded = false;
+    m_drainDepth = m_toSync.size();
+
+    if (m_stats && m_pendingSince != std::chrono::steady_clock::time_point())
+    {
+        m_stats->waitUsec.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - m_pendingSince).count()));
+    }
+
+    return now;
+}
+
+void ConsumerBase::endDrain(std::chrono::steady_clock::time_point start)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    m_sliceDeadline = std::chrono::steady_clock::time_point::max();
+
+    if (!m_deferredDrain && m_toSync.size() < m_drainDepth)
+    {
+        m_drainedTasks.fetch_add(m_drainDepth - m_toSync.size(), std::memory_order_relaxed);
+    }
+
+    if (m_sliceYielded)
+    {
+        // Ask the scheduler for another round soon instead of waiting for the next event
+        m_drainPending = true;
+    }
+
+    if (m_stats)
+    {
+        m_stats->recordDoTask(now - start);
+        if (m_sliceYielded)
+        {
+            m_stats->totalSliceExpired.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Whatever is left in m_toSync waits for the next drain from now on
+        m_pendingSince = m_toSync.empty() ? std::chrono::steady_clock::time_point() : now;
+        m_stats->toSyncPending.store(m_toSync.size(), std::memory_order_relaxed);
+    }
+}
+
+void ConsumerBase::drainOrDefer()
+{
+    if (m_deferredDrain)
+    {
+        m_drainPending = true;
+        return;
+    }
+
+    drain();
+}
+
+void ConsumerBase::recordBacklog()
+{
+    if (!m_stats)
+    {
+        return;
+    }
+
+    m_stats->toSyncDepth.record(m_toSync.size());
+    m_stats->toSyncPending.store(m_toSync.size(), std::memory_order_relaxed);
+
+    if (m_pendingSince == std::chrono::steady_clock::time_point() && !m_toSync.empty())
+    {
+        m_pendingSince = std::chrono::steady_clock::now();
+    }
+}
+
 bool ConsumerBase::addToRetry(const Task &task, const Constraint &cst) {
     auto retryCache = getOrch() ? getOrch()->getRetryCache(getName()) : nullptr;
     if (retryCache)
@@ -192,6 +636,7 @@ bool Orch::addToRetry(const std::string &executorName, const Task &task, const C
  * @brief Check the consumer's RetryCache, if the set of resolved constraints is not empty,
  * query RetryMap for failed tasks indexed by these resolved constraints,
  * and move them back to the consumer's SyncMap, such that they can be retried in the next iteration.
+ * The quota is shared fairly among the resolved constraints, tasks of a constraint are retried in FIFO order.
  * @param executorName - name of the consumer
  * @param quota - maximum number of tasks to be moved back to SyncMap in a single call
  * @return number of tasks moved back to SyncMap
@@ -204,22 +649,12 @@ size_t Orch::retryToSync(const std::string &executorName, size_t quota)
     if (!retryCache || quota <= 0)
         return 0;
 
-    std::unordered_set<Constraint>& constraints = retryCache->getResolvedConstraints();
-
-    size_t count = 0;
-
-    while (!constraints.empty() && count < quota)
-    {
-        auto cst = *constraints.begin();
-
-        auto tasks = retryCache->resolve(cst, quota - count);
-
-        count += tasks->size();
+    if (retryCache->getResolvedConstraints().empty())
+        return 0;
 
-        getConsumerBase(executorName)->addToSync(tasks, true);
+    auto tasks = retryCache->resolveResolved(quota);
 
-    }
-    return count;
+    return getConsumerBase(executorName)->addToSync(move(*tasks), true);
 }
 
 void Orch::notifyRetry(Orch *retryOrch, const std::string &executorName, const Constraint &cst)
@@ -241,10 +676,19 @@ size_t ConsumerBase::addToSync(std::shared_ptr<std::deque<swss::KeyOpFieldsValue
 
 void ConsumerBase::addToSync(const KeyOpFieldsValuesTuple &entry, bool onRetry)
 {
-    addToSyncInternal(entry, onRetry, true);
+    addToSyncInternal(KeyOpFieldsValuesTuple(entry), onRetry, true);
+
+    recordBacklog();
 }
 
-void ConsumerBase::addToSyncInternal(const KeyOpFieldsValuesTuple &entry, bool onRetry, bool recordTask)
+void ConsumerBase::addToSync(KeyOpFieldsValuesTuple &&entry, bool onRetry)
+{
+    addToSyncInternal(move(entry), onRetry, true);
+
+    recordBacklog();
+}
+
+void ConsumerBase::addToSyncInternal(KeyOpFieldsValuesTuple &&entry, bool onRetry, bool recordTask)
 {
     SWSS_LOG_ENTER();
 
@@ -299,8 +743,8 @@ void ConsumerBase::addToSyncInternal(const KeyOpFieldsValuesTuple &entry, bool o
                 {
                     // move the old SET back to m_toSync for later merge
                     auto old_task = retryCache->evict(key);
-                    m_toSync.emplace(key, *old_task);
                     Recorder::Instance().retry.record(dumpTuple(*old_task).append(DECACHE));
+                    m_toSync.emplace(key, move(*old_task));
                 }
             }
             break;
@@ -320,7 +764,7 @@ void ConsumerBase::addToSyncInternal(const KeyOpFieldsValuesTuple &entry, bool o
                 // Keep the DEL task, move the old SET back to m_toSync for later merge
                 auto old_task = retryCache->evict(key);
                 Recorder::Instance().retry.record(dumpTuple(*old_task).append(DECACHE));
-                m_toSync.emplace(key, *old_task);
+                m_toSync.emplace(key, move(*old_task));
             }
             break;
         }
@@ -330,22 +774,22 @@ void ConsumerBase::addToSyncInternal(const KeyOpFieldsValuesTuple &entry, bool o
     }
 
     /*
-    * m_toSync is a multimap which will allow one key with multiple values,
+    * m_toSync allows one key with multiple values,
     * Also, the order of the key-value pairs whose keys compare equivalent
-    * is the order of insertion and does not change. (since C++11)
+    * is the order of insertion and does not change.
     */
 
     /* If a new task comes we directly put it into getConsumerTable().m_toSync map */
-    if (m_toSync.find(key) == m_toSync.end())
+    auto iter = m_toSync.find(key);
+    if (iter == m_toSync.end())
     {
-        m_toSync.emplace(key, entry);
+        m_toSync.emplace(move(key), move(entry));
     }
 
-    /* if a DEL task comes, we overwrite the old key */
+    /* if a DEL task comes, we overwrite the old key in place */
     else if (op == DEL_COMMAND)
     {
-        m_toSync.erase(key);
-        m_toSync.emplace(key, entry);
+        m_toSync.replace(key, move(entry));
     }
     else
     {
@@ -361,42 +805,35 @@ void ConsumerBase::addToSyncInternal(const KeyOpFieldsValuesTuple &entry, bool o
         * If there was a SET already (I,E, the pointer still points to the same key), we combine the kfv.
         */
         auto ret = m_toSync.equal_range(key);
-        auto iter = ret.first;
-        for (; iter != ret.second; ++iter)
+        for (iter = ret.first; iter != ret.second; ++iter)
         {
-            auto old_op = kfvOp(iter->second);
-            if (old_op == SET_COMMAND)
+            if (kfvOp(iter->second) == SET_COMMAND)
                 break;
         }
         if (iter == ret.second)
         {
-            m_toSync.emplace(key, entry);
+            m_toSync.emplace(move(key), move(entry));
         }
         else
         {
-            KeyOpFieldsValuesTuple existing_data = iter->second;
-
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
+            /* Merge the new fields into the pending SET in place */
+            auto &existing_values = kfvFieldsValues(iter->second);
 
-
-            for (auto it : new_values)
+            for (auto &it : kfvFieldsValues(entry))
             {
-                string field = fvField(it);
-                string value = fvValue(it);
+                const string &field = fvField(it);
 
                 auto iu = existing_values.begin();
                 while (iu != existing_values.end())
                 {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
+                    if (fvField(*iu) == field)
                         iu = existing_values.erase(iu);
                     else
                         iu++;
                 }
-                existing_values.push_back(FieldValueTuple(field, value));
+                existing_values.push_back(move(it));
             }
-            iter->second = KeyOpFieldsValuesTuple(key, op, existing_values);
+            kfvOp(iter->second) = op;
         }
     }
 
@@ -413,9 +850,30 @@ size_t ConsumerBase::addToSync(const std::deque<KeyOpFieldsValuesTuple> &entries
 
     for (auto& entry: entries)
     {
-        addToSyncInternal(entry, onRetry, onRetry);
+        addToSyncInternal(KeyOpFieldsValuesTuple(entry), onRetry, onRetry);
+    }
+
+    recordBacklog();
+
+    return entries.size();
+}
+
+size_t ConsumerBase::addToSync(std::deque<KeyOpFieldsValuesTuple> &&entries, bool onRetry)
+{
+    SWSS_LOG_ENTER();
+
+    if (!onRetry)
+    {
+        recordTuples(entries);
+    }
+
+    for (auto& entry: entries)
+    {
+        addToSyncInternal(move(entry), onRetry, onRetry);
     }
 
+    recordBacklog();
+
     return entries.size();
 }
 
@@ -436,14 +894,26 @@ size_t ConsumerBase::refillToSync(Table* table)
         {
             continue;
         }
-        entries.push_back(kco);
+        entries.push_back(move(kco));
     }
 
-    return addToSync(entries);
+    return addToSync(move(entries));
 }
 
 size_t ConsumerBase::refillToSync()
 {
+    if (m_preloaded)
+    {
+        auto batches = std::move(m_preloaded);
+        size_t total_size = 0;
+        while (!batches->empty())
+        {
+            total_size += addToSync(move(batches->front()));
+            batches->pop_front();
+        }
+        return total_size;
+    }
+
     auto subTable = dynamic_cast<SubscriberStateTable *>(getSelectable());
     if (subTable != NULL)
     {
@@ -453,7 +923,7 @@ size_t ConsumerBase::refillToSync()
         {
             std::deque<KeyOpFieldsValuesTuple> entries;
             subTable->pops(entries);
-            update_size = addToSync(entries);
+            update_size = addToSync(move(entries));
             total_size += update_size;
         } while (update_size != 0);
         return total_size;
@@ -477,6 +947,113 @@ size_t ConsumerBase::refillToSync()
     return 0;
 }
 
+bool ConsumerBase::preloadToSync(size_t scanCount)
+{
+    SWSS_LOG_ENTER();
+
+    const DBConnector *db = refillDb(getSelectable());
+    if (db == nullptr)
+    {
+        return false;
+    }
+
+    auto batches = make_unique<deque<deque<KeyOpFieldsValuesTuple>>>();
+    try
+    {
+        TableScanner scanner(db, getTableName(), getConsumerTable()->getTableNameSeparator(), scanCount);
+
+        deque<KeyOpFieldsValuesTuple> entries;
+        while (scanner.next(entries))
+        {
+            batches->push_back(std::move(entries));
+            entries.clear();
+        }
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_WARN("Failed to preload %s, it is read again on refill: %s", getTableName().c_str(), e.what());
+        return false;
+    }
+
+    m_preloaded = std::move(batches);
+    return true;
+}
+
+bool ConsumerBase::scanTable(const std::function<void(const KeyOpFieldsValuesTuple &)> &visit) const
+{
+    SWSS_LOG_ENTER();
+
+    const DBConnector *db = refillDb(getSelectable());
+    if (db == nullptr)
+    {
+        return false;
+    }
+
+    // SCAN may return a key twice, each key is visited once
+    unordered_set<string> seen;
+    auto add = [&visit, &seen](const KeyOpFieldsValuesTuple &entry)
+    {
+        if (seen.insert(kfvKey(entry)).second)
+        {
+            visit(entry);
+        }
+    };
+
+    if (m_preloaded)
+    {
+        for (const auto &batch : *m_preloaded)
+        {
+            for (const auto &entry : batch)
+            {
+                add(entry);
+            }
+        }
+        return true;
+    }
+
+    string tableName = getTableName();
+    try
+    {
+        TableScanner scanner(db, tableName, getConsumerTable()->getTableNameSeparator());
+
+        deque<KeyOpFieldsValuesTuple> entries;
+        while (scanner.next(entries))
+        {
+            for (const auto &entry : entries)
+            {
+                add(entry);
+            }
+            entries.clear();
+        }
+        return true;
+    }
+    catch (const exception &e)
+    {
+        // The keys already visited are not visited again
+        SWSS_LOG_INFO("Failed to scan %s, read by key: %s", tableName.c_str(), e.what());
+    }
+
+    Table table(db, tableName);
+    vector<string> keys;
+    table.getKeys(keys);
+    for (const auto &key : keys)
+    {
+        KeyOpFieldsValuesTuple kco;
+        kfvKey(kco) = key;
+        kfvOp(kco) = SET_COMMAND;
+        if (table.get(key, kfvFieldsValues(kco)))
+        {
+            add(kco);
+        }
+    }
+    return true;
+}
+
+bool ConsumerBase::digestTable(TableDigest &digest) const
+{
+    return scanTable([&digest](const KeyOpFieldsValuesTuple &entry) { digest.add(entry); });
+}
+
 string ConsumerBase::dumpTuple(const KeyOpFieldsValuesTuple &tuple)
 {
     string s = getTableName() + getConsumerTable()->getTableNameSeparator() + kfvKey(tuple)
@@ -493,7 +1070,7 @@ void ConsumerBase::recordTuple(const KeyOpFieldsValuesTuple &tuple)
 {
     auto& swssRecorder = Recorder::Instance().swss;
 
-    if (!swssRecorder.isAsyncEnabled())
+    if (!swssRecorder.isAsyncEnabled() && !swssRecorder.isBinary())
     {
         swssRecorder.record(dumpTuple(tuple));
         return;
@@ -508,7 +1085,7 @@ void ConsumerBase::recordTuples(const std::deque<KeyOpFieldsValuesTuple> &entrie
 {
     auto& swssRecorder = Recorder::Instance().swss;
 
-    if (!swssRecorder.isAsyncEnabled())
+    if (!swssRecorder.isAsyncEnabled() && !swssRecorder.isBinary())
     {
         for (const auto& entry : entries)
         {
@@ -548,6 +1125,19 @@ void ConsumerBase::dumpPendingTasks(vector<string> &ts)
     }
 }
 
+size_t ConsumerBase::getPendingTaskCount()
+{
+    size_t count = m_toSync.size();
+
+    auto rc = getOrch() ? getOrch()->getRetryCache(getTableName()) : nullptr;
+    if (rc)
+    {
+        count += rc->getRetryMap().size();
+    }
+
+    return count;
+}
+
 void Consumer::execute()
 {
     SWSS_LOG_ENTER();
@@ -555,12 +1145,25 @@ void Consumer::execute()
     auto entries = std::make_shared<std::deque<KeyOpFieldsValuesTuple>>();
     getConsumerTable()->pops(*entries);
 
+    if (m_stats)
+    {
+        m_stats->recordPop(entries->size());
+    }
+
+    ORCH_PROBE2(consumer__execute__entry, m_name.c_str(), entries->size());
+    execute(entries);
+    ORCH_PROBE1(consumer__execute__return, m_name.c_str());
+}
+
+void Consumer::execute(std::shared_ptr<std::deque<KeyOpFieldsValuesTuple>> entries)
+{
     processAnyTask(
         // bundle tasks into a lambda function which takes no argument and returns void
         // this lambda captures variables by value from the surrounding scope
         [=](){
-            addToSync(entries);
-            drain();
+            // The popped entries are only seen by this task, they are moved into m_toSync
+            addToSync(move(*entries));
+            drainOrDefer();
         }
     );
 }
@@ -581,10 +1184,7 @@ void Executor::processAnyTask(AnyTask&& task)
     {
         // this executor should execute the input task in the main thread
         // but to avoid thread issue, it should wait when the ring buffer is actively working
-        while (!gRingBuffer->IsEmpty() || !gRingBuffer->IsIdle()) {
-            gRingBuffer->notify();
-            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_MSECONDS));
-        }
+        gRingBuffer->waitUntilDrained();
         // execute task()
         task();
     }
@@ -594,8 +1194,8 @@ void Executor::processAnyTask(AnyTask&& task)
         // push the task to gRingBuffer
         // this task would be executed in the ring thread, not here
         while (!gRingBuffer->push(task)) {
-            gRingBuffer->notify();
-            SWSS_LOG_WARN("ring is full...push again");
+            SWSS_LOG_INFO("ring is full...wait for the ring thread");
+            gRingBuffer->waitForSpace();
         }
         gRingBuffer->notify();
     }
@@ -605,6 +1205,12 @@ void Consumer::drain()
 {
     if (!m_toSync.empty())
     {
+        auto start = beginDrain();
+        ORCH_PROBE2(orch__dotask__entry, m_name.c_str(), m_toSync.size());
+
+        // What doTask() publishes on an EventBus is delivered once the drain is done
+        EventBatch batch;
+
         try
         {
             ((Orch *)m_orch)->doTask((Consumer&)*this);
@@ -629,6 +1235,9 @@ void Consumer::drain()
             SWSS_LOG_ERROR("Exception caught: type=unknown, table=%s",
                            getName().c_str());
         }
+
+        ORCH_PROBE2(orch__dotask__return, m_name.c_str(), m_toSync.size());
+        endDrain(start);
     }
 }
 
@@ -717,7 +1326,7 @@ bool Orch::parseReference(type_map &type_maps, string &ref_in, const string &typ
         SWSS_LOG_ERROR("not recognized type:%s\n", type_name.c_str());
         return false;
     }
-    auto obj_map = type_maps[type_name];
+    auto &obj_map = type_it->second;
     auto obj_it = obj_map->find(ref_in);
     if (obj_it == obj_map->end())
     {
@@ -777,6 +1386,45 @@ ref_resolve_status Orch::resolveFieldRefValue(
     return ref_resolve_status::success;
 }
 
+/*
+ * Call func(table, name) for every "table:name" item of a reference list
+ * such as "BUFFER_PROFILE_TABLE:p0,BUFFER_PROFILE_TABLE:p1". The items are
+ * split in place into two reused buffers instead of the vectors of
+ * tokenize(), these lists are walked on every reference update.
+ */
+template <typename Func>
+static void forEachReference(const string &refs, Func func)
+{
+    string table_name;
+    string object_name;
+    size_t start = 0;
+
+    while (start < refs.size())
+    {
+        size_t end = refs.find(list_item_delimiter, start);
+        if (end == string::npos)
+        {
+            end = refs.size();
+        }
+
+        size_t sep = refs.find(delimiter, start);
+        if (sep < end)
+        {
+            size_t name_end = refs.find(delimiter, sep + 1);
+            if (name_end > end)
+            {
+                name_end = end;
+            }
+
+            table_name.assign(refs, start, sep - start);
+            object_name.assign(refs, sep + 1, name_end - sep - 1);
+            func(table_name, object_name);
+        }
+
+        start = end + 1;
+    }
+}
+
 void Orch::removeMeFromObjsReferencedByMe(
     type_map &type_maps,
     const string &table,
@@ -785,20 +1433,15 @@ void Orch::removeMeFromObjsReferencedByMe(
     const string &old_referenced_obj_name,
     bool remove_field)
 {
-    vector<string> objects = tokenize(old_referenced_obj_name, list_item_delimiter);
-    for (auto &obj : objects)
-    {
+    forEachReference(old_referenced_obj_name, [&](const string &referenced_table, const string &ref_obj_name) {
         // obj_name references token
-        auto tokens = tokenize(obj, delimiter);
-        auto &referenced_table = tokens[0];
-        auto &ref_obj_name = tokens[1];
         auto &old_referenced_obj = (*type_maps[referenced_table])[ref_obj_name];
         old_referenced_obj.m_objsDependingOnMe.erase(obj_name);
         SWSS_LOG_INFO("Obj %s.%s Field %s: Remove reference to %s %s (now %s)",
                       table.c_str(), obj_name.c_str(), field.c_str(),
                       referenced_table.c_str(), ref_obj_name.c_str(),
                       to_string(old_referenced_obj.m_objsDependingOnMe.size()).c_str());
-    }
+    });
 
     if (remove_field)
     {
@@ -817,25 +1460,26 @@ void Orch::setObjectReference(
     auto &obj = (*type_maps[table])[obj_name];
     auto field_ref = obj.m_objsReferencingByMe.find(field);
 
-    if (field_ref != obj.m_objsReferencingByMe.end())
+    if (field_ref == obj.m_objsReferencingByMe.end())
+    {
+        field_ref = obj.m_objsReferencingByMe.emplace(field, referenced_obj).first;
+    }
+    else if (field_ref->second != referenced_obj)
+    {
         removeMeFromObjsReferencedByMe(type_maps, table, obj_name, field, field_ref->second, false);
+        field_ref->second = referenced_obj;
+    }
 
-    obj.m_objsReferencingByMe[field] = referenced_obj;
-
-    // Add the reference to the new object being referenced
-    vector<string> objs = tokenize(referenced_obj, list_item_delimiter);
-    for (auto &obj : objs)
-    {
-        auto tokens = tokenize(obj, delimiter);
-        auto &referenced_table = tokens[0];
-        auto &referenced_obj_name = tokens[1];
+    // Add the reference to the new object being referenced, a no-op for the
+    // objects an unchanged field already references
+    forEachReference(referenced_obj, [&](const string &referenced_table, const string &referenced_obj_name) {
         auto &new_obj_being_referenced = (*type_maps[referenced_table])[referenced_obj_name];
         new_obj_being_referenced.m_objsDependingOnMe.insert(obj_name);
         SWSS_LOG_INFO("Obj %s.%s Field %s: Add reference to %s %s (now %s)",
                       table.c_str(), obj_name.c_str(), field.c_str(),
                       referenced_table.c_str(), referenced_obj_name.c_str(),
                       to_string(new_obj_being_referenced.m_objsDependingOnMe.size()).c_str());
-    }
+    });
 }
 
 bool Orch::doesObjectExist(
@@ -845,8 +1489,9 @@ bool Orch::doesObjectExist(
     const string &field,
     string &referenced_obj)
 {
-    auto &&searchRef = (*type_maps[table]).find(obj_name);
-    if (searchRef != (*type_maps[table]).end())
+    auto &obj_map = *type_maps[table];
+    auto searchRef = obj_map.find(obj_name);
+    if (searchRef != obj_map.end())
     {
         auto &obj = searchRef->second;
         auto &&searchReferencingObjectRef = obj.m_objsReferencingByMe.find(field);
@@ -865,21 +1510,22 @@ void Orch::removeObject(
     const string &table,
     const string &obj_name)
 {
-    auto &&searchRef = (*type_maps[table]).find(obj_name);
-    if (searchRef == (*type_maps[table]).end())
+    auto &obj_map = *type_maps[table];
+    auto searchRef = obj_map.find(obj_name);
+    if (searchRef == obj_map.end())
     {
         return;
     }
 
     auto &obj = searchRef->second;
 
-    for (auto field_ref : obj.m_objsReferencingByMe)
+    for (auto &field_ref : obj.m_objsReferencingByMe)
     {
         removeMeFromObjsReferencedByMe(type_maps, table, obj_name, field_ref.first, field_ref.second, false);
     }
 
     // Update the field store
-    (*type_maps[table]).erase(obj_name);
+    obj_map.erase(searchRef);
     SWSS_LOG_INFO("Obj %s:%s is removed from store", table.c_str(), obj_name.c_str());
 }
 
@@ -908,6 +1554,12 @@ string Orch::objectReferenceInfo(
 
 void Orch::doTask()
 {
+    // Served by the owner's doTask()
+    if (m_drainOwner)
+    {
+        return;
+    }
+
     // limit the number of tasks moved from RetryMap to SyncMap in one iteration 
     // to avoid starvation of new tasks in SyncMap
     auto threshold = gBatchSize == 0 ? 30000 : gBatchSize;
@@ -916,34 +1568,43 @@ void Orch::doTask()
 
     for (auto &it : m_consumerMap)
     {
-        try
-        {
-            count += retryToSync(it.first, threshold - count);
-            it.second->drain();
-        }
-        catch (const std::invalid_argument& e)
-        {
-            SWSS_LOG_ERROR("Exception caught: type=invalid_argument, table=%s, orch=%s, error=%s",
-                           it.first.c_str(), typeid(*this).name(), e.what());
-        }
-        catch (const std::logic_error& e)
-        {
-            SWSS_LOG_ERROR("Exception caught: type=logic_error, table=%s, orch=%s, error=%s",
-                           it.first.c_str(), typeid(*this).name(), e.what());
-        }
-        catch (const std::exception& e)
-        {
-            SWSS_LOG_ERROR("Exception caught: type=exception, table=%s, orch=%s, error=%s",
-                           it.first.c_str(), typeid(*this).name(), e.what());
-        }
-        catch (...)
-        {
-            SWSS_LOG_ERROR("Exception caught: type=unknown, table=%s, orch=%s",
-                           it.first.c_str(), typeid(*this).name());
-        }
+        count += drainExecutor(it.first, it.second.get(), threshold - count);
     }
 }
 
+size_t Orch::drainExecutor(const std::string &executorName, Executor *executor, size_t quota)
+{
+    size_t count = 0;
+
+    try
+    {
+        count = retryToSync(executorName, quota);
+        executor->drain();
+    }
+    catch (const std::invalid_argument& e)
+    {
+        SWSS_LOG_ERROR("Exception caught: type=invalid_argument, table=%s, orch=%s, error=%s",
+                       executorName.c_str(), typeid(*this).name(), e.what());
+    }
+    catch (const std::logic_error& e)
+    {
+        SWSS_LOG_ERROR("Exception caught: type=logic_error, table=%s, orch=%s, error=%s",
+                       executorName.c_str(), typeid(*this).name(), e.what());
+    }
+    catch (const std::exception& e)
+    {
+        SWSS_LOG_ERROR("Exception caught: type=exception, table=%s, orch=%s, error=%s",
+                       executorName.c_str(), typeid(*this).name(), e.what());
+    }
+    catch (...)
+    {
+        SWSS_LOG_ERROR("Exception caught: type=unknown, table=%s, orch=%s",
+                       executorName.c_str(), typeid(*this).name());
+    }
+
+    return count;
+}
+
 void Orch::dumpPendingTasks(vector<string> &ts)
 {
     for (auto &it : m_consumerMap)
@@ -959,6 +1620,24 @@ void Orch::dumpPendingTasks(vector<string> &ts)
     }
 }
 
+void Orch::getPendingTaskCounts(vector<pair<string, size_t>> &counts)
+{
+    for (auto &it : m_consumerMap)
+    {
+        ConsumerBase* consumer = dynamic_cast<ConsumerBase *>(it.second.get());
+        if (consumer == NULL)
+        {
+            continue;
+        }
+
+        size_t count = consumer->getPendingTaskCount();
+        if (count != 0)
+        {
+            counts.emplace_back(consumer->getTableName(), count);
+        }
+    }
+}
+
 void Orch::flushResponses()
 {
     m_publisher.flush();
@@ -1189,6 +1868,14 @@ void Orch::addConsumer(DBConnector *db, string tableName, int pri)
     {
         addExecutor(new Consumer(new SubscriberStateTable(db, tableName, TableConsumable::DEFAULT_POP_BATCH_SIZE, pri), this, tableName));
     }
+    else if (Consumer::isPrefetchTable(tableName))
+    {
+        // Popped on a reader thread, so the table must not share the connection of the main thread
+        DBConnector *prefetchDb = db->newConnector(0);
+        auto consumer = new Consumer(new ConsumerStateTable(prefetchDb, tableName, gBatchSize, pri), this, tableName);
+        consumer->setPrefetchDb(prefetchDb);
+        addExecutor(consumer);
+    }
     else
     {
         addExecutor(new Consumer(new ConsumerStateTable(db, tableName, gBatchSize, pri), this, tableName));
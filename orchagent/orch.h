@@ -7,7 +7,10 @@
 #include <set>
 #include <memory>
 #include <utility>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 
 extern "C" {
 #include <sai.h>
@@ -27,6 +30,11 @@ extern "C" {
 #include "recorder.h"
 #include "schema.h"
 #include "retrycache.h"
+#include "executorstats.h"
+#include "syncmap.h"
+#include "referenceset.h"
+#include "tablescanner.h"
+#include "warmcheckpoint.h"
 
 const char delimiter           = ':';
 const char list_item_delimiter = ',';
@@ -54,7 +62,8 @@ const char state_db_key_delimiter  = '|';
 #define VLAN_SUB_INTERFACE_SEPARATOR "."
 
 #define RING_SIZE 30
-#define SLEEP_MSECONDS 500
+/* Upper bound of a single wait for ring progress, guards against a stalled ring thread */
+#define RING_WAIT_MSECONDS 100
 
 const int default_orch_pri = 0;
 
@@ -71,7 +80,7 @@ typedef enum
 typedef struct
 {
     // m_objsDependingOnMe stores names (without table name) of all objects depending on the current obj
-    std::set<std::string> m_objsDependingOnMe;
+    ReferenceSet m_objsDependingOnMe;
     // m_objsReferencingByMe is a map from a field of the current object's to the object names it references
     // the object names are with table name
     // multiple objects being referenced are separated by ','
@@ -86,10 +95,6 @@ typedef std::map<std::string, std::shared_ptr<object_reference_map>> type_map;
 typedef std::map<std::string, sai_object_id_t> object_map;
 typedef std::pair<std::string, sai_object_id_t> object_map_pair;
 
-// Use multimap to support multiple OpFieldsValues for the same key (e,g, DEL and SET)
-// The order of the key-value pairs whose keys compare equivalent is the order of
-// insertion and does not change. (since C++11)
-typedef std::multimap<std::string, swss::KeyOpFieldsValuesTuple> SyncMap;
 
 typedef std::pair<std::string, int> table_name_with_pri_t;
 
@@ -106,8 +111,10 @@ class RingBuffer;
 class Executor : public swss::Selectable
 {
 public:
+    // With a bounded scheduler, inherit the priority of the decorated selectable so Select serves executors in table priority order
     Executor(swss::Selectable *selectable, Orch *orch, const std::string &name)
-        : m_selectable(selectable)
+        : swss::Selectable(m_inheritPriority && selectable ? selectable->getPri() : 0)
+        , m_selectable(selectable)
         , m_orch(orch)
         , m_name(name)
     {
@@ -139,7 +146,16 @@ public:
     static std::shared_ptr<RingBuffer> gRingBuffer;
     void processAnyTask(AnyTask&& func);
 
+    /*
+     * Executors created afterwards take the priority of their table. Only set
+     * with a time slice or round budget, all executors are served at priority
+     * 0 by default so timers are not starved by high priority tables.
+     */
+    static void setInheritPriority(bool inherit) { m_inheritPriority = inherit; }
+
 protected:
+    static bool m_inheritPriority;
+
     swss::Selectable *m_selectable;
     Orch *m_orch;
 
@@ -156,6 +172,7 @@ class ConsumerBase : public Executor {
 public:
     ConsumerBase(swss::Selectable *selectable, Orch *orch, const std::string &name)
         : Executor(selectable, orch, name)
+        , m_stats(ExecutorStatsRegistry::instance().attach(name))
     {
     }
 
@@ -169,19 +186,30 @@ public:
     std::string dumpTuple(const swss::KeyOpFieldsValuesTuple &tuple);
     void dumpPendingTasks(std::vector<std::string> &ts);
 
+    /* Number of tasks dumpPendingTasks() would dump, without formatting them */
+    size_t getPendingTaskCount();
+
     /* Store the latest 'golden' status */
     // TODO: hide?
+    // Supports multiple OpFieldsValues for the same key (e,g, DEL and SET),
+    // see SyncMap for the ordering guarantees
     SyncMap m_toSync;
 
+    /* Select the index flavour of m_toSync, only allowed while it is empty */
+    void setTaskStoreMode(SyncMap::Mode mode) { m_toSync.setMode(mode); }
+
     /* record the tuple */
     void recordTuple(const swss::KeyOpFieldsValuesTuple &tuple);
     void recordTuples(const std::deque<swss::KeyOpFieldsValuesTuple> &entries);
 
     void addToSync(const swss::KeyOpFieldsValuesTuple &entry, bool onRetry=false);
+    void addToSync(swss::KeyOpFieldsValuesTuple &&entry, bool onRetry=false);
 
     // Returns: the number of entries added to m_toSync
     size_t addToSync(const std::deque<swss::KeyOpFieldsValuesTuple> &entries, bool onRetry=false);
     size_t addToSync(std::shared_ptr<std::deque<swss::KeyOpFieldsValuesTuple>> entries, bool onRetry=false); 
+    // Same, the entries are moved into m_toSync instead of copied
+    size_t addToSync(std::deque<swss::KeyOpFieldsValuesTuple> &&entries, bool onRetry=false);
 
     /**
      * @brief Add the failed task and its constraint to the consumer's RetryCache
@@ -193,25 +221,143 @@ public:
     size_t refillToSync();
     size_t refillToSync(swss::Table* table);
 
+    /*
+     * Read the existing data of the table for the next refillToSync(), in
+     * TableScanner batches on a DB connection of its own. Nothing else of the
+     * Consumer is touched, so the tables of several Consumers can be preloaded
+     * concurrently. Returns false if the table is not read by refillToSync()
+     * or could not be read, the refill then reads it itself.
+     */
+    bool preloadToSync(size_t scanCount = TABLE_SCAN_COUNT_DEFAULT);
+    void clearPreloaded() { m_preloaded.reset(); }
+    bool hasPreloaded() const { return m_preloaded != nullptr; }
+
+    /*
+     * Visit every entry of the table refillToSync() reads, from the preloaded
+     * batches if any, each key once. Returns false if the table is not read
+     * by refillToSync().
+     */
+    bool scanTable(const std::function<void(const swss::KeyOpFieldsValuesTuple &)> &visit) const;
+
+    /* Digest of the entries scanTable() visits */
+    bool digestTable(TableDigest &digest) const;
+
+    /* Latency and backlog statistics, null when collection is disabled */
+    ExecutorStats *getStats() const { return m_stats.get(); }
+
+    /*
+     * Time slice of a single drain. Long running doTask loops poll
+     * sliceExpired() and return once it reports true, the entries left in
+     * m_toSync are resumed on the next scheduling round. A zero slice lets
+     * doTask run to completion, which is the default.
+     */
+    static void setDefaultTimeSlice(std::chrono::milliseconds slice) { m_defaultTimeSlice = slice; }
+    void setTimeSlice(std::chrono::milliseconds slice) { m_timeSlice = slice; }
+    std::chrono::milliseconds getTimeSlice() const;
+    bool sliceExpired();
+
+    /* True if the last drain yielded at the end of its slice */
+    bool lastDrainYielded() const { return m_sliceYielded; }
+
+    /*
+     * Returns true if any drain yielded at the end of its slice, or was
+     * deferred, since the last call
+     */
+    static bool takePendingDrains() { return m_drainPending.exchange(false); }
+
+    /*
+     * Returns the number of tasks taken out of m_toSync by the drains flushed
+     * by the OrchDaemon main loop since the last call, the drains of worker
+     * groups are left out as the workers flush their own output
+     */
+    static size_t takeDrainedTasks() { return m_drainedTasks.exchange(0); }
+
+    /*
+     * Leave the drain following execute() to the OrchDaemon doTask round,
+     * which runs it on a worker thread for Orchs of an independent group
+     */
+    void setDeferredDrain(bool deferred) { m_deferredDrain = deferred; }
+    bool isDrainDeferred() const { return m_deferredDrain; }
+
+    virtual bool hasPendingTasks() const { return !m_toSync.empty(); }
+
+protected:
+    std::shared_ptr<ExecutorStats> m_stats;
+
+    /* Bracket a doTask invocation: arm the time slice and account the wait and run time */
+    std::chrono::steady_clock::time_point beginDrain();
+    void endDrain(std::chrono::steady_clock::time_point start);
+
+    /* Drain now, or ask for the next OrchDaemon round when the drain is deferred */
+    void drainOrDefer();
+
 private:
-    void addToSyncInternal(const swss::KeyOpFieldsValuesTuple &entry, bool onRetry, bool recordTask);
+    void addToSyncInternal(swss::KeyOpFieldsValuesTuple &&entry, bool onRetry, bool recordTask);
+    void recordBacklog();
+
+    static std::chrono::milliseconds m_defaultTimeSlice;
+    static std::atomic<bool> m_drainPending;
+    static std::atomic<size_t> m_drainedTasks;
+
+    // Negative means the default time slice applies
+    std::chrono::milliseconds m_timeSlice{-1};
+    std::chrono::steady_clock::time_point m_sliceDeadline = std::chrono::steady_clock::time_point::max();
+    bool m_sliceYielded = false;
+    bool m_deferredDrain = false;
+    // m_toSync size when the current drain started
+    size_t m_drainDepth = 0;
+
+    // Since when the pending entries in m_toSync have been waiting for a drain
+    std::chrono::steady_clock::time_point m_pendingSince;
+
+    // Batches read by preloadToSync(), handed to addToSync() one by one on refill
+    std::unique_ptr<std::deque<std::deque<swss::KeyOpFieldsValuesTuple>>> m_preloaded;
 };
 
+/*
+ * Bounded multi-producer/single-consumer task ring shared by the main thread and
+ * the ring thread. Producers and the consumer never take a lock, slots are
+ * handed over through per-slot sequence numbers. Sleeping is done on eventfds,
+ * so a producer waiting for the ring to drain (or for free space) is woken as
+ * soon as the ring thread makes progress instead of polling with a fixed sleep.
+ */
 class RingBuffer
 {
 private:
-    std::vector<AnyTask> buffer;
-    int head = 0;
-    int tail = 0;
+    struct Slot
+    {
+        std::atomic<size_t> seq;
+        AnyTask task;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask;
+    size_t m_capacity;
+
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+
     std::set<std::string> m_consumerSet;
 
-    std::condition_variable cv;
-    std::mutex mtx;
-    bool idle_status = true;
+    // signaled by producers, the ring thread sleeps on it when the ring is empty
+    int m_wakeFd = -1;
+    // signaled by the ring thread on progress while producers are waiting on it
+    int m_progressFd = -1;
+    std::atomic<int> m_waiters{0};
+
+    std::atomic<bool> idle_status{true};
+
+    void signalProgress();
+    void waitProgress();
 
 public:
     RingBuffer(int size=RING_SIZE);
-    bool thread_created = false;
+    ~RingBuffer();
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    std::atomic<bool> thread_created{false};
     std::atomic<bool> thread_exited{false};
 
     // pause the ring thread if the buffer is empty
@@ -219,10 +365,19 @@ public:
     // wake up the ring thread in case it's locked but not empty
     void notify();
 
+    // block the caller until the ring is empty and the ring thread is idle
+    void waitUntilDrained();
+    // block the caller until there is room for at least one more task
+    void waitForSpace();
+
     bool IsFull() const;
     bool IsEmpty() const;
     bool IsIdle() const;
 
+    size_t capacity() const { return m_capacity; }
+    // tasks pushed and not popped yet
+    size_t size() const { return m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed); }
+
     bool push(AnyTask entry);
     bool pop(AnyTask& entry);
 
@@ -238,6 +393,13 @@ public:
     {
     }
 
+    ~Consumer() override
+    {
+        // The table may use m_prefetchDb, release it first
+        delete m_selectable;
+        m_selectable = nullptr;
+    }
+
     swss::ConsumerTableBase *getConsumerTable() const override
     {
         // ConsumerTableBase is a subclass of TableBase
@@ -262,6 +424,26 @@ public:
 
     void execute() override;
     void drain() override;
+
+    /* Add entries popped by a ConsumerPrefetcher and drain them, as execute() does */
+    void execute(std::shared_ptr<std::deque<swss::KeyOpFieldsValuesTuple>> entries);
+
+    /*
+     * Tables popped on a reader thread by a ConsumerPrefetcher. Must be set
+     * before the Orchs are constructed, the tables get a DB connection of
+     * their own so they can be popped off the main thread.
+     */
+    static void setPrefetchTables(const std::set<std::string> &tableNames) { m_prefetchTables = tableNames; }
+    static bool isPrefetchTable(const std::string &tableName) { return m_prefetchTables.count(tableName) != 0; }
+
+    /* Hand over the DB connection the table was created on, see setPrefetchTables() */
+    void setPrefetchDb(swss::DBConnector *db) { m_prefetchDb.reset(db); }
+    bool isPrefetchable() const { return m_prefetchDb != nullptr; }
+
+private:
+    static std::set<std::string> m_prefetchTables;
+
+    std::unique_ptr<swss::DBConnector> m_prefetchDb;
 };
 
 typedef enum
@@ -320,12 +502,95 @@ public:
      */
     virtual void onWarmBootEnd() { }
 
+    /*
+     * Append the sizes of the main object tables of this Orch, published to
+     * STATE_DB by OrchAgentStatsOrch. Called between doTask runs, it must
+     * only read sizes which are cheap to get.
+     */
+    virtual void getObjectCounts(std::vector<swss::FieldValueTuple> &counts) const { }
+
     void dumpPendingTasks(std::vector<std::string> &ts);
+
+    /* Append the (table, count) of each consumer with pending tasks, the counts are read in O(1) */
+    void getPendingTaskCounts(std::vector<std::pair<std::string, size_t>> &counts);
     
     void createRetryCache(const std::string &executorName);
     RetryCache* getRetryCache(const std::string &executorName);
     ConsumerBase* getConsumerBase(const std::string &executorName);
 
+    /**
+     * @brief Switch the pending task store of a consumer to the hashed index.
+     * Keys are then drained in arrival order instead of key order, so only
+     * consumers whose doTask does not depend on key order should opt in.
+     * @param executorName - name of the consumer
+     * @param mode - task store index flavour
+     */
+    void setTaskStoreMode(const std::string &executorName, SyncMap::Mode mode);
+
+    /**
+     * @brief Override the drain time slice of a consumer, see ConsumerBase::sliceExpired()
+     * @param executorName - name of the consumer
+     * @param slice - time slice, zero to let doTask run to completion
+     */
+    void setTimeSlice(const std::string &executorName, std::chrono::milliseconds slice);
+
+    /* Highest priority among the executors of this Orch */
+    int getPriority() const;
+
+    /* Account a scheduling round that ran out of budget before this Orch was served */
+    void recordDeferred();
+
+    /**
+     * @brief Declare the Orchs whose state doTask of this Orch reads or modifies,
+     * typically the ones it reaches through gDirectory. An Orch which declared its
+     * dependencies may be run on an OrchDaemon worker thread, concurrently with the
+     * Orchs it is not connected to. An Orch which never declared them is assumed to
+     * depend on any other Orch and always runs on the main thread.
+     * Orchs exposing thread safe APIs only, such as the CRM usage counters, need not
+     * be declared. Null entries, Orchs absent on the platform, are ignored.
+     * @param dependencies - Orchs this Orch depends on
+     */
+    void declareDependencies(const std::vector<Orch *> &dependencies);
+    bool hasDeclaredDependencies() const { return m_dependenciesDeclared; }
+    const std::set<Orch *> &getDependencies() const { return m_dependencies; }
+
+    /* Apply ConsumerBase::setDeferredDrain() to all consumers */
+    void setDeferredDrain(bool deferred);
+
+    /**
+     * @brief Leave the drains of the consumers of this Orch to owner, whose
+     * doTask() serves them through drainExecutor() in its own order, typically
+     * across the tables of several Orchs. The consumers are always deferred and
+     * doTask() of this Orch no longer drains them.
+     * @param owner - Orch serving the consumers, nullptr to serve them again
+     */
+    void setDrainOwner(Orch *owner);
+    Orch *getDrainOwner() const { return m_drainOwner; }
+
+    /**
+     * @brief Move the resolved retries of a consumer back to its SyncMap and
+     * drain it, as doTask() does for each consumer
+     * @param executorName - name of the consumer
+     */
+    void drainExecutor(const std::string &executorName);
+
+    /* True if any consumer has pending tasks */
+    bool hasPendingTasks() const;
+
+    /* Number of tasks pending in the consumers */
+    size_t getPendingTaskCount() const;
+
+    /* True if the last drain of any consumer yielded at the end of its slice */
+    bool hasYieldedDrains() const;
+
+    /* True if a RetryCache holds tasks whose constraints were resolved */
+    bool hasResolvedRetries() const;
+
+    /* Consumers whose table bake() reads, see ConsumerBase::preloadToSync() */
+    void getRefillConsumers(std::vector<ConsumerBase *> &consumers) const;
+    /* Drop what was preloaded and not refilled by bake() */
+    void clearPreloaded();
+
     /** 
      * @brief Add the failed task and its constraint to the consumer's RetryCache
      * @param executorName - name of the consumer
@@ -380,8 +645,15 @@ protected:
     Executor *getExecutor(std::string executorName);
 
     ResponsePublisher m_publisher{"APPL_STATE_DB"};
-private:
+
     void addConsumer(swss::DBConnector *db, std::string tableName, int pri = default_orch_pri);
+private:
+
+    size_t drainExecutor(const std::string &executorName, Executor *executor, size_t quota);
+
+    std::set<Orch *> m_dependencies;
+    bool m_dependenciesDeclared = false;
+    Orch *m_drainOwner = nullptr;
 };
 
 #include "request_parser.h"
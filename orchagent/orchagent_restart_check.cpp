@@ -19,6 +19,8 @@ void printUsage()
     std::cout << "        Don't freeze orchagent even if check succeeded" << std::endl;
     std::cout << "    -s --skipPendingTaskCheck" << std::endl;
     std::cout << "        Skip pending task dependency check for orchagent" << std::endl;
+    std::cout << "    -d --dumpPendingTasks" << std::endl;
+    std::cout << "        Log every pending task of orchagent, not only their count per table" << std::endl;
     std::cout << "    -w --waitTime" << std::endl;
     std::cout << "        Wait time for response from orchagent, in milliseconds. Default value: 1000" << std::endl;
     std::cout << "    -r --retryCount" << std::endl;
@@ -40,6 +42,8 @@ void printUsage()
  *            if --noFreeze option is provided, orchagent won't freeze.
  *            if --skipPendingTaskCheck option is provided, orchagent won't use
  *                 whether there is pending task existing as state check criterion.
+ *            if --dumpPendingTasks option is provided, orchagent logs its pending
+ *                 tasks, not only their count per table.
  */
 int main(int argc, char **argv)
 {
@@ -48,17 +52,19 @@ int main(int argc, char **argv)
 
     std::string skipPendingTaskCheck = "false";
     std::string noFreeze            = "false";
+    std::string dumpPendingTasks    = "false";
     /* Default wait time is 1000 millisecond */
     int waitTime = 1000;
     int retryCount = 0;
 
-    const char* const optstring = "nsw:r:";
+    const char* const optstring = "nsdw:r:";
     while(true)
     {
         static struct option long_options[] =
         {
             { "noFreeze",                no_argument,       0, 'n' },
             { "skipPendingTaskCheck",    no_argument,       0, 's' },
+            { "dumpPendingTasks",        no_argument,       0, 'd' },
             { "retryCount",              required_argument, 0, 'r' },
             { "waitTime",                required_argument, 0, 'w' }
         };
@@ -82,6 +88,10 @@ int main(int argc, char **argv)
                 SWSS_LOG_NOTICE("Skipping pending task check for orchagent");
                 skipPendingTaskCheck = "true";
                 break;
+            case 'd':
+                SWSS_LOG_NOTICE("Dumping pending tasks of orchagent");
+                dumpPendingTasks = "true";
+                break;
             case 'w':
                 SWSS_LOG_NOTICE("Wait time for response from orchagent set to %s milliseconds", optarg);
                 waitTime = atoi(optarg);
@@ -118,6 +128,7 @@ int main(int argc, char **argv)
     std::vector<swss::FieldValueTuple> values;
     values.emplace_back("NoFreeze", noFreeze);
     values.emplace_back("SkipPendingTaskCheck", skipPendingTaskCheck);
+    values.emplace_back("DumpPendingTasks", dumpPendingTasks);
     std::string op = "orchagent";
 
     int retries = 0;
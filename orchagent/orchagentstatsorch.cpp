@@ -0,0 +1,100 @@
+#include "orchagentstatsorch.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+OrchAgentStatsOrch::OrchAgentStatsOrch(const vector<Orch *> &orchs, int intervalSec) :
+    Orch(),
+    m_orchs(orchs),
+    m_stateDb(new DBConnector("STATE_DB", 0)),
+    m_pipeline(new RedisPipeline(m_stateDb.get())),
+    m_statsTable(new Table(m_pipeline.get(), ORCHAGENT_STATS_TABLE, true))
+{
+    SWSS_LOG_ENTER();
+
+    // Stale entries from the previous run would be misleading
+    Table table(m_stateDb.get(), ORCHAGENT_STATS_TABLE);
+    vector<string> keys;
+    table.getKeys(keys);
+    for (const auto &key : keys)
+    {
+        table.del(key);
+    }
+
+    auto interv = timespec { .tv_sec = intervalSec, .tv_nsec = 0 };
+    m_timer = new SelectableTimer(interv);
+
+    // Note: ExecutableTimer will hold m_timer pointer and release the object later
+    m_executor = new ExecutableTimer(m_timer, this, "ORCHAGENT_STATS_POLL");
+    Orch::addExecutor(m_executor);
+    if (gRingBuffer)
+    {
+        // Route tasks run on the ring thread, so does the snapshot of their tables
+        gRingBuffer->addExecutor(m_executor);
+    }
+    m_timer->start();
+
+    SWSS_LOG_NOTICE("Orchagent statistics are published every %d seconds", intervalSec);
+}
+
+void OrchAgentStatsOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    m_executor->processAnyTask([this]() { publish(); });
+}
+
+void OrchAgentStatsOrch::publishEntry(const string &key, vector<FieldValueTuple> &fvs)
+{
+    auto &last = m_published[key];
+    if (last == fvs)
+    {
+        return;
+    }
+
+    m_statsTable->set(key, fvs);
+    last.swap(fvs);
+}
+
+void OrchAgentStatsOrch::publish()
+{
+    vector<FieldValueTuple> fvs;
+
+    for (auto &it : ExecutorStatsRegistry::instance().getAll())
+    {
+        auto &stats = *it.second;
+
+        fvs.clear();
+        fvs.emplace_back("to_sync", to_string(stats.toSyncPending.load(memory_order_relaxed)));
+        fvs.emplace_back("retry_pending", to_string(stats.retryPending.load(memory_order_relaxed)));
+        publishEntry(ORCHAGENT_STATS_CONSUMER_PREFIX + it.first, fvs);
+    }
+
+    for (auto &it : ExecutorStatsRegistry::instance().getAllBulkerStats())
+    {
+        fvs.clear();
+        fvs.emplace_back("pending", to_string(it.second->pending.load(memory_order_relaxed)));
+        publishEntry(ORCHAGENT_STATS_BULKER_PREFIX + it.first, fvs);
+    }
+
+    if (gRingBuffer)
+    {
+        fvs.clear();
+        fvs.emplace_back("occupancy", to_string(gRingBuffer->size()));
+        fvs.emplace_back("capacity", to_string(gRingBuffer->capacity()));
+        publishEntry(ORCHAGENT_STATS_RING_BUFFER_KEY, fvs);
+    }
+
+    fvs.clear();
+    for (auto *orch : m_orchs)
+    {
+        orch->getObjectCounts(fvs);
+    }
+    if (!fvs.empty())
+    {
+        publishEntry(ORCHAGENT_STATS_OBJECTS_KEY, fvs);
+    }
+
+    m_pipeline->flush();
+}
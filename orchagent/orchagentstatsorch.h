@@ -0,0 +1,57 @@
+#ifndef SWSS_ORCHAGENTSTATSORCH_H
+#define SWSS_ORCHAGENTSTATSORCH_H
+
+#include <map>
+
+#include "orch.h"
+#include "timer.h"
+#include "redispipeline.h"
+#include "executorstats.h"
+
+#define ORCHAGENT_STATS_TABLE                   "ORCHAGENT_STATS"
+#define ORCHAGENT_STATS_POLL_INTERVAL_DEFAULT   1
+#define ORCHAGENT_STATS_CONSUMER_PREFIX         "CONSUMER|"
+#define ORCHAGENT_STATS_BULKER_PREFIX           "BULKER|"
+#define ORCHAGENT_STATS_RING_BUFFER_KEY         "RING_BUFFER"
+#define ORCHAGENT_STATS_OBJECTS_KEY             "OBJECTS"
+
+/*
+ * Periodically publishes the backlog of orchagent into STATE_DB:ORCHAGENT_STATS:
+ *  CONSUMER|<executor> - to_sync, m_toSync size, and retry_pending, RetryCache size
+ *  BULKER|<object type> - entries queued in the EntityBulkers
+ *  RING_BUFFER         - tasks queued in the ring and its capacity
+ *  OBJECTS             - table sizes reported by Orch::getObjectCounts()
+ *
+ * The backlog gauges are kept by ExecutorStatsRegistry, which must be
+ * enabled. A snapshot reads atomics and container sizes, and only writes
+ * the entries whose values changed, in a single pipelined round trip.
+ * With the ring thread running the snapshot is queued to the ring, where
+ * it runs in between the route tasks.
+ */
+class OrchAgentStatsOrch : public Orch
+{
+public:
+    OrchAgentStatsOrch(const std::vector<Orch *> &orchs, int intervalSec = ORCHAGENT_STATS_POLL_INTERVAL_DEFAULT);
+
+    void doTask(swss::SelectableTimer &timer) override;
+    void doTask(Consumer &consumer) override {}
+
+    void publish();
+
+private:
+    void publishEntry(const std::string &key, std::vector<swss::FieldValueTuple> &fvs);
+
+    // Orchs of the OrchDaemon, asked for their object counts
+    const std::vector<Orch *> &m_orchs;
+
+    std::shared_ptr<swss::DBConnector> m_stateDb;
+    std::unique_ptr<swss::RedisPipeline> m_pipeline;
+    std::unique_ptr<swss::Table> m_statsTable;
+    swss::SelectableTimer *m_timer = nullptr;
+    Executor *m_executor = nullptr;
+
+    // Last published values per key
+    std::map<std::string, std::vector<swss::FieldValueTuple>> m_published;
+};
+
+#endif /* SWSS_ORCHAGENTSTATSORCH_H */
@@ -1,10 +1,17 @@
 #include <unistd.h>
+#include <inttypes.h>
 #include <unordered_map>
+#include <algorithm>
 #include <chrono>
 #include <limits.h>
 #include <errno.h>
 #include <signal.h>
 #include "orchdaemon.h"
+#include "orchprobes.h"
+#include "boottimeline.h"
+#include "warmreplay.h"
+#include "warmcheckpoint.h"
+#include "converter.h"
 #include "logger.h"
 #include <sairedis.h>
 #include "warm_restart.h"
@@ -21,6 +28,8 @@ using namespace swss;
 
 /* select() function timeout retry time */
 #define SELECT_TIMEOUT 1000
+/* Poll interval while an Orch group is still busy on a worker thread */
+#define WORKER_WAIT_MSECONDS 10
 #define PFC_WD_POLL_MSECS 100
 
 #define APP_FABRIC_MONITOR_PORT_TABLE_NAME      "FABRIC_PORT_TABLE"
@@ -33,6 +42,8 @@ extern string                      gMySwitchSubType;
 extern bool                        gOrchUnhealthy;
 extern string                      gSaiErrorString;
 volatile sig_atomic_t              gOrchShutdownRequested = 0;
+volatile sig_atomic_t              gFlightRecorderDumpRequested = 0;
+volatile sig_atomic_t              gMemAccountingDumpRequested = 0;
 
 extern void syncd_apply_view();
 /*
@@ -97,6 +108,12 @@ OrchDaemon::~OrchDaemon()
 {
     SWSS_LOG_ENTER();
 
+    // Stop popping before the Consumers go away
+    m_prefetchers.clear();
+
+    // Let the worker threads complete their groups before any Orch goes away
+    m_workerPool.reset();
+
     /*
      * Stop the ring thread before deleting orch pointers.
      *
@@ -170,11 +187,11 @@ void OrchDaemon::popRingBuffer()
 /**
  * This function initializes gRingBuffer, otherwise it's nullptr.
  */
-void OrchDaemon::enableRingBuffer() {
-    gRingBuffer = std::make_shared<RingBuffer>();
+void OrchDaemon::enableRingBuffer(int size) {
+    gRingBuffer = std::make_shared<RingBuffer>(size);
     Executor::gRingBuffer = gRingBuffer;
     Orch::gRingBuffer = gRingBuffer;
-    SWSS_LOG_NOTICE("RingBuffer created at %p!", (void *)gRingBuffer.get());
+    SWSS_LOG_NOTICE("RingBuffer created at %p with capacity %zu!", (void *)gRingBuffer.get(), gRingBuffer->capacity());
 }
 
 void OrchDaemon::disableRingBuffer() {
@@ -229,7 +246,17 @@ bool OrchDaemon::init()
         { APP_MCLAG_FDB_TABLE_NAME,  FdbOrch::fdborch_pri}
     };
 
-    gPortsOrch = new PortsOrch(m_applDb, m_stateDb, ports_tables, m_chassisAppDb);
+    /* Listens to the flex counter managers, so it has to exist before PortsOrch installs counters */
+    if (CounterSnapshotOrch::isEnabled())
+    {
+        CounterSnapshotOrch::getInstance(m_configDb);
+    }
+
+    // Enable the teammgrd, teamsyncd and mclagsyncd to send LAG events to orchagent via the ZMQ channel.
+    auto enable_lag_zmq = get_feature_status(ORCH_NORTHBOND_LAG_ZMQ_ENABLED, false);
+    auto lag_zmq_server = enable_lag_zmq ? m_zmqServer : nullptr;
+
+    gPortsOrch = new PortsOrch(m_applDb, m_stateDb, ports_tables, m_chassisAppDb, lag_zmq_server);
     TableConnector stateDbFdb(m_stateDb, STATE_FDB_TABLE_NAME);
     TableConnector stateMclagDbFdb(m_stateDb, STATE_MCLAG_REMOTE_FDB_TABLE_NAME);
     gFdbOrch = new FdbOrch(m_applDb, app_fdb_tables, stateDbFdb, stateMclagDbFdb, gPortsOrch);
@@ -293,9 +320,18 @@ bool OrchDaemon::init()
     ChassisOrch* chassis_frontend_orch = new ChassisOrch(m_configDb, m_applDb, chassis_frontend_tables, vnet_rt_orch);
     gDirectory.set(chassis_frontend_orch);
 
-    gIntfsOrch = new IntfsOrch(m_applDb, APP_INTF_TABLE_NAME, vrf_orch, m_chassisAppDb);
+    // Enable the intfmgrd and mclagsyncd to send INTF events to orchagent via the ZMQ channel.
+    auto enable_intf_zmq = get_feature_status(ORCH_NORTHBOND_INTF_ZMQ_ENABLED, false);
+    auto intf_zmq_server = enable_intf_zmq ? m_zmqServer : nullptr;
+
+    gIntfsOrch = new IntfsOrch(m_applDb, APP_INTF_TABLE_NAME, vrf_orch, m_chassisAppDb, intf_zmq_server);
     gDirectory.set(gIntfsOrch);
-    gNeighOrch = new NeighOrch(m_applDb, APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassisAppDb);
+
+    // Enable the neighsyncd to send NEIGH events to orchagent via the ZMQ channel.
+    auto enable_neigh_zmq = get_feature_status(ORCH_NORTHBOND_NEIGH_ZMQ_ENABLED, false);
+    auto neigh_zmq_server = enable_neigh_zmq ? m_zmqServer : nullptr;
+
+    gNeighOrch = new NeighOrch(m_applDb, APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassisAppDb, neigh_zmq_server);
     gDirectory.set(gNeighOrch);
 
     const int fgnhgorch_pri = 15;
@@ -400,6 +436,11 @@ bool OrchDaemon::init()
 
     TableConnector stateDbStorm(m_stateDb, "BUM_STORM_CAPABILITY");
     gPolicerOrch = new PolicerOrch(policer_tables, gPortsOrch);
+    // Storm control bindings of one rate share a policer where the platform meters each port on its own
+    if (getenv("STORM_CONTROL_SHARED_POLICER") && string(getenv("STORM_CONTROL_SHARED_POLICER")) == "1")
+    {
+        gPolicerOrch->setStormControlPolicerSharing(true);
+    }
 
     TableConnector stateDbMirrorSession(m_stateDb, STATE_MIRROR_SESSION_TABLE_NAME);
     TableConnector confDbMirrorSession(m_configDb, CFG_MIRROR_SESSION_TABLE_NAME);
@@ -843,6 +884,11 @@ bool OrchDaemon::init()
     }
 
     m_orchList.push_back(&CounterCheckOrch::getInstance(m_configDb));
+    m_orchList.push_back(&CounterRatesOrch::getInstance(m_configDb));
+    if (CounterSnapshotOrch::isEnabled())
+    {
+        m_orchList.push_back(&CounterSnapshotOrch::getInstance(m_configDb));
+    }
 
     vector<string> p4rt_tables = {APP_P4RT_TABLE_NAME};
     m_p4OrchZmqServer = new swss::ZmqServer(m_p4OrchZmqServerEp, "", false, true);
@@ -869,6 +915,19 @@ bool OrchDaemon::init()
         SWSS_LOG_NOTICE("High Frequency Telemetry is not supported on this platform");
     }
 
+    if (m_executorStatsInterval > 0)
+    {
+        m_orchList.push_back(new ExecutorStatsOrch(m_executorStatsInterval));
+    }
+
+    if (m_orchAgentStatsInterval > 0)
+    {
+        m_orchList.push_back(new OrchAgentStatsOrch(m_orchList, m_orchAgentStatsInterval));
+    }
+
+    // Close the construction phases before the warm restore
+    BootTimeline::instance().addOrchConstruction(m_orchList);
+
     if (WarmStart::isWarmStart())
     {
         bool suc = warmRestoreAndSyncUp();
@@ -882,7 +941,7 @@ bool OrchDaemon::init()
 }
 
 /* Flush redis through sairedis interface */
-void OrchDaemon::flush()
+void OrchDaemon::flushSaiRedis()
 {
     SWSS_LOG_ENTER();
 
@@ -894,6 +953,15 @@ void OrchDaemon::flush()
         SWSS_LOG_ERROR("Failed to flush redis pipeline %d", status);
         handleSaiFailure(SAI_API_SWITCH, "set", status, true);
     }
+}
+
+void OrchDaemon::flush(FlushPolicy::Reason reason)
+{
+    SWSS_LOG_ENTER();
+
+    ORCH_PROBE1(orchdaemon__flush__entry, static_cast<int>(reason));
+    flushSaiRedis();
+    m_flushPolicy.flushed(std::chrono::steady_clock::now(), reason);
 
     /*
      * Don't flush if ringbuffer is enable and it is not empty or Idle. Ring buffer thread
@@ -911,9 +979,41 @@ void OrchDaemon::flush()
     {
         for (auto* orch: m_orchList)
         {
+            // Orchs served by a worker thread flush their own responses
+            if (m_workerGroupOf.find(orch) != m_workerGroupOf.end())
+            {
+                continue;
+            }
             orch->flushResponses();
         }
     }
+    ORCH_PROBE1(orchdaemon__flush__return, static_cast<int>(reason));
+}
+
+void OrchDaemon::adaptiveFlush()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    // Timers and notification handlers do not report their SAI calls, an event counts at least one op
+    m_flushPolicy.addOps(std::max<size_t>(ConsumerBase::takeDrainedTasks(), 1), now);
+
+    auto reason = m_flushPolicy.check(now);
+    if (reason != FlushPolicy::Reason::NONE)
+    {
+        flush(reason);
+    }
+}
+
+void OrchDaemon::setFlushPolicy(int latencyMsec, size_t batchOps)
+{
+    SWSS_LOG_ENTER();
+
+    m_flushPolicy.configure(latencyMsec, batchOps);
+
+    if (m_flushPolicy.isAdaptive())
+    {
+        SWSS_LOG_NOTICE("Flushing sairedis within %d ms or every %zu ops", latencyMsec, batchOps);
+    }
 }
 
 /* Release the file handle so the log can be rotated */
@@ -929,6 +1029,302 @@ void OrchDaemon::logRotate() {
     }
 }
 
+void OrchDaemon::setSchedulerConfig(int timeSliceMsec, int roundBudgetMsec)
+{
+    SWSS_LOG_ENTER();
+
+    ConsumerBase::setDefaultTimeSlice(std::chrono::milliseconds(std::max(timeSliceMsec, 0)));
+    m_roundBudgetMsec = std::max(roundBudgetMsec, 0);
+
+    // Table priorities only apply to a bounded scheduler, called before the Orchs are created
+    Executor::setInheritPriority(timeSliceMsec > 0 || roundBudgetMsec > 0);
+
+    SWSS_LOG_NOTICE("Drain time slice %d ms, doTask round budget %d ms", timeSliceMsec, roundBudgetMsec);
+}
+
+void OrchDaemon::setWorkerThreads(int threads)
+{
+    m_workerThreads = std::max(threads, 0);
+}
+
+void OrchDaemon::setBakeThreads(int threads)
+{
+    m_bakeThreads = std::max(threads, 0);
+}
+
+/*
+ * Split the Orchs into the group served on the main thread and the groups
+ * which may be served on worker threads. Orchs connected through declared
+ * dependencies end up in the same group, so they never run concurrently.
+ * Orchs without declared dependencies, and any Orch connected to one of them,
+ * stay on the main thread.
+ */
+void OrchDaemon::buildRoundGroups()
+{
+    SWSS_LOG_ENTER();
+
+    waitForWorkers();
+
+    for (auto &group : m_workerGroups)
+    {
+        for (Orch *o : group->orchs)
+        {
+            o->setDeferredDrain(false);
+        }
+    }
+    m_workerGroups.clear();
+    m_workerGroupOf.clear();
+    m_serialOrchs.clear();
+
+    size_t total = m_orchList.size();
+
+    // Union-find over m_orchList, index total stands for the main thread group
+    std::vector<size_t> parent(total + 1);
+    for (size_t i = 0; i <= total; i++)
+    {
+        parent[i] = i;
+    }
+
+    auto find = [&](size_t i) {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    auto unite = [&](size_t a, size_t b) {
+        a = find(a);
+        b = find(b);
+        // The main thread group is always the root, so it is easy to tell apart
+        if (a == total)
+        {
+            parent[b] = a;
+        }
+        else
+        {
+            parent[a] = b;
+        }
+    };
+
+    std::unordered_map<Orch *, size_t> index;
+    for (size_t i = 0; i < total; i++)
+    {
+        index[m_orchList[i]] = i;
+    }
+
+    for (size_t i = 0; i < total; i++)
+    {
+        Orch *o = m_orchList[i];
+
+        if (!m_workerPool || !o->hasDeclaredDependencies())
+        {
+            unite(total, i);
+            continue;
+        }
+
+        for (Orch *dep : o->getDependencies())
+        {
+            auto it = index.find(dep);
+            // An Orch not in the list is not scheduled and can only be reached from the main thread
+            unite(it == index.end() ? total : it->second, i);
+        }
+    }
+
+    std::unordered_map<size_t, WorkerGroup *> groups;
+    for (size_t i = 0; i < total; i++)
+    {
+        Orch *o = m_orchList[i];
+        size_t root = find(i);
+
+        if (root == total)
+        {
+            m_serialOrchs.push_back(o);
+            continue;
+        }
+
+        auto &group = groups[root];
+        if (!group)
+        {
+            m_workerGroups.emplace_back(new WorkerGroup());
+            group = m_workerGroups.back().get();
+        }
+
+        group->orchs.push_back(o);
+        m_workerGroupOf[o] = group;
+        o->setDeferredDrain(true);
+    }
+
+    m_roundOrder = m_serialOrchs;
+    std::stable_sort(m_roundOrder.begin(), m_roundOrder.end(),
+                     [](Orch *a, Orch *b) { return a->getPriority() > b->getPriority(); });
+    m_roundCursor = 0;
+    m_groupedOrchCount = total;
+
+    if (m_workerPool)
+    {
+        SWSS_LOG_NOTICE("%zu Orchs run on the main thread, %zu independent groups run on %zu worker threads",
+                        m_serialOrchs.size(), m_workerGroups.size(), m_workerPool->size());
+    }
+}
+
+/*
+ * Return the selectable serving the given one in the main loop: a
+ * ConsumerPrefetcher for the Consumers created for prefetching, the
+ * selectable itself otherwise. Consumers of worker groups and of the ring
+ * thread keep being popped on the main thread, m_toSync can only be looked
+ * at from there while it is drained on the main thread.
+ */
+Selectable *OrchDaemon::prefetch(Selectable *selectable)
+{
+    auto consumer = dynamic_cast<Consumer *>(selectable);
+    if (consumer == nullptr || !consumer->isPrefetchable())
+    {
+        return selectable;
+    }
+
+    if (gRingBuffer || m_workerGroupOf.find(consumer->getOrch()) != m_workerGroupOf.end())
+    {
+        SWSS_LOG_WARN("Prefetching %s is not supported off the main thread, ignored", consumer->getName().c_str());
+        return selectable;
+    }
+
+    m_prefetchers.emplace_back(new ConsumerPrefetcher(consumer, m_prefetchDepth));
+    return m_prefetchers.back().get();
+}
+
+void OrchDaemon::startPrefetchers()
+{
+    for (auto &prefetcher : m_prefetchers)
+    {
+        prefetcher->start();
+    }
+}
+
+void OrchDaemon::stopPrefetchers()
+{
+    for (auto &prefetcher : m_prefetchers)
+    {
+        prefetcher->stop();
+    }
+}
+
+/* Let the readers of the Consumers drained below their depth limit pop again */
+void OrchDaemon::updatePrefetchers()
+{
+    for (auto &prefetcher : m_prefetchers)
+    {
+        prefetcher->updateBackpressure();
+    }
+}
+
+/* Serve one group of Orchs on a worker thread */
+void OrchDaemon::runWorkerGroup(WorkerGroup &group)
+{
+    bool active = false;
+    for (Orch *o : group.orchs)
+    {
+        active = active || o->hasPendingTasks();
+    }
+
+    // The worker has no other duty, so drains yielding at the end of their slice are resumed right away
+    bool yielded;
+    do
+    {
+        yielded = false;
+        for (Orch *o : group.orchs)
+        {
+            o->doTask();
+            yielded = yielded || o->hasYieldedDrains();
+        }
+    } while (yielded);
+
+    // Each worker flushes what it produced instead of waiting for the main loop
+    if (active)
+    {
+        for (Orch *o : group.orchs)
+        {
+            o->flushResponses();
+        }
+        flushSaiRedis();
+    }
+
+    group.busy = false;
+}
+
+void OrchDaemon::waitForWorkers()
+{
+    if (m_workerPool)
+    {
+        m_workerPool->wait();
+    }
+}
+
+/*
+ * Run doTask() of the Orchs to serve pending and retried tasks.
+ *
+ * Groups of independent Orchs are handed to the worker threads, they keep
+ * running while the main loop serves other events and are waited for only
+ * before one of their executors is executed.
+ *
+ * Without a round budget the main thread Orchs are served in m_orchList
+ * order. With a budget they are served in priority order and the round stops
+ * once the budget is used up, the next round resumes at the first Orch left
+ * out so low priority Orchs can not be starved by a busy high priority one.
+ */
+void OrchDaemon::runDoTaskRound()
+{
+    if (m_groupedOrchCount != m_orchList.size())
+    {
+        buildRoundGroups();
+    }
+
+    m_workersPending = false;
+    for (auto &group : m_workerGroups)
+    {
+        if (group->busy)
+        {
+            // Still serving the previous round, look again shortly
+            m_workersPending = true;
+            continue;
+        }
+
+        group->busy = true;
+        WorkerGroup *g = group.get();
+        m_workerPool->submit([this, g]() { runWorkerGroup(*g); });
+    }
+
+    if (m_roundBudgetMsec == 0)
+    {
+        for (Orch *o : m_serialOrchs)
+            o->doTask();
+
+        m_roundPending = ConsumerBase::takePendingDrains();
+        updatePrefetchers();
+        return;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_roundBudgetMsec);
+    size_t total = m_roundOrder.size();
+    size_t served = 0;
+
+    // The first Orch of a round is always served so every round makes progress
+    while (served < total && (served == 0 || std::chrono::steady_clock::now() < deadline))
+    {
+        m_roundOrder[(m_roundCursor + served) % total]->doTask();
+        served++;
+    }
+
+    for (size_t i = served; i < total; i++)
+    {
+        m_roundOrder[(m_roundCursor + i) % total]->recordDeferred();
+    }
+
+    bool deferred = served < total;
+    m_roundCursor = deferred ? (m_roundCursor + served) % total : 0;
+    m_roundPending = ConsumerBase::takePendingDrains() || deferred;
+    updatePrefetchers();
+}
 
 void OrchDaemon::start(long heartBeatInterval)
 {
@@ -938,11 +1334,33 @@ void OrchDaemon::start(long heartBeatInterval)
 
     ring_thread = std::thread(&OrchDaemon::popRingBuffer, this);
 
+    if (m_workerThreads > 0)
+    {
+        if (gRingBuffer)
+        {
+            SWSS_LOG_WARN("Orch worker threads are not supported together with the ring thread, ignored");
+        }
+        else
+        {
+            m_workerPool.reset(new OrchWorkerPool(m_workerThreads));
+        }
+    }
+
+    // Consumers are only prefetched for the Orchs staying on the main thread
+    buildRoundGroups();
+
     for (Orch *o : m_orchList)
     {
-        m_select->addSelectables(o->getSelectables());
+        for (Selectable *s : o->getSelectables())
+        {
+            m_select->addSelectable(prefetch(s));
+        }
     }
 
+    startPrefetchers();
+
+    m_flushPolicy.setStats(ExecutorStatsRegistry::instance().attachFlushStats());
+
     auto tstart = std::chrono::high_resolution_clock::now();
 
     while (true)
@@ -956,7 +1374,25 @@ void OrchDaemon::start(long heartBeatInterval)
             break;
         }
 
-        ret = m_select->select(&s, SELECT_TIMEOUT);
+        int timeout = SELECT_TIMEOUT;
+        if (m_roundPending)
+        {
+            // Resume the tasks left over by the previous round as soon as no event is ready,
+            // unless the ring thread is still busy and the round would not run anyway
+            timeout = (gRingBuffer && !gRingBuffer->IsIdle()) ? RING_WAIT_MSECONDS : 0;
+        }
+        else if (m_workersPending)
+        {
+            timeout = WORKER_WAIT_MSECONDS;
+        }
+
+        auto twait = std::chrono::steady_clock::now();
+        // Wake up in time to flush the pending ops within the latency target
+        timeout = m_flushPolicy.timeout(twait, timeout);
+
+        ret = m_select->select(&s, timeout);
+
+        m_flushPolicy.recordWait(std::chrono::steady_clock::now() - twait);
 
         if (gOrchShutdownRequested != 0)
         {
@@ -964,6 +1400,18 @@ void OrchDaemon::start(long heartBeatInterval)
             break;
         }
 
+        if (gFlightRecorderDumpRequested != 0)
+        {
+            gFlightRecorderDumpRequested = 0;
+            dumpFlightRecorders("SIGUSR1");
+        }
+
+        if (gMemAccountingDumpRequested != 0)
+        {
+            gMemAccountingDumpRequested = 0;
+            MemAccounting::instance().dump(m_stateDb, "SIGUSR2");
+        }
+
         /*
          * Log an error message periodically if a previous SAI API call failed with
          * an unrecoverable error.
@@ -1002,8 +1450,18 @@ void OrchDaemon::start(long heartBeatInterval)
              * Normally the redis pipeline will flush when enough request
              * accumulated. Still it is possible that small amount of
              * requests live in it. When the daemon has nothing to do, it
-             * is a good chance to flush the pipeline  */
-            flush();
+             * is a good chance to flush the pipeline. The adaptive policy
+             * only flushes when ops are pending, the periodic flush above
+             * still catches what it does not account for. */
+            if (!m_flushPolicy.isAdaptive())
+            {
+                flush(FlushPolicy::Reason::IDLE);
+            }
+            else if (m_flushPolicy.getPendingOps() != 0)
+            {
+                auto reason = m_flushPolicy.check(std::chrono::steady_clock::now());
+                flush(reason != FlushPolicy::Reason::NONE ? reason : FlushPolicy::Reason::IDLE);
+            }
 
             if (gRingBuffer)
             {
@@ -1013,10 +1471,16 @@ void OrchDaemon::start(long heartBeatInterval)
                 }
                 else
                 {
-                    for (Orch *o : m_orchList)
-                        o->doTask();
+                    runDoTaskRound();
                 }
             }
+            else if (m_roundPending || m_workersPending)
+            {
+                runDoTaskRound();
+            }
+
+            // Flushed on the next event or when their latency target is up
+            m_flushPolicy.addOps(ConsumerBase::takeDrainedTasks(), std::chrono::steady_clock::now());
 
             continue;
         }
@@ -1030,6 +1494,13 @@ void OrchDaemon::start(long heartBeatInterval)
         }
 
         auto *c = (Executor *)s;
+
+        // The tasks of an Orch served by a worker thread are only touched once it is done
+        if (m_workerGroupOf.find(c->getOrch()) != m_workerGroupOf.end())
+        {
+            waitForWorkers();
+        }
+
         c->execute();
 
         /* After each iteration, periodically check all m_toSync map to
@@ -1037,9 +1508,11 @@ void OrchDaemon::start(long heartBeatInterval)
 
         if (!gRingBuffer || (gRingBuffer->IsEmpty() && gRingBuffer->IsIdle()))
         {
-            for (Orch *o : m_orchList)
-                o->doTask();
+            runDoTaskRound();
         }
+
+        adaptiveFlush();
+
         /*
          * Asked to check warm restart readiness.
          * Not doing this under Select::TIMEOUT condition because of
@@ -1047,6 +1520,10 @@ void OrchDaemon::start(long heartBeatInterval)
          */
         if (gSwitchOrch && gSwitchOrch->checkRestartReady())
         {
+            waitForWorkers();
+            // Nothing may be popped behind the check, the entries already prefetched count as pending
+            stopPrefetchers();
+
             bool ret = warmRestartCheck();
             if (ret)
             {
@@ -1054,11 +1531,7 @@ void OrchDaemon::start(long heartBeatInterval)
                 // but should finish data that already in the ring
                 if (gRingBuffer)
                 {
-                    while (!gRingBuffer->IsEmpty() || !gRingBuffer->IsIdle())
-                    {
-                        gRingBuffer->notify();
-                        std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_MSECONDS));
-                    }
+                    gRingBuffer->waitUntilDrained();
                 }
 
                 // Should sleep here or continue handling timers and etc.??
@@ -1078,14 +1551,23 @@ void OrchDaemon::start(long heartBeatInterval)
                     }
 
                     // Flush sairedis's redis pipeline
-                    flush();
+                    flush(FlushPolicy::Reason::FORCED);
+
+                    if (!m_warmCheckpointPath.empty())
+                    {
+                        writeWarmCheckpoint();
+                    }
 
                     SWSS_LOG_WARN("Orchagent is frozen for warm restart!");
                     freezeAndHeartBeat(UINT_MAX, heartBeatInterval);
                 }
             }
+
+            startPrefetchers();
         }
     }
+
+    stopPrefetchers();
 }
 
 /*
@@ -1098,9 +1580,48 @@ bool OrchDaemon::warmRestoreAndSyncUp()
 
     WarmStart::setWarmStartState("orchagent", WarmStart::INITIALIZED);
 
+    auto &timeline = BootTimeline::instance();
+
+    // Objects of a bake are the tasks it refilled, of a doTask the tasks it drained
+    auto phase = [&timeline](Orch *o, const string &category, function<void()> run)
+    {
+        if (!timeline.isEnabled())
+        {
+            run();
+            return;
+        }
+
+        BootPhase p(BootTimeline::orchName(o), category);
+        int64_t before = static_cast<int64_t>(o->getPendingTaskCount());
+        run();
+        int64_t after = static_cast<int64_t>(o->getPendingTaskCount());
+        p.setObjects(category == "bake" ? after - before : before - after);
+    };
+
+    if (m_bakeThreads > 0)
+    {
+        BootPhase p("preload", "bake");
+        preloadExistingData();
+    }
+
+    // Read ahead of the bake, which consumes the preloaded tables
+    WarmCheckpoint checkpoint;
+    set<Orch *> unchanged;
+    if (!m_warmCheckpointPath.empty())
+    {
+        BootPhase p("checkpoint", "bake");
+        unchanged = loadWarmCheckpoint(checkpoint);
+    }
+
+    for (Orch *o : m_orchList)
+    {
+        phase(o, "bake", [o]() { o->bake(); });
+    }
+
+    // Tables preloaded for a bake() which didn't refill them would turn stale
     for (Orch *o : m_orchList)
     {
-        o->bake();
+        o->clearPreloaded();
     }
 
     // let's cache the neighbor updates in mux orch and
@@ -1108,29 +1629,35 @@ bool OrchDaemon::warmRestoreAndSyncUp()
     gMuxOrch->enableCachingNeighborUpdate();
 
     /*
-     * Three iterations are needed.
-     *
-     * First iteration: switchorch, Port init/hostif create part of portorch, buffers configuration
+     * Replay until every Orch settled, an Orch is run again only when one of
+     * its inputs progressed, see WarmReplay. This covers the ordering the
+     * fixed passes used to rely on:
      *
-     * Second iteration: port speed/mtu/fec_mode/pfc_asym/admin_status config,
-     * other orch(s) which wait for port to become ready.
+     * switchorch, Port init/hostif create part of portorch, buffers configuration
+     * first, then port speed/mtu/fec_mode/pfc_asym/admin_status config and the
+     * other orch(s) which wait for port to become ready, then the remaining
+     * data that are out of order.
      *
-     * Third iteration: Drain remaining data that are out of order.
+     * MirrorOrch is left out and run at the end.
      */
+    vector<Orch *> replayOrchs;
+    for (Orch *o : m_orchList)
+    {
+        if (o != gMirrorOrch)
+        {
+            replayOrchs.push_back(o);
+        }
+    }
 
-    for (auto it = 0; it < 3; it++)
     {
-        SWSS_LOG_DEBUG("The current doTask iteration is %d", it);
+        BootPhase replayPhase("warm replay", "warm_restore");
 
-        for (Orch *o : m_orchList)
+        WarmReplay replay(replayOrchs);
+        replay.run([&phase](Orch *o, size_t round)
         {
-            if (o == gMirrorOrch) {
-                SWSS_LOG_DEBUG("Skipping mirror processing until the end");
-                continue;
-            }
-
-            o->doTask();
-        }
+            phase(o, "warm_restore_" + to_string(round), [o]() { o->doTask(); });
+        });
+        replayPhase.setObjects(static_cast<int64_t>(replay.getRuns()));
     }
 
     gMuxOrch->updateCachedNeighbors();
@@ -1139,15 +1666,23 @@ bool OrchDaemon::warmRestoreAndSyncUp()
     // MirrorOrch depends on everything else being settled before it can run,
     // and mirror ACL rules depend on MirrorOrch, so run these two at the end
     // after the rest of the data has been processed.
-    gMirrorOrch->doTask();
-    gAclOrch->doTask();
+    phase(gMirrorOrch, "warm_restore_final", []() { gMirrorOrch->doTask(); });
+    phase(gAclOrch, "warm_restore_final", []() { gAclOrch->doTask(); });
 
     /*
      * At this point, all the pre-existing data should have been processed properly, and
      * orchagent should be in exact same state of pre-shutdown.
      * Perform restore validation as needed.
      */
-    bool suc = warmRestoreValidation();
+    bool suc;
+    {
+        BootPhase p("warmRestoreValidation", "warm_restore");
+        suc = warmRestoreValidation();
+        if (!unchanged.empty())
+        {
+            validateWarmCheckpoint(checkpoint, unchanged);
+        }
+    }
     if (!suc)
     {
         SWSS_LOG_ERROR("Orchagent state restore failed");
@@ -1158,9 +1693,12 @@ bool OrchDaemon::warmRestoreAndSyncUp()
 
     syncd_apply_view();
 
-    for (Orch *o : m_orchList)
     {
-        o->onWarmBootEnd();
+        BootPhase p("onWarmBootEnd", "warm_restore");
+        for (Orch *o : m_orchList)
+        {
+            o->onWarmBootEnd();
+        }
     }
 
     /*
@@ -1171,6 +1709,198 @@ bool OrchDaemon::warmRestoreAndSyncUp()
     return true;
 }
 
+/*
+ * Read the tables of all Consumers concurrently, each on a connection of its
+ * own. bake() keeps running serially on the main thread, Orchs override it
+ * with side effects, it only finds the tables already read.
+ */
+void OrchDaemon::preloadExistingData()
+{
+    SWSS_LOG_ENTER();
+
+    vector<ConsumerBase *> consumers;
+    for (Orch *o : m_orchList)
+    {
+        o->getRefillConsumers(consumers);
+    }
+    if (consumers.empty())
+    {
+        return;
+    }
+
+    atomic<size_t> preloaded{0};
+    {
+        OrchWorkerPool pool(std::min(static_cast<size_t>(m_bakeThreads), consumers.size()));
+        for (auto *consumer : consumers)
+        {
+            pool.submit([consumer, &preloaded]()
+            {
+                if (consumer->preloadToSync())
+                {
+                    preloaded++;
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    SWSS_LOG_NOTICE("Preloaded %zu of %zu tables for the warm restore bake",
+                    preloaded.load(), consumers.size());
+}
+
+void OrchDaemon::digestTables(map<Orch *, map<string, TableDigest>> &digests)
+{
+    for (Orch *o : m_orchList)
+    {
+        vector<ConsumerBase *> consumers;
+        o->getRefillConsumers(consumers);
+        for (auto *consumer : consumers)
+        {
+            TableDigest digest;
+            if (consumer->digestTable(digest))
+            {
+                digests[o][consumer->getTableName()] = digest;
+            }
+        }
+    }
+}
+
+/*
+ * Record what the warm restore is expected to rebuild. Called once frozen,
+ * the tables are those the warm restore bake will read back.
+ */
+void OrchDaemon::writeWarmCheckpoint()
+{
+    SWSS_LOG_ENTER();
+
+    WarmCheckpoint checkpoint;
+
+    map<Orch *, map<string, TableDigest>> digests;
+    digestTables(digests);
+    for (const auto &orch : digests)
+    {
+        string name = BootTimeline::orchName(orch.first);
+        for (const auto &table : orch.second)
+        {
+            checkpoint.addTable(name + "|" + table.first, table.second);
+        }
+    }
+
+    set<string> counted;
+    for (Orch *o : m_orchList)
+    {
+        // Counts of several instances of an Orch can't be told apart
+        string name = BootTimeline::orchName(o);
+        if (!counted.insert(name).second)
+        {
+            continue;
+        }
+
+        vector<FieldValueTuple> counts;
+        o->getObjectCounts(counts);
+        for (const auto &fv : counts)
+        {
+            checkpoint.addObjects(name + "|" + fvField(fv), to_uint<uint64_t>(fvValue(fv)));
+        }
+    }
+
+    checkpoint.write(m_warmCheckpointPath);
+}
+
+set<Orch *> OrchDaemon::loadWarmCheckpoint(WarmCheckpoint &checkpoint)
+{
+    SWSS_LOG_ENTER();
+
+    set<Orch *> unchanged;
+
+    bool loaded = checkpoint.load(m_warmCheckpointPath);
+
+    // Taken for this restart only, the next one takes its own
+    unlink(m_warmCheckpointPath.c_str());
+    if (!loaded)
+    {
+        return unchanged;
+    }
+
+    map<Orch *, map<string, TableDigest>> digests;
+    digestTables(digests);
+
+    const auto &tables = checkpoint.getTables();
+    size_t changed = 0;
+    for (Orch *o : m_orchList)
+    {
+        // Orchs without a table of their own are fed by others
+        auto &orchDigests = digests[o];
+        if (orchDigests.empty())
+        {
+            continue;
+        }
+
+        string name = BootTimeline::orchName(o);
+        bool same = true;
+        for (const auto &table : orchDigests)
+        {
+            auto it = tables.find(name + "|" + table.first);
+            if (it == tables.end() || it->second.digest != table.second.value() ||
+                it->second.count != table.second.count())
+            {
+                SWSS_LOG_INFO("Table %s of %s changed since the checkpoint", table.first.c_str(), name.c_str());
+                same = false;
+                changed++;
+            }
+        }
+
+        if (same)
+        {
+            unchanged.insert(o);
+        }
+    }
+
+    SWSS_LOG_NOTICE("Warm checkpoint: %zu tables changed, %zu of %zu orchs unchanged",
+                    changed, unchanged.size(), m_orchList.size());
+    return unchanged;
+}
+
+/*
+ * The replay of an Orch whose tables didn't change must rebuild the objects
+ * it had when orchagent froze.
+ */
+void OrchDaemon::validateWarmCheckpoint(const WarmCheckpoint &checkpoint, const set<Orch *> &unchanged)
+{
+    SWSS_LOG_ENTER();
+
+    const auto &objects = checkpoint.getObjects();
+    size_t mismatches = 0;
+    for (Orch *o : unchanged)
+    {
+        string name = BootTimeline::orchName(o);
+
+        vector<FieldValueTuple> counts;
+        o->getObjectCounts(counts);
+        for (const auto &fv : counts)
+        {
+            auto it = objects.find(name + "|" + fvField(fv));
+            if (it == objects.end())
+            {
+                continue;
+            }
+
+            uint64_t count = to_uint<uint64_t>(fvValue(fv));
+            if (count != it->second.count)
+            {
+                SWSS_LOG_WARN("Warm restore of %s rebuilt %" PRIu64 " %s, %" PRIu64 " at the checkpoint",
+                              name.c_str(), count, fvField(fv).c_str(), it->second.count);
+                mismatches++;
+            }
+        }
+    }
+
+    if (mismatches == 0)
+    {
+        SWSS_LOG_NOTICE("Warm restore matches the checkpoint of %zu orchs", unchanged.size());
+    }
+}
+
 /*
  * Get tasks to sync for consumers of each orch being managed by this orch daemon
  */
@@ -1180,6 +1910,39 @@ void OrchDaemon::getTaskToSync(vector<string> &ts)
     {
         o->dumpPendingTasks(ts);
     }
+
+    for (auto &prefetcher : m_prefetchers)
+    {
+        prefetcher->dumpPendingTasks(ts);
+    }
+}
+
+/*
+ * Get the number of tasks to sync of each table, without formatting the tasks.
+ * Returns the total.
+ */
+size_t OrchDaemon::getPendingTaskCounts(vector<pair<string, size_t>> &counts)
+{
+    for (Orch *o : m_orchList)
+    {
+        o->getPendingTaskCounts(counts);
+    }
+
+    for (auto &prefetcher : m_prefetchers)
+    {
+        size_t queued = prefetcher->getQueuedEntries();
+        if (queued != 0)
+        {
+            counts.emplace_back(prefetcher->getConsumer()->getTableName(), queued);
+        }
+    }
+
+    size_t total = 0;
+    for (const auto &count : counts)
+    {
+        total += count.second;
+    }
+    return total;
 }
 
 
@@ -1218,15 +1981,25 @@ bool OrchDaemon::warmRestartCheck()
     std::string data = "READY";
     bool ret = true;
 
-    vector<string> ts;
-    getTaskToSync(ts);
+    // The tasks are only formatted when asked to, there can be many of them
+    vector<pair<string, size_t>> counts;
+    size_t pending = getPendingTaskCounts(counts);
 
-    if (ts.size() != 0)
+    if (pending != 0)
     {
-        SWSS_LOG_NOTICE("WarmRestart check found pending tasks: ");
-        for(auto &s : ts)
+        SWSS_LOG_NOTICE("WarmRestart check found %zu pending tasks: ", pending);
+        for (auto &count : counts)
+        {
+            SWSS_LOG_NOTICE("    %s: %zu", count.first.c_str(), count.second);
+        }
+        if (gSwitchOrch->dumpPendingTasksOnCheck())
         {
-            SWSS_LOG_NOTICE("    %s", s.c_str());
+            vector<string> ts;
+            getTaskToSync(ts);
+            for(auto &s : ts)
+            {
+                SWSS_LOG_NOTICE("    %s", s.c_str());
+            }
         }
         if (!gSwitchOrch->skipPendingTaskCheck())
         {
@@ -1416,5 +2189,54 @@ bool DpuOrchDaemon::init()
     addOrchList(dash_port_map_orch);
     addOrchList(dash_ha_flow_orch);
 
+    /*
+     * Declare the dependencies of the DASH orchs, so they can be served on a
+     * worker thread next to the other orchs. Besides the orchs they look up
+     * through gDirectory, they all share the DPU DB connectors, so each one is
+     * tied to DashOrch and the DASH orchs form a single group.
+     */
+    dash_orch->declareDependencies({
+        gDirectory.get<DashMeterOrch*>(), gDirectory.get<DashRouteOrch*>() });
+    dash_vnet_orch->declareDependencies({
+        gDirectory.get<DashOrch*>(), gDirectory.get<DashPortMapOrch*>(), gDirectory.get<DashTunnelOrch*>() });
+    dash_route_orch->declareDependencies({
+        gDirectory.get<DashOrch*>(), gDirectory.get<DashTunnelOrch*>() });
+    dash_tunnel_orch->declareDependencies({ gDirectory.get<DashOrch*>() });
+    dash_acl_orch->declareDependencies({ gDirectory.get<DashOrch*>() });
+    dash_meter_orch->declareDependencies({ gDirectory.get<DashOrch*>() });
+    dash_port_map_orch->declareDependencies({ gDirectory.get<DashOrch*>() });
+    dash_ha_flow_orch->declareDependencies({ gDirectory.get<DashOrch*>() });
+    // BfdOrch software sessions are thread safe and not a dependency
+    dash_ha_orch->declareDependencies({ gDirectory.get<DashOrch*>() });
+
+    /*
+     * Drain the provisioning tables in dependency order, appliance, VNET, ENI
+     * and then what hangs off an ENI, so an ENI provisioned at once is flushed
+     * as one bulk per object type. The HA orchs keep draining on their own.
+     */
+    DashBatchOrch *dash_batch_orch = new DashBatchOrch({
+        { dash_orch, APP_DASH_APPLIANCE_TABLE_NAME },
+        { dash_orch, APP_DASH_ROUTING_TYPE_TABLE_NAME },
+        { dash_tunnel_orch, APP_DASH_TUNNEL_TABLE_NAME },
+        { dash_port_map_orch, APP_DASH_OUTBOUND_PORT_MAP_TABLE_NAME },
+        { dash_port_map_orch, APP_DASH_OUTBOUND_PORT_MAP_RANGE_TABLE_NAME },
+        { dash_meter_orch, APP_DASH_METER_POLICY_TABLE_NAME },
+        { dash_meter_orch, APP_DASH_METER_RULE_TABLE_NAME },
+        { dash_orch, APP_DASH_QOS_TABLE_NAME },
+        { dash_vnet_orch, APP_DASH_VNET_TABLE_NAME },
+        { dash_acl_orch, APP_DASH_PREFIX_TAG_TABLE_NAME },
+        { dash_acl_orch, APP_DASH_ACL_GROUP_TABLE_NAME },
+        { dash_acl_orch, APP_DASH_ACL_RULE_TABLE_NAME },
+        { dash_route_orch, APP_DASH_ROUTE_GROUP_TABLE_NAME },
+        { dash_orch, APP_DASH_ENI_TABLE_NAME },
+        { dash_vnet_orch, APP_DASH_VNET_MAPPING_TABLE_NAME },
+        { dash_route_orch, APP_DASH_ROUTE_TABLE_NAME },
+        { dash_route_orch, APP_DASH_ROUTE_RULE_TABLE_NAME },
+        { dash_orch, APP_DASH_ENI_ROUTE_TABLE_NAME },
+        { dash_acl_orch, APP_DASH_ACL_IN_TABLE_NAME },
+        { dash_acl_orch, APP_DASH_ACL_OUT_TABLE_NAME },
+    });
+    addOrchList(dash_batch_orch);
+
     return true;
 }
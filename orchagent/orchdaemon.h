@@ -31,6 +31,8 @@
 #include "vxlanorch.h"
 #include "vnetorch.h"
 #include "countercheckorch.h"
+#include "counterratesorch.h"
+#include "countersnapshotorch.h"
 #include "flexcounterorch.h"
 #include "watermarkorch.h"
 #include "policerorch.h"
@@ -59,7 +61,13 @@
 #include "dash/dashhafloworch.h"
 #include "dash/dashmeterorch.h"
 #include "dash/dashportmaporch.h"
+#include "dash/dashbatchorch.h"
 #include "high_frequency_telemetry/hftelorch.h"
+#include "executorstatsorch.h"
+#include "orchagentstatsorch.h"
+#include "orchworkerpool.h"
+#include "consumerprefetcher.h"
+#include "flushpolicy.h"
 #include <sairedis.h>
 
 using namespace swss;
@@ -74,6 +82,7 @@ public:
     void start(long heartBeatInterval);
     bool warmRestoreAndSyncUp();
     void getTaskToSync(vector<string> &ts);
+    size_t getPendingTaskCounts(vector<pair<string, size_t>> &counts);
     bool warmRestoreValidation();
 
     bool warmRestartCheck();
@@ -91,6 +100,59 @@ public:
     {
         m_fabricQueueStatEnabled = enabled;
     }
+    void setExecutorStatsInterval(int interval)
+    {
+        m_executorStatsInterval = interval;
+    }
+    const std::vector<Orch *> &getOrchList() const
+    {
+        return m_orchList;
+    }
+    void setOrchAgentStatsInterval(int interval)
+    {
+        m_orchAgentStatsInterval = interval;
+    }
+    /**
+     * Configure the scheduling of pending tasks.
+     * @param timeSliceMsec - default time slice of a single drain, 0 lets doTask run to completion
+     * @param roundBudgetMsec - time budget of one round over all Orchs, 0 means unbounded
+     */
+    void setSchedulerConfig(int timeSliceMsec, int roundBudgetMsec);
+    /**
+     * Serve groups of independent Orchs, see Orch::declareDependencies(), on a
+     * pool of worker threads. 0, the default, serves all Orchs on the main thread.
+     */
+    void setWorkerThreads(int threads);
+    /**
+     * Read the tables of the warm restore bake on a pool of threads ahead of
+     * the bake, streamed with SCAN. 0, the default, lets each bake read them.
+     */
+    void setBakeThreads(int threads);
+    /**
+     * Warm restart validation aid: write a checkpoint of the table digests
+     * and object counts to path as orchagent freezes for a warm restart,
+     * and log the objects the next warm restore rebuilt differently. The
+     * restore does not use it to skip any replay. Empty, the default,
+     * disables it.
+     */
+    void setWarmValidation(const std::string &path)
+    {
+        m_warmCheckpointPath = path;
+    }
+    /**
+     * Pop the tables selected with Consumer::setPrefetchTables() on reader threads.
+     * @param maxSyncDepth - m_toSync depth above which a reader pauses, 0 means unbounded
+     */
+    void setPrefetchDepth(size_t maxSyncDepth)
+    {
+        m_prefetchDepth = maxSyncDepth;
+    }
+    /**
+     * Flush the sairedis pipeline on pending ops, op age and idleness instead of a fixed cadence.
+     * @param latencyMsec - longest time an op may wait for a flush, 0 keeps the fixed cadence
+     * @param batchOps - pending ops flushed at once, 0 flushes on age and idleness only
+     */
+    void setFlushPolicy(int latencyMsec, size_t batchOps);
     void logRotate();
 
     // Two required API to support ring buffer feature
@@ -99,7 +161,7 @@ public:
      * and populate this ring's pointer to the producers [Orch, Consumer], to make sure that
      * they are connected to the same ring.
      */
-    void enableRingBuffer();
+    void enableRingBuffer(int size = RING_SIZE);
     void disableRingBuffer();
     /**
      * This method describes how the ring consumer consumes this ring.
@@ -125,11 +187,74 @@ protected:
     bool m_fabricPortStatEnabled = true;
     bool m_fabricQueueStatEnabled = true;
 
+    // Publish interval of executor statistics in seconds, 0 means disabled
+    int m_executorStatsInterval = 0;
+    // Publish interval of the orchagent backlog statistics in seconds, 0 means disabled
+    int m_orchAgentStatsInterval = 0;
+
     std::vector<Orch *> m_orchList;
     Select *m_select;
+
+    // Budget of one doTask round in milliseconds, 0 means unbounded
+    int m_roundBudgetMsec = 0;
+    // m_serialOrchs in priority order, a budgeted round resumes at m_roundCursor
+    std::vector<Orch *> m_roundOrder;
+    size_t m_roundCursor = 0;
+    // A round was cut short or a drain yielded, serve the pending tasks without waiting for an event
+    bool m_roundPending = false;
+
+    // Orchs connected through declared dependencies, served on a worker thread
+    struct WorkerGroup
+    {
+        std::vector<Orch *> orchs;
+        std::atomic<bool> busy{false};
+    };
+
+    int m_workerThreads = 0;
+    int m_bakeThreads = 0;
+    std::string m_warmCheckpointPath;
+    std::unique_ptr<OrchWorkerPool> m_workerPool;
+    std::vector<std::unique_ptr<WorkerGroup>> m_workerGroups;
+    std::unordered_map<Orch *, WorkerGroup *> m_workerGroupOf;
+    // Orchs served on the main thread, in m_orchList order
+    std::vector<Orch *> m_serialOrchs;
+    // Size of m_orchList when the groups were built
+    size_t m_groupedOrchCount = 0;
+    // A worker group was still busy when the last round started
+    bool m_workersPending = false;
+
+    // Readers popping the tables of main thread Consumers ahead of their doTask
+    std::vector<std::unique_ptr<ConsumerPrefetcher>> m_prefetchers;
+    size_t m_prefetchDepth = 0;
+
+    Selectable *prefetch(Selectable *selectable);
+    void startPrefetchers();
+    void stopPrefetchers();
+    void updatePrefetchers();
+
+    void runDoTaskRound();
+
+    /* Preload the tables refilled by bake() on m_bakeThreads threads */
+    void preloadExistingData();
+
+    /* Digests of the tables refilled by bake(), by Orch */
+    void digestTables(std::map<Orch *, std::map<std::string, TableDigest>> &digests);
+    void writeWarmCheckpoint();
+    /* Orchs whose tables all match the checkpoint */
+    std::set<Orch *> loadWarmCheckpoint(WarmCheckpoint &checkpoint);
+    void validateWarmCheckpoint(const WarmCheckpoint &checkpoint, const std::set<Orch *> &unchanged);
+    void buildRoundGroups();
+    void runWorkerGroup(WorkerGroup &group);
+    void waitForWorkers();
     std::chrono::time_point<std::chrono::high_resolution_clock> m_lastHeartBeat;
 
-    void flush();
+    // Decides when the main loop flushes the sairedis pipeline
+    FlushPolicy m_flushPolicy;
+
+    void flush(FlushPolicy::Reason reason = FlushPolicy::Reason::PERIODIC);
+    void flushSaiRedis();
+    /* Account the ops of the last event and flush them if the adaptive policy says so */
+    void adaptiveFlush();
 
     void heartBeat(std::chrono::time_point<std::chrono::high_resolution_clock> tcurrent, long interval);
 
@@ -0,0 +1,44 @@
+#pragma once
+
+/*
+ * Static tracepoints (USDT) on the orchagent hot paths, for bpftrace,
+ * perf or systemtap. A probe is a single nop in the instruction stream
+ * until a tracer attaches to it, its arguments are only moved into
+ * registers. They must stay cheap: string pointers, counts and statuses.
+ *
+ * Without sys/sdt.h at build time the probes compile to nothing.
+ *
+ *   provider  orchagent
+ *   consumer__execute__entry    table, popped tasks
+ *   consumer__execute__return   table
+ *   orch__dotask__entry         table, pending tasks
+ *   orch__dotask__return        table, tasks left pending
+ *   bulker__flush__entry        object type, op, entries
+ *   bulker__flush__return       object type, op, entries, status
+ *   orchdaemon__flush__entry    reason
+ *   orchdaemon__flush__return   reason
+ *   retry__add                  executor, key
+ *   retry__resolve              executor, tasks retried, tasks left
+ *   respub__publish             table, key, status code
+ *
+ * Bulker ops follow BulkerStats::Op (0 create, 1 remove, 2 set), flush
+ * reasons follow FlushPolicy::Reason. See orchagent/bpftrace for scripts.
+ */
+#ifdef HAVE_SYS_SDT_H
+
+#include <sys/sdt.h>
+
+#define ORCH_PROBE1(name, a1)                   DTRACE_PROBE1(orchagent, name, a1)
+#define ORCH_PROBE2(name, a1, a2)               DTRACE_PROBE2(orchagent, name, a1, a2)
+#define ORCH_PROBE3(name, a1, a2, a3)           DTRACE_PROBE3(orchagent, name, a1, a2, a3)
+#define ORCH_PROBE4(name, a1, a2, a3, a4)       DTRACE_PROBE4(orchagent, name, a1, a2, a3, a4)
+
+#else
+
+// sizeof keeps the arguments referenced without evaluating them
+#define ORCH_PROBE1(name, a1)                   do { (void)sizeof(a1); } while (0)
+#define ORCH_PROBE2(name, a1, a2)               do { (void)sizeof(a1); (void)sizeof(a2); } while (0)
+#define ORCH_PROBE3(name, a1, a2, a3)           do { ORCH_PROBE2(name, a1, a2); (void)sizeof(a3); } while (0)
+#define ORCH_PROBE4(name, a1, a2, a3, a4)       do { ORCH_PROBE3(name, a1, a2, a3); (void)sizeof(a4); } while (0)
+
+#endif
@@ -0,0 +1,88 @@
+#include "orchworkerpool.h"
+#include "logger.h"
+
+#include <exception>
+
+using namespace std;
+
+OrchWorkerPool::OrchWorkerPool(size_t threads)
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t i = 0; i < threads; i++)
+    {
+        m_threads.emplace_back(&OrchWorkerPool::run, this);
+    }
+
+    SWSS_LOG_NOTICE("Started %zu orch worker threads", threads);
+}
+
+OrchWorkerPool::~OrchWorkerPool()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_taskCv.notify_all();
+
+    for (auto &thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void OrchWorkerPool::submit(Task task)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+        m_outstanding++;
+    }
+    m_taskCv.notify_one();
+}
+
+void OrchWorkerPool::wait()
+{
+    unique_lock<mutex> lock(m_mutex);
+    m_doneCv.wait(lock, [this]() { return m_outstanding == 0; });
+}
+
+void OrchWorkerPool::run()
+{
+    while (true)
+    {
+        Task task;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_taskCv.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+
+            // Queued tasks are still run on stop, so wait() never hangs
+            if (m_tasks.empty())
+            {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        try
+        {
+            task();
+        }
+        catch (const exception &e)
+        {
+            SWSS_LOG_ERROR("Exception caught in orch worker thread: %s", e.what());
+        }
+        catch (...)
+        {
+            SWSS_LOG_ERROR("Unknown exception caught in orch worker thread");
+        }
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_outstanding--;
+        }
+        m_doneCv.notify_all();
+    }
+}
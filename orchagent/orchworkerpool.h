@@ -0,0 +1,43 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Fixed size pool of threads running the doTask rounds of independent Orch
+ * groups on behalf of the OrchDaemon main loop, see OrchDaemon::runDoTaskRound().
+ */
+class OrchWorkerPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit OrchWorkerPool(size_t threads);
+    ~OrchWorkerPool();
+
+    OrchWorkerPool(const OrchWorkerPool&) = delete;
+    OrchWorkerPool& operator=(const OrchWorkerPool&) = delete;
+
+    void submit(Task task);
+
+    /* Block until every submitted task has completed */
+    void wait();
+
+    size_t size() const { return m_threads.size(); }
+
+private:
+    void run();
+
+    std::vector<std::thread> m_threads;
+    std::deque<Task> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_taskCv;
+    std::condition_variable m_doneCv;
+    // Tasks queued or running
+    size_t m_outstanding = 0;
+    bool m_stop = false;
+};
@@ -157,7 +157,7 @@ ReturnCode ExtTablesManager::validateP4ExtTableAppDbEntry(P4ExtTableAppDbEntry &
     ReturnCode status;
 
     TableInfo *table;
-    table = getTableInfo(app_db_entry.table_name);
+    table = getExtTableInfo(app_db_entry.table_name);
     if (table == nullptr)
     {
         SWSS_LOG_ERROR("Not a valid extension table %s", app_db_entry.table_name.c_str());
@@ -257,7 +257,7 @@ ReturnCode ExtTablesManager::prepareP4SaiExtAPIParams(const P4ExtTableAppDbEntry
     try
     {
         TableInfo *table;
-        table = getTableInfo(app_db_entry.table_name);
+        table = getExtTableInfo(app_db_entry.table_name);
         if (!table)
         {
             SWSS_LOG_ERROR("extension entry for invalid table %s", app_db_entry.table_name.c_str());
@@ -429,7 +429,7 @@ ReturnCode ExtTablesManager::createP4ExtTableEntry(const P4ExtTableAppDbEntry &a
     generic_programmable_attr.value.json.json.list = (int8_t *)const_cast<char *>(ext_table_entry_attr.c_str());
     generic_programmable_attrs.push_back(generic_programmable_attr);
 
-    auto *table = getTableInfo(app_db_entry.table_name);
+    auto *table = getExtTableInfo(app_db_entry.table_name);
     if (!table)
     {
         SWSS_LOG_ERROR("extension entry for invalid table %s", app_db_entry.table_name.c_str());
@@ -468,7 +468,7 @@ ReturnCode ExtTablesManager::createP4ExtTableEntry(const P4ExtTableAppDbEntry &a
     }
     std::string crm_table_name = "EXT_" + app_db_entry.table_name;
     boost::algorithm::to_upper(crm_table_name);
-    gCrmOrch->incCrmExtTableUsedCounter(CrmResourceType::CRM_EXT_TABLE, crm_table_name);
+    m_crmUsedDelta[crm_table_name]++;
 
     ext_table_entry.sai_entry_oid = sai_generic_programmable_oid;
     for (auto action_dep_object_it = app_db_entry.action_dep_objects.begin();
@@ -590,7 +590,7 @@ ReturnCode ExtTablesManager::removeP4ExtTableEntry(const std::string &table_name
     }
     std::string crm_table_name = "EXT_" + table_name;
     boost::algorithm::to_upper(crm_table_name);
-    gCrmOrch->decCrmExtTableUsedCounter(CrmResourceType::CRM_EXT_TABLE, crm_table_name);
+    m_crmUsedDelta[crm_table_name]--;
 
     auto ext_table_key = KeyGenerator::generateExtTableKey(table_name, table_key);
     status = getSaiObject(ext_table_key, object_type, key);
@@ -683,6 +683,34 @@ void ExtTablesManager::enqueue(const std::string &table_name, const swss::KeyOpF
     m_entriesTables[table_name].push_back(entry);
 }
 
+TableInfo *ExtTablesManager::getExtTableInfo(const std::string &table_name)
+{
+    if (m_tableInfo == nullptr || m_tableInfoName != table_name)
+    {
+        m_tableInfo = getTableInfo(table_name);
+        m_tableInfoName = table_name;
+    }
+    return m_tableInfo;
+}
+
+void ExtTablesManager::flushCrmExtTableCounters()
+{
+    for (const auto &it : m_crmUsedDelta)
+    {
+        if (it.second > 0)
+        {
+            gCrmOrch->incCrmExtTableUsedCounter(CrmResourceType::CRM_EXT_TABLE, it.first,
+                                                static_cast<uint32_t>(it.second));
+        }
+        else if (it.second < 0)
+        {
+            gCrmOrch->decCrmExtTableUsedCounter(CrmResourceType::CRM_EXT_TABLE, it.first,
+                                                static_cast<uint32_t>(-it.second));
+        }
+    }
+    m_crmUsedDelta.clear();
+}
+
 void ExtTablesManager::drainWithNotExecuted() {
   for (auto& entries_table : m_entriesTables) {
     drainMgmtWithNotExecuted(entries_table.second, m_publisher);
@@ -694,6 +722,10 @@ ReturnCode ExtTablesManager::drain() {
   std::string table_prefix = "EXT_";
   ReturnCode ret;
 
+  // The table definitions may have been replaced since the last drain.
+  m_tableInfo = nullptr;
+  m_tableInfoName.clear();
+
   if (gP4Orch->tablesinfo) {
     for (auto table_it = gP4Orch->tablesinfo->m_tablePrecedenceMap.begin();
          table_it != gP4Orch->tablesinfo->m_tablePrecedenceMap.end();
@@ -787,12 +819,15 @@ ReturnCode ExtTablesManager::drain() {
           break;
         }
       }
+      flushCrmExtTableCounters();
       if (!status.ok()) {
         ret = status;
       }
     }
   }
 
+  m_tableInfo = nullptr;
+  m_tableInfoName.clear();
   drainWithNotExecuted();
   return ret;
 }
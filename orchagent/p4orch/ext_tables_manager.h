@@ -84,12 +84,24 @@ class ExtTablesManager : public ObjectManagerInterface
 
     ReturnCode setExtTableCounterStats(P4ExtTableEntry *ext_table_entry);
 
+    // Definition of an extension table, looked up once per table run of a
+    // drain instead of for every entry.
+    TableInfo *getExtTableInfo(const std::string &table_name);
+    // Applies the CRM used counter changes of the entries created and removed
+    // since the last call, one update per table.
+    void flushCrmExtTableCounters();
+
     P4ExtTableMap m_extTables;
     P4OidMapper *m_p4OidMapper;
     VRFOrch *m_vrfOrch;
     ResponsePublisherInterface *m_publisher;
     m_entriesTableMap m_entriesTables;
 
+    std::string m_tableInfoName;
+    TableInfo *m_tableInfo = nullptr;
+    // CRM table name -> entries created minus entries removed.
+    std::unordered_map<std::string, int64_t> m_crmUsedDelta;
+
     std::unique_ptr<swss::DBConnector> m_countersDb;
     std::unique_ptr<swss::Table> m_countersTable;
 };
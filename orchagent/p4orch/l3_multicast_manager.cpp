@@ -1431,8 +1431,9 @@ ReturnCode L3MulticastManager::createDefaultMyMac() {
   return ReturnCode();
 }
 
-ReturnCode L3MulticastManager::createRouterInterface(
-    P4MulticastRouterInterfaceEntry& entry, sai_object_id_t* rif_oid) {
+ReturnCodeOr<std::vector<sai_attribute_t>>
+L3MulticastManager::prepareRouterInterface(
+    P4MulticastRouterInterfaceEntry& entry) {
   SWSS_LOG_ENTER();
 
   // For NSF purposes, we cannot add the new SAI_ROUTER_INTERFACE_ATTR_MY_MAC,
@@ -1451,19 +1452,60 @@ ReturnCode L3MulticastManager::createRouterInterface(
         << " already exists in the centralized map");
   }
 
-  // Create RIF SAI object.
-  ASSIGN_OR_RETURN(std::vector<sai_attribute_t> attrs,
-                   prepareRifSaiAttrs(entry, m_my_mac_oid));
-  auto sai_status = sai_router_intfs_api->create_router_interface(
-      rif_oid, gSwitchId, (uint32_t)attrs.size(), attrs.data());
-  if (sai_status != SAI_STATUS_SUCCESS) {
-    LOG_ERROR_AND_RETURN(
-        ReturnCode(sai_status)
-        << "Failed to create router interface for multicast router interface "
-        << "table: "
-        << QuotedVar(entry.multicast_router_interface_entry_key).c_str());
+  return prepareRifSaiAttrs(entry, m_my_mac_oid);
+}
+
+std::vector<ReturnCode> L3MulticastManager::createRouterInterfaces(
+    const std::vector<P4MulticastRouterInterfaceEntry*>& entries,
+    std::vector<sai_object_id_t>* rif_oids) {
+  SWSS_LOG_ENTER();
+
+  std::vector<ReturnCode> statuses(entries.size());
+  fillStatusArrayWithNotExecuted(statuses, 0);
+
+  // Only the entries ahead of the first invalid one are created.
+  std::vector<std::vector<sai_attribute_t>> sai_attrs;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    auto attrs_or = prepareRouterInterface(*entries[i]);
+    if (!attrs_or.ok()) {
+      statuses[i] = attrs_or.status();
+      break;
+    }
+    sai_attrs.push_back(std::move(*attrs_or));
   }
-  return ReturnCode();
+
+  rif_oids->assign(sai_attrs.size(), SAI_NULL_OBJECT_ID);
+  if (sai_attrs.empty()) {
+    return statuses;
+  }
+
+  std::vector<uint32_t> attrs_cnt(sai_attrs.size());
+  std::vector<const sai_attribute_t*> attrs_ptr(sai_attrs.size());
+  for (size_t i = 0; i < sai_attrs.size(); ++i) {
+    attrs_cnt[i] = static_cast<uint32_t>(sai_attrs[i].size());
+    attrs_ptr[i] = sai_attrs[i].data();
+  }
+  std::vector<sai_status_t> object_statuses(sai_attrs.size(),
+                                            SAI_STATUS_NOT_EXECUTED);
+  sai_router_intfs_api->create_router_interfaces(
+      gSwitchId, static_cast<uint32_t>(sai_attrs.size()), attrs_cnt.data(),
+      attrs_ptr.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, rif_oids->data(),
+      object_statuses.data());
+
+  for (size_t i = 0; i < sai_attrs.size(); ++i) {
+    if (object_statuses[i] != SAI_STATUS_SUCCESS) {
+      statuses[i] = ReturnCode(object_statuses[i])
+                    << "Failed to create router interface for multicast "
+                    << "router interface table: "
+                    << QuotedVar(entries[i]->multicast_router_interface_entry_key)
+                           .c_str();
+      SWSS_LOG_ERROR("%s", statuses[i].message().c_str());
+      fillStatusArrayWithNotExecuted(statuses, i + 1);
+      break;
+    }
+    statuses[i] = ReturnCode();
+  }
+  return statuses;
 }
 
 ReturnCode L3MulticastManager::createNeighborEntry(
@@ -1783,30 +1825,67 @@ std::vector<ReturnCode> L3MulticastManager::addMulticastRouterInterfaceEntries(
   std::vector<ReturnCode> statuses(entries.size());
   fillStatusArrayWithNotExecuted(statuses, 0);
 
-  for (size_t i = 0; i < entries.size(); ++i) {
-    auto& entry = entries[i];
-    // TODO(b/353398275): Remove condition for kL2MulticastPassthrough
-    if (entry.action == p4orch::kL2MulticastPassthrough ||
-        entry.action == p4orch::kMulticastL2Passthrough) {
-      statuses[i] = addL2MulticastRouterInterfaceEntry(entry);
-    } else {
-      statuses[i] = addL3MulticastRouterInterfaceEntry(entry);
+  // TODO(b/353398275): Remove condition for kL2MulticastPassthrough
+  auto is_l2 = [](const P4MulticastRouterInterfaceEntry& entry) {
+    return entry.action == p4orch::kL2MulticastPassthrough ||
+           entry.action == p4orch::kMulticastL2Passthrough;
+  };
+
+  size_t i = 0;
+  while (i < entries.size()) {
+    if (is_l2(entries[i])) {
+      statuses[i] = addL2MulticastRouterInterfaceEntry(entries[i]);
+      if (!statuses[i].ok()) {
+        break;
+      }
+      ++i;
+      continue;
     }
-    if (!statuses[i].ok()) {
+
+    // The RIFs of a run of L3 entries are created in one bulk call.
+    std::vector<P4MulticastRouterInterfaceEntry*> run;
+    for (size_t j = i; j < entries.size() && !is_l2(entries[j]); ++j) {
+      run.push_back(&entries[j]);
+    }
+    std::vector<sai_object_id_t> rif_oids;
+    std::vector<ReturnCode> rif_statuses =
+        createRouterInterfaces(run, &rif_oids);
+
+    bool failed = false;
+    for (size_t j = 0; j < run.size(); ++j) {
+      if (!failed) {
+        statuses[i + j] =
+            rif_statuses[j].ok()
+                ? addL3MulticastRouterInterfaceEntry(*run[j], rif_oids[j])
+                : rif_statuses[j];
+        failed = !statuses[i + j].ok();
+      } else if (j < rif_oids.size() && rif_statuses[j].ok()) {
+        // Created ahead of the failure, the entry is not executed.
+        sai_status_t sai_status =
+            sai_router_intfs_api->remove_router_interface(rif_oids[j]);
+        if (sai_status != SAI_STATUS_SUCCESS) {
+          std::stringstream err_msg;
+          err_msg << "Unable to backout creation of the RIF for "
+                  << QuotedVar(run[j]->multicast_router_interface_entry_key);
+          SWSS_LOG_ERROR("%s", err_msg.str().c_str());
+          SWSS_RAISE_CRITICAL_STATE(err_msg.str());
+        }
+      }
+    }
+    if (failed) {
       break;
     }
+    i += run.size();
   }
   return statuses;
 }
 
 ReturnCode L3MulticastManager::addL3MulticastRouterInterfaceEntry(
-    P4MulticastRouterInterfaceEntry& entry) {
+    P4MulticastRouterInterfaceEntry& entry, sai_object_id_t rif_oid) {
   // We no longer share RIFs, so adding a new entry requires allocating a RIF.
+  // The RIF is created by the caller.
   SWSS_LOG_ENTER();
 
-  sai_object_id_t rif_oid = SAI_NULL_OBJECT_ID;
-  RETURN_IF_ERROR(createRouterInterface(entry, &rif_oid));
-
   // Need to set RIF in mapper in case have to back out.
   m_p4OidMapper->setOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE,
                         entry.multicast_router_interface_entry_key, rif_oid);
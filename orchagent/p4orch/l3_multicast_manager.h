@@ -198,9 +198,14 @@ class L3MulticastManager : public ObjectManagerInterface {
       const std::deque<swss::KeyOpFieldsValuesTuple>& tuple_list,
       const std::string& op, bool update);
 
-  // Wrapper around SAI setup and call, for easy mocking.
-  ReturnCode createRouterInterface(P4MulticastRouterInterfaceEntry& entry,
-                                   sai_object_id_t* rif_oid);
+  // Validates the entry and returns the SAI attributes of its RIF.
+  ReturnCodeOr<std::vector<sai_attribute_t>> prepareRouterInterface(
+      P4MulticastRouterInterfaceEntry& entry);
+  // Creates the RIFs of the entries in one bulk call. Stops at the first
+  // failure, rif_oids has the OIDs of the entries sent to SAI.
+  std::vector<ReturnCode> createRouterInterfaces(
+      const std::vector<P4MulticastRouterInterfaceEntry*>& entries,
+      std::vector<sai_object_id_t>* rif_oids);
   ReturnCode createNextHop(P4MulticastRouterInterfaceEntry& entry,
                            const sai_object_id_t rif_oid,
                            sai_object_id_t* next_hop_oid);
@@ -243,7 +248,7 @@ class L3MulticastManager : public ObjectManagerInterface {
   std::vector<ReturnCode> addMulticastRouterInterfaceEntries(
       std::vector<P4MulticastRouterInterfaceEntry>& entries);
   ReturnCode addL3MulticastRouterInterfaceEntry(
-      P4MulticastRouterInterfaceEntry& entry);      
+      P4MulticastRouterInterfaceEntry& entry, sai_object_id_t rif_oid);
   ReturnCode addL2MulticastRouterInterfaceEntry(
       P4MulticastRouterInterfaceEntry& entry);
   // Update existing multicast router interface table entries.
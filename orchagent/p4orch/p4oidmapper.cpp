@@ -1,7 +1,10 @@
 #include "p4oidmapper.h"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 #include <nlohmann/json.hpp>
+#include <stdexcept>
 #include <sstream>
 #include <string>
 
@@ -15,6 +18,192 @@ extern "C"
 
 using ::nlohmann::json;
 
+namespace
+{
+
+constexpr size_t kMinCapacity = 16;
+// Erased keys are left in the arena until there are this many bytes of them
+constexpr size_t kMinGarbage = 4096;
+
+} // namespace
+
+constexpr uint32_t P4OidTable::kEmptySlot;
+
+P4OidTable::Entry *P4OidTable::find(const std::string &key)
+{
+    return const_cast<Entry *>(static_cast<const P4OidTable *>(this)->find(key));
+}
+
+const P4OidTable::Entry *P4OidTable::find(const std::string &key) const
+{
+    if (m_size == 0)
+    {
+        return nullptr;
+    }
+
+    const auto &slot = m_slots[probe(key, hashKey(key))];
+    return slot.key == kEmptySlot ? nullptr : &slot.entry;
+}
+
+bool P4OidTable::insert(const std::string &key, const Entry &entry)
+{
+    // Kept at most 3/4 full
+    if ((m_size + 1) * 4 > m_slots.size() * 3)
+    {
+        rehash(std::max(kMinCapacity, m_slots.size() * 2));
+    }
+
+    uint32_t hash = hashKey(key);
+    auto &slot = m_slots[probe(key, hash)];
+    if (slot.key != kEmptySlot)
+    {
+        return false;
+    }
+
+    slot = {entry, storeKey(key), hash};
+    m_size++;
+    return true;
+}
+
+bool P4OidTable::erase(const std::string &key)
+{
+    if (m_size == 0)
+    {
+        return false;
+    }
+
+    size_t mask = m_slots.size() - 1;
+    size_t hole = probe(key, hashKey(key));
+    if (m_slots[hole].key == kEmptySlot)
+    {
+        return false;
+    }
+
+    m_garbage += sizeof(uint32_t) + key.size();
+    m_size--;
+
+    // Shift the following entries of the probe back, no tombstones are left
+    for (size_t i = (hole + 1) & mask; m_slots[i].key != kEmptySlot; i = (i + 1) & mask)
+    {
+        size_t home = m_slots[i].hash & mask;
+        bool movable = (hole <= i) ? (home <= hole || home > i) : (home <= hole && home > i);
+        if (movable)
+        {
+            m_slots[hole] = m_slots[i];
+            hole = i;
+        }
+    }
+    m_slots[hole].key = kEmptySlot;
+
+    if (m_garbage > kMinGarbage && m_garbage * 2 > m_keys.size())
+    {
+        compactKeys();
+    }
+    return true;
+}
+
+void P4OidTable::clear()
+{
+    m_slots.clear();
+    m_slots.shrink_to_fit();
+    m_keys.clear();
+    m_keys.shrink_to_fit();
+    m_garbage = 0;
+    m_size = 0;
+}
+
+uint32_t P4OidTable::hashKey(const std::string &key)
+{
+    // Folded to 32 bits, kept in the slots to skip most key compares
+    uint64_t hash = std::hash<std::string>()(key);
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+size_t P4OidTable::probe(const std::string &key, uint32_t hash) const
+{
+    size_t mask = m_slots.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        const auto &slot = m_slots[i];
+        if (slot.key == kEmptySlot || (slot.hash == hash && keyEquals(slot.key, key)))
+        {
+            return i;
+        }
+    }
+}
+
+bool P4OidTable::keyEquals(uint32_t offset, const std::string &key) const
+{
+    uint32_t size;
+    memcpy(&size, &m_keys[offset], sizeof(size));
+    return size == key.size() && memcmp(&m_keys[offset + sizeof(size)], key.data(), size) == 0;
+}
+
+std::string P4OidTable::keyAt(uint32_t offset) const
+{
+    uint32_t size;
+    memcpy(&size, &m_keys[offset], sizeof(size));
+    return std::string(&m_keys[offset + sizeof(size)], size);
+}
+
+uint32_t P4OidTable::storeKey(const std::string &key)
+{
+    size_t offset = m_keys.size();
+    if (offset + sizeof(uint32_t) + key.size() >= kEmptySlot)
+    {
+        throw std::length_error("P4 OID mapper keys exceed 4GB");
+    }
+
+    uint32_t size = static_cast<uint32_t>(key.size());
+    m_keys.resize(offset + sizeof(size) + size);
+    memcpy(&m_keys[offset], &size, sizeof(size));
+    memcpy(&m_keys[offset + sizeof(size)], key.data(), size);
+    return static_cast<uint32_t>(offset);
+}
+
+void P4OidTable::rehash(size_t capacity)
+{
+    SlotVector slots(capacity, Slot{{SAI_NULL_OBJECT_ID, 0}, kEmptySlot, 0});
+    size_t mask = capacity - 1;
+    for (const auto &slot : m_slots)
+    {
+        if (slot.key == kEmptySlot)
+        {
+            continue;
+        }
+
+        size_t i = slot.hash & mask;
+        while (slots[i].key != kEmptySlot)
+        {
+            i = (i + 1) & mask;
+        }
+        slots[i] = slot;
+    }
+    m_slots.swap(slots);
+}
+
+void P4OidTable::compactKeys()
+{
+    KeyVector keys;
+    keys.reserve(m_keys.size() - m_garbage);
+    for (auto &slot : m_slots)
+    {
+        if (slot.key == kEmptySlot)
+        {
+            continue;
+        }
+
+        uint32_t size;
+        memcpy(&size, &m_keys[slot.key], sizeof(size));
+        auto begin = m_keys.begin() + slot.key;
+        uint32_t offset = static_cast<uint32_t>(keys.size());
+        keys.insert(keys.end(), begin, begin + sizeof(size) + size);
+        slot.key = offset;
+    }
+    m_keys.swap(keys);
+    m_garbage = 0;
+}
+
 P4OidMapper::P4OidMapper() : m_db("APPL_STATE_DB", 0) {}
 
 bool P4OidMapper::setOID(_In_ sai_object_type_t object_type, _In_ const std::string &key, _In_ sai_object_id_t oid,
@@ -22,13 +211,12 @@ bool P4OidMapper::setOID(_In_ sai_object_type_t object_type, _In_ const std::str
 {
     SWSS_LOG_ENTER();
 
-    if (m_oidTables[object_type].find(key) != m_oidTables[object_type].end())
+    if (!m_oidTables[object_type].insert(key, {oid, ref_count}))
     {
         SWSS_LOG_ERROR("Key %s with SAI object type %d already exists in centralized mapper", key.c_str(), object_type);
         return false;
     }
 
-    m_oidTables[object_type][key] = {oid, ref_count};
     return true;
 }
 
@@ -43,13 +231,14 @@ bool P4OidMapper::getOID(_In_ sai_object_type_t object_type, _In_ const std::str
         return false;
     }
 
-    if (m_oidTables[object_type].find(key) == m_oidTables[object_type].end())
+    auto *entry = m_oidTables[object_type].find(key);
+    if (entry == nullptr)
     {
         SWSS_LOG_ERROR("Key %s with SAI object type %d does not exist in centralized mapper", key.c_str(), object_type);
         return false;
     }
 
-    *oid = m_oidTables[object_type].at(key).sai_oid;
+    *oid = entry->sai_oid;
     return true;
 }
 
@@ -64,7 +253,8 @@ bool P4OidMapper::getRefCount(_In_ sai_object_type_t object_type, _In_ const std
         return false;
     }
 
-    if (m_oidTables[object_type].find(key) == m_oidTables[object_type].end())
+    auto *entry = m_oidTables[object_type].find(key);
+    if (entry == nullptr)
     {
         SWSS_LOG_ERROR("Key %s with SAI object type %d does not exist in "
                        "centralized mapper",
@@ -72,7 +262,7 @@ bool P4OidMapper::getRefCount(_In_ sai_object_type_t object_type, _In_ const std
         return false;
     }
 
-    *ref_count = m_oidTables[object_type].at(key).ref_count;
+    *ref_count = entry->ref_count;
     return true;
 }
 
@@ -80,7 +270,8 @@ bool P4OidMapper::eraseOID(_In_ sai_object_type_t object_type, _In_ const std::s
 {
     SWSS_LOG_ENTER();
 
-    if (m_oidTables[object_type].find(key) == m_oidTables[object_type].end())
+    auto *entry = m_oidTables[object_type].find(key);
+    if (entry == nullptr)
     {
         SWSS_LOG_ERROR("Key %s with SAI object type %d does not exist in "
                        "centralized mapper",
@@ -88,7 +279,7 @@ bool P4OidMapper::eraseOID(_In_ sai_object_type_t object_type, _In_ const std::s
         return false;
     }
 
-    if (m_oidTables[object_type][key].ref_count != 0)
+    if (entry->ref_count != 0)
     {
         SWSS_LOG_ERROR("Key %s with SAI object type %d has non-zero reference count in "
                        "centralized mapper",
@@ -118,14 +309,15 @@ bool P4OidMapper::existsOID(_In_ sai_object_type_t object_type, _In_ const std::
 {
     SWSS_LOG_ENTER();
 
-    return m_oidTables[object_type].find(key) != m_oidTables[object_type].end();
+    return m_oidTables[object_type].find(key) != nullptr;
 }
 
 bool P4OidMapper::increaseRefCount(_In_ sai_object_type_t object_type, _In_ const std::string &key)
 {
     SWSS_LOG_ENTER();
 
-    if (m_oidTables[object_type].find(key) == m_oidTables[object_type].end())
+    auto *entry = m_oidTables[object_type].find(key);
+    if (entry == nullptr)
     {
         SWSS_LOG_ERROR("Key %s with SAI object type %d does not exist in "
                        "centralized mapper",
@@ -133,15 +325,15 @@ bool P4OidMapper::increaseRefCount(_In_ sai_object_type_t object_type, _In_ cons
         return false;
     }
 
-    if (m_oidTables[object_type][key].ref_count == std::numeric_limits<uint32_t>::max())
+    if (entry->ref_count == std::numeric_limits<uint32_t>::max())
     {
         SWSS_LOG_ERROR("Key %s with SAI object type %d reached maximum ref_count %u in "
                        "centralized mapper",
-                       key.c_str(), object_type, m_oidTables[object_type][key].ref_count);
+                       key.c_str(), object_type, entry->ref_count);
         return false;
     }
 
-    m_oidTables[object_type][key].ref_count++;
+    entry->ref_count++;
     return true;
 }
 
@@ -149,7 +341,8 @@ bool P4OidMapper::decreaseRefCount(_In_ sai_object_type_t object_type, _In_ cons
 {
     SWSS_LOG_ENTER();
 
-    if (m_oidTables[object_type].find(key) == m_oidTables[object_type].end())
+    auto *entry = m_oidTables[object_type].find(key);
+    if (entry == nullptr)
     {
         SWSS_LOG_ERROR("Key %s with SAI object type %d does not exist in "
                        "centralized mapper",
@@ -157,7 +350,7 @@ bool P4OidMapper::decreaseRefCount(_In_ sai_object_type_t object_type, _In_ cons
         return false;
     }
 
-    if (m_oidTables[object_type][key].ref_count == 0)
+    if (entry->ref_count == 0)
     {
         SWSS_LOG_ERROR("Key %s with SAI object type %d reached zero ref_count in "
                        "centralized mapper",
@@ -165,7 +358,7 @@ bool P4OidMapper::decreaseRefCount(_In_ sai_object_type_t object_type, _In_ cons
         return false;
     }
 
-    m_oidTables[object_type][key].ref_count--;
+    entry->ref_count--;
     return true;
 }
 
@@ -200,11 +393,10 @@ std::string P4OidMapper::dumpStateCache() {
     }
 
     json oid_mapper_j = json({});
-    for (const auto& kv_pair : m_oidTables[i]) {
-      MapperEntry m = kv_pair.second;
+    m_oidTables[i].forEach([&oid_mapper_j](const std::string& key, const P4OidTable::Entry& m) {
       json mapper_entry_j = {{"sai_oid", sai_serialize_object_id(m.sai_oid)}, {"ref_count", m.ref_count}};
-      oid_mapper_j[kv_pair.first] = mapper_entry_j;
-    }
+      oid_mapper_j[key] = mapper_entry_j;
+    });
     std::string sai_object_type = sai_serialize_object_type(static_cast<sai_object_type_t>(i));
     cache[sai_object_type] = oid_mapper_j;
   }
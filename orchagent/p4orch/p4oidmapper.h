@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "dbconnector.h"
+#include "memaccounting.h"
 #include "table.h"
 
 extern "C"
@@ -11,6 +13,85 @@ extern "C"
 #include "sai.h"
 }
 
+MEM_ACCOUNTING_TAG(P4OidMapperMemTag, "P4OidMapper|oids");
+
+// Open addressing hash table of the OID mappings of one SAI object type.
+// Slots hold the key hash, the OID and the reference count side by side, keys
+// are stored once in an arena the slots refer to by offset. Erased keys leave
+// garbage in the arena, which is compacted once it outweighs the live keys.
+class P4OidTable
+{
+  public:
+    struct Entry
+    {
+        sai_object_id_t sai_oid;
+        uint32_t ref_count;
+    };
+
+    // Returns nullptr if the key doesn't exist.
+    Entry *find(const std::string &key);
+    const Entry *find(const std::string &key) const;
+
+    // Returns false if the key already exists.
+    bool insert(const std::string &key, const Entry &entry);
+
+    // Returns false if the key doesn't exist.
+    bool erase(const std::string &key);
+
+    void clear();
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    // Calls f(key, entry) for each entry, in no particular order.
+    template <typename F> void forEach(F f) const
+    {
+        for (const auto &slot : m_slots)
+        {
+            if (slot.key != kEmptySlot)
+            {
+                f(keyAt(slot.key), slot.entry);
+            }
+        }
+    }
+
+  private:
+    static constexpr uint32_t kEmptySlot = UINT32_MAX;
+
+    struct Slot
+    {
+        Entry entry;
+        // Offset of the key in the arena, kEmptySlot for an empty slot.
+        uint32_t key;
+        uint32_t hash;
+    };
+
+    using SlotVector = std::vector<Slot, MemAccountingAllocator<Slot, P4OidMapperMemTag>>;
+    using KeyVector = std::vector<char, MemAccountingAllocator<char, P4OidMapperMemTag>>;
+
+    static uint32_t hashKey(const std::string &key);
+    // Index of the slot of the key, or of the empty slot ending its probe.
+    size_t probe(const std::string &key, uint32_t hash) const;
+    bool keyEquals(uint32_t offset, const std::string &key) const;
+    std::string keyAt(uint32_t offset) const;
+    uint32_t storeKey(const std::string &key);
+    void rehash(size_t capacity);
+    void compactKeys();
+
+    SlotVector m_slots;
+    // Keys as a 32 bit length followed by the key bytes.
+    KeyVector m_keys;
+    size_t m_garbage = 0;
+    size_t m_size = 0;
+};
+
 // Interface for mapping P4 ID to SAI OID.
 // This class is not thread safe.
 class P4OidMapper
@@ -78,14 +159,8 @@ class P4OidMapper
     std::string dumpStateCache();
 
   private:
-    struct MapperEntry
-    {
-        sai_object_id_t sai_oid;
-        uint32_t ref_count;
-    };
-
     // Buckets of map tables, one for every SAI object type.
-    std::unordered_map<std::string, MapperEntry> m_oidTables[SAI_OBJECT_TYPE_MAX];
+    P4OidTable m_oidTables[SAI_OBJECT_TYPE_MAX];
 
     swss::DBConnector m_db;
 };
@@ -39,28 +39,29 @@ P4Orch::P4Orch(swss::DBConnector* db, std::vector<std::string> tableNames,
               /*dbPersistence=*/false),
       m_zmqServer(zmqServer),
       m_publisher("APPL_DB", /*bool buffered=*/true,
-                  /*db_write_thread=*/true, zmqServer)
+                  /*db_write_thread=*/true, zmqServer),
+      m_sequencer(&m_publisher)
 {
     SWSS_LOG_ENTER();
 
-    m_tablesDefnManager = std::make_unique<TablesDefnManager>(&m_p4OidMapper, &m_publisher);
-    m_routerIntfManager = std::make_unique<RouterInterfaceManager>(&m_p4OidMapper, &m_publisher);
-    m_neighborManager = std::make_unique<NeighborManager>(&m_p4OidMapper, &m_publisher);
-    m_greTunnelManager = std::make_unique<GreTunnelManager>(&m_p4OidMapper, &m_publisher);
-    m_nextHopManager = std::make_unique<NextHopManager>(&m_p4OidMapper, &m_publisher);
+    m_tablesDefnManager = std::make_unique<TablesDefnManager>(&m_p4OidMapper, &m_sequencer);
+    m_routerIntfManager = std::make_unique<RouterInterfaceManager>(&m_p4OidMapper, &m_sequencer);
+    m_neighborManager = std::make_unique<NeighborManager>(&m_p4OidMapper, &m_sequencer);
+    m_greTunnelManager = std::make_unique<GreTunnelManager>(&m_p4OidMapper, &m_sequencer);
+    m_nextHopManager = std::make_unique<NextHopManager>(&m_p4OidMapper, &m_sequencer);
     m_l3MulticastManager = std::make_unique<p4orch::L3MulticastManager>(
-        &m_p4OidMapper, vrfOrch, &m_publisher);
+        &m_p4OidMapper, vrfOrch, &m_sequencer);
     m_ipMulticastManager = std::make_unique<p4orch::IpMulticastManager>(
-        &m_p4OidMapper, vrfOrch, &m_publisher);
-    m_routeManager = std::make_unique<RouteManager>(&m_p4OidMapper, vrfOrch, &m_publisher);
-    m_mirrorSessionManager = std::make_unique<p4orch::MirrorSessionManager>(&m_p4OidMapper, &m_publisher);
-    m_aclTableManager = std::make_unique<p4orch::AclTableManager>(&m_p4OidMapper, &m_publisher);
-    m_aclRuleManager = std::make_unique<p4orch::AclRuleManager>(&m_p4OidMapper, vrfOrch, coppOrch, &m_publisher);
-    m_wcmpManager = std::make_unique<p4orch::WcmpManager>(&m_p4OidMapper, &m_publisher);
-    m_l3AdmitManager = std::make_unique<L3AdmitManager>(&m_p4OidMapper, &m_publisher);
+        &m_p4OidMapper, vrfOrch, &m_sequencer);
+    m_routeManager = std::make_unique<RouteManager>(&m_p4OidMapper, vrfOrch, &m_sequencer);
+    m_mirrorSessionManager = std::make_unique<p4orch::MirrorSessionManager>(&m_p4OidMapper, &m_sequencer);
+    m_aclTableManager = std::make_unique<p4orch::AclTableManager>(&m_p4OidMapper, &m_sequencer);
+    m_aclRuleManager = std::make_unique<p4orch::AclRuleManager>(&m_p4OidMapper, vrfOrch, coppOrch, &m_sequencer);
+    m_wcmpManager = std::make_unique<p4orch::WcmpManager>(&m_p4OidMapper, &m_sequencer);
+    m_l3AdmitManager = std::make_unique<L3AdmitManager>(&m_p4OidMapper, &m_sequencer);
     m_tunnelDecapGroupManager =
-        std::make_unique<TunnelDecapGroupManager>(&m_p4OidMapper, &m_publisher);
-    m_extTablesManager = std::make_unique<ExtTablesManager>(&m_p4OidMapper, vrfOrch, &m_publisher);
+        std::make_unique<TunnelDecapGroupManager>(&m_p4OidMapper, &m_sequencer);
+    m_extTablesManager = std::make_unique<ExtTablesManager>(&m_p4OidMapper, vrfOrch, &m_sequencer);
 
     m_p4TableToManagerMap[APP_P4RT_TABLES_DEFINITION_TABLE_NAME] = m_tablesDefnManager.get();
     m_p4TableToManagerMap[APP_P4RT_ROUTER_INTERFACE_TABLE_NAME] = m_routerIntfManager.get();
@@ -179,32 +180,32 @@ void P4Orch::doTask(ConsumerBase &consumer)
           ReturnCode(StatusCode::SWSS_RC_NOT_EXECUTED), /*replace=*/true);
       continue;
     }
-    if (prev_op.empty()) {
-      prev_op = op;
-    }
-    if (prev_manager == nullptr) {
-      prev_manager = manager;
-    }
 
-        // Call drain after grouping the same type of requests together.
-    if (op != prev_op || prev_manager != manager) {
-      status = prev_manager->drain();
-            prev_op = op; 
-      prev_manager = manager;
-        }
+    // A run of SET requests is enqueued across the managers and drained once
+    // in add precedence, so the dependency layers are programmed as
+    // consecutive bulk calls. Other requests are drained when the manager
+    // changes.
+    if (!prev_op.empty() &&
+        (op != prev_op || (op != SET_COMMAND && manager != prev_manager))) {
+      status = drainRun(prev_op, prev_manager);
+    }
+    prev_op = op;
+    prev_manager = manager;
 
         if (status.ok()) {
-      prev_manager->enqueue(p4rt_table_name, kco);
+      if (op == SET_COMMAND) {
+        m_sequencer.expect(kfvKey(kco));
+      }
+      manager->enqueue(p4rt_table_name, kco);
         } else {
            m_publisher.publish(APP_P4RT_TABLE_NAME, kfvKey(kco),
                                kfvFieldsValues(kco),
                                ReturnCode(StatusCode::SWSS_RC_NOT_EXECUTED),
                                /*replace=*/true);
-      prev_manager = nullptr;
         }
     }
-  if (prev_manager != nullptr) {
-    prev_manager->drain();
+  if (!prev_op.empty() && status.ok()) {
+    drainRun(prev_op, prev_manager);
     }   
     m_publisher.flush();
     zmq_consumer->m_queue.clear();
@@ -275,6 +276,93 @@ ReturnCode P4Orch::drain() {
   return status;
 }
 
+ReturnCode P4Orch::drainRun(const std::string& op,
+                            ObjectManagerInterface* manager) {
+  if (op != SET_COMMAND) {
+    return manager->drain();
+  }
+
+  m_sequencer.hold();
+  ReturnCode status = drain();
+  m_sequencer.release();
+  return status;
+}
+
+void P4ResponseSequencer::publish(
+    const std::string& table, const std::string& key,
+    const std::vector<swss::FieldValueTuple>& intent_attrs,
+    const ReturnCode& status,
+    const std::vector<swss::FieldValueTuple>& state_attrs, bool replace) {
+  if (m_holding) {
+    m_held[key].push_back(
+        {table, intent_attrs, status, state_attrs, true, replace});
+    return;
+  }
+  m_publisher->publish(table, key, intent_attrs, status, state_attrs, replace);
+}
+
+void P4ResponseSequencer::publish(
+    const std::string& table, const std::string& key,
+    const std::vector<swss::FieldValueTuple>& intent_attrs,
+    const ReturnCode& status, bool replace) {
+  if (m_holding) {
+    m_held[key].push_back({table, intent_attrs, status, {}, false, replace});
+    return;
+  }
+  m_publisher->publish(table, key, intent_attrs, status, replace);
+}
+
+void P4ResponseSequencer::writeToDB(
+    const std::string& table, const std::string& key,
+    const std::vector<swss::FieldValueTuple>& values, const std::string& op,
+    bool replace) {
+  m_publisher->writeToDB(table, key, values, op, replace);
+}
+
+void P4ResponseSequencer::setEnableDbWriteAndNotify(
+    bool enable_db_write_and_notify) {
+  m_publisher->setEnableDbWriteAndNotify(enable_db_write_and_notify);
+}
+
+void P4ResponseSequencer::expect(const std::string& key) {
+  m_keys.push_back(key);
+}
+
+void P4ResponseSequencer::hold() { m_holding = true; }
+
+void P4ResponseSequencer::release() {
+  m_holding = false;
+  for (const auto& key : m_keys) {
+    auto it = m_held.find(key);
+    if (it == m_held.end() || it->second.empty()) {
+      continue;
+    }
+    publish(key, it->second.front());
+    it->second.pop_front();
+  }
+
+  // Responses to keys that were not requested in the run
+  for (const auto& it : m_held) {
+    for (const auto& response : it.second) {
+      publish(it.first, response);
+    }
+  }
+  m_keys.clear();
+  m_held.clear();
+}
+
+void P4ResponseSequencer::publish(const std::string& key,
+                                  const Response& response) {
+  if (response.with_state_attrs) {
+    m_publisher->publish(response.table, key, response.intent_attrs,
+                         response.status, response.state_attrs,
+                         response.replace);
+  } else {
+    m_publisher->publish(response.table, key, response.intent_attrs,
+                         response.status, response.replace);
+  }
+}
+
 void P4Orch::handlePortStatusChangeNotification(const std::string &op, const std::string &data)
 {
     if (op == "port_state_change")
@@ -300,14 +388,17 @@ void P4Orch::handlePortStatusChangeNotification(const std::string &op, const std
 
             if (status == SAI_PORT_OPER_STATUS_UP)
             {
-              m_wcmpManager->updateWatchPort(port.m_alias, false);
+              m_wcmpManager->queueWatchPortUpdate(port.m_alias, false);
             }
             else
             {
-              m_wcmpManager->updateWatchPort(port.m_alias, true);
+              m_wcmpManager->queueWatchPortUpdate(port.m_alias, true);
             }
         }
 
+        // The groups of all the ports of the notification are updated together
+        m_wcmpManager->flushWatchPortUpdates();
+
         sai_deserialize_free_port_oper_status_ntf(count, port_oper_status);
     }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
@@ -43,6 +44,51 @@ static const std::map<std::string, std::string> FixedTablesMap = {
     {"l3_admit_table", APP_P4RT_L3_ADMIT_TABLE_NAME},
     {"tunnel_table", APP_P4RT_TUNNEL_TABLE_NAME}};
 
+// Response publisher of the P4 managers. While a run of requests is drained
+// in add precedence, the responses are held and published in request order.
+class P4ResponseSequencer : public ResponsePublisherInterface
+{
+  public:
+    explicit P4ResponseSequencer(ResponsePublisherInterface *publisher) : m_publisher(publisher)
+    {
+    }
+
+    void publish(const std::string &table, const std::string &key,
+                 const std::vector<swss::FieldValueTuple> &intent_attrs, const ReturnCode &status,
+                 const std::vector<swss::FieldValueTuple> &state_attrs, bool replace = false) override;
+    void publish(const std::string &table, const std::string &key,
+                 const std::vector<swss::FieldValueTuple> &intent_attrs, const ReturnCode &status,
+                 bool replace = false) override;
+    void writeToDB(const std::string &table, const std::string &key, const std::vector<swss::FieldValueTuple> &values,
+                   const std::string &op, bool replace = false) override;
+    void setEnableDbWriteAndNotify(bool enable_db_write_and_notify) override;
+
+    // Records the key of the next request of the run.
+    void expect(const std::string &key);
+    // Holds the responses until release().
+    void hold();
+    // Publishes the held responses in the order of the expected keys.
+    void release();
+
+  private:
+    struct Response
+    {
+        std::string table;
+        std::vector<swss::FieldValueTuple> intent_attrs;
+        ReturnCode status;
+        std::vector<swss::FieldValueTuple> state_attrs;
+        bool with_state_attrs;
+        bool replace;
+    };
+
+    void publish(const std::string &key, const Response &response);
+
+    ResponsePublisherInterface *m_publisher;
+    bool m_holding = false;
+    std::vector<std::string> m_keys;
+    std::unordered_map<std::string, std::deque<Response>> m_held;
+};
+
 class P4Orch : public ZmqOrch
 {
   public:
@@ -72,6 +118,8 @@ class P4Orch : public ZmqOrch
                                         std::string& table_name);
     void enqueue(const swss::KeyOpFieldsValuesTuple& entry);
     ReturnCode drain();
+    // Drains a run of op requests, the SET runs go through all the managers.
+    ReturnCode drainRun(const std::string &op, ObjectManagerInterface *manager);
     void handlePortStatusChangeNotification(const std::string &op, const std::string &data);
 
     // P4 object manager request processing order.
@@ -102,6 +150,8 @@ class P4Orch : public ZmqOrch
     swss::ZmqServer* m_zmqServer;
     // Sepcial publisher that writes to APPL DB instead of APPL STATE DB.
     ResponsePublisher m_publisher;
+    // Publisher given to the managers, on top of m_publisher.
+    P4ResponseSequencer m_sequencer;
 
     friend class P4OrchTest;
     friend class p4orch::test::WcmpManagerTest;
@@ -1,7 +1,12 @@
 #include "p4orch/p4orch_util.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <initializer_list>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include "p4orch/p4orch.h"
@@ -10,6 +15,93 @@
 using ::p4orch::kTableKeyDelimiter;
 extern P4Orch *gP4Orch;
 
+namespace
+{
+
+// Ids of the key fields which have a prefix, built once.
+const std::string kMatchMulticastGroupId =
+    std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter + p4orch::kMulticastGroupId;
+const std::string kMatchMulticastReplicaPort =
+    std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter + p4orch::kMulticastReplicaPort;
+const std::string kMatchMulticastReplicaInstance =
+    std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter + p4orch::kMulticastReplicaInstance;
+const std::string kParamSrcMac = std::string(p4orch::kActionParamPrefix) + p4orch::kFieldDelimiter + p4orch::kSrcMac;
+const std::string kMatchDstMac = std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter + p4orch::kDstMac;
+const std::string kMatchInPort = std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter + p4orch::kInPort;
+const std::string kMatchFieldPrefix = std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter;
+
+// A field of a key, refers to the id and value it is built from.
+struct KeyField
+{
+    KeyField() : id(""), id_size(0), value(""), value_size(0)
+    {
+    }
+
+    KeyField(const char *id, const std::string &value)
+        : id(id), id_size(strlen(id)), value(value.data()), value_size(value.size())
+    {
+    }
+
+    KeyField(const std::string &id, const std::string &value)
+        : id(id.data()), id_size(id.size()), value(value.data()), value_size(value.size())
+    {
+    }
+
+    bool operator<(const KeyField &other) const
+    {
+        int cmp = memcmp(id, other.id, std::min(id_size, other.id_size));
+        return cmp < 0 || (cmp == 0 && id_size < other.id_size);
+    }
+
+    const char *id;
+    size_t id_size;
+    const char *value;
+    size_t value_size;
+};
+
+constexpr size_t kMaxKeyFields = 8;
+
+void appendKeyField(std::string &key, const char *id, size_t id_size, const char *value, size_t value_size)
+{
+    if (!key.empty())
+    {
+        key.push_back(':');
+    }
+    key.append(id, id_size);
+    key.push_back('=');
+    key.append(value, value_size);
+}
+
+// Builds the key KeyGenerator::generateKey() would for a map of the fields,
+// ordered by id, allocating the key once.
+std::string buildKey(std::initializer_list<KeyField> fields)
+{
+    if (fields.size() > kMaxKeyFields)
+    {
+        throw std::invalid_argument("Too many key fields");
+    }
+
+    std::array<KeyField, kMaxKeyFields> sorted;
+    auto end = std::copy(fields.begin(), fields.end(), sorted.begin());
+    std::sort(sorted.begin(), end);
+
+    size_t size = 0;
+    for (auto it = sorted.begin(); it != end; it++)
+    {
+        size += it->id_size + it->value_size + 2;
+    }
+
+    std::string key;
+    key.reserve(size);
+    for (auto it = sorted.begin(); it != end; it++)
+    {
+        appendKeyField(key, it->id, it->id_size, it->value, it->value_size);
+    }
+    return key;
+}
+
+} // namespace
+
 // Prepends "match/" to the input string str to construct a new string.
 std::string prependMatchField(const std::string &str)
 {
@@ -120,8 +212,7 @@ ActionInfo *getTableActionInfo(TableInfo *table, const std::string &action_name)
 
 std::string KeyGenerator::generateTablesInfoKey(const std::string &context)
 {
-    std::map<std::string, std::string> fv_map = {{"context", context}};
-    return generateKey(fv_map);
+    return buildKey({{"context", context}});
 }
 
 void drainMgmtWithNotExecuted(std::deque<swss::KeyOpFieldsValuesTuple>& entries,
@@ -162,9 +253,8 @@ ReturnCodeOr<bool> parseFlag(const std::string& name,
 
 std::string KeyGenerator::generateRouteKey(const std::string &vrf_id, const swss::IpPrefix &ip_prefix)
 {
-    std::map<std::string, std::string> fv_map = {
-        {p4orch::kVrfId, vrf_id}, {ip_prefix.isV4() ? p4orch::kIpv4Dst : p4orch::kIpv6Dst, ip_prefix.to_string()}};
-    return generateKey(fv_map);
+    return buildKey(
+        {{p4orch::kVrfId, vrf_id}, {ip_prefix.isV4() ? p4orch::kIpv4Dst : p4orch::kIpv6Dst, ip_prefix.to_string()}});
 }
 
 std::string KeyGenerator::generateRouterInterfaceKey(const std::string &router_intf_id)
@@ -174,9 +264,7 @@ std::string KeyGenerator::generateRouterInterfaceKey(const std::string &router_i
 
 std::string KeyGenerator::generateNeighborKey(const std::string &router_intf_id, const swss::IpAddress &neighbor_id)
 {
-    std::map<std::string, std::string> fv_map = {{p4orch::kRouterInterfaceId, router_intf_id},
-                                                 {p4orch::kNeighborId, neighbor_id.to_string()}};
-    return generateKey(fv_map);
+    return buildKey({{p4orch::kRouterInterfaceId, router_intf_id}, {p4orch::kNeighborId, neighbor_id.to_string()}});
 }
 
 std::string KeyGenerator::generateNextHopKey(const std::string &next_hop_id)
@@ -192,47 +280,24 @@ std::string KeyGenerator::generateMirrorSessionKey(const std::string &mirror_ses
 std::string KeyGenerator::generateMulticastRouterInterfaceKey(
     const std::string& multicast_replica_port,
     const std::string& multicast_replica_instance) {
-  std::map<std::string, std::string> fv_map = {};
-
-  fv_map.emplace(std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter +
-                     p4orch::kMulticastReplicaPort,
-                 multicast_replica_port);
-  fv_map.emplace(std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter +
-                     p4orch::kMulticastReplicaInstance,
-                 multicast_replica_instance);
-  return generateKey(fv_map);
+  return buildKey({{kMatchMulticastReplicaPort, multicast_replica_port},
+                   {kMatchMulticastReplicaInstance, multicast_replica_instance}});
 }
 
 std::string KeyGenerator::generateMulticastReplicationKey(
     const std::string& multicast_group_id,
     const std::string& multicast_replica_port,
     const std::string& multicast_replica_instance) {
-  std::map<std::string, std::string> fv_map = {};
-
-  fv_map.emplace(std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter +
-                     p4orch::kMulticastGroupId,
-                 multicast_group_id);
-  fv_map.emplace(std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter +
-                     p4orch::kMulticastReplicaPort,
-                 multicast_replica_port);
-  fv_map.emplace(std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter +
-                     p4orch::kMulticastReplicaInstance,
-                 multicast_replica_instance);
-  return generateKey(fv_map);
+  return buildKey({{kMatchMulticastGroupId, multicast_group_id},
+                   {kMatchMulticastReplicaPort, multicast_replica_port},
+                   {kMatchMulticastReplicaInstance, multicast_replica_instance}});
 }
 
 std::string KeyGenerator::generateMulticastRouterInterfaceRifKey(
     const std::string& multicast_replica_port,
     const swss::MacAddress& src_mac) {
-  std::map<std::string, std::string> fv_map = {};
-
-  fv_map.emplace(std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter +
-                     p4orch::kMulticastReplicaPort,
-                 multicast_replica_port);
-  fv_map.emplace(std::string(p4orch::kActionParamPrefix) +
-                     p4orch::kFieldDelimiter + p4orch::kSrcMac,
-                 src_mac.to_string());
-  return generateKey(fv_map);
+  return buildKey({{kMatchMulticastReplicaPort, multicast_replica_port},
+                   {kParamSrcMac, src_mac.to_string()}});
 }
 
 std::string KeyGenerator::generateL3MulticastGroupKey(
@@ -264,10 +329,9 @@ std::string KeyGenerator::generateL2MulticastGroupKey(
 
 std::string KeyGenerator::generateIpMulticastKey(
     const std::string& vrf_id, const swss::IpAddress& ip_dst) {
-  std::map<std::string, std::string> fv_map = {
-      {ip_dst.isV4() ? p4orch::kIpv4Dst : p4orch::kIpv6Dst, ip_dst.to_string()},
-      {p4orch::kVrfId, vrf_id}};
-  return generateKey(fv_map);
+  return buildKey(
+      {{ip_dst.isV4() ? p4orch::kIpv4Dst : p4orch::kIpv6Dst, ip_dst.to_string()},
+       {p4orch::kVrfId, vrf_id}});
 }
 
 std::string KeyGenerator::generateWcmpGroupKey(const std::string &wcmp_group_id)
@@ -278,29 +342,41 @@ std::string KeyGenerator::generateWcmpGroupKey(const std::string &wcmp_group_id)
 std::string KeyGenerator::generateAclRuleKey(const std::map<std::string, std::string> &match_fields,
                                              const std::string &priority)
 {
-    std::map<std::string, std::string> fv_map = {};
+    // The match fields are already ordered, and all of them before the priority
+    size_t size = strlen(p4orch::kPriority) + priority.size() + 2;
     for (const auto &match_field : match_fields)
     {
-        fv_map.emplace(std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter + match_field.first,
-                       match_field.second);
+        size += kMatchFieldPrefix.size() + match_field.first.size() + match_field.second.size() + 2;
     }
-    fv_map.emplace(p4orch::kPriority, priority);
-    return generateKey(fv_map);
+
+    std::string key;
+    key.reserve(size);
+    for (const auto &match_field : match_fields)
+    {
+        if (!key.empty())
+        {
+            key.push_back(':');
+        }
+        key.append(kMatchFieldPrefix);
+        key.append(match_field.first);
+        key.push_back('=');
+        key.append(match_field.second);
+    }
+    appendKeyField(key, p4orch::kPriority, strlen(p4orch::kPriority), priority.data(), priority.size());
+    return key;
 }
 
 std::string KeyGenerator::generateL3AdmitKey(const swss::MacAddress &mac_address_data,
                                              const swss::MacAddress &mac_address_mask, const std::string &port_name,
                                              const uint32_t &priority)
 {
-    std::map<std::string, std::string> fv_map = {};
-    fv_map.emplace(std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter + p4orch::kDstMac,
-                   mac_address_data.to_string() + p4orch::kDataMaskDelimiter + mac_address_mask.to_string());
-    if (!port_name.empty())
+    std::string dst_mac = mac_address_data.to_string() + p4orch::kDataMaskDelimiter + mac_address_mask.to_string();
+    if (port_name.empty())
     {
-        fv_map.emplace(std::string(p4orch::kMatchPrefix) + p4orch::kFieldDelimiter + p4orch::kInPort, port_name);
+        return buildKey({{kMatchDstMac, dst_mac}, {p4orch::kPriority, std::to_string(priority)}});
     }
-    fv_map.emplace(p4orch::kPriority, std::to_string(priority));
-    return generateKey(fv_map);
+    return buildKey(
+        {{kMatchDstMac, dst_mac}, {kMatchInPort, port_name}, {p4orch::kPriority, std::to_string(priority)}});
 }
 
 std::string KeyGenerator::generateTunnelKey(const std::string &tunnel_id)
@@ -311,18 +387,17 @@ std::string KeyGenerator::generateTunnelKey(const std::string &tunnel_id)
 std::string KeyGenerator::generateIpv6TunnelTermKey(
     const swss::IpAddress& src_ipv6_ip, const swss::IpAddress& src_ipv6_mask,
     const swss::IpAddress& dst_ipv6_ip, const swss::IpAddress& dst_ipv6_mask) {
-  std::map<std::string, std::string> fv_map = {
-      {p4orch::kDecapSrcIpv6Ip, src_ipv6_ip.to_string()},
-      {p4orch::kDecapSrcIpv6Mask, src_ipv6_mask.to_string()},
-      {p4orch::kDecapDstIpv6Ip, dst_ipv6_ip.to_string()},
-      {p4orch::kDecapDstIpv6Mask, dst_ipv6_mask.to_string()}};
-  return generateKey(fv_map);
+  return buildKey({{p4orch::kDecapSrcIpv6Ip, src_ipv6_ip.to_string()},
+                   {p4orch::kDecapSrcIpv6Mask, src_ipv6_mask.to_string()},
+                   {p4orch::kDecapDstIpv6Ip, dst_ipv6_ip.to_string()},
+                   {p4orch::kDecapDstIpv6Mask, dst_ipv6_mask.to_string()}});
 }
 
 std::string KeyGenerator::generateExtTableKey(const std::string &table_name, const std::string &table_key)
 {
     std::string key;
 
+    key.reserve(table_name.size() + table_key.size() + 1);
     key.append(table_name);
     key.append(":");
     key.append(table_key);
@@ -332,7 +407,14 @@ std::string KeyGenerator::generateExtTableKey(const std::string &table_name, con
 
 std::string KeyGenerator::generateKey(const std::map<std::string, std::string> &fv_map)
 {
+    size_t size = 0;
+    for (const auto &it : fv_map)
+    {
+        size += it.first.size() + it.second.size() + 2;
+    }
+
     std::string key;
+    key.reserve(size);
     bool append_delimiter = false;
     for (const auto &it : fv_map)
     {
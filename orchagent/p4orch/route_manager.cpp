@@ -1,5 +1,6 @@
 #include "p4orch/route_manager.h"
 
+#include <algorithm>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <sstream>
@@ -21,6 +22,8 @@
 
 using ::p4orch::kTableKeyDelimiter;
 
+#define P4_ROUTE_PARSE_CHUNK 256
+
 extern sai_object_id_t gSwitchId;
 extern sai_object_id_t gVirtualRouterId;
 
@@ -296,6 +299,8 @@ bool RouteUpdater::checkAction(int idx) const {
     return false;
 }
 
+size_t RouteManager::m_parseThreads = 0;
+
 RouteManager::RouteManager(P4OidMapper *p4oidMapper, VRFOrch *vrfOrch, ResponsePublisherInterface *publisher)
     : m_vrfOrch(vrfOrch),
       m_routerBulker(sai_route_api, gMaxBulkSize),
@@ -907,9 +912,45 @@ void RouteManager::drainWithNotExecuted() {
   drainMgmtWithNotExecuted(m_entries, m_publisher);
 }
 
+std::vector<std::unique_ptr<ReturnCodeOr<P4RouteEntry>>>
+RouteManager::deserializeRouteEntries() {
+  std::vector<std::unique_ptr<ReturnCodeOr<P4RouteEntry>>> parsed;
+  if (m_parseThreads == 0 || m_entries.size() <= P4_ROUTE_PARSE_CHUNK) {
+    // Not worth a hand off
+    return parsed;
+  }
+  if (!m_parsePool) {
+    m_parsePool.reset(new OrchWorkerPool(m_parseThreads));
+  }
+
+  parsed.resize(m_entries.size());
+  auto parse = [this, &parsed](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      std::string table_name;
+      std::string key;
+      parseP4RTKey(kfvKey(m_entries[i]), &table_name, &key);
+      parsed[i].reset(new ReturnCodeOr<P4RouteEntry>(
+          deserializeRouteEntry(key, kfvFieldsValues(m_entries[i]), table_name)));
+    }
+  };
+  for (size_t begin = 0; begin < parsed.size(); begin += P4_ROUTE_PARSE_CHUNK) {
+    size_t end = std::min(begin + P4_ROUTE_PARSE_CHUNK, parsed.size());
+    m_parsePool->submit([&parse, begin, end]() { parse(begin, end); });
+  }
+  m_parsePool->wait();
+
+  SWSS_LOG_INFO("Deserialized %zu route entries ahead", parsed.size());
+  return parsed;
+}
+
 ReturnCode RouteManager::drain() {
   SWSS_LOG_ENTER();
 
+  // Only the deserialization is done ahead, the validation depends on the
+  // entries of the batch programmed before.
+  auto parsed = deserializeRouteEntries();
+  size_t parsed_index = 0;
+
   std::vector<P4RouteEntry> route_list;
   std::vector<swss::KeyOpFieldsValuesTuple> tuple_list;
   std::unordered_set<std::string> route_entry_list;
@@ -926,7 +967,9 @@ ReturnCode RouteManager::drain() {
     const std::vector<swss::FieldValueTuple>& attributes =
         kfvFieldsValues(key_op_fvs_tuple);
 
-    auto route_entry_or = deserializeRouteEntry(key, attributes, table_name);
+    auto route_entry_or =
+        parsed.empty() ? deserializeRouteEntry(key, attributes, table_name)
+                       : std::move(*parsed[parsed_index++]);
     if (!route_entry_or.ok()) {
       status = route_entry_or.status();
       SWSS_LOG_ERROR("Unable to deserialize APP DB entry with key %s: %s",
@@ -10,6 +10,7 @@
 #include "bulker.h"
 #include "ipprefix.h"
 #include "orch.h"
+#include "orchworkerpool.h"
 #include "p4orch/next_hop_manager.h"
 #include "p4orch/object_manager_interface.h"
 #include "p4orch/p4oidmapper.h"
@@ -100,6 +101,13 @@ class RouteManager : public ObjectManagerInterface
     ReturnCode getSaiObject(const std::string &json_key, sai_object_type_t &object_type,
                             std::string &object_key) override;
 
+    // Deserializes large batches of route entries on this many threads ahead of
+    // their validation and programming, 0 to deserialize them inline.
+    static void setParseThreads(size_t threads)
+    {
+        m_parseThreads = threads;
+    }
+
   private:
     // Applies route entry updates from src to dest. The merged result will be
     // stored in ret.
@@ -112,6 +120,10 @@ class RouteManager : public ObjectManagerInterface
                                                      const std::vector<swss::FieldValueTuple> &attributes,
                                                      const std::string &table_name);
 
+    // Deserializes the queued entries, in queue order, on the parse pool.
+    // Returns nothing if the batch is to be deserialized inline.
+    std::vector<std::unique_ptr<ReturnCodeOr<P4RouteEntry>>> deserializeRouteEntries();
+
     // Gets the internal cached route entry by its key.
     // Return nullptr if corresponding route entry is not cached.
     P4RouteEntry *getRouteEntry(const std::string &route_entry_key);
@@ -165,6 +177,8 @@ class RouteManager : public ObjectManagerInterface
     swss::Table m_asic_state_table;
     ResponsePublisherInterface *m_publisher;
     std::deque<swss::KeyOpFieldsValuesTuple> m_entries;
+    static size_t m_parseThreads;
+    std::unique_ptr<OrchWorkerPool> m_parsePool;
 
     friend class RouteManagerTest;
 };
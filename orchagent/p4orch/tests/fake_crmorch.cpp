@@ -32,11 +32,11 @@ void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 {
 }
 
-void CrmOrch::incCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name)
+void CrmOrch::incCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name, uint32_t count)
 {
 }
 
-void CrmOrch::decCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name)
+void CrmOrch::decCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name, uint32_t count)
 {
 }
 
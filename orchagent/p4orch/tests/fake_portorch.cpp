@@ -21,8 +21,8 @@ sai_object_id_t gBridgePortOid;
 #define PG_DROP_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS   10000
 
 PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_with_pri_t> &tableNames,
-                     DBConnector *chassisAppDb)
-    : Orch(db, tableNames),
+                     DBConnector *chassisAppDb, swss::ZmqServer *zmqServer)
+    : ZmqOrch(db, tableNames, zmqServer, {APP_LAG_TABLE_NAME, APP_LAG_MEMBER_TABLE_NAME}),
       m_portStateTable(stateDb, STATE_PORT_TABLE_NAME),
       m_portOpErrTable(stateDb, STATE_PORT_OPER_ERR_TABLE_NAME),
       port_stat_manager(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP, StatsMode::READ,
@@ -62,7 +62,7 @@ bool PortsOrch::isPortAdminUp(const string &alias)
 
 std::map<string, Port> &PortsOrch::getAllPorts()
 {
-    return m_portList;
+    return m_portList.ports();
 }
 
 bool PortsOrch::bake()
@@ -398,27 +398,27 @@ void PortsOrch::doTask()
 {
 }
 
-void PortsOrch::doTask(Consumer &consumer)
+void PortsOrch::doTask(ConsumerBase &consumer)
 {
 }
 
-void PortsOrch::doPortTask(Consumer &consumer)
+void PortsOrch::doPortTask(ConsumerBase &consumer)
 {
 }
 
-void PortsOrch::doVlanTask(Consumer &consumer)
+void PortsOrch::doVlanTask(ConsumerBase &consumer)
 {
 }
 
-void PortsOrch::doVlanMemberTask(Consumer &consumer)
+void PortsOrch::doVlanMemberTask(ConsumerBase &consumer)
 {
 }
 
-void PortsOrch::doLagTask(Consumer &consumer)
+void PortsOrch::doLagTask(ConsumerBase &consumer)
 {
 }
 
-void PortsOrch::doLagMemberTask(Consumer &consumer)
+void PortsOrch::doLagMemberTask(ConsumerBase &consumer)
 {
 }
 
@@ -65,6 +65,27 @@ namespace p4orch {
 
 namespace {
 // Helpful place for constant and/or test functions
+
+// Bulk RIF creation on top of the single object mock, so each RIF is still
+// expected through create_router_interface.
+sai_status_t create_router_interfaces_one_by_one(
+    sai_object_id_t switch_id, uint32_t object_count,
+    const uint32_t* attr_count, const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode, sai_object_id_t* object_id,
+    sai_status_t* object_statuses) {
+  sai_status_t status = SAI_STATUS_SUCCESS;
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (status != SAI_STATUS_SUCCESS) {
+      object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+      continue;
+    }
+    object_statuses[i] = mock_sai_router_intf->create_router_interface(
+        &object_id[i], switch_id, attr_count[i], attr_list[i]);
+    status = object_statuses[i];
+  }
+  return status;
+}
+
 constexpr char* kSrcMac0 = "00:00:00:00:00:00";
 constexpr char* kSrcMac1 = "00:01:02:03:04:05";
 constexpr char* kSrcMac2 = "00:0a:0b:0c:0d:0e";
@@ -792,6 +813,8 @@ class L3MulticastManagerTest : public ::testing::Test {
     mock_sai_router_intf = &mock_sai_router_intf_;
     sai_router_intfs_api->create_router_interface =
         mock_create_router_interface;
+    sai_router_intfs_api->create_router_interfaces =
+        create_router_interfaces_one_by_one;
 
     mock_sai_ipmc_group = &mock_sai_ipmc_group_;
     sai_ipmc_group_api->create_ipmc_group = mock_create_ipmc_group;
@@ -938,7 +961,13 @@ class L3MulticastManagerTest : public ::testing::Test {
 
   ReturnCode CreateRouterInterface(P4MulticastRouterInterfaceEntry& entry,
                                    sai_object_id_t* rif_oid) {
-    return l3_multicast_manager_.createRouterInterface(entry, rif_oid);
+    std::vector<sai_object_id_t> rif_oids;
+    auto statuses =
+        l3_multicast_manager_.createRouterInterfaces({&entry}, &rif_oids);
+    if (!rif_oids.empty()) {
+      *rif_oid = rif_oids[0];
+    }
+    return statuses[0];
   }
 
   ReturnCode CreateNextHop(P4MulticastRouterInterfaceEntry& entry,
@@ -1842,6 +1871,110 @@ TEST_F(L3MulticastManagerTest,
   EXPECT_EQ(statuses[1].code(), StatusCode::SWSS_RC_NOT_EXECUTED);
 }
 
+TEST_F(L3MulticastManagerTest,
+       AddMulticastRouterInterfaceEntriesCreatesRifsInOneBulkCall) {
+  sai_router_intfs_api->create_router_interfaces =
+      mock_create_router_interfaces;
+  std::vector<P4MulticastRouterInterfaceEntry> entries;
+  entries.push_back(GenerateP4MulticastRouterInterfaceEntry(
+      "Ethernet5", "0x4", swss::MacAddress(kSrcMac5)));
+  entries.push_back(GenerateP4MulticastRouterInterfaceEntry(
+      "Ethernet5", "0x5", swss::MacAddress(kSrcMac5)));
+
+  std::vector<sai_object_id_t> exp_oids{kRifOid4, kRifOid5};
+  std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS, SAI_STATUS_SUCCESS};
+  EXPECT_CALL(mock_sai_router_intf_,
+              create_router_interfaces(
+                  Eq(gSwitchId), Eq(2), _, _,
+                  Eq(SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR), _, _))
+      .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                      SetArrayArgument<6>(exp_status.begin(), exp_status.end()),
+                      Return(SAI_STATUS_SUCCESS)));
+
+  std::vector<ReturnCode> statuses =
+      AddMulticastRouterInterfaceEntries(entries);
+  EXPECT_EQ(statuses.size(), 2);
+  EXPECT_TRUE(statuses[0].ok());
+  EXPECT_TRUE(statuses[1].ok());
+  EXPECT_EQ(GetRifOid(&entries[0]), kRifOid4);
+  EXPECT_EQ(GetRifOid(&entries[1]), kRifOid5);
+}
+
+TEST_F(L3MulticastManagerTest,
+       AddMulticastRouterInterfaceEntriesSecondRifFailsInBulk) {
+  sai_router_intfs_api->create_router_interfaces =
+      mock_create_router_interfaces;
+  std::vector<P4MulticastRouterInterfaceEntry> entries;
+  entries.push_back(GenerateP4MulticastRouterInterfaceEntry(
+      "Ethernet5", "0x4", swss::MacAddress(kSrcMac5)));
+  entries.push_back(GenerateP4MulticastRouterInterfaceEntry(
+      "Ethernet5", "0x5", swss::MacAddress(kSrcMac5)));
+  entries.push_back(GenerateP4MulticastRouterInterfaceEntry(
+      "Ethernet5", "0x6", swss::MacAddress(kSrcMac5)));
+
+  std::vector<sai_object_id_t> exp_oids{kRifOid4, SAI_NULL_OBJECT_ID,
+                                        SAI_NULL_OBJECT_ID};
+  std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS, SAI_STATUS_FAILURE,
+                                       SAI_STATUS_NOT_EXECUTED};
+  EXPECT_CALL(mock_sai_router_intf_,
+              create_router_interfaces(Eq(gSwitchId), Eq(3), _, _, _, _, _))
+      .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                      SetArrayArgument<6>(exp_status.begin(), exp_status.end()),
+                      Return(SAI_STATUS_FAILURE)));
+
+  std::vector<ReturnCode> statuses =
+      AddMulticastRouterInterfaceEntries(entries);
+  EXPECT_EQ(statuses.size(), 3);
+  EXPECT_TRUE(statuses[0].ok());
+  EXPECT_EQ(statuses[1].code(), StatusCode::SWSS_RC_UNKNOWN);
+  EXPECT_EQ(statuses[2].code(), StatusCode::SWSS_RC_NOT_EXECUTED);
+  EXPECT_EQ(GetRifOid(&entries[0]), kRifOid4);
+  EXPECT_EQ(GetMulticastRouterInterfaceEntry(
+                entries[1].multicast_router_interface_entry_key),
+            nullptr);
+}
+
+TEST_F(L3MulticastManagerTest,
+       AddMulticastRouterInterfaceEntriesNextHopFailsRemovesLaterRifs) {
+  std::vector<P4MulticastRouterInterfaceEntry> entries;
+  entries.push_back(GenerateP4MulticastRouterInterfaceEntryByAction(
+      "Ethernet1", "0x0001", swss::MacAddress(kSrcMac1),
+      swss::MacAddress(kDstMac0), /*vlan_id=*/0, "metadata",
+      p4orch::kMulticastSetSrcMac));
+  entries.push_back(GenerateP4MulticastRouterInterfaceEntryByAction(
+      "Ethernet1", "0x0002", swss::MacAddress(kSrcMac1),
+      swss::MacAddress(kDstMac0), /*vlan_id=*/0, "metadata",
+      p4orch::kMulticastSetSrcMac));
+
+  EXPECT_CALL(mock_sai_my_mac_, create_my_mac(_, gSwitchId, Eq(2), _))
+      .WillOnce(DoAll(SetArgPointee<0>(kDefaultMyMacOid),
+                      Return(SAI_STATUS_SUCCESS)));
+  EXPECT_CALL(mock_sai_router_intf_, create_router_interface(_, _, _, _))
+      .WillOnce(DoAll(SetArgPointee<0>(kRifOid1), Return(SAI_STATUS_SUCCESS)))
+      .WillOnce(DoAll(SetArgPointee<0>(kRifOid2), Return(SAI_STATUS_SUCCESS)));
+  EXPECT_CALL(mock_sai_neighbor_, create_neighbor_entry(_, _, _))
+      .WillOnce(Return(SAI_STATUS_SUCCESS));
+  EXPECT_CALL(mock_sai_next_hop_, create_next_hop(_, _, _, _))
+      .WillOnce(Return(SAI_STATUS_FAILURE));
+  EXPECT_CALL(mock_sai_neighbor_, remove_neighbor_entry(_))
+      .WillOnce(Return(SAI_STATUS_SUCCESS));
+  // The RIF of the failed entry, and the one created for the entry that is
+  // not executed.
+  EXPECT_CALL(mock_sai_router_intf_, remove_router_interface(kRifOid1))
+      .WillOnce(Return(SAI_STATUS_SUCCESS));
+  EXPECT_CALL(mock_sai_router_intf_, remove_router_interface(kRifOid2))
+      .WillOnce(Return(SAI_STATUS_SUCCESS));
+
+  std::vector<ReturnCode> statuses =
+      AddMulticastRouterInterfaceEntries(entries);
+  EXPECT_EQ(statuses.size(), 2);
+  EXPECT_EQ(statuses[0].code(), StatusCode::SWSS_RC_UNKNOWN);
+  EXPECT_EQ(statuses[1].code(), StatusCode::SWSS_RC_NOT_EXECUTED);
+  EXPECT_EQ(GetMulticastRouterInterfaceEntry(
+                entries[1].multicast_router_interface_entry_key),
+            nullptr);
+}
+
 TEST_F(L3MulticastManagerTest,
        AddMulticastRouterInterfaceEntryNoActionSuccess) {
   auto entry = SetupP4MulticastRouterInterfaceNoActionEntry(
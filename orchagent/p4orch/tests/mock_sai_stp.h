@@ -38,6 +38,16 @@ public:
                              _In_ uint32_t attr_count,
                              _In_ const sai_attribute_t *attr_list));
 
+    // Mock method for creating STP ports in bulk
+    MOCK_METHOD7(create_stp_ports,
+                sai_status_t(_In_ sai_object_id_t switch_id,
+                             _In_ uint32_t object_count,
+                             _In_ const uint32_t *attr_count,
+                             _In_ const sai_attribute_t **attr_list,
+                             _In_ sai_bulk_op_error_mode_t mode,
+                             _Out_ sai_object_id_t *object_id,
+                             _Out_ sai_status_t *object_statuses));
+
     // Mock method for removing an STP port
     MOCK_METHOD1(remove_stp_port,
                 sai_status_t(_In_ sai_object_id_t stp_port_id));
@@ -94,6 +104,17 @@ sai_status_t mock_create_stp_port(_Out_ sai_object_id_t *stp_port_id,
     return mock_sai_stp->create_stp_port(stp_port_id, switch_id,attr_count, attr_list);
 }
 
+sai_status_t mock_create_stp_ports(_In_ sai_object_id_t switch_id,
+                             _In_ uint32_t object_count,
+                             _In_ const uint32_t *attr_count,
+                             _In_ const sai_attribute_t **attr_list,
+                             _In_ sai_bulk_op_error_mode_t mode,
+                             _Out_ sai_object_id_t *object_id,
+                             _Out_ sai_status_t *object_statuses)
+{
+    return mock_sai_stp->create_stp_ports(switch_id, object_count, attr_count, attr_list, mode, object_id, object_statuses);
+}
+
 sai_status_t mock_remove_stp_port(_In_ sai_object_id_t stp_port_id)
 {
     return mock_sai_stp->remove_stp_port(stp_port_id);
@@ -167,6 +167,42 @@ TEST(P4OidMapperTest, VerifyMapperTest)
 
 }
 
+TEST(P4OidMapperTest, ManyEntriesTest)
+{
+    P4OidMapper mapper;
+    auto key = [](int i) { return "{\"match/ipv4_dst\":\"10.0." + std::to_string(i) + ".0/24\"}"; };
+
+    // Enough entries for the table to grow and the erased keys to be compacted.
+    for (int i = 0; i < 10000; i++)
+    {
+        EXPECT_TRUE(mapper.setOID(SAI_OBJECT_TYPE_NEXT_HOP, key(i), static_cast<sai_object_id_t>(i + 1)));
+    }
+    for (int i = 0; i < 10000; i += 2)
+    {
+        EXPECT_TRUE(mapper.eraseOID(SAI_OBJECT_TYPE_NEXT_HOP, key(i)));
+    }
+    EXPECT_EQ(5000, mapper.getNumEntries(SAI_OBJECT_TYPE_NEXT_HOP));
+
+    for (int i = 0; i < 10000; i++)
+    {
+        sai_object_id_t oid;
+        if (i % 2 == 0)
+        {
+            EXPECT_FALSE(mapper.existsOID(SAI_OBJECT_TYPE_NEXT_HOP, key(i)));
+            continue;
+        }
+        EXPECT_TRUE(mapper.getOID(SAI_OBJECT_TYPE_NEXT_HOP, key(i), &oid));
+        EXPECT_EQ(static_cast<sai_object_id_t>(i + 1), oid);
+        EXPECT_TRUE(mapper.increaseRefCount(SAI_OBJECT_TYPE_NEXT_HOP, key(i)));
+    }
+
+    uint32_t ref_count;
+    EXPECT_TRUE(mapper.getRefCount(SAI_OBJECT_TYPE_NEXT_HOP, key(9999), &ref_count));
+    EXPECT_EQ(1, ref_count);
+    EXPECT_TRUE(mapper.setOID(SAI_OBJECT_TYPE_NEXT_HOP, key(0), kOid1));
+    EXPECT_EQ(5001, mapper.getNumEntries(SAI_OBJECT_TYPE_NEXT_HOP));
+}
+
 TEST(P4OidMapperTest, DumpEmptyStateCacheTest) {
   P4OidMapper mapper;
   std::string msg = mapper.dumpStateCache();
@@ -402,6 +402,64 @@ TEST_F(P4OrchTest, ProcessP4NotificationInOrder) {
   DoTask(consumer);
 }
 
+TEST_F(P4OrchTest, ProcessP4NotificationBulksSetRunAcrossTables) {
+  InSequence s;
+  ZmqServer zmq_server("endpoint");
+  DBConnector db("APPL_DB", 0);
+  ZmqConsumerStateTable* table =
+      new ZmqConsumerStateTable(&db, APP_P4RT_TABLE_NAME, zmq_server,
+                                TableConsumable::DEFAULT_POP_BATCH_SIZE, 0,
+                                /*dbPersistence=*/false);
+  ZmqConsumer consumer(table, nullptr, APP_P4RT_TABLE_NAME,
+                       /*orderedQueue=*/true);
+
+  std::vector<swss::FieldValueTuple> ritf_attrs;
+  ritf_attrs.push_back(
+      swss::FieldValueTuple{prependParamField(p4orch::kPort), "Ethernet1"});
+  ritf_attrs.push_back(swss::FieldValueTuple{prependParamField(p4orch::kSrcMac),
+                                             "00:01:02:03:04:05"});
+
+  // Router interface, neighbor, router interface
+  const std::string ritf_key =
+      std::string(APP_P4RT_ROUTER_INTERFACE_TABLE_NAME) + kTableKeyDelimiter +
+      "{\"match/router_interface_id\":\"intf-3/4\"}";
+  consumer.m_queue.push_back(
+      swss::KeyOpFieldsValuesTuple{ritf_key, SET_COMMAND, ritf_attrs});
+  const std::string neighbor_key = std::string(APP_P4RT_NEIGHBOR_TABLE_NAME) +
+                                   kTableKeyDelimiter +
+                                   "{\"match/router_interface_id\":\"intf-3/"
+                                   "4\",\"match/neighbor_id\":\"10.0.0.22\"}";
+  std::vector<swss::FieldValueTuple> neighbor_attrs;
+  neighbor_attrs.push_back(swss::FieldValueTuple{
+      prependParamField(p4orch::kDstMac), "00:01:02:03:04:05"});
+  consumer.m_queue.push_back(
+      swss::KeyOpFieldsValuesTuple{neighbor_key, SET_COMMAND, neighbor_attrs});
+  const std::string ritf_key_2 =
+      std::string(APP_P4RT_ROUTER_INTERFACE_TABLE_NAME) + kTableKeyDelimiter +
+      "{\"match/router_interface_id\":\"intf-3/5\"}";
+  consumer.m_queue.push_back(
+      swss::KeyOpFieldsValuesTuple{ritf_key_2, SET_COMMAND, ritf_attrs});
+
+  // Both router interfaces are created in one bulk call, the responses still
+  // follow the request order.
+  std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS, SAI_STATUS_SUCCESS};
+  EXPECT_CALL(mock_sai_router_intf_,
+              create_router_interfaces(_, Eq(2), _, _, _, _, _))
+      .WillOnce(DoAll(SetArrayArgument<6>(exp_status.begin(), exp_status.end()),
+                      Return(SAI_STATUS_SUCCESS)));
+  EXPECT_CALL(*gMockResponsePublisher,
+              publish(Eq(APP_P4RT_TABLE_NAME), Eq(ritf_key), Eq(ritf_attrs),
+                      Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+  EXPECT_CALL(
+      *gMockResponsePublisher,
+      publish(Eq(APP_P4RT_TABLE_NAME), Eq(neighbor_key), Eq(neighbor_attrs),
+              Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+  EXPECT_CALL(*gMockResponsePublisher,
+              publish(Eq(APP_P4RT_TABLE_NAME), Eq(ritf_key_2), Eq(ritf_attrs),
+                      Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+  DoTask(consumer);
+}
+
 TEST_F(P4OrchTest, ProcessP4NotificationWrongOrder) {
   InSequence s;
   ZmqServer zmq_server("endpoint");
@@ -70,6 +70,18 @@ TEST(P4OrchUtilTest, KeyGeneratorTest)
          EXPECT_EQ("dst_ipv6_ip=::2:dst_ipv6_mask=::2:src_ipv6_ip=::1:src_"
                    "ipv6_mask=::1",
                    ipv6_tunnel_term_key);
+
+    // Fields with different prefixes are ordered as generateKey() orders them.
+    EXPECT_EQ(KeyGenerator::generateKey({{"match/multicast_replica_port", "Ethernet8"},
+                                         {"param/src_mac", "00:01:02:03:04:05"}}),
+              KeyGenerator::generateMulticastRouterInterfaceRifKey("Ethernet8",
+                                                                   swss::MacAddress("00:01:02:03:04:05")));
+    EXPECT_EQ("match/dst_mac=00:01:02:03:04:05&ff:ff:ff:ff:ff:ff:match/in_port=Ethernet8:priority=2030",
+              KeyGenerator::generateL3AdmitKey(swss::MacAddress("00:01:02:03:04:05"),
+                                               swss::MacAddress("ff:ff:ff:ff:ff:ff"), "Ethernet8", 2030));
+    EXPECT_EQ("match/dst_mac=00:01:02:03:04:05&ff:ff:ff:ff:ff:ff:priority=2030",
+              KeyGenerator::generateL3AdmitKey(swss::MacAddress("00:01:02:03:04:05"),
+                                               swss::MacAddress("ff:ff:ff:ff:ff:ff"), "", 2030));
 }
 
 TEST(P4OrchUtilTest, ParseP4RTKeyTest)
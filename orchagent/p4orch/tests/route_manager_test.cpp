@@ -2719,6 +2719,40 @@ TEST_F(RouteManagerTest, DeserializeRouteEntryInDrainFails)
               Drain(/*failure_before=*/false));
 }
 
+TEST_F(RouteManagerTest, DeserializeRouteEntriesAheadInDrain)
+{
+    RouteManager::setParseThreads(2);
+
+    // The first entry fails validation, the malformed second one must not be
+    // reported for its deserialization done ahead.
+    auto key_op_fvs_1 = GenerateKeyOpFieldsValuesTuple(gVrfName, swss::IpPrefix(kIpv4Prefix), SET_COMMAND,
+                                                       p4orch::kSetNexthopId, kNexthopId1);
+    Enqueue(APP_P4RT_IPV4_TABLE_NAME, key_op_fvs_1);
+    const std::string kKeyPrefix = std::string(APP_P4RT_IPV4_TABLE_NAME) + kTableKeyDelimiter;
+    auto key_op_fvs_2 =
+        swss::KeyOpFieldsValuesTuple(kKeyPrefix + "{{{{{{{{{{{{", SET_COMMAND, std::vector<swss::FieldValueTuple>{});
+    Enqueue(APP_P4RT_IPV4_TABLE_NAME, key_op_fvs_2);
+    for (int i = 0; i < 600; i++)
+    {
+        auto prefix = swss::IpPrefix("10." + std::to_string(i / 256) + "." + std::to_string(i % 256) + ".0/24");
+        Enqueue(APP_P4RT_IPV4_TABLE_NAME, GenerateKeyOpFieldsValuesTuple(gVrfName, prefix, SET_COMMAND,
+                                                                         p4orch::kSetNexthopId, kNexthopId1));
+    }
+
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), _, _, Eq(StatusCode::SWSS_RC_NOT_EXECUTED), Eq(true)))
+        .Times(600);
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(kfvKey(key_op_fvs_2)), _,
+                                    Eq(StatusCode::SWSS_RC_NOT_EXECUTED), Eq(true)))
+        .Times(1);
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(kfvKey(key_op_fvs_1)),
+                                    FieldValueTupleArrayEq(kfvFieldsValues(key_op_fvs_1)),
+                                    Eq(StatusCode::SWSS_RC_NOT_FOUND), Eq(true)))
+        .Times(1);
+    EXPECT_EQ(StatusCode::SWSS_RC_NOT_FOUND, Drain(/*failure_before=*/false));
+
+    RouteManager::setParseThreads(0);
+}
+
 TEST_F(RouteManagerTest, ValidateRouteEntryInDrainFailsWhenVrfDoesNotExist)
 {
     p4_oid_mapper_.setOID(SAI_OBJECT_TYPE_NEXT_HOP, KeyGenerator::generateNextHopKey(kNexthopId1), kNexthopOid1);
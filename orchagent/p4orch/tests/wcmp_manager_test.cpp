@@ -1484,6 +1484,42 @@ TEST_F(WcmpManagerTest, PruneNextHopFails) {
   EXPECT_FALSE(app_db_entry.wcmp_group_members[0]->pruned);
 }
 
+TEST_F(WcmpManagerTest, FlushQueuedWatchPortUpdatesInOneCall)
+{
+    std::string port_name = "Ethernet6";
+    P4WcmpGroupEntry app_db_entry = AddWcmpGroupEntryWithWatchport(port_name, true);
+
+    std::vector<sai_object_id_t> member_oids{};
+    std::vector<uint32_t> member_weights{};
+    std::vector<sai_attribute_t> attrs;
+    sai_attribute_t attr;
+    attr.id = SAI_NEXT_HOP_GROUP_ATTR_NEXT_HOP_LIST;
+    attr.value.objlist.count = static_cast<uint32_t>(member_oids.size());
+    attr.value.objlist.list = member_oids.data();
+    attrs.push_back(attr);
+    attr.id = SAI_NEXT_HOP_GROUP_ATTR_NEXT_HOP_MEMBER_WEIGHT_LIST;
+    attr.value.u32list.count = static_cast<uint32_t>(member_weights.size());
+    attr.value.u32list.list = member_weights.data();
+    attrs.push_back(attr);
+
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS, SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_next_hop_group_,
+                set_next_hop_groups_attribute(
+                    Eq(2), ArrayEq(std::vector<sai_object_id_t>{kWcmpGroupOid1, kWcmpGroupOid1}),
+                    AttrArrayEq(attrs), _, _))
+        .WillOnce(DoAll(SetArrayArgument<4>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
+
+    // Nothing is programmed until the flush, a port without members adds nothing
+    wcmp_group_manager_->queueWatchPortUpdate(port_name, true);
+    wcmp_group_manager_->queueWatchPortUpdate("Ethernet7", true);
+    EXPECT_TRUE(app_db_entry.wcmp_group_members[0]->pruned);
+    wcmp_group_manager_->flushWatchPortUpdates();
+    EXPECT_TRUE(app_db_entry.wcmp_group_members[0]->pruned);
+
+    // Nothing left to flush
+    wcmp_group_manager_->flushWatchPortUpdates();
+}
+
 TEST_F(WcmpManagerTest, RestorePrunedNextHopSucceeds)
 {
     // Add member with operationally down watch port. Since associated watchport
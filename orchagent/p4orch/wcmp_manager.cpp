@@ -71,23 +71,6 @@ std::vector<sai_attribute_t> prepareSaiGroupAttrs(
   return attrs;
 }
 
-ReturnCode updateGroup(P4WcmpGroupEntry& wcmp_group) {
-  auto attrs = prepareSaiGroupAttrs(wcmp_group, /*update=*/true);
-  std::vector<sai_object_id_t> oids(attrs.size());
-  std::vector<sai_status_t> status(attrs.size());
-  for (size_t i = 0; i < attrs.size(); ++i) {
-    oids[i] = wcmp_group.wcmp_group_oid;
-  }
-  // This SAI operation is assumed to be atomic.
-  CHECK_ERROR_AND_LOG_AND_RETURN(
-      sai_next_hop_group_api->set_next_hop_groups_attribute(
-          uint32_t(attrs.size()), oids.data(), attrs.data(),
-          SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, status.data()),
-      "Failed to update next hop group  "
-          << QuotedVar(wcmp_group.wcmp_group_id));
-  return ReturnCode();
-}
-
 }  // namespace
 
 ReturnCode WcmpManager::validateWcmpGroupEntry(
@@ -498,6 +481,13 @@ ReturnCode WcmpManager::processEntries(
 void WcmpManager::updateWatchPort(const std::string& port, bool prune) {
   SWSS_LOG_ENTER();
 
+  queueWatchPortUpdate(port, prune);
+  flushWatchPortUpdates();
+}
+
+void WcmpManager::queueWatchPortUpdate(const std::string& port, bool prune) {
+  SWSS_LOG_ENTER();
+
   // Get list of WCMP group members associated with the watch_port
 
   if (port_name_to_wcmp_group_member_map.find(port) !=
@@ -510,26 +500,75 @@ void WcmpManager::updateWatchPort(const std::string& port, bool prune) {
                                     QuotedVar(member->wcmp_group_id) +
                                     " in updateWatchPort");
         } else {
-          const std::string update = prune ? "prune" : "restore";
           member->pruned = prune;
-          auto status = updateGroup(*wcmp_group);
-          if (!status.ok()) {
-            member->pruned = !member->pruned;
-            SWSS_RAISE_CRITICAL_STATE(
-                "Failed to " + update + " member in group " +
-                QuotedVar(member->wcmp_group_id) +
-                " in updateWatchPort: " + status.message());
-          } else {
-            SWSS_LOG_NOTICE("%s member %s from group %s", update.c_str(),
-                            member->next_hop_id.c_str(),
-                            member->wcmp_group_id.c_str());
-          }
+          m_watchPortUpdates[member->wcmp_group_id].push_back(member);
         }
       }
     }
   }
 }
 
+void WcmpManager::flushWatchPortUpdates() {
+  SWSS_LOG_ENTER();
+
+  if (m_watchPortUpdates.empty()) {
+    return;
+  }
+
+  // Each group update has two SAI attrs:
+  // SAI_NEXT_HOP_GROUP_ATTR_NEXT_HOP_LIST and
+  // SAI_NEXT_HOP_GROUP_ATTR_NEXT_HOP_MEMBER_WEIGHT_LIST.
+  std::vector<P4WcmpGroupEntry*> groups;
+  std::vector<sai_attribute_t> sai_attrs;
+  std::vector<sai_object_id_t> oids;
+  for (const auto& it : m_watchPortUpdates) {
+    auto* wcmp_group = getWcmpGroupEntry(it.first);
+    groups.push_back(wcmp_group);
+    for (const auto& attr :
+         prepareSaiGroupAttrs(*wcmp_group, /*update=*/true)) {
+      sai_attrs.push_back(attr);
+      oids.push_back(wcmp_group->wcmp_group_oid);
+    }
+  }
+  std::vector<sai_status_t> object_statuses(sai_attrs.size(),
+                                            SAI_STATUS_NOT_EXECUTED);
+  // This SAI operation is assumed to be atomic for each group.
+  sai_next_hop_group_api->set_next_hop_groups_attribute(
+      static_cast<uint32_t>(sai_attrs.size()), oids.data(), sai_attrs.data(),
+      SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, object_statuses.data());
+
+  size_t i = 0;
+  for (const auto& it : m_watchPortUpdates) {
+    auto* wcmp_group = groups[i];
+    sai_status_t status = object_statuses[2 * i];
+    if (status == SAI_STATUS_SUCCESS) {
+      status = object_statuses[2 * i + 1];
+    }
+    i++;
+
+    if (status != SAI_STATUS_SUCCESS) {
+      for (auto& member : it.second) {
+        member->pruned = !member->pruned;
+      }
+      // Back to the member lists the group still has
+      prepareSaiGroupAttrs(*wcmp_group, /*update=*/true);
+      ReturnCode rc = ReturnCode(status) << "Failed to update next hop group "
+                                         << QuotedVar(it.first);
+      SWSS_RAISE_CRITICAL_STATE("Failed to update members in group " +
+                                QuotedVar(it.first) +
+                                " in updateWatchPort: " + rc.message());
+      continue;
+    }
+
+    for (const auto& member : it.second) {
+      SWSS_LOG_NOTICE("%s member %s from group %s",
+                      member->pruned ? "prune" : "restore",
+                      member->next_hop_id.c_str(), it.first.c_str());
+    }
+  }
+  m_watchPortUpdates.clear();
+}
+
 bool WcmpManager::getPortOperStatusFromMap(const std::string &port, sai_port_oper_status_t *oper_status)
 {
     if (port_oper_status_map.find(port) != port_oper_status_map.end())
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -92,6 +94,13 @@ class WcmpManager : public ObjectManagerInterface
     // Prunes or restores next hop members.
     void updateWatchPort(const std::string& port, bool prune);
 
+    // Prunes or restores the next hop members of the port, the groups they
+    // are in are updated by flushWatchPortUpdates().
+    void queueWatchPortUpdate(const std::string& port, bool prune);
+
+    // Updates the groups of all the queued watch port changes in one bulk call.
+    void flushWatchPortUpdates();
+
     // Inserts into/updates port_oper_status_map
     void updatePortOperStatusMap(const std::string &port, const sai_port_oper_status_t &status);
 
@@ -162,6 +171,9 @@ class WcmpManager : public ObjectManagerInterface
 
     // Maps port name to oper-status
     std::unordered_map<std::string, sai_port_oper_status_t> port_oper_status_map;
+    // Maps wcmp_group_id to the members pruned or restored since the last
+    // flushWatchPortUpdates()
+    std::map<std::string, std::vector<std::shared_ptr<P4WcmpGroupMemberEntry>>> m_watchPortUpdates;
 
     // Owners of pointers below must outlive this class's instance.
     P4OidMapper *m_p4OidMapper;
@@ -6,6 +6,7 @@
 #include <unordered_set>
 #include <exception>
 #include <string>
+#include <vector>
 
 #include "pbhschema.h"
 #include "ipaddress.h"
@@ -273,6 +274,23 @@ bool PbhHelper::getPbhHashField(PbhHashField &hashField, const std::string &key)
     return this->getPbhObj(hashField, key);
 }
 
+std::vector<PbhRule> PbhHelper::getPbhRulesByHash(const std::string &key) const
+{
+    std::vector<PbhRule> ruleList;
+
+    for (const auto &cit : this->ruleMap)
+    {
+        const auto &rule = cit.second;
+
+        if (rule.hash.is_set && rule.hash.value == key)
+        {
+            ruleList.push_back(rule);
+        }
+    }
+
+    return ruleList;
+}
+
 template<>
 auto PbhHelper::getPbhObjMap() -> std::unordered_map<std::string, PbhTable>&
 {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "pbhcnt.h"
 
 class PbhHelper final
@@ -22,6 +24,8 @@ public:
     bool getPbhHash(PbhHash &hash, const std::string &key) const;
     bool getPbhHashField(PbhHashField &hashField, const std::string &key) const;
 
+    std::vector<PbhRule> getPbhRulesByHash(const std::string &key) const;
+
     bool addPbhTable(const PbhTable &table);
     bool updatePbhTable(const PbhTable &table);
     bool removePbhTable(const std::string &key);
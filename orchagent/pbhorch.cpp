@@ -476,20 +476,10 @@ void PbhOrch::deployPbhTableRemoveTasks()
 
 // PBH rule -----------------------------------------------------------------------------------------------------------
 
-bool PbhOrch::createPbhRule(const PbhRule &rule)
+bool PbhOrch::buildPbhAclRule(std::shared_ptr<AclRulePbh> &pbhRule, const PbhRule &rule) const
 {
     SWSS_LOG_ENTER();
 
-    PbhRule rObj;
-
-    if (this->pbhHlpr.getPbhRule(rObj, rule.key))
-    {
-        SWSS_LOG_ERROR("Failed to create PBH rule(%s) in SAI: object already exists", rule.key.c_str());
-        return false;
-    }
-
-    std::shared_ptr<AclRulePbh> pbhRule;
-
     if (rule.flow_counter.is_set)
     {
         pbhRule = std::make_shared<AclRulePbh>(this->aclOrch, rule.name, rule.table, rule.flow_counter.value);
@@ -630,11 +620,12 @@ bool PbhOrch::createPbhRule(const PbhRule &rule)
         return false;
     }
 
-    if (!this->aclOrch->addAclRule(pbhRule, rule.table))
-    {
-        SWSS_LOG_ERROR("Failed to create PBH rule(%s) in SAI", rule.key.c_str());
-        return false;
-    }
+    return true;
+}
+
+bool PbhOrch::onPbhRuleCreated(const PbhRule &rule)
+{
+    SWSS_LOG_ENTER();
 
     if (!this->pbhHlpr.addPbhRule(rule))
     {
@@ -695,143 +686,8 @@ bool PbhOrch::updatePbhRule(const PbhRule &rule)
 
     std::shared_ptr<AclRulePbh> pbhRule;
 
-    if (rule.flow_counter.is_set)
-    {
-        pbhRule = std::make_shared<AclRulePbh>(this->aclOrch, rule.name, rule.table, rule.flow_counter.value);
-    }
-    else
-    {
-        pbhRule = std::make_shared<AclRulePbh>(this->aclOrch, rule.name, rule.table);
-    }
-
-    if (rule.priority.is_set)
-    {
-        if (!pbhRule->validateAddPriority(rule.priority.value))
-        {
-            SWSS_LOG_ERROR("Failed to configure PBH rule(%s) priority", rule.key.c_str());
-            return false;
-        }
-    }
-
-    if (rule.gre_key.is_set)
-    {
-        sai_attribute_t attr;
-
-        attr.id = SAI_ACL_ENTRY_ATTR_FIELD_GRE_KEY;
-        attr.value.aclfield.enable = true;
-        attr.value.aclfield.data.u32 = rule.gre_key.value;
-        attr.value.aclfield.mask.u32 = rule.gre_key.mask;
-
-        if (!pbhRule->validateAddMatch(attr))
-        {
-            SWSS_LOG_ERROR("Failed to configure PBH rule(%s) match: GRE_KEY", rule.key.c_str());
-            return false;
-        }
-    }
-
-    if (rule.ether_type.is_set)
-    {
-        sai_attribute_t attr;
-
-        attr.id = SAI_ACL_ENTRY_ATTR_FIELD_ETHER_TYPE;
-        attr.value.aclfield.enable = true;
-        attr.value.aclfield.data.u16 = rule.ether_type.value;
-        attr.value.aclfield.mask.u16 = rule.ether_type.mask;
-
-        if (!pbhRule->validateAddMatch(attr))
-        {
-            SWSS_LOG_ERROR("Failed to configure PBH rule(%s) match: ETHER_TYPE", rule.key.c_str());
-            return false;
-        }
-    }
-
-    if (rule.ip_protocol.is_set)
-    {
-        sai_attribute_t attr;
-
-        attr.id = SAI_ACL_ENTRY_ATTR_FIELD_IP_PROTOCOL;
-        attr.value.aclfield.enable = true;
-        attr.value.aclfield.data.u8 = rule.ip_protocol.value;
-        attr.value.aclfield.mask.u8 = rule.ip_protocol.mask;
-
-        if (!pbhRule->validateAddMatch(attr))
-        {
-            SWSS_LOG_ERROR("Failed to configure PBH rule(%s) match: IP_PROTOCOL", rule.key.c_str());
-            return false;
-        }
-    }
-
-    if (rule.ipv6_next_header.is_set)
+    if (!this->buildPbhAclRule(pbhRule, rule))
     {
-        sai_attribute_t attr;
-
-        attr.id = SAI_ACL_ENTRY_ATTR_FIELD_IPV6_NEXT_HEADER;
-        attr.value.aclfield.enable = true;
-        attr.value.aclfield.data.u8 = rule.ipv6_next_header.value;
-        attr.value.aclfield.mask.u8 = rule.ipv6_next_header.mask;
-
-        if (!pbhRule->validateAddMatch(attr))
-        {
-            SWSS_LOG_ERROR("Failed to configure PBH rule(%s) match: IPV6_NEXT_HEADER", rule.key.c_str());
-            return false;
-        }
-    }
-
-    if (rule.l4_dst_port.is_set)
-    {
-        sai_attribute_t attr;
-
-        attr.id = SAI_ACL_ENTRY_ATTR_FIELD_L4_DST_PORT;
-        attr.value.aclfield.enable = true;
-        attr.value.aclfield.data.u16 = rule.l4_dst_port.value;
-        attr.value.aclfield.mask.u16 = rule.l4_dst_port.mask;
-
-        if (!pbhRule->validateAddMatch(attr))
-        {
-            SWSS_LOG_ERROR("Failed to configure PBH rule(%s) match: L4_DST_PORT", rule.key.c_str());
-            return false;
-        }
-    }
-
-    if (rule.inner_ether_type.is_set)
-    {
-        sai_attribute_t attr;
-
-        attr.id = SAI_ACL_ENTRY_ATTR_FIELD_INNER_ETHER_TYPE;
-        attr.value.aclfield.enable = true;
-        attr.value.aclfield.data.u16 = rule.inner_ether_type.value;
-        attr.value.aclfield.mask.u16 = rule.inner_ether_type.mask;
-
-        if (!pbhRule->validateAddMatch(attr))
-        {
-            SWSS_LOG_ERROR("Failed to configure PBH rule(%s) match: INNER_ETHER_TYPE", rule.key.c_str());
-            return false;
-        }
-    }
-
-    if (rule.hash.is_set && rule.packet_action.is_set)
-    {
-        PbhHash hObj;
-
-        if (this->pbhHlpr.getPbhHash(hObj, rule.hash.value))
-        {
-            sai_attribute_t attr;
-
-            attr.id = rule.packet_action.value;
-            attr.value.aclaction.enable = true;
-            attr.value.aclaction.parameter.oid = hObj.getOid();
-
-            if (!pbhRule->validateAddAction(attr))
-            {
-                SWSS_LOG_ERROR("Failed to configure PBH rule(%s) action", rule.key.c_str());
-                return false;
-            }
-        }
-    }
-
-    if (!pbhRule->validate())
-    {
-        SWSS_LOG_ERROR("Failed to validate PBH rule(%s)", rule.key.c_str());
         return false;
     }
 
@@ -891,6 +747,47 @@ bool PbhOrch::updatePbhRule(const PbhRule &rule)
     return true;
 }
 
+bool PbhOrch::updatePbhRuleHash(const PbhRule &rule)
+{
+    SWSS_LOG_ENTER();
+
+    std::shared_ptr<AclRulePbh> pbhRule;
+
+    if (!this->buildPbhAclRule(pbhRule, rule))
+    {
+        return false;
+    }
+
+    // Mellanox W/A
+    if (this->pbhCap.getAsicVendor() == PbhAsicVendor::MELLANOX)
+    {
+        auto pbhRulePtr = dynamic_cast<AclRulePbh*>(this->aclOrch->getAclRule(rule.table, rule.name));
+
+        if (pbhRulePtr == nullptr)
+        {
+            SWSS_LOG_ERROR("Failed to update PBH rule(%s) hash in SAI: invalid object type", rule.key.c_str());
+            return false;
+        }
+
+        if (!pbhRulePtr->disableAction())
+        {
+            SWSS_LOG_ERROR("Failed to disable PBH rule(%s) action", rule.key.c_str());
+            return false;
+        }
+    }
+
+    // Only the action referring to the hash differs, it is the one attribute set
+    if (!this->aclOrch->updateAclRule(pbhRule))
+    {
+        SWSS_LOG_ERROR("Failed to update PBH rule(%s) hash in SAI", rule.key.c_str());
+        return false;
+    }
+
+    SWSS_LOG_NOTICE("Updated PBH rule(%s) hash in SAI", rule.key.c_str());
+
+    return true;
+}
+
 bool PbhOrch::removePbhRule(const PbhRule &rule)
 {
     SWSS_LOG_ENTER();
@@ -933,6 +830,9 @@ void PbhOrch::deployPbhRuleSetupTasks()
     auto &map = this->pbhHlpr.ruleTask.pendingSetupMap;
     auto it = map.begin();
 
+    std::vector<PbhRule> ruleList;
+    std::vector<std::shared_ptr<AclRule>> pbhRuleList;
+
     while (it != map.end())
     {
         auto &key = it->first;
@@ -949,10 +849,17 @@ void PbhOrch::deployPbhRuleSetupTasks()
 
         if (!this->pbhHlpr.getPbhRule(rObj, key))
         {
-            if (!this->createPbhRule(rule))
+            std::shared_ptr<AclRulePbh> pbhRule;
+
+            if (!this->buildPbhAclRule(pbhRule, rule))
             {
                 SWSS_LOG_ERROR("Failed to create PBH rule(%s): ASIC and CONFIG DB are diverged", key.c_str());
             }
+            else
+            {
+                ruleList.push_back(rule);
+                pbhRuleList.push_back(pbhRule);
+            }
         }
         else
         {
@@ -964,6 +871,32 @@ void PbhOrch::deployPbhRuleSetupTasks()
 
         it = map.erase(it);
     }
+
+    if (pbhRuleList.empty())
+    {
+        return;
+    }
+
+    // New rules are created together, through the ACL bulkers when enabled
+    std::vector<bool> results;
+
+    this->aclOrch->addAclRules(pbhRuleList, results);
+
+    for (std::size_t i = 0; i < ruleList.size(); i++)
+    {
+        const auto &rule = ruleList.at(i);
+
+        if (!results.at(i))
+        {
+            SWSS_LOG_ERROR("Failed to create PBH rule(%s): ASIC and CONFIG DB are diverged", rule.key.c_str());
+            continue;
+        }
+
+        if (!this->onPbhRuleCreated(rule))
+        {
+            SWSS_LOG_ERROR("Failed to create PBH rule(%s): ASIC and CONFIG DB are diverged", rule.key.c_str());
+        }
+    }
 }
 
 void PbhOrch::deployPbhRuleRemoveTasks()
@@ -1000,6 +933,38 @@ void PbhOrch::deployPbhRuleRemoveTasks()
 
 // PBH hash -----------------------------------------------------------------------------------------------------------
 
+std::string PbhOrch::getPbhHashContent(std::vector<sai_object_id_t> hashFieldOidList) const
+{
+    // Hash fields of the same contents share an object, the sorted list identifies a hash
+    std::sort(hashFieldOidList.begin(), hashFieldOidList.end());
+
+    std::string content;
+
+    for (const auto &cit : hashFieldOidList)
+    {
+        content += std::to_string(cit) + ",";
+    }
+
+    return content;
+}
+
+std::string PbhOrch::getPbhHashContent(const PbhHash &hash) const
+{
+    std::vector<sai_object_id_t> hashFieldOidList;
+
+    for (const auto &cit : hash.hash_field_list.value)
+    {
+        PbhHashField hfObj;
+
+        if (this->pbhHlpr.getPbhHashField(hfObj, cit))
+        {
+            hashFieldOidList.push_back(hfObj.getOid());
+        }
+    }
+
+    return this->getPbhHashContent(hashFieldOidList);
+}
+
 bool PbhOrch::createPbhHash(const PbhHash &hash)
 {
     SWSS_LOG_ENTER();
@@ -1048,18 +1013,30 @@ bool PbhOrch::createPbhHash(const PbhHash &hash)
     attr.value.objlist.list = hashFieldOidList.data();
     attrList.push_back(attr);
 
-    sai_status_t status;
-    sai_object_id_t hashOid;
+    const auto content = this->getPbhHashContent(hashFieldOidList);
+    auto &shared = this->sharedHashMap[content];
 
-    status = sai_hash_api->create_hash(&hashOid, gSwitchId, static_cast<sai_uint32_t>(attrList.size()), attrList.data());
-    if (status != SAI_STATUS_SUCCESS)
+    if (shared.oid == SAI_NULL_OBJECT_ID)
     {
-        SWSS_LOG_ERROR("Failed to create PBH hash(%s) in SAI", hash.key.c_str());
-        return false;
+        sai_status_t status;
+
+        status = sai_hash_api->create_hash(&shared.oid, gSwitchId, static_cast<sai_uint32_t>(attrList.size()), attrList.data());
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create PBH hash(%s) in SAI", hash.key.c_str());
+            this->sharedHashMap.erase(content);
+            return false;
+        }
+    }
+    else
+    {
+        SWSS_LOG_INFO("Reusing SAI hash of identical hash fields for PBH hash(%s)", hash.key.c_str());
     }
 
+    shared.refCount++;
+
     hObj = hash;
-    hObj.setOid(hashOid);
+    hObj.setOid(shared.oid);
 
     if (!this->pbhHlpr.addPbhHash(hObj))
     {
@@ -1152,13 +1129,58 @@ bool PbhOrch::updatePbhHash(const PbhHash &hash)
     attr.value.objlist.count = static_cast<sai_uint32_t>(hashFieldOidList.size());
     attr.value.objlist.list = hashFieldOidList.data();
 
-    sai_status_t status;
+    const auto curContent = this->getPbhHashContent(hObj);
+    const auto newContent = this->getPbhHashContent(hashFieldOidList);
+    const auto curOid = hObj.getOid();
 
-    status = sai_hash_api->set_hash_attribute(hObj.getOid(), &attr);
-    if (status != SAI_STATUS_SUCCESS)
+    if (newContent != curContent)
     {
-        SWSS_LOG_ERROR("Failed to update PBH hash(%s) in SAI", hash.key.c_str());
-        return false;
+        const auto &curIt = this->sharedHashMap.find(curContent);
+        const auto &newIt = this->sharedHashMap.find(newContent);
+
+        if (newIt == this->sharedHashMap.end() && (curIt == this->sharedHashMap.end() || curIt->second.refCount == 1))
+        {
+            // Nothing else uses the object, it is set to the new hash fields in place
+            sai_status_t status;
+
+            status = sai_hash_api->set_hash_attribute(curOid, &attr);
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to update PBH hash(%s) in SAI", hash.key.c_str());
+                return false;
+            }
+
+            if (curIt != this->sharedHashMap.end())
+            {
+                this->sharedHashMap.erase(curIt);
+            }
+
+            this->sharedHashMap[newContent] = { curOid, 1 };
+        }
+        else
+        {
+            // The hash moves to the object of its new hash fields, its rules are pointed to it below
+            if (newIt != this->sharedHashMap.end())
+            {
+                newIt->second.refCount++;
+                hObj.setOid(newIt->second.oid);
+            }
+            else
+            {
+                sai_status_t status;
+                sai_object_id_t hashOid;
+
+                status = sai_hash_api->create_hash(&hashOid, gSwitchId, 1, &attr);
+                if (status != SAI_STATUS_SUCCESS)
+                {
+                    SWSS_LOG_ERROR("Failed to update PBH hash(%s) in SAI", hash.key.c_str());
+                    return false;
+                }
+
+                this->sharedHashMap[newContent] = { hashOid, 1 };
+                hObj.setOid(hashOid);
+            }
+        }
     }
 
     if (!this->pbhHlpr.decRefCount(hObj))
@@ -1181,6 +1203,39 @@ bool PbhOrch::updatePbhHash(const PbhHash &hash)
         return false;
     }
 
+    if (hObj.getOid() != curOid)
+    {
+        for (const auto &cit : this->pbhHlpr.getPbhRulesByHash(hObj.key))
+        {
+            if (cit.packet_action.is_set && !this->updatePbhRuleHash(cit))
+            {
+                SWSS_LOG_ERROR("Failed to update PBH rule(%s): ASIC and CONFIG DB are diverged", cit.key.c_str());
+            }
+        }
+
+        const auto &curIt = this->sharedHashMap.find(curContent);
+
+        if (curIt != this->sharedHashMap.end() && curIt->second.refCount > 1)
+        {
+            curIt->second.refCount--;
+        }
+        else
+        {
+            sai_status_t status;
+
+            status = sai_hash_api->remove_hash(curOid);
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to remove PBH hash(%s) previous object from SAI", hObj.key.c_str());
+            }
+
+            if (curIt != this->sharedHashMap.end())
+            {
+                this->sharedHashMap.erase(curIt);
+            }
+        }
+    }
+
     SWSS_LOG_NOTICE("Updated PBH hash(%s) in SAI", hObj.key.c_str());
 
     return true;
@@ -1198,13 +1253,28 @@ bool PbhOrch::removePbhHash(const PbhHash &hash)
         return false;
     }
 
-    sai_status_t status;
+    const auto content = this->getPbhHashContent(hObj);
+    const auto &cit = this->sharedHashMap.find(content);
 
-    status = sai_hash_api->remove_hash(hObj.getOid());
-    if (status != SAI_STATUS_SUCCESS)
+    if (cit != this->sharedHashMap.end() && cit->second.refCount > 1)
     {
-        SWSS_LOG_ERROR("Failed to remove PBH hash(%s) from SAI", hObj.key.c_str());
-        return false;
+        cit->second.refCount--;
+    }
+    else
+    {
+        sai_status_t status;
+
+        status = sai_hash_api->remove_hash(hObj.getOid());
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove PBH hash(%s) from SAI", hObj.key.c_str());
+            return false;
+        }
+
+        if (cit != this->sharedHashMap.end())
+        {
+            this->sharedHashMap.erase(cit);
+        }
     }
 
     if (!this->pbhHlpr.removePbhHash(hObj.key))
@@ -1305,6 +1375,19 @@ void PbhOrch::deployPbhHashRemoveTasks()
 
 // PBH hash field -----------------------------------------------------------------------------------------------------
 
+std::string PbhOrch::getPbhHashFieldContent(const PbhHashField &hashField) const
+{
+    std::string content;
+
+    content += hashField.hash_field.is_set ? std::to_string(hashField.hash_field.value) : "";
+    content += "|";
+    content += hashField.ip_mask.is_set ? hashField.ip_mask.value.to_string() : "";
+    content += "|";
+    content += hashField.sequence_id.is_set ? std::to_string(hashField.sequence_id.value) : "";
+
+    return content;
+}
+
 bool PbhOrch::createPbhHashField(const PbhHashField &hashField)
 {
     SWSS_LOG_ENTER();
@@ -1363,18 +1446,30 @@ bool PbhOrch::createPbhHashField(const PbhHashField &hashField)
         return false;
     }
 
-    sai_status_t status;
-    sai_object_id_t hfOid;
+    const auto content = this->getPbhHashFieldContent(hashField);
+    auto &shared = this->sharedHashFieldMap[content];
 
-    status = sai_hash_api->create_fine_grained_hash_field(&hfOid, gSwitchId, static_cast<sai_uint32_t>(attrList.size()), attrList.data());
-    if (status != SAI_STATUS_SUCCESS)
+    if (shared.oid == SAI_NULL_OBJECT_ID)
     {
-        SWSS_LOG_ERROR("Failed to create PBH hash field(%s) in SAI", hashField.key.c_str());
-        return false;
+        sai_status_t status;
+
+        status = sai_hash_api->create_fine_grained_hash_field(&shared.oid, gSwitchId, static_cast<sai_uint32_t>(attrList.size()), attrList.data());
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create PBH hash field(%s) in SAI", hashField.key.c_str());
+            this->sharedHashFieldMap.erase(content);
+            return false;
+        }
+    }
+    else
+    {
+        SWSS_LOG_INFO("Reusing SAI hash field of identical contents for PBH hash field(%s)", hashField.key.c_str());
     }
 
+    shared.refCount++;
+
     hfObj = hashField;
-    hfObj.setOid(hfOid);
+    hfObj.setOid(shared.oid);
 
     if (!this->pbhHlpr.addPbhHashField(hfObj))
     {
@@ -1442,13 +1537,28 @@ bool PbhOrch::removePbhHashField(const PbhHashField &hashField)
         return false;
     }
 
-    sai_status_t status;
+    const auto content = this->getPbhHashFieldContent(hfObj);
+    const auto &cit = this->sharedHashFieldMap.find(content);
 
-    status = sai_hash_api->remove_fine_grained_hash_field(hfObj.getOid());
-    if (status != SAI_STATUS_SUCCESS)
+    if (cit != this->sharedHashFieldMap.end() && cit->second.refCount > 1)
     {
-        SWSS_LOG_ERROR("Failed to remove PBH hash field(%s) from SAI", hfObj.key.c_str());
-        return false;
+        cit->second.refCount--;
+    }
+    else
+    {
+        sai_status_t status;
+
+        status = sai_hash_api->remove_fine_grained_hash_field(hfObj.getOid());
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove PBH hash field(%s) from SAI", hfObj.key.c_str());
+            return false;
+        }
+
+        if (cit != this->sharedHashFieldMap.end())
+        {
+            this->sharedHashFieldMap.erase(cit);
+        }
     }
 
     if (!this->pbhHlpr.removePbhHashField(hfObj.key))
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "orch.h"
@@ -49,10 +53,17 @@ private:
     bool updatePbhTable(const PbhTable &table);
     bool removePbhTable(const PbhTable &table);
 
-    bool createPbhRule(const PbhRule &rule);
+    bool buildPbhAclRule(std::shared_ptr<AclRulePbh> &pbhRule, const PbhRule &rule) const;
+    bool updatePbhRuleHash(const PbhRule &rule);
+
+    bool onPbhRuleCreated(const PbhRule &rule);
     bool updatePbhRule(const PbhRule &rule);
     bool removePbhRule(const PbhRule &rule);
 
+    std::string getPbhHashContent(std::vector<sai_object_id_t> hashFieldOidList) const;
+    std::string getPbhHashContent(const PbhHash &hash) const;
+    std::string getPbhHashFieldContent(const PbhHashField &hashField) const;
+
     bool createPbhHash(const PbhHash &hash);
     bool updatePbhHash(const PbhHash &hash);
     bool removePbhHash(const PbhHash &hash);
@@ -86,4 +97,14 @@ private:
 
     PbhHelper pbhHlpr;
     PbhCapabilities pbhCap;
+
+    struct PbhSharedObject
+    {
+        sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+        std::uint64_t refCount = 0;
+    };
+
+    // SAI hash and hash field objects by content, shared by the PBH objects configured alike
+    std::unordered_map<std::string, PbhSharedObject> sharedHashMap;
+    std::unordered_map<std::string, PbhSharedObject> sharedHashFieldMap;
 };
@@ -31,6 +31,8 @@ extern sai_port_api_t *sai_port_api;
 extern sai_queue_api_t *sai_queue_api;
 extern sai_buffer_api_t *sai_buffer_api;
 
+bool PfcWdActionHandler::m_bulk = false;
+
 PfcWdActionHandler::PfcWdActionHandler(sai_object_id_t port, sai_object_id_t queue,
         uint8_t queueId, shared_ptr<Table> countersTable):
     m_port(port),
@@ -47,6 +49,30 @@ PfcWdActionHandler::~PfcWdActionHandler(void)
 
 }
 
+void PfcWdActionHandler::beginBulk(void)
+{
+    SWSS_LOG_ENTER();
+
+    m_bulk = true;
+}
+
+void PfcWdActionHandler::endBulk(void)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_bulk)
+    {
+        return;
+    }
+
+    m_bulk = false;
+
+    // Same order as the constructors: PFC first, then the drop action
+    PfcWdLossyHandler::flushBulk();
+    PfcWdZeroBufferHandler::flushBulk();
+    PfcWdAclHandler::flushBulk();
+}
+
 void PfcWdActionHandler::initCounters(void)
 {
     SWSS_LOG_ENTER();
@@ -325,21 +351,18 @@ PfcWdAclHandler::PfcWdAclHandler(sai_object_id_t port, sai_object_id_t queue,
     {
         // First time of handling PFC for this queue, create ACL table, and bind
         createPfcAclTable(port, m_strIngressTable, true);
-        shared_ptr<AclRulePacket> newRule = make_shared<AclRulePacket>(gAclOrch, m_strRule, m_strIngressTable);
-        createPfcAclRule(newRule, queueId, m_strIngressTable, port);
+    }
+
+    if (isBulk())
+    {
+        // Add all the ports stormed on this queue to the rule at once
+        auto &pending = m_bulkIngressPorts[queueId];
+        pending.first = this;
+        pending.second.push_back(port);
     }
     else
     {
-        AclRule* rule = gAclOrch->getAclRule(m_strIngressTable, m_strRule);
-        if (rule == nullptr)
-        {
-            shared_ptr<AclRulePacket> newRule = make_shared<AclRulePacket>(gAclOrch, m_strRule, m_strIngressTable);
-            createPfcAclRule(newRule, queueId, m_strIngressTable, port);
-        } 
-        else 
-        {
-            gAclOrch->updateAclRule(m_strIngressTable, m_strRule, MATCH_IN_PORTS, &port, RULE_OPER_ADD);
-        }
+        addPfcAclRulePorts({ port });
     }
 
     // Egress table/rule creation
@@ -353,13 +376,13 @@ PfcWdAclHandler::PfcWdAclHandler(sai_object_id_t port, sai_object_id_t queue,
 
     if (shared_egress_acl_table)
     {
-        Port p;
-        if (!gPortsOrch->getPort(port, p))
+        const Port *p = gPortsOrch->findPort(port);
+        if (!p)
         {
             SWSS_LOG_ERROR("Failed to get port structure from port oid 0x%" PRIx64, port);
             return;
         }
-        m_strEgressRule = "Egress_Rule_PfcWdAclHandler_" + p.m_alias + "_" + queuestr;
+        m_strEgressRule = "Egress_Rule_PfcWdAclHandler_" + p->m_alias + "_" + queuestr;
         m_strEgressTable = "EgressTable_PfcWdAclHandler";
         found = m_aclTables.find(m_strEgressTable);
         if (found == m_aclTables.end())
@@ -367,7 +390,7 @@ PfcWdAclHandler::PfcWdAclHandler(sai_object_id_t port, sai_object_id_t queue,
             // First time of handling PFC, create ACL table and also ACL rule.
             createPfcAclTable(port, m_strEgressTable, false);
             shared_ptr<AclRulePacket> newRule = make_shared<AclRulePacket>(gAclOrch, m_strEgressRule, m_strEgressTable);
-            createPfcAclRule(newRule, queueId, m_strEgressTable, port);
+            createPfcAclRule(newRule, queueId, m_strEgressTable, { port });
         }
         else
         {
@@ -376,7 +399,7 @@ PfcWdAclHandler::PfcWdAclHandler(sai_object_id_t port, sai_object_id_t queue,
             if (rule == nullptr)
             {
                 shared_ptr<AclRulePacket> newRule = make_shared<AclRulePacket>(gAclOrch, m_strEgressRule, m_strEgressTable);
-                createPfcAclRule(newRule, queueId, m_strEgressTable, port);
+                createPfcAclRule(newRule, queueId, m_strEgressTable, { port });
             }
         }
     }
@@ -389,7 +412,7 @@ PfcWdAclHandler::PfcWdAclHandler(sai_object_id_t port, sai_object_id_t queue,
             // First time of handling PFC for this queue, create ACL table, and bind
             createPfcAclTable(port, m_strEgressTable, false);
             shared_ptr<AclRulePacket> newRule = make_shared<AclRulePacket>(gAclOrch, m_strRule, m_strEgressTable);
-            createPfcAclRule(newRule, queueId, m_strEgressTable, port);
+            createPfcAclRule(newRule, queueId, m_strEgressTable, { port });
         }
         else
         {
@@ -437,6 +460,34 @@ PfcWdAclHandler::~PfcWdAclHandler(void)
     }
 }
 
+void PfcWdAclHandler::addPfcAclRulePorts(const vector<sai_object_id_t> &ports)
+{
+    SWSS_LOG_ENTER();
+
+    AclRule* rule = gAclOrch->getAclRule(m_strIngressTable, m_strRule);
+    if (rule == nullptr)
+    {
+        shared_ptr<AclRulePacket> newRule = make_shared<AclRulePacket>(gAclOrch, m_strRule, m_strIngressTable);
+        createPfcAclRule(newRule, getQueueId(), m_strIngressTable, ports);
+    }
+    else
+    {
+        gAclOrch->updateAclRuleInPorts(m_strIngressTable, m_strRule, ports, RULE_OPER_ADD);
+    }
+}
+
+void PfcWdAclHandler::flushBulk(void)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &pending: m_bulkIngressPorts)
+    {
+        pending.second.first->addPfcAclRulePorts(pending.second.second);
+    }
+
+    m_bulkIngressPorts.clear();
+}
+
 void PfcWdAclHandler::clear()
 {
     SWSS_LOG_ENTER();
@@ -493,7 +544,7 @@ void PfcWdAclHandler::createPfcAclTable(sai_object_id_t port, string strTable, b
     gAclOrch->addAclTable(aclTable);
 }
 
-void PfcWdAclHandler::createPfcAclRule(shared_ptr<AclRulePacket> rule, uint8_t queueId, string strTable, sai_object_id_t portOid)
+void PfcWdAclHandler::createPfcAclRule(shared_ptr<AclRulePacket> rule, uint8_t queueId, string strTable, const vector<sai_object_id_t> &ports)
 {
     SWSS_LOG_ENTER();
 
@@ -510,7 +561,6 @@ void PfcWdAclHandler::createPfcAclRule(shared_ptr<AclRulePacket> rule, uint8_t q
     // Add MATCH_IN_PORTS as match criteria for ingress table and MATCH_OUT_PORT as match creiteria for shared egress table.
     if (strTable == INGRESS_TABLE_DROP || shared_egress_acl_table)
     {
-        Port p;
         if (strTable == INGRESS_TABLE_DROP) 
         {
             attr_name = MATCH_IN_PORTS;
@@ -519,13 +569,21 @@ void PfcWdAclHandler::createPfcAclRule(shared_ptr<AclRulePacket> rule, uint8_t q
             attr_name = MATCH_OUT_PORT;
         }
     
-        if (!gPortsOrch->getPort(portOid, p))
+        attr_value.clear();
+        for (auto portOid: ports)
         {
-            SWSS_LOG_ERROR("Failed to get port structure from port oid 0x%" PRIx64, portOid);
-            return;
+            const Port *p = gPortsOrch->findPort(portOid);
+            if (!p)
+            {
+                SWSS_LOG_ERROR("Failed to get port structure from port oid 0x%" PRIx64, portOid);
+                return;
+            }
+
+            attr_value += p->m_alias;
+            attr_value += ',';
         }
-    
-        attr_value = p.m_alias;
+        attr_value.pop_back();
+
         rule->validateAddMatch(attr_name, attr_value);
     }
 
@@ -537,6 +595,8 @@ void PfcWdAclHandler::createPfcAclRule(shared_ptr<AclRulePacket> rule, uint8_t q
 }
 
 std::map<std::string, AclTable> PfcWdAclHandler::m_aclTables;
+std::map<uint8_t, pair<PfcWdAclHandler *, vector<sai_object_id_t>>> PfcWdAclHandler::m_bulkIngressPorts;
+map<sai_object_id_t, uint8_t> PfcWdLossyHandler::m_bulkPfcMasks;
 
 PfcWdLossyHandler::PfcWdLossyHandler(sai_object_id_t port, sai_object_id_t queue,
         uint8_t queueId, shared_ptr<Table> countersTable):
@@ -552,19 +612,13 @@ PfcWdLossyHandler::PfcWdLossyHandler(sai_object_id_t port, sai_object_id_t queue
         return;
     }
 
-    uint8_t pfcMask = 0;
-
-    if (!gPortsOrch->getPortPfc(port, &pfcMask))
+    if (isBulk())
     {
-        SWSS_LOG_ERROR("Failed to get PFC mask on port 0x%" PRIx64, port);
+        m_bulkPfcMasks[port] = static_cast<uint8_t>(m_bulkPfcMasks[port] | (1 << queueId));
+        return;
     }
 
-    pfcMask = static_cast<uint8_t>(pfcMask & ~(1 << queueId));
-
-    if (!gPortsOrch->setPortPfc(port, pfcMask))
-    {
-        SWSS_LOG_ERROR("Failed to set PFC mask on port 0x%" PRIx64, port);
-    }
+    setPortPfcMask(port, static_cast<uint8_t>(1 << queueId), false);
 }
 
 PfcWdLossyHandler::~PfcWdLossyHandler(void)
@@ -579,19 +633,45 @@ PfcWdLossyHandler::~PfcWdLossyHandler(void)
         return;
     }
 
+    setPortPfcMask(getPort(), static_cast<uint8_t>(1 << getQueueId()), true);
+}
+
+void PfcWdLossyHandler::setPortPfcMask(sai_object_id_t port, uint8_t queueMask, bool enable)
+{
+    SWSS_LOG_ENTER();
+
     uint8_t pfcMask = 0;
 
-    if (!gPortsOrch->getPortPfc(getPort(), &pfcMask))
+    if (!gPortsOrch->getPortPfc(port, &pfcMask))
     {
-        SWSS_LOG_ERROR("Failed to get PFC mask on port 0x%" PRIx64, getPort());
+        SWSS_LOG_ERROR("Failed to get PFC mask on port 0x%" PRIx64, port);
     }
 
-    pfcMask = static_cast<uint8_t>(pfcMask | (1 << getQueueId()));
+    if (enable)
+    {
+        pfcMask = static_cast<uint8_t>(pfcMask | queueMask);
+    }
+    else
+    {
+        pfcMask = static_cast<uint8_t>(pfcMask & ~queueMask);
+    }
 
-    if (!gPortsOrch->setPortPfc(getPort(), pfcMask))
+    if (!gPortsOrch->setPortPfc(port, pfcMask))
+    {
+        SWSS_LOG_ERROR("Failed to set PFC mask on port 0x%" PRIx64, port);
+    }
+}
+
+void PfcWdLossyHandler::flushBulk(void)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto &portMask: m_bulkPfcMasks)
     {
-        SWSS_LOG_ERROR("Failed to set PFC mask on port 0x%" PRIx64, getPort());
+        setPortPfcMask(portMask.first, portMask.second, false);
     }
+
+    m_bulkPfcMasks.clear();
 }
 
 bool PfcWdLossyHandler::getHwCounters(PfcWdHwStats& counters)
@@ -626,14 +706,14 @@ bool PfcWdLossyHandler::getHwCounters(PfcWdHwStats& counters)
     }
 
     // PG counters not yet supported in Mellanox platform
-    Port portInstance;
-    if (!gPortsOrch->getPort(getPort(), portInstance))
+    const Port *portInstance = gPortsOrch->findPort(getPort());
+    if (!portInstance)
     {
         SWSS_LOG_ERROR("Cannot get port by ID 0x%" PRIx64, getPort());
         return false;
     }
 
-    sai_object_id_t pg = portInstance.m_priority_group_ids[static_cast <size_t> (getQueueId())];
+    sai_object_id_t pg = portInstance->m_priority_group_ids[static_cast <size_t> (getQueueId())];
     vector<uint64_t> pgStats;
     pgStats.resize(pgStatIds.size());
 
@@ -663,6 +743,12 @@ PfcWdZeroBufferHandler::PfcWdZeroBufferHandler(sai_object_id_t port,
 {
     SWSS_LOG_ENTER();
 
+    if (isBulk())
+    {
+        m_bulkHandlers.push_back(this);
+        return;
+    }
+
     Port portInstance;
     if (!gPortsOrch->getPort(port, portInstance))
     {
@@ -670,16 +756,48 @@ PfcWdZeroBufferHandler::PfcWdZeroBufferHandler(sai_object_id_t port,
         return;
     }
 
-    setQueueLockFlag(portInstance, true);
+    setQueueLockFlag(portInstance, { queue }, true);
+    setZeroBufferProfile();
+}
+
+PfcWdZeroBufferHandler::~PfcWdZeroBufferHandler(void)
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+    attr.id = SAI_QUEUE_ATTR_BUFFER_PROFILE_ID;
+    attr.value.oid = m_originalQueueBufferProfile;
+
+    // Set our zero buffer profile on a queue
+    sai_status_t status = sai_queue_api->set_queue_attribute(getQueue(), &attr);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to set buffer profile ID on queue 0x%" PRIx64 ": %d", getQueue(), status);
+        return;
+    }
+
+    Port portInstance;
+    if (!gPortsOrch->getPort(getPort(), portInstance))
+    {
+        SWSS_LOG_ERROR("Cannot get port by ID 0x%" PRIx64, getPort());
+        return;
+    }
+
+    setQueueLockFlag(portInstance, { getQueue() }, false);
+}
+
+void PfcWdZeroBufferHandler::setZeroBufferProfile(void)
+{
+    SWSS_LOG_ENTER();
 
     sai_attribute_t attr;
     attr.id = SAI_QUEUE_ATTR_BUFFER_PROFILE_ID;
 
     // Get queue's buffer profile ID
-    sai_status_t status = sai_queue_api->get_queue_attribute(queue, 1, &attr);
+    sai_status_t status = sai_queue_api->get_queue_attribute(getQueue(), 1, &attr);
     if (status != SAI_STATUS_SUCCESS)
     {
-        SWSS_LOG_ERROR("Failed to get buffer profile ID on queue 0x%" PRIx64 ": %d", queue, status);
+        SWSS_LOG_ERROR("Failed to get buffer profile ID on queue 0x%" PRIx64 ": %d", getQueue(), status);
         return;
     }
 
@@ -689,10 +807,10 @@ PfcWdZeroBufferHandler::PfcWdZeroBufferHandler(sai_object_id_t port,
     attr.value.oid = ZeroBufferProfile::getZeroBufferProfile();
 
     // Set our zero buffer profile
-    status = sai_queue_api->set_queue_attribute(queue, &attr);
+    status = sai_queue_api->set_queue_attribute(getQueue(), &attr);
     if (status != SAI_STATUS_SUCCESS)
     {
-        SWSS_LOG_ERROR("Failed to set buffer profile ID on queue 0x%" PRIx64 ": %d", queue, status);
+        SWSS_LOG_ERROR("Failed to set buffer profile ID on queue 0x%" PRIx64 ": %d", getQueue(), status);
         return;
     }
 
@@ -700,38 +818,56 @@ PfcWdZeroBufferHandler::PfcWdZeroBufferHandler(sai_object_id_t port,
     m_originalQueueBufferProfile = oldQueueProfileId;
 }
 
-PfcWdZeroBufferHandler::~PfcWdZeroBufferHandler(void)
+void PfcWdZeroBufferHandler::flushBulk(void)
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t attr;
-    attr.id = SAI_QUEUE_ATTR_BUFFER_PROFILE_ID;
-    attr.value.oid = m_originalQueueBufferProfile;
-
-    // Set our zero buffer profile on a queue
-    sai_status_t status = sai_queue_api->set_queue_attribute(getQueue(), &attr);
-    if (status != SAI_STATUS_SUCCESS)
+    if (m_bulkHandlers.empty())
     {
-        SWSS_LOG_ERROR("Failed to set buffer profile ID on queue 0x%" PRIx64 ": %d", getQueue(), status);
         return;
     }
 
-    Port portInstance;
-    if (!gPortsOrch->getPort(getPort(), portInstance))
+    // Lock the queues of each port with a single port update
+    map<sai_object_id_t, set<sai_object_id_t>> portQueues;
+    for (const auto *handler: m_bulkHandlers)
     {
-        SWSS_LOG_ERROR("Cannot get port by ID 0x%" PRIx64, getPort());
-        return;
+        portQueues[handler->getPort()].insert(handler->getQueue());
+    }
+
+    set<sai_object_id_t> lockedPorts;
+    for (const auto &it: portQueues)
+    {
+        Port portInstance;
+        if (!gPortsOrch->getPort(it.first, portInstance))
+        {
+            SWSS_LOG_ERROR("Cannot get port by ID 0x%" PRIx64, it.first);
+            continue;
+        }
+
+        setQueueLockFlag(portInstance, it.second, true);
+        lockedPorts.insert(it.first);
     }
 
-    setQueueLockFlag(portInstance, false);
+    // The zero buffer profile is shared, create it once for the whole bulk
+    ZeroBufferProfile::getZeroBufferProfile();
+
+    for (auto *handler: m_bulkHandlers)
+    {
+        if (lockedPorts.find(handler->getPort()) != lockedPorts.end())
+        {
+            handler->setZeroBufferProfile();
+        }
+    }
+
+    m_bulkHandlers.clear();
 }
 
-void PfcWdZeroBufferHandler::setQueueLockFlag(Port& port, bool isLocked) const
+void PfcWdZeroBufferHandler::setQueueLockFlag(Port& port, const set<sai_object_id_t>& queues, bool isLocked)
 {
-    // set lock bits on queue
+    // set lock bits on queues
     for (size_t i = 0; i < port.m_queue_ids.size(); ++i)
     {
-        if (port.m_queue_ids[i] == getQueue())
+        if (queues.find(port.m_queue_ids[i]) != queues.end())
         {
             port.m_queue_lock[i] = isLocked;
         }
@@ -739,6 +875,8 @@ void PfcWdZeroBufferHandler::setQueueLockFlag(Port& port, bool isLocked) const
     gPortsOrch->setPort(port.m_alias, port);
 }
 
+vector<PfcWdZeroBufferHandler *> PfcWdZeroBufferHandler::m_bulkHandlers;
+
 PfcWdZeroBufferHandler::ZeroBufferProfile::ZeroBufferProfile(void)
 {
     SWSS_LOG_ENTER();
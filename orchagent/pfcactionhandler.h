@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <memory>
+#include <map>
+#include <set>
 #include "aclorch.h"
 #include "table.h"
 
@@ -48,6 +50,19 @@ class PfcWdActionHandler
 
         static void initWdCounters(shared_ptr<Table> countersTable, const string &queueIdStr);
         void initCounters(void);
+
+        // Handlers created between beginBulk() and endBulk() defer their port,
+        // queue and ACL rule programming to endBulk(), which applies it once
+        // per port and per ACL rule for all queues stormed together.
+        // Handlers must not be destroyed before endBulk() is called.
+        static void beginBulk(void);
+        static void endBulk(void);
+
+        static inline bool isBulk(void)
+        {
+            return m_bulk;
+        }
+
         void commitCounters(bool periodic = false);
 
         virtual bool getHwCounters(PfcWdHwStats& counters)
@@ -82,6 +97,8 @@ class PfcWdActionHandler
         string m_portAlias;
         shared_ptr<Table> m_countersTable = nullptr;
         PfcWdHwStats m_hwStats;
+
+        static bool m_bulk;
 };
 
 // Pfc queue that implements forward action by disabling PFC on queue
@@ -92,6 +109,15 @@ class PfcWdLossyHandler: public PfcWdActionHandler
                 uint8_t queueId, shared_ptr<Table> countersTable);
         virtual ~PfcWdLossyHandler(void);
         virtual bool getHwCounters(PfcWdHwStats& counters);
+
+    private:
+        friend class PfcWdActionHandler;
+
+        static void flushBulk(void);
+        static void setPortPfcMask(sai_object_id_t port, uint8_t queueMask, bool enable);
+
+        // Port -> mask of the queues to disable PFC on at the end of a bulk
+        static map<sai_object_id_t, uint8_t> m_bulkPfcMasks;
 };
 
 class PfcWdAclHandler: public PfcWdLossyHandler
@@ -104,8 +130,14 @@ class PfcWdAclHandler: public PfcWdLossyHandler
         // class shared cleanup
         static void clear();
     private:
+        friend class PfcWdActionHandler;
+
+        static void flushBulk(void);
+
         // class shared dict: ACL table name -> ACL table
         static std::map<std::string, AclTable> m_aclTables;
+        // Queue index -> handler and ports to add to the ingress rule of the queue at the end of a bulk
+        static std::map<uint8_t, pair<PfcWdAclHandler *, vector<sai_object_id_t>>> m_bulkIngressPorts;
 
         bool shared_egress_acl_table = false;
 
@@ -114,7 +146,8 @@ class PfcWdAclHandler: public PfcWdLossyHandler
         string m_strRule;
         string m_strEgressRule;
         void createPfcAclTable(sai_object_id_t port, string strTable, bool ingress);
-        void createPfcAclRule(shared_ptr<AclRulePacket> rule, uint8_t queueId, string strTable, sai_object_id_t port);
+        void createPfcAclRule(shared_ptr<AclRulePacket> rule, uint8_t queueId, string strTable, const vector<sai_object_id_t> &ports);
+        void addPfcAclRulePorts(const vector<sai_object_id_t> &ports);
         void updatePfcAclRule(shared_ptr<AclRule> rule, uint8_t queueId, string strTable, vector<sai_object_id_t> port);
 };
 
@@ -135,11 +168,19 @@ class PfcWdZeroBufferHandler: public PfcWdLossyHandler
         virtual ~PfcWdZeroBufferHandler(void);
 
     private:
+        friend class PfcWdActionHandler;
+
+        static void flushBulk(void);
+
         /*
-         * Sets lock bits on port's queue
-         * to protect it from being changed by other Orch's
+         * Sets lock bits on port's queues
+         * to protect them from being changed by other Orch's
         */
-        void setQueueLockFlag(Port& port, bool isLocked) const;
+        static void setQueueLockFlag(Port& port, const set<sai_object_id_t>& queues, bool isLocked);
+        void setZeroBufferProfile(void);
+
+        // Handlers waiting for the zero buffer profile at the end of a bulk
+        static vector<PfcWdZeroBufferHandler *> m_bulkHandlers;
 
         // Singletone class for keeping shared data - zero buffer profiles
         class ZeroBufferProfile
@@ -0,0 +1,384 @@
+#include <cstdlib>
+#include <cstring>
+#include <hiredis/hiredis.h>
+#include "pfcwddetect.h"
+#include "orch.h"
+#include "schema.h"
+#include "redisapi.h"
+#include "sai_serialize.h"
+
+using namespace std;
+using namespace swss;
+
+#define PFC_WD_QUEUE_PACKETS        0
+#define PFC_WD_QUEUE_OCCUPANCY      1
+#define PFC_WD_QUEUE_PAUSE_STATUS   2
+#define PFC_WD_QUEUE_DEBUG_STORM    3
+#define PFC_WD_QUEUE_FIELD_COUNT    4
+
+#define PFC_WD_PORT_RX_PACKETS      0
+#define PFC_WD_PORT_DURATION        1
+#define PFC_WD_PORT_ON2OFF_PACKETS  2
+#define PFC_WD_PORT_FIELD_COUNT     3
+
+static string formatCommand(const vector<string> &args)
+{
+    vector<const char *> argv;
+    vector<size_t> argvlen;
+
+    for (const auto &arg : args)
+    {
+        argv.push_back(arg.c_str());
+        argvlen.push_back(arg.size());
+    }
+
+    RedisCommand cmd;
+    cmd.formatArgv(static_cast<int>(args.size()), argv.data(), argvlen.data());
+
+    return string(cmd.c_str(), cmd.length());
+}
+
+static uint64_t counterDelta(uint64_t cur, uint64_t last)
+{
+    // Counters cleared since the last poll do not count as progress
+    return cur >= last ? cur - last : 0;
+}
+
+// Paused for more than 80% of the poll, as the Lua plugins check it
+static bool pausedMostOfPoll(const PfcWdSample &cur, const PfcWdSample &last, uint64_t pollTimeUs)
+{
+    return counterDelta(cur.pfcDuration, last.pfcDuration) * 5 > pollTimeUs * 4;
+}
+
+static bool sameCounters(const PfcWdSample &a, const PfcWdSample &b)
+{
+    return (a.packets == b.packets) &&
+        (a.occupancyBytes == b.occupancyBytes) &&
+        (a.pfcRxPackets == b.pfcRxPackets) &&
+        (a.pfcDuration == b.pfcDuration) &&
+        (a.pfcOn2OffPackets == b.pfcOn2OffPackets) &&
+        (a.pauseStatus == b.pauseStatus);
+}
+
+unique_ptr<PfcWdDetectPolicy> PfcWdDetectPolicy::create(const string &platform)
+{
+    if (platform == VS_PLATFORM_SUBSTRING)
+    {
+        return unique_ptr<PfcWdDetectPolicy>(new PfcWdGenericDetectPolicy("RX_PAUSE_DURATION_US"));
+    }
+
+    if ((platform == BFN_PLATFORM_SUBSTRING) ||
+        (platform == NPS_PLATFORM_SUBSTRING) ||
+        (platform == CLX_PLATFORM_SUBSTRING) ||
+        (platform == MRVL_PRST_PLATFORM_SUBSTRING))
+    {
+        return unique_ptr<PfcWdDetectPolicy>(new PfcWdGenericDetectPolicy());
+    }
+
+    if (platform == MRVL_TL_PLATFORM_SUBSTRING)
+    {
+        return unique_ptr<PfcWdDetectPolicy>(new PfcWdTeralynxDetectPolicy());
+    }
+
+    if (platform == CISCO_8000_PLATFORM_SUBSTRING)
+    {
+        return unique_ptr<PfcWdDetectPolicy>(new PfcWdPauseStatusDetectPolicy());
+    }
+
+    // Mellanox and Broadcom plugins also keep pause time estimations and
+    // history in COUNTERS_DB, they stay on Lua
+    return nullptr;
+}
+
+PfcWdGenericDetectPolicy::PfcWdGenericDetectPolicy(const string &durationCounter):
+    m_durationCounter(durationCounter)
+{
+}
+
+uint32_t PfcWdGenericDetectPolicy::requiredCounters(void) const
+{
+    return QUEUE_PACKETS | QUEUE_OCCUPANCY | PFC_RX_PACKETS | PFC_DURATION;
+}
+
+string PfcWdGenericDetectPolicy::durationCounter(void) const
+{
+    return m_durationCounter;
+}
+
+bool PfcWdGenericDetectPolicy::isStorm(const PfcWdSample &cur, const PfcWdSample &last, uint64_t pollTimeUs) const
+{
+    bool noTx = cur.packets == last.packets;
+
+    if (cur.occupancyBytes > 0)
+    {
+        return noTx && counterDelta(cur.pfcRxPackets, last.pfcRxPackets) > 0;
+    }
+
+    return noTx && pausedMostOfPoll(cur, last, pollTimeUs);
+}
+
+uint32_t PfcWdTeralynxDetectPolicy::requiredCounters(void) const
+{
+    return QUEUE_PACKETS | QUEUE_OCCUPANCY | PFC_RX_PACKETS | PFC_DURATION;
+}
+
+bool PfcWdTeralynxDetectPolicy::isStorm(const PfcWdSample &cur, const PfcWdSample &last, uint64_t pollTimeUs) const
+{
+    if ((counterDelta(cur.pfcRxPackets, last.pfcRxPackets) == 0) || !pausedMostOfPoll(cur, last, pollTimeUs))
+    {
+        return false;
+    }
+
+    return (cur.occupancyBytes == 0) || (cur.packets == last.packets);
+}
+
+uint32_t PfcWdPauseStatusDetectPolicy::requiredCounters(void) const
+{
+    return QUEUE_PACKETS | QUEUE_PAUSE_STATUS;
+}
+
+bool PfcWdPauseStatusDetectPolicy::comparesLast(void) const
+{
+    return false;
+}
+
+bool PfcWdPauseStatusDetectPolicy::isStorm(const PfcWdSample &cur, const PfcWdSample &last, uint64_t pollTimeUs) const
+{
+    return cur.pauseStatus;
+}
+
+PfcWdDetector::PfcWdDetector(unique_ptr<PfcWdDetectPolicy> policy, shared_ptr<DBConnector> countersDb):
+    m_policy(move(policy)),
+    m_countersDb(countersDb)
+{
+}
+
+void PfcWdDetector::addQueue(sai_object_id_t queueId, sai_object_id_t portId, uint8_t index,
+        uint64_t detectionTimeUs, bool alert)
+{
+    SWSS_LOG_ENTER();
+
+    Queue queue;
+    queue.queueId = queueId;
+    queue.detectionTimeUs = detectionTimeUs;
+    queue.timeLeftUs = detectionTimeUs;
+    queue.alert = alert;
+
+    string prefix = "SAI_PORT_STAT_PFC_" + to_string(index) + "_";
+    queue.queueCmd = formatCommand({ "HMGET", string(COUNTERS_TABLE) + ":" + sai_serialize_object_id(queueId),
+            "SAI_QUEUE_STAT_PACKETS", "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES",
+            "SAI_QUEUE_ATTR_PAUSE_STATUS", "DEBUG_STORM" });
+    queue.portCmd = formatCommand({ "HMGET", string(COUNTERS_TABLE) + ":" + sai_serialize_object_id(portId),
+            prefix + "RX_PKTS", prefix + m_policy->durationCounter(), prefix + "ON2OFF_RX_PKTS" });
+
+    auto it = m_index.find(queueId);
+    if (it != m_index.end())
+    {
+        // Reconfigured, keep the storm state
+        queue.stormed = m_queues[it->second].stormed;
+        m_queues[it->second] = move(queue);
+        return;
+    }
+
+    m_index[queueId] = m_queues.size();
+    m_queues.push_back(move(queue));
+}
+
+void PfcWdDetector::removeQueue(sai_object_id_t queueId)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_index.find(queueId);
+    if (it == m_index.end())
+    {
+        return;
+    }
+
+    size_t pos = it->second;
+    m_index.erase(it);
+
+    if (pos != m_queues.size() - 1)
+    {
+        m_queues[pos] = move(m_queues.back());
+        m_index[m_queues[pos].queueId] = pos;
+    }
+    m_queues.pop_back();
+}
+
+void PfcWdDetector::setStormed(sai_object_id_t queueId, bool stormed)
+{
+    auto it = m_index.find(queueId);
+    if (it == m_index.end())
+    {
+        return;
+    }
+
+    auto &queue = m_queues[it->second];
+    if (queue.stormed == stormed)
+    {
+        return;
+    }
+
+    queue.stormed = stormed;
+    queue.timeLeftUs = queue.detectionTimeUs;
+    queue.hasLast = false;
+}
+
+bool PfcWdDetector::readBatch(vector<redisReply *> &replies)
+{
+    redisContext *ctx = m_countersDb->getContext();
+
+    for (const auto &queue : m_queues)
+    {
+        if ((redisAppendFormattedCommand(ctx, queue.queueCmd.data(), queue.queueCmd.size()) != REDIS_OK) ||
+            (redisAppendFormattedCommand(ctx, queue.portCmd.data(), queue.portCmd.size()) != REDIS_OK))
+        {
+            SWSS_LOG_ERROR("Failed to queue PFC watchdog counters read: %s", ctx->errstr);
+            return false;
+        }
+    }
+
+    replies.assign(m_queues.size() * 2, nullptr);
+    for (size_t i = 0; i < replies.size(); i++)
+    {
+        void *reply = nullptr;
+        if (redisGetReply(ctx, &reply) != REDIS_OK || !reply)
+        {
+            SWSS_LOG_ERROR("Failed to read PFC watchdog counters: %s", ctx->errstr);
+            for (auto r : replies)
+            {
+                if (r)
+                {
+                    freeReplyObject(r);
+                }
+            }
+            replies.clear();
+            return false;
+        }
+        replies[i] = static_cast<redisReply *>(reply);
+    }
+
+    return true;
+}
+
+bool PfcWdDetector::parseSample(const redisReply *queueReply, const redisReply *portReply,
+        PfcWdSample &sample, bool &debugStorm) const
+{
+    if ((queueReply->type != REDIS_REPLY_ARRAY) || (queueReply->elements != PFC_WD_QUEUE_FIELD_COUNT) ||
+        (portReply->type != REDIS_REPLY_ARRAY) || (portReply->elements != PFC_WD_PORT_FIELD_COUNT))
+    {
+        return false;
+    }
+
+    uint32_t present = 0;
+    auto parse = [&present](const redisReply *element, uint32_t counter, uint64_t &value)
+    {
+        if (element->type == REDIS_REPLY_STRING)
+        {
+            value = strtoull(element->str, nullptr, 10);
+            present |= counter;
+        }
+    };
+
+    parse(queueReply->element[PFC_WD_QUEUE_PACKETS], PfcWdDetectPolicy::QUEUE_PACKETS, sample.packets);
+    parse(queueReply->element[PFC_WD_QUEUE_OCCUPANCY], PfcWdDetectPolicy::QUEUE_OCCUPANCY, sample.occupancyBytes);
+    parse(portReply->element[PFC_WD_PORT_RX_PACKETS], PfcWdDetectPolicy::PFC_RX_PACKETS, sample.pfcRxPackets);
+    parse(portReply->element[PFC_WD_PORT_DURATION], PfcWdDetectPolicy::PFC_DURATION, sample.pfcDuration);
+    parse(portReply->element[PFC_WD_PORT_ON2OFF_PACKETS], PfcWdDetectPolicy::PFC_ON2OFF_PACKETS, sample.pfcOn2OffPackets);
+
+    auto pauseStatus = queueReply->element[PFC_WD_QUEUE_PAUSE_STATUS];
+    if (pauseStatus->type == REDIS_REPLY_STRING)
+    {
+        sample.pauseStatus = strcmp(pauseStatus->str, "true") == 0;
+        present |= PfcWdDetectPolicy::QUEUE_PAUSE_STATUS;
+    }
+
+    auto debug = queueReply->element[PFC_WD_QUEUE_DEBUG_STORM];
+    debugStorm = (debug->type == REDIS_REPLY_STRING) && (strcmp(debug->str, "enabled") == 0);
+
+    uint32_t required = m_policy->requiredCounters();
+    return (present & required) == required;
+}
+
+void PfcWdDetector::poll(uint64_t pollTimeUs, vector<pair<sai_object_id_t, string>> &events)
+{
+    if (m_queues.empty())
+    {
+        return;
+    }
+
+    vector<redisReply *> replies;
+    if (!readBatch(replies))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < m_queues.size(); i++)
+    {
+        auto &queue = m_queues[i];
+
+        // Stormed queues wait for the restore plugin, unless only alerted
+        if (queue.stormed && !queue.alert)
+        {
+            continue;
+        }
+
+        PfcWdSample cur;
+        bool debugStorm = false;
+        if (!parseSample(replies[2 * i], replies[2 * i + 1], cur, debugStorm))
+        {
+            continue;
+        }
+
+        const PfcWdSample *last = &cur;
+        if (m_policy->comparesLast())
+        {
+            if (!queue.hasLast)
+            {
+                queue.last = cur;
+                queue.hasLast = true;
+                continue;
+            }
+
+            // Polled again before syncd refreshed the counters, which would
+            // look like an idle queue and restart the detection countdown
+            if (!queue.staleSkipped && sameCounters(cur, queue.last))
+            {
+                queue.staleSkipped = true;
+                continue;
+            }
+            queue.staleSkipped = false;
+            last = &queue.last;
+        }
+
+        if (debugStorm || m_policy->isStorm(cur, *last, pollTimeUs))
+        {
+            if (queue.timeLeftUs <= pollTimeUs)
+            {
+                events.emplace_back(queue.queueId, PFC_WD_EVENT_STORM);
+                queue.timeLeftUs = queue.detectionTimeUs;
+                // Start over from the next poll, as the plugins drop their *_last fields
+                queue.hasLast = false;
+                continue;
+            }
+
+            queue.timeLeftUs -= pollTimeUs;
+        }
+        else
+        {
+            if (queue.alert && queue.stormed)
+            {
+                events.emplace_back(queue.queueId, PFC_WD_EVENT_RESTORE);
+            }
+            queue.timeLeftUs = queue.detectionTimeUs;
+        }
+
+        queue.last = cur;
+        queue.hasLast = true;
+    }
+
+    for (auto reply : replies)
+    {
+        freeReplyObject(reply);
+    }
+}
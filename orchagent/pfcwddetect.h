@@ -0,0 +1,143 @@
+#ifndef PFC_WD_DETECT_H
+#define PFC_WD_DETECT_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "dbconnector.h"
+
+extern "C" {
+#include "sai.h"
+}
+
+#define PFC_WD_EVENT_STORM      "storm"
+#define PFC_WD_EVENT_RESTORE    "restore"
+
+// Counters of a PFC watchdog queue at one poll
+struct PfcWdSample
+{
+    uint64_t packets = 0;
+    uint64_t occupancyBytes = 0;
+    uint64_t pfcRxPackets = 0;
+    uint64_t pfcDuration = 0;
+    uint64_t pfcOn2OffPackets = 0;
+    bool pauseStatus = false;
+};
+
+// Storm predicate of a platform, the native counterpart of pfc_detect_<platform>.lua
+class PfcWdDetectPolicy
+{
+    public:
+        enum Counter : uint32_t
+        {
+            QUEUE_PACKETS       = 1 << 0,
+            QUEUE_OCCUPANCY     = 1 << 1,
+            QUEUE_PAUSE_STATUS  = 1 << 2,
+            PFC_RX_PACKETS      = 1 << 3,
+            PFC_DURATION        = 1 << 4,
+            PFC_ON2OFF_PACKETS  = 1 << 5,
+        };
+
+        virtual ~PfcWdDetectPolicy(void) = default;
+
+        // Counters that have to be polled for the queue to be evaluated
+        virtual uint32_t requiredCounters(void) const = 0;
+
+        // Suffix of the SAI_PORT_STAT_PFC_<prio>_ pause duration counter
+        virtual std::string durationCounter(void) const
+        {
+            return "RX_PAUSE_DURATION";
+        }
+
+        // False when the predicate only looks at the current sample
+        virtual bool comparesLast(void) const
+        {
+            return true;
+        }
+
+        virtual bool isStorm(const PfcWdSample &cur, const PfcWdSample &last, uint64_t pollTimeUs) const = 0;
+
+        // Policy of the platform, null when the platform keeps its Lua plugin
+        static std::unique_ptr<PfcWdDetectPolicy> create(const std::string &platform);
+};
+
+// Queue blocked with PFC frames received, or paused for most of the poll
+class PfcWdGenericDetectPolicy: public PfcWdDetectPolicy
+{
+    public:
+        PfcWdGenericDetectPolicy(const std::string &durationCounter = "RX_PAUSE_DURATION");
+
+        uint32_t requiredCounters(void) const override;
+        std::string durationCounter(void) const override;
+        bool isStorm(const PfcWdSample &cur, const PfcWdSample &last, uint64_t pollTimeUs) const override;
+
+    private:
+        std::string m_durationCounter;
+};
+
+// PFC frames received and paused for most of the poll
+class PfcWdTeralynxDetectPolicy: public PfcWdDetectPolicy
+{
+    public:
+        uint32_t requiredCounters(void) const override;
+        bool isStorm(const PfcWdSample &cur, const PfcWdSample &last, uint64_t pollTimeUs) const override;
+};
+
+// Queue paused as reported by SAI_QUEUE_ATTR_PAUSE_STATUS
+class PfcWdPauseStatusDetectPolicy: public PfcWdDetectPolicy
+{
+    public:
+        uint32_t requiredCounters(void) const override;
+        bool comparesLast(void) const override;
+        bool isStorm(const PfcWdSample &cur, const PfcWdSample &last, uint64_t pollTimeUs) const override;
+};
+
+// Evaluates the storm policy over the counters of all the watched queues.
+// The counters polled by the PFC_WD flex counter group are read from
+// COUNTERS_DB in one pipelined batch per poll, and the previous samples and
+// detection countdowns are kept in memory instead of the *_last and
+// PFC_WD_DETECTION_TIME_LEFT fields of the Lua plugins.
+class PfcWdDetector
+{
+    public:
+        PfcWdDetector(std::unique_ptr<PfcWdDetectPolicy> policy, std::shared_ptr<swss::DBConnector> countersDb);
+
+        void addQueue(sai_object_id_t queueId, sai_object_id_t portId, uint8_t index,
+                uint64_t detectionTimeUs, bool alert);
+        void removeQueue(sai_object_id_t queueId);
+
+        // Stormed queues are only evaluated for alert, to report their restoration
+        void setStormed(sai_object_id_t queueId, bool stormed);
+
+        // Appends the (queue, PFC_WD_EVENT_*) events detected by this poll
+        void poll(uint64_t pollTimeUs, std::vector<std::pair<sai_object_id_t, std::string>> &events);
+
+    private:
+        struct Queue
+        {
+            sai_object_id_t queueId;
+            uint64_t detectionTimeUs;
+            uint64_t timeLeftUs;
+            bool alert;
+            bool stormed = false;
+            bool hasLast = false;
+            // The last poll read the same counters again, syncd did not poll in between
+            bool staleSkipped = false;
+            PfcWdSample last;
+            std::string queueCmd;
+            std::string portCmd;
+        };
+
+        bool readBatch(std::vector<struct redisReply *> &replies);
+        bool parseSample(const struct redisReply *queueReply, const struct redisReply *portReply,
+                PfcWdSample &sample, bool &debugStorm) const;
+
+        std::unique_ptr<PfcWdDetectPolicy> m_policy;
+        std::shared_ptr<swss::DBConnector> m_countersDb;
+        std::vector<Queue> m_queues;
+        std::unordered_map<sai_object_id_t, size_t> m_index;
+};
+
+#endif
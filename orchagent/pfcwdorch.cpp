@@ -27,6 +27,8 @@
 #define SAI_PORT_STAT_PFC_PREFIX        "SAI_PORT_STAT_PFC_"
 #define PFC_WD_TC_MAX 8
 #define COUNTER_CHECK_POLL_TIMEOUT_SEC  1
+// Set to 1 to keep the Lua storm detection on platforms with a native policy
+#define PFC_WD_LUA_DETECT_ENV           "PFC_WD_LUA_DETECT"
 
 extern sai_object_id_t gSwitchId;
 extern sai_switch_api_t* sai_switch_api;
@@ -353,7 +355,14 @@ task_process_status PfcWdSwOrch<DropHandler, ForwardHandler>::createEntry(const
 
             if (field == POLL_INTERVAL_FIELD)
             {
-                this->m_pfcwdFlexCounterManager->updateGroupPollingInterval(stoi(value));
+                m_pollInterval = stoi(value);
+                this->m_pfcwdFlexCounterManager->updateGroupPollingInterval(m_pollInterval);
+                if ((m_detectTimer != nullptr) && (m_pollInterval > 0))
+                {
+                    auto interv = timespec { .tv_sec = m_pollInterval / 1000, .tv_nsec = (m_pollInterval % 1000) * 1000000 };
+                    m_detectTimer->setInterval(interv);
+                    m_detectTimer->reset();
+                }
             }
             else if (field == BIG_RED_SWITCH_FIELD)
             {
@@ -471,10 +480,16 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::enableBigRedSwitchMode()
         {
             entry.second.handler->commitCounters();
             entry.second.handler = nullptr;
+            if (m_detector)
+            {
+                m_detector->setStormed(entry.first, false);
+            }
         }
     }
 
     // Create pfcwdaction handler on all the ports.
+    beginBulk();
+
     for (auto & it: allPorts)
     {
         Port port = it.second;
@@ -489,6 +504,7 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::enableBigRedSwitchMode()
         if (!gPortsOrch->getPortPfcWatchdogStatus(port.m_port_id, &pfcMask))
         {
             SWSS_LOG_ERROR("Failed to get PFC watchdog mask on port %s", port.m_alias.c_str());
+            endBulk();
             return;
         }
 
@@ -522,6 +538,8 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::enableBigRedSwitchMode()
             }
         }
     }
+
+    endBulk();
 }
 
 template <typename DropHandler, typename ForwardHandler>
@@ -595,6 +613,11 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::registerInWdDb(const Port& port,
 
         // Create internal entry
         m_entryMap.emplace(queueId, PfcWdQueueEntry(action, port.m_port_id, i, port.m_alias));
+        if (m_detector)
+        {
+            m_detector->addQueue(queueId, port.m_port_id, i, static_cast<uint64_t>(detectionTime) * 1000,
+                    action == PfcWdAction::PFC_WD_ACTION_ALERT);
+        }
 
         // Initialize PFC WD related counters
         PfcWdActionHandler::initWdCounters(
@@ -663,6 +686,10 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::unregisterFromWdDb(const Port& po
         }
 
         m_entryMap.erase(queueId);
+        if (m_detector)
+        {
+            m_detector->removeQueue(queueId);
+        }
 
         // Clean up
         string countersKey = this->getCountersTable()->getTableName() + this->getCountersTable()->getTableNameSeparator() + sai_serialize_object_id(queueId);
@@ -689,6 +716,14 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
 {
     SWSS_LOG_ENTER();
 
+    const char *luaDetect = getenv(PFC_WD_LUA_DETECT_ENV);
+    auto detectPolicy = PfcWdDetectPolicy::create(this->m_platform);
+    if (detectPolicy && !(luaDetect && string(luaDetect) == "1"))
+    {
+        m_detector.reset(new PfcWdDetector(move(detectPolicy), this->getCountersDb()));
+        SWSS_LOG_NOTICE("PFC watchdog storms are detected natively on platform %s", this->m_platform.c_str());
+    }
+
     string detectSha, restoreSha;
     string detectPluginName = "pfc_detect_" + this->m_platform + ".lua";
     string restorePluginName;
@@ -702,16 +737,24 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
 
     try
     {
-        string detectLuaScript = swss::loadLuaScript(detectPluginName);
-        detectSha = swss::loadRedisScript(
-                this->getCountersDb().get(),
-                detectLuaScript);
-
         string restoreLuaScript = swss::loadLuaScript(restorePluginName);
         restoreSha = swss::loadRedisScript(
                 this->getCountersDb().get(),
                 restoreLuaScript);
-        plugins = detectSha + "," + restoreSha;
+
+        if (m_detector)
+        {
+            // Restoration is still evaluated by its plugin
+            plugins = restoreSha;
+        }
+        else
+        {
+            string detectLuaScript = swss::loadLuaScript(detectPluginName);
+            detectSha = swss::loadRedisScript(
+                    this->getCountersDb().get(),
+                    detectLuaScript);
+            plugins = detectSha + "," + restoreSha;
+        }
     }
     catch (...)
     {
@@ -733,6 +776,15 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
     Orch::addExecutor(executor);
     timer->start();
 
+    if (m_detector)
+    {
+        auto detectInterv = timespec { .tv_sec = m_pollInterval / 1000, .tv_nsec = (m_pollInterval % 1000) * 1000000 };
+        m_detectTimer = new SelectableTimer(detectInterv);
+        auto detectExecutor = new ExecutableTimer(m_detectTimer, this, "PFC_WD_DETECT");
+        Orch::addExecutor(detectExecutor);
+        m_detectTimer->start();
+    }
+
     auto ssTable = new swss::SubscriberStateTable(
             m_applDb.get(), APP_PFC_WD_TABLE_NAME, TableConsumable::DEFAULT_POP_BATCH_SIZE, default_orch_pri);
     auto ssConsumer = new Consumer(ssTable, this, APP_PFC_WD_TABLE_NAME);
@@ -787,6 +839,8 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(Consumer& consumer)
 
     if ((consumer.getDbName() == "APPL_DB") && (consumer.getTableName() == APP_PFC_WD_TABLE_NAME))
     {
+        beginBulk();
+
         auto it = consumer.m_toSync.begin();
         while (it != consumer.m_toSync.end())
         {
@@ -850,6 +904,8 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(Consumer& consumer)
 
             it = consumer.m_toSync.erase(it);
         }
+
+        endBulk();
     }
 }
 
@@ -921,6 +977,12 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    if (&timer == m_detectTimer)
+    {
+        detectStorms();
+        return;
+    }
+
     for (auto& handlerPair : m_entryMap)
     {
         if (handlerPair.second.handler != nullptr)
@@ -931,6 +993,71 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(SelectableTimer &timer)
 
 }
 
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::detectStorms(void)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_bigRedSwitchFlag)
+    {
+        return;
+    }
+
+    vector<pair<sai_object_id_t, string>> events;
+    m_detector->poll(static_cast<uint64_t>(m_pollInterval) * 1000, events);
+
+    if (events.empty())
+    {
+        return;
+    }
+
+    // Mitigate all the queues stormed in this poll together
+    beginBulk();
+
+    for (const auto &event : events)
+    {
+        if (!startWdActionOnQueue(event.second, event.first))
+        {
+            SWSS_LOG_ERROR("Failed to start PFC watchdog %s event action on queue 0x%" PRIx64, event.second.c_str(), event.first);
+        }
+    }
+
+    endBulk();
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::beginBulk(void)
+{
+    PfcWdActionHandler::beginBulk();
+    m_bulk = true;
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::endBulk(void)
+{
+    PfcWdActionHandler::endBulk();
+    m_bulk = false;
+
+    for (const auto &it : m_bulkStormState)
+    {
+        m_applTable->set(it.first, it.second);
+    }
+    m_bulkStormState.clear();
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::setStormState(const PfcWdQueueEntry &entry)
+{
+    if (m_bulk)
+    {
+        m_bulkStormState[entry.portAlias].emplace_back(to_string(entry.index), PFC_WD_IN_STORM);
+        return;
+    }
+
+    string key = m_applTable->getTableName() + m_applTable->getTableNameSeparator() + entry.portAlias;
+    m_applDb->hset(key, to_string(entry.index), PFC_WD_IN_STORM);
+}
+
 template <typename DropHandler, typename ForwardHandler>
 void PfcWdSwOrch<DropHandler, ForwardHandler>::report_pfc_storm(
         sai_object_id_t id, const PfcWdQueueEntry *entry, const string &info)
@@ -996,8 +1123,7 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::startWdActionOnQueue(const string
                         this->getCountersTable());
                 entry->second.handler->initCounters();
                 // Log storm event to APPL_DB for warm-reboot purpose
-                string key = m_applTable->getTableName() + m_applTable->getTableNameSeparator() + entry->second.portAlias;
-                m_applDb->hset(key, to_string(entry->second.index), PFC_WD_IN_STORM);
+                setStormState(entry->second);
             }
         }
         else if (entry->second.action == PfcWdAction::PFC_WD_ACTION_DROP)
@@ -1013,8 +1139,7 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::startWdActionOnQueue(const string
                         this->getCountersTable());
                 entry->second.handler->initCounters();
                 // Log storm event to APPL_DB for warm-reboot purpose
-                string key = m_applTable->getTableName() + m_applTable->getTableNameSeparator() + entry->second.portAlias;
-                m_applDb->hset(key, to_string(entry->second.index), PFC_WD_IN_STORM);
+                setStormState(entry->second);
             }
         }
         else if (entry->second.action == PfcWdAction::PFC_WD_ACTION_FORWARD)
@@ -1030,8 +1155,7 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::startWdActionOnQueue(const string
                         this->getCountersTable());
                 entry->second.handler->initCounters();
                 // Log storm event to APPL_DB for warm-reboot purpose
-                string key = m_applTable->getTableName() + m_applTable->getTableNameSeparator() + entry->second.portAlias;
-                m_applDb->hset(key, to_string(entry->second.index), PFC_WD_IN_STORM);
+                setStormState(entry->second);
             }
         }
         else
@@ -1064,6 +1188,11 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::startWdActionOnQueue(const string
         return false;
     }
 
+    if (m_detector)
+    {
+        m_detector->setStormed(entry->first, entry->second.handler != nullptr);
+    }
+
     return true;
 }
 
@@ -4,6 +4,7 @@
 #include "orch.h"
 #include "port.h"
 #include "pfcactionhandler.h"
+#include "pfcwddetect.h"
 #include "producertable.h"
 #include "notificationconsumer.h"
 #include "timer.h"
@@ -133,6 +134,13 @@ private:
     void setBigRedSwitchMode(string value);
 
     void report_pfc_storm(sai_object_id_t id, const PfcWdQueueEntry *, const string&);
+    void detectStorms(void);
+
+    // Apply the actions of the queues stormed between beginBulk() and
+    // endBulk() together, see PfcWdActionHandler::beginBulk()
+    void beginBulk(void);
+    void endBulk(void);
+    void setStormState(const PfcWdQueueEntry &entry);
 
     map<sai_object_id_t, PfcWdQueueEntry> m_entryMap;
     map<sai_object_id_t, PfcWdQueueEntry> m_brsEntryMap;
@@ -144,9 +152,17 @@ private:
     bool m_bigRedSwitchFlag = false;
     int m_pollInterval;
 
+    // Native storm detection, null when the Lua plugin of the platform is used
+    unique_ptr<PfcWdDetector> m_detector;
+    SelectableTimer *m_detectTimer = nullptr;
+
     shared_ptr<DBConnector> m_applDb = nullptr;
     // Track queues in storm
     shared_ptr<Table> m_applTable = nullptr;
+
+    bool m_bulk = false;
+    // Port alias -> storm state of its queues to write at the end of a bulk
+    map<string, vector<FieldValueTuple>> m_bulkStormState;
 };
 
 #endif
@@ -2,6 +2,8 @@
 #include "policerorch.h"
 
 #include "converter.h"
+#include "bulker.h"
+#include <deque>
 #include <inttypes.h>
 
 using namespace std;
@@ -11,6 +13,7 @@ extern sai_policer_api_t*   sai_policer_api;
 extern sai_port_api_t *sai_port_api;
 
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 extern PortsOrch* gPortsOrch;
 
 #define ETHERNET_PREFIX "Ethernet"
@@ -118,472 +121,887 @@ PolicerOrch::PolicerOrch(vector<TableConnector> &tableNames, PortsOrch *portOrch
     SWSS_LOG_ENTER();
 }
 
-task_process_status PolicerOrch::handlePortStormControlTable(swss::KeyOpFieldsValuesTuple tuple)
+void PolicerOrch::setStormControlPolicerSharing(bool enable)
 {
-    auto key = kfvKey(tuple);
-    auto op = kfvOp(tuple);
-    string storm_key = key;
-    auto tokens = tokenize(storm_key, config_db_key_delimiter);
-    auto interface_name = tokens[0];
-    auto storm_type = tokens[1];
-    Port port;
-
-    /*Only proceed for Ethernet interfaces*/
-    if (strncmp(interface_name.c_str(), ETHERNET_PREFIX, strlen(ETHERNET_PREFIX)))
-    {
-        SWSS_LOG_ERROR("%s: Unsupported / Invalid interface %s",
-                storm_type.c_str(), interface_name.c_str());
-        return task_process_status::task_success;
-    }
-    if (!gPortsOrch->getPort(interface_name, port))
+    SWSS_LOG_ENTER();
+
+    /* Set at startup, the policers in place aren't converted */
+    if (!m_stormControlBindings.empty() || !m_stormControlPolicers.empty())
     {
-        SWSS_LOG_ERROR("Failed to apply storm-control %s to port %s. Port not found",
-                storm_type.c_str(), interface_name.c_str());
-        /*continue here as there can be more interfaces*/
-        return task_process_status::task_success;
+        SWSS_LOG_WARN("Storm control policer sharing can't be changed once storm control is configured");
+        return;
     }
-    /*Policer Name: _<interface_name>_<storm_type>*/
-    const auto storm_policer_name = "_"+interface_name+"_"+storm_type;
 
-    if (op == SET_COMMAND)
+    m_shareStormControlPolicers = enable;
+    SWSS_LOG_NOTICE("Storm control policer sharing %s", enable ? "enabled" : "disabled");
+}
+
+/* Attributes of a POLICER entry, returns false when a mandatory one is missing */
+static bool getPolicerAttributes(const KeyOpFieldsValuesTuple &tuple, vector<sai_attribute_t> &attrs)
+{
+    bool meter_type = false, mode = false;
+
+    for (auto i = kfvFieldsValues(tuple).begin();
+            i != kfvFieldsValues(tuple).end(); ++i)
     {
-        // Mark the operation as an 'update', if the policer exists.
-        bool update = m_syncdPolicers.find(storm_policer_name) != m_syncdPolicers.end();
-        vector <sai_attribute_t> attrs;
-        bool cir = false;
+        auto field = to_upper(fvField(*i));
+        auto value = to_upper(fvValue(*i));
+
+        SWSS_LOG_DEBUG("attribute: %s value: %s", field.c_str(), value.c_str());
+
         sai_attribute_t attr;
 
-        /*Meter type hardcoded to BYTES*/
-        attr.id = SAI_POLICER_ATTR_METER_TYPE;
-        attr.value.s32 = (sai_meter_type_t) meter_type_map.at("BYTES");
-        attrs.push_back(attr);
+        if (field == meter_type_field)
+        {
+            attr.id = SAI_POLICER_ATTR_METER_TYPE;
+            attr.value.s32 = (sai_meter_type_t) meter_type_map.at(value);
+            meter_type = true;
+        }
+        else if (field == mode_field)
+        {
+            attr.id = SAI_POLICER_ATTR_MODE;
+            attr.value.s32 = (sai_policer_mode_t) policer_mode_map.at(value);
+            mode = true;
+        }
+        else if (field == color_source_field)
+        {
+            attr.id = SAI_POLICER_ATTR_COLOR_SOURCE;
+            attr.value.s32 = policer_color_source_map.at(value);
+        }
+        else if (field == cbs_field)
+        {
+            attr.id = SAI_POLICER_ATTR_CBS;
+            attr.value.u64 = stoul(value);
+        }
+        else if (field == cir_field)
+        {
+            attr.id = SAI_POLICER_ATTR_CIR;
+            attr.value.u64 = stoul(value);
+        }
+        else if (field == pbs_field)
+        {
+            attr.id = SAI_POLICER_ATTR_PBS;
+            attr.value.u64 = stoul(value);
+        }
+        else if (field == pir_field)
+        {
+            attr.id = SAI_POLICER_ATTR_PIR;
+            attr.value.u64 = stoul(value);
+        }
+        else if (field == red_packet_action_field)
+        {
+            attr.id = SAI_POLICER_ATTR_RED_PACKET_ACTION;
+            attr.value.s32 = packet_action_map.at(value);
+        }
+        else if (field == green_packet_action_field)
+        {
+            attr.id = SAI_POLICER_ATTR_GREEN_PACKET_ACTION;
+            attr.value.s32 = packet_action_map.at(value);
+        }
+        else if (field == yellow_packet_action_field)
+        {
+            attr.id = SAI_POLICER_ATTR_YELLOW_PACKET_ACTION;
+            attr.value.s32 = packet_action_map.at(value);
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Unknown policer attribute %s specified",
+                    field.c_str());
+            continue;
+        }
 
-        /*Policer mode hardcoded to STORM_CONTROL*/
-        attr.id = SAI_POLICER_ATTR_MODE;
-        attr.value.s32 = (sai_policer_mode_t) policer_mode_map.at("STORM_CONTROL");
         attrs.push_back(attr);
+    }
 
-        /*Red Packet Action hardcoded to DROP*/
-        attr.id = SAI_POLICER_ATTR_RED_PACKET_ACTION;
-        attr.value.s32 = packet_action_map.at("DROP");
-        attrs.push_back(attr);
+    return meter_type && mode;
+}
 
-        for (auto i = kfvFieldsValues(tuple).begin();
-                i != kfvFieldsValues(tuple).end(); ++i)
+/* A POLICER SET of the batch being applied */
+struct PolicerOp
+{
+    SyncMap::iterator task;
+    bool create;
+    sai_object_id_t policer_id;
+    vector<sai_attribute_t> attrs;
+    // One per attribute set on update, one for the creation
+    vector<sai_status_t> statuses;
+};
+
+/*
+ * The POLICER entries of the batch are removed with one bulk call, then
+ * created and updated with another. A DEL is ahead of the SET of its key
+ * in the batch, the policers of different keys don't depend on each other.
+ */
+void PolicerOrch::doPolicerTask(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    ObjectBulker<sai_policer_api_t> remover(sai_policer_api, gSwitchId, gMaxBulkSize);
+    vector<SyncMap::iterator> removing;
+    // Written by the bulker on flush, kept in place until then
+    deque<sai_status_t> remove_statuses;
+
+    auto it = consumer.m_toSync.begin();
+    while (it != consumer.m_toSync.end())
+    {
+        const auto &key = kfvKey(it->second);
+
+        if (kfvOp(it->second) != DEL_COMMAND)
         {
-            auto field = to_upper(fvField(*i));
-            auto value = to_upper(fvValue(*i));
+            it++;
+            continue;
+        }
 
-            /*BPS value is used as CIR*/
-            if (field == storm_control_kbps)
-            {
-                attr.id = SAI_POLICER_ATTR_CIR;
-                /*convert kbps to bps*/
-                attr.value.u64 = (stoul(value)*1000/8);
-                cir = true;
-                attrs.push_back(attr);
-                SWSS_LOG_DEBUG("CIR %s",value.c_str());
-            }
-            else
-            {
-                SWSS_LOG_ERROR("Unknown storm control attribute %s specified",
-                        field.c_str());
-                continue;
-            }
+        if (m_syncdPolicers.find(key) == m_syncdPolicers.end())
+        {
+            SWSS_LOG_ERROR("Policer %s does not exists", key.c_str());
+            it = consumer.m_toSync.erase(it);
+            continue;
         }
-        /*CIR is mandatory parameter*/
-        if (!cir)
+
+        if (m_policerRefCounts[key] > 0)
         {
-            SWSS_LOG_ERROR("Failed to create storm control policer %s,\
-                    missing mandatory fields", storm_policer_name.c_str());
-            return task_process_status::task_failed;
+            SWSS_LOG_INFO("Policer %s is still referenced", key.c_str());
+            it++;
+            continue;
         }
 
-        /*Enabling storm-control on port*/
-        sai_attribute_t port_attr;
-        if (storm_type == storm_broadcast)
+        remove_statuses.push_back(SAI_STATUS_NOT_EXECUTED);
+        remover.remove_entry(&remove_statuses.back(), m_syncdPolicers.at(key));
+        removing.push_back(it);
+        it++;
+    }
+
+    remover.flush();
+
+    for (size_t i = 0; i < removing.size(); i++)
+    {
+        auto task = removing[i];
+        const auto key = kfvKey(task->second);
+        sai_status_t status = remove_statuses[i];
+
+        if (is_bulk_unsupported(status))
         {
-            port_attr.id = SAI_PORT_ATTR_BROADCAST_STORM_CONTROL_POLICER_ID;
+            status = sai_policer_api->remove_policer(m_syncdPolicers.at(key));
         }
-        else if (storm_type == storm_unknown_unicast)
+
+        if (status != SAI_STATUS_SUCCESS)
         {
-            port_attr.id = SAI_PORT_ATTR_FLOOD_STORM_CONTROL_POLICER_ID;
+            SWSS_LOG_ERROR("Failed to remove policer %s, rv:%d",
+                    key.c_str(), status);
+            if (handleSaiRemoveStatus(SAI_API_POLICER, status) == task_need_retry)
+            {
+                continue;
+            }
         }
-        else if (storm_type == storm_unknown_mcast)
+
+        SWSS_LOG_NOTICE("Removed policer %s", key.c_str());
+        m_syncdPolicers.erase(key);
+        m_policerRefCounts.erase(key);
+        consumer.m_toSync.erase(task);
+    }
+
+    ObjectBulker<sai_policer_api_t> bulker(sai_policer_api, gSwitchId, gMaxBulkSize);
+    deque<PolicerOp> ops;
+
+    it = consumer.m_toSync.begin();
+    while (it != consumer.m_toSync.end())
+    {
+        const auto &key = kfvKey(it->second);
+
+        // A SET behind a DEL still waiting is handled once the DEL is done
+        if (kfvOp(it->second) != SET_COMMAND || consumer.m_toSync.find(key) != it)
         {
-            port_attr.id = SAI_PORT_ATTR_MULTICAST_STORM_CONTROL_POLICER_ID;
+            it++;
+            continue;
         }
-        else
+
+        vector<sai_attribute_t> attrs;
+        bool mandatory;
+        try
         {
-            SWSS_LOG_ERROR("Unknown storm_type %s", storm_type.c_str());
-            return task_process_status::task_failed;
+            mandatory = getPolicerAttributes(it->second, attrs);
+        }
+        catch (const std::exception &e)
+        {
+            SWSS_LOG_ERROR("Failed to parse policer %s: %s", key.c_str(), e.what());
+            it = consumer.m_toSync.erase(it);
+            continue;
         }
 
-        sai_object_id_t policer_id;
+        ops.emplace_back();
+        auto &op = ops.back();
+        op.task = it;
+        op.create = m_syncdPolicers.find(key) == m_syncdPolicers.end();
+        op.policer_id = SAI_NULL_OBJECT_ID;
+
         // Create a new policer
-        if (!update)
+        if (op.create)
         {
-            sai_status_t status = sai_policer_api->create_policer(
-                    &policer_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
-            if (status != SAI_STATUS_SUCCESS)
+            if (!mandatory)
             {
-                SWSS_LOG_ERROR("Failed to create policer %s, rv:%d",
-                        storm_policer_name.c_str(), status);
-                if (handleSaiCreateStatus(SAI_API_POLICER, status) == task_need_retry)
-                {
-                    return task_process_status::task_need_retry;
-                }
+                SWSS_LOG_ERROR("Failed to create policer %s,\
+                        missing mandatory fields", key.c_str());
             }
 
-            SWSS_LOG_DEBUG("Created storm-control policer %s", storm_policer_name.c_str());
-            m_syncdPolicers[storm_policer_name] = policer_id;
-            m_policerRefCounts[storm_policer_name] = 0;
+            op.attrs = attrs;
+            op.statuses.resize(1);
+            bulker.create_entry(&op.policer_id, &op.statuses[0],
+                                (uint32_t)op.attrs.size(), op.attrs.data());
         }
         // Update an existing policer
         else
         {
-            policer_id = m_syncdPolicers[storm_policer_name];
+            op.policer_id = m_syncdPolicers[key];
 
             // The update operation has limitations that it could only update
             // the rate and the size accordingly.
+            // SR_TCM: CIR, CBS, PBS
+            // TR_TCM: CIR, CBS, PIR, PBS
             // STORM_CONTROL: CIR, CBS
-            for (auto & attr: attrs)
+            for (auto &attr: attrs)
             {
-                if (attr.id != SAI_POLICER_ATTR_CIR)
+                if (attr.id == SAI_POLICER_ATTR_CBS ||
+                        attr.id == SAI_POLICER_ATTR_CIR ||
+                        attr.id == SAI_POLICER_ATTR_PBS ||
+                        attr.id == SAI_POLICER_ATTR_PIR)
                 {
-                    continue;
+                    op.attrs.push_back(attr);
                 }
+            }
 
-                sai_status_t status = sai_policer_api->set_policer_attribute(
-                        policer_id, &attr);
-                if (status != SAI_STATUS_SUCCESS)
-                {
-                    SWSS_LOG_ERROR("Failed to update policer %s attribute, rv:%d",
-                            storm_policer_name.c_str(), status);
-                    if (handleSaiSetStatus(SAI_API_POLICER, status) == task_need_retry)
-                    {
-                        return task_process_status::task_need_retry;
-                    }
-
-                }
+            op.statuses.resize(op.attrs.size());
+            for (size_t i = 0; i < op.attrs.size(); i++)
+            {
+                bulker.set_entry_attribute(&op.statuses[i], op.policer_id, &op.attrs[i]);
             }
         }
-        policer_id = m_syncdPolicers[storm_policer_name];
+        it++;
+    }
+
+    bulker.flush();
 
-        if (update)
+    for (auto &op : ops)
+    {
+        const auto key = kfvKey(op.task->second);
+        bool retry = false;
+
+        if (op.create)
         {
-            SWSS_LOG_NOTICE("update storm-control policer %s", storm_policer_name.c_str());
-            port_attr.value.oid = SAI_NULL_OBJECT_ID;
-            /*Remove and re-apply policer*/
-            sai_status_t status = sai_port_api->set_port_attribute(port.m_port_id, &port_attr);
+            sai_status_t status = op.statuses[0];
+            if (is_bulk_unsupported(status))
+            {
+                status = sai_policer_api->create_policer(
+                    &op.policer_id, gSwitchId, (uint32_t)op.attrs.size(), op.attrs.data());
+            }
+
             if (status != SAI_STATUS_SUCCESS)
             {
-                SWSS_LOG_ERROR("Failed to remove storm-control %s from port %s, rv:%d",
-                        storm_type.c_str(), interface_name.c_str(), status);
-                if (handleSaiSetStatus(SAI_API_POLICER, status) == task_need_retry)
+                SWSS_LOG_ERROR("Failed to create policer %s, rv:%d",
+                        key.c_str(), status);
+                if (handleSaiCreateStatus(SAI_API_POLICER, status) == task_need_retry)
                 {
-                    return task_process_status::task_need_retry;
+                    continue;
                 }
+                consumer.m_toSync.erase(op.task);
+                continue;
             }
-        }
-        port_attr.value.oid = policer_id;
 
-        sai_status_t status = sai_port_api->set_port_attribute(port.m_port_id, &port_attr);
-        if (status != SAI_STATUS_SUCCESS)
+            SWSS_LOG_NOTICE("Created policer %s", key.c_str());
+            m_syncdPolicers[key] = op.policer_id;
+            m_policerRefCounts[key] = 0;
+        }
+        else
         {
-            SWSS_LOG_ERROR("Failed to apply storm-control %s to port %s, rv:%d",
-                    storm_type.c_str(), interface_name.c_str(),status);
-
-            /*TODO: Do the below policer cleanup in an API*/
-            /*Remove the already created policer*/
-            if (SAI_STATUS_SUCCESS != sai_policer_api->remove_policer(
-                        m_syncdPolicers[storm_policer_name]))
+            for (size_t i = 0; i < op.attrs.size() && !retry; i++)
             {
-                SWSS_LOG_ERROR("Failed to remove policer %s, rv:%d",
-                        storm_policer_name.c_str(), status);
-                /*TODO: Just doing a syslog. */
+                sai_status_t status = op.statuses[i];
+                if (is_bulk_unsupported(status))
+                {
+                    status = sai_policer_api->set_policer_attribute(op.policer_id, &op.attrs[i]);
+                }
+
+                if (status != SAI_STATUS_SUCCESS)
+                {
+                    SWSS_LOG_ERROR("Failed to update policer %s attribute, rv:%d",
+                            key.c_str(), status);
+                    retry = handleSaiSetStatus(SAI_API_POLICER, status) == task_need_retry;
+                }
             }
 
-            SWSS_LOG_NOTICE("Removed policer %s as set_port_attribute for %s failed", 
-                    storm_policer_name.c_str(),interface_name.c_str());
-            m_syncdPolicers.erase(storm_policer_name);
-            m_policerRefCounts.erase(storm_policer_name);
+            if (retry)
+            {
+                continue;
+            }
 
-            return task_process_status::task_need_retry;
+            SWSS_LOG_NOTICE("Update policer %s attributes", key.c_str());
         }
+
+        consumer.m_toSync.erase(op.task);
     }
-    else if (op == DEL_COMMAND)
+}
+
+/* A storm control task of the batch being applied */
+struct StormControlOp
+{
+    SyncMap::iterator task;
+    string interface_name;
+    string storm_type;
+    /* Policer of the binding when not shared: _<interface_name>_<storm_type> */
+    string name;
+    bool add;
+    sai_object_id_t port_id;
+    /* The storm control policer attribute of the port */
+    sai_attr_id_t port_attr_id;
+    uint64_t cir;
+    vector<sai_attribute_t> attrs;
+
+    /* Policer bound to the port by the task */
+    sai_object_id_t policer_id = SAI_NULL_OBJECT_ID;
+    /* Not shared: policer created, or updated in place and bound again */
+    bool create = false;
+    bool update = false;
+    /* The port is unbound before being bound again or released */
+    bool unbind = false;
+
+    sai_status_t policer_status = SAI_STATUS_NOT_EXECUTED;
+    sai_status_t unbind_status = SAI_STATUS_NOT_EXECUTED;
+    sai_status_t bind_status = SAI_STATUS_NOT_EXECUTED;
+    sai_status_t remove_status = SAI_STATUS_NOT_EXECUTED;
+    /* Policer removed with the binding, not shared */
+    bool remove = false;
+    bool retry = false;
+    bool done = false;
+};
+
+/* A shared storm control policer created by the batch */
+struct StormControlPolicerCreate
+{
+    vector<sai_attribute_t> attrs;
+    sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+    sai_status_t status = SAI_STATUS_NOT_EXECUTED;
+};
+
+static sai_status_t setPortAttribute(sai_object_id_t port_id, sai_attr_id_t id, sai_object_id_t oid)
+{
+    sai_attribute_t attr;
+    attr.id = id;
+    attr.value.oid = oid;
+    return sai_port_api->set_port_attribute(port_id, &attr);
+}
+
+/*
+ * The storm control bindings of the batch are applied in bulk steps: the
+ * policers are created and updated, the ports being updated or cleared are
+ * unbound, the ports are bound, then the policers left unused are removed.
+ * With sharing, the bindings of one rate use one policer, counted by its
+ * bindings and removed with the last of them.
+ *
+ * The syslog of the storm control tests is matched on this function name.
+ */
+void PolicerOrch::handlePortStormControlTable(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    deque<StormControlOp> ops;
+    map<uint64_t, StormControlPolicerCreate> creates;
+    ObjectBulker<sai_policer_api_t> policerBulker(sai_policer_api, gSwitchId, gMaxBulkSize);
+
+    auto it = consumer.m_toSync.begin();
+    while (it != consumer.m_toSync.end())
     {
-        if (m_syncdPolicers.find(storm_policer_name) == m_syncdPolicers.end())
+        const auto &tuple = it->second;
+        auto key = kfvKey(tuple);
+        auto op = kfvOp(tuple);
+
+        // A SET behind a DEL of its key is handled once the DEL is done
+        if (consumer.m_toSync.find(it->first) != it)
+        {
+            it++;
+            continue;
+        }
+
+        auto tokens = tokenize(key, config_db_key_delimiter);
+        if (tokens.size() < 2)
         {
-            SWSS_LOG_ERROR("Policer %s not configured", storm_policer_name.c_str());
-            return task_process_status::task_success;
+            SWSS_LOG_ERROR("Invalid storm control key %s", key.c_str());
+            it = consumer.m_toSync.erase(it);
+            continue;
+        }
+        auto interface_name = tokens[0];
+        auto storm_type = tokens[1];
+        Port port;
+
+        /*Only proceed for Ethernet interfaces*/
+        if (strncmp(interface_name.c_str(), ETHERNET_PREFIX, strlen(ETHERNET_PREFIX)))
+        {
+            SWSS_LOG_ERROR("%s: Unsupported / Invalid interface %s",
+                    storm_type.c_str(), interface_name.c_str());
+            it = consumer.m_toSync.erase(it);
+            continue;
+        }
+        if (!gPortsOrch->getPort(interface_name, port))
+        {
+            SWSS_LOG_ERROR("Failed to apply storm-control %s to port %s. Port not found",
+                    storm_type.c_str(), interface_name.c_str());
+            /*continue here as there can be more interfaces*/
+            it = consumer.m_toSync.erase(it);
+            continue;
         }
 
-        sai_attribute_t port_attr;
+        sai_attr_id_t port_attr_id;
         if (storm_type == storm_broadcast)
         {
-            port_attr.id = SAI_PORT_ATTR_BROADCAST_STORM_CONTROL_POLICER_ID;
+            port_attr_id = SAI_PORT_ATTR_BROADCAST_STORM_CONTROL_POLICER_ID;
         }
         else if (storm_type == storm_unknown_unicast)
         {
-            port_attr.id = SAI_PORT_ATTR_FLOOD_STORM_CONTROL_POLICER_ID;
+            port_attr_id = SAI_PORT_ATTR_FLOOD_STORM_CONTROL_POLICER_ID;
         }
         else if (storm_type == storm_unknown_mcast)
         {
-            port_attr.id = SAI_PORT_ATTR_MULTICAST_STORM_CONTROL_POLICER_ID;
+            port_attr_id = SAI_PORT_ATTR_MULTICAST_STORM_CONTROL_POLICER_ID;
         }
         else
         {
             SWSS_LOG_ERROR("Unknown storm_type %s", storm_type.c_str());
-            return task_process_status::task_failed;
+            it = consumer.m_toSync.erase(it);
+            continue;
         }
 
-        port_attr.value.oid = SAI_NULL_OBJECT_ID;
+        /*Policer Name: _<interface_name>_<storm_type>*/
+        const auto storm_policer_name = "_"+interface_name+"_"+storm_type;
+        auto binding = m_stormControlBindings.find(storm_policer_name);
+        bool unshared = m_syncdPolicers.find(storm_policer_name) != m_syncdPolicers.end();
+
+        StormControlOp sc;
+        sc.task = it;
+        sc.interface_name = interface_name;
+        sc.storm_type = storm_type;
+        sc.name = storm_policer_name;
+        sc.add = op == SET_COMMAND;
+        sc.port_id = port.m_port_id;
+        sc.port_attr_id = port_attr_id;
+        sc.cir = 0;
+
+        if (!sc.add)
+        {
+            if (binding == m_stormControlBindings.end() && !unshared)
+            {
+                SWSS_LOG_ERROR("Policer %s not configured", storm_policer_name.c_str());
+                it = consumer.m_toSync.erase(it);
+                continue;
+            }
 
-        sai_status_t status = sai_port_api->set_port_attribute(port.m_port_id, &port_attr);
-        if (status != SAI_STATUS_SUCCESS)
+            sc.unbind = true;
+            ops.push_back(sc);
+            it++;
+            continue;
+        }
+
+        bool cir = false;
+        sai_attribute_t attr;
+
+        /*Meter type hardcoded to BYTES*/
+        attr.id = SAI_POLICER_ATTR_METER_TYPE;
+        attr.value.s32 = (sai_meter_type_t) meter_type_map.at("BYTES");
+        sc.attrs.push_back(attr);
+
+        /*Policer mode hardcoded to STORM_CONTROL*/
+        attr.id = SAI_POLICER_ATTR_MODE;
+        attr.value.s32 = (sai_policer_mode_t) policer_mode_map.at("STORM_CONTROL");
+        sc.attrs.push_back(attr);
+
+        /*Red Packet Action hardcoded to DROP*/
+        attr.id = SAI_POLICER_ATTR_RED_PACKET_ACTION;
+        attr.value.s32 = packet_action_map.at("DROP");
+        sc.attrs.push_back(attr);
+
+        for (auto i = kfvFieldsValues(tuple).begin();
+                i != kfvFieldsValues(tuple).end(); ++i)
         {
-            SWSS_LOG_ERROR("Failed to remove storm-control %s from port %s, rv:%d",
-                    storm_type.c_str(), interface_name.c_str(), status);
-            if (handleSaiRemoveStatus(SAI_API_POLICER, status) == task_need_retry)
+            auto field = to_upper(fvField(*i));
+            auto value = to_upper(fvValue(*i));
+
+            /*BPS value is used as CIR*/
+            if (field == storm_control_kbps)
             {
-                return task_process_status::task_need_retry;
+                attr.id = SAI_POLICER_ATTR_CIR;
+                /*convert kbps to bps*/
+                attr.value.u64 = (stoul(value)*1000/8);
+                sc.cir = attr.value.u64;
+                cir = true;
+                sc.attrs.push_back(attr);
+                SWSS_LOG_DEBUG("CIR %s",value.c_str());
             }
+            else
+            {
+                SWSS_LOG_ERROR("Unknown storm control attribute %s specified",
+                        field.c_str());
+                continue;
+            }
+        }
+        /*CIR is mandatory parameter*/
+        if (!cir)
+        {
+            SWSS_LOG_ERROR("Failed to create storm control policer %s,\
+                    missing mandatory fields", storm_policer_name.c_str());
+            it = consumer.m_toSync.erase(it);
+            continue;
         }
 
-        status = sai_policer_api->remove_policer(
-                m_syncdPolicers[storm_policer_name]);
-        if (status != SAI_STATUS_SUCCESS)
+        if (m_shareStormControlPolicers)
         {
-            SWSS_LOG_ERROR("Failed to remove policer %s, rv:%d",
-                    storm_policer_name.c_str(), status);
-            if (handleSaiRemoveStatus(SAI_API_POLICER, status) == task_need_retry)
+            if (binding != m_stormControlBindings.end() && binding->second == sc.cir)
             {
-                return task_process_status::task_need_retry;
+                SWSS_LOG_INFO("Storm-control %s on port %s is unchanged",
+                        storm_type.c_str(), interface_name.c_str());
+                it = consumer.m_toSync.erase(it);
+                continue;
+            }
+
+            // The policer of the rate is bound, no need to clear the port first
+            auto pooled = m_stormControlPolicers.find(sc.cir);
+            if (pooled != m_stormControlPolicers.end())
+            {
+                sc.policer_id = pooled->second.oid;
+            }
+            else if (creates.find(sc.cir) == creates.end())
+            {
+                auto &create = creates[sc.cir];
+                create.attrs = sc.attrs;
+                policerBulker.create_entry(&create.oid, &create.status,
+                                           (uint32_t)create.attrs.size(), create.attrs.data());
             }
         }
+        else if (unshared)
+        {
+            // The update operation has limitations that it could only update
+            // the rate and the size accordingly.
+            // STORM_CONTROL: CIR, CBS
+            SWSS_LOG_NOTICE("update storm-control policer %s", storm_policer_name.c_str());
+            sc.update = true;
+            sc.unbind = true;
+            sc.policer_id = m_syncdPolicers[storm_policer_name];
+            ops.push_back(sc);
+            auto &queued = ops.back();
+            policerBulker.set_entry_attribute(&queued.policer_status, queued.policer_id, &queued.attrs.back());
+            it++;
+            continue;
+        }
+        else
+        {
+            sc.create = true;
+            ops.push_back(sc);
+            auto &queued = ops.back();
+            policerBulker.create_entry(&queued.policer_id, &queued.policer_status,
+                                       (uint32_t)queued.attrs.size(), queued.attrs.data());
+            it++;
+            continue;
+        }
 
-        SWSS_LOG_NOTICE("Removed policer %s", storm_policer_name.c_str());
-        m_syncdPolicers.erase(storm_policer_name);
-        m_policerRefCounts.erase(storm_policer_name);
+        ops.push_back(sc);
+        it++;
     }
-    return task_process_status::task_success;
-}
-
-void PolicerOrch::doTask(Consumer &consumer)
-{
-    SWSS_LOG_ENTER();
-    task_process_status storm_status = task_success;
 
-    if (!gPortsOrch->allPortsReady())
+    if (ops.empty())
     {
         return;
     }
 
-    auto it = consumer.m_toSync.begin();
-    while (it != consumer.m_toSync.end())
+    policerBulker.flush();
+
+    for (auto &create : creates)
     {
-        auto tuple = it->second;
+        if (is_bulk_unsupported(create.second.status))
+        {
+            create.second.status = sai_policer_api->create_policer(&create.second.oid, gSwitchId,
+                    (uint32_t)create.second.attrs.size(), create.second.attrs.data());
+        }
 
-        auto key = kfvKey(tuple);
-        auto op = kfvOp(tuple);
-        auto table_name = consumer.getTableName();
+        if (create.second.status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create storm-control policer for CIR %" PRIu64 ", rv:%d",
+                    create.first, create.second.status);
+            continue;
+        }
+
+        SWSS_LOG_NOTICE("Created storm-control policer for CIR %" PRIu64, create.first);
+        m_stormControlPolicers[create.first] = { create.second.oid, 0 };
+    }
 
-        // Special handling for storm-control configuration.
-        if (table_name == CFG_PORT_STORM_CONTROL_TABLE_NAME)
+    // Outcome of the policers, the ports are unbound
+    ObjectBulker<sai_port_api_t> unbinder(sai_port_api, gSwitchId, gMaxBulkSize);
+    for (auto &sc : ops)
+    {
+        if (sc.add && m_shareStormControlPolicers)
         {
-            storm_status = handlePortStormControlTable(tuple);
-            if ((storm_status == task_process_status::task_success) ||
-                    (storm_status == task_process_status::task_failed))
-            {
-                it = consumer.m_toSync.erase(it);
-            }
-            else
+            if (sc.policer_id == SAI_NULL_OBJECT_ID)
             {
-                it++;
+                auto &create = creates.at(sc.cir);
+                if (create.status != SAI_STATUS_SUCCESS)
+                {
+                    sc.retry = handleSaiCreateStatus(SAI_API_POLICER, create.status) == task_need_retry;
+                    sc.done = !sc.retry;
+                    continue;
+                }
+                sc.policer_id = create.oid;
             }
-            continue;
         }
-        if (op == SET_COMMAND)
+        else if (sc.create)
         {
-            // Mark the operation as an 'update', if the policer exists.
-            bool update = m_syncdPolicers.find(key) != m_syncdPolicers.end();
-
-            vector<sai_attribute_t> attrs;
-            bool meter_type = false, mode = false;
-
-            for (auto i = kfvFieldsValues(tuple).begin();
-                    i != kfvFieldsValues(tuple).end(); ++i)
+            if (is_bulk_unsupported(sc.policer_status))
             {
-                auto field = to_upper(fvField(*i));
-                auto value = to_upper(fvValue(*i));
+                sc.policer_status = sai_policer_api->create_policer(&sc.policer_id, gSwitchId,
+                        (uint32_t)sc.attrs.size(), sc.attrs.data());
+            }
 
-                SWSS_LOG_DEBUG("attribute: %s value: %s", field.c_str(), value.c_str());
+            if (sc.policer_status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to create policer %s, rv:%d",
+                        sc.name.c_str(), sc.policer_status);
+                sc.retry = handleSaiCreateStatus(SAI_API_POLICER, sc.policer_status) == task_need_retry;
+                sc.done = !sc.retry;
+                continue;
+            }
 
-                sai_attribute_t attr;
+            SWSS_LOG_DEBUG("Created storm-control policer %s", sc.name.c_str());
+            m_syncdPolicers[sc.name] = sc.policer_id;
+            m_policerRefCounts[sc.name] = 0;
+        }
+        else if (sc.update)
+        {
+            if (is_bulk_unsupported(sc.policer_status))
+            {
+                sc.policer_status = sai_policer_api->set_policer_attribute(sc.policer_id, &sc.attrs.back());
+            }
 
-                if (field == meter_type_field)
-                {
-                    attr.id = SAI_POLICER_ATTR_METER_TYPE;
-                    attr.value.s32 = (sai_meter_type_t) meter_type_map.at(value);
-                    meter_type = true;
-                }
-                else if (field == mode_field)
-                {
-                    attr.id = SAI_POLICER_ATTR_MODE;
-                    attr.value.s32 = (sai_policer_mode_t) policer_mode_map.at(value);
-                    mode = true;
-                }
-                else if (field == color_source_field)
-                {
-                    attr.id = SAI_POLICER_ATTR_COLOR_SOURCE;
-                    attr.value.s32 = policer_color_source_map.at(value);
-                }
-                else if (field == cbs_field)
-                {
-                    attr.id = SAI_POLICER_ATTR_CBS;
-                    attr.value.u64 = stoul(value);
-                }
-                else if (field == cir_field)
-                {
-                    attr.id = SAI_POLICER_ATTR_CIR;
-                    attr.value.u64 = stoul(value);
-                }
-                else if (field == pbs_field)
-                {
-                    attr.id = SAI_POLICER_ATTR_PBS;
-                    attr.value.u64 = stoul(value);
-                }
-                else if (field == pir_field)
-                {
-                    attr.id = SAI_POLICER_ATTR_PIR;
-                    attr.value.u64 = stoul(value);
-                }
-                else if (field == red_packet_action_field)
-                {
-                    attr.id = SAI_POLICER_ATTR_RED_PACKET_ACTION;
-                    attr.value.s32 = packet_action_map.at(value);
-                }
-                else if (field == green_packet_action_field)
-                {
-                    attr.id = SAI_POLICER_ATTR_GREEN_PACKET_ACTION;
-                    attr.value.s32 = packet_action_map.at(value);
-                }
-                else if (field == yellow_packet_action_field)
-                {
-                    attr.id = SAI_POLICER_ATTR_YELLOW_PACKET_ACTION;
-                    attr.value.s32 = packet_action_map.at(value);
-                }
-                else
+            if (sc.policer_status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to update policer %s attribute, rv:%d",
+                        sc.name.c_str(), sc.policer_status);
+                if (handleSaiSetStatus(SAI_API_POLICER, sc.policer_status) == task_need_retry)
                 {
-                    SWSS_LOG_ERROR("Unknown policer attribute %s specified",
-                            field.c_str());
+                    sc.retry = true;
                     continue;
                 }
+            }
+        }
+
+        if (sc.unbind)
+        {
+            sai_attribute_t attr;
+            attr.id = sc.port_attr_id;
+            attr.value.oid = SAI_NULL_OBJECT_ID;
+            unbinder.set_entry_attribute(&sc.unbind_status, sc.port_id, &attr);
+        }
+    }
 
-                attrs.push_back(attr);
+    unbinder.flush();
+
+    // The ports are bound
+    ObjectBulker<sai_port_api_t> binder(sai_port_api, gSwitchId, gMaxBulkSize);
+    for (auto &sc : ops)
+    {
+        if (sc.retry || sc.done)
+        {
+            continue;
+        }
+
+        if (sc.unbind)
+        {
+            if (is_bulk_unsupported(sc.unbind_status))
+            {
+                sc.unbind_status = setPortAttribute(sc.port_id, sc.port_attr_id, SAI_NULL_OBJECT_ID);
             }
 
-            // Create a new policer
-            if (!update)
+            if (sc.unbind_status != SAI_STATUS_SUCCESS)
             {
-                if (!meter_type || !mode)
+                SWSS_LOG_ERROR("Failed to remove storm-control %s from port %s, rv:%d",
+                        sc.storm_type.c_str(), sc.interface_name.c_str(), sc.unbind_status);
+                task_process_status handle_status = sc.add ?
+                    handleSaiSetStatus(SAI_API_POLICER, sc.unbind_status) :
+                    handleSaiRemoveStatus(SAI_API_POLICER, sc.unbind_status);
+                if (handle_status == task_need_retry)
                 {
-                    SWSS_LOG_ERROR("Failed to create policer %s,\
-                            missing mandatory fields", key.c_str());
+                    sc.retry = true;
+                    continue;
                 }
+            }
+        }
 
-                sai_object_id_t policer_id;
-                sai_status_t status = sai_policer_api->create_policer(
-                    &policer_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
-                if (status != SAI_STATUS_SUCCESS)
-                {
-                    SWSS_LOG_ERROR("Failed to create policer %s, rv:%d",
-                            key.c_str(), status);
-                    if (handleSaiCreateStatus(SAI_API_POLICER, status) == task_need_retry)
-                    {
-                        it++;
-                        continue;
-                    }
-                }
+        if (sc.add)
+        {
+            sai_attribute_t attr;
+            attr.id = sc.port_attr_id;
+            attr.value.oid = sc.policer_id;
+            binder.set_entry_attribute(&sc.bind_status, sc.port_id, &attr);
+        }
+    }
+
+    binder.flush();
+
+    // The bindings are recorded, the policers left unused are removed
+    ObjectBulker<sai_policer_api_t> remover(sai_policer_api, gSwitchId, gMaxBulkSize);
+    // Shared policers no longer bound, released once all bindings are counted
+    vector<uint64_t> releases;
 
-                SWSS_LOG_NOTICE("Created policer %s", key.c_str());
-                m_syncdPolicers[key] = policer_id;
-                m_policerRefCounts[key] = 0;
+    for (auto &sc : ops)
+    {
+        if (sc.retry || sc.done)
+        {
+            continue;
+        }
+
+        if (!sc.add)
+        {
+            auto binding = m_stormControlBindings.find(sc.name);
+            if (binding != m_stormControlBindings.end())
+            {
+                releases.push_back(binding->second);
+                m_stormControlBindings.erase(binding);
+                SWSS_LOG_NOTICE("Removed storm-control %s from port %s",
+                        sc.storm_type.c_str(), sc.interface_name.c_str());
             }
-            // Update an existing policer
             else
             {
-                auto policer_id = m_syncdPolicers[key];
-
-                // The update operation has limitations that it could only update
-                // the rate and the size accordingly.
-                // SR_TCM: CIR, CBS, PBS
-                // TR_TCM: CIR, CBS, PIR, PBS
-                // STORM_CONTROL: CIR, CBS
-                for (auto & attr: attrs)
-                {
-                    if (attr.id != SAI_POLICER_ATTR_CBS &&
-                            attr.id != SAI_POLICER_ATTR_CIR &&
-                            attr.id != SAI_POLICER_ATTR_PBS &&
-                            attr.id != SAI_POLICER_ATTR_PIR)
-                    {
-                        continue;
-                    }
-
-                    sai_status_t status = sai_policer_api->set_policer_attribute(
-                            policer_id, &attr);
-                    if (status != SAI_STATUS_SUCCESS)
-                    {
-                        SWSS_LOG_ERROR("Failed to update policer %s attribute, rv:%d",
-                                key.c_str(), status);
-                        if (handleSaiSetStatus(SAI_API_POLICER, status) == task_need_retry)
-                        {
-                            it++;
-                            continue;
-                        }
-                    }
-                }
-
-                SWSS_LOG_NOTICE("Update policer %s attributes", key.c_str());
+                sc.remove = true;
+                remover.remove_entry(&sc.remove_status, m_syncdPolicers[sc.name]);
             }
+            continue;
+        }
 
-            it = consumer.m_toSync.erase(it);
+        if (is_bulk_unsupported(sc.bind_status))
+        {
+            sc.bind_status = setPortAttribute(sc.port_id, sc.port_attr_id, sc.policer_id);
         }
-        else if (op == DEL_COMMAND)
+
+        if (sc.bind_status != SAI_STATUS_SUCCESS)
         {
-            if (m_syncdPolicers.find(key) == m_syncdPolicers.end())
+            SWSS_LOG_ERROR("Failed to apply storm-control %s to port %s, rv:%d",
+                    sc.storm_type.c_str(), sc.interface_name.c_str(), sc.bind_status);
+            sc.retry = true;
+
+            if (!m_shareStormControlPolicers)
             {
-                SWSS_LOG_ERROR("Policer %s does not exists", key.c_str());
-                it = consumer.m_toSync.erase(it);
-                continue;
+                /*Remove the already created policer*/
+                sc.remove = true;
+                remover.remove_entry(&sc.remove_status, m_syncdPolicers[sc.name]);
             }
+            continue;
+        }
 
-            if (m_policerRefCounts[key] > 0)
+        if (m_shareStormControlPolicers)
+        {
+            m_stormControlPolicers[sc.cir].ref_count++;
+            auto binding = m_stormControlBindings.find(sc.name);
+            if (binding != m_stormControlBindings.end())
             {
-                SWSS_LOG_INFO("Policer %s is still referenced", key.c_str());
-                it++;
-                continue;
+                releases.push_back(binding->second);
             }
+            m_stormControlBindings[sc.name] = sc.cir;
+        }
+        SWSS_LOG_INFO("Applied storm-control %s to port %s",
+                sc.storm_type.c_str(), sc.interface_name.c_str());
+    }
 
-            sai_status_t status = sai_policer_api->remove_policer(
-                    m_syncdPolicers.at(key));
-            if (status != SAI_STATUS_SUCCESS)
+    for (auto cir : releases)
+    {
+        m_stormControlPolicers[cir].ref_count--;
+    }
+
+    // Shared policers left unbound, including those created for bindings which all failed
+    map<uint64_t, sai_status_t> released;
+    auto sweep = [&](uint64_t cir)
+    {
+        auto pooled = m_stormControlPolicers.find(cir);
+        if (pooled != m_stormControlPolicers.end() && pooled->second.ref_count == 0 &&
+                released.find(cir) == released.end())
+        {
+            auto &status = released[cir];
+            status = SAI_STATUS_NOT_EXECUTED;
+            remover.remove_entry(&status, pooled->second.oid);
+        }
+    };
+    for (auto cir : releases)
+    {
+        sweep(cir);
+    }
+    for (const auto &create : creates)
+    {
+        sweep(create.first);
+    }
+
+    remover.flush();
+
+    for (auto &r : released)
+    {
+        auto pooled = m_stormControlPolicers.find(r.first);
+        if (is_bulk_unsupported(r.second))
+        {
+            r.second = sai_policer_api->remove_policer(pooled->second.oid);
+        }
+
+        if (r.second != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove storm-control policer for CIR %" PRIu64 ", rv:%d",
+                    r.first, r.second);
+            /*TODO: Just doing a syslog. */
+        }
+        else
+        {
+            SWSS_LOG_NOTICE("Removed storm-control policer for CIR %" PRIu64, r.first);
+        }
+        m_stormControlPolicers.erase(pooled);
+    }
+
+    for (auto &sc : ops)
+    {
+        if (sc.remove)
+        {
+            if (is_bulk_unsupported(sc.remove_status))
+            {
+                sc.remove_status = sai_policer_api->remove_policer(m_syncdPolicers[sc.name]);
+            }
+
+            if (sc.remove_status != SAI_STATUS_SUCCESS)
             {
                 SWSS_LOG_ERROR("Failed to remove policer %s, rv:%d",
-                        key.c_str(), status);
-                if (handleSaiRemoveStatus(SAI_API_POLICER, status) == task_need_retry)
+                        sc.name.c_str(), sc.remove_status);
+                if (!sc.add && handleSaiRemoveStatus(SAI_API_POLICER, sc.remove_status) == task_need_retry)
                 {
-                    it++;
+                    sc.retry = true;
                     continue;
                 }
             }
 
-            SWSS_LOG_NOTICE("Removed policer %s", key.c_str());
-            m_syncdPolicers.erase(key);
-            m_policerRefCounts.erase(key);
-            it = consumer.m_toSync.erase(it);
+            SWSS_LOG_NOTICE("Removed policer %s", sc.name.c_str());
+            m_syncdPolicers.erase(sc.name);
+            m_policerRefCounts.erase(sc.name);
+        }
+
+        if (!sc.retry)
+        {
+            consumer.m_toSync.erase(sc.task);
         }
     }
 }
+
+void PolicerOrch::doTask(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    if (!gPortsOrch->allPortsReady())
+    {
+        return;
+    }
+
+    // Special handling for storm-control configuration.
+    if (consumer.getTableName() == CFG_PORT_STORM_CONTROL_TABLE_NAME)
+    {
+        handlePortStormControlTable(consumer);
+        return;
+    }
+
+    doPolicerTask(consumer);
+}
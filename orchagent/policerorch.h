@@ -11,6 +11,16 @@ using namespace std;
 typedef map<string, sai_object_id_t> PolicerTable;
 typedef map<string, int> PolicerRefCountTable;
 
+/* A storm control policer shared by the storm control bindings of one rate */
+struct StormControlPolicer
+{
+    sai_object_id_t oid;
+    int ref_count;
+};
+
+/* Shared storm control policers by CIR, in bytes per second */
+typedef map<uint64_t, StormControlPolicer> StormControlPolicerPool;
+
 class PolicerOrch : public Orch
 {
 public:
@@ -21,13 +31,26 @@ public:
 
     bool increaseRefCount(const string &name);
     bool decreaseRefCount(const string &name);
-    task_process_status handlePortStormControlTable(swss::KeyOpFieldsValuesTuple tuple);
+
+    /*
+     * Let the storm control bindings of one rate share one policer. Only for
+     * platforms metering each port bound to a policer on its own, to be set
+     * before any storm control is configured.
+     */
+    void setStormControlPolicerSharing(bool enable);
 private:
     PortsOrch *m_portsOrch;
     virtual void doTask(Consumer& consumer);
+    void doPolicerTask(Consumer& consumer);
+    void handlePortStormControlTable(Consumer& consumer);
 
     PolicerTable m_syncdPolicers;
     PolicerRefCountTable m_policerRefCounts;
+
+    bool m_shareStormControlPolicers = false;
+    StormControlPolicerPool m_stormControlPolicers;
+    /* CIR of the shared policer of each storm control binding, by policer name */
+    map<string, uint64_t> m_stormControlBindings;
 };
 
 
@@ -10,6 +10,7 @@ extern "C" {
 #include <logger.h>
 
 #include "port_capabilities.h"
+#include "saicapabilitycache.h"
 
 using namespace swss;
 
@@ -48,7 +49,7 @@ bool PortCapabilities::isPortPfcAsymSupported() const
 
 sai_status_t PortCapabilities::queryAttrCapabilitiesSai(sai_attr_capability_t &attrCap, sai_object_type_t objType, sai_attr_id_t attrId) const
 {
-    return sai_query_attribute_capability(gSwitchId, objType, attrId, &attrCap);
+    return querySaiAttributeCapability(gSwitchId, objType, attrId, &attrCap);
 }
 
 template<typename T>
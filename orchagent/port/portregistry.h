@@ -0,0 +1,164 @@
+#pragma once
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "port.h"
+
+/*
+ * Ports by alias, a std::map with hash indices on top of it.
+ *
+ * The map keeps the alias order getAllPorts() callers iterate in and the
+ * node stability findPort() relies on, lookups by alias go through a hash
+ * index of the map nodes instead of walking the tree. OIDs and bridge port
+ * OIDs are resolved to aliases by PortsOrch::saiOidToAlias.
+ *
+ * VLANs are also indexed by VLAN ID. Ports are assigned in place through
+ * operator[], so a VLAN is indexed with indexVlan() once its ID is set. An
+ * entry is checked against the stored VLAN on lookup and dropped on erase(),
+ * a VLAN missing from the index is looked up by a scan and indexed then.
+ */
+class PortRegistry
+{
+public:
+    using container_type = std::map<std::string, swss::Port>;
+    using iterator = container_type::iterator;
+    using const_iterator = container_type::const_iterator;
+
+    swss::Port &operator[](const std::string &alias)
+    {
+        auto it = m_aliasIndex.find(alias);
+        if (it != m_aliasIndex.end())
+        {
+            return it->second->second;
+        }
+
+        auto node = m_ports.emplace(alias, swss::Port()).first;
+        m_aliasIndex.emplace(alias, node);
+        return node->second;
+    }
+
+    swss::Port &at(const std::string &alias)
+    {
+        auto it = find(alias);
+        if (it == end())
+        {
+            throw std::out_of_range("PortRegistry::at " + alias);
+        }
+        return it->second;
+    }
+
+    const swss::Port &at(const std::string &alias) const
+    {
+        auto it = find(alias);
+        if (it == end())
+        {
+            throw std::out_of_range("PortRegistry::at " + alias);
+        }
+        return it->second;
+    }
+
+    iterator find(const std::string &alias)
+    {
+        auto it = m_aliasIndex.find(alias);
+        return it == m_aliasIndex.end() ? m_ports.end() : it->second;
+    }
+
+    const_iterator find(const std::string &alias) const
+    {
+        auto it = m_aliasIndex.find(alias);
+        return it == m_aliasIndex.end() ? m_ports.cend() : const_iterator(it->second);
+    }
+
+    size_t count(const std::string &alias) const
+    {
+        return m_aliasIndex.count(alias);
+    }
+
+    iterator erase(iterator it)
+    {
+        unindex(it);
+        return m_ports.erase(it);
+    }
+
+    size_t erase(const std::string &alias)
+    {
+        auto it = find(alias);
+        if (it == end())
+        {
+            return 0;
+        }
+
+        erase(it);
+        return 1;
+    }
+
+    void clear()
+    {
+        m_ports.clear();
+        m_aliasIndex.clear();
+        m_vlanIndex.clear();
+    }
+
+    /* Index the VLAN stored as alias by its current VLAN ID */
+    void indexVlan(const std::string &alias)
+    {
+        auto it = find(alias);
+        if (it != end() && it->second.m_type == swss::Port::VLAN)
+        {
+            m_vlanIndex[it->second.m_vlan_info.vlan_id] = it;
+        }
+    }
+
+    iterator findVlan(sai_vlan_id_t vlan_id)
+    {
+        auto it = m_vlanIndex.find(vlan_id);
+        if (it != m_vlanIndex.end() && isVlan(it->second->second, vlan_id))
+        {
+            return it->second;
+        }
+
+        // Not indexed, or no longer this VLAN, found the slow way once
+        for (auto port = m_ports.begin(); port != m_ports.end(); port++)
+        {
+            if (isVlan(port->second, vlan_id))
+            {
+                m_vlanIndex[vlan_id] = port;
+                return port;
+            }
+        }
+        return end();
+    }
+
+    iterator begin() { return m_ports.begin(); }
+    iterator end() { return m_ports.end(); }
+    const_iterator begin() const { return m_ports.begin(); }
+    const_iterator end() const { return m_ports.end(); }
+    size_t size() const { return m_ports.size(); }
+    bool empty() const { return m_ports.empty(); }
+
+    container_type &ports() { return m_ports; }
+
+private:
+    static bool isVlan(const swss::Port &port, sai_vlan_id_t vlan_id)
+    {
+        return port.m_type == swss::Port::VLAN && port.m_vlan_info.vlan_id == vlan_id;
+    }
+
+    void unindex(iterator it)
+    {
+        m_aliasIndex.erase(it->first);
+
+        auto vlan = m_vlanIndex.find(it->second.m_vlan_info.vlan_id);
+        if (vlan != m_vlanIndex.end() && vlan->second == it)
+        {
+            m_vlanIndex.erase(vlan);
+        }
+    }
+
+    container_type m_ports;
+    std::unordered_map<std::string, iterator> m_aliasIndex;
+    std::unordered_map<sai_vlan_id_t, iterator> m_vlanIndex;
+};
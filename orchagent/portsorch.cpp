@@ -33,6 +33,7 @@
 #include "sai_serialize.h"
 #include "crmorch.h"
 #include "countercheckorch.h"
+#include "counterratesorch.h"
 #include "notifier.h"
 #include "fdborch.h"
 #include "p4orch/p4orch.h"
@@ -40,6 +41,7 @@
 #include "stringutility.h"
 #include "subscriberstatetable.h"
 #include "warm_restart.h"
+#include "saicapabilitycache.h"
 
 #include "saitam.h"
 
@@ -52,6 +54,7 @@ extern sai_hostif_api_t* sai_hostif_api;
 extern sai_acl_api_t* sai_acl_api;
 extern sai_queue_api_t *sai_queue_api;
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 extern sai_fdb_api_t *sai_fdb_api;
 extern sai_tam_api_t *sai_tam_api;
 extern sai_l2mc_group_api_t *sai_l2mc_group_api;
@@ -84,6 +87,8 @@ extern bool gMultiAsicVoq;
 
 #define PORT_SPEED_LIST_DEFAULT_SIZE                     16
 #define PORT_STATE_POLLING_SEC                            5
+#define PORT_STATUS_AUDIT_SEC                             5
+#define PORT_STATUS_AUDIT_SLICE                          64
 #define PORT_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS     1000
 #define PORT_BUFFER_DROP_STAT_POLLING_INTERVAL_MS     60000
 #define PORT_PHY_ATTR_FLEX_COUNTER_POLLING_INTERVAL_MS 10000
@@ -128,7 +133,7 @@ struct PortBulker
 
     void executeGet(sai_bulk_op_error_mode_t errorMode = SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR)
     {
-        if (count == 0)
+        if (count == 0 || sai_port_api->get_ports_attribute == nullptr)
         {
             return;
         }
@@ -720,8 +725,8 @@ static bool isMlnxPlatform()
  *    bridge. By design, SONiC switch starts with all bridge ports removed from
  *    default VLAN and all ports removed from .1Q bridge.
  */
-PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_with_pri_t> &tableNames, DBConnector *chassisAppDb) :
-        Orch(db, tableNames),
+PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_with_pri_t> &tableNames, DBConnector *chassisAppDb, ZmqServer *zmqServer) :
+        ZmqOrch(db, tableNames, zmqServer, { APP_LAG_TABLE_NAME, APP_LAG_MEMBER_TABLE_NAME }),
         m_portStateTable(stateDb, STATE_PORT_TABLE_NAME),
         m_portOpErrTable(stateDb, STATE_PORT_OPER_ERR_TABLE_NAME),
         port_stat_manager(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP, StatsMode::READ, PORT_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS, false),
@@ -750,10 +755,14 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
                 ref(wred_queue_stat_manager)
             }),
         m_port_state_poller(new SelectableTimer(timespec { .tv_sec = PORT_STATE_POLLING_SEC, .tv_nsec = 0 })),
+        m_port_status_auditor(new SelectableTimer(timespec { .tv_sec = PORT_STATUS_AUDIT_SEC, .tv_nsec = 0 })),
         m_isWarmRestoreStage(WarmStart::isWarmStart())
 {
     SWSS_LOG_ENTER();
 
+    m_portAttrBulkSupported = sai_port_api->set_ports_attribute != nullptr;
+    m_portRemoveBulkSupported = sai_port_api->remove_ports != nullptr;
+
     /* Initialize counter table */
     m_counter_db = shared_ptr<DBConnector>(new DBConnector("COUNTERS_DB", 0));
     m_counterNameMapUpdater = unique_ptr<CounterNameMapUpdater>(new CounterNameMapUpdater("COUNTERS_DB", COUNTERS_PORT_NAME_MAP));
@@ -776,7 +785,6 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
 
     /* Initialize queue tables */
     m_queueCounterNameMapUpdater = unique_ptr<CounterNameMapUpdater>(new CounterNameMapUpdater("COUNTERS_DB", COUNTERS_QUEUE_NAME_MAP));
-    m_voqTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_VOQ_NAME_MAP));
     m_queuePortTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_PORT_MAP));
     m_queueIndexTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_INDEX_MAP));
     m_queueTypeTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_TYPE_MAP));
@@ -795,7 +803,7 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
 
     initGearbox();
 
-    string queueWmSha, pgWmSha, portRateSha, nvdaPortTrimSha, portFlrSha, gbPortRateSha;
+    string queueWmSha, pgWmSha, nvdaPortTrimSha, portFlrSha, gbPortRateSha;
     string queueWmPluginName = "watermark_queue.lua";
     string pgWmPluginName = "watermark_pg.lua";
     string portRatePluginName = "port_rates.lua";
@@ -810,9 +818,6 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
         string pgLuaScript = swss::loadLuaScript(pgWmPluginName);
         pgWmSha = swss::loadRedisScript(m_counter_db.get(), pgLuaScript);
 
-        string portRateLuaScript = swss::loadLuaScript(portRatePluginName);
-        portRateSha = swss::loadRedisScript(m_counter_db.get(), portRateLuaScript);
-
         string nvdaPortTrimLuaScript = swss::loadLuaScript(nvdaPortTrimPluginName);
         nvdaPortTrimSha = swss::loadRedisScript(m_counter_db.get(), nvdaPortTrimLuaScript);
 
@@ -824,7 +829,8 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
             string gbportRateLuaScript = swss::loadLuaScript(portRatePluginName);
             gbPortRateSha = swss::loadRedisScript(m_gb_counter_db.get(), gbportRateLuaScript);
 
-            // Register plugin for gearbox flex counter group
+            // Register plugin for gearbox flex counter group, port rates and BER of
+            // COUNTERS_DB are computed natively by CounterRatesOrch
             setFlexCounterGroupParameter(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP,
                                         PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS,
                                         STATS_MODE_READ,
@@ -841,17 +847,9 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
 
     // Build portStatPlugins string, only adding non-empty plugin SHAs
     std::string portStatPlugins;
-    if (!portRateSha.empty())
-    {
-        portStatPlugins = portRateSha;
-    }
     if (!portFlrSha.empty())
     {
-        if (!portStatPlugins.empty())
-        {
-            portStatPlugins += ",";
-        }
-        portStatPlugins += portFlrSha;
+        portStatPlugins = portFlrSha;
     }
 
     // Nvidia custom trim stat calculation
@@ -860,7 +858,11 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
         isPortStatSupported(SAI_PORT_STAT_TX_TRIM_PACKETS) && \
         !isPortStatSupported(SAI_PORT_STAT_DROPPED_TRIM_PACKETS))
     {
-        portStatPlugins += "," + nvdaPortTrimSha;
+        if (!portStatPlugins.empty())
+        {
+            portStatPlugins += ",";
+        }
+        portStatPlugins += nvdaPortTrimSha;
     }
 
     setFlexCounterGroupParameter(QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP,
@@ -897,9 +899,9 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
     values.count = max_flood_control_types;
     values.list = supported_flood_control_types.data();
 
-    if (sai_query_attribute_enum_values_capability(gSwitchId, SAI_OBJECT_TYPE_VLAN,
-                                                   SAI_VLAN_ATTR_UNKNOWN_UNICAST_FLOOD_CONTROL_TYPE,
-                                                   &values) != SAI_STATUS_SUCCESS)
+    if (querySaiAttributeEnumValuesCapability(gSwitchId, SAI_OBJECT_TYPE_VLAN,
+                                              SAI_VLAN_ATTR_UNKNOWN_UNICAST_FLOOD_CONTROL_TYPE,
+                                              &values) != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_NOTICE("This device does not support unknown unicast flood control types");
     }
@@ -916,9 +918,9 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
     values.count = max_flood_control_types;
     values.list = supported_flood_control_types.data();
 
-    if (sai_query_attribute_enum_values_capability(gSwitchId, SAI_OBJECT_TYPE_VLAN,
-                                                   SAI_VLAN_ATTR_BROADCAST_FLOOD_CONTROL_TYPE,
-                                                   &values) != SAI_STATUS_SUCCESS)
+    if (querySaiAttributeEnumValuesCapability(gSwitchId, SAI_OBJECT_TYPE_VLAN,
+                                              SAI_VLAN_ATTR_BROADCAST_FLOOD_CONTROL_TYPE,
+                                              &values) != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_NOTICE("This device does not support broadcast flood control types");
     }
@@ -944,9 +946,9 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
     sai_attr_capability_t capability;
 
 
-    if (sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_PORT,
-                                            SAI_PORT_ATTR_HOST_TX_SIGNAL_ENABLE,
-                                            &capability) == SAI_STATUS_SUCCESS)
+    if (querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_PORT,
+                                         SAI_PORT_ATTR_HOST_TX_SIGNAL_ENABLE,
+                                         &capability) == SAI_STATUS_SUCCESS)
     {
         if (capability.create_implemented == true)
         {
@@ -955,9 +957,9 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
         }
     }
 
-    if (sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_SWITCH,
-                                            SAI_SWITCH_ATTR_PORT_HOST_TX_READY_NOTIFY,
-                                            &capability) == SAI_STATUS_SUCCESS)
+    if (querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_SWITCH,
+                                         SAI_SWITCH_ATTR_PORT_HOST_TX_READY_NOTIFY,
+                                         &capability) == SAI_STATUS_SUCCESS)
     {
         if (capability.create_implemented == true)
         {
@@ -987,9 +989,9 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
     if (gMySwitchType != "dpu")
     {
         sai_attr_capability_t attr_cap;
-        if (sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_PORT,
-                                           SAI_PORT_ATTR_AUTO_NEG_FEC_MODE_OVERRIDE,
-                                           &attr_cap) != SAI_STATUS_SUCCESS)
+        if (querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_PORT,
+                                        SAI_PORT_ATTR_AUTO_NEG_FEC_MODE_OVERRIDE,
+                                        &attr_cap) != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_NOTICE("Unable to query autoneg fec mode override");
         }
@@ -999,9 +1001,9 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
         }
 
         sai_attr_capability_t oper_fec_cap;
-        if (sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_PORT,
-                                           SAI_PORT_ATTR_OPER_PORT_FEC_MODE, &oper_fec_cap)
-                                           != SAI_STATUS_SUCCESS)
+        if (querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_PORT,
+                                        SAI_PORT_ATTR_OPER_PORT_FEC_MODE, &oper_fec_cap)
+                                        != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_NOTICE("Unable to query capability support for oper fec mode");
         }
@@ -1108,6 +1110,10 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
 
     auto executor = new ExecutableTimer(m_port_state_poller, this, "PORT_STATE_POLLER");
     Orch::addExecutor(executor);
+
+    auto auditor = new ExecutableTimer(m_port_status_auditor, this, "PORT_STATUS_AUDIT");
+    Orch::addExecutor(auditor);
+    m_port_status_auditor->start();
 }
 
 void PortsOrch::initializeCpuPort()
@@ -1755,7 +1761,7 @@ bool PortsOrch::isPortAdminUp(const string &alias)
 
 map<string, Port>& PortsOrch::getAllPorts()
 {
-    return m_portList;
+    return m_portList.ports();
 }
 
 unordered_set<string>& PortsOrch::getAllVlans()
@@ -1767,36 +1773,102 @@ bool PortsOrch::getPort(string alias, Port &p)
 {
     SWSS_LOG_ENTER();
 
-    if (m_portList.find(alias) == m_portList.end())
+    auto port = findPort(alias);
+    if (port == nullptr)
     {
         return false;
     }
-    else
-    {
-        p = m_portList[alias];
-        return true;
-    }
+
+    p = *port;
+    return true;
 }
 
 bool PortsOrch::getPort(sai_object_id_t id, Port &port)
 {
     SWSS_LOG_ENTER();
 
+    auto p = findPort(id);
+    if (p == nullptr)
+    {
+        return false;
+    }
+
+    port = *p;
+    return true;
+}
+
+const Port *PortsOrch::findPort(const string &alias) const
+{
+    auto itr = m_portList.find(alias);
+    if (itr == m_portList.end())
+    {
+        return nullptr;
+    }
+
+    return &itr->second;
+}
+
+const Port *PortsOrch::findPort(sai_object_id_t id) const
+{
     auto itr = saiOidToAlias.find(id);
     if (itr == saiOidToAlias.end())
+    {
+        return nullptr;
+    }
+
+    auto port = findPort(itr->second);
+    if (port == nullptr)
+    {
+        SWSS_LOG_THROW("Inconsistent saiOidToAlias map and m_portList map: oid=%" PRIx64, id);
+    }
+    return port;
+}
+
+const Port *PortsOrch::findPortByBridgePortId(sai_object_id_t bridge_port_id) const
+{
+    auto itr = saiOidToAlias.find(bridge_port_id);
+    if (itr == saiOidToAlias.end())
+    {
+        return nullptr;
+    }
+
+    return findPort(itr->second);
+}
+
+bool PortsOrch::getPortOid(const string &alias, sai_object_id_t &port_id) const
+{
+    auto port = findPort(alias);
+    if (port == nullptr)
     {
         return false;
     }
-    else
+
+    port_id = port->m_port_id;
+    return true;
+}
+
+bool PortsOrch::getBridgePortOid(const string &alias, sai_object_id_t &bridge_port_id) const
+{
+    auto port = findPort(alias);
+    if (port == nullptr)
     {
-        if (!getPort(itr->second, port))
-        {
-            SWSS_LOG_THROW("Inconsistent saiOidToAlias map and m_portList map: oid=%" PRIx64, id);
-        }
-        return true;
+        return false;
     }
 
-    return false;
+    bridge_port_id = port->m_bridge_port_id;
+    return true;
+}
+
+bool PortsOrch::getVlanId(sai_object_id_t bv_id, sai_vlan_id_t &vlan_id) const
+{
+    auto vlan = findPort(bv_id);
+    if (vlan == nullptr)
+    {
+        return false;
+    }
+
+    vlan_id = vlan->m_vlan_info.vlan_id;
+    return true;
 }
 
 bool PortsOrch::isFrontPanelPort(Port& port)
@@ -2210,6 +2282,15 @@ bool PortsOrch::setPortAdminStatus(Port &port, bool state)
     SWSS_LOG_ENTER();
 
     sai_attribute_t attr;
+    preparePortAdminStatus(port, state, attr);
+
+    sai_status_t status = sai_port_api->set_port_attribute(port.m_port_id, &attr);
+
+    return completePortAdminStatus(port, state, status);
+}
+
+void PortsOrch::preparePortAdminStatus(Port &port, bool state, sai_attribute_t &attr)
+{
     attr.id = SAI_PORT_ATTR_ADMIN_STATE;
     attr.value.booldata = state;
 
@@ -2223,8 +2304,10 @@ bool PortsOrch::setPortAdminStatus(Port &port, bool state)
         SWSS_LOG_NOTICE("Set admin status DOWN host_tx_ready to false for port %s",
                 port.m_alias.c_str());
     }
+}
 
-    sai_status_t status = sai_port_api->set_port_attribute(port.m_port_id, &attr);
+bool PortsOrch::completePortAdminStatus(Port &port, bool state, sai_status_t status)
+{
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to set admin status %s for port %s."
@@ -2305,17 +2388,30 @@ bool PortsOrch::setPortMtu(const Port& port, sai_uint32_t mtu)
     SWSS_LOG_ENTER();
 
     sai_attribute_t attr;
+    preparePortMtu(port, mtu, attr);
+
+    sai_status_t status = sai_port_api->set_port_attribute(port.m_port_id, &attr);
+
+    return completePortMtu(port, mtu, attr, status);
+}
+
+void PortsOrch::preparePortMtu(const Port& port, sai_uint32_t mtu, sai_attribute_t &attr)
+{
     attr.id = SAI_PORT_ATTR_MTU;
     /* mtu + 14 + 4 + 4 = 22 bytes */
-    mtu += (uint32_t)(sizeof(struct ether_header) + FCS_LEN + VLAN_TAG_LEN);
-    attr.value.u32 = mtu;
+    attr.value.u32 = mtu + (uint32_t)(sizeof(struct ether_header) + FCS_LEN + VLAN_TAG_LEN);
 
     if (isMACsecPort(port.m_port_id))
     {
         attr.value.u32 += MAX_MACSEC_SECTAG_SIZE;
     }
+}
+
+bool PortsOrch::completePortMtu(const Port& port, sai_uint32_t mtu, const sai_attribute_t &attr, sai_status_t status)
+{
+    /* The gearbox gets the MTU without the MACsec SecTAG */
+    mtu += (uint32_t)(sizeof(struct ether_header) + FCS_LEN + VLAN_TAG_LEN);
 
-    sai_status_t status = sai_port_api->set_port_attribute(port.m_port_id, &attr);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to set MTU %u to port pid:%" PRIx64 ", rv:%d",
@@ -2335,6 +2431,28 @@ bool PortsOrch::setPortMtu(const Port& port, sai_uint32_t mtu)
     return true;
 }
 
+void PortsOrch::updatePortMtu(Port &p, sai_uint32_t mtu)
+{
+    p.m_mtu = mtu;
+    m_portList[p.m_alias] = p;
+
+    if (p.m_rif_id)
+    {
+        gIntfsOrch->setRouterIntfsMtu(p);
+    }
+    if (gP4Orch)
+    {
+        gP4Orch->setRouterIntfsMtu(p.m_alias, p.m_mtu);
+    }
+    // Sub interfaces inherit parent physical port mtu
+    updateChildPortsMtu(p, mtu);
+
+    SWSS_LOG_NOTICE(
+        "Set port %s MTU to %u",
+        p.m_alias.c_str(), mtu
+    );
+}
+
 
 bool PortsOrch::setPortTpid(Port &port, sai_uint16_t tpid)
 {
@@ -3420,6 +3538,7 @@ bool PortsOrch::setGearboxPortAttr(const Port &port, dest_port_type_t port_type,
                 {
                     string key = "phy:"+to_string(m_gearboxInterfaceMap[port.m_index].phy_id)+":ports:"+to_string(port.m_index);
                     m_gearboxTable->hset(key, speed_attr, to_string(speed));
+                    m_gearbox.invalidate();
                     SWSS_LOG_NOTICE("BOX: Updated APPL_DB key:%s %s %d", key.c_str(), speed_attr.c_str(), speed);
                 }
                 else if (id == SAI_PORT_ATTR_FEC_MODE && fec_override_sup && !setPortFecOverride(dest_port_id, override_fec))
@@ -3861,17 +3980,22 @@ bool PortsOrch::removeVlanHostIntf(Port vl)
 }
 
 void PortsOrch::updateDbPortFlapCount(Port& port, sai_port_oper_status_t pstatus)
+{
+    updateDbPortFlapCount(port, 1, pstatus == SAI_PORT_OPER_STATUS_DOWN, pstatus == SAI_PORT_OPER_STATUS_UP);
+}
+
+void PortsOrch::updateDbPortFlapCount(Port& port, uint32_t flaps, bool wentDown, bool wentUp)
 {
     SWSS_LOG_ENTER();
 
-    ++port.m_flap_count;
+    port.m_flap_count += flaps;
     vector<FieldValueTuple> tuples;
     FieldValueTuple tuple("flap_count", std::to_string(port.m_flap_count));
     tuples.push_back(tuple);
 
     auto now = std::chrono::system_clock::now();
     std::time_t now_c = std::chrono::system_clock::to_time_t(now);
-    if (pstatus == SAI_PORT_OPER_STATUS_DOWN)
+    if (wentDown)
     {
         char buffer[32];
         // Format: Www Mmm dd hh:mm:ss yyyy
@@ -3879,7 +4003,7 @@ void PortsOrch::updateDbPortFlapCount(Port& port, sai_port_oper_status_t pstatus
         FieldValueTuple tuple("last_down_time", buffer);
         tuples.push_back(tuple);
     }
-    else if (pstatus == SAI_PORT_OPER_STATUS_UP)
+    if (wentUp)
     {
         char buffer[32];
         // Format: Www Mmm dd hh:mm:ss yyyy
@@ -3934,6 +4058,26 @@ sai_status_t PortsOrch::removePort(sai_object_id_t port_id)
 {
     SWSS_LOG_ENTER();
 
+    prepareRemovePort(port_id);
+
+    sai_status_t status = sai_port_api->remove_port(port_id);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    m_portCount--;
+    m_portSupportedSpeeds.erase(port_id);
+    SWSS_LOG_NOTICE("Remove port %" PRIx64, port_id);
+
+    return status;
+}
+
+/* Release what depends on the port ahead of its removal */
+void PortsOrch::prepareRemovePort(sai_object_id_t port_id)
+{
+    SWSS_LOG_ENTER();
+
     Port port;
 
     /*
@@ -3953,6 +4097,7 @@ sai_status_t PortsOrch::removePort(sai_object_id_t port_id)
     /* Remove port counters */
     port_stat_manager.clearCounterIdList(port.m_port_id);
     port_buffer_drop_stat_manager.clearCounterIdList(port.m_port_id);
+    CounterRatesOrch::getInstance().removePort(port.m_port_id);
 
     /*
      * Remove port serdes (if exists) before removing port since this
@@ -3966,18 +4111,22 @@ sai_status_t PortsOrch::removePort(sai_object_id_t port_id)
         SWSS_LOG_INFO("Removing cached information for queue %" PRIx64, queue_id);
         m_queueInfo.erase(queue_id);
     }
+}
 
-    sai_status_t status = sai_port_api->remove_port(port_id);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        return status;
-    }
+/* Forget a port removed from SAI */
+void PortsOrch::finishRemovePort(const string &alias, sai_object_id_t port_id)
+{
+    SWSS_LOG_ENTER();
 
-    m_portCount--;
-    m_portSupportedSpeeds.erase(port_id);
-    SWSS_LOG_NOTICE("Remove port %" PRIx64, port_id);
+    removePortFromLanesMap(alias);
+    removePortFromPortListMap(port_id);
 
-    return status;
+    /* Delete port from port list */
+    m_portConfigMap.erase(alias);
+    m_portList.erase(alias);
+    saiOidToAlias.erase(port_id);
+
+    SWSS_LOG_NOTICE("Removed port %s", alias.c_str());
 }
 
 string PortsOrch::getQueueWatermarkFlexCounterTableKey(string key)
@@ -4067,6 +4216,9 @@ bool PortsOrch::initPortsBulk(std::vector<Port>& ports)
         status = false;
     }
 
+    /* Create associated Gearbox lane mapping, in bulk per PHY */
+    initGearboxPorts(ports);
+
     for (auto& p: ports)
     {
         const auto& alias = p.m_alias;
@@ -4087,7 +4239,6 @@ bool PortsOrch::initPortsBulk(std::vector<Port>& ports)
 // Registers a newly created and initialized port, adds port to internal maps.
 // Performs the following operations:
 // - Adds port to internal port list and mapping tables
-// - Initializes gearbox port configuration if applicable
 // - Sets up port name mapping for counter tables
 // - Installs flex counters for port statistics monitoring
 // - Notifies subscribers of port state changes
@@ -4100,8 +4251,6 @@ void PortsOrch::registerPort(Port &p)
     const auto &index = p.m_index;
     const auto id = p.m_port_id;
 
-    /* Create associated Gearbox lane mapping */
-    initGearboxPort(p);
     updateSystemPort(p);
 
     /* Add port to port list */
@@ -4146,6 +4295,7 @@ void PortsOrch::registerPort(Port &p)
         auto port_counter_stats = generateCounterStats(port_stat_ids, sai_serialize_port_stat);
         port_stat_manager.setCounterIdList(p.m_port_id,
                 CounterType::PORT, port_counter_stats);
+        CounterRatesOrch::getInstance().addPort(p);
         auto gbport_counter_stats = generateCounterStats(gbport_stat_ids, sai_serialize_port_stat);
         if (p.m_system_side_id)
             gb_port_stat_manager.setCounterIdList(p.m_system_side_id,
@@ -4273,11 +4423,15 @@ void PortsOrch::deInitPort(string alias, sai_object_id_t port_id)
         removePortBufferQueueCounters(p, range, skip_host_tx_queue);
     }
 
+    m_portBufferCounters.erase(p.m_alias);
+    m_portsInUse.erase(p.m_alias);
+
     /* remove port from flex_counter_table for updating counters  */
     auto flex_counters_orch = gDirectory.get<FlexCounterOrch*>();
     if ((flex_counters_orch->getPortCountersState()))
     {
         port_stat_manager.clearCounterIdList(p.m_port_id);
+        CounterRatesOrch::getInstance().removePort(p.m_port_id);
     }
 
     if (flex_counters_orch->getPortBufferDropCountersState())
@@ -4431,7 +4585,7 @@ void PortsOrch::removePortFromPortListMap(sai_object_id_t port_id)
     }
 }
 
-void PortsOrch::doSendToIngressPortTask(Consumer &consumer)
+void PortsOrch::doSendToIngressPortTask(ConsumerBase &consumer)
 {
     SWSS_LOG_ENTER();
 
@@ -4552,15 +4706,31 @@ bool PortsOrch::programSerdes(
     }
 }
 
-void PortsOrch::doPortTask(Consumer &consumer)
+void PortsOrch::doPortTask(ConsumerBase &consumer)
 {
     SWSS_LOG_ENTER();
 
     auto &taskMap = consumer.m_toSync;
     auto it = taskMap.begin();
 
+    // A single entry gains nothing from deferring its sets
+    m_portAttrBulkMode = m_portAttrBulkSupported && taskMap.size() > 1;
+    const bool removeBulk = m_portRemoveBulkSupported && taskMap.size() > 1;
+
     while (it != taskMap.end())
     {
+        /* The entry must see the port as its queued sets left it, a retry may merge into it */
+        if (m_portAttrBulkAliases.count(it->first))
+        {
+            flushPortAttrBulk(consumer);
+        }
+
+        /* Nor may it find a port whose removal is still queued */
+        if (m_portRemoveBulkAliases.count(it->first))
+        {
+            flushPortRemoveBulk(consumer);
+        }
+
         auto keyOpFieldsValues = it->second;
         auto key = kfvKey(keyOpFieldsValues);
         auto op = kfvOp(keyOpFieldsValues);
@@ -4708,6 +4878,9 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     it++;
                 }
 
+                // The new ports may take the lanes of the ports being removed
+                flushPortRemoveBulk(consumer);
+
                 // Bulk port remove
                 if (!portsToRemoveList.empty())
                 {
@@ -4756,12 +4929,20 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 // Add and initialize the port
                 if (!portExists)
                 {
+                    // The new ports may take the lanes of the ports being removed
+                    flushPortRemoveBulk(consumer);
+
                     std::vector<PortConfig> portsToAddList { pCfg };
                     std::vector<Port> addedPorts;
 
+                    collectNewPorts(consumer, std::next(it), portsToAddList);
+
                     if (!addPortBulk(portsToAddList, addedPorts))
                     {
-                        SWSS_LOG_ERROR("Failed to add port %s", pCfg.key.c_str());
+                        for (const auto &cfg : portsToAddList)
+                        {
+                            SWSS_LOG_ERROR("Failed to add port %s", cfg.key.c_str());
+                        }
                         it++;
                         continue;
                     }
@@ -5072,6 +5253,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
 
                         p.m_speed = pCfg.speed.value;
                         m_portList[p.m_alias] = p;
+                        CounterRatesOrch::getInstance().setPortSpeed(p.m_port_id, p.m_speed);
 
                         SWSS_LOG_NOTICE(
                             "Set port %s speed to %u",
@@ -5255,7 +5437,28 @@ void PortsOrch::doPortTask(Consumer &consumer)
 
                 if (pCfg.mtu.is_set)
                 {
-                    if (p.m_mtu != pCfg.mtu.value)
+                    if (p.m_mtu != pCfg.mtu.value && m_portAttrBulkMode)
+                    {
+                        sai_attribute_t attr;
+                        preparePortMtu(p, pCfg.mtu.value, attr);
+
+                        auto mtu = pCfg.mtu.value;
+                        queuePortAttr(p, attr, keyOpFieldsValues, [this, mtu, attr](Port &port, sai_status_t status)
+                        {
+                            if (!completePortMtu(port, mtu, attr, status))
+                            {
+                                SWSS_LOG_ERROR(
+                                    "Failed to set port %s MTU to %u",
+                                    port.m_alias.c_str(), mtu
+                                );
+                                return false;
+                            }
+
+                            updatePortMtu(port, mtu);
+                            return true;
+                        });
+                    }
+                    else if (p.m_mtu != pCfg.mtu.value)
                     {
                         if (!setPortMtu(p, pCfg.mtu.value))
                         {
@@ -5267,24 +5470,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                             continue;
                         }
 
-                        p.m_mtu = pCfg.mtu.value;
-                        m_portList[p.m_alias] = p;
-
-                        if (p.m_rif_id)
-                        {
-                            gIntfsOrch->setRouterIntfsMtu(p);
-                        }
-                        if (gP4Orch)
-                        {
-                            gP4Orch->setRouterIntfsMtu(p.m_alias, p.m_mtu);
-                        }
-                        // Sub interfaces inherit parent physical port mtu
-                        updateChildPortsMtu(p, pCfg.mtu.value);
-
-                        SWSS_LOG_NOTICE(
-                            "Set port %s MTU to %u",
-                            p.m_alias.c_str(), pCfg.mtu.value
-                        );
+                        updatePortMtu(p, pCfg.mtu.value);
                     }
                 }
 
@@ -5509,7 +5695,35 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 /* Last step set port admin status */
                 if (pCfg.admin_status.is_set)
                 {
-                    if (p.m_admin_state_up != pCfg.admin_status.value)
+                    if (p.m_admin_state_up != pCfg.admin_status.value && m_portAttrBulkMode)
+                    {
+                        sai_attribute_t attr;
+                        preparePortAdminStatus(p, pCfg.admin_status.value, attr);
+
+                        auto up = pCfg.admin_status.value;
+                        auto adminStatus = m_portHlpr.getAdminStatusStr(pCfg);
+                        queuePortAttr(p, attr, keyOpFieldsValues, [this, up, adminStatus](Port &port, sai_status_t status)
+                        {
+                            if (!completePortAdminStatus(port, up, status))
+                            {
+                                SWSS_LOG_ERROR(
+                                    "Failed to set port %s admin status to %s",
+                                    port.m_alias.c_str(), adminStatus.c_str()
+                                );
+                                return false;
+                            }
+
+                            port.m_admin_state_up = up;
+                            m_portList[port.m_alias] = port;
+
+                            SWSS_LOG_NOTICE(
+                                "Set port %s admin status to %s",
+                                port.m_alias.c_str(), adminStatus.c_str()
+                            );
+                            return true;
+                        });
+                    }
+                    else if (p.m_admin_state_up != pCfg.admin_status.value)
                     {
                         if (!setPortAdminStatus(p, pCfg.admin_status.value))
                         {
@@ -5702,6 +5916,15 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 );
             }
 
+            if (removeBulk)
+            {
+                prepareRemovePort(port_id);
+                m_portRemoveBulkOps.push_back({ alias, port_id, it->second });
+                m_portRemoveBulkAliases.insert(alias);
+                it = taskMap.erase(it);
+                continue;
+            }
+
             sai_status_t status = removePort(port_id);
             if (SAI_STATUS_SUCCESS != status)
             {
@@ -5713,15 +5936,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 it++;
                 continue;
             }
-            removePortFromLanesMap(alias);
-            removePortFromPortListMap(port_id);
-
-            /* Delete port from port list */
-            m_portConfigMap.erase(alias);
-            m_portList.erase(alias);
-            saiOidToAlias.erase(port_id);
-
-            SWSS_LOG_NOTICE("Removed port %s", alias.c_str());
+            finishRemovePort(alias, port_id);
         }
         else
         {
@@ -5730,52 +5945,261 @@ void PortsOrch::doPortTask(Consumer &consumer)
 
         it = consumer.m_toSync.erase(it);
     }
+
+    flushPortRemoveBulk(consumer);
+    flushPortAttrBulk(consumer);
 }
 
-void PortsOrch::doVlanTask(Consumer &consumer)
+/*
+ * Gather the new ports queued behind the one being created, a breakout
+ * brings its whole port group in one drain. A port whose config doesn't
+ * parse or validate is left to its own entry.
+ */
+void PortsOrch::collectNewPorts(ConsumerBase &consumer, SyncMap::iterator from, std::vector<PortConfig> &portsToAddList)
 {
     SWSS_LOG_ENTER();
 
-    auto it = consumer.m_toSync.begin();
-    while (it != consumer.m_toSync.end())
+    auto &taskMap = consumer.m_toSync;
+    for (auto it = from; it != taskMap.end(); it++)
     {
-        auto &t = it->second;
+        const auto &alias = it->first;
+        if (kfvOp(it->second) != SET_COMMAND || alias == "PortConfigDone" || alias == "PortInitDone" ||
+            m_portList.count(alias) || taskMap.count(alias) > 1)
+        {
+            continue;
+        }
 
-        string key = kfvKey(t);
+        if (std::any_of(portsToAddList.begin(), portsToAddList.end(),
+                        [&](const PortConfig &cfg) { return cfg.key == alias; }))
+        {
+            continue;
+        }
 
-        /* Ensure the key starts with "Vlan" otherwise ignore */
-        if (strncmp(key.c_str(), VLAN_PREFIX, 4))
+        std::unordered_map<std::string, std::string> fvMap;
+        auto cfg = m_portConfigMap.find(alias);
+        if (cfg != m_portConfigMap.end())
+        {
+            fvMap = cfg->second;
+        }
+        for (const auto &fv : kfvFieldsValues(it->second))
+        {
+            fvMap[fvField(fv)] = fvValue(fv);
+        }
+
+        PortConfig pCfg(alias, SET_COMMAND);
+        pCfg.fieldValueMap = fvMap;
+        if (!m_portHlpr.parsePortConfig(pCfg) || !m_portHlpr.validatePortConfig(pCfg))
         {
-            SWSS_LOG_ERROR("Invalid key format. No 'Vlan' prefix: %s", key.c_str());
-            it = consumer.m_toSync.erase(it);
             continue;
         }
 
-        int vlan_id;
-        vlan_id = stoi(key.substr(4)); // FIXME: might raise exception
+        m_portConfigMap[alias] = fvMap;
+        m_lanesAliasSpeedMap[pCfg.lanes.value] = pCfg;
+        portsToAddList.push_back(pCfg);
+    }
+}
 
-        string vlan_alias;
-        vlan_alias = VLAN_PREFIX + to_string(vlan_id);
-        string op = kfvOp(t);
+/*
+ * Remove the ports queued by the drain in one bulk call. A port still in use
+ * goes back to m_toSync to be retried, like a single removal.
+ */
+void PortsOrch::flushPortRemoveBulk(ConsumerBase &consumer)
+{
+    SWSS_LOG_ENTER();
 
-        if (op == SET_COMMAND)
+    if (m_portRemoveBulkOps.empty())
+    {
+        return;
+    }
+
+    auto portCount = static_cast<std::uint32_t>(m_portRemoveBulkOps.size());
+    std::vector<sai_object_id_t> portList;
+    std::vector<sai_status_t> statusList(portCount, SAI_STATUS_NOT_EXECUTED);
+    for (const auto &op : m_portRemoveBulkOps)
+    {
+        portList.push_back(op.port_id);
+    }
+
+    auto status = sai_port_api->remove_ports(portCount, portList.data(),
+                                             SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statusList.data());
+    if (status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED)
+    {
+        SWSS_LOG_NOTICE("Bulk port remove is not supported, falling back to single object calls");
+        m_portRemoveBulkSupported = false;
+        std::fill(statusList.begin(), statusList.end(), SAI_STATUS_NOT_EXECUTED);
+    }
+
+    for (std::uint32_t i = 0; i < portCount; i++)
+    {
+        const auto &op = m_portRemoveBulkOps[i];
+
+        if (statusList[i] == SAI_STATUS_NOT_EXECUTED)
         {
-            // Retrieve attributes
-            uint32_t mtu = 0;
-            MacAddress mac;
-            string hostif_name = "";
-            for (auto i : kfvFieldsValues(t))
+            statusList[i] = sai_port_api->remove_port(op.port_id);
+        }
+
+        if (statusList[i] != SAI_STATUS_SUCCESS)
+        {
+            if (statusList[i] != SAI_STATUS_OBJECT_IN_USE)
             {
-                if (fvField(i) == "mtu")
-                {
-                    mtu = (uint32_t)stoul(fvValue(i));
-                }
-                if (fvField(i) == "mac")
-                {
-                    mac = MacAddress(fvValue(i));
-                }
-                if (fvField(i) == "host_ifname")
-                {
+                throw runtime_error("Delete port failed");
+            }
+
+            SWSS_LOG_WARN("Failed to remove port %" PRIx64 ", as the object is in use", op.port_id);
+            auto range = consumer.m_toSync.equal_range(op.alias);
+            if (std::none_of(range.first, range.second,
+                             [](const SyncMap::value_type &entry) { return kfvOp(entry.second) == DEL_COMMAND; }))
+            {
+                consumer.m_toSync.emplace(op.alias, op.task);
+            }
+            continue;
+        }
+
+        m_portCount--;
+        m_portSupportedSpeeds.erase(op.port_id);
+        finishRemovePort(op.alias, op.port_id);
+    }
+
+    m_portRemoveBulkOps.clear();
+    m_portRemoveBulkAliases.clear();
+}
+
+void PortsOrch::queuePortAttr(const Port &port, const sai_attribute_t &attr, const KeyOpFieldsValuesTuple &task,
+                              std::function<bool(Port &, sai_status_t)> complete)
+{
+    SWSS_LOG_ENTER();
+
+    m_portAttrBulkOps.push_back({ port.m_alias, port.m_port_id, attr, SAI_STATUS_NOT_EXECUTED, task, std::move(complete) });
+    m_portAttrBulkAliases.insert(port.m_alias);
+}
+
+void PortsOrch::flushPortAttrBulk(ConsumerBase &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_portAttrBulkOps.empty())
+    {
+        return;
+    }
+
+    // Bound to the current port API on every flush, like the single object calls
+    ObjectBulker<sai_port_api_t> bulker(sai_port_api, gSwitchId, gMaxBulkSize);
+    bulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+
+    for (auto &op: m_portAttrBulkOps)
+    {
+        bulker.set_entry_attribute(&op.status, op.port_id, &op.attr);
+    }
+
+    bulker.flush();
+
+    auto unsupported = [](sai_status_t status)
+    {
+        return status == SAI_STATUS_NOT_IMPLEMENTED ||
+               status == SAI_STATUS_NOT_SUPPORTED ||
+               status == SAI_STATUS_NOT_EXECUTED;
+    };
+
+    if (std::all_of(m_portAttrBulkOps.begin(), m_portAttrBulkOps.end(),
+                    [&](const PortAttrBulkOp &op) { return unsupported(op.status); }))
+    {
+        SWSS_LOG_NOTICE("Bulk port attribute set is not supported, falling back to single object calls");
+        m_portAttrBulkSupported = false;
+        m_portAttrBulkMode = false;
+    }
+
+    for (auto &op: m_portAttrBulkOps)
+    {
+        if (unsupported(op.status))
+        {
+            op.status = sai_port_api->set_port_attribute(op.port_id, &op.attr);
+        }
+
+        Port p;
+        if (!getPort(op.alias, p))
+        {
+            SWSS_LOG_ERROR("Port %s is gone before its attribute %d was set", op.alias.c_str(), op.attr.id);
+            continue;
+        }
+
+        if (op.complete(p, op.status))
+        {
+            continue;
+        }
+
+        /*
+         * Retry the task, a pending SET of the port is newer and keeps its fields,
+         * a pending DEL makes the retry moot
+         */
+        auto range = consumer.m_toSync.equal_range(op.alias);
+        auto pending = std::find_if(range.first, range.second,
+                                    [](const SyncMap::value_type &entry) { return kfvOp(entry.second) == SET_COMMAND; });
+        if (pending != range.second)
+        {
+            auto &values = kfvFieldsValues(pending->second);
+            for (const auto &fv: kfvFieldsValues(op.task))
+            {
+                if (std::none_of(values.begin(), values.end(),
+                                 [&](const FieldValueTuple &v) { return fvField(v) == fvField(fv); }))
+                {
+                    values.push_back(fv);
+                }
+            }
+        }
+        else if (range.first == range.second)
+        {
+            consumer.m_toSync.emplace(op.alias, op.task);
+        }
+    }
+
+    m_portAttrBulkOps.clear();
+    m_portAttrBulkAliases.clear();
+}
+
+void PortsOrch::doVlanTask(ConsumerBase &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = consumer.m_toSync.begin();
+    while (it != consumer.m_toSync.end())
+    {
+        auto &t = it->second;
+
+        string key = kfvKey(t);
+
+        /* Ensure the key starts with "Vlan" otherwise ignore */
+        if (strncmp(key.c_str(), VLAN_PREFIX, 4))
+        {
+            SWSS_LOG_ERROR("Invalid key format. No 'Vlan' prefix: %s", key.c_str());
+            it = consumer.m_toSync.erase(it);
+            continue;
+        }
+
+        int vlan_id;
+        vlan_id = stoi(key.substr(4)); // FIXME: might raise exception
+
+        string vlan_alias;
+        vlan_alias = VLAN_PREFIX + to_string(vlan_id);
+        string op = kfvOp(t);
+
+        if (op == SET_COMMAND)
+        {
+            // Retrieve attributes
+            uint32_t mtu = 0;
+            MacAddress mac;
+            string hostif_name = "";
+            for (auto i : kfvFieldsValues(t))
+            {
+                if (fvField(i) == "mtu")
+                {
+                    mtu = (uint32_t)stoul(fvValue(i));
+                }
+                if (fvField(i) == "mac")
+                {
+                    mac = MacAddress(fvValue(i));
+                }
+                if (fvField(i) == "host_ifname")
+                {
                     hostif_name = fvValue(i);
                 }
             }
@@ -5857,7 +6281,7 @@ void PortsOrch::doVlanTask(Consumer &consumer)
     }
 }
 
-void PortsOrch::doVlanMemberTask(Consumer &consumer)
+void PortsOrch::doVlanMemberTask(ConsumerBase &consumer)
 {
     SWSS_LOG_ENTER();
 
@@ -5974,7 +6398,7 @@ void PortsOrch::doVlanMemberTask(Consumer &consumer)
     }
 }
 
-void PortsOrch::doTransceiverPresenceCheck(Consumer &consumer)
+void PortsOrch::doTransceiverPresenceCheck(ConsumerBase &consumer)
 {
     /*
     the idea is to listen to transceiver info table, and also maintain an internal list of plugged modules.
@@ -6042,12 +6466,17 @@ bool PortsOrch::setSaiHostTxSignal(const Port &port, bool enable)
     return true;
 }
 
-void PortsOrch::doLagTask(Consumer &consumer)
+void PortsOrch::doLagTask(ConsumerBase &consumer)
 {
     SWSS_LOG_ENTER();
 
     string table_name = consumer.getTableName();
 
+    if (table_name != CHASSIS_APP_LAG_TABLE_NAME)
+    {
+        allocateLagIds(consumer);
+    }
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -6238,7 +6667,7 @@ void PortsOrch::doLagTask(Consumer &consumer)
     }
 }
 
-void PortsOrch::doLagMemberTask(Consumer &consumer)
+void PortsOrch::doLagMemberTask(ConsumerBase &consumer)
 {
     SWSS_LOG_ENTER();
 
@@ -6492,7 +6921,7 @@ void PortsOrch::doTask()
     }
 }
 
-void PortsOrch::doTask(Consumer &consumer)
+void PortsOrch::doTask(ConsumerBase &consumer)
 {
     SWSS_LOG_ENTER();
 
@@ -7413,6 +7842,7 @@ bool PortsOrch::addVlan(string vlan_alias)
     vlan.m_vlan_info.bc_flood_type = SAI_VLAN_FLOOD_CONTROL_TYPE_ALL;
     vlan.m_members = set<string>();
     m_portList[vlan_alias] = vlan;
+    m_portList.indexVlan(vlan_alias);
     m_port_ref_count[vlan_alias] = 0;
     m_bridge_port_ref_count[vlan_alias] = 0;
     saiOidToAlias[vlan_oid] =  vlan_alias;
@@ -7499,16 +7929,14 @@ bool PortsOrch::getVlanByVlanId(sai_vlan_id_t vlan_id, Port &vlan)
 {
     SWSS_LOG_ENTER();
 
-    for (auto &it: m_portList)
+    auto it = m_portList.findVlan(vlan_id);
+    if (it == m_portList.end())
     {
-        if (it.second.m_type == Port::VLAN && it.second.m_vlan_info.vlan_id == vlan_id)
-        {
-            vlan = it.second;
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    vlan = it->second;
+    return true;
 }
 
 bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode, string end_point_ip)
@@ -7567,6 +7995,82 @@ bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode, stri
     SWSS_LOG_NOTICE("Add member %s to VLAN %s vid:%hu pid%" PRIx64,
             port.m_alias.c_str(), vlan.m_alias.c_str(), vlan.m_vlan_info.vlan_id, port.m_port_id);
 
+    return addVlanMemberPost(vlan, port, vlan_member_id, sai_tagging_mode);
+}
+
+/*
+ * VLAN members created with one bulk call, e.g. the remote VTEPs of a burst of
+ * IMET routes joining their VLAN flood domains. Members are given as VLAN and
+ * port aliases, success holds the result of each.
+ */
+void PortsOrch::addVlanMembers(const vector<pair<string, string>> &members, const string &tagging_mode, vector<bool> &success)
+{
+    SWSS_LOG_ENTER();
+
+    success.assign(members.size(), false);
+
+    sai_vlan_tagging_mode_t sai_tagging_mode = SAI_VLAN_TAGGING_MODE_TAGGED;
+    if (tagging_mode == "untagged")
+        sai_tagging_mode = SAI_VLAN_TAGGING_MODE_UNTAGGED;
+    else if (tagging_mode == "priority_tagged")
+        sai_tagging_mode = SAI_VLAN_TAGGING_MODE_PRIORITY_TAGGED;
+
+    ObjectBulker<sai_vlan_api_t> bulker(sai_vlan_api, gSwitchId, gMaxBulkSize);
+    vector<sai_object_id_t> member_ids(members.size(), SAI_NULL_OBJECT_ID);
+    vector<sai_status_t> statuses(members.size(), SAI_STATUS_NOT_EXECUTED);
+    vector<bool> queued(members.size(), false);
+
+    for (size_t i = 0; i < members.size(); i++)
+    {
+        Port vlan, port;
+        if (!getPort(members[i].first, vlan) || !getPort(members[i].second, port))
+        {
+            SWSS_LOG_ERROR("Failed to locate VLAN %s or member %s",
+                    members[i].first.c_str(), members[i].second.c_str());
+            continue;
+        }
+
+        sai_attribute_t attrs[3];
+        attrs[0].id = SAI_VLAN_MEMBER_ATTR_VLAN_ID;
+        attrs[0].value.oid = vlan.m_vlan_info.vlan_oid;
+        attrs[1].id = SAI_VLAN_MEMBER_ATTR_BRIDGE_PORT_ID;
+        attrs[1].value.oid = port.m_bridge_port_id;
+        attrs[2].id = SAI_VLAN_MEMBER_ATTR_VLAN_TAGGING_MODE;
+        attrs[2].value.s32 = sai_tagging_mode;
+
+        bulker.create_entry(&member_ids[i], &statuses[i], 3, attrs);
+        queued[i] = true;
+    }
+    bulker.flush();
+
+    for (size_t i = 0; i < members.size(); i++)
+    {
+        Port vlan, port;
+        if (!queued[i] || !getPort(members[i].first, vlan) || !getPort(members[i].second, port))
+        {
+            continue;
+        }
+
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to add member %s to VLAN %s vid:%hu pid:%" PRIx64,
+                    port.m_alias.c_str(), vlan.m_alias.c_str(), vlan.m_vlan_info.vlan_id, port.m_port_id);
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_VLAN, statuses[i]);
+            if (handle_status != task_success)
+            {
+                success[i] = parseHandleSaiStatusFailure(handle_status);
+                continue;
+            }
+        }
+        SWSS_LOG_NOTICE("Add member %s to VLAN %s vid:%hu pid%" PRIx64,
+                port.m_alias.c_str(), vlan.m_alias.c_str(), vlan.m_vlan_info.vlan_id, port.m_port_id);
+
+        success[i] = addVlanMemberPost(vlan, port, member_ids[i], sai_tagging_mode);
+    }
+}
+
+bool PortsOrch::addVlanMemberPost(Port &vlan, Port &port, sai_object_id_t vlan_member_id, sai_vlan_tagging_mode_t sai_tagging_mode)
+{
     /* Use untagged VLAN as pvid of the member port */
     if (sai_tagging_mode == SAI_VLAN_TAGGING_MODE_UNTAGGED &&
         port.m_type != Port::TUNNEL)
@@ -7941,6 +8445,36 @@ bool PortsOrch::isVlanMember(Port &vlan, Port &port, string end_point_ip)
     return true;
 }
 
+/*
+ * Allocate the system lag ids of the new local lags of the batch in one go,
+ * addLag() then finds them in the cache of the allocator instead of running
+ * the allocation script against the chassis db once per lag.
+ */
+void PortsOrch::allocateLagIds(ConsumerBase &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    if (gMySwitchType != "voq" || !gMultiAsicVoq || !m_lagIdAllocator)
+    {
+        return;
+    }
+
+    vector<string> system_lag_aliases;
+    for (const auto &it : consumer.m_toSync)
+    {
+        const auto &t = it.second;
+        if (kfvOp(t) == SET_COMMAND && m_portList.find(kfvKey(t)) == m_portList.end())
+        {
+            system_lag_aliases.push_back(gMyHostName + "|" + gMyAsicName + "|" + kfvKey(t));
+        }
+    }
+
+    if (system_lag_aliases.size() > 1)
+    {
+        m_lagIdAllocator->lagIdAddBulk(system_lag_aliases);
+    }
+}
+
 bool PortsOrch::addLag(string lag_alias, uint32_t spa_id, int32_t switch_id)
 {
     SWSS_LOG_ENTER();
@@ -8406,6 +8940,9 @@ void PortsOrch::generateQueueMap(map<string, FlexCounterQueueStates> queuesState
         queuesStateVector.clear();
     }
 
+    /* All the ports go to the counter DB maps in one write per map */
+    QueueMaps maps;
+
     for (const auto& it: m_portList)
     {
         if (it.second.m_type == Port::PHY)
@@ -8424,10 +8961,10 @@ void PortsOrch::generateQueueMap(map<string, FlexCounterQueueStates> queuesState
                 }
                 queuesStateVector.insert(make_pair(it.second.m_alias, flexCounterQueueState));
             }
-            generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), false);
+            generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), false, maps);
             if (gMySwitchType == "voq")
             {
-                generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), true);
+                generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), true, maps);
             }
         }
 
@@ -8439,30 +8976,26 @@ void PortsOrch::generateQueueMap(map<string, FlexCounterQueueStates> queuesState
                 FlexCounterQueueStates flexCounterQueueState(maxQueueNumber);
                 queuesStateVector.insert(make_pair(it.second.m_alias, flexCounterQueueState));
             }
-            generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), true);
+            generateQueueMapPerPort(it.second, queuesStateVector.at(it.second.m_alias), true, maps);
         }
     }
 
+    writeQueueMaps(maps);
+
     m_isQueueMapGenerated = true;
 }
 
 void PortsOrch::generateQueueMapPerPort(const Port& port, FlexCounterQueueStates& queuesState, bool voq)
 {
-    /* Create the Queue map in the Counter DB */
-    vector<FieldValueTuple> queueVector;
-    vector<FieldValueTuple> queuePortVector;
-    vector<FieldValueTuple> queueIndexVector;
-    vector<FieldValueTuple> queueTypeVector;
-    std::vector<sai_object_id_t> queue_ids;
+    QueueMaps maps;
+    generateQueueMapPerPort(port, queuesState, voq, maps);
+    writeQueueMaps(maps);
+}
 
-    if (voq)
-    {
-        queue_ids = m_port_voq_ids[port.m_alias];
-    }
-    else
-    {
-        queue_ids = port.m_queue_ids;
-    }
+void PortsOrch::generateQueueMapPerPort(const Port& port, FlexCounterQueueStates& queuesState, bool voq, QueueMaps& maps)
+{
+    /* Add the Queue map entries of the port */
+    const auto& queue_ids = voq ? m_port_voq_ids[port.m_alias] : port.m_queue_ids;
 
     for (size_t queueIndex = 0; queueIndex < queue_ids.size(); ++queueIndex)
     {
@@ -8489,18 +9022,18 @@ void PortsOrch::generateQueueMapPerPort(const Port& port, FlexCounterQueueStates
             {
                 continue;
             }
-            queueTypeVector.emplace_back(id, sai_queue_type_string_map[queueType]);
-            queueIndexVector.emplace_back(id, to_string(queueRealIndex));
+            maps.types.emplace_back(id, sai_queue_type_string_map[queueType]);
+            maps.indices.emplace_back(id, to_string(queueRealIndex));
         }
 
-        queueVector.emplace_back(name.str(), id);
         if (voq)
         {
             // Install a flex counter for this voq to track stats. Voq counters do
             // not have buffer queue config. So it does not get enabled through the
             // flexcounter orch logic. Always enabled voq counters.
             addQueueFlexCountersPerPortPerQueueIndex(port, queueIndex, true, queueType);
-            queuePortVector.emplace_back(id, sai_serialize_object_id(port.m_system_port_oid));
+            maps.voqNames.emplace_back(name.str(), id);
+            maps.ports.emplace_back(id, sai_serialize_object_id(port.m_system_port_oid));
         }
         else
         {
@@ -8514,23 +9047,48 @@ void PortsOrch::generateQueueMapPerPort(const Port& port, FlexCounterQueueStates
             {
                addQueueFlexCountersPerPortPerQueueIndex(port, queueIndex, false, queueType);
             }
-            queuePortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
+            maps.names.emplace_back(name.str(), id);
+            maps.ports.emplace_back(id, sai_serialize_object_id(port.m_port_id));
         }
     }
 
-    if (voq)
+    if (!voq)
     {
-        m_voqTable->set("", queueVector);
+        CounterCheckOrch::getInstance().addPort(port);
     }
-    else
+}
+
+void PortsOrch::writeQueueMaps(const QueueMaps& maps)
+{
+    if (!maps.names.empty())
     {
-        m_queueCounterNameMapUpdater->setCounterNameMap(queueVector);
-        CounterCheckOrch::getInstance().addPort(port);
+        m_queueCounterNameMapUpdater->setCounterNameMap(maps.names);
     }
-    m_queuePortTable->set("", queuePortVector);
-    m_queueIndexTable->set("", queueIndexVector);
-    m_queueTypeTable->set("", queueTypeVector);
 
+    /* One HSET per map, sent together */
+    RedisPipeline pipeline(m_counter_db.get());
+    Table voqWriter(&pipeline, COUNTERS_VOQ_NAME_MAP, true);
+    Table portWriter(&pipeline, COUNTERS_QUEUE_PORT_MAP, true);
+    Table indexWriter(&pipeline, COUNTERS_QUEUE_INDEX_MAP, true);
+    Table typeWriter(&pipeline, COUNTERS_QUEUE_TYPE_MAP, true);
+
+    if (!maps.voqNames.empty())
+    {
+        voqWriter.set("", maps.voqNames);
+    }
+    if (!maps.ports.empty())
+    {
+        portWriter.set("", maps.ports);
+    }
+    if (!maps.indices.empty())
+    {
+        indexWriter.set("", maps.indices);
+    }
+    if (!maps.types.empty())
+    {
+        typeWriter.set("", maps.types);
+    }
+    pipeline.flush();
 }
 
 void PortsOrch::addQueueFlexCounters(map<string, FlexCounterQueueStates> queuesStateVector)
@@ -8594,27 +9152,35 @@ void PortsOrch::addQueueFlexCountersPerPort(const Port& port, FlexCounterQueueSt
 
 void PortsOrch::addQueueFlexCountersPerPortPerQueueIndex(const Port& port, size_t queueIndex, bool voq, sai_queue_type_t queueType)
 {
-    std::unordered_set<string> counter_stats;
-    std::vector<sai_object_id_t> queue_ids;
-
-    for (const auto& it: queue_stat_ids)
+    if (!voq && !trackPortBufferCounter(port, PortBufferCounter::QUEUE, queueIndex, queueType))
     {
-        counter_stats.emplace(sai_serialize_queue_stat(it));
+        return;
     }
-    if (voq)
+
+    /* All the queues poll the same counters, build and serialize them once */
+    const string profile_name = voq ? "VOQ" : "QUEUE";
+    auto profile = queue_stat_manager.getCounterProfile(profile_name);
+    if (!profile)
     {
-        for (const auto& voq_it: voq_stat_ids)
+        std::unordered_set<string> counter_stats;
+
+        for (const auto& it: queue_stat_ids)
         {
-            counter_stats.emplace(sai_serialize_queue_stat(voq_it));
+            counter_stats.emplace(sai_serialize_queue_stat(it));
         }
-        queue_ids = m_port_voq_ids[port.m_alias];
-    }
-    else
-    {
-        queue_ids = port.m_queue_ids;
+        if (voq)
+        {
+            for (const auto& voq_it: voq_stat_ids)
+            {
+                counter_stats.emplace(sai_serialize_queue_stat(voq_it));
+            }
+        }
+        profile = queue_stat_manager.registerCounterProfile(profile_name, CounterType::QUEUE, counter_stats);
     }
 
-    queue_stat_manager.setCounterIdList(queue_ids[queueIndex], CounterType::QUEUE, counter_stats, queueType);
+    const auto& queue_ids = voq ? m_port_voq_ids[port.m_alias] : port.m_queue_ids;
+
+    queue_stat_manager.setCounterIdList(queue_ids[queueIndex], profile, queueType);
 }
 
 
@@ -8679,8 +9245,18 @@ void PortsOrch::addQueueWatermarkFlexCountersPerPort(const Port& port, FlexCount
 
 void PortsOrch::addQueueWatermarkFlexCountersPerPortPerQueueIndex(const Port& port, size_t queueIndex, sai_queue_type_t queueType)
 {
-    auto queue_counter_stats = generateCounterStats(queueWatermarkStatIds, sai_serialize_queue_stat);
-    queue_watermark_manager.setCounterIdList(port.m_queue_ids[queueIndex], CounterType::QUEUE, queue_counter_stats, queueType);
+    if (!trackPortBufferCounter(port, PortBufferCounter::QUEUE_WATERMARK, queueIndex, queueType))
+    {
+        return;
+    }
+
+    auto profile = queue_watermark_manager.getCounterProfile("QUEUE_WATERMARK");
+    if (!profile)
+    {
+        auto queue_counter_stats = generateCounterStats(queueWatermarkStatIds, sai_serialize_queue_stat);
+        profile = queue_watermark_manager.registerCounterProfile("QUEUE_WATERMARK", CounterType::QUEUE, queue_counter_stats);
+    }
+    queue_watermark_manager.setCounterIdList(port.m_queue_ids[queueIndex], profile, queueType);
 }
 
 void PortsOrch::createPortBufferQueueCounters(const Port &port, string queues, bool skip_host_tx_queue)
@@ -8702,10 +9278,7 @@ void PortsOrch::addPortBufferQueueCounters(const Port &port, uint32_t startIndex
     SWSS_LOG_ENTER();
 
     /* Create the Queue map in the Counter DB */
-    vector<FieldValueTuple> queueVector;
-    vector<FieldValueTuple> queuePortVector;
-    vector<FieldValueTuple> queueIndexVector;
-    vector<FieldValueTuple> queueTypeVector;
+    QueueMaps maps;
 
     for (auto queueIndex = startIndex; queueIndex <= endIndex; queueIndex++)
     {
@@ -8723,12 +9296,12 @@ void PortsOrch::addPortBufferQueueCounters(const Port &port, uint32_t startIndex
         uint8_t queueRealIndex = 0;
         if (getQueueTypeAndIndex(port.m_queue_ids[queueIndex], queueType, queueRealIndex))
         {
-            queueTypeVector.emplace_back(id, sai_queue_type_string_map[queueType]);
-            queueIndexVector.emplace_back(id, to_string(queueRealIndex));
+            maps.types.emplace_back(id, sai_queue_type_string_map[queueType]);
+            maps.indices.emplace_back(id, to_string(queueRealIndex));
         }
 
-        queueVector.emplace_back(name.str(), id);
-        queuePortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
+        maps.names.emplace_back(name.str(), id);
+        maps.ports.emplace_back(id, sai_serialize_object_id(port.m_port_id));
 
         auto flexCounterOrch = gDirectory.get<FlexCounterOrch*>();
         if (flexCounterOrch->getQueueCountersState())
@@ -8749,10 +9322,7 @@ void PortsOrch::addPortBufferQueueCounters(const Port &port, uint32_t startIndex
         }
     }
 
-    m_queueCounterNameMapUpdater->setCounterNameMap(queueVector);
-    m_queuePortTable->set("", queuePortVector);
-    m_queueIndexTable->set("", queueIndexVector);
-    m_queueTypeTable->set("", queueTypeVector);
+    writeQueueMaps(maps);
 
     CounterCheckOrch::getInstance().addPort(port);
 }
@@ -8817,6 +9387,10 @@ void PortsOrch::deletePortBufferQueueCounters(const Port &port, uint32_t startIn
             /* Remove wred queue counters */
             wred_queue_stat_manager.clearCounterIdList(port.m_queue_ids[queueIndex], queueType);
         }
+
+        untrackPortBufferCounter(port, PortBufferCounter::QUEUE, queueIndex);
+        untrackPortBufferCounter(port, PortBufferCounter::QUEUE_WATERMARK, queueIndex);
+        untrackPortBufferCounter(port, PortBufferCounter::WRED_QUEUE, queueIndex);
     }
 
     CounterCheckOrch::getInstance().removePort(port);
@@ -8837,6 +9411,9 @@ void PortsOrch::generatePriorityGroupMap(map<string, FlexCounterPgStates> pgsSta
         pgsStateVector.clear();
     }
 
+    /* All the ports go to the counter DB maps in one write per map */
+    PriorityGroupMaps maps;
+
     for (const auto& it: m_portList)
     {
         if (it.second.m_type == Port::PHY)
@@ -8851,19 +9428,25 @@ void PortsOrch::generatePriorityGroupMap(map<string, FlexCounterPgStates> pgsSta
                 }
                 pgsStateVector.insert(make_pair(it.second.m_alias, flexCounterPgState));
             }
-            generatePriorityGroupMapPerPort(it.second, pgsStateVector.at(it.second.m_alias));
+            generatePriorityGroupMapPerPort(it.second, pgsStateVector.at(it.second.m_alias), maps);
         }
     }
 
+    writePriorityGroupMaps(maps);
+
     m_isPriorityGroupMapGenerated = true;
 }
 
 void PortsOrch::generatePriorityGroupMapPerPort(const Port& port, FlexCounterPgStates& pgsState)
 {
-    /* Create the PG map in the Counter DB */
-    vector<FieldValueTuple> pgVector;
-    vector<FieldValueTuple> pgPortVector;
-    vector<FieldValueTuple> pgIndexVector;
+    PriorityGroupMaps maps;
+    generatePriorityGroupMapPerPort(port, pgsState, maps);
+    writePriorityGroupMaps(maps);
+}
+
+void PortsOrch::generatePriorityGroupMapPerPort(const Port& port, FlexCounterPgStates& pgsState, PriorityGroupMaps& maps)
+{
+    /* Add the PG map entries of the port */
 
     for (size_t pgIndex = 0; pgIndex < port.m_priority_group_ids.size(); ++pgIndex)
     {
@@ -8876,17 +9459,35 @@ void PortsOrch::generatePriorityGroupMapPerPort(const Port& port, FlexCounterPgS
 
         const auto id = sai_serialize_object_id(port.m_priority_group_ids[pgIndex]);
 
-        pgVector.emplace_back(name.str(), id);
-        pgPortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
-        pgIndexVector.emplace_back(id, to_string(pgIndex));
+        maps.names.emplace_back(name.str(), id);
+        maps.ports.emplace_back(id, sai_serialize_object_id(port.m_port_id));
+        maps.indices.emplace_back(id, to_string(pgIndex));
+    }
+
+    CounterCheckOrch::getInstance().addPort(port);
+}
 
+void PortsOrch::writePriorityGroupMaps(const PriorityGroupMaps& maps)
+{
+    if (!maps.names.empty())
+    {
+        m_pgCounterNameMapUpdater->setCounterNameMap(maps.names);
     }
 
-    m_pgCounterNameMapUpdater->setCounterNameMap(pgVector);
-    m_pgPortTable->set("", pgPortVector);
-    m_pgIndexTable->set("", pgIndexVector);
+    /* One HSET per map, sent together */
+    RedisPipeline pipeline(m_counter_db.get());
+    Table portWriter(&pipeline, COUNTERS_PG_PORT_MAP, true);
+    Table indexWriter(&pipeline, COUNTERS_PG_INDEX_MAP, true);
 
-    CounterCheckOrch::getInstance().addPort(port);
+    if (!maps.ports.empty())
+    {
+        portWriter.set("", maps.ports);
+    }
+    if (!maps.indices.empty())
+    {
+        indexWriter.set("", maps.indices);
+    }
+    pipeline.flush();
 }
 
 void PortsOrch::createPortBufferPgCounters(const Port& port, string pgs)
@@ -8909,9 +9510,7 @@ void PortsOrch::addPortBufferPgCounters(const Port& port, uint32_t startIndex, u
 
     /* Create the PG map in the Counter DB */
     /* Add stat counters to flex_counter */
-    vector<FieldValueTuple> pgVector;
-    vector<FieldValueTuple> pgPortVector;
-    vector<FieldValueTuple> pgIndexVector;
+    PriorityGroupMaps maps;
 
     for (auto pgIndex = startIndex; pgIndex <= endIndex; pgIndex++)
     {
@@ -8920,9 +9519,9 @@ void PortsOrch::addPortBufferPgCounters(const Port& port, uint32_t startIndex, u
 
         const auto id = sai_serialize_object_id(port.m_priority_group_ids[pgIndex]);
 
-        pgVector.emplace_back(name.str(), id);
-        pgPortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
-        pgIndexVector.emplace_back(id, to_string(pgIndex));
+        maps.names.emplace_back(name.str(), id);
+        maps.ports.emplace_back(id, sai_serialize_object_id(port.m_port_id));
+        maps.indices.emplace_back(id, to_string(pgIndex));
 
         auto flexCounterOrch = gDirectory.get<FlexCounterOrch*>();
         if (flexCounterOrch->getPgCountersState())
@@ -8937,9 +9536,7 @@ void PortsOrch::addPortBufferPgCounters(const Port& port, uint32_t startIndex, u
         }
     }
 
-    m_pgCounterNameMapUpdater->setCounterNameMap(pgVector);
-    m_pgPortTable->set("", pgPortVector);
-    m_pgIndexTable->set("", pgIndexVector);
+    writePriorityGroupMaps(maps);
 
     CounterCheckOrch::getInstance().addPort(port);
 }
@@ -8994,8 +9591,18 @@ void PortsOrch::addPriorityGroupFlexCountersPerPort(const Port& port, FlexCounte
 
 void PortsOrch::addPriorityGroupFlexCountersPerPortPerPgIndex(const Port& port, size_t pgIndex)
 {
-    auto pg_counter_stats = generateCounterStats(ingressPriorityGroupDropStatIds, sai_serialize_ingress_priority_group_stat);
-    pg_drop_stat_manager.setCounterIdList(port.m_priority_group_ids[pgIndex], CounterType::PRIORITY_GROUP, pg_counter_stats);
+    if (!trackPortBufferCounter(port, PortBufferCounter::PG_DROP, pgIndex, SAI_QUEUE_TYPE_ALL))
+    {
+        return;
+    }
+
+    auto profile = pg_drop_stat_manager.getCounterProfile("PG_DROP");
+    if (!profile)
+    {
+        auto pg_counter_stats = generateCounterStats(ingressPriorityGroupDropStatIds, sai_serialize_ingress_priority_group_stat);
+        profile = pg_drop_stat_manager.registerCounterProfile("PG_DROP", CounterType::PRIORITY_GROUP, pg_counter_stats);
+    }
+    pg_drop_stat_manager.setCounterIdList(port.m_priority_group_ids[pgIndex], profile);
 }
 
 void PortsOrch::addPriorityGroupWatermarkFlexCounters(map<string, FlexCounterPgStates> pgsStateVector)
@@ -9050,8 +9657,18 @@ void PortsOrch::addPriorityGroupWatermarkFlexCountersPerPort(const Port& port, F
 
 void PortsOrch::addPriorityGroupWatermarkFlexCountersPerPortPerPgIndex(const Port& port, size_t pgIndex)
 {
-    auto pg_counter_stats = generateCounterStats(ingressPriorityGroupWatermarkStatIds, sai_serialize_ingress_priority_group_stat);
-    pg_watermark_manager.setCounterIdList(port.m_priority_group_ids[pgIndex], CounterType::PRIORITY_GROUP, pg_counter_stats);
+    if (!trackPortBufferCounter(port, PortBufferCounter::PG_WATERMARK, pgIndex, SAI_QUEUE_TYPE_ALL))
+    {
+        return;
+    }
+
+    auto profile = pg_watermark_manager.getCounterProfile("PG_WATERMARK");
+    if (!profile)
+    {
+        auto pg_counter_stats = generateCounterStats(ingressPriorityGroupWatermarkStatIds, sai_serialize_ingress_priority_group_stat);
+        profile = pg_watermark_manager.registerCounterProfile("PG_WATERMARK", CounterType::PRIORITY_GROUP, pg_counter_stats);
+    }
+    pg_watermark_manager.setCounterIdList(port.m_priority_group_ids[pgIndex], profile);
 }
 
 void PortsOrch::removePortBufferPgCounters(const Port& port, string pgs)
@@ -9097,6 +9714,9 @@ void PortsOrch::deletePortBufferPgCounters(const Port& port, uint32_t startIndex
             // Remove watermark counters from flex_counter
             pg_watermark_manager.clearCounterIdList(port.m_priority_group_ids[pgIndex]);
         }
+
+        untrackPortBufferCounter(port, PortBufferCounter::PG_DROP, pgIndex);
+        untrackPortBufferCounter(port, PortBufferCounter::PG_WATERMARK, pgIndex);
     }
 
     CounterCheckOrch::getInstance().removePort(port);
@@ -9120,6 +9740,7 @@ void PortsOrch::generatePortCounterMap()
         }
         port_stat_manager.setCounterIdList(it.second.m_port_id,
                 CounterType::PORT, port_counter_stats);
+        CounterRatesOrch::getInstance().addPort(it.second);
         if (it.second.m_system_side_id)
             gb_port_stat_manager.setCounterIdList(it.second.m_system_side_id,
                     CounterType::PORT, gbport_counter_stats, it.second.m_switch_id);
@@ -9158,7 +9779,7 @@ void PortsOrch::queryPortPhyAttrCapabilities()
     {
         sai_attr_capability_t capability;
 
-        sai_status_t status = sai_query_attribute_capability(
+        sai_status_t status = querySaiAttributeCapability(
             gSwitchId,
             SAI_OBJECT_TYPE_PORT,
             attr_id,
@@ -9314,7 +9935,7 @@ void PortsOrch::queryPortPhySerdesAttrCapabilities()
     {
         sai_attr_capability_t capability;
 
-        sai_status_t status = sai_query_attribute_capability(
+        sai_status_t status = querySaiAttributeCapability(
             gSwitchId,
             SAI_OBJECT_TYPE_PORT_SERDES,
             attr_id,
@@ -9576,23 +10197,202 @@ void PortsOrch::addWredQueueFlexCountersPerPort(const Port& port, FlexCounterQue
 
 void PortsOrch::addWredQueueFlexCountersPerPortPerQueueIndex(const Port& port, size_t queueIndex,  bool voq, sai_queue_type_t queueType)
 {
-    std::unordered_set<string> counter_stats;
-    std::vector<sai_object_id_t> queue_ids;
-
-    for (const auto& it: wred_queue_stat_ids)
+    if (!voq && !trackPortBufferCounter(port, PortBufferCounter::WRED_QUEUE, queueIndex, queueType))
     {
-        counter_stats.emplace(sai_serialize_queue_stat(it));
+        return;
     }
-    if (voq)
+
+    auto profile = wred_queue_stat_manager.getCounterProfile("WRED_QUEUE");
+    if (!profile)
     {
-        queue_ids = m_port_voq_ids[port.m_alias];
-    }
-    else
+        std::unordered_set<string> counter_stats;
+
+        for (const auto& it: wred_queue_stat_ids)
+        {
+            counter_stats.emplace(sai_serialize_queue_stat(it));
+        }
+        profile = wred_queue_stat_manager.registerCounterProfile("WRED_QUEUE", CounterType::QUEUE, counter_stats);
+    }
+
+    const auto& queue_ids = voq ? m_port_voq_ids[port.m_alias] : port.m_queue_ids;
+
+    wred_queue_stat_manager.setCounterIdList(queue_ids[queueIndex], profile, queueType);
+}
+
+void PortsOrch::setCountersOperUpOnly(bool enable)
+{
+    SWSS_LOG_ENTER();
+
+    if (enable == m_countersOperUpOnly)
+    {
+        return;
+    }
+
+    m_countersOperUpOnly = enable;
+
+    SWSS_LOG_NOTICE("Queue and PG counters registered %s", enable ? "for the ports in use only" : "for all the ports");
+
+    /* Only the ports not in use change */
+    for (const auto &it: m_portBufferCounters)
+    {
+        if (m_portsInUse.count(it.first))
+        {
+            continue;
+        }
+
+        Port port;
+        if (!getPort(it.first, port))
+        {
+            continue;
+        }
+        setPortBufferCountersRegistered(port, !enable);
+    }
+
+    flushCounters();
+}
+
+bool PortsOrch::isPortInUse(const string &alias) const
+{
+    return m_portsInUse.find(alias) != m_portsInUse.end();
+}
+
+/*
+ * Records a queue or PG counter requested on a port, returns whether it is
+ * to be registered now
+ */
+bool PortsOrch::trackPortBufferCounter(const Port& port, PortBufferCounter counter, size_t index, sai_queue_type_t queueType)
+{
+    if (port.m_type != Port::PHY)
+    {
+        return true;
+    }
+
+    m_portBufferCounters[port.m_alias][{ counter, index }] = queueType;
+
+    return !m_countersOperUpOnly || isPortInUse(port.m_alias);
+}
+
+void PortsOrch::untrackPortBufferCounter(const Port& port, PortBufferCounter counter, size_t index)
+{
+    auto it = m_portBufferCounters.find(port.m_alias);
+    if (it == m_portBufferCounters.end())
+    {
+        return;
+    }
+
+    it->second.erase({ counter, index });
+    if (it->second.empty())
+    {
+        m_portBufferCounters.erase(it);
+    }
+}
+
+/*
+ * Registers or deregisters all the queue and PG counters requested on the
+ * port. The cached counter managers send them with the next flushCounters().
+ */
+void PortsOrch::setPortBufferCountersRegistered(const Port& port, bool registered)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_portBufferCounters.find(port.m_alias);
+    if (it == m_portBufferCounters.end())
+    {
+        return;
+    }
+
+    SWSS_LOG_INFO("%s %zu queue and PG counters of port %s", registered ? "Register" : "Deregister",
+                  it->second.size(), port.m_alias.c_str());
+
+    /* Registering goes through trackPortBufferCounter() again, which only updates the entries */
+    for (const auto &counter: it->second)
+    {
+        size_t index = counter.first.second;
+        sai_queue_type_t queueType = counter.second;
+
+        switch (counter.first.first)
+        {
+            case PortBufferCounter::QUEUE:
+                if (registered)
+                {
+                    addQueueFlexCountersPerPortPerQueueIndex(port, index, false, queueType);
+                }
+                else
+                {
+                    queue_stat_manager.clearCounterIdList(port.m_queue_ids[index], queueType);
+                }
+                break;
+            case PortBufferCounter::QUEUE_WATERMARK:
+                if (registered)
+                {
+                    addQueueWatermarkFlexCountersPerPortPerQueueIndex(port, index, queueType);
+                }
+                else
+                {
+                    queue_watermark_manager.clearCounterIdList(port.m_queue_ids[index], queueType);
+                }
+                break;
+            case PortBufferCounter::WRED_QUEUE:
+                if (registered)
+                {
+                    addWredQueueFlexCountersPerPortPerQueueIndex(port, index, false, queueType);
+                }
+                else
+                {
+                    wred_queue_stat_manager.clearCounterIdList(port.m_queue_ids[index], queueType);
+                }
+                break;
+            case PortBufferCounter::PG_DROP:
+                if (registered)
+                {
+                    addPriorityGroupFlexCountersPerPortPerPgIndex(port, index);
+                }
+                else
+                {
+                    pg_drop_stat_manager.clearCounterIdList(port.m_priority_group_ids[index]);
+                }
+                break;
+            case PortBufferCounter::PG_WATERMARK:
+                if (registered)
+                {
+                    addPriorityGroupWatermarkFlexCountersPerPortPerPgIndex(port, index);
+                }
+                else
+                {
+                    pg_watermark_manager.clearCounterIdList(port.m_priority_group_ids[index]);
+                }
+                break;
+        }
+    }
+}
+
+/*
+ * A port is in use from its first oper up until it goes oper down while
+ * admin down, so the counters of a flapping link keep being polled
+ */
+void PortsOrch::updatePortInUse(const Port& port, sai_port_oper_status_t status)
+{
+    if (port.m_type != Port::PHY)
+    {
+        return;
+    }
+
+    bool changed = false;
+    bool inUse = status == SAI_PORT_OPER_STATUS_UP;
+
+    if (inUse)
+    {
+        changed = m_portsInUse.insert(port.m_alias).second;
+    }
+    else if (!port.m_admin_state_up)
     {
-        queue_ids = port.m_queue_ids;
+        changed = m_portsInUse.erase(port.m_alias) > 0;
     }
 
-    wred_queue_stat_manager.setCounterIdList(queue_ids[queueIndex], CounterType::QUEUE, counter_stats, queueType);
+    if (changed && m_countersOperUpOnly)
+    {
+        setPortBufferCountersRegistered(port, inUse);
+    }
 }
 
 void PortsOrch::flushCounters()
@@ -9635,6 +10435,11 @@ void PortsOrch::doTask(NotificationConsumer &consumer)
     {
         handleNotification(consumer, entry);
     }
+
+    processPortOperStatus();
+
+    /* Counters of the ports whose use changed, sent together */
+    flushCounters();
 }
 
 void PortsOrch::handleNotification(NotificationConsumer &consumer, KeyOpFieldsValuesTuple& entry)
@@ -9652,7 +10457,6 @@ void PortsOrch::handleNotification(NotificationConsumer &consumer, KeyOpFieldsVa
 
         for (uint32_t i = 0; i < count; i++)
         {
-            Port port;
             sai_object_id_t id = portoperstatus[i].port_id;
             sai_port_oper_status_t status = portoperstatus[i].port_state;
             sai_port_error_status_t port_oper_err = portoperstatus[i].port_error_status;
@@ -9661,50 +10465,7 @@ void PortsOrch::handleNotification(NotificationConsumer &consumer, KeyOpFieldsVa
                                 "oper_error_status:0x%" PRIx32,
                                 id, status, port_oper_err);
 
-            if (!getPort(id, port))
-            {
-                SWSS_LOG_NOTICE("Got port state change for port id 0x%" PRIx64 " which does not exist, possibly outdated event", id);
-                continue;
-            }
-
-            updatePortOperStatus(port, status);
-            if (status == SAI_PORT_OPER_STATUS_UP)
-            {
-                sai_uint32_t speed;
-                if (getPortOperSpeed(port, speed))
-                {
-                    SWSS_LOG_NOTICE("%s oper speed is %d", port.m_alias.c_str(), speed);
-                    updateDbPortOperSpeed(port, speed);
-                }
-                else
-                {
-                    updateDbPortOperSpeed(port, 0);
-                }
-                sai_port_fec_mode_t fec_mode;
-                string fec_str;
-                if (oper_fec_sup && getPortOperFec(port, fec_mode))
-                {
-                    if (!m_portHlpr.fecToStr(fec_str, fec_mode))
-                    {
-                        SWSS_LOG_ERROR("Error unknown fec mode %d while querying port %s fec mode",
-                                    static_cast<std::int32_t>(fec_mode), port.m_alias.c_str());
-                        fec_str = "N/A";
-                    }
-                    updateDbPortOperFec(port,fec_str);
-                }
-                else
-                {
-                    updateDbPortOperFec(port, "N/A");
-                }
-            } else {
-                if (port_oper_err)
-                {
-                    updatePortErrorStatus(port, port_oper_err);
-                }
-            }
-
-            /* update m_portList */
-            m_portList[port.m_alias] = port;
+            queuePortOperStatus(id, status, port_oper_err);
         }
 
         sai_deserialize_free_port_oper_status_ntf(count, portoperstatus);
@@ -9728,6 +10489,118 @@ void PortsOrch::handleNotification(NotificationConsumer &consumer, KeyOpFieldsVa
     }
 }
 
+void PortsOrch::queuePortOperStatus(sai_object_id_t id, sai_port_oper_status_t status, sai_port_error_status_t error)
+{
+    auto it = m_operStatusChanges.find(id);
+    if (it == m_operStatusChanges.end())
+    {
+        const Port *port = findPort(id);
+        if (port == nullptr)
+        {
+            SWSS_LOG_NOTICE("Got port state change for port id 0x%" PRIx64 " which does not exist, possibly outdated event", id);
+            return;
+        }
+
+        PortOperStatusChange change;
+        change.initial = port->m_oper_status;
+        change.last = port->m_oper_status;
+        it = m_operStatusChanges.emplace(id, std::move(change)).first;
+        m_operStatusOrder.push_back(id);
+    }
+
+    auto &change = it->second;
+    if (status != change.last)
+    {
+        change.changes++;
+        change.ups += status == SAI_PORT_OPER_STATUS_UP ? 1 : 0;
+        change.downs += status == SAI_PORT_OPER_STATUS_DOWN ? 1 : 0;
+    }
+    change.last = status;
+
+    if (status != SAI_PORT_OPER_STATUS_UP && error)
+    {
+        change.errors.push_back(error);
+    }
+}
+
+/*
+ * Apply the oper status changes queued over the burst, once per port at its
+ * last status. The flaps in between are counted without being replayed to
+ * the host interfaces, next hops and observers.
+ */
+void PortsOrch::processPortOperStatus()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto id : m_operStatusOrder)
+    {
+        const auto &change = m_operStatusChanges[id];
+
+        Port port;
+        if (!getPort(id, port))
+        {
+            SWSS_LOG_NOTICE("Port id 0x%" PRIx64 " was removed before its state change was handled", id);
+            continue;
+        }
+
+        sai_port_oper_status_t status = change.last;
+        bool changed = status != port.m_oper_status;
+
+        // The last change is accounted by updatePortOperStatus()
+        uint32_t collapsed = change.changes - (changed ? 1 : 0);
+        if (collapsed > 0 && port.m_type == Port::PHY)
+        {
+            uint32_t downs = change.downs - (changed && status == SAI_PORT_OPER_STATUS_DOWN ? 1 : 0);
+            uint32_t ups = change.ups - (changed && status == SAI_PORT_OPER_STATUS_UP ? 1 : 0);
+
+            SWSS_LOG_NOTICE("Port %s flapped %u times within a burst", port.m_alias.c_str(), collapsed);
+            updateDbPortFlapCount(port, collapsed, downs > 0, ups > 0);
+        }
+
+        updatePortOperStatus(port, status);
+        if (status == SAI_PORT_OPER_STATUS_UP)
+        {
+            sai_uint32_t speed;
+            if (getPortOperSpeed(port, speed))
+            {
+                SWSS_LOG_NOTICE("%s oper speed is %d", port.m_alias.c_str(), speed);
+                updateDbPortOperSpeed(port, speed);
+            }
+            else
+            {
+                updateDbPortOperSpeed(port, 0);
+            }
+            sai_port_fec_mode_t fec_mode;
+            string fec_str;
+            if (oper_fec_sup && getPortOperFec(port, fec_mode))
+            {
+                if (!m_portHlpr.fecToStr(fec_str, fec_mode))
+                {
+                    SWSS_LOG_ERROR("Error unknown fec mode %d while querying port %s fec mode",
+                                static_cast<std::int32_t>(fec_mode), port.m_alias.c_str());
+                    fec_str = "N/A";
+                }
+                updateDbPortOperFec(port,fec_str);
+            }
+            else
+            {
+                updateDbPortOperFec(port, "N/A");
+            }
+        }
+
+        for (auto error : change.errors)
+        {
+            updatePortErrorStatus(port, error);
+        }
+
+        /* update m_portList */
+        m_portList[port.m_alias] = port;
+    }
+
+    m_operStatusOrder.clear();
+    m_operStatusChanges.clear();
+}
+
 void PortsOrch::updatePortErrorStatus(Port &port, sai_port_error_status_t errstatus)
 {
     size_t errors = 0;
@@ -9809,6 +10682,8 @@ void PortsOrch::updatePortOperStatus(Port &port, sai_port_oper_status_t status)
     }
     port.m_oper_status = status;
 
+    updatePortInUse(port, status);
+
     if(port.m_type == Port::TUNNEL)
     {
         return;
@@ -9889,49 +10764,185 @@ void PortsOrch::refreshPortStatus()
 {
     SWSS_LOG_ENTER();
 
+    vector<Port *> ports;
     for (auto &it: m_portList)
     {
-        auto &port = it.second;
-        if (port.m_type != Port::PHY)
+        if (it.second.m_type == Port::PHY)
         {
-            continue;
+            ports.push_back(&it.second);
         }
+    }
+
+    size_t bulkSize = max(gMaxBulkSize, (size_t)1);
+    for (size_t begin = 0; begin < ports.size(); begin += bulkSize)
+    {
+        vector<Port *> slice(ports.begin() + begin, ports.begin() + min(begin + bulkSize, ports.size()));
+        refreshPortStatus(slice, false);
+    }
+}
 
-        sai_port_oper_status_t status;
-        if (!getPortOperStatus(port, status))
+/*
+ * Refresh the oper status of a batch of PHY ports read in one bulk get, and
+ * the oper speed and FEC of the ports found up. An audit only acts on the
+ * ports whose status differs from the one known, and skips the ports it
+ * fails to read.
+ */
+void PortsOrch::refreshPortStatus(const vector<Port *> &ports, bool audit)
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_port_oper_status_t> statuses;
+    vector<bool> valid;
+    getPortOperStatus(ports, statuses, valid);
+
+    vector<Port *> up;
+    for (size_t idx = 0; idx < ports.size(); idx++)
+    {
+        auto &port = *ports[idx];
+        auto status = statuses[idx];
+
+        if (!valid[idx])
         {
+            if (audit)
+            {
+                continue;
+            }
             throw runtime_error("PortsOrch get port oper status failure");
         }
 
-        SWSS_LOG_INFO("%s oper status is %s", port.m_alias.c_str(), oper_status_strings.at(status).c_str());
+        if (audit)
+        {
+            if (status == port.m_oper_status)
+            {
+                continue;
+            }
+            SWSS_LOG_NOTICE("%s oper status is %s, missed a state change notification",
+                            port.m_alias.c_str(), oper_status_strings.at(status).c_str());
+        }
+        else
+        {
+            SWSS_LOG_INFO("%s oper status is %s", port.m_alias.c_str(), oper_status_strings.at(status).c_str());
+        }
+
         updatePortOperStatus(port, status);
 
         if (status == SAI_PORT_OPER_STATUS_UP)
         {
-            sai_uint32_t speed;
-            if (getPortOperSpeed(port, speed))
+            up.push_back(&port);
+        }
+    }
+
+    refreshPortOperSpeedFec(up);
+    flushCounters();
+}
+
+void PortsOrch::refreshPortOperSpeedFec(const vector<Port *> &ports)
+{
+    SWSS_LOG_ENTER();
+
+    if (ports.empty())
+    {
+        return;
+    }
+
+    const auto portCount = static_cast<uint32_t>(ports.size());
+
+    PortBulker speeds(portCount);
+    PortBulker fecs(portCount);
+    for (const auto port: ports)
+    {
+        sai_attribute_t attr;
+        attr.id = SAI_PORT_ATTR_OPER_SPEED;
+        speeds.add(port->m_port_id, attr);
+        attr.id = SAI_PORT_ATTR_OPER_PORT_FEC_MODE;
+        fecs.add(port->m_port_id, attr);
+    }
+
+    speeds.executeGet();
+    if (oper_fec_sup)
+    {
+        fecs.executeGet();
+    }
+
+    for (size_t idx = 0; idx < portCount; idx++)
+    {
+        auto &port = *ports[idx];
+
+        sai_uint32_t speed = 0;
+        if (speeds.statuses[idx] == SAI_STATUS_SUCCESS)
+        {
+            speed = speeds.attrList[idx].value.u32;
+            if (speed == 0)
             {
-                SWSS_LOG_INFO("%s oper speed is %d", port.m_alias.c_str(), speed);
-                updateDbPortOperSpeed(port, speed);
+                SWSS_LOG_WARN("Port %s operational speed is 0", port.m_alias.c_str());
             }
-            else
+        }
+        else if (!getPortOperSpeed(port, speed))
+        {
+            speed = 0;
+        }
+        SWSS_LOG_INFO("%s oper speed is %d", port.m_alias.c_str(), speed);
+        updateDbPortOperSpeed(port, speed);
+
+        string fec_str = "N/A";
+        sai_port_fec_mode_t fec_mode = SAI_PORT_FEC_MODE_NONE;
+        bool fec = false;
+        if (oper_fec_sup)
+        {
+            if (fecs.statuses[idx] == SAI_STATUS_SUCCESS)
             {
-                updateDbPortOperSpeed(port, 0);
+                fec_mode = static_cast<sai_port_fec_mode_t>(fecs.attrList[idx].value.s32);
+                fec = true;
             }
-            sai_port_fec_mode_t fec_mode;
-            string fec_str = "N/A";
-            if (oper_fec_sup && getPortOperFec(port, fec_mode))
+            else
             {
-                if (!m_portHlpr.fecToStr(fec_str, fec_mode))
-                {
-                    SWSS_LOG_ERROR("Error unknown fec mode %d while querying port %s fec mode",
-                                   static_cast<std::int32_t>(fec_mode), port.m_alias.c_str());
-                    fec_str = "N/A";
-                }
+                fec = getPortOperFec(port, fec_mode);
             }
-            updateDbPortOperFec(port,fec_str);
+        }
+        if (fec && !m_portHlpr.fecToStr(fec_str, fec_mode))
+        {
+            SWSS_LOG_ERROR("Error unknown fec mode %d while querying port %s fec mode",
+                           static_cast<std::int32_t>(fec_mode), port.m_alias.c_str());
+            fec_str = "N/A";
+        }
+        updateDbPortOperFec(port, fec_str);
+    }
+}
+
+/*
+ * Audit the oper status of the next slice of PHY ports, so a port state
+ * change notification lost by syncd or the notification channel is caught
+ * up without reading all the ports in one go.
+ */
+void PortsOrch::auditPortStatus()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_isWarmRestoreStage || !allPortsReady())
+    {
+        return;
+    }
+
+    auto &ports = m_portList.ports();
+    auto it = ports.upper_bound(m_portStatusAuditCursor);
+    if (m_portStatusAuditCursor.empty())
+    {
+        it = ports.begin();
+    }
+
+    vector<Port *> slice;
+    for (; it != ports.end() && slice.size() < PORT_STATUS_AUDIT_SLICE; it++)
+    {
+        if (it->second.m_type == Port::PHY)
+        {
+            slice.push_back(&it->second);
         }
     }
+
+    // Wrap around once the last port is audited
+    m_portStatusAuditCursor = it == ports.end() || slice.empty() ? "" : slice.back()->m_alias;
+
+    refreshPortStatus(slice, true);
 }
 
 bool PortsOrch::getPortOperStatus(const Port& port, sai_port_oper_status_t& status) const
@@ -9958,6 +10969,43 @@ bool PortsOrch::getPortOperStatus(const Port& port, sai_port_oper_status_t& stat
     return true;
 }
 
+/*
+ * Oper status of the ports in one bulk get, a port the bulk get didn't
+ * return a status for is read on its own.
+ */
+void PortsOrch::getPortOperStatus(const vector<Port *> &ports, vector<sai_port_oper_status_t> &statuses, vector<bool> &valid) const
+{
+    SWSS_LOG_ENTER();
+
+    const auto portCount = static_cast<uint32_t>(ports.size());
+
+    statuses.assign(portCount, SAI_PORT_OPER_STATUS_UNKNOWN);
+    valid.assign(portCount, false);
+
+    PortBulker bulker(portCount);
+    for (const auto port: ports)
+    {
+        sai_attribute_t attr;
+        attr.id = SAI_PORT_ATTR_OPER_STATUS;
+        bulker.add(port->m_port_id, attr);
+    }
+
+    bulker.executeGet();
+
+    for (size_t idx = 0; idx < portCount; idx++)
+    {
+        if (bulker.statuses[idx] == SAI_STATUS_SUCCESS)
+        {
+            statuses[idx] = static_cast<sai_port_oper_status_t>(bulker.attrList[idx].value.u32);
+            valid[idx] = true;
+        }
+        else
+        {
+            valid[idx] = getPortOperStatus(*ports[idx], statuses[idx]);
+        }
+    }
+}
+
 bool PortsOrch::getPortOperSpeed(const Port& port, sai_uint32_t& speed) const
 {
     SWSS_LOG_ENTER();
@@ -10374,18 +11422,17 @@ bool PortsOrch::updateL3VniStatus(uint16_t vlan_id, bool isUp)
  */
 void PortsOrch::initGearbox()
 {
-    GearboxUtils gearbox;
     Table* tmpGearboxTable = m_gearboxTable.get();
-    m_gearboxEnabled = gearbox.isGearboxEnabled(tmpGearboxTable);
+    m_gearboxEnabled = m_gearbox.isGearboxEnabled(tmpGearboxTable);
 
     SWSS_LOG_ENTER();
 
     if (m_gearboxEnabled)
     {
-        m_gearboxPhyMap = gearbox.loadPhyMap(tmpGearboxTable);
-        m_gearboxInterfaceMap = gearbox.loadInterfaceMap(tmpGearboxTable);
-        m_gearboxLaneMap = gearbox.loadLaneMap(tmpGearboxTable);
-        m_gearboxPortMap = gearbox.loadPortMap(tmpGearboxTable);
+        m_gearboxPhyMap = m_gearbox.loadPhyMap(tmpGearboxTable);
+        m_gearboxInterfaceMap = m_gearbox.loadInterfaceMap(tmpGearboxTable);
+        m_gearboxLaneMap = m_gearbox.loadLaneMap(tmpGearboxTable);
+        m_gearboxPortMap = m_gearbox.loadPortMap(tmpGearboxTable);
 
         SWSS_LOG_NOTICE("BOX: m_gearboxPhyMap size       = %d.", (int) m_gearboxPhyMap.size());
         SWSS_LOG_NOTICE("BOX: m_gearboxInterfaceMap size = %d.", (int) m_gearboxInterfaceMap.size());
@@ -10398,312 +11445,369 @@ void PortsOrch::initGearbox()
 }
 
 /*
- * Create both the system-side and line-side gearbox ports for the associated
- * PHY and connect the ports.
- *
+ * Build the attributes of the system-side or line-side gearbox port of the
+ * port. The attributes point into the lists of gbAttrs.
  */
-bool PortsOrch::initGearboxPort(Port &port)
+bool PortsOrch::getGearboxPortAttrs(const Port &port, bool systemSide, GearboxPortAttrs &gbAttrs)
 {
-    vector<sai_attribute_t> attrs;
-    vector<uint32_t> lanes;
-    vector<uint32_t> vals;
     sai_attribute_t attr;
-    sai_object_id_t systemPort;
-    sai_object_id_t linePort;
-    sai_object_id_t connector;
-    sai_object_id_t phyOid;
-    sai_status_t status;
-    string phyOidStr;
-    int phy_id;
     sai_port_fec_mode_t sai_fec;
 
-    SWSS_LOG_ENTER();
+    auto &intf = m_gearboxInterfaceMap[port.m_index];
+    auto &gbPort = m_gearboxPortMap[port.m_index];
+    auto &attrs = gbAttrs.attrs;
+    auto &lanes = gbAttrs.lanes;
 
-    if (m_gearboxEnabled)
+    attr.id = SAI_PORT_ATTR_ADMIN_STATE;
+    attr.value.booldata = port.m_admin_state_up;
+    attrs.push_back(attr);
+
+    attr.id = SAI_PORT_ATTR_HW_LANE_LIST;
+    if (systemSide)
     {
-        if (m_gearboxInterfaceMap.find(port.m_index) != m_gearboxInterfaceMap.end())
-        {
-            SWSS_LOG_NOTICE("BOX: port_id:0x%" PRIx64 " index:%d alias:%s", port.m_port_id, port.m_index, port.m_alias.c_str());
+        lanes.assign(intf.system_lanes.begin(), intf.system_lanes.end());
+    }
+    else
+    {
+        lanes.assign(intf.line_lanes.begin(), intf.line_lanes.end());
+    }
+    attr.value.u32list.list = lanes.data();
+    attr.value.u32list.count = static_cast<uint32_t>(lanes.size());
+    attrs.push_back(attr);
 
-            phy_id = m_gearboxInterfaceMap[port.m_index].phy_id;
-            phyOidStr = m_gearboxPhyMap[phy_id].phy_oid;
+    for (uint32_t i = 0; i < attr.value.u32list.count; i++)
+    {
+        SWSS_LOG_DEBUG("BOX: list[%d] = %d", i, attr.value.u32list.list[i]);
+    }
 
-            if (phyOidStr.size() == 0)
-            {
-                SWSS_LOG_ERROR("BOX: Gearbox PHY phy_id:%d has an invalid phy_oid", phy_id);
-                return false;
-            }
+    attr.id = SAI_PORT_ATTR_SPEED;
+    attr.value.u32 = (uint32_t) (systemSide ? gbPort.system_speed : gbPort.line_speed) * (uint32_t) lanes.size();
+    if (isSpeedSupported(port.m_alias, port.m_port_id, attr.value.u32))
+    {
+        attrs.push_back(attr);
+    }
 
-            sai_deserialize_object_id(phyOidStr, phyOid);
+    attr.id = SAI_PORT_ATTR_AUTO_NEG_MODE;
+    attr.value.booldata = systemSide ? gbPort.system_auto_neg : gbPort.line_auto_neg;
+    attrs.push_back(attr);
 
-            SWSS_LOG_NOTICE("BOX: Gearbox port %s assigned phyOid 0x%" PRIx64, port.m_alias.c_str(), phyOid);
-            port.m_switch_id = phyOid;
+    const auto &fec = systemSide ? gbPort.system_fec : gbPort.line_fec;
+    attr.id = SAI_PORT_ATTR_FEC_MODE;
+    if (!m_portHlpr.fecToSaiFecMode(fec, sai_fec))
+    {
+        SWSS_LOG_ERROR("Invalid %s FEC mode %s", systemSide ? "system" : "line", fec.c_str());
+        return false;
+    }
+    attr.value.s32 = sai_fec;
+    attrs.push_back(attr);
 
-            /* Create SYSTEM-SIDE port */
-            attrs.clear();
+    // FEC override will take effect only when autoneg is enabled
+    if (fec_override_sup)
+    {
+        attr.id = SAI_PORT_ATTR_AUTO_NEG_FEC_MODE_OVERRIDE;
+        attr.value.booldata = m_portHlpr.fecIsOverrideRequired(fec);
+        attrs.push_back(attr);
+    }
 
-            attr.id = SAI_PORT_ATTR_ADMIN_STATE;
-            attr.value.booldata = port.m_admin_state_up;
-            attrs.push_back(attr);
+    if (!systemSide)
+    {
+        attr.id = SAI_PORT_ATTR_MEDIA_TYPE;
+        attr.value.u32 = media_type_map[gbPort.line_media_type];
+        attrs.push_back(attr);
+    }
 
-            attr.id = SAI_PORT_ATTR_HW_LANE_LIST;
-            lanes.assign(m_gearboxInterfaceMap[port.m_index].system_lanes.begin(), m_gearboxInterfaceMap[port.m_index].system_lanes.end());
-            attr.value.u32list.list = lanes.data();
-            attr.value.u32list.count = static_cast<uint32_t>(lanes.size());
-            attrs.push_back(attr);
+    attr.id = SAI_PORT_ATTR_INTERNAL_LOOPBACK_MODE;
+    attr.value.u32 = loopback_mode_map[systemSide ? gbPort.system_loopback : gbPort.line_loopback];
+    attrs.push_back(attr);
 
-            for (uint32_t i = 0; i < attr.value.u32list.count; i++)
-            {
-                SWSS_LOG_DEBUG("BOX: list[%d] = %d", i, attr.value.u32list.list[i]);
-            }
+    attr.id = SAI_PORT_ATTR_LINK_TRAINING_ENABLE;
+    attr.value.booldata = systemSide ? gbPort.system_training : gbPort.line_training;
+    attrs.push_back(attr);
 
-            attr.id = SAI_PORT_ATTR_SPEED;
-            attr.value.u32 = (uint32_t) m_gearboxPortMap[port.m_index].system_speed * (uint32_t) lanes.size();
-            if (isSpeedSupported(port.m_alias, port.m_port_id, attr.value.u32))
-            {
-                attrs.push_back(attr);
-            }
+    if (!systemSide)
+    {
+        attr.id = SAI_PORT_ATTR_INTERFACE_TYPE;
+        attr.value.u32 = interface_type_map[gbPort.line_intf_type];
+        attrs.push_back(attr);
 
-            attr.id = SAI_PORT_ATTR_AUTO_NEG_MODE;
-            attr.value.booldata = m_gearboxPortMap[port.m_index].system_auto_neg;
-            attrs.push_back(attr);
+        attr.id = SAI_PORT_ATTR_ADVERTISED_SPEED;
+        gbAttrs.adverSpeeds.assign(gbPort.line_adver_speed.begin(), gbPort.line_adver_speed.end());
+        attr.value.u32list.list = gbAttrs.adverSpeeds.data();
+        attr.value.u32list.count = static_cast<uint32_t>(gbAttrs.adverSpeeds.size());
+        attrs.push_back(attr);
 
-            attr.id = SAI_PORT_ATTR_FEC_MODE;
-            if (!m_portHlpr.fecToSaiFecMode(m_gearboxPortMap[port.m_index].system_fec, sai_fec))
-            {
-                SWSS_LOG_ERROR("Invalid system FEC mode %s", m_gearboxPortMap[port.m_index].system_fec.c_str());
-                return false;
-            }
-            attr.value.s32 = sai_fec;
-            attrs.push_back(attr);
+        attr.id = SAI_PORT_ATTR_ADVERTISED_FEC_MODE;
+        gbAttrs.adverFecs.assign(gbPort.line_adver_fec.begin(), gbPort.line_adver_fec.end());
+        attr.value.u32list.list = gbAttrs.adverFecs.data();
+        attr.value.u32list.count = static_cast<uint32_t>(gbAttrs.adverFecs.size());
+        attrs.push_back(attr);
 
-            if (fec_override_sup)
-            {
-                attr.id = SAI_PORT_ATTR_AUTO_NEG_FEC_MODE_OVERRIDE;
+        attr.id = SAI_PORT_ATTR_ADVERTISED_AUTO_NEG_MODE;
+        attr.value.booldata = gbPort.line_adver_auto_neg;
+        attrs.push_back(attr);
 
-                attr.value.booldata = m_portHlpr.fecIsOverrideRequired(m_gearboxPortMap[port.m_index].system_fec);
-                attrs.push_back(attr);
-            }
+        attr.id = SAI_PORT_ATTR_ADVERTISED_ASYMMETRIC_PAUSE_MODE;
+        attr.value.booldata = gbPort.line_adver_asym_pause;
+        attrs.push_back(attr);
 
-            attr.id = SAI_PORT_ATTR_INTERNAL_LOOPBACK_MODE;
-            attr.value.u32 = loopback_mode_map[m_gearboxPortMap[port.m_index].system_loopback];
-            attrs.push_back(attr);
+        attr.id = SAI_PORT_ATTR_ADVERTISED_MEDIA_TYPE;
+        attr.value.u32 = media_type_map[gbPort.line_adver_media_type];
+        attrs.push_back(attr);
+    }
 
-            attr.id = SAI_PORT_ATTR_LINK_TRAINING_ENABLE;
-            attr.value.booldata = m_gearboxPortMap[port.m_index].system_training;
-            attrs.push_back(attr);
+    if (m_cmisModuleAsicSyncSupported)
+    {
+        attr.id = SAI_PORT_ATTR_HOST_TX_SIGNAL_ENABLE;
+        attr.value.booldata = false;
+        attrs.push_back(attr);
+    }
 
-            if (m_cmisModuleAsicSyncSupported)
-            {
-                attr.id = SAI_PORT_ATTR_HOST_TX_SIGNAL_ENABLE;
-                attr.value.booldata = false;
-                attrs.push_back(attr);
-            }
+    return true;
+}
 
-            status = sai_port_api->create_port(&systemPort, phyOid, static_cast<uint32_t>(attrs.size()), attrs.data());
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("BOX: Failed to create Gearbox system-side port for alias:%s port_id:0x%" PRIx64 " index:%d status:%d",
-                        port.m_alias.c_str(), port.m_port_id, port.m_index, status);
-                task_process_status handle_status = handleSaiCreateStatus(SAI_API_PORT, status);
-                if (handle_status != task_success)
-                {
-                    return parseHandleSaiStatusFailure(handle_status);
-                }
-            }
-            SWSS_LOG_NOTICE("BOX: Created Gearbox system-side port 0x%" PRIx64 " for alias:%s index:%d",
-                    systemPort, port.m_alias.c_str(), port.m_index);
-            port.m_system_side_id = systemPort;
+/*
+ * Create the system-side and line-side gearbox ports of the ports. The ports
+ * of a PHY are created in a single bulk call to its SAI instance, one by one
+ * if the PHY SAI has no bulk support, and then connected.
+ */
+bool PortsOrch::initGearboxPorts(vector<Port> &ports)
+{
+    struct GearboxPortEntry
+    {
+        Port *port;
+        sai_object_id_t phyOid;
+        GearboxPortAttrs system;
+        GearboxPortAttrs line;
+    };
 
-            /* Create LINE-SIDE port */
-            attrs.clear();
+    SWSS_LOG_ENTER();
 
-            attr.id = SAI_PORT_ATTR_ADMIN_STATE;
-            attr.value.booldata = port.m_admin_state_up;
-            attrs.push_back(attr);
+    if (!m_gearboxEnabled)
+    {
+        return true;
+    }
 
-            attr.id = SAI_PORT_ATTR_HW_LANE_LIST;
-            lanes.assign(m_gearboxInterfaceMap[port.m_index].line_lanes.begin(), m_gearboxInterfaceMap[port.m_index].line_lanes.end());
-            attr.value.u32list.list = lanes.data();
-            attr.value.u32list.count = static_cast<uint32_t>(lanes.size());
-            attrs.push_back(attr);
+    bool result = true;
 
-            for (uint32_t i = 0; i < attr.value.u32list.count; i++)
-            {
-                SWSS_LOG_DEBUG("BOX: list[%d] = %d", i, attr.value.u32list.list[i]);
-            }
+    // Sized up front, the attributes point into the entries
+    vector<GearboxPortEntry> entries;
+    entries.reserve(ports.size());
 
-            attr.id = SAI_PORT_ATTR_SPEED;
-            attr.value.u32 = (uint32_t) m_gearboxPortMap[port.m_index].line_speed * (uint32_t) lanes.size();
-            if (isSpeedSupported(port.m_alias, port.m_port_id, attr.value.u32))
-            {
-                attrs.push_back(attr);
-            }
+    map<sai_object_id_t, vector<GearboxPortEntry *>> phyEntries;
 
-            attr.id = SAI_PORT_ATTR_AUTO_NEG_MODE;
-            attr.value.booldata = m_gearboxPortMap[port.m_index].line_auto_neg;
-            attrs.push_back(attr);
+    for (auto &port : ports)
+    {
+        if (m_gearboxInterfaceMap.find(port.m_index) == m_gearboxInterfaceMap.end())
+        {
+            continue;
+        }
 
-            attr.id = SAI_PORT_ATTR_FEC_MODE;
-            if (!m_portHlpr.fecToSaiFecMode(m_gearboxPortMap[port.m_index].line_fec, sai_fec))
-            {
-                SWSS_LOG_ERROR("Invalid line FEC mode %s", m_gearboxPortMap[port.m_index].line_fec.c_str());
-                return false;
-            }
-            attr.value.s32 = sai_fec;
-            attrs.push_back(attr);
+        SWSS_LOG_NOTICE("BOX: port_id:0x%" PRIx64 " index:%d alias:%s", port.m_port_id, port.m_index, port.m_alias.c_str());
 
-            // FEC override will take effect only when autoneg is enabled
-            if (fec_override_sup)
-            {
-                attr.id = SAI_PORT_ATTR_AUTO_NEG_FEC_MODE_OVERRIDE;
-                attr.value.booldata = m_portHlpr.fecIsOverrideRequired(m_gearboxPortMap[port.m_index].line_fec);
-                attrs.push_back(attr);
-            }
+        int phy_id = m_gearboxInterfaceMap[port.m_index].phy_id;
+        const auto &phyOidStr = m_gearboxPhyMap[phy_id].phy_oid;
 
-            attr.id = SAI_PORT_ATTR_MEDIA_TYPE;
-            attr.value.u32 = media_type_map[m_gearboxPortMap[port.m_index].line_media_type];
-            attrs.push_back(attr);
+        if (phyOidStr.size() == 0)
+        {
+            SWSS_LOG_ERROR("BOX: Gearbox PHY phy_id:%d has an invalid phy_oid", phy_id);
+            result = false;
+            continue;
+        }
 
-            attr.id = SAI_PORT_ATTR_INTERNAL_LOOPBACK_MODE;
-            attr.value.u32 = loopback_mode_map[m_gearboxPortMap[port.m_index].line_loopback];
-            attrs.push_back(attr);
+        sai_object_id_t phyOid;
+        sai_deserialize_object_id(phyOidStr, phyOid);
 
-            attr.id = SAI_PORT_ATTR_LINK_TRAINING_ENABLE;
-            attr.value.booldata = m_gearboxPortMap[port.m_index].line_training;
-            attrs.push_back(attr);
+        SWSS_LOG_NOTICE("BOX: Gearbox port %s assigned phyOid 0x%" PRIx64, port.m_alias.c_str(), phyOid);
+        port.m_switch_id = phyOid;
 
-            attr.id = SAI_PORT_ATTR_INTERFACE_TYPE;
-            attr.value.u32 = interface_type_map[m_gearboxPortMap[port.m_index].line_intf_type];
-            attrs.push_back(attr);
+        entries.emplace_back();
+        auto &entry = entries.back();
+        entry.port = &port;
+        entry.phyOid = phyOid;
 
-            attr.id = SAI_PORT_ATTR_ADVERTISED_SPEED;
-            vals.assign(m_gearboxPortMap[port.m_index].line_adver_speed.begin(), m_gearboxPortMap[port.m_index].line_adver_speed.end());
-            attr.value.u32list.list = vals.data();
-            attr.value.u32list.count = static_cast<uint32_t>(vals.size());
-            attrs.push_back(attr);
+        if (!getGearboxPortAttrs(port, true, entry.system) || !getGearboxPortAttrs(port, false, entry.line))
+        {
+            entries.pop_back();
+            result = false;
+            continue;
+        }
 
-            attr.id = SAI_PORT_ATTR_ADVERTISED_FEC_MODE;
-            vals.assign(m_gearboxPortMap[port.m_index].line_adver_fec.begin(), m_gearboxPortMap[port.m_index].line_adver_fec.end());
-            attr.value.u32list.list = vals.data();
-            attr.value.u32list.count = static_cast<uint32_t>(vals.size());
-            attrs.push_back(attr);
+        phyEntries[phyOid].push_back(&entry);
+    }
 
-            attr.id = SAI_PORT_ATTR_ADVERTISED_AUTO_NEG_MODE;
-            attr.value.booldata = m_gearboxPortMap[port.m_index].line_adver_auto_neg;
-            attrs.push_back(attr);
+    for (auto &it : phyEntries)
+    {
+        const auto phyOid = it.first;
+        const auto &phyPorts = it.second;
 
-            attr.id = SAI_PORT_ATTR_ADVERTISED_ASYMMETRIC_PAUSE_MODE;
-            attr.value.booldata = m_gearboxPortMap[port.m_index].line_adver_asym_pause;
-            attrs.push_back(attr);
+        // System-side and line-side ports of each port, side by side
+        vector<uint32_t> attrCounts;
+        vector<const sai_attribute_t *> attrLists;
+        for (auto *entry : phyPorts)
+        {
+            attrCounts.push_back(static_cast<uint32_t>(entry->system.attrs.size()));
+            attrLists.push_back(entry->system.attrs.data());
+            attrCounts.push_back(static_cast<uint32_t>(entry->line.attrs.size()));
+            attrLists.push_back(entry->line.attrs.data());
+        }
 
-            attr.id = SAI_PORT_ATTR_ADVERTISED_MEDIA_TYPE;
-            attr.value.u32 = media_type_map[m_gearboxPortMap[port.m_index].line_adver_media_type];
-            attrs.push_back(attr);
+        auto count = static_cast<uint32_t>(attrCounts.size());
+        vector<sai_object_id_t> oids(count, SAI_NULL_OBJECT_ID);
+        vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
 
-            if (m_cmisModuleAsicSyncSupported)
+        auto status = sai_port_api->create_ports(phyOid, count, attrCounts.data(), attrLists.data(),
+                                                 SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, oids.data(), statuses.data());
+        if (status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED)
+        {
+            SWSS_LOG_NOTICE("BOX: No bulk port creation on PHY 0x%" PRIx64 ", creating %u ports one by one", phyOid, count);
+            for (uint32_t i = 0; i < count; i++)
             {
-                attr.id = SAI_PORT_ATTR_HOST_TX_SIGNAL_ENABLE;
-                attr.value.booldata = false;
-                attrs.push_back(attr);
+                statuses[i] = sai_port_api->create_port(&oids[i], phyOid, attrCounts[i], attrLists[i]);
             }
+        }
 
-            status = sai_port_api->create_port(&linePort, phyOid, static_cast<uint32_t>(attrs.size()), attrs.data());
-            if (status != SAI_STATUS_SUCCESS)
+        for (size_t i = 0; i < phyPorts.size(); i++)
+        {
+            auto &port = *phyPorts[i]->port;
+            auto systemPort = oids[2 * i];
+            auto linePort = oids[2 * i + 1];
+
+            if (statuses[2 * i] != SAI_STATUS_SUCCESS)
             {
-                SWSS_LOG_ERROR("BOX: Failed to create Gearbox line-side port for alias:%s port_id:0x%" PRIx64 " index:%d status:%d",
-                   port.m_alias.c_str(), port.m_port_id, port.m_index, status);
-                task_process_status handle_status = handleSaiCreateStatus(SAI_API_PORT, status);
+                SWSS_LOG_ERROR("BOX: Failed to create Gearbox system-side port for alias:%s port_id:0x%" PRIx64 " index:%d status:%d",
+                        port.m_alias.c_str(), port.m_port_id, port.m_index, statuses[2 * i]);
+                task_process_status handle_status = handleSaiCreateStatus(SAI_API_PORT, statuses[2 * i]);
                 if (handle_status != task_success)
                 {
-                    return parseHandleSaiStatusFailure(handle_status);
+                    result = parseHandleSaiStatusFailure(handle_status) && result;
+                    continue;
                 }
             }
-            SWSS_LOG_NOTICE("BOX: Created Gearbox line-side port 0x%" PRIx64 " for alias:%s index:%d",
-                linePort, port.m_alias.c_str(), port.m_index);
-
-            /* Connect SYSTEM-SIDE to LINE-SIDE */
-            attrs.clear();
-
-            attr.id = SAI_PORT_CONNECTOR_ATTR_SYSTEM_SIDE_PORT_ID;
-            attr.value.oid = systemPort;
-            attrs.push_back(attr);
-            attr.id = SAI_PORT_CONNECTOR_ATTR_LINE_SIDE_PORT_ID;
-            attr.value.oid = linePort;
-            attrs.push_back(attr);
+            SWSS_LOG_NOTICE("BOX: Created Gearbox system-side port 0x%" PRIx64 " for alias:%s index:%d",
+                    systemPort, port.m_alias.c_str(), port.m_index);
+            port.m_system_side_id = systemPort;
 
-            status = sai_port_api->create_port_connector(&connector, phyOid, static_cast<uint32_t>(attrs.size()), attrs.data());
-            if (status != SAI_STATUS_SUCCESS)
+            if (statuses[2 * i + 1] != SAI_STATUS_SUCCESS)
             {
-                SWSS_LOG_ERROR("BOX: Failed to connect Gearbox system-side:0x%" PRIx64 " to line-side:0x%" PRIx64 "; status:%d", systemPort, linePort, status);
-                task_process_status handle_status = handleSaiCreateStatus(SAI_API_PORT, status);
+                SWSS_LOG_ERROR("BOX: Failed to create Gearbox line-side port for alias:%s port_id:0x%" PRIx64 " index:%d status:%d",
+                   port.m_alias.c_str(), port.m_port_id, port.m_index, statuses[2 * i + 1]);
+                task_process_status handle_status = handleSaiCreateStatus(SAI_API_PORT, statuses[2 * i + 1]);
                 if (handle_status != task_success)
                 {
-                    return parseHandleSaiStatusFailure(handle_status);
+                    result = parseHandleSaiStatusFailure(handle_status) && result;
+                    continue;
                 }
             }
+            SWSS_LOG_NOTICE("BOX: Created Gearbox line-side port 0x%" PRIx64 " for alias:%s index:%d",
+                linePort, port.m_alias.c_str(), port.m_index);
 
-            SWSS_LOG_NOTICE("BOX: Connected Gearbox ports; system-side:0x%" PRIx64 " to line-side:0x%" PRIx64, systemPort, linePort);
-            m_gearboxPortListLaneMap[port.m_port_id] = make_tuple(systemPort, linePort);
-            port.m_line_side_id = linePort;
-            saiOidToAlias[systemPort] = port.m_alias;
-            saiOidToAlias[linePort] = port.m_alias;
-
-            /* Add gearbox system/line port name map to counter table */
-            FieldValueTuple tuple(port.m_alias + "_system", sai_serialize_object_id(systemPort));
-            vector<FieldValueTuple> fields;
-            fields.push_back(tuple);
-            m_gbcounterTable->set("", fields);
-
-            fields[0] = FieldValueTuple(port.m_alias + "_line", sai_serialize_object_id(linePort));
-            m_gbcounterTable->set("", fields);
-
-            /* Set serdes tx taps on system and line side */
-            map<sai_port_serdes_attr_t, SerdesValue> serdes_attr;
-            typedef pair<sai_port_serdes_attr_t, SerdesValue> serdes_attr_pair;
-            vector<uint32_t> attr_val;
-            for (auto pair: tx_fir_strings_system_side) {
-                if (m_gearboxInterfaceMap[port.m_index].tx_firs.find(pair.first) != m_gearboxInterfaceMap[port.m_index].tx_firs.end() ) {
-                    attr_val.clear();
-                    getPortSerdesVal(m_gearboxInterfaceMap[port.m_index].tx_firs[pair.first], attr_val, 10);
-                    serdes_attr.insert(serdes_attr_pair(pair.second, attr_val));
-                }
-            }
-            if (serdes_attr.size() != 0)
-            {
-                if (setPortSerdesAttribute(systemPort, phyOid, serdes_attr))
-                {
-                    SWSS_LOG_NOTICE("Set port %s system side serdes attributes is success", port.m_alias.c_str());
-                }
-                else
-                {
-                    SWSS_LOG_ERROR("Failed to set port %s system side serdes attributes", port.m_alias.c_str());
-                    return false;
-                }
-            }
-            serdes_attr.clear();
-            for (auto pair: tx_fir_strings_line_side) {
-                if (m_gearboxInterfaceMap[port.m_index].tx_firs.find(pair.first) != m_gearboxInterfaceMap[port.m_index].tx_firs.end() ) {
-                    attr_val.clear();
-                    getPortSerdesVal(m_gearboxInterfaceMap[port.m_index].tx_firs[pair.first], attr_val, 10);
-                    serdes_attr.insert(serdes_attr_pair(pair.second, attr_val));
-                }
-            }
-            if (serdes_attr.size() != 0)
+            if (!connectGearboxPort(port, phyOid, systemPort, linePort))
             {
-                if (setPortSerdesAttribute(linePort, phyOid, serdes_attr))
-                {
-                    SWSS_LOG_NOTICE("Set port %s line side serdes attributes is success", port.m_alias.c_str());
-                }
-                else
-                {
-                    SWSS_LOG_ERROR("Failed to set port %s line side serdes attributes", port.m_alias.c_str());
-                    return false;
-                }
+                result = false;
             }
         }
     }
 
+    return result;
+}
+
+bool PortsOrch::initGearboxPort(Port &port)
+{
+    vector<Port> ports = { port };
+    bool result = initGearboxPorts(ports);
+    port = ports.front();
+    return result;
+}
+
+/*
+ * Connect the system-side and line-side gearbox ports of the port and set
+ * their serdes attributes.
+ */
+bool PortsOrch::connectGearboxPort(Port &port, sai_object_id_t phyOid, sai_object_id_t systemPort, sai_object_id_t linePort)
+{
+    vector<sai_attribute_t> attrs;
+    sai_attribute_t attr;
+    sai_object_id_t connector;
+    sai_status_t status;
+
+    /* Connect SYSTEM-SIDE to LINE-SIDE */
+    attr.id = SAI_PORT_CONNECTOR_ATTR_SYSTEM_SIDE_PORT_ID;
+    attr.value.oid = systemPort;
+    attrs.push_back(attr);
+    attr.id = SAI_PORT_CONNECTOR_ATTR_LINE_SIDE_PORT_ID;
+    attr.value.oid = linePort;
+    attrs.push_back(attr);
+
+    status = sai_port_api->create_port_connector(&connector, phyOid, static_cast<uint32_t>(attrs.size()), attrs.data());
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("BOX: Failed to connect Gearbox system-side:0x%" PRIx64 " to line-side:0x%" PRIx64 "; status:%d", systemPort, linePort, status);
+        task_process_status handle_status = handleSaiCreateStatus(SAI_API_PORT, status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+
+    SWSS_LOG_NOTICE("BOX: Connected Gearbox ports; system-side:0x%" PRIx64 " to line-side:0x%" PRIx64, systemPort, linePort);
+    m_gearboxPortListLaneMap[port.m_port_id] = make_tuple(systemPort, linePort);
+    port.m_line_side_id = linePort;
+    saiOidToAlias[systemPort] = port.m_alias;
+    saiOidToAlias[linePort] = port.m_alias;
+
+    /* Add gearbox system/line port name map to counter table */
+    FieldValueTuple tuple(port.m_alias + "_system", sai_serialize_object_id(systemPort));
+    vector<FieldValueTuple> fields;
+    fields.push_back(tuple);
+    m_gbcounterTable->set("", fields);
+
+    fields[0] = FieldValueTuple(port.m_alias + "_line", sai_serialize_object_id(linePort));
+    m_gbcounterTable->set("", fields);
+
+    /* Set serdes tx taps on system and line side */
+    map<sai_port_serdes_attr_t, SerdesValue> serdes_attr;
+    typedef pair<sai_port_serdes_attr_t, SerdesValue> serdes_attr_pair;
+    vector<uint32_t> attr_val;
+    for (auto pair: tx_fir_strings_system_side) {
+        if (m_gearboxInterfaceMap[port.m_index].tx_firs.find(pair.first) != m_gearboxInterfaceMap[port.m_index].tx_firs.end() ) {
+            attr_val.clear();
+            getPortSerdesVal(m_gearboxInterfaceMap[port.m_index].tx_firs[pair.first], attr_val, 10);
+            serdes_attr.insert(serdes_attr_pair(pair.second, attr_val));
+        }
+    }
+    if (serdes_attr.size() != 0)
+    {
+        if (setPortSerdesAttribute(systemPort, phyOid, serdes_attr))
+        {
+            SWSS_LOG_NOTICE("Set port %s system side serdes attributes is success", port.m_alias.c_str());
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to set port %s system side serdes attributes", port.m_alias.c_str());
+            return false;
+        }
+    }
+    serdes_attr.clear();
+    for (auto pair: tx_fir_strings_line_side) {
+        if (m_gearboxInterfaceMap[port.m_index].tx_firs.find(pair.first) != m_gearboxInterfaceMap[port.m_index].tx_firs.end() ) {
+            attr_val.clear();
+            getPortSerdesVal(m_gearboxInterfaceMap[port.m_index].tx_firs[pair.first], attr_val, 10);
+            serdes_attr.insert(serdes_attr_pair(pair.second, attr_val));
+        }
+    }
+    if (serdes_attr.size() != 0)
+    {
+        if (setPortSerdesAttribute(linePort, phyOid, serdes_attr))
+        {
+            SWSS_LOG_NOTICE("Set port %s line side serdes attributes is success", port.m_alias.c_str());
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to set port %s line side serdes attributes", port.m_alias.c_str());
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -11263,6 +12367,20 @@ void PortsOrch::updateGearboxPortOperStatus(const Port& port)
     }
 }
 
+bool PortsOrch::incrFdbCount(const std::string& alias, int count)
+{
+    auto itr = m_portList.find(alias);
+    if (itr == m_portList.end())
+    {
+        return false;
+    }
+    else
+    {
+        itr->second.m_fdb_count += count;
+    }
+    return true;
+}
+
 bool PortsOrch::decrFdbCount(const std::string& alias, int count)
 {
     auto itr = m_portList.find(alias);
@@ -11708,6 +12826,12 @@ bool PortsOrch::removePtTam(sai_object_id_t tam_id)
 
 void PortsOrch::doTask(swss::SelectableTimer &timer)
 {
+    if (&timer == m_port_status_auditor)
+    {
+        auditPortStatus();
+        return;
+    }
+
     Port port;
 
     for (auto it = m_port_state_poll.begin(); it != m_port_state_poll.end(); )
@@ -1,11 +1,15 @@
 #ifndef SWSS_PORTSORCH_H
 #define SWSS_PORTSORCH_H
 
+#include <deque>
+#include <functional>
 #include <map>
 #include <unordered_set>
 
 #include "acltable.h"
 #include "orch.h"
+#include "zmqorch.h"
+#include "zmqserver.h"
 #include "port.h"
 #include "observer.h"
 #include "macaddress.h"
@@ -16,10 +20,12 @@
 #include "lagid.h"
 #include "flexcounterorch.h"
 #include "events.h"
+#include "bulker.h"
 
 #include "port/port_capabilities.h"
 #include "port/porthlpr.h"
 #include "port/portschema.h"
+#include "port/portregistry.h"
 
 #include "high_frequency_telemetry/counternameupdater.h"
 
@@ -111,6 +117,28 @@ struct VlanMemberUpdate
     bool add;
 };
 
+/* Port attribute set deferred to the end of a PORT_TABLE drain */
+struct PortAttrBulkOp
+{
+    string alias;
+    sai_object_id_t port_id;
+    sai_attribute_t attr;
+    sai_status_t status;
+    // Put back to m_toSync when the completion asks for a retry
+    KeyOpFieldsValuesTuple task;
+    // Bookkeeping once the attribute is set, returns false to retry the task
+    std::function<bool(Port &, sai_status_t)> complete;
+};
+
+/* Port removal deferred to the end of a PORT_TABLE drain */
+struct PortRemoveBulkOp
+{
+    string alias;
+    sai_object_id_t port_id;
+    // Put back to m_toSync when the port is still in use
+    KeyOpFieldsValuesTuple task;
+};
+
 struct queueInfo
 {
     // SAI_QUEUE_ATTR_TYPE
@@ -148,10 +176,11 @@ namespace portphyserdesattr_test
 class PortSerdesAttrTest;
 } // namespace portphyserdesattr_test
 
-class PortsOrch : public Orch, public Subject
+class PortsOrch : public ZmqOrch, public Subject
 {
 public:
-    PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_with_pri_t> &tableNames, DBConnector *chassisAppDb);
+    /* The LAG and LAG member tables are read from the ZMQ channel of zmqServer if any */
+    PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_with_pri_t> &tableNames, DBConnector *chassisAppDb, swss::ZmqServer *zmqServer = nullptr);
 
     bool allPortsReady();
     bool isInitDone();
@@ -166,6 +195,17 @@ public:
     bool setBridgePortLearningFDB(Port &port, sai_bridge_port_fdb_learning_mode_t mode);
     bool getPort(string alias, Port &port);
     bool getPort(sai_object_id_t id, Port &port);
+    /*
+     * Lookups without copying the Port. The pointer refers to the stored
+     * Port, null if there is none, and stays valid until the port is removed.
+     * Changes still go through setPort().
+     */
+    const Port *findPort(const string &alias) const;
+    const Port *findPort(sai_object_id_t id) const;
+    const Port *findPortByBridgePortId(sai_object_id_t bridge_port_id) const;
+    bool getPortOid(const string &alias, sai_object_id_t &port_id) const;
+    bool getBridgePortOid(const string &alias, sai_object_id_t &bridge_port_id) const;
+    bool getVlanId(sai_object_id_t bv_id, sai_vlan_id_t &vlan_id) const;
     void increasePortRefCount(const string &alias);
     void decreasePortRefCount(const string &alias);
     bool getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port);
@@ -179,6 +219,8 @@ public:
     bool setHostIntfsOperStatus(const Port& port, bool up) const;
     void updateDbPortOperStatus(const Port& port, sai_port_oper_status_t status) const;
     void updateDbPortFlapCount(Port& port, sai_port_oper_status_t pstatus);
+    /* Account flaps at once, with the last down and up times when the flaps went down or up */
+    void updateDbPortFlapCount(Port& port, uint32_t flaps, bool wentDown, bool wentUp);
     void updateDbPortOperError(Port& port, PortOperErrorEvent *pevent);
 
     bool createVlanHostIntf(Port& vl, string hostif_name);
@@ -229,6 +271,14 @@ public:
     void addPriorityGroupFlexCounters(map<string, FlexCounterPgStates> pgsStateVector);
     void addPriorityGroupWatermarkFlexCounters(map<string, FlexCounterPgStates> pgsStateVector);
 
+    /*
+     * Registers the queue and PG counters of a physical port only while it
+     * is in use: from its first oper up until it goes down while admin down.
+     * The counter name maps keep covering every port.
+     */
+    void setCountersOperUpOnly(bool enable);
+    bool isPortInUse(const string &alias) const;
+
     void generatePortCounterMap();
     void generatePortBufferDropCounterMap();
 
@@ -251,6 +301,8 @@ public:
     void flushCounters();
 
     void refreshPortStatus();
+    void refreshPortStatus(const vector<Port *> &ports, bool audit);
+    void refreshPortOperSpeedFec(const vector<Port *> &ports);
     bool removeAclTableGroup(const Port &p);
 
     bool addSubPort(Port &port, const string &alias, const string &vlan, const bool &adminUp = true, const uint32_t &mtu = 0);
@@ -264,6 +316,7 @@ public:
     bool addBridgePort(Port &port);
     bool removeBridgePort(Port &port);
     bool addVlanMember(Port &vlan, Port &port, string& tagging_mode, string end_point_ip = "");
+    void addVlanMembers(const vector<pair<string, string>> &members, const string &tagging_mode, vector<bool> &success);
     bool removeVlanMember(Port &vlan, Port &port, string end_point_ip = "");
     bool isVlanMember(Port &vlan, Port &port, string end_point_ip = "");
     bool addVlanFloodGroups(Port &vlan, Port &port, string end_point_ip);
@@ -285,9 +338,11 @@ public:
     bool setPortIPG(sai_object_id_t port_id, uint32_t ipg);
 
     bool getPortOperStatus(const Port& port, sai_port_oper_status_t& status) const;
+    void getPortOperStatus(const vector<Port *> &ports, vector<sai_port_oper_status_t> &statuses, vector<bool> &valid) const;
 
     void updateGearboxPortOperStatus(const Port& port);
 
+    bool incrFdbCount(const string& alias, int count);
     bool decrFdbCount(const string& alias, int count);
 
     void setMACsecEnabledState(sai_object_id_t port_id, bool enabled);
@@ -309,7 +364,6 @@ private:
     unique_ptr<Table> m_systemPortTable;
     unique_ptr<Table> m_gearboxTable;
     unique_ptr<CounterNameMapUpdater> m_queueCounterNameMapUpdater;
-    unique_ptr<Table> m_voqTable;
     unique_ptr<Table> m_queuePortTable;
     unique_ptr<Table> m_queueIndexTable;
     unique_ptr<Table> m_queueTypeTable;
@@ -377,6 +431,7 @@ private:
     } dest_port_type_t;
 
     bool m_gearboxEnabled = false;
+    GearboxUtils m_gearbox;
     map<int, gearbox_phy_t> m_gearboxPhyMap;
     map<int, gearbox_interface_t> m_gearboxInterfaceMap;
     map<int, gearbox_lane_t> m_gearboxLaneMap;
@@ -388,7 +443,7 @@ private:
     sai_uint32_t m_portCount;
     map<set<uint32_t>, sai_object_id_t> m_portListLaneMap;
     map<set<uint32_t>, PortConfig> m_lanesAliasSpeedMap;
-    map<string, Port> m_portList;
+    PortRegistry m_portList;
     map<string, Port> m_pluggedModulesPort;
     map<string, vlan_members_t> m_portVlanMember;
     map<string, std::vector<sai_object_id_t>> m_port_voq_ids;
@@ -417,21 +472,73 @@ private:
 
     swss::SelectableTimer *m_port_state_poller = nullptr;
 
+    /*
+     * Oper status audit catching missed notifications, a slice of the ports
+     * per tick, resuming at the alias after the last one audited
+     */
+    swss::SelectableTimer *m_port_status_auditor = nullptr;
+    string m_portStatusAuditCursor;
+    void auditPortStatus();
+
     bool m_cmisModuleAsicSyncSupported = false;
 
+    /*
+     * While a PORT_TABLE drain holds several entries, MTU and final admin state
+     * sets are queued and issued through one ObjectBulker<sai_port_api_t> flush
+     */
+    bool m_portAttrBulkSupported = false;
+    bool m_portAttrBulkMode = false;
+    std::deque<PortAttrBulkOp> m_portAttrBulkOps;
+    std::unordered_set<string> m_portAttrBulkAliases;
+
+    void queuePortAttr(const Port &port, const sai_attribute_t &attr, const KeyOpFieldsValuesTuple &task,
+                       std::function<bool(Port &, sai_status_t)> complete);
+    void flushPortAttrBulk(ConsumerBase &consumer);
+
+    /*
+     * A breakout removes and creates a port group in one drain: the removals
+     * are queued and issued with one remove_ports call, the new ports behind
+     * the first one created join its addPortBulk()
+     */
+    bool m_portRemoveBulkSupported = false;
+    std::deque<PortRemoveBulkOp> m_portRemoveBulkOps;
+    std::unordered_set<string> m_portRemoveBulkAliases;
+
+    void flushPortRemoveBulk(ConsumerBase &consumer);
+    void collectNewPorts(ConsumerBase &consumer, SyncMap::iterator from, std::vector<PortConfig> &portsToAddList);
+
     void doTask() override;
     void onWarmBootEnd() override;
-    void doTask(Consumer &consumer);
-    void doPortTask(Consumer &consumer);
-    void doSendToIngressPortTask(Consumer &consumer);
-    void doVlanTask(Consumer &consumer);
-    void doVlanMemberTask(Consumer &consumer);
-    void doLagTask(Consumer &consumer);
-    void doLagMemberTask(Consumer &consumer);
-    void doTransceiverPresenceCheck(Consumer &consumer);
+    void doTask(ConsumerBase &consumer) override;
+    void doPortTask(ConsumerBase &consumer);
+    void doSendToIngressPortTask(ConsumerBase &consumer);
+    void doVlanTask(ConsumerBase &consumer);
+    void doVlanMemberTask(ConsumerBase &consumer);
+    void doLagTask(ConsumerBase &consumer);
+    void doLagMemberTask(ConsumerBase &consumer);
+    void doTransceiverPresenceCheck(ConsumerBase &consumer);
 
     void doTask(NotificationConsumer &consumer);
     void handleNotification(NotificationConsumer &consumer, KeyOpFieldsValuesTuple& entry);
+
+    /*
+     * Oper status notifications of a port over the burst doTask() pops,
+     * handled once at the last status. Each change still counts as a flap.
+     */
+    struct PortOperStatusChange
+    {
+        sai_port_oper_status_t initial;
+        sai_port_oper_status_t last;
+        uint32_t ups = 0;
+        uint32_t downs = 0;
+        uint32_t changes = 0;
+        vector<sai_port_error_status_t> errors;
+    };
+    vector<sai_object_id_t> m_operStatusOrder;
+    unordered_map<sai_object_id_t, PortOperStatusChange> m_operStatusChanges;
+
+    void queuePortOperStatus(sai_object_id_t id, sai_port_oper_status_t status, sai_port_error_status_t error);
+    void processPortOperStatus();
     void doTask(swss::SelectableTimer &timer);
 
     void removePortFromLanesMap(string alias);
@@ -456,8 +563,10 @@ private:
 
     bool addVlan(string vlan);
     bool removeVlan(Port vlan);
+    bool addVlanMemberPost(Port &vlan, Port &port, sai_object_id_t vlan_member_id, sai_vlan_tagging_mode_t sai_tagging_mode);
 
     bool addLag(string lag, uint32_t spa_id, int32_t switch_id);
+    void allocateLagIds(ConsumerBase &consumer);
     bool removeLag(Port lag);
     bool setLagTpid(sai_object_id_t id, sai_uint16_t tpid);
     bool addLagMember(Port &lag, Port &port, string status);
@@ -466,6 +575,8 @@ private:
     bool setDistributionOnLagMember(Port &lagMember, bool enableDistribution);
 
     sai_status_t removePort(sai_object_id_t port_id);
+    void prepareRemovePort(sai_object_id_t port_id);
+    void finishRemovePort(const string &alias, sai_object_id_t port_id);
     bool initExistingPort(const PortConfig &port);
     bool initPortsBulk(std::vector<Port>& ports);
     void registerPort(Port &p);
@@ -478,10 +589,15 @@ private:
     void postPortInit(Port &p);
 
     bool setPortAdminStatus(Port &port, bool up);
+    void preparePortAdminStatus(Port &port, bool up, sai_attribute_t &attr);
+    bool completePortAdminStatus(Port &port, bool up, sai_status_t status);
     bool getPortAdminStatus(sai_object_id_t id, bool& up);
     bool getPortMtu(const Port& port, sai_uint32_t &mtu);
     bool getPortHostTxReady(const Port& port, bool &hostTxReadyVal);
     bool setPortMtu(const Port& port, sai_uint32_t mtu);
+    void preparePortMtu(const Port& port, sai_uint32_t mtu, sai_attribute_t &attr);
+    bool completePortMtu(const Port& port, sai_uint32_t mtu, const sai_attribute_t &attr, sai_status_t status);
+    void updatePortMtu(Port &p, sai_uint32_t mtu);
     bool setPortTpid(Port &port, sai_uint16_t tpid);
     bool setPortPvid (Port &port, sai_uint32_t pvid);
     bool getPortPvid(Port &port, sai_uint32_t &pvid);
@@ -515,8 +631,26 @@ private:
 
     bool getQueueTypeAndIndex(sai_object_id_t queue_id, sai_queue_type_t &type, uint8_t &index);
 
+    /* Counter DB map entries of many ports, written at once */
+    struct QueueMaps
+    {
+        vector<FieldValueTuple> names;
+        vector<FieldValueTuple> voqNames;
+        vector<FieldValueTuple> ports;
+        vector<FieldValueTuple> indices;
+        vector<FieldValueTuple> types;
+    };
+    struct PriorityGroupMaps
+    {
+        vector<FieldValueTuple> names;
+        vector<FieldValueTuple> ports;
+        vector<FieldValueTuple> indices;
+    };
+
     bool m_isQueueMapGenerated = false;
     void generateQueueMapPerPort(const Port& port, FlexCounterQueueStates& queuesState, bool voq);
+    void generateQueueMapPerPort(const Port& port, FlexCounterQueueStates& queuesState, bool voq, QueueMaps& maps);
+    void writeQueueMaps(const QueueMaps& maps);
     bool m_isQueueFlexCountersAdded = false;
     void addQueueFlexCountersPerPort(const Port& port, FlexCounterQueueStates& queuesState);
     void addQueueFlexCountersPerPortPerQueueIndex(const Port& port, size_t queueIndex, bool voq, sai_queue_type_t queueType);
@@ -531,6 +665,8 @@ private:
 
     bool m_isPriorityGroupMapGenerated = false;
     void generatePriorityGroupMapPerPort(const Port& port, FlexCounterPgStates& pgsState);
+    void generatePriorityGroupMapPerPort(const Port& port, FlexCounterPgStates& pgsState, PriorityGroupMaps& maps);
+    void writePriorityGroupMaps(const PriorityGroupMaps& maps);
     bool m_isPriorityGroupFlexCountersAdded = false;
     void addPriorityGroupFlexCountersPerPort(const Port& port, FlexCounterPgStates& pgsState);
     void addPriorityGroupFlexCountersPerPortPerPgIndex(const Port& port, size_t pgIndex);
@@ -539,6 +675,27 @@ private:
     void addPriorityGroupWatermarkFlexCountersPerPort(const Port& port, FlexCounterPgStates& pgsState);
     void addPriorityGroupWatermarkFlexCountersPerPortPerPgIndex(const Port& port, size_t pgIndex);
 
+    /* Queue or PG flex counter of a port, keyed by kind and index */
+    enum class PortBufferCounter
+    {
+        QUEUE,
+        QUEUE_WATERMARK,
+        WRED_QUEUE,
+        PG_DROP,
+        PG_WATERMARK,
+    };
+    typedef pair<PortBufferCounter, size_t> PortBufferCounterKey;
+
+    bool m_countersOperUpOnly = false;
+    /* Ports up since they were last brought down administratively */
+    set<string> m_portsInUse;
+    /* Queue and PG counters requested on each port, registered or deferred */
+    map<string, map<PortBufferCounterKey, sai_queue_type_t>> m_portBufferCounters;
+    bool trackPortBufferCounter(const Port& port, PortBufferCounter counter, size_t index, sai_queue_type_t queueType);
+    void untrackPortBufferCounter(const Port& port, PortBufferCounter counter, size_t index);
+    void setPortBufferCountersRegistered(const Port& port, bool registered);
+    void updatePortInUse(const Port& port, sai_port_oper_status_t status);
+
     bool m_isPortCounterMapGenerated = false;
     bool m_isPortBufferDropCounterMapGenerated = false;
 
@@ -591,8 +748,20 @@ private:
 
     ReturnCode addSendToIngressHostIf(const std::string &send_to_ingress_name);
     ReturnCode removeSendToIngressHostIf();
+    // Attributes of a gearbox port and the lists they point to
+    struct GearboxPortAttrs
+    {
+        std::vector<sai_attribute_t> attrs;
+        std::vector<uint32_t> lanes;
+        std::vector<uint32_t> adverSpeeds;
+        std::vector<uint32_t> adverFecs;
+    };
+
     void initGearbox();
+    bool getGearboxPortAttrs(const Port &port, bool systemSide, GearboxPortAttrs &gbAttrs);
+    bool initGearboxPorts(std::vector<Port> &ports);
     bool initGearboxPort(Port &port);
+    bool connectGearboxPort(Port &port, sai_object_id_t phyOid, sai_object_id_t systemPort, sai_object_id_t linePort);
     bool getPortOperFec(const Port& port, sai_port_fec_mode_t &fec_mode) const;
     void updateDbPortOperFec(Port &port, string fec_str);
     void updatePortErrorStatus(Port &port, sai_port_error_status_t port_oper_eror);
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "ipaddress.h"
+#include "ipprefix.h"
+
+/*
+ * Prefixes of one VRF indexed by their bits, one binary trie per address
+ * family. A prefix is stored at the depth of its mask length.
+ *
+ * Finding the prefixes covering a route walks the route bits from the root
+ * down to the route mask length at most, so the cost follows the prefix
+ * length instead of the number of stored prefixes.
+ */
+template <typename T>
+class PrefixTrie
+{
+public:
+    PrefixTrie() = default;
+
+    PrefixTrie(const PrefixTrie&) = delete;
+    PrefixTrie& operator=(const PrefixTrie&) = delete;
+
+    bool empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
+
+    /* Returns false if the prefix is already present, its value is left as is */
+    bool insert(const swss::IpPrefix &prefix, const T &value)
+    {
+        auto ip = prefix.getIp();
+        auto node = &root(prefix.isV4());
+        for (unsigned bit = 0; bit < length(prefix); bit++)
+        {
+            auto &child = (*node)->child[bitAt(ip, bit)];
+            if (!child)
+            {
+                child.reset(new Node());
+            }
+            node = &child;
+        }
+
+        if ((*node)->present)
+        {
+            return false;
+        }
+
+        (*node)->present = true;
+        (*node)->value = value;
+        m_size++;
+        return true;
+    }
+
+    /* Returns false if the prefix is not present */
+    bool erase(const swss::IpPrefix &prefix)
+    {
+        if (!eraseFrom(root(prefix.isV4()), prefix.getIp(), 0, length(prefix)))
+        {
+            return false;
+        }
+
+        m_size--;
+        return true;
+    }
+
+    /* Returns the value of the longest stored prefix covering prefix, null if none */
+    const T *longestMatch(const swss::IpPrefix &prefix) const
+    {
+        return longestMatch(prefix.getIp(), prefix.isV4(), length(prefix));
+    }
+
+    /* Returns the value of the longest stored prefix covering the address, null if none */
+    const T *longestMatch(const swss::IpAddress &ip) const
+    {
+        return longestMatch(ip, ip.isV4(), width(ip.isV4()));
+    }
+
+    /* Returns the value stored for exactly this prefix, null if none */
+    T *find(const swss::IpPrefix &prefix)
+    {
+        Node *node = nodeAt(prefix);
+        return node && node->present ? &node->value : nullptr;
+    }
+
+    /* Returns true if a stored prefix lies within prefix, prefix itself included */
+    bool hasWithin(const swss::IpPrefix &prefix) const
+    {
+        // Empty branches are pruned, any node left leads to a stored prefix
+        const Node *node = nodeAt(prefix);
+        return node && (node->present || node->child[0] || node->child[1]);
+    }
+
+private:
+    struct Node
+    {
+        std::unique_ptr<Node> child[2];
+        bool present = false;
+        T value{};
+    };
+
+    static unsigned width(bool v4) { return v4 ? 32 : 128; }
+
+    static unsigned length(const swss::IpPrefix &prefix)
+    {
+        unsigned len = static_cast<unsigned>(prefix.getMaskLength());
+        unsigned max = width(prefix.isV4());
+        return len < max ? len : max;
+    }
+
+    static unsigned bitAt(const swss::IpAddress &ip, unsigned bit)
+    {
+        ip_addr_t addr = ip.getIp();
+        const uint8_t *bytes = addr.family == AF_INET ? reinterpret_cast<const uint8_t *>(&addr.ip_addr.ipv4_addr)
+                                                      : addr.ip_addr.ipv6_addr;
+        return (bytes[bit / 8] >> (7 - bit % 8)) & 1u;
+    }
+
+    const T *longestMatch(const swss::IpAddress &ip, bool v4, unsigned len) const
+    {
+        const Node *node = (v4 ? m_v4 : m_v6).get();
+        const T *match = nullptr;
+
+        for (unsigned bit = 0; node; bit++)
+        {
+            if (node->present)
+            {
+                match = &node->value;
+            }
+
+            if (bit == len)
+            {
+                break;
+            }
+            node = node->child[bitAt(ip, bit)].get();
+        }
+
+        return match;
+    }
+
+    Node *nodeAt(const swss::IpPrefix &prefix) const
+    {
+        auto ip = prefix.getIp();
+        Node *node = (prefix.isV4() ? m_v4 : m_v6).get();
+
+        unsigned len = length(prefix);
+        for (unsigned bit = 0; node && bit < len; bit++)
+        {
+            node = node->child[bitAt(ip, bit)].get();
+        }
+
+        return node;
+    }
+
+    std::unique_ptr<Node> &root(bool v4)
+    {
+        auto &node = v4 ? m_v4 : m_v6;
+        if (!node)
+        {
+            node.reset(new Node());
+        }
+        return node;
+    }
+
+    bool eraseFrom(std::unique_ptr<Node> &node, const swss::IpAddress &ip, unsigned bit, unsigned len)
+    {
+        if (!node)
+        {
+            return false;
+        }
+
+        if (bit == len)
+        {
+            if (!node->present)
+            {
+                return false;
+            }
+            node->present = false;
+            node->value = T{};
+        }
+        else if (!eraseFrom(node->child[bitAt(ip, bit)], ip, bit + 1, len))
+        {
+            return false;
+        }
+
+        // Prune the branch once nothing is left below it
+        if (!node->present && !node->child[0] && !node->child[1])
+        {
+            node.reset();
+        }
+        return true;
+    }
+
+    std::unique_ptr<Node> m_v4;
+    std::unique_ptr<Node> m_v6;
+    size_t m_size = 0;
+};
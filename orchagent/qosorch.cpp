@@ -4,8 +4,11 @@
 #include "crmorch.h"
 #include "sai_serialize.h"
 #include "cbf/nhgmaporch.h"
+#include "bulker.h"
 
 #include <inttypes.h>
+#include <algorithm>
+#include <cstring>
 #include <stdlib.h>
 #include <sstream>
 #include <iostream>
@@ -32,6 +35,7 @@ extern CrmOrch *gCrmOrch;
 extern string gMySwitchType;
 extern string gMyHostName;
 extern string gMyAsicName;
+extern size_t gMaxBulkSize;
 
 map<string, sai_ecn_mark_mode_t> ecn_map = {
     {"ecn_none", SAI_ECN_MARK_MODE_NONE},
@@ -116,6 +120,21 @@ map<string, string> qos_to_ref_table_map = {
     {encap_tc_to_queue_field_name, CFG_TC_TO_QUEUE_MAP_TABLE_NAME}
 };
 
+/* QoS map tables whose maps of identical contents share one SAI object */
+static const map<string, sai_qos_map_type_t> shared_qos_map_types = {
+    {CFG_DSCP_TO_TC_MAP_TABLE_NAME, SAI_QOS_MAP_TYPE_DSCP_TO_TC},
+    {CFG_MPLS_TC_TO_TC_MAP_TABLE_NAME, SAI_QOS_MAP_TYPE_MPLS_EXP_TO_TC},
+    {CFG_DOT1P_TO_TC_MAP_TABLE_NAME, SAI_QOS_MAP_TYPE_DOT1P_TO_TC},
+    {CFG_TC_TO_QUEUE_MAP_TABLE_NAME, SAI_QOS_MAP_TYPE_TC_TO_QUEUE},
+    {CFG_TC_TO_DOT1P_MAP_TABLE_NAME, SAI_QOS_MAP_TYPE_TC_AND_COLOR_TO_DOT1P},
+    {CFG_TC_TO_DSCP_MAP_TABLE_NAME, SAI_QOS_MAP_TYPE_TC_AND_COLOR_TO_DSCP},
+    {CFG_TC_TO_PRIORITY_GROUP_MAP_TABLE_NAME, SAI_QOS_MAP_TYPE_TC_TO_PRIORITY_GROUP},
+    {CFG_PFC_PRIORITY_TO_PRIORITY_GROUP_MAP_TABLE_NAME, SAI_QOS_MAP_TYPE_PFC_PRIORITY_TO_PRIORITY_GROUP},
+    {CFG_PFC_PRIORITY_TO_QUEUE_MAP_TABLE_NAME, SAI_QOS_MAP_TYPE_PFC_PRIORITY_TO_QUEUE},
+    {CFG_DSCP_TO_FC_MAP_TABLE_NAME, SAI_QOS_MAP_TYPE_DSCP_TO_FORWARDING_CLASS},
+    {CFG_EXP_TO_FC_MAP_TABLE_NAME, SAI_QOS_MAP_TYPE_MPLS_EXP_TO_FORWARDING_CLASS}
+};
+
 #define DSCP_MAX_VAL 63
 #define EXP_MAX_VAL 7
 
@@ -146,28 +165,66 @@ task_process_status QosMapHandler::processWorkItem(Consumer& consumer, KeyOpFiel
         {
             return task_process_status::task_invalid_entry;
         }
+        QosOrch::SharedQosMap qos_map;
+        bool shareable = QosOrch::getQosMapContent(qos_map_type_name, attributes, qos_map);
         if (SAI_NULL_OBJECT_ID != sai_object)
         {
-            if (!modifyQosItem(sai_object, attributes))
+            if (shareable && gQosOrch->isSharedQosMapContent(sai_object, qos_map.content))
             {
-                SWSS_LOG_ERROR("Failed to set [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
-                freeAttribResources(attributes);
-                return task_process_status::task_failed;
+                SWSS_LOG_INFO("[%s:%s] is unchanged", qos_map_type_name.c_str(), qos_object_name.c_str());
+            }
+            else if (shareable && gQosOrch->getSharedQosMapRefCount(sai_object) > 1)
+            {
+                if (!gQosOrch->moveQosMap(qos_map_type_name, qos_object_name, qos_map))
+                {
+                    SWSS_LOG_ERROR("Failed to set [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
+                    freeAttribResources(attributes);
+                    return task_process_status::task_failed;
+                }
+                SWSS_LOG_NOTICE("Set [%s:%s] to a separate object", qos_map_type_name.c_str(), qos_object_name.c_str());
+            }
+            else
+            {
+                if (!modifyQosItem(sai_object, attributes))
+                {
+                    SWSS_LOG_ERROR("Failed to set [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
+                    freeAttribResources(attributes);
+                    return task_process_status::task_failed;
+                }
+                if (shareable)
+                {
+                    gQosOrch->updateSharedQosMap(sai_object, qos_map);
+                }
+                SWSS_LOG_NOTICE("Set [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
             }
-            SWSS_LOG_NOTICE("Set [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
         }
         else
         {
-            sai_object = addQosItem(attributes);
-            if (sai_object == SAI_NULL_OBJECT_ID)
+            if (shareable)
             {
-                SWSS_LOG_ERROR("Failed to create [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
-                freeAttribResources(attributes);
-                return task_process_status::task_failed;
+                sai_object = gQosOrch->acquireSharedQosMap(qos_map.content);
+            }
+            if (sai_object != SAI_NULL_OBJECT_ID)
+            {
+                SWSS_LOG_NOTICE("Created [%s:%s] sharing object %" PRIx64, qos_map_type_name.c_str(), qos_object_name.c_str(), sai_object);
+            }
+            else
+            {
+                sai_object = addQosItem(attributes);
+                if (sai_object == SAI_NULL_OBJECT_ID)
+                {
+                    SWSS_LOG_ERROR("Failed to create [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
+                    freeAttribResources(attributes);
+                    return task_process_status::task_failed;
+                }
+                if (shareable)
+                {
+                    gQosOrch->addSharedQosMap(sai_object, qos_map);
+                }
+                SWSS_LOG_NOTICE("Created [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
             }
             (*(QosOrch::getTypeMap()[qos_map_type_name]))[qos_object_name].m_saiObjectId = sai_object;
             (*(QosOrch::getTypeMap()[qos_map_type_name]))[qos_object_name].m_pendingRemove = false;
-            SWSS_LOG_NOTICE("Created [%s:%s]", qos_map_type_name.c_str(), qos_object_name.c_str());
         }
         freeAttribResources(attributes);
     }
@@ -185,10 +242,19 @@ task_process_status QosMapHandler::processWorkItem(Consumer& consumer, KeyOpFiel
             (*(QosOrch::getTypeMap()[qos_map_type_name]))[qos_object_name].m_pendingRemove = true;
             return task_process_status::task_need_retry;
         }
-        if (!removeQosItem(sai_object))
+        if (gQosOrch->getSharedQosMapRefCount(sai_object) > 1)
+        {
+            gQosOrch->releaseSharedQosMap(sai_object);
+            SWSS_LOG_INFO("Object %" PRIx64 " of %s is still shared", sai_object, qos_object_name.c_str());
+        }
+        else
         {
-            SWSS_LOG_ERROR("Failed to remove QoS map. db name:%s sai object:%" PRIx64, qos_object_name.c_str(), sai_object);
-            return task_process_status::task_failed;
+            if (!removeQosItem(sai_object))
+            {
+                SWSS_LOG_ERROR("Failed to remove QoS map. db name:%s sai object:%" PRIx64, qos_object_name.c_str(), sai_object);
+                return task_process_status::task_failed;
+            }
+            gQosOrch->releaseSharedQosMap(sai_object);
         }
         auto it_to_delete = (QosOrch::getTypeMap()[qos_map_type_name])->find(qos_object_name);
         (QosOrch::getTypeMap()[qos_map_type_name])->erase(it_to_delete);
@@ -1323,6 +1389,268 @@ type_map& QosOrch::getTypeMap()
     return m_qos_maps;
 }
 
+bool QosOrch::getQosMapContent(const string &map_type_name, const vector<sai_attribute_t> &attributes, SharedQosMap &qos_map)
+{
+    auto type = shared_qos_map_types.find(map_type_name);
+    if (type == shared_qos_map_types.end() || attributes.size() != 1 ||
+        attributes[0].id != SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST)
+    {
+        return false;
+    }
+
+    const auto &list = attributes[0].value.qosmap;
+    qos_map.type = type->second;
+    qos_map.entries.assign(list.list, list.list + list.count);
+    sort(qos_map.entries.begin(), qos_map.entries.end(), [](const sai_qos_map_t &a, const sai_qos_map_t &b) {
+        return memcmp(&a.key, &b.key, sizeof(a.key)) < 0;
+    });
+
+    // The entries are value initialized, their bytes identify the contents
+    qos_map.content.assign(reinterpret_cast<const char *>(&qos_map.type), sizeof(qos_map.type));
+    qos_map.content.append(reinterpret_cast<const char *>(qos_map.entries.data()), qos_map.entries.size() * sizeof(sai_qos_map_t));
+    return true;
+}
+
+sai_object_id_t QosOrch::acquireSharedQosMap(const string &content)
+{
+    auto found = m_qos_maps_by_content.find(content);
+    if (found == m_qos_maps_by_content.end())
+    {
+        return SAI_NULL_OBJECT_ID;
+    }
+
+    m_shared_qos_maps[found->second].ref_count++;
+    return found->second;
+}
+
+sai_object_id_t QosOrch::createSharedQosMap(SharedQosMap qos_map)
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_attribute_t> attrs(2);
+    attrs[0].id = SAI_QOS_MAP_ATTR_TYPE;
+    attrs[0].value.s32 = qos_map.type;
+    attrs[1].id = SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST;
+    attrs[1].value.qosmap.count = static_cast<uint32_t>(qos_map.entries.size());
+    attrs[1].value.qosmap.list = qos_map.entries.data();
+
+    sai_object_id_t sai_object;
+    sai_status_t sai_status = sai_qos_map_api->create_qos_map(&sai_object, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    if (SAI_STATUS_SUCCESS != sai_status)
+    {
+        SWSS_LOG_ERROR("Failed to create QoS map of type %d, status:%d", qos_map.type, sai_status);
+        return SAI_NULL_OBJECT_ID;
+    }
+
+    addSharedQosMap(sai_object, std::move(qos_map));
+    return sai_object;
+}
+
+void QosOrch::addSharedQosMap(sai_object_id_t sai_object, SharedQosMap qos_map)
+{
+    qos_map.ref_count = 1;
+    qos_map.pinned = false;
+    m_qos_maps_by_content.emplace(qos_map.content, sai_object);
+    m_shared_qos_maps[sai_object] = std::move(qos_map);
+}
+
+void QosOrch::updateSharedQosMap(sai_object_id_t sai_object, SharedQosMap qos_map)
+{
+    auto shared = m_shared_qos_maps.find(sai_object);
+    if (shared == m_shared_qos_maps.end())
+    {
+        return;
+    }
+
+    auto indexed = m_qos_maps_by_content.find(shared->second.content);
+    if (indexed != m_qos_maps_by_content.end() && indexed->second == sai_object)
+    {
+        m_qos_maps_by_content.erase(indexed);
+    }
+
+    qos_map.ref_count = shared->second.ref_count;
+    qos_map.pinned = shared->second.pinned;
+    if (!qos_map.pinned)
+    {
+        m_qos_maps_by_content.emplace(qos_map.content, sai_object);
+    }
+    shared->second = std::move(qos_map);
+}
+
+/* Returns true if the object was used by one map at most, and is to be removed */
+bool QosOrch::releaseSharedQosMap(sai_object_id_t sai_object)
+{
+    auto shared = m_shared_qos_maps.find(sai_object);
+    if (shared == m_shared_qos_maps.end())
+    {
+        return true;
+    }
+
+    if (--shared->second.ref_count > 0)
+    {
+        return false;
+    }
+
+    auto indexed = m_qos_maps_by_content.find(shared->second.content);
+    if (indexed != m_qos_maps_by_content.end() && indexed->second == sai_object)
+    {
+        m_qos_maps_by_content.erase(indexed);
+    }
+    m_shared_qos_maps.erase(shared);
+    return true;
+}
+
+uint32_t QosOrch::getSharedQosMapRefCount(sai_object_id_t sai_object) const
+{
+    auto shared = m_shared_qos_maps.find(sai_object);
+    return shared == m_shared_qos_maps.end() ? 0 : shared->second.ref_count;
+}
+
+bool QosOrch::isSharedQosMapContent(sai_object_id_t sai_object, const string &content) const
+{
+    auto shared = m_shared_qos_maps.find(sai_object);
+    return shared != m_shared_qos_maps.end() && shared->second.content == content;
+}
+
+bool QosOrch::moveQosMap(const string &map_type_name, const string &map_name, SharedQosMap qos_map)
+{
+    SWSS_LOG_ENTER();
+
+    auto &object = (*m_qos_maps[map_type_name])[map_name];
+    sai_object_id_t old_object = object.m_saiObjectId;
+
+    sai_object_id_t new_object = acquireSharedQosMap(qos_map.content);
+    if (new_object == SAI_NULL_OBJECT_ID)
+    {
+        new_object = createSharedQosMap(std::move(qos_map));
+        if (new_object == SAI_NULL_OBJECT_ID)
+        {
+            return false;
+        }
+    }
+
+    if (!rebindQosMap(map_type_name, map_name, new_object))
+    {
+        // Ports that failed still use the old object, which is kept for them
+        rebindQosMap(map_type_name, map_name, old_object);
+        if (releaseSharedQosMap(new_object))
+        {
+            sai_qos_map_api->remove_qos_map(new_object);
+        }
+        return false;
+    }
+
+    object.m_saiObjectId = new_object;
+    releaseSharedQosMap(old_object);
+    return true;
+}
+
+/* Apply the object to the ports and the switch the QoS map is applied to */
+bool QosOrch::rebindQosMap(const string &map_type_name, const string &map_name, sai_object_id_t sai_object)
+{
+    SWSS_LOG_ENTER();
+
+    const string reference = map_type_name + delimiter + map_name;
+    vector<pair<string, sai_attribute_t>> port_attrs;
+    vector<sai_object_id_t> port_ids;
+    bool result = true;
+
+    for (const auto &port_qos_map : *m_qos_maps[CFG_PORT_QOS_MAP_TABLE_NAME])
+    {
+        for (const auto &field : port_qos_map.second.m_objsReferencingByMe)
+        {
+            auto attr_id = qos_to_attr_map.find(field.first);
+            if (field.second != reference || attr_id == qos_to_attr_map.end())
+            {
+                continue;
+            }
+
+            if (port_qos_map.first == PORT_NAME_GLOBAL)
+            {
+                result = applyDscpToTcMapToSwitch(SAI_SWITCH_ATTR_QOS_DSCP_TO_TC_MAP, sai_object) && result;
+                continue;
+            }
+
+            for (const auto &port_name : tokenize(port_qos_map.first, list_item_delimiter))
+            {
+                Port port;
+                if (!gPortsOrch->getPort(port_name, port))
+                {
+                    continue;
+                }
+
+                sai_attribute_t attr;
+                attr.id = attr_id->second;
+                attr.value.oid = sai_object;
+                port_attrs.emplace_back(port_name, attr);
+                port_ids.push_back(port.m_port_id);
+            }
+        }
+    }
+
+    ObjectBulker<sai_port_api_t> bulker(sai_port_api, gSwitchId, gMaxBulkSize);
+    vector<sai_status_t> statuses(port_attrs.size());
+    for (size_t i = 0; i < port_attrs.size(); i++)
+    {
+        bulker.set_entry_attribute(&statuses[i], port_ids[i], &port_attrs[i].second);
+    }
+    bulker.flush();
+
+    for (size_t i = 0; i < port_attrs.size(); i++)
+    {
+        sai_status_t status = statuses[i];
+        if (is_bulk_unsupported(status))
+        {
+            status = sai_port_api->set_port_attribute(port_ids[i], &port_attrs[i].second);
+        }
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to apply %s to port %s, rv:%d",
+                           map_name.c_str(), port_attrs[i].first.c_str(), status);
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+/* Give the QoS map an object that isn't shared, for a tunnel that can't be re-bound */
+sai_object_id_t QosOrch::pinQosMap(const string &map_type_name, const string &map_name)
+{
+    SWSS_LOG_ENTER();
+
+    auto &object = (*m_qos_maps[map_type_name])[map_name];
+    auto shared = m_shared_qos_maps.find(object.m_saiObjectId);
+    if (shared == m_shared_qos_maps.end() || shared->second.pinned)
+    {
+        return object.m_saiObjectId;
+    }
+
+    if (shared->second.ref_count > 1)
+    {
+        SharedQosMap qos_map = shared->second;
+        sai_object_id_t old_object = object.m_saiObjectId;
+        sai_object_id_t new_object = createSharedQosMap(qos_map);
+        if (new_object == SAI_NULL_OBJECT_ID)
+        {
+            return SAI_NULL_OBJECT_ID;
+        }
+        // The contents are the same, ports left on the old object behave the same
+        rebindQosMap(map_type_name, map_name, new_object);
+        object.m_saiObjectId = new_object;
+        releaseSharedQosMap(old_object);
+        shared = m_shared_qos_maps.find(new_object);
+    }
+
+    auto indexed = m_qos_maps_by_content.find(shared->second.content);
+    if (indexed != m_qos_maps_by_content.end() && indexed->second == shared->first)
+    {
+        m_qos_maps_by_content.erase(indexed);
+    }
+    shared->second.pinned = true;
+    return shared->first;
+}
+
 void QosOrch::initTableHandlers()
 {
     SWSS_LOG_ENTER();
@@ -2172,6 +2500,7 @@ task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer, KeyOpFiel
         }
     }
 
+    vector<Port> ports;
     for (string port_name : port_names)
     {
         Port port;
@@ -2182,15 +2511,43 @@ task_process_status QosOrch::handlePortQosMapTable(Consumer& consumer, KeyOpFiel
             SWSS_LOG_ERROR("Failed to apply QoS maps to port %s. Port is not found.", port_name.c_str());
             continue;
         }
+        ports.push_back(port);
+    }
+
+    /* Apply the list of attributes to all the ports at once */
+    vector<sai_attribute_t> attrs;
+    for (auto it = update_list.begin(); it != update_list.end(); it++)
+    {
+        sai_attribute_t attr;
+        attr.id = it->first;
+        attr.value.oid = it->second.second;
+        attrs.push_back(attr);
+    }
 
-        /* Apply a list of attributes to be applied */
-        for (auto it = update_list.begin(); it != update_list.end(); it++)
+    ObjectBulker<sai_port_api_t> bulker(sai_port_api, gSwitchId, gMaxBulkSize);
+    vector<sai_status_t> statuses(ports.size() * attrs.size());
+    for (size_t i = 0; i < ports.size(); i++)
+    {
+        for (size_t j = 0; j < attrs.size(); j++)
         {
-            sai_attribute_t attr;
-            attr.id = it->first;
-            attr.value.oid = it->second.second;
+            bulker.set_entry_attribute(&statuses[i * attrs.size() + j], ports[i].m_port_id, &attrs[j]);
+        }
+    }
+    bulker.flush();
+
+    for (size_t i = 0; i < ports.size(); i++)
+    {
+        auto &port = ports[i];
+        const string &port_name = port.m_alias;
 
-            sai_status_t status = sai_port_api->set_port_attribute(port.m_port_id, &attr);
+        auto it = update_list.begin();
+        for (size_t j = 0; j < attrs.size(); j++, it++)
+        {
+            sai_status_t status = statuses[i * attrs.size() + j];
+            if (is_bulk_unsupported(status))
+            {
+                status = sai_port_api->set_port_attribute(port.m_port_id, &attrs[j]);
+            }
             if (status != SAI_STATUS_SUCCESS)
             {
                 SWSS_LOG_ERROR("Failed to apply %s to port %s, rv:%d",
@@ -2318,7 +2675,14 @@ sai_object_id_t QosOrch::resolveTunnelQosMap(std::string referencing_table_name,
     ref_resolve_status status = resolveFieldRefValue(m_qos_maps, map_type_name, qos_to_ref_table_map.at(map_type_name), tuple, id, object_name);
     if (status == ref_resolve_status::success)
     {
-        
+        const string &map_table_name = qos_to_ref_table_map.at(map_type_name);
+        id = pinQosMap(map_table_name, object_name.substr(map_table_name.size() + 1));
+        if (id == SAI_NULL_OBJECT_ID)
+        {
+            SWSS_LOG_ERROR("Failed to resolve QoS map for table %s tunnel %s type %s", referencing_table_name.c_str(), tunnel_name.c_str(), map_type_name.c_str());
+            return SAI_NULL_OBJECT_ID;
+        }
+
         setObjectReference(m_qos_maps, referencing_table_name, tunnel_name, map_type_name, object_name);
         SWSS_LOG_INFO("Resolved QoS map for table %s tunnel %s type %s name %s", referencing_table_name.c_str(), tunnel_name.c_str(), map_type_name.c_str(), object_name.c_str());
         return id;
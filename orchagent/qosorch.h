@@ -227,9 +227,40 @@ private:
     bool applySchedulerToQueueSchedulerGroup(Port &port, size_t queue_ind, sai_object_id_t scheduler_profile_id);
     bool applyWredProfileToQueue(Port &port, size_t queue_ind, sai_object_id_t sai_wred_profile);
     bool applyDscpToTcMapToSwitch(sai_attr_id_t attr_id, sai_object_id_t sai_dscp_to_tc_map);
+
+    /*
+     * QoS maps of identical contents share one SAI object, looked up by the
+     * map type and sorted entries and counted by the named maps using it. A
+     * shared map whose contents change moves to an object of the new contents
+     * and the ports it's applied to are re-bound. Tunnels aren't re-bound, a
+     * map resolved by a tunnel gets an object of its own that isn't shared.
+     */
+    struct SharedQosMap
+    {
+        std::string content;
+        sai_qos_map_type_t type;
+        std::vector<sai_qos_map_t> entries;
+        uint32_t ref_count = 0;
+        bool pinned = false;
+    };
+
+    static bool getQosMapContent(const string &map_type_name, const vector<sai_attribute_t> &attributes, SharedQosMap &qos_map);
+    sai_object_id_t acquireSharedQosMap(const string &content);
+    sai_object_id_t createSharedQosMap(SharedQosMap qos_map);
+    void addSharedQosMap(sai_object_id_t sai_object, SharedQosMap qos_map);
+    void updateSharedQosMap(sai_object_id_t sai_object, SharedQosMap qos_map);
+    bool releaseSharedQosMap(sai_object_id_t sai_object);
+    uint32_t getSharedQosMapRefCount(sai_object_id_t sai_object) const;
+    bool isSharedQosMapContent(sai_object_id_t sai_object, const string &content) const;
+    bool moveQosMap(const string &map_type_name, const string &map_name, SharedQosMap qos_map);
+    bool rebindQosMap(const string &map_type_name, const string &map_name, sai_object_id_t sai_object);
+    sai_object_id_t pinQosMap(const string &map_type_name, const string &map_name);
 private:
     qos_table_handler_map m_qos_handler_map;
 
+    std::unordered_map<std::string, sai_object_id_t> m_qos_maps_by_content;
+    std::unordered_map<sai_object_id_t, SharedQosMap> m_shared_qos_maps;
+
     struct SchedulerGroupPortInfo_t
     {
         std::vector<sai_object_id_t> groups;
@@ -0,0 +1,398 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * Pool of interned object names used by the Orch reference tracking.
+ *
+ * Every name gets a small integer handle while at least one set holds it,
+ * handles of released names are reused. Only to be used from the thread
+ * serving the Orchs using type_map.
+ */
+class ObjectNamePool
+{
+public:
+    typedef uint32_t Handle;
+
+    /* Handle 0 is never assigned and stands for an unknown name */
+    static constexpr Handle INVALID_HANDLE = 0;
+
+    static ObjectNamePool& instance()
+    {
+        // Never destroyed, sets may be released after the static destructors ran
+        static ObjectNamePool *pool = new ObjectNamePool();
+        return *pool;
+    }
+
+    /* Return the handle of the name and take a reference on it */
+    Handle acquire(const std::string &name)
+    {
+        auto it = m_handles.find(name);
+        if (it != m_handles.end())
+        {
+            m_entries[it->second - 1].refs++;
+            return it->second;
+        }
+
+        Handle handle;
+        if (m_free.empty())
+        {
+            m_entries.emplace_back();
+            handle = static_cast<Handle>(m_entries.size());
+        }
+        else
+        {
+            handle = m_free.back();
+            m_free.pop_back();
+        }
+
+        auto rc = m_handles.emplace(name, handle);
+        m_entries[handle - 1] = Entry{&rc.first->first, 1};
+        return handle;
+    }
+
+    void acquire(Handle handle)
+    {
+        m_entries[handle - 1].refs++;
+    }
+
+    /* Drop a reference, the name is forgotten with its last reference */
+    void release(Handle handle)
+    {
+        auto &entry = m_entries[handle - 1];
+        if (--entry.refs == 0)
+        {
+            m_handles.erase(*entry.name);
+            entry.name = nullptr;
+            m_free.push_back(handle);
+        }
+    }
+
+    /* Handle of a name currently held, INVALID_HANDLE otherwise */
+    Handle lookup(const std::string &name) const
+    {
+        auto it = m_handles.find(name);
+        return it == m_handles.end() ? INVALID_HANDLE : it->second;
+    }
+
+    const std::string &name(Handle handle) const
+    {
+        return *m_entries[handle - 1].name;
+    }
+
+    size_t size() const { return m_handles.size(); }
+
+private:
+    ObjectNamePool() = default;
+
+    struct Entry
+    {
+        // Points to the key of m_handles, which is stable
+        const std::string *name;
+        size_t refs;
+    };
+
+    std::unordered_map<std::string, Handle> m_handles;
+    std::vector<Entry> m_entries;
+    std::vector<Handle> m_free;
+};
+
+/*
+ * Set of object names, stored as interned handles in an open addressing
+ * hash table. Adding and removing a name is O(1) and an entry takes 4
+ * bytes instead of a tree node holding a string copy, which matters for
+ * profiles referenced by every queue or priority group of the switch.
+ *
+ * The interface follows the std::set<std::string> it replaces, iteration
+ * yields names but in no particular order.
+ */
+class ReferenceSet
+{
+public:
+    typedef ObjectNamePool::Handle Handle;
+    typedef size_t size_type;
+
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::string value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string *pointer;
+        typedef const std::string &reference;
+
+        const_iterator(const ReferenceSet *set, size_t pos) : m_set(set), m_pos(pos)
+        {
+            skip();
+        }
+
+        reference operator*() const { return ObjectNamePool::instance().name(m_set->m_slots[m_pos]); }
+        pointer operator->() const { return &**this; }
+
+        const_iterator &operator++()
+        {
+            m_pos++;
+            skip();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const const_iterator &other) const { return m_pos == other.m_pos; }
+        bool operator!=(const const_iterator &other) const { return m_pos != other.m_pos; }
+
+    private:
+        void skip()
+        {
+            while (m_pos < m_set->m_slots.size() && !isOccupied(m_set->m_slots[m_pos]))
+            {
+                m_pos++;
+            }
+        }
+
+        const ReferenceSet *m_set;
+        size_t m_pos;
+    };
+
+    typedef const_iterator iterator;
+
+    ReferenceSet() = default;
+
+    ReferenceSet(const ReferenceSet &other) : m_slots(other.m_slots), m_size(other.m_size), m_used(other.m_used)
+    {
+        acquireAll();
+    }
+
+    ReferenceSet(ReferenceSet &&other) noexcept : m_slots(std::move(other.m_slots)), m_size(other.m_size), m_used(other.m_used)
+    {
+        other.m_slots.clear();
+        other.m_size = 0;
+        other.m_used = 0;
+    }
+
+    ReferenceSet &operator=(const ReferenceSet &other)
+    {
+        if (this != &other)
+        {
+            ReferenceSet copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    ReferenceSet &operator=(ReferenceSet &&other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~ReferenceSet()
+    {
+        clear();
+    }
+
+    void swap(ReferenceSet &other) noexcept
+    {
+        m_slots.swap(other.m_slots);
+        std::swap(m_size, other.m_size);
+        std::swap(m_used, other.m_used);
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_slots.size()); }
+
+    size_type size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    void clear()
+    {
+        for (auto handle : m_slots)
+        {
+            if (isOccupied(handle))
+            {
+                ObjectNamePool::instance().release(handle);
+            }
+        }
+        m_slots.clear();
+        m_size = 0;
+        m_used = 0;
+    }
+
+    std::pair<const_iterator, bool> insert(const std::string &name)
+    {
+        auto &pool = ObjectNamePool::instance();
+
+        Handle handle = pool.lookup(name);
+        size_t pos = findSlot(handle);
+        if (pos != NPOS)
+        {
+            return std::make_pair(const_iterator(this, pos), false);
+        }
+
+        if (handle == EMPTY)
+        {
+            handle = pool.acquire(name);
+        }
+        else
+        {
+            pool.acquire(handle);
+        }
+
+        return std::make_pair(const_iterator(this, place(handle)), true);
+    }
+
+    size_type erase(const std::string &name)
+    {
+        size_t pos = findSlot(ObjectNamePool::instance().lookup(name));
+        if (pos == NPOS)
+        {
+            return 0;
+        }
+
+        Handle handle = m_slots[pos];
+        m_slots[pos] = DELETED;
+        ObjectNamePool::instance().release(handle);
+
+        if (--m_size == 0)
+        {
+            clear();
+        }
+
+        return 1;
+    }
+
+    size_type count(const std::string &name) const
+    {
+        return findSlot(ObjectNamePool::instance().lookup(name)) == NPOS ? 0 : 1;
+    }
+
+    const_iterator find(const std::string &name) const
+    {
+        size_t pos = findSlot(ObjectNamePool::instance().lookup(name));
+        return pos == NPOS ? end() : const_iterator(this, pos);
+    }
+
+private:
+    static constexpr Handle EMPTY = ObjectNamePool::INVALID_HANDLE;
+    static constexpr Handle DELETED = UINT32_MAX;
+    static constexpr size_t NPOS = SIZE_MAX;
+    static constexpr size_t MIN_SLOTS = 4;
+
+    static bool isOccupied(Handle handle) { return handle != EMPTY && handle != DELETED; }
+
+    void acquireAll()
+    {
+        for (auto handle : m_slots)
+        {
+            if (isOccupied(handle))
+            {
+                ObjectNamePool::instance().acquire(handle);
+            }
+        }
+    }
+
+    /* Store a handle known to be absent, return its slot */
+    size_t place(Handle handle)
+    {
+        // Keep the load, tombstones included, under 3/4
+        if ((m_used + 1) * 4 > m_slots.size() * 3)
+        {
+            rehash(m_size + 1);
+        }
+
+        size_t mask = m_slots.size() - 1;
+        size_t tombstone = NPOS;
+        size_t pos;
+        for (pos = hash(handle) & mask; m_slots[pos] != EMPTY; pos = (pos + 1) & mask)
+        {
+            if (m_slots[pos] == DELETED && tombstone == NPOS)
+            {
+                tombstone = pos;
+            }
+        }
+
+        if (tombstone != NPOS)
+        {
+            pos = tombstone;
+        }
+        else
+        {
+            m_used++;
+        }
+
+        m_slots[pos] = handle;
+        m_size++;
+        return pos;
+    }
+
+    static size_t hash(Handle handle)
+    {
+        return static_cast<size_t>(handle * 0x9E3779B1u);
+    }
+
+    size_t findSlot(Handle handle) const
+    {
+        if (handle == EMPTY || m_slots.empty())
+        {
+            return NPOS;
+        }
+
+        size_t mask = m_slots.size() - 1;
+        for (size_t pos = hash(handle) & mask; m_slots[pos] != EMPTY; pos = (pos + 1) & mask)
+        {
+            if (m_slots[pos] == handle)
+            {
+                return pos;
+            }
+        }
+
+        return NPOS;
+    }
+
+    void rehash(size_t minSize)
+    {
+        size_t slots = MIN_SLOTS;
+        while (minSize * 4 > slots * 3)
+        {
+            slots *= 2;
+        }
+
+        std::vector<Handle> old;
+        old.swap(m_slots);
+        m_slots.assign(slots, Handle(EMPTY));
+        m_size = 0;
+        m_used = 0;
+
+        for (auto handle : old)
+        {
+            if (isOccupied(handle))
+            {
+                size_t mask = m_slots.size() - 1;
+                size_t pos = hash(handle) & mask;
+                while (m_slots[pos] != EMPTY)
+                {
+                    pos = (pos + 1) & mask;
+                }
+                m_slots[pos] = handle;
+                m_size++;
+                m_used++;
+            }
+        }
+    }
+
+    std::vector<Handle> m_slots;
+    // Live entries
+    size_t m_size = 0;
+    // Live entries and tombstones
+    size_t m_used = 0;
+};
@@ -15,6 +15,47 @@
 using namespace std;
 using namespace swss;
 
+/*
+ * Call func for every item of a comma separated list, with the splitting
+ * rules of std::getline: an empty string has no item and a trailing comma
+ * does not start one. Items are copied into the caller's scratch buffer.
+ */
+template <typename Func>
+static void forEachListItem(const std::string& str, std::string& item, Func func)
+{
+    size_t start = 0;
+    while (start < str.size())
+    {
+        size_t end = str.find(',', start);
+        if (end == std::string::npos)
+        {
+            end = str.size();
+        }
+
+        item.assign(str, start, end - start);
+        func(item);
+        start = end + 1;
+    }
+}
+
+
+RequestSchema::RequestSchema(const request_description_t& request_description)
+{
+    attr_names_.reserve(request_description.attr_item_types.size());
+    attr_types_.reserve(request_description.attr_item_types.size());
+
+    for (const auto& item: request_description.attr_item_types)
+    {
+        attr_slots_.emplace(item.first, attr_names_.size());
+        attr_names_.push_back(item.first);
+        attr_types_.push_back(item.second);
+    }
+
+    for (const auto& attr: request_description.mandatory_attr_items)
+    {
+        mandatory_slots_.emplace_back(attr, find(attr));
+    }
+}
 
 void Request::parse(const KeyOpFieldsValuesTuple& request)
 {
@@ -23,6 +64,10 @@ void Request::parse(const KeyOpFieldsValuesTuple& request)
         throw std::logic_error("The parser already has a parsed request");
     }
 
+    // Drop whatever a previous, possibly failed, parse left behind
+    generation_++;
+    number_of_attrs_ = 0;
+
     parseOperation(request);
     parseKey(request);
     parseAttrs(request);
@@ -34,18 +79,36 @@ void Request::clear()
 {
     operation_.clear();
     full_key_.clear();
-    attr_names_.clear();
-    key_item_strings_.clear();
-    key_item_mac_addresses_.clear();
-    attr_item_strings_.clear();
-    attr_item_bools_.clear();
-    attr_item_mac_addresses_.clear();
-    attr_item_packet_actions_.clear();
-    attr_item_string_list_.clear();
+    generation_++;
+    number_of_attrs_ = 0;
 
     is_parsed_ = false;
 }
 
+const RequestValue& Request::getKey(int position, request_types_t type) const
+{
+    if (position < 0 || static_cast<size_t>(position) >= number_of_key_items_
+        || request_description_.key_item_types[position] != type
+        || key_values_[position].generation != generation_)
+    {
+        throw std::out_of_range(std::string("No key item of the requested type at position ") + std::to_string(position));
+    }
+
+    return key_values_[position];
+}
+
+const RequestValue& Request::getAttr(const std::string& attr_name, request_types_t type) const
+{
+    size_t slot = schema_.find(attr_name);
+    if (slot == RequestSchema::npos || schema_.type(slot) != type
+        || attr_values_[slot].generation != generation_)
+    {
+        throw std::out_of_range(std::string("No attribute of the requested type: ") + attr_name);
+    }
+
+    return attr_values_[slot];
+}
+
 void Request::parseOperation(const KeyOpFieldsValuesTuple& request)
 {
     operation_ = kfvOp(request);
@@ -59,17 +122,35 @@ void Request::parseKey(const KeyOpFieldsValuesTuple& request)
 {
     full_key_ = kfvKey(request);
 
-    // split the key by separator
-    std::vector<std::string> key_items;
+    // split the key by separator, reusing the item buffers of the previous requests
+    size_t key_item_count = 0;
     size_t key_item_start = 0;
-    size_t key_item_end = full_key_.find(key_separator_);
-    while (key_item_end != std::string::npos)
+    size_t last_item_start = 0;
+    while (true)
     {
-        key_items.push_back(full_key_.substr(key_item_start, key_item_end - key_item_start));
+        size_t key_item_end = full_key_.find(key_separator_, key_item_start);
+        size_t len = (key_item_end == std::string::npos ? full_key_.length() : key_item_end) - key_item_start;
+
+        if (key_item_count == number_of_key_items_ - 1)
+        {
+            last_item_start = key_item_start;
+        }
+        if (key_item_count < key_items_.size())
+        {
+            key_items_[key_item_count].assign(full_key_, key_item_start, len);
+        }
+        else
+        {
+            key_items_.emplace_back(full_key_, key_item_start, len);
+        }
+        key_item_count++;
+
+        if (key_item_end == std::string::npos)
+        {
+            break;
+        }
         key_item_start = key_item_end + 1;
-        key_item_end = full_key_.find(key_separator_, key_item_start);
     }
-    key_items.push_back(full_key_.substr(key_item_start, full_key_.length()));
 
     /*
      * Attempt to parse an IPv6/MAC address only if the following conditions are met:
@@ -85,25 +166,15 @@ void Request::parseKey(const KeyOpFieldsValuesTuple& request)
      *     - This runs under the assumption that an IPv6 address, if present, will always be the last key item
      */
     if (key_separator_ == ':' and 
-        key_items.size() > number_of_key_items_ and 
+        key_item_count > number_of_key_items_ and 
         (request_description_.key_item_types.back() == REQ_T_IP or request_description_.key_item_types.back() == REQ_T_IP_PREFIX
         or request_description_.key_item_types.back() == REQ_T_MAC_ADDRESS))
     {
-        // Remove key_items so that key_items.size() is correct, then assemble the removed items into an IPv6 address
-        std::vector<std::string> ip_addr_groups(--key_items.begin() + number_of_key_items_, key_items.end());
-        key_items.erase(--key_items.begin() + number_of_key_items_, key_items.end());
-
-        std::string ip_string;
-
-        for (const auto &i : ip_addr_groups)
-        {
-            ip_string += i + ":";
-        }
-        ip_string.pop_back(); // remove extra ":" from end of string
-
-        key_items.push_back(ip_string);
+        // The surplus items are groups of the address, which is the rest of the key
+        key_items_[number_of_key_items_ - 1].assign(full_key_, last_item_start, std::string::npos);
+        key_item_count = number_of_key_items_;
     }
-    if (key_items.size() != number_of_key_items_)
+    if (key_item_count != number_of_key_items_)
     {
         throw std::invalid_argument(std::string("Wrong number of key items. Expected ")
                                   + std::to_string(number_of_key_items_)
@@ -115,36 +186,36 @@ void Request::parseKey(const KeyOpFieldsValuesTuple& request)
     // check types of the key items
     for (int i = 0; i < static_cast<int>(number_of_key_items_); i++)
     {
+        auto& value = key_values_[i];
         switch(request_description_.key_item_types[i])
         {
             case REQ_T_STRING:
-                key_item_strings_[i] = key_items[i];
+                value.str = key_items_[i];
                 break;
             case REQ_T_MAC_ADDRESS:
-                key_item_mac_addresses_[i] = parseMacAddress(key_items[i]);
+                value.mac = parseMacAddress(key_items_[i]);
                 break;
             case REQ_T_IP:
-                key_item_ip_addresses_[i] = parseIpAddress(key_items[i]);
+                value.ip = parseIpAddress(key_items_[i]);
                 break;
             case REQ_T_IP_PREFIX:
-                key_item_ip_prefix_[i] = parseIpPrefix(key_items[i]);
+                value.ip_prefix = parseIpPrefix(key_items_[i]);
                 break;
             case REQ_T_UINT:
-                key_item_uint_[i] = parseUint(key_items[i]);
+                value.uint = parseUint(key_items_[i]);
                 break;
             default:
                 throw std::logic_error(std::string("Not implemented key type parser. Key '")
                                      + full_key_
                                      + std::string("'. Key item:")
-                                     + key_items[i]);
+                                     + key_items_[i]);
         }
+        value.generation = generation_;
     }
 }
 
 void Request::parseAttrs(const KeyOpFieldsValuesTuple& request)
 {
-    const auto not_found = std::end(request_description_.attr_item_types);
-
     for (auto i = kfvFieldsValues(request).begin();
          i != kfvFieldsValues(request).end(); i++)
     {
@@ -154,8 +225,8 @@ void Request::parseAttrs(const KeyOpFieldsValuesTuple& request)
             // it's used when we don't have any attributes, but we have to provide one for redis
             continue;
         }
-        const auto item = request_description_.attr_item_types.find(fvField(*i));
-        if (item == not_found)
+        const size_t slot = schema_.find(fvField(*i));
+        if (slot == RequestSchema::npos)
         {
             if (!relaxed_attr_parsing_)
             {
@@ -167,68 +238,74 @@ void Request::parseAttrs(const KeyOpFieldsValuesTuple& request)
             }
         }
 
-        attr_names_.insert(fvField(*i));
-        switch(item->second)
+        auto& value = attr_values_[slot];
+        switch(schema_.type(slot))
         {
             case REQ_T_STRING:
-                attr_item_strings_[fvField(*i)] = fvValue(*i);
+                value.str = fvValue(*i);
                 break;
             case REQ_T_BOOL:
-                attr_item_bools_[fvField(*i)] = parseBool(fvValue(*i));
+                value.boolean = parseBool(fvValue(*i));
                 break;
             case REQ_T_MAC_ADDRESS:
-                attr_item_mac_addresses_[fvField(*i)] = parseMacAddress(fvValue(*i));
+                value.mac = parseMacAddress(fvValue(*i));
                 break;
             case REQ_T_PACKET_ACTION:
-                attr_item_packet_actions_[fvField(*i)] = parsePacketAction(fvValue(*i));
+                value.packet_action = parsePacketAction(fvValue(*i));
                 break;
             case REQ_T_VLAN:
-                attr_item_vlan_[fvField(*i)] = parseVlan(fvValue(*i));
+                value.vlan = parseVlan(fvValue(*i));
                 break;
             case REQ_T_IP:
-                attr_item_ip_[fvField(*i)] = parseIpAddress(fvValue(*i));
+                value.ip = parseIpAddress(fvValue(*i));
                 break;
             case REQ_T_IP_PREFIX:
-                attr_item_ip_prefix_[fvField(*i)] = parseIpPrefix(fvValue(*i));
+                value.ip_prefix = parseIpPrefix(fvValue(*i));
                 break;
             case REQ_T_UINT:
-                attr_item_uint_[fvField(*i)] = parseUint(fvValue(*i));
+                value.uint = parseUint(fvValue(*i));
                 break;
             case REQ_T_SET:
-                attr_item_set_[fvField(*i)] = parseSet(fvValue(*i));
+                parseSet(fvValue(*i), value.set);
                 break;
             case REQ_T_MAC_ADDRESS_LIST:
-                attr_item_mac_addresses_list_[fvField(*i)] = parseMacAddressList(fvValue(*i));
+                parseMacAddressList(fvValue(*i), value.mac_list);
                 break;
             case REQ_T_IP_LIST:
-                attr_item_ip_list_[fvField(*i)] = parseIpAddressList(fvValue(*i));
+                parseIpAddressList(fvValue(*i), value.ip_list);
                 break;
             case REQ_T_UINT_LIST:
-                attr_item_uint_list_[fvField(*i)] = parseUintList(fvValue(*i));
+                parseUintList(fvValue(*i), value.uint_list);
                 break;
             case REQ_T_BOOL_LIST:
-                attr_item_bool_list_[fvField(*i)] = parseBoolList(fvValue(*i));
+                parseBoolList(fvValue(*i), value.bool_list);
                 break;
             case REQ_T_STRING_LIST:
-                attr_item_string_list_[fvField(*i)] = parseStringList(fvValue(*i));
+                parseStringList(fvValue(*i), value.string_list);
                 break;
             default:
                 throw std::logic_error(std::string("Not implemented attribute type parser for attribute:") + fvField(*i));
         }
+
+        if (value.generation != generation_)
+        {
+            value.generation = generation_;
+            number_of_attrs_++;
+        }
     }
 
-    if (operation_ == DEL_COMMAND && attr_names_.size() > 0)
+    if (operation_ == DEL_COMMAND && number_of_attrs_ > 0)
     {
         throw std::invalid_argument("Delete operation request contains attributes");
     }
 
     if (operation_ == SET_COMMAND)
     {
-        for (const auto& attr: request_description_.mandatory_attr_items)
+        for (const auto& attr: schema_.mandatory())
         {
-            if (attr_names_.find(attr) == std::end(attr_names_))
+            if (attr.second == RequestSchema::npos || attr_values_[attr.second].generation != generation_)
             {
-                throw std::invalid_argument(std::string("Mandatory attribute '") + attr + std::string("' not found"));
+                throw std::invalid_argument(std::string("Mandatory attribute '") + attr.first + std::string("' not found"));
             }
         }
     }
@@ -287,23 +364,12 @@ IpPrefix Request::parseIpPrefix(const std::string& str)
     }
 }
 
-set<string> Request::parseSet(const std::string& str)
+void Request::parseSet(const std::string& str, set<string>& str_set)
 {
-    try
-    {
-        set<string> str_set;
-        string substr;
-        std::istringstream iss(str);
-        while (getline(iss, substr, ','))
-        {
-            str_set.insert(substr);
-        }
-        return str_set;
-    }
-    catch (std::invalid_argument& _)
-    {
-        throw std::invalid_argument(std::string("Invalid string set"));
-    }
+    str_set.clear();
+    forEachListItem(str, list_item_, [&](const string& item) {
+        str_set.insert(item);
+    });
 }
 
 uint64_t Request::parseUint(const std::string& str)
@@ -358,7 +424,7 @@ uint16_t Request::parseVlan(const std::string& str)
 
 sai_packet_action_t Request::parsePacketAction(const std::string& str)
 {
-    std::unordered_map<std::string, sai_packet_action_t> m = {
+    static const std::unordered_map<std::string, sai_packet_action_t> m = {
         {"drop", SAI_PACKET_ACTION_DROP},
         {"forward", SAI_PACKET_ACTION_FORWARD},
         {"copy", SAI_PACKET_ACTION_COPY},
@@ -378,18 +444,14 @@ sai_packet_action_t Request::parsePacketAction(const std::string& str)
     return found->second;
 }
 
-vector<bool> Request::parseBoolList(const std::string& str)
+void Request::parseBoolList(const std::string& str, vector<bool>& res)
 {
     try
     {
-        vector<bool> res;
-        string substr;
-        std::istringstream iss(str);
-        while (getline(iss, substr, ','))
-        {
-            res.emplace_back(parseBool(substr));
-        }
-        return res;
+        res.clear();
+        forEachListItem(str, list_item_, [&](const string& item) {
+            res.emplace_back(parseBool(item));
+        });
     }
     catch (std::invalid_argument& _)
     {
@@ -397,19 +459,14 @@ vector<bool> Request::parseBoolList(const std::string& str)
     }
 }
 
-vector<IpAddress> Request::parseIpAddressList(const std::string& str)
+void Request::parseIpAddressList(const std::string& str, vector<IpAddress>& addrs)
 {
     try
     {
-        vector<IpAddress> addrs;
-        string substr;
-        std::istringstream iss(str);
-        while (getline(iss, substr, ','))
-        {
-            IpAddress addr(substr);
-            addrs.emplace_back(addr);
-        }
-        return addrs;
+        addrs.clear();
+        forEachListItem(str, list_item_, [&](const string& item) {
+            addrs.emplace_back(item);
+        });
     }
     catch (std::invalid_argument& _)
     {
@@ -417,23 +474,19 @@ vector<IpAddress> Request::parseIpAddressList(const std::string& str)
     }
 }
 
-vector<MacAddress> Request::parseMacAddressList(const std::string& str)
+void Request::parseMacAddressList(const std::string& str, vector<MacAddress>& addrs)
 {
     try
     {
-        vector<MacAddress> addrs;
-        string substr;
-        std::istringstream iss(str);
-        while (getline(iss, substr, ','))
-        {
+        addrs.clear();
+        forEachListItem(str, list_item_, [&](const string& item) {
             uint8_t mac[ETHER_ADDR_LEN];
-            if (!MacAddress::parseMacString(substr, mac))
+            if (!MacAddress::parseMacString(item, mac))
             {
                 throw std::invalid_argument(std::string("Invalid mac address: ") + str);
             }
-            addrs.emplace_back(MacAddress(mac));
-        }
-        return addrs;
+            addrs.emplace_back(mac);
+        });
     }
     catch (std::invalid_argument& _)
     {
@@ -441,18 +494,14 @@ vector<MacAddress> Request::parseMacAddressList(const std::string& str)
     }
 }
 
-vector<uint64_t> Request::parseUintList(const std::string& str)
+void Request::parseUintList(const std::string& str, vector<uint64_t>& res)
 {
     try
     {
-        vector<uint64_t> res;
-        string substr;
-        std::istringstream iss(str);
-        while (getline(iss, substr, ','))
-        {
-            res.emplace_back(std::stoul(substr));
-        }
-        return res;
+        res.clear();
+        forEachListItem(str, list_item_, [&](const string& item) {
+            res.emplace_back(std::stoul(item));
+        });
     }
     catch (std::invalid_argument& _)
     {
@@ -464,21 +513,20 @@ vector<uint64_t> Request::parseUintList(const std::string& str)
     }
 }
 
-vector<string> Request::parseStringList(const std::string& str)
+void Request::parseStringList(const std::string& str, vector<string>& res)
 {
-    std::vector<string> res;
-    try
-    {
-        std::string token;
-        std::istringstream iss(str);
-        while (getline(iss, token, ','))
+    // Assign in place so the strings of the previous request keep their buffers
+    size_t count = 0;
+    forEachListItem(str, list_item_, [&](const string& item) {
+        if (count < res.size())
         {
-            res.emplace_back(token);
+            res[count] = item;
         }
-    }
-    catch (std::invalid_argument& _)
-    {
-        throw std::invalid_argument(std::string("Invalid string list: ") + str);
-    }
-    return res;
+        else
+        {
+            res.emplace_back(item);
+        }
+        count++;
+    });
+    res.resize(count);
 }
@@ -3,8 +3,15 @@
 
 #include "ipaddress.h"
 #include "ipprefix.h"
+#include "macaddress.h"
+#include <cstdint>
+#include <iterator>
 #include <sstream>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 typedef enum _request_types_t
@@ -33,6 +40,194 @@ typedef struct _request_description
     std::vector<std::string> mandatory_attr_items;
 } request_description_t;
 
+/*
+ * Schema compiled once from a request_description_t: every attribute gets a
+ * fixed slot index, so a parsed request stores its values in an indexed
+ * array instead of one hash map per value type.
+ */
+class RequestSchema
+{
+public:
+    static constexpr size_t npos = SIZE_MAX;
+
+    explicit RequestSchema(const request_description_t& request_description);
+
+    size_t size() const
+    {
+        return attr_names_.size();
+    }
+
+    // Slot of the attribute, npos for an attribute not in the schema
+    size_t find(const std::string& attr_name) const
+    {
+        const auto it = attr_slots_.find(attr_name);
+        return it == attr_slots_.end() ? npos : it->second;
+    }
+
+    const std::string& name(size_t slot) const
+    {
+        return attr_names_[slot];
+    }
+
+    request_types_t type(size_t slot) const
+    {
+        return attr_types_[slot];
+    }
+
+    // Mandatory attribute names with their slot, npos if not in the schema
+    const std::vector<std::pair<std::string, size_t>>& mandatory() const
+    {
+        return mandatory_slots_;
+    }
+
+private:
+    std::vector<std::string> attr_names_;
+    std::vector<request_types_t> attr_types_;
+    std::unordered_map<std::string, size_t> attr_slots_;
+    std::vector<std::pair<std::string, size_t>> mandatory_slots_;
+};
+
+/*
+ * Storage of a parsed key item or attribute. Only the member matching the
+ * type of the slot is used, it keeps its capacity from one request to the
+ * next so parsing does not allocate once the slot has been warmed up.
+ */
+struct RequestValue
+{
+    // The value belongs to the current request when equal to its generation
+    uint64_t generation = 0;
+
+    std::string str;
+    bool boolean = false;
+    swss::MacAddress mac;
+    sai_packet_action_t packet_action = SAI_PACKET_ACTION_DROP;
+    uint16_t vlan = 0;
+    swss::IpAddress ip;
+    swss::IpPrefix ip_prefix;
+    uint64_t uint = 0;
+    std::set<std::string> set;
+    std::vector<swss::IpAddress> ip_list;
+    std::vector<swss::MacAddress> mac_list;
+    std::vector<uint64_t> uint_list;
+    std::vector<bool> bool_list;
+    std::vector<std::string> string_list;
+};
+
+/*
+ * Names of the attributes of a parsed request. A view on the request slots,
+ * valid until the next parse() or clear(). Offers the lookup and iteration
+ * interface of the std::unordered_set it replaces.
+ */
+class RequestAttrNames
+{
+public:
+    typedef std::string value_type;
+    typedef size_t size_type;
+
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::string value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string* pointer;
+        typedef const std::string& reference;
+
+        const_iterator(const RequestAttrNames* names, size_t slot) : names_(names), slot_(slot)
+        {
+            skip();
+        }
+
+        reference operator*() const { return names_->schema_->name(slot_); }
+        pointer operator->() const { return &**this; }
+
+        const_iterator& operator++()
+        {
+            slot_++;
+            skip();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const const_iterator& other) const { return slot_ == other.slot_; }
+        bool operator!=(const const_iterator& other) const { return slot_ != other.slot_; }
+
+    private:
+        void skip()
+        {
+            while (slot_ < names_->schema_->size() && !names_->isPresent(slot_))
+            {
+                slot_++;
+            }
+        }
+
+        const RequestAttrNames* names_;
+        size_t slot_;
+    };
+
+    typedef const_iterator iterator;
+
+    RequestAttrNames(const RequestSchema* schema, const std::vector<RequestValue>* values, uint64_t generation, size_t count)
+        : schema_(schema), values_(values), generation_(generation), count_(count)
+    {
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, schema_->size()); }
+
+    size_type size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    const_iterator find(const std::string& attr_name) const
+    {
+        size_t slot = schema_->find(attr_name);
+        return slot != RequestSchema::npos && isPresent(slot) ? const_iterator(this, slot) : end();
+    }
+
+    size_type count(const std::string& attr_name) const
+    {
+        return find(attr_name) == end() ? 0 : 1;
+    }
+
+    bool operator==(const std::unordered_set<std::string>& other) const
+    {
+        if (other.size() != count_)
+        {
+            return false;
+        }
+        for (const auto& name: other)
+        {
+            if (count(name) == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const std::unordered_set<std::string>& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    bool isPresent(size_t slot) const
+    {
+        return (*values_)[slot].generation == generation_;
+    }
+
+    const RequestSchema* schema_;
+    const std::vector<RequestValue>* values_;
+    uint64_t generation_;
+    size_t count_;
+};
+
 class Request
 {
 public:
@@ -54,91 +249,91 @@ public:
     const std::string& getKeyString(int position) const
     {
         assert(is_parsed_);
-        return key_item_strings_.at(position);
+        return getKey(position, REQ_T_STRING).str;
     }
 
     const swss::MacAddress& getKeyMacAddress(int position) const
     {
         assert(is_parsed_);
-        return key_item_mac_addresses_.at(position);
+        return getKey(position, REQ_T_MAC_ADDRESS).mac;
     }
 
     const swss::IpAddress& getKeyIpAddress(int position) const
     {
         assert(is_parsed_);
-        return key_item_ip_addresses_.at(position);
+        return getKey(position, REQ_T_IP).ip;
     }
 
     const swss::IpPrefix& getKeyIpPrefix(int position) const
     {
         assert(is_parsed_);
-        return key_item_ip_prefix_.at(position);
+        return getKey(position, REQ_T_IP_PREFIX).ip_prefix;
     }
 
     const uint64_t& getKeyUint(int position) const
     {
         assert(is_parsed_);
-        return key_item_uint_.at(position);
+        return getKey(position, REQ_T_UINT).uint;
     }
 
-    const std::unordered_set<std::string>& getAttrFieldNames() const
+    RequestAttrNames getAttrFieldNames() const
     {
         assert(is_parsed_);
-        return attr_names_;
+        return RequestAttrNames(&schema_, &attr_values_, generation_, number_of_attrs_);
     }
 
     const std::string& getAttrString(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_strings_.at(attr_name);
+        return getAttr(attr_name, REQ_T_STRING).str;
     }
 
     bool getAttrBool(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_bools_.at(attr_name);
+        return getAttr(attr_name, REQ_T_BOOL).boolean;
     }
 
     const swss::MacAddress& getAttrMacAddress(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_mac_addresses_.at(attr_name);
+        return getAttr(attr_name, REQ_T_MAC_ADDRESS).mac;
     }
 
     sai_packet_action_t getAttrPacketAction(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_packet_actions_.at(attr_name);
+        return getAttr(attr_name, REQ_T_PACKET_ACTION).packet_action;
     }
 
     uint16_t getAttrVlan(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_vlan_.at(attr_name);
+        return getAttr(attr_name, REQ_T_VLAN).vlan;
     }
 
     swss::IpAddress getAttrIP(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_ip_.at(attr_name);
+        return getAttr(attr_name, REQ_T_IP).ip;
     }
 
     swss::IpPrefix getAttrIpPrefix(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_ip_prefix_.at(attr_name);
+        return getAttr(attr_name, REQ_T_IP_PREFIX).ip_prefix;
     }
 
     const uint64_t& getAttrUint(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_uint_.at(attr_name);
+        return getAttr(attr_name, REQ_T_UINT).uint;
     }
 
     const std::set<std::string>& getAttrSet(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_set_.at(attr_name);
+        return getAttr(attr_name, REQ_T_SET).set;
     }
 
     void setTableName(std::string& table_name)
@@ -155,40 +350,43 @@ public:
     const std::vector<swss::IpAddress>& getAttrIPList(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_ip_list_.at(attr_name);
+        return getAttr(attr_name, REQ_T_IP_LIST).ip_list;
     }
 
     const std::vector<swss::MacAddress>& getAttrMacAddressList(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_mac_addresses_list_.at(attr_name);
+        return getAttr(attr_name, REQ_T_MAC_ADDRESS_LIST).mac_list;
     }
 
     const std::vector<uint64_t>& getAttrUintList(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_uint_list_.at(attr_name);
+        return getAttr(attr_name, REQ_T_UINT_LIST).uint_list;
     }
 
-    const std::vector<bool> getAttrBoolList(const std::string& attr_name) const
+    const std::vector<bool>& getAttrBoolList(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_bool_list_.at(attr_name);
+        return getAttr(attr_name, REQ_T_BOOL_LIST).bool_list;
     }
 
     const std::vector<std::string>& getAttrStringList(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_string_list_.at(attr_name);
+        return getAttr(attr_name, REQ_T_STRING_LIST).string_list;
     }
 
 protected:
     Request(const request_description_t& request_description, const char key_separator, bool relaxed_attr_parsing = false)
         : request_description_(request_description),
+          schema_(request_description),
           key_separator_(key_separator),
           is_parsed_(false),
+          number_of_key_items_(request_description.key_item_types.size()),
           relaxed_attr_parsing_(relaxed_attr_parsing),
-          number_of_key_items_(request_description.key_item_types.size())
+          key_values_(number_of_key_items_),
+          attr_values_(schema_.size())
     {
     }
 
@@ -203,16 +401,21 @@ private:
     swss::IpPrefix parseIpPrefix(const std::string& str);
     uint64_t parseUint(const std::string& str);
     uint16_t parseVlan(const std::string& str);
-    std::set<std::string> parseSet(const std::string& str);
-    std::vector<swss::IpAddress> parseIpAddressList(const std::string& str);
-    std::vector<swss::MacAddress> parseMacAddressList(const std::string& str);
-    std::vector<uint64_t> parseUintList(const std::string& str);
-    std::vector<bool> parseBoolList(const std::string& str);
-    std::vector<std::string> parseStringList(const std::string& str);
+    void parseSet(const std::string& str, std::set<std::string>& str_set);
+    void parseIpAddressList(const std::string& str, std::vector<swss::IpAddress>& addrs);
+    void parseMacAddressList(const std::string& str, std::vector<swss::MacAddress>& addrs);
+    void parseUintList(const std::string& str, std::vector<uint64_t>& res);
+    void parseBoolList(const std::string& str, std::vector<bool>& res);
+    void parseStringList(const std::string& str, std::vector<std::string>& res);
 
     sai_packet_action_t parsePacketAction(const std::string& str);
 
+    // Value of a key item or attribute of the current request, std::out_of_range if absent
+    const RequestValue& getKey(int position, request_types_t type) const;
+    const RequestValue& getAttr(const std::string& attr_name, request_types_t type) const;
+
     const request_description_t& request_description_;
+    const RequestSchema schema_;
     char key_separator_;
     bool is_parsed_;
     size_t number_of_key_items_;
@@ -222,27 +425,16 @@ private:
     std::string table_name_;
     std::string operation_;
     std::string full_key_;
-    std::unordered_map<int, std::string> key_item_strings_;
-    std::unordered_map<int, swss::MacAddress> key_item_mac_addresses_;
-    std::unordered_map<int, swss::IpAddress> key_item_ip_addresses_;
-    std::unordered_map<int, swss::IpPrefix> key_item_ip_prefix_;
-    std::unordered_map<int, uint64_t> key_item_uint_;
-    std::unordered_set<std::string> attr_names_;
-    // FIXME: Make one union with all the values, except string
-    std::unordered_map<std::string, std::string> attr_item_strings_;
-    std::unordered_map<std::string, bool> attr_item_bools_;
-    std::unordered_map<std::string, std::vector<bool>> attr_item_bool_list_;
-    std::unordered_map<std::string, swss::MacAddress> attr_item_mac_addresses_;
-    std::unordered_map<std::string, sai_packet_action_t> attr_item_packet_actions_;
-    std::unordered_map<std::string, uint16_t> attr_item_vlan_;
-    std::unordered_map<std::string, swss::IpAddress> attr_item_ip_;
-    std::unordered_map<std::string, swss::IpPrefix> attr_item_ip_prefix_;
-    std::unordered_map<std::string, uint64_t> attr_item_uint_;
-    std::unordered_map<std::string, std::set<std::string>> attr_item_set_;
-    std::unordered_map<std::string, std::vector<swss::IpAddress>> attr_item_ip_list_;
-    std::unordered_map<std::string, std::vector<swss::MacAddress>> attr_item_mac_addresses_list_;
-    std::unordered_map<std::string, std::vector<uint64_t>> attr_item_uint_list_;
-    std::unordered_map<std::string, std::vector<std::string>> attr_item_string_list_;
+
+    // Bumped by every parse, invalidates the values of the previous request at once
+    uint64_t generation_ = 0;
+    size_t number_of_attrs_ = 0;
+    std::vector<RequestValue> key_values_;
+    std::vector<RequestValue> attr_values_;
+
+    // Scratch buffers reused by the key and list parsers
+    std::vector<std::string> key_items_;
+    std::string list_item_;
 };
 
 #endif // __REQUEST_PARSER_H
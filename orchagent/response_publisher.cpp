@@ -1,10 +1,14 @@
 #include "response_publisher.h"
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "json.h"
+#include "orchprobes.h"
+
 namespace
 {
 
@@ -64,6 +68,9 @@ void RecordResponse(const std::string &response_channel, const std::string &key,
 
 } // namespace
 
+constexpr const char *ResponsePublisher::BULK_RESPONSE_OP;
+constexpr size_t ResponsePublisher::DB_UPDATE_RING_SIZE;
+
 ResponsePublisher::ResponsePublisher(const std::string& dbName, bool buffered,
                                      bool db_write_thread,
                                      swss::ZmqServer* zmqServer)
@@ -75,6 +82,7 @@ ResponsePublisher::ResponsePublisher(const std::string& dbName, bool buffered,
 {
     if (db_write_thread)
     {
+        m_ring.resize(DB_UPDATE_RING_SIZE);
         m_update_thread = std::unique_ptr<std::thread>(new std::thread(&ResponsePublisher::dbUpdateThread, this));
     }
 }
@@ -85,8 +93,8 @@ ResponsePublisher::~ResponsePublisher()
     {
         {
             std::lock_guard<std::mutex> lock(m_lock);
-            m_queue.emplace(/*table=*/"", /*key=*/"", /*values =*/std::vector<swss::FieldValueTuple>{}, /*op=*/"",
-                            /*replace=*/false, /*flush=*/false, /*shutdown=*/true);
+            enqueue(entry(/*table=*/"", /*key=*/"", /*values =*/std::vector<swss::FieldValueTuple>{}, /*op=*/"",
+                          /*replace=*/false, /*buffered=*/false, /*flush=*/false, /*shutdown=*/true));
         }
         m_signal.notify_one();
         m_update_thread->join();
@@ -122,6 +130,7 @@ void ResponsePublisher::publish(const std::string &table, const std::string &key
     }
 
     RecordResponse(response_channel, key, intent_attrs_copy, status.codeStr());
+    ORCH_PROBE3(respub__publish, table.c_str(), key.c_str(), static_cast<int>(status.code()));
 
     // Write to the DB only if: m_enable_db_write_and_notify is true and:
     // 1) A write operation is being performed and state attributes are specified.
@@ -149,6 +158,64 @@ void ResponsePublisher::publish(const std::string &table, const std::string &key
     publish(table, key, intent_attrs, status, state_attrs, replace);
 }
 
+void ResponsePublisher::publishBulk(const std::string &table, const std::vector<Response> &bulk, bool replace)
+{
+    if (bulk.empty())
+    {
+        return;
+    }
+
+    std::string response_channel = "APPL_DB_" + table + "_RESPONSE_CHANNEL";
+    std::vector<swss::FieldValueTuple> notification;
+    std::vector<entry> writes;
+
+    for (const auto &response : bulk)
+    {
+        const auto &status = response.status;
+        auto intent_attrs_copy = response.intent_attrs;
+        swss::FieldValueTuple err_str("err_str", PrependedComponent(status) + status.message());
+        intent_attrs_copy.insert(intent_attrs_copy.begin(), err_str);
+
+        if (m_enable_db_write_and_notify)
+        {
+            if (m_zmqServer != nullptr)
+            {
+                auto intent_attrs_zmq_copy = response.intent_attrs;
+                intent_attrs_zmq_copy.insert(intent_attrs_zmq_copy.begin(),
+                                             swss::FieldValueTuple(status.codeStr(), err_str.second));
+                responses[table].push_back(
+                    swss::KeyOpFieldsValuesTuple{response.key, SET_COMMAND, intent_attrs_zmq_copy});
+            }
+            else
+            {
+                auto values = intent_attrs_copy;
+                values.insert(values.begin(), swss::FieldValueTuple("status", status.codeStr()));
+                notification.emplace_back(response.key, swss::JSon::buildJson(values));
+            }
+        }
+
+        RecordResponse(response_channel, response.key, intent_attrs_copy, status.codeStr());
+        ORCH_PROBE3(respub__publish, table.c_str(), response.key.c_str(), static_cast<int>(status.code()));
+
+        // Only successful responses write APPL_STATE_DB, see publish()
+        if (m_enable_db_write_and_notify && status.ok())
+        {
+            writes.emplace_back(table, response.key, response.intent_attrs,
+                                response.intent_attrs.size() ? SET_COMMAND : DEL_COMMAND, replace,
+                                /*buffered=*/true, /*flush=*/false, /*shutdown=*/false);
+        }
+    }
+
+    writeToDBBulk(writes);
+
+    if (!notification.empty())
+    {
+        swss::NotificationProducer notificationProducer{
+            m_ntf_pipe.get(), response_channel, m_buffered};
+        notificationProducer.send(BULK_RESPONSE_OP, std::to_string(notification.size()), notification);
+    }
+}
+
 void ResponsePublisher::writeToDB(const std::string &table, const std::string &key,
                                   const std::vector<swss::FieldValueTuple> &values, const std::string &op, bool replace)
 {
@@ -156,22 +223,81 @@ void ResponsePublisher::writeToDB(const std::string &table, const std::string &k
     {
         {
             std::lock_guard<std::mutex> lock(m_lock);
-            m_queue.emplace(table, key, values, op, replace, /*flush=*/false, /*shutdown=*/false);
+            enqueue(entry(table, key, values, op, replace, m_buffered, /*flush=*/false, /*shutdown=*/false));
         }
         m_signal.notify_one();
     }
     else
     {
-        writeToDBInternal(table, key, values, op, replace);
+        writeToDBInternal(table, key, values, op, replace, m_buffered);
     }
     RecordDBWrite(table, key, values, op);
 }
 
+void ResponsePublisher::writeToDBBulk(std::vector<entry> &writes)
+{
+    if (writes.empty())
+    {
+        return;
+    }
+
+    for (const auto &e : writes)
+    {
+        RecordDBWrite(e.table, e.key, e.values, e.op);
+    }
+
+    if (m_update_thread != nullptr)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            for (auto &e : writes)
+            {
+                enqueue(std::move(e));
+            }
+            if (!m_buffered)
+            {
+                enqueue(entry(/*table=*/"", /*key=*/"", /*values =*/std::vector<swss::FieldValueTuple>{}, /*op=*/"",
+                              /*replace=*/false, /*buffered=*/false, /*flush=*/true, /*shutdown=*/false));
+            }
+        }
+        m_signal.notify_one();
+    }
+    else
+    {
+        for (const auto &e : writes)
+        {
+            writeToDBInternal(e.table, e.key, e.values, e.op, e.replace, e.buffered);
+        }
+        if (!m_buffered)
+        {
+            m_db_pipe->flush();
+        }
+    }
+}
+
+void ResponsePublisher::enqueue(entry &&e)
+{
+    if (m_ring_count == m_ring.size())
+    {
+        // Full, unroll the pending writes into a twice larger ring
+        std::vector<entry> ring(std::max(m_ring.size() * 2, DB_UPDATE_RING_SIZE));
+        for (size_t i = 0; i < m_ring_count; i++)
+        {
+            ring[i] = std::move(m_ring[(m_ring_head + i) % m_ring.size()]);
+        }
+        m_ring.swap(ring);
+        m_ring_head = 0;
+    }
+
+    m_ring[(m_ring_head + m_ring_count) % m_ring.size()] = std::move(e);
+    m_ring_count++;
+}
+
 void ResponsePublisher::writeToDBInternal(const std::string &table, const std::string &key,
                                           const std::vector<swss::FieldValueTuple> &values, const std::string &op,
-                                          bool replace)
+                                          bool replace, bool buffered)
 {
-    swss::Table applStateTable{m_db_pipe.get(), table, m_buffered};
+    swss::Table applStateTable{m_db_pipe.get(), table, buffered};
 
     auto attrs = values;
     if (op == SET_COMMAND)
@@ -233,8 +359,8 @@ void ResponsePublisher::flush() {
   {
       {
           std::lock_guard<std::mutex> lock(m_lock);
-          m_queue.emplace(/*table=*/"", /*key=*/"", /*values =*/std::vector<swss::FieldValueTuple>{}, /*op=*/"",
-                          /*replace=*/false, /*flush=*/true, /*shutdown=*/false);
+          enqueue(entry(/*table=*/"", /*key=*/"", /*values =*/std::vector<swss::FieldValueTuple>{}, /*op=*/"",
+                        /*replace=*/false, /*buffered=*/false, /*flush=*/true, /*shutdown=*/false));
       }
       m_signal.notify_one();
   }
@@ -251,30 +377,40 @@ void ResponsePublisher::setBuffered(bool buffered)
 
 void ResponsePublisher::dbUpdateThread()
 {
+    std::vector<entry> batch;
     while (true)
     {
-        entry e;
         {
             std::unique_lock<std::mutex> lock(m_lock);
-            while (m_queue.empty())
+            while (m_ring_count == 0)
             {
                 m_signal.wait(lock);
             }
 
-            e = m_queue.front();
-            m_queue.pop();
-        }
-        if (e.shutdown)
-        {
-            break;
-        }
-        if (e.flush)
-        {
-            m_db_pipe->flush();
+            // Take everything pending at once, the lock is released while writing
+            batch.clear();
+            for (size_t i = 0; i < m_ring_count; i++)
+            {
+                batch.push_back(std::move(m_ring[(m_ring_head + i) % m_ring.size()]));
+            }
+            m_ring_head = (m_ring_head + m_ring_count) % m_ring.size();
+            m_ring_count = 0;
         }
-        else
+
+        for (const auto &e : batch)
         {
-            writeToDBInternal(e.table, e.key, e.values, e.op, e.replace);
+            if (e.shutdown)
+            {
+                return;
+            }
+            if (e.flush)
+            {
+                m_db_pipe->flush();
+            }
+            else
+            {
+                writeToDBInternal(e.table, e.key, e.values, e.op, e.replace, e.buffered);
+            }
         }
     }
 }
@@ -1,10 +1,8 @@
 #pragma once
 
 #include <condition_variable>
-#include <list>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -54,6 +52,26 @@ class ResponsePublisher : public ResponsePublisherInterface
 
     void setEnableDbWriteAndNotify(bool enable_db_write_and_notify) override;
 
+    // Operation of the notification aggregating the responses of a bulk.
+    static constexpr const char *BULK_RESPONSE_OP = "bulk";
+
+    struct Response
+    {
+        std::string key;
+        std::vector<swss::FieldValueTuple> intent_attrs;
+        ReturnCode status;
+    };
+
+    /**
+     * @brief Publish the responses of a bulk operation on table
+     *
+     * Same as publish() without state attributes for each response, except
+     * that the notifications go out as a single BULK_RESPONSE_OP message. Its
+     * fields are the response keys, each value is the JSON encoded
+     * "status" code followed by the values of the single notification.
+     */
+    void publishBulk(const std::string &table, const std::vector<Response> &bulk, bool replace = false);
+
     /**
      * @brief Flush pending responses
      */
@@ -79,6 +97,7 @@ class ResponsePublisher : public ResponsePublisherInterface
         std::vector<swss::FieldValueTuple> values;
         std::string op;
         bool replace;
+        bool buffered;
         bool flush;
         bool shutdown;
 
@@ -87,15 +106,24 @@ class ResponsePublisher : public ResponsePublisherInterface
         }
 
         entry(const std::string &table, const std::string &key, const std::vector<swss::FieldValueTuple> &values,
-              const std::string &op, bool replace, bool flush, bool shutdown)
-            : table(table), key(key), values(values), op(op), replace(replace), flush(flush), shutdown(shutdown)
+              const std::string &op, bool replace, bool buffered, bool flush, bool shutdown)
+            : table(table), key(key), values(values), op(op), replace(replace), buffered(buffered), flush(flush),
+              shutdown(shutdown)
         {
         }
     };
 
+    // Initial number of slots of the DB write ring, it doubles when full.
+    static constexpr size_t DB_UPDATE_RING_SIZE = 1024;
+
     void dbUpdateThread();
     void writeToDBInternal(const std::string &table, const std::string &key,
-                           const std::vector<swss::FieldValueTuple> &values, const std::string &op, bool replace);
+                           const std::vector<swss::FieldValueTuple> &values, const std::string &op, bool replace,
+                           bool buffered);
+    // Writes the states of a bulk through the DB pipeline, flushed once at the end.
+    void writeToDBBulk(std::vector<entry> &writes);
+    // Appends to the DB write ring, m_lock must be held.
+    void enqueue(entry &&e);
 
     std::unique_ptr<swss::DBConnector> m_db;
     std::unique_ptr<swss::RedisPipeline> m_ntf_pipe;
@@ -108,7 +136,10 @@ class ResponsePublisher : public ResponsePublisherInterface
                   // used when ZMQ is enabled.
     // Thread to write to DB.
     std::unique_ptr<std::thread> m_update_thread;
-    std::queue<entry, std::list<entry>> m_queue;
+    // Pending DB writes, a ring of preallocated slots reused by the thread.
+    std::vector<entry> m_ring;
+    size_t m_ring_head{0};
+    size_t m_ring_count{0};
     mutable std::mutex m_lock;
     std::condition_variable m_signal;
     bool m_enable_db_write_and_notify{true};
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <list>
 #include <unordered_set>
 #include <unordered_map>
 #include "recorder.h"
+#include "orchprobes.h"
 #include "rediscommand.h"
+#include "executorstats.h"
 
 using namespace swss;
 
@@ -12,7 +18,10 @@ enum ConstraintType
     RETRY_CST_DUMMY,
     RETRY_CST_PIC,              // context doesn't exist
     RETRY_CST_PIC_REF,          // context refcnt nonzero
-    RETRY_CST_SAI_RESOURCE      // SAI resource exhaustion (INSUFFICIENT_RESOURCES, TABLE_FULL, etc.)
+    RETRY_CST_SAI_RESOURCE,     // SAI resource exhaustion (INSUFFICIENT_RESOURCES, TABLE_FULL, etc.)
+    RETRY_CST_NEIGH,            // next hop of an unresolved neighbor doesn't exist
+    RETRY_CST_NHG,              // no next hop group left to sync
+    RETRY_CST_VRF_REF           // VRF refcnt nonzero
 };
 
 static inline std::ostream& operator<<(std::ostream& os, ConstraintType t) {
@@ -21,6 +30,9 @@ static inline std::ostream& operator<<(std::ostream& os, ConstraintType t) {
         case ConstraintType::RETRY_CST_PIC:          return os << "RETRY_CST_PIC";
         case ConstraintType::RETRY_CST_PIC_REF:      return os << "RETRY_CST_PIC_REF";
         case ConstraintType::RETRY_CST_SAI_RESOURCE: return os << "RETRY_CST_SAI_RESOURCE";
+        case ConstraintType::RETRY_CST_NEIGH:        return os << "RETRY_CST_NEIGH";
+        case ConstraintType::RETRY_CST_NHG:          return os << "RETRY_CST_NHG";
+        case ConstraintType::RETRY_CST_VRF_REF:      return os << "RETRY_CST_VRF_REF";
         default:           return os << "UNKNOWN";
     }
 }
@@ -53,17 +65,97 @@ namespace std {
     };
 }
 
-using RetryKeysMap = std::unordered_map<Constraint, std::unordered_set<std::string>>;
+/*
+ * Keys of the tasks waiting on one constraint, in the order they failed so
+ * that they are woken up first in first out. Remembers when each key was
+ * parked to measure the time spent in retry.
+ */
+class RetryKeyQueue
+{
+public:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+    typedef std::list<std::string>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+
+    const_iterator begin() const { return m_order.begin(); }
+    const_iterator end() const { return m_order.end(); }
+    size_t size() const { return m_order.size(); }
+    bool empty() const { return m_order.empty(); }
+
+    size_t count(const std::string &key) const
+    {
+        return m_index.count(key);
+    }
+
+    const_iterator find(const std::string &key) const
+    {
+        auto it = m_index.find(key);
+        return it == m_index.end() ? end() : const_iterator(it->second.pos);
+    }
+
+    /* Append the key if not already queued, a queued key keeps its place */
+    bool insert(const std::string &key)
+    {
+        if (m_index.find(key) != m_index.end())
+        {
+            return false;
+        }
+
+        auto pos = m_order.insert(m_order.end(), key);
+        m_index.emplace(key, Entry{pos, std::chrono::steady_clock::now()});
+        return true;
+    }
+
+    size_t erase(const std::string &key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            return 0;
+        }
+
+        m_order.erase(it->second.pos);
+        m_index.erase(it);
+        return 1;
+    }
+
+    const_iterator erase(const_iterator pos)
+    {
+        m_index.erase(*pos);
+        return m_order.erase(pos);
+    }
+
+    TimePoint since(const std::string &key) const
+    {
+        auto it = m_index.find(key);
+        return it == m_index.end() ? TimePoint() : it->second.since;
+    }
+
+private:
+    struct Entry
+    {
+        std::list<std::string>::iterator pos;
+        TimePoint since;
+    };
+
+    std::list<std::string> m_order;
+    std::unordered_map<std::string, Entry> m_index;
+};
+
+using RetryKeysMap = std::unordered_map<Constraint, RetryKeyQueue>;
 
 class RetryCache
 {
 public:
     std::string m_executorName; // name of the corresponding executor
     std::unordered_set<Constraint> m_resolvedConstraints; // store the resolved constraints notified
+    std::deque<Constraint> m_resolvedOrder; // resolved constraints, in the order they are served
     RetryKeysMap m_retryKeys; // group failed tasks by constraints
     RetryMap m_toRetry; // cache the data about the failed tasks for a ConsumerBase instance
 
-    RetryCache(std::string executorName) : m_executorName (executorName) {}
+    RetryCache(std::string executorName) :
+        m_executorName (executorName),
+        m_stats(ExecutorStatsRegistry::instance().attach(executorName)) {}
 
     std::unordered_set<Constraint>& getResolvedConstraints()
     {
@@ -82,13 +174,15 @@ public:
      */
     void mark_resolved(const Constraint &cst)
     {
-        if (m_retryKeys.find(cst) == m_retryKeys.end())
+        auto keys = m_retryKeys.find(cst);
+        if (keys == m_retryKeys.end())
             return;
 
-        m_resolvedConstraints.emplace(cst.first, cst.second);
+        if (m_resolvedConstraints.emplace(cst.first, cst.second).second)
+            m_resolvedOrder.push_back(cst);
 
         std::stringstream ss;
-        ss << cst << " resolution notified -> " << m_retryKeys[cst].size() << " task(s)";
+        ss << cst << " resolution notified -> " << keys->second.size() << " task(s)";
         Recorder::Instance().retry.record(ss.str());
     }
 
@@ -101,12 +195,19 @@ public:
         const auto& key = kfvKey(task);
         if (key.empty())
             return;
+        ORCH_PROBE2(retry__add, m_executorName.c_str(), key.c_str());
         m_retryKeys[cst].insert(key);
         m_toRetry.emplace(
             std::piecewise_construct,
             std::forward_as_tuple(key),
             std::forward_as_tuple(cst, task)
         );
+
+        if (m_stats)
+        {
+            m_stats->totalRetryCached.fetch_add(1, std::memory_order_relaxed);
+            m_stats->retryPending.store(m_toRetry.size(), std::memory_order_relaxed);
+        }
     }
 
     /** Delete a SET task from the retry cache by its key.
@@ -137,17 +238,26 @@ public:
 
         // Erase the task from m_toRetry, and unbind cst with it.
         m_toRetry.erase(it);
-        m_retryKeys[cst].erase(key);
 
-        if (m_retryKeys[cst].empty()) {
-            m_retryKeys.erase(cst);
-            m_resolvedConstraints.erase(cst);
+        auto keys = m_retryKeys.find(cst);
+        if (keys != m_retryKeys.end())
+        {
+            keys->second.erase(key);
+            if (keys->second.empty())
+                forget(keys);
+        }
+
+        if (m_stats)
+        {
+            m_stats->totalRetryEvicted.fetch_add(1, std::memory_order_relaxed);
+            m_stats->retryPending.store(m_toRetry.size(), std::memory_order_relaxed);
         }
 
         return task;
     }
 
     /** Find cached failed tasks that can be resolved by the constraint, remove them from the retry cache.
+     * Tasks are returned in the order they failed.
      * @param cst the retry constraint
      * @return the resolved failed tasks
      */
@@ -155,8 +265,74 @@ public:
 
         auto tasks = std::make_shared<std::deque<KeyOpFieldsValuesTuple>>();
 
-        // get a set of keys that correspond to tasks constrained by the cst
-        std::unordered_set<std::string>& keys = m_retryKeys[cst];
+        resolveInto(cst, threshold, *tasks);
+
+        return tasks;
+    }
+
+    /** Wake up the tasks of all resolved constraints, up to the quota.
+     * Constraints are served round robin in the order they were resolved, each
+     * getting an even share of the remaining quota per pass, so that a constraint
+     * with a large backlog cannot starve the others.
+     * @param quota maximum number of tasks to return
+     * @return the resolved failed tasks
+     */
+    std::shared_ptr<std::deque<KeyOpFieldsValuesTuple>> resolveResolved(size_t quota = 30000)
+    {
+        auto tasks = std::make_shared<std::deque<KeyOpFieldsValuesTuple>>();
+
+        while (!m_resolvedOrder.empty() && tasks->size() < quota)
+        {
+            size_t round = m_resolvedOrder.size();
+            size_t share = std::max<size_t>(1, (quota - tasks->size()) / round);
+
+            for (size_t i = 0; i < round && tasks->size() < quota; i++)
+            {
+                Constraint cst = m_resolvedOrder.front();
+                m_resolvedOrder.pop_front();
+
+                // The constraint goes back at the end of the queue while it has tasks left
+                if (!resolveInto(cst, std::min(share, quota - tasks->size()), *tasks))
+                    m_resolvedOrder.push_back(cst);
+            }
+        }
+
+        return tasks;
+    }
+
+private:
+    std::shared_ptr<ExecutorStats> m_stats;
+
+    /* Drop a constraint without tasks left */
+    void forget(RetryKeysMap::iterator keys)
+    {
+        if (m_resolvedConstraints.erase(keys->first))
+        {
+            auto pos = std::find(m_resolvedOrder.begin(), m_resolvedOrder.end(), keys->first);
+            if (pos != m_resolvedOrder.end())
+                m_resolvedOrder.erase(pos);
+        }
+        m_retryKeys.erase(keys);
+    }
+
+    /* Move up to threshold tasks of the constraint to tasks, return true when none is left */
+    bool resolveInto(const Constraint &cst, size_t threshold, std::deque<KeyOpFieldsValuesTuple> &tasks)
+    {
+        auto keysIt = m_retryKeys.find(cst);
+        if (keysIt == m_retryKeys.end())
+        {
+            if (m_resolvedConstraints.erase(cst))
+            {
+                auto pos = std::find(m_resolvedOrder.begin(), m_resolvedOrder.end(), cst);
+                if (pos != m_resolvedOrder.end())
+                    m_resolvedOrder.erase(pos);
+            }
+            return true;
+        }
+
+        // a set of keys that correspond to tasks constrained by the cst, oldest first
+        RetryKeyQueue& keys = keysIt->second;
+        auto now = std::chrono::steady_clock::now();
 
         size_t count = 0;
         auto it = keys.begin();
@@ -168,32 +344,45 @@ public:
             auto failed_task_it = range.first;
             while (failed_task_it != range.second)
             {
-                auto failed_task = failed_task_it->second;
-                if (failed_task.first == cst)
+                if (failed_task_it->second.first == cst)
                 {
-                    tasks->push_back(std::move(failed_task.second));
+                    tasks.push_back(std::move(failed_task_it->second.second));
                     failed_task_it = m_toRetry.erase(failed_task_it);
                     count++;
                 } else {
                     ++failed_task_it;
                 }
             }
+
+            if (m_stats)
+            {
+                m_stats->retryWaitUsec.record(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - keys.since(*it)).count()));
+            }
             it = keys.erase(it);
         }
 
         std::stringstream ss;
-        ss << cst << " | " << m_executorName << " | " << tasks->size() << " retried";
+        ss << cst << " | " << m_executorName << " | " << count << " retried";
+
+        ORCH_PROBE3(retry__resolve, m_executorName.c_str(), count, keys.size());
 
-        if (keys.empty()) {
-            m_retryKeys.erase(cst);
-            m_resolvedConstraints.erase(cst);
+        bool done = keys.empty();
+        if (done) {
+            forget(keysIt);
         } else {
             ss << " (rest:" << keys.size() << ")";
         }
 
         Recorder::Instance().retry.record(ss.str());
 
-        return tasks;
+        if (m_stats)
+        {
+            m_stats->totalRetryWoken.fetch_add(count, std::memory_order_relaxed);
+            m_stats->retryPending.store(m_toRetry.size(), std::memory_order_relaxed);
+        }
+
+        return done;
     }
 };
 
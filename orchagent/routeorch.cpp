@@ -4,6 +4,8 @@
 #include <inttypes.h>
 #include <algorithm>
 #include "routeorch.h"
+#include "saiattrlist.h"
+#include "routebinary.h"
 #include "nhgorch.h"
 #include "tunneldecaporch.h"
 #include "cbf/cbfnhgorch.h"
@@ -37,6 +39,11 @@ extern string gMySwitchType;
 #define DEFAULT_NUMBER_OF_ECMP_GROUPS   128
 #define DEFAULT_MAX_ECMP_GROUP_SIZE     32
 
+/* Route tasks parsed per parse thread hand off */
+#define ROUTE_PARSE_CHUNK               256
+
+size_t RouteOrch::m_parseThreads = 0;
+
 RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames, SwitchOrch *switchOrch, NeighOrch *neighOrch, IntfsOrch *intfsOrch, VRFOrch *vrfOrch, FgNhgOrch *fgNhgOrch, Srv6Orch *srv6Orch, swss::ZmqServer *zmqServer) :
         gRouteBulker(sai_route_api, gMaxBulkSize),
         gLabelRouteBulker(sai_mpls_api, gMaxBulkSize),
@@ -57,6 +64,9 @@ RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
     m_publisher.setBuffered(true);
     m_publisher.m_directDbWrite = true;
 
+    /* Route processing is independent of the prefix order, use the hashed task store */
+    setTaskStoreMode(APP_ROUTE_TABLE_NAME, SyncMap::Mode::Hashed);
+
     sai_attribute_t attr;
     attr.id = SAI_SWITCH_ATTR_NUMBER_OF_ECMP_GROUPS;
 
@@ -316,8 +326,8 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr, sai_object_
      * IP address */
     if (observerEntry == m_nextHopObservers.end())
     {
-        m_nextHopObservers.emplace(host, NextHopObserverEntry());
-        observerEntry = m_nextHopObservers.find(host);
+        observerEntry = m_nextHopObservers.emplace(host, NextHopObserverEntry()).first;
+        m_observedHosts[vrf_id].insert(dstAddr, host);
 
         /* Find the prefixes that cover the destination IP */
         if (m_syncdRoutes.find(vrf_id) != m_syncdRoutes.end())
@@ -379,6 +389,15 @@ void RouteOrch::detach(Observer *observer, const IpAddress& dstAddr, sai_object_
             // destination IP.
             if (observerEntry->second.observers.empty())
             {
+                auto trie = m_observedHosts.find(vrf_id);
+                if (trie != m_observedHosts.end())
+                {
+                    trie->second.erase(dstAddr);
+                    if (trie->second.empty())
+                    {
+                        m_observedHosts.erase(trie);
+                    }
+                }
                 m_nextHopObservers.erase(observerEntry);
             }
             break;
@@ -417,7 +436,7 @@ bool RouteOrch::addDefaultRouteNexthopsInNextHopGroup(NextHopGroupEntry& origina
 
     for (auto it : default_route_next_hop_set)
     {
-        vector<sai_attribute_t> nhgm_attrs;
+        SaiAttrList<> nhgm_attrs;
         sai_attribute_t nhgm_attr;
         nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
         nhgm_attr.value.oid = original_next_hop_group.next_hop_group_id;
@@ -455,27 +474,32 @@ bool RouteOrch::validnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t&
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
+    bool success = true;
     count = 0;
 
-    for (auto nhopgroup = m_syncdNextHopGroups.begin();
-         nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
+    auto it_index = m_nextHopGroupMembers.find(nexthop);
+    vector<NextHopGroupTable::value_type *> nhgs;
+    if (it_index != m_nextHopGroupMembers.end())
     {
-
-        if (!(nhopgroup->first.contains(nexthop)))
+        for (auto nhopgroup : it_index->second)
         {
-            continue;
+            // Route NHOP Group is swapped by default route nh memeber . do not add Nexthop again.
+            // Wait for Nexthop Group Cleanup
+            if (!nhopgroup->second.is_default_route_nh_swap)
+            {
+                nhgs.push_back(nhopgroup);
+            }
         }
+    }
 
-       // Route NHOP Group is swapped by default route nh memeber . do not add Nexthop again.
-       // Wait for Nexthop Group Cleanup
-        if (nhopgroup->second.is_default_route_nh_swap)
-        {
-           continue;
-        }
-        
-        vector<sai_attribute_t> nhgm_attrs;
+    /* Re-add the member to every group in one bulk call */
+    vector<sai_object_id_t> nhgm_ids(nhgs.size());
+    vector<sai_status_t> statuses(nhgs.size());
+    sai_object_id_t next_hop_id = m_neighOrch->getNextHopId(nexthop);
+    for (size_t i = 0; i < nhgs.size(); i++)
+    {
+        auto nhopgroup = nhgs[i];
+        SaiAttrList<> nhgm_attrs;
         sai_attribute_t nhgm_attr;
 
         /* get updated nhkey with possible weight */
@@ -486,7 +510,7 @@ bool RouteOrch::validnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t&
         nhgm_attrs.push_back(nhgm_attr);
 
         nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = m_neighOrch->getNextHopId(nexthop);
+        nhgm_attr.value.oid = next_hop_id;
         nhgm_attrs.push_back(nhgm_attr);
 
         if (nhkey->weight)
@@ -503,24 +527,30 @@ bool RouteOrch::validnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t&
             nhgm_attrs.push_back(nhgm_attr);
         }
 
-        status = sai_next_hop_group_api->create_next_hop_group_member(&nexthop_id, gSwitchId,
-                                                                      (uint32_t)nhgm_attrs.size(),
-                                                                      nhgm_attrs.data());
+        gNextHopGroupMemberBulker.create_entry(&nhgm_ids[i], &statuses[i],
+                                               (uint32_t)nhgm_attrs.size(),
+                                               nhgm_attrs.data());
+    }
+    gNextHopGroupMemberBulker.flush();
 
-        if (status != SAI_STATUS_SUCCESS)
+    for (size_t i = 0; i < nhgs.size(); i++)
+    {
+        auto nhopgroup = nhgs[i];
+        if (statuses[i] != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to add next hop member to group %" PRIx64 ": %d\n",
-                           nhopgroup->second.next_hop_group_id, status);
-            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, status);
+                           nhopgroup->second.next_hop_group_id, statuses[i]);
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, statuses[i]);
             if (handle_status != task_success)
             {
-                return parseHandleSaiStatusFailure(handle_status);
+                success = parseHandleSaiStatusFailure(handle_status) && success;
+                continue;
             }
         }
 
         ++count;
         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
-        nhopgroup->second.nhopgroup_members[nexthop].next_hop_id = nexthop_id;
+        nhopgroup->second.nhopgroup_members[nexthop].next_hop_id = nhgm_ids[i];
         /* Keep the count of number of nexthop members are present in Nexthop Group
          * when the links became active again*/
         nhopgroup->second.nh_member_install_count++;
@@ -531,45 +561,53 @@ bool RouteOrch::validnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t&
         return false;
     }
 
-    return true;
+    return success;
 }
 
 bool RouteOrch::invalidnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t& count)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
+    bool success = true;
     count = 0;
 
-    for (auto nhopgroup = m_syncdNextHopGroups.begin();
-         nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
+    auto it_index = m_nextHopGroupMembers.find(nexthop);
+    vector<NextHopGroupTable::value_type *> nhgs;
+    if (it_index != m_nextHopGroupMembers.end())
     {
-
-        if (!(nhopgroup->first.contains(nexthop)))
+        for (auto nhopgroup : it_index->second)
         {
-            continue;
-        }
-
-        // Route NHOP Group is already swapped by default route nh memeber . do not delete actual nexthop again.
-   
-        if (nhopgroup->second.is_default_route_nh_swap)
-        {
-           continue;
+            // Route NHOP Group is already swapped by default route nh memeber . do not delete actual nexthop again.
+            if (!nhopgroup->second.is_default_route_nh_swap)
+            {
+                nhgs.push_back(nhopgroup);
+            }
         }
- 
+    }
 
-        nexthop_id = nhopgroup->second.nhopgroup_members[nexthop].next_hop_id;
-        status = sai_next_hop_group_api->remove_next_hop_group_member(nexthop_id);
+    /* Pull the member out of every group in one bulk call, the cost follows
+     * the number of groups and not the number of routes using them */
+    vector<sai_object_id_t> nhgm_ids(nhgs.size());
+    vector<sai_status_t> statuses(nhgs.size());
+    for (size_t i = 0; i < nhgs.size(); i++)
+    {
+        nhgm_ids[i] = nhgs[i]->second.nhopgroup_members[nexthop].next_hop_id;
+        gNextHopGroupMemberBulker.remove_entry(&statuses[i], nhgm_ids[i]);
+    }
+    gNextHopGroupMemberBulker.flush();
 
-        if (status != SAI_STATUS_SUCCESS)
+    for (size_t i = 0; i < nhgs.size(); i++)
+    {
+        auto nhopgroup = nhgs[i];
+        if (statuses[i] != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to remove next hop member %" PRIx64 " from group %" PRIx64 ": %d\n",
-                           nexthop_id, nhopgroup->second.next_hop_group_id, status);
-            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, status);
+                           nhgm_ids[i], nhopgroup->second.next_hop_group_id, statuses[i]);
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, statuses[i]);
             if (handle_status != task_success)
             {
-                return parseHandleSaiStatusFailure(handle_status);
+                success = parseHandleSaiStatusFailure(handle_status) && success;
+                continue;
             }
         }
         // Reduce the member install count when links down
@@ -599,9 +637,449 @@ bool RouteOrch::invalidnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t
         return false;
     }
 
+    return success;
+}
+
+void RouteOrch::parseRouteRequest(const KeyOpFieldsValuesTuple &t, RouteRequest &req)
+{
+    const string& key = kfvKey(t);
+
+    if (!key.compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
+    {
+        size_t found = key.find(':');
+        req.vrf_name = key.substr(0, found);
+        req.prefix = key.substr(found+1);
+    }
+    else
+    {
+        req.prefix = key;
+    }
+
+    try
+    {
+        req.ip_prefix = IpPrefix(req.prefix);
+        req.prefix_valid = true;
+    }
+    catch (const std::exception&)
+    {
+        /* Left to doTask(), which reports it in order */
+        req.prefix_valid = false;
+    }
+
+    if (kfvOp(t) != SET_COMMAND)
+    {
+        return;
+    }
+
+    const auto& fvs = kfvFieldsValues(t);
+    if (fvs.size() == 1 && fvField(fvs[0]) == ROUTE_BINARY_FIELD)
+    {
+        /* Left to doTask(), which reports it in order */
+        req.malformed = !parseRouteBinaryRequest(fvValue(fvs[0]), req);
+        return;
+    }
+
+    for (const auto& i : fvs)
+    {
+        if (fvField(i) == "nexthop" && fvValue(i) != "")
+            req.ips = fvValue(i);
+
+        if (fvField(i) == "ifname" && fvValue(i) != "")
+            req.aliases = fvValue(i);
+
+        if (fvField(i) == "mpls_nh" && fvValue(i) != "")
+            req.mpls_nhs = fvValue(i);
+
+        if (fvField(i) == "vni_label" && fvValue(i) != "") {
+            req.vni_labels = fvValue(i);
+            req.overlay_nh = true;
+        }
+
+        if (fvField(i) == "router_mac" && fvValue(i) != "")
+            req.remote_macs = fvValue(i);
+
+        if (fvField(i) == "blackhole")
+            req.blackhole = fvValue(i) == "true";
+
+        if (fvField(i) == "weight" && fvValue(i) != "")
+            req.weights = fvValue(i);
+
+        if (fvField(i) == "nexthop_group" && fvValue(i) != "")
+            req.nhg_index = fvValue(i);
+
+        if (fvField(i) == "segment" && fvValue(i) != "") {
+            req.srv6_segments = fvValue(i);
+            req.srv6_seg = true;
+            req.srv6_nh = true;
+        }
+
+        if (fvField(i) == "seg_src" && fvValue(i) != "") {
+            req.srv6_source = fvValue(i);
+            req.srv6_nh = true;
+        }
+
+        if (fvField(i) == "protocol" && fvValue(i) != "")
+            req.protocol = fvValue(i);
+
+        if (fvField(i) == "fallback_to_default_route")
+            req.fallback_to_default_route = fvValue(i) == "true";
+
+        if (fvField(i) == "vpn_sid" && fvValue(i) != "") {
+            req.srv6_vpn_sids = fvValue(i);
+            req.srv6_nh = true;
+            req.srv6_vpn = true;
+        }
+
+        if (fvField(i) == "pic_context_id" && fvValue(i) != "")
+        {
+            req.context_index = fvValue(i);
+            req.srv6_vpn = true;
+        }
+    }
+
+    /* Routes referencing a nexthop_group get their key from the NhgOrch */
+    if (req.nhg_index.empty())
+    {
+        req.ipv = tokenize(req.ips, ',');
+        req.alsv = tokenize(req.aliases, ',');
+        req.mpls_nhv = tokenize(req.mpls_nhs, ',');
+        req.vni_labelv = tokenize(req.vni_labels, ',');
+        req.rmacv = tokenize(req.remote_macs, ',');
+        req.srv6_segv = tokenize(req.srv6_segments, ',');
+        req.srv6_src = tokenize(req.srv6_source, ',');
+        req.srv6_vpn_sidv = tokenize(req.srv6_vpn_sids, ',');
+    }
+}
+
+bool RouteOrch::parseRouteBinaryRequest(const string &bin, RouteRequest &req)
+{
+    vector<string> *list = nullptr;
+    string *joined = nullptr;
+    string *value = nullptr;
+
+    /* Lists are given item by item, the joined string is kept for the logs and key checks */
+    auto begin = [&](RouteBinaryTag tag, size_t count)
+    {
+        list = nullptr;
+        joined = nullptr;
+        value = nullptr;
+
+        switch (tag)
+        {
+            case ROUTE_BIN_PROTOCOL:        value = &req.protocol; break;
+            case ROUTE_BIN_BLACKHOLE:       req.blackhole = true; break;
+            case ROUTE_BIN_NEXTHOP_GROUP:   value = &req.nhg_index; break;
+            case ROUTE_BIN_NEXTHOP:         list = &req.ipv; joined = &req.ips; break;
+            case ROUTE_BIN_IFNAME:          list = &req.alsv; joined = &req.aliases; break;
+            case ROUTE_BIN_MPLS_NH:         list = &req.mpls_nhv; joined = &req.mpls_nhs; break;
+            case ROUTE_BIN_WEIGHT:          value = &req.weights; break;
+            case ROUTE_BIN_VNI_LABEL:
+                list = &req.vni_labelv;
+                joined = &req.vni_labels;
+                req.overlay_nh = true;
+                break;
+            case ROUTE_BIN_ROUTER_MAC:      list = &req.rmacv; joined = &req.remote_macs; break;
+            case ROUTE_BIN_SEGMENT:
+                list = &req.srv6_segv;
+                joined = &req.srv6_segments;
+                req.srv6_seg = true;
+                req.srv6_nh = true;
+                break;
+            case ROUTE_BIN_SEG_SRC:
+                list = &req.srv6_src;
+                joined = &req.srv6_source;
+                req.srv6_nh = true;
+                break;
+            case ROUTE_BIN_VPN_SID:
+                list = &req.srv6_vpn_sidv;
+                joined = &req.srv6_vpn_sids;
+                req.srv6_nh = true;
+                req.srv6_vpn = true;
+                break;
+            case ROUTE_BIN_PIC_CONTEXT_ID:
+                value = &req.context_index;
+                req.srv6_vpn = true;
+                break;
+            case ROUTE_BIN_FALLBACK:        req.fallback_to_default_route = true; break;
+            default:
+                SWSS_LOG_INFO("Ignoring unknown route attribute %u", static_cast<unsigned>(tag));
+                break;
+        }
+
+        if (list)
+        {
+            list->reserve(count);
+        }
+    };
+
+    auto item = [&](RouteBinaryTag, const char *data, size_t len)
+    {
+        if (list)
+        {
+            if (!list->empty())
+            {
+                joined->push_back(',');
+            }
+            joined->append(data, len);
+            list->emplace_back(data, len);
+        }
+        else if (value)
+        {
+            value->assign(data, len);
+        }
+    };
+
+    if (!parseRouteBinary(bin, begin, item))
+    {
+        return false;
+    }
+
+    /* Routes referencing a nexthop_group get their key from the NhgOrch */
+    if (!req.nhg_index.empty())
+    {
+        req.ipv.clear();
+        req.alsv.clear();
+        req.mpls_nhv.clear();
+        req.vni_labelv.clear();
+        req.rmacv.clear();
+        req.srv6_segv.clear();
+        req.srv6_src.clear();
+        req.srv6_vpn_sidv.clear();
+    }
+
+    return true;
+}
+
+void RouteOrch::preParseRoutes(SyncMap &toSync, SyncMap::iterator it)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_parsePool)
+    {
+        m_parsePool.reset(new OrchWorkerPool(m_parseThreads));
+    }
+
+    vector<const KeyOpFieldsValuesTuple *> tasks;
+    size_t window = m_parsePool->size() * ROUTE_PARSE_CHUNK;
+    for (; it != toSync.end() && tasks.size() < window; it++)
+    {
+        tasks.push_back(&it->second);
+    }
+
+    vector<RouteRequest> requests(tasks.size());
+    auto parse = [&tasks, &requests](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            parseRouteRequest(*tasks[i], requests[i]);
+        }
+    };
+
+    if (tasks.size() <= ROUTE_PARSE_CHUNK)
+    {
+        /* Not worth a hand off */
+        parse(0, tasks.size());
+    }
+    else
+    {
+        for (size_t begin = 0; begin < tasks.size(); begin += ROUTE_PARSE_CHUNK)
+        {
+            size_t end = min(begin + ROUTE_PARSE_CHUNK, tasks.size());
+            m_parsePool->submit([&parse, begin, end]() { parse(begin, end); });
+        }
+        m_parsePool->wait();
+    }
+
+    for (size_t i = 0; i < tasks.size(); i++)
+    {
+        m_parsedRoutes[tasks[i]] = std::move(requests[i]);
+    }
+
+    SWSS_LOG_INFO("Parsed %zu route tasks ahead", tasks.size());
+}
+
+bool RouteOrch::takeParsedRoute(SyncMap &toSync, SyncMap::iterator it, RouteRequest &req)
+{
+    if (m_parseThreads == 0)
+    {
+        return false;
+    }
+
+    auto found = m_parsedRoutes.find(&it->second);
+    if (found == m_parsedRoutes.end())
+    {
+        preParseRoutes(toSync, it);
+        found = m_parsedRoutes.find(&it->second);
+    }
+
+    req = std::move(found->second);
+    m_parsedRoutes.erase(found);
+    return true;
+}
+
+RouteDigest::Bucket RouteDigest::getBucket(const string &key)
+{
+    Bucket bucket;
+    size_t prefix = 0;
+
+    if (!key.compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
+    {
+        size_t found = key.find(':');
+        if (found != string::npos)
+        {
+            bucket.first = key.substr(0, found);
+            prefix = found + 1;
+        }
+    }
+
+    bucket.second = static_cast<uint32_t>(TableDigest::hash(key.substr(prefix)) % ROUTE_DIGEST_BUCKETS);
+    return bucket;
+}
+
+void RouteDigest::set(const string &key, uint64_t digest)
+{
+    auto rc = m_entries.emplace(key, digest);
+    auto &bucket = m_buckets[getBucket(key)];
+    if (!rc.second)
+    {
+        bucket.remove(rc.first->second);
+        rc.first->second = digest;
+    }
+    bucket.add(digest);
+}
+
+void RouteDigest::del(const string &key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        return;
+    }
+
+    auto bucket = m_buckets.find(getBucket(key));
+    bucket->second.remove(it->second);
+    if (bucket->second.count() == 0)
+    {
+        m_buckets.erase(bucket);
+    }
+    m_entries.erase(it);
+}
+
+bool RouteDigest::get(const string &key, uint64_t &digest) const
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        return false;
+    }
+
+    digest = it->second;
     return true;
 }
 
+void RouteOrch::reconcileRoutes(ConsumerBase& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    /* APPL_DB may lag behind the routes received over ZMQ */
+    if (dynamic_cast<ZmqConsumerStateTable *>(consumer.getSelectable()))
+    {
+        SWSS_LOG_NOTICE("Routes are written to APPL_DB asynchronously, skip the reconciliation");
+        return;
+    }
+
+    RouteDigest::Buckets tableBuckets;
+    bool scanned = consumer.scanTable([&tableBuckets](const KeyOpFieldsValuesTuple &entry)
+    {
+        if (kfvKey(entry) != "resync")
+        {
+            tableBuckets[RouteDigest::getBucket(kfvKey(entry))].add(entry);
+        }
+    });
+    if (!scanned)
+    {
+        SWSS_LOG_WARN("Routes are not read from a DB, skip the reconciliation");
+        return;
+    }
+
+    const auto &applied = m_routeDigest.getBuckets();
+    set<RouteDigest::Bucket> differ;
+    for (const auto &bucket : tableBuckets)
+    {
+        auto found = applied.find(bucket.first);
+        if (found == applied.end() || found->second != bucket.second)
+        {
+            differ.insert(bucket.first);
+        }
+    }
+    for (const auto &bucket : applied)
+    {
+        if (tableBuckets.find(bucket.first) == tableBuckets.end())
+        {
+            differ.insert(bucket.first);
+        }
+    }
+
+    /* APPL_DB and the routes done with match in the other buckets, the
+     * routes held there during the window have nothing left to do */
+    size_t dropped = 0;
+    for (auto it = consumer.m_toSync.begin(); it != consumer.m_toSync.end();)
+    {
+        const string &key = kfvKey(it->second);
+        if (key != "resync" && differ.find(RouteDigest::getBucket(key)) == differ.end())
+        {
+            it = consumer.m_toSync.erase(it);
+            dropped++;
+        }
+        else
+        {
+            it++;
+        }
+    }
+
+    if (differ.empty())
+    {
+        SWSS_LOG_NOTICE("Routes match APPL_DB in %zu buckets, dropped %zu held routes",
+                        tableBuckets.size(), dropped);
+        return;
+    }
+
+    /* Only the routes of the buckets that differ are read and compared */
+    deque<KeyOpFieldsValuesTuple> entries;
+    unordered_set<string> seen;
+    consumer.scanTable([this, &differ, &entries, &seen](const KeyOpFieldsValuesTuple &entry)
+    {
+        const string &key = kfvKey(entry);
+        if (key == "resync" || differ.find(RouteDigest::getBucket(key)) == differ.end())
+        {
+            return;
+        }
+
+        seen.insert(key);
+        uint64_t digest;
+        if (m_routeDigest.get(key, digest) && digest == TableDigest::digest(entry))
+        {
+            return;
+        }
+        entries.push_back(entry);
+    });
+
+    size_t updated = entries.size();
+    for (const auto &entry : m_routeDigest.getEntries())
+    {
+        if (differ.find(RouteDigest::getBucket(entry.first)) != differ.end() &&
+            seen.find(entry.first) == seen.end())
+        {
+            entries.push_back(KeyOpFieldsValuesTuple(entry.first, DEL_COMMAND, vector<FieldValueTuple>()));
+        }
+    }
+
+    SWSS_LOG_NOTICE("Routes differ from APPL_DB in %zu of %zu buckets, dropped %zu held routes, "
+                    "resync %zu routes and remove %zu",
+                    differ.size(), tableBuckets.size(), dropped, updated, entries.size() - updated);
+
+    consumer.addToSync(entries);
+}
+
 void RouteOrch::doTask(ConsumerBase& consumer)
 {
     SWSS_LOG_ENTER();
@@ -620,8 +1098,10 @@ void RouteOrch::doTask(ConsumerBase& consumer)
     }
 
     /* Default handling is for APP_ROUTE_TABLE_NAME */
+    m_parsedRoutes.clear();
     auto it = consumer.m_toSync.begin();
-    while (it != consumer.m_toSync.end())
+    bool yielded = false;
+    while (!yielded && it != consumer.m_toSync.end())
     {
         // Route bulk results will be stored in a map
         std::map<
@@ -631,11 +1111,22 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                 >,
                 RouteBulkContext
         >                                       toBulk;
+        bool reconcile = false;
+
+        m_bulkRouteStates = true;
 
         // Add or remove routes with a route bulker
         while (it != consumer.m_toSync.end())
         {
-            KeyOpFieldsValuesTuple t = it->second;
+            /* Once the time slice is used up, complete the current batch and leave
+             * the remaining routes in m_toSync for the next scheduling round */
+            if (!toBulk.empty() && consumer.sliceExpired())
+            {
+                yielded = true;
+                break;
+            }
+
+            const KeyOpFieldsValuesTuple &t = it->second;
 
             string key = kfvKey(t);
             string op = kfvOp(t);
@@ -650,157 +1141,97 @@ void RouteOrch::doTask(ConsumerBase& consumer)
             {
                 ctx.clear();
             }
+            if (op == SET_COMMAND)
+            {
+                ctx.digest = TableDigest::digest(t);
+            }
 
             /* Get notification from application */
             /* resync application:
-             * When routeorch receives 'resync' message, it marks all current
-             * routes as dirty and waits for 'resync complete' message. For all
-             * newly received routes, if they match current dirty routes, it unmarks
-             * them dirty. After receiving 'resync complete' message, it creates all
-             * newly added routes and removes all dirty routes.
+             * When routeorch receives 'resync' message, it holds the routes
+             * until the 'resync complete' message. It then compares the
+             * digests of APPL_DB with those of the routes it is done with,
+             * bucket by bucket, and only drives the routes of the buckets
+             * that differ. The batch is completed first, as the
+             * reconciliation changes m_toSync.
              */
             if (key == "resync")
             {
+                toBulk.erase(rc.first);
+                it = consumer.m_toSync.erase(it);
+
                 if (op == "SET")
                 {
-                    /* Mark all current routes as dirty (DEL) in consumer.m_toSync map */
                     SWSS_LOG_NOTICE("Start resync routes\n");
-                    for (auto j : m_syncdRoutes)
-                    {
-                        string vrf;
-
-                        if (j.first != gVirtualRouterId)
-                        {
-                            vrf = m_vrfOrch->getVRFname(j.first) + ":";
-                        }
-
-                        for (auto i : j.second)
-                        {
-                            vector<FieldValueTuple> v;
-                            key = vrf + i.first.to_string();
-                            auto x = KeyOpFieldsValuesTuple(key, DEL_COMMAND, v);
-                            consumer.addToSync(x);
-                        }
-                    }
                     m_resync = true;
-                }
-                else
-                {
-                    SWSS_LOG_NOTICE("Complete resync routes\n");
-                    m_resync = false;
+                    continue;
                 }
 
-                it = consumer.m_toSync.erase(it);
-                continue;
+                SWSS_LOG_NOTICE("Complete resync routes\n");
+                m_resync = false;
+                reconcile = true;
+                break;
             }
 
             if (m_resync)
             {
+                toBulk.erase(rc.first);
                 it++;
                 continue;
             }
 
+            RouteRequest req;
+            if (!takeParsedRoute(consumer.m_toSync, it, req))
+            {
+                parseRouteRequest(t, req);
+            }
+
+            if (req.malformed)
+            {
+                SWSS_LOG_ERROR("Skip route %s, it has a malformed %s field", kfvKey(t).c_str(), ROUTE_BINARY_FIELD);
+                it = consumer.m_toSync.erase(it);
+                continue;
+            }
+
             sai_object_id_t& vrf_id = ctx.vrf_id;
             IpPrefix& ip_prefix = ctx.ip_prefix;
 
-            if (!key.compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
+            if (!req.vrf_name.empty())
             {
-                size_t found = key.find(':');
-                string vrf_name = key.substr(0, found);
-
-                if (!m_vrfOrch->isVRFexists(vrf_name))
+                if (!m_vrfOrch->isVRFexists(req.vrf_name))
                 {
                     it++;
                     continue;
                 }
-                vrf_id = m_vrfOrch->getVRFid(vrf_name);
-                ip_prefix = IpPrefix(key.substr(found+1));
+                vrf_id = m_vrfOrch->getVRFid(req.vrf_name);
             }
             else
             {
                 vrf_id = gVirtualRouterId;
-                ip_prefix = IpPrefix(key);
             }
+            /* Throws on an invalid prefix, as parsing it here would */
+            ip_prefix = req.prefix_valid ? req.ip_prefix : IpPrefix(req.prefix);
 
             if (op == SET_COMMAND)
             {
-                string ips;
-                string aliases;
-                string mpls_nhs;
-                string vni_labels;
-                string remote_macs;
-                string weights;
-                string nhg_index;
-                string context_index;
+                const string& ips = req.ips;
+                const string& aliases = req.aliases;
+                const string& remote_macs = req.remote_macs;
+                const string& vni_labels = req.vni_labels;
+                const string& weights = req.weights;
+                const string& nhg_index = req.nhg_index;
+                const string& context_index = req.context_index;
                 bool& excp_intfs_flag = ctx.excp_intfs_flag;
-                bool overlay_nh = false;
-                bool blackhole = false;
-                string srv6_segments;
-                string srv6_source;
-                string srv6_vpn_sids;
-                bool srv6_seg = false;
-                bool srv6_vpn = false;
-                bool srv6_nh = false;
-                bool fallback_to_default_route = false;
-
-                for (auto i : kfvFieldsValues(t))
+                bool overlay_nh = req.overlay_nh;
+                bool blackhole = req.blackhole;
+                bool srv6_seg = req.srv6_seg;
+                bool srv6_vpn = req.srv6_vpn;
+                bool srv6_nh = req.srv6_nh;
+                bool fallback_to_default_route = req.fallback_to_default_route;
+
+                if (!req.protocol.empty())
                 {
-                    if (fvField(i) == "nexthop" && fvValue(i) != "")
-                        ips = fvValue(i);
-
-                    if (fvField(i) == "ifname" && fvValue(i) != "")
-                        aliases = fvValue(i);
-
-                    if (fvField(i) == "mpls_nh" && fvValue(i) != "")
-                        mpls_nhs = fvValue(i);
-
-                    if (fvField(i) == "vni_label" && fvValue(i) != "") {
-                        vni_labels = fvValue(i);
-                        overlay_nh = true;
-                    }
-
-                    if (fvField(i) == "router_mac" && fvValue(i) != "")
-                        remote_macs = fvValue(i);
-
-                    if (fvField(i) == "blackhole")
-                        blackhole = fvValue(i) == "true";
-
-                    if (fvField(i) == "weight" && fvValue(i) != "")
-                        weights = fvValue(i);
-
-                    if (fvField(i) == "nexthop_group" && fvValue(i) != "")
-                        nhg_index = fvValue(i);
-
-                    if (fvField(i) == "segment" && fvValue(i) != "") {
-                        srv6_segments = fvValue(i);
-                        srv6_seg = true;
-                        srv6_nh = true;
-                    }
-
-                    if (fvField(i) == "seg_src" && fvValue(i) != "") {
-                        srv6_source = fvValue(i);
-                        srv6_nh = true;
-                    }
-
-                    if (fvField(i) == "protocol" && fvValue(i) != "")
-                    {
-                        ctx.protocol = fvValue(i);
-                    }
-
-                    if (fvField(i) == "fallback_to_default_route")
-                        fallback_to_default_route = fvValue(i) == "true";
-
-                    if (fvField(i) == "vpn_sid" && fvValue(i) != "") {
-                        srv6_vpn_sids = fvValue(i);
-                        srv6_nh = true;
-                        srv6_vpn = true;
-                    }
-
-                    if (fvField(i) == "pic_context_id" && fvValue(i) != "")
-                    {
-                        context_index = fvValue(i);
-                        srv6_vpn = true;
-                    }
+                    ctx.protocol = req.protocol;
                 }
 
                 /*
@@ -823,30 +1254,21 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                  * based on the IPs and aliases.  Otherwise, get the key from
                  * the NhgOrch.
                  */
-                vector<string> ipv;
-                vector<string> alsv;
-                vector<string> mpls_nhv;
-                vector<string> vni_labelv;
-                vector<string> rmacv;
-                NextHopGroupKey& nhg = ctx.nhg;
-                vector<string> srv6_segv;
-                vector<string> srv6_src;
-                vector<string> srv6_vpn_sidv;
+                vector<string>& ipv = req.ipv;
+                vector<string>& alsv = req.alsv;
+                vector<string>& mpls_nhv = req.mpls_nhv;
+                vector<string>& vni_labelv = req.vni_labelv;
+                vector<string>& rmacv = req.rmacv;
+                NextHopGroupKeyRef& nhg = ctx.nhg;
+                vector<string>& srv6_segv = req.srv6_segv;
+                vector<string>& srv6_src = req.srv6_src;
+                vector<string>& srv6_vpn_sidv = req.srv6_vpn_sidv;
                 bool l3Vni = true;
                 uint32_t vni = 0;
 
                 /* Check if the next hop group is owned by the NhgOrch. */
                 if (nhg_index.empty())
                 {
-                    ipv = tokenize(ips, ',');
-                    alsv = tokenize(aliases, ',');
-                    mpls_nhv = tokenize(mpls_nhs, ',');
-                    vni_labelv = tokenize(vni_labels, ',');
-                    rmacv = tokenize(remote_macs, ',');
-                    srv6_segv = tokenize(srv6_segments, ',');
-                    srv6_src = tokenize(srv6_source, ',');
-                    srv6_vpn_sidv = tokenize(srv6_vpn_sids, ',');
-
                     /*
                     * For backward compatibility, adjust ip string from old format to
                     * new format. Meanwhile it can deal with some abnormal cases.
@@ -928,7 +1350,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
 
                     if (blackhole)
                     {
-                        nhg = NextHopGroupKey();
+                        nhg = NextHopGroupKeyRef();
                     }
                     else if (srv6_nh == true)
                     {
@@ -955,8 +1377,8 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                             nhg_str += (srv6_vpn ? srv6_vpn_sidv[i] : "") + NH_DELIMITER; // srv6 vpn sid
                         }
 
-                        nhg = NextHopGroupKey(nhg_str, overlay_nh, srv6_nh);
-                        SWSS_LOG_INFO("SRV6 route with nhg %s", nhg.to_string().c_str());
+                        nhg = NextHopGroupKeyRef::parse(nhg_str, overlay_nh, srv6_nh);
+                        SWSS_LOG_INFO("SRV6 route with nhg %s", nhg->to_string().c_str());
                     }
                     else if (overlay_nh == false)
                     {
@@ -974,7 +1396,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                             nhg_str += ipv[i] + NH_DELIMITER + alsv[i];
                         }
 
-                        nhg = NextHopGroupKey(nhg_str, weights);
+                        nhg = NextHopGroupKeyRef::parse(nhg_str, weights);
                     }
                     else
                     {
@@ -996,7 +1418,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                             nhg_str += ipv[i] + NH_DELIMITER + "vni" + alsv[i] + NH_DELIMITER + vni_labelv[i] + NH_DELIMITER + rmacv[i];
                         }
 
-                        nhg = NextHopGroupKey(nhg_str, overlay_nh, srv6_nh);
+                        nhg = NextHopGroupKeyRef::parse(nhg_str, overlay_nh, srv6_nh);
                     }
                 }
                 else
@@ -1020,7 +1442,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                 route_entry.switch_id = gSwitchId;
                 copy(route_entry.destination, ip_prefix);
 
-                if (nhg.getSize() == 1 && nhg.hasIntfNextHop())
+                if (nhg->getSize() == 1 && nhg->hasIntfNextHop())
                 {
                     if (alsv[0] == "unknown")
                     {
@@ -1125,7 +1547,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
 
         while (it_prev != it)
         {
-            KeyOpFieldsValuesTuple t = it_prev->second;
+            const KeyOpFieldsValuesTuple &t = it_prev->second;
 
             string key = kfvKey(t);
             string op = kfvOp(t);
@@ -1224,10 +1646,17 @@ void RouteOrch::doTask(ConsumerBase& consumer)
             }
         }
 
+        /* Bind the flow counters of the routes added by this batch in one bulk */
+        gFlowCounterRouteOrch->processRouteFlowCounterBinding();
+
         /* Flush response publisher so route notifications reach fpmsyncd every batch.
          * Without this, notifications stay buffered in the Redis pipeline until the
          * next OrchDaemon periodic flush (up to 1s), delaying the offload reply to
-         * zebra and causing BGP advertisement delay when supress fib pending is ON */
+         * zebra and causing BGP advertisement delay when supress fib pending is ON.
+         * The states of the whole batch go out as one notification */
+        m_bulkRouteStates = false;
+        m_publisher.publishBulk(APP_ROUTE_TABLE_NAME, m_routeStates);
+        m_routeStates.clear();
         m_publisher.flush();
 
         /* Remove next hop group if the reference count decreases to zero */
@@ -1249,6 +1678,46 @@ void RouteOrch::doTask(ConsumerBase& consumer)
         {
             m_srv6Orch->removeSrv6Nexthops(m_bulkSrv6NhgReducedVec);
         }
+
+        /* Digest the tasks of the batch that are done with, neither left in
+         * m_toSync nor moved to the retry cache */
+        for (const auto& bulk : toBulk)
+        {
+            const string& key = bulk.first.first;
+            const string& op = bulk.first.second;
+            if (bulk.second.retry_cst != DUMMY_CONSTRAINT)
+            {
+                continue;
+            }
+
+            bool pending = false;
+            auto range = consumer.m_toSync.equal_range(key);
+            for (auto task = range.first; task != range.second; task++)
+            {
+                pending = pending || kfvOp(task->second) == op;
+            }
+            if (pending)
+            {
+                continue;
+            }
+
+            if (op == SET_COMMAND)
+            {
+                m_routeDigest.set(key, bulk.second.digest);
+            }
+            else if (op == DEL_COMMAND)
+            {
+                m_routeDigest.del(key);
+            }
+        }
+
+        if (reconcile)
+        {
+            reconcileRoutes(consumer);
+            /* The reconciled tasks may reuse the storage of parsed tasks */
+            m_parsedRoutes.clear();
+            it = consumer.m_toSync.begin();
+        }
         /* No Update to Default Route so we can return */
         if (!(v4_default_nhg_key.getSize()) && !(v6_default_nhg_key.getSize()))
         {
@@ -1271,12 +1740,27 @@ void RouteOrch::notifyNextHopChangeObservers(sai_object_id_t vrf_id, const IpPre
 {
     SWSS_LOG_ENTER();
 
-    for (auto& entry : m_nextHopObservers)
+    auto trie = m_observedHosts.find(vrf_id);
+    if (trie == m_observedHosts.end())
+    {
+        return;
+    }
+
+    /* Only the observed hosts the prefix covers, collected first as observers
+     * may attach or detach while being updated */
+    vector<Host> hosts;
+    trie->second.forEachCovered(prefix, [&hosts](const IpAddress &, const Host &host) {
+        hosts.push_back(host);
+    });
+
+    for (const auto& host : hosts)
     {
-        if (vrf_id != entry.first.first || !prefix.isAddressInSubnet(entry.first.second))
+        auto observed = m_nextHopObservers.find(host);
+        if (observed == m_nextHopObservers.end())
         {
             continue;
         }
+        auto& entry = *observed;
 
         if (add)
         {
@@ -1465,7 +1949,7 @@ bool RouteOrch::removeFineGrainedNextHopGroup(sai_object_id_t &next_hop_group_id
     }
 
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
-    m_nextHopGroupCount--;
+    decreaseNextHopGroupCount();
     return true;
 }
 
@@ -1551,7 +2035,7 @@ bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops)
         return false;
     }
     sai_attribute_t nhg_attr;
-    vector<sai_attribute_t> nhg_attrs;
+    SaiAttrList<> nhg_attrs;
 
     nhg_attr.id = SAI_NEXT_HOP_GROUP_ATTR_TYPE;
     nhg_attr.value.s32 = m_switchOrch->checkOrderedEcmpEnable() ? SAI_NEXT_HOP_GROUP_TYPE_DYNAMIC_ORDERED_ECMP : SAI_NEXT_HOP_GROUP_TYPE_ECMP;
@@ -1591,7 +2075,7 @@ bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops)
         auto weight = nhopgroup_members_set[nhid].weight;
 
         // Create a next hop group member
-        vector<sai_attribute_t> nhgm_attrs;
+        SaiAttrList<> nhgm_attrs;
 
         sai_attribute_t nhgm_attr;
         nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
@@ -1669,6 +2153,7 @@ bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops)
      */
     next_hop_group_entry.ref_count = 0;
     m_syncdNextHopGroups[nexthops] = next_hop_group_entry;
+    indexNextHopGroup(*m_syncdNextHopGroups.find(nexthops));
 
     return true;
 }
@@ -1690,6 +2175,16 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops, const bool i
         return true;
     }
 
+    /* The group is NhgOrch's, only the reference to it goes away */
+    if (!next_hop_group_entry->second.shared_nhg_index.empty())
+    {
+        SWSS_LOG_NOTICE("Release shared next hop group %s of %s", next_hop_group_entry->second.shared_nhg_index.c_str(),
+                        nexthops.to_string().c_str());
+        gNhgOrch->decNhgRefCount(next_hop_group_entry->second.shared_nhg_index);
+        m_syncdNextHopGroups.erase(next_hop_group_entry);
+        return true;
+    }
+
     next_hop_group_id = next_hop_group_entry->second.next_hop_group_id;
     SWSS_LOG_NOTICE("Delete next hop group %s", nexthops.to_string().c_str());
 
@@ -1757,7 +2252,7 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops, const bool i
         }
     }
 
-    m_nextHopGroupCount--;
+    decreaseNextHopGroupCount();
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
     MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
     sai_object_id_t mux_tunnel_nh_id = mux_orch->getTunnelNextHopId();
@@ -1814,11 +2309,191 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops, const bool i
         }
     }
  
+    unindexNextHopGroup(*next_hop_group_entry);
     m_syncdNextHopGroups.erase(nexthops);
 
     return true;
 }
 
+/*
+ * Reuse the NhgOrch group with the same next hops as a route, if any, as the
+ * route's next hop group instead of syncing another group with the same
+ * members.  NhgOrch keeps owning the group and its members, RouteOrch only
+ * holds one reference to it for all the routes sharing it.
+ */
+bool RouteOrch::shareNextHopGroup(const RouteBulkContext& ctx, const NextHopGroupKey &nexthops)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Groups whose members RouteOrch changes on its own, swapping in the
+     * default route next hops or handling overlay and SRv6 next hops, are
+     * never shared.
+     */
+    if (ctx.fallback_to_default_route || ctx.ip_prefix.isDefaultRoute() ||
+        nexthops.is_overlay_nexthop() || nexthops.is_srv6_nexthop())
+    {
+        return false;
+    }
+
+    string nhg_index = gNhgOrch->getShareableNhg(nexthops);
+    if (nhg_index.empty())
+    {
+        return false;
+    }
+
+    NextHopGroupEntry next_hop_group_entry;
+    next_hop_group_entry.next_hop_group_id = gNhgOrch->getNhg(nhg_index).getId();
+    next_hop_group_entry.shared_nhg_index = nhg_index;
+    m_syncdNextHopGroups[nexthops] = next_hop_group_entry;
+    gNhgOrch->incNhgRefCount(nhg_index);
+
+    SWSS_LOG_NOTICE("Share next hop group %s for %s", nhg_index.c_str(), nexthops.to_string().c_str());
+    return true;
+}
+
+/*
+ * Give the routes sharing the NhgOrch group nhg_index a group synced by
+ * RouteOrch, before NhgOrch updates or removes the group.  Returns false if
+ * the group cannot be synced yet, the routes then keep sharing the group.
+ */
+bool RouteOrch::unshareNextHopGroup(const string& nhg_index, const NextHopGroupKey &nexthops)
+{
+    SWSS_LOG_ENTER();
+
+    auto it_nhg = m_syncdNextHopGroups.find(nexthops);
+    if (it_nhg == m_syncdNextHopGroups.end() || it_nhg->second.shared_nhg_index != nhg_index)
+    {
+        return true;
+    }
+
+    NextHopGroupEntry shared_entry = it_nhg->second;
+    m_syncdNextHopGroups.erase(it_nhg);
+
+    if (!addNextHopGroup(nexthops))
+    {
+        SWSS_LOG_INFO("Failed to sync next hop group %s to unshare %s", nexthops.to_string().c_str(), nhg_index.c_str());
+        m_syncdNextHopGroups[nexthops] = shared_entry;
+        return false;
+    }
+
+    auto& next_hop_group_entry = m_syncdNextHopGroups.at(nexthops);
+    next_hop_group_entry.ref_count = shared_entry.ref_count;
+    sai_object_id_t next_hop_group_id = next_hop_group_entry.next_hop_group_id;
+
+    /* Mux routes point to a next hop or tunnel of MuxOrch's choice rather than to the group */
+    MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
+    bool mux_nexthops = mux_orch->isMuxNexthops(nexthops);
+
+    std::deque<sai_status_t> route_statuses;
+    std::vector<IpPrefix> prefixes;
+    for (auto& route_table : m_syncdRoutes)
+    {
+        for (auto& route : route_table.second)
+        {
+            if (mux_nexthops || !route.second.nhg_index.empty() || route.second.nhg_key != nexthops ||
+                m_fgNhgOrch->syncdContainsFgNhg(route_table.first, route.first))
+            {
+                continue;
+            }
+
+            sai_route_entry_t route_entry;
+            route_entry.vr_id = route_table.first;
+            route_entry.switch_id = gSwitchId;
+            copy(route_entry.destination, route.first);
+
+            sai_attribute_t route_attr;
+            route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+            route_attr.value.oid = next_hop_group_id;
+
+            route_statuses.emplace_back();
+            gRouteBulker.set_entry_attribute(&route_statuses.back(), &route_entry, &route_attr);
+            prefixes.push_back(route.first);
+        }
+    }
+
+    std::deque<sai_status_t> label_statuses;
+    for (auto& label_route_table : m_syncdLabelRoutes)
+    {
+        for (auto& label_route : label_route_table.second)
+        {
+            if (!label_route.second.nhg_index.empty() || label_route.second.nhg_key != nexthops)
+            {
+                continue;
+            }
+
+            sai_inseg_entry_t inseg_entry;
+            inseg_entry.switch_id = gSwitchId;
+            inseg_entry.label = label_route.first;
+
+            sai_attribute_t inseg_attr;
+            inseg_attr.id = SAI_INSEG_ENTRY_ATTR_NEXT_HOP_ID;
+            inseg_attr.value.oid = next_hop_group_id;
+
+            label_statuses.emplace_back();
+            gLabelRouteBulker.set_entry_attribute(&label_statuses.back(), &inseg_entry, &inseg_attr);
+        }
+    }
+
+    gRouteBulker.flush();
+    gLabelRouteBulker.flush();
+
+    size_t i = 0;
+    for (auto status : route_statuses)
+    {
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to set route %s to next hop group %s, rv:%d",
+                           prefixes[i].to_string().c_str(), nexthops.to_string().c_str(), status);
+            handleSaiSetStatus(SAI_API_ROUTE, status);
+        }
+        i++;
+    }
+
+    for (auto status : label_statuses)
+    {
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to set label route to next hop group %s, rv:%d",
+                           nexthops.to_string().c_str(), status);
+            handleSaiSetStatus(SAI_API_MPLS, status);
+        }
+    }
+
+    gNhgOrch->decNhgRefCount(nhg_index);
+
+    SWSS_LOG_NOTICE("Unshare next hop group %s for %s, %zu routes moved", nhg_index.c_str(),
+                    nexthops.to_string().c_str(), route_statuses.size() + label_statuses.size());
+    return true;
+}
+
+void RouteOrch::indexNextHopGroup(NextHopGroupTable::value_type &nhg)
+{
+    /* Entries of the unordered_map keep their address until erased */
+    for (const auto &nh : nhg.first.getNextHops())
+    {
+        m_nextHopGroupMembers[nh].insert(&nhg);
+    }
+}
+
+void RouteOrch::unindexNextHopGroup(NextHopGroupTable::value_type &nhg)
+{
+    for (const auto &nh : nhg.first.getNextHops())
+    {
+        auto it = m_nextHopGroupMembers.find(nh);
+        if (it == m_nextHopGroupMembers.end())
+        {
+            continue;
+        }
+
+        it->second.erase(&nhg);
+        if (it->second.empty())
+        {
+            m_nextHopGroupMembers.erase(it);
+        }
+    }
+}
+
 void RouteOrch::addNextHopRoute(const NextHopKey& nextHop, const RouteKey& routeKey)
 {
     auto it = m_nextHops.find((nextHop));
@@ -1868,62 +2543,100 @@ void RouteOrch::removeNextHopRoute(const NextHopKey& nextHop, const RouteKey& ro
 
 bool RouteOrch::updateNextHopRoutes(const NextHopKey& nextHop, uint32_t& numRoutes)
 {
-    numRoutes = 0;
-    auto it = m_nextHops.find((nextHop));
+    vector<uint32_t> counts, failed;
+    bool success = updateNextHopRoutes(vector<NextHopKey>{ nextHop }, counts, failed);
+    numRoutes = counts[0];
+    return success;
+}
 
-    if (it == m_nextHops.end())
+/**
+ * @brief Points the single nexthop routes of every nexthop at its current
+ *        nexthop ID, the routes of all the nexthops go in one bulk call
+ * @param nextHops nexthops whose routes are updated
+ * @param numRoutes number of routes updated, per nexthop
+ * @param numFailed number of routes that failed to update, per nexthop
+ * @return true if all the routes were updated
+ */
+bool RouteOrch::updateNextHopRoutes(const vector<NextHopKey>& nextHops, vector<uint32_t>& numRoutes, vector<uint32_t>& numFailed)
+{
+    numRoutes.assign(nextHops.size(), 0);
+    numFailed.assign(nextHops.size(), 0);
+
+    size_t total = 0;
+    for (const auto& nextHop : nextHops)
     {
-        SWSS_LOG_INFO("No routes found for NH %s", nextHop.ip_address.to_string().c_str());
-        return true;
+        auto it = m_nextHops.find(nextHop);
+        if (it != m_nextHops.end())
+        {
+            total += it->second.size();
+        }
     }
 
     sai_route_entry_t route_entry;
     sai_attribute_t route_attr;
-    sai_object_id_t next_hop_id;
+    route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
 
-    auto rt = it->second.begin();
-    while(rt != it->second.end())
+    vector<const RouteKey *> routes;
+    vector<size_t> owners;
+    vector<sai_status_t> statuses(total);
+    for (size_t i = 0; i < nextHops.size(); i++)
     {
-        /* Check if route points to nexthop group and skip */
-        NextHopGroupKey nhg_key = gRouteOrch->getSyncdRouteNhgKey(gVirtualRouterId, (*rt).prefix);
-        if (nhg_key.getSize() > 1)
+        auto it = m_nextHops.find(nextHops[i]);
+        if (it == m_nextHops.end())
         {
-            /* multiple mux nexthop case:
-             * skip for now, muxOrch::updateRoute() will handle route
-             */
-            SWSS_LOG_INFO("Route %s is mux multi nexthop route, skipping.",
-                        (*rt).prefix.to_string().c_str());
-
-            ++rt;
+            SWSS_LOG_INFO("No routes found for NH %s", nextHops[i].ip_address.to_string().c_str());
             continue;
         }
 
-        next_hop_id = m_neighOrch->getNextHopId(nextHop);
-        SWSS_LOG_INFO("Updating route %s with nexthop %" PRIu64, (*rt).prefix.to_string().c_str(), (uint64_t)next_hop_id);
+        sai_object_id_t next_hop_id = m_neighOrch->getNextHopId(nextHops[i]);
+        route_attr.value.oid = next_hop_id;
+
+        for (const auto& rt : it->second)
+        {
+            /* Check if route points to nexthop group and skip */
+            NextHopGroupKey nhg_key = gRouteOrch->getSyncdRouteNhgKey(gVirtualRouterId, rt.prefix);
+            if (nhg_key.getSize() > 1)
+            {
+                /* multiple mux nexthop case:
+                 * skip for now, muxOrch::updateRoute() will handle route
+                 */
+                SWSS_LOG_INFO("Route %s is mux multi nexthop route, skipping.",
+                            rt.prefix.to_string().c_str());
+                continue;
+            }
 
-        route_entry.vr_id = (*rt).vrf_id;
-        route_entry.switch_id = gSwitchId;
-        copy(route_entry.destination, (*rt).prefix);
+            SWSS_LOG_INFO("Updating route %s with nexthop %" PRIu64, rt.prefix.to_string().c_str(), (uint64_t)next_hop_id);
 
-        route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
-        route_attr.value.oid = next_hop_id;
+            route_entry.vr_id = rt.vrf_id;
+            route_entry.switch_id = gSwitchId;
+            copy(route_entry.destination, rt.prefix);
 
-        sai_status_t status = sai_route_api->set_route_entry_attribute(&route_entry, &route_attr);
-        if (status != SAI_STATUS_SUCCESS)
+            gRouteBulker.set_entry_attribute(&statuses[routes.size()], &route_entry, &route_attr);
+            routes.push_back(&rt);
+            owners.push_back(i);
+        }
+    }
+    gRouteBulker.flush();
+
+    bool success = true;
+    for (size_t i = 0; i < routes.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("Failed to update route %s, rv:%d", (*rt).prefix.to_string().c_str(), status);
-            task_process_status handle_status = handleSaiSetStatus(SAI_API_ROUTE, status);
+            SWSS_LOG_ERROR("Failed to update route %s, rv:%d", routes[i]->prefix.to_string().c_str(), statuses[i]);
+            task_process_status handle_status = handleSaiSetStatus(SAI_API_ROUTE, statuses[i]);
             if (handle_status != task_success)
             {
-                return parseHandleSaiStatusFailure(handle_status);
+                success = parseHandleSaiStatusFailure(handle_status) && success;
+                ++numFailed[owners[i]];
+                continue;
             }
         }
 
-        ++numRoutes;
-        ++rt;
+        ++numRoutes[owners[i]];
     }
 
-    return true;
+    return success;
 }
 
 /**
@@ -2151,6 +2864,13 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
                     SWSS_LOG_INFO("Failed to get next hop %s for %s, resolving neighbor",
                             nextHops.to_string().c_str(), ipPrefix.to_string().c_str());
                     m_neighOrch->resolveNeighbor(nexthop);
+                    /* Park the route in the RetryCache until NeighOrch creates the next hop, rather than
+                     * rescanning it on every doTask. Neighbors on VLAN interfaces may instead get a MuxOrch
+                     * tunnel next hop that is not announced, so such routes keep being rescanned. */
+                    if (nexthop.alias.compare(0, strlen(VLAN_PREFIX), VLAN_PREFIX))
+                    {
+                        ctx.retry_cst = make_constraint(RETRY_CST_NEIGH, NextHopKey(nexthop.ip_address, nexthop.alias).to_string());
+                    }
                     return false;
                 }
             }
@@ -2173,8 +2893,8 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
             }
         }
 
-        /* Check if there is already an existing next hop group */
-        if (!hasNextHopGroup(nextHops))
+        /* Check if there is already an existing next hop group, or one to share */
+        if (!hasNextHopGroup(nextHops) && !shareNextHopGroup(ctx, nextHops))
         {
             /* Try to create a new next hop group */
             if (!addNextHopGroup(nextHops))
@@ -2186,7 +2906,7 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
                     return false;
                 }
 
-                if (it_route != m_syncdRoutes.at(vrf_id).end() && it_route->second.nhg_key.is_srv6_nexthop())
+                if (it_route != m_syncdRoutes.at(vrf_id).end() && it_route->second.nhg_key->is_srv6_nexthop())
                 {
                     return false;
                 }
@@ -2225,9 +2945,9 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
 
                 /* If the current next hop is part of the next hop group to sync,
                  * then return false and no need to add another temporary route. */
-                if (it_route != m_syncdRoutes.at(vrf_id).end() && it_route->second.nhg_key.getSize() == 1)
+                if (it_route != m_syncdRoutes.at(vrf_id).end() && it_route->second.nhg_key->getSize() == 1)
                 {
-                    const NextHopKey& nexthop = *it_route->second.nhg_key.getNextHops().begin();
+                    const NextHopKey& nexthop = *it_route->second.nhg_key->getNextHops().begin();
                     if (nextHops.contains(nexthop))
                     {
                         return false;
@@ -2238,6 +2958,13 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
                  * and there is no temporary route right now or the current temporary
                  * route is not pointing to a member of the next hop group to sync. */
                 addTempRoute(ctx, nextHops);
+
+                /* Out of next hop groups, park the route in the RetryCache until one is
+                 * released rather than trying to add the group again on every doTask */
+                if (m_nextHopGroupCount + NhgOrch::getSyncedNhgCount() >= m_maxNextHopGroupCount)
+                {
+                    ctx.retry_cst = make_constraint(RETRY_CST_NHG);
+                }
                 /* Return false since the original route is not successfully added */
                 return false;
             }
@@ -2261,7 +2988,7 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
 
     sai_attribute_t route_attr;
     vector<sai_attribute_t> attrs;
-    vector<_sai_attribute_t> route_attrs;
+    SaiAttrList<> route_attrs;
     auto& object_statuses = ctx.object_statuses;
 
     /* If the prefix is not in m_syncdRoutes, then we need to create the route
@@ -2309,7 +3036,7 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
     else
     {
         /* Set the packet action to forward when there was no next hop (dropped) and not pointing to blackhole*/
-        if (it_route->second.nhg_key.getSize() == 0 && !blackhole)
+        if (it_route->second.nhg_key->getSize() == 0 && !blackhole)
         {
             route_attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
             route_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
@@ -2496,7 +3223,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
                 /* Case where route was pointing to non-fine grained nhs in the past,
                  * and transitioned to Fine Grained ECMP */
                 decreaseNextHopRefCount(it_route->second.nhg_key);
-                if (it_route->second.nhg_key.getSize() > 1
+                if (it_route->second.nhg_key->getSize() > 1
                     && m_syncdNextHopGroups[it_route->second.nhg_key].ref_count == 0)
                 {
                     m_bulkNhgReducedRefCnt.emplace(it_route->second.nhg_key, 0);
@@ -2554,7 +3281,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         sai_status_t status;
 
         /* Set the packet action to forward when there was no next hop (dropped) and not pointing to blackhole */
-        if (it_route->second.nhg_key.getSize() == 0 && !blackhole)
+        if (it_route->second.nhg_key->getSize() == 0 && !blackhole)
         {
             status = *it_status++;
             if (status != SAI_STATUS_SUCCESS)
@@ -2598,7 +3325,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         else if (it_route->second.nhg_index.empty())
         {
             decreaseNextHopRefCount(it_route->second.nhg_key);
-            auto ol_nextHops = it_route->second.nhg_key;
+            NextHopGroupKey ol_nextHops = it_route->second.nhg_key;
             if (ol_nextHops.is_srv6_nexthop())
             {
                 m_bulkSrv6NhgReducedVec.emplace_back(ol_nextHops);
@@ -2626,7 +3353,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
             }
             else if (ol_nextHops.is_overlay_nexthop())
             {
-                const NextHopKey& nexthop = *it_route->second.nhg_key.getNextHops().begin();
+                const NextHopKey& nexthop = *it_route->second.nhg_key->getNextHops().begin();
                 if (m_neighOrch->getNextHopRefCount(nexthop) == 0)
                 {
                     SWSS_LOG_NOTICE("Update overlay Nexthop %s", ol_nextHops.to_string().c_str());
@@ -2907,7 +3634,7 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
          */
         decreaseNextHopRefCount(it_route->second.nhg_key);
 
-        auto ol_nextHops = it_route->second.nhg_key;
+        NextHopGroupKey ol_nextHops = it_route->second.nhg_key;
 
         if (ol_nextHops.is_srv6_nexthop())
         {
@@ -2915,7 +3642,7 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
         }
         
         MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
-        if (it_route->second.nhg_key.getSize() > 1)
+        if (it_route->second.nhg_key->getSize() > 1)
         {
             if (m_syncdNextHopGroups[it_route->second.nhg_key].ref_count == 0)
             {
@@ -2938,7 +3665,7 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
         }
         else if (ol_nextHops.is_overlay_nexthop())
         {
-            const NextHopKey& nexthop = *it_route->second.nhg_key.getNextHops().begin();
+            const NextHopKey& nexthop = *it_route->second.nhg_key->getNextHops().begin();
             if (m_neighOrch->getNextHopRefCount(nexthop) == 0)
             {
                 SWSS_LOG_NOTICE("Remove overlay Nexthop %s", ol_nextHops.to_string().c_str());
@@ -2949,9 +3676,9 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
          * Additionally check if the NH has label and its ref count == 0, then
          * remove the label next hop.
          */
-        else if (it_route->second.nhg_key.getSize() == 1)
+        else if (it_route->second.nhg_key->getSize() == 1)
         {
-            const NextHopKey& nexthop = *it_route->second.nhg_key.getNextHops().begin();
+            const NextHopKey& nexthop = *it_route->second.nhg_key->getNextHops().begin();
             if (nexthop.isMplsNextHop() &&
                 (m_neighOrch->getNextHopRefCount(nexthop) == 0))
             {
@@ -2964,7 +3691,7 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
     }
 
     SWSS_LOG_INFO("Remove route %s with next hop(s) %s",
-            ipPrefix.to_string().c_str(), it_route->second.nhg_key.to_string().c_str());
+            ipPrefix.to_string().c_str(), it_route->second.nhg_key->to_string().c_str());
 
     /* Publish removal status, removes route entry from APPL STATE DB */
     publishRouteState(ctx);
@@ -3123,6 +3850,12 @@ void RouteOrch::increaseNextHopGroupCount()
 void RouteOrch::decreaseNextHopGroupCount()
 {
     m_nextHopGroupCount --;
+    notifyNextHopGroupReleased();
+}
+
+void RouteOrch::notifyNextHopGroupReleased()
+{
+    notifyRetry(this, APP_ROUTE_TABLE_NAME, make_constraint(RETRY_CST_NHG));
 }
 
 bool RouteOrch::checkNextHopGroupCount()
@@ -3130,6 +3863,25 @@ bool RouteOrch::checkNextHopGroupCount()
     return m_nextHopGroupCount < m_maxNextHopGroupCount;
 }
 
+void RouteOrch::getObjectCounts(vector<FieldValueTuple> &counts) const
+{
+    size_t routes = 0;
+    for (const auto &vrf : m_syncdRoutes)
+    {
+        routes += vrf.second.size();
+    }
+
+    size_t labelRoutes = 0;
+    for (const auto &vrf : m_syncdLabelRoutes)
+    {
+        labelRoutes += vrf.second.size();
+    }
+
+    counts.emplace_back("routes", to_string(routes));
+    counts.emplace_back("label_routes", to_string(labelRoutes));
+    counts.emplace_back("next_hop_groups", to_string(m_nextHopGroupCount));
+}
+
 const NhgBase &RouteOrch::getNhg(const std::string &nhg_index)
 {
     SWSS_LOG_ENTER();
@@ -3196,6 +3948,12 @@ void RouteOrch::publishRouteState(const RouteBulkContext& ctx, const ReturnCode&
         fvs.emplace_back("protocol", ctx.protocol);
     }
 
+    if (m_bulkRouteStates)
+    {
+        m_routeStates.push_back({ctx.key, std::move(fvs), status});
+        return;
+    }
+
     const bool replace = false;
 
     m_publisher.publish(APP_ROUTE_TABLE_NAME, ctx.key, fvs, status, replace);
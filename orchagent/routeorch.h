@@ -13,11 +13,15 @@
 #include "ipaddresses.h"
 #include "ipprefix.h"
 #include "nexthopgroupkey.h"
+#include "hosttrie.h"
 #include "bulker.h"
 #include "fgnhgorch.h"
 #include <map>
 #include "zmqorch.h"
 #include "zmqserver.h"
+#include "orchworkerpool.h"
+#include "memaccounting.h"
+#include <memory>
 #include <unordered_map>
 
 /* Maximum next hop group number */
@@ -28,6 +32,9 @@
 #define LOOPBACK_PREFIX     "Loopback"
 #define VLAN_PREFIX         "Vlan"
 
+/* Digest buckets of the routes of a VRF */
+#define ROUTE_DIGEST_BUCKETS 1024
+
 struct NextHopGroupMemberEntry
 {
     sai_object_id_t  next_hop_id; // next hop sai oid
@@ -56,6 +63,7 @@ struct NextHopGroupEntry
     uint32_t                nh_member_install_count;
     bool                    eligible_for_default_route_nh_swap;
     bool                    is_default_route_nh_swap;
+    std::string             shared_nhg_index;       // NhgOrch's group reused instead of syncing one, if not empty
 };
 
 struct NextHopUpdate
@@ -73,7 +81,8 @@ struct NextHopUpdate
  */
 struct RouteNhg
 {
-    NextHopGroupKey nhg_key;
+    /* Interned, routes with the same next hops share the key */
+    NextHopGroupKeyRef nhg_key;
 
     /*
      * Index of the next hop group used.  Filled only if referencing a
@@ -86,6 +95,8 @@ struct RouteNhg
     RouteNhg() = default;
     RouteNhg(const NextHopGroupKey& key, const std::string& index, const std::string &context_index = "") :
         nhg_key(key), nhg_index(index), context_index(context_index) {}
+    RouteNhg(const NextHopGroupKeyRef& key, const std::string& index, const std::string &context_index = "") :
+        nhg_key(key), nhg_index(index), context_index(context_index) {}
 
     bool operator==(const RouteNhg& rnhg)
        { return ((nhg_key == rnhg.nhg_key) && (nhg_index == rnhg.nhg_index) && (context_index == rnhg.context_index)); }
@@ -106,10 +117,15 @@ struct RouteKey
     }
 };
 
+MEM_ACCOUNTING_TAG(NextHopGroupMemTag, "RouteOrch|next_hop_groups");
+MEM_ACCOUNTING_TAG(RouteMemTag, "RouteOrch|routes");
+
 /* NextHopGroupTable: NextHopGroupKey, NextHopGroupEntry */
-typedef std::unordered_map<NextHopGroupKey, NextHopGroupEntry> NextHopGroupTable;
+typedef std::unordered_map<NextHopGroupKey, NextHopGroupEntry, std::hash<NextHopGroupKey>, std::equal_to<NextHopGroupKey>,
+                           MemAccountingAllocator<std::pair<const NextHopGroupKey, NextHopGroupEntry>, NextHopGroupMemTag>> NextHopGroupTable;
 /* RouteTable: destination network, NextHopGroupKey */
-typedef std::map<IpPrefix, RouteNhg> RouteTable;
+typedef std::map<IpPrefix, RouteNhg, std::less<IpPrefix>,
+                 MemAccountingAllocator<std::pair<const IpPrefix, RouteNhg>, RouteMemTag>> RouteTable;
 /* RouteTables: vrf_id, RouteTable */
 typedef std::map<sai_object_id_t, RouteTable> RouteTables;
 /* LabelRouteTable: destination label, next hop address(es) */
@@ -122,6 +138,8 @@ typedef std::pair<sai_object_id_t, IpAddress> Host;
 typedef std::map<Host, NextHopObserverEntry> NextHopObserverTable;
 /* Single Nexthop to Routemap */
 typedef std::map<NextHopKey, std::set<RouteKey>> NextHopRouteTable;
+/* NextHopGroupMemberIndex: next hop, syncd next hop groups it is a member of */
+typedef std::map<NextHopKey, std::set<NextHopGroupTable::value_type *>> NextHopGroupMemberIndex;
 
 struct NextHopObserverEntry
 {
@@ -133,7 +151,7 @@ struct RouteBulkContext
 {
     std::deque<sai_status_t>            object_statuses;    // Bulk statuses
     NextHopGroupKey                     tmp_next_hop;       // Temporary next hop
-    NextHopGroupKey                     nhg;
+    NextHopGroupKeyRef                  nhg;
     std::string                         nhg_index;
     std::string                         context_index;
     sai_object_id_t                     vrf_id;
@@ -151,12 +169,13 @@ struct RouteBulkContext
     std::string                         key;       // Key in database table
     std::string                         protocol;  // Protocol string
     bool                                is_set;    // True if set operation
+    uint64_t                            digest;    // TableDigest of the SET task
 
     Constraint                          retry_cst;
 
     RouteBulkContext(const std::string& key, bool is_set)
         : key(key), excp_intfs_flag(false), using_temp_nhg(false), is_set(is_set),
-          fallback_to_default_route(false), retry_cst(DUMMY_CONSTRAINT)
+          digest(0), fallback_to_default_route(false), retry_cst(DUMMY_CONSTRAINT)
     {
     }
 
@@ -168,18 +187,90 @@ struct RouteBulkContext
     {
         object_statuses.clear();
         tmp_next_hop.clear();
-        nhg.clear();
+        nhg = NextHopGroupKeyRef();
         ipv.clear();
         vrf_id = SAI_NULL_OBJECT_ID;
         excp_intfs_flag = false;
         using_temp_nhg = false;
         key.clear();
         protocol.clear();
+        digest = 0;
         fallback_to_default_route = false;
         retry_cst = DUMMY_CONSTRAINT;
     }
 };
 
+/*
+ * Digests of the APP_ROUTE_TABLE entries RouteOrch is done with, as they were
+ * read from APPL_DB, summed into buckets by VRF and prefix. When a routeresync
+ * window ends the same buckets are digested over APPL_DB, and only the routes
+ * of the buckets that differ are driven through RouteOrch again.
+ */
+class RouteDigest
+{
+public:
+    /* VRF name, empty for the default VRF, and bucket of the prefix */
+    typedef std::pair<std::string, uint32_t> Bucket;
+    typedef std::map<Bucket, TableDigest> Buckets;
+
+    static Bucket getBucket(const std::string &key);
+
+    void set(const std::string &key, uint64_t digest);
+    void del(const std::string &key);
+
+    /* Digest of the entry of the key, false if there is none */
+    bool get(const std::string &key, uint64_t &digest) const;
+
+    const Buckets &getBuckets() const { return m_buckets; }
+    const std::unordered_map<std::string, uint64_t> &getEntries() const { return m_entries; }
+
+private:
+    std::unordered_map<std::string, uint64_t> m_entries;
+    Buckets m_buckets;
+};
+
+/*
+ * Fields of an APP_ROUTE_TABLE task, parsed without touching any Orch state
+ * so that batches of tasks can be parsed on RouteOrch's parse threads.
+ */
+struct RouteRequest
+{
+    std::string                         vrf_name;           // Empty for the default VRF
+    std::string                         prefix;
+    IpPrefix                            ip_prefix;
+    bool                                prefix_valid = false;
+
+    std::string                         ips;
+    std::string                         aliases;
+    std::string                         mpls_nhs;
+    std::string                         vni_labels;
+    std::string                         remote_macs;
+    std::string                         weights;
+    std::string                         nhg_index;
+    std::string                         context_index;
+    std::string                         srv6_segments;
+    std::string                         srv6_source;
+    std::string                         srv6_vpn_sids;
+    std::string                         protocol;
+    bool                                overlay_nh = false;
+    bool                                blackhole = false;
+    bool                                srv6_seg = false;
+    bool                                srv6_vpn = false;
+    bool                                srv6_nh = false;
+    bool                                fallback_to_default_route = false;
+    bool                                malformed = false;  // Undecodable ROUTE_BINARY_FIELD
+
+    // Tokenized next hop fields, filled when nhg_index is empty
+    std::vector<string>                 ipv;
+    std::vector<string>                 alsv;
+    std::vector<string>                 mpls_nhv;
+    std::vector<string>                 vni_labelv;
+    std::vector<string>                 rmacv;
+    std::vector<string>                 srv6_segv;
+    std::vector<string>                 srv6_src;
+    std::vector<string>                 srv6_vpn_sidv;
+};
+
 struct LabelRouteBulkContext
 {
     std::deque<sai_status_t>            object_statuses;    // Bulk statuses
@@ -233,6 +324,7 @@ public:
 
     bool addNextHopGroup(const NextHopGroupKey&);
     bool removeNextHopGroup(const NextHopGroupKey&, const bool is_default_route_nh_swap=false);
+    bool unshareNextHopGroup(const std::string& nhg_index, const NextHopGroupKey&);
 
     bool addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops);
     bool removeRoute(RouteBulkContext& ctx);
@@ -242,6 +334,7 @@ public:
     void addNextHopRoute(const NextHopKey&, const RouteKey&);
     void removeNextHopRoute(const NextHopKey&, const RouteKey&);
     bool updateNextHopRoutes(const NextHopKey&, uint32_t&);
+    bool updateNextHopRoutes(const std::vector<NextHopKey>&, std::vector<uint32_t>&, std::vector<uint32_t>&);
     bool getRoutesForNexthop(std::set<RouteKey>&, const NextHopKey&);
     bool swapnexthopinNextHopGroup(sai_object_id_t next_hop_group_id, sai_object_id_t default_next_hop_id);
 
@@ -268,9 +361,20 @@ public:
 
     void increaseNextHopGroupCount();
     void decreaseNextHopGroupCount();
+    /* Wake up the routes waiting for a next hop group to be released */
+    void notifyNextHopGroupReleased();
     bool checkNextHopGroupCount();
     const RouteTables& getSyncdRoutes() const { return m_syncdRoutes; }
 
+    void getObjectCounts(std::vector<FieldValueTuple> &counts) const override;
+
+    /* Parse APP_ROUTE_TABLE tasks on threads threads ahead of doTask, 0 parses them inline */
+    static void setParseThreads(size_t threads) { m_parseThreads = threads; }
+
+    static void parseRouteRequest(const KeyOpFieldsValuesTuple &t, RouteRequest &req);
+    /* Fills the SET fields of req from a ROUTE_BINARY_FIELD value, returns false if malformed */
+    static bool parseRouteBinaryRequest(const std::string &bin, RouteRequest &req);
+
 private:
     SwitchOrch *m_switchOrch;
     NeighOrch *m_neighOrch;
@@ -282,6 +386,7 @@ private:
     unsigned int m_nextHopGroupCount;
     unsigned int m_maxNextHopGroupCount;
     bool m_resync;
+    RouteDigest m_routeDigest;
 
     std::set<NextHopKey> v4_active_default_route_nhops;
     std::set<NextHopKey> v6_active_default_route_nhops;
@@ -292,6 +397,7 @@ private:
     LabelRouteTables m_syncdLabelRoutes;
     NextHopGroupTable m_syncdNextHopGroups;
     NextHopRouteTable m_nextHops;
+    NextHopGroupMemberIndex m_nextHopGroupMembers;
 
     std::set<std::pair<NextHopGroupKey, sai_object_id_t>> m_bulkNhgReducedRefCnt;
     /* m_bulkNhgReducedRefCnt: nexthop, vrf_id */
@@ -301,13 +407,32 @@ private:
     std::vector<NextHopGroupKey> m_bulkSrv6NhgReducedVec;
 
     NextHopObserverTable m_nextHopObservers;
+    /* vrf_id, hosts of m_nextHopObservers indexed by address */
+    std::map<sai_object_id_t, HostTrie<Host>> m_observedHosts;
+
+    /* Route states of the current doTask() batch, published with a single notification */
+    bool m_bulkRouteStates = false;
+    std::vector<ResponsePublisher::Response> m_routeStates;
 
     EntityBulker<sai_route_api_t>           gRouteBulker;
     EntityBulker<sai_mpls_api_t>            gLabelRouteBulker;
     ObjectBulker<sai_next_hop_group_api_t>  gNextHopGroupMemberBulker;
 
+    static size_t m_parseThreads;
+    std::unique_ptr<OrchWorkerPool> m_parsePool;
+    /* Requests parsed ahead of the drain, by task in m_toSync, valid for one doTask() */
+    std::unordered_map<const KeyOpFieldsValuesTuple *, RouteRequest> m_parsedRoutes;
+
+    void preParseRoutes(SyncMap &toSync, SyncMap::iterator it);
+    bool takeParsedRoute(SyncMap &toSync, SyncMap::iterator it, RouteRequest &req);
+
+    void indexNextHopGroup(NextHopGroupTable::value_type &nhg);
+    void unindexNextHopGroup(NextHopGroupTable::value_type &nhg);
+
     void addTempRoute(RouteBulkContext& ctx, const NextHopGroupKey&);
+    bool shareNextHopGroup(const RouteBulkContext& ctx, const NextHopGroupKey&);
 
+    void addLabelRouteNextHops(ConsumerBase& consumer);
     void addTempLabelRoute(LabelRouteBulkContext& ctx, const NextHopGroupKey&);
     bool addLabelRoute(LabelRouteBulkContext& ctx, const NextHopGroupKey&);
     bool removeLabelRoute(LabelRouteBulkContext& ctx);
@@ -317,6 +442,8 @@ private:
     void updateDefRouteState(string ip, bool add=false);
 
     void doTask(ConsumerBase& consumer);
+    /* Drive the routes that differ between APPL_DB and m_routeDigest */
+    void reconcileRoutes(ConsumerBase& consumer);
     void doLabelTask(ConsumerBase& consumer);
 
     const NhgBase &getNhg(const std::string& nhg_index);
@@ -22,23 +22,34 @@ SaiAttrWrapper::~SaiAttrWrapper()
     }
 }
 
-SaiAttrWrapper::SaiAttrWrapper(const SaiAttrWrapper& other)
+SaiAttrWrapper::SaiAttrWrapper(const SaiAttrWrapper& other) :
+    m_objectType(other.m_objectType),
+    m_meta(other.m_meta),
+    m_serializedAttr(other.m_serializedAttr)
 {
-    init(other.m_objectType, *other.m_meta, other.m_attr);
+    if (m_meta)
+    {
+        m_attr.id = other.m_attr.id;
+        deserialize();
+    }
 }
 
 SaiAttrWrapper& SaiAttrWrapper::operator=(const SaiAttrWrapper& other)
 {
-    init(other.m_objectType, *other.m_meta, other.m_attr);
+    if (this != &other)
+    {
+        // The lists held so far are released with the temporary
+        swap(SaiAttrWrapper(other));
+    }
     return *this;
 }
 
-SaiAttrWrapper::SaiAttrWrapper(SaiAttrWrapper&& other)
+SaiAttrWrapper::SaiAttrWrapper(SaiAttrWrapper&& other) noexcept
 {
     swap(std::move(other));
 }
 
-SaiAttrWrapper& SaiAttrWrapper::operator=(SaiAttrWrapper&& other)
+SaiAttrWrapper& SaiAttrWrapper::operator=(SaiAttrWrapper&& other) noexcept
 {
     swap(std::move(other));
     return *this;
@@ -64,7 +75,7 @@ sai_attr_id_t SaiAttrWrapper::getAttrId() const
     return m_attr.id;
 }
 
-void SaiAttrWrapper::swap(SaiAttrWrapper&& other)
+void SaiAttrWrapper::swap(SaiAttrWrapper&& other) noexcept
 {
     std::swap(m_objectType, other.m_objectType);
     std::swap(m_meta, other.m_meta);
@@ -83,6 +94,11 @@ void SaiAttrWrapper::init(
 
     m_serializedAttr = sai_serialize_attr_value(*m_meta, attr);
 
+    deserialize();
+}
+
+void SaiAttrWrapper::deserialize()
+{
     // deserialize to actually preform a deep copy of attr
     // and attribute value's dynamically allocated lists.
     sai_deserialize_attr_value(m_serializedAttr, *m_meta, m_attr);
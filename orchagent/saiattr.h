@@ -8,6 +8,12 @@ extern "C"
 
 #include <string>
 
+/*
+ * Deep copy of a SAI attribute, its list-typed values included. The value is
+ * kept serialized as well, for ordering and printing. Moves only swap the
+ * owned lists, so containers of wrappers relocate without copying; a copy
+ * deserializes the kept string once.
+ */
 class SaiAttrWrapper
 {
 public:
@@ -15,9 +21,9 @@ public:
 
     SaiAttrWrapper(sai_object_type_t objectType, const sai_attribute_t& attr);
     SaiAttrWrapper(const SaiAttrWrapper& other);
-    SaiAttrWrapper(SaiAttrWrapper&& other);
+    SaiAttrWrapper(SaiAttrWrapper&& other) noexcept;
     SaiAttrWrapper& operator=(const SaiAttrWrapper& other);
-    SaiAttrWrapper& operator=(SaiAttrWrapper&& other);
+    SaiAttrWrapper& operator=(SaiAttrWrapper&& other) noexcept;
     virtual ~SaiAttrWrapper();
 
     bool operator<(const SaiAttrWrapper& other) const;
@@ -32,7 +38,8 @@ private:
         sai_object_type_t objectType,
         const sai_attr_metadata_t& meta,
         const sai_attribute_t& attr);
-    void swap(SaiAttrWrapper&& other);
+    void deserialize();
+    void swap(SaiAttrWrapper&& other) noexcept;
 
     sai_object_type_t m_objectType {SAI_OBJECT_TYPE_NULL};
     const sai_attr_metadata_t* m_meta {nullptr};
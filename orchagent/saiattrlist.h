@@ -0,0 +1,97 @@
+#pragma once
+
+extern "C"
+{
+#include <sai.h>
+}
+
+#include <assert.h>
+#include <cstddef>
+#include <vector>
+
+/*
+ * Attribute array of one SAI call, a drop-in for std::vector<sai_attribute_t>
+ * in the call paths building one array per object.
+ *
+ * The first N attributes are kept in the object itself, usually on the stack
+ * of the caller, so building the array of a call doesn't allocate. Past N the
+ * attributes spill to a heap vector, still kept by clear() for the next use.
+ * As with the vector, the list-typed values are not copied, they point to the
+ * memory of their owner, which must outlive the SAI call or the bulker queueing
+ * of the array. data() is invalidated by push_back(), and the array can't be
+ * copied or moved since data() may point into it.
+ */
+template <size_t N = 8>
+class SaiAttrList
+{
+    static_assert(N > 0, "SaiAttrList needs an inline capacity");
+
+public:
+    SaiAttrList() = default;
+
+    SaiAttrList(const SaiAttrList&) = delete;
+    SaiAttrList& operator=(const SaiAttrList&) = delete;
+
+    void push_back(const sai_attribute_t &attr)
+    {
+        if (!m_spilled)
+        {
+            if (m_size < N)
+            {
+                m_inline[m_size++] = attr;
+                return;
+            }
+
+            m_heap.reserve(2 * N);
+            m_heap.assign(m_inline, m_inline + m_size);
+            m_spilled = true;
+            m_spills++;
+        }
+
+        m_heap.push_back(attr);
+        m_size++;
+    }
+
+    /* Appends only, pos must be end() */
+    template <typename It>
+    void insert(const sai_attribute_t *pos, It first, It last)
+    {
+        assert(pos == end());
+        (void)pos;
+        for (; first != last; ++first)
+        {
+            push_back(*first);
+        }
+    }
+
+    void clear()
+    {
+        m_heap.clear();
+        m_spilled = false;
+        m_size = 0;
+    }
+
+    sai_attribute_t *data() { return m_spilled ? m_heap.data() : m_inline; }
+    const sai_attribute_t *data() const { return m_spilled ? m_heap.data() : m_inline; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    sai_attribute_t &operator[](size_t i) { return data()[i]; }
+    const sai_attribute_t &operator[](size_t i) const { return data()[i]; }
+    sai_attribute_t &back() { return data()[m_size - 1]; }
+
+    sai_attribute_t *begin() { return data(); }
+    sai_attribute_t *end() { return data() + m_size; }
+    const sai_attribute_t *begin() const { return data(); }
+    const sai_attribute_t *end() const { return data() + m_size; }
+
+    /* Times the attributes outgrew the inline storage, for the tests */
+    size_t getSpills() const { return m_spills; }
+
+private:
+    sai_attribute_t m_inline[N];
+    std::vector<sai_attribute_t> m_heap;
+    size_t m_size = 0;
+    bool m_spilled = false;
+    size_t m_spills = 0;
+};
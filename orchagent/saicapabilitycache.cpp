@@ -0,0 +1,285 @@
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+#include "saicapabilitycache.h"
+#include "sai_serialize.h"
+#include "logger.h"
+
+using namespace std;
+using json = nlohmann::json;
+
+extern sai_object_id_t gSwitchId;
+
+SaiCapabilityCache &SaiCapabilityCache::instance()
+{
+    static SaiCapabilityCache cache;
+    return cache;
+}
+
+bool SaiCapabilityCache::isCacheable(sai_status_t status)
+{
+    return status == SAI_STATUS_SUCCESS ||
+           status == SAI_STATUS_NOT_SUPPORTED ||
+           status == SAI_STATUS_NOT_IMPLEMENTED ||
+           SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
+           SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status);
+}
+
+sai_status_t SaiCapabilityCache::queryAttributeCapability(sai_object_id_t switchId, sai_object_type_t objectType,
+                                                          sai_attr_id_t attrId, sai_attr_capability_t *capability)
+{
+    if (!capability)
+    {
+        return sai_query_attribute_capability(switchId, objectType, attrId, capability);
+    }
+
+    lock_guard<mutex> lock(m_mutex);
+
+    Key key(switchId, objectType, attrId);
+    auto it = m_attributes.find(key);
+    if (it != m_attributes.end())
+    {
+        *capability = it->second.capability;
+        return it->second.status;
+    }
+
+    auto status = sai_query_attribute_capability(switchId, objectType, attrId, capability);
+    if (isCacheable(status))
+    {
+        m_attributes[key] = { status, *capability };
+        m_dirty = true;
+    }
+
+    return status;
+}
+
+sai_status_t SaiCapabilityCache::queryAttributeEnumValuesCapability(sai_object_id_t switchId, sai_object_type_t objectType,
+                                                                    sai_attr_id_t attrId, sai_s32_list_t *enumValues)
+{
+    if (!enumValues)
+    {
+        return sai_query_attribute_enum_values_capability(switchId, objectType, attrId, enumValues);
+    }
+
+    lock_guard<mutex> lock(m_mutex);
+
+    Key key(switchId, objectType, attrId);
+    auto it = m_enumValues.find(key);
+    if (it != m_enumValues.end())
+    {
+        return copyEnumValues(it->second, enumValues);
+    }
+
+    // Sized after the metadata, a SAI which reports more values is asked again with its count
+    auto meta = sai_metadata_get_attr_metadata(objectType, attrId);
+    EnumValuesEntry entry;
+    entry.values.resize(meta && meta->enummetadata ? meta->enummetadata->valuescount : 0);
+
+    sai_s32_list_t list = { static_cast<uint32_t>(entry.values.size()), entry.values.data() };
+    entry.status = sai_query_attribute_enum_values_capability(switchId, objectType, attrId, &list);
+    if (entry.status == SAI_STATUS_BUFFER_OVERFLOW)
+    {
+        entry.values.resize(list.count);
+        list.list = entry.values.data();
+        entry.status = sai_query_attribute_enum_values_capability(switchId, objectType, attrId, &list);
+    }
+
+    if (!isCacheable(entry.status))
+    {
+        return entry.status;
+    }
+
+    entry.values.resize(entry.status == SAI_STATUS_SUCCESS ? list.count : 0);
+    m_dirty = true;
+
+    return copyEnumValues(m_enumValues.emplace(key, move(entry)).first->second, enumValues);
+}
+
+sai_status_t SaiCapabilityCache::copyEnumValues(const EnumValuesEntry &entry, sai_s32_list_t *enumValues)
+{
+    if (entry.status != SAI_STATUS_SUCCESS)
+    {
+        return entry.status;
+    }
+
+    auto count = static_cast<uint32_t>(entry.values.size());
+    if (!enumValues->list || enumValues->count < count)
+    {
+        enumValues->count = count;
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    copy(entry.values.begin(), entry.values.end(), enumValues->list);
+    enumValues->count = count;
+    return SAI_STATUS_SUCCESS;
+}
+
+void SaiCapabilityCache::clear()
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    m_attributes.clear();
+    m_enumValues.clear();
+    m_dirty = false;
+}
+
+string SaiCapabilityCache::platformSignature()
+{
+    sai_api_version_t version = 0;
+    if (sai_query_api_version(&version) != SAI_STATUS_SUCCESS)
+    {
+        return "";
+    }
+
+    const char *platform = getenv("platform");
+    return to_string(version) + "|" + (platform ? platform : "");
+}
+
+void SaiCapabilityCache::setPersistence(const string &path, const string &signature, bool restore)
+{
+    SWSS_LOG_ENTER();
+
+    lock_guard<mutex> lock(m_mutex);
+
+    m_path = signature.empty() ? "" : path;
+    m_signature = signature;
+
+    if (m_path.empty())
+    {
+        SWSS_LOG_NOTICE("SAI capabilities are not persisted, no SAI API version");
+        return;
+    }
+
+    // A cold start writes the results again, the SAI profile may have changed
+    if (!restore || !load())
+    {
+        m_dirty = true;
+    }
+}
+
+bool SaiCapabilityCache::load()
+{
+    SWSS_LOG_ENTER();
+
+    ifstream file(m_path);
+    if (!file.is_open())
+    {
+        SWSS_LOG_NOTICE("No SAI capabilities persisted at %s", m_path.c_str());
+        return false;
+    }
+
+    try
+    {
+        json cache = json::parse(file);
+        if (cache.at("signature").get<string>() != m_signature)
+        {
+            SWSS_LOG_NOTICE("SAI capabilities at %s were taken with another SAI or platform, ignored", m_path.c_str());
+            return false;
+        }
+
+        map<Key, AttributeEntry> attributeEntries;
+        map<Key, EnumValuesEntry> enumValuesEntries;
+
+        for (const auto &item : cache.at("attributes"))
+        {
+            AttributeEntry entry = {};
+            entry.status = item.at(2).get<sai_status_t>();
+            entry.capability.create_implemented = item.at(3).get<bool>();
+            entry.capability.set_implemented = item.at(4).get<bool>();
+            entry.capability.get_implemented = item.at(5).get<bool>();
+
+            Key key(gSwitchId, static_cast<sai_object_type_t>(item.at(0).get<int32_t>()), item.at(1).get<sai_attr_id_t>());
+            attributeEntries.emplace(key, entry);
+        }
+        for (const auto &item : cache.at("enum_values"))
+        {
+            EnumValuesEntry entry;
+            entry.status = item.at(2).get<sai_status_t>();
+            entry.values = item.at(3).get<vector<int32_t>>();
+
+            Key key(gSwitchId, static_cast<sai_object_type_t>(item.at(0).get<int32_t>()), item.at(1).get<sai_attr_id_t>());
+            enumValuesEntries.emplace(key, move(entry));
+        }
+
+        // Results queried before the restore are kept
+        m_attributes.insert(attributeEntries.begin(), attributeEntries.end());
+        m_enumValues.insert(enumValuesEntries.begin(), enumValuesEntries.end());
+
+        SWSS_LOG_NOTICE("Restored %zu SAI capabilities from %s", attributeEntries.size() + enumValuesEntries.size(), m_path.c_str());
+        return true;
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_ERROR("Failed to parse the SAI capabilities at %s: %s", m_path.c_str(), e.what());
+        return false;
+    }
+}
+
+bool SaiCapabilityCache::save()
+{
+    SWSS_LOG_ENTER();
+
+    lock_guard<mutex> lock(m_mutex);
+
+    if (m_path.empty() || !m_dirty)
+    {
+        return true;
+    }
+
+    json attributes = json::array();
+    for (const auto &it : m_attributes)
+    {
+        if (get<0>(it.first) != gSwitchId)
+        {
+            continue;
+        }
+
+        const auto &capability = it.second.capability;
+        attributes.push_back({ static_cast<int32_t>(get<1>(it.first)), get<2>(it.first), it.second.status,
+                               static_cast<bool>(capability.create_implemented),
+                               static_cast<bool>(capability.set_implemented),
+                               static_cast<bool>(capability.get_implemented) });
+    }
+
+    json enumValues = json::array();
+    for (const auto &it : m_enumValues)
+    {
+        if (get<0>(it.first) != gSwitchId)
+        {
+            continue;
+        }
+
+        enumValues.push_back({ static_cast<int32_t>(get<1>(it.first)), get<2>(it.first), it.second.status, it.second.values });
+    }
+
+    json cache = { { "signature", m_signature }, { "attributes", attributes }, { "enum_values", enumValues } };
+
+    // Written aside and renamed, a restart never finds a partial file
+    string tmp = m_path + ".tmp";
+    {
+        ofstream file(tmp);
+        file << cache.dump();
+        if (!file.good())
+        {
+            SWSS_LOG_ERROR("Failed to write the SAI capabilities to %s", tmp.c_str());
+            unlink(tmp.c_str());
+            return false;
+        }
+    }
+
+    if (rename(tmp.c_str(), m_path.c_str()) != 0)
+    {
+        SWSS_LOG_ERROR("Failed to write the SAI capabilities to %s", m_path.c_str());
+        unlink(tmp.c_str());
+        return false;
+    }
+
+    m_dirty = false;
+    SWSS_LOG_NOTICE("Persisted %zu SAI capabilities to %s", attributes.size() + enumValues.size(), m_path.c_str());
+    return true;
+}
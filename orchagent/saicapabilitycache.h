@@ -0,0 +1,94 @@
+#pragma once
+
+extern "C" {
+#include <sai.h>
+}
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/*
+ * Process wide cache of the SAI attribute capability queries.
+ *
+ * Orchs query the same capabilities at init, often once per port or table
+ * type, and with a remote syncd every query is a round trip. The results are
+ * kept by switch, object type and attribute, so each capability is asked to
+ * SAI once. Enum values are queried with the full list of the attribute
+ * metadata, the count probe callers do before sizing their list is answered
+ * from the cache as well. Only successes and definite "not supported" answers
+ * are kept, any other failure is queried again next time.
+ *
+ * The results of gSwitchId can be persisted to a file and restored on a warm
+ * restart. The file carries the SAI API version and platform it was taken
+ * with and is ignored if they changed.
+ */
+class SaiCapabilityCache
+{
+public:
+    static SaiCapabilityCache &instance();
+
+    sai_status_t queryAttributeCapability(sai_object_id_t switchId, sai_object_type_t objectType,
+                                          sai_attr_id_t attrId, sai_attr_capability_t *capability);
+    sai_status_t queryAttributeEnumValuesCapability(sai_object_id_t switchId, sai_object_type_t objectType,
+                                                    sai_attr_id_t attrId, sai_s32_list_t *enumValues);
+
+    /**
+     * @param path - file the results are persisted to
+     * @param signature - SAI API version and platform the results are valid for, empty disables persistence
+     * @param restore - load the results of path if they were taken with the same signature
+     */
+    void setPersistence(const std::string &path, const std::string &signature, bool restore);
+    /* Write the results to the persistence file if any were added since it was loaded or written */
+    bool save();
+
+    void clear();
+
+    /* SAI API version and platform of this process */
+    static std::string platformSignature();
+
+private:
+    using Key = std::tuple<sai_object_id_t, sai_object_type_t, sai_attr_id_t>;
+
+    struct AttributeEntry
+    {
+        sai_status_t status;
+        sai_attr_capability_t capability;
+    };
+
+    struct EnumValuesEntry
+    {
+        sai_status_t status;
+        std::vector<int32_t> values;
+    };
+
+    SaiCapabilityCache() = default;
+
+    static bool isCacheable(sai_status_t status);
+    static sai_status_t copyEnumValues(const EnumValuesEntry &entry, sai_s32_list_t *enumValues);
+
+    bool load();
+
+    std::mutex m_mutex;
+    std::map<Key, AttributeEntry> m_attributes;
+    std::map<Key, EnumValuesEntry> m_enumValues;
+
+    std::string m_path;
+    std::string m_signature;
+    bool m_dirty = false;
+};
+
+inline sai_status_t querySaiAttributeCapability(sai_object_id_t switchId, sai_object_type_t objectType,
+                                                sai_attr_id_t attrId, sai_attr_capability_t *capability)
+{
+    return SaiCapabilityCache::instance().queryAttributeCapability(switchId, objectType, attrId, capability);
+}
+
+inline sai_status_t querySaiAttributeEnumValuesCapability(sai_object_id_t switchId, sai_object_type_t objectType,
+                                                          sai_attr_id_t attrId, sai_s32_list_t *enumValues)
+{
+    return SaiCapabilityCache::instance().queryAttributeEnumValuesCapability(switchId, objectType, attrId, enumValues);
+}
@@ -831,11 +831,18 @@ void handleSaiFailure(sai_api_t api, string oper, sai_status_t status, bool abor
 
     string s_api = sai_serialize_api(api);
     string s_status = sai_serialize_status(status);
+    bool wasUnhealthy = gOrchUnhealthy;
     gOrchUnhealthy = true;
     gSaiErrorString = "Encountered failure in " + oper +
                       " operation, SAI API: " + s_api + ", status: " + s_status;
     SWSS_LOG_ERROR("%s", gSaiErrorString.c_str());
 
+    // Keep the operations leading to the first failure
+    if (!wasUnhealthy)
+    {
+        dumpFlightRecorders(gSaiErrorString);
+    }
+
     // Publish a structured syslog event
     event_params_t params = {
         { "operation", oper },
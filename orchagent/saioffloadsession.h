@@ -10,9 +10,12 @@
 #include <vector>
 #include <string>
 #include <tuple>
+#include <memory>
 #include <unordered_map>
 #include "portsorch.h"
 #include "vrforch.h"
+#include "bulker.h"
+#include "redispipeline.h"
 
 using namespace std;
 using namespace swss;
@@ -32,6 +35,7 @@ extern sai_object_id_t      gVirtualRouterId;
 extern PortsOrch*           gPortsOrch;
 extern sai_switch_api_t*    sai_switch_api;
 extern Directory<Orch*>     gDirectory;
+extern size_t               gMaxBulkSize;
 
 // saioffload handler types for BFD and ICMP
 template<typename T>
@@ -49,6 +53,10 @@ struct SaiOffloadHandlerTraits<sai_bfd_api_t>
     using get_session_stats_ext_fn = sai_get_bfd_session_stats_ext_fn;
     using clear_session_stats_fn = sai_clear_bfd_session_stats_fn;
     using notif_t = sai_bfd_session_state_notification_t;
+    using state_t = sai_bfd_session_state_t;
+
+    static create_session_fn get_create_session(api_t *api) { return api->create_bfd_session; }
+    static remove_session_fn get_remove_session(api_t *api) { return api->remove_bfd_session; }
 };
 
 template<>
@@ -63,6 +71,10 @@ struct SaiOffloadHandlerTraits<sai_icmp_echo_api_t>
     using get_session_stats_ext_fn = sai_get_icmp_echo_session_stats_ext_fn;
     using clear_session_stats_fn = sai_clear_icmp_echo_session_stats_fn;
     using notif_t = sai_icmp_echo_session_state_notification_t;
+    using state_t = sai_icmp_echo_session_state_t;
+
+    static create_session_fn get_create_session(api_t *api) { return api->create_icmp_echo_session; }
+    static remove_session_fn get_remove_session(api_t *api) { return api->remove_icmp_echo_session; }
 };
 
 /**
@@ -122,6 +134,21 @@ struct SaiOffloadSessionHandler {
      */
     SaiOffloadHandlerStatus create(const fv_vector_t& fv_data);
 
+    /**
+     *@method prepare
+     *
+     *@brief Build the SAI attributes of an offload session without creating it,
+     *       for a creation in bulk through SaiOffloadSessionTable
+     *
+     *@param fv_data(in)  session parameters as Field Value tuples
+     *
+     *@return SUCCESS_VALID_ENTRY session parameters valid, attributes built
+     *        FAILED_INVALID_ENTRY session parameters are invalid
+     *        FAILED_VALID_ENTRY attributes can't be built for valid key
+     *        RETRY_VALID_ENTRY retry session creation for valid key
+     */
+    SaiOffloadHandlerStatus prepare(const fv_vector_t& fv_data);
+
     /**
      *@method handle_hwlookup
      *
@@ -215,6 +242,17 @@ struct SaiOffloadSessionHandler {
         return m_session_id;
     }
 
+    /**
+     *@method get_attrs
+     *
+     *@brief Returns the SAI attributes built by prepare()
+     *
+     *@return reference to vector of SAI attributes
+     */
+    inline std::vector<sai_attribute_t>& get_attrs() {
+        return m_attrs;
+    }
+
 protected:
     SaiOffloadSessionHandler() = default;
 
@@ -255,6 +293,40 @@ SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::create
 {
     constexpr auto atype = static_cast<sai_api_t>(SaiOrchHandlerClass::SAI_API_TYPE::API_TYPE);
     constexpr auto& name = static_cast<SaiOrchHandlerClass *>(this)->m_name;
+
+    auto prepare_status = prepare(fv_data);
+    if (prepare_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
+    {
+        return prepare_status;
+    }
+
+    m_session_id = SAI_NULL_OBJECT_ID;
+    sai_status_t status = sai_create_session(&m_session_id, gSwitchId, (uint32_t)m_attrs.size(), m_attrs.data());
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("%s, SAI create offload session failed %s, rv:%d", name.c_str(), m_key.c_str(), status);
+        task_process_status handle_status = handleSaiCreateStatus(atype, status);
+        if (handle_status != task_success)
+        {
+            // check for retries
+            if (parseHandleSaiStatusFailure(handle_status))
+            {
+                return SaiOffloadHandlerStatus::FAILED_VALID_ENTRY;
+            }
+            else
+            {
+                return SaiOffloadHandlerStatus::RETRY_VALID_ENTRY;
+            }
+        }
+    }
+    return SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY;
+}
+
+template <class SaiOrchHandlerClass, typename T>
+SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::prepare(const fv_vector_t& fv_data)
+{
+    constexpr auto& name = static_cast<SaiOrchHandlerClass *>(this)->m_name;
     auto& handler_map = static_cast<SaiOrchHandlerClass *>(this)->m_handler_map;
 
     m_data = fv_data;
@@ -296,6 +368,7 @@ SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::create
 
     // for the sai attribute vector for create
     sai_attribute_t attr;
+    m_attrs.clear();
     for (auto it = m_attr_val_map.begin(); it != m_attr_val_map.end(); it++)
     {
         attr.id = it->first;
@@ -303,26 +376,6 @@ SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::create
         m_attrs.emplace_back(attr);
     }
 
-    m_session_id = SAI_NULL_OBJECT_ID;
-    sai_status_t status = sai_create_session(&m_session_id, gSwitchId, (uint32_t)m_attrs.size(), m_attrs.data());
-
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("%s, SAI create offload session failed %s, rv:%d", name.c_str(), m_key.c_str(), status);
-        task_process_status handle_status = handleSaiCreateStatus(atype, status);
-        if (handle_status != task_success)
-        {
-            // check for retries
-            if (parseHandleSaiStatusFailure(handle_status))
-            {
-                return SaiOffloadHandlerStatus::FAILED_VALID_ENTRY;
-            }
-            else
-            {
-                return SaiOffloadHandlerStatus::RETRY_VALID_ENTRY;
-            }
-        }
-    }
     return SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY;
 }
 
@@ -575,4 +628,358 @@ bool SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::register_state_change_not
     return true;
 }
 
+/**
+ *@class SaiOffloadSessionTable
+ *
+ *@brief Offload sessions of one type, shared by the orchs offloading them
+ *
+ *       The sessions are kept in compact arrays indexed by key and by SAI
+ *       object id. Creations and removals are queued and applied with one
+ *       bulk SAI call per flush, falling back to single calls when the
+ *       vendor has no bulk support. State notifications are coalesced per
+ *       session, and every STATE_DB write goes through a pipeline flushed
+ *       by flush_state_db().
+ */
+template <typename T>
+class SaiOffloadSessionTable {
+public:
+    using Tapis = SaiOffloadHandlerTraits<T>;
+    using state_t = typename Tapis::state_t;
+    using state_update_t = std::pair<sai_object_id_t, state_t>;
+
+    /**
+     *@method SaiOffloadSessionTable
+     *
+     *@brief class constructor
+     *
+     *@param api(in)          SAI API function pointers
+     *       name(in)         name used in logs
+     *       state_db(in)     STATE_DB connector
+     *       table_name(in)   STATE_DB session table name
+     *       state_fname(in)  STATE_DB field of the session state
+     *       state_names(in)  map of session state to its STATE_DB string
+     *       init_state(in)   state of a session until its first notification
+     */
+    SaiOffloadSessionTable(typename Tapis::api_t *api, const std::string &name,
+            swss::DBConnector *state_db, const std::string &table_name,
+            const std::string &state_fname, const std::map<state_t, std::string> &state_names,
+            state_t init_state) :
+        m_api(api),
+        m_name(name),
+        m_bulker(api, gSwitchId, gMaxBulkSize),
+        m_state_pipeline(new swss::RedisPipeline(state_db)),
+        m_state_table(m_state_pipeline.get(), table_name, true),
+        m_state_fname(state_fname),
+        m_state_names(state_names),
+        m_init_state(init_state)
+    {
+    }
+
+    inline bool exists(const std::string &key) const {
+        return m_key_index.find(key) != m_key_index.end();
+    }
+
+    inline size_t size() const {
+        return m_ids.size();
+    }
+
+    inline size_t pending_creates() const {
+        return m_creates.size();
+    }
+
+    inline size_t pending_removes() const {
+        return m_removes.size();
+    }
+
+    inline sai_object_id_t get_session_id(const std::string &key) const {
+        return m_ids[m_key_index.at(key)];
+    }
+
+    inline const fv_map_t& get_fv_map(const std::string &key) const {
+        return m_fv_maps[m_key_index.at(key)];
+    }
+
+    inline void set_fv_map(const std::string &key, const fv_map_t &fv_map) {
+        m_fv_maps[m_key_index.at(key)] = fv_map;
+    }
+
+    inline swss::Table& get_state_table() {
+        return m_state_table;
+    }
+
+    /**
+     *@method queue_create
+     *
+     *@brief Queue the creation of a session until flush_creates()
+     *
+     *@param key(in)           session key
+     *       state_db_key(in)  STATE_DB key of the session
+     *       attrs(in)         SAI attributes of the session
+     *       fv_vector(in)     STATE_DB fields of the session
+     *       fv_map(in)        session parameters cached for updates
+     */
+    void queue_create(const std::string &key, const std::string &state_db_key,
+            const std::vector<sai_attribute_t> &attrs, const fv_vector_t &fv_vector, const fv_map_t &fv_map)
+    {
+        m_creates.push_back({key, state_db_key, attrs, fv_vector, fv_map});
+    }
+
+    /**
+     *@method queue_remove
+     *
+     *@brief Queue the removal of an existing session until flush_removes()
+     *
+     *@param key(in)  session key
+     */
+    void queue_remove(const std::string &key)
+    {
+        m_removes.push_back(key);
+    }
+
+    /**
+     *@method flush_creates
+     *
+     *@brief Create the queued sessions, the created ones are added and
+     *       published to STATE_DB
+     *
+     *@param statuses(out)  SAI status of each queued creation, in queue order
+     */
+    void flush_creates(std::vector<sai_status_t> &statuses)
+    {
+        SWSS_LOG_ENTER();
+
+        std::vector<sai_object_id_t> ids(m_creates.size(), SAI_NULL_OBJECT_ID);
+        statuses.assign(m_creates.size(), SAI_STATUS_NOT_EXECUTED);
+
+        for (size_t i = 0; i < m_creates.size(); i++)
+        {
+            auto &attrs = m_creates[i].attrs;
+            m_bulker.create_entry(&ids[i], &statuses[i], (uint32_t)attrs.size(), attrs.data());
+        }
+        m_bulker.flush();
+
+        auto create_session = Tapis::get_create_session(m_api);
+        for (size_t i = 0; i < m_creates.size(); i++)
+        {
+            auto &create = m_creates[i];
+            if (is_bulk_unsupported(statuses[i]))
+            {
+                statuses[i] = create_session(&ids[i], gSwitchId, (uint32_t)create.attrs.size(), create.attrs.data());
+            }
+
+            if (statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("%s, SAI create offload session failed %s, rv:%d", m_name.c_str(),
+                        create.key.c_str(), statuses[i]);
+                continue;
+            }
+
+            add(create, ids[i]);
+        }
+
+        m_creates.clear();
+    }
+
+    /**
+     *@method flush_removes
+     *
+     *@brief Remove the queued sessions, the removed ones are dropped and
+     *       deleted from STATE_DB
+     *
+     *@param statuses(out)  SAI status of each queued removal, in queue order
+     */
+    void flush_removes(std::vector<sai_status_t> &statuses)
+    {
+        SWSS_LOG_ENTER();
+
+        statuses.assign(m_removes.size(), SAI_STATUS_NOT_EXECUTED);
+
+        for (size_t i = 0; i < m_removes.size(); i++)
+        {
+            m_bulker.remove_entry(&statuses[i], get_session_id(m_removes[i]));
+        }
+        m_bulker.flush();
+
+        auto remove_session = Tapis::get_remove_session(m_api);
+        for (size_t i = 0; i < m_removes.size(); i++)
+        {
+            const auto &key = m_removes[i];
+            if (is_bulk_unsupported(statuses[i]))
+            {
+                statuses[i] = remove_session(get_session_id(key));
+            }
+
+            if (statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("%s, Failed to remove offload session %s, rv:%d", m_name.c_str(),
+                        key.c_str(), statuses[i]);
+                continue;
+            }
+
+            erase(key);
+        }
+
+        m_removes.clear();
+    }
+
+    /**
+     *@method update_states
+     *
+     *@brief Apply the state notifications received since the last call
+     *
+     *       Only the last state of a session is kept. It is written to
+     *       STATE_DB if it differs from the session state, or if it is the
+     *       first notification of the session.
+     *
+     *@param updates(in)  session ids and states, in notification order
+     *
+     *@return number of sessions whose state was written
+     */
+    size_t update_states(const std::vector<state_update_t> &updates)
+    {
+        SWSS_LOG_ENTER();
+
+        std::vector<size_t> order;
+        std::unordered_map<sai_object_id_t, size_t> last;
+
+        for (size_t i = 0; i < updates.size(); i++)
+        {
+            auto found = last.find(updates[i].first);
+            if (found == last.end())
+            {
+                last.emplace(updates[i].first, i);
+                order.push_back(i);
+            }
+            else
+            {
+                found->second = i;
+            }
+        }
+
+        size_t written = 0;
+        for (auto i : order)
+        {
+            auto id = updates[i].first;
+            auto state = updates[last[id]].second;
+
+            auto index = m_id_index.find(id);
+            if (index == m_id_index.end())
+            {
+                SWSS_LOG_INFO("%s, session id:%" PRIx64 " missing for state %s", m_name.c_str(), id,
+                        m_state_names.at(state).c_str());
+                continue;
+            }
+
+            auto n = index->second;
+            if (state == m_states[n] && m_published[n])
+            {
+                continue;
+            }
+
+            m_state_table.hset(m_state_db_keys[n], m_state_fname, m_state_names.at(state));
+
+            SWSS_LOG_NOTICE("%s, session state for %s changed from %s to %s", m_name.c_str(),
+                    m_state_db_keys[n].c_str(), m_state_names.at(m_states[n]).c_str(),
+                    m_state_names.at(state).c_str());
+
+            m_states[n] = state;
+            m_published[n] = true;
+            written++;
+        }
+
+        return written;
+    }
+
+    /**
+     *@method flush_state_db
+     *
+     *@brief Flush the STATE_DB writes of the sessions
+     */
+    void flush_state_db()
+    {
+        m_state_pipeline->flush();
+    }
+
+private:
+    struct SessionCreate {
+        std::string key;
+        std::string state_db_key;
+        std::vector<sai_attribute_t> attrs;
+        fv_vector_t fv_vector;
+        fv_map_t fv_map;
+    };
+
+    void add(const SessionCreate &create, sai_object_id_t id)
+    {
+        auto n = m_ids.size();
+
+        m_keys.push_back(create.key);
+        m_state_db_keys.push_back(create.state_db_key);
+        m_ids.push_back(id);
+        m_states.push_back(m_init_state);
+        m_published.push_back(false);
+        m_fv_maps.push_back(create.fv_map);
+
+        m_key_index[create.key] = n;
+        m_id_index[id] = n;
+
+        m_state_table.set(create.state_db_key, create.fv_vector);
+    }
+
+    void erase(const std::string &key)
+    {
+        auto n = m_key_index.at(key);
+        auto last = m_ids.size() - 1;
+
+        m_state_table.del(m_state_db_keys[n]);
+        m_key_index.erase(key);
+        m_id_index.erase(m_ids[n]);
+
+        // The last session takes the place of the removed one
+        if (n != last)
+        {
+            m_keys[n] = std::move(m_keys[last]);
+            m_state_db_keys[n] = std::move(m_state_db_keys[last]);
+            m_ids[n] = m_ids[last];
+            m_states[n] = m_states[last];
+            m_published[n] = m_published[last];
+            m_fv_maps[n] = std::move(m_fv_maps[last]);
+
+            m_key_index[m_keys[n]] = n;
+            m_id_index[m_ids[n]] = n;
+        }
+
+        m_keys.pop_back();
+        m_state_db_keys.pop_back();
+        m_ids.pop_back();
+        m_states.pop_back();
+        m_published.pop_back();
+        m_fv_maps.pop_back();
+    }
+
+    typename Tapis::api_t *m_api;
+    std::string m_name;
+    ObjectBulker<T> m_bulker;
+
+    std::unique_ptr<swss::RedisPipeline> m_state_pipeline;
+    swss::Table m_state_table;
+    std::string m_state_fname;
+    std::map<state_t, std::string> m_state_names;
+    state_t m_init_state;
+
+    // per session arrays, a session has the same index in each
+    std::vector<std::string> m_keys;
+    std::vector<std::string> m_state_db_keys;
+    std::vector<sai_object_id_t> m_ids;
+    std::vector<state_t> m_states;
+    std::vector<bool> m_published;
+    std::vector<fv_map_t> m_fv_maps;
+
+    std::unordered_map<std::string, size_t> m_key_index;
+    std::unordered_map<sai_object_id_t, size_t> m_id_index;
+
+    std::vector<SessionCreate> m_creates;
+    std::vector<std::string> m_removes;
+};
+
 #endif
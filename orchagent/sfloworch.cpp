@@ -9,9 +9,11 @@ extern sai_samplepacket_api_t* sai_samplepacket_api;
 extern sai_port_api_t*         sai_port_api;
 extern sai_object_id_t         gSwitchId;
 extern PortsOrch*              gPortsOrch;
+extern size_t                  gMaxBulkSize;
 
 SflowOrch::SflowOrch(DBConnector* db, vector<string> &tableNames) :
-    Orch(db, tableNames)
+    Orch(db, tableNames),
+    m_portBulker(sai_port_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
     m_sflowStatus = false;
@@ -60,199 +62,115 @@ bool SflowOrch::sflowDestroySession(SflowSession &session)
     return true;
 }
 
-bool SflowOrch::sflowUpdateRate(sai_object_id_t port_id, uint32_t rate)
+/* Session the port samples direction dir with, SAI_NULL_OBJECT_ID if it does not */
+static sai_object_id_t sflowPortSample(const SflowPortInfo *info, const string &dir)
 {
-    auto         port_info = m_sflowPortInfoMap.find(port_id);
-    auto         session = m_sflowRateSampleMap.find(rate);
-    SflowSession new_session;
-    uint32_t     old_rate = sflowSessionGetRate(port_info->second.m_sample_id);
-
-    if (session == m_sflowRateSampleMap.end())
-    {
-        if (!sflowCreateSession(rate, new_session))
-        {
-            SWSS_LOG_ERROR("Creating sflow session with rate %d failed", rate);
-            return false;
-        }
-        m_sflowRateSampleMap[rate] = new_session;
-    }
-    else
+    if (!info || !info->admin_state)
     {
-        new_session = session->second;
+        return SAI_NULL_OBJECT_ID;
     }
 
-    if (port_info->second.admin_state)
-    {
-        if (!sflowAddPort(new_session.m_sample_id, port_id, port_info->second.m_sample_dir))
-        {
-            return false;
-        }
-    }
-    port_info->second.m_sample_id = new_session.m_sample_id;
-
-    m_sflowRateSampleMap[rate].ref_count++;
-    m_sflowRateSampleMap[old_rate].ref_count--;
-    if (m_sflowRateSampleMap[old_rate].ref_count == 0)
-    {
-        if (!sflowDestroySession(m_sflowRateSampleMap[old_rate]))
-        {
-            SWSS_LOG_ERROR("Failed to clean old session %" PRIx64 " with rate %d",
-                           m_sflowRateSampleMap[old_rate].m_sample_id, old_rate);
-        }
-        else
-        {
-            m_sflowRateSampleMap.erase(old_rate);
-        }
-    }
-    return true;
+    return (info->m_sample_dir == "both" || info->m_sample_dir == dir) ? info->m_sample_id : SAI_NULL_OBJECT_ID;
 }
 
-bool SflowOrch::sflowAddPort(sai_object_id_t sample_id, sai_object_id_t port_id, string direction)
+/* Queue the sample packet attributes which differ between old_info and the update */
+void SflowOrch::sflowQueuePortUpdate(SflowPortUpdate &update, const SflowPortInfo *old_info)
 {
-    sai_attribute_t attr;
-    sai_status_t    sai_rc;
+    const sai_attr_id_t attr_ids[] = { SAI_PORT_ATTR_INGRESS_SAMPLEPACKET_ENABLE, SAI_PORT_ATTR_EGRESS_SAMPLEPACKET_ENABLE };
+    const string dirs[] = { "rx", "tx" };
 
-    SWSS_LOG_DEBUG("sflowAddPort  %" PRIx64 " portOid %" PRIx64 " dir %s",
-                           sample_id, port_id, direction.c_str());
+    SWSS_LOG_DEBUG("sflowQueuePortUpdate portOid %" PRIx64 " remove %d sample %" PRIx64 " dir %s",
+                   update.port_id, (unsigned int)update.remove, update.info.m_sample_id, update.info.m_sample_dir.c_str());
 
-    if (direction == "both" || direction == "rx")
+    update.attr_count = 0;
+    for (size_t i = 0; i < 2; i++)
     {
-        attr.id = SAI_PORT_ATTR_INGRESS_SAMPLEPACKET_ENABLE;
-        attr.value.oid = sample_id;
-        sai_rc = sai_port_api->set_port_attribute(port_id, &attr);
-
-        if (sai_rc != SAI_STATUS_SUCCESS)
+        sai_object_id_t old_sample_id = sflowPortSample(old_info, dirs[i]);
+        sai_object_id_t new_sample_id = update.remove ? SAI_NULL_OBJECT_ID : sflowPortSample(&update.info, dirs[i]);
+        if (old_sample_id == new_sample_id)
         {
-            SWSS_LOG_ERROR("Failed to set session %" PRIx64 " on port %" PRIx64, sample_id, port_id);
-            task_process_status handle_status = handleSaiSetStatus(SAI_API_PORT, sai_rc);
-            if (handle_status != task_success)
-            {
-                return parseHandleSaiStatusFailure(handle_status);
-            }
+            continue;
         }
-    }
-
-    if (direction == "both" || direction == "tx")
-    {
-        attr.id = SAI_PORT_ATTR_EGRESS_SAMPLEPACKET_ENABLE;
-        attr.value.oid = sample_id;
-        sai_rc = sai_port_api->set_port_attribute(port_id, &attr);
 
-        if (sai_rc != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to set session %" PRIx64 " on port %" PRIx64, sample_id, port_id);
-            task_process_status handle_status = handleSaiSetStatus(SAI_API_PORT, sai_rc);
-            if (handle_status != task_success)
-            {
-                return parseHandleSaiStatusFailure(handle_status);
-            }
-        }
+        auto &attr = update.attrs[update.attr_count];
+        attr.id = attr_ids[i];
+        attr.value.oid = new_sample_id;
+        m_portBulker.set_entry_attribute(&update.statuses[update.attr_count], update.port_id, &attr);
+        update.attr_count++;
     }
-    return true;
 }
 
-bool SflowOrch::sflowDelPort(sai_object_id_t port_id, string direction)
+void SflowOrch::sflowApplyPortUpdates(Consumer &consumer, deque<SflowPortUpdate> &updates)
 {
-    sai_attribute_t attr;
-    sai_status_t    sai_rc;
+    SWSS_LOG_ENTER();
 
-    SWSS_LOG_DEBUG("sflowDelPort  portOid %" PRIx64 " dir %s",
-                           port_id, direction.c_str());
+    m_portBulker.flush();
 
-    if (direction == "both" || direction == "rx")
+    for (auto &update : updates)
     {
-        attr.id = SAI_PORT_ATTR_INGRESS_SAMPLEPACKET_ENABLE;
-        attr.value.oid = SAI_NULL_OBJECT_ID;
-        sai_rc = sai_port_api->set_port_attribute(port_id, &attr);
-
-        if (sai_rc != SAI_STATUS_SUCCESS)
+        bool retry = false;
+        for (uint32_t i = 0; i < update.attr_count; i++)
         {
-            SWSS_LOG_ERROR("Failed to delete session on port %" PRIx64, port_id);
-            task_process_status handle_status = handleSaiSetStatus(SAI_API_PORT, sai_rc);
-            if (handle_status != task_success)
+            sai_status_t sai_rc = update.statuses[i];
+            if (is_bulk_unsupported(sai_rc))
+            {
+                sai_rc = sai_port_api->set_port_attribute(update.port_id, &update.attrs[i]);
+            }
+
+            if (sai_rc != SAI_STATUS_SUCCESS)
             {
-                return parseHandleSaiStatusFailure(handle_status);
+                SWSS_LOG_ERROR("Failed to set session %" PRIx64 " on port %" PRIx64,
+                               update.attrs[i].value.oid, update.port_id);
+                task_process_status handle_status = handleSaiSetStatus(SAI_API_PORT, sai_rc);
+                if (handle_status != task_success && !parseHandleSaiStatusFailure(handle_status))
+                {
+                    retry = true;
+                }
             }
         }
-    }
 
-    if (direction == "both" || direction == "tx")
-    {
-        attr.id = SAI_PORT_ATTR_EGRESS_SAMPLEPACKET_ENABLE;
-        attr.value.oid = SAI_NULL_OBJECT_ID;
-        sai_rc = sai_port_api->set_port_attribute(port_id, &attr);
+        if (retry)
+        {
+            continue;
+        }
 
-        if (sai_rc != SAI_STATUS_SUCCESS)
+        auto port_info = m_sflowPortInfoMap.find(update.port_id);
+        if (port_info != m_sflowPortInfoMap.end())
         {
-            SWSS_LOG_ERROR("Failed to delete session on port %" PRIx64, port_id);
-            task_process_status handle_status = handleSaiSetStatus(SAI_API_PORT, sai_rc);
-            if (handle_status != task_success)
+            m_sflowRateSampleMap[sflowSessionGetRate(port_info->second.m_sample_id)].ref_count--;
+            if (update.remove)
             {
-                return parseHandleSaiStatusFailure(handle_status);
+                m_sflowPortInfoMap.erase(port_info);
             }
         }
-    }
-    return true;
-}
-
-bool SflowOrch::sflowUpdateSampleDirection(sai_object_id_t port_id, string old_dir, string new_dir)
-{
-    sai_object_id_t ing_sample_oid = SAI_NULL_OBJECT_ID;
-    sai_object_id_t egr_sample_oid = SAI_NULL_OBJECT_ID;
-    sai_attribute_t attr;
-    sai_status_t    sai_rc;
-    auto            port_info = m_sflowPortInfoMap.find(port_id);
-
-    SWSS_LOG_DEBUG("sflowUpdateSampleDirection  portOid %" PRIx64 " old dir %s new dir %s",
-                           port_id, old_dir.c_str(), new_dir.c_str());
-
-    if ((new_dir == "tx") && (old_dir == "rx" || old_dir == "both"))
-    {
-        ing_sample_oid = SAI_NULL_OBJECT_ID;
-        egr_sample_oid = port_info->second.m_sample_id;
-    }
-
-    if ((new_dir == "rx") && (old_dir == "tx" || old_dir == "both"))
-    {
-        ing_sample_oid = port_info->second.m_sample_id;
-        egr_sample_oid = SAI_NULL_OBJECT_ID;
-    }
-
-    if ((new_dir == "both") && (old_dir == "tx" || old_dir == "rx"))
-    {
-        ing_sample_oid = port_info->second.m_sample_id;
-        egr_sample_oid = port_info->second.m_sample_id;
-    }
-
-    attr.id = SAI_PORT_ATTR_INGRESS_SAMPLEPACKET_ENABLE;
-    attr.value.oid = ing_sample_oid;
-    sai_rc = sai_port_api->set_port_attribute(port_id, &attr);
-
-    if (sai_rc != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to Ingress session on port %" PRIx64, port_id);
-        task_process_status handle_status = handleSaiSetStatus(SAI_API_PORT, sai_rc);
-        if (handle_status != task_success)
+        if (!update.remove)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            m_sflowRateSampleMap[sflowSessionGetRate(update.info.m_sample_id)].ref_count++;
+            m_sflowPortInfoMap[update.port_id] = update.info;
         }
-    }
 
-    attr.id = SAI_PORT_ATTR_EGRESS_SAMPLEPACKET_ENABLE;
-    attr.value.oid = egr_sample_oid;
-    sai_rc = sai_port_api->set_port_attribute(port_id, &attr);
+        consumer.m_toSync.erase(update.task);
+    }
+    updates.clear();
 
-    if (sai_rc != SAI_STATUS_SUCCESS)
+    // Sessions are removed once no port is left on them, after the ports moved to their new rate
+    auto session = m_sflowRateSampleMap.begin();
+    while (session != m_sflowRateSampleMap.end())
     {
-        SWSS_LOG_ERROR("Failed to Update Egress session on port %" PRIx64, port_id);
-        task_process_status handle_status = handleSaiSetStatus(SAI_API_PORT, sai_rc);
-        if (handle_status != task_success)
+        if (session->second.ref_count == 0)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            if (!sflowDestroySession(session->second))
+            {
+                SWSS_LOG_ERROR("Failed to clean old session %" PRIx64 " with rate %d",
+                               session->second.m_sample_id, session->first);
+                session++;
+                continue;
+            }
+            session = m_sflowRateSampleMap.erase(session);
+            continue;
         }
+        session++;
     }
-
-    return true;
 }
 
 void SflowOrch::sflowExtractInfo(vector<FieldValueTuple> &fvs, bool &admin, uint32_t &rate, string &dir)
@@ -326,36 +244,6 @@ uint32_t SflowOrch::sflowSessionGetRate(sai_object_id_t m_sample_id)
     return 0;
 }
 
-bool SflowOrch::handleSflowSessionDel(sai_object_id_t port_id)
-{
-    auto sflowInfo = m_sflowPortInfoMap.find(port_id);
-
-    if (sflowInfo != m_sflowPortInfoMap.end())
-    {
-        uint32_t rate = sflowSessionGetRate(sflowInfo->second.m_sample_id);
-        if (sflowInfo->second.admin_state)
-        {
-            if (!sflowDelPort(port_id, sflowInfo->second.m_sample_dir))
-            {
-                return false;
-            }
-            sflowInfo->second.admin_state = false;
-        }
-
-        m_sflowPortInfoMap.erase(port_id);
-        m_sflowRateSampleMap[rate].ref_count--;
-        if (m_sflowRateSampleMap[rate].ref_count == 0)
-        {
-            if (!sflowDestroySession(m_sflowRateSampleMap[rate]))
-            {
-                return false;
-            }
-            m_sflowRateSampleMap.erase(rate);
-        }
-    }
-    return true;
-}
-
 void SflowOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
@@ -372,6 +260,10 @@ void SflowOrch::doTask(Consumer &consumer)
         return;
     }
 
+    // Ports changed in this round have their sample packet attributes set in bulk
+    deque<SflowPortUpdate> updates;
+    set<sai_object_id_t> updated_ports;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -380,6 +272,21 @@ void SflowOrch::doTask(Consumer &consumer)
         string alias = kfvKey(tuple);
 
         gPortsOrch->getPort(alias, port);
+
+        // A port changed twice in a round is set in order
+        if (updated_ports.count(port.m_port_id))
+        {
+            sflowApplyPortUpdates(consumer, updates);
+            updated_ports.clear();
+        }
+
+        auto sflowInfo = m_sflowPortInfoMap.find(port.m_port_id);
+        const SflowPortInfo *old_info = sflowInfo != m_sflowPortInfoMap.end() ? &sflowInfo->second : nullptr;
+
+        SflowPortUpdate update = {};
+        update.task = it;
+        update.port_id = port.m_port_id;
+
         if (op == SET_COMMAND)
         {
             bool      admin_state = m_sflowStatus;
@@ -388,113 +295,68 @@ void SflowOrch::doTask(Consumer &consumer)
 
             if (!m_sflowStatus)
             {
-                return;
+                break;
             }
-            auto sflowInfo = m_sflowPortInfoMap.find(port.m_port_id);
-            if (sflowInfo != m_sflowPortInfoMap.end())
+            if (old_info)
             {
-                rate = sflowSessionGetRate(sflowInfo->second.m_sample_id);
-                admin_state = sflowInfo->second.admin_state;
+                rate = sflowSessionGetRate(old_info->m_sample_id);
+                admin_state = old_info->admin_state;
             }
 
-            SWSS_LOG_DEBUG(" Existing Cfg portOid %" PRIx64 " admin %d rate %d dir %s", 
-                            port.m_port_id, (unsigned int)admin_state, rate, 
-                            sflowInfo->second.m_sample_dir.c_str());
+            SWSS_LOG_DEBUG(" Existing Cfg portOid %" PRIx64 " admin %d rate %d dir %s",
+                            port.m_port_id, (unsigned int)admin_state, rate,
+                            old_info ? old_info->m_sample_dir.c_str() : "");
 
             sflowExtractInfo(kfvFieldsValues(tuple), admin_state, rate, dir);
 
-            SWSS_LOG_DEBUG("New Cfg  portOid %" PRIx64 " admin %d rate %d dir %s", 
+            SWSS_LOG_DEBUG("New Cfg  portOid %" PRIx64 " admin %d rate %d dir %s",
                             port.m_port_id, (unsigned int)admin_state, rate, dir.c_str());
 
-            if (sflowInfo == m_sflowPortInfoMap.end())
+            if (!old_info && rate == 0)
+            {
+                it++;
+                continue;
+            }
+
+            // Ports sampling at the same rate share one session
+            auto session = m_sflowRateSampleMap.find(rate);
+            if (session == m_sflowRateSampleMap.end())
             {
-                if (rate == 0)
+                SflowSession new_session;
+                if (!sflowCreateSession(rate, new_session))
                 {
+                    SWSS_LOG_ERROR("Creating sflow session with rate %d failed", rate);
                     it++;
                     continue;
                 }
-
-                SflowPortInfo port_info;
-                auto          session_info = m_sflowRateSampleMap.find(rate);
-                if (session_info != m_sflowRateSampleMap.end())
-                {
-                    port_info.m_sample_id = session_info->second.m_sample_id;
-                }
-                else
-                {
-                    SflowSession  session;
-                    if (!sflowCreateSession(rate, session))
-                    {
-                        it++;
-                        continue;
-                    }
-                    m_sflowRateSampleMap[rate] = session;
-                    port_info.m_sample_id = session.m_sample_id;
-                }
-                port_info.m_sample_dir = dir;
-
-                if (admin_state)
-                {
-                    if (!sflowAddPort(port_info.m_sample_id, port.m_port_id, port_info.m_sample_dir))
-                    {
-                        it++;
-                        continue;
-                    }
-                }
-                port_info.admin_state = admin_state;
-                m_sflowPortInfoMap[port.m_port_id] = port_info;
-                m_sflowRateSampleMap[rate].ref_count++;
+                session = m_sflowRateSampleMap.emplace(rate, new_session).first;
             }
-            else
-            {
-                if (rate != sflowSessionGetRate(sflowInfo->second.m_sample_id))
-                {
-                    if (!sflowUpdateRate(port.m_port_id, rate))
-                    {
-                        it++;
-                        continue;
-                    }
-                }
-                if (admin_state != sflowInfo->second.admin_state)
-                {
-                    bool ret = false;
-                    if (admin_state)
-                    {
-                        ret = sflowAddPort(sflowInfo->second.m_sample_id, port.m_port_id,
-                                            sflowInfo->second.m_sample_dir);
-                    }
-                    else
-                    {
-                        ret = sflowDelPort(port.m_port_id, sflowInfo->second.m_sample_dir);
-                    }
-                    if (!ret)
-                    {
-                        it++;
-                        continue;
-                    }
-                    sflowInfo->second.admin_state = admin_state;
-                }
 
-                if (dir !=  sflowInfo->second.m_sample_dir)
-                {
-                    string old_dir = sflowInfo->second.m_sample_dir;
-                    if (!sflowUpdateSampleDirection(port.m_port_id, old_dir, dir))
-                    {
-                        it++;
-                        continue;
-                    }
-                    sflowInfo->second.m_sample_dir = dir;
-                }
-            }
+            update.remove = false;
+            update.info.admin_state = admin_state;
+            update.info.m_sample_dir = dir;
+            update.info.m_sample_id = session->second.m_sample_id;
         }
         else if (op == DEL_COMMAND)
         {
-            if (!handleSflowSessionDel(port.m_port_id))
+            if (!old_info)
             {
-                it++;
+                it = consumer.m_toSync.erase(it);
                 continue;
             }
+            update.remove = true;
         }
-        it = consumer.m_toSync.erase(it);
+        else
+        {
+            it = consumer.m_toSync.erase(it);
+            continue;
+        }
+
+        updates.push_back(update);
+        sflowQueuePortUpdate(updates.back(), old_info);
+        updated_ports.insert(port.m_port_id);
+        it++;
     }
+
+    sflowApplyPortUpdates(consumer, updates);
 }
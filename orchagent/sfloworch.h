@@ -1,11 +1,14 @@
 #pragma once
 
+#include <deque>
 #include <map>
+#include <set>
 #include <string>
 #include <inttypes.h>
 
 #include "orch.h"
 #include "portsorch.h"
+#include "bulker.h"
 
 struct SflowPortInfo
 {
@@ -20,6 +23,22 @@ struct SflowSession
     uint32_t        ref_count;
 };
 
+/*
+ * Change of one SFLOW_SESSION_TABLE entry. The sample packet attributes of all
+ * the changed ports are set in one bulk call, the port info and session
+ * references are updated once they are set.
+ */
+struct SflowPortUpdate
+{
+    SyncMap::iterator           task;
+    sai_object_id_t             port_id;
+    bool                        remove;
+    SflowPortInfo               info;
+    uint32_t                    attr_count;
+    sai_attribute_t             attrs[2];
+    sai_status_t                statuses[2];
+};
+
 /* SAI Port to Sflow Port Info Map */
 typedef std::map<sai_object_id_t, SflowPortInfo> SflowPortInfoMap;
 
@@ -36,15 +55,14 @@ private:
     SflowRateSampleMap  m_sflowRateSampleMap;
     bool                m_sflowStatus;
 
+    ObjectBulker<sai_port_api_t> m_portBulker;
+
     virtual void doTask(Consumer& consumer);
     bool sflowCreateSession(uint32_t rate, SflowSession &session);
     bool sflowDestroySession(SflowSession &session);
-    bool sflowAddPort(sai_object_id_t sample_id, sai_object_id_t port_id, string direction);
-    bool sflowDelPort(sai_object_id_t port_id, string direction);
+    void sflowQueuePortUpdate(SflowPortUpdate &update, const SflowPortInfo *old_info);
+    void sflowApplyPortUpdates(Consumer &consumer, std::deque<SflowPortUpdate> &updates);
     void sflowStatusSet(Consumer &consumer);
-    bool sflowUpdateRate(sai_object_id_t port_id, uint32_t rate);
-    bool sflowUpdateSampleDirection(sai_object_id_t port_id, string old_dir, string new_dir);
     uint32_t sflowSessionGetRate(sai_object_id_t sample_id);
-    bool handleSflowSessionDel(sai_object_id_t port_id);
     void sflowExtractInfo(std::vector<FieldValueTuple> &fvs, bool &admin, uint32_t &rate, string &dir);
 };
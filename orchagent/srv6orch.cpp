@@ -12,6 +12,7 @@
 #include "redisutility.h"
 #include "flex_counter_manager.h"
 #include "flow_counter_handler.h"
+#include "saicapabilitycache.h"
 
 using namespace std;
 using namespace swss;
@@ -30,6 +31,7 @@ extern sai_object_id_t gSwitchId;
 extern sai_object_id_t  gVirtualRouterId;
 extern sai_object_id_t  gUnderlayIfId;
 extern sai_srv6_api_t* sai_srv6_api;
+extern sai_counter_api_t* sai_counter_api;
 extern sai_tunnel_api_t* sai_tunnel_api;
 extern sai_next_hop_api_t* sai_next_hop_api;
 extern sai_router_interface_api_t* sai_router_intfs_api;
@@ -37,6 +39,7 @@ extern sai_router_interface_api_t* sai_router_intfs_api;
 extern RouteOrch *gRouteOrch;
 extern CrmOrch *gCrmOrch;
 extern bool gTraditionalFlexCounter;
+extern size_t gMaxBulkSize;
 
 const map<string, sai_my_sid_entry_endpoint_behavior_t> end_behavior_map =
 {
@@ -109,6 +112,9 @@ Srv6Orch::Srv6Orch(DBConnector *cfgDb, DBConnector *applDb, const vector<TableCo
 {
     m_neighOrch->attach(this);
 
+    m_sidListBulkSupported = sai_srv6_api->create_srv6_sidlists != nullptr;
+    m_mySidBulkSupported = sai_srv6_api->create_my_sid_entries != nullptr;
+
     initializeCounters();
 }
 
@@ -144,7 +150,7 @@ void Srv6Orch::initializeCounters()
 bool Srv6Orch::queryMySidCountersCapability() const
 {
     sai_attr_capability_t capability;
-    sai_status_t status = sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_MY_SID_ENTRY, SAI_MY_SID_ENTRY_ATTR_COUNTER_ID, &capability);
+    sai_status_t status = querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_MY_SID_ENTRY, SAI_MY_SID_ENTRY_ATTR_COUNTER_ID, &capability);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_WARN("Could not query SRv6 MySID entry attribute SAI_MY_SID_ENTRY_ATTR_COUNTER_ID %d", status);
@@ -265,22 +271,203 @@ void Srv6Orch::setCountersState(bool enable)
 
     SWSS_LOG_NOTICE("Setting SRv6 MySID counters state to %s", enable ? "enabled" : "disabled");
 
+    if (enable)
+    {
+        addMySidCounters();
+    } else {
+        removeMySidCounters();
+    }
+
+    m_mysid_counters_enabled = enable;
+}
+
+/*
+ * Counters of all the MySID entries, created with one bulk call and bound to
+ * their entries with another. COUNTERS_SRV6_NAME_MAP gets them with one HSET.
+ */
+void Srv6Orch::addMySidCounters()
+{
+    SWSS_LOG_ENTER();
+
+    vector<MySidEntry *> entries;
     for (auto& mysid : srv6_my_sid_table_)
     {
-        const auto& sai_entry = mysid.second.entry;
-        auto &counter_oid = mysid.second.counter;
+        if (mysid.second.counter == SAI_NULL_OBJECT_ID)
+        {
+            entries.push_back(&mysid.second);
+        }
+    }
+    if (entries.empty())
+    {
+        return;
+    }
+
+    sai_attribute_t counter_attr;
+    counter_attr.id = SAI_COUNTER_ATTR_TYPE;
+    counter_attr.value.s32 = SAI_COUNTER_TYPE_REGULAR;
+
+    vector<sai_object_id_t> counter_ids(entries.size(), SAI_NULL_OBJECT_ID);
+    vector<sai_status_t> statuses(entries.size(), SAI_STATUS_SUCCESS);
+    ObjectBulker<sai_counter_api_t> counter_bulker(sai_counter_api, gSwitchId, gMaxBulkSize);
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        counter_bulker.create_entry(&counter_ids[i], &statuses[i], 1, &counter_attr);
+    }
+    counter_bulker.flush();
 
-        if (enable)
+    // The entries are set one by one when the SAI has no bulk set for them
+    bool bulk_set = sai_srv6_api->set_my_sid_entries_attribute != nullptr;
+    EntityBulker<sai_srv6_api_t> entry_bulker(sai_srv6_api, gMaxBulkSize);
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (is_bulk_unsupported(statuses[i]))
+        {
+            statuses[i] = FlowCounterHandler::createGenericCounter(counter_ids[i]) ? SAI_STATUS_SUCCESS : SAI_STATUS_FAILURE;
+        }
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create SAI counter for SRv6 MySID entry");
+            counter_ids[i] = SAI_NULL_OBJECT_ID;
+            continue;
+        }
+
+        sai_attribute_t attr;
+        attr.id = SAI_MY_SID_ENTRY_ATTR_COUNTER_ID;
+        attr.value.oid = counter_ids[i];
+        if (bulk_set)
+        {
+            entry_bulker.set_entry_attribute(&statuses[i], &entries[i]->entry, &attr);
+        }
+        else
         {
-            addMySidCounter(sai_entry, counter_oid);
-            setMySidEntryCounter(sai_entry, counter_oid);
-        } else {
-            setMySidEntryCounter(sai_entry, SAI_NULL_OBJECT_ID);
-            removeMySidCounter(sai_entry, counter_oid);
+            statuses[i] = sai_srv6_api->set_my_sid_entry_attribute(&entries[i]->entry, &attr);
         }
     }
+    entry_bulker.flush();
 
-    m_mysid_counters_enabled = enable;
+    vector<FieldValueTuple> nameMapFvs;
+    auto was_empty = m_pending_counters.empty();
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        auto counter_oid = counter_ids[i];
+        if (counter_oid == SAI_NULL_OBJECT_ID)
+        {
+            continue;
+        }
+
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to set my_sid entry counter oid to %s, rc: %s", sai_serialize_object_id(counter_oid).c_str(), sai_serialize_status(statuses[i]).c_str());
+            FlowCounterHandler::removeGenericCounter(counter_oid);
+            continue;
+        }
+
+        auto key = getMySidCounterKey(entries[i]->entry);
+        entries[i]->counter = counter_oid;
+        nameMapFvs.emplace_back(key, sai_serialize_object_id(counter_oid));
+        m_pending_counters[counter_oid] = key;
+    }
+
+    if (!nameMapFvs.empty())
+    {
+        m_mysid_counters_table->set("", nameMapFvs);
+    }
+
+    if (was_empty && !m_pending_counters.empty())
+    {
+        m_counter_update_timer->start();
+    }
+}
+
+/*
+ * Counters of all the MySID entries, unbound from their entries and removed
+ * with one bulk call each. COUNTERS_SRV6_NAME_MAP goes with them, except for
+ * the counters the SAI failed to unbind, which stay with their entries.
+ */
+void Srv6Orch::removeMySidCounters()
+{
+    SWSS_LOG_ENTER();
+
+    vector<MySidEntry *> entries;
+    for (auto& mysid : srv6_my_sid_table_)
+    {
+        if (mysid.second.counter != SAI_NULL_OBJECT_ID)
+        {
+            entries.push_back(&mysid.second);
+        }
+    }
+
+    m_mysid_counters_table->del("");
+
+    if (entries.empty())
+    {
+        return;
+    }
+
+    vector<sai_status_t> statuses(entries.size(), SAI_STATUS_SUCCESS);
+    bool bulk_set = sai_srv6_api->set_my_sid_entries_attribute != nullptr;
+    EntityBulker<sai_srv6_api_t> entry_bulker(sai_srv6_api, gMaxBulkSize);
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        sai_attribute_t attr;
+        attr.id = SAI_MY_SID_ENTRY_ATTR_COUNTER_ID;
+        attr.value.oid = SAI_NULL_OBJECT_ID;
+        if (bulk_set)
+        {
+            entry_bulker.set_entry_attribute(&statuses[i], &entries[i]->entry, &attr);
+        }
+        else
+        {
+            statuses[i] = sai_srv6_api->set_my_sid_entry_attribute(&entries[i]->entry, &attr);
+        }
+    }
+    entry_bulker.flush();
+
+    // A counter still bound to its entry can't be removed, it is kept with its entry
+    vector<MySidEntry *> unbound;
+    vector<FieldValueTuple> nameMapFvs;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to set my_sid entry counter oid to %s, rc: %s", sai_serialize_object_id(SAI_NULL_OBJECT_ID).c_str(), sai_serialize_status(statuses[i]).c_str());
+            nameMapFvs.emplace_back(getMySidCounterKey(entries[i]->entry), sai_serialize_object_id(entries[i]->counter));
+            continue;
+        }
+        unbound.push_back(entries[i]);
+    }
+
+    if (!nameMapFvs.empty())
+    {
+        m_mysid_counters_table->set("", nameMapFvs);
+    }
+
+    statuses.assign(unbound.size(), SAI_STATUS_SUCCESS);
+    ObjectBulker<sai_counter_api_t> counter_bulker(sai_counter_api, gSwitchId, gMaxBulkSize);
+    for (size_t i = 0; i < unbound.size(); i++)
+    {
+        auto counter_oid = unbound[i]->counter;
+        if (m_pending_counters.erase(counter_oid) == 0)
+        {
+            m_counter_manager.clearCounterIdList(counter_oid);
+        }
+
+        counter_bulker.remove_entry(&statuses[i], counter_oid);
+    }
+    counter_bulker.flush();
+
+    for (size_t i = 0; i < unbound.size(); i++)
+    {
+        if (is_bulk_unsupported(statuses[i]))
+        {
+            FlowCounterHandler::removeGenericCounter(unbound[i]->counter);
+        }
+        else if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove generic counter: %s", sai_serialize_object_id(unbound[i]->counter).c_str());
+        }
+        unbound[i]->counter = SAI_NULL_OBJECT_ID;
+    }
 }
 
 void Srv6Orch::doTask(SelectableTimer &timer)
@@ -306,6 +493,9 @@ void Srv6Orch::doTask(SelectableTimer &timer)
         }
     }
 
+    // The counters registered above are sent to the flex counter group at once
+    m_counter_manager.flush();
+
     if (m_pending_counters.empty())
     {
         m_counter_update_timer->stop();
@@ -1055,7 +1245,8 @@ bool Srv6Orch::createUpdateSidList(const string sid_name, const string sid_list,
         return true;
     }
     SWSS_LOG_INFO("Segment count %d", segment_list.count);
-    segment_list.list = new sai_ip6_t[segment_list.count];
+    unique_ptr<sai_ip6_t[]> segments(new sai_ip6_t[segment_list.count]);
+    segment_list.list = segments.get();
     uint32_t index = 0;
 
     for (string ip_str : sid_ips)
@@ -1088,6 +1279,18 @@ bool Srv6Orch::createUpdateSidList(const string sid_name, const string sid_list,
             attr.value.s32 = sidlist_type_map.at(sidlist_type);
         }
         attributes.push_back(attr);
+
+        if (m_bulkMode && m_sidListBulkSupported)
+        {
+            m_sidListBulkOps.emplace_back();
+            auto &ctx = m_sidListBulkOps.back();
+            ctx.sid_name = sid_name;
+            ctx.segments = move(segments);
+            ctx.attrs = move(attributes);
+            m_bulkPendingKeys.insert(sid_name);
+            return true;
+        }
+
         status = sai_srv6_api->create_srv6_sidlist(&segment_oid, gSwitchId, (uint32_t) attributes.size(), attributes.data());
         if (status != SAI_STATUS_SUCCESS)
         {
@@ -1112,10 +1315,55 @@ bool Srv6Orch::createUpdateSidList(const string sid_name, const string sid_list,
             return false;
         }
     }
-    delete segment_list.list;
     return true;
 }
 
+void Srv6Orch::flushSidListBulk()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_sidListBulkOps.empty())
+    {
+        return;
+    }
+
+    ObjectBulker<sai_srv6_api_t> bulker(sai_srv6_api, gSwitchId, gMaxBulkSize);
+    bulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+    for (auto &ctx : m_sidListBulkOps)
+    {
+        bulker.create_entry(&ctx.oid, &ctx.status, (uint32_t)ctx.attrs.size(), ctx.attrs.data());
+    }
+    bulker.flush();
+
+    SWSS_LOG_INFO("Created %zu srv6 sidlists in bulk", m_sidListBulkOps.size());
+
+    for (auto &ctx : m_sidListBulkOps)
+    {
+        if (is_bulk_unsupported(ctx.status))
+        {
+            if (m_sidListBulkSupported)
+            {
+                SWSS_LOG_NOTICE("Bulk srv6 sidlist creation is not supported, rv:%d", ctx.status);
+                m_sidListBulkSupported = false;
+            }
+            ctx.status = sai_srv6_api->create_srv6_sidlist(&ctx.oid, gSwitchId, (uint32_t)ctx.attrs.size(), ctx.attrs.data());
+        }
+
+        if (ctx.status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create srv6 sidlist object %s, rv %d", ctx.sid_name.c_str(), ctx.status);
+            continue;
+        }
+        sid_table_[ctx.sid_name].sid_object_id = ctx.oid;
+    }
+
+    for (auto &ctx : m_sidListBulkOps)
+    {
+        m_bulkPendingKeys.erase(ctx.sid_name);
+    }
+    m_sidListBulkOps.clear();
+}
+
 task_process_status Srv6Orch::deleteSidList(const string sid_name)
 {
     SWSS_LOG_ENTER();
@@ -1603,6 +1851,21 @@ bool Srv6Orch::createUpdateMysidEntry(string my_sid_string, const string dt_vrf,
             attributes.push_back(attr);
         }
 
+        if (m_bulkMode && m_mySidBulkSupported)
+        {
+            m_mySidBulkOps.emplace_back();
+            auto &ctx = m_mySidBulkOps.back();
+            ctx.key_string = key_string;
+            ctx.entry = my_sid_entry;
+            ctx.end_behavior = end_behavior;
+            ctx.dt_vrf = vrf_update ? dt_vrf : "";
+            ctx.adj = nh_update ? adj : "";
+            ctx.counter = counter_oid;
+            ctx.attrs = move(attributes);
+            m_bulkPendingKeys.insert(key_string);
+            return true;
+        }
+
         status = sai_srv6_api->create_my_sid_entry(&my_sid_entry, (uint32_t) attributes.size(), attributes.data());
         if (status != SAI_STATUS_SUCCESS)
         {
@@ -1633,14 +1896,23 @@ bool Srv6Orch::createUpdateMysidEntry(string my_sid_string, const string dt_vrf,
             }
         }
     }
+    storeMySidEntry(key_string, my_sid_entry, end_behavior, vrf_update ? dt_vrf : "", nh_update ? adj : "");
+
+    return true;
+}
+
+void Srv6Orch::storeMySidEntry(const string &key_string, const sai_my_sid_entry_t &my_sid_entry,
+                               sai_my_sid_entry_endpoint_behavior_t end_behavior, const string &dt_vrf, const string &adj)
+{
     SWSS_LOG_INFO("Store keystring %s in cache", key_string.c_str());
-    if(vrf_update)
+    if (!dt_vrf.empty())
     {
         m_vrfOrch->increaseVrfRefCount(dt_vrf);
         srv6_my_sid_table_[key_string].endVrfString = dt_vrf;
     }
-    if(nh_update)
+    if (!adj.empty())
     {
+        NextHopKey nexthop(adj);
         m_neighOrch->increaseNextHopRefCount(nexthop, 1);
 
         SWSS_LOG_INFO("Increasing refcount to %d for Nexthop %s",
@@ -1650,8 +1922,53 @@ bool Srv6Orch::createUpdateMysidEntry(string my_sid_string, const string dt_vrf,
     }
     srv6_my_sid_table_[key_string].endBehavior = end_behavior;
     srv6_my_sid_table_[key_string].entry = my_sid_entry;
+}
 
-    return true;
+void Srv6Orch::flushMySidBulk()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_mySidBulkOps.empty())
+    {
+        return;
+    }
+
+    EntityBulker<sai_srv6_api_t> bulker(sai_srv6_api, gMaxBulkSize);
+    for (auto &ctx : m_mySidBulkOps)
+    {
+        bulker.create_entry(&ctx.status, &ctx.entry, (uint32_t)ctx.attrs.size(), ctx.attrs.data());
+    }
+    bulker.flush();
+
+    SWSS_LOG_INFO("Created %zu my_sid entries in bulk", m_mySidBulkOps.size());
+
+    for (auto &ctx : m_mySidBulkOps)
+    {
+        if (is_bulk_unsupported(ctx.status))
+        {
+            if (m_mySidBulkSupported)
+            {
+                SWSS_LOG_NOTICE("Bulk my_sid entry creation is not supported, rv:%d", ctx.status);
+                m_mySidBulkSupported = false;
+            }
+            ctx.status = sai_srv6_api->create_my_sid_entry(&ctx.entry, (uint32_t)ctx.attrs.size(), ctx.attrs.data());
+        }
+
+        if (ctx.status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create my_sid entry %s, rv %d", ctx.key_string.c_str(), ctx.status);
+            continue;
+        }
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_SRV6_MY_SID_ENTRY);
+        srv6_my_sid_table_[ctx.key_string].counter = ctx.counter;
+        storeMySidEntry(ctx.key_string, ctx.entry, ctx.end_behavior, ctx.dt_vrf, ctx.adj);
+    }
+
+    for (auto &ctx : m_mySidBulkOps)
+    {
+        m_bulkPendingKeys.erase(ctx.key_string);
+    }
+    m_mySidBulkOps.clear();
 }
 
 bool Srv6Orch::deleteMysidEntry(const string my_sid_string)
@@ -2354,9 +2671,19 @@ void Srv6Orch::doTask(Consumer &consumer)
     SWSS_LOG_ENTER();
     task_process_status status;
     const string &table_name = consumer.getTableName();
+
+    m_bulkMode = (table_name == APP_SRV6_SID_LIST_TABLE_NAME || table_name == APP_SRV6_MY_SID_TABLE_NAME)
+        && consumer.m_toSync.size() > 1;
+
     auto it = consumer.m_toSync.begin();
     while(it != consumer.m_toSync.end())
     {
+        if (m_bulkPendingKeys.count(it->first))
+        {
+            flushSidListBulk();
+            flushMySidBulk();
+        }
+
         auto t = it->second;
         SWSS_LOG_INFO("table name : %s",table_name.c_str());
         if (table_name == APP_SRV6_SID_LIST_TABLE_NAME)
@@ -2391,4 +2718,8 @@ void Srv6Orch::doTask(Consumer &consumer)
         }
         consumer.m_toSync.erase(it++);
     }
+
+    flushSidListBulk();
+    flushMySidBulk();
+    m_bulkMode = false;
 }
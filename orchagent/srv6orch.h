@@ -1,10 +1,13 @@
 #ifndef SWSS_SRV6ORCH_H
 #define SWSS_SRV6ORCH_H
 
+#include <deque>
+#include <memory>
 #include <vector>
 #include <string>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <boost/optional.hpp>
 
 #include "dbconnector.h"
@@ -19,6 +22,7 @@
 #include "nexthopkey.h"
 #include "neighorch.h"
 #include "producerstatetable.h"
+#include "bulker.h"
 
 #include "ipaddress.h"
 #include "ipaddresses.h"
@@ -52,6 +56,29 @@ struct MySidEntry
     sai_object_id_t   counter;
 };
 
+/* SID list create queued for the bulk flush at the end of a drain */
+struct SidListBulkContext
+{
+    string sid_name;
+    unique_ptr<sai_ip6_t[]> segments;   // Backs the segment list attribute
+    vector<sai_attribute_t> attrs;
+    sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+    sai_status_t status = SAI_STATUS_NOT_EXECUTED;
+};
+
+/* MySID entry create queued for the bulk flush at the end of a drain */
+struct MySidBulkContext
+{
+    string key_string;
+    sai_my_sid_entry_t entry;
+    sai_my_sid_entry_endpoint_behavior_t end_behavior;
+    string dt_vrf;  // Set when the behavior references a VRF
+    string adj;     // Set when the behavior references a nexthop
+    sai_object_id_t counter = SAI_NULL_OBJECT_ID;
+    vector<sai_attribute_t> attrs;
+    sai_status_t status = SAI_STATUS_NOT_EXECUTED;
+};
+
 struct MySidIpInIpTunnel
 {
     sai_object_id_t overlay_rif_oid;
@@ -187,7 +214,11 @@ class Srv6Orch : public Orch, public Observer
         bool deleteSrv6Nexthop(const NextHopKey &nh);
         bool srv6NexthopExists(const NextHopKey &nh);
         bool createUpdateMysidEntry(string my_sid_string, const string vrf, const string adj, const string end_action);
+        void storeMySidEntry(const string &key_string, const sai_my_sid_entry_t &my_sid_entry,
+                             sai_my_sid_entry_endpoint_behavior_t end_behavior, const string &dt_vrf, const string &adj);
         bool deleteMysidEntry(const string my_sid_string);
+        void flushSidListBulk();
+        void flushMySidBulk();
         bool sidEntryEndpointBehavior(const string action, sai_my_sid_entry_endpoint_behavior_t &end_behavior,
                                       sai_my_sid_entry_endpoint_behavior_flavor_t &end_flavor);
         MySidLocatorCfg getMySidEntryLocatorCfg(const sai_my_sid_entry_t& sai_entry) const;
@@ -234,6 +265,8 @@ class Srv6Orch : public Orch, public Observer
         bool addMySidCounter(const sai_my_sid_entry_t& sai_entry, sai_object_id_t& counter_oid);
         void removeMySidCounter(const sai_my_sid_entry_t& sai_entry, sai_object_id_t& counter_oid);
         void setMySidEntryCounter(const sai_my_sid_entry_t& sai_entry, sai_object_id_t counter_oid);
+        void addMySidCounters();
+        void removeMySidCounters();
 
         ProducerStateTable m_sidTable;
         ProducerStateTable m_mysidTable;
@@ -257,7 +290,7 @@ class Srv6Orch : public Orch, public Observer
         SwitchOrch *m_switchOrch;
         NeighOrch *m_neighOrch;
 
-        FlexCounterManager m_counter_manager;
+        FlexCounterTaggedCachedManager<void> m_counter_manager;
         unique_ptr<Table> m_mysid_counters_table;
         unique_ptr<Table> m_vid_to_rid_table;
         shared_ptr<DBConnector> m_counter_db;
@@ -267,6 +300,19 @@ class Srv6Orch : public Orch, public Observer
         bool m_mysid_counters_enabled = false;
         bool m_mysid_counters_supported = false;
 
+        /*
+         * Creates of new SID lists and MySID entries are queued while a drain of
+         * more than one task is processed and flushed in bulk at its end, so that
+         * the routes resolving over the SID lists are programmed after them.
+         * A task for a key with a queued create flushes the queue first.
+         */
+        bool m_bulkMode = false;
+        bool m_sidListBulkSupported;
+        bool m_mySidBulkSupported;
+        deque<SidListBulkContext> m_sidListBulkOps;
+        deque<MySidBulkContext> m_mySidBulkOps;
+        unordered_set<string> m_bulkPendingKeys;
+
         /*
          * Map to store the SRv6 MySID entries not yet configured in ASIC because associated to a non-ready nexthop
          * 
@@ -1,8 +1,10 @@
 #include <tuple>
+#include <algorithm>
 #include "portsorch.h"
 #include "logger.h"
 #include "fdborch.h"
 #include "stporch.h"
+#include "bulker.h"
 
 extern sai_stp_api_t *sai_stp_api;
 extern sai_vlan_api_t *sai_vlan_api;
@@ -13,6 +15,7 @@ extern PortsOrch *gPortsOrch;
 
 
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 
 StpOrch::StpOrch(DBConnector * db, DBConnector * stateDb, vector<string> &tableNames) :
     Orch(db, tableNames)
@@ -203,17 +206,12 @@ bool StpOrch::removeVlanFromStpInstance(string vlan_alias, sai_uint16_t stp_inst
     return true;
 }
 
-/* If STP Port exists return else create a new STP Port */
-sai_object_id_t StpOrch::addStpPort(Port &port, sai_uint16_t stp_instance)
+/* Fill the attributes creating the STP port of port in stp_instance, the
+ * bridge port and the STP instance are created if they don't exist yet.
+ */
+bool StpOrch::getStpPortCreateAttrs(Port &port, sai_uint16_t stp_instance, sai_attribute_t *attr)
 {
-    sai_object_id_t stp_port_id = SAI_NULL_OBJECT_ID;
     sai_object_id_t stp_id = SAI_NULL_OBJECT_ID;
-    sai_attribute_t attr[3];
-
-    if(port.m_stp_port_ids.find(stp_instance) != port.m_stp_port_ids.end())
-    {
-        return port.m_stp_port_ids[stp_instance];
-    }
 
     if(port.m_bridge_port_id == SAI_NULL_OBJECT_ID)
     {
@@ -222,7 +220,7 @@ sai_object_id_t StpOrch::addStpPort(Port &port, sai_uint16_t stp_instance)
         if(port.m_bridge_port_id == SAI_NULL_OBJECT_ID)
         {
             SWSS_LOG_ERROR("Failed to add STP port %s invalid bridge port id STP instance %d", port.m_alias.c_str(), stp_instance);
-            return SAI_NULL_OBJECT_ID;
+            return false;
         }
     }
     attr[0].id = SAI_STP_PORT_ATTR_BRIDGE_PORT;
@@ -234,7 +232,7 @@ sai_object_id_t StpOrch::addStpPort(Port &port, sai_uint16_t stp_instance)
         stp_id = addStpInstance(stp_instance);
         if(stp_id == SAI_NULL_OBJECT_ID)
         {
-            return SAI_NULL_OBJECT_ID;
+            return false;
         }
     }
 
@@ -244,6 +242,25 @@ sai_object_id_t StpOrch::addStpPort(Port &port, sai_uint16_t stp_instance)
     attr[2].id = SAI_STP_PORT_ATTR_STATE;
     attr[2].value.s32 = SAI_STP_PORT_STATE_BLOCKING;
 
+    return true;
+}
+
+/* If STP Port exists return else create a new STP Port */
+sai_object_id_t StpOrch::addStpPort(Port &port, sai_uint16_t stp_instance)
+{
+    sai_object_id_t stp_port_id = SAI_NULL_OBJECT_ID;
+    sai_attribute_t attr[3];
+
+    if(port.m_stp_port_ids.find(stp_instance) != port.m_stp_port_ids.end())
+    {
+        return port.m_stp_port_ids[stp_instance];
+    }
+
+    if(!getStpPortCreateAttrs(port, stp_instance, attr))
+    {
+        return SAI_NULL_OBJECT_ID;
+    }
+
     sai_status_t status = sai_stp_api->create_stp_port(&stp_port_id, gSwitchId, 3, attr);
     if (status != SAI_STATUS_SUCCESS)
     {
@@ -426,20 +443,146 @@ void StpOrch::doStpTask(Consumer &consumer)
     }
 }
 
+/* createStpPorts: Creates the STP ports of the queued states which don't have
+ * one yet with one bulk call, with the state as their initial state. A state
+ * whose STP port failed to be created is dropped, as addStpPort does.
+ */
+void StpOrch::createStpPorts(Consumer &consumer, vector<StpPortStateUpdate> &updates)
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_status_t> statuses(updates.size(), SAI_STATUS_SUCCESS);
+    ObjectBulker<sai_stp_api_t> bulker(sai_stp_api, gSwitchId, gMaxBulkSize);
+    bool creating = false;
+    for (size_t i = 0; i < updates.size(); i++)
+    {
+        if (updates[i].create)
+        {
+            bulker.create_entry(&updates[i].stp_port_oid, &statuses[i], 3, updates[i].create_attrs);
+            creating = true;
+        }
+    }
+    if (!creating)
+    {
+        return;
+    }
+    bulker.flush();
+
+    auto update = updates.begin();
+    for (size_t i = 0; i < statuses.size(); i++, update++)
+    {
+        if (!update->create)
+        {
+            continue;
+        }
+
+        if (is_bulk_unsupported(statuses[i]))
+        {
+            statuses[i] = sai_stp_api->create_stp_port(&update->stp_port_oid, gSwitchId, 3, update->create_attrs);
+        }
+
+        Port port;
+        if (statuses[i] != SAI_STATUS_SUCCESS || !gPortsOrch->getPort(update->port_alias, port))
+        {
+            SWSS_LOG_ERROR("Failed to add STP port %s instance %d status %u", update->port_alias.c_str(), update->stp_instance, statuses[i]);
+            consumer.m_toSync.erase(update->task);
+            continue;
+        }
+
+        port.m_stp_port_ids[update->stp_instance] = update->stp_port_oid;
+        gPortsOrch->setPort(port.m_alias, port);
+        SWSS_LOG_INFO("Add STP port %s instance %d oid %" PRIx64 " state %d", port.m_alias.c_str(), update->stp_instance,
+                update->stp_port_oid, update->stp_state);
+        consumer.m_toSync.erase(update->task);
+    }
+
+    /* The created STP ports already have their state */
+    updates.erase(remove_if(updates.begin(), updates.end(),
+                            [](const StpPortStateUpdate &u) { return u.create; }), updates.end());
+}
+
+/* flushStpPortStates: Sets the queued port states with one bulk call, falling
+ * back to one call per STP port if the SAI does not support it. The tasks of
+ * the states which failed are kept for retry.
+ */
+void StpOrch::flushStpPortStates(Consumer &consumer, vector<StpPortStateUpdate> &updates)
+{
+    SWSS_LOG_ENTER();
+
+    createStpPorts(consumer, updates);
+
+    if (updates.empty())
+    {
+        return;
+    }
+
+    vector<sai_status_t> statuses(updates.size(), SAI_STATUS_NOT_SUPPORTED);
+    if (m_stpPortStateBulkSupported)
+    {
+        ObjectBulker<sai_stp_api_t> bulker(sai_stp_api, gSwitchId, gMaxBulkSize);
+        bulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+        for (size_t i = 0; i < updates.size(); i++)
+        {
+            sai_attribute_t attr;
+            attr.id = SAI_STP_PORT_ATTR_STATE;
+            attr.value.u32 = getStpSaiState(updates[i].stp_state);
+            bulker.set_entry_attribute(&statuses[i], updates[i].stp_port_oid, &attr);
+        }
+        bulker.flush();
+    }
+
+    for (size_t i = 0; i < updates.size(); i++)
+    {
+        auto &update = updates[i];
+
+        if (is_bulk_unsupported(statuses[i]))
+        {
+            if (m_stpPortStateBulkSupported)
+            {
+                SWSS_LOG_NOTICE("Bulk STP port state set is not supported, rv:%d", statuses[i]);
+                m_stpPortStateBulkSupported = false;
+            }
+
+            sai_attribute_t attr;
+            attr.id = SAI_STP_PORT_ATTR_STATE;
+            attr.value.u32 = getStpSaiState(update.stp_state);
+            statuses[i] = sai_stp_api->set_stp_port_attribute(update.stp_port_oid, &attr);
+        }
+
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to set STP port state %s instance %d state %d status %x", update.port_alias.c_str(),
+                    update.stp_instance, update.stp_state, statuses[i]);
+            continue;
+        }
+
+        SWSS_LOG_INFO("Set STP port state %s instance %d state %d ", update.port_alias.c_str(), update.stp_instance, update.stp_state);
+        consumer.m_toSync.erase(update.task);
+    }
+
+    updates.clear();
+}
+
 void StpOrch::doStpPortStateTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    /* The port states of the batch are set in bulk, and the STP ports which
+     * don't exist yet are created in bulk with their state. A removal flushes
+     * the states queued before it, so that the tasks of a port apply in order.
+     */
+    vector<StpPortStateUpdate> updates;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
         auto &t = it->second;
         string key = kfvKey(t);
         size_t found = key.find(':');
-        /* Return if the format of key is wrong */
+        /* Stop if the format of key is wrong */
         if (found == string::npos)
         {
-            return;
+            break;
         }
         string port_alias = key.substr(0, found);
         string stp_instance = key.substr(found+1);
@@ -448,7 +591,7 @@ void StpOrch::doStpPortStateTask(Consumer &consumer)
 
         if (!gPortsOrch->getPort(port_alias, port))
         {
-            return;
+            break;
         }
 
         string op = kfvOp(t);
@@ -466,15 +609,36 @@ void StpOrch::doStpPortStateTask(Consumer &consumer)
             }
             if(state != STP_STATE_INVALID)
             {
-                if(!updateStpPortState(port, instance, state))
+                StpPortStateUpdate update = {};
+                update.task = it;
+                update.port_alias = port_alias;
+                update.stp_instance = instance;
+                update.stp_state = state;
+
+                auto stp_port = port.m_stp_port_ids.find(instance);
+                if (stp_port != port.m_stp_port_ids.end())
+                {
+                    update.stp_port_oid = stp_port->second;
+                }
+                else if (getStpPortCreateAttrs(port, instance, update.create_attrs))
+                {
+                    update.create = true;
+                    update.create_attrs[2].value.s32 = getStpSaiState(state);
+                }
+
+                if (update.stp_port_oid != SAI_NULL_OBJECT_ID || update.create)
                 {
+                    updates.push_back(update);
                     it++;
                     continue;
                 }
+
+                SWSS_LOG_ERROR("Failed to get STP port oid port %s instance %d state %d ", port_alias.c_str(), instance, state);
             }
         }
         else if (op == DEL_COMMAND)
         {
+            flushStpPortStates(consumer, updates);
             if(!removeStpPort(port, instance))
             {
                 it++;
@@ -483,6 +647,8 @@ void StpOrch::doStpPortStateTask(Consumer &consumer)
         }
         it = consumer.m_toSync.erase(it);
     }
+
+    flushStpPortStates(consumer, updates);
 }
 
 void StpOrch::doStpFastageTask(Consumer &consumer)
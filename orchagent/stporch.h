@@ -24,6 +24,18 @@ typedef struct StpInstEntry
     std::set<std::string> stp_inst_vlan_list;
 } StpInstEntry;
 
+typedef struct StpPortStateUpdate
+{
+    SyncMap::iterator task;
+    std::string port_alias;
+    sai_uint16_t stp_instance;
+    sai_uint8_t stp_state;
+    sai_object_id_t stp_port_oid;
+    /* The STP port does not exist yet, it is created in bulk with the state */
+    bool create;
+    sai_attribute_t create_attrs[3];
+} StpPortStateUpdate;
+
 
 class StpOrch : public Orch
 {
@@ -41,6 +53,7 @@ private:
     std::map<sai_uint16_t, StpInstEntry> m_vlanAliasToStpInstanceMap;
 
     sai_uint16_t m_maxStpInstance;
+    bool m_stpPortStateBulkSupported = true;
 
     
     void doStpTask(Consumer &consumer);
@@ -54,10 +67,13 @@ private:
     bool addVlanToStpInstance(string vlan, sai_uint16_t stp_instance);
     sai_object_id_t getStpInstanceOid(sai_uint16_t stp_instance);
     
+    bool getStpPortCreateAttrs(Port &port, sai_uint16_t stp_instance, sai_attribute_t *attr);
     sai_object_id_t addStpPort(Port &port, sai_uint16_t stp_instance);
     bool removeStpPort(Port &port, sai_uint16_t stp_instance);
     sai_stp_port_state_t getStpSaiState(sai_uint8_t stp_state);
     bool updateStpPortState(Port &port, sai_uint16_t stp_instance, sai_uint8_t stp_state);
+    void createStpPorts(Consumer &consumer, std::vector<StpPortStateUpdate> &updates);
+    void flushStpPortStates(Consumer &consumer, std::vector<StpPortStateUpdate> &updates);
 
     void doTask(Consumer& consumer);
 };
@@ -22,6 +22,7 @@ extern "C" {
 
 #include "switch_schema.h"
 #include "switch_capabilities.h"
+#include "saicapabilitycache.h"
 
 using namespace swss;
 
@@ -316,7 +317,7 @@ sai_status_t SwitchCapabilities::queryEnumCapabilitiesSai(std::vector<sai_int32_
 {
     sai_s32_list_t enumList = { .count = 0, .list = nullptr };
 
-    auto status = sai_query_attribute_enum_values_capability(gSwitchId, objType, attrId, &enumList);
+    auto status = querySaiAttributeEnumValuesCapability(gSwitchId, objType, attrId, &enumList);
     if ((status != SAI_STATUS_SUCCESS) && (status != SAI_STATUS_BUFFER_OVERFLOW))
     {
         return status;
@@ -325,12 +326,12 @@ sai_status_t SwitchCapabilities::queryEnumCapabilitiesSai(std::vector<sai_int32_
     capList.resize(enumList.count);
     enumList.list = capList.data();
 
-    return sai_query_attribute_enum_values_capability(gSwitchId, objType, attrId, &enumList);
+    return querySaiAttributeEnumValuesCapability(gSwitchId, objType, attrId, &enumList);
 }
 
 sai_status_t SwitchCapabilities::queryAttrCapabilitiesSai(sai_attr_capability_t &attrCap, sai_object_type_t objType, sai_attr_id_t attrId) const
 {
-    return sai_query_attribute_capability(gSwitchId, objType, attrId, &attrCap);
+    return querySaiAttributeCapability(gSwitchId, objType, attrId, &attrCap);
 }
 
 void SwitchCapabilities::queryHashNativeHashFieldListEnumCapabilities()
@@ -24,6 +24,7 @@ extern "C" {
 
 #include "schema.h"
 #include "capabilities.h"
+#include "saicapabilitycache.h"
 
 using namespace swss;
 
@@ -276,7 +277,7 @@ sai_status_t SwitchTrimmingCapabilities::queryEnumCapabilitiesSai(std::vector<sa
 {
     sai_s32_list_t enumList = { .count = 0, .list = nullptr };
 
-    auto status = sai_query_attribute_enum_values_capability(gSwitchId, objType, attrId, &enumList);
+    auto status = querySaiAttributeEnumValuesCapability(gSwitchId, objType, attrId, &enumList);
     if ((status != SAI_STATUS_SUCCESS) && (status != SAI_STATUS_BUFFER_OVERFLOW))
     {
         return status;
@@ -285,12 +286,12 @@ sai_status_t SwitchTrimmingCapabilities::queryEnumCapabilitiesSai(std::vector<sa
     capList.resize(enumList.count);
     enumList.list = capList.data();
 
-    return sai_query_attribute_enum_values_capability(gSwitchId, objType, attrId, &enumList);
+    return querySaiAttributeEnumValuesCapability(gSwitchId, objType, attrId, &enumList);
 }
 
 sai_status_t SwitchTrimmingCapabilities::queryAttrCapabilitiesSai(sai_attr_capability_t &attrCap, sai_object_type_t objType, sai_attr_id_t attrId) const
 {
-    return sai_query_attribute_capability(gSwitchId, objType, attrId, &attrCap);
+    return querySaiAttributeCapability(gSwitchId, objType, attrId, &attrCap);
 }
 
 void SwitchTrimmingCapabilities::queryTrimSizeAttrCapabilities()
@@ -11,6 +11,7 @@
 #include "macaddress.h"
 #include "return_code.h"
 #include "saihelper.h"
+#include "saicapabilitycache.h"
 #include "sai_serialize.h"
 #include "notifications.h"
 #include "redisapi.h"
@@ -145,6 +146,16 @@ void SwitchOrch::set_switch_pfc_dlr_init_capability()
     set_switch_capability(fvVector);
 }
 
+AsicSdkHealthEventReady::AsicSdkHealthEventReady(SwitchOrch *orch)
+    : Executor(new SelectableEvent(), orch, "ASIC_SDK_HEALTH_EVENT_READY")
+{
+}
+
+void AsicSdkHealthEventReady::execute()
+{
+    static_cast<SwitchOrch *>(m_orch)->m_asicSdkHealthEventFlushTimer->start();
+}
+
 SwitchOrch::SwitchOrch(DBConnector *db, vector<TableConnector>& connectors, TableConnector switchTable):
         Orch(connectors),
         m_switchTable(switchTable.first, switchTable.second),
@@ -160,6 +171,14 @@ SwitchOrch::SwitchOrch(DBConnector *db, vector<TableConnector>& connectors, Tabl
     auto restartCheckNotifier = new Notifier(m_restartCheckNotificationConsumer, this, "RESTARTCHECK");
     Orch::addExecutor(restartCheckNotifier);
 
+    m_asicSdkHealthEventPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_stateDbForNotification.get()));
+    m_asicSdkHealthEventWriter = unique_ptr<Table>(new Table(m_asicSdkHealthEventPipeline.get(), STATE_ASIC_SDK_HEALTH_EVENT_TABLE_NAME, true));
+    m_asicSdkHealthEventFlushTimer = new SelectableTimer(timespec { .tv_sec = ASIC_SDK_HEALTH_EVENT_FLUSH_INTERVAL, .tv_nsec = 0 });
+    auto flushExecutor = new ExecutableTimer(m_asicSdkHealthEventFlushTimer, this, "ASIC_SDK_HEALTH_EVENT_FLUSH_TIMER");
+    Orch::addExecutor(flushExecutor);
+    m_asicSdkHealthEventReady = new AsicSdkHealthEventReady(this);
+    Orch::addExecutor(m_asicSdkHealthEventReady);
+
     initAsicSdkHealthEventNotification();
     set_switch_pfc_dlr_init_capability();
     initSensorsTable();
@@ -477,10 +496,10 @@ void SwitchOrch::setSwitchNonSaiAttributes(swss::FieldValueTuple &val)
                 values.count = static_cast<uint32_t>(values_list.size());
                 values.list = values_list.data();
 
-                auto status = sai_query_attribute_enum_values_capability(gSwitchId,
-                                                                         SAI_OBJECT_TYPE_NEXT_HOP_GROUP,
-                                                                         SAI_NEXT_HOP_GROUP_ATTR_TYPE,
-                                                                         &values);
+                auto status = querySaiAttributeEnumValuesCapability(gSwitchId,
+                                                                    SAI_OBJECT_TYPE_NEXT_HOP_GROUP,
+                                                                    SAI_NEXT_HOP_GROUP_ATTR_TYPE,
+                                                                    &values);
                 if (status == SAI_STATUS_SUCCESS)
                 {
                     for (size_t i = 0; i < values.count; i++)
@@ -523,8 +542,8 @@ sai_status_t SwitchOrch::setSwitchTunnelVxlanParams(swss::FieldValueTuple &val)
         attr.value.s32 = SAI_TUNNEL_VXLAN_UDP_SPORT_MODE_USER_DEFINED;
         attrs.push_back(attr);
         sai_attr_capability_t capability;
-        status = sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_SWITCH_TUNNEL,
-                                                SAI_SWITCH_TUNNEL_ATTR_VXLAN_UDP_SPORT_SECURITY, &capability);
+        status = querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_SWITCH_TUNNEL,
+                                             SAI_SWITCH_TUNNEL_ATTR_VXLAN_UDP_SPORT_SECURITY, &capability);
         if (status == SAI_STATUS_SUCCESS) {
             if (capability.create_implemented) {
                 attr.id = SAI_SWITCH_TUNNEL_ATTR_VXLAN_UDP_SPORT_SECURITY;
@@ -1443,6 +1462,33 @@ void SwitchOrch::doCfgSuppressAsicSdkHealthEventTableTask(Consumer &consumer)
 
         if (op == SET_COMMAND)
         {
+            // Cached for the elimination of the oldest events, regardless of
+            // the categories registration
+            bool maxEventsConfigured = false;
+            for (const auto &cit : kfvFieldsValues(keyOpFieldsValues))
+            {
+                if (fvField(cit) != "max_events")
+                {
+                    continue;
+                }
+
+                try
+                {
+                    m_asicSdkHealthEventMaxEvents[key] = to_uint<uint32_t>(fvValue(cit));
+                    m_asicSdkHealthEventSeveritiesToEliminate.insert(key);
+                    maxEventsConfigured = true;
+                }
+                catch (const exception &e)
+                {
+                    SWSS_LOG_ERROR("Invalid max_events %s for severity %s: %s", fvValue(cit).c_str(), key.c_str(), e.what());
+                }
+            }
+
+            if (!maxEventsConfigured)
+            {
+                m_asicSdkHealthEventMaxEvents.erase(key);
+            }
+
             bool categoriesConfigured = false;
             bool continueMainLoop = false;
             for (const auto &cit : kfvFieldsValues(keyOpFieldsValues))
@@ -1479,6 +1525,7 @@ void SwitchOrch::doCfgSuppressAsicSdkHealthEventTableTask(Consumer &consumer)
         }
         else if (op == DEL_COMMAND)
         {
+            m_asicSdkHealthEventMaxEvents.erase(key);
             registerAsicSdkHealthEventCategories(saiSeverity, key);
         }
         else
@@ -1544,6 +1591,7 @@ void SwitchOrch::doTask(NotificationConsumer& consumer)
     m_warmRestartCheck.checkRestartReadyState = false;
     m_warmRestartCheck.noFreeze = false;
     m_warmRestartCheck.skipPendingTaskCheck = false;
+    m_warmRestartCheck.dumpPendingTasks = false;
 
     SWSS_LOG_NOTICE("RESTARTCHECK notification for %s ", op.c_str());
     if (op == "orchagent")
@@ -1563,6 +1611,10 @@ void SwitchOrch::doTask(NotificationConsumer& consumer)
             {
                 m_warmRestartCheck.skipPendingTaskCheck = true;
             }
+            if (fvField(i) == "DumpPendingTasks" && fvValue(i) == "true")
+            {
+                m_warmRestartCheck.dumpPendingTasks = true;
+            }
         }
         SWSS_LOG_NOTICE("%s", s.c_str());
     }
@@ -1658,7 +1710,18 @@ void SwitchOrch::onSwitchAsicSdkHealthEvent(sai_object_id_t switch_id,
     values.emplace_back("category", category_str);
     values.emplace_back("description", description_str);
 
-    m_asicSdkHealthEventTable->set(time_ss.str(),values);
+    bool wasEmpty;
+    {
+        lock_guard<mutex> lock(m_asicSdkHealthEventMutex);
+        wasEmpty = m_pendingAsicSdkHealthEvents.empty();
+        m_pendingAsicSdkHealthEvents.push_back({time_ss.str(), severity_str, std::move(values)});
+    }
+
+    // Running on the notification thread, let the main thread arm the flush timer
+    if (wasEmpty)
+    {
+        m_asicSdkHealthEventReady->notify();
+    }
 
     event_publish(g_events_handle, "asic-sdk-health-event", &params);
 
@@ -1781,14 +1844,89 @@ void SwitchOrch::doTask(SelectableTimer &timer)
             }
         }
     }
+    else if (&timer == m_asicSdkHealthEventFlushTimer)
+    {
+        flushAsicSdkHealthEvents();
+    }
     else if (&timer == m_eliminateEventsTimer)
     {
-        auto ret = swss::runRedisScript(*m_stateDb, m_eliminateEventsSha, {}, {});
-        for (auto str: ret)
+        eliminateAsicSdkHealthEvents();
+    }
+}
+
+void SwitchOrch::flushAsicSdkHealthEvents()
+{
+    SWSS_LOG_ENTER();
+
+    lock_guard<mutex> lock(m_asicSdkHealthEventMutex);
+
+    size_t count = 0;
+    while (!m_pendingAsicSdkHealthEvents.empty() && count < ASIC_SDK_HEALTH_EVENT_FLUSH_BATCH_SIZE)
+    {
+        auto &event = m_pendingAsicSdkHealthEvents.front();
+        m_asicSdkHealthEventWriter->set(event.key, event.values);
+        if (m_asicSdkHealthEventMaxEvents.find(event.severity) != m_asicSdkHealthEventMaxEvents.end())
+        {
+            m_asicSdkHealthEventSeveritiesToEliminate.insert(event.severity);
+        }
+        m_pendingAsicSdkHealthEvents.pop_front();
+        count++;
+    }
+
+    m_asicSdkHealthEventPipeline->flush();
+
+    if (m_pendingAsicSdkHealthEvents.empty())
+    {
+        m_asicSdkHealthEventFlushTimer->stop();
+    }
+
+    SWSS_LOG_INFO("Recorded %zu ASIC/SDK health events, %zu pending", count, m_pendingAsicSdkHealthEvents.size());
+}
+
+void SwitchOrch::flushPendingAsicSdkHealthEvents()
+{
+    SWSS_LOG_ENTER();
+
+    // Waits for a batch being written by the main thread, so no event is lost
+    lock_guard<mutex> lock(m_asicSdkHealthEventMutex);
+
+    size_t count = m_pendingAsicSdkHealthEvents.size();
+    for (const auto &event : m_pendingAsicSdkHealthEvents)
+    {
+        m_asicSdkHealthEventTable->set(event.key, event.values);
+    }
+    m_pendingAsicSdkHealthEvents.clear();
+
+    SWSS_LOG_NOTICE("Recorded %zu pending ASIC/SDK health events", count);
+}
+
+void SwitchOrch::eliminateAsicSdkHealthEvents()
+{
+    SWSS_LOG_ENTER();
+
+    vector<string> argv;
+    for (const auto &severity : m_asicSdkHealthEventSeveritiesToEliminate)
+    {
+        auto it = m_asicSdkHealthEventMaxEvents.find(severity);
+        if (it != m_asicSdkHealthEventMaxEvents.end())
         {
-            SWSS_LOG_INFO("Eliminate ASIC/SDK health %s", str.c_str());
+            argv.push_back(severity);
+            argv.push_back(to_string(it->second));
         }
     }
+    m_asicSdkHealthEventSeveritiesToEliminate.clear();
+
+    // Nothing recorded or reconfigured since the last elimination
+    if (argv.empty())
+    {
+        return;
+    }
+
+    auto ret = swss::runRedisScript(*m_stateDb, m_eliminateEventsSha, {}, argv);
+    for (auto str: ret)
+    {
+        SWSS_LOG_INFO("Eliminate ASIC/SDK health %s", str.c_str());
+    }
 }
 
 void SwitchOrch::initSensorsTable()
@@ -1878,7 +2016,7 @@ void SwitchOrch::querySwitchPortEgressSampleCapability()
     sai_attr_capability_t capability;
 
     // Check if SAI is capable of handling Port egress sample.
-    status = sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_PORT,
+    status = querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_PORT,
                             SAI_PORT_ATTR_EGRESS_SAMPLEPACKET_ENABLE, &capability);
     if (status != SAI_STATUS_SUCCESS)
     {
@@ -1907,7 +2045,7 @@ void SwitchOrch::querySwitchPortMirrorCapability()
     sai_attr_capability_t capability;
 
     // Check if SAI is capable of handling Port ingress mirror session
-    status = sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_PORT,
+    status = querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_PORT,
                             SAI_PORT_ATTR_INGRESS_MIRROR_SESSION, &capability);
     if (status != SAI_STATUS_SUCCESS)
     {
@@ -1931,7 +2069,7 @@ void SwitchOrch::querySwitchPortMirrorCapability()
     }
 
     // Check if SAI is capable of handling Port egress mirror session
-    status = sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_PORT,
+    status = querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_PORT,
                             SAI_PORT_ATTR_EGRESS_MIRROR_SESSION, &capability);
     if (status != SAI_STATUS_SUCCESS)
     {
@@ -1967,7 +2105,7 @@ void SwitchOrch::querySwitchTpidCapability()
         sai_attr_capability_t capability;
 
         // Check if SAI is capable of handling TPID for Port
-        status = sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_TPID, &capability);
+        status = querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_TPID, &capability);
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_WARN("Could not query port TPID capability %d", status);
@@ -1987,7 +2125,7 @@ void SwitchOrch::querySwitchTpidCapability()
             SWSS_LOG_NOTICE("port TPID capability %d", capability.set_implemented);
         }
         // Check if SAI is capable of handling TPID for LAG
-        status = sai_query_attribute_capability(gSwitchId, SAI_OBJECT_TYPE_LAG, SAI_LAG_ATTR_TPID, &capability);
+        status = querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_LAG, SAI_LAG_ATTR_TPID, &capability);
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_WARN("Could not query LAG TPID capability %d", status);
@@ -2072,7 +2210,7 @@ bool SwitchOrch::querySwitchCapability(sai_object_type_t sai_object, sai_attr_id
     sai_status_t status = SAI_STATUS_SUCCESS;
     sai_attr_capability_t capability;
 
-    status = sai_query_attribute_capability(gSwitchId, sai_object, attr_id, &capability);
+    status = querySaiAttributeCapability(gSwitchId, sai_object, attr_id, &capability);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_WARN("Could not query switch level DSCP to TC map %d", status);
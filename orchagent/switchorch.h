@@ -1,7 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+
 #include "acltable.h"
 #include "orch.h"
+#include "selectableevent.h"
 #include "timer.h"
 #include "flex_counter/flex_counter_manager.h"
 #include "switch/switch_capabilities.h"
@@ -27,6 +32,8 @@
 #define SWITCH_CAPABILITY_TABLE_FAST_LINKUP_GUARD_TIMER_RANGE          "FAST_LINKUP_GUARD_TIMER_RANGE"
 
 #define ASIC_SDK_HEALTH_EVENT_ELIMINATE_INTERVAL 3600
+#define ASIC_SDK_HEALTH_EVENT_FLUSH_INTERVAL 1
+#define ASIC_SDK_HEALTH_EVENT_FLUSH_BATCH_SIZE 256
 #define SWITCH_CAPABILITY_TABLE_ASIC_SDK_HEALTH_EVENT_CAPABLE          "ASIC_SDK_HEALTH_EVENT"
 #define SWITCH_CAPABILITY_TABLE_REG_FATAL_ASIC_SDK_HEALTH_CATEGORY     "REG_FATAL_ASIC_SDK_HEALTH_CATEGORY"
 #define SWITCH_CAPABILITY_TABLE_REG_WARNING_ASIC_SDK_HEALTH_CATEGORY   "REG_WARNING_ASIC_SDK_HEALTH_CATEGORY"
@@ -41,15 +48,32 @@ struct WarmRestartCheck
     bool    checkRestartReadyState;
     bool    noFreeze;
     bool    skipPendingTaskCheck;
+    bool    dumpPendingTasks;
+};
+
+class SwitchOrch;
+
+// Wakes the main thread up once the notification thread has queued ASIC/SDK
+// health events, so the flush timer is only armed from the main thread
+class AsicSdkHealthEventReady : public Executor
+{
+public:
+    AsicSdkHealthEventReady(SwitchOrch *orch);
+
+    void notify() { static_cast<swss::SelectableEvent *>(getSelectable())->notify(); }
+    void execute() override;
 };
 
 class SwitchOrch : public Orch
 {
+    friend class AsicSdkHealthEventReady;
+
 public:
     SwitchOrch(swss::DBConnector *db, std::vector<TableConnector>& connectors, TableConnector switchTable);
     bool checkRestartReady() { return m_warmRestartCheck.checkRestartReadyState; }
     bool checkRestartNoFreeze() { return m_warmRestartCheck.noFreeze; }
     bool skipPendingTaskCheck() { return m_warmRestartCheck.skipPendingTaskCheck; }
+    bool dumpPendingTasksOnCheck() { return m_warmRestartCheck.dumpPendingTasks; }
     void checkRestartReadyDone() { m_warmRestartCheck.checkRestartReadyState = false; }
     void restartCheckReply(const std::string &op, const std::string &data, std::vector<swss::FieldValueTuple> &values);
     bool setAgingFDB(uint32_t sec);
@@ -73,6 +97,8 @@ public:
                                     sai_switch_asic_sdk_health_category_t category,
                                     sai_switch_health_data_t data,
                                     const sai_u8_list_t &description);
+    // Record every queued ASIC/SDK health event right away, on the notification thread before orchagent exits
+    void flushPendingAsicSdkHealthEvents();
 
     inline bool isFatalEventReceived() const
         {
@@ -191,9 +217,36 @@ private:
     std::set<sai_switch_attr_t> m_supportedAsicSdkHealthEventAttributes;
     std::string m_eliminateEventsSha;
     swss::SelectableTimer* m_eliminateEventsTimer = nullptr;
-    uint32_t m_fatalEventCount = 0;
+    std::atomic<uint32_t> m_fatalEventCount{0};
+
+    // Events are queued by the notification thread and recorded to STATE_DB
+    // by the flush timer on the main thread, at most
+    // ASIC_SDK_HEALTH_EVENT_FLUSH_BATCH_SIZE of them per pipelined batch.
+    // m_asicSdkHealthEventTable is only used by the notification thread.
+    struct AsicSdkHealthEvent
+    {
+        std::string key;
+        std::string severity;
+        std::vector<swss::FieldValueTuple> values;
+    };
+    std::unique_ptr<swss::RedisPipeline> m_asicSdkHealthEventPipeline;
+    std::unique_ptr<swss::Table> m_asicSdkHealthEventWriter;
+    // Guards the pending events, held while they are written
+    std::mutex m_asicSdkHealthEventMutex;
+    std::deque<AsicSdkHealthEvent> m_pendingAsicSdkHealthEvents;
+    AsicSdkHealthEventReady* m_asicSdkHealthEventReady = nullptr;
+    swss::SelectableTimer* m_asicSdkHealthEventFlushTimer = nullptr;
+
+    // max_events of the SUPPRESS_ASIC_SDK_HEALTH_EVENT severities, kept from
+    // the CONFIG_DB updates and passed to the elimination script
+    std::map<std::string, uint32_t> m_asicSdkHealthEventMaxEvents;
+    // Severities to check on the next elimination, with events recorded or
+    // max_events changed since the last one
+    std::set<std::string> m_asicSdkHealthEventSeveritiesToEliminate;
 
     void initAsicSdkHealthEventNotification();
+    void flushAsicSdkHealthEvents();
+    void eliminateAsicSdkHealthEvents();
     void registerAsicSdkHealthEventCategories(sai_switch_attr_t saiSeverity, const std::string &severityString, const std::string &suppressed_category_list="", bool isInitializing=false);
 
     // Switch hash SAI defaults
@@ -212,7 +265,7 @@ private:
 
     // Information contained in the request from
     // external program for orchagent pre-shutdown state check
-    WarmRestartCheck m_warmRestartCheck = {false, false, false};
+    WarmRestartCheck m_warmRestartCheck = {false, false, false, false};
 
     // Switch OA capabilities
     SwitchCapabilities swCap;
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+
+#include "table.h"
+
+/*
+ * Pending task store of a consumer.
+ *
+ * SyncMap keeps the interface and semantics of the std::multimap it replaces:
+ * multiple KeyOpFieldsValuesTuple may exist for one key (e.g. DEL and SET),
+ * entries of the same key are adjacent and kept in insertion order, and
+ * iterators stay valid until the element they point to is erased.
+ *
+ * Entries are stored in a node list, indexed by key. Two index flavours exist:
+ *  - Ordered (default): keys are iterated in ascending order, exactly like
+ *    the multimap.
+ *  - Hashed: keys are iterated in the order they were first added and the
+ *    index is a hash table, so adding and removing a key costs one hash
+ *    lookup instead of an ordered tree traversal with string compares. Hot
+ *    tables whose doTask does not depend on key order can opt in.
+ */
+class SyncMap
+{
+public:
+    enum class Mode
+    {
+        Ordered,
+        Hashed
+    };
+
+    typedef std::string key_type;
+    typedef swss::KeyOpFieldsValuesTuple mapped_type;
+    typedef std::pair<const std::string, swss::KeyOpFieldsValuesTuple> value_type;
+
+private:
+    typedef std::list<value_type> Storage;
+
+public:
+    typedef Storage::iterator iterator;
+    typedef Storage::const_iterator const_iterator;
+    typedef Storage::reverse_iterator reverse_iterator;
+    typedef Storage::const_reverse_iterator const_reverse_iterator;
+    typedef Storage::size_type size_type;
+
+    SyncMap() = default;
+
+    SyncMap(const SyncMap&) = delete;
+    SyncMap& operator=(const SyncMap&) = delete;
+
+    Mode getMode() const { return m_mode; }
+
+    /* The index flavour can only be changed while the store is empty */
+    void setMode(Mode mode)
+    {
+        if (!empty())
+        {
+            throw std::logic_error("SyncMap mode can only be changed when empty");
+        }
+        m_mode = mode;
+    }
+
+    iterator begin() { return m_storage.begin(); }
+    iterator end() { return m_storage.end(); }
+    const_iterator begin() const { return m_storage.begin(); }
+    const_iterator end() const { return m_storage.end(); }
+    const_iterator cbegin() const { return m_storage.cbegin(); }
+    const_iterator cend() const { return m_storage.cend(); }
+    reverse_iterator rbegin() { return m_storage.rbegin(); }
+    reverse_iterator rend() { return m_storage.rend(); }
+    const_reverse_iterator rbegin() const { return m_storage.rbegin(); }
+    const_reverse_iterator rend() const { return m_storage.rend(); }
+
+    size_type size() const { return m_storage.size(); }
+    bool empty() const { return m_storage.empty(); }
+
+    void clear()
+    {
+        m_storage.clear();
+        m_ordered.clear();
+        m_hashed.clear();
+    }
+
+    /* Insert at the end of the entries with the same key, like multimap::emplace */
+    template <typename K, typename V>
+    iterator emplace(K &&key, V &&value)
+    {
+        std::string k(std::forward<K>(key));
+
+        Slot *slot = findSlot(k);
+        if (slot)
+        {
+            auto pos = std::next(slot->first, static_cast<std::ptrdiff_t>(slot->count));
+            auto it = m_storage.emplace(pos, std::piecewise_construct,
+                                        std::forward_as_tuple(std::move(k)), std::forward_as_tuple(std::forward<V>(value)));
+            slot->count++;
+            return it;
+        }
+
+        if (m_mode == Mode::Hashed)
+        {
+            auto it = m_storage.emplace(m_storage.end(), std::piecewise_construct,
+                                        std::forward_as_tuple(k), std::forward_as_tuple(std::forward<V>(value)));
+            m_hashed.emplace(std::move(k), Slot{it, 1});
+            return it;
+        }
+
+        auto next = m_ordered.upper_bound(k);
+        auto pos = next == m_ordered.end() ? m_storage.end() : next->second.first;
+        auto it = m_storage.emplace(pos, std::piecewise_construct,
+                                    std::forward_as_tuple(k), std::forward_as_tuple(std::forward<V>(value)));
+        m_ordered.emplace_hint(next, std::move(k), Slot{it, 1});
+        return it;
+    }
+
+    template <typename P>
+    iterator emplace(P &&pair)
+    {
+        return emplace(std::forward<P>(pair).first, std::forward<P>(pair).second);
+    }
+
+    iterator insert(const value_type &value)
+    {
+        return emplace(value.first, value.second);
+    }
+
+    /*
+     * Replace all entries of the key by a single entry, in place when the key
+     * already exists, so a DEL overriding pending tasks keeps its position.
+     */
+    template <typename V>
+    iterator replace(const std::string &key, V &&value)
+    {
+        Slot *slot = findSlot(key);
+        if (!slot)
+        {
+            return emplace(key, std::forward<V>(value));
+        }
+
+        auto first = slot->first;
+        m_storage.erase(std::next(first), std::next(first, static_cast<std::ptrdiff_t>(slot->count)));
+        slot->count = 1;
+        first->second = std::forward<V>(value);
+        return first;
+    }
+
+    iterator find(const std::string &key)
+    {
+        Slot *slot = findSlot(key);
+        return slot ? slot->first : m_storage.end();
+    }
+
+    const_iterator find(const std::string &key) const
+    {
+        const Slot *slot = const_cast<SyncMap *>(this)->findSlot(key);
+        return slot ? const_iterator(slot->first) : m_storage.cend();
+    }
+
+    size_type count(const std::string &key) const
+    {
+        const Slot *slot = const_cast<SyncMap *>(this)->findSlot(key);
+        return slot ? slot->count : 0;
+    }
+
+    std::pair<iterator, iterator> equal_range(const std::string &key)
+    {
+        Slot *slot = findSlot(key);
+        if (!slot)
+        {
+            return std::make_pair(m_storage.end(), m_storage.end());
+        }
+        return std::make_pair(slot->first, std::next(slot->first, static_cast<std::ptrdiff_t>(slot->count)));
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        Slot *slot = findSlot(pos->first);
+        if (slot)
+        {
+            if (--slot->count == 0)
+            {
+                eraseSlot(pos->first);
+            }
+            else if (const_iterator(slot->first) == pos)
+            {
+                slot->first = std::next(slot->first);
+            }
+        }
+        return m_storage.erase(pos);
+    }
+
+    iterator erase(iterator pos)
+    {
+        return erase(const_iterator(pos));
+    }
+
+    size_type erase(const std::string &key)
+    {
+        Slot *slot = findSlot(key);
+        if (!slot)
+        {
+            return 0;
+        }
+
+        size_type n = slot->count;
+        auto first = slot->first;
+        auto last = std::next(first, static_cast<std::ptrdiff_t>(n));
+        eraseSlot(key);
+        m_storage.erase(first, last);
+        return n;
+    }
+
+private:
+    struct Slot
+    {
+        iterator first;
+        size_type count;
+    };
+
+    Slot *findSlot(const std::string &key)
+    {
+        if (m_mode == Mode::Hashed)
+        {
+            auto it = m_hashed.find(key);
+            return it == m_hashed.end() ? nullptr : &it->second;
+        }
+
+        auto it = m_ordered.find(key);
+        return it == m_ordered.end() ? nullptr : &it->second;
+    }
+
+    void eraseSlot(const std::string &key)
+    {
+        if (m_mode == Mode::Hashed)
+        {
+            m_hashed.erase(key);
+        }
+        else
+        {
+            m_ordered.erase(key);
+        }
+    }
+
+    Mode m_mode = Mode::Ordered;
+    Storage m_storage;
+    std::map<std::string, Slot> m_ordered;
+    std::unordered_map<std::string, Slot> m_hashed;
+};
@@ -0,0 +1,17 @@
+-- KEYS - None
+-- ARGV[1] - SCAN cursor
+-- ARGV[2] - MATCH pattern of the table keys
+-- ARGV[3] - COUNT hint of the page size
+
+-- return { next cursor, key, { field, value, ... }, key, { ... }, ... }
+-- a key deleted since the scan comes with an empty hash
+
+local page = redis.call('SCAN', ARGV[1], 'MATCH', ARGV[2], 'COUNT', ARGV[3])
+
+local ret = { page[1] }
+for _, key in ipairs(page[2]) do
+    table.insert(ret, key)
+    table.insert(ret, redis.call('HGETALL', key))
+end
+
+return ret
@@ -0,0 +1,87 @@
+#include "tablescanner.h"
+#include "redisreply.h"
+#include "redisapi.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+// SCAN MATCH takes a glob pattern
+static string escapeGlob(const string &s)
+{
+    string out;
+    for (char c : s)
+    {
+        if (c == '*' || c == '?' || c == '[' || c == ']' || c == '\\')
+        {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+static string replyString(const redisReply *r)
+{
+    return string(r->str, r->len);
+}
+
+TableScanner::TableScanner(const DBConnector *db, const string &tableName, const string &separator, size_t count) :
+    m_db(db->newConnector(0)),
+    m_prefix(tableName + separator),
+    m_pattern(escapeGlob(m_prefix) + "*"),
+    m_count(to_string(count))
+{
+    string script = loadLuaScript(TABLE_SCAN_LUA_SCRIPT);
+    m_sha = loadRedisScript(m_db.get(), script);
+}
+
+bool TableScanner::next(deque<KeyOpFieldsValuesTuple> &entries)
+{
+    // A page may be empty while the cursor still goes on
+    while (!m_done)
+    {
+        RedisCommand command;
+        command.format("EVALSHA %s 0 %s %s %s",
+                       m_sha.c_str(), m_cursor.c_str(), m_pattern.c_str(), m_count.c_str());
+        RedisReply reply(m_db.get(), command, REDIS_REPLY_ARRAY);
+        auto r = reply.getContext();
+
+        if (r->elements == 0 || r->element[0]->type != REDIS_REPLY_STRING)
+        {
+            throw runtime_error("Unexpected reply to the scan of " + m_prefix);
+        }
+        m_cursor = replyString(r->element[0]);
+        m_done = m_cursor == "0";
+
+        size_t added = 0;
+        for (size_t i = 1; i + 1 < r->elements; i += 2)
+        {
+            auto key = r->element[i];
+            auto hash = r->element[i + 1];
+
+            // Deleted since the scan
+            if (hash->type != REDIS_REPLY_ARRAY || hash->elements == 0)
+            {
+                continue;
+            }
+
+            KeyOpFieldsValuesTuple kco;
+            kfvKey(kco) = replyString(key).substr(m_prefix.size());
+            kfvOp(kco) = SET_COMMAND;
+            for (size_t j = 0; j + 1 < hash->elements; j += 2)
+            {
+                kfvFieldsValues(kco).emplace_back(replyString(hash->element[j]), replyString(hash->element[j + 1]));
+            }
+            entries.push_back(std::move(kco));
+            added++;
+        }
+
+        if (added > 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
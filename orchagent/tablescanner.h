@@ -0,0 +1,42 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "dbconnector.h"
+#include "table.h"
+
+#define TABLE_SCAN_COUNT_DEFAULT    1000
+#define TABLE_SCAN_LUA_SCRIPT       "table_scan.lua"
+
+/*
+ * Streams the content of a Redis table in batches. Each batch is one SCAN
+ * page of keys along with their HGETALL, read by table_scan.lua in a single
+ * round trip. Unlike getKeys() followed by a get() per key, neither the full
+ * key list nor a round trip per key is needed, the caller hands each batch
+ * over before reading the next one.
+ *
+ * The scanner reads on a DB connection of its own, so tables can be read
+ * from several threads. SCAN may return a key twice, batches must be merged
+ * by key, as addToSync() does. Redis errors are thrown as by swss::RedisReply.
+ */
+class TableScanner
+{
+public:
+    TableScanner(const swss::DBConnector *db, const std::string &tableName, const std::string &separator,
+                 size_t count = TABLE_SCAN_COUNT_DEFAULT);
+
+    /* Append the next batch of entries as SET tasks, returns false once the table is exhausted */
+    bool next(std::deque<swss::KeyOpFieldsValuesTuple> &entries);
+
+private:
+    std::unique_ptr<swss::DBConnector> m_db;
+    std::string m_sha;
+    std::string m_prefix;
+    std::string m_pattern;
+    std::string m_count;
+
+    std::string m_cursor = "0";
+    bool m_done = false;
+};
@@ -23,6 +23,7 @@ extern sai_next_hop_api_t* sai_next_hop_api;
 extern sai_object_id_t  gVirtualRouterId;
 extern sai_object_id_t  gUnderlayIfId;
 extern sai_object_id_t  gSwitchId;
+extern size_t           gMaxBulkSize;
 extern PortsOrch*       gPortsOrch;
 extern CrmOrch*         gCrmOrch;
 extern QosOrch*         gQosOrch;
@@ -31,6 +32,7 @@ TunnelDecapOrch::TunnelDecapOrch(
     DBConnector *appDb, DBConnector *stateDb,
     DBConnector *configDb, const vector<string> &tableNames)
     : Orch(appDb, tableNames),
+      termBulker(sai_tunnel_api, gSwitchId, gMaxBulkSize, SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY),
       stateTunnelDecapTable(make_unique<Table>(stateDb, STATE_TUNNEL_DECAP_TABLE_NAME)),
       stateTunnelDecapTermTable(make_unique<Table>(stateDb, STATE_TUNNEL_DECAP_TERM_TABLE_NAME))
 {
@@ -510,7 +512,13 @@ void TunnelDecapOrch::doDecapTunnelTermTask(Consumer &consumer)
 
                 if (tunnel_exists)
                 {
-                    if (!addDecapTunnelTermEntry(tunnel_name, src_ip_str, dst_ip_str, term_type, subnet_type))
+                    auto post = [key](bool success) {
+                        if (!success)
+                        {
+                            SWSS_LOG_ERROR("%s: failed to add tunnel decap term to ASIC_DB.", key.c_str());
+                        }
+                    };
+                    if (!addDecapTunnelTermEntry(tunnel_name, src_ip_str, dst_ip_str, term_type, subnet_type, post))
                     {
                         SWSS_LOG_ERROR("%s: failed to add tunnel decap term to ASIC_DB.", key.c_str());
                     }
@@ -526,11 +534,18 @@ void TunnelDecapOrch::doDecapTunnelTermTask(Consumer &consumer)
         {
             if (tunnel_exists)
             {
-                if (removeDecapTunnelTermEntry(tunnel_name, dst_ip_str))
-                {
-                    RemoveTunnelIfNotReferenced(tunnel_name);
-                }
-                else
+                auto post = [this, key, tunnel_name](bool success) {
+                    if (!success)
+                    {
+                        SWSS_LOG_ERROR("Failed to remove tunnel decap term %s from ASIC_DB.", key.c_str());
+                    }
+                    // The tunnel may be gone with the earlier terms of the same flush
+                    else if (tunnelTable.find(tunnel_name) != tunnelTable.end())
+                    {
+                        RemoveTunnelIfNotReferenced(tunnel_name);
+                    }
+                };
+                if (!removeDecapTunnelTermEntry(tunnel_name, dst_ip_str, post))
                 {
                     SWSS_LOG_ERROR("Failed to remove tunnel decap term %s from ASIC_DB.", key.c_str());
                 }
@@ -548,6 +563,8 @@ void TunnelDecapOrch::doDecapTunnelTermTask(Consumer &consumer)
 
         it = consumer.m_toSync.erase(it);
     }
+
+    flushDecapTunnelTermEntries();
 }
 
 void TunnelDecapOrch::doSubnetDecapTask(Consumer &consumer)
@@ -877,7 +894,8 @@ bool TunnelDecapOrch::addDecapTunnel(
 
 /**
  * Function Description:
- *    @brief adds a decap tunnel termination entry to ASIC_DB
+ *    @brief queues a decap tunnel termination entry to be added to ASIC_DB
+ *           by flushDecapTunnelTermEntries()
  *
  * Arguments:
  *    @param[in] tunnel_name - key of the tunnel from APP_DB
@@ -885,16 +903,18 @@ bool TunnelDecapOrch::addDecapTunnel(
  *    @param[in] dst_ip_str - destination ip prefix of the decap term entry
  *    @param[in] term_type - P2P or P2MP. Other types (MP2P and MP2MP) not supported yet
  *    @param[in] subnet_type - the subnet type
+ *    @param[in] post - run with the result of the creation on flush
  *
  * Return Values:
- *    @return true on success and false if there's an error
+ *    @return true if the entry is queued or exists and false if there's an error
  */
 bool TunnelDecapOrch::addDecapTunnelTermEntry(
     std::string tunnel_name,
     std::string src_ip_str,
     std::string dst_ip_str,
     TunnelTermType term_type,
-    std::string subnet_type)
+    std::string subnet_type,
+    std::function<void(bool)> post)
 {
     SWSS_LOG_ENTER();
 
@@ -913,6 +933,10 @@ bool TunnelDecapOrch::addDecapTunnelTermEntry(
     if (tunnel.tunnel_term_info.find(dst_ip) != tunnel.tunnel_term_info.end())
     {
         SWSS_LOG_NOTICE("Tunnel decap term entry %s already exists.", dst_ip_str.c_str());
+        if (post)
+        {
+            post(true);
+        }
         return true;
     }
 
@@ -974,34 +998,115 @@ bool TunnelDecapOrch::addDecapTunnelTermEntry(
         tunnel_table_entry_attrs.push_back(attr);
     }
 
-    // create the tunnel table entry
-    sai_object_id_t tunnel_term_table_entry_id;
-    sai_status_t status = sai_tunnel_api->create_tunnel_term_table_entry(&tunnel_term_table_entry_id, gSwitchId, (uint32_t)tunnel_table_entry_attrs.size(), tunnel_table_entry_attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to create tunnel decap term entry %s.", dst_ip.to_string().c_str());
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_TUNNEL, status);
-        if (handle_status != task_success)
-        {
-            return parseHandleSaiStatusFailure(handle_status);
-        }
-    }
-
+    // queue the tunnel table entry creation, the term is counted from now on
     tunnel.tunnel_term_info[dst_ip] = {
-        tunnel_term_table_entry_id, // tunnel_term_id
+        SAI_NULL_OBJECT_ID,         // tunnel_term_id, set on flush
         src_ip_str,                 // src_ip
         dst_ip_str,                 // dst_ip
         term_type,                  // tunnel_type
         subnet_type                 // subnet_type
     };
     increaseTunnelRefCount(tunnel_name);
-    setDecapTunnelTermStatus(tunnel_name, dst_ip_str, src_ip_str, term_type, subnet_type);
 
-    SWSS_LOG_NOTICE("Created tunnel decap term entry %s.", dst_ip_str.c_str());
+    termBulkOps.push_back({tunnel_name, tunnel.tunnel_term_info[dst_ip], true, SAI_STATUS_NOT_EXECUTED, post, tunnel_table_entry_attrs});
+    auto &op = termBulkOps.back();
+    termBulker.create_entry(&op.term.tunnel_term_id, &op.status, (uint32_t)op.attrs.size(), op.attrs.data());
 
     return true;
 }
 
+/**
+ * Function Description:
+ *    @brief creates and removes the queued decap term entries in bulk, and
+ *           updates the decap terms of the tunnels with the results
+ */
+void TunnelDecapOrch::flushDecapTunnelTermEntries()
+{
+    SWSS_LOG_ENTER();
+
+    if (termBulkOps.empty())
+    {
+        return;
+    }
+
+    termBulker.flush();
+
+    // Removals are flushed ahead of creations, their results are handled first too
+    vector<pair<std::function<void(bool)>, bool>> posts;
+    for (bool create : {false, true})
+    {
+        for (auto &op : termBulkOps)
+        {
+            if (op.create != create)
+            {
+                continue;
+            }
+
+            auto &term = op.term;
+            IpPrefix dst_ip{term.dst_ip};
+            bool success = true;
+
+            if (is_bulk_unsupported(op.status))
+            {
+                op.status = op.create ?
+                    sai_tunnel_api->create_tunnel_term_table_entry(&term.tunnel_term_id, gSwitchId, (uint32_t)op.attrs.size(), op.attrs.data()) :
+                    sai_tunnel_api->remove_tunnel_term_table_entry(term.tunnel_term_id);
+            }
+
+            if (op.status != SAI_STATUS_SUCCESS)
+            {
+                task_process_status handle_status;
+                if (op.create)
+                {
+                    SWSS_LOG_ERROR("Failed to create tunnel decap term entry %s.", term.dst_ip.c_str());
+                    handle_status = handleSaiCreateStatus(SAI_API_TUNNEL, op.status);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Failed to remove tunnel table entry: %" PRIu64, term.tunnel_term_id);
+                    handle_status = handleSaiRemoveStatus(SAI_API_TUNNEL, op.status);
+                }
+                success = (handle_status == task_success);
+            }
+
+            auto &tunnel = tunnelTable[op.tunnel_name];
+            if (op.create && success)
+            {
+                tunnel.tunnel_term_info[dst_ip].tunnel_term_id = term.tunnel_term_id;
+                setDecapTunnelTermStatus(op.tunnel_name, term.dst_ip, term.src_ip, term.term_type, term.subnet_type);
+                SWSS_LOG_NOTICE("Created tunnel decap term entry %s.", term.dst_ip.c_str());
+            }
+            else if (op.create)
+            {
+                tunnel.tunnel_term_info.erase(dst_ip);
+                decreaseTunnelRefCount(op.tunnel_name);
+            }
+            else if (success)
+            {
+                removeDecapTunnelTermStatus(op.tunnel_name, term.dst_ip);
+                SWSS_LOG_NOTICE("Removed decap tunnel term entry with ip address: %s.", term.dst_ip.c_str());
+            }
+            else
+            {
+                tunnel.tunnel_term_info[dst_ip] = term;
+                increaseTunnelRefCount(op.tunnel_name);
+            }
+
+            if (op.post)
+            {
+                posts.emplace_back(op.post, success);
+            }
+        }
+    }
+    termBulkOps.clear();
+
+    // The posts may remove tunnels, run once all the terms are updated
+    for (auto &post : posts)
+    {
+        post.first(post.second);
+    }
+}
+
 /**
  * Function Description:
  *    @brief sets attributes for a tunnel
@@ -1138,14 +1243,26 @@ bool TunnelDecapOrch::setIpAttribute(string tunnel_name, string src_ip_str)
     TunnelEntry *tunnel_info = &tunnel_it->second;
     map<swss::IpPrefix, TunnelTermEntry> decap_terms_copy(tunnel_info->tunnel_term_info.begin(), tunnel_info->tunnel_term_info.end());
 
+    bool result = true;
+    auto post = [&result](bool success) {
+        result = result && success;
+    };
+
+    // The terms are removed in bulk, then added back in bulk
     for (auto it = decap_terms_copy.begin(); it != decap_terms_copy.end(); ++it)
     {
         TunnelTermEntry &term_entry = it->second;
-        if (!removeDecapTunnelTermEntry(tunnel_name, term_entry.dst_ip))
+        if (!removeDecapTunnelTermEntry(tunnel_name, term_entry.dst_ip, post))
         {
-            return false;
+            result = false;
+            break;
         }
     }
+    flushDecapTunnelTermEntries();
+    if (!result)
+    {
+        return false;
+    }
 
     for (auto it = decap_terms_copy.begin(); it != decap_terms_copy.end(); ++it)
     {
@@ -1153,14 +1270,16 @@ bool TunnelDecapOrch::setIpAttribute(string tunnel_name, string src_ip_str)
         {
             TunnelTermEntry &term_entry = it->second;
             // add the decap term with new src ip
-            if (!addDecapTunnelTermEntry(tunnel_name, src_ip_str, term_entry.dst_ip, term_entry.term_type, term_entry.subnet_type))
+            if (!addDecapTunnelTermEntry(tunnel_name, src_ip_str, term_entry.dst_ip, term_entry.term_type, term_entry.subnet_type, post))
             {
-                return false;
+                result = false;
+                break;
             }
         }
     }
+    flushDecapTunnelTermEntries();
 
-    return true;
+    return result;
 }
 
 /**
@@ -1216,19 +1335,20 @@ bool TunnelDecapOrch::removeDecapTunnel(string table_name, string key)
 
 /**
  * Function Description:
- *    @brief remove decap tunnel termination entry
+ *    @brief queue the removal of a decap tunnel termination entry, removed
+ *           by flushDecapTunnelTermEntries()
  *
  * Arguments:
  *    @param[in] tunnel_name - tunnel name
  *    @param[in] dst_ip - destination ip address of the decap term entry
+ *    @param[in] post - run with the result of the removal on flush
  *
  * Return Values:
- *    @return true on success and false if there's an error
+ *    @return true if the removal is queued and false if there's an error
  */
-bool TunnelDecapOrch::removeDecapTunnelTermEntry(std::string tunnel_name, std::string dst_ip_str)
+bool TunnelDecapOrch::removeDecapTunnelTermEntry(std::string tunnel_name, std::string dst_ip_str,
+                                                 std::function<void(bool)> post)
 {
-    sai_status_t status;
-
     auto tunnel_it = tunnelTable.find(tunnel_name);
     if (tunnel_it == tunnelTable.end())
     {
@@ -1243,23 +1363,26 @@ bool TunnelDecapOrch::removeDecapTunnelTermEntry(std::string tunnel_name, std::s
         SWSS_LOG_ERROR("Tunnel decap term entry %s does not exist.", dst_ip_str.c_str());
         return false;
     }
-    auto &decap_term = term_it->second;
 
-    status = sai_tunnel_api->remove_tunnel_term_table_entry(decap_term.tunnel_term_id);
-    if (status != SAI_STATUS_SUCCESS)
+    if (term_it->second.tunnel_term_id == SAI_NULL_OBJECT_ID)
     {
-        SWSS_LOG_ERROR("Failed to remove tunnel table entry: %" PRIu64, decap_term.tunnel_term_id);
-        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_TUNNEL, status);
-        if (handle_status != task_success)
+        // The creation is still queued, it's flushed to have the entry to remove
+        flushDecapTunnelTermEntries();
+        term_it = tunnel_it->second.tunnel_term_info.find(dst_ip);
+        if (term_it == tunnel_it->second.tunnel_term_info.end())
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_ERROR("Tunnel decap term entry %s does not exist.", dst_ip_str.c_str());
+            return false;
         }
     }
 
+    // queue the tunnel table entry removal, the term isn't counted from now on
+    termBulkOps.push_back({tunnel_name, term_it->second, false, SAI_STATUS_NOT_EXECUTED, post, {}});
+    auto &op = termBulkOps.back();
+    termBulker.remove_entry(&op.status, op.term.tunnel_term_id);
+
     tunnel_it->second.tunnel_term_info.erase(term_it);
     decreaseTunnelRefCount(tunnel_name);
-    removeDecapTunnelTermStatus(tunnel_name, dst_ip_str);
-    SWSS_LOG_NOTICE("Removed decap tunnel term entry with ip address: %s.", dst_ip_str.c_str());
     return true;
 }
 
@@ -1503,17 +1626,29 @@ void TunnelDecapOrch::processUnhandledDecapTunnelTerms(const string &tunnel_name
     auto tunnel_it = unhandledDecapTerms.find(tunnel_name);
     if (tunnel_it != unhandledDecapTerms.end())
     {
-        for (auto term_it = tunnel_it->second.begin(); term_it != tunnel_it->second.end();)
+        // The terms are created in bulk, the ones created are no longer unhandled
+        vector<IpPrefix> added;
+        for (auto term_it = tunnel_it->second.begin(); term_it != tunnel_it->second.end(); ++term_it)
         {
             auto &term = term_it->second;
-            if (addDecapTunnelTermEntry(tunnel_name, term.src_ip, term.dst_ip, term.term_type, term.subnet_type))
-            {
-                term_it = tunnel_it->second.erase(term_it);
-            }
-            else
-            {
-                ++term_it;
-            }
+            IpPrefix dst_ip = term_it->first;
+            auto post = [&added, dst_ip](bool success) {
+                if (success)
+                {
+                    added.push_back(dst_ip);
+                }
+            };
+            addDecapTunnelTermEntry(tunnel_name, term.src_ip, term.dst_ip, term.term_type, term.subnet_type, post);
+        }
+        flushDecapTunnelTermEntries();
+
+        for (const auto &dst_ip : added)
+        {
+            tunnel_it->second.erase(dst_ip);
+        }
+        if (tunnel_it->second.empty())
+        {
+            unhandledDecapTerms.erase(tunnel_it);
         }
     }
 }
@@ -2,9 +2,12 @@
 #define SWSS_TUNNELDECAPORCH_H
 
 #include <arpa/inet.h>
+#include <deque>
+#include <functional>
 #include <unordered_set>
 
 #include "orch.h"
+#include "bulker.h"
 #include "sai.h"
 #include "ipaddress.h"
 #include "ipaddresses.h"
@@ -69,6 +72,19 @@ typedef std::map<swss::IpAddress, NexthopTunnel> Nexthop;
 /* Tunnel to nexthop maps */
 typedef std::map<std::string, Nexthop> TunnelNhs;
 
+/* Decap term create or remove queued in the term bulker */
+struct DecapTermBulkOp
+{
+    std::string                 tunnel_name;
+    TunnelTermEntry             term;
+    bool                        create;
+    sai_status_t                status;
+    // Run with the result once the op is flushed, may be empty
+    std::function<void(bool)>   post;
+    // Creation attributes, for a single create where bulk isn't supported
+    std::vector<sai_attribute_t> attrs;
+};
+
 /* unhandled decap term table */
 typedef std::map<std::string, std::map<swss::IpPrefix, TunnelTermEntry>> UnhandledDecapTermTable;
 
@@ -92,6 +108,12 @@ private:
     TunnelTable tunnelTable;
     TunnelNhs   tunnelNhs;
     UnhandledDecapTermTable unhandledDecapTerms;
+
+    /* Decap terms are created and removed in bulk, a term is in tunnel_term_info
+     * from the time its creation is queued until its removal is, see
+     * flushDecapTunnelTermEntries() */
+    ObjectBulker<sai_tunnel_api_t> termBulker;
+    std::deque<DecapTermBulkOp> termBulkOps;
     std::unique_ptr<swss::Table> stateTunnelDecapTable = nullptr;
     std::unique_ptr<swss::Table> stateTunnelDecapTermTable = nullptr;
     SubnetDecapConfig subnetDecapConfig = {
@@ -108,8 +130,11 @@ private:
     bool removeDecapTunnel(std::string table_name, std::string key);
 
     bool addDecapTunnelTermEntry(std::string tunnel_name, std::string src_ip_str,
-                                 std::string dst_ip_str, TunnelTermType term_type, std::string subnet_type);
-    bool removeDecapTunnelTermEntry(std::string tunnel_name, std::string dst_ip_str);
+                                 std::string dst_ip_str, TunnelTermType term_type, std::string subnet_type,
+                                 std::function<void(bool)> post = nullptr);
+    bool removeDecapTunnelTermEntry(std::string tunnel_name, std::string dst_ip_str,
+                                    std::function<void(bool)> post = nullptr);
+    void flushDecapTunnelTermEntries();
 
     void addUnhandledDecapTunnelTerm(const std::string &tunnel_name, const std::string &src_ip_str,
                                      const std::string &dst_ip_str, TunnelTermType term_type,
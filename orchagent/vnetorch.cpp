@@ -46,6 +46,7 @@ extern MacAddress gVxlanMacAddress;
 extern BfdOrch *gBfdOrch;
 extern SwitchOrch *gSwitchOrch;
 extern TunnelDecapOrch *gTunneldecapOrch;
+extern size_t gMaxBulkSize;
 /*
  * VRF Modeling and VNetVrf class definitions
  */
@@ -762,6 +763,47 @@ sai_object_id_t VNetRouteOrch::getNextHopGroupId(const string& vnet, const NextH
     return syncd_nexthop_groups_[vnet][nexthops].next_hop_group_id;
 }
 
+void VNetRouteOrch::indexNextHopGroup(const string& vnet, const NextHopGroupKey& nexthops)
+{
+    auto& endpoint_nhgs = endpoint_nhgs_[vnet];
+    for (const auto& nh : nexthops.getNextHops())
+    {
+        endpoint_nhgs[nh].insert(nexthops);
+    }
+}
+
+vector<NextHopGroupKey> VNetRouteOrch::getEndpointNextHopGroups(const string& vnet, const NextHopKey& endpoint)
+{
+    vector<NextHopGroupKey> groups;
+
+    auto& endpoint_nhgs = endpoint_nhgs_[vnet];
+    auto it = endpoint_nhgs.find(endpoint);
+    if (it == endpoint_nhgs.end())
+    {
+        return groups;
+    }
+
+    // Groups removed since they were indexed are dropped here
+    auto& nhgs = syncd_nexthop_groups_[vnet];
+    for (auto nhg = it->second.begin(); nhg != it->second.end();)
+    {
+        if (nhgs.find(*nhg) == nhgs.end())
+        {
+            nhg = it->second.erase(nhg);
+            continue;
+        }
+        groups.push_back(*nhg);
+        nhg++;
+    }
+
+    if (it->second.empty())
+    {
+        endpoint_nhgs.erase(it);
+    }
+
+    return groups;
+}
+
 bool VNetRouteOrch::addNextHopGroup(const string& vnet, const NextHopGroupKey &nexthops, VNetVrfObject *vrf_obj, const string& monitoring,  const bool isLocalEp)
 {
     SWSS_LOG_ENTER();
@@ -871,6 +913,7 @@ bool VNetRouteOrch::addNextHopGroup(const string& vnet, const NextHopGroupKey &n
      */
     next_hop_group_entry.ref_count = 0;
     syncd_nexthop_groups_[vnet][nexthops] = next_hop_group_entry;
+    indexNextHopGroup(vnet, nexthops);
 
     return true;
 }
@@ -971,6 +1014,7 @@ bool VNetRouteOrch::createNextHopGroup(const string& vnet,
             next_hop_group_entry.active_members[nexthop] = SAI_NULL_OBJECT_ID;
         }
         syncd_nexthop_groups_[vnet][nexthops] = next_hop_group_entry;
+        indexNextHopGroup(vnet, nexthops);
     }
     else
     {
@@ -1124,6 +1168,7 @@ bool VNetRouteOrch::selectNextHopGroup(const string& vnet,
             next_hop_group_entry.next_hop_group_id = SAI_NULL_OBJECT_ID;
             next_hop_group_entry.ref_count = 0;
             syncd_nexthop_groups_[vnet][nhg_custom] = next_hop_group_entry;
+            indexNextHopGroup(vnet, nhg_custom);
         }
         nexthops_selected = nhg_custom;
         return true;
@@ -2730,68 +2775,89 @@ void VNetRouteOrch::updateVnetTunnel(const BfdUpdate& update)
 
     nexthop_info_[vnet][endpoint.ip_address].bfd_state = state;
 
-    for (auto& nhg_info_pair : syncd_nexthop_groups_[vnet])
-    {
-        NextHopGroupKey nexthops = nhg_info_pair.first;
-        NextHopGroupInfo& nhg_info = nhg_info_pair.second;
+    // when we add the first nexthop to the route, we dont create a nexthop group, we call the updateTunnelRoute with NHG with one member.
+    // when adding the 2nd, 3rd ... members we create each NH using this create_next_hop_group_member call but give it the reference of next_hop_group_id.
+    // this way we dont have to update the route, the syncd does it by itself. we only call the updateTunnelRoute to add/remove when adding or removing the
+    // route fully.
+    //
+    // Only the groups holding the endpoint are visited, the members of all of them are
+    // added or removed with one bulk call before their routes are updated.
+    vector<NextHopGroupKey> groups = getEndpointNextHopGroups(vnet, endpoint);
+    vector<sai_object_id_t> member_ids(groups.size(), SAI_NULL_OBJECT_ID);
+    vector<sai_status_t> statuses(groups.size(), SAI_STATUS_SUCCESS);
+    vector<bool> queued(groups.size(), false);
+    ObjectBulker<sai_next_hop_group_api_t> bulker(sai_next_hop_group_api, gSwitchId, gMaxBulkSize);
 
-        std::set<NextHopKey> next_hop_set = nexthops.getNextHops();
-        uint32_t seq_id = 0;
-        uint32_t nh_seq_id = 0;
-        for (auto nh: next_hop_set)
-        {
-            seq_id++;
-            if (nh == endpoint)
-            {
-                nh_seq_id = seq_id;
-                break;
-            }
-        }
+    for (size_t i = 0; i < groups.size(); i++)
+    {
+        NextHopGroupKey& nexthops = groups[i];
+        NextHopGroupInfo& nhg_info = syncd_nexthop_groups_[vnet][nexthops];
 
-        if (!nh_seq_id)
+        if (nexthops.getSize() <= 1)
         {
             continue;
         }
-        // when we add the first nexthop to the route, we dont create a nexthop group, we call the updateTunnelRoute with NHG with one member.
-        // when adding the 2nd, 3rd ... members we create each NH using this create_next_hop_group_member call but give it the reference of next_hop_group_id.
-        // this way we dont have to update the route, the syncd does it by itself. we only call the updateTunnelRoute to add/remove when adding or removing the
-        // route fully.
 
-        bool failed = false;
         if (state == SAI_BFD_SESSION_STATE_UP)
         {
-            sai_object_id_t next_hop_group_member_id = SAI_NULL_OBJECT_ID;
-            if (nexthops.getSize() > 1)
+            uint32_t seq_id = 0;
+            uint32_t nh_seq_id = 0;
+            for (const auto& nh : nexthops.getNextHops())
             {
-                // Create a next hop group member
-                vector<sai_attribute_t> nhgm_attrs;
+                seq_id++;
+                if (nh == endpoint)
+                {
+                    nh_seq_id = seq_id;
+                    break;
+                }
+            }
 
-                sai_attribute_t nhgm_attr;
-                nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-                nhgm_attr.value.oid = nhg_info.next_hop_group_id;
-                nhgm_attrs.push_back(nhgm_attr);
+            // Create a next hop group member
+            vector<sai_attribute_t> nhgm_attrs;
+
+            sai_attribute_t nhgm_attr;
+            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+            nhgm_attr.value.oid = nhg_info.next_hop_group_id;
+            nhgm_attrs.push_back(nhgm_attr);
 
-                nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-                nhgm_attr.value.oid = vrf_obj->getTunnelNextHop(endpoint);
+            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+            nhgm_attr.value.oid = vrf_obj->getTunnelNextHop(endpoint);
+            nhgm_attrs.push_back(nhgm_attr);
+
+            if (gSwitchOrch->checkOrderedEcmpEnable())
+            {
+                nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_SEQUENCE_ID;
+                nhgm_attr.value.u32 = nh_seq_id;
                 nhgm_attrs.push_back(nhgm_attr);
+            }
 
-                if (gSwitchOrch->checkOrderedEcmpEnable())
-                {
-                    nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_SEQUENCE_ID;
-                    nhgm_attr.value.u32 = nh_seq_id;
-                    nhgm_attrs.push_back(nhgm_attr);
-                }
+            bulker.create_entry(&member_ids[i], &statuses[i], (uint32_t)nhgm_attrs.size(), nhgm_attrs.data());
+            queued[i] = true;
+        }
+        else if (nhg_info.active_members.find(endpoint) != nhg_info.active_members.end())
+        {
+            bulker.remove_entry(&statuses[i], nhg_info.active_members[endpoint]);
+            queued[i] = true;
+        }
+    }
+    bulker.flush();
 
-                sai_status_t status = sai_next_hop_group_api->create_next_hop_group_member(&next_hop_group_member_id,
-                                                                                gSwitchId,
-                                                                                (uint32_t)nhgm_attrs.size(),
-                                                                                nhgm_attrs.data());
+    for (size_t i = 0; i < groups.size(); i++)
+    {
+        NextHopGroupKey& nexthops = groups[i];
+        NextHopGroupInfo& nhg_info = syncd_nexthop_groups_[vnet][nexthops];
 
-                if (status != SAI_STATUS_SUCCESS)
+        bool failed = false;
+        if (state == SAI_BFD_SESSION_STATE_UP)
+        {
+            sai_object_id_t next_hop_group_member_id = member_ids[i];
+            if (queued[i])
+            {
+                if (statuses[i] != SAI_STATUS_SUCCESS)
                 {
                     SWSS_LOG_ERROR("Failed to add next hop member to group %" PRIx64 ": %d\n",
-                                    nhg_info.next_hop_group_id, status);
-                    task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, status);
+                                    nhg_info.next_hop_group_id, statuses[i]);
+                    task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, statuses[i]);
                     if (handle_status != task_success)
                     {
                         continue;
@@ -2807,7 +2873,7 @@ void VNetRouteOrch::updateVnetTunnel(const BfdUpdate& update)
                 nhg_info.active_members[endpoint] = next_hop_group_member_id;
                 if (vnet_orch_->isVnetExecVrf())
                 {
-                    for (auto ip_pfx : syncd_nexthop_groups_[vnet][nexthops].tunnel_routes)
+                    for (auto ip_pfx : nhg_info.tunnel_routes)
                     {
                         // remove the bgp learnt route first if any exists and then add the tunnel route.
                         auto ipPrefixsubnet = ip_pfx.getSubnet();
@@ -2828,7 +2894,8 @@ void VNetRouteOrch::updateVnetTunnel(const BfdUpdate& update)
                             if (!gRouteOrch->removeRoutePrefix(ipPrefixsubnet))
                             {
                                 SWSS_LOG_ERROR("Could not remove existing bgp route for prefix: %s\n", prefixStr.c_str());
-                                return;
+                                failed = true;
+                                break;
                             }
                             SWSS_LOG_INFO("Successfully removed existing bgp route for prefix: %s\n", prefixStr.c_str());
                         }
@@ -2848,9 +2915,10 @@ void VNetRouteOrch::updateVnetTunnel(const BfdUpdate& update)
                 }
                 if (failed)
                 {
-                    // This is an unrecoverable error, Throw a LOG_ERROR and return
+                    // This is an unrecoverable error, Throw a LOG_ERROR and leave the group as it is.
+                    // The other groups still record the members created for them in the bulk.
                     SWSS_LOG_ERROR("Inconsistent hardware State. Failed to create tunnel routes.\n");
-                    return;
+                    continue;
                 }
             }
             else
@@ -2860,16 +2928,13 @@ void VNetRouteOrch::updateVnetTunnel(const BfdUpdate& update)
         }
         else
         {
-            if (nexthops.getSize() > 1 && nhg_info.active_members.find(endpoint) != nhg_info.active_members.end())
+            if (queued[i])
             {
-                sai_object_id_t nexthop_id = nhg_info.active_members[endpoint];
-                sai_status_t status = sai_next_hop_group_api->remove_next_hop_group_member(nexthop_id);
-
-                if (status != SAI_STATUS_SUCCESS)
+                if (statuses[i] != SAI_STATUS_SUCCESS)
                 {
                     SWSS_LOG_ERROR("Failed to remove next hop member %" PRIx64 " from group %" PRIx64 ": %d\n",
-                                nexthop_id, nhg_info.next_hop_group_id, status);
-                    task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, status);
+                                nhg_info.active_members[endpoint], nhg_info.next_hop_group_id, statuses[i]);
+                    task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, statuses[i]);
                     if (handle_status != task_success)
                     {
                         continue;
@@ -2894,7 +2959,7 @@ void VNetRouteOrch::updateVnetTunnel(const BfdUpdate& update)
                 {
                     if (vnet_orch_->isVnetExecVrf())
                     {
-                        for (auto ip_pfx : syncd_nexthop_groups_[vnet][nexthops].tunnel_routes)
+                        for (auto ip_pfx : nhg_info.tunnel_routes)
                         {
                             SWSS_LOG_NOTICE("Removing Vnet route for prefix : %s due to no active nexthops.\n",ip_pfx.to_string().c_str());
                             string op = DEL_COMMAND;
@@ -2904,14 +2969,12 @@ void VNetRouteOrch::updateVnetTunnel(const BfdUpdate& update)
                 }
             }
         }
-        if (!failed)
+
+        // Post configured in State DB
+        for (auto ip_pfx : nhg_info.tunnel_routes)
         {
-            // Post configured in State DB
-            for (auto ip_pfx : syncd_nexthop_groups_[vnet][nexthops].tunnel_routes)
-            {
-                string profile = vrf_obj->getProfile(ip_pfx);
-                postRouteState(vnet, ip_pfx, nexthops, profile);
-            }
+            string profile = vrf_obj->getProfile(ip_pfx);
+            postRouteState(vnet, ip_pfx, nexthops, profile);
         }
     }
 }
@@ -3047,6 +3110,7 @@ void VNetRouteOrch::updateVnetTunnelCustomMonitor(const MonitorUpdate& update)
             next_hop_group_entry.next_hop_group_id = SAI_NULL_OBJECT_ID;
             next_hop_group_entry.ref_count = 0;
             syncd_nexthop_groups_[vnet][nhg_custom] = next_hop_group_entry;
+            indexNextHopGroup(vnet, nhg_custom);
         }
     }
     auto active_nhg_size = active_nhg.getSize();
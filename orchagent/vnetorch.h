@@ -535,6 +535,8 @@ private:
     bool createNextHopGroup(const string&, NextHopGroupKey&, VNetVrfObject *vrf_obj,
                             const string& monitoring);
     NextHopGroupKey getActiveNHSet(const string&, NextHopGroupKey&, const IpPrefix& );
+    void indexNextHopGroup(const string&, const NextHopGroupKey&);
+    vector<NextHopGroupKey> getEndpointNextHopGroups(const string&, const NextHopKey&);
 
     bool selectNextHopGroup(const string&, NextHopGroupKey&, NextHopGroupKey&, const string&, const int32_t, const int32_t, IpPrefix&,
                             VNetVrfObject *vrf_obj, NextHopGroupKey&,
@@ -595,6 +597,8 @@ private:
     VNetRouteTable syncd_routes_;
     VNetNextHopObserverTable next_hop_observers_;
     std::map<std::string, VNetNextHopGroupInfoTable> syncd_nexthop_groups_;
+    // Next hop groups of each VNET by endpoint, a group is dropped on lookup once it is removed
+    std::map<std::string, std::map<NextHopKey, std::set<NextHopGroupKey>>> endpoint_nhgs_;
     std::map<std::string, VNetTunnelRouteTable> syncd_tunnel_routes_;
     std::map<std::string, bool> vnet_tunnel_route_check_directly_connected;
     BfdSessionTable bfd_sessions_;
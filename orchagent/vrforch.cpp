@@ -1,4 +1,5 @@
 #include <cassert>
+#include <deque>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -14,26 +15,35 @@
 #include "vxlanorch.h"
 #include "flowcounterrouteorch.h"
 #include "directory.h"
+#include "bulker.h"
 
 using namespace std;
 using namespace swss;
 
 extern sai_virtual_router_api_t* sai_virtual_router_api;
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 
 extern Directory<Orch*>      gDirectory;
 extern PortsOrch*            gPortsOrch;
 extern RouteOrch*            gRouteOrch;
 extern FlowCounterRouteOrch* gFlowCounterRouteOrch;
 
-bool VRFOrch::addOperation(const Request& request)
+void VRFOrch::doTask(Consumer& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    // New VRFs are created with one bulk call, addOperation() finishes them
+    bulkCreateVrfs(consumer);
+
+    Orch2::doTask(consumer);
+}
+
+void VRFOrch::getVrfAttributes(const Request& request, vector<sai_attribute_t>& attrs, uint32_t& vni)
 {
     SWSS_LOG_ENTER();
-    uint32_t vni = 0;
-    bool error = true;
 
     sai_attribute_t attr;
-    vector<sai_attribute_t> attrs;
 
     for (const auto& name: request.getAttrFieldNames())
     {
@@ -85,36 +95,141 @@ bool VRFOrch::addOperation(const Request& request)
         }
         attrs.push_back(attr);
     }
+}
+
+/*
+ * Create the virtual routers of the new VRFs of the batch with one bulk call.
+ * The tasks are left in m_toSync, addOperation() adds the VNI map and the
+ * state of the VRFs created here. A VRF the bulk call failed to create is
+ * created again by addOperation(), which handles the SAI status.
+ */
+void VRFOrch::bulkCreateVrfs(Consumer& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    ObjectBulker<sai_virtual_router_api_t> bulker(sai_virtual_router_api, gSwitchId, gMaxBulkSize);
+    VRFRequest request;
+    unordered_set<string> deleting;
+    vector<string> names;
+    // Written by the bulker on flush, kept in place until then
+    deque<sai_object_id_t> router_ids;
+    deque<sai_status_t> statuses;
+
+    for (const auto& it: consumer.m_toSync)
+    {
+        const auto& task = it.second;
+
+        // A VRF removed and added back in the batch is left to the tasks
+        if (kfvOp(task) == DEL_COMMAND)
+        {
+            deleting.insert(it.first);
+            continue;
+        }
+
+        if (kfvOp(task) != SET_COMMAND || deleting.count(it.first))
+        {
+            continue;
+        }
+
+        try
+        {
+            request.parse(task);
+        }
+        catch (const std::exception&)
+        {
+            // Reported by Orch2::doTask()
+            request.clear();
+            continue;
+        }
+
+        const std::string& vrf_name = request.getKeyString(0);
+        if (vrf_table_.find(vrf_name) != std::end(vrf_table_) || created_vrfs_.count(vrf_name))
+        {
+            request.clear();
+            continue;
+        }
+
+        uint32_t vni = 0;
+        vector<sai_attribute_t> attrs;
+        getVrfAttributes(request, attrs, vni);
+
+        router_ids.push_back(SAI_NULL_OBJECT_ID);
+        statuses.push_back(SAI_STATUS_NOT_EXECUTED);
+        bulker.create_entry(&router_ids.back(), &statuses.back(),
+                            static_cast<uint32_t>(attrs.size()), attrs.data());
+        names.push_back(vrf_name);
+        request.clear();
+    }
+
+    if (names.empty())
+    {
+        return;
+    }
+
+    bulker.flush();
+
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_INFO("Bulk create of virtual router %s failed, rv: %d", names[i].c_str(), statuses[i]);
+            continue;
+        }
+
+        addVrfEntry(names[i], router_ids[i]);
+        created_vrfs_.insert(names[i]);
+    }
+}
+
+void VRFOrch::addVrfEntry(const std::string& vrf_name, sai_object_id_t router_id)
+{
+    SWSS_LOG_ENTER();
+
+    vrf_table_[vrf_name].vrf_id = router_id;
+    vrf_table_[vrf_name].ref_count = 0;
+    vrf_id_table_[router_id] = vrf_name;
+    gFlowCounterRouteOrch->onAddVR(router_id);
+
+    IpPrefix default_link_local_prefix("fe80::/10");
+    gRouteOrch->addLinkLocalRouteToMe(router_id, default_link_local_prefix);
+    SWSS_LOG_NOTICE("Created link local ipv6 route %s to cpu for VRF '%s'",
+                    default_link_local_prefix.to_string().c_str(), vrf_name.c_str());
+}
+
+bool VRFOrch::addOperation(const Request& request)
+{
+    SWSS_LOG_ENTER();
+    uint32_t vni = 0;
+    bool error = true;
+
+    vector<sai_attribute_t> attrs;
+    getVrfAttributes(request, attrs, vni);
 
     const std::string& vrf_name = request.getKeyString(0);
     auto it = vrf_table_.find(vrf_name);
-    if (it == std::end(vrf_table_))
+    bool bulk_created = created_vrfs_.erase(vrf_name) != 0;
+    if (it == std::end(vrf_table_) || bulk_created)
     {
-        // Create a new vrf
-        sai_object_id_t router_id;
-        sai_status_t status = sai_virtual_router_api->create_virtual_router(&router_id,
-                                                                            gSwitchId,
-                                                                            static_cast<uint32_t>(attrs.size()),
-                                                                            attrs.data());
-        if (status != SAI_STATUS_SUCCESS)
+        if (!bulk_created)
         {
-            SWSS_LOG_ERROR("Failed to create virtual router name: %s, rv: %d", vrf_name.c_str(), status);
-            task_process_status handle_status = handleSaiCreateStatus(SAI_API_VIRTUAL_ROUTER, status);
-            if (handle_status != task_success)
+            // Create a new vrf
+            sai_object_id_t router_id;
+            sai_status_t status = sai_virtual_router_api->create_virtual_router(&router_id,
+                                                                                gSwitchId,
+                                                                                static_cast<uint32_t>(attrs.size()),
+                                                                                attrs.data());
+            if (status != SAI_STATUS_SUCCESS)
             {
-                return parseHandleSaiStatusFailure(handle_status);
+                SWSS_LOG_ERROR("Failed to create virtual router name: %s, rv: %d", vrf_name.c_str(), status);
+                task_process_status handle_status = handleSaiCreateStatus(SAI_API_VIRTUAL_ROUTER, status);
+                if (handle_status != task_success)
+                {
+                    return parseHandleSaiStatusFailure(handle_status);
+                }
             }
-        }
 
-        vrf_table_[vrf_name].vrf_id = router_id;
-        vrf_table_[vrf_name].ref_count = 0;
-        vrf_id_table_[router_id] = vrf_name;
-        gFlowCounterRouteOrch->onAddVR(router_id);
-
-        IpPrefix default_link_local_prefix("fe80::/10");
-        gRouteOrch->addLinkLocalRouteToMe(router_id, default_link_local_prefix);
-        SWSS_LOG_NOTICE("Created link local ipv6 route %s to cpu for VRF '%s'",
-                        default_link_local_prefix.to_string().c_str(), vrf_name.c_str());
+            addVrfEntry(vrf_name, router_id);
+        }
 
         if (vni != 0)
         {
@@ -175,7 +290,16 @@ bool VRFOrch::delOperation(const Request& request)
     }
 
     if (vrf_table_[vrf_name].ref_count)
+    {
+        // Parked until decreaseVrfRefCount() drops the last reference
+        KeyOpFieldsValuesTuple task(request.getFullKey(), DEL_COMMAND, vector<FieldValueTuple>());
+        if (addToRetry(vrf_table_name_, task, make_constraint(RETRY_CST_VRF_REF, vrf_name)))
+        {
+            SWSS_LOG_INFO("VRF '%s' is still referenced, removal deferred", vrf_name.c_str());
+            return true;
+        }
         return false;
+    }
 
     sai_object_id_t router_id = vrf_table_[vrf_name].vrf_id;
     // Delete link-local routes before removing VRF
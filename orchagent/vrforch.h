@@ -1,6 +1,8 @@
 #ifndef __VRFORCH_H
 #define __VRFORCH_H
 
+#include <unordered_set>
+
 #include "request_parser.h"
 
 extern sai_object_id_t gVirtualRouterId;
@@ -51,8 +53,11 @@ class VRFOrch : public Orch2
 public:
     VRFOrch(swss::DBConnector *appDb, const std::string& appTableName, swss::DBConnector *stateDb, const std::string& stateTableName) :
         Orch2(appDb, appTableName, request_),
-        m_stateVrfObjectTable(stateDb, stateTableName)
+        m_stateVrfObjectTable(stateDb, stateTableName),
+        vrf_table_name_(appTableName)
     {
+        // A VRF still referenced is removed once its last reference is gone
+        createRetryCache(appTableName);
     }
 
     bool isVRFexists(const std::string& name) const
@@ -108,7 +113,10 @@ public:
     {
         if (vrf_table_.find(name) != std::end(vrf_table_))
         {
-            vrf_table_.at(name).ref_count--;
+            if (--vrf_table_.at(name).ref_count == 0)
+            {
+                notifyRetry(this, vrf_table_name_, make_constraint(RETRY_CST_VRF_REF, name));
+            }
         }
     }
 
@@ -170,8 +178,12 @@ public:
 
     int updateL3VniVlan(uint32_t vni, uint16_t vlan_id);
 private:
+    virtual void doTask(Consumer& consumer);
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
+    void getVrfAttributes(const Request& request, std::vector<sai_attribute_t>& attrs, uint32_t& vni);
+    void bulkCreateVrfs(Consumer& consumer);
+    void addVrfEntry(const std::string& vrf_name, sai_object_id_t router_id);
     bool updateVrfVNIMap(const std::string& vrf_name, uint32_t vni);
     bool delVrfVNIMap(const std::string& vrf_name, uint32_t vni);
 
@@ -181,6 +193,9 @@ private:
     VRFNameVNIMapTable vrf_vni_map_table_;
     swss::Table m_stateVrfObjectTable;
     L3VNITable l3vni_table_;
+    std::string vrf_table_name_;
+    // Created by bulkCreateVrfs(), their SET tasks are not handled yet
+    std::unordered_set<std::string> created_vrfs_;
 };
 
 #endif // __VRFORCH_H
@@ -32,6 +32,7 @@ extern PortsOrch*       gPortsOrch;
 extern sai_object_id_t  gUnderlayIfId;
 extern FlexManagerDirectory g_FlexManagerDirectory;
 extern bool gTraditionalFlexCounter;
+extern size_t gMaxBulkSize;
 
 #define FLEX_COUNTER_UPD_INTERVAL 1
 
@@ -171,7 +172,7 @@ remove_tunnel_map(sai_object_id_t tunnel_map_id)
     }
 }
 
-static sai_object_id_t create_tunnel_map_entry(
+static std::vector<sai_attribute_t> get_tunnel_map_entry_attrs(
     MAP_T map_t,
     sai_object_id_t tunnel_map_id,
     sai_uint32_t vni,
@@ -181,7 +182,6 @@ static sai_object_id_t create_tunnel_map_entry(
     )
 {
     sai_attribute_t attr;
-    sai_object_id_t tunnel_map_entry_id;
     std::vector<sai_attribute_t> tunnel_map_entry_attrs;
 
     attr.id = SAI_TUNNEL_MAP_ENTRY_ATTR_TUNNEL_MAP_TYPE;
@@ -208,6 +208,21 @@ static sai_object_id_t create_tunnel_map_entry(
     attr.value.u32 = vni;
     tunnel_map_entry_attrs.push_back(attr);
 
+    return tunnel_map_entry_attrs;
+}
+
+static sai_object_id_t create_tunnel_map_entry(
+    MAP_T map_t,
+    sai_object_id_t tunnel_map_id,
+    sai_uint32_t vni,
+    sai_uint16_t vlan_id,
+    sai_object_id_t obj_id=SAI_NULL_OBJECT_ID,
+    bool encap=false
+    )
+{
+    sai_object_id_t tunnel_map_entry_id;
+    auto tunnel_map_entry_attrs = get_tunnel_map_entry_attrs(map_t, tunnel_map_id, vni, vlan_id, obj_id, encap);
+
     sai_status_t status = sai_tunnel_api->create_tunnel_map_entry(&tunnel_map_entry_id, gSwitchId,
                                             static_cast<uint32_t> (tunnel_map_entry_attrs.size()),
                                             tunnel_map_entry_attrs.data());
@@ -225,6 +240,89 @@ static sai_object_id_t create_tunnel_map_entry(
     return tunnel_map_entry_id;
 }
 
+TunnelMapEntryBulker::TunnelMapEntryBulker() :
+    bulker_(sai_tunnel_api, gSwitchId, gMaxBulkSize, SAI_OBJECT_TYPE_TUNNEL_MAP_ENTRY)
+{
+    bulker_.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+}
+
+void TunnelMapEntryBulker::create(const std::vector<sai_attribute_t> &attrs, TunnelMapEntryPost post)
+{
+    ops_.push_back({true, SAI_NULL_OBJECT_ID, SAI_STATUS_NOT_EXECUTED, attrs, std::move(post), nullptr});
+    auto &op = ops_.back();
+    bulker_.create_entry(&op.map_entry_id, &op.status, static_cast<uint32_t>(op.attrs.size()), op.attrs.data());
+}
+
+void TunnelMapEntryBulker::remove(sai_object_id_t map_entry_id, TunnelMapEntryRemovePost post)
+{
+    if (map_entry_id == SAI_NULL_OBJECT_ID)
+    {
+        if (post)
+        {
+            post(true);
+        }
+        return;
+    }
+
+    ops_.push_back({false, map_entry_id, SAI_STATUS_NOT_EXECUTED, {}, nullptr, std::move(post)});
+    auto &op = ops_.back();
+    bulker_.remove_entry(&op.status, map_entry_id);
+}
+
+void TunnelMapEntryBulker::flush()
+{
+    SWSS_LOG_ENTER();
+
+    if (ops_.empty())
+    {
+        return;
+    }
+
+    bulker_.flush();
+
+    std::deque<Op> ops;
+    ops.swap(ops_);
+
+    for (auto &op : ops)
+    {
+        if (is_bulk_unsupported(op.status))
+        {
+            op.status = op.add ?
+                sai_tunnel_api->create_tunnel_map_entry(&op.map_entry_id, gSwitchId, static_cast<uint32_t>(op.attrs.size()), op.attrs.data()) :
+                sai_tunnel_api->remove_tunnel_map_entry(op.map_entry_id);
+        }
+
+        if (op.add)
+        {
+            if (op.status != SAI_STATUS_SUCCESS)
+            {
+                op.map_entry_id = SAI_NULL_OBJECT_ID;
+                task_process_status handle_status = handleSaiCreateStatus(SAI_API_TUNNEL, op.status);
+                if (handle_status != task_success)
+                {
+                    SWSS_LOG_ERROR("Can't create a tunnel map entry object");
+                }
+            }
+            op.post(op.map_entry_id);
+        }
+        else
+        {
+            if (op.status != SAI_STATUS_SUCCESS)
+            {
+                task_process_status handle_status = handleSaiRemoveStatus(SAI_API_TUNNEL, op.status);
+                if (handle_status != task_success)
+                {
+                    SWSS_LOG_ERROR("Can't delete a tunnel map entry object");
+                }
+            }
+            if (op.remove_post)
+            {
+                op.remove_post(op.status == SAI_STATUS_SUCCESS);
+            }
+        }
+    }
+}
+
 void remove_tunnel_map_entry(sai_object_id_t obj_id)
 {
     sai_status_t status = SAI_STATUS_SUCCESS;
@@ -560,6 +658,22 @@ sai_object_id_t VxlanTunnel::addDecapMapperEntry(sai_object_id_t obj, uint32_t v
     return create_tunnel_map_entry(map_t, decap_id, vni, 0, obj);
 }
 
+void VxlanTunnel::addEncapMapperEntry(TunnelMapEntryBulker &bulker, sai_object_id_t obj, uint32_t vni,
+                                      TunnelMapEntryPost post, tunnel_map_type_t type)
+{
+    const auto encap_id = getEncapMapId(type);
+    const auto map_t = tunnel_map_type(type,true);
+    bulker.create(get_tunnel_map_entry_attrs(map_t, encap_id, vni, 0, obj, true), std::move(post));
+}
+
+void VxlanTunnel::addDecapMapperEntry(TunnelMapEntryBulker &bulker, sai_object_id_t obj, uint32_t vni,
+                                      TunnelMapEntryPost post, tunnel_map_type_t type)
+{
+    const auto decap_id = getDecapMapId(type);
+    const auto map_t = tunnel_map_type(type,false);
+    bulker.create(get_tunnel_map_entry_attrs(map_t, decap_id, vni, 0, obj), std::move(post));
+}
+
 void VxlanTunnel::insertMapperEntry(sai_object_id_t encap, sai_object_id_t decap, uint32_t vni)
 {
     tunnel_map_entries_[vni] = std::pair<sai_object_id_t, sai_object_id_t>(encap, decap);
@@ -980,7 +1094,7 @@ void VxlanTunnel::increment_spurious_imr_add(const std::string remote_vtep)
 {
     tunnel_refcnt_t tnl_refcnts;
 
-    auto it = tnl_users_.find(remote_vtep); 
+    auto it = tnl_users_.find(IpAddress(remote_vtep)); 
     if (it == tnl_users_.end())
     {
         return ; 
@@ -989,7 +1103,7 @@ void VxlanTunnel::increment_spurious_imr_add(const std::string remote_vtep)
     {
         tnl_refcnts = it->second;
         tnl_refcnts.spurious_add_imr_refcnt++;
-        tnl_users_[remote_vtep] = tnl_refcnts;
+        it->second = tnl_refcnts;
     }
 }
 
@@ -997,7 +1111,7 @@ void VxlanTunnel::increment_spurious_imr_del(const std::string remote_vtep)
 {
     tunnel_refcnt_t tnl_refcnts;
 
-    auto it = tnl_users_.find(remote_vtep); 
+    auto it = tnl_users_.find(IpAddress(remote_vtep)); 
     if (it == tnl_users_.end())
     {
         return ; 
@@ -1006,7 +1120,7 @@ void VxlanTunnel::increment_spurious_imr_del(const std::string remote_vtep)
     {
         tnl_refcnts = it->second;
         tnl_refcnts.spurious_del_imr_refcnt++;
-        tnl_users_[remote_vtep] = tnl_refcnts;
+        it->second = tnl_refcnts;
     }
 }
 
@@ -1014,7 +1128,7 @@ int VxlanTunnel::getRemoteEndPointRefCnt(const std::string remote_vtep)
 {
     tunnel_refcnt_t tnl_refcnts;
 
-    auto it = tnl_users_.find(remote_vtep); 
+    auto it = tnl_users_.find(IpAddress(remote_vtep)); 
     if (it == tnl_users_.end())
     {
         return -1; 
@@ -1030,7 +1144,7 @@ int VxlanTunnel::getRemoteEndPointIMRRefCnt(const std::string remote_vtep)
 {
     tunnel_refcnt_t tnl_refcnts;
 
-    auto it = tnl_users_.find(remote_vtep); 
+    auto it = tnl_users_.find(IpAddress(remote_vtep)); 
     if (it == tnl_users_.end())
     {
         return -1; 
@@ -1046,7 +1160,7 @@ int VxlanTunnel::getRemoteEndPointIPRefCnt(const std::string remote_vtep)
 {
     tunnel_refcnt_t tnl_refcnts;
 
-    auto it = tnl_users_.find(remote_vtep);
+    auto it = tnl_users_.find(IpAddress(remote_vtep));
     if (it == tnl_users_.end())
     {
         return -1;
@@ -1110,21 +1224,18 @@ void VxlanTunnel::updateRemoteEndPointIpRef(const std::string remote_vtep, bool
 {
     tunnel_refcnt_t tnl_refcnts;
 
-    auto it = tnl_users_.find(remote_vtep);
+    IpAddress remote_ip(remote_vtep);
+    auto it = tnl_users_.find(remote_ip);
     if (inc)
     {
         if (it == tnl_users_.end())
         {
             memset(&tnl_refcnts, 0, sizeof(tunnel_refcnt_t));
-            tnl_refcnts.ip_refcnt++;
-            tnl_users_[remote_vtep] = tnl_refcnts;
-        }
-        else
-        {
-            it->second.ip_refcnt++;
+            it = tnl_users_.emplace(remote_ip, tnl_refcnts).first;
         }
+        it->second.ip_refcnt++;
         SWSS_LOG_DEBUG("Incrementing remote end point %s reference to %d", remote_vtep.c_str(),
-                       tnl_users_[remote_vtep].ip_refcnt);
+                       it->second.ip_refcnt);
     }
     else
     {
@@ -1139,7 +1250,7 @@ void VxlanTunnel::updateRemoteEndPointIpRef(const std::string remote_vtep, bool
                        it->second.ip_refcnt);
         if (it->second.ip_refcnt == 0)
         {
-             tnl_users_.erase(remote_vtep);
+             tnl_users_.erase(it);
         }
     }
 }
@@ -1152,17 +1263,17 @@ bool VxlanTunnel::createDynamicDIPTunnel(const std::string dip, tunnel_user_t us
     VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
     string tunnel_name;
 
-    auto it = tnl_users_.find(dip); 
+    IpAddress dipaddr(dip);
+    auto it = tnl_users_.find(dipaddr);
     if (it == tnl_users_.end())
     {
         tunnel_orch->getTunnelNameFromDIP(dip, tunnel_name);
-        auto dipaddr = IpAddress(dip);
         dip_tunnel = (new VxlanTunnel(tunnel_name, src_ip_, dipaddr, TNL_CREATION_SRC_EVPN));
         tunnel_orch->addTunnel(tunnel_name,dip_tunnel);
 
         memset(&tnl_refcnts,0,sizeof(tunnel_refcnt_t));
         updateRemoteEndPointRefCnt(true,tnl_refcnts,usr);
-        tnl_users_[dip] = tnl_refcnts;
+        tnl_users_[dipaddr] = tnl_refcnts;
 
         TUNNELMAP_SET_VLAN(mapper_list);
         TUNNELMAP_SET_VRF(mapper_list);
@@ -1173,7 +1284,7 @@ bool VxlanTunnel::createDynamicDIPTunnel(const std::string dip, tunnel_user_t us
     {
         tnl_refcnts = it->second;
         updateRemoteEndPointRefCnt(true,tnl_refcnts,usr);
-        tnl_users_[dip] = tnl_refcnts;
+        it->second = tnl_refcnts;
     }
 
     return true;
@@ -1189,7 +1300,7 @@ bool VxlanTunnel::deleteDynamicDIPTunnel(const std::string dip, tunnel_user_t us
     Port tunnelPort;
     std::string tunnel_name;
 
-    auto it = tnl_users_.find(dip); 
+    auto it = tnl_users_.find(IpAddress(dip)); 
     if (it != tnl_users_.end())
     {
         tnl_refcnts = it->second;
@@ -1197,7 +1308,7 @@ bool VxlanTunnel::deleteDynamicDIPTunnel(const std::string dip, tunnel_user_t us
         if (update_refcnt)
         {
             updateRemoteEndPointRefCnt(false,tnl_refcnts,usr);
-            tnl_users_[dip] = tnl_refcnts;
+            it->second = tnl_refcnts;
         }
  
         SWSS_LOG_INFO("diprefcnt = %d",
@@ -1227,7 +1338,7 @@ bool VxlanTunnel::deleteDynamicDIPTunnel(const std::string dip, tunnel_user_t us
         TUNNELMAP_SET_VRF(mapper_list);
         dip_tunnel->deleteTunnelHw(mapper_list,TUNNEL_MAP_USE_COMMON_ENCAP_DECAP, false);
  
-        tnl_users_.erase(dip);
+        tnl_users_.erase(it);
  
         tunnel_orch->delTunnel(tunnel_name);
         SWSS_LOG_NOTICE("P2P Tunnel deleted : %s", tunnel_name.c_str());
@@ -2009,6 +2120,14 @@ bool VxlanTunnel::isTunnelReferenced()
 
 //------------------- VXLAN_TUNNEL_MAP Table --------------------------//
 
+void VxlanTunnelMapOrch::doTask(Consumer& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    Orch2::doTask(consumer);
+    map_entry_bulker_.flush();
+}
+
 bool VxlanTunnelMapOrch::addOperation(const Request& request)
 {
     SWSS_LOG_ENTER();
@@ -2099,9 +2218,16 @@ bool VxlanTunnelMapOrch::addOperation(const Request& request)
     {
         if (isL3Vni == false)
         {
-            auto tunnel_map_entry_id = create_tunnel_map_entry(MAP_T::VNI_TO_VLAN_ID,
-                                                               tunnel_map_id, vni_id, vlan_id);
-            vxlan_tunnel_map_table_[full_tunnel_map_entry_name].map_entry_id = tunnel_map_entry_id;
+            map_entry_bulker_.create(get_tunnel_map_entry_attrs(MAP_T::VNI_TO_VLAN_ID, tunnel_map_id, vni_id, vlan_id),
+                [this, full_tunnel_map_entry_name](sai_object_id_t tunnel_map_entry_id)
+                {
+                    auto it = vxlan_tunnel_map_table_.find(full_tunnel_map_entry_name);
+                    if (it != vxlan_tunnel_map_table_.end())
+                    {
+                        it->second.map_entry_id = tunnel_map_entry_id;
+                    }
+                });
+            vxlan_tunnel_map_table_[full_tunnel_map_entry_name].map_entry_id = SAI_NULL_OBJECT_ID;
         }
         else
         {
@@ -2153,7 +2279,7 @@ bool VxlanTunnelMapOrch::delOperation(const Request& request)
     auto tunnel_map_entry_id = vxlan_tunnel_map_table_[full_tunnel_map_entry_name].map_entry_id;
     try
     {
-        remove_tunnel_map_entry(tunnel_map_entry_id);
+        map_entry_bulker_.remove(tunnel_map_entry_id);
     }
     catch (const std::runtime_error& error)
     {
@@ -2188,6 +2314,9 @@ bool VxlanTunnelMapOrch::delOperation(const Request& request)
       // then mark it as pending for delete. 
       if (!tunnel_obj->isTunnelReferenced())
       {
+          // The tunnel maps go with the tunnel, remove their entries first
+          map_entry_bulker_.flush();
+
           if (!tunnel_orch->isDipTunnelsSupported())
           {
               ret = gPortsOrch->getPort(port_tunnel_name, tunnelPort);
@@ -2249,6 +2378,14 @@ bool VxlanTunnelMapOrch::delOperation(const Request& request)
 
 //------------------- VXLAN_VRF_MAP Table --------------------------//
 
+void VxlanVrfMapOrch::doTask(Consumer& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    Orch2::doTask(consumer);
+    map_entry_bulker_.flush();
+}
+
 bool VxlanVrfMapOrch::addOperation(const Request& request)
 {
     SWSS_LOG_ENTER();
@@ -2326,20 +2463,37 @@ bool VxlanVrfMapOrch::addOperation(const Request& request)
         {
             entry.vniVlanMapName = vniVlanMapName;
             entry.vlan_id = vlan_id;
-            remove_tunnel_map_entry(tnl_map_entry_id);
+            map_entry_bulker_.remove(tnl_map_entry_id);
             SWSS_LOG_DEBUG("remove_tunnel_map_entry name %s, vlan %d, vni %d\n", entry.vniVlanMapName.c_str(), entry.vlan_id, entry.vni_id);
         }
         /*
-         * Create encap and decap mapper
+         * Create encap and decap mapper, their ids are set on flush
          */
-        entry.encap_id = tunnel_obj->addEncapMapperEntry(vrf_id, vni_id);
+        entry.encap_id = SAI_NULL_OBJECT_ID;
+        entry.decap_id = SAI_NULL_OBJECT_ID;
+        tunnel_obj->addEncapMapperEntry(map_entry_bulker_, vrf_id, vni_id,
+            [this, full_map_entry_name](sai_object_id_t encap_id)
+            {
+                auto it = vxlan_vrf_table_.find(full_map_entry_name);
+                if (it != vxlan_vrf_table_.end())
+                {
+                    it->second.encap_id = encap_id;
+                }
+                SWSS_LOG_DEBUG("Vxlan tunnel encap entry '%" PRIx64 "'", encap_id);
+            });
         vrf_orch->increaseVrfRefCount(vrf_name);
-        entry.decap_id = tunnel_obj->addDecapMapperEntry(vrf_id, vni_id);
+        tunnel_obj->addDecapMapperEntry(map_entry_bulker_, vrf_id, vni_id,
+            [this, full_map_entry_name](sai_object_id_t decap_id)
+            {
+                auto it = vxlan_vrf_table_.find(full_map_entry_name);
+                if (it != vxlan_vrf_table_.end())
+                {
+                    it->second.decap_id = decap_id;
+                }
+                SWSS_LOG_DEBUG("Vxlan tunnel decap entry '0x%" PRIx64 "'", decap_id);
+            });
         vrf_orch->increaseVrfRefCount(vrf_name);
 
-        SWSS_LOG_DEBUG("Vxlan tunnel encap entry '%" PRIx64 "' decap entry '0x%" PRIx64 "'",
-                entry.encap_id, entry.decap_id);
-
         vxlan_vrf_table_[full_map_entry_name] = entry;
         vxlan_vrf_tunnel_[vrf_name] = tunnel_obj->getTunnelId();
     }
@@ -2401,9 +2555,9 @@ bool VxlanVrfMapOrch::delOperation(const Request& request)
         SWSS_LOG_NOTICE("VxlanVrfMapOrch Vxlan tunnel VRF encap entry '%" PRIx64 "' decap entry '0x%" PRIx64 "'",
                 entry.encap_id, entry.decap_id);
 
-        remove_tunnel_map_entry(entry.encap_id);
+        map_entry_bulker_.remove(entry.encap_id);
         vrf_orch->decreaseVrfRefCount(vrf_name);
-        remove_tunnel_map_entry(entry.decap_id);
+        map_entry_bulker_.remove(entry.decap_id);
         vrf_orch->decreaseVrfRefCount(vrf_name);
 
         if (!entry.isL2Vni)
@@ -2424,11 +2578,17 @@ bool VxlanVrfMapOrch::delOperation(const Request& request)
             SWSS_LOG_NOTICE("Adding tunnel map entry. Tunnel: %s %s",tunnel_name.c_str(),entry.vniVlanMapName.c_str());
 
             SWSS_LOG_DEBUG("create_tunnel_map_entry vni %d, vlan %d\n", entry.vni_id, entry.vlan_id);
-            auto tunnel_map_entry_id = create_tunnel_map_entry(MAP_T::VNI_TO_VLAN_ID,
-                    tunnel_map_id, entry.vni_id, (uint16_t)entry.vlan_id);
-            SWSS_LOG_DEBUG("updateTnlMapId name %s\n", entry.vniVlanMapName.c_str());
+            const auto vniVlanMapName = entry.vniVlanMapName;
+            map_entry_bulker_.create(get_tunnel_map_entry_attrs(MAP_T::VNI_TO_VLAN_ID,
+                    tunnel_map_id, entry.vni_id, (uint16_t)entry.vlan_id),
+                [vxlan_tun_map_orch, vniVlanMapName](sai_object_id_t tunnel_map_entry_id)
+                {
+                    SWSS_LOG_DEBUG("updateTnlMapId name %s\n", vniVlanMapName.c_str());
+                    vxlan_tun_map_orch->updateTnlMapId(vniVlanMapName, tunnel_map_entry_id);
+                });
 
-            vxlan_tun_map_orch->updateTnlMapId(entry.vniVlanMapName, tunnel_map_entry_id);
+            // The L2 entry is back in place before later operations look it up
+            map_entry_bulker_.flush();
         }
 
         vxlan_vrf_table_.erase(full_map_entry_name);
@@ -2446,6 +2606,31 @@ bool VxlanVrfMapOrch::delOperation(const Request& request)
 
 //------------------- EVPN_REMOTE_VNI Table --------------------------//
 
+void EvpnRemoteVnip2pOrch::doTask(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    batch_members_ = true;
+    Orch2::doTask(consumer);
+    batch_members_ = false;
+
+    if (pending_members_.empty())
+    {
+        return;
+    }
+
+    // A burst of IMET routes joins its remote VTEPs to their VLANs with one bulk call
+    std::vector<bool> success;
+    gPortsOrch->addVlanMembers(pending_members_, "untagged", success);
+
+    for (size_t i = 0; i < pending_members_.size(); i++)
+    {
+        SWSS_LOG_INFO("remote_vtep port=%s vlan=%s added=%d", pending_members_[i].second.c_str(),
+                      pending_members_[i].first.c_str(), static_cast<int>(success[i]));
+    }
+    pending_members_.clear();
+}
+
 bool EvpnRemoteVnip2pOrch::addOperation(const Request& request)
 {
     SWSS_LOG_ENTER();
@@ -2521,14 +2706,20 @@ bool EvpnRemoteVnip2pOrch::addOperation(const Request& request)
         return false;
     }
 
-    // SAI Call to add tunnel to the VLAN flood domain
+    SWSS_LOG_INFO("remote_vtep=%s vni=%d vlanid=%d ",
+                   remote_vtep.c_str(), vni_id, vlan_id);
+
+    // SAI Call to add tunnel to the VLAN flood domain, batched with the rest of the drain
     // NOTE: does 'untagged' make the most sense here?
+    if (batch_members_)
+    {
+        pending_members_.emplace_back(vlanPort.m_alias, tunnelPort.m_alias);
+        return true;
+    }
+
     string tagging_mode = "untagged";
     gPortsOrch->addVlanMember(vlanPort, tunnelPort, tagging_mode);
 
-    SWSS_LOG_INFO("remote_vtep=%s vni=%d vlanid=%d ",
-                   remote_vtep.c_str(), vni_id, vlan_id);
-
     return true;
 }
 
@@ -1,13 +1,18 @@
 #pragma once
 
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <map>
 #include <unordered_map>
 #include <set>
 #include <memory>
+#include <net/ethernet.h>
 #include "request_parser.h"
 #include "portsorch.h"
 #include "vrforch.h"
 #include "timer.h"
+#include "bulker.h"
 
 enum class MAP_T
 {
@@ -95,13 +100,32 @@ struct nh_key_t
     }
 };
 
+// Hashes the address bytes, remote VTEP tables are looked up for every route and MAC
+struct ip_address_hash
+{
+    size_t operator() (const IpAddress& ip) const
+    {
+        const ip_addr_t addr = ip.getIp();
+        if (addr.family == AF_INET)
+        {
+            return std::hash<uint32_t>() (addr.ip_addr.ipv4_addr);
+        }
+
+        uint64_t words[2];
+        memcpy(words, addr.ip_addr.ipv6_addr, sizeof(words));
+        return std::hash<uint64_t>() (words[0] ^ (words[1] * 0x9e3779b97f4a7c15ULL));
+    }
+};
+
 struct nh_key_hash
 {
     size_t operator() (const nh_key_t& key) const
     {
-        stringstream ss;
-        ss << key.ip_addr.to_string() << key.mac_address.to_string() << std::to_string(key.vni);
-        return std::hash<std::string>() (ss.str());
+        uint64_t mac = 0;
+        memcpy(&mac, key.mac_address.getMac(), ETHER_ADDR_LEN);
+        size_t hash = ip_address_hash() (key.ip_addr);
+        hash ^= std::hash<uint64_t>() (mac ^ (uint64_t(key.vni) << 48)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
     }
 };
 
@@ -135,9 +159,44 @@ typedef struct tunnel_map_entry_s
    uint32_t        vni_id;
 } tunnel_map_entry_t;
 
+typedef std::function<void(sai_object_id_t)> TunnelMapEntryPost;
+typedef std::function<void(bool)> TunnelMapEntryRemovePost;
+
+/*
+ * Tunnel map entries queued by the doTask of a map orch and programmed in
+ * bulk at its end. Removes are flushed before creates. The post step of a
+ * create runs after the flush with the id of the entry, SAI_NULL_OBJECT_ID
+ * when it could not be created. The optional post step of a remove runs
+ * with whether the entry was removed. Entries are programmed one by one
+ * when the SAI has no generic bulk support for tunnel map entries.
+ */
+class TunnelMapEntryBulker
+{
+public:
+    TunnelMapEntryBulker();
+
+    void create(const std::vector<sai_attribute_t> &attrs, TunnelMapEntryPost post);
+    void remove(sai_object_id_t map_entry_id, TunnelMapEntryRemovePost post = nullptr);
+    void flush();
+
+private:
+    struct Op
+    {
+        bool add;
+        sai_object_id_t map_entry_id;
+        sai_status_t status;
+        std::vector<sai_attribute_t> attrs;
+        TunnelMapEntryPost post;
+        TunnelMapEntryRemovePost remove_post;
+    };
+
+    ObjectBulker<sai_tunnel_api_t> bulker_;
+    std::deque<Op> ops_;
+};
+
 typedef std::map<uint32_t, std::pair<sai_object_id_t, sai_object_id_t>> TunnelMapEntries;
 typedef std::unordered_map<nh_key_t, nh_tunnel_t, nh_key_hash> TunnelNHs;
-typedef std::map<std::string, tunnel_refcnt_t> TunnelUsers;
+typedef std::unordered_map<IpAddress, tunnel_refcnt_t, ip_address_hash> TunnelUsers;
 
 enum class VxlanTunnelTTLMode
 {
@@ -161,6 +220,11 @@ public:
                                         tunnel_map_type_t type=TUNNEL_MAP_T_VIRTUAL_ROUTER);
     sai_object_id_t addDecapMapperEntry(sai_object_id_t obj, uint32_t vni,
                                         tunnel_map_type_t type=TUNNEL_MAP_T_VIRTUAL_ROUTER);
+    /* Same as above, the entry is queued in the bulker and post gets its id on flush */
+    void addEncapMapperEntry(TunnelMapEntryBulker &bulker, sai_object_id_t obj, uint32_t vni,
+                             TunnelMapEntryPost post, tunnel_map_type_t type=TUNNEL_MAP_T_VIRTUAL_ROUTER);
+    void addDecapMapperEntry(TunnelMapEntryBulker &bulker, sai_object_id_t obj, uint32_t vni,
+                             TunnelMapEntryPost post, tunnel_map_type_t type=TUNNEL_MAP_T_VIRTUAL_ROUTER);
 
     void insertMapperEntry(sai_object_id_t encap, sai_object_id_t decap, uint32_t vni);
     std::pair<sai_object_id_t, sai_object_id_t> getMapperEntry(uint32_t vni);
@@ -425,11 +489,13 @@ public:
 
     void updateTnlMapId(std::string vniVlanMapName, sai_object_id_t tunnel_map_id);
 private:
+    virtual void doTask(Consumer& consumer);
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
 
     VxlanTunnelMapTable vxlan_tunnel_map_table_;
     VxlanTunnelMapRequest request_;
+    TunnelMapEntryBulker map_entry_bulker_;
 };
 
 const request_description_t vxlan_vrf_request_description = {
@@ -472,12 +538,14 @@ public:
     }
 
 private:
+    virtual void doTask(Consumer& consumer);
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
 
     VxlanVrfTable vxlan_vrf_table_;
     VxlanVrfTunnel vxlan_vrf_tunnel_;
     VxlanVrfRequest request_;
+    TunnelMapEntryBulker map_entry_bulker_;
 };
 
 //---------------- EVPN_REMOTE_VNI table ---------------------
@@ -501,12 +569,21 @@ class EvpnRemoteVnip2pOrch : public Orch2
 public:
     EvpnRemoteVnip2pOrch(DBConnector *db, const std::string& tableName) : Orch2(db, tableName, request_) { }
 
+    using Orch2::doTask;
+    void doTask(Consumer &consumer) override;
 
 private:
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
 
     EvpnRemoteVniRequest request_;
+
+    /*
+     * Remote VTEPs joining a VLAN flood domain in a drain, as VLAN and tunnel
+     * port aliases, added with one VLAN member bulk call at its end
+     */
+    bool batch_members_ = false;
+    std::vector<std::pair<std::string, std::string>> pending_members_;
 };
 
 class EvpnRemoteVnip2mpOrch : public Orch2
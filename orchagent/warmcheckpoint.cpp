@@ -0,0 +1,180 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "warmcheckpoint.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+static_assert(sizeof(WarmCheckpoint::Record) == 128, "checkpoint records are laid out in the file as is");
+
+// splitmix64 finalizer, spreads the bits so digests can be summed
+static uint64_t mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t TableDigest::hash(const string &s, uint64_t seed)
+{
+    // FNV-1a
+    uint64_t h = 0xcbf29ce484222325ULL ^ seed;
+    for (char c : s)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+uint64_t TableDigest::digest(const KeyOpFieldsValuesTuple &entry)
+{
+    // Redis doesn't keep the field order of a hash across restarts, fields are summed
+    uint64_t h = mix(hash(kfvKey(entry)));
+    for (const auto &fv : kfvFieldsValues(entry))
+    {
+        h += mix(hash(fvValue(fv), hash(fvField(fv))));
+    }
+
+    return mix(h);
+}
+
+void WarmCheckpoint::addTable(const string &name, const TableDigest &digest)
+{
+    m_tables[name] = { digest.value(), digest.count() };
+}
+
+void WarmCheckpoint::addObjects(const string &name, uint64_t count)
+{
+    m_objects[name] = { 0, count };
+}
+
+bool WarmCheckpoint::write(const string &path) const
+{
+    SWSS_LOG_ENTER();
+
+    vector<Record> records;
+    auto append = [&records](RecordType type, const string &name, const Value &value)
+    {
+        if (name.size() >= sizeof(Record::name))
+        {
+            SWSS_LOG_WARN("Checkpoint record name %s is too long, skipped", name.c_str());
+            return;
+        }
+
+        Record record = {};
+        record.type = static_cast<uint32_t>(type);
+        record.digest = value.digest;
+        record.count = value.count;
+        memcpy(record.name, name.c_str(), name.size());
+        records.push_back(record);
+    };
+
+    for (const auto &it : m_tables)
+    {
+        append(RecordType::TABLE, it.first, it.second);
+    }
+    for (const auto &it : m_objects)
+    {
+        append(RecordType::OBJECTS, it.first, it.second);
+    }
+
+    Header header = { WARM_CHECKPOINT_MAGIC, WARM_CHECKPOINT_VERSION, records.size() };
+
+    // Written aside and renamed, a restart never finds a partial checkpoint
+    string tmp = path + ".tmp";
+    FILE *file = fopen(tmp.c_str(), "wb");
+    if (!file)
+    {
+        SWSS_LOG_ERROR("Failed to open the warm checkpoint %s", tmp.c_str());
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              (records.empty() || fwrite(records.data(), sizeof(Record), records.size(), file) == records.size());
+    ok = fclose(file) == 0 && ok;
+
+    if (!ok || rename(tmp.c_str(), path.c_str()) != 0)
+    {
+        SWSS_LOG_ERROR("Failed to write the warm checkpoint %s", path.c_str());
+        unlink(tmp.c_str());
+        return false;
+    }
+
+    SWSS_LOG_NOTICE("Wrote warm checkpoint %s, %zu tables, %zu object counts",
+                    path.c_str(), m_tables.size(), m_objects.size());
+    return true;
+}
+
+bool WarmCheckpoint::load(const string &path)
+{
+    SWSS_LOG_ENTER();
+
+    m_tables.clear();
+    m_objects.clear();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        SWSS_LOG_NOTICE("No warm checkpoint at %s", path.c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header))
+    {
+        SWSS_LOG_ERROR("Warm checkpoint %s is truncated", path.c_str());
+        close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        SWSS_LOG_ERROR("Failed to map the warm checkpoint %s", path.c_str());
+        return false;
+    }
+
+    auto header = static_cast<const Header *>(map);
+    bool ok = header->magic == WARM_CHECKPOINT_MAGIC && header->version == WARM_CHECKPOINT_VERSION &&
+              header->records == (size - sizeof(Header)) / sizeof(Record) &&
+              (size - sizeof(Header)) % sizeof(Record) == 0;
+    if (!ok)
+    {
+        SWSS_LOG_ERROR("Warm checkpoint %s doesn't match version %u, ignored", path.c_str(), WARM_CHECKPOINT_VERSION);
+    }
+    else
+    {
+        auto records = reinterpret_cast<const Record *>(static_cast<const char *>(map) + sizeof(Header));
+        for (uint64_t i = 0; i < header->records; i++)
+        {
+            const auto &record = records[i];
+            string name(record.name, strnlen(record.name, sizeof(record.name)));
+            Value value = { record.digest, record.count };
+
+            if (record.type == static_cast<uint32_t>(RecordType::TABLE))
+            {
+                m_tables[name] = value;
+            }
+            else if (record.type == static_cast<uint32_t>(RecordType::OBJECTS))
+            {
+                m_objects[name] = value;
+            }
+        }
+    }
+
+    munmap(map, size);
+    return ok;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "table.h"
+
+#define WARM_CHECKPOINT_MAGIC       0x504b434fu     // "OCKP"
+#define WARM_CHECKPOINT_VERSION     1
+
+/*
+ * Order independent digest of the entries of a table. Entry digests are
+ * summed, so an entry added can be removed again.
+ */
+class TableDigest
+{
+public:
+    void add(const swss::KeyOpFieldsValuesTuple &entry) { add(digest(entry)); }
+    void add(uint64_t entryDigest) { m_value += entryDigest; m_count++; }
+    void remove(uint64_t entryDigest) { m_value -= entryDigest; m_count--; }
+
+    uint64_t value() const { return m_value; }
+    uint64_t count() const { return m_count; }
+
+    bool operator==(const TableDigest &other) const
+    {
+        return m_value == other.m_value && m_count == other.m_count;
+    }
+    bool operator!=(const TableDigest &other) const { return !(*this == other); }
+
+    static uint64_t digest(const swss::KeyOpFieldsValuesTuple &entry);
+    static uint64_t hash(const std::string &s, uint64_t seed = 0);
+
+private:
+    uint64_t m_value = 0;
+    uint64_t m_count = 0;
+};
+
+/*
+ * Checkpoint of the orchagent state taken as it freezes for a warm restart:
+ * the digest of every table the warm restore bake refills, and the object
+ * counts reported by Orch::getObjectCounts().
+ *
+ * On restart the digests tell which tables changed while orchagent was down,
+ * and once the replay is done the object counts of the Orchs whose tables
+ * were unchanged must match, anything else is a replay that diverged.
+ *
+ * The file is a header followed by fixed size records, it is read through
+ * mmap and rejected on a magic, version or size mismatch.
+ */
+class WarmCheckpoint
+{
+public:
+    enum class RecordType : uint32_t
+    {
+        TABLE = 1,
+        OBJECTS = 2,
+    };
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t records;
+    };
+
+    struct Record
+    {
+        uint32_t type;
+        uint32_t reserved;
+        uint64_t digest;
+        uint64_t count;
+        char name[104];
+    };
+
+    struct Value
+    {
+        uint64_t digest;
+        uint64_t count;
+    };
+
+    void addTable(const std::string &name, const TableDigest &digest);
+    void addObjects(const std::string &name, uint64_t count);
+
+    bool write(const std::string &path) const;
+    bool load(const std::string &path);
+
+    const std::map<std::string, Value> &getTables() const { return m_tables; }
+    const std::map<std::string, Value> &getObjects() const { return m_objects; }
+
+private:
+    std::map<std::string, Value> m_tables;
+    std::map<std::string, Value> m_objects;
+};
@@ -0,0 +1,89 @@
+#include <algorithm>
+
+#include "warmreplay.h"
+#include "orch.h"
+#include "logger.h"
+
+using namespace std;
+
+WarmReplay::WarmReplay(const vector<Orch *> &orchs, size_t maxRounds) :
+    m_orchs(orchs),
+    m_maxRounds(maxRounds)
+{
+    for (size_t i = 0; i < m_orchs.size(); i++)
+    {
+        m_index[m_orchs[i]] = i;
+    }
+
+    // Everything is new to the first round
+    m_epoch = m_lastProgress = 1;
+    m_progress.assign(m_orchs.size(), m_epoch);
+    m_lastRun.assign(m_orchs.size(), 0);
+}
+
+uint64_t WarmReplay::inputEpoch(size_t index) const
+{
+    Orch *orch = m_orchs[index];
+    if (!orch->hasDeclaredDependencies())
+    {
+        return m_lastProgress;
+    }
+
+    uint64_t epoch = m_progress[index];
+    for (Orch *dependency : orch->getDependencies())
+    {
+        auto it = m_index.find(dependency);
+        if (it != m_index.end())
+        {
+            epoch = max(epoch, m_progress[it->second]);
+        }
+    }
+
+    return epoch;
+}
+
+bool WarmReplay::run(const Runner &runner)
+{
+    SWSS_LOG_ENTER();
+
+    while (m_rounds < m_maxRounds)
+    {
+        size_t round = ++m_rounds;
+        size_t runs = 0;
+
+        for (size_t i = 0; i < m_orchs.size(); i++)
+        {
+            Orch *orch = m_orchs[i];
+
+            // Resolved retries are run right away, the others wait for a change
+            bool retry = orch->hasResolvedRetries();
+            if (!retry && round > 1 && (!orch->hasPendingTasks() || inputEpoch(i) <= m_lastRun[i]))
+            {
+                continue;
+            }
+
+            size_t before = orch->getPendingTaskCount();
+            m_lastRun[i] = ++m_epoch;
+
+            runner(orch, round);
+            runs++;
+
+            if (retry || orch->getPendingTaskCount() != before)
+            {
+                m_progress[i] = m_lastProgress = ++m_epoch;
+            }
+        }
+
+        m_runs += runs;
+        SWSS_LOG_INFO("Warm replay round %zu ran %zu Orchs", round, runs);
+
+        if (runs == 0)
+        {
+            SWSS_LOG_NOTICE("Warm replay settled after %zu rounds, %zu Orch runs", round, m_runs);
+            return true;
+        }
+    }
+
+    SWSS_LOG_WARN("Warm replay still making progress after %zu rounds, %zu Orch runs", m_rounds, m_runs);
+    return false;
+}
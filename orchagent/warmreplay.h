@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+class Orch;
+
+#define WARM_REPLAY_MAX_ROUNDS  32
+
+/*
+ * Replays the tasks refilled by bake() on warm restore, until every Orch
+ * settled, instead of a fixed number of doTask() passes over all Orchs.
+ *
+ * The first round runs every Orch in order. Afterwards an Orch with tasks
+ * still pending, or with RetryCache constraints resolved, is only run again
+ * once one of its inputs made progress since its last run: an Orch which
+ * declared its dependencies waits on those and on itself, any other Orch on
+ * any Orch. Progress is a change of the pending task count, a task consumed
+ * or parked into a RetryCache, or a run retrying resolved tasks. A task blocked on a missing prerequisite is
+ * retried once per change that may have created it rather than on every
+ * pass, and the replay ends as soon as a round runs nothing.
+ */
+class WarmReplay
+{
+public:
+    using Runner = std::function<void(Orch *orch, size_t round)>;
+
+    WarmReplay(const std::vector<Orch *> &orchs, size_t maxRounds = WARM_REPLAY_MAX_ROUNDS);
+
+    /*
+     * Runs the rounds, runner performs the doTask() of an Orch.
+     * Returns false if tasks were still making progress after maxRounds.
+     */
+    bool run(const Runner &runner);
+
+    size_t getRounds() const { return m_rounds; }
+
+    /* Number of Orch runs over all rounds */
+    size_t getRuns() const { return m_runs; }
+
+private:
+    /* Latest progress of the Orchs the Orch at index depends on */
+    uint64_t inputEpoch(size_t index) const;
+
+    std::vector<Orch *> m_orchs;
+    std::unordered_map<Orch *, size_t> m_index;
+    size_t m_maxRounds;
+
+    // Epochs order the runs and the progress, a run gets a fresh epoch
+    uint64_t m_epoch = 0;
+    uint64_t m_lastProgress = 0;
+    std::vector<uint64_t> m_progress;
+    std::vector<uint64_t> m_lastRun;
+
+    size_t m_rounds = 0;
+    size_t m_runs = 0;
+};
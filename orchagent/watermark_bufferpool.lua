@@ -7,54 +7,43 @@
 local counters_db = ARGV[1]
 local counters_table_name = 'COUNTERS'
 
-local user_table_name = 'USER_WATERMARKS'
-local persistent_table_name = 'PERSISTENT_WATERMARKS'
-local periodic_table_name = 'PERIODIC_WATERMARKS'
+local view_table_names = {'PERIODIC_WATERMARKS', 'PERSISTENT_WATERMARKS', 'USER_WATERMARKS'}
 
-local sai_buffer_pool_watermark_stat_name = 'SAI_BUFFER_POOL_STAT_WATERMARK_BYTES'
-local sai_hdrm_pool_watermark_stat_name = 'SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES'
+local wm_fields = {
+    'SAI_BUFFER_POOL_STAT_WATERMARK_BYTES',
+    'SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES'
+}
 
 local rets = {}
 
 redis.call('SELECT', counters_db)
 
+-- Raise the watermarks of the three views of an object to the ones of the
+-- last poll: the counters are read once, and each view with one HMGET and
+-- at most one HSET for all the fields
+local function update_views(key, fields)
+    local cur = redis.call('HMGET', counters_table_name .. ':' .. key, unpack(fields))
+    for _, view_table_name in ipairs(view_table_names) do
+        local last = redis.call('HMGET', view_table_name .. ':' .. key, unpack(fields))
+        local fvs = {}
+        for j = 1, table.getn(fields) do
+            local value = tonumber(cur[j])
+            local last_value = tonumber(last[j])
+            if value and (not last_value or value > last_value) then
+                table.insert(fvs, fields[j])
+                table.insert(fvs, cur[j])
+            end
+        end
+        if table.getn(fvs) > 0 then
+            redis.call('HSET', view_table_name .. ':' .. key, unpack(fvs))
+        end
+    end
+end
+
 -- Iterate through each buffer pool oid
 local n = table.getn(KEYS)
 for i = n, 1, -1 do
-    -- Get new watermark value from COUNTERS
-    local buffer_pool_wm = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name)
-    local hdrm_pool_wm = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name)
-
-    -- Get last value from *_WATERMARKS
-    local user_buffer_pool_wm = redis.call('HGET', user_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name)
-    local persistent_buffer_pool_wm = redis.call('HGET', persistent_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name)
-    local periodic_buffer_pool_wm = redis.call('HGET', periodic_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name)
-
-    local user_hdrm_pool_wm = redis.call('HGET', user_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name)
-    local persistent_hdrm_pool_wm = redis.call('HGET', persistent_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name)
-    local periodic_hdrm_pool_wm = redis.call('HGET', periodic_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name)
-
-    if buffer_pool_wm then
-        buffer_pool_wm = tonumber(buffer_pool_wm)
-
-        redis.call('HSET', user_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name,
-                   user_buffer_pool_wm and math.max(buffer_pool_wm, user_buffer_pool_wm) or buffer_pool_wm)
-        redis.call('HSET', persistent_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name,
-                   persistent_buffer_pool_wm and math.max(buffer_pool_wm, persistent_buffer_pool_wm) or buffer_pool_wm)
-        redis.call('HSET', periodic_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name,
-                   periodic_buffer_pool_wm and math.max(buffer_pool_wm, periodic_buffer_pool_wm) or buffer_pool_wm)
-    end
-
-    if hdrm_pool_wm then
-        hdrm_pool_wm = tonumber(hdrm_pool_wm)
-
-        redis.call('HSET', user_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name,
-                   user_hdrm_pool_wm and math.max(hdrm_pool_wm, user_hdrm_pool_wm) or hdrm_pool_wm)
-        redis.call('HSET', persistent_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name,
-                   persistent_hdrm_pool_wm and math.max(hdrm_pool_wm, persistent_hdrm_pool_wm) or hdrm_pool_wm)
-        redis.call('HSET', periodic_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name,
-                   periodic_hdrm_pool_wm and math.max(hdrm_pool_wm, periodic_hdrm_pool_wm) or hdrm_pool_wm)
-    end
+    update_views(KEYS[i], wm_fields)
 end
 
 return rets
@@ -2,36 +2,47 @@
 -- ARGV[1] - counters db index
 -- ARGV[2] - counters table name
 -- ARGV[3] - poll time interval
--- return nothing for now 
+-- return nothing for now
 
 local counters_db = ARGV[1]
-local counters_table_name = "COUNTERS" 
+local counters_table_name = 'COUNTERS'
 
-local periodic_table_name = "PERIODIC_WATERMARKS"
-local persistent_table_name = "PERSISTENT_WATERMARKS"
-local user_table_name = "USER_WATERMARKS"
+local view_table_names = {'PERIODIC_WATERMARKS', 'PERSISTENT_WATERMARKS', 'USER_WATERMARKS'}
+
+local wm_fields = {
+    'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES'
+}
 
 local rets = {}
 
 redis.call('SELECT', counters_db)
 
+-- Raise the watermarks of the three views of an object to the ones of the
+-- last poll: the counters are read once, and each view with one HMGET and
+-- at most one HSET for all the fields
+local function update_views(key, fields)
+    local cur = redis.call('HMGET', counters_table_name .. ':' .. key, unpack(fields))
+    for _, view_table_name in ipairs(view_table_names) do
+        local last = redis.call('HMGET', view_table_name .. ':' .. key, unpack(fields))
+        local fvs = {}
+        for j = 1, table.getn(fields) do
+            local value = tonumber(cur[j])
+            local last_value = tonumber(last[j])
+            if value and (not last_value or value > last_value) then
+                table.insert(fvs, fields[j])
+                table.insert(fvs, cur[j])
+            end
+        end
+        if table.getn(fvs) > 0 then
+            redis.call('HSET', view_table_name .. ':' .. key, unpack(fvs))
+        end
+    end
+end
+
 -- Iterate through each queue
 local n = table.getn(KEYS)
 for i = n, 1, -1 do
-    -- Gen new WM value
-    local queue_shared_wm = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES')
-
-    -- Get the last values in the other tables (assume 0 if does not exist)
-    local periodic_shared_wm = redis.call('HGET', periodic_table_name .. ':' .. KEYS[i], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES') 
-    local persistent_shared_wm = redis.call('HGET', persistent_table_name .. ':' .. KEYS[i], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES')
-    local user_shared_wm = redis.call('HGET', user_table_name .. ':' .. KEYS[i], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES') 
-
-    -- Set the values into the other tables. Make comparioson, if th evalue was absent in COUNTERS, set to N/A
-    if tonumber(queue_shared_wm) then
-        redis.call('HSET', periodic_table_name .. ':' .. KEYS[i], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES', periodic_shared_wm and math.max(queue_shared_wm, periodic_shared_wm) or queue_shared_wm)
-        redis.call('HSET', persistent_table_name .. ':' .. KEYS[i], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES', persistent_shared_wm and math.max(queue_shared_wm, persistent_shared_wm) or queue_shared_wm)
-        redis.call('HSET', user_table_name .. ':' .. KEYS[i], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES', user_shared_wm and math.max(queue_shared_wm, user_shared_wm) or queue_shared_wm)
-    end
+    update_views(KEYS[i], wm_fields)
 end
 
 return rets
@@ -28,9 +28,10 @@ WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
     m_countersDb = make_shared<DBConnector>("COUNTERS_DB", 0);
     m_appDb = make_shared<DBConnector>("APPL_DB", 0);
     m_countersTable = make_shared<Table>(m_countersDb.get(), COUNTERS_TABLE);
-    m_periodicWatermarkTable = make_shared<Table>(m_countersDb.get(), PERIODIC_WATERMARKS_TABLE);
-    m_persistentWatermarkTable = make_shared<Table>(m_countersDb.get(), PERSISTENT_WATERMARKS_TABLE);
-    m_userWatermarkTable = make_shared<Table>(m_countersDb.get(), USER_WATERMARKS_TABLE);
+    m_pipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_countersDb.get()));
+    m_periodicWatermarkTable = make_shared<Table>(m_pipeline.get(), PERIODIC_WATERMARKS_TABLE, true);
+    m_persistentWatermarkTable = make_shared<Table>(m_pipeline.get(), PERSISTENT_WATERMARKS_TABLE, true);
+    m_userWatermarkTable = make_shared<Table>(m_pipeline.get(), USER_WATERMARKS_TABLE, true);
 
     m_clearNotificationConsumer = new swss::NotificationConsumer(
             m_appDb.get(),
@@ -181,53 +182,57 @@ void WatermarkOrch::doTask(NotificationConsumer &consumer)
         return;
     }
 
+    WmClearBatch batch;
+
     if (data == CLEAR_PG_HEADROOM_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      m_pg_ids);
+        addWmClear(batch,
+                   "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
+                   m_pg_ids);
     }
     else if (data == CLEAR_PG_SHARED_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
-                      m_pg_ids);
+        addWmClear(batch,
+                   "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
+                   m_pg_ids);
     }
     else if (data == CLEAR_QUEUE_SHARED_UNI_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_unicast_queue_ids);
+        addWmClear(batch,
+                   "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
+                   m_unicast_queue_ids);
     }
     else if (data == CLEAR_QUEUE_SHARED_MULTI_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_multicast_queue_ids);
+        addWmClear(batch,
+                   "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
+                   m_multicast_queue_ids);
     }
     else if (data == CLEAR_QUEUE_SHARED_ALL_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_all_queue_ids);
+        addWmClear(batch,
+                   "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
+                   m_all_queue_ids);
     }
     else if (data == CLEAR_BUFFER_POOL_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
+        addWmClear(batch,
+                   "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
+                   gBufferOrch->getBufferPoolNameOidMap());
     }
     else if (data == CLEAR_HEADROOM_POOL_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
+        addWmClear(batch,
+                   "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES",
+                   gBufferOrch->getBufferPoolNameOidMap());
     }
     else
     {
         SWSS_LOG_WARN("Unknown watermark clear request data: %s", data.c_str());
         return;
     }
+
+    clearWms(table, batch);
 }
 
 void WatermarkOrch::doTask(SelectableTimer &timer)
@@ -256,27 +261,17 @@ void WatermarkOrch::doTask(SelectableTimer &timer)
             m_telemetryTimer->stop();
         }
 
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
-                      m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_unicast_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_multicast_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_all_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
+        // All the periodic watermarks of an object are zeroed by one write,
+        // and all the objects by one pipeline flush
+        WmClearBatch batch;
+        addWmClear(batch, "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES", m_pg_ids);
+        addWmClear(batch, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES", m_pg_ids);
+        addWmClear(batch, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", m_unicast_queue_ids);
+        addWmClear(batch, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", m_multicast_queue_ids);
+        addWmClear(batch, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", m_all_queue_ids);
+        addWmClear(batch, "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES", gBufferOrch->getBufferPoolNameOidMap());
+        addWmClear(batch, "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES", gBufferOrch->getBufferPoolNameOidMap());
+        clearWms(m_periodicWatermarkTable.get(), batch);
         SWSS_LOG_DEBUG("Periodic watermark cleared by timer!");
     }
 }
@@ -320,29 +315,37 @@ void WatermarkOrch::init_queue_ids()
     }
 }
 
-void WatermarkOrch::clearSingleWm(Table *table, string wm_name, vector<sai_object_id_t> &obj_ids)
+void WatermarkOrch::addWmClear(WmClearBatch &batch, const string &wm_name, const vector<sai_object_id_t> &obj_ids)
 {
-    /* Zero-out some WM in some table for some vector of object ids*/
+    /* Zero-out some WM for some vector of object ids*/
     SWSS_LOG_ENTER();
     SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), obj_ids.size());
 
-    vector<FieldValueTuple> vfvt = {{wm_name, "0"}};
-
     for (sai_object_id_t id: obj_ids)
     {
-        table->set(sai_serialize_object_id(id), vfvt);
+        batch[id].emplace_back(wm_name, "0");
     }
 }
 
-void WatermarkOrch::clearSingleWm(Table *table, string wm_name, const object_reference_map &nameOidMap)
+void WatermarkOrch::addWmClear(WmClearBatch &batch, const string &wm_name, const object_reference_map &nameOidMap)
 {
     SWSS_LOG_ENTER();
     SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), nameOidMap.size());
 
-    vector<FieldValueTuple> fvTuples = {{wm_name, "0"}};
-
     for (const auto &it : nameOidMap)
     {
-        table->set(sai_serialize_object_id(it.second.m_saiObjectId), fvTuples);
+        batch[it.second.m_saiObjectId].emplace_back(wm_name, "0");
+    }
+}
+
+void WatermarkOrch::clearWms(Table *table, const WmClearBatch &batch)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto &it : batch)
+    {
+        table->set(sai_serialize_object_id(it.first), it.second);
     }
+
+    m_pipeline->flush();
 }
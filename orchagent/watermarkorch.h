@@ -7,6 +7,7 @@
 #include "port.h"
 
 #include "notificationconsumer.h"
+#include "redispipeline.h"
 #include "timer.h"
 
 const uint8_t queue_wm_status_mask = 1 << 0;
@@ -34,8 +35,12 @@ public:
     void handleWmConfigUpdate(const std::string &key, const std::vector<swss::FieldValueTuple> &fvt);
     void handleFcConfigUpdate(const std::string &key, const std::vector<swss::FieldValueTuple> &fvt);
 
-    void clearSingleWm(swss::Table *table, std::string wm_name, std::vector<sai_object_id_t> &obj_ids);
-    void clearSingleWm(swss::Table *table, std::string wm_name, const object_reference_map &nameOidMap);
+    /* Watermark fields to zero, per object */
+    typedef std::map<sai_object_id_t, std::vector<swss::FieldValueTuple>> WmClearBatch;
+
+    void addWmClear(WmClearBatch &batch, const std::string &wm_name, const std::vector<sai_object_id_t> &obj_ids);
+    void addWmClear(WmClearBatch &batch, const std::string &wm_name, const object_reference_map &nameOidMap);
+    void clearWms(swss::Table *table, const WmClearBatch &batch);
 
     std::shared_ptr<swss::Table> getCountersTable(void)
     {
@@ -59,6 +64,8 @@ private:
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
     std::shared_ptr<swss::DBConnector> m_appDb = nullptr;
     std::shared_ptr<swss::Table> m_countersTable = nullptr;
+    /* The watermark views are written through one buffered pipeline */
+    std::unique_ptr<swss::RedisPipeline> m_pipeline;
     std::shared_ptr<swss::Table> m_periodicWatermarkTable = nullptr;
     std::shared_ptr<swss::Table> m_persistentWatermarkTable = nullptr;
     std::shared_ptr<swss::Table> m_userWatermarkTable = nullptr;
@@ -1,4 +1,7 @@
+#include <iterator>
+
 #include "zmqorch.h"
+#include "observer.h"
 
 using namespace swss;
 using namespace std;
@@ -16,7 +19,12 @@ void ZmqConsumer::execute()
     {
         std::deque<KeyOpFieldsValuesTuple> entries;
         table->pops(entries);
-        addToSync(entries);
+        if (m_stats)
+        {
+            m_stats->recordPop(entries.size());
+        }
+        // The popped entries are not used again, they are moved rather than copied
+        addToSync(std::move(entries));
     }
     else
     {
@@ -25,17 +33,30 @@ void ZmqConsumer::execute()
             std::deque<KeyOpFieldsValuesTuple> entries;
             table->pops(entries);
             update_size = entries.size();
-            m_queue.insert(m_queue.end(), entries.begin(), entries.end());
+            if (m_stats && update_size != 0)
+            {
+                m_stats->recordPop(update_size);
+            }
+            m_queue.insert(m_queue.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
         } while (update_size != 0);
     }
 
-    drain();
+    drainOrDefer();
 }
 
 void ZmqConsumer::drain()
 {
     if (!m_toSync.empty() || !m_queue.empty())
+    {
+        auto start = beginDrain();
+
+        // What doTask() publishes on an EventBus is delivered once the drain is done
+        EventBatch batch;
+
         (static_cast<ZmqOrch*>(m_orch))->doTask(*this);
+
+        endDrain(start);
+    }
 }
 
 ZmqOrch::ZmqOrch(DBConnector *db, const vector<string> &tableNames, ZmqServer *zmqServer, bool orderedQueue, bool dbPersistence)
@@ -56,20 +77,27 @@ ZmqOrch::ZmqOrch(DBConnector *db, const vector<table_name_with_pri_t> &tableName
     }
 }
 
+ZmqOrch::ZmqOrch(DBConnector *db, const vector<table_name_with_pri_t> &tableNames_with_pri, ZmqServer *zmqServer, const set<string> &zmqTableNames)
+{
+    for (const auto& it : tableNames_with_pri)
+    {
+        addConsumer(db, it.first, it.second, zmqTableNames.count(it.first) ? zmqServer : nullptr);
+    }
+}
+
 void ZmqOrch::addConsumer(DBConnector *db, string tableName, int pri, ZmqServer *zmqServer, bool orderedQueue, bool dbPersistence)
 {
-    if (db->getDbId() == APPL_DB || db->getDbId() == DPU_APPL_DB)
+    if (zmqServer == nullptr)
     {
-        if (zmqServer != nullptr)
-        {
-            SWSS_LOG_DEBUG("ZmqConsumer initialize for: %s", tableName.c_str());
-            addExecutor(new ZmqConsumer(new ZmqConsumerStateTable(db, tableName, *zmqServer, gBatchSize, pri, dbPersistence), this, tableName, orderedQueue));
-        }
-        else
-        {
-            SWSS_LOG_DEBUG("Consumer initialize for: %s", tableName.c_str());
-            addExecutor(new Consumer(new ConsumerStateTable(db, tableName, gBatchSize, pri), this, tableName));
-        }
+        // Same Consumer as any Orch, a prefetched table keeps its reader thread
+        SWSS_LOG_DEBUG("Consumer initialize for: %s", tableName.c_str());
+        Orch::addConsumer(db, tableName, pri);
+    }
+    else if (db->getDbId() == APPL_DB || db->getDbId() == DPU_APPL_DB)
+    {
+        // With persistence the table is written to the DB on a thread of the ZmqConsumerStateTable, off the doTask path
+        SWSS_LOG_DEBUG("ZmqConsumer initialize for: %s", tableName.c_str());
+        addExecutor(new ZmqConsumer(new ZmqConsumerStateTable(db, tableName, *zmqServer, gBatchSize, pri, dbPersistence), this, tableName, orderedQueue));
     }
     else
     {
@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include <deque>
+#include <set>
 #include <orch.h>
 #include "zmqserver.h"
 
@@ -22,6 +23,8 @@ public:
     void execute() override;
     void drain() override;
 
+    bool hasPendingTasks() const override { return !m_toSync.empty() || !m_queue.empty(); }
+
     // If m_ordered_queue is set, m_queue will be used instead of m_toSync for
     // storing requests.
     bool m_ordered_queue;
@@ -33,6 +36,8 @@ class ZmqOrch : public Orch
 public:
     ZmqOrch(swss::DBConnector *db, const std::vector<std::string> &tableNames, swss::ZmqServer *zmqServer, bool orderedQueue = false, bool dbPersistence = true);
     ZmqOrch(swss::DBConnector *db, const std::vector<table_name_with_pri_t> &tableNames_with_pri, swss::ZmqServer *zmqServer, bool orderedQueue = false, bool dbPersistence = true);
+    /* Only the tables of zmqTableNames are read from the ZMQ channel, the others from Redis */
+    ZmqOrch(swss::DBConnector *db, const std::vector<table_name_with_pri_t> &tableNames_with_pri, swss::ZmqServer *zmqServer, const std::set<std::string> &zmqTableNames);
 
     virtual void doTask(ConsumerBase &consumer) { };
     void doTask(Consumer &consumer) override;
@@ -20,6 +20,7 @@
 #include <set>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 
 using namespace std;
 using namespace swss;
@@ -179,8 +180,40 @@ void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
     /* Insert or update the ifindex to key map */
     m_ifindexNameMap[ifindex] = key;
 
-    if (nlmsg_type == RTM_DELLINK)
+    /* The kernel still has the port */
+    auto state = m_portStates.find(key);
+    if (state != m_portStates.end())
     {
+        state->second.stale = false;
+    }
+
+    LinkEvent event{nlmsg_type, key, admin, oper, mtu, Clock::now()};
+    if (m_coalesceWindow.count() == 0)
+    {
+        handleLinkEvent(event);
+        return;
+    }
+
+    /* A flapping port sends many events, only the last one is handled */
+    auto pending = m_pendingEvents.find(ifindex);
+    if (pending != m_pendingEvents.end())
+    {
+        event.first = pending->second.first;
+        pending->second = event;
+    }
+    else
+    {
+        m_pendingEvents.emplace(ifindex, event);
+    }
+}
+
+void LinkSync::handleLinkEvent(const LinkEvent &event)
+{
+    const string &key = event.key;
+
+    if (event.nlmsg_type == RTM_DELLINK)
+    {
+        m_portStates.erase(key);
         m_statePortTable.del(key);
         SWSS_LOG_NOTICE("Delete %s(ok) from state db", key.c_str());
         return;
@@ -194,19 +227,112 @@ void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
     {
         g_portSet.erase(key);
         FieldValueTuple tuple("state", "ok");
-        FieldValueTuple admin_status("admin_status", (admin ? "up" : "down"));
-        FieldValueTuple port_mtu("mtu", to_string(mtu));
+        FieldValueTuple admin_status("admin_status", (event.admin ? "up" : "down"));
+        FieldValueTuple port_mtu("mtu", to_string(event.mtu));
         vector<FieldValueTuple> vector;
         vector.push_back(tuple);
-        FieldValueTuple op("netdev_oper_status", oper ? "up" : "down");
+        FieldValueTuple op("netdev_oper_status", event.oper ? "up" : "down");
         vector.push_back(op);
         vector.push_back(admin_status);
         vector.push_back(port_mtu);
+
+        /* Only the changes are published */
+        auto state = m_portStates.find(key);
+        if (state != m_portStates.end() && state->second.fvs == vector)
+        {
+            SWSS_LOG_INFO("No change of %s(ok:%s), not published", key.c_str(), event.oper ? "up" : "down");
+            return;
+        }
+
         m_statePortTable.set(key, vector);
-        SWSS_LOG_NOTICE("Publish %s(ok:%s) to state db", key.c_str(), oper ? "up" : "down");
+        m_portStates[key] = PortState{vector, false};
+        SWSS_LOG_NOTICE("Publish %s(ok:%s) to state db", key.c_str(), event.oper ? "up" : "down");
     }
     else
     {
         SWSS_LOG_NOTICE("Cannot find %s in port table", key.c_str());
     }
 }
+
+void LinkSync::setCoalesceWindow(int windowMsec)
+{
+    flushPendingEvents(true);
+    m_coalesceWindow = chrono::milliseconds(max(windowMsec, 0));
+}
+
+size_t LinkSync::flushPendingEvents(bool force)
+{
+    auto now = Clock::now();
+    size_t count = 0;
+
+    for (auto it = m_pendingEvents.begin(); it != m_pendingEvents.end();)
+    {
+        if (!force && it->second.first + m_coalesceWindow > now)
+        {
+            ++it;
+            continue;
+        }
+
+        handleLinkEvent(it->second);
+        it = m_pendingEvents.erase(it);
+        count++;
+    }
+    return count;
+}
+
+int LinkSync::getPendingTimeout() const
+{
+    if (m_pendingEvents.empty())
+    {
+        return -1;
+    }
+
+    auto due = Clock::time_point::max();
+    for (const auto &it : m_pendingEvents)
+    {
+        due = min(due, it.second.first + m_coalesceWindow);
+    }
+
+    auto now = Clock::now();
+    if (due <= now)
+    {
+        return 0;
+    }
+
+    // Round up, waking up just before the deadline would only spin
+    auto msec = chrono::duration_cast<chrono::milliseconds>(due - now + chrono::milliseconds(1) - Clock::duration(1)).count();
+    return static_cast<int>(msec);
+}
+
+void LinkSync::startResync()
+{
+    SWSS_LOG_NOTICE("Resyncing %zu ports", m_portStates.size());
+
+    for (auto &it : m_portStates)
+    {
+        it.second.stale = true;
+    }
+    m_resyncing = true;
+}
+
+void LinkSync::endResync()
+{
+    /* The events of the dump go first */
+    flushPendingEvents(true);
+
+    for (auto it = m_portStates.begin(); it != m_portStates.end();)
+    {
+        if (!it->second.stale)
+        {
+            ++it;
+            continue;
+        }
+
+        SWSS_LOG_NOTICE("%s is gone from the kernel, delete %s(ok) from state db",
+                        it->first.c_str(), it->first.c_str());
+        m_statePortTable.del(it->first);
+        it = m_portStates.erase(it);
+    }
+
+    m_resyncing = false;
+}
@@ -5,7 +5,9 @@
 #include "producerstatetable.h"
 #include "netmsg.h"
 
+#include <chrono>
 #include <map>
+#include <vector>
 
 namespace swss {
 
@@ -14,16 +16,68 @@ class LinkSync : public NetMsg
 public:
     enum { MAX_ADDR_SIZE = 64 };
 
+    typedef std::chrono::steady_clock Clock;
+
     LinkSync(DBConnector *appl_db, DBConnector *state_db);
 
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
+    /*
+     * Hold the events of an ifindex for windowMsec from its first one, only
+     * the last one is handled then. 0 handles the events right away.
+     */
+    void setCoalesceWindow(int windowMsec);
+
+    /* Handle the held events which are due, all of them when force is set, returns their count */
+    size_t flushPendingEvents(bool force = false);
+
+    /* Milliseconds until held events are due, -1 if none */
+    int getPendingTimeout() const;
+
+    /*
+     * Resync after lost link events: the ports published so far are stale
+     * until a kernel dump reports them again, endResync() deletes the ones it
+     * did not from STATE_DB.
+     */
+    void startResync();
+    void endResync();
+
+    bool isResyncing() const
+    {
+        return m_resyncing;
+    }
+
 private:
+    /* What the STATE_DB update of a link event depends on */
+    struct LinkEvent
+    {
+        int nlmsg_type;
+        std::string key;
+        bool admin;
+        bool oper;
+        unsigned int mtu;
+        Clock::time_point first;
+    };
+
+    /* STATE_DB fields last published for a port */
+    struct PortState
+    {
+        std::vector<FieldValueTuple> fvs;
+        bool stale;
+    };
+
+    void handleLinkEvent(const LinkEvent &event);
+
     ProducerStateTable m_portTableProducer;
     Table m_portTable, m_statePortTable;
 
     std::map<unsigned int, std::string> m_ifindexNameMap;
     std::map<unsigned int, std::string> m_ifindexOldNameMap;
+
+    std::chrono::milliseconds m_coalesceWindow{0};
+    std::map<unsigned int, LinkEvent> m_pendingEvents;
+    std::map<std::string, PortState> m_portStates;
+    bool m_resyncing = false;
 };
 
 }
@@ -13,6 +13,7 @@
 #include "netlink.h"
 #include "producerstatetable.h"
 #include "portsyncd/linksync.h"
+#include "lib/resyncnetlink.h"
 #include "subscriberstatetable.h"
 #include "exec.h"
 #include "warm_restart.h"
@@ -22,6 +23,9 @@ using namespace swss;
 
 #define DEFAULT_SELECT_TIMEOUT 1000 /* ms */
 
+/* Window the link events of a port are coalesced in, a port flap sends many */
+#define LINK_EVENT_COALESCE_WINDOW 50 /* ms */
+
 /*
  * This g_portSet contains all the front panel ports that the corresponding
  * host interfaces needed to be created. When this LinkSync class is
@@ -81,7 +85,7 @@ int main(int argc, char **argv)
         WarmStart::checkWarmStart("portsyncd", "swss");
         const bool warm = WarmStart::isWarmStart();
 
-        NetLink netlink;
+        ResyncNetLink netlink;
         Select s;
 
         netlink.registerGroup(RTNLGRP_LINK);
@@ -91,56 +95,84 @@ int main(int argc, char **argv)
         handlePortConfigFromConfigDB(p, cfgDb, warm);
 
         LinkSync sync(&appl_db, &state_db);
+        sync.setCoalesceWindow(LINK_EVENT_COALESCE_WINDOW);
         NetDispatcher::getInstance().registerMessageHandler(RTM_NEWLINK, &sync);
         NetDispatcher::getInstance().registerMessageHandler(RTM_DELLINK, &sync);
 
         s.addSelectable(&netlink);
+        bool resyncPending = false;
 
         while (true)
         {
             Selectable *temps;
             int ret;
-            ret = s.select(&temps, DEFAULT_SELECT_TIMEOUT);
+
+            /* Wake up in time for the coalesced link events */
+            int timeout = sync.getPendingTimeout();
+            if (timeout < 0 || timeout > DEFAULT_SELECT_TIMEOUT)
+            {
+                timeout = DEFAULT_SELECT_TIMEOUT;
+            }
+            ret = s.select(&temps, timeout);
 
             if (ret == Select::ERROR)
             {
                 cerr << "Error had been returned in select" << endl;
                 continue;
             }
-            else if (ret == Select::TIMEOUT)
+            else if (ret != Select::TIMEOUT && ret != Select::OBJECT)
             {
+                SWSS_LOG_ERROR("Unknown return value from Select %d", ret);
                 continue;
             }
-            else if (ret != Select::OBJECT)
+
+            if (ret == Select::OBJECT && temps != static_cast<Selectable*>(&netlink))
             {
-                SWSS_LOG_ERROR("Unknown return value from Select %d", ret);
+                SWSS_LOG_ERROR("Unknown object returned by select");
                 continue;
             }
 
-            if (temps == static_cast<Selectable*>(&netlink))
+            if (ret == Select::OBJECT)
             {
-                /* on netlink message, check if PortInitDone should be sent out */
-                if (!g_init && g_portSet.empty())
+                /*
+                 * Link events were lost, dump the kernel links again once the
+                 * dump in progress if any is done. The ports missing from the
+                 * dump are deleted at its end.
+                 */
+                if (netlink.checkOverflow())
                 {
-                    /*
-                     * After finishing reading port configuration file and
-                     * creating all host interfaces, this daemon shall send
-                     * out a signal to orchagent indicating port initialization
-                     * procedure is done and other application could start
-                     * syncing.
-                     */
-                    FieldValueTuple finish_notice("lanes", "0");
-                    vector<FieldValueTuple> attrs = { finish_notice };
-                    p.set("PortInitDone", attrs);
-                    SWSS_LOG_NOTICE("PortInitDone");
-
-                    g_init = true;
+                    resyncPending = true;
+                }
+                if (netlink.checkDumpDone() && sync.isResyncing() && !resyncPending)
+                {
+                    sync.endResync();
+                }
+                if (resyncPending && !netlink.isDumping())
+                {
+                    sync.startResync();
+                    netlink.dumpRequest(RTM_GETLINK);
+                    resyncPending = false;
                 }
             }
-            else
+
+            size_t handled = sync.flushPendingEvents();
+
+            /* on link events, check if PortInitDone should be sent out */
+            if ((ret == Select::OBJECT || handled) && !g_init && g_portSet.empty())
             {
-                SWSS_LOG_ERROR("Unknown object returned by select");
-                continue;
+                /*
+                 * After finishing reading port configuration file and
+                 * creating all host interfaces, this daemon shall send
+                 * out a signal to orchagent indicating port initialization
+                 * procedure is done and other application could start
+                 * syncing.
+                 */
+                FieldValueTuple finish_notice("lanes", "0");
+                vector<FieldValueTuple> attrs = { finish_notice };
+                p.set("PortInitDone", attrs);
+                SWSS_LOG_NOTICE("PortInitDone");
+
+                g_init = true;
             }
         }
     }
@@ -2,9 +2,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "logger.h"
@@ -31,6 +33,7 @@ void usage()
     cout << "       (default config folder is /etc/swss/config.d/)" << endl;
     cout << "Options:" << endl;
     cout << "  -e, --endpoint ENDPOINT    ZMQ endpoint address (e.g., tcp://localhost or tcp://127.0.0.1)" << endl;
+    cout << "  -b, --bulk                 Write the entries of a file grouped by table, one flush per table" << endl;
 }
 
 void dump_db_item(KeyOpFieldsValuesTuple &db_item)
@@ -107,6 +110,89 @@ bool write_db_data(vector<KeyOpFieldsValuesTuple> &db_items, set<string>  &zmq_t
     return true;
 }
 
+/*
+ * Same as write_db_data, with the entries grouped by table in the order the
+ * tables first appear. Consecutive entries of a table with the same operation
+ * are written by a single batch call, which ZMQ tables send as one message,
+ * and the pipeline is flushed once per table. The order between the entries
+ * of different tables is not kept.
+ */
+bool write_db_data_bulk(vector<KeyOpFieldsValuesTuple> &db_items, set<string>  &zmq_tables, std::shared_ptr<ZmqClient> zmq_client, bool use_custom_endpoint)
+{
+    vector<pair<string, vector<KeyOpFieldsValuesTuple>>> tables;
+    unordered_map<string, size_t> table_index;
+
+    // Nothing is written if any entry is invalid
+    for (auto &db_item : db_items)
+    {
+        dump_db_item(db_item);
+
+        string key = kfvKey(db_item);
+        size_t pos = key.find(name_delimiter);
+        if ((string::npos == pos) || ((key.size() - 1) == pos))
+        {
+            SWSS_LOG_ERROR("Invalid formatted hash:%s\n", key.c_str());
+            return false;
+        }
+        if (kfvOp(db_item) != SET_COMMAND && kfvOp(db_item) != DEL_COMMAND)
+        {
+            SWSS_LOG_ERROR("Invalid operation: %s\n", kfvOp(db_item).c_str());
+            return false;
+        }
+
+        string table_name = key.substr(0, pos);
+        auto it = table_index.find(table_name);
+        if (it == table_index.end())
+        {
+            it = table_index.emplace(table_name, tables.size()).first;
+            tables.emplace_back(table_name, vector<KeyOpFieldsValuesTuple>());
+        }
+
+        tables[it->second].second.emplace_back(key.substr(pos + 1), kfvOp(db_item), move(kfvFieldsValues(db_item)));
+    }
+
+    string db_name = use_custom_endpoint ? "DPU_APPL_DB" : "APPL_DB";
+    DBConnector db(db_name, 0, true);
+    // Sized so that only the flush after each table sends the commands
+    RedisPipeline pipeline(&db, db_items.size() + 1);
+    unordered_map<string, shared_ptr<ProducerStateTable>> table_map;
+
+    for (auto &table : tables)
+    {
+        auto p_table = get_table(table_map, pipeline, table.first, zmq_tables, zmq_client);
+        auto &items = table.second;
+
+        auto first = items.begin();
+        while (first != items.end())
+        {
+            auto last = find_if(first, items.end(), [&](const KeyOpFieldsValuesTuple &item) {
+                return kfvOp(item) != kfvOp(*first);
+            });
+
+            if (kfvOp(*first) == SET_COMMAND)
+            {
+                p_table->set(vector<KeyOpFieldsValuesTuple>(first, last));
+            }
+            else
+            {
+                vector<string> keys;
+                for (auto it = first; it != last; ++it)
+                {
+                    keys.push_back(kfvKey(*it));
+                }
+                p_table->del(keys);
+            }
+
+            first = last;
+        }
+
+        pipeline.flush();
+        SWSS_LOG_INFO("Applied %zu entries to %s", items.size(), table.first.c_str());
+    }
+
+    return true;
+}
+
 bool load_json_db_data(ifstream &fs, vector<KeyOpFieldsValuesTuple> &db_items)
 {
     json json_array;
@@ -199,6 +285,7 @@ int main(int argc, char **argv)
 {
     vector<string> files;
     string zmq_endpoint = ZMQ_LOCAL_ADDRESS;
+    bool bulk = false;
     
     // Parse command-line arguments
     for (int i = 1; i < argc; i++)
@@ -216,6 +303,10 @@ int main(int argc, char **argv)
                 exit(EXIT_FAILURE);
             }
         }
+        else if (!strcmp(argv[i], "-b") || !strcmp(argv[i], "--bulk"))
+        {
+            bulk = true;
+        }
         else
         {
             files.push_back(string(argv[i]));
@@ -258,7 +349,9 @@ int main(int argc, char **argv)
                 return EXIT_FAILURE;
             }
 
-            if (!write_db_data(db_items, zmq_tables, zmq_client, use_custom_endpoint))
+            bool written = bulk ? write_db_data_bulk(db_items, zmq_tables, zmq_client, use_custom_endpoint)
+                                : write_db_data(db_items, zmq_tables, zmq_client, use_custom_endpoint);
+            if (!written)
             {
                 SWSS_LOG_ERROR("Failed applying data from JSON file %s", i.c_str());
                 return EXIT_FAILURE;
@@ -0,0 +1,419 @@
+#include <getopt.h>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include <dbconnector.h>
+#include <producerstatetable.h>
+#include <redispipeline.h>
+#include <redisreply.h>
+#include "zmqclient.h"
+#include "zmqproducerstatetable.h"
+#include "orch_zmq_config.h"
+#include <schema.h>
+#include <tokenize.h>
+
+#include "dash_api/vnet.pb.h"
+
+using namespace std;
+using namespace swss;
+
+/* Commands queued on the pipeline before it is flushed */
+#define LOADGEN_PIPELINE_SIZE_DEFAULT 1000
+/* Interval the drain is polled at */
+#define LOADGEN_POLL_INTERVAL_MSEC 100
+
+/*
+ * Synthetic workload of one APPL_DB table. The entries are numbered, key(i)
+ * and fields(i, gen) build the entry i for the generation gen of the churn.
+ */
+struct Workload
+{
+	string table;
+	/* Object type the orch creates for an entry, counted in ASIC_DB */
+	string asicType;
+	function<string(size_t)> key;
+	function<vector<FieldValueTuple>(size_t, size_t)> fields;
+	size_t maxEntries;
+};
+
+struct Options
+{
+	string workload = "route";
+	string pattern = "add";
+	size_t count = 1000;
+	size_t rounds = 1;
+	double rate = 0;
+	size_t pipelineSize = LOADGEN_PIPELINE_SIZE_DEFAULT;
+	bool zmq = false;
+	string watch = "asic";
+	int timeout = 300;
+	vector<string> ifnames = { "Ethernet0" };
+	vector<string> nexthops = { "10.0.0.1" };
+	string vlan = "Vlan1000";
+	string aclTable = "LOADGEN";
+};
+
+void usage()
+{
+	cout << "Usage: swssloadgen [-w workload] [-p pattern] [-n count] [-c rounds] [-r rate] [-b pipeline_size] [-z]" << endl;
+	cout << "                   [-W watch] [-T timeout] [-i ifnames] [-g nexthops] [-v vlan] [-a acl_table]" << endl;
+	cout << "    -w workload: route|neigh|fdb|acl|dash, the APPL_DB table written (default route)" << endl;
+	cout << "    -p pattern: add, set the entries once," << endl;
+	cout << "                update, set them again rounds times with other values," << endl;
+	cout << "                flap, set and delete them rounds times (default add)" << endl;
+	cout << "    -n count: number of entries (default 1000)" << endl;
+	cout << "    -c rounds: rounds of the update and flap patterns (default 1)" << endl;
+	cout << "    -r rate: operations per second, 0 writes as fast as possible (default 0)" << endl;
+	cout << "    -b pipeline_size: commands queued on the pipeline before it is flushed (default 1000)" << endl;
+	cout << "    -z: write through the ZMQ producer, tables listed in the ZMQ table configuration always are" << endl;
+	cout << "    -W watch: asic, wait for the ASIC_DB object count of the workload," << endl;
+	cout << "              response, wait for the APPL_STATE_DB entry count of the table," << endl;
+	cout << "              none, only wait for the table to be consumed (default asic)" << endl;
+	cout << "    -T timeout: seconds to wait for the drain (default 300)" << endl;
+	cout << "    -i ifnames: comma separated interfaces of the routes, neighbors and FDB entries (default Ethernet0)" << endl;
+	cout << "    -g nexthops: comma separated next hops of the routes, paired with the interfaces (default 10.0.0.1)" << endl;
+	cout << "    -v vlan: VLAN of the FDB entries (default Vlan1000)" << endl;
+	cout << "    -a acl_table: ACL table of the rules, created beforehand (default LOADGEN)" << endl;
+}
+
+static string ipv4(uint32_t addr)
+{
+	return to_string(addr >> 24) + "." + to_string((addr >> 16) & 0xff) + "." +
+	       to_string((addr >> 8) & 0xff) + "." + to_string(addr & 0xff);
+}
+
+static string mac(size_t i, size_t gen)
+{
+	stringstream ss;
+	ss << hex << setfill('0') << "02:" << setw(2) << (gen & 0xff);
+	for (int shift = 24; shift >= 0; shift -= 8)
+	{
+		ss << ":" << setw(2) << ((i >> shift) & 0xff);
+	}
+	return ss.str();
+}
+
+static Workload makeWorkload(const Options &opts)
+{
+	const auto &ifnames = opts.ifnames;
+	const auto &nexthops = opts.nexthops;
+
+	if (opts.workload == "route")
+	{
+		/* /24 routes in 10.0.0.0/8, /32 ones past 65536 routes */
+		bool host = opts.count > 0x10000;
+		return Workload{ APP_ROUTE_TABLE_NAME, "SAI_OBJECT_TYPE_ROUTE_ENTRY",
+			[host](size_t i) {
+				return host ? ipv4(0x0a000000 + static_cast<uint32_t>(i)) + "/32"
+				            : ipv4(0x0a000000 + static_cast<uint32_t>(i << 8)) + "/24";
+			},
+			[ifnames, nexthops](size_t i, size_t gen) {
+				size_t k = (i + gen) % nexthops.size();
+				return vector<FieldValueTuple>{ { "nexthop", nexthops[k] }, { "ifname", ifnames[k % ifnames.size()] } };
+			},
+			0x1000000 };
+	}
+	else if (opts.workload == "neigh")
+	{
+		return Workload{ APP_NEIGH_TABLE_NAME, "SAI_OBJECT_TYPE_NEIGHBOR_ENTRY",
+			[ifnames](size_t i) {
+				return ifnames[i % ifnames.size()] + ":" + ipv4(0xac100000 + static_cast<uint32_t>(i));
+			},
+			[](size_t i, size_t gen) {
+				return vector<FieldValueTuple>{ { "neigh", mac(i, gen) }, { "family", "IPv4" } };
+			},
+			0x100000 };
+	}
+	else if (opts.workload == "fdb")
+	{
+		auto vlan = opts.vlan;
+		return Workload{ APP_FDB_TABLE_NAME, "SAI_OBJECT_TYPE_FDB_ENTRY",
+			[vlan](size_t i) {
+				return vlan + ":" + mac(i, 0);
+			},
+			[ifnames](size_t i, size_t gen) {
+				return vector<FieldValueTuple>{ { "port", ifnames[(i + gen) % ifnames.size()] }, { "type", "dynamic" } };
+			},
+			0x100000000 };
+	}
+	else if (opts.workload == "acl")
+	{
+		auto table = opts.aclTable;
+		return Workload{ APP_ACL_RULE_TABLE_NAME, "SAI_OBJECT_TYPE_ACL_ENTRY",
+			[table](size_t i) {
+				return table + ":RULE_" + to_string(i);
+			},
+			[](size_t i, size_t gen) {
+				return vector<FieldValueTuple>{
+					{ "PRIORITY", to_string(1000 + (i % 8000)) },
+					{ "SRC_IP", ipv4(0x0a000000 + static_cast<uint32_t>(i)) + "/32" },
+					{ "PACKET_ACTION", gen % 2 ? "FORWARD" : "DROP" } };
+			},
+			0x1000000 };
+	}
+	else if (opts.workload == "dash")
+	{
+		return Workload{ APP_DASH_VNET_TABLE_NAME, "SAI_OBJECT_TYPE_VNET",
+			[](size_t i) {
+				return "Vnet" + to_string(i);
+			},
+			[](size_t i, size_t gen) {
+				dash::vnet::Vnet vnet;
+				vnet.set_vni(static_cast<uint32_t>((1000 + i + gen) & 0xffffff));
+				return vector<FieldValueTuple>{ { "pb", vnet.SerializeAsString() } };
+			},
+			0x1000000 };
+	}
+
+	throw invalid_argument("unknown workload " + opts.workload);
+}
+
+static size_t countKeys(DBConnector &db, const string &pattern)
+{
+	return db.keys(pattern).size();
+}
+
+static long long countMembers(DBConnector &db, const string &set)
+{
+	RedisCommand command;
+	command.format("SCARD %s", set.c_str());
+	RedisReply reply(&db, command, REDIS_REPLY_INTEGER);
+	return reply.getContext()->integer;
+}
+
+/*
+ * Writes the operations of the pattern, paced to the rate, and returns the
+ * number written.
+ */
+static size_t generate(const Options &opts, const Workload &workload, ProducerStateTable &producer, RedisPipeline &pipeline)
+{
+	size_t ops = 0;
+	auto start = chrono::steady_clock::now();
+
+	auto pace = [&]() {
+		ops++;
+		if (opts.rate <= 0)
+		{
+			return;
+		}
+
+		auto due = start + chrono::duration_cast<chrono::steady_clock::duration>(
+			chrono::duration<double>(static_cast<double>(ops) / opts.rate));
+		if (due > chrono::steady_clock::now())
+		{
+			// Queued commands go out before the wait, they are due already
+			pipeline.flush();
+			this_thread::sleep_until(due);
+		}
+	};
+
+	auto setAll = [&](size_t gen) {
+		for (size_t i = 0; i < opts.count; i++)
+		{
+			producer.set(workload.key(i), workload.fields(i, gen), SET_COMMAND);
+			pace();
+		}
+	};
+
+	auto delAll = [&]() {
+		for (size_t i = 0; i < opts.count; i++)
+		{
+			producer.del(workload.key(i), DEL_COMMAND);
+			pace();
+		}
+	};
+
+	setAll(0);
+	for (size_t round = 1; round <= opts.rounds && opts.pattern != "add"; round++)
+	{
+		if (opts.pattern == "flap")
+		{
+			delAll();
+			if (round < opts.rounds)
+			{
+				setAll(round);
+			}
+		}
+		else
+		{
+			setAll(round);
+		}
+	}
+
+	pipeline.flush();
+	return ops;
+}
+
+int main(int argc, char **argv)
+{
+	Options opts;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "w:p:n:c:r:b:zW:T:i:g:v:a:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'w':
+			opts.workload = optarg;
+			break;
+		case 'p':
+			opts.pattern = optarg;
+			break;
+		case 'n':
+			opts.count = strtoull(optarg, nullptr, 10);
+			break;
+		case 'c':
+			opts.rounds = strtoull(optarg, nullptr, 10);
+			break;
+		case 'r':
+			opts.rate = atof(optarg);
+			break;
+		case 'b':
+			opts.pipelineSize = strtoull(optarg, nullptr, 10);
+			break;
+		case 'z':
+			opts.zmq = true;
+			break;
+		case 'W':
+			opts.watch = optarg;
+			break;
+		case 'T':
+			opts.timeout = atoi(optarg);
+			break;
+		case 'i':
+			opts.ifnames = tokenize(optarg, ',');
+			break;
+		case 'g':
+			opts.nexthops = tokenize(optarg, ',');
+			break;
+		case 'v':
+			opts.vlan = optarg;
+			break;
+		case 'a':
+			opts.aclTable = optarg;
+			break;
+		default:
+			usage();
+			exit(opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE);
+		}
+	}
+
+	if (optind != argc || opts.count == 0 || opts.rounds == 0 || opts.pipelineSize == 0 ||
+	    opts.ifnames.empty() || opts.nexthops.empty() ||
+	    (opts.pattern != "add" && opts.pattern != "update" && opts.pattern != "flap") ||
+	    (opts.watch != "asic" && opts.watch != "response" && opts.watch != "none"))
+	{
+		usage();
+		exit(EXIT_FAILURE);
+	}
+
+	Workload workload;
+	try
+	{
+		workload = makeWorkload(opts);
+	}
+	catch (const exception &e)
+	{
+		cerr << e.what() << endl;
+		usage();
+		exit(EXIT_FAILURE);
+	}
+
+	if (opts.count > workload.maxEntries)
+	{
+		cerr << "At most " << workload.maxEntries << " " << opts.workload << " entries are generated" << endl;
+		exit(EXIT_FAILURE);
+	}
+
+	DBConnector applDb("APPL_DB", 0, true);
+	DBConnector applStateDb("APPL_STATE_DB", 0, true);
+	DBConnector asicDb("ASIC_DB", 0, true);
+
+	shared_ptr<ZmqClient> zmqClient;
+	auto zmqTables = load_zmq_tables();
+	if (opts.zmq || zmqTables.find(workload.table) != zmqTables.end())
+	{
+		zmqClient = create_zmq_client(ZMQ_LOCAL_ADDRESS);
+	}
+
+	RedisPipeline pipeline(&applDb, opts.pipelineSize);
+	auto producer = createProducerStateTable(&pipeline, workload.table, true, zmqClient);
+
+	/* The drain is complete once the count of the watched objects reaches the expected one */
+	string watchPattern;
+	DBConnector *watchDb = nullptr;
+	if (opts.watch == "asic")
+	{
+		watchDb = &asicDb;
+		watchPattern = "ASIC_STATE:" + workload.asicType + ":*";
+	}
+	else if (opts.watch == "response")
+	{
+		watchDb = &applStateDb;
+		watchPattern = workload.table + ":*";
+	}
+
+	size_t baseline = watchDb ? countKeys(*watchDb, watchPattern) : 0;
+	size_t expected = baseline + (opts.pattern == "flap" ? 0 : opts.count);
+
+	// Keys pending for the consumer, ZMQ writes go to orchagent directly
+	string keySet = "_" + workload.table + "_KEY_SET";
+
+	auto start = chrono::steady_clock::now();
+	size_t ops = generate(opts, workload, *producer, pipeline);
+	auto written = chrono::steady_clock::now();
+
+	auto seconds = [&](chrono::steady_clock::time_point t) {
+		return chrono::duration<double>(t - start).count();
+	};
+
+	cout << "Wrote " << ops << " " << workload.table << " operations in " << seconds(written) << " s, "
+	     << (seconds(written) > 0 ? static_cast<double>(ops) / seconds(written) : 0) << " ops/s" << endl;
+
+	auto deadline = written + chrono::seconds(opts.timeout);
+	bool consumed = zmqClient != nullptr;
+	bool drained = watchDb == nullptr;
+	size_t count = baseline;
+	while (!consumed || !drained)
+	{
+		auto now = chrono::steady_clock::now();
+		if (!consumed && countMembers(applDb, keySet) == 0)
+		{
+			consumed = true;
+			cout << "Consumed by orchagent after " << seconds(now) << " s" << endl;
+		}
+
+		if (consumed && !drained)
+		{
+			count = countKeys(*watchDb, watchPattern);
+			if (count == expected)
+			{
+				drained = true;
+				cout << "Drained to " << count << " " << (opts.watch == "asic" ? workload.asicType : workload.table)
+				     << " after " << seconds(now) << " s, " << static_cast<double>(ops) / seconds(now) << " ops/s" << endl;
+			}
+		}
+
+		if (consumed && drained)
+		{
+			break;
+		}
+
+		if (now > deadline)
+		{
+			cerr << "Not drained after " << opts.timeout << " s: " << (consumed ? "" : "table not consumed, ")
+			     << count << " of " << expected << " objects" << endl;
+			return EXIT_FAILURE;
+		}
+
+		this_thread::sleep_for(chrono::milliseconds(LOADGEN_POLL_INTERVAL_MSEC));
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -1,5 +1,11 @@
+#include <getopt.h>
+#include <time.h>
+
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <thread>
 
 #include <dbconnector.h>
 #include <producerstatetable.h>
@@ -15,12 +21,39 @@ using namespace swss;
 static int line_index = 0;
 static DBConnector db("APPL_DB", 0, true);
 
+/* Commands queued on the pipeline of the maximum rate mode before it is flushed */
+#define PLAYER_PIPELINE_SIZE 1000
+
 void usage()
 {
-	cout << "Usage: swssplayer <file>" << endl;
+	cout << "Usage: swssplayer [-t] [-s scale] [-m] <file>" << endl;
+	cout << "    -t: replay the records with the time between them in the file" << endl;
+	cout << "    -s scale: with -t, divide the time between the records by scale" << endl;
+	cout << "    -m: replay as fast as possible, the writes are pipelined" << endl;
+	cout << "Tables listed in the ZMQ table configuration are written through ZMQ" << endl;
 	/* TODO: Add sample input file */
 }
 
+/* Timestamp of a record, as written by the recorder: 2024-01-01.10:20:30.123456 */
+static bool parseTimestamp(const string &s, chrono::microseconds &ts)
+{
+	struct tm tm = {};
+	const char *end = strptime(s.c_str(), "%Y-%m-%d.%H:%M:%S", &tm);
+	if (end == nullptr)
+	{
+		return false;
+	}
+
+	long usec = 0;
+	if (*end == '.')
+	{
+		usec = strtol(end + 1, nullptr, 10);
+	}
+
+	ts = chrono::seconds(timegm(&tm)) + chrono::microseconds(usec);
+	return true;
+}
+
 vector<FieldValueTuple> processFieldsValuesTuple(string s)
 {
 	vector<FieldValueTuple> result;
@@ -37,14 +70,22 @@ vector<FieldValueTuple> processFieldsValuesTuple(string s)
 	return result;
 }
 
-shared_ptr<ProducerStateTable> get_table(unordered_map<string, shared_ptr<ProducerStateTable>>& table_map, string table_name, set<string>  zmq_tables, std::shared_ptr<ZmqClient> zmq_client)
+shared_ptr<ProducerStateTable> get_table(unordered_map<string, shared_ptr<ProducerStateTable>>& table_map, string table_name, set<string>  zmq_tables, std::shared_ptr<ZmqClient> zmq_client, RedisPipeline *pipeline = nullptr)
 {
     shared_ptr<ProducerStateTable> p_table= nullptr;
     auto findResult = table_map.find(table_name);
     if (findResult == table_map.end())
     {
         if ((zmq_tables.find(table_name) != zmq_tables.end()) && (zmq_client != nullptr)) {
-            p_table = make_shared<ZmqProducerStateTable>(&db, table_name, *zmq_client, true);
+            if (pipeline != nullptr) {
+                p_table = make_shared<ZmqProducerStateTable>(pipeline, table_name, *zmq_client);
+            }
+            else {
+                p_table = make_shared<ZmqProducerStateTable>(&db, table_name, *zmq_client, true);
+            }
+        }
+        else if (pipeline != nullptr) {
+            p_table = make_shared<ProducerStateTable>(pipeline, table_name, true);
         }
         else {
             p_table = make_shared<ProducerStateTable>(&db, table_name);
@@ -60,16 +101,26 @@ shared_ptr<ProducerStateTable> get_table(unordered_map<string, shared_ptr<Produc
     return p_table;
 }
 
-void processTokens(vector<string> tokens, unordered_map<string, shared_ptr<ProducerStateTable>>& table_map, set<string>  zmq_tables, std::shared_ptr<ZmqClient> zmq_client)
+bool processTokens(vector<string> tokens, unordered_map<string, shared_ptr<ProducerStateTable>>& table_map, set<string>  zmq_tables, std::shared_ptr<ZmqClient> zmq_client, RedisPipeline *pipeline = nullptr)
 {
+	/* Recording start and other notes carry no operation */
+	if (tokens.size() < 3)
+	{
+		return false;
+	}
+
 	auto key = tokens[1];
 
 	/* Process the key */
 	auto v_key = tokenize(key, ':', 1);
+	if (v_key.size() < 2)
+	{
+		return false;
+	}
 	auto table_name = v_key[0];
 	auto key_name = v_key[1];
 
-	auto p_producer= get_table(table_map, table_name, zmq_tables, zmq_client);
+	auto p_producer= get_table(table_map, table_name, zmq_tables, zmq_client, pipeline);
 
 	/* Process the operation */
 	auto op = tokens[2];
@@ -82,17 +133,48 @@ void processTokens(vector<string> tokens, unordered_map<string, shared_ptr<Produ
 	{
 		p_producer->del(key_name, DEL_COMMAND);
 	}
+	else
+	{
+		return false;
+	}
+
+	return true;
 }
 
 int main(int argc, char **argv)
 {
-	if (argc != 2)
+	bool timing = false;
+	bool max_rate = false;
+	double scale = 1.0;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "ts:mh")) != -1)
+	{
+		switch (opt)
+		{
+		case 't':
+			timing = true;
+			break;
+		case 's':
+			scale = atof(optarg);
+			timing = true;
+			break;
+		case 'm':
+			max_rate = true;
+			break;
+		default:
+			usage();
+			exit(opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE);
+		}
+	}
+
+	if (optind != argc - 1 || scale <= 0 || (timing && max_rate))
 	{
 		usage();
 		exit(EXIT_FAILURE);
 	}
 
-	ifstream file(argv[1]);
+	ifstream file(argv[optind]);
 	string line;
 
     auto zmq_tables = load_zmq_tables();
@@ -102,12 +184,64 @@ int main(int argc, char **argv)
         zmq_client = create_zmq_client(ZMQ_LOCAL_ADDRESS);
     }
 
+	unique_ptr<RedisPipeline> pipeline;
+	if (max_rate)
+	{
+		pipeline = make_unique<RedisPipeline>(&db, PLAYER_PIPELINE_SIZE);
+	}
+
+	size_t ops = 0;
+	chrono::microseconds first_ts(0);
+	bool has_first_ts = false;
+	chrono::steady_clock::duration max_late(0);
+
     unordered_map<string, shared_ptr<ProducerStateTable>> table_map;
+	auto start = chrono::steady_clock::now();
 	while (getline(file, line))
 	{
 		auto tokens = tokenize(line, '|', 3);
-		processTokens(tokens, table_map, zmq_tables, zmq_client);
+
+		chrono::microseconds ts;
+		if (timing && !tokens.empty() && parseTimestamp(tokens[0], ts))
+		{
+			if (!has_first_ts)
+			{
+				first_ts = ts;
+				has_first_ts = true;
+			}
+
+			// Scheduled against the start of the replay, a slow write does not delay the records after it
+			auto due = start + chrono::duration_cast<chrono::steady_clock::duration>((ts - first_ts) / scale);
+			auto now = chrono::steady_clock::now();
+			if (due > now)
+			{
+				this_thread::sleep_until(due);
+			}
+			else if (now - due > max_late)
+			{
+				max_late = now - due;
+			}
+		}
+
+		if (processTokens(tokens, table_map, zmq_tables, zmq_client, pipeline.get()))
+		{
+			ops++;
+		}
 
 		line_index++;
 	}
+
+	if (pipeline)
+	{
+		pipeline->flush();
+	}
+
+	auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	cout << "Replayed " << ops << " operations of " << line_index << " lines in " << elapsed << " s, "
+	     << (elapsed > 0 ? static_cast<double>(ops) / elapsed : 0) << " ops/s" << endl;
+	if (timing)
+	{
+		cout << "Most behind the recorded timing: "
+		     << chrono::duration_cast<chrono::microseconds>(max_late).count() << " us" << endl;
+	}
 }
@@ -0,0 +1,67 @@
+#include <fstream>
+#include <iostream>
+
+#include "recbinary.h"
+
+using namespace std;
+using namespace swss;
+
+void usage()
+{
+	cout << "Usage: swssrecdump [file ...]" << endl;
+	cout << "Prints the text lines of binary swss.rec files, or of the standard input" << endl;
+}
+
+static bool dump(istream &is, const string &name)
+{
+	RecBinaryReader reader(is);
+	if (!reader.begin())
+	{
+		cerr << name << ": not a binary swss record file" << endl;
+		return false;
+	}
+
+	string line;
+	while (reader.next(line))
+	{
+		cout << line << '\n';
+	}
+
+	if (!reader.complete())
+	{
+		// The last record was being written when the file was copied or orchagent stopped
+		cerr << name << ": truncated or malformed record, stopped" << endl;
+		return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc == 2 && (string(argv[1]) == "-h" || string(argv[1]) == "--help"))
+	{
+		usage();
+		return EXIT_SUCCESS;
+	}
+
+	if (argc == 1)
+	{
+		return dump(cin, "<stdin>") ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	bool ok = true;
+	for (int i = 1; i < argc; i++)
+	{
+		ifstream file(argv[i], ios::binary);
+		if (!file.is_open())
+		{
+			cerr << argv[i] << ": failed to open" << endl;
+			ok = false;
+			continue;
+		}
+		ok = dump(file, argv[i]) && ok;
+	}
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
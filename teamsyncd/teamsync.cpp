@@ -11,6 +11,7 @@
 #include "producerstatetable.h"
 #include "warm_restart.h"
 #include "teamsync.h"
+#include "lib/orch_zmq_config.h"
 
 #include <team.h>
 #include <teamdctl.h>
@@ -25,8 +26,10 @@ using namespace swss;
 
 TeamSync::TeamSync(DBConnector *db, DBConnector *stateDb, Select *select) :
     m_select(select),
-    m_lagTable(db, APP_LAG_TABLE_NAME),
-    m_lagMemberTable(db, APP_LAG_MEMBER_TABLE_NAME),
+    // When the feature ORCH_NORTHBOND_LAG_ZMQ_ENABLED is enabled, LAG events must be sent to orchagent via the ZMQ channel.
+    m_zmqClient(create_local_zmq_client(ORCH_NORTHBOND_LAG_ZMQ_ENABLED, false)),
+    m_lagTable(createProducerStateTable(db, APP_LAG_TABLE_NAME, m_zmqClient)),
+    m_lagMemberTable(createProducerStateTable(db, APP_LAG_MEMBER_TABLE_NAME, m_zmqClient)),
     m_stateLagTable(stateDb, STATE_LAG_TABLE_NAME)
 {
     WarmStart::initialize(TEAMSYNCD_APP_NAME, "teamd");
@@ -38,8 +41,16 @@ TeamSync::TeamSync(DBConnector *db, DBConnector *stateDb, Select *select) :
         m_start_time = steady_clock::now();
         auto warmRestartIval = WarmStart::getWarmStartTimer(TEAMSYNCD_APP_NAME, "teamd");
         m_pending_timeout = warmRestartIval ? warmRestartIval : DEFAULT_WR_PENDING_TIMEOUT;
-        m_lagTable.create_temp_view();
-        m_lagMemberTable.create_temp_view();
+        if (m_zmqClient)
+        {
+            Table(db, APP_LAG_TABLE_NAME).getKeys(m_warmLags);
+            Table(db, APP_LAG_MEMBER_TABLE_NAME).getKeys(m_warmLagMembers);
+        }
+        else
+        {
+            m_lagTable->create_temp_view();
+            m_lagMemberTable->create_temp_view();
+        }
         WarmStart::setWarmStartState(TEAMSYNCD_APP_NAME, WarmStart::INITIALIZED);
         SWSS_LOG_NOTICE("Starting in warmstart mode");
     }
@@ -85,8 +96,35 @@ void TeamSync::applyState()
 {
     SWSS_LOG_NOTICE("Applying state");
 
-    m_lagTable.apply_temp_view();
-    m_lagMemberTable.apply_temp_view();
+    if (m_zmqClient)
+    {
+        for (const auto &key : m_warmLagMembers)
+        {
+            auto pos = key.find(':');
+            auto lag = m_teamSelectables.find(key.substr(0, pos));
+            if (pos == string::npos || lag == m_teamSelectables.end() ||
+                !lag->second->m_lagMembers.count(key.substr(pos + 1)))
+            {
+                SWSS_LOG_NOTICE("Remove stale LAG member %s", key.c_str());
+                m_lagMemberTable->del(key);
+            }
+        }
+        for (const auto &key : m_warmLags)
+        {
+            if (!m_teamSelectables.count(key))
+            {
+                SWSS_LOG_NOTICE("Remove stale LAG %s", key.c_str());
+                m_lagTable->del(key);
+            }
+        }
+        m_warmLags.clear();
+        m_warmLagMembers.clear();
+    }
+    else
+    {
+        m_lagTable->apply_temp_view();
+        m_lagMemberTable->apply_temp_view();
+    }
 
     for(auto &it: m_stateLagTablePreserved)
     {
@@ -154,7 +192,7 @@ void TeamSync::addLag(const string &lagName, int ifindex, bool admin_state,
     fvVector.push_back(a);
     fvVector.push_back(o);
     fvVector.push_back(m);
-    m_lagTable.set(lagName, fvVector);
+    m_lagTable->set(lagName, fvVector);
 
     SWSS_LOG_INFO("Add %s admin_status:%s oper_status:%s, mtu: %d",
                    lagName.c_str(), admin_state ? "up" : "down", oper_state ? "up" : "down", mtu);
@@ -193,7 +231,7 @@ void TeamSync::addLag(const string &lagName, int ifindex, bool admin_state,
          * teamd has not yet finished setting up. */
         try
         {
-            auto sync = make_shared<TeamPortSync>(lagName, ifindex, &m_lagMemberTable);
+            auto sync = make_shared<TeamPortSync>(lagName, ifindex, m_lagMemberTable.get());
             if (m_warmstart)
             {
                 m_stateLagTablePreserved[lagName] = fvVector;
@@ -231,14 +269,14 @@ void TeamSync::removeLag(const string &lagName)
     auto selectable = m_teamSelectables[lagName];
     for (auto it : selectable->m_lagMembers)
     {
-        m_lagMemberTable.del(lagName + ":" + it.first);
+        m_lagMemberTable->del(lagName + ":" + it.first);
 
         SWSS_LOG_INFO("Remove member %s before removing LAG %s",
                 it.first.c_str(), lagName.c_str());
     }
 
     /* Delete the LAG */
-    m_lagTable.del(lagName);
+    m_lagTable->del(lagName);
 
     SWSS_LOG_INFO("Remove LAG %s", lagName.c_str());
 
@@ -377,6 +415,39 @@ TeamSync::TeamPortSync::~TeamPortSync()
     }
 }
 
+void TeamSync::TeamPortSync::setMember(const string &member, bool enabled)
+{
+    auto it = m_lagMembers.find(member);
+    if (it != m_lagMembers.end() && it->second == enabled)
+    {
+        return;
+    }
+
+    string key = m_lagName + ":" + member;
+    vector<FieldValueTuple> v;
+    FieldValueTuple l("status", enabled ? "enabled" : "disabled");
+    v.push_back(l);
+    m_lagMemberTable->set(key, v);
+    m_lagMembers[member] = enabled;
+
+    SWSS_LOG_INFO("Set LAG %s member %s with status %s",
+            m_lagName.c_str(), member.c_str(), enabled ? "enabled" : "disabled");
+}
+
+void TeamSync::TeamPortSync::removeMember(const string &member)
+{
+    if (m_lagMembers.erase(member) == 0)
+    {
+        return;
+    }
+
+    string key = m_lagName + ":" + member;
+    m_lagMemberTable->del(key);
+
+    SWSS_LOG_INFO("Remove member %s from LAG %s",
+            member.c_str(), m_lagName.c_str());
+}
+
 int TeamSync::TeamPortSync::onChange()
 {
     struct team_port *port;
@@ -406,45 +477,99 @@ int TeamSync::TeamPortSync::onChange()
 
         team_get_port_enabled(m_team, ifindex, &enabled);
         tmp_lag_members[string(ifname)] = enabled;
+        m_memberNames[ifindex] = ifname;
     }
 
     /* Compare old and new LAG members and set/del accordingly */
     for (auto it : tmp_lag_members)
     {
-        if (m_lagMembers.find(it.first) == m_lagMembers.end() || it.second != m_lagMembers[it.first])
+        setMember(it.first, it.second);
+    }
+
+    for (auto it = m_lagMembers.begin(); it != m_lagMembers.end();)
+    {
+        const string member = (it++)->first;
+        if (tmp_lag_members.find(member) == tmp_lag_members.end())
+        {
+            removeMember(member);
+        }
+    }
+
+    return 0;
+}
+
+int TeamSync::TeamPortSync::onChange(team_change_type_mask_t type_mask)
+{
+    if (type_mask & TEAM_PORT_CHANGE)
+    {
+        struct team_port *port;
+
+        team_for_each_port(port, m_team)
         {
-            string key = m_lagName + ":" + it.first;
-            vector<FieldValueTuple> v;
-            FieldValueTuple l("status", it.second ? "enabled" : "disabled");
-            v.push_back(l);
-            m_lagMemberTable->set(key, v);
-
-            SWSS_LOG_INFO("Set LAG %s member %s with status %s",
-                    m_lagName.c_str(), it.first.c_str(), it.second ? "enabled" : "disabled");
+            if (!team_is_port_changed(port))
+            {
+                continue;
+            }
+
+            uint32_t ifindex = team_get_port_ifindex(port);
+
+            if (team_is_port_removed(port))
+            {
+                auto it = m_memberNames.find(ifindex);
+                if (it != m_memberNames.end())
+                {
+                    removeMember(it->second);
+                    m_memberNames.erase(it);
+                }
+                continue;
+            }
+
+            char ifname[MAX_IFNAME + 1] = {0};
+            bool enabled;
+
+            /* Skip if interface is not found */
+            if (!team_ifindex2ifname(m_team, ifindex, ifname, MAX_IFNAME))
+            {
+                SWSS_LOG_INFO("Interface ifindex(%u) is not found", ifindex);
+                continue;
+            }
+
+            team_get_port_enabled(m_team, ifindex, &enabled);
+            m_memberNames[ifindex] = ifname;
+            setMember(ifname, enabled);
         }
     }
 
-    for (auto it : m_lagMembers)
+    if (type_mask & TEAM_OPTION_CHANGE)
     {
-        if (tmp_lag_members.find(it.first) == tmp_lag_members.end())
+        struct team_option *option;
+
+        /* LACP selection toggles the per port "enabled" option */
+        team_for_each_option(option, m_team)
         {
-            string key = m_lagName + ":" + it.first;
-            m_lagMemberTable->del(key);
+            if (!team_is_option_changed(option) || !team_is_option_per_port(option) ||
+                strcmp(team_get_option_name(option), "enabled") != 0)
+            {
+                continue;
+            }
+
+            auto it = m_memberNames.find(team_get_option_port_ifindex(option));
+            if (it == m_memberNames.end() || m_lagMembers.find(it->second) == m_lagMembers.end())
+            {
+                continue;
+            }
 
-            SWSS_LOG_INFO("Remove member %s from LAG %s",
-                    it.first.c_str(), m_lagName.c_str());
+            setMember(it->second, team_get_option_value_bool(option));
         }
     }
 
-    /* Replace the old LAG members with the new ones */
-    m_lagMembers = tmp_lag_members;
     return 0;
 }
 
 int TeamSync::TeamPortSync::teamdHandler(struct team_handle *team, void *arg,
                                          team_change_type_mask_t type_mask)
 {
-    return ((TeamSync::TeamPortSync *)arg)->onChange();
+    return ((TeamSync::TeamPortSync *)arg)->onChange(type_mask);
 }
 
 int TeamSync::TeamPortSync::getFd()
@@ -2,10 +2,12 @@
 #define __TEAMSYNC__
 
 #include <map>
+#include <set>
 #include <string>
 #include <memory>
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "zmqclient.h"
 #include "selectable.h"
 #include "select.h"
 #include "netmsg.h"
@@ -47,15 +49,24 @@ public:
         bool oper_state;
         unsigned int mtu;
     protected:
+        /* Walk all ports of the LAG, only used for the initial sync */
         int onChange();
+        /* Handle only the ports and options libteam reports as changed */
+        int onChange(team_change_type_mask_t type_mask);
         static int teamdHandler(struct team_handle *th, void *arg,
                                 team_change_type_mask_t type_mask);
         static const struct team_change_handler gPortChangeHandler;
+
+        /* Write LAG_MEMBER_TABLE only if the member state differs from m_lagMembers */
+        void setMember(const std::string &member, bool enabled);
+        void removeMember(const std::string &member);
     private:
         ProducerStateTable *m_lagMemberTable;
         struct team_handle *m_team;
         std::string m_lagName;
         int m_ifindex;
+        /* Member names by ifindex, a removed port may no longer resolve */
+        std::map<uint32_t, std::string> m_memberNames;
     };
 
 protected:
@@ -71,11 +82,20 @@ protected:
 
 private:
     Select *m_select;
-    ProducerStateTable m_lagTable;
-    ProducerStateTable m_lagMemberTable;
+    /* Set when LAG_TABLE and LAG_MEMBER_TABLE are sent to orchagent via the ZMQ channel */
+    std::shared_ptr<ZmqClient> m_zmqClient;
+    std::shared_ptr<ProducerStateTable> m_lagTable;
+    std::shared_ptr<ProducerStateTable> m_lagMemberTable;
     Table m_stateLagTable;
 
     bool m_warmstart;
+    /*
+     * LAGs and LAG members in APPL_DB when a warm start began. A temp view is
+     * not available over the ZMQ channel, those not learnt again by the end of
+     * the warm start are removed instead.
+     */
+    std::vector<std::string> m_warmLags;
+    std::vector<std::string> m_warmLagMembers;
     std::unordered_map<std::string, std::vector<FieldValueTuple>> m_stateLagTablePreserved;
     steady_clock::time_point m_start_time;
     uint32_t m_pending_timeout;
@@ -380,7 +380,7 @@ class TestAcl(object):
                             priority=3, action=Action.ACTION_PERMIT, terminating=False,
                             src_addr=["192.168.0.1/32", "192.168.1.2/30"], dst_addr=["192.168.0.1/32", "192.168.1.2/30"],
                             src_port=[PortRange(0,1)], dst_port=[PortRange(0,1)])
-        ctx.asic_dash_acl_rule_table.wait_for_n_keys(num_keys=4)
+        ctx.asic_dash_acl_rule_table.wait_for_n_keys(num_keys=3)
 
     def test_acl_group(self, ctx):
         ctx.create_acl_group(ACL_GROUP_1, IpVersion.IP_VERSION_IPV6)
@@ -1,5 +1,6 @@
 #include "ut_helper.h"
 #include "flowcounterrouteorch.h"
+#include "saicapabilitycache.h"
 
 extern sai_object_id_t gSwitchId;
 
@@ -147,6 +148,30 @@ namespace aclorch_test
         ASSERT_TRUE(Check::AttrListEq(SAI_OBJECT_TYPE_ACL_TABLE, res->attr_list, attr_list));
     }
 
+    TEST_F(AclTest, MatchTemplates)
+    {
+        auto l3TableType = AclTableTypeBuilder().withName(TABLE_TYPE_L3).build();
+        auto l3v6TableType = AclTableTypeBuilder().withName(TABLE_TYPE_L3V6).build();
+
+        auto match = l3TableType.getMatchTemplate(MATCH_L4_SRC_PORT_RANGE);
+        ASSERT_NE(match, nullptr);
+        ASSERT_EQ(match->attr, SAI_ACL_ENTRY_ATTR_FIELD_ACL_RANGE_TYPE);
+        ASSERT_EQ(match->format, AclMatchFormat::RANGE);
+
+        ASSERT_EQ(l3TableType.getMatchTemplate("NO_SUCH_MATCH"), nullptr);
+        ASSERT_EQ(l3TableType.getMatchTemplate(ACTION_PACKET_ACTION), nullptr);
+
+        // IP_PROTOCOL is matched as NEXT_HEADER on IPv6 tables only
+        match = l3TableType.getMatchTemplate(MATCH_IP_PROTOCOL);
+        ASSERT_EQ(match->attr, SAI_ACL_ENTRY_ATTR_FIELD_IP_PROTOCOL);
+        ASSERT_FALSE(match->deprecated);
+
+        match = l3v6TableType.getMatchTemplate(MATCH_IP_PROTOCOL);
+        ASSERT_EQ(match->attr, SAI_ACL_ENTRY_ATTR_FIELD_IPV6_NEXT_HEADER);
+        ASSERT_EQ(match->format, AclMatchFormat::U8);
+        ASSERT_TRUE(match->deprecated);
+    }
+
     struct MockAclOrch
     {
         AclOrch *m_aclOrch;
@@ -492,6 +517,7 @@ namespace aclorch_test
             gSwitchId = 0;
 
             sai_api_uninitialize();
+            SaiCapabilityCache::instance().clear();
 
             sai_switch_api = nullptr;
             sai_acl_api = nullptr;
@@ -1898,6 +1924,373 @@ namespace aclorch_test
         ASSERT_TRUE(orch->m_aclOrch->removeAclRule(tableId, ruleId));
     }
 
+    uint32_t _ut_stub_get_acl_table_attribute_calls;
+
+    sai_status_t _ut_stub_get_acl_table_attribute(
+        _In_ sai_object_id_t acl_table_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list)
+    {
+        _ut_stub_get_acl_table_attribute_calls++;
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            attr_list[i].value.u32 = 100;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    TEST_F(AclOrchTest, CrmAclTableAvailabilityQueriedOnUsageChange)
+    {
+        auto old_get_acl_table_attribute = sai_acl_api->get_acl_table_attribute;
+        sai_acl_api->get_acl_table_attribute = _ut_stub_get_acl_table_attribute;
+        _ut_stub_get_acl_table_attribute_calls = 0;
+
+        sai_object_id_t table_oid = 0x1234;
+        auto key = Portal::CrmOrchInternal::getCrmAclTableKey(gCrmOrch, table_oid);
+        auto const &entries = Portal::CrmOrchInternal::getResourceMap(gCrmOrch).at(CrmResourceType::CRM_ACL_ENTRY).countersMap;
+
+        // A new table is queried on the first poll
+        gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, table_oid);
+        Portal::CrmOrchInternal::getResAvailableCounters(gCrmOrch);
+        ASSERT_EQ(_ut_stub_get_acl_table_attribute_calls, 1);
+        ASSERT_EQ(entries.at(key).availableCounter, 100);
+
+        // Between queries the available counter follows the usage
+        gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, table_oid);
+        ASSERT_EQ(entries.at(key).availableCounter, 99);
+        Portal::CrmOrchInternal::getResAvailableCounters(gCrmOrch);
+        ASSERT_EQ(_ut_stub_get_acl_table_attribute_calls, 2);
+
+        // An unchanged table is queried again only every fourth poll
+        for (int i = 0; i < 3; i++)
+        {
+            Portal::CrmOrchInternal::getResAvailableCounters(gCrmOrch);
+        }
+        ASSERT_EQ(_ut_stub_get_acl_table_attribute_calls, 2);
+        Portal::CrmOrchInternal::getResAvailableCounters(gCrmOrch);
+        ASSERT_EQ(_ut_stub_get_acl_table_attribute_calls, 3);
+
+        gCrmOrch->decCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, table_oid);
+        gCrmOrch->decCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, table_oid);
+
+        sai_acl_api->get_acl_table_attribute = old_get_acl_table_attribute;
+    }
+
+    struct AclOrchBulkTest : public AclOrchTest
+    {
+        void SetUp() override
+        {
+            AclOrchTest::SetUp();
+            AclOrch::setBulkRules(true);
+        }
+
+        void TearDown() override
+        {
+            AclOrch::setBulkRules(false);
+            AclOrchTest::TearDown();
+        }
+    };
+
+    TEST_F(AclOrchBulkTest, AclRule_BulkCreateAndRemove)
+    {
+        string tableId = "acl_table";
+
+        auto orch = createAclOrch();
+
+        auto kvfAclTable = deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            SET_COMMAND,
+            {
+                { ACL_TABLE_DESCRIPTION, "L3 table" },
+                { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                { ACL_TABLE_STAGE, STAGE_INGRESS },
+                { ACL_TABLE_PORTS, "1,2" }
+            }
+        }});
+
+        orch->doAclTableTask(kvfAclTable);
+
+        auto tableOid = orch->getTableById(tableId);
+        ASSERT_NE(tableOid, SAI_NULL_OBJECT_ID);
+
+        // add acl rules in one bulk, two of them sharing a range ...
+
+        auto kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            {
+                tableId + "|rule_1",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD },
+                    { MATCH_SRC_IP, "1.2.3.4" }
+                }
+            },
+            {
+                tableId + "|rule_2",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_L4_SRC_PORT_RANGE, "10-20" }
+                }
+            },
+            {
+                tableId + "|rule_3",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_L4_SRC_PORT_RANGE, "10-20" },
+                    { MATCH_DST_IP, "4.3.2.1" }
+                }
+            }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        // validate acl rules add ...
+
+        ASSERT_EQ(orch->getAclTables().at(tableOid).rules.size(), 3);
+        for (const auto &ruleId: { "rule_1", "rule_2", "rule_3" })
+        {
+            auto rule = orch->m_aclOrch->getAclRule(tableId, ruleId);
+            ASSERT_NE(rule, nullptr);
+            ASSERT_NE(rule->getOid(), SAI_NULL_OBJECT_ID);
+            ASSERT_NE(rule->getCounterOid(), SAI_NULL_OBJECT_ID);
+            ASSERT_TRUE(validateAclRuleCounter(*rule, true));
+        }
+
+        // replace rule_2, the removal and the creation are both bulked ...
+
+        kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            {
+                tableId + "|rule_2",
+                DEL_COMMAND,
+                {}
+            },
+            {
+                tableId + "|rule_2",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD },
+                    { MATCH_L4_SRC_PORT_RANGE, "10-20" }
+                }
+            }
+        });
+
+        auto oldRuleOid = orch->m_aclOrch->getAclRule(tableId, "rule_2")->getOid();
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        auto rule = orch->m_aclOrch->getAclRule(tableId, "rule_2");
+        ASSERT_NE(rule, nullptr);
+        ASSERT_NE(rule->getOid(), SAI_NULL_OBJECT_ID);
+        ASSERT_NE(rule->getOid(), oldRuleOid);
+        ASSERT_EQ(orch->getAclTables().at(tableOid).rules.size(), 3);
+
+        // delete acl rules ...
+
+        kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            { tableId + "|rule_1", DEL_COMMAND, {} },
+            { tableId + "|rule_2", DEL_COMMAND, {} },
+            { tableId + "|rule_3", DEL_COMMAND, {} }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        ASSERT_TRUE(orch->getAclTables().at(tableOid).rules.empty());
+
+        // delete acl table ...
+
+        kvfAclTable = deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            DEL_COMMAND,
+            {}
+        }});
+
+        orch->doAclTableTask(kvfAclTable);
+
+        ASSERT_EQ(orch->getAclTables().find(tableOid), orch->getAclTables().end());
+    }
+
+    TEST_F(AclOrchBulkTest, AclRule_RangeKeptForReuse)
+    {
+        string tableId = "acl_table";
+
+        auto orch = createAclOrch();
+
+        auto kvfAclTable = deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            SET_COMMAND,
+            {
+                { ACL_TABLE_DESCRIPTION, "L3 table" },
+                { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                { ACL_TABLE_STAGE, STAGE_INGRESS },
+                { ACL_TABLE_PORTS, "1,2" }
+            }
+        }});
+
+        orch->doAclTableTask(kvfAclTable);
+
+        auto kvfAclRule = deque<KeyOpFieldsValuesTuple>({{
+            tableId + "|rule_1",
+            SET_COMMAND,
+            {
+                { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                { MATCH_L4_SRC_PORT_RANGE, "50-60" }
+            }
+        }});
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        auto rangeKey = make_tuple(SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE, 50, 60);
+        ASSERT_EQ(AclRange::m_ranges.count(rangeKey), 1);
+        auto rangeOid = AclRange::m_ranges.at(rangeKey)->getOid();
+        ASSERT_NE(rangeOid, SAI_NULL_OBJECT_ID);
+
+        // replace the rule, its range is taken back instead of removed and created again ...
+
+        kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            { tableId + "|rule_1", DEL_COMMAND, {} },
+            {
+                tableId + "|rule_1",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD },
+                    { MATCH_L4_SRC_PORT_RANGE, "50-60" }
+                }
+            }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        auto rule = orch->m_aclOrch->getAclRule(tableId, "rule_1");
+        ASSERT_NE(rule, nullptr);
+        ASSERT_EQ(rule->m_ranges.size(), 1);
+        ASSERT_EQ(rule->m_ranges[0]->getOid(), rangeOid);
+        ASSERT_TRUE(AclRange::m_unused.empty());
+
+        // delete the rule, the range is removed once the drain is done ...
+
+        kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            { tableId + "|rule_1", DEL_COMMAND, {} }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        ASSERT_EQ(AclRange::m_ranges.count(rangeKey), 0);
+        ASSERT_TRUE(AclRange::m_unused.empty());
+    }
+
+    TEST_F(AclOrchBulkTest, AclRule_UpdateInPlace)
+    {
+        string tableId = "acl_table";
+
+        auto orch = createAclOrch();
+
+        auto kvfAclTable = deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            SET_COMMAND,
+            {
+                { ACL_TABLE_DESCRIPTION, "L3 table" },
+                { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                { ACL_TABLE_STAGE, STAGE_INGRESS },
+                { ACL_TABLE_PORTS, "1,2" }
+            }
+        }});
+
+        orch->doAclTableTask(kvfAclTable);
+
+        auto tableOid = orch->getTableById(tableId);
+        ASSERT_NE(tableOid, SAI_NULL_OBJECT_ID);
+
+        auto kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            {
+                tableId + "|rule_1",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD },
+                    { MATCH_SRC_IP, "1.2.3.4" }
+                }
+            },
+            {
+                tableId + "|rule_2",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_L4_SRC_PORT_RANGE, "10-20" }
+                }
+            }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+        ASSERT_EQ(orch->getAclTables().at(tableOid).rules.size(), 2);
+
+        auto rule1 = orch->m_aclOrch->getAclRule(tableId, "rule_1");
+        auto rule2 = orch->m_aclOrch->getAclRule(tableId, "rule_2");
+        auto rule1Oid = rule1->getOid();
+        auto rule2Oid = rule2->getOid();
+        auto counter1Oid = rule1->getCounterOid();
+
+        // set both rules again, rule_1 is updated in bulk and rule_2 changes its range ...
+
+        kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            {
+                tableId + "|rule_1",
+                SET_COMMAND,
+                {
+                    { RULE_PRIORITY, "900" },
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_DST_IP, "4.3.2.1" }
+                }
+            },
+            {
+                tableId + "|rule_2",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_L4_SRC_PORT_RANGE, "30-40" }
+                }
+            }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        // the rules keep their entries and counters ...
+
+        ASSERT_EQ(orch->m_aclOrch->getAclRule(tableId, "rule_1"), rule1);
+        ASSERT_EQ(rule1->getOid(), rule1Oid);
+        ASSERT_EQ(rule1->getCounterOid(), counter1Oid);
+        ASSERT_TRUE(validateAclRuleMatch(*rule1, MATCH_DST_IP, "4.3.2.1"));
+        ASSERT_FALSE(validateAclRuleMatch(*rule1, MATCH_SRC_IP, "1.2.3.4"));
+        ASSERT_TRUE(validateAclRuleAction(*rule1, ACTION_PACKET_ACTION, PACKET_ACTION_DROP));
+
+        ASSERT_EQ(orch->m_aclOrch->getAclRule(tableId, "rule_2"), rule2);
+        ASSERT_EQ(rule2->getOid(), rule2Oid);
+        ASSERT_EQ(rule2->getRangeConfig().size(), 1);
+        ASSERT_EQ(rule2->getRangeConfig()[0].min, 30u);
+        ASSERT_EQ(rule2->getRangeConfig()[0].max, 40u);
+
+        vector<FieldValueTuple> counts;
+        orch->m_aclOrch->getObjectCounts(counts);
+        map<string, string> countMap(counts.begin(), counts.end());
+        ASSERT_EQ(countMap["acl_rule_updates"], "2");
+        ASSERT_EQ(countMap["acl_rule_update_fallbacks"], "0");
+
+        kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            { tableId + "|rule_1", DEL_COMMAND, {} },
+            { tableId + "|rule_2", DEL_COMMAND, {} }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+        ASSERT_TRUE(orch->getAclTables().at(tableOid).rules.empty());
+
+        kvfAclTable = deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            DEL_COMMAND,
+            {}
+        }});
+
+        orch->doAclTableTask(kvfAclTable);
+    }
+
     sai_switch_api_t *old_sai_switch_api;
 
     // The following function is used to override SAI API get_switch_attribute to request passing
@@ -2305,6 +2698,73 @@ namespace aclorch_test
 
     }
 
+    TEST_F(AclOrchTest, AclRule_CounterRuleMap)
+    {
+        string tableId = "acl_table_1";
+
+        auto orch = createAclOrch();
+
+        auto kvfAclTable = deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            SET_COMMAND,
+            {
+                { ACL_TABLE_DESCRIPTION, "L3 table" },
+                { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                { ACL_TABLE_STAGE, STAGE_INGRESS },
+                { ACL_TABLE_PORTS, "1,2" }
+            }
+        }});
+
+        orch->doAclTableTask(kvfAclTable);
+
+        auto kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            {
+                tableId + "|rule_1",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD },
+                    { MATCH_SRC_IP, "1.2.3.4" }
+                }
+            },
+            {
+                tableId + "|rule_2",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_DST_IP, "4.3.2.1" }
+                }
+            }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        // Both counters of the drain land in the map
+
+        swss::DBConnector countersDb("COUNTERS_DB", 0);
+        swss::Table counterRuleMap(&countersDb, "ACL_COUNTER_RULE_MAP");
+
+        vector<FieldValueTuple> values;
+        ASSERT_TRUE(counterRuleMap.get("", values));
+        map<string, string> fields(values.begin(), values.end());
+        ASSERT_EQ(fields.size(), 2);
+        for (const auto &ruleId: { "rule_1", "rule_2" })
+        {
+            auto rule = orch->m_aclOrch->getAclRule(tableId, ruleId);
+            ASSERT_NE(rule, nullptr);
+            ASSERT_EQ(fields[tableId + ":" + ruleId], sai_serialize_object_id(rule->getCounterOid()));
+        }
+
+        kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            { tableId + "|rule_1", DEL_COMMAND, {} }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        ASSERT_TRUE(counterRuleMap.get("", values));
+        ASSERT_EQ(values.size(), 1);
+        ASSERT_EQ(fvField(values[0]), tableId + ":rule_2");
+    }
+
     TEST_F(AclOrchTest, AclRule_TrimDisableAction)
     {
         const std::string aclTableTypeName = "TRIM_TYPE";
@@ -0,0 +1,73 @@
+#include "aliasinterner.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace aliasinterner_test
+{
+    using namespace std;
+
+    TEST(AliasInternerTest, StableIds)
+    {
+        auto &interner = AliasInterner::instance();
+
+        AliasId empty;
+        ASSERT_TRUE(empty.empty());
+        ASSERT_EQ(empty.id(), 0u);
+        ASSERT_EQ(AliasId(""), empty);
+
+        AliasId a("AliasTestEthernet0");
+        size_t size = interner.size();
+        AliasId b(string("AliasTestEthernet0"));
+        ASSERT_EQ(interner.size(), size);
+        ASSERT_EQ(a.id(), b.id());
+        ASSERT_EQ(&a.str(), &interner.name(a.id()));
+
+        AliasId c = "AliasTestEthernet4";
+        ASSERT_EQ(interner.size(), size + 1);
+        ASSERT_NE(a, c);
+
+        c = "AliasTestEthernet0";
+        ASSERT_EQ(a, c);
+        ASSERT_EQ(interner.size(), size + 1);
+    }
+
+    TEST(AliasInternerTest, StringInterface)
+    {
+        AliasId alias("AliasTestEthernet8");
+        string name = alias;
+
+        ASSERT_EQ(name, "AliasTestEthernet8");
+        ASSERT_EQ(alias, "AliasTestEthernet8");
+        ASSERT_EQ(alias, name);
+        ASSERT_NE(alias, "AliasTestEthernet12");
+        ASSERT_EQ(alias + "|10.0.0.1", "AliasTestEthernet8|10.0.0.1");
+        ASSERT_EQ("10.0.0.1@" + alias, "10.0.0.1@AliasTestEthernet8");
+        ASSERT_EQ(alias.size(), name.size());
+        ASSERT_EQ(alias.compare(0, 9, "AliasTest"), 0);
+        ASSERT_STREQ(alias.c_str(), name.c_str());
+    }
+
+    TEST(AliasInternerTest, Containers)
+    {
+        // Ordered containers keep the order of the names
+        map<AliasId, int> ordered;
+        ordered[AliasId("AliasTestVlan1000")] = 3;
+        ordered[AliasId("AliasTestEthernet16")] = 1;
+        ordered[AliasId("AliasTestPortChannel1")] = 2;
+
+        int expected = 1;
+        for (const auto &it : ordered)
+        {
+            ASSERT_EQ(it.second, expected++);
+        }
+
+        unordered_map<AliasId, int> hashed;
+        hashed[string("AliasTestEthernet16")] = 1;
+        ASSERT_EQ(hashed.count(AliasId("AliasTestEthernet16")), 1);
+        ASSERT_EQ(hashed.count(AliasId("AliasTestEthernet20")), 0);
+    }
+}
@@ -0,0 +1,80 @@
+#include "gtest/gtest.h"
+#include "asynccmdexecutor.h"
+
+#include <thread>
+
+extern int mockCmdReturn;
+extern std::vector<std::string> mockCallArgs;
+
+namespace asynccmdexecutor_ut
+{
+    using namespace swss;
+    using namespace std;
+
+    struct AsyncCmdExecutorTest : public ::testing::Test
+    {
+        virtual void SetUp() override
+        {
+            mockCallArgs.clear();
+            mockCmdReturn = 0;
+        }
+
+        virtual void TearDown() override
+        {
+            mockCmdReturn = 0;
+        }
+    };
+
+    TEST_F(AsyncCmdExecutorTest, SameKeyRunsInOrder)
+    {
+        AsyncCmdExecutor executor(nullptr, "TEST_CMD", 4);
+        vector<string> completed;
+        auto mainThread = this_thread::get_id();
+
+        for (auto cmd : { "/sbin/ip link set dev Ethernet0 up",
+                          "/sbin/ip link set dev Ethernet0 mtu 9100",
+                          "/sbin/ip link set dev Ethernet0 down" })
+        {
+            string cmd_str = cmd;
+            executor.submit("Ethernet0", cmd_str, [&, cmd_str](int ret, const string &res) {
+                ASSERT_EQ(mainThread, this_thread::get_id());
+                ASSERT_EQ(0, ret);
+                completed.push_back(cmd_str);
+            });
+        }
+        executor.wait();
+
+        ASSERT_EQ(size_t(0), executor.getPending());
+        ASSERT_EQ(size_t(3), mockCallArgs.size());
+        ASSERT_EQ("/sbin/ip link set dev Ethernet0 up", mockCallArgs[0]);
+        ASSERT_EQ("/sbin/ip link set dev Ethernet0 mtu 9100", mockCallArgs[1]);
+        ASSERT_EQ("/sbin/ip link set dev Ethernet0 down", mockCallArgs[2]);
+        ASSERT_EQ(mockCallArgs, completed);
+    }
+
+    TEST_F(AsyncCmdExecutorTest, Stats)
+    {
+        AsyncCmdExecutor executor(nullptr, "TEST_CMD", 1);
+        int failed = 0;
+
+        mockCmdReturn = 1;
+        executor.submit("Ethernet0", "/sbin/ip link set dev Ethernet0 up", [&](int ret, const string &res) {
+            failed += ret ? 1 : 0;
+        });
+        executor.submit("Ethernet4", "/sbin/ip link set dev Ethernet4 up");
+        executor.wait();
+
+        mockCmdReturn = 0;
+        executor.submit("hsflowd", "service hsflowd restart");
+        executor.wait();
+
+        ASSERT_EQ(1, failed);
+        auto stats = executor.getStats();
+        ASSERT_EQ(size_t(2), stats.size());
+        ASSERT_EQ(uint64_t(2), stats["/sbin/ip"].count);
+        ASSERT_EQ(uint64_t(2), stats["/sbin/ip"].failures);
+        ASSERT_EQ(uint64_t(1), stats["service"].count);
+        ASSERT_EQ(uint64_t(0), stats["service"].failures);
+        ASSERT_GE(stats["/sbin/ip"].totalUsecs, stats["/sbin/ip"].maxUsecs);
+    }
+}
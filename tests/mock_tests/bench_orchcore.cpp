@@ -0,0 +1,353 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "bulker.h"
+#include "nexthopgroupkey.h"
+#include "request_parser.h"
+#include "retrycache.h"
+#include "swssnet.h"
+
+#include <arpa/inet.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+extern sai_route_api_t *sai_route_api;
+
+/*
+ * Microbenchmarks of the orchagent core types, run with make bench_orchcore.
+ *
+ * The workloads are DISABLED_ tests so that make check skips them. Each one
+ * prints a JSON line per measured operation, and appends it to the file named
+ * by ORCHCORE_BENCH_OUTPUT when set. The scale is read from the environment:
+ *  - ORCHCORE_BENCH_ITERATIONS: operations per measurement, 100000 by default
+ */
+
+namespace orchcore_bench
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    /* Results are accumulated here so that the measured calls are not optimized out */
+    static volatile size_t g_sink;
+
+    static size_t benchParam(const char *name, size_t value)
+    {
+        const char *env = getenv(name);
+        if (env == nullptr || *env == '\0')
+        {
+            return value;
+        }
+        return static_cast<size_t>(strtoull(env, nullptr, 10));
+    }
+
+    static size_t iterations()
+    {
+        return max<size_t>(benchParam("ORCHCORE_BENCH_ITERATIONS", 100000), 1);
+    }
+
+    static void report(const string &name, size_t ops, nanoseconds elapsed)
+    {
+        double ns = static_cast<double>(elapsed.count());
+
+        stringstream line;
+        line << "{\"benchmark\": \"" << name << "\""
+             << ", \"ops\": " << ops
+             << ", \"ns_per_op\": " << (ops ? ns / static_cast<double>(ops) : 0)
+             << ", \"ops_per_sec\": " << (ns > 0 ? static_cast<double>(ops) * 1e9 / ns : 0)
+             << "}";
+
+        cout << line.str() << endl;
+
+        const char *output = getenv("ORCHCORE_BENCH_OUTPUT");
+        if (output != nullptr && *output != '\0')
+        {
+            ofstream out(output, ios::app);
+            out << line.str() << endl;
+        }
+    }
+
+    /* Run fn for every index in [0, ops) and report the time taken */
+    static void measure(const string &name, size_t ops, const function<void(size_t)> &fn)
+    {
+        auto start = steady_clock::now();
+        for (size_t i = 0; i < ops; i++)
+        {
+            fn(i);
+        }
+        report(name, ops, duration_cast<nanoseconds>(steady_clock::now() - start));
+    }
+
+    static string nextHopGroup(size_t first, size_t width)
+    {
+        string nhg;
+        for (size_t i = 0; i < width; i++)
+        {
+            nhg += (i ? "," : "") + string("10.0.") + to_string(((first + i) >> 8) & 0xff) + "." +
+                   to_string((first + i) & 0xff) + "@Ethernet" + to_string(((first + i) % 32) * 4);
+        }
+        return nhg;
+    }
+
+    TEST(OrchCoreBench, DISABLED_NextHopGroupKey)
+    {
+        size_t ops = iterations();
+
+        vector<string> strings;
+        for (size_t i = 0; i < 64; i++)
+        {
+            strings.push_back(nextHopGroup(i, 8));
+        }
+
+        measure("nhg_key_construct", ops, [&](size_t i) {
+            NextHopGroupKey key(strings[i % strings.size()]);
+            g_sink += key.getSize();
+        });
+
+        vector<NextHopGroupKey> keys(strings.begin(), strings.end());
+        measure("nhg_key_compare", ops, [&](size_t i) {
+            const auto &a = keys[i % keys.size()];
+            const auto &b = keys[(i + 1) % keys.size()];
+            g_sink += (a < b) + (a == b);
+        });
+
+        measure("nhg_key_hash", ops, [&](size_t i) {
+            g_sink += hash<NextHopGroupKey>()(keys[i % keys.size()]);
+        });
+    }
+
+    TEST(OrchCoreBench, DISABLED_NextHopKeyParse)
+    {
+        vector<string> strings;
+        for (size_t i = 0; i < 64; i++)
+        {
+            strings.push_back(nextHopGroup(i, 1));
+        }
+
+        measure("nh_key_parse", iterations(), [&](size_t i) {
+            NextHopKey key(strings[i % strings.size()]);
+            g_sink += key.alias.size();
+        });
+    }
+
+    const request_description_t bench_description = {
+        { REQ_T_STRING, REQ_T_IP_PREFIX },
+        {
+            { "nexthop",      REQ_T_IP_LIST },
+            { "ifname",       REQ_T_STRING },
+            { "src_mac",      REQ_T_MAC_ADDRESS },
+            { "vlan",         REQ_T_VLAN },
+            { "enabled",      REQ_T_BOOL },
+            { "packet_action", REQ_T_PACKET_ACTION },
+        },
+        { }
+    };
+
+    class BenchRequest : public Request
+    {
+    public:
+        BenchRequest() : Request(bench_description, ':') { }
+    };
+
+    TEST(OrchCoreBench, DISABLED_RequestParse)
+    {
+        vector<KeyOpFieldsValuesTuple> requests;
+        for (size_t i = 0; i < 64; i++)
+        {
+            requests.emplace_back("Vrf1:10." + to_string(i) + ".0.0/16", SET_COMMAND, vector<FieldValueTuple>{
+                { "nexthop", "10.0.0.1,10.0.0.2,10.0.0.3" },
+                { "ifname", "Ethernet0,Ethernet4,Ethernet8" },
+                { "src_mac", "00:11:22:33:44:55" },
+                { "vlan", "Vlan100" },
+                { "enabled", "true" },
+                { "packet_action", "forward" },
+            });
+        }
+
+        BenchRequest request;
+        measure("request_parse", iterations(), [&](size_t i) {
+            request.parse(requests[i % requests.size()]);
+            g_sink += request.getAttrFieldNames().size();
+            request.clear();
+        });
+    }
+
+    TEST(OrchCoreBench, DISABLED_SwssnetCopy)
+    {
+        vector<IpAddress> v4;
+        vector<IpAddress> v6;
+        vector<IpPrefix> prefixes;
+        for (size_t i = 0; i < 64; i++)
+        {
+            v4.emplace_back("10.1.0." + to_string(i));
+            v6.emplace_back("2001:db8::" + to_string(i + 1));
+            prefixes.emplace_back("2001:db8:" + to_string(i + 1) + "::/64");
+        }
+
+        sai_ip_address_t address;
+        sai_ip_prefix_t prefix;
+
+        measure("swssnet_copy_ipv4", iterations(), [&](size_t i) {
+            swss::copy(address, v4[i % v4.size()]);
+            g_sink += address.addr.ip4;
+        });
+
+        measure("swssnet_copy_ipv6", iterations(), [&](size_t i) {
+            swss::copy(address, v6[i % v6.size()]);
+            g_sink += address.addr.ip6[15];
+        });
+
+        measure("swssnet_copy_prefix", iterations(), [&](size_t i) {
+            swss::copy(prefix, prefixes[i % prefixes.size()]);
+            g_sink += prefix.mask.ip6[7];
+        });
+    }
+
+    sai_status_t bench_create_route_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_route_entry_t *route_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    TEST(OrchCoreBench, DISABLED_EntityBulkerCreateFlush)
+    {
+        auto old_route_api = sai_route_api;
+        sai_route_api_t route_api = {};
+        route_api.create_route_entries = bench_create_route_entries;
+        sai_route_api = &route_api;
+
+        size_t ops = iterations();
+        EntityBulker<sai_route_api_t> bulker(sai_route_api, 1000);
+
+        vector<sai_route_entry_t> entries(ops);
+        for (size_t i = 0; i < ops; i++)
+        {
+            auto &entry = entries[i];
+            memset(&entry, 0, sizeof(entry));
+            entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+            entry.destination.addr.ip4 = htonl(static_cast<uint32_t>(0x0a000000 + (i << 8)));
+            entry.destination.mask.ip4 = htonl(0xffffff00);
+        }
+
+        sai_attribute_t attrs[2];
+        attrs[0].id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+        attrs[0].value.s32 = SAI_PACKET_ACTION_FORWARD;
+        attrs[1].id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+        attrs[1].value.oid = 0x1000;
+
+        deque<sai_status_t> statuses;
+        auto start = steady_clock::now();
+        for (size_t i = 0; i < ops; i++)
+        {
+            statuses.emplace_back();
+            bulker.create_entry(&statuses.back(), &entries[i], 2, attrs);
+        }
+        bulker.flush();
+        report("bulker_route_create_flush", ops, duration_cast<nanoseconds>(steady_clock::now() - start));
+
+        ASSERT_EQ(statuses.back(), SAI_STATUS_SUCCESS);
+        sai_route_api = old_route_api;
+    }
+
+    class BenchOrch : public Orch
+    {
+    public:
+        BenchOrch(swss::DBConnector *db, string tableName)
+            : Orch(db, tableName)
+        {
+        }
+
+        void doTask(Consumer &consumer)
+        {
+            consumer.m_toSync.clear();
+        }
+
+        Consumer *getConsumer(const string &name)
+        {
+            return dynamic_cast<Consumer *>(getExecutor(name));
+        }
+    };
+
+    TEST(OrchCoreBench, DISABLED_AddToSyncMerge)
+    {
+        ::testing_db::reset();
+
+        swss::DBConnector appl_db("APPL_DB", 0);
+        BenchOrch orch(&appl_db, "ORCHCORE_BENCH_TABLE");
+        auto consumer = orch.getConsumer("ORCHCORE_BENCH_TABLE");
+        ASSERT_NE(consumer, nullptr);
+
+        /* Every key is set twice per batch, the second SET is merged into the first */
+        size_t ops = iterations();
+        size_t batch = 1000;
+        vector<deque<KeyOpFieldsValuesTuple>> batches;
+        for (size_t i = 0; i < ops; i += batch)
+        {
+            batches.emplace_back();
+            for (size_t j = i; j < min(i + batch, ops); j++)
+            {
+                string key = "key" + to_string((j - i) / 2);
+                string field = j % 2 ? "f2" : "f1";
+                batches.back().emplace_back(key, SET_COMMAND, vector<FieldValueTuple>{ { field, to_string(j) } });
+            }
+        }
+
+        auto start = steady_clock::now();
+        for (auto &entries : batches)
+        {
+            consumer->addToSync(entries);
+            consumer->m_toSync.clear();
+        }
+        report("add_to_sync_merge", ops, duration_cast<nanoseconds>(steady_clock::now() - start));
+
+        ::testing_db::reset();
+    }
+
+    TEST(OrchCoreBench, DISABLED_RetryCache)
+    {
+        size_t ops = iterations();
+        size_t constraints = 64;
+
+        vector<Constraint> csts;
+        for (size_t i = 0; i < constraints; i++)
+        {
+            csts.push_back(make_constraint(RETRY_CST_NHG, "nhg" + to_string(i)));
+        }
+
+        vector<Task> tasks;
+        for (size_t i = 0; i < ops; i++)
+        {
+            tasks.emplace_back("key" + to_string(i), SET_COMMAND, vector<FieldValueTuple>{ { "nexthop_group", "nhg" + to_string(i % constraints) } });
+        }
+
+        RetryCache cache("ORCHCORE_BENCH_RETRY");
+
+        measure("retry_cache_insert", ops, [&](size_t i) {
+            cache.insert(tasks[i], csts[i % constraints]);
+        });
+
+        auto start = steady_clock::now();
+        size_t resolved = 0;
+        for (const auto &cst : csts)
+        {
+            cache.mark_resolved(cst);
+            resolved += cache.resolve(cst, ops)->size();
+        }
+        report("retry_cache_resolve", resolved, duration_cast<nanoseconds>(steady_clock::now() - start));
+
+        ASSERT_EQ(resolved, ops);
+    }
+}
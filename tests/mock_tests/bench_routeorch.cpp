@@ -0,0 +1,377 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "routeorch.h"
+#undef private
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_orch_test.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+/*
+ * RouteOrch benchmarks on the mock sairedis, run with make bench_routeorch.
+ *
+ * The workloads are DISABLED_ tests so that make check skips them. Each one
+ * prints a JSON line per measured phase, and appends it to the file named by
+ * ROUTEORCH_BENCH_OUTPUT when set. The scale is read from the environment:
+ *  - ROUTEORCH_BENCH_ROUTES: prefixes per workload, 100000 by default, 1000000 for the full run
+ *  - ROUTEORCH_BENCH_BATCH:  route tasks per doTask() call, 1000 by default
+ *  - ROUTEORCH_BENCH_FANOUT: neighbors used by the ECMP and flap workloads, 8 by default
+ *  - ROUTEORCH_BENCH_VRFS:   VRFs of the VRF scaling workload, 16 by default
+ *  - ROUTEORCH_BENCH_FLAPS:  rounds of the flap storm, 4 by default
+ */
+
+/* Heap allocations of the whole test binary, sampled around each phase */
+static std::atomic<uint64_t> g_benchAllocations{0};
+
+void* operator new(size_t size)
+{
+    g_benchAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace routeorch_bench
+{
+    using namespace std;
+    using namespace std::chrono;
+    using namespace mock_orch_test;
+
+    static size_t benchParam(const char *name, size_t value)
+    {
+        const char *env = getenv(name);
+        if (env == nullptr || *env == '\0')
+        {
+            return value;
+        }
+        return static_cast<size_t>(strtoull(env, nullptr, 10));
+    }
+
+    static uint64_t peakRssKb()
+    {
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+        return static_cast<uint64_t>(usage.ru_maxrss);
+    }
+
+    static double percentile(vector<double> samples, double p)
+    {
+        if (samples.empty())
+        {
+            return 0;
+        }
+        sort(samples.begin(), samples.end());
+        size_t idx = static_cast<size_t>(p * static_cast<double>(samples.size() - 1) + 0.5);
+        return samples[min(idx, samples.size() - 1)];
+    }
+
+    class RouteOrchBench : public MockOrchTest
+    {
+    protected:
+        size_t m_routes = benchParam("ROUTEORCH_BENCH_ROUTES", 100000);
+        size_t m_batch = max<size_t>(benchParam("ROUTEORCH_BENCH_BATCH", 1000), 1);
+        size_t m_fanout = min<size_t>(max<size_t>(benchParam("ROUTEORCH_BENCH_FANOUT", 8), 2), 200);
+        size_t m_vrfs = max<size_t>(benchParam("ROUTEORCH_BENCH_VRFS", 16), 1);
+        size_t m_flaps = max<size_t>(benchParam("ROUTEORCH_BENCH_FLAPS", 4), 1);
+
+        vector<string> m_v4NextHops;
+        vector<string> m_v6NextHops;
+
+        void ApplyInitialConfigs() override
+        {
+            Table port_table = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+            Table intf_table = Table(m_app_db.get(), APP_INTF_TABLE_NAME);
+            Table neigh_table = Table(m_app_db.get(), APP_NEIGH_TABLE_NAME);
+            Table vrf_table = Table(m_app_db.get(), APP_VRF_TABLE_NAME);
+
+            auto ports = ut_helper::getInitialSaiPorts();
+            for (const auto &it : ports)
+            {
+                port_table.set(it.first, it.second);
+                port_table.set(it.first, { { "oper_status", "up" } });
+            }
+            port_table.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+            gPortsOrch->addExistingData(&port_table);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+
+            port_table.set("PortInitDone", { { "lanes", "0" } });
+            gPortsOrch->addExistingData(&port_table);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+
+            for (size_t i = 1; i <= m_vrfs; i++)
+            {
+                vrf_table.set("Vrf" + to_string(i), { { "NULL", "NULL" } });
+            }
+            gVrfOrch->addExistingData(&vrf_table);
+            static_cast<Orch *>(gVrfOrch)->doTask();
+
+            intf_table.set(ETHERNET0, { { "NULL", "NULL" },
+                                        { "mac_addr", "00:00:00:00:00:00" } });
+            intf_table.set(ETHERNET0 + ":10.0.0.1/24", { { "scope", "global" },
+                                                         { "family", "IPv4" } });
+            intf_table.set(ETHERNET0 + ":fc00::1/64", { { "scope", "global" },
+                                                        { "family", "IPv6" } });
+            gIntfsOrch->addExistingData(&intf_table);
+            static_cast<Orch *>(gIntfsOrch)->doTask();
+
+            for (size_t i = 0; i < m_fanout; i++)
+            {
+                char mac[18];
+                snprintf(mac, sizeof(mac), "00:00:0a:00:00:%02zx", i + 2);
+
+                m_v4NextHops.push_back("10.0.0." + to_string(i + 2));
+                neigh_table.set(ETHERNET0 + ":" + m_v4NextHops.back(), { { "neigh", mac },
+                                                                         { "family", "IPv4" } });
+
+                stringstream v6;
+                v6 << "fc00::" << hex << (i + 2);
+                m_v6NextHops.push_back(v6.str());
+                neigh_table.set(ETHERNET0 + ":" + m_v6NextHops.back(), { { "neigh", mac },
+                                                                         { "family", "IPv6" } });
+            }
+            gNeighOrch->addExistingData(&neigh_table);
+            static_cast<Orch *>(gNeighOrch)->doTask();
+        }
+
+        static string ipv4Prefix(size_t i)
+        {
+            return to_string(100 + (i >> 16)) + "." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + ".0/24";
+        }
+
+        static string ipv6Prefix(size_t i)
+        {
+            stringstream pfx;
+            pfx << "2001:db8:" << hex << (i >> 16) << ":" << (i & 0xffff) << "::/64";
+            return pfx.str();
+        }
+
+        /* SET of a route through count next hops, starting at next hop first */
+        static KeyOpFieldsValuesTuple routeSet(const string &key, const vector<string> &nhs, size_t first, size_t count)
+        {
+            string ips;
+            string ifnames;
+            for (size_t i = 0; i < count; i++)
+            {
+                if (i)
+                {
+                    ips += ",";
+                    ifnames += ",";
+                }
+                ips += nhs[(first + i) % nhs.size()];
+                ifnames += ETHERNET0;
+            }
+            return KeyOpFieldsValuesTuple(key, SET_COMMAND, { { "nexthop", ips }, { "ifname", ifnames } });
+        }
+
+        static KeyOpFieldsValuesTuple routeDel(const string &key)
+        {
+            return KeyOpFieldsValuesTuple(key, DEL_COMMAND, {});
+        }
+
+        void report(const string &workload, size_t routes, const vector<double> &batchUsec,
+                    double elapsedUsec, uint64_t allocations)
+        {
+            stringstream line;
+            line << "{\"workload\": \"" << workload << "\""
+                 << ", \"routes\": " << routes
+                 << ", \"batches\": " << batchUsec.size()
+                 << ", \"batch_size\": " << m_batch
+                 << ", \"routes_per_sec\": " << (elapsedUsec > 0 ? static_cast<double>(routes) * 1e6 / elapsedUsec : 0)
+                 << ", \"batch_p50_usec\": " << percentile(batchUsec, 0.50)
+                 << ", \"batch_p99_usec\": " << percentile(batchUsec, 0.99)
+                 << ", \"peak_rss_kb\": " << peakRssKb()
+                 << ", \"allocs_per_route\": " << (routes ? static_cast<double>(allocations) / static_cast<double>(routes) : 0)
+                 << "}";
+
+            cout << line.str() << endl;
+
+            const char *output = getenv("ROUTEORCH_BENCH_OUTPUT");
+            if (output != nullptr && *output != '\0')
+            {
+                ofstream out(output, ios::app);
+                out << line.str() << endl;
+            }
+        }
+
+        /* Feed the tasks to RouteOrch m_batch at a time, one doTask() per batch */
+        void run(const string &workload, const vector<KeyOpFieldsValuesTuple> &tasks)
+        {
+            vector<deque<KeyOpFieldsValuesTuple>> batches;
+            for (size_t i = 0; i < tasks.size(); i += m_batch)
+            {
+                batches.emplace_back(tasks.begin() + static_cast<ptrdiff_t>(i),
+                                     tasks.begin() + static_cast<ptrdiff_t>(min(i + m_batch, tasks.size())));
+            }
+
+            auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+            vector<double> batchUsec;
+            batchUsec.reserve(batches.size());
+
+            uint64_t allocations = g_benchAllocations.load(memory_order_relaxed);
+            auto start = steady_clock::now();
+            for (auto &batch : batches)
+            {
+                auto t0 = steady_clock::now();
+                consumer->addToSync(move(batch));
+                static_cast<Orch *>(gRouteOrch)->doTask();
+                batchUsec.push_back(static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - t0).count()) / 1e3);
+            }
+            double elapsedUsec = static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - start).count()) / 1e3;
+            allocations = g_benchAllocations.load(memory_order_relaxed) - allocations;
+
+            ASSERT_TRUE(consumer->m_toSync.empty()) << workload << " left " << consumer->m_toSync.size() << " tasks";
+            report(workload, tasks.size(), batchUsec, elapsedUsec, allocations);
+        }
+    };
+
+    TEST_F(RouteOrchBench, DISABLED_Ipv4AddDel)
+    {
+        vector<KeyOpFieldsValuesTuple> tasks;
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            tasks.push_back(routeSet(ipv4Prefix(i), m_v4NextHops, i, 1));
+        }
+        run("ipv4_add", tasks);
+        ASSERT_GE(gRouteOrch->m_syncdRoutes[gVirtualRouterId].size(), m_routes);
+
+        tasks.clear();
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            tasks.push_back(routeDel(ipv4Prefix(i)));
+        }
+        run("ipv4_del", tasks);
+    }
+
+    TEST_F(RouteOrchBench, DISABLED_Ipv6AddDel)
+    {
+        vector<KeyOpFieldsValuesTuple> tasks;
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            tasks.push_back(routeSet(ipv6Prefix(i), m_v6NextHops, i, 1));
+        }
+        run("ipv6_add", tasks);
+        ASSERT_GE(gRouteOrch->m_syncdRoutes[gVirtualRouterId].size(), m_routes);
+
+        tasks.clear();
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            tasks.push_back(routeDel(ipv6Prefix(i)));
+        }
+        run("ipv6_del", tasks);
+    }
+
+    TEST_F(RouteOrchBench, DISABLED_EcmpFanout)
+    {
+        /* m_fanout groups of half the neighbors each, shared by all the prefixes */
+        size_t width = max<size_t>(m_fanout / 2, 2);
+
+        vector<KeyOpFieldsValuesTuple> tasks;
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            tasks.push_back(routeSet(ipv4Prefix(i), m_v4NextHops, i, width));
+        }
+        run("ecmp_add", tasks);
+        ASSERT_GE(gRouteOrch->m_syncdRoutes[gVirtualRouterId].size(), m_routes);
+
+        tasks.clear();
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            tasks.push_back(routeDel(ipv4Prefix(i)));
+        }
+        run("ecmp_del", tasks);
+    }
+
+    TEST_F(RouteOrchBench, DISABLED_FlapStorm)
+    {
+        vector<KeyOpFieldsValuesTuple> tasks;
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            tasks.push_back(routeSet(ipv4Prefix(i), m_v4NextHops, 0, m_fanout));
+        }
+        run("flap_setup", tasks);
+
+        /* Path changes: every prefix moves between a single path and the full ECMP group */
+        for (size_t round = 0; round < m_flaps; round++)
+        {
+            tasks.clear();
+            for (size_t i = 0; i < m_routes; i++)
+            {
+                tasks.push_back(routeSet(ipv4Prefix(i), m_v4NextHops, round, round % 2 ? m_fanout : 1));
+            }
+            run("flap_route_update", tasks);
+        }
+
+        /* Neighbor flaps under the full ECMP group, timed as one batch each */
+        uint64_t allocations = g_benchAllocations.load(memory_order_relaxed);
+        vector<double> batchUsec;
+        auto start = steady_clock::now();
+        for (size_t round = 0; round < m_flaps; round++)
+        {
+            NextHopKey nh(m_v4NextHops[round % m_fanout], ETHERNET0);
+            uint32_t count = 0;
+
+            auto t0 = steady_clock::now();
+            ASSERT_TRUE(gRouteOrch->invalidnexthopinNextHopGroup(nh, count));
+            ASSERT_TRUE(gRouteOrch->validnexthopinNextHopGroup(nh, count));
+            batchUsec.push_back(static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - t0).count()) / 1e3);
+        }
+        double elapsedUsec = static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - start).count()) / 1e3;
+        report("flap_nexthop", m_routes * m_flaps, batchUsec, elapsedUsec,
+               g_benchAllocations.load(memory_order_relaxed) - allocations);
+
+        tasks.clear();
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            tasks.push_back(routeDel(ipv4Prefix(i)));
+        }
+        run("flap_teardown", tasks);
+    }
+
+    TEST_F(RouteOrchBench, DISABLED_VrfScaling)
+    {
+        vector<KeyOpFieldsValuesTuple> tasks;
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            string key = "Vrf" + to_string(i % m_vrfs + 1) + ":" + ipv4Prefix(i / m_vrfs);
+            tasks.push_back(routeSet(key, m_v4NextHops, i, 1));
+        }
+        run("vrf_add", tasks);
+
+        for (auto &task : tasks)
+        {
+            task = routeDel(kfvKey(task));
+        }
+        run("vrf_del", tasks);
+    }
+}
@@ -0,0 +1,351 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "portsorch.h"
+#undef private
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_dash_orch_test.h"
+#include "aclorch.h"
+#include "dash_api/eni.pb.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+/*
+ * Production modelled orchagent scenarios on the mock sairedis and the in
+ * process DB tables, run with make bench_scenarios.
+ *
+ * Tasks are handed to the Consumers of their tables in batches, as pops from
+ * APPL_DB would, and every Orch of the test is then run round after round,
+ * like the OrchDaemon main loop, until no Consumer has tasks left. The
+ * scenarios are DISABLED_ tests so that make check skips them. Each one prints
+ * a JSON line per measured phase with the wall and CPU time and the peak RSS,
+ * and appends it to the file named by SCENARIO_BENCH_OUTPUT when set. The
+ * scale is read from the environment:
+ *  - SCENARIO_BENCH_ROUTES:    prefixes of the BGP table load, 100000 by default
+ *  - SCENARIO_BENCH_NEIGHBORS: neighbors of the neighbor storm, 4000 by default
+ *  - SCENARIO_BENCH_ACL_RULES: rules of the ACL reload, 1000 by default
+ *  - SCENARIO_BENCH_ENIS:      ENIs of the DASH provisioning, 64 by default
+ *  - SCENARIO_BENCH_FLAPS:     rounds of the port flap storm, 8 by default
+ *  - SCENARIO_BENCH_BATCH:     tasks per batch handed to a Consumer, 1000 by default
+ */
+
+namespace scenario_bench
+{
+    using namespace std;
+    using namespace std::chrono;
+    using namespace mock_orch_test;
+
+    /* Rounds of the daemon loop after which the tasks left are reported as stuck */
+    static const size_t MAX_ROUNDS = 64;
+
+    static size_t benchParam(const char *name, size_t value)
+    {
+        const char *env = getenv(name);
+        if (env == nullptr || *env == '\0')
+        {
+            return value;
+        }
+        return static_cast<size_t>(strtoull(env, nullptr, 10));
+    }
+
+    static double cpuUsec(const struct rusage &usage)
+    {
+        return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e6 +
+               static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+    }
+
+    class ScenarioBench : public MockDashOrchTest
+    {
+    protected:
+        size_t m_routes = benchParam("SCENARIO_BENCH_ROUTES", 100000);
+        size_t m_neighbors = min<size_t>(benchParam("SCENARIO_BENCH_NEIGHBORS", 4000), 250 * 250);
+        size_t m_aclRules = max<size_t>(benchParam("SCENARIO_BENCH_ACL_RULES", 1000), 1);
+        size_t m_enis = max<size_t>(benchParam("SCENARIO_BENCH_ENIS", 64), 1);
+        size_t m_flaps = max<size_t>(benchParam("SCENARIO_BENCH_FLAPS", 8), 1);
+        size_t m_batch = max<size_t>(benchParam("SCENARIO_BENCH_BATCH", 1000), 1);
+
+        vector<string> m_nextHops;
+        size_t m_rounds = 0;
+
+        void ApplyInitialConfigs() override
+        {
+            Table port_table = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+            Table intf_table = Table(m_app_db.get(), APP_INTF_TABLE_NAME);
+            Table neigh_table = Table(m_app_db.get(), APP_NEIGH_TABLE_NAME);
+
+            auto ports = ut_helper::getInitialSaiPorts();
+            for (const auto &it : ports)
+            {
+                port_table.set(it.first, it.second);
+                port_table.set(it.first, { { "oper_status", "up" } });
+            }
+            port_table.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+            gPortsOrch->addExistingData(&port_table);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+
+            port_table.set("PortInitDone", { { "lanes", "0" } });
+            gPortsOrch->addExistingData(&port_table);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+
+            intf_table.set(ETHERNET0, { { "NULL", "NULL" },
+                                        { "mac_addr", "00:00:00:00:00:00" } });
+            intf_table.set(ETHERNET0 + ":10.0.0.1/16", { { "scope", "global" },
+                                                         { "family", "IPv4" } });
+            gIntfsOrch->addExistingData(&intf_table);
+            static_cast<Orch *>(gIntfsOrch)->doTask();
+
+            for (size_t i = 0; i < 8; i++)
+            {
+                m_nextHops.push_back("10.0.0." + to_string(i + 2));
+                neigh_table.set(ETHERNET0 + ":" + m_nextHops.back(), { { "neigh", mac(i) },
+                                                                       { "family", "IPv4" } });
+            }
+            gNeighOrch->addExistingData(&neigh_table);
+            static_cast<Orch *>(gNeighOrch)->doTask();
+        }
+
+        static string mac(size_t i)
+        {
+            char buf[18];
+            snprintf(buf, sizeof(buf), "00:00:0a:%02zx:%02zx:%02zx", (i >> 16) & 0xff, (i >> 8) & 0xff, i & 0xff);
+            return buf;
+        }
+
+        ConsumerBase *consumer(Orch *orch, const string &table)
+        {
+            auto consumer = dynamic_cast<ConsumerBase *>(orch->getExecutor(table));
+            EXPECT_NE(consumer, nullptr) << table;
+            return consumer;
+        }
+
+        size_t pendingTasks()
+        {
+            size_t pending = 0;
+            for (auto orch : ut_orch_list)
+            {
+                for (auto &it : (*orch)->m_consumerMap)
+                {
+                    auto consumer = dynamic_cast<ConsumerBase *>(it.second.get());
+                    if (consumer != nullptr)
+                    {
+                        pending += consumer->m_toSync.size();
+                    }
+                }
+            }
+            return pending;
+        }
+
+        /* One doTask() of every Orch per round, until nothing is left or MAX_ROUNDS */
+        void runDaemon()
+        {
+            for (size_t round = 0; round < MAX_ROUNDS; round++)
+            {
+                m_rounds++;
+                for (auto orch : ut_orch_list)
+                {
+                    (*orch)->doTask();
+                }
+                if (pendingTasks() == 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        /* Hand the tasks to the Consumer m_batch at a time, the daemon loop runs after each batch */
+        size_t feed(ConsumerBase *consumer, const vector<KeyOpFieldsValuesTuple> &tasks)
+        {
+            for (size_t i = 0; i < tasks.size(); i += m_batch)
+            {
+                deque<KeyOpFieldsValuesTuple> batch(tasks.begin() + static_cast<ptrdiff_t>(i),
+                                                    tasks.begin() + static_cast<ptrdiff_t>(min(i + m_batch, tasks.size())));
+                consumer->addToSync(move(batch));
+                runDaemon();
+            }
+            return tasks.size();
+        }
+
+        void report(const string &scenario, size_t tasks, double elapsedUsec, double cpuUsec, size_t pending)
+        {
+            struct rusage usage;
+            getrusage(RUSAGE_SELF, &usage);
+
+            stringstream line;
+            line << "{\"scenario\": \"" << scenario << "\""
+                 << ", \"tasks\": " << tasks
+                 << ", \"rounds\": " << m_rounds
+                 << ", \"pending\": " << pending
+                 << ", \"elapsed_usec\": " << elapsedUsec
+                 << ", \"cpu_usec\": " << cpuUsec
+                 << ", \"tasks_per_sec\": " << (elapsedUsec > 0 ? static_cast<double>(tasks) * 1e6 / elapsedUsec : 0)
+                 << ", \"peak_rss_kb\": " << usage.ru_maxrss
+                 << "}";
+
+            cout << line.str() << endl;
+
+            const char *output = getenv("SCENARIO_BENCH_OUTPUT");
+            if (output != nullptr && *output != '\0')
+            {
+                ofstream out(output, ios::app);
+                out << line.str() << endl;
+            }
+        }
+
+        /* Run the workload, which returns the number of tasks it injected, and report it */
+        void measure(const string &scenario, const function<size_t()> &workload)
+        {
+            struct rusage before, after;
+            m_rounds = 0;
+
+            getrusage(RUSAGE_SELF, &before);
+            auto start = steady_clock::now();
+            size_t tasks = workload();
+            double elapsedUsec = static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - start).count()) / 1e3;
+            getrusage(RUSAGE_SELF, &after);
+
+            size_t pending = pendingTasks();
+            report(scenario, tasks, elapsedUsec, cpuUsec(after) - cpuUsec(before), pending);
+            EXPECT_EQ(pending, 0) << scenario << " left " << pending << " tasks";
+        }
+    };
+
+    TEST_F(ScenarioBench, DISABLED_BgpTableLoad)
+    {
+        vector<KeyOpFieldsValuesTuple> sets;
+        vector<KeyOpFieldsValuesTuple> dels;
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            string prefix = to_string(100 + (i >> 16)) + "." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + ".0/24";
+
+            /* Groups of 4 next hops out of 8, as the paths of a few upstream peers */
+            string ips;
+            string ifnames;
+            for (size_t j = 0; j < 4; j++)
+            {
+                ips += (j ? "," : "") + m_nextHops[(i + j) % m_nextHops.size()];
+                ifnames += (j ? "," : "") + ETHERNET0;
+            }
+            sets.emplace_back(prefix, SET_COMMAND, vector<FieldValueTuple>{ { "nexthop", ips }, { "ifname", ifnames } });
+            dels.emplace_back(prefix, DEL_COMMAND, vector<FieldValueTuple>{});
+        }
+
+        auto routes = consumer(gRouteOrch, APP_ROUTE_TABLE_NAME);
+        measure("bgp_table_load", [&]() { return feed(routes, sets); });
+        measure("bgp_table_withdraw", [&]() { return feed(routes, dels); });
+    }
+
+    TEST_F(ScenarioBench, DISABLED_NeighborStorm)
+    {
+        vector<KeyOpFieldsValuesTuple> sets;
+        vector<KeyOpFieldsValuesTuple> dels;
+        for (size_t i = 0; i < m_neighbors; i++)
+        {
+            string key = ETHERNET0 + ":10.0." + to_string(1 + i / 250) + "." + to_string(1 + i % 250);
+            sets.emplace_back(key, SET_COMMAND, vector<FieldValueTuple>{ { "neigh", mac(0x100 + i) }, { "family", "IPv4" } });
+            dels.emplace_back(key, DEL_COMMAND, vector<FieldValueTuple>{});
+        }
+
+        auto neighbors = consumer(gNeighOrch, APP_NEIGH_TABLE_NAME);
+        measure("neighbor_storm_add", [&]() { return feed(neighbors, sets); });
+        measure("neighbor_storm_del", [&]() { return feed(neighbors, dels); });
+    }
+
+    TEST_F(ScenarioBench, DISABLED_AclReload)
+    {
+        const string table = "BENCH_ACL";
+
+        vector<KeyOpFieldsValuesTuple> tableSet = {
+            { table, SET_COMMAND, { { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                                    { ACL_TABLE_PORTS, ETHERNET0 },
+                                    { ACL_TABLE_STAGE, "INGRESS" } } }
+        };
+        vector<KeyOpFieldsValuesTuple> tableDel = { { table, DEL_COMMAND, {} } };
+
+        vector<KeyOpFieldsValuesTuple> ruleSets;
+        vector<KeyOpFieldsValuesTuple> ruleDels;
+        for (size_t i = 0; i < m_aclRules; i++)
+        {
+            string key = table + "|RULE_" + to_string(i);
+            string ip = "20." + to_string((i >> 16) & 0xff) + "." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + "/32";
+            ruleSets.emplace_back(key, SET_COMMAND, vector<FieldValueTuple>{ { RULE_PRIORITY, to_string(1000 + i) },
+                                                                            { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                                                                            { MATCH_SRC_IP, ip } });
+            ruleDels.emplace_back(key, DEL_COMMAND, vector<FieldValueTuple>{});
+        }
+
+        auto tables = consumer(gAclOrch, CFG_ACL_TABLE_TABLE_NAME);
+        auto rules = consumer(gAclOrch, CFG_ACL_RULE_TABLE_NAME);
+
+        measure("acl_load", [&]() { return feed(tables, tableSet) + feed(rules, ruleSets); });
+        measure("acl_reload", [&]() {
+            return feed(rules, ruleDels) + feed(tables, tableDel) + feed(tables, tableSet) + feed(rules, ruleSets);
+        });
+    }
+
+    TEST_F(ScenarioBench, DISABLED_DashEniProvisioning)
+    {
+        CreateApplianceEntry();
+        CreateVnet();
+
+        vector<KeyOpFieldsValuesTuple> sets;
+        vector<KeyOpFieldsValuesTuple> dels;
+        for (size_t i = 0; i < m_enis; i++)
+        {
+            string name = "ENI_" + to_string(i);
+            dash::eni::Eni eni = BuildEniEntry();
+            eni.set_eni_id(name);
+            eni.set_mac_address(mac(0x200000 + i));
+            sets.emplace_back(name, SET_COMMAND, vector<FieldValueTuple>{ { "pb", eni.SerializeAsString() } });
+            dels.emplace_back(name, DEL_COMMAND, vector<FieldValueTuple>{});
+        }
+
+        auto enis = consumer(m_DashOrch, APP_DASH_ENI_TABLE_NAME);
+        measure("dash_eni_provision", [&]() { return feed(enis, sets); });
+        measure("dash_eni_remove", [&]() { return feed(enis, dels); });
+    }
+
+    TEST_F(ScenarioBench, DISABLED_PortFlapStorm)
+    {
+        /* Routes through every neighbor, so that the flaps of Ethernet0 reach RouteOrch */
+        vector<KeyOpFieldsValuesTuple> sets;
+        for (size_t i = 0; i < min<size_t>(m_routes, 10000); i++)
+        {
+            string prefix = "30." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + ".0/24";
+            sets.emplace_back(prefix, SET_COMMAND, vector<FieldValueTuple>{ { "nexthop", m_nextHops[i % m_nextHops.size()] },
+                                                                           { "ifname", ETHERNET0 } });
+        }
+        feed(consumer(gRouteOrch, APP_ROUTE_TABLE_NAME), sets);
+
+        measure("port_flap_storm", [&]() {
+            size_t events = 0;
+            for (size_t round = 0; round < m_flaps * 2; round++)
+            {
+                auto status = round % 2 ? SAI_PORT_OPER_STATUS_UP : SAI_PORT_OPER_STATUS_DOWN;
+                for (auto &it : gPortsOrch->getAllPorts())
+                {
+                    if (it.second.m_type == Port::PHY)
+                    {
+                        gPortsOrch->updatePortOperStatus(it.second, status);
+                        events++;
+                    }
+                }
+                runDaemon();
+            }
+            return events;
+        });
+    }
+}
@@ -0,0 +1,322 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "bfdorch.h"
+#undef private
+#include "sai_serialize.h"
+#include "mock_orch_test.h"
+
+namespace bfdorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    sai_bfd_api_t ut_sai_bfd_api;
+    sai_bfd_api_t *pold_sai_bfd_api;
+
+    sai_object_id_t _ut_stub_next_oid;
+    set<sai_object_id_t> _ut_stub_sessions;
+    // Sessions the SAI fails to create, by peer address
+    sai_ip4_t _ut_stub_failing_peer;
+    bool _ut_stub_bulk_supported;
+    uint32_t _ut_stub_bulk_create_calls;
+    uint32_t _ut_stub_bulk_remove_calls;
+    uint32_t _ut_stub_create_calls;
+    uint32_t _ut_stub_remove_calls;
+
+    sai_status_t _ut_stub_create_bfd_session(
+        _Out_ sai_object_id_t *session_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        _ut_stub_create_calls++;
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            if (attr_list[i].id == SAI_BFD_SESSION_ATTR_DST_IP_ADDRESS &&
+                attr_list[i].value.ipaddr.addr.ip4 == _ut_stub_failing_peer)
+            {
+                return SAI_STATUS_TABLE_FULL;
+            }
+        }
+
+        *session_id = ++_ut_stub_next_oid;
+        _ut_stub_sessions.insert(*session_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_remove_bfd_session(
+        _In_ sai_object_id_t session_id)
+    {
+        _ut_stub_remove_calls++;
+        _ut_stub_sessions.erase(session_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_create_bfd_sessions(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        if (!_ut_stub_bulk_supported)
+        {
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_create_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_create_bfd_session(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_remove_bfd_sessions(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        if (!_ut_stub_bulk_supported)
+        {
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+
+        _ut_stub_bulk_remove_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_remove_bfd_session(object_id[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    class BfdStateObserver : public Observer
+    {
+    public:
+        vector<pair<string, sai_bfd_session_state_t>> updates;
+
+        void update(SubjectType type, void *cntx) override
+        {
+            if (type == SUBJECT_TYPE_BFD_SESSION_STATE_CHANGE)
+            {
+                auto update = static_cast<BfdUpdate *>(cntx);
+                updates.emplace_back(update->peer, update->state);
+            }
+        }
+    };
+
+    class BfdOrchTest : public MockOrchTest
+    {
+    protected:
+        BgpGlobalStateOrch *m_bgpGlobalStateOrch;
+        BfdOrch *m_bfdOrch;
+        BfdStateObserver m_observer;
+
+        void PostSetUp() override
+        {
+            ut_sai_bfd_api = *sai_bfd_api;
+            pold_sai_bfd_api = sai_bfd_api;
+            ut_sai_bfd_api.create_bfd_session = _ut_stub_create_bfd_session;
+            ut_sai_bfd_api.remove_bfd_session = _ut_stub_remove_bfd_session;
+            sai_bfd_api = &ut_sai_bfd_api;
+
+            _ut_stub_next_oid = 0x1000;
+            _ut_stub_sessions.clear();
+            _ut_stub_failing_peer = 0;
+            _ut_stub_bulk_supported = true;
+            _ut_stub_bulk_create_calls = 0;
+            _ut_stub_bulk_remove_calls = 0;
+            _ut_stub_create_calls = 0;
+            _ut_stub_remove_calls = 0;
+
+            // Hardware sessions are used only when the ASIC offloads BFD
+            m_bgpGlobalStateOrch = new BgpGlobalStateOrch(m_config_db.get(), CFG_BGP_DEVICE_GLOBAL_TABLE_NAME);
+            m_bgpGlobalStateOrch->bfd_offload = true;
+            gDirectory.set(m_bgpGlobalStateOrch);
+
+            TableConnector stateDbBfdSessionTable(m_state_db.get(), STATE_BFD_SESSION_TABLE_NAME);
+            m_bfdOrch = new BfdOrch(m_app_db.get(), APP_BFD_SESSION_TABLE_NAME, stateDbBfdSessionTable);
+
+            // The state change notification is registered with the switch, not under test here
+            m_bfdOrch->register_state_change_notif = true;
+
+            m_bfdOrch->m_sessionBulker.create_entries = _ut_stub_create_bfd_sessions;
+            m_bfdOrch->m_sessionBulker.remove_entries = _ut_stub_remove_bfd_sessions;
+
+            m_bfdOrch->attach(&m_observer);
+        }
+
+        void PreTearDown() override
+        {
+            m_bfdOrch->detach(&m_observer);
+            delete m_bfdOrch;
+            delete m_bgpGlobalStateOrch;
+            sai_bfd_api = pold_sai_bfd_api;
+        }
+
+        Consumer *getConsumer()
+        {
+            return dynamic_cast<Consumer *>(m_bfdOrch->getExecutor(APP_BFD_SESSION_TABLE_NAME));
+        }
+
+        void applySessions(const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            getConsumer()->addToSync(entries);
+            static_cast<Orch *>(m_bfdOrch)->doTask();
+        }
+
+        KeyOpFieldsValuesTuple sessionSet(const string &peer)
+        {
+            return { "default:default:" + peer, SET_COMMAND, { { "local_addr", "10.0.0.1" } } };
+        }
+
+        KeyOpFieldsValuesTuple sessionDel(const string &peer)
+        {
+            return { "default:default:" + peer, DEL_COMMAND, {} };
+        }
+
+        string stateDbKey(const string &peer)
+        {
+            return "default|default|" + peer;
+        }
+
+        size_t getStateDbSessionCount()
+        {
+            Table state_table(m_state_db.get(), STATE_BFD_SESSION_TABLE_NAME);
+            vector<string> keys;
+            state_table.getKeys(keys);
+            return keys.size();
+        }
+
+        string getStateDbSessionState(const string &peer)
+        {
+            Table state_table(m_state_db.get(), STATE_BFD_SESSION_TABLE_NAME);
+            string state;
+            state_table.hget(stateDbKey(peer), "state", state);
+            return state;
+        }
+
+        KeyOpFieldsValuesTuple stateChange(const vector<pair<string, sai_bfd_session_state_t>> &changes)
+        {
+            vector<sai_bfd_session_state_notification_t> ntfs;
+            for (auto &change : changes)
+            {
+                sai_bfd_session_state_notification_t ntf = {};
+                ntf.bfd_session_id = m_bfdOrch->bfd_session_map.at("default:default:" + change.first);
+                ntf.session_state = change.second;
+                ntfs.push_back(ntf);
+            }
+
+            return { sai_serialize_bfd_session_state_ntf((uint32_t)ntfs.size(), ntfs.data()), "bfd_session_state_change", {} };
+        }
+    };
+
+    TEST_F(BfdOrchTest, BulkCreateAndRemove)
+    {
+        applySessions({ sessionSet("10.0.0.2"), sessionSet("10.0.0.3"), sessionSet("10.0.0.4") });
+
+        // The sessions of the batch go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        ASSERT_EQ(_ut_stub_create_calls, 3);
+        ASSERT_EQ(_ut_stub_sessions.size(), 3);
+        ASSERT_EQ(m_bfdOrch->bfd_session_map.size(), 3);
+        ASSERT_EQ(getStateDbSessionCount(), 3);
+        ASSERT_EQ(getStateDbSessionState("10.0.0.3"), "Down");
+        ASSERT_EQ(m_observer.updates.size(), 3);
+        ASSERT_TRUE(getConsumer()->m_toSync.empty());
+
+        applySessions({ sessionDel("10.0.0.2"), sessionDel("10.0.0.3"), sessionDel("10.0.0.4") });
+
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 1);
+        ASSERT_EQ(_ut_stub_remove_calls, 3);
+        ASSERT_TRUE(_ut_stub_sessions.empty());
+        ASSERT_TRUE(m_bfdOrch->bfd_session_map.empty());
+        ASSERT_TRUE(m_bfdOrch->bfd_session_lookup.empty());
+        ASSERT_EQ(getStateDbSessionCount(), 0);
+        ASSERT_TRUE(getConsumer()->m_toSync.empty());
+    }
+
+    TEST_F(BfdOrchTest, BulkCreateFailedInTheMiddle)
+    {
+        _ut_stub_failing_peer = IpAddress("10.0.0.3").getV4Addr();
+
+        applySessions({ sessionSet("10.0.0.2"), sessionSet("10.0.0.3"), sessionSet("10.0.0.4") });
+
+        // The failed session is retried alone with other source ports, the others are created
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        // Three retries with other UDP source ports
+        ASSERT_EQ(_ut_stub_create_calls, 3 + 3);
+        ASSERT_EQ(_ut_stub_sessions.size(), 2);
+        ASSERT_EQ(m_bfdOrch->bfd_session_map.size(), 2);
+        ASSERT_EQ(m_bfdOrch->bfd_session_map.count("default:default:10.0.0.3"), 0);
+        ASSERT_EQ(getStateDbSessionCount(), 2);
+        ASSERT_EQ(getConsumer()->m_toSync.size(), 1);
+
+        _ut_stub_failing_peer = 0;
+        static_cast<Orch *>(m_bfdOrch)->doTask();
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 2);
+        ASSERT_EQ(_ut_stub_sessions.size(), 3);
+        ASSERT_EQ(m_bfdOrch->bfd_session_map.count("default:default:10.0.0.3"), 1);
+        ASSERT_EQ(getStateDbSessionCount(), 3);
+        ASSERT_TRUE(getConsumer()->m_toSync.empty());
+    }
+
+    TEST_F(BfdOrchTest, BulkNotSupportedFallsBackToSingleCalls)
+    {
+        _ut_stub_bulk_supported = false;
+
+        applySessions({ sessionSet("10.0.0.2"), sessionSet("10.0.0.3") });
+
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 0);
+        ASSERT_EQ(_ut_stub_create_calls, 2);
+        ASSERT_EQ(_ut_stub_sessions.size(), 2);
+        ASSERT_EQ(getStateDbSessionCount(), 2);
+        ASSERT_TRUE(getConsumer()->m_toSync.empty());
+
+        applySessions({ sessionDel("10.0.0.2"), sessionDel("10.0.0.3") });
+
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 0);
+        ASSERT_EQ(_ut_stub_remove_calls, 2);
+        ASSERT_TRUE(_ut_stub_sessions.empty());
+        ASSERT_EQ(getStateDbSessionCount(), 0);
+        ASSERT_TRUE(getConsumer()->m_toSync.empty());
+    }
+
+    TEST_F(BfdOrchTest, EveryStateChangeIsPublished)
+    {
+        applySessions({ sessionSet("10.0.0.2"), sessionSet("10.0.0.3") });
+        m_observer.updates.clear();
+
+        // A flap within one round is still seen by the observers, in order
+        m_bfdOrch->handle_bfd_state_notifications({
+            stateChange({ { "10.0.0.2", SAI_BFD_SESSION_STATE_UP }, { "10.0.0.3", SAI_BFD_SESSION_STATE_UP } }),
+            stateChange({ { "10.0.0.2", SAI_BFD_SESSION_STATE_DOWN } }),
+            stateChange({ { "10.0.0.2", SAI_BFD_SESSION_STATE_DOWN } }),
+            stateChange({ { "10.0.0.2", SAI_BFD_SESSION_STATE_UP } })
+        });
+
+        vector<pair<string, sai_bfd_session_state_t>> expected = {
+            { stateDbKey("10.0.0.2"), SAI_BFD_SESSION_STATE_UP },
+            { stateDbKey("10.0.0.3"), SAI_BFD_SESSION_STATE_UP },
+            { stateDbKey("10.0.0.2"), SAI_BFD_SESSION_STATE_DOWN },
+            { stateDbKey("10.0.0.2"), SAI_BFD_SESSION_STATE_UP }
+        };
+        ASSERT_EQ(m_observer.updates, expected);
+        ASSERT_EQ(getStateDbSessionState("10.0.0.2"), "Up");
+        ASSERT_EQ(getStateDbSessionState("10.0.0.3"), "Up");
+    }
+}
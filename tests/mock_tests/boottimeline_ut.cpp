@@ -0,0 +1,98 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "boottimeline.h"
+
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace boottimeline_test
+{
+    using namespace std;
+
+    class TimelineTestOrch : public Orch
+    {
+    public:
+        TimelineTestOrch(swss::DBConnector *db, string tableName)
+            :Orch(db, tableName)
+        {
+        }
+
+        void doTask(Consumer& consumer)
+        {
+            consumer.m_toSync.clear();
+        }
+    };
+
+    struct BootTimelineTest : public ::testing::Test
+    {
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+        }
+
+        virtual void TearDown() override
+        {
+            ::testing_db::reset();
+        }
+    };
+
+    TEST_F(BootTimelineTest, RecordsOrchConstructionAndPhases)
+    {
+        auto &timeline = BootTimeline::instance();
+        timeline.start();
+
+        swss::DBConnector appl_db("APPL_DB", 0);
+        TimelineTestOrch orch(&appl_db, "TIMELINE_TEST_TABLE");
+
+        {
+            BootPhase phase("doTask", "warm_restore_1");
+            phase.setObjects(7);
+        }
+
+        vector<Orch *> orchs = { &orch };
+        timeline.addOrchConstruction(orchs);
+
+        const auto &events = timeline.getEvents();
+        ASSERT_EQ(events.size(), 2);
+        ASSERT_EQ(events[0].name, "doTask");
+        ASSERT_EQ(events[0].objects, 7);
+        ASSERT_EQ(events[1].category, "construct");
+        ASSERT_EQ(events[1].name, "boottimeline_test::TimelineTestOrch");
+
+        auto json = timeline.toTraceJson();
+        ASSERT_NE(json.find("\"traceEvents\""), string::npos);
+        ASSERT_NE(json.find("\"name\":\"boottimeline_test::TimelineTestOrch\",\"cat\":\"construct\",\"ph\":\"X\""), string::npos);
+        ASSERT_NE(json.find("\"args\":{\"objects\":7}"), string::npos);
+
+        char dir[] = "/tmp/boottimelineXXXXXX";
+        ASSERT_NE(mkdtemp(dir), nullptr);
+
+        swss::DBConnector state_db("STATE_DB", 0);
+        timeline.finish(&state_db, dir);
+        ASSERT_FALSE(timeline.isEnabled());
+
+        // Orchs constructed after the boot are not recorded
+        TimelineTestOrch late(&appl_db, "TIMELINE_LATE_TABLE");
+        ASSERT_EQ(timeline.getEvents().size(), 3);
+
+        swss::Table table(&state_db, BOOT_TIMELINE_TABLE);
+        string value;
+        ASSERT_TRUE(table.hget("0000|warm_restore_1|doTask", "objects", value));
+        ASSERT_EQ(value, "7");
+        ASSERT_TRUE(table.hget("0001|construct|boottimeline_test::TimelineTestOrch", "duration_usec", value));
+        ASSERT_TRUE(table.hget("0002|boot|orchagent", "start_usec", value));
+        ASSERT_EQ(value, "0");
+
+        string path = string(dir) + "/" + BOOT_TIMELINE_TRACE_FILE;
+        ifstream file(path);
+        ASSERT_TRUE(file.good());
+        stringstream content;
+        content << file.rdbuf();
+        ASSERT_NE(content.str().find("\"cat\":\"boot\""), string::npos);
+
+        unlink(path.c_str());
+        rmdir(dir);
+    }
+}
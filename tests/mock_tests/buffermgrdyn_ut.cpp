@@ -45,6 +45,8 @@ namespace buffermgrdyn_test
     Table bufferMaxParamTable(m_state_db.get(), STATE_BUFFER_MAXIMUM_VALUE_TABLE);
     Table statePortTable(m_state_db.get(), STATE_PORT_TABLE_NAME);
     Table stateBufferTable(m_state_db.get(), STATE_BUFFER_MAXIMUM_VALUE_TABLE);
+    Table stateAsicTable(m_state_db.get(), STATE_BUFFER_ASIC_TABLE_NAME);
+    Table losslessTrafficPatternTable(m_config_db.get(), CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME);
 
     map<string, vector<FieldValueTuple>> zeroProfileMap;
     vector<KeyOpFieldsValuesTuple> zeroProfile;
@@ -182,8 +184,10 @@ namespace buffermgrdyn_test
                 TableConnector(m_config_db.get(), CFG_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME),
                 TableConnector(m_config_db.get(), CFG_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME),
                 TableConnector(m_config_db.get(), CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER),
+                TableConnector(m_config_db.get(), CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME),
                 TableConnector(m_state_db.get(), STATE_BUFFER_MAXIMUM_VALUE_TABLE),
-                TableConnector(m_state_db.get(), STATE_PORT_TABLE_NAME)
+                TableConnector(m_state_db.get(), STATE_PORT_TABLE_NAME),
+                TableConnector(m_state_db.get(), STATE_BUFFER_ASIC_TABLE_NAME)
             };
 
             m_dynamicBuffer = new BufferMgrDynamic(m_config_db.get(), m_state_db.get(), m_app_db.get(), m_app_state_db.get(), buffer_table_connectors, nullptr, zero_profile);
@@ -2399,4 +2403,66 @@ namespace buffermgrdyn_test
         EXPECT_EQ(m_dynamicBuffer->m_shpProfilesToCheck.size(), profileCheckListSizeBefore)
             << "Should not add profiles to check list when SHP size unchanged";
     }
+
+    /*
+     * Memoized headroom is dropped when the vendor parameters it was calculated from change
+     */
+    TEST_F(BufferMgrDynTest, HeadroomCacheInvalidatedOnParameterChange)
+    {
+        StartBufferManager();
+        m_dynamicBuffer->m_nativeHeadroomSupported = true;
+
+        stateAsicTable.set("MELLANOX-SPECTRUM",
+                           {
+                               {"cell_size", "96"},
+                               {"pipeline_latency", "19"},
+                               {"mac_phy_delay", "0.8"},
+                               {"peer_response_time", "3.8"}
+                           });
+        losslessTrafficPatternTable.set("AZURE",
+                                        {
+                                            {"mtu", "1024"},
+                                            {"small_packet_percentage", "100"}
+                                        });
+
+        buffer_profile_t profile;
+        profile.name = "pg_lossless_100000_5m_profile";
+        profile.speed = "100000";
+        profile.cable_length = "5m";
+        profile.port_mtu = "9100";
+        profile.lane_count = 4;
+
+        m_dynamicBuffer->calculateHeadroomSize(profile);
+        auto xoff = profile.xoff;
+        ASSERT_FALSE(xoff.empty());
+        ASSERT_EQ(m_dynamicBuffer->m_headroomCache.size(), 1);
+        ASSERT_TRUE(m_dynamicBuffer->m_headroomParamLoaded);
+
+        // Fewer small packets need less headroom
+        losslessTrafficPatternTable.set("AZURE",
+                                        {
+                                            {"mtu", "1024"},
+                                            {"small_packet_percentage", "50"}
+                                        });
+        m_dynamicBuffer->addExistingData(&losslessTrafficPatternTable);
+        static_cast<Orch *>(m_dynamicBuffer)->doTask();
+        ASSERT_TRUE(m_dynamicBuffer->m_headroomCache.empty());
+        ASSERT_FALSE(m_dynamicBuffer->m_headroomParamLoaded);
+
+        profile.xoff.clear();
+        m_dynamicBuffer->calculateHeadroomSize(profile);
+        ASSERT_FALSE(profile.xoff.empty());
+        ASSERT_LT(stoul(profile.xoff), stoul(xoff));
+        ASSERT_EQ(m_dynamicBuffer->m_headroomParam.small_packet_percentage, 50);
+
+        // The same goes for the ASIC parameters
+        stateAsicTable.hset("MELLANOX-SPECTRUM", "cell_size", "144");
+        m_dynamicBuffer->addExistingData(&stateAsicTable);
+        static_cast<Orch *>(m_dynamicBuffer)->doTask();
+        ASSERT_TRUE(m_dynamicBuffer->m_headroomCache.empty());
+
+        m_dynamicBuffer->calculateHeadroomSize(profile);
+        ASSERT_EQ(m_dynamicBuffer->m_headroomParam.cell_size, 144);
+        ASSERT_EQ(m_dynamicBuffer->m_headroomCache.size(), 1);
+    }
 }
@@ -10,6 +10,7 @@
 #include "mock_response_publisher.h"
 
 extern string gMySwitchType;
+extern size_t gMaxBulkSize;
 
 extern std::unique_ptr<MockResponsePublisher> gMockResponsePublisher;
 
@@ -135,6 +136,8 @@ namespace bufferorch_test
         return SAI_STATUS_SUCCESS;
     }
 
+    uint32_t _ut_stub_set_pgs_bulk_count;
+    bool _ut_stub_set_pgs_bulk_not_implemented = false;
     sai_status_t _ut_stub_sai_set_ingress_priority_groups_attribute(
         uint32_t object_count,
         const sai_object_id_t *object_id,
@@ -142,6 +145,11 @@ namespace bufferorch_test
         sai_bulk_op_error_mode_t mode,
         sai_status_t *object_statuses)
     {
+        if (_ut_stub_set_pgs_bulk_not_implemented)
+        {
+            return SAI_STATUS_NOT_IMPLEMENTED;
+        }
+        _ut_stub_set_pgs_bulk_count++;
         for (size_t i = 0; i < object_count; i++)
         {
             object_statuses[i] = _ut_stub_sai_set_ingress_priority_group_attribute(object_id[i], attr_list + i);
@@ -619,6 +627,53 @@ namespace bufferorch_test
         _unhook_sai_apis();
     }
 
+    TEST_F(BufferOrchTest, BufferOrchTestPgBulkSetChunksAndFallback)
+    {
+        _hook_sai_apis();
+        vector<string> ts;
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        auto bufferPgConsumer = dynamic_cast<Consumer *>(gBufferOrch->getExecutor(APP_BUFFER_PG_TABLE_NAME));
+
+        auto maxBulkSize = gMaxBulkSize;
+        gMaxBulkSize = 2;
+
+        // 3 PGs are set in 2 bulks
+        for (const auto &alias: { "Ethernet0:0", "Ethernet1:0", "Ethernet2:0" })
+        {
+            entries.push_back({alias, "SET", {{"profile", "ingress_lossy_profile"}}});
+        }
+        bufferPgConsumer->addToSync(entries);
+        entries.clear();
+        auto sai_pgs_bulk_count = _ut_stub_set_pgs_bulk_count;
+        auto sai_pg_attr_set_count = _ut_stub_set_pg_count;
+        static_cast<Orch *>(gBufferOrch)->doTask();
+        ASSERT_EQ(sai_pgs_bulk_count + 2, _ut_stub_set_pgs_bulk_count);
+        ASSERT_EQ(sai_pg_attr_set_count + 3, _ut_stub_set_pg_count);
+        CheckDependency(APP_BUFFER_PG_TABLE_NAME, "Ethernet2:0", "profile", APP_BUFFER_PROFILE_TABLE_NAME, "ingress_lossy_profile");
+
+        // Bulk set is not implemented, the PGs are set one by one from now on
+        _ut_stub_set_pgs_bulk_not_implemented = true;
+        for (const auto &alias: { "Ethernet0:1", "Ethernet1:1", "Ethernet2:1" })
+        {
+            entries.push_back({alias, "SET", {{"profile", "ingress_lossy_profile"}}});
+        }
+        bufferPgConsumer->addToSync(entries);
+        entries.clear();
+        sai_pgs_bulk_count = _ut_stub_set_pgs_bulk_count;
+        sai_pg_attr_set_count = _ut_stub_set_pg_count;
+        static_cast<Orch *>(gBufferOrch)->doTask();
+        ASSERT_EQ(sai_pgs_bulk_count, _ut_stub_set_pgs_bulk_count);
+        ASSERT_EQ(sai_pg_attr_set_count + 3, _ut_stub_set_pg_count);
+        CheckDependency(APP_BUFFER_PG_TABLE_NAME, "Ethernet2:1", "profile", APP_BUFFER_PROFILE_TABLE_NAME, "ingress_lossy_profile");
+
+        static_cast<Orch *>(gBufferOrch)->dumpPendingTasks(ts);
+        ASSERT_TRUE(ts.empty());
+
+        _ut_stub_set_pgs_bulk_not_implemented = false;
+        gMaxBulkSize = maxBulkSize;
+        _unhook_sai_apis();
+    }
+
     TEST_F(BufferOrchTest, BufferOrchTestReferencingObjRemoveThenAdd)
     {
         _hook_sai_apis();
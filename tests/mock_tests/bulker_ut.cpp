@@ -17,6 +17,57 @@ namespace bulker_test
 
     DEFINE_SAI_GENERIC_API_OBJECT_BULK_MOCK_WITH_SET(next_hop, next_hop);
 
+    size_t bulk_create_route_call_count;
+    vector<uint32_t> bulk_create_route_sizes;
+
+    sai_status_t _ut_create_route_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_route_entry_t *route_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        bulk_create_route_call_count++;
+        bulk_create_route_sizes.push_back(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            // Fail the first entry of every call
+            object_statuses[i] = i == 0 ? SAI_STATUS_FAILURE : SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    // Packet action and metadata of every created route, in call order
+    vector<pair<int32_t, uint32_t>> bulk_created_route_attrs;
+
+    sai_status_t _ut_record_create_route_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_route_entry_t *route_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            EXPECT_EQ(attr_count[i], 2);
+            bulk_created_route_attrs.emplace_back(attr_list[i][0].value.s32, attr_list[i][1].value.u32);
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_route_entry_t make_route_entry(uint32_t index)
+    {
+        sai_route_entry_t route_entry;
+        memset(&route_entry, 0, sizeof(route_entry));
+        route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+        route_entry.destination.addr.ip4 = htonl(0x0a000000 + (index << 8));
+        route_entry.destination.mask.ip4 = htonl(0xffffff00);
+        return route_entry;
+    }
+
     sai_bulk_object_create_fn old_object_create;
     sai_bulk_object_remove_fn old_object_remove;
     sai_bulk_object_set_attribute_fn old_object_set_attribute;
@@ -506,4 +557,135 @@ namespace bulker_test
         ASSERT_FALSE(gRouteBulker.bulk_entry_pending_removal_or_set(route_entry));
         ASSERT_FALSE(gRouteBulker.bulk_entry_pending_removal(route_entry));
     }
+
+    TEST_F(BulkerTest, BulkerChunkSizerAdaptsToLatency)
+    {
+        BulkChunkSizer fixed(1000, 0);
+        fixed.record(1000, 1000000);
+        ASSERT_FALSE(fixed.is_adaptive());
+        ASSERT_EQ(fixed.get_chunk_size(), 1000);
+
+        BulkChunkSizer sizer(1000, 10000);
+        ASSERT_EQ(sizer.get_chunk_size(), 1000);
+
+        // Halved on every call over the target, down to the floor
+        sizer.record(1000, 20000);
+        ASSERT_EQ(sizer.get_chunk_size(), 500);
+        for (int i = 0; i < 10; i++)
+        {
+            sizer.record(sizer.get_chunk_size(), 20000);
+        }
+        ASSERT_EQ(sizer.get_chunk_size(), size_t(BulkChunkSizer::MIN_CHUNK_SIZE));
+
+        // Partial chunks and calls close to the target keep the size
+        sizer.record(4, 100);
+        sizer.record(16, 6000);
+        ASSERT_EQ(sizer.get_chunk_size(), 16);
+
+        // Fast full chunks grow it by a quarter, up to the max
+        sizer.record(16, 1000);
+        ASSERT_EQ(sizer.get_chunk_size(), 20);
+        for (int i = 0; i < 100; i++)
+        {
+            sizer.record(sizer.get_chunk_size(), 1000);
+        }
+        ASSERT_EQ(sizer.get_chunk_size(), 1000);
+    }
+
+    TEST_F(BulkerTest, BulkerAutoFlushAndStats)
+    {
+        ExecutorStatsRegistry::instance().setEnabled(true);
+        EntityBulker<sai_route_api_t> gRouteBulker(sai_route_api, 3);
+        ExecutorStatsRegistry::instance().setEnabled(false);
+
+        sai_route_api->create_route_entries = _ut_create_route_entries;
+        bulk_create_route_call_count = 0;
+        bulk_create_route_sizes.clear();
+
+        ASSERT_NE(gRouteBulker.stats, nullptr);
+        uint64_t calls = gRouteBulker.stats->totalCalls.load();
+        uint64_t created = gRouteBulker.stats->totalCreated.load();
+        uint64_t failed = gRouteBulker.stats->totalFailed.load();
+        uint64_t autoFlushes = gRouteBulker.stats->totalAutoFlushes.load();
+
+        sai_attribute_t route_attr;
+        route_attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+        route_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+        deque<sai_status_t> object_statuses;
+        gRouteBulker.enable_auto_flush(4);
+        for (uint32_t i = 0; i < 5; i++)
+        {
+            auto route_entry = make_route_entry(i);
+            object_statuses.emplace_back();
+            gRouteBulker.create_entry(&object_statuses.back(), &route_entry, 1, &route_attr);
+        }
+
+        // The 4th entry flushes the first four in chunks of max_bulk_size, the 5th stays pending
+        ASSERT_EQ(bulk_create_route_call_count, 2);
+        ASSERT_EQ(bulk_create_route_sizes, vector<uint32_t>({3, 1}));
+        ASSERT_EQ(gRouteBulker.creating_entries_count(), 1);
+        ASSERT_EQ(object_statuses[0], SAI_STATUS_FAILURE);
+        ASSERT_EQ(object_statuses[3], SAI_STATUS_FAILURE);
+        ASSERT_EQ(object_statuses[1], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(object_statuses[4], SAI_STATUS_NOT_EXECUTED);
+
+        gRouteBulker.flush();
+        ASSERT_EQ(bulk_create_route_call_count, 3);
+        ASSERT_EQ(object_statuses[4], SAI_STATUS_FAILURE);
+
+        ASSERT_EQ(gRouteBulker.stats->totalCalls.load() - calls, 3);
+        ASSERT_EQ(gRouteBulker.stats->totalCreated.load() - created, 5);
+        ASSERT_EQ(gRouteBulker.stats->totalFailed.load() - failed, 3);
+        ASSERT_EQ(gRouteBulker.stats->totalAutoFlushes.load() - autoFlushes, 1);
+        ASSERT_EQ(gRouteBulker.stats->chunkSize.load(), 3);
+
+        sai_route_api->create_route_entries = nullptr;
+    }
+
+    TEST_F(BulkerTest, BulkerAttrArenaAllocations)
+    {
+        // 100k routes of 2 attributes each used to allocate one vector per route
+        const uint32_t routes = 100000;
+        EntityBulker<sai_route_api_t> gRouteBulker(sai_route_api, 1000);
+        sai_route_api->create_route_entries = _ut_record_create_route_entries;
+        bulk_created_route_attrs.clear();
+
+        deque<sai_status_t> object_statuses;
+        for (uint32_t i = 0; i < routes; i++)
+        {
+            auto route_entry = make_route_entry(i);
+            sai_attribute_t route_attrs[2];
+            route_attrs[0].id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+            route_attrs[0].value.s32 = i % 2 ? SAI_PACKET_ACTION_DROP : SAI_PACKET_ACTION_FORWARD;
+            route_attrs[1].id = SAI_ROUTE_ENTRY_ATTR_META_DATA;
+            route_attrs[1].value.u32 = i;
+
+            object_statuses.emplace_back();
+            gRouteBulker.create_entry(&object_statuses.back(), &route_entry, 2, route_attrs);
+        }
+
+        size_t slabs = gRouteBulker.attr_arena.get_slab_allocations();
+        cout << "Queued " << routes << " routes with " << slabs << " attribute slab allocations" << endl;
+        ASSERT_LE(slabs, routes * 2 / BulkAttrArena::SLAB_SIZE + 1);
+
+        // The copies are intact across slabs
+        gRouteBulker.flush();
+        ASSERT_EQ(bulk_created_route_attrs.size(), routes);
+        for (uint32_t i = 0; i < routes; i++)
+        {
+            ASSERT_EQ(bulk_created_route_attrs[i].first, i % 2 ? SAI_PACKET_ACTION_DROP : SAI_PACKET_ACTION_FORWARD);
+            ASSERT_EQ(bulk_created_route_attrs[i].second, i);
+        }
+
+        // The next batch reuses the first slab
+        auto route_entry = make_route_entry(0);
+        sai_attribute_t route_attrs[2] = {};
+        object_statuses.emplace_back();
+        gRouteBulker.create_entry(&object_statuses.back(), &route_entry, 2, route_attrs);
+        ASSERT_EQ(gRouteBulker.attr_arena.get_slab_allocations(), slabs);
+
+        gRouteBulker.clear();
+        sai_route_api->create_route_entries = nullptr;
+    }
 }
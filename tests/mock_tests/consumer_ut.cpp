@@ -457,6 +457,45 @@ namespace consumer_test
 
     }
 
+    TEST_F(ConsumerTest, ConsumerAddToSync_Moved_Del_Set_Setnew1)
+    {
+        // Test case, same as ConsumerAddToSync_Del_Set_Setnew1 with the queue moved into m_toSync
+        auto entrya = KeyOpFieldsValuesTuple(
+            { key,
+                DEL_COMMAND,
+                { { } } });
+
+        auto entryb = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1a },
+                    { f2, v2a } } });
+
+        auto entryc = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1b },
+                    { f3, v3a } } });
+
+        kofv_q.push_back(entrya);
+        kofv_q.push_back(entryb);
+        kofv_q.push_back(entryc);
+        ASSERT_EQ(consumer->addToSync(std::move(kofv_q)), 3);
+
+        // expect DEL then SET with new values and new fields
+        exp_kofv = entrya;
+        validate_syncmap(consumer->m_toSync, 2, key, exp_kofv);
+
+        exp_kofv = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f2, v2a },
+                    { f1, v1b },
+                    { f3, v3a } } });
+
+        validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
+    }
+
     TEST_F(ConsumerTest, ConsumerPops_notification_count)
     {
         int consumer_pops_batch_size = 10;
@@ -398,6 +398,14 @@ namespace copporch_test
                 }
             );
             ASSERT_EQ(coppOrch.doProcessCoppRule(tableKofvt2), task_process_status::task_success);
+
+            /* The group keeps its policer with the updated rates */
+            const auto &updatedPolicerMap = Portal::CoppOrchInternal::getTrapGroupPolicerMap(coppOrch.get());
+            const auto &cit3 = updatedPolicerMap.find(trapGroupOid);
+            ASSERT_TRUE(cit3 != updatedPolicerMap.end());
+            EXPECT_EQ(cit3->second.policer_id, cit2->second.policer_id);
+            EXPECT_EQ(cit3->second.values.at(SAI_POLICER_ATTR_CIR), 1000u);
+            EXPECT_EQ(cit3->second.values.at(SAI_POLICER_ATTR_CBS), 1000u);
         }
 
 
@@ -90,6 +90,32 @@ namespace counternameupdater_test
         gHFTOrch = saved_gHFTOrch;
     }
 
+    // Test counter name maps set at once
+    TEST_F(CounterNameMapUpdaterTest, SetCounterNameMapBatch)
+    {
+        HFTelOrch *saved_gHFTOrch = gHFTOrch;
+        gHFTOrch = nullptr;
+
+        CounterNameMapUpdater queue_updater("COUNTERS_DB", "COUNTERS_QUEUE_NAME_MAP");
+
+        vector<FieldValueTuple> maps = {
+            {"Ethernet0:0", "oid:0x1500000000001"},
+            {"Ethernet4:0", "oid:0x1500000000002"},
+            {"Ethernet8:0", ""},
+        };
+        queue_updater.setCounterNameMap(maps);
+
+        string value;
+        ASSERT_TRUE(m_counters_queue_name_map_table->hget("", "Ethernet0:0", value));
+        ASSERT_EQ(value, "oid:0x1500000000001");
+        ASSERT_TRUE(m_counters_queue_name_map_table->hget("", "Ethernet4:0", value));
+        ASSERT_EQ(value, "oid:0x1500000000002");
+        ASSERT_TRUE(m_counters_queue_name_map_table->hget("", "Ethernet8:0", value));
+        ASSERT_EQ(value, "oid:0x0");
+
+        gHFTOrch = saved_gHFTOrch;
+    }
+
     // Test single counter name map set
     TEST_F(CounterNameMapUpdaterTest, SetSingleCounterNameMap)
     {
@@ -27,6 +27,8 @@ namespace dashhafloworch_ut
         void doTask(swss::NotificationConsumer &consumer) { DashHaFlowOrch::doTask(consumer); }
         void doTask(swss::SelectableTimer &timer) { DashHaFlowOrch::doTask(timer); }
         void handleSessionFinished(sai_object_id_t session_id) { DashHaFlowOrch::handleSessionFinished(session_id); }
+        void handleSessionFlows(sai_object_id_t session_id, uint32_t count) { DashHaFlowOrch::handleSessionFlows(session_id, count); }
+        uint32_t getMaxInflight() const { return DashHaFlowOrch::getMaxInflight(); }
         void handleTimerExpired(swss::SelectableTimer *timer) { DashHaFlowOrch::handleTimerExpired(timer); }
         swss::SelectableTimer* getSyncTimer() { return m_sync_timer; }
         swss::SelectableTimer* getDumpTimer() { return m_dump_timer; }
@@ -670,6 +672,67 @@ namespace dashhafloworch_ut
         ASSERT_TRUE(found_created) << "New session should be created after previous session finished";
     }
 
+    TEST_F(DashHaFlowOrchTest, StreamingBulkSyncReportsProgress)
+    {
+        sai_object_id_t session_id = 0x1000000000000001;
+        EXPECT_CALL(*mock_sai_dash_flow_api, create_flow_entry_bulk_get_session)
+            .Times(1)
+            .WillOnce(DoAll(SetArgPointee<0>(session_id), Return(SAI_STATUS_SUCCESS)));
+
+        auto consumer = unique_ptr<Consumer>(new Consumer(
+            new swss::ConsumerStateTable(m_dpu_app_db.get(), APP_DASH_FLOW_SYNC_SESSION_TABLE_NAME, 1, 1),
+            m_dashHaFlowOrch, APP_DASH_FLOW_SYNC_SESSION_TABLE_NAME));
+        consumer->addToSync(
+            deque<KeyOpFieldsValuesTuple>(
+                {
+                    {
+                        "SYNC_SESSION_1",
+                        SET_COMMAND,
+                        {
+                            {"type", DashHaFlowOrch::SESSION_TYPE_BULK_SYNC},
+                            {"target_server_ip", "192.168.1.1"},
+                            {"target_server_port", "8080"},
+                            {"mode", "streaming"},
+                            {"max_inflight", "256"},
+                            {"progress_interval", "100"}
+                        }
+                    }
+                }
+            )
+        );
+        static_cast<Orch *>(m_dashHaFlowOrch)->doTask(*consumer.get());
+        ASSERT_EQ(m_dashHaFlowOrch->getMaxInflight(), 256);
+
+        swss::Table state_table(m_dpu_state_db.get(), STATE_DASH_FLOW_SYNC_SESSION_STATE_TABLE_NAME);
+        string value;
+
+        // Progress is only written once a whole chunk of flows is in
+        m_dashHaFlowOrch->handleSessionFlows(session_id, 60);
+        ASSERT_TRUE(state_table.hget("SYNC_SESSION_1", "state", value));
+        ASSERT_EQ(value, "created");
+
+        m_dashHaFlowOrch->handleSessionFlows(session_id, 60);
+        ASSERT_TRUE(state_table.hget("SYNC_SESSION_1", "state", value));
+        ASSERT_EQ(value, "in_progress");
+        ASSERT_TRUE(state_table.hget("SYNC_SESSION_1", "flows", value));
+        ASSERT_EQ(value, "120");
+        ASSERT_TRUE(state_table.hget("SYNC_SESSION_1", "first_flow_latency_in_ms", value));
+
+        m_dashHaFlowOrch->handleSessionFlows(session_id, 5);
+        EXPECT_CALL(*mock_sai_dash_flow_api, remove_flow_entry_bulk_get_session)
+            .Times(1)
+            .WillOnce(Return(SAI_STATUS_SUCCESS));
+        m_dashHaFlowOrch->handleSessionFinished(session_id);
+
+        ASSERT_TRUE(state_table.hget("SYNC_SESSION_1", "state", value));
+        ASSERT_EQ(value, "completed");
+        ASSERT_TRUE(state_table.hget("SYNC_SESSION_1", "flows", value));
+        ASSERT_EQ(value, "125");
+        ASSERT_TRUE(state_table.hget("SYNC_SESSION_1", "flows_per_sec", value));
+        ASSERT_TRUE(state_table.hget("SYNC_SESSION_1", "duration_in_ms", value));
+        ASSERT_EQ(m_dashHaFlowOrch->getMaxInflight(), 1);
+    }
+
     TEST_F(DashHaFlowOrchTest, HandleTimeoutBulkSyncSession)
     {
         sai_object_id_t session_id = 0x1000000000000001;
@@ -468,6 +468,25 @@ namespace dashorch_test
         EXPECT_EQ(removed_entry.vni_range.max, trusted_vni);
     }
 
+    TEST_F(DashOrchTest, EniNameMapWrittenPerBatch)
+    {
+        CreateApplianceEntry();
+        CreateVnet();
+
+        SetDashTable(APP_DASH_ENI_TABLE_NAME, eni1, BuildEniEntry());
+        auto eni = m_DashOrch->getEni(eni1);
+        ASSERT_NE(eni, nullptr);
+
+        swss::DBConnector counters_db("COUNTERS_DB", 0);
+        swss::Table name_map(&counters_db, COUNTERS_ENI_NAME_MAP);
+        string value;
+        ASSERT_TRUE(name_map.hget("", eni1, value));
+        ASSERT_EQ(value, sai_serialize_object_id(eni->eni_id));
+
+        SetDashTable(APP_DASH_ENI_TABLE_NAME, eni1, dash::eni::Eni(), false);
+        ASSERT_FALSE(name_map.hget("", eni1, value));
+    }
+
     TEST_F(DashOrchTest, CreateRemoveEniTrustedVnisSingleRange)
     {
         CreateApplianceEntry();
@@ -0,0 +1,89 @@
+#include <arpa/inet.h>
+
+#include "dashprefixset.h"
+#include "gtest/gtest.h"
+
+namespace dashprefixset_test
+{
+    using namespace std;
+
+    sai_ip_prefix_t v4Prefix(const char *address, uint32_t length)
+    {
+        sai_ip_prefix_t prefix = {};
+        prefix.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+        inet_pton(AF_INET, address, &prefix.addr.ip4);
+        prefix.mask.ip4 = htonl(length ? ~uint32_t(0) << (32 - length) : 0);
+        return prefix;
+    }
+
+    sai_ip_prefix_t v6Prefix(const char *address, uint32_t length)
+    {
+        sai_ip_prefix_t prefix = {};
+        prefix.addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+        inet_pton(AF_INET6, address, prefix.addr.ip6);
+        for (uint32_t i = 0; i < length; i++)
+        {
+            prefix.mask.ip6[i / 8] = static_cast<uint8_t>(prefix.mask.ip6[i / 8] | (0x80 >> (i % 8)));
+        }
+        return prefix;
+    }
+
+    string toString(const vector<sai_ip_prefix_t> &prefixes)
+    {
+        string out;
+        char buf[INET6_ADDRSTRLEN];
+        for (const auto &prefix : prefixes)
+        {
+            int length = 0;
+            if (prefix.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+            {
+                length = __builtin_popcount(prefix.mask.ip4);
+                inet_ntop(AF_INET, &prefix.addr.ip4, buf, sizeof(buf));
+            }
+            else
+            {
+                for (auto byte : prefix.mask.ip6)
+                {
+                    length += __builtin_popcount(byte);
+                }
+                inet_ntop(AF_INET6, prefix.addr.ip6, buf, sizeof(buf));
+            }
+            out += (out.empty() ? "" : ",") + string(buf) + "/" + to_string(length);
+        }
+        return out;
+    }
+
+    TEST(DashPrefixSetTest, CollapsesPrefixes)
+    {
+        DashPrefixSet set({
+            v4Prefix("10.0.1.0", 24),
+            v4Prefix("10.0.0.0", 24),
+            v4Prefix("10.0.0.5", 32),
+            v4Prefix("10.0.1.0", 24),
+            v4Prefix("10.0.2.0", 24),
+            v4Prefix("192.168.1.2", 30),
+        });
+
+        ASSERT_EQ(set.rangeCount(), 2);
+        ASSERT_EQ(toString(set.prefixes()), "10.0.0.0/23,10.0.2.0/24,192.168.1.0/30");
+
+        DashPrefixSet v6({ v6Prefix("2001:db8::", 33), v6Prefix("2001:db8:8000::", 33), v6Prefix("::", 0) });
+        ASSERT_EQ(toString(v6.prefixes()), "::/0");
+    }
+
+    TEST(DashPrefixSetTest, SubtractGivesChangedRanges)
+    {
+        DashPrefixSet before({ v4Prefix("10.0.0.0", 23), v4Prefix("10.0.4.0", 24) });
+        DashPrefixSet after({ v4Prefix("10.0.1.0", 24), v4Prefix("10.0.0.0", 24), v4Prefix("10.0.4.0", 24) });
+
+        ASSERT_EQ(before, after);
+        ASSERT_TRUE(after.subtract(before).empty());
+
+        after = DashPrefixSet({ v4Prefix("10.0.0.0", 24), v4Prefix("10.0.4.0", 24), v4Prefix("10.0.5.0", 25) });
+        ASSERT_EQ(toString(after.subtract(before).prefixes()), "10.0.5.0/25");
+        ASSERT_EQ(toString(before.subtract(after).prefixes()), "10.0.1.0/24");
+
+        DashPrefixSet all({ v4Prefix("0.0.0.0", 0) });
+        ASSERT_EQ(toString(all.subtract(DashPrefixSet({ v4Prefix("0.0.0.0", 1) })).prefixes()), "128.0.0.0/1");
+    }
+}
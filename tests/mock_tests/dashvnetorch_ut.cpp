@@ -170,4 +170,37 @@ namespace dashvnetorch_test
         int actualUsed = GetCrmUsedCount(CrmResourceType::CRM_DASH_IPV4_PA_VALIDATION);
         EXPECT_EQ(expectedUsed, actualUsed);
     }
+
+    TEST_F(DashVnetOrchTest, VnetMapBatchParsedOnParseThreads)
+    {
+        AddVnetEncapRoutingType(dash::route_type::ENCAP_TYPE_VXLAN);
+        CreateVnet();
+
+        dash::vnet_mapping::VnetMapping vnet_map;
+        vnet_map.set_routing_type(dash::route_type::ROUTING_TYPE_VNET_ENCAP);
+        vnet_map.mutable_underlay_ip()->set_ipv4(swss::IpAddress("7.7.7.7").getV4Addr());
+        std::string pb = vnet_map.SerializeAsString();
+
+        // More than one hand off, and a task without its message
+        auto consumer = std::make_unique<Consumer>(
+            new swss::ConsumerStateTable(m_app_db.get(), APP_DASH_VNET_MAPPING_TABLE_NAME),
+            m_dashVnetOrch, APP_DASH_VNET_MAPPING_TABLE_NAME);
+        std::deque<swss::KeyOpFieldsValuesTuple> entries;
+        for (int i = 0; i < 600; i++)
+        {
+            std::string ip = "10.0." + std::to_string(i / 256) + "." + std::to_string(i % 256);
+            entries.push_back({ vnet1 + ":" + ip, SET_COMMAND, { { "pb", pb } } });
+        }
+        entries.push_back({ vnet1 + ":10.1.0.0", SET_COMMAND, { { "not_pb", pb } } });
+        consumer->addToSync(entries);
+
+        int expectedUsed = GetCrmUsedCount(CrmResourceType::CRM_DASH_IPV4_OUTBOUND_CA_TO_PA) + 600;
+
+        DashParsePool::setThreads(2);
+        static_cast<Orch *>(m_dashVnetOrch)->doTask(*consumer.get());
+        DashParsePool::setThreads(0);
+
+        EXPECT_TRUE(consumer->m_toSync.empty());
+        EXPECT_EQ(GetCrmUsedCount(CrmResourceType::CRM_DASH_IPV4_OUTBOUND_CA_TO_PA), expectedUsed);
+    }
 }
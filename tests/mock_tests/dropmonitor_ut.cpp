@@ -0,0 +1,104 @@
+#define private public
+#include "drop_monitor.h"
+#undef private
+#include "ut_helper.h"
+
+namespace dropmonitor_test
+{
+    using namespace std;
+
+    static DropMonitorConfig makeConfig(uint64_t drops, uint64_t incidents, uint64_t window)
+    {
+        DropMonitorConfig config;
+        config.enabled = true;
+        config.drop_count_threshold = drops;
+        config.incident_count_threshold = incidents;
+        config.window = window;
+        return config;
+    }
+
+    TEST(DropMonitorTest, PersistentDropsRaiseAlert)
+    {
+        DropMonitor monitor(nullptr);
+        monitor.addPort("Ethernet0", 0x1000000000001);
+        monitor.setCounter("DEBUG_0", "SAI_PORT_STAT_IN_DROP_REASON_RANGE_BASE", makeConfig(10, 2, 100));
+        ASSERT_FALSE(monitor.empty());
+
+        auto &m = monitor.m_monitors[0];
+        ASSERT_EQ(m.capacity, 3u);
+
+        // The first poll only sets the reference count
+        ASSERT_FALSE(monitor.addSample(m, 0, 1000, 0));
+
+        // Three polls over the threshold within the window
+        ASSERT_FALSE(monitor.addSample(m, 0, 1020, 10));
+        ASSERT_FALSE(monitor.addSample(m, 0, 1025, 20));
+        ASSERT_FALSE(monitor.addSample(m, 0, 1040, 30));
+        ASSERT_TRUE(monitor.addSample(m, 0, 1060, 40));
+
+        // The incidents are cleared by the alert
+        ASSERT_EQ(m.count[0], 0u);
+        ASSERT_FALSE(monitor.addSample(m, 0, 1080, 50));
+    }
+
+    TEST(DropMonitorTest, IncidentsExpireOutOfWindow)
+    {
+        DropMonitor monitor(nullptr);
+        monitor.addPort("Ethernet0", 0x1000000000001);
+        monitor.setCounter("DEBUG_0", "SAI_PORT_STAT_IN_DROP_REASON_RANGE_BASE", makeConfig(0, 1, 30));
+
+        auto &m = monitor.m_monitors[0];
+        ASSERT_FALSE(monitor.addSample(m, 0, 0, 0));
+        ASSERT_FALSE(monitor.addSample(m, 0, 5, 10));
+
+        // The first incident is out of the window
+        ASSERT_FALSE(monitor.addSample(m, 0, 10, 50));
+        ASSERT_EQ(m.count[0], 1u);
+
+        // Cleared counters are no drops
+        ASSERT_FALSE(monitor.addSample(m, 0, 0, 60));
+        ASSERT_TRUE(monitor.addSample(m, 0, 5, 70));
+    }
+
+    TEST(DropMonitorTest, PortRemovalKeepsOtherPorts)
+    {
+        DropMonitor monitor(nullptr);
+        monitor.addPort("Ethernet0", 0x1000000000001);
+        monitor.addPort("Ethernet4", 0x1000000000002);
+        monitor.setCounter("DEBUG_0", "SAI_PORT_STAT_IN_DROP_REASON_RANGE_BASE", makeConfig(0, 1, 100));
+
+        auto &m = monitor.m_monitors[0];
+        ASSERT_FALSE(monitor.addSample(m, 1, 0, 0));
+        ASSERT_FALSE(monitor.addSample(m, 1, 5, 10));
+
+        // Ethernet4 moves to the first slot with its state
+        monitor.removePort("Ethernet0");
+        ASSERT_EQ(monitor.m_ports.size(), 1u);
+        ASSERT_EQ(monitor.m_portIndex.at("Ethernet4"), 0u);
+        ASSERT_EQ(m.count[0], 1u);
+        ASSERT_TRUE(monitor.addSample(m, 0, 10, 20));
+
+        // Disabling the counter stops monitoring it
+        monitor.setCounter("DEBUG_0", "SAI_PORT_STAT_IN_DROP_REASON_RANGE_BASE", DropMonitorConfig());
+        ASSERT_TRUE(monitor.empty());
+    }
+
+    TEST(DropMonitorTest, ReadsOnDedicatedConnection)
+    {
+        auto counters_db = make_shared<swss::DBConnector>("COUNTERS_DB", 0);
+        DropMonitor monitor(counters_db);
+        monitor.addPort("Ethernet0", 0x1000000000001);
+        monitor.setCounter("DEBUG_0", "SAI_PORT_STAT_IN_DROP_REASON_RANGE_BASE", makeConfig(0, 1, 100));
+        ASSERT_EQ(monitor.m_readDb, nullptr);
+
+        // The batch is not read on the connection shared with the other writers
+        monitor.poll(0);
+        ASSERT_NE(monitor.m_readDb, nullptr);
+        ASSERT_NE(monitor.m_readDb->getContext(), counters_db->getContext());
+        ASSERT_EQ(monitor.m_readDb->getDbId(), counters_db->getDbId());
+
+        auto read_db = monitor.m_readDb.get();
+        monitor.poll(10);
+        ASSERT_EQ(monitor.m_readDb.get(), read_db);
+    }
+}
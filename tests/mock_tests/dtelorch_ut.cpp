@@ -0,0 +1,300 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "dtelorch.h"
+#undef private
+#include "mock_orch_test.h"
+
+namespace dtelorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    sai_dtel_api_t ut_sai_dtel_api;
+    sai_dtel_api_t *pold_sai_dtel_api;
+
+    sai_object_id_t _ut_stub_next_oid;
+    set<sai_object_id_t> _ut_stub_queue_reports;
+    // Queue reports the SAI fails to create, by queue, and to remove, by id
+    sai_object_id_t _ut_stub_failing_queue_id;
+    sai_object_id_t _ut_stub_failing_queue_report_id;
+    bool _ut_stub_bulk_supported;
+    uint32_t _ut_stub_bulk_create_calls;
+    uint32_t _ut_stub_bulk_remove_calls;
+
+    sai_status_t _ut_stub_create_dtel(
+        _Out_ sai_object_id_t *dtel_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        *dtel_id = ++_ut_stub_next_oid;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_remove_dtel(
+        _In_ sai_object_id_t dtel_id)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_set_dtel_attribute(
+        _In_ sai_object_id_t dtel_id,
+        _In_ const sai_attribute_t *attr)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_create_dtel_queue_report(
+        _Out_ sai_object_id_t *queue_report_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            if (attr_list[i].id == SAI_DTEL_QUEUE_REPORT_ATTR_QUEUE_ID &&
+                attr_list[i].value.oid == _ut_stub_failing_queue_id)
+            {
+                return SAI_STATUS_TABLE_FULL;
+            }
+        }
+
+        *queue_report_id = ++_ut_stub_next_oid;
+        _ut_stub_queue_reports.insert(*queue_report_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_remove_dtel_queue_report(
+        _In_ sai_object_id_t queue_report_id)
+    {
+        if (queue_report_id == _ut_stub_failing_queue_report_id)
+        {
+            return SAI_STATUS_OBJECT_IN_USE;
+        }
+
+        _ut_stub_queue_reports.erase(queue_report_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_create_dtel_queue_reports(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        if (!_ut_stub_bulk_supported)
+        {
+            return SAI_STATUS_NOT_IMPLEMENTED;
+        }
+
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_create_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_create_dtel_queue_report(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_remove_dtel_queue_reports(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        if (!_ut_stub_bulk_supported)
+        {
+            return SAI_STATUS_NOT_IMPLEMENTED;
+        }
+
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_remove_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_remove_dtel_queue_report(object_id[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    class DTelOrchTest : public MockOrchTest
+    {
+    protected:
+        DTelOrch *m_dtelOrch;
+
+        void ApplyInitialConfigs()
+        {
+            Table port_table = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+            auto ports = ut_helper::getInitialSaiPorts();
+            port_table.set(ETHERNET0, ports[ETHERNET0]);
+            port_table.set("PortConfigDone", { { "count", to_string(1) } });
+            port_table.set("PortInitDone", { {} });
+
+            gPortsOrch->addExistingData(&port_table);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+        }
+
+        void PostSetUp() override
+        {
+            ut_sai_dtel_api = *sai_dtel_api;
+            pold_sai_dtel_api = sai_dtel_api;
+            ut_sai_dtel_api.create_dtel = _ut_stub_create_dtel;
+            ut_sai_dtel_api.remove_dtel = _ut_stub_remove_dtel;
+            ut_sai_dtel_api.set_dtel_attribute = _ut_stub_set_dtel_attribute;
+            ut_sai_dtel_api.create_dtel_queue_report = _ut_stub_create_dtel_queue_report;
+            ut_sai_dtel_api.remove_dtel_queue_report = _ut_stub_remove_dtel_queue_report;
+            sai_dtel_api = &ut_sai_dtel_api;
+
+            _ut_stub_next_oid = 0x1000;
+            _ut_stub_queue_reports.clear();
+            _ut_stub_failing_queue_id = SAI_NULL_OBJECT_ID;
+            _ut_stub_failing_queue_report_id = SAI_NULL_OBJECT_ID;
+            _ut_stub_bulk_supported = true;
+            _ut_stub_bulk_create_calls = 0;
+            _ut_stub_bulk_remove_calls = 0;
+
+            vector<string> dtel_tables = {
+                CFG_DTEL_TABLE_NAME,
+                CFG_DTEL_REPORT_SESSION_TABLE_NAME,
+                CFG_DTEL_INT_SESSION_TABLE_NAME,
+                CFG_DTEL_QUEUE_REPORT_TABLE_NAME,
+                CFG_DTEL_EVENT_TABLE_NAME
+            };
+            m_dtelOrch = new DTelOrch(m_config_db.get(), dtel_tables, gPortsOrch);
+
+            m_dtelOrch->m_queueReportBulker.create_entries = _ut_stub_create_dtel_queue_reports;
+            m_dtelOrch->m_queueReportBulker.remove_entries = _ut_stub_remove_dtel_queue_reports;
+        }
+
+        void PreTearDown() override
+        {
+            delete m_dtelOrch;
+            sai_dtel_api = pold_sai_dtel_api;
+        }
+
+        void applyQueueReports(const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            auto consumer = dynamic_cast<Consumer *>(m_dtelOrch->getExecutor(CFG_DTEL_QUEUE_REPORT_TABLE_NAME));
+            consumer->addToSync(entries);
+            static_cast<Orch *>(m_dtelOrch)->doTask();
+        }
+
+        KeyOpFieldsValuesTuple queueReportSet(const string &queue)
+        {
+            return { ETHERNET0 + "|" + queue, SET_COMMAND, { { REPORT_TAIL_DROP, ENABLED }, { QUEUE_DEPTH_THRESHOLD, "1000" } } };
+        }
+
+        KeyOpFieldsValuesTuple queueReportDel(const string &queue)
+        {
+            return { ETHERNET0 + "|" + queue, DEL_COMMAND, {} };
+        }
+
+        sai_object_id_t getQueueId(uint32_t index)
+        {
+            Port port;
+            gPortsOrch->getPort(ETHERNET0, port);
+            return port.m_queue_ids[index];
+        }
+
+        sai_object_id_t getQueueReportOid(const string &queue)
+        {
+            sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+            m_dtelOrch->getQueueReportOid(ETHERNET0, queue, oid);
+            return oid;
+        }
+    };
+
+    TEST_F(DTelOrchTest, QueueReportBulkCreateFailedInTheMiddle)
+    {
+        _ut_stub_failing_queue_id = getQueueId(1);
+
+        applyQueueReports({ queueReportSet("0"), queueReportSet("1"), queueReportSet("2") });
+
+        // The queue reports of the batch go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        ASSERT_EQ(_ut_stub_queue_reports.size(), 2);
+        ASSERT_EQ(_ut_stub_queue_reports.count(getQueueReportOid("0")), 1);
+        ASSERT_EQ(_ut_stub_queue_reports.count(getQueueReportOid("2")), 1);
+
+        // The failed queue report stays configured without an object
+        ASSERT_TRUE(m_dtelOrch->isQueueReportEnabled(ETHERNET0, "1"));
+        ASSERT_EQ(getQueueReportOid("1"), SAI_NULL_OBJECT_ID);
+        ASSERT_TRUE(m_dtelOrch->m_queueReportRequests.empty());
+        ASSERT_TRUE(m_dtelOrch->m_pendingQueueReports.empty());
+
+        // Setting it again creates it
+        _ut_stub_failing_queue_id = SAI_NULL_OBJECT_ID;
+        applyQueueReports({ queueReportSet("1") });
+        ASSERT_EQ(_ut_stub_queue_reports.size(), 3);
+        ASSERT_EQ(_ut_stub_queue_reports.count(getQueueReportOid("1")), 1);
+    }
+
+    TEST_F(DTelOrchTest, QueueReportBulkRemoveFailedInTheMiddle)
+    {
+        applyQueueReports({ queueReportSet("0"), queueReportSet("1"), queueReportSet("2") });
+        ASSERT_EQ(_ut_stub_queue_reports.size(), 3);
+
+        auto failing_oid = getQueueReportOid("1");
+        _ut_stub_failing_queue_report_id = failing_oid;
+
+        applyQueueReports({ queueReportDel("0"), queueReportDel("1"), queueReportDel("2") });
+
+        // The queue reports of the batch go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 1);
+
+        // The queue report that is still in the SAI is kept with its id
+        ASSERT_EQ(_ut_stub_queue_reports.size(), 1);
+        ASSERT_FALSE(m_dtelOrch->isQueueReportEnabled(ETHERNET0, "0"));
+        ASSERT_FALSE(m_dtelOrch->isQueueReportEnabled(ETHERNET0, "2"));
+        ASSERT_TRUE(m_dtelOrch->isQueueReportEnabled(ETHERNET0, "1"));
+        ASSERT_EQ(getQueueReportOid("1"), failing_oid);
+
+        // Deleting it again removes it
+        _ut_stub_failing_queue_report_id = SAI_NULL_OBJECT_ID;
+        applyQueueReports({ queueReportDel("1") });
+        ASSERT_TRUE(_ut_stub_queue_reports.empty());
+        ASSERT_TRUE(m_dtelOrch->m_dTelPortTable.empty());
+    }
+
+    TEST_F(DTelOrchTest, QueueReportFallbackWithoutBulkSupport)
+    {
+        _ut_stub_bulk_supported = false;
+        _ut_stub_failing_queue_id = getQueueId(1);
+
+        applyQueueReports({ queueReportSet("0"), queueReportSet("1"), queueReportSet("2") });
+
+        // Each queue report is created on its own
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 0);
+        ASSERT_EQ(_ut_stub_queue_reports.size(), 2);
+        ASSERT_EQ(_ut_stub_queue_reports.count(getQueueReportOid("0")), 1);
+        ASSERT_EQ(getQueueReportOid("1"), SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(_ut_stub_queue_reports.count(getQueueReportOid("2")), 1);
+
+        _ut_stub_failing_queue_report_id = getQueueReportOid("0");
+        applyQueueReports({ queueReportDel("0"), queueReportDel("2") });
+
+        // Each queue report is removed on its own
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 0);
+        ASSERT_EQ(_ut_stub_queue_reports.size(), 1);
+        ASSERT_TRUE(m_dtelOrch->isQueueReportEnabled(ETHERNET0, "0"));
+        ASSERT_FALSE(m_dtelOrch->isQueueReportEnabled(ETHERNET0, "2"));
+    }
+}
@@ -0,0 +1,190 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "executorstatsorch.h"
+#include "orchagentstatsorch.h"
+
+namespace executorstats_test
+{
+    using namespace std;
+
+    class StatsTestOrch : public Orch
+    {
+    public:
+        StatsTestOrch(swss::DBConnector *db, string tableName)
+            :Orch(db, tableName)
+        {
+        }
+
+        void doTask(Consumer& consumer)
+        {
+            consumer.m_toSync.clear();
+        }
+
+        Consumer *getConsumer(const string &name)
+        {
+            return dynamic_cast<Consumer *>(getExecutor(name));
+        }
+
+        void getObjectCounts(vector<FieldValueTuple> &counts) const override
+        {
+            counts.emplace_back("test_objects", to_string(objects));
+        }
+
+        size_t objects = 0;
+    };
+
+    struct ExecutorStatsTest : public ::testing::Test
+    {
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+            ExecutorStatsRegistry::instance().setEnabled(true);
+        }
+
+        virtual void TearDown() override
+        {
+            ExecutorStatsRegistry::instance().setEnabled(false);
+            ::testing_db::reset();
+        }
+    };
+
+    TEST(LatencyHistogramTest, BucketBounds)
+    {
+        for (uint64_t v = 0; v < 65536; v++)
+        {
+            auto idx = LatencyHistogram::bucketIndex(v);
+            ASSERT_TRUE(idx < LatencyHistogram::BUCKET_COUNT);
+            ASSERT_GE(LatencyHistogram::bucketUpperBound(idx), v);
+            if (idx > 0)
+            {
+                ASSERT_LT(LatencyHistogram::bucketUpperBound(idx - 1), v);
+            }
+        }
+
+        ASSERT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+    }
+
+    TEST(LatencyHistogramTest, Percentiles)
+    {
+        LatencyHistogram hist;
+
+        ASSERT_EQ(hist.percentile(50), 0);
+
+        for (uint64_t v = 1; v <= 1000; v++)
+        {
+            hist.record(v);
+        }
+
+        ASSERT_EQ(hist.count(), 1000);
+        ASSERT_EQ(hist.max(), 1000);
+        ASSERT_EQ(hist.sum(), 500500);
+
+        // Relative error is bounded by the sub-bucket resolution
+        auto p50 = hist.percentile(50);
+        ASSERT_GE(p50, 500);
+        ASSERT_LE(p50, 500 + 500 / LatencyHistogram::SUB_BUCKET_COUNT);
+        ASSERT_EQ(hist.percentile(100), 1000);
+
+        hist.reset();
+        ASSERT_EQ(hist.count(), 0);
+        ASSERT_EQ(hist.max(), 0);
+    }
+
+    TEST_F(ExecutorStatsTest, ConsumerRecordsBacklogAndDoTask)
+    {
+        swss::DBConnector appl_db("APPL_DB", 0);
+        StatsTestOrch orch(&appl_db, "STATS_TEST_TABLE");
+
+        auto consumer = orch.getConsumer("STATS_TEST_TABLE");
+        ASSERT_NE(consumer, nullptr);
+        auto stats = consumer->getStats();
+        ASSERT_NE(stats, nullptr);
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"key1", SET_COMMAND, { {"f", "v"} }});
+        entries.push_back({"key2", SET_COMMAND, { {"f", "v"} }});
+        consumer->addToSync(entries);
+
+        ASSERT_EQ(stats->toSyncDepth.count(), 1);
+        ASSERT_EQ(stats->toSyncDepth.max(), 2);
+
+        consumer->drain();
+        ASSERT_EQ(stats->doTaskUsec.count(), 1);
+        ASSERT_EQ(stats->totalDoTasks.load(), 1);
+
+        // Nothing to do, doTask is not invoked and not recorded
+        consumer->drain();
+        ASSERT_EQ(stats->doTaskUsec.count(), 1);
+
+        stats->recordPop(3);
+        stats->recordPop(2);
+
+        ExecutorStatsOrch statsOrch(1);
+        statsOrch.publish();
+
+        swss::DBConnector counters_db("COUNTERS_DB", 0);
+        swss::Table table(&counters_db, EXECUTOR_STATS_TABLE);
+        std::string value;
+        ASSERT_TRUE(table.hget("STATS_TEST_TABLE", "to_sync_depth_max", value));
+        ASSERT_EQ(value, "2");
+        ASSERT_TRUE(table.hget("STATS_TEST_TABLE", "total_pop_entries", value));
+        ASSERT_EQ(value, "5");
+        ASSERT_TRUE(table.hget("STATS_TEST_TABLE", "total_dotasks", value));
+        ASSERT_EQ(value, "1");
+
+        // Interval histograms are reset after being published
+        ASSERT_EQ(stats->toSyncDepth.count(), 0);
+    }
+
+    TEST_F(ExecutorStatsTest, DisabledConsumerHasNoStats)
+    {
+        ExecutorStatsRegistry::instance().setEnabled(false);
+
+        swss::DBConnector appl_db("APPL_DB", 0);
+        StatsTestOrch orch(&appl_db, "STATS_DISABLED_TABLE");
+
+        auto consumer = orch.getConsumer("STATS_DISABLED_TABLE");
+        ASSERT_NE(consumer, nullptr);
+        ASSERT_EQ(consumer->getStats(), nullptr);
+    }
+
+    TEST_F(ExecutorStatsTest, OrchAgentStatsPublishesBacklog)
+    {
+        swss::DBConnector appl_db("APPL_DB", 0);
+        StatsTestOrch orch(&appl_db, "STATS_BACKLOG_TABLE");
+        orch.objects = 3;
+
+        auto consumer = orch.getConsumer("STATS_BACKLOG_TABLE");
+        ASSERT_NE(consumer, nullptr);
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"key1", SET_COMMAND, { {"f", "v"} }});
+        entries.push_back({"key2", SET_COMMAND, { {"f", "v"} }});
+        consumer->addToSync(entries);
+
+        vector<Orch *> orchs = { &orch };
+        OrchAgentStatsOrch statsOrch(orchs, 1);
+        statsOrch.publish();
+
+        swss::DBConnector state_db("STATE_DB", 0);
+        swss::Table table(&state_db, ORCHAGENT_STATS_TABLE);
+        std::string value;
+        ASSERT_TRUE(table.hget(ORCHAGENT_STATS_CONSUMER_PREFIX "STATS_BACKLOG_TABLE", "to_sync", value));
+        ASSERT_EQ(value, "2");
+        ASSERT_TRUE(table.hget(ORCHAGENT_STATS_CONSUMER_PREFIX "STATS_BACKLOG_TABLE", "retry_pending", value));
+        ASSERT_EQ(value, "0");
+        ASSERT_TRUE(table.hget(ORCHAGENT_STATS_OBJECTS_KEY, "test_objects", value));
+        ASSERT_EQ(value, "3");
+
+        // The drain empties m_toSync, the next snapshot follows
+        consumer->drain();
+        orch.objects = 1;
+        statsOrch.publish();
+
+        ASSERT_TRUE(table.hget(ORCHAGENT_STATS_CONSUMER_PREFIX "STATS_BACKLOG_TABLE", "to_sync", value));
+        ASSERT_EQ(value, "0");
+        ASSERT_TRUE(table.hget(ORCHAGENT_STATS_OBJECTS_KEY, "test_objects", value));
+        ASSERT_EQ(value, "1");
+    }
+}
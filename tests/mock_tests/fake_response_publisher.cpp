@@ -39,6 +39,18 @@ void ResponsePublisher::publish(
     }
 }
 
+void ResponsePublisher::publishBulk(
+    const std::string& table, const std::vector<Response>& bulk, bool replace)
+{
+    if (gMockResponsePublisher)
+    {
+        for (const auto& response : bulk)
+        {
+            gMockResponsePublisher->publish(table, response.key, response.intent_attrs, response.status, replace);
+        }
+    }
+}
+
 void ResponsePublisher::writeToDB(
     const std::string& table, const std::string& key,
     const std::vector<swss::FieldValueTuple>& values, const std::string& op,
@@ -75,15 +75,9 @@ const std::string WarmStartHelper::printKFV(const std::string &key,
     return "";
 }
 
-bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &left,
-                                   const std::vector<FieldValueTuple> &right)
+uint64_t WarmStartHelper::digestFV(const std::vector<FieldValueTuple> &fv)
 {
-    return false;
-}
-
-bool WarmStartHelper::compareOneFV(const std::string &v1, const std::string &v2)
-{
-    return false;
+    return 0;
 }
 
 }
@@ -46,12 +46,47 @@ namespace fdb_syncd_flush_test
         return SAI_STATUS_SUCCESS;
     }
 
+    static int g_sai_bulk_create_call_count = 0;
+    static int g_sai_bulk_remove_call_count = 0;
+
+    sai_status_t _ut_stub_sai_create_fdb_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_fdb_entry_t *fdb_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        g_sai_bulk_create_call_count++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_sai_remove_fdb_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_fdb_entry_t *fdb_entry,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        g_sai_bulk_remove_call_count++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
     void _hook_sai_fdb_api()
     {
         ut_sai_fdb_api = *sai_fdb_api;
         pold_sai_fdb_api = sai_fdb_api;
         ut_sai_fdb_api.create_fdb_entry = _ut_stub_sai_create_fdb_entry;
         ut_sai_fdb_api.flush_fdb_entries = _ut_stub_sai_flush_fdb_entries;
+        ut_sai_fdb_api.create_fdb_entries = _ut_stub_sai_create_fdb_entries;
+        ut_sai_fdb_api.remove_fdb_entries = _ut_stub_sai_remove_fdb_entries;
         sai_fdb_api = &ut_sai_fdb_api;
     }
     void _unhook_sai_fdb_api()
@@ -225,6 +260,55 @@ namespace fdb_syncd_flush_test
         entry.bv_id = bv_id;
         m_fdborch->update(type, &entry, bridge_port_id, SAI_FDB_ENTRY_TYPE_DYNAMIC);
     }
+
+    /* Queues one fdb_event notification on the FDB notification consumer */
+    void queueFdbEvent(FdbOrch* m_fdborch,
+                       sai_fdb_event_t type,
+                       vector<uint8_t> mac_addr,
+                       sai_object_id_t bridge_port_id,
+                       sai_object_id_t bv_id){
+        sai_fdb_event_notification_data_t event;
+        memset(&event, 0, sizeof(event));
+        event.event_type = type;
+        for (int i = 0; i < (int)mac_addr.size(); i++){
+            *(event.fdb_entry.mac_address+i) = mac_addr[i];
+        }
+        event.fdb_entry.bv_id = bv_id;
+
+        sai_attribute_t attr;
+        attr.id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+        attr.value.oid = bridge_port_id;
+        event.attr_count = 1;
+        event.attr = &attr;
+
+        std::vector<swss::FieldValueTuple> notifyValues;
+        notifyValues.emplace_back("fdb_event", sai_serialize_fdb_event_ntf(1, &event));
+        std::string msg = swss::JSon::buildJson(notifyValues);
+
+        mockReply = (redisReply *)calloc(1, sizeof(redisReply));
+        mockReply->type = REDIS_REPLY_ARRAY;
+        mockReply->elements = 3;
+        mockReply->element = (redisReply **)calloc(mockReply->elements, sizeof(redisReply *));
+        mockReply->element[0] = (redisReply *)calloc(1, sizeof(redisReply));
+        mockReply->element[1] = (redisReply *)calloc(1, sizeof(redisReply));
+        mockReply->element[2] = (redisReply *)calloc(1, sizeof(redisReply));
+        mockReply->element[2]->type = REDIS_REPLY_STRING;
+        mockReply->element[2]->str = (char *)calloc(1, msg.length() + 1);
+        memcpy(mockReply->element[2]->str, msg.c_str(), msg.length());
+
+        m_fdborch->m_fdbNotificationConsumer->readData();
+        mockReply = nullptr;
+    }
+
+    struct FdbEventsRecorder : public EventSubscriber<FdbUpdate>
+    {
+        vector<vector<FdbUpdate>> batches;
+
+        void onEvents(const vector<FdbUpdate> &events) override
+        {
+            batches.push_back(events);
+        }
+    };
 }
 
 namespace fdb_syncd_flush_test
@@ -363,7 +447,7 @@ namespace fdb_syncd_flush_test
 
         /* Event 2: Generate a FDB Flush per port and per vlan */
         vector<uint8_t> flush_mac_addr = {0, 0, 0, 0, 0, 0};
-        for (map<FdbEntry, FdbData>::iterator it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
+        for (auto it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
         {
             it->second.is_flush_pending = true;
         }
@@ -411,7 +495,7 @@ namespace fdb_syncd_flush_test
 
         /* Event2: Send a Consolidated Flush response from syncd */
         vector<uint8_t> flush_mac_addr = {0, 0, 0, 0, 0, 0};
-        for (map<FdbEntry, FdbData>::iterator it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
+        for (auto it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
         {
             it->second.is_flush_pending = true;
         }
@@ -459,7 +543,7 @@ namespace fdb_syncd_flush_test
 
         /* Event2: Send a Consolidated Flush response from syncd for vlan */
         vector<uint8_t> flush_mac_addr = {0, 0, 0, 0, 0, 0};
-        for (map<FdbEntry, FdbData>::iterator it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
+        for (auto it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
         {
             it->second.is_flush_pending = true;
         }
@@ -507,7 +591,7 @@ namespace fdb_syncd_flush_test
 
         /* Event2: Send a Consolidated Flush response from syncd for a port */
         vector<uint8_t> flush_mac_addr = {0, 0, 0, 0, 0, 0};
-        for (map<FdbEntry, FdbData>::iterator it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
+        for (auto it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
         {
             it->second.is_flush_pending = true;
         }
@@ -561,7 +645,7 @@ namespace fdb_syncd_flush_test
 
         /* Event 2: Generate a FDB Flush per port and per vlan */
         vector<uint8_t> flush_mac_addr = {0, 0, 0, 0, 0, 0};
-        for (map<FdbEntry, FdbData>::iterator it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
+        for (auto it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
         {
             it->second.is_flush_pending = true;
         }
@@ -609,7 +693,7 @@ namespace fdb_syncd_flush_test
 
         /* Event 2: Generate a non-consilidated FDB Flush per port and per vlan */
         vector<uint8_t> flush_mac_addr = {124, 254, 144, 18, 34, 236};
-        for (map<FdbEntry, FdbData>::iterator it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
+        for (auto it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
         {
             it->second.is_flush_pending = true;
         }
@@ -782,4 +866,120 @@ namespace fdb_syncd_flush_test
         EXPECT_EQ(m_fdborch->m_entries.find(fdb_entry), m_fdborch->m_entries.end())
             << "DYNAMIC entry survived: event[1] inherited STATIC type (type bleed regression)";
     }
-}
\ No newline at end of file
+
+    /* The queued FDB notifications are handled as one batch, coalesced per MAC */
+    TEST_F(FdbOrchTest, FdbEventNotificationsBatched)
+    {
+        setUpVlan(m_portsOrch.get());
+        setUpPort(m_portsOrch.get());
+        setUpVlanMember(m_portsOrch.get());
+        m_portsOrch->m_initDone = true;
+
+        sai_object_id_t bv_id      = m_portsOrch->m_portList[VLAN40].m_vlan_info.vlan_oid;
+        sai_object_id_t bp_id_eth0 = m_portsOrch->m_portList[ETH0].m_bridge_port_id;
+        vector<uint8_t> mac1 = {0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0x01};
+        vector<uint8_t> mac2 = {0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0x02};
+
+        FdbEventsRecorder recorder;
+        m_fdborch->getFdbEvents().subscribe(&recorder);
+
+        /* mac1 is learned and aged in the same batch */
+        queueFdbEvent(m_fdborch.get(), SAI_FDB_EVENT_LEARNED, mac1, bp_id_eth0, bv_id);
+        queueFdbEvent(m_fdborch.get(), SAI_FDB_EVENT_LEARNED, mac2, bp_id_eth0, bv_id);
+        queueFdbEvent(m_fdborch.get(), SAI_FDB_EVENT_AGED, mac1, bp_id_eth0, bv_id);
+
+        m_fdborch->doTask(*m_fdborch->m_fdbNotificationConsumer);
+
+        ASSERT_EQ(m_fdborch->m_entries.size(), 1);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 1);
+        ASSERT_TRUE(m_fdborch->m_pendingFdbState.empty());
+
+        ASSERT_EQ(recorder.batches.size(), 1);
+        ASSERT_EQ(recorder.batches[0].size(), 2);
+        ASSERT_EQ(recorder.batches[0][0].entry.mac, MacAddress("aa:bb:cc:dd:ee:01"));
+        ASSERT_FALSE(recorder.batches[0][0].add);
+        ASSERT_EQ(recorder.batches[0][1].entry.mac, MacAddress("aa:bb:cc:dd:ee:02"));
+        ASSERT_TRUE(recorder.batches[0][1].add);
+
+        m_fdborch->getFdbEvents().unsubscribe(&recorder);
+    }
+
+    /* FDB entries of an APP_FDB_TABLE batch are added and removed with one bulk call each */
+    TEST_F(FdbOrchTest, BulkAddRemoveFdbEntries)
+    {
+        _hook_sai_fdb_api();
+        // The bulker binds the SAI functions on construction
+        m_fdborch->m_fdbBulker = EntityBulker<sai_fdb_api_t>(sai_fdb_api, 1000);
+
+        setUpVlan(m_portsOrch.get());
+        setUpPort(m_portsOrch.get());
+        setUpVlanMember(m_portsOrch.get());
+        m_portsOrch->m_initDone = true;
+        g_sai_bulk_create_call_count = 0;
+        g_sai_bulk_remove_call_count = 0;
+
+        auto consumer = dynamic_cast<Consumer *>(m_fdborch->getExecutor(APP_FDB_TABLE_NAME));
+        ASSERT_NE(consumer, nullptr);
+
+        consumer->addToSync(std::deque<KeyOpFieldsValuesTuple>({
+            { VLAN40 ":52:54:00:ac:3a:01", SET_COMMAND, { { "port", ETH0 }, { "type", "dynamic" } } },
+            { VLAN40 ":52:54:00:ac:3a:02", SET_COMMAND, { { "port", ETH0 }, { "type", "static" } } },
+            /* Not a VLAN member yet, saved until it becomes one */
+            { VLAN40 ":52:54:00:ac:3a:03", SET_COMMAND, { { "port", "Ethernet4" }, { "type", "dynamic" } } }
+        }));
+        m_fdborch->doTask(*consumer);
+
+        ASSERT_EQ(g_sai_bulk_create_call_count, 1);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_EQ(m_fdborch->m_entries.size(), 2);
+        ASSERT_EQ(m_fdborch->saved_fdb_entries["Ethernet4"].size(), 1);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 2);
+        ASSERT_EQ(m_portsOrch->m_portList[VLAN40].m_fdb_count, 2);
+
+        consumer->addToSync(std::deque<KeyOpFieldsValuesTuple>({
+            { VLAN40 ":52:54:00:ac:3a:01", DEL_COMMAND, { } },
+            { VLAN40 ":52:54:00:ac:3a:02", DEL_COMMAND, { } },
+            { VLAN40 ":52:54:00:ac:3a:03", DEL_COMMAND, { } }
+        }));
+        m_fdborch->doTask(*consumer);
+
+        ASSERT_EQ(g_sai_bulk_remove_call_count, 1);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_TRUE(m_fdborch->m_entries.empty());
+        ASSERT_TRUE(m_fdborch->saved_fdb_entries["Ethernet4"].empty());
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 0);
+        ASSERT_EQ(m_portsOrch->m_portList[VLAN40].m_fdb_count, 0);
+
+        _unhook_sai_fdb_api();
+    }
+
+    /* Entries of a bridge port or VLAN are found through the indices and follow moves */
+    TEST(FdbRegistryTest, IndexesBridgePortAndVlan)
+    {
+        FdbRegistry registry;
+        FdbEntry a = { MacAddress("52:54:00:ac:3a:01"), 0x2600000000000001, ETH0 };
+        FdbEntry b = { MacAddress("52:54:00:ac:3a:02"), 0x2600000000000001, ETH0 };
+        FdbEntry c = { MacAddress("52:54:00:ac:3a:01"), 0x2600000000000002, ETH0 };
+        FdbData data = {};
+        data.bridge_port_id = 0x3a00000000000001;
+
+        registry.set(a, data);
+        registry.set(b, data);
+        registry.set(c, data);
+
+        ASSERT_EQ(registry.getBridgePortEntries(0x3a00000000000001).size(), 3);
+        ASSERT_EQ(registry.getBridgePortEntries(0x3a00000000000001, 0x2600000000000002).size(), 1);
+        ASSERT_EQ(registry.getBridgeEntries(0x2600000000000001).size(), 2);
+
+        /* MAC move */
+        data.bridge_port_id = 0x3a00000000000002;
+        registry.set(b, data);
+        ASSERT_EQ(registry.getBridgePortEntries(0x3a00000000000001).size(), 2);
+        ASSERT_EQ(registry.getBridgePortEntries(0x3a00000000000002).size(), 1);
+
+        ASSERT_EQ(registry.erase(a), 1);
+        ASSERT_EQ(registry.getBridgeEntries(0x2600000000000001).size(), 1);
+        ASSERT_EQ(registry.getBridgePortEntries(0x3a00000000000001).size(), 1);
+        ASSERT_EQ(registry.size(), 2);
+    }
+}
@@ -0,0 +1,243 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "fgnhgorch.h"
+#undef private
+#include "mock_orch_test.h"
+
+namespace fgnhgorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    static const string FG_PREFIX = "2.2.2.0/24";
+
+    sai_next_hop_group_api_t ut_sai_next_hop_group_api;
+    sai_next_hop_group_api_t *pold_sai_next_hop_group_api;
+
+    // Next hop each member points to, by member id
+    map<sai_object_id_t, sai_object_id_t> _ut_stub_member_next_hops;
+    // Next hop the SAI fails to point a member at
+    sai_object_id_t _ut_stub_failing_nh_id;
+    bool _ut_stub_bulk_supported;
+    uint32_t _ut_stub_set_calls;
+    uint32_t _ut_stub_bulk_set_calls;
+    uint32_t _ut_stub_bulk_set_objects;
+
+    sai_status_t _ut_stub_set_member(
+        _In_ sai_object_id_t member_id,
+        _In_ const sai_attribute_t *attr)
+    {
+        if (attr->id == SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID &&
+            attr->value.oid == _ut_stub_failing_nh_id)
+        {
+            return SAI_STATUS_TABLE_FULL;
+        }
+
+        _ut_stub_member_next_hops[member_id] = attr->value.oid;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_set_next_hop_group_member_attribute(
+        _In_ sai_object_id_t next_hop_group_member_id,
+        _In_ const sai_attribute_t *attr)
+    {
+        _ut_stub_set_calls++;
+        return _ut_stub_set_member(next_hop_group_member_id, attr);
+    }
+
+    sai_status_t _ut_stub_set_next_hop_group_members_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_set_calls++;
+        if (!_ut_stub_bulk_supported)
+        {
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+
+        _ut_stub_bulk_set_objects += object_count;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_set_member(object_id[i], &attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    class FgNhgOrchTest : public MockOrchTest
+    {
+    protected:
+        FgNhgEntry m_fgNhgEntry;
+        FGNextHopGroupEntry m_routeEntry;
+        vector<NextHopKey> m_nhs;
+        map<NextHopKey, sai_object_id_t> m_nhIds;
+
+        void PostSetUp() override
+        {
+            ut_sai_next_hop_group_api = *sai_next_hop_group_api;
+            pold_sai_next_hop_group_api = sai_next_hop_group_api;
+            ut_sai_next_hop_group_api.set_next_hop_group_member_attribute = _ut_stub_set_next_hop_group_member_attribute;
+            ut_sai_next_hop_group_api.set_next_hop_group_members_attribute = _ut_stub_set_next_hop_group_members_attribute;
+            sai_next_hop_group_api = &ut_sai_next_hop_group_api;
+
+            _ut_stub_member_next_hops.clear();
+            _ut_stub_failing_nh_id = SAI_NULL_OBJECT_ID;
+            _ut_stub_bulk_supported = true;
+            _ut_stub_set_calls = 0;
+            _ut_stub_bulk_set_calls = 0;
+            _ut_stub_bulk_set_objects = 0;
+
+            // One bank of 6 buckets, spread over 3 next hops with 2 buckets each
+            m_fgNhgEntry.fg_nhg_name = "fgnhg_v4";
+            m_fgNhgEntry.configured_bucket_size = 6;
+            m_fgNhgEntry.real_bucket_size = 6;
+            m_fgNhgEntry.hash_bucket_indices = { { 0, 5 } };
+            m_fgNhgEntry.match_mode = ROUTE_BASED;
+
+            m_routeEntry.next_hop_group_id = 0x5000;
+            m_routeEntry.points_to_rif = false;
+            m_routeEntry.syncd_fgnhg_map.resize(1);
+            for (uint32_t i = 0; i < 3; i++)
+            {
+                NextHopKey nh(IpAddress("10.0.0." + to_string(i + 1)), ETHERNET0);
+                m_nhs.push_back(nh);
+                m_nhIds[nh] = 0x1000 + i;
+                m_fgNhgEntry.next_hops[nh.ip_address] = { 0, "", false };
+                m_routeEntry.active_nexthops.insert(nh);
+            }
+            for (uint32_t bucket = 0; bucket < 6; bucket++)
+            {
+                const NextHopKey &nh = m_nhs[bucket / 2];
+                sai_object_id_t member_id = 0x2000 + bucket;
+                m_routeEntry.nhopgroup_members.push_back(member_id);
+                m_routeEntry.bucket_next_hops.push_back(m_nhIds[nh]);
+                m_routeEntry.syncd_fgnhg_map[0][nh].push_back(bucket);
+                _ut_stub_member_next_hops[member_id] = m_nhIds[nh];
+            }
+        }
+
+        void PreTearDown() override
+        {
+            sai_next_hop_group_api = pold_sai_next_hop_group_api;
+        }
+
+        // Takes the next hop out of the route, its buckets are spread over the other ones
+        bool removeNextHop(const NextHopKey &removed)
+        {
+            vector<BankMemberChanges> bank_member_changes(1);
+            map<NextHopKey, sai_object_id_t> nhopgroup_members_set;
+
+            for (const auto &nh : m_routeEntry.active_nexthops)
+            {
+                if (nh == removed)
+                {
+                    bank_member_changes[0].nhs_to_del.push_back(nh);
+                    continue;
+                }
+                bank_member_changes[0].active_nhs.push_back(nh);
+                nhopgroup_members_set[nh] = m_nhIds[nh];
+            }
+
+            return gFgNhgOrch->computeAndSetHashBucketChanges(&m_routeEntry, &m_fgNhgEntry,
+                    bank_member_changes, nhopgroup_members_set, IpPrefix(FG_PREFIX));
+        }
+
+        // Next hop the member of the bucket points to in the SAI
+        sai_object_id_t saiNextHop(HashBucketIdx bucket)
+        {
+            return _ut_stub_member_next_hops[m_routeEntry.nhopgroup_members[bucket]];
+        }
+
+        map<string, string> stateBuckets()
+        {
+            Table state_table(m_state_db.get(), STATE_FG_ROUTE_TABLE_NAME);
+            vector<FieldValueTuple> values;
+            state_table.get(FG_PREFIX, values);
+
+            map<string, string> buckets;
+            for (const auto &fv : values)
+            {
+                buckets[fvField(fv)] = fvValue(fv);
+            }
+            return buckets;
+        }
+    };
+
+    TEST_F(FgNhgOrchTest, RebalanceBulkSetFailedInTheMiddle)
+    {
+        // Buckets 2 and 3 of the second next hop go to the first and the third one
+        _ut_stub_failing_nh_id = m_nhIds[m_nhs[2]];
+
+        ASSERT_FALSE(removeNextHop(m_nhs[1]));
+
+        // Only the moved buckets go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_set_calls, 1);
+        ASSERT_EQ(_ut_stub_bulk_set_objects, 2);
+        ASSERT_EQ(_ut_stub_set_calls, 0);
+
+        // The buckets assigned to the other next hops are moved, tracked and recorded
+        auto &bank_map = m_routeEntry.syncd_fgnhg_map[0];
+        ASSERT_EQ(bank_map.count(m_nhs[1]), 0);
+        ASSERT_EQ(bank_map[m_nhs[0]], HashBuckets({ 0, 1, 2 }));
+        ASSERT_EQ(bank_map[m_nhs[2]], HashBuckets({ 4, 5, 3 }));
+        ASSERT_EQ(saiNextHop(2), m_nhIds[m_nhs[0]]);
+        ASSERT_EQ(m_routeEntry.bucket_next_hops[2], m_nhIds[m_nhs[0]]);
+
+        // The failed bucket still points to its old next hop and isn't recorded
+        ASSERT_EQ(saiNextHop(3), m_nhIds[m_nhs[1]]);
+        ASSERT_EQ(m_routeEntry.bucket_next_hops[3], m_nhIds[m_nhs[1]]);
+
+        auto state = stateBuckets();
+        ASSERT_EQ(state["2"], m_nhs[0].to_string());
+        ASSERT_EQ(state.count("3"), 0);
+
+        // The buckets that didn't move are left alone
+        for (HashBucketIdx bucket : { 0, 1, 4, 5 })
+        {
+            ASSERT_EQ(saiNextHop(bucket), m_routeEntry.bucket_next_hops[bucket]);
+        }
+        ASSERT_TRUE(gFgNhgOrch->m_hashBucketChanges.empty());
+    }
+
+    TEST_F(FgNhgOrchTest, RebalanceBulkNotSupportedFallsBackToSingleCalls)
+    {
+        _ut_stub_bulk_supported = false;
+        _ut_stub_failing_nh_id = m_nhIds[m_nhs[2]];
+
+        ASSERT_FALSE(removeNextHop(m_nhs[1]));
+
+        // Each moved bucket is set with its own call, with the same per bucket result
+        ASSERT_EQ(_ut_stub_bulk_set_calls, 1);
+        ASSERT_EQ(_ut_stub_set_calls, 2);
+        ASSERT_FALSE(gFgNhgOrch->m_hashBucketBulkSupported);
+
+        ASSERT_EQ(saiNextHop(2), m_nhIds[m_nhs[0]]);
+        ASSERT_EQ(m_routeEntry.bucket_next_hops[2], m_nhIds[m_nhs[0]]);
+        ASSERT_EQ(saiNextHop(3), m_nhIds[m_nhs[1]]);
+        ASSERT_EQ(m_routeEntry.bucket_next_hops[3], m_nhIds[m_nhs[1]]);
+        ASSERT_EQ(stateBuckets().count("3"), 0);
+
+        // Bulk set isn't tried again
+        _ut_stub_failing_nh_id = SAI_NULL_OBJECT_ID;
+        ASSERT_TRUE(removeNextHop(m_nhs[0]));
+        ASSERT_EQ(_ut_stub_bulk_set_calls, 1);
+        ASSERT_EQ(_ut_stub_set_calls, 5);
+        for (HashBucketIdx bucket : { 0, 1, 2 })
+        {
+            ASSERT_EQ(saiNextHop(bucket), m_nhIds[m_nhs[2]]);
+        }
+    }
+}
@@ -747,6 +747,24 @@ namespace flexcounter_test
                                           "SAI_QUEUE_STAT_BYTES,SAI_QUEUE_STAT_PACKETS"
                                          }
                                      }));
+
+        // Queue and PG counters of a port not in use are deregistered in oper up only mode,
+        // checkFlexCounter() without a field checks the counter is absent
+        gPortsOrch->m_portsInUse.erase(firstPortName);
+        gPortsOrch->setCountersOperUpOnly(true);
+        ASSERT_TRUE(checkFlexCounter(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP, queueOid));
+        ASSERT_TRUE(checkFlexCounter(QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, queueOid));
+        ASSERT_TRUE(checkFlexCounter(PG_DROP_STAT_COUNTER_FLEX_COUNTER_GROUP, pgOid));
+
+        // and registered again once the port comes up
+        gPortsOrch->updatePortInUse(firstPort, SAI_PORT_OPER_STATUS_UP);
+        gPortsOrch->flushCounters();
+        ASSERT_TRUE(gPortsOrch->isPortInUse(firstPortName));
+        ASSERT_TRUE(checkFlexCounter(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP, queueOid, QUEUE_COUNTER_ID_LIST));
+        ASSERT_TRUE(checkFlexCounter(QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, queueOid, QUEUE_COUNTER_ID_LIST));
+        ASSERT_TRUE(checkFlexCounter(PG_DROP_STAT_COUNTER_FLEX_COUNTER_GROUP, pgOid, PG_COUNTER_ID_LIST));
+        gPortsOrch->setCountersOperUpOnly(false);
+
         auto oid = firstPort.m_port_id;
         ASSERT_TRUE(checkFlexCounter(PORT_BUFFER_DROP_STAT_FLEX_COUNTER_GROUP, oid,
                                      {
@@ -1023,6 +1041,66 @@ namespace flexcounter_test
                 entries.clear();
                 static_cast<Orch *>(flexCounterOrch)->doTask();
                 ASSERT_EQ(flexCounterOrch->m_groupsWithBulkChunkSize.find("PORT"), flexCounterOrch->m_groupsWithBulkChunkSize.end());
+
+                // Verify the polling schedule: the budget stretches the poll intervals of the enabled groups
+                entries.push_back({"GLOBAL", "SET", {
+                            {"POLL_BUDGET", "1"}
+                        }});
+                entries.push_back({"PORT", "SET", {
+                            {"POLL_INTERVAL", "1000"},
+                            {"FLEX_COUNTER_STATUS", "enable"}
+                        }});
+                entries.push_back({"QUEUE", "SET", {
+                            {"POLL_INTERVAL", "1000"},
+                            {"FLEX_COUNTER_STATUS", "enable"}
+                        }});
+                consumer->addToSync(entries);
+                entries.clear();
+                static_cast<Orch *>(flexCounterOrch)->doTask();
+                ASSERT_EQ(flexCounterOrch->m_groupSchedules["PORT"].appliedInterval, 2000u);
+                ASSERT_EQ(flexCounterOrch->m_groupSchedules["QUEUE"].appliedInterval, 2000u);
+
+                // A phase offset defers the enable of the group
+                entries.push_back({"QUEUE", "SET", {
+                            {"POLL_INTERVAL", "1000"},
+                            {"FLEX_COUNTER_STATUS", "disable"}
+                        }});
+                consumer->addToSync(entries);
+                entries.clear();
+                static_cast<Orch *>(flexCounterOrch)->doTask();
+                ASSERT_EQ(flexCounterOrch->m_groupSchedules["PORT"].appliedInterval, 1000u);
+
+                entries.push_back({"QUEUE", "SET", {
+                            {"POLL_INTERVAL", "1000"},
+                            {"POLL_PHASE_OFFSET", "60000"},
+                            {"FLEX_COUNTER_STATUS", "enable"}
+                        }});
+                consumer->addToSync(entries);
+                entries.clear();
+                static_cast<Orch *>(flexCounterOrch)->doTask();
+                ASSERT_TRUE(flexCounterOrch->m_groupSchedules["QUEUE"].enablePending);
+                ASSERT_EQ(flexCounterOrch->m_groupSchedules["PORT"].appliedInterval, 2000u);
+
+                entries.push_back({"GLOBAL", "DEL", { {} }});
+                consumer->addToSync(entries);
+                entries.clear();
+                static_cast<Orch *>(flexCounterOrch)->doTask();
+                ASSERT_EQ(flexCounterOrch->m_groupSchedules["PORT"].appliedInterval, 1000u);
+                ASSERT_EQ(flexCounterOrch->m_groupSchedules["QUEUE"].appliedInterval, 1000u);
+
+                entries.push_back({"QUEUE", "SET", {
+                            {"FLEX_COUNTER_STATUS", "disable"}
+                        }});
+                consumer->addToSync(entries);
+                entries.clear();
+                static_cast<Orch *>(flexCounterOrch)->doTask();
+                entries.push_back({"QUEUE", "SET", {
+                            {"FLEX_COUNTER_STATUS", "enable"}
+                        }});
+                consumer->addToSync(entries);
+                entries.clear();
+                static_cast<Orch *>(flexCounterOrch)->doTask();
+                ASSERT_FALSE(flexCounterOrch->m_groupSchedules["QUEUE"].enablePending);
             }
         }
 
@@ -0,0 +1,137 @@
+#include "ut_helper.h"
+#include "flushpolicy.h"
+
+namespace flushpolicy_test
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    using Reason = FlushPolicy::Reason;
+
+    struct FlushPolicyTest : public ::testing::Test
+    {
+        FlushPolicy policy;
+        FlushPolicy::Clock::time_point t0;
+
+        void SetUp() override
+        {
+            t0 = FlushPolicy::Clock::now();
+            // Start a fresh interval at t0
+            policy.flushed(t0, Reason::FORCED);
+        }
+    };
+
+    TEST_F(FlushPolicyTest, FixedCadenceWithoutLatencyTarget)
+    {
+        policy.addOps(1000, t0);
+
+        ASSERT_FALSE(policy.isAdaptive());
+        ASSERT_EQ(policy.check(t0 + seconds(10)), Reason::NONE);
+        ASSERT_EQ(policy.timeout(t0, 1000), 1000);
+    }
+
+    TEST_F(FlushPolicyTest, FlushesFullBatch)
+    {
+        policy.configure(50, 100);
+
+        policy.addOps(99, t0);
+        ASSERT_EQ(policy.check(t0 + milliseconds(1)), Reason::NONE);
+
+        policy.addOps(1, t0 + milliseconds(1));
+        ASSERT_EQ(policy.check(t0 + milliseconds(1)), Reason::BATCH);
+    }
+
+    TEST_F(FlushPolicyTest, FlushesOnLatencyTarget)
+    {
+        policy.configure(50, 100);
+
+        policy.addOps(10, t0 + milliseconds(5));
+        // The deadline follows the oldest op, not the latest one
+        policy.addOps(10, t0 + milliseconds(40));
+
+        ASSERT_EQ(policy.check(t0 + milliseconds(54)), Reason::NONE);
+        ASSERT_EQ(policy.check(t0 + milliseconds(55)), Reason::LATENCY);
+    }
+
+    TEST_F(FlushPolicyTest, TimeoutWakesUpAtDeadline)
+    {
+        policy.configure(50, 100);
+
+        ASSERT_EQ(policy.timeout(t0, 1000), 1000);
+
+        policy.addOps(1, t0);
+        ASSERT_EQ(policy.timeout(t0 + milliseconds(20), 1000), 30);
+        ASSERT_EQ(policy.timeout(t0 + microseconds(20500), 1000), 30);
+        ASSERT_EQ(policy.timeout(t0 + milliseconds(20), 10), 10);
+        ASSERT_EQ(policy.timeout(t0 + milliseconds(60), 1000), 0);
+    }
+
+    TEST_F(FlushPolicyTest, IdleLoopFlushesSmallBatch)
+    {
+        policy.configure(50, 100);
+
+        // Mostly waiting for events
+        policy.recordWait(milliseconds(9));
+        policy.addOps(2, t0 + milliseconds(10));
+        ASSERT_EQ(policy.check(t0 + milliseconds(10)), Reason::IDLE);
+    }
+
+    TEST_F(FlushPolicyTest, BusyLoopHoldsSmallBatch)
+    {
+        policy.configure(50, 100);
+
+        policy.recordWait(milliseconds(1));
+        policy.addOps(2, t0 + milliseconds(10));
+        ASSERT_EQ(policy.check(t0 + milliseconds(10)), Reason::NONE);
+    }
+
+    TEST_F(FlushPolicyTest, IdleLoopHoldsBatchExpectedToFill)
+    {
+        policy.configure(50, 100);
+
+        // Learn a rate of 100 ops per 10 ms
+        for (int i = 1; i <= 20; i++)
+        {
+            policy.addOps(100, t0 + milliseconds(10 * i));
+            policy.flushed(t0 + milliseconds(10 * i), Reason::BATCH);
+        }
+        ASSERT_GT(policy.getOpsPerUsec(), 0.005);
+
+        auto t1 = t0 + milliseconds(200);
+        policy.recordWait(milliseconds(9));
+        policy.addOps(50, t1 + milliseconds(10));
+        ASSERT_EQ(policy.check(t1 + milliseconds(10)), Reason::NONE);
+    }
+
+    TEST_F(FlushPolicyTest, FlushResetsPendingOps)
+    {
+        policy.configure(50, 0);
+
+        policy.addOps(5, t0);
+        policy.flushed(t0 + milliseconds(1), Reason::LATENCY);
+
+        ASSERT_EQ(policy.getPendingOps(), 0);
+        ASSERT_EQ(policy.check(t0 + seconds(1)), Reason::NONE);
+        ASSERT_EQ(policy.timeout(t0 + milliseconds(1), 1000), 1000);
+    }
+
+    TEST_F(FlushPolicyTest, RecordsFlushStats)
+    {
+        auto stats = make_shared<FlushStats>();
+        policy.setStats(stats);
+        policy.configure(50, 100);
+
+        policy.addOps(100, t0 + milliseconds(2));
+        policy.flushed(t0 + milliseconds(4), Reason::BATCH);
+        policy.flushed(t0 + milliseconds(1004), Reason::PERIODIC);
+
+        ASSERT_EQ(stats->totalFlushes.load(), 2);
+        ASSERT_EQ(stats->totalBatch.load(), 1);
+        ASSERT_EQ(stats->totalPeriodic.load(), 1);
+        ASSERT_EQ(stats->flushOps.max(), 100);
+        ASSERT_EQ(stats->flushIntervalUsec.max(), 1000000);
+        // Only flushes with pending ops have a delay
+        ASSERT_EQ(stats->flushDelayUsec.count(), 1);
+        ASSERT_EQ(stats->flushDelayUsec.max(), 2000);
+    }
+}
@@ -0,0 +1,238 @@
+#include "ut_helpers_fpmsyncd.h"
+#include <gtest/gtest.h>
+#include "mock_table.h"
+#include "fpmsyncd/routesync.h"
+
+#include <swss/netdispatcher.h>
+#include <netlink/route/route.h>
+#include <netlink/route/nexthop.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+/*
+ * Netlink parser benchmarks of RouteSync, run with make bench_routesync.
+ *
+ * Every workload feeds the same RTM_NEWROUTE messages once through libnl, the
+ * way FpmLink dispatches them to onMsg(), and once through onRouteMsgRaw().
+ * The workloads are DISABLED_ tests so that make check skips them. Each one
+ * prints a JSON line per parser, and appends it to the file named by
+ * ROUTESYNC_BENCH_OUTPUT when set. The scale is read from the environment:
+ *  - ROUTESYNC_BENCH_ROUTES: routes per workload, 100000 by default
+ *  - ROUTESYNC_BENCH_FANOUT: next hops of each route, 4 by default
+ */
+
+/* Heap allocations of the whole test binary, sampled around each run */
+static std::atomic<uint64_t> g_benchAllocations{0};
+
+void* operator new(size_t size)
+{
+    g_benchAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace routesync_bench
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    static size_t benchParam(const char *name, size_t value)
+    {
+        const char *env = getenv(name);
+        if (env == nullptr || *env == '\0')
+        {
+            return value;
+        }
+        return static_cast<size_t>(strtoull(env, nullptr, 10));
+    }
+
+    static uint64_t peakRssKb()
+    {
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+        return static_cast<uint64_t>(usage.ru_maxrss);
+    }
+
+    class RouteSyncBench : public ::testing::Test
+    {
+    protected:
+        size_t m_routes = max<size_t>(benchParam("ROUTESYNC_BENCH_ROUTES", 100000), 1);
+        size_t m_fanout = min<size_t>(max<size_t>(benchParam("ROUTESYNC_BENCH_FANOUT", 4), 1), 64);
+
+        shared_ptr<DBConnector> m_db = make_shared<DBConnector>("APPL_DB", 0);
+        shared_ptr<RedisPipeline> m_pipeline = make_shared<RedisPipeline>(m_db.get());
+        RouteSync m_routeSync{m_pipeline.get()};
+
+        vector<nl_msg *> m_msgs;
+
+        void SetUp() override
+        {
+            struct stat st;
+            testing_db::reset();
+            if (stat(OverrideRtProtoPath, &st) == 0)
+            {
+                rtnl_route_read_protocol_names(OverrideRtProtoPath);
+            }
+            else
+            {
+                rtnl_route_read_protocol_names(DefaultRtProtoPath);
+            }
+            m_routeSync.setSuppressionEnabled(true);
+            NetDispatcher::getInstance().registerMessageHandler(RTM_NEWROUTE, &m_routeSync);
+        }
+
+        void TearDown() override
+        {
+            NetDispatcher::getInstance().unregisterMessageHandler(RTM_NEWROUTE);
+            for (auto msg : m_msgs)
+            {
+                nlmsg_free(msg);
+            }
+            testing_db::reset();
+        }
+
+        static nl_addr *parseAddr(const string &addr, int family)
+        {
+            nl_addr *parsed = nullptr;
+            nl_addr_parse(addr.c_str(), family, &parsed);
+            return parsed;
+        }
+
+        /* Adds the RTM_NEWROUTE zebra would send for a route through m_fanout next hops */
+        void addRouteMsg(const string &prefix, int family, uint32_t table, const string &gw_prefix)
+        {
+            rtnl_route *route = rtnl_route_alloc();
+            nl_addr *dst = parseAddr(prefix, family);
+            rtnl_route_set_dst(route, dst);
+            nl_addr_put(dst);
+            rtnl_route_set_type(route, RTN_UNICAST);
+            rtnl_route_set_protocol(route, RTPROT_BGP);
+            rtnl_route_set_family(route, static_cast<uint8_t>(family));
+            rtnl_route_set_scope(route, RT_SCOPE_UNIVERSE);
+            rtnl_route_set_table(route, table);
+
+            for (size_t i = 0; i < m_fanout; i++)
+            {
+                rtnl_nexthop *nh = rtnl_route_nh_alloc();
+                nl_addr *gw = parseAddr(gw_prefix + to_string(i + 2), family);
+                rtnl_route_nh_set_gateway(nh, gw);
+                nl_addr_put(gw);
+                rtnl_route_nh_set_ifindex(nh, static_cast<int>(i + 2));
+                rtnl_route_add_nexthop(route, nh);
+            }
+
+            nl_msg *msg = nullptr;
+            ASSERT_EQ(rtnl_route_build_add_request(route, 0, &msg), 0);
+            m_msgs.push_back(msg);
+            rtnl_route_put(route);
+        }
+
+        void report(const string &workload, const string &parser, double elapsedUsec, uint64_t allocations)
+        {
+            size_t routes = m_msgs.size();
+
+            stringstream line;
+            line << "{\"workload\": \"" << workload << "\""
+                 << ", \"parser\": \"" << parser << "\""
+                 << ", \"routes\": " << routes
+                 << ", \"fanout\": " << m_fanout
+                 << ", \"routes_per_sec\": " << (elapsedUsec > 0 ? static_cast<double>(routes) * 1e6 / elapsedUsec : 0)
+                 << ", \"peak_rss_kb\": " << peakRssKb()
+                 << ", \"allocs_per_route\": " << (routes ? static_cast<double>(allocations) / static_cast<double>(routes) : 0)
+                 << "}";
+
+            cout << line.str() << endl;
+
+            const char *output = getenv("ROUTESYNC_BENCH_OUTPUT");
+            if (output != nullptr && *output != '\0')
+            {
+                ofstream out(output, ios::app);
+                out << line.str() << endl;
+            }
+        }
+
+        /* Publishes m_msgs through both parsers, starting from an empty APPL_DB each time */
+        void run(const string &workload)
+        {
+            testing_db::reset();
+            uint64_t allocations = g_benchAllocations.load(memory_order_relaxed);
+            auto start = steady_clock::now();
+            for (auto msg : m_msgs)
+            {
+                /* Same steps as FpmLink::processFpmMessage() */
+                nl_msg *conv = nlmsg_convert(nlmsg_hdr(msg));
+                nlmsg_set_proto(conv, NETLINK_ROUTE);
+                NetDispatcher::getInstance().onNetlinkMessage(conv);
+                nlmsg_free(conv);
+            }
+            double elapsedUsec = static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - start).count()) / 1e3;
+            report(workload, "libnl", elapsedUsec, g_benchAllocations.load(memory_order_relaxed) - allocations);
+
+            testing_db::reset();
+            allocations = g_benchAllocations.load(memory_order_relaxed);
+            start = steady_clock::now();
+            for (auto msg : m_msgs)
+            {
+                ASSERT_TRUE(m_routeSync.onRouteMsgRaw(nlmsg_hdr(msg)));
+            }
+            elapsedUsec = static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - start).count()) / 1e3;
+            report(workload, "raw", elapsedUsec, g_benchAllocations.load(memory_order_relaxed) - allocations);
+        }
+    };
+
+    TEST_F(RouteSyncBench, DISABLED_Ipv4Routes)
+    {
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            string prefix = to_string(100 + (i >> 16)) + "." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + ".0/24";
+            addRouteMsg(prefix, AF_INET, 0, "10.0.0.");
+        }
+        run("ipv4");
+    }
+
+    TEST_F(RouteSyncBench, DISABLED_Ipv6Routes)
+    {
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            stringstream prefix;
+            prefix << "2001:db8:" << hex << (i >> 16) << ":" << (i & 0xffff) << "::/64";
+            addRouteMsg(prefix.str(), AF_INET6, 0, "fc00::");
+        }
+        run("ipv6");
+    }
+
+    TEST_F(RouteSyncBench, DISABLED_VrfRoutes)
+    {
+        /* Table 10 is Vrf10 in the mocked link cache */
+        for (size_t i = 0; i < m_routes; i++)
+        {
+            string prefix = to_string(100 + (i >> 16)) + "." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + ".0/24";
+            addRouteMsg(prefix, AF_INET, 10, "10.0.0.");
+        }
+        run("vrf");
+    }
+}
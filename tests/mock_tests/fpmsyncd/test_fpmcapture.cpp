@@ -0,0 +1,69 @@
+#include "fpmsyncd/fpmcapture.h"
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+using namespace std;
+using namespace swss;
+
+namespace fpmcapture_test
+{
+    static vector<char> fpmMsg(size_t dataLen, char fill)
+    {
+        size_t len = fpm_data_len_to_msg_len(dataLen);
+        vector<char> msg(len, fill);
+        auto hdr = reinterpret_cast<fpm_msg_hdr_t *>(msg.data());
+        hdr->version = FPM_PROTO_VERSION;
+        hdr->msg_type = FPM_MSG_TYPE_NETLINK;
+        hdr->msg_len = htons(static_cast<uint16_t>(len));
+        return msg;
+    }
+
+    struct FpmCaptureTest : public ::testing::Test
+    {
+        string path = "/tmp/fpmcapture_ut_" + to_string(getpid());
+
+        void TearDown() override
+        {
+            unlink(path.c_str());
+        }
+    };
+
+    TEST_F(FpmCaptureTest, ReadsBackWhatWasWritten)
+    {
+        auto first = fpmMsg(16, 'a');
+        auto second = fpmMsg(100, 'b');
+
+        FpmCaptureWriter writer;
+        writer.open(path);
+        writer.write(reinterpret_cast<const fpm_msg_hdr_t *>(first.data()));
+        writer.write(reinterpret_cast<const fpm_msg_hdr_t *>(second.data()));
+        ASSERT_EQ(writer.getCount(), 2u);
+        writer.close();
+
+        FpmCaptureReader reader;
+        reader.open(path);
+
+        fpm_capture_rec_hdr_t first_rec, second_rec, rec;
+        vector<char> msg;
+        ASSERT_TRUE(reader.next(first_rec, msg));
+        ASSERT_EQ(msg, first);
+        ASSERT_TRUE(reader.next(second_rec, msg));
+        ASSERT_EQ(msg, second);
+        ASSERT_LE(first_rec.time_usec, second_rec.time_usec);
+        ASSERT_FALSE(reader.next(rec, msg));
+    }
+
+    TEST_F(FpmCaptureTest, RejectsOtherFiles)
+    {
+        ofstream(path) << "not a capture";
+
+        FpmCaptureReader reader;
+        ASSERT_THROW(reader.open(path), system_error);
+    }
+}
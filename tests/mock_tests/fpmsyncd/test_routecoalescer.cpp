@@ -0,0 +1,110 @@
+#include "fpmsyncd/routecoalescer.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+using namespace std;
+using namespace std::chrono;
+using namespace swss;
+
+namespace routecoalescer_test
+{
+    struct RouteCoalescerTest : public ::testing::Test
+    {
+        RouteCoalescer coalescer;
+        RouteCoalescer::Clock::time_point t0 = RouteCoalescer::Clock::now();
+
+        /* Key to the protocol of its SET, "DEL" for a DEL */
+        map<string, string> written;
+
+        static vector<KeyOpFieldsValuesTuple> routeSet(const string &key, const string &protocol)
+        {
+            vector<FieldValueTuple> fvs{{"protocol", protocol}};
+            return { KeyOpFieldsValuesTuple(key, "SET", fvs) };
+        }
+
+        size_t flush(RouteCoalescer::Clock::time_point now, bool force = false)
+        {
+            return coalescer.flush(now, force, [this](const string &key, vector<KeyOpFieldsValuesTuple> &kfvs)
+            {
+                written[key] = kfvs.empty() ? "DEL" : fvValue(kfvFieldsValues(kfvs.back())[0]);
+            });
+        }
+    };
+
+    TEST_F(RouteCoalescerTest, DisabledByDefault)
+    {
+        ASSERT_FALSE(coalescer.isEnabled());
+        ASSERT_EQ(coalescer.timeout(t0), -1);
+
+        coalescer.configure(10, 0);
+        ASSERT_TRUE(coalescer.isEnabled());
+        ASSERT_EQ(coalescer.getMaxDelayMsec(), 10 * RouteCoalescer::DEFAULT_MAX_DELAY_WINDOWS);
+    }
+
+    TEST_F(RouteCoalescerTest, WritesFinalStateOnly)
+    {
+        coalescer.configure(10, 100);
+
+        coalescer.set("10.0.0.0/24", routeSet("10.0.0.0/24", "bgp"), t0);
+        coalescer.del("10.0.0.0/24", t0 + milliseconds(2));
+        coalescer.set("10.0.0.0/24", routeSet("10.0.0.0/24", "static"), t0 + milliseconds(4));
+        coalescer.del("10.1.0.0/24", t0 + milliseconds(4));
+
+        ASSERT_EQ(flush(t0 + milliseconds(13)), 0u);
+        ASSERT_EQ(coalescer.timeout(t0 + milliseconds(13)), 1);
+
+        ASSERT_EQ(flush(t0 + milliseconds(14)), 2u);
+        ASSERT_EQ(written["10.0.0.0/24"], "static");
+        ASSERT_EQ(written["10.1.0.0/24"], "DEL");
+        ASSERT_EQ(coalescer.size(), 0u);
+        ASSERT_EQ(coalescer.timeout(t0 + milliseconds(14)), -1);
+
+        const auto &stats = coalescer.getStats();
+        ASSERT_EQ(stats.held, 4u);
+        ASSERT_EQ(stats.coalesced, 2u);
+        ASSERT_EQ(stats.written, 2u);
+        ASSERT_EQ(stats.maxHoldUsec, 14000u);
+    }
+
+    TEST_F(RouteCoalescerTest, MaxDelayBoundsChurningKey)
+    {
+        coalescer.configure(10, 30);
+
+        // An update every 5 ms keeps the window from expiring
+        for (int i = 0; i <= 6; i++)
+        {
+            coalescer.set("10.0.0.0/24", routeSet("10.0.0.0/24", to_string(i)), t0 + milliseconds(5 * i));
+            flush(t0 + milliseconds(5 * i));
+        }
+
+        ASSERT_EQ(written["10.0.0.0/24"], "6");
+        ASSERT_EQ(coalescer.getStats().maxDelayWrites, 1u);
+        ASSERT_EQ(coalescer.size(), 0u);
+    }
+
+    TEST_F(RouteCoalescerTest, TimeoutFollowsNextDueKey)
+    {
+        coalescer.configure(10, 100);
+
+        coalescer.set("10.0.0.0/24", routeSet("10.0.0.0/24", "bgp"), t0);
+        ASSERT_EQ(coalescer.timeout(t0 + milliseconds(4)), 6);
+        ASSERT_EQ(coalescer.timeout(t0 + microseconds(4500)), 6);
+    }
+
+    TEST_F(RouteCoalescerTest, ForceWritesEverything)
+    {
+        coalescer.configure(50, 0);
+
+        coalescer.set("10.0.0.0/24", routeSet("10.0.0.0/24", "bgp"), t0);
+        coalescer.del("10.1.0.0/24", t0);
+
+        ASSERT_EQ(flush(t0, true), 2u);
+        ASSERT_EQ(written.size(), 2u);
+        ASSERT_EQ(coalescer.size(), 0u);
+
+        // Nothing is left to write once the window expires
+        ASSERT_EQ(flush(t0 + seconds(1)), 0u);
+    }
+}
@@ -0,0 +1,82 @@
+#include "fpmsyncd/routeoffloadtracker.h"
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace swss;
+
+namespace routeoffloadtracker_test
+{
+    TEST(RouteOffloadTracker, KeepsFirstUpdateOfWaitingRoute)
+    {
+        RouteOffloadTracker tracker;
+        auto t0 = RouteOffloadTracker::Clock::now();
+
+        tracker.add("10.0.0.0/24", t0);
+        tracker.add("10.0.0.0/24", t0 + milliseconds(5));
+        tracker.add("Vrf10:10.0.0.0/24", t0);
+        ASSERT_EQ(tracker.size(), 2u);
+
+        ASSERT_TRUE(tracker.complete("10.0.0.0/24", t0 + milliseconds(8)));
+        ASSERT_FALSE(tracker.complete("10.0.0.0/24", t0 + milliseconds(9)));
+
+        auto latency = tracker.getLatency();
+        ASSERT_EQ(latency.count, 1u);
+        ASSERT_EQ(latency.inFlight, 1u);
+        ASSERT_EQ(latency.maxUsec, 8000u);
+    }
+
+    TEST(RouteOffloadTracker, DeletedRouteIsNotWaiting)
+    {
+        RouteOffloadTracker tracker;
+        auto t0 = RouteOffloadTracker::Clock::now();
+
+        tracker.add("10.0.0.0/24", t0);
+        tracker.remove("10.0.0.0/24");
+
+        ASSERT_FALSE(tracker.complete("10.0.0.0/24", t0));
+        ASSERT_EQ(tracker.getLatency().count, 0u);
+        ASSERT_EQ(tracker.getLatency().p99Usec, 0u);
+    }
+
+    TEST(RouteOffloadTracker, Percentiles)
+    {
+        RouteOffloadTracker tracker;
+        auto t0 = RouteOffloadTracker::Clock::now();
+
+        // 1 ms to 100 ms
+        for (int i = 1; i <= 100; i++)
+        {
+            string key = "10.0." + to_string(i) + ".0/24";
+            tracker.add(key, t0);
+            tracker.complete(key, t0 + milliseconds(i));
+        }
+
+        auto latency = tracker.getLatency();
+        ASSERT_EQ(latency.count, 100u);
+        ASSERT_EQ(latency.p50Usec, 50000u);
+        ASSERT_EQ(latency.p90Usec, 90000u);
+        ASSERT_EQ(latency.p99Usec, 99000u);
+        ASSERT_EQ(latency.maxUsec, 100000u);
+    }
+
+    TEST(RouteOffloadTracker, PercentilesFollowLatestSamples)
+    {
+        RouteOffloadTracker tracker;
+        auto t0 = RouteOffloadTracker::Clock::now();
+
+        tracker.add("10.0.0.0/24", t0);
+        tracker.complete("10.0.0.0/24", t0 + seconds(10));
+
+        for (size_t i = 0; i < RouteOffloadTracker::LATENCY_SAMPLES; i++)
+        {
+            tracker.add("10.0.0.0/24", t0);
+            tracker.complete("10.0.0.0/24", t0 + milliseconds(1));
+        }
+
+        auto latency = tracker.getLatency();
+        ASSERT_EQ(latency.count, RouteOffloadTracker::LATENCY_SAMPLES + 1);
+        ASSERT_EQ(latency.maxUsec, 1000u);
+    }
+}
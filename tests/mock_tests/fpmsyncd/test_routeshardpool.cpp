@@ -0,0 +1,67 @@
+#include "fpmsyncd/routeshardpool.h"
+#include "mock_table.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+using namespace std;
+using namespace swss;
+
+namespace routeshardpool_test
+{
+    static vector<KeyOpFieldsValuesTuple> routeSet(const string &key, const string &nexthop)
+    {
+        vector<FieldValueTuple> fvs{{"nexthop", nexthop}};
+        return { KeyOpFieldsValuesTuple(key, "SET", fvs) };
+    }
+
+    TEST(RouteShardPool, ShardOfIsStableAndInRange)
+    {
+        set<size_t> shards;
+        for (int i = 0; i < 256; i++)
+        {
+            string key = "Vrf" + to_string(i) + ":10.0.0.0/24";
+            size_t shard = RouteShardPool::shardOf(key, 4);
+            ASSERT_LT(shard, 4u);
+            ASSERT_EQ(shard, RouteShardPool::shardOf(key, 4));
+            shards.insert(shard);
+        }
+        ASSERT_EQ(shards.size(), 4u);
+    }
+
+    TEST(RouteShardPool, WritesInOrderPerKey)
+    {
+        testing_db::reset();
+
+        DBConnector db("APPL_DB", 0);
+        Table routeTable(&db, "ROUTE_TABLE");
+
+        /* A single shard, the mock tables are not thread safe */
+        {
+            RouteShardPool pool(1, "ROUTE_TABLE");
+            ASSERT_EQ(pool.size(), 1u);
+
+            pool.set("10.0.0.0/24", routeSet("10.0.0.0/24", "10.1.0.1"));
+            pool.set("10.0.0.0/24", routeSet("10.0.0.0/24", "10.1.0.2"));
+            pool.set("10.0.1.0/24", routeSet("10.0.1.0/24", "10.1.0.1"));
+            pool.del("10.0.1.0/24");
+            pool.drain();
+
+            ASSERT_EQ(pool.getWritten(), 4u);
+
+            string nexthop;
+            ASSERT_TRUE(routeTable.hget("10.0.0.0/24", "nexthop", nexthop));
+            ASSERT_EQ(nexthop, "10.1.0.2");
+            vector<FieldValueTuple> fvs;
+            ASSERT_FALSE(routeTable.get("10.0.1.0/24", fvs));
+
+            /* Still written when the pool goes away */
+            pool.set("10.0.2.0/24", routeSet("10.0.2.0/24", "10.1.0.3"));
+        }
+
+        string nexthop;
+        ASSERT_TRUE(routeTable.hget("10.0.2.0/24", "nexthop", nexthop));
+        ASSERT_EQ(nexthop, "10.1.0.3");
+    }
+}
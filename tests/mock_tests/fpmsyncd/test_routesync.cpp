@@ -2950,4 +2950,202 @@ TEST_F(FpmSyncdResponseTest, TestVnetRouteMsgWithZmqDisabled_OnlyNonEmptyFields)
     EXPECT_EQ(fieldMap["nexthop"], "0.0.0.0");
 
     rtnl_route_put(test_route);
-}
\ No newline at end of file
+}
+/* Publishes route through onMsg() and through onRouteMsgRaw(), expecting the same APPL_DB entry */
+static void expectRawRouteMatchesLibnl(RouteSync& sync, DBConnector* db, rtnl_route* route, const string& key)
+{
+    Table route_table(db, APP_ROUTE_TABLE_NAME);
+
+    nl_msg* msg = nullptr;
+    ASSERT_EQ(rtnl_route_build_add_request(route, 0, &msg), 0);
+    auto nlMsg = unique_ptr<nl_msg, decltype(nlmsg_free)*>(msg, nlmsg_free);
+
+    vector<FieldValueTuple> libnl_fvs;
+    sync.onMsg(RTM_NEWROUTE, (nl_object*)route);
+    ASSERT_TRUE(route_table.get(key, libnl_fvs));
+    route_table.del(key);
+
+    vector<FieldValueTuple> raw_fvs;
+    ASSERT_TRUE(sync.onRouteMsgRaw(nlmsg_hdr(nlMsg.get())));
+    ASSERT_TRUE(route_table.get(key, raw_fvs));
+    EXPECT_EQ(raw_fvs, libnl_fvs);
+}
+
+TEST_F(FpmSyncdResponseTest, TestRawRouteMsgMatchesLibnl)
+{
+    // ECMP route with weights
+    auto ecmp_route = create_route("10.2.0.0/16");
+    rtnl_route_set_table(ecmp_route.get(), 0);
+    rtnl_nexthop* nh1 = create_nexthop(test_gateway);
+    rtnl_nexthop* nh2 = create_nexthop(test_gateway_);
+    rtnl_route_nh_set_weight(nh2, 3);
+    rtnl_route_add_nexthop(ecmp_route.get(), nh1);
+    rtnl_route_add_nexthop(ecmp_route.get(), nh2);
+    expectRawRouteMatchesLibnl(m_routeSync, m_db.get(), ecmp_route.get(), "10.2.0.0/16");
+
+    // Single path VRF route
+    auto vrf_route = create_route("10.3.0.1");
+    rtnl_route_set_table(vrf_route.get(), 10);
+    rtnl_route_add_nexthop(vrf_route.get(), create_nexthop(test_gateway__));
+    expectRawRouteMatchesLibnl(m_routeSync, m_db.get(), vrf_route.get(), "Vrf10:10.3.0.1");
+
+    // IPv6 route
+    nl_addr* dst_addr;
+    nl_addr_parse("2001:db8::/64", AF_INET6, &dst_addr);
+    auto v6_route = unique_ptr<rtnl_route, decltype(rtnl_route_put)*>(rtnl_route_alloc(), rtnl_route_put);
+    rtnl_route_set_dst(v6_route.get(), dst_addr);
+    nl_addr_put(dst_addr);
+    rtnl_route_set_type(v6_route.get(), RTN_UNICAST);
+    rtnl_route_set_protocol(v6_route.get(), RTPROT_BGP);
+    rtnl_route_set_family(v6_route.get(), AF_INET6);
+    rtnl_route_set_table(v6_route.get(), 0);
+    rtnl_nexthop* nh6 = rtnl_route_nh_alloc();
+    nl_addr* gw_addr;
+    nl_addr_parse("fe80::1", AF_INET6, &gw_addr);
+    rtnl_route_nh_set_gateway(nh6, gw_addr);
+    nl_addr_put(gw_addr);
+    rtnl_route_nh_set_ifindex(nh6, 5);
+    rtnl_route_add_nexthop(v6_route.get(), nh6);
+    expectRawRouteMatchesLibnl(m_routeSync, m_db.get(), v6_route.get(), "2001:db8::/64");
+
+    // Blackhole route
+    auto blackhole_route = create_route("10.4.0.0/24");
+    rtnl_route_set_table(blackhole_route.get(), 0);
+    rtnl_route_set_type(blackhole_route.get(), RTN_BLACKHOLE);
+    expectRawRouteMatchesLibnl(m_routeSync, m_db.get(), blackhole_route.get(), "10.4.0.0/24");
+
+    // Delete
+    nl_msg* msg = nullptr;
+    ASSERT_EQ(rtnl_route_build_del_request(ecmp_route.get(), 0, &msg), 0);
+    auto del_msg = unique_ptr<nl_msg, decltype(nlmsg_free)*>(msg, nlmsg_free);
+    EXPECT_TRUE(m_routeSync.onRouteMsgRaw(nlmsg_hdr(del_msg.get())));
+
+    Table route_table(m_db.get(), APP_ROUTE_TABLE_NAME);
+    vector<FieldValueTuple> fvs;
+    EXPECT_FALSE(route_table.get("10.2.0.0/16", fvs));
+}
+
+TEST_F(FpmSyncdResponseTest, TestRawRouteMsgLeavesOtherRoutesToLibnl)
+{
+    Table route_table(m_db.get(), APP_ROUTE_TABLE_NAME);
+    vector<string> keys;
+
+    // Invalid VRF name
+    auto route = create_route("10.5.0.0/24");
+    rtnl_route_set_table(route.get(), 30);
+    rtnl_route_add_nexthop(route.get(), create_nexthop(test_gateway));
+
+    nl_msg* msg = nullptr;
+    ASSERT_EQ(rtnl_route_build_add_request(route.get(), 0, &msg), 0);
+    auto nlMsg = unique_ptr<nl_msg, decltype(nlmsg_free)*>(msg, nlmsg_free);
+    EXPECT_FALSE(m_routeSync.onRouteMsgRaw(nlmsg_hdr(nlMsg.get())));
+
+    // No next hop
+    auto no_nh_route = create_route("10.6.0.0/24");
+    rtnl_route_set_table(no_nh_route.get(), 0);
+    msg = nullptr;
+    ASSERT_EQ(rtnl_route_build_add_request(no_nh_route.get(), 0, &msg), 0);
+    auto no_nh_msg = unique_ptr<nl_msg, decltype(nlmsg_free)*>(msg, nlmsg_free);
+    EXPECT_FALSE(m_routeSync.onRouteMsgRaw(nlmsg_hdr(no_nh_msg.get())));
+
+    route_table.getKeys(keys);
+    EXPECT_TRUE(keys.empty());
+}
+
+TEST_F(FpmSyncdResponseTest, RouteResponseCompletesInFlightRoute)
+{
+    auto route = create_route("10.7.0.0/24");
+    rtnl_route_set_table(route.get(), 0);
+    rtnl_route_add_nexthop(route.get(), create_nexthop(test_gateway));
+
+    nl_msg* msg = nullptr;
+    ASSERT_EQ(rtnl_route_build_add_request(route.get(), 0, &msg), 0);
+    auto nlMsg = unique_ptr<nl_msg, decltype(nlmsg_free)*>(msg, nlmsg_free);
+    ASSERT_TRUE(m_routeSync.onRouteMsgRaw(nlmsg_hdr(nlMsg.get())));
+    ASSERT_EQ(m_routeSync.getOffloadTracker().size(), 1u);
+
+    EXPECT_CALL(m_mockFpm, send(_)).WillOnce(Return(true));
+
+    m_routeSync.onRouteResponse("10.7.0.0/24", {
+        {"err_str", "SWSS_RC_SUCCESS"},
+        {"protocol", "bgp"},
+    });
+
+    ASSERT_EQ(m_routeSync.getOffloadTracker().size(), 0u);
+    ASSERT_EQ(m_routeSync.getOffloadTracker().getLatency().count, 1u);
+}
+
+TEST_F(FpmSyncdResponseTest, RouteResponsesBatchOffloadReplies)
+{
+    int sent = 0;
+    EXPECT_CALL(m_mockFpm, send(_)).Times(2).WillRepeatedly([&](nlmsghdr* hdr) -> bool {
+        rtnl_route* routeObject{};
+
+        rtnl_route_parse(hdr, &routeObject);
+
+        // Offload flag is set
+        EXPECT_EQ(rtnl_route_get_flags(routeObject) & RTM_F_OFFLOAD, RTM_F_OFFLOAD);
+
+        sent++;
+        return true;
+    });
+
+    m_routeSync.beginOffloadReplies();
+    m_routeSync.onRouteResponse("1.0.0.0/24", {
+        {"err_str", "SWSS_RC_SUCCESS"},
+        {"protocol", "kernel"},
+    });
+    m_routeSync.onRouteResponse("1::/64", {
+        {"err_str", "SWSS_RC_SUCCESS"},
+        {"protocol", "kernel"},
+    });
+
+    // Nothing goes to zebra until the batch is flushed
+    ASSERT_EQ(sent, 0);
+
+    m_routeSync.flushOffloadReplies();
+    ASSERT_EQ(sent, 2);
+}
+
+TEST_F(FpmSyncdResponseTest, LinkEventsUpdateLinkNames)
+{
+    char if_name[IFNAMSIZ];
+
+    // Not known to the mocked link cache
+    ASSERT_FALSE(m_routeSync.getIfName(77, if_name, IFNAMSIZ));
+    ASSERT_TRUE(m_routeSync.m_linkNames.isMissing(77));
+
+    auto link = unique_ptr<rtnl_link, decltype(rtnl_link_put)*>(rtnl_link_alloc(), rtnl_link_put);
+    rtnl_link_set_ifindex(link.get(), 77);
+    rtnl_link_set_name(link.get(), "Vrf77");
+
+    m_routeSync.onMsg(RTM_NEWLINK, (nl_object*)link.get());
+    ASSERT_FALSE(m_routeSync.m_linkNames.isMissing(77));
+    ASSERT_TRUE(m_routeSync.getIfName(77, if_name, IFNAMSIZ));
+    ASSERT_STREQ(if_name, "Vrf77");
+
+    // Renamed
+    rtnl_link_set_name(link.get(), "Vrf78");
+    m_routeSync.onMsg(RTM_NEWLINK, (nl_object*)link.get());
+    ASSERT_TRUE(m_routeSync.getIfName(77, if_name, IFNAMSIZ));
+    ASSERT_STREQ(if_name, "Vrf78");
+    ASSERT_EQ(m_routeSync.m_linkNames.getIndex("Vrf77"), 0);
+    ASSERT_EQ(m_routeSync.m_linkNames.getIndex("Vrf78"), 77);
+
+    m_routeSync.onMsg(RTM_DELLINK, (nl_object*)link.get());
+    ASSERT_FALSE(m_routeSync.getIfName(77, if_name, IFNAMSIZ));
+}
+
+TEST_F(FpmSyncdResponseTest, LinkNamesServeRepeatedLookups)
+{
+    char if_name[IFNAMSIZ];
+
+    // Resolved once through the mocked link cache, then from the table
+    ASSERT_TRUE(m_routeSync.getIfName(10, if_name, IFNAMSIZ));
+    ASSERT_STREQ(if_name, "Vrf10");
+    ASSERT_NE(m_routeSync.m_linkNames.getName(10), nullptr);
+    ASSERT_EQ(*m_routeSync.m_linkNames.getName(10), "Vrf10");
+
+    ASSERT_TRUE(m_routeSync.getIfName(10, if_name, IFNAMSIZ));
+    ASSERT_STREQ(if_name, "Vrf10");
+}
@@ -0,0 +1,95 @@
+#include "gearboxutils.h"
+#include "mock_table.h"
+
+#include <gtest/gtest.h>
+
+namespace gearboxutils_test
+{
+    using namespace std;
+    using namespace swss;
+
+    struct GearboxUtilsTest : public ::testing::Test
+    {
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+        }
+
+        virtual void TearDown() override
+        {
+            ::testing_db::reset();
+        }
+
+        void setPhy(Table &table, int phy_id, const string &name)
+        {
+            table.set("phy:" + to_string(phy_id), { { "phy_id", to_string(phy_id) }, { "name", name } });
+        }
+
+        void setConfigDone(Table &table, const string &generation)
+        {
+            table.set("GearboxConfigDone", { { "success", "1" }, { "generation", generation } });
+        }
+    };
+
+    TEST_F(GearboxUtilsTest, CacheFollowsTableVersion)
+    {
+        DBConnector appl_db("APPL_DB", 0);
+        Table table(&appl_db, "_GEARBOX_TABLE");
+        GearboxUtils gearbox;
+
+        setPhy(table, 1, "phy1");
+        setConfigDone(table, "1");
+
+        auto phys = gearbox.loadPhyMap(&table);
+        ASSERT_EQ(phys.size(), 1);
+        ASSERT_EQ(phys[1].name, "phy1");
+
+        // A field written in place is served from the cache until invalidated
+        table.hset("phy:1", "name", "phy1-renamed");
+        ASSERT_EQ(gearbox.loadPhyMap(&table)[1].name, "phy1");
+        gearbox.invalidate();
+        ASSERT_EQ(gearbox.loadPhyMap(&table)[1].name, "phy1-renamed");
+
+        // A new entry changes the keys of the table
+        setPhy(table, 2, "phy2");
+        phys = gearbox.loadPhyMap(&table);
+        ASSERT_EQ(phys.size(), 2);
+        ASSERT_EQ(phys[2].name, "phy2");
+
+        // A new sync changes the generation of GearboxConfigDone
+        setPhy(table, 2, "phy2-resynced");
+        ASSERT_EQ(gearbox.loadPhyMap(&table)[2].name, "phy2");
+        setConfigDone(table, "2");
+        ASSERT_EQ(gearbox.loadPhyMap(&table)[2].name, "phy2-resynced");
+
+        // A removed entry changes the keys of the table
+        table.del("phy:1");
+        phys = gearbox.loadPhyMap(&table);
+        ASSERT_EQ(phys.size(), 1);
+        ASSERT_EQ(phys.count(1), 0);
+    }
+
+    TEST_F(GearboxUtilsTest, CacheIsKeyedOnTableNotAddress)
+    {
+        DBConnector appl_db("APPL_DB", 0);
+        GearboxUtils gearbox;
+
+        {
+            Table table(&appl_db, "_GEARBOX_TABLE");
+            setPhy(table, 1, "phy1");
+            setConfigDone(table, "1");
+            ASSERT_EQ(gearbox.loadPhyMap(&table)[1].name, "phy1");
+        }
+
+        // Another table object at possibly the same address sees the new sync
+        Table table(&appl_db, "_GEARBOX_TABLE");
+        setPhy(table, 1, "phy1-resynced");
+        setConfigDone(table, "2");
+        ASSERT_EQ(gearbox.loadPhyMap(&table)[1].name, "phy1-resynced");
+
+        // An empty table is not cached
+        Table other(&appl_db, "_OTHER_GEARBOX_TABLE");
+        ASSERT_TRUE(gearbox.loadPhyMap(&other).empty());
+        ASSERT_EQ(gearbox.loadPhyMap(&table)[1].name, "phy1-resynced");
+    }
+}
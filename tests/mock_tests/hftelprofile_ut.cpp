@@ -236,4 +236,26 @@ namespace hftelprofile_ut
         sai_object_id_t bad_oid = 0xDEAD;
         EXPECT_THROW(s.p->updateTemplates(bad_oid), runtime_error);
     }
+
+    /* ---- Kept objects keep their label, new ones take the free labels ---- */
+    TEST(HFTelGroupTest, UpdateObjectsKeepsLabels)
+    {
+        HFTelGroup group("PORT");
+
+        group.updateObjects({"Ethernet0", "Ethernet4", "Ethernet8"});
+        EXPECT_EQ(group.getObjects().at("Ethernet0"), 1);
+        EXPECT_EQ(group.getObjects().at("Ethernet4"), 2);
+        EXPECT_EQ(group.getObjects().at("Ethernet8"), 3);
+
+        group.updateObjects({"Ethernet0", "Ethernet8"});
+        ASSERT_EQ(group.getObjects().size(), 2u);
+        EXPECT_EQ(group.getObjects().at("Ethernet0"), 1);
+        EXPECT_EQ(group.getObjects().at("Ethernet8"), 3);
+
+        group.updateObjects({"Ethernet0", "Ethernet2", "Ethernet8", "Ethernet12"});
+        EXPECT_EQ(group.getObjects().at("Ethernet0"), 1);
+        EXPECT_EQ(group.getObjects().at("Ethernet12"), 2);
+        EXPECT_EQ(group.getObjects().at("Ethernet2"), 4);
+        EXPECT_EQ(group.getObjects().at("Ethernet8"), 3);
+    }
 }
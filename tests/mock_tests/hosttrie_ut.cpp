@@ -0,0 +1,63 @@
+#include "hosttrie.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+namespace hosttrie_test
+{
+    using namespace std;
+    using namespace swss;
+
+    static set<string> covered(const HostTrie<int> &trie, const string &prefix)
+    {
+        set<string> result;
+        trie.forEachCovered(IpPrefix(prefix), [&result](const IpAddress &host, int value) {
+            result.insert(host.to_string() + "=" + to_string(value));
+        });
+        return result;
+    }
+
+    TEST(HostTrieTest, FindsCoveredHosts)
+    {
+        HostTrie<int> trie;
+
+        ASSERT_TRUE(trie.insert(IpAddress("10.0.0.1"), 1));
+        ASSERT_TRUE(trie.insert(IpAddress("10.0.1.1"), 2));
+        ASSERT_TRUE(trie.insert(IpAddress("192.168.0.1"), 3));
+        ASSERT_TRUE(trie.insert(IpAddress("fc00::1"), 4));
+        ASSERT_FALSE(trie.insert(IpAddress("10.0.0.1"), 5));
+        ASSERT_EQ(trie.size(), 4u);
+
+        ASSERT_EQ(covered(trie, "10.0.0.0/24"), set<string>({ "10.0.0.1=1" }));
+        ASSERT_EQ(covered(trie, "10.0.0.0/16"), set<string>({ "10.0.0.1=1", "10.0.1.1=2" }));
+        ASSERT_EQ(covered(trie, "0.0.0.0/0"), set<string>({ "10.0.0.1=1", "10.0.1.1=2", "192.168.0.1=3" }));
+        ASSERT_EQ(covered(trie, "10.0.1.1/32"), set<string>({ "10.0.1.1=2" }));
+        ASSERT_TRUE(covered(trie, "10.0.2.0/24").empty());
+
+        ASSERT_EQ(covered(trie, "::/0"), set<string>({ "fc00::1=4" }));
+        ASSERT_EQ(covered(trie, "fc00::/64"), set<string>({ "fc00::1=4" }));
+        ASSERT_TRUE(covered(trie, "fc01::/64").empty());
+    }
+
+    TEST(HostTrieTest, EraseRemovesHost)
+    {
+        HostTrie<int> trie;
+
+        trie.insert(IpAddress("10.0.0.1"), 1);
+        trie.insert(IpAddress("10.0.0.2"), 2);
+
+        ASSERT_TRUE(trie.erase(IpAddress("10.0.0.1")));
+        ASSERT_FALSE(trie.erase(IpAddress("10.0.0.1")));
+        ASSERT_FALSE(trie.erase(IpAddress("fc00::1")));
+        ASSERT_EQ(covered(trie, "10.0.0.0/24"), set<string>({ "10.0.0.2=2" }));
+
+        ASSERT_TRUE(trie.erase(IpAddress("10.0.0.2")));
+        ASSERT_TRUE(trie.empty());
+        ASSERT_TRUE(covered(trie, "0.0.0.0/0").empty());
+
+        ASSERT_TRUE(trie.insert(IpAddress("10.0.0.1"), 3));
+        ASSERT_EQ(covered(trie, "10.0.0.0/24"), set<string>({ "10.0.0.1=3" }));
+    }
+}
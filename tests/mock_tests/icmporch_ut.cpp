@@ -0,0 +1,241 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "icmporch.h"
+#undef private
+#include "mock_orch_test.h"
+
+namespace icmporch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    sai_icmp_echo_api_t ut_sai_icmp_echo_api;
+    sai_icmp_echo_api_t *pold_sai_icmp_echo_api;
+
+    sai_object_id_t _ut_stub_next_oid;
+    set<sai_object_id_t> _ut_stub_sessions;
+    // Sessions the SAI fails to create, by GUID, and to remove, by id
+    uint64_t _ut_stub_failing_guid;
+    sai_object_id_t _ut_stub_failing_session_id;
+    uint32_t _ut_stub_bulk_create_calls;
+    uint32_t _ut_stub_bulk_remove_calls;
+
+    sai_status_t _ut_stub_create_icmp_echo_session(
+        _Out_ sai_object_id_t *session_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            if (attr_list[i].id == SAI_ICMP_ECHO_SESSION_ATTR_GUID &&
+                attr_list[i].value.u64 == _ut_stub_failing_guid)
+            {
+                return SAI_STATUS_TABLE_FULL;
+            }
+        }
+
+        *session_id = ++_ut_stub_next_oid;
+        _ut_stub_sessions.insert(*session_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_remove_icmp_echo_session(
+        _In_ sai_object_id_t session_id)
+    {
+        if (session_id == _ut_stub_failing_session_id)
+        {
+            return SAI_STATUS_OBJECT_IN_USE;
+        }
+
+        _ut_stub_sessions.erase(session_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_create_icmp_echo_sessions(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_create_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_create_icmp_echo_session(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_remove_icmp_echo_sessions(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_remove_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_remove_icmp_echo_session(object_id[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    class IcmpOrchTest : public MockOrchTest
+    {
+    protected:
+        IcmpOrch *m_icmpOrch;
+
+        void PostSetUp() override
+        {
+            ut_sai_icmp_echo_api = *sai_icmp_echo_api;
+            pold_sai_icmp_echo_api = sai_icmp_echo_api;
+            ut_sai_icmp_echo_api.create_icmp_echo_session = _ut_stub_create_icmp_echo_session;
+            ut_sai_icmp_echo_api.remove_icmp_echo_session = _ut_stub_remove_icmp_echo_session;
+            sai_icmp_echo_api = &ut_sai_icmp_echo_api;
+
+            _ut_stub_next_oid = 0x1000;
+            _ut_stub_sessions.clear();
+            _ut_stub_failing_guid = 0;
+            _ut_stub_failing_session_id = SAI_NULL_OBJECT_ID;
+            _ut_stub_bulk_create_calls = 0;
+            _ut_stub_bulk_remove_calls = 0;
+
+            TableConnector stateDbIcmpSessionTable(m_state_db.get(), STATE_ICMP_ECHO_SESSION_TABLE_NAME);
+            m_icmpOrch = new IcmpOrch(m_app_db.get(), APP_ICMP_ECHO_SESSION_TABLE_NAME, stateDbIcmpSessionTable);
+
+            // The state change notification is registered with the switch, not under test here
+            m_icmpOrch->m_register_state_change_notif = true;
+
+            auto &bulker = m_icmpOrch->m_icmp_sessions.m_bulker;
+            bulker.create_entries = _ut_stub_create_icmp_echo_sessions;
+            bulker.remove_entries = _ut_stub_remove_icmp_echo_sessions;
+        }
+
+        void PreTearDown() override
+        {
+            delete m_icmpOrch;
+            sai_icmp_echo_api = pold_sai_icmp_echo_api;
+        }
+
+        Consumer *getConsumer()
+        {
+            return dynamic_cast<Consumer *>(m_icmpOrch->getExecutor(APP_ICMP_ECHO_SESSION_TABLE_NAME));
+        }
+
+        void applySessions(const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            getConsumer()->addToSync(entries);
+            static_cast<Orch *>(m_icmpOrch)->doTask();
+        }
+
+        string sessionKey(const string &guid)
+        {
+            return "default:default:" + guid + ":NORMAL";
+        }
+
+        KeyOpFieldsValuesTuple sessionSet(const string &guid)
+        {
+            return { sessionKey(guid), SET_COMMAND, {
+                { "tx_interval", "10" },
+                { "rx_interval", "30" },
+                { "src_ip", "10.0.0.1" },
+                { "dst_ip", "10.0.0.2" }
+            } };
+        }
+
+        KeyOpFieldsValuesTuple sessionDel(const string &guid)
+        {
+            return { sessionKey(guid), DEL_COMMAND, {} };
+        }
+
+        size_t getStateDbSessionCount()
+        {
+            Table state_table(m_state_db.get(), STATE_ICMP_ECHO_SESSION_TABLE_NAME);
+            vector<string> keys;
+            state_table.getKeys(keys);
+            return keys.size();
+        }
+    };
+
+    TEST_F(IcmpOrchTest, BulkCreateFailedInTheMiddle)
+    {
+        _ut_stub_failing_guid = 2;
+
+        applySessions({ sessionSet("1"), sessionSet("2"), sessionSet("3") });
+
+        // The sessions of the batch go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        ASSERT_EQ(_ut_stub_sessions.size(), 2);
+
+        // The others are created and published, the failed one is retried
+        auto &sessions = m_icmpOrch->m_icmp_sessions;
+        ASSERT_EQ(sessions.size(), 2);
+        ASSERT_EQ(_ut_stub_sessions.count(sessions.get_session_id(sessionKey("1"))), 1);
+        ASSERT_EQ(_ut_stub_sessions.count(sessions.get_session_id(sessionKey("3"))), 1);
+        ASSERT_FALSE(sessions.exists(sessionKey("2")));
+        ASSERT_EQ(sessions.pending_creates(), 0);
+        ASSERT_EQ(getStateDbSessionCount(), 2);
+        ASSERT_EQ(getConsumer()->m_toSync.size(), 1);
+
+        _ut_stub_failing_guid = 0;
+        static_cast<Orch *>(m_icmpOrch)->doTask();
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 2);
+        ASSERT_EQ(sessions.size(), 3);
+        ASSERT_EQ(_ut_stub_sessions.count(sessions.get_session_id(sessionKey("2"))), 1);
+        ASSERT_EQ(getStateDbSessionCount(), 3);
+        ASSERT_TRUE(getConsumer()->m_toSync.empty());
+    }
+
+    TEST_F(IcmpOrchTest, BulkRemoveFailedInTheMiddle)
+    {
+        applySessions({ sessionSet("1"), sessionSet("2"), sessionSet("3") });
+        ASSERT_EQ(_ut_stub_sessions.size(), 3);
+
+        auto &sessions = m_icmpOrch->m_icmp_sessions;
+        auto failing_id = sessions.get_session_id(sessionKey("2"));
+        _ut_stub_failing_session_id = failing_id;
+
+        applySessions({ sessionDel("1"), sessionDel("2"), sessionDel("3") });
+
+        // The sessions of the batch go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 1);
+
+        // The session that is still in the SAI is kept with its id and retried
+        ASSERT_EQ(_ut_stub_sessions.size(), 1);
+        ASSERT_EQ(sessions.size(), 1);
+        ASSERT_FALSE(sessions.exists(sessionKey("1")));
+        ASSERT_FALSE(sessions.exists(sessionKey("3")));
+        ASSERT_EQ(sessions.get_session_id(sessionKey("2")), failing_id);
+        ASSERT_EQ(sessions.pending_removes(), 0);
+        ASSERT_EQ(getStateDbSessionCount(), 1);
+        ASSERT_EQ(getConsumer()->m_toSync.size(), 1);
+
+        _ut_stub_failing_session_id = SAI_NULL_OBJECT_ID;
+        static_cast<Orch *>(m_icmpOrch)->doTask();
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 2);
+        ASSERT_TRUE(_ut_stub_sessions.empty());
+        ASSERT_EQ(sessions.size(), 0);
+        ASSERT_EQ(getStateDbSessionCount(), 0);
+        ASSERT_TRUE(getConsumer()->m_toSync.empty());
+    }
+}
@@ -3,6 +3,13 @@
 #include <fstream>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <map>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <netlink/netlink.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+#include <linux/rtnetlink.h>
 #include "../mock_table.h"
 #include "warm_restart.h"
 #define private public
@@ -14,18 +21,109 @@ extern std::vector<std::string> mockCallArgs;
 
 bool Ethernet0IPv6Set = false;
 
-int cb(const std::string &cmd, std::string &stdout){
-    mockCallArgs.push_back(cmd);
-    if (cmd == "sysctl -w net.ipv6.conf.\"Ethernet0\".disable_ipv6=0") Ethernet0IPv6Set = true;
-    else if (cmd.find("/sbin/ip -6 address \"add\"") == 0) {
-        return Ethernet0IPv6Set ? 0 : 2;
+/* Decoded netlink requests sent by IntfMgr, e.g. "address add Ethernet0 2001::8/64" */
+static std::vector<std::string> netlinkCalls;
+static std::map<std::string, unsigned int> ifIndexes;
+static std::vector<std::string> ifNames;
+static int netlinkAckResult = 0;
+
+static std::string ifName(int ifindex)
+{
+    if (ifindex <= 0 || ifindex > (int)ifNames.size())
+    {
+        return "";
     }
-    else if (cmd == "/sbin/ip link set \"Ethernet64.10\" \"up\""){
-        return 1;
+    return ifNames[ifindex - 1];
+}
+
+/*
+ * Wrap the netlink socket and interface lookups used by NetDevHelper so
+ * that requests are recorded and acked locally instead of reaching the
+ * kernel. The ack result mimics the failures the ip command used to return.
+ */
+extern "C" {
+
+int __wrap_nl_connect(struct nl_sock *sk, int protocol)
+{
+    return 0;
+}
+
+unsigned int __wrap_if_nametoindex(const char *ifname)
+{
+    auto it = ifIndexes.find(ifname);
+    if (it != ifIndexes.end())
+    {
+        return it->second;
     }
-    else {
-        return 0;
+    ifNames.push_back(ifname);
+    ifIndexes[ifname] = (unsigned int)ifNames.size();
+    return (unsigned int)ifNames.size();
+}
+
+int __wrap_nl_send_auto(struct nl_sock *sk, struct nl_msg *msg)
+{
+    struct nlmsghdr *hdr = nlmsg_hdr(msg);
+
+    netlinkAckResult = 0;
+    if (hdr->nlmsg_type == RTM_NEWADDR || hdr->nlmsg_type == RTM_DELADDR)
+    {
+        struct ifaddrmsg *ifa = (struct ifaddrmsg *)nlmsg_data(hdr);
+        struct nlattr *local = nlmsg_find_attr(hdr, sizeof(*ifa), IFA_LOCAL);
+        char buf[INET6_ADDRSTRLEN] = "";
+        bool add = (hdr->nlmsg_type == RTM_NEWADDR);
+
+        if (local)
+        {
+            inet_ntop(ifa->ifa_family, nla_data(local), buf, sizeof(buf));
+        }
+        netlinkCalls.push_back(std::string("address ") + (add ? "add " : "del ") + ifName(ifa->ifa_index) +
+                               " " + buf + "/" + std::to_string(ifa->ifa_prefixlen));
+        if (add && ifa->ifa_family == AF_INET6 && !Ethernet0IPv6Set)
+        {
+            netlinkAckResult = -NLE_NOACCESS;
+        }
+    }
+    else if (hdr->nlmsg_type == RTM_NEWLINK)
+    {
+        struct ifinfomsg *ifi = (struct ifinfomsg *)nlmsg_data(hdr);
+
+        if (ifi->ifi_change & IFF_UP)
+        {
+            bool up = (ifi->ifi_flags & IFF_UP);
+            netlinkCalls.push_back("link set " + ifName(ifi->ifi_index) + (up ? " up" : " down"));
+            if (up && ifName(ifi->ifi_index) == "Ethernet64.10")
+            {
+                netlinkAckResult = -NLE_FAILURE;
+            }
+        }
+    }
+
+    return (int)hdr->nlmsg_len;
+}
+
+int __wrap_nl_wait_for_ack(struct nl_sock *sk)
+{
+    return netlinkAckResult;
+}
+
+}
+
+static int countNetlinkCalls(const std::string &prefix, const std::string &addr = "")
+{
+    int count = 0;
+    for (const auto &call : netlinkCalls)
+    {
+        if (call.find(prefix) == 0 && (addr.empty() || call.find(" " + addr) != std::string::npos))
+        {
+            count++;
+        }
     }
+    return count;
+}
+
+int cb(const std::string &cmd, std::string &stdout){
+    mockCallArgs.push_back(cmd);
+    if (cmd == "sysctl -w net.ipv6.conf.\"Ethernet0\".disable_ipv6=0") Ethernet0IPv6Set = true;
     return 0;
 }
 
@@ -58,6 +156,7 @@ namespace intfmgr_ut
             };
             cfg_intf_tables = tables;
             mockCallArgs.clear();
+            netlinkCalls.clear();
             callback = cb;
         }
     };
@@ -77,12 +176,7 @@ namespace intfmgr_ut
         const std::vector<std::string>& keys = {"Ethernet0", "2001::8/64"};
         const std::vector<swss::FieldValueTuple> data;
         intfmgr.doIntfAddrTask(keys, data, "SET");
-        int ip_cmd_called = 0;
-        for (auto cmd : mockCallArgs){
-            if (cmd.find("/sbin/ip -6 address \"add\"") == 0){
-                ip_cmd_called++;
-            }
-        }
+        int ip_cmd_called = countNetlinkCalls("address add Ethernet0", "2001::8/64");
         ASSERT_EQ(ip_cmd_called, 2);
     }
 
@@ -101,12 +195,7 @@ namespace intfmgr_ut
         const std::vector<std::string>& keys = {"Ethernet0", "2001::8/64"};
         const std::vector<swss::FieldValueTuple> data;
         intfmgr.doIntfAddrTask(keys, data, "SET");
-        int ip_cmd_called = 0;
-        for (auto cmd : mockCallArgs){
-            if (cmd.find("/sbin/ip -6 address \"add\"") == 0){
-                ip_cmd_called++;
-            }
-        }
+        int ip_cmd_called = countNetlinkCalls("address add Ethernet0", "2001::8/64");
         ASSERT_EQ(ip_cmd_called, 1);
     }
 
@@ -154,6 +243,7 @@ namespace intfmgr_ut
         intfmgr.doIntfAddrTask(ipv4Keys, emptyData, "SET");
 
         mockCallArgs.clear();
+        netlinkCalls.clear();
 
         /* Simulate admin up by calling doPortTableTask */
         std::vector<swss::FieldValueTuple> portData;
@@ -161,27 +251,9 @@ namespace intfmgr_ut
         intfmgr.doPortTableTask("Ethernet0", portData, "SET");
 
         /* Verify that only IPv6 link-local address add was called */
-        int ipv6_ll_add_called = 0;
-        int ipv6_global_add_called = 0;
-        int ipv4_add_called = 0;
-        for (const auto &cmd : mockCallArgs)
-        {
-            if (cmd.find("/sbin/ip -6 address \"add\"") != std::string::npos &&
-                cmd.find("fe80::1/64") != std::string::npos)
-            {
-                ipv6_ll_add_called++;
-            }
-            if (cmd.find("/sbin/ip -6 address \"add\"") != std::string::npos &&
-                cmd.find("2001::8/64") != std::string::npos)
-            {
-                ipv6_global_add_called++;
-            }
-            if (cmd.find("/sbin/ip address \"add\"") != std::string::npos &&
-                cmd.find("10.0.0.1/31") != std::string::npos)
-            {
-                ipv4_add_called++;
-            }
-        }
+        int ipv6_ll_add_called = countNetlinkCalls("address add Ethernet0", "fe80::1/64");
+        int ipv6_global_add_called = countNetlinkCalls("address add Ethernet0", "2001::8/64");
+        int ipv4_add_called = countNetlinkCalls("address add Ethernet0", "10.0.0.1/31");
         ASSERT_EQ(ipv6_ll_add_called, 1);
         ASSERT_EQ(ipv6_global_add_called, 0);
         ASSERT_EQ(ipv4_add_called, 0);
@@ -191,17 +263,10 @@ namespace intfmgr_ut
         ASSERT_EQ(intfmgr.m_intfLLAddresses.count("Ethernet0"), 0u);
 
         mockCallArgs.clear();
+        netlinkCalls.clear();
         intfmgr.doPortTableTask("Ethernet0", portData, "SET");
 
-        ipv6_ll_add_called = 0;
-        for (const auto &cmd : mockCallArgs)
-        {
-            if (cmd.find("/sbin/ip -6 address \"add\"") != std::string::npos &&
-                cmd.find("fe80::1/64") != std::string::npos)
-            {
-                ipv6_ll_add_called++;
-            }
-        }
+        ipv6_ll_add_called = countNetlinkCalls("address add Ethernet0", "fe80::1/64");
         ASSERT_EQ(ipv6_ll_add_called, 0);
     }
 
@@ -223,20 +288,14 @@ namespace intfmgr_ut
         intfmgr.doIntfAddrTask(llKeys, emptyData, "SET");
 
         mockCallArgs.clear();
+        netlinkCalls.clear();
 
         /* Simulate admin down — should NOT trigger replay */
         std::vector<swss::FieldValueTuple> portData;
         portData.emplace_back("admin_status", "down");
         intfmgr.doPortTableTask("Ethernet0", portData, "SET");
 
-        int ipv6_add_called = 0;
-        for (const auto &cmd : mockCallArgs)
-        {
-            if (cmd.find("/sbin/ip -6 address \"add\"") != std::string::npos)
-            {
-                ipv6_add_called++;
-            }
-        }
+        int ipv6_add_called = countNetlinkCalls("address add");
         ASSERT_EQ(ipv6_add_called, 0);
     }
 
@@ -16,6 +16,7 @@ namespace intfsorch_test
 
     int create_rif_count = 0;
     int remove_rif_count = 0;
+    int bulk_create_rif_call_count = 0;
     sai_router_interface_api_t *pold_sai_rif_api;
     sai_router_interface_api_t ut_sai_rif_api;
 
@@ -29,6 +30,25 @@ namespace intfsorch_test
         return SAI_STATUS_SUCCESS;
     }
 
+    sai_status_t _ut_create_router_interfaces(
+            _In_ sai_object_id_t switch_id,
+            _In_ uint32_t object_count,
+            _In_ const uint32_t *attr_count,
+            _In_ const sai_attribute_t **attr_list,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_object_id_t *object_id,
+            _Out_ sai_status_t *object_statuses)
+    {
+        ++bulk_create_rif_call_count;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            ++create_rif_count;
+            object_id[i] = SAI_NULL_OBJECT_ID;
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
     sai_status_t _ut_remove_router_interface(
             _In_ sai_object_id_t router_interface_id)
     {
@@ -60,6 +80,7 @@ namespace intfsorch_test
             sai_router_intfs_api = &ut_sai_rif_api;
 
             sai_router_intfs_api->create_router_interface = _ut_create_router_interface;
+            sai_router_intfs_api->create_router_interfaces = _ut_create_router_interfaces;
             sai_router_intfs_api->remove_router_interface = _ut_remove_router_interface;
 
             m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
@@ -337,6 +358,47 @@ namespace intfsorch_test
         ASSERT_EQ(current_remove_count + 1, remove_rif_count);
     };
 
+    TEST_F(IntfsOrchTest, IntfsOrchBulkCreateRifs)
+    {
+        // RIFs of a batch are created in one bulk, IP2ME routes of the batch find their RIF
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"Ethernet0", "SET", { {"mtu", "9100"}}});
+        entries.push_back({"Ethernet4", "SET", { {"mtu", "9100"}}});
+        entries.push_back({"Ethernet8", "SET", { {"mtu", "9100"}}});
+        entries.push_back({"Ethernet0:10.0.0.1/24", "SET", { {"scope", "global"},{"family", "IPv4"}}});
+        auto consumer = dynamic_cast<Consumer *>(gIntfsOrch->getExecutor(APP_INTF_TABLE_NAME));
+        consumer->addToSync(entries);
+        auto current_create_count = create_rif_count;
+        auto current_bulk_call_count = bulk_create_rif_call_count;
+        static_cast<Orch *>(gIntfsOrch)->doTask();
+        ASSERT_EQ(current_create_count + 3, create_rif_count);
+        ASSERT_EQ(current_bulk_call_count + 1, bulk_create_rif_call_count);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+
+        IntfsTable m_syncdIntfses = gIntfsOrch->getSyncdIntfses();
+        ASSERT_EQ(m_syncdIntfses.count("Ethernet0"), 1);
+        ASSERT_EQ(m_syncdIntfses.count("Ethernet4"), 1);
+        ASSERT_EQ(m_syncdIntfses.count("Ethernet8"), 1);
+        ASSERT_EQ(m_syncdIntfses["Ethernet0"].ip_addresses.count(IpPrefix("10.0.0.1/24")), 1);
+
+        // An interface with a pending DEL is left to the one by one path
+        gIntfsOrch->increaseRouterIntfsRefCount("Ethernet4");
+        entries.clear();
+        entries.push_back({"Ethernet4", "DEL", { {} }});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gIntfsOrch)->doTask();
+
+        entries.clear();
+        entries.push_back({"Ethernet4", "SET", { {"mtu", "9100"}}});
+        consumer->addToSync(entries);
+        gIntfsOrch->decreaseRouterIntfsRefCount("Ethernet4");
+        current_create_count = create_rif_count;
+        current_bulk_call_count = bulk_create_rif_call_count;
+        static_cast<Orch *>(gIntfsOrch)->doTask();
+        ASSERT_EQ(current_create_count + 1, create_rif_count);
+        ASSERT_EQ(current_bulk_call_count, bulk_create_rif_call_count);
+    }
+
     TEST_F(IntfsOrchTest, IntfsOrchVrfUpdate)
     {
         //create a new vrf
@@ -394,4 +456,44 @@ namespace intfsorch_test
         m_syncdIntfses = gIntfsOrch->getSyncdIntfses();
         ASSERT_EQ(m_syncdIntfses["Loopback3"].vrf_id, gVirtualRouterId);    
     }
+
+    /* A VRF still referenced is removed once its last reference is gone */
+    TEST_F(IntfsOrchTest, IntfsOrchVrfRemoveDeferred)
+    {
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"Vrf-Red", "SET", { {"NULL", "NULL"}}});
+        entries.push_back({"Vrf-Green", "SET", { {"NULL", "NULL"}}});
+        auto vrf_consumer = dynamic_cast<Consumer *>(gVrfOrch->getExecutor(APP_VRF_TABLE_NAME));
+        vrf_consumer->addToSync(entries);
+        static_cast<Orch *>(gVrfOrch)->doTask();
+        ASSERT_TRUE(gVrfOrch->isVRFexists("Vrf-Red"));
+        ASSERT_TRUE(gVrfOrch->isVRFexists("Vrf-Green"));
+        ASSERT_TRUE(gVrfOrch->created_vrfs_.empty());
+
+        entries.clear();
+        entries.push_back({"Loopback4", "SET", { {"vrf_name", "Vrf-Red"}}});
+        auto intf_consumer = dynamic_cast<Consumer *>(gIntfsOrch->getExecutor(APP_INTF_TABLE_NAME));
+        intf_consumer->addToSync(entries);
+        static_cast<Orch *>(gIntfsOrch)->doTask();
+        ASSERT_EQ(gVrfOrch->getVrfRefCount("Vrf-Red"), 1);
+
+        // The removal waits in the retry cache instead of being polled
+        entries.clear();
+        entries.push_back({"Vrf-Red", "DEL", {}});
+        vrf_consumer->addToSync(entries);
+        static_cast<Orch *>(gVrfOrch)->doTask();
+        ASSERT_TRUE(gVrfOrch->isVRFexists("Vrf-Red"));
+        ASSERT_TRUE(vrf_consumer->m_toSync.empty());
+        ASSERT_EQ(gVrfOrch->getRetryCache(APP_VRF_TABLE_NAME)->getRetryMap().size(), 1);
+
+        entries.clear();
+        entries.push_back({"Loopback4", "DEL", {}});
+        intf_consumer->addToSync(entries);
+        static_cast<Orch *>(gIntfsOrch)->doTask();
+        ASSERT_EQ(gVrfOrch->getVrfRefCount("Vrf-Red"), 0);
+
+        static_cast<Orch *>(gVrfOrch)->doTask();
+        ASSERT_FALSE(gVrfOrch->isVRFexists("Vrf-Red"));
+        ASSERT_TRUE(gVrfOrch->getRetryCache(APP_VRF_TABLE_NAME)->getRetryMap().empty());
+    }
 }
\ No newline at end of file
@@ -0,0 +1,299 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#include "isolationgrouporch.h"
+#undef protected
+#include "mock_orch_test.h"
+
+namespace isolationgrouporch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    static const string ISO_GRP = "MCLAG_ISO_GRP";
+
+    sai_isolation_group_api_t ut_sai_isolation_group_api;
+    sai_isolation_group_api_t *pold_sai_isolation_group_api;
+
+    sai_object_id_t _ut_stub_next_id;
+    // Members in the SAI, by member id, with the port they isolate
+    map<sai_object_id_t, sai_object_id_t> _ut_stub_members;
+    // Member the SAI fails to create, by port id
+    sai_object_id_t _ut_stub_failing_port_id;
+    // Member the SAI fails to remove, by member id
+    sai_object_id_t _ut_stub_failing_member_id;
+    bool _ut_stub_bulk_supported;
+    uint32_t _ut_stub_create_calls;
+    uint32_t _ut_stub_remove_calls;
+    uint32_t _ut_stub_bulk_create_calls;
+    uint32_t _ut_stub_bulk_remove_calls;
+
+    sai_status_t _ut_stub_create_isolation_group(
+        _Out_ sai_object_id_t *isolation_group_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        *isolation_group_id = ++_ut_stub_next_id;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_create_member(
+        _Out_ sai_object_id_t *member_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        sai_object_id_t port_id = SAI_NULL_OBJECT_ID;
+
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            if (attr_list[i].id == SAI_ISOLATION_GROUP_MEMBER_ATTR_ISOLATION_OBJECT)
+            {
+                port_id = attr_list[i].value.oid;
+            }
+        }
+        if (port_id == _ut_stub_failing_port_id)
+        {
+            return SAI_STATUS_TABLE_FULL;
+        }
+
+        *member_id = ++_ut_stub_next_id;
+        _ut_stub_members[*member_id] = port_id;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_remove_member(
+        _In_ sai_object_id_t member_id)
+    {
+        if (member_id == _ut_stub_failing_member_id)
+        {
+            return SAI_STATUS_OBJECT_IN_USE;
+        }
+
+        _ut_stub_members.erase(member_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_create_isolation_group_member(
+        _Out_ sai_object_id_t *isolation_group_member_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        _ut_stub_create_calls++;
+        return _ut_stub_create_member(isolation_group_member_id, attr_count, attr_list);
+    }
+
+    sai_status_t _ut_stub_remove_isolation_group_member(
+        _In_ sai_object_id_t isolation_group_member_id)
+    {
+        _ut_stub_remove_calls++;
+        return _ut_stub_remove_member(isolation_group_member_id);
+    }
+
+    sai_status_t _ut_stub_create_isolation_group_members(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_create_calls++;
+        if (!_ut_stub_bulk_supported)
+        {
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_create_member(&object_id[i], attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_remove_isolation_group_members(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_remove_calls++;
+        if (!_ut_stub_bulk_supported)
+        {
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_remove_member(object_id[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    class IsolationGroupTest : public MockOrchTest
+    {
+    protected:
+        shared_ptr<IsolationGroup> m_isoGrp;
+
+        void ApplyInitialConfigs() override
+        {
+            Table port_table = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+            auto ports = ut_helper::getInitialSaiPorts();
+            port_table.set(ETHERNET0, ports[ETHERNET0]);
+            port_table.set(ETHERNET4, ports[ETHERNET4]);
+            port_table.set(ETHERNET8, ports[ETHERNET8]);
+            port_table.set("PortConfigDone", { { "count", to_string(3) } });
+            port_table.set("PortInitDone", { {} });
+
+            gPortsOrch->addExistingData(&port_table);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+        }
+
+        void PostSetUp() override
+        {
+            ut_sai_isolation_group_api = *sai_isolation_group_api;
+            pold_sai_isolation_group_api = sai_isolation_group_api;
+            ut_sai_isolation_group_api.create_isolation_group = _ut_stub_create_isolation_group;
+            ut_sai_isolation_group_api.create_isolation_group_member = _ut_stub_create_isolation_group_member;
+            ut_sai_isolation_group_api.remove_isolation_group_member = _ut_stub_remove_isolation_group_member;
+            sai_isolation_group_api = &ut_sai_isolation_group_api;
+
+            _ut_stub_next_id = 0x1000;
+            _ut_stub_members.clear();
+            _ut_stub_failing_port_id = SAI_NULL_OBJECT_ID;
+            _ut_stub_failing_member_id = SAI_NULL_OBJECT_ID;
+            _ut_stub_bulk_supported = true;
+            _ut_stub_create_calls = 0;
+            _ut_stub_remove_calls = 0;
+            _ut_stub_bulk_create_calls = 0;
+            _ut_stub_bulk_remove_calls = 0;
+
+            m_isoGrp = make_shared<IsolationGroup>(ISO_GRP, ISOLATION_GROUP_TYPE_PORT);
+            m_isoGrp->m_memberBulker.create_entries = _ut_stub_create_isolation_group_members;
+            m_isoGrp->m_memberBulker.remove_entries = _ut_stub_remove_isolation_group_members;
+            ASSERT_EQ(m_isoGrp->create(), ISO_GRP_STATUS_SUCCESS);
+        }
+
+        void PreTearDown() override
+        {
+            m_isoGrp.reset();
+            sai_isolation_group_api = pold_sai_isolation_group_api;
+        }
+
+        sai_object_id_t portId(const string &alias)
+        {
+            Port port;
+            gPortsOrch->getPort(alias, port);
+            return port.m_port_id;
+        }
+
+        bool isMember(const string &alias)
+        {
+            auto member = m_isoGrp->m_members.find(alias);
+            return member != m_isoGrp->m_members.end() &&
+                   _ut_stub_members.count(member->second) == 1 &&
+                   _ut_stub_members[member->second] == portId(alias);
+        }
+    };
+
+    TEST_F(IsolationGroupTest, MembersBulkCreateFailedInTheMiddle)
+    {
+        _ut_stub_failing_port_id = portId(ETHERNET4);
+
+        m_isoGrp->setMembers("Ethernet0,Ethernet4,Ethernet8");
+
+        // The new members go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        ASSERT_EQ(_ut_stub_create_calls, 0);
+
+        // The others are tracked, the failed one is neither a member nor pending
+        ASSERT_TRUE(isMember(ETHERNET0));
+        ASSERT_TRUE(isMember(ETHERNET8));
+        ASSERT_EQ(m_isoGrp->m_members.count(ETHERNET4), 0);
+        ASSERT_EQ(_ut_stub_members.size(), 2);
+        ASSERT_TRUE(m_isoGrp->m_pending_members.empty());
+
+        // Setting the same list again only creates the missing member
+        _ut_stub_failing_port_id = SAI_NULL_OBJECT_ID;
+        m_isoGrp->setMembers("Ethernet0,Ethernet4,Ethernet8");
+
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 2);
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 0);
+        ASSERT_TRUE(isMember(ETHERNET4));
+        ASSERT_EQ(_ut_stub_members.size(), 3);
+    }
+
+    TEST_F(IsolationGroupTest, MembersBulkRemoveFailedInTheMiddle)
+    {
+        m_isoGrp->setMembers("Ethernet0,Ethernet4,Ethernet8");
+        ASSERT_EQ(_ut_stub_members.size(), 3);
+
+        _ut_stub_failing_member_id = m_isoGrp->m_members[ETHERNET4];
+        m_isoGrp->setMembers("Ethernet0");
+
+        // The members no longer needed go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 1);
+        ASSERT_EQ(_ut_stub_remove_calls, 0);
+
+        // The member that failed to go away is still tracked with its oid, the other one is gone
+        ASSERT_TRUE(isMember(ETHERNET0));
+        ASSERT_TRUE(isMember(ETHERNET4));
+        ASSERT_EQ(m_isoGrp->m_members.count(ETHERNET8), 0);
+        ASSERT_EQ(_ut_stub_members.size(), 2);
+        ASSERT_TRUE(m_isoGrp->m_pending_members.empty());
+
+        // The next update removes it
+        _ut_stub_failing_member_id = SAI_NULL_OBJECT_ID;
+        m_isoGrp->setMembers("Ethernet0");
+
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 2);
+        ASSERT_TRUE(isMember(ETHERNET0));
+        ASSERT_EQ(m_isoGrp->m_members.size(), 1);
+        ASSERT_EQ(_ut_stub_members.size(), 1);
+    }
+
+    TEST_F(IsolationGroupTest, MembersBulkNotSupportedFallsBackToSingleCalls)
+    {
+        _ut_stub_bulk_supported = false;
+        _ut_stub_failing_port_id = portId(ETHERNET4);
+
+        m_isoGrp->setMembers("Ethernet0,Ethernet4,Ethernet8");
+
+        // Each member is created with its own call, with the same per member result
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        ASSERT_EQ(_ut_stub_create_calls, 3);
+        ASSERT_TRUE(isMember(ETHERNET0));
+        ASSERT_TRUE(isMember(ETHERNET8));
+        ASSERT_EQ(m_isoGrp->m_members.count(ETHERNET4), 0);
+
+        _ut_stub_failing_member_id = m_isoGrp->m_members[ETHERNET8];
+        m_isoGrp->setMembers("Ethernet4");
+
+        // Ethernet4 fails again, each removal is its own call
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 2);
+        ASSERT_EQ(_ut_stub_create_calls, 4);
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 1);
+        ASSERT_EQ(_ut_stub_remove_calls, 2);
+        ASSERT_EQ(m_isoGrp->m_members.count(ETHERNET0), 0);
+        ASSERT_TRUE(isMember(ETHERNET8));
+        ASSERT_EQ(m_isoGrp->m_members.count(ETHERNET4), 0);
+        ASSERT_EQ(_ut_stub_members.size(), 1);
+    }
+}
@@ -0,0 +1,262 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "macsecorch.h"
+#undef private
+#include "mock_orch_test.h"
+
+namespace macsecorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    // A SCI whose value doesn't depend on the byte order it's read in
+    static const string SCI = "0101010101010101";
+    static const sai_uint64_t SCI_VALUE = 0x0101010101010101ULL;
+
+    sai_macsec_api_t ut_sai_macsec_api;
+    sai_macsec_api_t *pold_sai_macsec_api;
+    sai_acl_api_t ut_sai_acl_api;
+    sai_acl_api_t *pold_sai_acl_api;
+
+    sai_object_id_t _ut_stub_next_sa_id;
+    set<sai_object_id_t> _ut_stub_sas;
+    // SA the SAI fails to create, by the SC it belongs to
+    sai_object_id_t _ut_stub_failing_sc_id;
+    bool _ut_stub_bulk_supported;
+    uint32_t _ut_stub_create_calls;
+    uint32_t _ut_stub_bulk_create_calls;
+    // Whether the MACsec flow action of an ACL entry is enabled, by entry id
+    map<sai_object_id_t, bool> _ut_stub_flow_active;
+
+    sai_status_t _ut_stub_create_macsec_sa(
+        _Out_ sai_object_id_t *sa_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        _ut_stub_create_calls++;
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            if (attr_list[i].id == SAI_MACSEC_SA_ATTR_SC_ID &&
+                attr_list[i].value.oid == _ut_stub_failing_sc_id)
+            {
+                return SAI_STATUS_TABLE_FULL;
+            }
+        }
+
+        *sa_id = ++_ut_stub_next_sa_id;
+        _ut_stub_sas.insert(*sa_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_remove_macsec_sa(
+        _In_ sai_object_id_t sa_id)
+    {
+        _ut_stub_sas.erase(sa_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_create_macsec_sas(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_create_calls++;
+        if (!_ut_stub_bulk_supported)
+        {
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_create_macsec_sa(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_set_acl_entry_attribute(
+        _In_ sai_object_id_t acl_entry_id,
+        _In_ const sai_attribute_t *attr)
+    {
+        if (attr->id == SAI_ACL_ENTRY_ATTR_ACTION_MACSEC_FLOW)
+        {
+            _ut_stub_flow_active[acl_entry_id] = attr->value.aclaction.enable;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    class MACsecOrchTest : public MockOrchTest
+    {
+    protected:
+        MACsecOrch *m_macsecOrch;
+
+        void PostSetUp() override
+        {
+            ut_sai_macsec_api = *sai_macsec_api;
+            pold_sai_macsec_api = sai_macsec_api;
+            ut_sai_macsec_api.create_macsec_sa = _ut_stub_create_macsec_sa;
+            ut_sai_macsec_api.remove_macsec_sa = _ut_stub_remove_macsec_sa;
+            sai_macsec_api = &ut_sai_macsec_api;
+
+            ut_sai_acl_api = *sai_acl_api;
+            pold_sai_acl_api = sai_acl_api;
+            ut_sai_acl_api.set_acl_entry_attribute = _ut_stub_set_acl_entry_attribute;
+            sai_acl_api = &ut_sai_acl_api;
+
+            _ut_stub_next_sa_id = 0x1000;
+            _ut_stub_sas.clear();
+            _ut_stub_failing_sc_id = SAI_NULL_OBJECT_ID;
+            _ut_stub_bulk_supported = true;
+            _ut_stub_create_calls = 0;
+            _ut_stub_bulk_create_calls = 0;
+            _ut_stub_flow_active.clear();
+
+            vector<string> macsec_tables = { APP_MACSEC_EGRESS_SA_TABLE_NAME };
+            m_macsecOrch = new MACsecOrch(m_app_db.get(), m_state_db.get(), macsec_tables, gPortsOrch);
+
+            m_macsecOrch->getMACsecSABulker(gSwitchId).create_entries = _ut_stub_create_macsec_sas;
+        }
+
+        void PreTearDown() override
+        {
+            // The ports, SCs and flows are only known to the orch, not to the SAI
+            m_macsecOrch->m_macsec_ports.clear();
+            delete m_macsecOrch;
+            sai_macsec_api = pold_sai_macsec_api;
+            sai_acl_api = pold_sai_acl_api;
+        }
+
+        // An enabled MACsec port with one egress SC that has no SA yet
+        void addMACsecPort(const string &port_name, sai_object_id_t sc_id)
+        {
+            auto port = make_shared<MACsecOrch::MACsecPort>();
+            port->m_enable = true;
+            port->m_cipher_suite = SAI_MACSEC_CIPHER_SUITE_GCM_AES_128;
+
+            auto &sc = port->m_egress_scs[SCI_VALUE];
+            sc.m_encoding_an = 0;
+            sc.m_sc_id = sc_id;
+            sc.m_flow_id = flowId(sc_id);
+            sc.m_entry_id = entryId(sc_id);
+
+            m_macsecOrch->m_macsec_ports[port_name] = port;
+        }
+
+        sai_object_id_t flowId(sai_object_id_t sc_id)
+        {
+            return sc_id + 0x10;
+        }
+
+        sai_object_id_t entryId(sai_object_id_t sc_id)
+        {
+            return sc_id + 0x20;
+        }
+
+        MACsecOrch::MACsecSC &getSC(const string &port_name)
+        {
+            return m_macsecOrch->m_macsec_ports[port_name]->m_egress_scs[SCI_VALUE];
+        }
+
+        Consumer *getConsumer()
+        {
+            return dynamic_cast<Consumer *>(m_macsecOrch->getExecutor(APP_MACSEC_EGRESS_SA_TABLE_NAME));
+        }
+
+        void applySAs(const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            getConsumer()->addToSync(entries);
+            static_cast<Orch *>(m_macsecOrch)->doTask();
+        }
+
+        KeyOpFieldsValuesTuple saSet(const string &port_name)
+        {
+            return { port_name + ":" + SCI + ":0", SET_COMMAND, {
+                { "sak", "0123456789abcdef0123456789abcdef" },
+                { "auth_key", "fedcba9876543210fedcba9876543210" },
+                { "next_pn", "1" }
+            } };
+        }
+
+        bool saStateExists(const string &port_name)
+        {
+            Table state_table(m_state_db.get(), STATE_MACSEC_EGRESS_SA_TABLE_NAME);
+            vector<FieldValueTuple> values;
+            return state_table.get(port_name + "|" + SCI + "|0", values);
+        }
+    };
+
+    TEST_F(MACsecOrchTest, BulkCreateFailedInTheMiddle)
+    {
+        addMACsecPort(ETHERNET0, 0x100);
+        addMACsecPort(ETHERNET4, 0x200);
+        addMACsecPort(ETHERNET8, 0x300);
+        _ut_stub_failing_sc_id = 0x200;
+
+        applySAs({ saSet(ETHERNET0), saSet(ETHERNET4), saSet(ETHERNET8) });
+
+        // The SAs of the round go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        ASSERT_EQ(_ut_stub_sas.size(), 2);
+
+        // The others get their SA, their flow and their state
+        for (auto port_name : { ETHERNET0, ETHERNET8 })
+        {
+            auto &sc = getSC(port_name);
+            ASSERT_EQ(sc.m_sa_ids.size(), 1);
+            ASSERT_EQ(_ut_stub_sas.count(sc.m_sa_ids[0]), 1);
+            ASSERT_TRUE(_ut_stub_flow_active[sc.m_entry_id]);
+            ASSERT_TRUE(saStateExists(port_name));
+        }
+
+        // The SC of the failed SA keeps dropping, the flow is never enabled
+        auto &failed_sc = getSC(ETHERNET4);
+        ASSERT_TRUE(failed_sc.m_sa_ids.empty());
+        ASSERT_EQ(_ut_stub_flow_active.count(failed_sc.m_entry_id), 0);
+        ASSERT_FALSE(saStateExists(ETHERNET4));
+
+        ASSERT_TRUE(m_macsecOrch->m_sa_requests.empty());
+        ASSERT_TRUE(getConsumer()->m_toSync.empty());
+    }
+
+    TEST_F(MACsecOrchTest, BulkNotSupportedFallsBackToSingleCalls)
+    {
+        addMACsecPort(ETHERNET0, 0x100);
+        addMACsecPort(ETHERNET4, 0x200);
+        _ut_stub_bulk_supported = false;
+        _ut_stub_failing_sc_id = 0x200;
+
+        applySAs({ saSet(ETHERNET0), saSet(ETHERNET4) });
+
+        // Each SA is created with its own call, with the same per SA result
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        ASSERT_EQ(_ut_stub_create_calls, 2);
+        ASSERT_EQ(_ut_stub_sas.size(), 1);
+
+        auto &sc = getSC(ETHERNET0);
+        ASSERT_EQ(sc.m_sa_ids.size(), 1);
+        ASSERT_TRUE(_ut_stub_flow_active[sc.m_entry_id]);
+        ASSERT_TRUE(saStateExists(ETHERNET0));
+
+        auto &failed_sc = getSC(ETHERNET4);
+        ASSERT_TRUE(failed_sc.m_sa_ids.empty());
+        ASSERT_EQ(_ut_stub_flow_active.count(failed_sc.m_entry_id), 0);
+        ASSERT_FALSE(saStateExists(ETHERNET4));
+
+        ASSERT_TRUE(getConsumer()->m_toSync.empty());
+    }
+}
@@ -0,0 +1,89 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "memaccounting.h"
+
+namespace memaccounting_test
+{
+    using namespace std;
+
+    MEM_ACCOUNTING_TAG(TestMemTag, "MemAccountingTest|entries");
+
+    using TestTable = map<int, string, less<int>, MemAccountingAllocator<pair<const int, string>, TestMemTag>>;
+
+    struct MemAccountingTest : public ::testing::Test
+    {
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+            MemAccounting::setEnabled(true);
+        }
+
+        virtual void TearDown() override
+        {
+            MemAccounting::setEnabled(false);
+            ::testing_db::reset();
+        }
+    };
+
+    TEST_F(MemAccountingTest, CountsTaggedContainers)
+    {
+        auto &stats = MemAccountingAllocator<int, TestMemTag>::stats();
+        auto bytes = stats.bytes.load();
+        auto allocations = stats.allocations.load();
+        auto deallocations = stats.deallocations.load();
+
+        {
+            TestTable table;
+            for (int i = 0; i < 10; i++)
+            {
+                table.emplace(i, "entry");
+            }
+
+            ASSERT_EQ(stats.allocations.load(), allocations + 10);
+            ASSERT_GT(stats.bytes.load(), bytes);
+
+            table.erase(0);
+            ASSERT_EQ(stats.deallocations.load(), deallocations + 1);
+        }
+
+        ASSERT_EQ(stats.bytes.load(), bytes);
+        ASSERT_EQ(stats.deallocations.load(), deallocations + 10);
+
+        // The stats of the tag are the ones of the registry
+        ASSERT_EQ(&MemAccounting::instance().tag("MemAccountingTest|entries"), &stats);
+    }
+
+    TEST_F(MemAccountingTest, DisabledAccountingCountsNothing)
+    {
+        MemAccounting::setEnabled(false);
+
+        auto &stats = MemAccountingAllocator<int, TestMemTag>::stats();
+        auto allocations = stats.allocations.load();
+
+        TestTable table;
+        table.emplace(1, "entry");
+
+        ASSERT_EQ(stats.allocations.load(), allocations);
+    }
+
+    TEST_F(MemAccountingTest, DumpPublishesToStateDb)
+    {
+        TestTable table;
+        table.emplace(1, "entry");
+
+        swss::DBConnector state_db("STATE_DB", 0);
+        MemAccounting::instance().dump(&state_db, "test");
+
+        swss::Table memory(&state_db, ORCHAGENT_MEMORY_TABLE);
+        string value;
+        ASSERT_TRUE(memory.hget("MemAccountingTest|entries", "bytes", value));
+        ASSERT_EQ(value, to_string(MemAccountingAllocator<int, TestMemTag>::stats().bytes.load()));
+        ASSERT_TRUE(memory.hget("MemAccountingTest|entries", "allocations", value));
+
+        ASSERT_TRUE(memory.hget(ORCHAGENT_MEMORY_HEAP_KEY, "allocator", value));
+        ASSERT_TRUE(memory.hget(ORCHAGENT_MEMORY_HEAP_KEY, "accounting", value));
+        ASSERT_EQ(value, "enabled");
+        ASSERT_TRUE(memory.hget(ORCHAGENT_MEMORY_HEAP_KEY, "heap_profile", value));
+    }
+}
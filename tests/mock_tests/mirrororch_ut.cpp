@@ -53,5 +53,36 @@ namespace mirrororch_test
         auto ret = gMirrorOrch->setUnsetPortMirror(dummyPort, /*ingress*/ false, /*set*/ true, /*sessionId*/ SAI_NULL_OBJECT_ID);
         ASSERT_FALSE(ret);
     }
+
+    TEST_F(MirrorOrchTest, IndexesSessionsByIpAndSourcePort)
+    {
+        ASSERT_NE(gMirrorOrch, nullptr);
+
+        MirrorEntry session("");
+        session.dstIp = IpAddress("10.0.0.1");
+        session.src_port = "Ethernet0,PortChannel1";
+        session.nexthopInfo.nexthop = NextHopKey("10.1.0.1", "Ethernet4");
+        gMirrorOrch->m_syncdMirrors.emplace("session1", session);
+        gMirrorOrch->indexSession("session1", session);
+
+        auto byIp = [](const IpAddress& ip) {
+            return [ip](const MirrorEntry& entry) {
+                return entry.dstIp == ip || entry.nexthopInfo.nexthop.ip_address == ip;
+            };
+        };
+        ASSERT_EQ(gMirrorOrch->findSessions(gMirrorOrch->m_ipSessions, IpAddress("10.0.0.1"), byIp(IpAddress("10.0.0.1"))).size(), 1);
+        ASSERT_EQ(gMirrorOrch->findSessions(gMirrorOrch->m_ipSessions, IpAddress("10.1.0.1"), byIp(IpAddress("10.1.0.1"))).size(), 1);
+        ASSERT_EQ(gMirrorOrch->m_srcPortSessions.count("PortChannel1"), 1);
+        ASSERT_EQ(gMirrorOrch->m_srcPortSessions.count("PortChannel10"), 0);
+
+        // The next hop moved, the old next hop no longer finds the session
+        gMirrorOrch->m_syncdMirrors.at("session1").nexthopInfo.nexthop = NextHopKey("10.2.0.1", "Ethernet8");
+        ASSERT_TRUE(gMirrorOrch->findSessions(gMirrorOrch->m_ipSessions, IpAddress("10.1.0.1"), byIp(IpAddress("10.1.0.1"))).empty());
+        ASSERT_EQ(gMirrorOrch->m_ipSessions.count(IpAddress("10.1.0.1")), 0);
+
+        // Removed sessions are dropped too
+        gMirrorOrch->m_syncdMirrors.erase("session1");
+        ASSERT_TRUE(gMirrorOrch->findSessions(gMirrorOrch->m_ipSessions, IpAddress("10.0.0.1"), byIp(IpAddress("10.0.0.1"))).empty());
+    }
 }
 
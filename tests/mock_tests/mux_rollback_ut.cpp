@@ -9,6 +9,7 @@
 #define protected public
 #include "neighorch.h"
 #include "muxorch.h"
+#include "routeorch.h"
 #undef protected
 #undef private
 #include "mock_orchagent_main.h"
@@ -44,6 +45,33 @@ namespace mux_rollback_test
     sai_bulk_set_route_entry_attribute_fn old_set_route_entries_attribute;
     sai_bulk_object_create_fn old_object_create;
     sai_bulk_object_remove_fn old_object_remove;
+    sai_bulk_set_route_entry_attribute_fn old_set_nh_route_entries_attribute;
+
+    // Route the RouteOrch route bulker fails to point at a new NH, by destination
+    bool _ut_stub_route_update_fails;
+    IpAddress _ut_stub_failing_route_ip;
+
+    sai_status_t _ut_stub_set_route_entries_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_route_entry_t *route_entry,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+            if (_ut_stub_route_update_fails &&
+                route_entry[i].destination.addr.ip4 == _ut_stub_failing_route_ip.getV4Addr())
+            {
+                object_statuses[i] = SAI_STATUS_TABLE_FULL;
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
 
     class MuxRollbackTest : public MockOrchTest
     {
@@ -173,6 +201,9 @@ namespace mux_rollback_test
             m_MuxCable->nbr_handler_->gRouteBulker.create_entries = mock_create_route_entries;
             m_MuxCable->nbr_handler_->gRouteBulker.remove_entries = mock_remove_route_entries;
             m_MuxCable->nbr_handler_->gRouteBulker.set_entries_attribute = mock_set_route_entries_attribute;
+            old_set_nh_route_entries_attribute = gRouteOrch->gRouteBulker.set_entries_attribute;
+            gRouteOrch->gRouteBulker.set_entries_attribute = _ut_stub_set_route_entries_attribute;
+            _ut_stub_route_update_fails = false;
         }
 
         void PreTearDown() override
@@ -189,6 +220,7 @@ namespace mux_rollback_test
             m_MuxCable->nbr_handler_->gRouteBulker.create_entries = old_create_route_entries;
             m_MuxCable->nbr_handler_->gRouteBulker.remove_entries = old_remove_route_entries;
             m_MuxCable->nbr_handler_->gRouteBulker.set_entries_attribute = old_set_route_entries_attribute;
+            gRouteOrch->gRouteBulker.set_entries_attribute = old_set_nh_route_entries_attribute;
         }
     };
 
@@ -442,4 +474,58 @@ namespace mux_rollback_test
             EXPECT_EQ(STANDBY_STATE, m_MuxCable->getState());
         }
     }
+
+    TEST_F(MuxRollbackTest, BatchedToggleRollsBackFailedCable)
+    {
+        m_MuxCableOrch->toggleCables({ { TEST_INTERFACE, ACTIVE_STATE } }, true);
+        EXPECT_EQ(ACTIVE_STATE, m_MuxCable->getState());
+
+        std::vector<sai_status_t> exp_status{SAI_STATUS_ITEM_NOT_FOUND};
+        EXPECT_CALL(*mock_sai_neighbor_api, remove_neighbor_entries)
+            .WillOnce(DoAll(SetArrayArgument<3>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_ITEM_NOT_FOUND)));
+        m_MuxCableOrch->toggleCables({ { TEST_INTERFACE, STANDBY_STATE } }, false);
+        EXPECT_EQ(STANDBY_STATE, m_MuxCable->getState());
+
+        std::vector<sai_status_t> full_status{SAI_STATUS_TABLE_FULL};
+        EXPECT_CALL(*mock_sai_next_hop_api, create_next_hops)
+            .WillOnce(DoAll(SetArrayArgument<6>(full_status.begin(), full_status.end()), Return(SAI_STATUS_TABLE_FULL)));
+        m_MuxCableOrch->toggleCables({ { TEST_INTERFACE, ACTIVE_STATE } }, true);
+        EXPECT_EQ(STANDBY_STATE, m_MuxCable->getState());
+    }
+
+    TEST_F(MuxRollbackTest, ActiveToStandbyRouteUpdateFailedRollbackToActive)
+    {
+        NextHopKey nh_key = NextHopKey(IpAddress(SERVER_IP1), VLAN_1000);
+        RouteKey route_1 = { gVirtualRouterId, IpPrefix("10.1.0.0/24") };
+        RouteKey route_2 = { gVirtualRouterId, IpPrefix("10.2.0.0/24") };
+
+        // Two single nexthop routes through the server neighbor
+        gRouteOrch->addNextHopRoute(nh_key, route_1);
+        gRouteOrch->addNextHopRoute(nh_key, route_2);
+
+        SetMuxStateFromAppDb(ACTIVE_STATE);
+        EXPECT_EQ(ACTIVE_STATE, m_MuxCable->getState());
+        ASSERT_TRUE(gNeighOrch->hasNextHop(nh_key));
+        int ref_count = gNeighOrch->getNextHopRefCount(nh_key);
+
+        // One route can't be moved to the tunnel, the toggle is rolled back
+        // and both routes are pointed at the neighbor again
+        _ut_stub_route_update_fails = true;
+        _ut_stub_failing_route_ip = IpAddress("10.2.0.0");
+        SetMuxStateFromAppDb(STANDBY_STATE);
+        EXPECT_EQ(ACTIVE_STATE, m_MuxCable->getState());
+
+        // The neighbor is referenced by the two routes only once
+        ASSERT_TRUE(gNeighOrch->hasNextHop(nh_key));
+        EXPECT_EQ(ref_count, gNeighOrch->getNextHopRefCount(nh_key));
+
+        // Once the routes move, nothing holds the neighbor back from being removed
+        _ut_stub_route_update_fails = false;
+        SetMuxStateFromAppDb(STANDBY_STATE);
+        EXPECT_EQ(STANDBY_STATE, m_MuxCable->getState());
+        EXPECT_FALSE(gNeighOrch->hasNextHop(nh_key));
+
+        gRouteOrch->removeNextHopRoute(nh_key, route_1);
+        gRouteOrch->removeNextHopRoute(nh_key, route_2);
+    }
 }
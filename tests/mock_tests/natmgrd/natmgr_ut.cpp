@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <map>
+#include "../mock_table.h"
+#include "warm_restart.h"
+#include "shellcmd.h"
+#define private public
+#include "natmgr.h"
+#undef private
+
+extern int (*callback)(const std::string &cmd, std::string &stdout);
+extern std::vector<std::string> mockCallArgs;
+
+/* Commands run through a pipe by NatMgr, with what was written to their stdin */
+static std::vector<std::pair<std::string, std::string>> pipedCmds;
+/* Exit codes of the piped commands, by command */
+static std::map<std::string, int> pipedCmdRcs;
+
+/*
+ * Wrap the pipes opened by NatMgr so that the commands and their input are
+ * recorded instead of being run, the input goes to a temporary file.
+ */
+extern "C" {
+
+FILE *__wrap_popen(const char *command, const char *type)
+{
+    pipedCmds.push_back({ command, "" });
+    return tmpfile();
+}
+
+int __wrap_pclose(FILE *stream)
+{
+    auto &cmd = pipedCmds.back();
+
+    rewind(stream);
+    for (int c = fgetc(stream); c != EOF; c = fgetc(stream))
+    {
+        cmd.second += (char)c;
+    }
+    fclose(stream);
+
+    /* Exit status as returned by waitpid() */
+    return pipedCmdRcs[cmd.first] << 8;
+}
+
+}
+
+int cb(const std::string &cmd, std::string &stdout)
+{
+    mockCallArgs.push_back(cmd);
+    return 0;
+}
+
+// Test Fixture
+namespace natmgr_ut
+{
+    struct NatMgrTest : public ::testing::Test
+    {
+        std::shared_ptr<swss::DBConnector> m_config_db;
+        std::shared_ptr<swss::DBConnector> m_app_db;
+        std::shared_ptr<swss::DBConnector> m_state_db;
+        std::shared_ptr<swss::NatMgr> m_natMgr;
+
+        const std::string m_restoreCmd = std::string(IPTABLES_RESTORE_CMD) + " --noflush";
+
+        virtual void SetUp() override
+        {
+            testing_db::reset();
+            m_config_db = std::make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_app_db = std::make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_state_db = std::make_shared<swss::DBConnector>("STATE_DB", 0);
+
+            swss::WarmStart::initialize("natmgrd", "nat");
+
+            mockCallArgs.clear();
+            pipedCmds.clear();
+            pipedCmdRcs.clear();
+            callback = cb;
+
+            std::vector<std::string> cfg_tables = {
+                CFG_STATIC_NAT_TABLE_NAME,
+                CFG_STATIC_NAPT_TABLE_NAME,
+                CFG_NAT_POOL_TABLE_NAME,
+                CFG_NAT_BINDINGS_TABLE_NAME,
+                CFG_NAT_GLOBAL_TABLE_NAME,
+            };
+            m_natMgr = std::make_shared<swss::NatMgr>(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_tables);
+            m_natMgr->m_natZoneInterfaceInfo["Ethernet0"] = "1";
+        }
+
+        void queueRules()
+        {
+            m_natMgr->setMangleIptablesRules("A", "Ethernet0", "1");
+            m_natMgr->setStaticNatIptablesRules("A", "Ethernet0", "65.55.45.1", "10.0.0.1", DNAT_NAT_TYPE);
+        }
+    };
+
+    TEST_F(NatMgrTest, RulesCommittedWithOneIptablesRestore)
+    {
+        queueRules();
+        m_natMgr->flush();
+
+        // The rules of the batch go in one transaction, grouped by table in first use order
+        ASSERT_EQ(pipedCmds.size(), 1);
+        ASSERT_EQ(pipedCmds[0].first, m_restoreCmd);
+        ASSERT_EQ(pipedCmds[0].second,
+                  "*mangle\n"
+                  "-A PREROUTING -i Ethernet0 -j MARK --set-mark 1\n"
+                  "-A POSTROUTING -o Ethernet0 -j MARK --set-mark 1\n"
+                  "COMMIT\n"
+                  "*nat\n"
+                  "-A PREROUTING  -m mark --mark 1 -j DNAT -d 65.55.45.1 --to-destination 10.0.0.1\n"
+                  "-A POSTROUTING  -m mark --mark 1 -j SNAT -s 10.0.0.1 --to-source 65.55.45.1\n"
+                  "COMMIT\n");
+        ASSERT_TRUE(mockCallArgs.empty());
+        ASSERT_TRUE(m_natMgr->m_iptablesCmds.empty());
+
+        // Nothing is left to commit
+        m_natMgr->flush();
+        ASSERT_EQ(pipedCmds.size(), 1);
+    }
+
+    TEST_F(NatMgrTest, RejectedRestoreReplaysTheRuleSets)
+    {
+        pipedCmdRcs[m_restoreCmd] = 1;
+
+        queueRules();
+        auto cmds = m_natMgr->m_iptablesCmds;
+        m_natMgr->flush();
+
+        // Nothing was applied by the transaction, each rule set is run on its own, in order
+        ASSERT_EQ(pipedCmds.size(), 1);
+        ASSERT_EQ(pipedCmds[0].first, m_restoreCmd);
+        ASSERT_EQ(mockCallArgs, cmds);
+        ASSERT_TRUE(m_natMgr->m_iptablesCmds.empty());
+    }
+
+    TEST_F(NatMgrTest, RuleWithoutTableIsRunOnItsOwn)
+    {
+        queueRules();
+        m_natMgr->queueIptablesCmds(std::string(IPTABLES_CMD) + " -F");
+        auto cmds = m_natMgr->m_iptablesCmds;
+        m_natMgr->flush();
+
+        // A command that can't be turned into an iptables-restore line skips the transaction
+        ASSERT_TRUE(pipedCmds.empty());
+        ASSERT_EQ(mockCallArgs, cmds);
+    }
+
+    TEST_F(NatMgrTest, ConntrackCommandsRunByOneShellAfterTheRules)
+    {
+        queueRules();
+        m_natMgr->updateDynamicSingleNatConnTrackTimeout("10.0.0.1", 300);
+        m_natMgr->flushAllNatEntries();
+        m_natMgr->flush();
+
+        ASSERT_EQ(pipedCmds.size(), 2);
+        ASSERT_EQ(pipedCmds[0].first, m_restoreCmd);
+        ASSERT_EQ(pipedCmds[1].first, BASH_CMD);
+        ASSERT_EQ(pipedCmds[1].second,
+                  std::string(CONNTRACK_CMD) + " -U -s 10.0.0.1 -t 300" + REDIRECT_TO_DEV_NULL + "\n" +
+                  CONNTRACK_CMD + FLUSH + "\n");
+        ASSERT_TRUE(mockCallArgs.empty());
+        ASSERT_TRUE(m_natMgr->m_conntrackCmds.empty());
+    }
+}
@@ -0,0 +1,369 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "natorch.h"
+#undef private
+#include "mock_orch_test.h"
+
+#include <tuple>
+
+namespace natorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    typedef tuple<int, uint32_t, uint32_t> HwNatKey;
+
+    sai_nat_api_t ut_sai_nat_api;
+    sai_nat_api_t *pold_sai_nat_api;
+
+    // NAT entries in the hardware, by type, source and destination ip
+    set<HwNatKey> _ut_stub_hw_nat_entries;
+    // Source ip whose create or remove fails
+    uint32_t _ut_stub_failing_src_ip;
+    // NAT entries whose hit bit is set
+    set<HwNatKey> _ut_stub_hit_nat_entries;
+    bool _ut_stub_bulk_get_supported;
+    uint32_t _ut_stub_bulk_create_calls;
+    uint32_t _ut_stub_bulk_remove_calls;
+    uint32_t _ut_stub_bulk_get_calls;
+    uint32_t _ut_stub_bulk_get_entries;
+    uint32_t _ut_stub_get_calls;
+
+    HwNatKey hwNatKey(const sai_nat_entry_t *nat_entry)
+    {
+        return make_tuple((int)nat_entry->nat_type, nat_entry->data.key.src_ip, nat_entry->data.key.dst_ip);
+    }
+
+    sai_status_t _ut_stub_sai_create_nat_entry(
+        _In_ const sai_nat_entry_t *nat_entry,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        if (nat_entry->data.key.src_ip == _ut_stub_failing_src_ip)
+        {
+            return SAI_STATUS_TABLE_FULL;
+        }
+        _ut_stub_hw_nat_entries.insert(hwNatKey(nat_entry));
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_sai_remove_nat_entry(
+        _In_ const sai_nat_entry_t *nat_entry)
+    {
+        if (nat_entry->data.key.src_ip == _ut_stub_failing_src_ip)
+        {
+            return SAI_STATUS_OBJECT_IN_USE;
+        }
+        _ut_stub_hw_nat_entries.erase(hwNatKey(nat_entry));
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_sai_create_nat_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_nat_entry_t *nat_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        _ut_stub_bulk_create_calls++;
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_sai_create_nat_entry(&nat_entry[i], attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_sai_remove_nat_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_nat_entry_t *nat_entry,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        _ut_stub_bulk_remove_calls++;
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_sai_remove_nat_entry(&nat_entry[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t getHitBit(const sai_nat_entry_t *nat_entry, sai_attribute_t *attr_list)
+    {
+        if (_ut_stub_hw_nat_entries.find(hwNatKey(nat_entry)) == _ut_stub_hw_nat_entries.end())
+        {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        // The hit bit is cleared on read
+        attr_list[0].value.booldata = _ut_stub_hit_nat_entries.erase(hwNatKey(nat_entry)) != 0;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_sai_get_nat_entry_attribute(
+        _In_ const sai_nat_entry_t *nat_entry,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list)
+    {
+        _ut_stub_get_calls++;
+        return getHitBit(nat_entry, attr_list);
+    }
+
+    sai_status_t _ut_stub_sai_get_nat_entries_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_nat_entry_t *nat_entry,
+        _In_ const uint32_t *attr_count,
+        _Inout_ sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        if (!_ut_stub_bulk_get_supported)
+        {
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+
+        _ut_stub_bulk_get_calls++;
+        _ut_stub_bulk_get_entries += object_count;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = getHitBit(&nat_entry[i], attr_list[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    class NatOrchTest : public MockOrchTest
+    {
+    protected:
+        NatOrch *m_natOrch = nullptr;
+
+        void PostSetUp() override
+        {
+            ut_sai_nat_api = *sai_nat_api;
+            pold_sai_nat_api = sai_nat_api;
+            ut_sai_nat_api.create_nat_entry = _ut_stub_sai_create_nat_entry;
+            ut_sai_nat_api.remove_nat_entry = _ut_stub_sai_remove_nat_entry;
+            ut_sai_nat_api.create_nat_entries = _ut_stub_sai_create_nat_entries;
+            ut_sai_nat_api.remove_nat_entries = _ut_stub_sai_remove_nat_entries;
+            ut_sai_nat_api.get_nat_entry_attribute = _ut_stub_sai_get_nat_entry_attribute;
+            ut_sai_nat_api.get_nat_entries_attribute = _ut_stub_sai_get_nat_entries_attribute;
+            sai_nat_api = &ut_sai_nat_api;
+
+            _ut_stub_hw_nat_entries.clear();
+            _ut_stub_failing_src_ip = 0;
+            _ut_stub_hit_nat_entries.clear();
+            _ut_stub_bulk_get_supported = true;
+            _ut_stub_bulk_create_calls = 0;
+            _ut_stub_bulk_remove_calls = 0;
+            _ut_stub_bulk_get_calls = 0;
+            _ut_stub_bulk_get_entries = 0;
+            _ut_stub_get_calls = 0;
+
+            // The NAT bulker takes the SAI API when the orch is created
+            vector<table_name_with_pri_t> nat_tables = {
+                { APP_NAT_DNAT_POOL_TABLE_NAME,  55 },
+                { APP_NAT_TABLE_NAME,            54 },
+                { APP_NAPT_TABLE_NAME,           53 },
+                { APP_NAT_TWICE_TABLE_NAME,      52 },
+                { APP_NAPT_TWICE_TABLE_NAME,     51 },
+                { APP_NAT_GLOBAL_TABLE_NAME,     50 }
+            };
+            m_natOrch = new NatOrch(m_app_db.get(), m_state_db.get(), nat_tables, gRouteOrch, gNeighOrch);
+            m_natOrch->admin_mode = "enabled";
+            m_natOrch->maxAllowedSNatEntries = 1024;
+        }
+
+        void PreTearDown() override
+        {
+            delete m_natOrch;
+            m_natOrch = nullptr;
+            sai_nat_api = pold_sai_nat_api;
+        }
+
+        void applyTwiceNat(const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            auto consumer = dynamic_cast<Consumer *>(m_natOrch->getExecutor(APP_NAT_TWICE_TABLE_NAME));
+            consumer->addToSync(entries);
+            m_natOrch->doTask(*consumer);
+        }
+
+        KeyOpFieldsValuesTuple twiceNatSet(const string &src, const string &dst, const string &type = "dynamic")
+        {
+            return { src + ":" + dst, SET_COMMAND, {
+                { "translated_src_ip", "14.14.14.14" },
+                { "translated_dst_ip", "12.12.12.12" },
+                { "entry_type", type }
+            } };
+        }
+
+        KeyOpFieldsValuesTuple twiceNatDel(const string &src, const string &dst)
+        {
+            return { src + ":" + dst, DEL_COMMAND, {} };
+        }
+
+        TwiceNatEntryKey twiceNatKey(const string &src, const string &dst)
+        {
+            TwiceNatEntryKey key;
+            key.src_ip = IpAddress(src);
+            key.dst_ip = IpAddress(dst);
+            return key;
+        }
+
+        bool inHw(const string &src, const string &dst)
+        {
+            return _ut_stub_hw_nat_entries.count(make_tuple((int)SAI_NAT_TYPE_DOUBLE_NAT,
+                        IpAddress(src).getV4Addr(), IpAddress(dst).getV4Addr())) != 0;
+        }
+
+        void setHit(const string &src, const string &dst)
+        {
+            _ut_stub_hit_nat_entries.insert(make_tuple((int)SAI_NAT_TYPE_DOUBLE_NAT,
+                        IpAddress(src).getV4Addr(), IpAddress(dst).getV4Addr()));
+        }
+    };
+
+    TEST_F(NatOrchTest, TwiceNatBulkCreateAndRemovePartialFailure)
+    {
+        _ut_stub_failing_src_ip = IpAddress("10.0.0.2").getV4Addr();
+
+        applyTwiceNat({
+            twiceNatSet("10.0.0.1", "20.0.0.1"),
+            twiceNatSet("10.0.0.2", "20.0.0.2"),
+            twiceNatSet("10.0.0.3", "20.0.0.3")
+        });
+
+        // The entries are created in one bulk, the failed one is left out of the hardware and of the totals
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        ASSERT_TRUE(inHw("10.0.0.1", "20.0.0.1"));
+        ASSERT_FALSE(inHw("10.0.0.2", "20.0.0.2"));
+        ASSERT_TRUE(inHw("10.0.0.3", "20.0.0.3"));
+        ASSERT_TRUE(m_natOrch->m_twiceNatEntries[twiceNatKey("10.0.0.1", "20.0.0.1")].addedToHw);
+        ASSERT_FALSE(m_natOrch->m_twiceNatEntries[twiceNatKey("10.0.0.2", "20.0.0.2")].addedToHw);
+        ASSERT_TRUE(m_natOrch->m_twiceNatEntries[twiceNatKey("10.0.0.3", "20.0.0.3")].addedToHw);
+        ASSERT_EQ(m_natOrch->totalDynamicTwiceNatEntries, 2);
+        ASSERT_EQ(m_natOrch->totalSnatEntries, 2);
+        ASSERT_EQ(m_natOrch->totalDnatEntries, 2);
+        ASSERT_EQ(m_natOrch->totalEntries, 4);
+        ASSERT_TRUE(m_natOrch->m_natBulkOps.empty());
+        ASSERT_FALSE(m_natOrch->m_natBulkMode);
+
+        // Removing the entry not in the hardware is skipped, the others are removed in one bulk
+        applyTwiceNat({
+            twiceNatDel("10.0.0.1", "20.0.0.1"),
+            twiceNatDel("10.0.0.2", "20.0.0.2"),
+            twiceNatDel("10.0.0.3", "20.0.0.3")
+        });
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 1);
+        ASSERT_TRUE(_ut_stub_hw_nat_entries.empty());
+        ASSERT_TRUE(m_natOrch->m_twiceNatEntries.empty());
+        ASSERT_EQ(m_natOrch->totalDynamicTwiceNatEntries, 0);
+        ASSERT_EQ(m_natOrch->totalEntries, 0);
+
+        // An entry whose removal failed is not counted out
+        _ut_stub_failing_src_ip = 0;
+        applyTwiceNat({
+            twiceNatSet("10.0.0.1", "20.0.0.1"),
+            twiceNatSet("10.0.0.2", "20.0.0.2")
+        });
+        ASSERT_EQ(m_natOrch->totalDynamicTwiceNatEntries, 2);
+
+        _ut_stub_failing_src_ip = IpAddress("10.0.0.2").getV4Addr();
+        applyTwiceNat({
+            twiceNatDel("10.0.0.1", "20.0.0.1"),
+            twiceNatDel("10.0.0.2", "20.0.0.2")
+        });
+        ASSERT_FALSE(inHw("10.0.0.1", "20.0.0.1"));
+        ASSERT_TRUE(inHw("10.0.0.2", "20.0.0.2"));
+        ASSERT_EQ(m_natOrch->totalDynamicTwiceNatEntries, 1);
+        ASSERT_EQ(m_natOrch->totalEntries, 2);
+    }
+
+    TEST_F(NatOrchTest, TwiceNatRollbackOnFailedCreate)
+    {
+        applyTwiceNat({ twiceNatSet("10.0.0.1", "20.0.0.1") });
+        ASSERT_EQ(m_natOrch->totalEntries, 2);
+
+        // A re-add in the same task waits for the removal, then fails: nothing of it is accounted
+        _ut_stub_failing_src_ip = IpAddress("10.0.0.1").getV4Addr();
+        applyTwiceNat({
+            twiceNatDel("10.0.0.1", "20.0.0.1"),
+            twiceNatSet("10.0.0.1", "20.0.0.1", "static")
+        });
+        ASSERT_FALSE(inHw("10.0.0.1", "20.0.0.1"));
+        auto &entry = m_natOrch->m_twiceNatEntries[twiceNatKey("10.0.0.1", "20.0.0.1")];
+        ASSERT_FALSE(entry.addedToHw);
+        ASSERT_EQ(entry.entry_type, "static");
+        ASSERT_EQ(m_natOrch->totalDynamicTwiceNatEntries, 0);
+        ASSERT_EQ(m_natOrch->totalStaticTwiceNatEntries, 0);
+        ASSERT_EQ(m_natOrch->totalSnatEntries, 0);
+        ASSERT_EQ(m_natOrch->totalDnatEntries, 0);
+        ASSERT_EQ(m_natOrch->totalEntries, 0);
+
+        // Removed and added again in one task, the re-add isn't dropped by the deferred bookkeeping
+        _ut_stub_failing_src_ip = 0;
+        applyTwiceNat({ twiceNatDel("10.0.0.1", "20.0.0.1") });
+        applyTwiceNat({ twiceNatSet("10.0.0.1", "20.0.0.1") });
+        applyTwiceNat({
+            twiceNatDel("10.0.0.1", "20.0.0.1"),
+            twiceNatSet("10.0.0.1", "20.0.0.1", "static")
+        });
+        ASSERT_TRUE(inHw("10.0.0.1", "20.0.0.1"));
+        ASSERT_TRUE(m_natOrch->m_twiceNatEntries[twiceNatKey("10.0.0.1", "20.0.0.1")].addedToHw);
+        ASSERT_EQ(m_natOrch->totalDynamicTwiceNatEntries, 0);
+        ASSERT_EQ(m_natOrch->totalStaticTwiceNatEntries, 1);
+        ASSERT_EQ(m_natOrch->totalEntries, 2);
+    }
+
+    TEST_F(NatOrchTest, HitBitAging)
+    {
+        applyTwiceNat({
+            twiceNatSet("10.0.0.1", "20.0.0.1"),
+            twiceNatSet("10.0.0.2", "20.0.0.2"),
+            twiceNatSet("10.0.0.3", "20.0.0.3", "static")
+        });
+
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        time_t aged = now.tv_sec - m_natOrch->timeout - 1;
+        for (auto &entry : m_natOrch->m_twiceNatEntries)
+        {
+            entry.second.activeTime = aged;
+        }
+
+        // The hit bits of the dynamic entries are read in one bulk, static entries are always active
+        setHit("10.0.0.1", "20.0.0.1");
+        m_natOrch->queryHitBits();
+        ASSERT_EQ(_ut_stub_bulk_get_calls, 1);
+        ASSERT_EQ(_ut_stub_bulk_get_entries, 2);
+        ASSERT_EQ(_ut_stub_get_calls, 0);
+        ASSERT_GE(m_natOrch->m_twiceNatEntries[twiceNatKey("10.0.0.1", "20.0.0.1")].activeTime, now.tv_sec);
+        ASSERT_EQ(m_natOrch->m_twiceNatEntries[twiceNatKey("10.0.0.2", "20.0.0.2")].activeTime, aged);
+        ASSERT_GE(m_natOrch->m_twiceNatEntries[twiceNatKey("10.0.0.3", "20.0.0.3")].activeTime, now.tv_sec);
+        ASSERT_TRUE(m_natOrch->m_hitBits.empty());
+        ASSERT_TRUE(m_natOrch->m_hitBitQueries.empty());
+        ASSERT_TRUE(m_natOrch->m_hitBitWalk.done());
+
+        // Without bulk get support the entries are read one at a time
+        _ut_stub_bulk_get_supported = false;
+        setHit("10.0.0.2", "20.0.0.2");
+        m_natOrch->queryHitBits();
+        ASSERT_FALSE(m_natOrch->m_bulkGetSupported);
+        ASSERT_EQ(_ut_stub_bulk_get_calls, 1);
+        ASSERT_EQ(_ut_stub_get_calls, 2);
+        ASSERT_GE(m_natOrch->m_twiceNatEntries[twiceNatKey("10.0.0.2", "20.0.0.2")].activeTime, now.tv_sec);
+    }
+}
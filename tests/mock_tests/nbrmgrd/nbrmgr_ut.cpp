@@ -6,7 +6,9 @@
 #include "../mock_table.h"
 #include "warm_restart.h"
 #define private public
+#define protected public
 #include "nbrmgr.h"
+#undef protected
 #undef private
 
 extern int (*callback)(const std::string &cmd, std::string &stdout);
@@ -41,6 +43,35 @@ int __wrap_nl_send_auto(struct nl_sock *sk, struct nl_msg *msg)
     return 0;
 }
 
+void __wrap_nl_socket_free(struct nl_sock *sk)
+{
+}
+
+int __wrap_nl_wait_for_ack(struct nl_sock *sk)
+{
+    return 0;
+}
+
+int __wrap_nl_socket_get_fd(const struct nl_sock *sk)
+{
+    return -1;
+}
+
+/* Batched resolve requests, one entry per datagram with its number of requests */
+static std::vector<size_t> resolveBatches;
+
+int __wrap_nl_sendto(struct nl_sock *sk, void *buf, size_t size)
+{
+    size_t requests = 0;
+    int len = static_cast<int>(size);
+    for (auto hdr = static_cast<struct nlmsghdr *>(buf); NLMSG_OK(hdr, len); hdr = NLMSG_NEXT(hdr, len))
+    {
+        requests++;
+    }
+    resolveBatches.push_back(requests);
+    return static_cast<int>(size);
+}
+
 /* Control whether nlmsg_alloc returns NULL to simulate setNeighbor failure */
 static bool mock_nlmsg_alloc_fail = false;
 
@@ -87,6 +118,7 @@ namespace nbrmgr_ut
 
             mockCallArgs.clear();
             neighResolvedKeys.clear();
+            resolveBatches.clear();
             mock_nlmsg_alloc_fail = false;
             callback = noop_cb;
         }
@@ -201,4 +233,59 @@ namespace nbrmgr_ut
         /* Should not crash; failures are logged as warnings */
         swss::NbrMgr nbrmgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_nbr_tables);
     }
+
+    /*
+     * Test that the entries reconciled at startup are sent to the kernel
+     * as one batch.
+     */
+    TEST_F(NbrMgrTest, ReconcileBatchesResolves)
+    {
+        std::vector<std::string> cfg_nbr_tables = {CFG_NEIGH_TABLE_NAME};
+
+        swss::Table neighResolveTable(m_app_db.get(), APP_NEIGH_RESOLVE_TABLE_NAME);
+        std::vector<swss::FieldValueTuple> fvs;
+        neighResolveTable.set("Ethernet0:10.0.0.1", fvs);
+        neighResolveTable.set("Ethernet4:10.0.0.3", fvs);
+        neighResolveTable.set("Ethernet8:2000::2", fvs);
+
+        swss::NbrMgr nbrmgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_nbr_tables);
+
+        ASSERT_EQ(resolveBatches.size(), 1u);
+        ASSERT_EQ(resolveBatches[0], 3u);
+    }
+
+    /*
+     * Test that the resolve requests above the resolve rate are held back
+     * and that the rate is raised while requests are held back.
+     */
+    TEST_F(NbrMgrTest, ResolveRateLimit)
+    {
+        std::vector<std::string> cfg_nbr_tables = {CFG_NEIGH_TABLE_NAME};
+
+        swss::NbrMgr nbrmgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_nbr_tables);
+        auto consumer = dynamic_cast<Consumer *>(nbrmgr.getExecutor(APP_NEIGH_RESOLVE_TABLE_NAME));
+        ASSERT_NE(consumer, nullptr);
+
+        std::vector<swss::FieldValueTuple> fvs;
+        consumer->addToSync(swss::KeyOpFieldsValuesTuple("Ethernet0:10.0.0.1", SET_COMMAND, fvs));
+        consumer->addToSync(swss::KeyOpFieldsValuesTuple("Ethernet0:10.0.0.2", SET_COMMAND, fvs));
+        consumer->addToSync(swss::KeyOpFieldsValuesTuple("Ethernet0:10.0.0.3", SET_COMMAND, fvs));
+
+        nbrmgr.m_resolveRate = NBR_RESOLVE_RATE_MIN;
+        nbrmgr.m_resolveTokens = 1;
+        nbrmgr.doResolveNeighTask(*consumer);
+
+        ASSERT_EQ(resolveBatches.size(), 1u);
+        ASSERT_EQ(resolveBatches[0], 1u);
+        ASSERT_EQ(consumer->m_toSync.size(), 2u);
+        ASSERT_TRUE(nbrmgr.hasPendingResolves());
+        ASSERT_GT(nbrmgr.m_resolveRate, NBR_RESOLVE_RATE_MIN);
+
+        nbrmgr.m_resolveTokens = NBR_RESOLVE_RATE_MIN;
+        nbrmgr.doResolveNeighTask(*consumer);
+
+        ASSERT_EQ(resolveBatches.size(), 2u);
+        ASSERT_EQ(resolveBatches[1], 2u);
+        ASSERT_FALSE(nbrmgr.hasPendingResolves());
+    }
 }
@@ -29,6 +29,67 @@ namespace neighorch_test
     static const NeighborEntry VLAN3000_NEIGH = NeighborEntry(TEST_IP, VLAN_3000);
     static const NeighborEntry VLAN4000_NEIGH = NeighborEntry(TEST_IP, VLAN_4000);
 
+    sai_next_hop_api_t ut_sai_next_hop_api;
+    sai_next_hop_api_t *pold_sai_next_hop_api;
+
+    // Neighbor the SAI fails to create in a bulk, by IP
+    string _ut_stub_failing_neighbor_ip;
+    uint32_t _ut_stub_next_hop_bulk_create_calls;
+    set<sai_object_id_t> _ut_stub_removed_next_hops;
+
+    sai_status_t _ut_stub_create_neighbor_entries(CREATE_BULK_PARAMS(neighbor))
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            if (!_ut_stub_failing_neighbor_ip.empty() &&
+                neighbor_entry[i].ip_address.addr.ip4 == IpAddress(_ut_stub_failing_neighbor_ip).getV4Addr())
+            {
+                object_statuses[i] = SAI_STATUS_TABLE_FULL;
+            }
+            else
+            {
+                object_statuses[i] = old_sai_neighbor_api->create_neighbor_entry(&neighbor_entry[i], attr_count[i], attr_list[i]);
+            }
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_create_next_hops(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_next_hop_bulk_create_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = sai_next_hop_api->create_next_hop(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_remove_next_hop(
+        _In_ sai_object_id_t next_hop_id)
+    {
+        _ut_stub_removed_next_hops.insert(next_hop_id);
+        return pold_sai_next_hop_api->remove_next_hop(next_hop_id);
+    }
+
     class NeighOrchTest : public MockOrchTest
     {
     protected:
@@ -277,4 +338,145 @@ namespace neighorch_test
         /* Literal "usb0" can overload-resolve to NextHopKey(str, bool overlay) vs (str, str). */
         ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(NeighborEntry(TEST_IP, std::string("usb0"))), 0);
     }
+
+    /*
+     * Remote neighbors learned from the chassis are created in bulk. Vlan1000
+     * stands in for the interface of a remote system port and Ethernet8 for
+     * the inband port that carries their next hops.
+     */
+    class NeighOrchVoqTest : public NeighOrchTest
+    {
+    protected:
+        unique_ptr<Consumer> m_consumer;
+
+        void PostSetUp() override
+        {
+            NeighOrchTest::PostSetUp();
+
+            ut_sai_next_hop_api = *sai_next_hop_api;
+            pold_sai_next_hop_api = sai_next_hop_api;
+            ut_sai_next_hop_api.remove_next_hop = _ut_stub_remove_next_hop;
+            sai_next_hop_api = &ut_sai_next_hop_api;
+
+            _ut_stub_failing_neighbor_ip.clear();
+            _ut_stub_next_hop_bulk_create_calls = 0;
+            _ut_stub_removed_next_hops.clear();
+
+            gNeighOrch->gNeighBulker.create_entries = mock_create_neighbor_entries;
+            gNeighOrch->gNextHopBulker.create_entries = _ut_stub_create_next_hops;
+
+            gNeighOrch->m_stateSystemNeighPipeline = make_unique<RedisPipeline>(m_state_db.get());
+            gNeighOrch->m_stateSystemNeighTable = make_unique<Table>(
+                gNeighOrch->m_stateSystemNeighPipeline.get(), STATE_SYSTEM_NEIGH_TABLE_NAME, true);
+
+            gPortsOrch->m_inbandPortName = ETHERNET8;
+            gPortsOrch->m_portList[ETHERNET8].m_admin_state_up = true;
+            gPortsOrch->m_portList[ETHERNET8].m_oper_status = SAI_PORT_OPER_STATUS_UP;
+            gPortsOrch->m_portList[VLAN_1000].m_system_port_info.type = SAI_SYSTEM_PORT_TYPE_REMOTE;
+
+            m_consumer = unique_ptr<Consumer>(new Consumer(
+                new ConsumerStateTable(m_chassis_app_db.get(), CHASSIS_APP_SYSTEM_NEIGH_TABLE_NAME, 1, 1),
+                gNeighOrch, CHASSIS_APP_SYSTEM_NEIGH_TABLE_NAME));
+        }
+
+        void PreTearDown() override
+        {
+            m_consumer.reset();
+            sai_next_hop_api = pold_sai_next_hop_api;
+            NeighOrchTest::PreTearDown();
+        }
+
+        void applySystemNeighbors(const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            m_consumer->addToSync(entries);
+            gNeighOrch->doVoqSystemNeighTask(*m_consumer);
+        }
+
+        KeyOpFieldsValuesTuple systemNeighSet(const string &ip, const string &mac, const string &encap_index)
+        {
+            string key = VLAN_1000 + m_consumer->getConsumerTable()->getTableNameSeparator() + ip;
+            return { key, SET_COMMAND, { { "neigh", mac }, { "encap_index", encap_index } } };
+        }
+
+        bool systemNeighStateExists(const string &ip)
+        {
+            Table state_table(m_state_db.get(), STATE_SYSTEM_NEIGH_TABLE_NAME);
+            vector<FieldValueTuple> values;
+            return state_table.get(VLAN_1000 + "|" + ip, values);
+        }
+
+        bool systemNeighExists(const string &ip)
+        {
+            return gNeighOrch->m_syncdNeighbors.count(NeighborEntry(ip, VLAN_1000)) == 1 &&
+                   gNeighOrch->hasNextHop(NextHopKey(ip, ETHERNET8));
+        }
+    };
+
+    TEST_F(NeighOrchVoqTest, BulkCreateFailedInTheMiddle)
+    {
+        _ut_stub_failing_neighbor_ip = "192.168.0.11";
+
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry).Times(0);
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries)
+            .Times(2)
+            .WillRepeatedly(_ut_stub_create_neighbor_entries);
+
+        applySystemNeighbors({
+            systemNeighSet("192.168.0.10", MAC1, "10"),
+            systemNeighSet("192.168.0.11", MAC2, "11"),
+            systemNeighSet("192.168.0.12", MAC3, "12")
+        });
+
+        // The next hops of the round go in one bulk as well
+        ASSERT_EQ(_ut_stub_next_hop_bulk_create_calls, 1);
+
+        // The others are created with their next hop on the inband port and get their state
+        for (auto neigh : { make_pair(string("192.168.0.10"), 10u), make_pair(string("192.168.0.12"), 12u) })
+        {
+            ASSERT_TRUE(systemNeighExists(neigh.first));
+            ASSERT_TRUE(systemNeighStateExists(neigh.first));
+            ASSERT_EQ(gNeighOrch->m_syncdNeighbors[NeighborEntry(neigh.first, VLAN_1000)].voq_encap_index, neigh.second);
+        }
+
+        // The failed one leaves no next hop behind and its task is kept for the retry
+        ASSERT_EQ(gNeighOrch->m_syncdNeighbors.count(NeighborEntry(string("192.168.0.11"), VLAN_1000)), 0);
+        ASSERT_FALSE(gNeighOrch->hasNextHop(NextHopKey(string("192.168.0.11"), ETHERNET8)));
+        ASSERT_FALSE(systemNeighStateExists("192.168.0.11"));
+        ASSERT_EQ(_ut_stub_removed_next_hops.size(), 1);
+        ASSERT_EQ(_ut_stub_removed_next_hops.count(SAI_NULL_OBJECT_ID), 0);
+        ASSERT_EQ(m_consumer->m_toSync.size(), 1);
+
+        // The retry creates it
+        _ut_stub_failing_neighbor_ip.clear();
+        gNeighOrch->doVoqSystemNeighTask(*m_consumer);
+
+        ASSERT_TRUE(systemNeighExists("192.168.0.11"));
+        ASSERT_TRUE(systemNeighStateExists("192.168.0.11"));
+        ASSERT_EQ(_ut_stub_next_hop_bulk_create_calls, 2);
+        ASSERT_EQ(_ut_stub_removed_next_hops.size(), 1);
+        ASSERT_TRUE(m_consumer->m_toSync.empty());
+    }
+
+    TEST_F(NeighOrchVoqTest, BulkNotSupportedFallsBackToSingleCalls)
+    {
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entries).WillOnce(Return(SAI_STATUS_NOT_SUPPORTED));
+        EXPECT_CALL(*mock_sai_neighbor_api, create_neighbor_entry).Times(3);
+
+        applySystemNeighbors({
+            systemNeighSet("192.168.0.10", MAC1, "10"),
+            systemNeighSet("192.168.0.11", MAC2, "11"),
+            systemNeighSet("192.168.0.12", MAC3, "12")
+        });
+
+        // Nothing was created by the bulk, the queued next hops are dropped and created one by one
+        ASSERT_EQ(_ut_stub_next_hop_bulk_create_calls, 0);
+        ASSERT_TRUE(_ut_stub_removed_next_hops.empty());
+
+        for (auto ip : { "192.168.0.10", "192.168.0.11", "192.168.0.12" })
+        {
+            ASSERT_TRUE(systemNeighExists(ip));
+            ASSERT_TRUE(systemNeighStateExists(ip));
+        }
+        ASSERT_TRUE(m_consumer->m_toSync.empty());
+    }
 }
@@ -0,0 +1,259 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "vxlanorch.h"
+#include "nvgreorch.h"
+#undef private
+#include "mock_orch_test.h"
+
+namespace nvgreorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    static const string NVGRE_TUNNEL = "tunnel_1";
+
+    sai_tunnel_api_t ut_sai_tunnel_api;
+    sai_tunnel_api_t *pold_sai_tunnel_api;
+
+    sai_object_id_t _ut_stub_next_oid;
+    set<sai_object_id_t> _ut_stub_map_entries;
+    // Map entries the SAI fails to create, by VSID, and to remove, by id
+    uint32_t _ut_stub_failing_vsid;
+    sai_object_id_t _ut_stub_failing_map_entry_id;
+    uint32_t _ut_stub_bulk_create_calls;
+    uint32_t _ut_stub_bulk_remove_calls;
+
+    sai_status_t _ut_stub_create_object(
+        _Out_ sai_object_id_t *object_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        *object_id = ++_ut_stub_next_oid;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_remove_object(
+        _In_ sai_object_id_t object_id)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_create_tunnel_map_entries(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_create_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+            for (uint32_t j = 0; j < attr_count[i]; j++)
+            {
+                if (attr_list[i][j].id == SAI_TUNNEL_MAP_ENTRY_ATTR_VSID_ID_KEY &&
+                    attr_list[i][j].value.u32 == _ut_stub_failing_vsid)
+                {
+                    object_statuses[i] = SAI_STATUS_TABLE_FULL;
+                    status = SAI_STATUS_FAILURE;
+                }
+            }
+
+            if (object_statuses[i] == SAI_STATUS_SUCCESS)
+            {
+                object_id[i] = ++_ut_stub_next_oid;
+                _ut_stub_map_entries.insert(object_id[i]);
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_remove_tunnel_map_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_remove_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            if (object_id[i] == _ut_stub_failing_map_entry_id)
+            {
+                object_statuses[i] = SAI_STATUS_OBJECT_IN_USE;
+                status = SAI_STATUS_FAILURE;
+                continue;
+            }
+
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+            _ut_stub_map_entries.erase(object_id[i]);
+        }
+        return status;
+    }
+
+    class NvgreOrchTest : public MockOrchTest
+    {
+    protected:
+        NvgreTunnelOrch *m_nvgreTunnelOrch;
+        NvgreTunnelMapOrch *m_nvgreTunnelMapOrch;
+
+        void ApplyInitialConfigs()
+        {
+            Table port_table = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+            Table vlan_table = Table(m_app_db.get(), APP_VLAN_TABLE_NAME);
+
+            auto ports = ut_helper::getInitialSaiPorts();
+            port_table.set(ETHERNET0, ports[ETHERNET0]);
+            port_table.set("PortConfigDone", { { "count", to_string(1) } });
+            port_table.set("PortInitDone", { {} });
+
+            vlan_table.set(VLAN_1000, { { "admin_status", "up" } });
+            vlan_table.set(VLAN_2000, { { "admin_status", "up" } });
+            vlan_table.set(VLAN_3000, { { "admin_status", "up" } });
+
+            gPortsOrch->addExistingData(&port_table);
+            gPortsOrch->addExistingData(&vlan_table);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+        }
+
+        void PostSetUp() override
+        {
+            ut_sai_tunnel_api = *sai_tunnel_api;
+            pold_sai_tunnel_api = sai_tunnel_api;
+            ut_sai_tunnel_api.create_tunnel_map = _ut_stub_create_object;
+            ut_sai_tunnel_api.remove_tunnel_map = _ut_stub_remove_object;
+            ut_sai_tunnel_api.create_tunnel = _ut_stub_create_object;
+            ut_sai_tunnel_api.remove_tunnel = _ut_stub_remove_object;
+            ut_sai_tunnel_api.create_tunnel_term_table_entry = _ut_stub_create_object;
+            ut_sai_tunnel_api.remove_tunnel_term_table_entry = _ut_stub_remove_object;
+            sai_tunnel_api = &ut_sai_tunnel_api;
+
+            _ut_stub_next_oid = 0x1000;
+            _ut_stub_map_entries.clear();
+            _ut_stub_failing_vsid = 0;
+            _ut_stub_failing_map_entry_id = SAI_NULL_OBJECT_ID;
+            _ut_stub_bulk_create_calls = 0;
+            _ut_stub_bulk_remove_calls = 0;
+
+            m_nvgreTunnelOrch = new NvgreTunnelOrch(m_config_db.get(), CFG_NVGRE_TUNNEL_TABLE_NAME);
+            gDirectory.set(m_nvgreTunnelOrch);
+            m_nvgreTunnelMapOrch = new NvgreTunnelMapOrch(m_config_db.get(), CFG_NVGRE_TUNNEL_MAP_TABLE_NAME);
+            gDirectory.set(m_nvgreTunnelMapOrch);
+
+            auto &bulker = m_nvgreTunnelMapOrch->map_entry_bulker_.bulker_;
+            bulker.create_entries = _ut_stub_create_tunnel_map_entries;
+            bulker.remove_entries = _ut_stub_remove_tunnel_map_entries;
+
+            auto consumer = dynamic_cast<Consumer *>(m_nvgreTunnelOrch->getExecutor(CFG_NVGRE_TUNNEL_TABLE_NAME));
+            consumer->addToSync({ { NVGRE_TUNNEL, SET_COMMAND, { { "src_ip", "10.0.0.1" } } } });
+            static_cast<Orch *>(m_nvgreTunnelOrch)->doTask();
+        }
+
+        void PreTearDown() override
+        {
+            // The tunnels are removed through the stubs
+            delete m_nvgreTunnelMapOrch;
+            delete m_nvgreTunnelOrch;
+            sai_tunnel_api = pold_sai_tunnel_api;
+        }
+
+        NvgreTunnel *getTunnel()
+        {
+            return m_nvgreTunnelOrch->getNvgreTunnel(NVGRE_TUNNEL);
+        }
+
+        void applyTunnelMaps(const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            auto consumer = dynamic_cast<Consumer *>(m_nvgreTunnelMapOrch->getExecutor(CFG_NVGRE_TUNNEL_MAP_TABLE_NAME));
+            consumer->addToSync(entries);
+            static_cast<Orch *>(m_nvgreTunnelMapOrch)->doTask();
+        }
+
+        KeyOpFieldsValuesTuple mapSet(const string &name, const string &vsid, const string &vlan_id)
+        {
+            return { NVGRE_TUNNEL + "|" + name, SET_COMMAND, { { "vsid", vsid }, { "vlan_id", vlan_id } } };
+        }
+
+        KeyOpFieldsValuesTuple mapDel(const string &name)
+        {
+            return { NVGRE_TUNNEL + "|" + name, DEL_COMMAND, {} };
+        }
+    };
+
+    TEST_F(NvgreOrchTest, BulkCreateFailedInTheMiddle)
+    {
+        ASSERT_TRUE(m_nvgreTunnelOrch->isTunnelExists(NVGRE_TUNNEL));
+
+        _ut_stub_failing_vsid = 2000;
+        applyTunnelMaps({
+            mapSet("map_1000", "1000", VLAN_1000),
+            mapSet("map_2000", "2000", VLAN_2000),
+            mapSet("map_3000", "3000", VLAN_3000)
+        });
+
+        // The entries of the batch go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        ASSERT_EQ(_ut_stub_map_entries.size(), 2);
+
+        // The failed entry is forgotten, the others get their ids
+        auto tunnel = getTunnel();
+        ASSERT_FALSE(tunnel->isTunnelMapExists(NVGRE_TUNNEL + "|map_2000"));
+        ASSERT_EQ(_ut_stub_map_entries.count(tunnel->getMapEntryId(NVGRE_TUNNEL + "|map_1000")), 1);
+        ASSERT_EQ(_ut_stub_map_entries.count(tunnel->getMapEntryId(NVGRE_TUNNEL + "|map_3000")), 1);
+
+        // Setting the failed entry again retries it
+        _ut_stub_failing_vsid = 0;
+        applyTunnelMaps({ mapSet("map_2000", "2000", VLAN_2000) });
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 2);
+        ASSERT_EQ(_ut_stub_map_entries.size(), 3);
+        ASSERT_EQ(_ut_stub_map_entries.count(tunnel->getMapEntryId(NVGRE_TUNNEL + "|map_2000")), 1);
+    }
+
+    TEST_F(NvgreOrchTest, BulkRemoveFailedInTheMiddle)
+    {
+        applyTunnelMaps({
+            mapSet("map_1000", "1000", VLAN_1000),
+            mapSet("map_2000", "2000", VLAN_2000),
+            mapSet("map_3000", "3000", VLAN_3000)
+        });
+        ASSERT_EQ(_ut_stub_map_entries.size(), 3);
+
+        auto tunnel = getTunnel();
+        auto failing_id = tunnel->getMapEntryId(NVGRE_TUNNEL + "|map_2000");
+        _ut_stub_failing_map_entry_id = failing_id;
+
+        applyTunnelMaps({
+            mapDel("map_1000"),
+            mapDel("map_2000"),
+            mapDel("map_3000")
+        });
+
+        // The entries of the batch go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 1);
+
+        // The entry that is still in the SAI is kept with its id
+        ASSERT_EQ(_ut_stub_map_entries.size(), 1);
+        ASSERT_FALSE(tunnel->isTunnelMapExists(NVGRE_TUNNEL + "|map_1000"));
+        ASSERT_FALSE(tunnel->isTunnelMapExists(NVGRE_TUNNEL + "|map_3000"));
+        ASSERT_TRUE(tunnel->isTunnelMapExists(NVGRE_TUNNEL + "|map_2000"));
+        ASSERT_EQ(tunnel->getMapEntryId(NVGRE_TUNNEL + "|map_2000"), failing_id);
+
+        // Deleting it again retries the removal
+        _ut_stub_failing_map_entry_id = SAI_NULL_OBJECT_ID;
+        applyTunnelMaps({ mapDel("map_2000") });
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 2);
+        ASSERT_TRUE(_ut_stub_map_entries.empty());
+        ASSERT_TRUE(tunnel->nvgre_tunnel_map_table_.empty());
+    }
+}
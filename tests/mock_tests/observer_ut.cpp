@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include "logger.h"
+#include "observer.h"
+
+#include <string>
+
+namespace observer_test
+{
+    using namespace std;
+
+    struct TestEvent
+    {
+        string key;
+        int value;
+    };
+
+    using TestBus = EventBus<string, TestEvent>;
+
+    struct TestSubscriber : public EventSubscriber<TestEvent>
+    {
+        vector<vector<TestEvent>> batches;
+        TestBus *republish = nullptr;
+
+        void onEvents(const vector<TestEvent> &events) override
+        {
+            batches.push_back(events);
+            if (republish)
+            {
+                republish->publish({ "republished", 0 });
+            }
+        }
+    };
+
+    TestBus makeBus()
+    {
+        return TestBus([](const TestEvent &event) { return event.key; });
+    }
+
+    TEST(EventBusTest, DeliversRightAwayOutsideOfBatch)
+    {
+        auto bus = makeBus();
+        TestSubscriber subscriber;
+        bus.subscribe(&subscriber);
+
+        bus.publish({ "a", 1 });
+        ASSERT_EQ(subscriber.batches.size(), 1u);
+        ASSERT_EQ(subscriber.batches[0].size(), 1u);
+
+        bus.unsubscribe(&subscriber);
+        bus.publish({ "a", 2 });
+        ASSERT_EQ(subscriber.batches.size(), 1u);
+    }
+
+    TEST(EventBusTest, CoalescesByKeyWithinBatch)
+    {
+        auto bus = makeBus();
+        TestSubscriber subscriber;
+        bus.subscribe(&subscriber);
+
+        {
+            EventBatch outer;
+            bus.publish({ "a", 1 });
+            {
+                EventBatch inner;
+                bus.publish({ "b", 2 });
+            }
+            bus.publish({ "a", 3 });
+
+            // Nothing is delivered before the outermost batch is closed
+            ASSERT_TRUE(subscriber.batches.empty());
+            ASSERT_EQ(bus.getPendingCount(), 2u);
+        }
+
+        ASSERT_EQ(subscriber.batches.size(), 1u);
+        auto &events = subscriber.batches[0];
+        ASSERT_EQ(events.size(), 2u);
+        ASSERT_EQ(events[0].key, "a");
+        ASSERT_EQ(events[0].value, 3);
+        ASSERT_EQ(events[1].key, "b");
+        ASSERT_EQ(bus.getPendingCount(), 0u);
+    }
+
+    TEST(EventBusTest, QueuesEventsPublishedWhileDelivering)
+    {
+        auto bus = makeBus();
+        auto downstream = makeBus();
+        TestSubscriber subscriber;
+        TestSubscriber downstreamSubscriber;
+        bus.subscribe(&subscriber);
+        downstream.subscribe(&downstreamSubscriber);
+        subscriber.republish = &downstream;
+
+        {
+            EventBatch batch;
+            bus.publish({ "a", 1 });
+            bus.publish({ "b", 2 });
+        }
+
+        ASSERT_EQ(subscriber.batches.size(), 1u);
+        ASSERT_EQ(downstreamSubscriber.batches.size(), 1u);
+        ASSERT_EQ(downstreamSubscriber.batches[0].size(), 1u);
+        ASSERT_FALSE(EventBatch::isOpen());
+    }
+}
@@ -1,12 +1,14 @@
 #define protected public
 #include "orch.h"
 #include "orchdaemon.h"
+#include "timer.h"
 #undef protected
 #include "dbconnector.h"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "mock_sai_switch.h"
 #include "saihelper.h"
+#include <thread>
 
 extern sai_switch_api_t* sai_switch_api;
 sai_switch_api_t test_sai_switch;
@@ -128,6 +130,49 @@ namespace orchdaemon_test
         orchd = new OrchDaemon(&appl_db, &config_db, &state_db, &counters_db, nullptr);
     }
 
+    TEST_F(OrchDaemonTest, RingBufferMultiProducerDrain)
+    {
+        orchd->enableRingBuffer(8);
+
+        auto gRingBuffer = orchd->gRingBuffer;
+        EXPECT_EQ(gRingBuffer->capacity(), 7);
+
+        orchd->ring_thread = std::thread(&OrchDaemon::popRingBuffer, orchd);
+        while (!gRingBuffer->thread_created)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        const int tasks_per_producer = 1000;
+        std::atomic<int> executed{0};
+
+        auto producer = [&]() {
+            for (int i = 0; i < tasks_per_producer; i++)
+            {
+                while (!gRingBuffer->push([&executed]() { executed++; }))
+                {
+                    gRingBuffer->waitForSpace();
+                }
+                gRingBuffer->notify();
+            }
+        };
+
+        std::thread second_producer(producer);
+        producer();
+        second_producer.join();
+
+        // returns as soon as the ring thread has consumed everything, without a fixed sleep
+        gRingBuffer->waitUntilDrained();
+
+        EXPECT_TRUE(gRingBuffer->IsEmpty() && gRingBuffer->IsIdle());
+        EXPECT_EQ(executed.load(), 2 * tasks_per_producer);
+
+        delete orchd;
+        EXPECT_TRUE(Executor::gRingBuffer == nullptr);
+
+        orchd = new OrchDaemon(&appl_db, &config_db, &state_db, &counters_db, nullptr);
+    }
+
     TEST_F(OrchDaemonTest, RingThreadTeardownSafeWhenRingDisabled)
     {
         // Reproduces the scenario fixed alongside PR #4400's graceful
@@ -248,4 +293,326 @@ namespace orchdaemon_test
         orchd->disableRingBuffer();
     }
 
+    class SlicedTestOrch : public Orch
+    {
+        public:
+            SlicedTestOrch(DBConnector *db, const std::string &tableName, int pri, std::vector<std::string> &served)
+                : Orch(db, tableName, pri), m_served(served)
+            {
+            }
+
+            // Spend 2ms per entry and yield at the end of the time slice
+            void doTask(Consumer &consumer) override
+            {
+                auto it = consumer.m_toSync.begin();
+                while (it != consumer.m_toSync.end())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                    m_served.push_back(it->first);
+                    it = consumer.m_toSync.erase(it);
+
+                    if (consumer.sliceExpired())
+                    {
+                        break;
+                    }
+                }
+            }
+
+            Consumer *getConsumer(const std::string &name)
+            {
+                return dynamic_cast<Consumer *>(getExecutor(name));
+            }
+
+            std::vector<std::string> &m_served;
+    };
+
+    TEST_F(OrchDaemonTest, DrainYieldsAtEndOfTimeSlice)
+    {
+        std::vector<std::string> served;
+        SlicedTestOrch orch(&appl_db, "SLICED_TABLE", 0, served);
+        auto consumer = orch.getConsumer("SLICED_TABLE");
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"a", SET_COMMAND, {}});
+        entries.push_back({"b", SET_COMMAND, {}});
+        entries.push_back({"c", SET_COMMAND, {}});
+        consumer->addToSync(entries);
+
+        ConsumerBase::takePendingDrains();
+        orch.setTimeSlice("SLICED_TABLE", std::chrono::milliseconds(1));
+
+        consumer->drain();
+        EXPECT_EQ(served.size(), 1);
+        EXPECT_EQ(consumer->m_toSync.size(), 2);
+        EXPECT_TRUE(ConsumerBase::takePendingDrains());
+        EXPECT_FALSE(ConsumerBase::takePendingDrains());
+
+        // A zero slice lets doTask run to completion
+        orch.setTimeSlice("SLICED_TABLE", std::chrono::milliseconds(0));
+        consumer->drain();
+        EXPECT_EQ(served.size(), 3);
+        EXPECT_TRUE(consumer->m_toSync.empty());
+        EXPECT_FALSE(ConsumerBase::takePendingDrains());
+    }
+
+    TEST_F(OrchDaemonTest, DefaultSchedulingIgnoresTablePriority)
+    {
+        std::vector<std::string> served;
+        orchd->setSchedulerConfig(0, 0);
+
+        // Without a time slice or round budget every executor is served at priority 0
+        SlicedTestOrch orch(&appl_db, "DEFAULT_PRI_TABLE", 10, served);
+        EXPECT_EQ(orch.getConsumer("DEFAULT_PRI_TABLE")->getPri(), 0);
+        EXPECT_EQ(orch.getPriority(), 0);
+
+        // So a table does not get ahead of the timers
+        ExecutableTimer timer(new swss::SelectableTimer(timespec { .tv_sec = 1, .tv_nsec = 0 }), &orch, "DEFAULT_TIMER");
+        EXPECT_EQ(timer.getPri(), 0);
+    }
+
+    TEST_F(OrchDaemonTest, BudgetedRoundResumesInPriorityOrder)
+    {
+        std::vector<std::string> served;
+
+        // Executors take the priority of their table once the scheduler is bounded
+        orchd->setSchedulerConfig(0, 1);
+        auto low = new SlicedTestOrch(&appl_db, "LOW_PRI_TABLE", 0, served);
+        auto high = new SlicedTestOrch(&appl_db, "HIGH_PRI_TABLE", 10, served);
+        orchd->addOrchList(low);
+        orchd->addOrchList(high);
+
+        EXPECT_EQ(high->getPriority(), 10);
+        EXPECT_EQ(high->getConsumer("HIGH_PRI_TABLE")->getPri(), 10);
+
+        high->getConsumer("HIGH_PRI_TABLE")->addToSync(KeyOpFieldsValuesTuple{"h", SET_COMMAND, {}});
+        low->getConsumer("LOW_PRI_TABLE")->addToSync(KeyOpFieldsValuesTuple{"l", SET_COMMAND, {}});
+
+        // The budget is used up by the high priority Orch, the low priority one is deferred
+        orchd->runDoTaskRound();
+        ASSERT_EQ(served.size(), 1);
+        EXPECT_EQ(served[0], "h");
+        EXPECT_TRUE(orchd->m_roundPending);
+
+        // The next round resumes at the deferred Orch
+        orchd->runDoTaskRound();
+        ASSERT_EQ(served.size(), 2);
+        EXPECT_EQ(served[1], "l");
+
+        orchd->setSchedulerConfig(0, 0);
+    }
+
+    TEST(OrchWorkerPoolTest, WaitForAllTasks)
+    {
+        OrchWorkerPool pool(4);
+        std::atomic<int> done{0};
+
+        for (int i = 0; i < 100; i++)
+        {
+            pool.submit([&done]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                done++;
+            });
+        }
+
+        pool.wait();
+        EXPECT_EQ(done.load(), 100);
+
+        // A throwing task does not take the worker down
+        pool.submit([]() { throw std::runtime_error("test"); });
+        pool.submit([&done]() { done++; });
+        pool.wait();
+        EXPECT_EQ(done.load(), 101);
+    }
+
+    TEST_F(OrchDaemonTest, IndependentOrchsRunOnWorkers)
+    {
+        std::vector<std::string> mainServed;
+        std::vector<std::string> workerServed;
+        auto undeclared = new SlicedTestOrch(&appl_db, "UNDECLARED_TABLE", 0, mainServed);
+        auto tiedToMain = new SlicedTestOrch(&appl_db, "TIED_TABLE", 0, mainServed);
+        auto independent = new SlicedTestOrch(&appl_db, "INDEPENDENT_TABLE", 0, workerServed);
+        auto peer = new SlicedTestOrch(&appl_db, "PEER_TABLE", 0, workerServed);
+
+        tiedToMain->declareDependencies({ undeclared });
+        independent->declareDependencies({ peer, nullptr });
+        peer->declareDependencies({});
+
+        orchd->addOrchList(undeclared);
+        orchd->addOrchList(tiedToMain);
+        orchd->addOrchList(independent);
+        orchd->addOrchList(peer);
+
+        orchd->m_workerPool.reset(new OrchWorkerPool(2));
+        orchd->buildRoundGroups();
+
+        ASSERT_EQ(orchd->m_workerGroups.size(), 1);
+        EXPECT_EQ(orchd->m_workerGroups[0]->orchs, std::vector<Orch *>({ independent, peer }));
+        EXPECT_EQ(orchd->m_serialOrchs, std::vector<Orch *>({ undeclared, tiedToMain }));
+
+        // The drain of a worker Orch is left to the round
+        auto consumer = independent->getConsumer("INDEPENDENT_TABLE");
+        EXPECT_TRUE(consumer->isDrainDeferred());
+        EXPECT_FALSE(undeclared->getConsumer("UNDECLARED_TABLE")->isDrainDeferred());
+
+        consumer->addToSync(KeyOpFieldsValuesTuple{"i", SET_COMMAND, {}});
+        peer->getConsumer("PEER_TABLE")->addToSync(KeyOpFieldsValuesTuple{"p", SET_COMMAND, {}});
+        undeclared->getConsumer("UNDECLARED_TABLE")->addToSync(KeyOpFieldsValuesTuple{"u", SET_COMMAND, {}});
+
+        EXPECT_CALL(mock_sai_switch_, set_switch_attribute(_, _)).WillRepeatedly(Return(SAI_STATUS_SUCCESS));
+
+        orchd->runDoTaskRound();
+        orchd->waitForWorkers();
+
+        EXPECT_EQ(mainServed, std::vector<std::string>({ "u" }));
+        EXPECT_EQ(workerServed, std::vector<std::string>({ "i", "p" }));
+        EXPECT_FALSE(orchd->m_workerGroups[0]->busy);
+
+        orchd->m_workerPool.reset();
+    }
+
+    TEST_F(OrchDaemonTest, DrainOwnerServesTablesInStageOrder)
+    {
+        std::vector<std::string> served;
+        auto first = new SlicedTestOrch(&appl_db, "FIRST_TABLE", 0, served);
+        auto second = new SlicedTestOrch(&appl_db, "SECOND_TABLE", 0, served);
+        auto batch = new DashBatchOrch({ { second, "SECOND_TABLE" }, { first, "FIRST_TABLE" } });
+
+        orchd->addOrchList(first);
+        orchd->addOrchList(second);
+        orchd->addOrchList(batch);
+
+        EXPECT_EQ(first->getDrainOwner(), batch);
+        EXPECT_EQ(batch->getDependencies(), std::set<Orch *>({ first, second }));
+
+        // Executing only pops, the owned Orchs don't drain on their own
+        auto consumer = first->getConsumer("FIRST_TABLE");
+        EXPECT_TRUE(consumer->isDrainDeferred());
+        consumer->addToSync(KeyOpFieldsValuesTuple{"f", SET_COMMAND, {}});
+        second->getConsumer("SECOND_TABLE")->addToSync(KeyOpFieldsValuesTuple{"s", SET_COMMAND, {}});
+        first->doTask();
+        EXPECT_TRUE(served.empty());
+
+        // Rebuilding the round groups keeps them deferred
+        orchd->buildRoundGroups();
+        EXPECT_TRUE(consumer->isDrainDeferred());
+
+        orchd->runDoTaskRound();
+        EXPECT_EQ(served, std::vector<std::string>({ "s", "f" }));
+    }
+
+    TEST_F(OrchDaemonTest, PrefetchedBatchesKeepPopOrder)
+    {
+        std::vector<std::string> served;
+        Consumer::setPrefetchTables({ "PREFETCH_TABLE" });
+        auto orch = new SlicedTestOrch(&appl_db, "PREFETCH_TABLE", 5, served);
+        Consumer::setPrefetchTables({});
+        orchd->addOrchList(orch);
+
+        auto consumer = orch->getConsumer("PREFETCH_TABLE");
+        ASSERT_TRUE(consumer->isPrefetchable());
+        EXPECT_NE(consumer->getDbConnector(), &appl_db);
+
+        orchd->setPrefetchDepth(2);
+        orchd->buildRoundGroups();
+
+        auto prefetcher = dynamic_cast<ConsumerPrefetcher *>(orchd->prefetch(consumer));
+        ASSERT_NE(prefetcher, nullptr);
+        EXPECT_EQ(prefetcher->getConsumer(), consumer);
+        EXPECT_EQ(prefetcher->getPri(), 5);
+
+        // A Consumer not created for prefetching is selected as is
+        std::vector<std::string> plainServed;
+        SlicedTestOrch plain(&appl_db, "PLAIN_TABLE", 0, plainServed);
+        EXPECT_FALSE(plain.getConsumer("PLAIN_TABLE")->isPrefetchable());
+        EXPECT_EQ(orchd->prefetch(plain.getConsumer("PLAIN_TABLE")), plain.getConsumer("PLAIN_TABLE"));
+
+        auto first = std::make_shared<std::deque<KeyOpFieldsValuesTuple>>();
+        first->push_back({"a", SET_COMMAND, {}});
+        first->push_back({"b", SET_COMMAND, {}});
+        auto second = std::make_shared<std::deque<KeyOpFieldsValuesTuple>>();
+        second->push_back({"c", SET_COMMAND, {}});
+        prefetcher->enqueue(first);
+        prefetcher->enqueue(second);
+
+        // Entries popped but not yet executed are pending tasks
+        EXPECT_EQ(prefetcher->getQueuedEntries(), 3);
+        std::vector<std::string> ts;
+        orchd->getTaskToSync(ts);
+        EXPECT_EQ(ts.size(), 3);
+
+        // Counted per table without formatting them
+        consumer->addToSync(KeyOpFieldsValuesTuple{"d", SET_COMMAND, {}});
+        std::vector<std::pair<std::string, size_t>> counts;
+        EXPECT_EQ(orchd->getPendingTaskCounts(counts), 4);
+        ASSERT_EQ(counts.size(), 2);
+        EXPECT_EQ(counts[0], std::make_pair(std::string("PREFETCH_TABLE"), size_t(1)));
+        EXPECT_EQ(counts[1], std::make_pair(std::string("PREFETCH_TABLE"), size_t(3)));
+        consumer->m_toSync.clear();
+
+        prefetcher->execute();
+        EXPECT_EQ(served, std::vector<std::string>({ "a", "b", "c" }));
+        EXPECT_EQ(prefetcher->getQueuedEntries(), 0);
+        EXPECT_TRUE(consumer->m_toSync.empty());
+    }
+
+    TEST_F(OrchDaemonTest, PrefetchBackpressureFollowsSyncDepth)
+    {
+        std::vector<std::string> served;
+        Consumer::setPrefetchTables({ "PREFETCH_TABLE" });
+        auto orch = new SlicedTestOrch(&appl_db, "PREFETCH_TABLE", 0, served);
+        Consumer::setPrefetchTables({});
+        orchd->addOrchList(orch);
+
+        orchd->setPrefetchDepth(2);
+        orchd->buildRoundGroups();
+
+        auto consumer = orch->getConsumer("PREFETCH_TABLE");
+        auto prefetcher = dynamic_cast<ConsumerPrefetcher *>(orchd->prefetch(consumer));
+        ASSERT_NE(prefetcher, nullptr);
+
+        // The reader starts and stops cleanly, also when restarted
+        prefetcher->start();
+        prefetcher->stop();
+        prefetcher->start();
+
+        consumer->addToSync(KeyOpFieldsValuesTuple{"x", SET_COMMAND, {}});
+        prefetcher->updateBackpressure();
+        EXPECT_FALSE(prefetcher->isThrottled());
+
+        consumer->addToSync(KeyOpFieldsValuesTuple{"y", SET_COMMAND, {}});
+        prefetcher->updateBackpressure();
+        EXPECT_TRUE(prefetcher->isThrottled());
+
+        // Draining the backlog in a round lets the reader pop again
+        orchd->runDoTaskRound();
+        EXPECT_EQ(served, std::vector<std::string>({ "x", "y" }));
+        EXPECT_FALSE(prefetcher->isThrottled());
+
+        orchd->stopPrefetchers();
+    }
+
+    TEST_F(OrchDaemonTest, BakeReadsTablesNotPreloaded)
+    {
+        std::vector<std::string> served;
+        auto orch = new SlicedTestOrch(&appl_db, "PRELOAD_TABLE", 0, served);
+        orchd->addOrchList(orch);
+
+        Table table(&appl_db, "PRELOAD_TABLE");
+        table.set("a", { { "f", "v" } });
+        table.set("b", { { "f", "v" } });
+
+        // The mocked Redis can't run the scan script, the preload fails
+        orchd->setBakeThreads(2);
+        orchd->preloadExistingData();
+
+        auto consumer = orch->getConsumer("PRELOAD_TABLE");
+        EXPECT_FALSE(consumer->hasPreloaded());
+
+        orch->bake();
+        EXPECT_EQ(orch->getPendingTaskCount(), 2);
+
+        orch->clearPreloaded();
+        static_cast<Orch *>(orch)->doTask();
+        EXPECT_EQ(served, std::vector<std::string>({ "a", "b" }));
+    }
 }
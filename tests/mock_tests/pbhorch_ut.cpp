@@ -0,0 +1,225 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "aclorch.h"
+#include "pbhorch.h"
+#undef private
+#include "mock_orch_test.h"
+
+namespace pbhorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    static const string PBH_TABLE = "pbh_table";
+
+    sai_acl_api_t ut_sai_acl_api;
+    sai_acl_api_t *pold_sai_acl_api;
+
+    // ACL entry the SAI fails to create, by priority
+    sai_uint32_t _ut_stub_failing_priority;
+    uint32_t _ut_stub_create_calls;
+    uint32_t _ut_stub_bulk_create_calls;
+
+    sai_status_t _ut_stub_create_pbh_acl_entry(
+        _Out_ sai_object_id_t *acl_entry_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            if (attr_list[i].id == SAI_ACL_ENTRY_ATTR_PRIORITY &&
+                attr_list[i].value.u32 == _ut_stub_failing_priority)
+            {
+                return SAI_STATUS_TABLE_FULL;
+            }
+        }
+
+        return pold_sai_acl_api->create_acl_entry(acl_entry_id, switch_id, attr_count, attr_list);
+    }
+
+    sai_status_t _ut_stub_create_acl_entry(
+        _Out_ sai_object_id_t *acl_entry_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        _ut_stub_create_calls++;
+        return _ut_stub_create_pbh_acl_entry(acl_entry_id, switch_id, attr_count, attr_list);
+    }
+
+    sai_status_t _ut_stub_create_acl_entries(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_create_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_create_pbh_acl_entry(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    class PbhOrchTest : public MockOrchTest
+    {
+    protected:
+        PbhOrch *m_pbhOrch;
+
+        void ApplyInitialConfigs() override
+        {
+            Table port_table = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+            auto ports = ut_helper::getInitialSaiPorts();
+            port_table.set("Ethernet0", ports["Ethernet0"]);
+            port_table.set("Ethernet4", ports["Ethernet4"]);
+            port_table.set("PortConfigDone", { { "count", to_string(2) } });
+            port_table.set("PortInitDone", { {} });
+
+            gPortsOrch->addExistingData(&port_table);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+        }
+
+        void PostSetUp() override
+        {
+            ut_sai_acl_api = *sai_acl_api;
+            pold_sai_acl_api = sai_acl_api;
+            ut_sai_acl_api.create_acl_entry = _ut_stub_create_acl_entry;
+            sai_acl_api = &ut_sai_acl_api;
+
+            _ut_stub_failing_priority = 0;
+            _ut_stub_create_calls = 0;
+            _ut_stub_bulk_create_calls = 0;
+
+            gAclOrch->m_aclEntryBulker.create_entries = _ut_stub_create_acl_entries;
+
+            vector<TableConnector> pbh_tables = {
+                { m_config_db.get(), CFG_PBH_TABLE_TABLE_NAME },
+                { m_config_db.get(), CFG_PBH_RULE_TABLE_NAME },
+                { m_config_db.get(), CFG_PBH_HASH_TABLE_NAME },
+                { m_config_db.get(), CFG_PBH_HASH_FIELD_TABLE_NAME }
+            };
+            m_pbhOrch = new PbhOrch(pbh_tables, gAclOrch, gPortsOrch);
+
+            applyPbhTasks(CFG_PBH_HASH_FIELD_TABLE_NAME, {{
+                "inner_ip_proto", SET_COMMAND, {
+                    { "hash_field", "INNER_IP_PROTOCOL" },
+                    { "sequence_id", "1" }
+                }
+            }});
+            applyPbhTasks(CFG_PBH_HASH_TABLE_NAME, {{
+                "inner_hash", SET_COMMAND, {
+                    { "hash_field_list", "inner_ip_proto" }
+                }
+            }});
+            applyPbhTasks(CFG_PBH_TABLE_TABLE_NAME, {{
+                PBH_TABLE, SET_COMMAND, {
+                    { "interface_list", "Ethernet0,Ethernet4" },
+                    { "description", "NVGRE" }
+                }
+            }});
+        }
+
+        void PreTearDown() override
+        {
+            AclOrch::setBulkRules(false);
+            delete m_pbhOrch;
+            sai_acl_api = pold_sai_acl_api;
+        }
+
+        void applyPbhTasks(const string &table_name, const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            auto consumer = dynamic_cast<Consumer *>(m_pbhOrch->getExecutor(table_name));
+            consumer->addToSync(entries);
+            static_cast<Orch *>(m_pbhOrch)->doTask(*consumer);
+        }
+
+        KeyOpFieldsValuesTuple ruleSet(const string &rule_name, const string &priority)
+        {
+            return { PBH_TABLE + "|" + rule_name, SET_COMMAND, {
+                { "priority", priority },
+                { "gre_key", "0x2500/0xffffff00" },
+                { "inner_ether_type", "0x86dd" },
+                { "hash", "inner_hash" }
+            } };
+        }
+
+        bool ruleExists(const string &rule_name)
+        {
+            PbhRule rule;
+            return m_pbhOrch->pbhHlpr.getPbhRule(rule, PBH_TABLE + "|" + rule_name);
+        }
+
+        AclRule *getAclRule(const string &rule_name)
+        {
+            return gAclOrch->getAclRule(PBH_TABLE, rule_name);
+        }
+    };
+
+    TEST_F(PbhOrchTest, RuleBulkCreateFailedInTheMiddle)
+    {
+        AclOrch::setBulkRules(true);
+        _ut_stub_failing_priority = 2;
+
+        applyPbhTasks(CFG_PBH_RULE_TABLE_NAME, {
+            ruleSet("rule_1", "1"), ruleSet("rule_2", "2"), ruleSet("rule_3", "3")
+        });
+
+        // The rules of the round go in one bulk
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        ASSERT_EQ(_ut_stub_create_calls, 0);
+
+        // The others are created and tracked, the failed one is neither in the ASIC nor in the cache
+        for (auto rule_name : { "rule_1", "rule_3" })
+        {
+            ASSERT_TRUE(ruleExists(rule_name));
+            ASSERT_NE(getAclRule(rule_name), nullptr);
+            ASSERT_NE(getAclRule(rule_name)->getOid(), SAI_NULL_OBJECT_ID);
+        }
+        ASSERT_FALSE(ruleExists("rule_2"));
+        ASSERT_EQ(getAclRule("rule_2"), nullptr);
+        ASSERT_TRUE(m_pbhOrch->pbhHlpr.ruleTask.pendingSetupMap.empty());
+
+        // The hash is referenced by the created rules only
+        PbhHash hash;
+        ASSERT_TRUE(m_pbhOrch->pbhHlpr.getPbhHash(hash, "inner_hash"));
+        ASSERT_EQ(m_pbhOrch->pbhHlpr.getPbhRulesByHash("inner_hash").size(), 2);
+    }
+
+    TEST_F(PbhOrchTest, RulesCreatedOneByOneWithoutBulk)
+    {
+        _ut_stub_failing_priority = 2;
+
+        applyPbhTasks(CFG_PBH_RULE_TABLE_NAME, {
+            ruleSet("rule_1", "1"), ruleSet("rule_2", "2"), ruleSet("rule_3", "3")
+        });
+
+        // Bulk ACL rule programming is disabled, each rule is created with its own call
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 0);
+        ASSERT_EQ(_ut_stub_create_calls, 3);
+
+        for (auto rule_name : { "rule_1", "rule_3" })
+        {
+            ASSERT_TRUE(ruleExists(rule_name));
+            ASSERT_NE(getAclRule(rule_name), nullptr);
+        }
+        ASSERT_FALSE(ruleExists("rule_2"));
+        ASSERT_EQ(getAclRule("rule_2"), nullptr);
+        ASSERT_TRUE(m_pbhOrch->pbhHlpr.ruleTask.pendingSetupMap.empty());
+    }
+}
@@ -0,0 +1,92 @@
+#include "ut_helper.h"
+#include "pfcwddetect.h"
+
+namespace pfcwddetect_test
+{
+    using namespace std;
+
+    // 100 ms poll
+    static const uint64_t pollTimeUs = 100 * 1000;
+
+    TEST(PfcWdDetectPolicyTest, PlatformsWithoutPolicyKeepLua)
+    {
+        ASSERT_EQ(PfcWdDetectPolicy::create(MLNX_PLATFORM_SUBSTRING), nullptr);
+        ASSERT_EQ(PfcWdDetectPolicy::create(BRCM_PLATFORM_SUBSTRING), nullptr);
+        ASSERT_EQ(PfcWdDetectPolicy::create(""), nullptr);
+
+        auto vs = PfcWdDetectPolicy::create(VS_PLATFORM_SUBSTRING);
+        ASSERT_NE(vs, nullptr);
+        ASSERT_EQ(vs->durationCounter(), "RX_PAUSE_DURATION_US");
+
+        auto bfn = PfcWdDetectPolicy::create(BFN_PLATFORM_SUBSTRING);
+        ASSERT_NE(bfn, nullptr);
+        ASSERT_EQ(bfn->durationCounter(), "RX_PAUSE_DURATION");
+
+        auto cisco = PfcWdDetectPolicy::create(CISCO_8000_PLATFORM_SUBSTRING);
+        ASSERT_NE(cisco, nullptr);
+        ASSERT_FALSE(cisco->comparesLast());
+    }
+
+    TEST(PfcWdDetectPolicyTest, GenericPolicy)
+    {
+        PfcWdGenericDetectPolicy policy;
+        PfcWdSample last;
+        last.packets = 100;
+        last.pfcRxPackets = 10;
+        last.pfcDuration = 1000;
+
+        // Blocked queue receiving PFC frames
+        PfcWdSample cur = last;
+        cur.occupancyBytes = 512;
+        cur.pfcRxPackets = 11;
+        ASSERT_TRUE(policy.isStorm(cur, last, pollTimeUs));
+
+        // Still transmitting
+        cur.packets = 101;
+        ASSERT_FALSE(policy.isStorm(cur, last, pollTimeUs));
+
+        // Empty queue paused for more than 80% of the poll
+        cur = last;
+        cur.pfcDuration = last.pfcDuration + pollTimeUs * 9 / 10;
+        ASSERT_TRUE(policy.isStorm(cur, last, pollTimeUs));
+
+        cur.pfcDuration = last.pfcDuration + pollTimeUs / 2;
+        ASSERT_FALSE(policy.isStorm(cur, last, pollTimeUs));
+
+        // Cleared counters are no progress
+        cur = last;
+        cur.occupancyBytes = 512;
+        cur.pfcRxPackets = 0;
+        ASSERT_FALSE(policy.isStorm(cur, last, pollTimeUs));
+    }
+
+    TEST(PfcWdDetectPolicyTest, TeralynxPolicyNeedsPauseDuration)
+    {
+        PfcWdTeralynxDetectPolicy policy;
+        PfcWdSample last;
+
+        PfcWdSample cur;
+        cur.occupancyBytes = 512;
+        cur.pfcRxPackets = 1;
+        ASSERT_FALSE(policy.isStorm(cur, last, pollTimeUs));
+
+        cur.pfcDuration = pollTimeUs;
+        ASSERT_TRUE(policy.isStorm(cur, last, pollTimeUs));
+
+        // An empty queue may still transmit
+        cur.occupancyBytes = 0;
+        cur.packets = 10;
+        ASSERT_TRUE(policy.isStorm(cur, last, pollTimeUs));
+    }
+
+    TEST(PfcWdDetectPolicyTest, PauseStatusPolicy)
+    {
+        PfcWdPauseStatusDetectPolicy policy;
+        PfcWdSample cur;
+
+        ASSERT_FALSE(policy.isStorm(cur, cur, pollTimeUs));
+
+        cur.pauseStatus = true;
+        ASSERT_TRUE(policy.isStorm(cur, cur, pollTimeUs));
+    }
+}
@@ -0,0 +1,210 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "policerorch.h"
+#undef private
+#include "mock_orch_test.h"
+
+namespace policerorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    sai_port_api_t ut_sai_port_api;
+    sai_port_api_t *pold_sai_port_api;
+
+    // Port on which the SAI fails to bind a broadcast storm control policer
+    sai_object_id_t _ut_stub_failing_port_id = SAI_NULL_OBJECT_ID;
+
+    sai_status_t _ut_stub_sai_set_port_attribute(
+        _In_ sai_object_id_t port_id,
+        _In_ const sai_attribute_t *attr)
+    {
+        if (attr->id == SAI_PORT_ATTR_BROADCAST_STORM_CONTROL_POLICER_ID &&
+            attr->value.oid != SAI_NULL_OBJECT_ID &&
+            port_id == _ut_stub_failing_port_id)
+        {
+            return SAI_STATUS_FAILURE;
+        }
+        return pold_sai_port_api->set_port_attribute(port_id, attr);
+    }
+
+    sai_status_t _ut_stub_sai_set_ports_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        for (size_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_sai_set_port_attribute(object_id[i], attr_list + i);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    class PolicerOrchTest : public MockOrchTest
+    {
+    protected:
+        void ApplyInitialConfigs()
+        {
+            Table port_table = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+            auto ports = ut_helper::getInitialSaiPorts();
+            port_table.set(ETHERNET0, ports[ETHERNET0]);
+            port_table.set(ETHERNET4, ports[ETHERNET4]);
+            port_table.set(ETHERNET8, ports[ETHERNET8]);
+            port_table.set("PortConfigDone", { { "count", to_string(3) } });
+            port_table.set("PortInitDone", { {} });
+
+            gPortsOrch->addExistingData(&port_table);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+        }
+
+        void PostSetUp() override
+        {
+            ut_sai_port_api = *sai_port_api;
+            pold_sai_port_api = sai_port_api;
+            ut_sai_port_api.set_port_attribute = _ut_stub_sai_set_port_attribute;
+            ut_sai_port_api.set_ports_attribute = _ut_stub_sai_set_ports_attribute;
+            sai_port_api = &ut_sai_port_api;
+            _ut_stub_failing_port_id = SAI_NULL_OBJECT_ID;
+        }
+
+        void PreTearDown() override
+        {
+            sai_port_api = pold_sai_port_api;
+        }
+
+        Consumer *getStormControlConsumer()
+        {
+            return dynamic_cast<Consumer *>(gPolicerOrch->getExecutor(CFG_PORT_STORM_CONTROL_TABLE_NAME));
+        }
+
+        void applyStormControl(const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            getStormControlConsumer()->addToSync(entries);
+            static_cast<Orch *>(gPolicerOrch)->doTask();
+        }
+
+        sai_object_id_t getPortId(const string &alias)
+        {
+            Port port;
+            gPortsOrch->getPort(alias, port);
+            return port.m_port_id;
+        }
+
+        sai_object_id_t getBroadcastPolicer(const string &alias)
+        {
+            sai_attribute_t attr;
+            attr.id = SAI_PORT_ATTR_BROADCAST_STORM_CONTROL_POLICER_ID;
+            attr.value.oid = SAI_NULL_OBJECT_ID;
+            sai_port_api->get_port_attribute(getPortId(alias), 1, &attr);
+            return attr.value.oid;
+        }
+    };
+
+    TEST_F(PolicerOrchTest, StormControlBulkBindingsFailedInTheMiddle)
+    {
+        _ut_stub_failing_port_id = getPortId(ETHERNET4);
+
+        applyStormControl({
+            { ETHERNET0 + "|broadcast", SET_COMMAND, { { "kbps", "8000" } } },
+            { ETHERNET4 + "|broadcast", SET_COMMAND, { { "kbps", "8000" } } },
+            { ETHERNET8 + "|broadcast", SET_COMMAND, { { "kbps", "8000" } } }
+        });
+
+        // The failed binding is retried, its policer is removed
+        ASSERT_EQ(gPolicerOrch->m_syncdPolicers.size(), 2);
+        ASSERT_EQ(gPolicerOrch->m_syncdPolicers.count("_Ethernet4_broadcast"), 0);
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET0), gPolicerOrch->m_syncdPolicers["_Ethernet0_broadcast"]);
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET8), gPolicerOrch->m_syncdPolicers["_Ethernet8_broadcast"]);
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET4), SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(getStormControlConsumer()->m_toSync.size(), 1);
+
+        _ut_stub_failing_port_id = SAI_NULL_OBJECT_ID;
+        static_cast<Orch *>(gPolicerOrch)->doTask();
+        ASSERT_EQ(gPolicerOrch->m_syncdPolicers.size(), 3);
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET4), gPolicerOrch->m_syncdPolicers["_Ethernet4_broadcast"]);
+        ASSERT_TRUE(getStormControlConsumer()->m_toSync.empty());
+
+        // The rate is updated in place
+        auto oid = gPolicerOrch->m_syncdPolicers["_Ethernet0_broadcast"];
+        applyStormControl({ { ETHERNET0 + "|broadcast", SET_COMMAND, { { "kbps", "16000" } } } });
+        ASSERT_EQ(gPolicerOrch->m_syncdPolicers["_Ethernet0_broadcast"], oid);
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET0), oid);
+
+        applyStormControl({
+            { ETHERNET0 + "|broadcast", DEL_COMMAND, {} },
+            { ETHERNET4 + "|broadcast", DEL_COMMAND, {} },
+            { ETHERNET8 + "|broadcast", DEL_COMMAND, {} }
+        });
+        ASSERT_TRUE(gPolicerOrch->m_syncdPolicers.empty());
+        ASSERT_TRUE(gPolicerOrch->m_policerRefCounts.empty());
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET0), SAI_NULL_OBJECT_ID);
+        ASSERT_TRUE(getStormControlConsumer()->m_toSync.empty());
+    }
+
+    TEST_F(PolicerOrchTest, StormControlSharedPolicers)
+    {
+        gPolicerOrch->setStormControlPolicerSharing(true);
+        ASSERT_TRUE(gPolicerOrch->m_shareStormControlPolicers);
+
+        uint64_t cir8000 = 8000 * 1000 / 8;
+        uint64_t cir16000 = 16000 * 1000 / 8;
+        uint64_t cir32000 = 32000 * 1000 / 8;
+
+        applyStormControl({
+            { ETHERNET0 + "|broadcast", SET_COMMAND, { { "kbps", "8000" } } },
+            { ETHERNET4 + "|broadcast", SET_COMMAND, { { "kbps", "8000" } } },
+            { ETHERNET8 + "|broadcast", SET_COMMAND, { { "kbps", "16000" } } }
+        });
+
+        // One policer per rate, counted by its bindings
+        ASSERT_TRUE(gPolicerOrch->m_syncdPolicers.empty());
+        ASSERT_EQ(gPolicerOrch->m_stormControlPolicers.size(), 2);
+        ASSERT_EQ(gPolicerOrch->m_stormControlPolicers[cir8000].ref_count, 2);
+        ASSERT_EQ(gPolicerOrch->m_stormControlPolicers[cir16000].ref_count, 1);
+        ASSERT_EQ(gPolicerOrch->m_stormControlBindings.size(), 3);
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET0), gPolicerOrch->m_stormControlPolicers[cir8000].oid);
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET4), gPolicerOrch->m_stormControlPolicers[cir8000].oid);
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET8), gPolicerOrch->m_stormControlPolicers[cir16000].oid);
+
+        // Sharing can't be changed once storm control is configured
+        gPolicerOrch->setStormControlPolicerSharing(false);
+        ASSERT_TRUE(gPolicerOrch->m_shareStormControlPolicers);
+
+        // A binding moved to another rate
+        applyStormControl({ { ETHERNET4 + "|broadcast", SET_COMMAND, { { "kbps", "16000" } } } });
+        ASSERT_EQ(gPolicerOrch->m_stormControlPolicers[cir8000].ref_count, 1);
+        ASSERT_EQ(gPolicerOrch->m_stormControlPolicers[cir16000].ref_count, 2);
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET4), gPolicerOrch->m_stormControlPolicers[cir16000].oid);
+
+        // The policer created for a rate whose only binding failed is removed
+        _ut_stub_failing_port_id = getPortId(ETHERNET0);
+        applyStormControl({ { ETHERNET0 + "|broadcast", SET_COMMAND, { { "kbps", "32000" } } } });
+        ASSERT_EQ(gPolicerOrch->m_stormControlPolicers.count(cir32000), 0);
+        ASSERT_EQ(gPolicerOrch->m_stormControlBindings["_Ethernet0_broadcast"], cir8000);
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET0), gPolicerOrch->m_stormControlPolicers[cir8000].oid);
+        ASSERT_EQ(getStormControlConsumer()->m_toSync.size(), 1);
+        getStormControlConsumer()->m_toSync.clear();
+        _ut_stub_failing_port_id = SAI_NULL_OBJECT_ID;
+
+        // The last binding of a rate releases its policer
+        applyStormControl({ { ETHERNET0 + "|broadcast", DEL_COMMAND, {} } });
+        ASSERT_EQ(gPolicerOrch->m_stormControlPolicers.count(cir8000), 0);
+        ASSERT_EQ(getBroadcastPolicer(ETHERNET0), SAI_NULL_OBJECT_ID);
+
+        applyStormControl({
+            { ETHERNET4 + "|broadcast", DEL_COMMAND, {} },
+            { ETHERNET8 + "|broadcast", DEL_COMMAND, {} }
+        });
+        ASSERT_TRUE(gPolicerOrch->m_stormControlPolicers.empty());
+        ASSERT_TRUE(gPolicerOrch->m_stormControlBindings.empty());
+        ASSERT_TRUE(getStormControlConsumer()->m_toSync.empty());
+    }
+}
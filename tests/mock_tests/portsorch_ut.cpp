@@ -269,6 +269,32 @@ namespace portsorch_test
         return pold_sai_port_api->set_port_attribute(port_id, attr);
     }
 
+    uint32_t _sai_set_ports_attribute_calls = 0;
+    uint32_t _sai_set_ports_attribute_objects = 0;
+    bool set_ports_attribute_not_implemented = false;
+
+    sai_status_t _ut_stub_sai_set_ports_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        if (set_ports_attribute_not_implemented)
+        {
+            return SAI_STATUS_NOT_IMPLEMENTED;
+        }
+
+        _sai_set_ports_attribute_calls++;
+        _sai_set_ports_attribute_objects += object_count;
+
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_sai_set_port_attribute(object_id[i], attr_list + i);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
     vector<sai_object_type_t> supported_sai_objects = {
         SAI_OBJECT_TYPE_PORT,
         SAI_OBJECT_TYPE_LAG,
@@ -407,6 +433,7 @@ namespace portsorch_test
         pold_sai_port_api = sai_port_api;
         ut_sai_port_api.get_port_attribute = _ut_stub_sai_get_port_attribute;
         ut_sai_port_api.set_port_attribute = _ut_stub_sai_set_port_attribute;
+        ut_sai_port_api.set_ports_attribute = _ut_stub_sai_set_ports_attribute;
         ut_sai_port_api.create_port_serdes = _ut_stub_sai_create_port_serdes;
         ut_sai_port_api.remove_port_serdes = _ut_stub_sai_remove_port_serdes;
         sai_port_api = &ut_sai_port_api;
@@ -869,6 +896,116 @@ namespace portsorch_test
         cleanupPorts(gPortsOrch);
     }
 
+    /*
+    * Test port flaps coalesced within a notification burst
+    */
+    TEST_F(PortsOrchTest, PortFlapCountCoalesced)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+        auto ports = ut_helper::getInitialSaiPorts();
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { "lanes", "0" } });
+
+        gPortsOrch->addExistingData(&portTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        Port port;
+        gPortsOrch->getPort("Ethernet0", port);
+        ASSERT_TRUE(port.m_oper_status != SAI_PORT_OPER_STATUS_UP);
+        ASSERT_TRUE(port.m_flap_count == 0);
+
+        auto exec = static_cast<Notifier *>(gPortsOrch->getExecutor("PORT_STATUS_NOTIFICATIONS"));
+        auto consumer = exec->getNotificationConsumer();
+
+        // Ethernet0 goes up, down and up again in a single notification
+        sai_port_oper_status_notification_t port_oper_status[3];
+        memset(port_oper_status, 0, sizeof(port_oper_status));
+        port_oper_status[0].port_state = SAI_PORT_OPER_STATUS_UP;
+        port_oper_status[1].port_state = SAI_PORT_OPER_STATUS_DOWN;
+        port_oper_status[2].port_state = SAI_PORT_OPER_STATUS_UP;
+        for (auto &status : port_oper_status)
+        {
+            status.port_id = port.m_port_id;
+        }
+
+        mockReply = (redisReply *)calloc(1, sizeof(redisReply));
+        mockReply->type = REDIS_REPLY_ARRAY;
+        mockReply->elements = 3; // REDIS_PUBLISH_MESSAGE_ELEMNTS
+        mockReply->element = (redisReply **)calloc(mockReply->elements, sizeof(redisReply *));
+        mockReply->element[2] = (redisReply *)calloc(1, sizeof(redisReply));
+        mockReply->element[2]->type = REDIS_REPLY_STRING;
+        std::string data = sai_serialize_port_oper_status_ntf(3, port_oper_status);
+        std::vector<FieldValueTuple> notifyValues;
+        FieldValueTuple opdata("port_state_change", data);
+        notifyValues.push_back(opdata);
+        std::string msg = swss::JSon::buildJson(notifyValues);
+        mockReply->element[2]->str = (char*)calloc(1, msg.length() + 1);
+        memcpy(mockReply->element[2]->str, msg.c_str(), msg.length());
+
+        consumer->readData();
+        gPortsOrch->doTask(*consumer);
+        mockReply = nullptr;
+
+        // Every change is a flap, the port ends up at the last status
+        gPortsOrch->getPort("Ethernet0", port);
+        ASSERT_TRUE(port.m_oper_status == SAI_PORT_OPER_STATUS_UP);
+        ASSERT_TRUE(port.m_flap_count == 3);
+
+        string value;
+        ASSERT_TRUE(portTable.hget("Ethernet0", "flap_count", value));
+        ASSERT_EQ(value, "3");
+        ASSERT_TRUE(portTable.hget("Ethernet0", "last_down_time", value));
+        ASSERT_TRUE(portTable.hget("Ethernet0", "oper_status", value));
+        ASSERT_EQ(value, "up");
+
+        cleanupPorts(gPortsOrch);
+    }
+
+    /*
+    * Test the oper status audit catching a missed notification
+    */
+    TEST_F(PortsOrchTest, PortStatusAudit)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+        auto ports = ut_helper::getInitialSaiPorts();
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { "lanes", "0" } });
+
+        gPortsOrch->addExistingData(&portTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+        ASSERT_TRUE(gPortsOrch->allPortsReady());
+
+        Port port;
+        ASSERT_TRUE(gPortsOrch->getPort("Ethernet0", port));
+        sai_port_oper_status_t status;
+        ASSERT_TRUE(gPortsOrch->getPortOperStatus(port, status));
+
+        // As if the notification of the last change was lost
+        auto missed = status == SAI_PORT_OPER_STATUS_UP ? SAI_PORT_OPER_STATUS_DOWN : SAI_PORT_OPER_STATUS_UP;
+        gPortsOrch->m_portList["Ethernet0"].m_oper_status = missed;
+
+        // Each tick audits a slice, a round goes through every port
+        for (size_t i = 0; i < ports.size(); i++)
+        {
+            gPortsOrch->auditPortStatus();
+        }
+
+        ASSERT_TRUE(gPortsOrch->getPort("Ethernet0", port));
+        ASSERT_EQ(port.m_oper_status, status);
+
+        cleanupPorts(gPortsOrch);
+    }
+
    /*
     * Test port oper error count
     */
@@ -1304,6 +1441,91 @@ namespace portsorch_test
         cleanupPorts(gPortsOrch);
     }
 
+    /*
+     * MTU and admin status of several ports in one drain go through one bulk set,
+     * and through single object sets once bulk set turns out not to be implemented
+     */
+    TEST_F(PortsOrchTest, PortAttrBulkSet)
+    {
+        auto portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+        // Get SAI default ports
+        auto &ports = defaultPortList;
+        ASSERT_TRUE(!ports.empty());
+
+        // Generate port config
+        for (const auto &cit : ports)
+        {
+            portTable.set(cit.first, cit.second);
+        }
+
+        // Set PortConfigDone
+        portTable.set("PortConfigDone", { { "count", std::to_string(ports.size()) } });
+
+        // Refill consumer
+        gPortsOrch->addExistingData(&portTable);
+
+        // Apply configuration
+        static_cast<Orch*>(gPortsOrch)->doTask();
+
+        _hook_sai_port_api();
+        _sai_set_ports_attribute_calls = 0;
+        _sai_set_ports_attribute_objects = 0;
+        _sai_set_admin_state_down_count = 0;
+
+        auto consumer = dynamic_cast<Consumer*>(gPortsOrch->getExecutor(APP_PORT_TABLE_NAME));
+
+        std::deque<KeyOpFieldsValuesTuple> kfvList = {
+            { "Ethernet0", SET_COMMAND, { { "mtu", "9100" }, { "admin_status", "down" } } },
+            { "Ethernet1", SET_COMMAND, { { "mtu", "9100" }, { "admin_status", "down" } } },
+            { "Ethernet2", SET_COMMAND, { { "mtu", "9100" }, { "admin_status", "down" } } }
+        };
+        consumer->addToSync(kfvList);
+        static_cast<Orch*>(gPortsOrch)->doTask();
+
+        ASSERT_EQ(_sai_set_ports_attribute_calls, 1);
+        ASSERT_EQ(_sai_set_ports_attribute_objects, 6);
+        ASSERT_EQ(_sai_set_admin_state_down_count, 3);
+
+        for (const auto &kfv : kfvList)
+        {
+            Port p;
+            ASSERT_TRUE(gPortsOrch->getPort(kfvKey(kfv), p));
+            ASSERT_EQ(p.m_mtu, 9100);
+            ASSERT_FALSE(p.m_admin_state_up);
+        }
+
+        // Fall back to single object sets
+        set_ports_attribute_not_implemented = true;
+
+        kfvList = {
+            { "Ethernet0", SET_COMMAND, { { "mtu", "1500" }, { "admin_status", "up" } } },
+            { "Ethernet1", SET_COMMAND, { { "mtu", "1500" }, { "admin_status", "up" } } }
+        };
+        consumer->addToSync(kfvList);
+        static_cast<Orch*>(gPortsOrch)->doTask();
+
+        ASSERT_FALSE(gPortsOrch->m_portAttrBulkSupported);
+
+        for (const auto &kfv : kfvList)
+        {
+            Port p;
+            ASSERT_TRUE(gPortsOrch->getPort(kfvKey(kfv), p));
+            ASSERT_EQ(p.m_mtu, 1500);
+            ASSERT_TRUE(p.m_admin_state_up);
+        }
+
+        std::vector<std::string> taskList;
+        gPortsOrch->dumpPendingTasks(taskList);
+        ASSERT_TRUE(taskList.empty());
+
+        set_ports_attribute_not_implemented = false;
+        _unhook_sai_port_api();
+
+        // Cleanup ports
+        cleanupPorts(gPortsOrch);
+    }
+
     TEST_F(PortsOrchTest, PortAdvancedConfig)
     {
         auto portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
@@ -2245,6 +2467,87 @@ namespace portsorch_test
         _unhook_sai_queue_api();
     }
 
+    /**
+     * Test that verifies PortsOrch::findPort() refers to the stored Port
+     */
+    TEST_F(PortsOrchTest, FindPortTest)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+        auto &ports = defaultPortList;
+        ASSERT_TRUE(!ports.empty());
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+
+        gPortsOrch->addExistingData(&portTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        const Port *port = gPortsOrch->findPort("Ethernet0");
+        ASSERT_NE(port, nullptr);
+        ASSERT_EQ(port, &gPortsOrch->getAllPorts().at("Ethernet0"));
+        ASSERT_EQ(gPortsOrch->findPort(port->m_port_id), port);
+        ASSERT_EQ(gPortsOrch->findPort("EthernetUnknown"), nullptr);
+        ASSERT_EQ(gPortsOrch->findPort(SAI_NULL_OBJECT_ID), nullptr);
+
+        sai_object_id_t port_id;
+        ASSERT_TRUE(gPortsOrch->getPortOid("Ethernet0", port_id));
+        ASSERT_EQ(port_id, port->m_port_id);
+        ASSERT_FALSE(gPortsOrch->getPortOid("EthernetUnknown", port_id));
+
+        sai_vlan_id_t vlan_id;
+        ASSERT_FALSE(gPortsOrch->getVlanId(SAI_NULL_OBJECT_ID, vlan_id));
+
+        // Changes made in place are seen through the pointer
+        auto fdb_count = port->m_fdb_count;
+        ASSERT_TRUE(gPortsOrch->incrFdbCount("Ethernet0", 2));
+        ASSERT_EQ(port->m_fdb_count, fdb_count + 2);
+        ASSERT_TRUE(gPortsOrch->decrFdbCount("Ethernet0", 2));
+        ASSERT_EQ(port->m_fdb_count, fdb_count);
+    }
+
+    /**
+     * Test that verifies the PortRegistry indices follow the ports
+     */
+    TEST(PortRegistryTest, Indices)
+    {
+        PortRegistry registry;
+
+        registry["Ethernet0"] = Port("Ethernet0", Port::PHY);
+
+        // Stored in place, found by a scan then indexed
+        Port vlan10("Vlan10", Port::VLAN);
+        vlan10.m_vlan_info.vlan_id = 10;
+        registry["Vlan10"] = vlan10;
+
+        Port vlan20("Vlan20", Port::VLAN);
+        vlan20.m_vlan_info.vlan_id = 20;
+        registry["Vlan20"] = vlan20;
+        registry.indexVlan("Vlan20");
+
+        ASSERT_EQ(registry.size(), 3);
+        ASSERT_EQ(&registry.find("Ethernet0")->second, &registry["Ethernet0"]);
+        ASSERT_EQ(registry.findVlan(10)->first, "Vlan10");
+        ASSERT_EQ(registry.findVlan(20)->first, "Vlan20");
+        ASSERT_EQ(registry.findVlan(30), registry.end());
+
+        ASSERT_EQ(registry.erase("Vlan20"), 1);
+        ASSERT_EQ(registry.find("Vlan20"), registry.end());
+        ASSERT_EQ(registry.findVlan(20), registry.end());
+        ASSERT_EQ(registry.count("Vlan20"), 0);
+
+        for (auto it = registry.begin(); it != registry.end();)
+        {
+            it = registry.erase(it);
+        }
+        ASSERT_TRUE(registry.empty());
+        ASSERT_EQ(registry.find("Ethernet0"), registry.end());
+        ASSERT_EQ(registry.findVlan(10), registry.end());
+    }
+
     TEST_F(PortsOrchTest, PortDeleteQueueCountersCleanup)
     {
         Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
@@ -2318,6 +2621,69 @@ namespace portsorch_test
         ASSERT_TRUE(countersQueuePortMap.hget("", sai_serialize_object_id(readdedQ1), dummy));
     }
 
+    /*
+    * Test a port group removed and created again, each in one drain
+    */
+    TEST_F(PortsOrchTest, PortGroupDeleteAndReadd)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        std::deque<KeyOpFieldsValuesTuple> entries;
+
+        auto &ports = defaultPortList;
+        ASSERT_TRUE(!ports.empty());
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { "lanes", "0" } });
+
+        gPortsOrch->addExistingData(&portTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        const vector<string> group = { "Ethernet0", "Ethernet4", "Ethernet8" };
+        map<string, sai_object_id_t> oids;
+        for (const auto &alias : group)
+        {
+            Port port;
+            ASSERT_TRUE(gPortsOrch->getPort(alias, port));
+            oids[alias] = port.m_port_id;
+            entries.push_back({alias, "DEL", { { } }});
+        }
+
+        auto consumer = dynamic_cast<Consumer *>(gPortsOrch->getExecutor(APP_PORT_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+        entries.clear();
+
+        for (const auto &alias : group)
+        {
+            Port port;
+            ASSERT_FALSE(gPortsOrch->getPort(alias, port));
+            ASSERT_EQ(gPortsOrch->saiOidToAlias.count(oids[alias]), 0);
+        }
+        ASSERT_TRUE(gPortsOrch->m_portRemoveBulkOps.empty());
+        ASSERT_EQ(consumer->m_toSync.size(), 0);
+
+        for (const auto &alias : group)
+        {
+            entries.push_back({alias, "SET", ports.at(alias)});
+        }
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+        entries.clear();
+
+        for (const auto &alias : group)
+        {
+            Port port;
+            ASSERT_TRUE(gPortsOrch->getPort(alias, port));
+            ASSERT_NE(port.m_port_id, SAI_NULL_OBJECT_ID);
+            ASSERT_TRUE(port.m_init);
+        }
+    }
+
     TEST_F(PortsOrchTest, PortPTConfigDefaultTimestampTemplate)
     {
         auto portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
@@ -4440,6 +4806,64 @@ namespace portsorch_test
         ts.clear();
     }
 
+    TEST_F(PortsOrchTest, PfcZeroBufferHandlerBulk)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        // Populate port table with SAI ports
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone, PortInitDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { "lanes", "0" } });
+
+        // refill consumer
+        gPortsOrch->addExistingData(&portTable);
+
+        // Apply configuration :
+        //  create ports
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_TRUE(gPortsOrch->allPortsReady());
+
+        // Simulate storm drop handlers started on Ethernet0 TC 3 and 4 in one poll
+        Port port;
+        gPortsOrch->getPort("Ethernet0", port);
+
+        auto countersTable = make_shared<Table>(m_counters_db.get(), COUNTERS_TABLE);
+
+        PfcWdActionHandler::beginBulk();
+        auto dropHandler3 = make_unique<PfcWdZeroBufferHandler>(port.m_port_id, port.m_queue_ids[3], 3, countersTable);
+        auto dropHandler4 = make_unique<PfcWdZeroBufferHandler>(port.m_port_id, port.m_queue_ids[4], 4, countersTable);
+
+        // Nothing is applied until the bulk ends
+        gPortsOrch->getPort("Ethernet0", port);
+        ASSERT_FALSE(port.m_queue_lock[3]);
+        ASSERT_FALSE(port.m_queue_lock[4]);
+
+        PfcWdActionHandler::endBulk();
+        ASSERT_FALSE(PfcWdActionHandler::isBulk());
+
+        gPortsOrch->getPort("Ethernet0", port);
+        ASSERT_TRUE(port.m_queue_lock[3]);
+        ASSERT_TRUE(port.m_queue_lock[4]);
+        ASSERT_FALSE(port.m_queue_lock[5]);
+
+        // release zero buffer drop handlers
+        dropHandler3.reset();
+        dropHandler4.reset();
+
+        gPortsOrch->getPort("Ethernet0", port);
+        ASSERT_FALSE(port.m_queue_lock[3]);
+        ASSERT_FALSE(port.m_queue_lock[4]);
+    }
+
     /* This test passes an incorrect LAG entry and verifies that this entry is not
      * erased from the consumer table.
      */
@@ -305,4 +305,93 @@ namespace portsyncd_ut
         std::vector<swss::FieldValueTuple> ovalues;
         ASSERT_EQ(sync.m_statePortTable.get("Ethernet0", ovalues), false);
     }
+
+    TEST_F(PortSyncdTest, test_onMsgCoalesced)
+    {
+        swss::LinkSync sync(m_app_db.get(), m_state_db.get());
+        populateCfgDb(m_portCfgTable.get());
+        swss::DBConnector cfg_db_conn("CONFIG_DB", 0);
+        swss::ProducerStateTable p(m_app_db.get(), APP_PORT_TABLE_NAME);
+        writeToApplDB(p, cfg_db_conn);
+
+        sync.setCoalesceWindow(1000);
+
+        /* Oper up then down within the window */
+        struct nl_object* msg = draft_nlmsg("Ethernet0", {IFF_UP, IFF_RUNNING}, "sx_netdev",
+                                            "1c:34:da:1c:9f:00", 142, 9100, 0);
+        sync.onMsg(RTM_NEWLINK, msg);
+        free_nlobj(msg);
+        msg = draft_nlmsg("Ethernet0", {IFF_UP}, "sx_netdev", "1c:34:da:1c:9f:00", 142, 9100, 0);
+        sync.onMsg(RTM_NEWLINK, msg);
+        free_nlobj(msg);
+
+        /* Held until the window expires */
+        std::vector<swss::FieldValueTuple> ovalues;
+        ASSERT_EQ(sync.m_statePortTable.get("Ethernet0", ovalues), false);
+        ASSERT_GT(sync.getPendingTimeout(), 0);
+        ASSERT_EQ(sync.flushPendingEvents(), 0u);
+
+        ASSERT_EQ(sync.flushPendingEvents(true), 1u);
+        ASSERT_EQ(sync.getPendingTimeout(), -1);
+        std::string value;
+        ASSERT_TRUE(sync.m_statePortTable.hget("Ethernet0", "netdev_oper_status", value));
+        ASSERT_EQ(value, "down");
+    }
+
+    TEST_F(PortSyncdTest, test_onMsgUnchangedNotPublished)
+    {
+        swss::LinkSync sync(m_app_db.get(), m_state_db.get());
+        populateCfgDb(m_portCfgTable.get());
+        swss::DBConnector cfg_db_conn("CONFIG_DB", 0);
+        swss::ProducerStateTable p(m_app_db.get(), APP_PORT_TABLE_NAME);
+        writeToApplDB(p, cfg_db_conn);
+
+        struct nl_object* msg = draft_nlmsg("Ethernet0", {IFF_UP, IFF_RUNNING}, "sx_netdev",
+                                            "1c:34:da:1c:9f:00", 142, 9100, 0);
+        sync.onMsg(RTM_NEWLINK, msg);
+
+        /* Cleared behind portsyncd's back, an event with no change does not write it again */
+        sync.m_statePortTable.del("Ethernet0");
+        sync.onMsg(RTM_NEWLINK, msg);
+        free_nlobj(msg);
+        std::vector<swss::FieldValueTuple> ovalues;
+        ASSERT_EQ(sync.m_statePortTable.get("Ethernet0", ovalues), false);
+
+        /* An MTU change does */
+        msg = draft_nlmsg("Ethernet0", {IFF_UP, IFF_RUNNING}, "sx_netdev", "1c:34:da:1c:9f:00", 142, 1500, 0);
+        sync.onMsg(RTM_NEWLINK, msg);
+        free_nlobj(msg);
+        std::string value;
+        ASSERT_TRUE(sync.m_statePortTable.hget("Ethernet0", "mtu", value));
+        ASSERT_EQ(value, "1500");
+    }
+
+    TEST_F(PortSyncdTest, test_resyncDeletesGonePorts)
+    {
+        swss::LinkSync sync(m_app_db.get(), m_state_db.get());
+        populateCfgDb(m_portCfgTable.get());
+        swss::DBConnector cfg_db_conn("CONFIG_DB", 0);
+        swss::ProducerStateTable p(m_app_db.get(), APP_PORT_TABLE_NAME);
+        writeToApplDB(p, cfg_db_conn);
+
+        struct nl_object* msg0 = draft_nlmsg("Ethernet0", {IFF_UP, IFF_RUNNING}, "sx_netdev",
+                                             "1c:34:da:1c:9f:00", 142, 9100, 0);
+        struct nl_object* msg4 = draft_nlmsg("Ethernet4", {IFF_UP, IFF_RUNNING}, "sx_netdev",
+                                             "1c:34:da:1c:9f:04", 143, 9100, 0);
+        sync.onMsg(RTM_NEWLINK, msg0);
+        sync.onMsg(RTM_NEWLINK, msg4);
+
+        /* The dump only reports Ethernet0, the DELLINK of Ethernet4 was lost */
+        sync.startResync();
+        ASSERT_TRUE(sync.isResyncing());
+        sync.onMsg(RTM_NEWLINK, msg0);
+        sync.endResync();
+        ASSERT_FALSE(sync.isResyncing());
+        free_nlobj(msg0);
+        free_nlobj(msg4);
+
+        std::vector<swss::FieldValueTuple> ovalues;
+        ASSERT_EQ(sync.m_statePortTable.get("Ethernet0", ovalues), true);
+        ASSERT_EQ(sync.m_statePortTable.get("Ethernet4", ovalues), false);
+    }
 }
@@ -0,0 +1,86 @@
+#include "prefixtrie.h"
+
+#include <gtest/gtest.h>
+
+namespace prefixtrie_test
+{
+    using namespace std;
+    using namespace swss;
+
+    static int match(const PrefixTrie<int> &trie, const string &prefix)
+    {
+        auto value = trie.longestMatch(IpPrefix(prefix));
+        return value ? *value : 0;
+    }
+
+    TEST(PrefixTrieTest, FindsLongestCoveringPrefix)
+    {
+        PrefixTrie<int> trie;
+
+        ASSERT_TRUE(trie.insert(IpPrefix("0.0.0.0/0"), 1));
+        ASSERT_TRUE(trie.insert(IpPrefix("10.0.0.0/8"), 2));
+        ASSERT_TRUE(trie.insert(IpPrefix("10.1.0.0/16"), 3));
+        ASSERT_TRUE(trie.insert(IpPrefix("fc00::/64"), 4));
+        ASSERT_FALSE(trie.insert(IpPrefix("10.0.0.0/8"), 5));
+        ASSERT_EQ(trie.size(), 4u);
+
+        ASSERT_EQ(match(trie, "10.1.2.0/24"), 3);
+        ASSERT_EQ(match(trie, "10.2.0.0/16"), 2);
+        ASSERT_EQ(match(trie, "10.0.0.0/8"), 2);
+        ASSERT_EQ(match(trie, "11.0.0.0/8"), 1);
+        ASSERT_EQ(match(trie, "0.0.0.0/0"), 1);
+
+        // A shorter route is not covered by a longer prefix
+        ASSERT_EQ(match(trie, "10.0.0.0/7"), 1);
+
+        ASSERT_EQ(match(trie, "fc00::1/128"), 4);
+        ASSERT_EQ(match(trie, "fc00::/48"), 0);
+        ASSERT_EQ(match(trie, "fc01::/64"), 0);
+    }
+
+    TEST(PrefixTrieTest, EraseRemovesPrefix)
+    {
+        PrefixTrie<int> trie;
+
+        trie.insert(IpPrefix("10.0.0.0/8"), 1);
+        trie.insert(IpPrefix("10.1.0.0/16"), 2);
+
+        ASSERT_TRUE(trie.erase(IpPrefix("10.1.0.0/16")));
+        ASSERT_FALSE(trie.erase(IpPrefix("10.1.0.0/16")));
+        ASSERT_FALSE(trie.erase(IpPrefix("10.0.0.0/16")));
+        ASSERT_EQ(match(trie, "10.1.1.0/24"), 1);
+
+        ASSERT_TRUE(trie.erase(IpPrefix("10.0.0.0/8")));
+        ASSERT_TRUE(trie.empty());
+        ASSERT_EQ(match(trie, "10.1.1.0/24"), 0);
+
+        ASSERT_TRUE(trie.insert(IpPrefix("10.0.0.0/8"), 3));
+        ASSERT_EQ(match(trie, "10.1.1.0/24"), 3);
+    }
+
+    TEST(PrefixTrieTest, FindsAddressesAndPrefixesWithin)
+    {
+        PrefixTrie<int> trie;
+
+        trie.insert(IpPrefix("10.0.0.1/24"), 1);
+        trie.insert(IpPrefix("fc00::1/64"), 2);
+
+        // Host bits of the stored prefixes are ignored
+        ASSERT_NE(trie.find(IpPrefix("10.0.0.0/24")), nullptr);
+        ASSERT_EQ(*trie.find(IpPrefix("10.0.0.0/24")), 1);
+        ASSERT_EQ(trie.find(IpPrefix("10.0.0.0/16")), nullptr);
+
+        ASSERT_EQ(*trie.longestMatch(IpAddress("10.0.0.7")), 1);
+        ASSERT_EQ(*trie.longestMatch(IpAddress("fc00::7")), 2);
+        ASSERT_EQ(trie.longestMatch(IpAddress("10.0.1.7")), nullptr);
+
+        ASSERT_TRUE(trie.hasWithin(IpPrefix("10.0.0.0/8")));
+        ASSERT_TRUE(trie.hasWithin(IpPrefix("10.0.0.0/24")));
+        ASSERT_FALSE(trie.hasWithin(IpPrefix("10.0.0.0/25")));
+        ASSERT_FALSE(trie.hasWithin(IpPrefix("11.0.0.0/8")));
+
+        trie.erase(IpPrefix("10.0.0.0/24"));
+        ASSERT_FALSE(trie.hasWithin(IpPrefix("0.0.0.0/0")));
+        ASSERT_TRUE(trie.hasWithin(IpPrefix("::/0")));
+    }
+}
@@ -1223,6 +1223,77 @@ namespace qosorch_test
         ASSERT_EQ((*QosOrch::getTypeMap()[CFG_DSCP_TO_TC_MAP_TABLE_NAME])["AZURE"].m_saiObjectId, switch_dscp_to_tc_map_id);
     }
 
+    TEST_F(QosOrchTest, QosOrchTestSharedQosMap)
+    {
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        auto &dscpToTcMaps = *QosOrch::getTypeMap()[CFG_DSCP_TO_TC_MAP_TABLE_NAME];
+        auto shared_object = dscpToTcMaps["AZURE"].m_saiObjectId;
+        auto current_sai_remove_qos_map_count = sai_remove_qos_map_count;
+
+        // A map of the same contents in another order shares the object
+        entries.push_back({"AZURE_1", "SET",
+                           {
+                               {"1", "1"},
+                               {"0", "0"}
+                           }});
+        auto consumer = dynamic_cast<Consumer *>(gQosOrch->getExecutor(CFG_DSCP_TO_TC_MAP_TABLE_NAME));
+        consumer->addToSync(entries);
+        entries.clear();
+        static_cast<Orch *>(gQosOrch)->doTask();
+        ASSERT_EQ(dscpToTcMaps["AZURE_1"].m_saiObjectId, shared_object);
+        ASSERT_EQ(gQosOrch->getSharedQosMapRefCount(shared_object), 2u);
+
+        entries.push_back({"Ethernet0", "SET",
+                           {
+                               {"dscp_to_tc_map", "AZURE_1"}
+                           }});
+        consumer = dynamic_cast<Consumer *>(gQosOrch->getExecutor(CFG_PORT_QOS_MAP_TABLE_NAME));
+        consumer->addToSync(entries);
+        entries.clear();
+        static_cast<Orch *>(gQosOrch)->doTask();
+        CheckDependency(CFG_PORT_QOS_MAP_TABLE_NAME, "Ethernet0", "dscp_to_tc_map", CFG_DSCP_TO_TC_MAP_TABLE_NAME, "AZURE_1");
+
+        // Changing the contents moves the map to an object of its own, and the port is re-bound to it
+        entries.push_back({"AZURE_1", "SET",
+                           {
+                               {"1", "0"},
+                               {"0", "1"}
+                           }});
+        consumer = dynamic_cast<Consumer *>(gQosOrch->getExecutor(CFG_DSCP_TO_TC_MAP_TABLE_NAME));
+        consumer->addToSync(entries);
+        entries.clear();
+        static_cast<Orch *>(gQosOrch)->doTask();
+        auto moved_object = dscpToTcMaps["AZURE_1"].m_saiObjectId;
+        ASSERT_NE(moved_object, shared_object);
+        ASSERT_EQ(dscpToTcMaps["AZURE"].m_saiObjectId, shared_object);
+        ASSERT_EQ(gQosOrch->getSharedQosMapRefCount(shared_object), 1u);
+        ASSERT_EQ(current_sai_remove_qos_map_count, sai_remove_qos_map_count);
+
+        Port port;
+        gPortsOrch->getPort("Ethernet0", port);
+        sai_attribute_t attr;
+        attr.id = SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP;
+        ASSERT_EQ(sai_port_api->get_port_attribute(port.m_port_id, 1, &attr), SAI_STATUS_SUCCESS);
+        ASSERT_EQ(attr.value.oid, moved_object);
+
+        // Removing a map that still shares its object keeps the object
+        entries.push_back({"AZURE_2", "SET",
+                           {
+                               {"0", "0"},
+                               {"1", "1"}
+                           }});
+        consumer->addToSync(entries);
+        entries.clear();
+        static_cast<Orch *>(gQosOrch)->doTask();
+        ASSERT_EQ(dscpToTcMaps["AZURE_2"].m_saiObjectId, shared_object);
+
+        RemoveItem(CFG_DSCP_TO_TC_MAP_TABLE_NAME, "AZURE_2");
+        static_cast<Orch *>(gQosOrch)->doTask();
+        ASSERT_EQ(dscpToTcMaps.count("AZURE_2"), 0);
+        ASSERT_EQ(current_sai_remove_qos_map_count, sai_remove_qos_map_count);
+        ASSERT_EQ(gQosOrch->getSharedQosMapRefCount(shared_object), 1u);
+    }
+
     TEST_F(QosOrchTest, QosOrchTestRetryFirstItem)
     {
         // There was a bug in QosOrch that the 2nd notifications and after can not be handled, eg the 1st one needs to be retried
@@ -0,0 +1,97 @@
+#include "referenceset.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <string>
+
+namespace referenceset_test
+{
+    using namespace std;
+
+    static set<string> contents(const ReferenceSet &refs)
+    {
+        return set<string>(refs.begin(), refs.end());
+    }
+
+    TEST(ReferenceSetTest, SetInterface)
+    {
+        ReferenceSet refs;
+
+        ASSERT_TRUE(refs.empty());
+        ASSERT_EQ(refs.find("Ethernet0:3"), refs.end());
+        ASSERT_EQ(refs.erase("Ethernet0:3"), 0);
+
+        ASSERT_TRUE(refs.insert("Ethernet0:3").second);
+        ASSERT_FALSE(refs.insert("Ethernet0:3").second);
+        ASSERT_TRUE(refs.insert("Ethernet4:3").second);
+
+        ASSERT_EQ(refs.size(), 2);
+        ASSERT_EQ(refs.count("Ethernet0:3"), 1);
+        ASSERT_EQ(refs.count("Ethernet8:3"), 0);
+        ASSERT_EQ(*refs.find("Ethernet4:3"), "Ethernet4:3");
+        ASSERT_EQ(contents(refs), set<string>({"Ethernet0:3", "Ethernet4:3"}));
+
+        ASSERT_EQ(refs.erase("Ethernet0:3"), 1);
+        ASSERT_EQ(refs.count("Ethernet0:3"), 0);
+        ASSERT_EQ(refs.size(), 1);
+
+        refs.clear();
+        ASSERT_TRUE(refs.empty());
+        ASSERT_EQ(refs.begin(), refs.end());
+    }
+
+    TEST(ReferenceSetTest, NamesAreReleasedWithLastReference)
+    {
+        auto &pool = ObjectNamePool::instance();
+        auto base = pool.size();
+
+        {
+            ReferenceSet a;
+            a.insert("profile_a");
+            a.insert("profile_b");
+
+            ReferenceSet b(a);
+            ASSERT_EQ(pool.size(), base + 2);
+
+            a.erase("profile_a");
+            ASSERT_EQ(pool.size(), base + 2);
+            ASSERT_EQ(b.count("profile_a"), 1);
+
+            b.erase("profile_a");
+            ASSERT_EQ(pool.size(), base + 1);
+            ASSERT_TRUE(pool.lookup("profile_a") == ObjectNamePool::INVALID_HANDLE);
+
+            ReferenceSet c(std::move(b));
+            ASSERT_TRUE(b.empty());
+            ASSERT_EQ(c.count("profile_b"), 1);
+        }
+
+        ASSERT_EQ(pool.size(), base);
+    }
+
+    TEST(ReferenceSetTest, MatchesStdSet)
+    {
+        ReferenceSet refs;
+        set<string> expected;
+        mt19937 rng(1);
+
+        // Mixed churn exercises tombstones, rehashing and handle reuse
+        for (int i = 0; i < 20000; i++)
+        {
+            string name = "obj" + to_string(rng() % 500);
+            if (rng() % 3 == 0)
+            {
+                ASSERT_EQ(refs.erase(name), expected.erase(name));
+            }
+            else
+            {
+                ASSERT_EQ(refs.insert(name).second, expected.insert(name).second);
+            }
+            ASSERT_EQ(refs.size(), expected.size());
+        }
+
+        ASSERT_EQ(contents(refs), expected);
+    }
+}
@@ -58,3 +58,52 @@ TEST(ResponsePublisher, TestPublishEnableDbWrite)
     ASSERT_EQ(value, "new-value");
 }
 
+
+TEST(ResponsePublisher, TestPublishBulk)
+{
+    DBConnector conn{"APPL_STATE_DB", 0};
+    Table stateTable{&conn, "SOME_TABLE"};
+    std::string value;
+    ResponsePublisher publisher{"APPL_STATE_DB"};
+
+    publisher.setBuffered(true);
+
+    publisher.publish("SOME_TABLE", "OLD_KEY", {{"field", "value"}}, ReturnCode(SAI_STATUS_SUCCESS));
+    publisher.publishBulk("SOME_TABLE", {{"BULK_KEY1", {{"field", "value1"}}, ReturnCode(SAI_STATUS_SUCCESS)},
+                                         {"BULK_KEY2", {{"field", "value2"}}, ReturnCode(SAI_STATUS_FAILURE)},
+                                         {"OLD_KEY", {}, ReturnCode(SAI_STATUS_SUCCESS)}});
+    publisher.flush();
+
+    ASSERT_TRUE(stateTable.hget("BULK_KEY1", "field", value));
+    ASSERT_EQ(value, "value1");
+    // Failed responses do not write the state
+    ASSERT_FALSE(stateTable.hget("BULK_KEY2", "field", value));
+    // Successful responses without attributes delete the state
+    ASSERT_FALSE(stateTable.hget("OLD_KEY", "field", value));
+}
+
+TEST(ResponsePublisher, TestPublishBulkDbWriteThread)
+{
+    DBConnector conn{"APPL_STATE_DB", 0};
+    Table stateTable{&conn, "SOME_TABLE"};
+    std::string value;
+
+    // More responses than the initial ring slots
+    std::vector<ResponsePublisher::Response> bulk;
+    for (int i = 0; i < 1500; i++)
+    {
+        bulk.push_back({"THREAD_KEY" + std::to_string(i), {{"field", std::to_string(i)}},
+                        ReturnCode(SAI_STATUS_SUCCESS)});
+    }
+
+    {
+        ResponsePublisher publisher{"APPL_STATE_DB", /*buffered=*/false, /*db_write_thread=*/true};
+        publisher.publishBulk("SOME_TABLE", bulk);
+        // The writes pending at destruction are done before the thread exits
+    }
+
+    ASSERT_TRUE(stateTable.hget("THREAD_KEY0", "field", value));
+    ASSERT_EQ(value, "0");
+    ASSERT_TRUE(stateTable.hget("THREAD_KEY1499", "field", value));
+    ASSERT_EQ(value, "1499");
+}
@@ -314,4 +314,103 @@ namespace retrycache_test
                 ASSERT_FALSE(true); // unexpected field
         }
     }
+
+    TEST_F(RetryCacheTest, ResolveInFailureOrder)
+    {
+        for (auto key: {"key3", "key1", "key2"})
+        {
+            cache->insert({key, "SET", {{"PIC", "2"}}}, cst);
+        }
+
+        // A queued key keeps its place
+        ASSERT_FALSE(cache->m_retryKeys[cst].insert("key3"));
+        ASSERT_EQ(*cache->m_retryKeys[cst].begin(), "key3");
+        ASSERT_EQ(cache->m_retryKeys[cst].size(), 3);
+
+        auto tasks = cache->resolve(cst, 2);
+        ASSERT_EQ(tasks->size(), 2);
+        ASSERT_EQ(kfvKey((*tasks)[0]), "key3");
+        ASSERT_EQ(kfvKey((*tasks)[1]), "key1");
+
+        tasks = cache->resolve(cst);
+        ASSERT_EQ(tasks->size(), 1);
+        ASSERT_EQ(kfvKey((*tasks)[0]), "key2");
+        ASSERT_TRUE(cache->m_retryKeys.empty());
+    }
+
+    TEST_F(RetryCacheTest, ResolvedConstraintsShareQuota)
+    {
+        Constraint busy = make_constraint(RETRY_CST_PIC, "busy");
+        Constraint quiet = make_constraint(RETRY_CST_PIC, "quiet");
+
+        for (int i = 0; i < 10; i++)
+        {
+            cache->insert({"busy" + std::to_string(i), "SET", {}}, busy);
+        }
+        cache->insert({"quiet0", "SET", {}}, quiet);
+        cache->insert({"quiet1", "SET", {}}, quiet);
+
+        cache->mark_resolved(busy);
+        cache->mark_resolved(quiet);
+        // Notifying again does not give the constraint a second turn
+        cache->mark_resolved(busy);
+        ASSERT_EQ(cache->m_resolvedOrder.size(), 2);
+
+        // The busy constraint was resolved first but cannot take the whole quota
+        auto tasks = cache->resolveResolved(4);
+        ASSERT_EQ(tasks->size(), 4);
+        size_t quietTasks = 0;
+        for (auto &task: *tasks)
+        {
+            if (kfvKey(task).compare(0, 5, "quiet") == 0)
+                quietTasks++;
+        }
+        ASSERT_EQ(quietTasks, 2);
+        ASSERT_EQ(cache->m_resolvedOrder.size(), 1);
+        ASSERT_EQ(cache->m_resolvedOrder.front(), busy);
+
+        tasks = cache->resolveResolved(100);
+        ASSERT_EQ(tasks->size(), 8);
+        ASSERT_EQ(kfvKey(tasks->front()), "busy2");
+        ASSERT_TRUE(cache->m_resolvedOrder.empty());
+        ASSERT_TRUE(cache->getResolvedConstraints().empty());
+        ASSERT_TRUE(cache->getRetryMap().empty());
+    }
+
+    TEST_F(RetryCacheTest, EvictDropsResolvedConstraint)
+    {
+        cache->insert({"key", "SET", {{"PIC", "2"}}}, cst);
+        cache->mark_resolved(cst);
+        ASSERT_EQ(cache->m_resolvedOrder.size(), 1);
+
+        ASSERT_NE(cache->evict("key"), nullptr);
+        ASSERT_TRUE(cache->m_resolvedOrder.empty());
+        ASSERT_TRUE(cache->getResolvedConstraints().empty());
+        ASSERT_TRUE(cache->resolveResolved()->empty());
+    }
+
+    TEST(RetryCacheStatsTest, CountsParkedAndWokenTasks)
+    {
+        ExecutorStatsRegistry::instance().setEnabled(true);
+        RetryCache rc("RetryCacheStatsTest");
+        auto stats = ExecutorStatsRegistry::instance().attach("RetryCacheStatsTest");
+        ExecutorStatsRegistry::instance().setEnabled(false);
+        ASSERT_TRUE(stats);
+
+        Constraint cst = make_constraint(RETRY_CST_NEIGH, "10.0.0.1@Ethernet0");
+        rc.insert({"10.1.0.0/24", "SET", {{"nexthop", "10.0.0.1"}}}, cst);
+        rc.insert({"10.2.0.0/24", "SET", {{"nexthop", "10.0.0.1"}}}, cst);
+        rc.insert({"10.3.0.0/24", "SET", {{"nexthop", "10.0.0.1"}}}, cst);
+        ASSERT_EQ(stats->totalRetryCached.load(), 3);
+        ASSERT_EQ(stats->retryPending.load(), 3);
+
+        ASSERT_NE(rc.evict("10.3.0.0/24"), nullptr);
+        ASSERT_EQ(stats->totalRetryEvicted.load(), 1);
+
+        rc.mark_resolved(cst);
+        ASSERT_EQ(rc.resolveResolved()->size(), 2);
+        ASSERT_EQ(stats->totalRetryWoken.load(), 2);
+        ASSERT_EQ(stats->retryPending.load(), 0);
+        ASSERT_EQ(stats->retryWaitUsec.count(), 2);
+    }
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "mock_response_publisher.h"
 #include "mock_sai_api.h"
 #include "bulker.h"
+#include "routebinary.h"
 
 extern string gMySwitchType;
 
@@ -1026,4 +1027,373 @@ namespace routeorch_test
         ASSERT_EQ(gRouteOrch->gRouteBulker.setting_entries_count(), 0);
         ASSERT_EQ(gRouteOrch->gRouteBulker.removing_entries_count(), 0);
     }
+
+    TEST_F(RouteOrchTest, RouteNhgSharesInternedKey)
+    {
+        size_t interned = NextHopGroupKeyRef::internedCount();
+        {
+            RouteNhg first(NextHopGroupKey("192.0.2.1,192.0.2.2"), "");
+            RouteNhg second(NextHopGroupKey("192.0.2.2,192.0.2.1"), "");
+
+            ASSERT_EQ(&first.nhg_key.get(), &second.nhg_key.get());
+            ASSERT_TRUE(first.nhg_key == NextHopGroupKey("192.0.2.1,192.0.2.2"));
+            ASSERT_EQ(first.nhg_key->getSize(), 2);
+            ASSERT_EQ(NextHopGroupKeyRef::internedCount(), interned + 1);
+
+            second.nhg_key = NextHopGroupKey("192.0.2.1");
+            ASSERT_TRUE(first != second);
+            ASSERT_EQ(NextHopGroupKeyRef::internedCount(), interned + 2);
+        }
+        ASSERT_EQ(NextHopGroupKeyRef::internedCount(), interned);
+
+        RouteNhg empty;
+        ASSERT_EQ(empty.nhg_key->getSize(), 0);
+    }
+
+    TEST_F(RouteOrchTest, NextHopGroupKeyRefParseSharesKey)
+    {
+        size_t interned = NextHopGroupKeyRef::internedCount();
+        {
+            auto first = NextHopGroupKeyRef::parse("192.0.2.3@Ethernet0,192.0.2.4@Ethernet4");
+            auto second = NextHopGroupKeyRef::parse("192.0.2.3@Ethernet0,192.0.2.4@Ethernet4");
+            auto reordered = NextHopGroupKeyRef::parse("192.0.2.4@Ethernet4,192.0.2.3@Ethernet0");
+            auto weighted = NextHopGroupKeyRef::parse("192.0.2.3@Ethernet0,192.0.2.4@Ethernet4", "1,2");
+
+            ASSERT_EQ(&first.get(), &second.get());
+            ASSERT_EQ(&first.get(), &reordered.get());
+            ASSERT_NE(&first.get(), &weighted.get());
+            ASSERT_EQ(first.hash(), std::hash<NextHopGroupKey>()(NextHopGroupKey("192.0.2.3@Ethernet0,192.0.2.4@Ethernet4")));
+            ASSERT_EQ(NextHopGroupKeyRef::internedCount(), interned + 2);
+
+            RouteNhg route(first, "");
+            ASSERT_EQ(&route.nhg_key.get(), &first.get());
+        }
+        ASSERT_EQ(NextHopGroupKeyRef::internedCount(), interned);
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchParseRouteRequest)
+    {
+        RouteRequest req;
+        RouteOrch::parseRouteRequest({"Vrf1:2.2.2.0/24", "SET", { {"ifname", "Ethernet0,Ethernet4"},
+                                                                  {"nexthop", "10.0.0.2,10.0.0.3"},
+                                                                  {"protocol", "bgp"}}}, req);
+        ASSERT_EQ(req.vrf_name, "Vrf1");
+        ASSERT_TRUE(req.prefix_valid);
+        ASSERT_EQ(req.ip_prefix, IpPrefix("2.2.2.0/24"));
+        ASSERT_EQ(req.protocol, "bgp");
+        ASSERT_EQ(req.ipv, vector<string>({"10.0.0.2", "10.0.0.3"}));
+        ASSERT_EQ(req.alsv, vector<string>({"Ethernet0", "Ethernet4"}));
+
+        RouteRequest invalid;
+        RouteOrch::parseRouteRequest({"not_a_prefix", "DEL", {}}, invalid);
+        ASSERT_FALSE(invalid.prefix_valid);
+        ASSERT_TRUE(invalid.vrf_name.empty());
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchParseThreads)
+    {
+        RouteOrch::setParseThreads(2);
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        for (int i = 0; i < 600; i++)
+        {
+            entries.push_back({"3." + to_string(i / 256) + "." + to_string(i % 256) + ".0/24", "SET",
+                               { {"ifname", "Ethernet0"}, {"nexthop", "10.0.0.2"}}});
+        }
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        auto current_create_count = create_route_count;
+
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        RouteOrch::setParseThreads(0);
+
+        ASSERT_EQ(current_create_count + 600, create_route_count);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_TRUE(gRouteOrch->isRouteExists(gVirtualRouterId, IpPrefix("3.2.87.0/24")));
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchNextHopGroupMemberIndex)
+    {
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        std::vector<FieldValueTuple> fvs{{"ifname", "Ethernet0,Ethernet0"}, {"nexthop", "10.0.0.2,10.0.0.3"}};
+        entries.push_back({"4.4.1.0/24", "SET", fvs});
+        entries.push_back({"4.4.2.0/24", "SET", fvs});
+
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        NextHopKey nh("10.0.0.2", "Ethernet0");
+        NextHopGroupKey nhg_key("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0");
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg_key));
+        ASSERT_EQ(gRouteOrch->m_nextHopGroupMembers.at(nh).size(), 1);
+        ASSERT_EQ(gRouteOrch->m_nextHopGroupMembers.at(NextHopKey("10.0.0.3", "Ethernet0")).size(), 1);
+
+        // Both routes share one group, so one member goes away and comes back
+        uint32_t count = 0;
+        ASSERT_TRUE(gRouteOrch->invalidnexthopinNextHopGroup(nh, count));
+        ASSERT_EQ(count, 1);
+        ASSERT_EQ(gRouteOrch->m_syncdNextHopGroups[nhg_key].nh_member_install_count, 1);
+
+        ASSERT_TRUE(gRouteOrch->validnexthopinNextHopGroup(nh, count));
+        ASSERT_EQ(count, 1);
+        ASSERT_EQ(gRouteOrch->m_syncdNextHopGroups[nhg_key].nh_member_install_count, 2);
+        ASSERT_NE(gRouteOrch->m_syncdNextHopGroups[nhg_key].nhopgroup_members[nh].next_hop_id, SAI_NULL_OBJECT_ID);
+
+        entries.clear();
+        entries.push_back({"4.4.1.0/24", "DEL", {}});
+        entries.push_back({"4.4.2.0/24", "DEL", {}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg_key));
+        ASSERT_EQ(gRouteOrch->m_nextHopGroupMembers.count(nh), 0);
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchSharesNhgOrchNextHopGroup)
+    {
+        auto nhg_consumer = dynamic_cast<Consumer *>(gNhgOrch->getExecutor(APP_NEXTHOP_GROUP_TABLE_NAME));
+        std::deque<KeyOpFieldsValuesTuple> nhg_entries;
+        nhg_entries.push_back({"nhg1", "SET", {{"ifname", "Ethernet0,Ethernet0"}, {"nexthop", "10.0.0.2,10.0.0.3"}}});
+        nhg_consumer->addToSync(nhg_entries);
+        static_cast<Orch *>(gNhgOrch)->doTask();
+        ASSERT_TRUE(gNhgOrch->hasNhg("nhg1"));
+
+        auto nhg_count = gRouteOrch->getNhgCount();
+
+        // A route listing the next hops of nhg1 reuses it
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"4.4.1.0/24", "SET", {{"ifname", "Ethernet0,Ethernet0"}, {"nexthop", "10.0.0.2,10.0.0.3"}}});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        NextHopGroupKey nhg_key("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0");
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg_key));
+        ASSERT_EQ(gRouteOrch->m_syncdNextHopGroups[nhg_key].shared_nhg_index, "nhg1");
+        ASSERT_EQ(gRouteOrch->m_syncdNextHopGroups[nhg_key].next_hop_group_id, gNhgOrch->getNhg("nhg1").getId());
+        ASSERT_EQ(gRouteOrch->getNhgCount(), nhg_count);
+        ASSERT_EQ(gNhgOrch->m_syncdNextHopGroups.at("nhg1").ref_count, 1u);
+
+        // Updating nhg1 moves the route to a group of its own
+        nhg_entries.clear();
+        nhg_entries.push_back({"nhg1", "SET", {{"ifname", "Ethernet0"}, {"nexthop", "10.0.0.2"}}});
+        nhg_consumer->addToSync(nhg_entries);
+        static_cast<Orch *>(gNhgOrch)->doTask();
+
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg_key));
+        ASSERT_TRUE(gRouteOrch->m_syncdNextHopGroups[nhg_key].shared_nhg_index.empty());
+        ASSERT_EQ(gRouteOrch->m_syncdNextHopGroups[nhg_key].ref_count, 1);
+        ASSERT_EQ(gRouteOrch->getNhgCount(), nhg_count + 1);
+        ASSERT_EQ(gNhgOrch->m_syncdNextHopGroups.at("nhg1").ref_count, 0u);
+        ASSERT_TRUE(gNhgOrch->getShareableNhg(nhg_key).empty());
+
+        entries.clear();
+        entries.push_back({"4.4.1.0/24", "DEL", {}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg_key));
+
+        nhg_entries.clear();
+        nhg_entries.push_back({"nhg1", "DEL", {}});
+        nhg_consumer->addToSync(nhg_entries);
+        static_cast<Orch *>(gNhgOrch)->doTask();
+        ASSERT_FALSE(gNhgOrch->hasNhg("nhg1"));
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchLabelRouteCreatesMplsNextHops)
+    {
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"100", "SET", {{"ifname", "Ethernet0,Ethernet0"}, {"nexthop", "10.0.0.2,10.0.0.3"},
+                                          {"mpls_nh", "push201,push202"}}});
+        entries.push_back({"101", "SET", {{"ifname", "Ethernet0"}, {"nexthop", "10.0.0.2"}, {"mpls_nh", "push201"}}});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_LABEL_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        // The labeled next hops of both routes were created up front
+        NextHopKey nh1("push201+10.0.0.2@Ethernet0");
+        NextHopKey nh2("push202+10.0.0.3@Ethernet0");
+        ASSERT_TRUE(gNeighOrch->hasNextHop(nh1));
+        ASSERT_TRUE(gNeighOrch->hasNextHop(nh2));
+        ASSERT_EQ(consumer->m_toSync.size(), 0u);
+
+        auto &label_routes = gRouteOrch->m_syncdLabelRoutes[gVirtualRouterId];
+        ASSERT_EQ(label_routes.count(100), 1u);
+        ASSERT_EQ(label_routes.count(101), 1u);
+
+        entries.clear();
+        entries.push_back({"100", "DEL", {}});
+        entries.push_back({"101", "DEL", {}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_EQ(label_routes.count(100), 0u);
+        ASSERT_EQ(label_routes.count(101), 0u);
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchParksRouteOutOfNextHopGroups)
+    {
+        auto max_nhg_count = gRouteOrch->m_maxNextHopGroupCount;
+        gRouteOrch->m_maxNextHopGroupCount = gRouteOrch->getNhgCount() + NhgOrch::getSyncedNhgCount();
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"4.4.2.0/24", "SET", {{"ifname", "Ethernet0,Ethernet0"}, {"nexthop", "10.0.0.2,10.0.0.3"}}});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        // The route waits on a temporary route, out of the sync map
+        NextHopGroupKey nhg_key("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0");
+        auto retry_cache = gRouteOrch->getRetryCache(APP_ROUTE_TABLE_NAME);
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg_key));
+        ASSERT_EQ(retry_cache->getRetryMap().count("4.4.2.0/24"), 1u);
+        ASSERT_EQ(consumer->m_toSync.count("4.4.2.0/24"), 0u);
+
+        // Releasing a group retries the route
+        gRouteOrch->m_maxNextHopGroupCount = max_nhg_count;
+        gRouteOrch->notifyNextHopGroupReleased();
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg_key));
+        ASSERT_EQ(retry_cache->getRetryMap().count("4.4.2.0/24"), 0u);
+
+        entries.clear();
+        entries.push_back({"4.4.2.0/24", "DEL", {}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg_key));
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchParsesBinaryRouteLikeFields)
+    {
+        RouteBinaryWriter bin;
+        bin.addValue(ROUTE_BIN_PROTOCOL, "bgp");
+        bin.addList(ROUTE_BIN_NEXTHOP, "10.0.0.2,10.0.0.3");
+        bin.addList(ROUTE_BIN_IFNAME, "Ethernet0,Ethernet4");
+        bin.addValue(ROUTE_BIN_WEIGHT, "1,2");
+
+        std::vector<FieldValueTuple> fvs{{"protocol", "bgp"}, {"nexthop", "10.0.0.2,10.0.0.3"},
+                                         {"ifname", "Ethernet0,Ethernet4"}, {"weight", "1,2"}};
+        std::vector<FieldValueTuple> bin_fvs{{ROUTE_BINARY_FIELD, bin.str()}};
+
+        RouteRequest fields_req, bin_req;
+        RouteOrch::parseRouteRequest(KeyOpFieldsValuesTuple("Vrf1:4.4.3.0/24", "SET", fvs), fields_req);
+        RouteOrch::parseRouteRequest(KeyOpFieldsValuesTuple("Vrf1:4.4.3.0/24", "SET", bin_fvs), bin_req);
+
+        ASSERT_FALSE(bin_req.malformed);
+        ASSERT_EQ(bin_req.vrf_name, fields_req.vrf_name);
+        ASSERT_EQ(bin_req.ip_prefix, fields_req.ip_prefix);
+        ASSERT_EQ(bin_req.protocol, fields_req.protocol);
+        ASSERT_EQ(bin_req.ips, fields_req.ips);
+        ASSERT_EQ(bin_req.aliases, fields_req.aliases);
+        ASSERT_EQ(bin_req.weights, fields_req.weights);
+        ASSERT_EQ(bin_req.ipv, fields_req.ipv);
+        ASSERT_EQ(bin_req.alsv, fields_req.alsv);
+        ASSERT_EQ(bin_req.blackhole, fields_req.blackhole);
+
+        // Truncated
+        std::vector<FieldValueTuple> bad_fvs{{ROUTE_BINARY_FIELD, bin.str().substr(0, bin.str().size() - 1)}};
+        RouteRequest bad_req;
+        RouteOrch::parseRouteRequest(KeyOpFieldsValuesTuple("4.4.3.0/24", "SET", bad_fvs), bad_req);
+        ASSERT_TRUE(bad_req.malformed);
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchAddsBinaryRoute)
+    {
+        RouteBinaryWriter bin;
+        bin.addValue(ROUTE_BIN_PROTOCOL, "bgp");
+        bin.addList(ROUTE_BIN_NEXTHOP, "10.0.0.2,10.0.0.3");
+        bin.addList(ROUTE_BIN_IFNAME, "Ethernet0,Ethernet0");
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        std::vector<FieldValueTuple> fvs{{ROUTE_BINARY_FIELD, bin.str()}};
+        entries.push_back({"4.4.4.0/24", "SET", fvs});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        NextHopGroupKey nhg_key("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0");
+        ASSERT_TRUE(gRouteOrch->isRouteExists(gVirtualRouterId, IpPrefix("4.4.4.0/24")));
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg_key));
+
+        entries.clear();
+        entries.push_back({"4.4.4.0/24", "DEL", { {} }});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg_key));
+    }
+
+    TEST_F(RouteOrchTest, RouteDigestBuckets)
+    {
+        auto bucket = RouteDigest::getBucket("Vrf1:fe80::/64");
+        ASSERT_EQ(bucket.first, "Vrf1");
+        ASSERT_EQ(bucket.second, RouteDigest::getBucket("fe80::/64").second);
+        ASSERT_EQ(RouteDigest::getBucket("fe80::/64").first, "");
+
+        RouteDigest digest;
+        digest.set("Vrf1:fe80::/64", 1);
+        digest.set("Vrf1:fe80::/64", 2);
+        ASSERT_EQ(digest.getBuckets().at(bucket).value(), 2);
+        ASSERT_EQ(digest.getBuckets().at(bucket).count(), 1);
+
+        uint64_t value;
+        ASSERT_TRUE(digest.get("Vrf1:fe80::/64", value));
+        ASSERT_EQ(value, 2);
+
+        digest.del("Vrf1:fe80::/64");
+        ASSERT_FALSE(digest.get("Vrf1:fe80::/64", value));
+        ASSERT_TRUE(digest.getBuckets().empty());
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchResyncReconcilesDifferingRoutes)
+    {
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        Table routeTable = Table(m_app_db.get(), APP_ROUTE_TABLE_NAME);
+
+        // The routes of SetUp() are digested as done with
+        ASSERT_EQ(gRouteOrch->m_routeDigest.getEntries().size(), 2);
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"resync", "SET", { {"nexthop", "0.0.0.0"} }});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_TRUE(gRouteOrch->m_resync);
+
+        // Held during the window
+        auto current_create_count = create_route_count;
+        entries.clear();
+        entries.push_back({"1.1.1.0/24", "SET", { {"ifname", "Ethernet0"},
+                                                  {"nexthop", "10.0.0.2"}}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_EQ(consumer->m_toSync.size(), 1);
+
+        // Only in APPL_DB, no task for it
+        routeTable.set("2.2.2.0/24", { {"ifname", "Ethernet0" },
+                                       {"nexthop", "10.0.0.3" }});
+
+        entries.clear();
+        entries.push_back({"resync", "DEL", {}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_FALSE(gRouteOrch->m_resync);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_EQ(current_create_count + 1, create_route_count);
+        ASSERT_TRUE(gRouteOrch->isRouteExists(gVirtualRouterId, IpPrefix("2.2.2.0/24")));
+        ASSERT_EQ(gRouteOrch->m_routeDigest.getEntries().size(), 3);
+
+        // Removed from APPL_DB only, a stop alone reconciles as well
+        routeTable.del("2.2.2.0/24");
+        auto current_remove_count = remove_route_count;
+        entries.clear();
+        entries.push_back({"resync", "DEL", {}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_EQ(current_remove_count + 1, remove_route_count);
+        ASSERT_FALSE(gRouteOrch->isRouteExists(gVirtualRouterId, IpPrefix("2.2.2.0/24")));
+        ASSERT_EQ(gRouteOrch->m_routeDigest.getEntries().size(), 2);
+    }
 }
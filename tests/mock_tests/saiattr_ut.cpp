@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include "saiattr.h"
+#include "saiattrlist.h"
+
+#include <vector>
+
+namespace saiattr_test
+{
+    using namespace std;
+
+    static sai_attribute_t makeAttr(sai_attr_id_t id, uint32_t value)
+    {
+        sai_attribute_t attr {};
+        attr.id = id;
+        attr.value.u32 = value;
+        return attr;
+    }
+
+    TEST(SaiAttrList, KeepsAttributesInline)
+    {
+        SaiAttrList<4> attrs;
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            attrs.push_back(makeAttr(i, i * 10));
+        }
+
+        ASSERT_EQ(attrs.size(), 4u);
+        ASSERT_EQ(attrs.getSpills(), 0u);
+        ASSERT_EQ(attrs.data()[3].value.u32, 30u);
+    }
+
+    TEST(SaiAttrList, SpillsPastInlineCapacity)
+    {
+        SaiAttrList<2> attrs;
+        vector<sai_attribute_t> expected;
+        for (uint32_t i = 0; i < 5; i++)
+        {
+            expected.push_back(makeAttr(i, i + 100));
+        }
+        attrs.insert(attrs.end(), expected.begin(), expected.end());
+
+        ASSERT_EQ(attrs.size(), 5u);
+        ASSERT_EQ(attrs.getSpills(), 1u);
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(attrs[i].id, expected[i].id);
+            ASSERT_EQ(attrs[i].value.u32, expected[i].value.u32);
+        }
+
+        // Back to the inline storage once cleared
+        attrs.clear();
+        ASSERT_TRUE(attrs.empty());
+        attrs.push_back(makeAttr(7, 7));
+        ASSERT_EQ(attrs.back().id, 7u);
+        ASSERT_EQ(attrs.getSpills(), 1u);
+    }
+
+    TEST(SaiAttrWrapper, MoveKeepsDeepCopy)
+    {
+        sai_object_id_t ports[] = { 0x1000000000001, 0x1000000000002 };
+        sai_attribute_t attr {};
+        attr.id = SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS;
+        attr.value.aclfield.enable = true;
+        attr.value.aclfield.data.objlist.count = 2;
+        attr.value.aclfield.data.objlist.list = ports;
+
+        SaiAttrWrapper wrapper(SAI_OBJECT_TYPE_ACL_ENTRY, attr);
+        const auto *list = wrapper.getSaiAttr().value.aclfield.data.objlist.list;
+        ASSERT_NE(list, ports);
+
+        // Relocating a vector of wrappers moves the owned lists
+        vector<SaiAttrWrapper> wrappers;
+        wrappers.push_back(std::move(wrapper));
+        wrappers.reserve(wrappers.capacity() + 1);
+        ASSERT_EQ(wrappers[0].getSaiAttr().value.aclfield.data.objlist.list, list);
+
+        SaiAttrWrapper copy;
+        copy = wrappers[0];
+        ASSERT_EQ(copy.toString(), wrappers[0].toString());
+        ASSERT_NE(copy.getSaiAttr().value.aclfield.data.objlist.list, list);
+        ASSERT_EQ(copy.getSaiAttr().value.aclfield.data.objlist.list[1], ports[1]);
+    }
+}
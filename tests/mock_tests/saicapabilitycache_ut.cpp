@@ -0,0 +1,94 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "saicapabilitycache.h"
+
+#include <cstdio>
+#include <unistd.h>
+
+namespace saicapabilitycache_test
+{
+    using namespace std;
+
+    struct SaiCapabilityCacheTest : public ::testing::Test
+    {
+        string m_path;
+
+        virtual void SetUp() override
+        {
+            SaiCapabilityCache::instance().clear();
+            m_path = "/tmp/saicapabilitycache_ut." + to_string(getpid());
+        }
+
+        virtual void TearDown() override
+        {
+            SaiCapabilityCache::instance().setPersistence("", "", false);
+            SaiCapabilityCache::instance().clear();
+            unlink(m_path.c_str());
+        }
+
+        void addEntries()
+        {
+            auto &cache = SaiCapabilityCache::instance();
+
+            sai_attr_capability_t capability = {};
+            capability.create_implemented = true;
+            capability.get_implemented = true;
+            cache.m_attributes[make_tuple(gSwitchId, SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_TPID)] = { SAI_STATUS_SUCCESS, capability };
+            cache.m_enumValues[make_tuple(gSwitchId, SAI_OBJECT_TYPE_VLAN, SAI_VLAN_ATTR_BROADCAST_FLOOD_CONTROL_TYPE)] = { SAI_STATUS_SUCCESS, { 0, 1, 3 } };
+            cache.m_dirty = true;
+        }
+    };
+
+    TEST_F(SaiCapabilityCacheTest, EnumValuesAnsweredFromCache)
+    {
+        addEntries();
+
+        sai_s32_list_t values = { 0, nullptr };
+        ASSERT_EQ(querySaiAttributeEnumValuesCapability(gSwitchId, SAI_OBJECT_TYPE_VLAN, SAI_VLAN_ATTR_BROADCAST_FLOOD_CONTROL_TYPE, &values),
+                  SAI_STATUS_BUFFER_OVERFLOW);
+        ASSERT_EQ(values.count, 3u);
+
+        vector<int32_t> list(5);
+        values = { static_cast<uint32_t>(list.size()), list.data() };
+        ASSERT_EQ(querySaiAttributeEnumValuesCapability(gSwitchId, SAI_OBJECT_TYPE_VLAN, SAI_VLAN_ATTR_BROADCAST_FLOOD_CONTROL_TYPE, &values),
+                  SAI_STATUS_SUCCESS);
+        ASSERT_EQ(values.count, 3u);
+        ASSERT_EQ(list[2], 3);
+
+        sai_attr_capability_t capability = {};
+        ASSERT_EQ(querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_TPID, &capability), SAI_STATUS_SUCCESS);
+        ASSERT_TRUE(capability.create_implemented);
+        ASSERT_FALSE(capability.set_implemented);
+    }
+
+    TEST_F(SaiCapabilityCacheTest, RestoredOnlyWithSameSignature)
+    {
+        auto &cache = SaiCapabilityCache::instance();
+
+        cache.setPersistence(m_path, "sai1|platform", false);
+        addEntries();
+        ASSERT_TRUE(cache.save());
+
+        cache.clear();
+        cache.setPersistence(m_path, "sai1|platform", true);
+        ASSERT_EQ(cache.m_attributes.size(), 1u);
+        ASSERT_EQ(cache.m_enumValues.size(), 1u);
+        ASSERT_FALSE(cache.m_dirty);
+
+        sai_attr_capability_t capability = {};
+        ASSERT_EQ(querySaiAttributeCapability(gSwitchId, SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_TPID, &capability), SAI_STATUS_SUCCESS);
+        ASSERT_TRUE(capability.get_implemented);
+
+        // A cold start or another SAI queries again
+        cache.clear();
+        cache.setPersistence(m_path, "sai1|platform", false);
+        ASSERT_TRUE(cache.m_attributes.empty());
+        ASSERT_TRUE(cache.m_dirty);
+
+        cache.clear();
+        cache.setPersistence(m_path, "sai2|platform", true);
+        ASSERT_TRUE(cache.m_attributes.empty());
+        ASSERT_TRUE(cache.m_enumValues.empty());
+        ASSERT_TRUE(cache.m_dirty);
+    }
+}
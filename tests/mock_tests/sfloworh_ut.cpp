@@ -367,6 +367,53 @@ namespace sflow_test
             ASSERT_FALSE(Portal::SflowOrchInternal::getSflowStatusEnable(mock_orch.get()));
         }
     }
-}
-
 
+    /* Test ports at the same rate sharing a session across a rate change */
+    TEST_F(SflowOrchTest, SflowPortRateChange)
+    {
+        MockSflowOrch mock_orch;
+        mock_orch.doSflowTableTask({ { "global", SET_COMMAND, { { "admin_state", "up" } } } });
+
+        mock_orch.doSflowSessionTableTask({
+            { "Ethernet0", SET_COMMAND, { { "admin_state", "up" }, { "sample_rate", "1000" }, { "sample_direction", "both" } } },
+            { "Ethernet4", SET_COMMAND, { { "admin_state", "up" }, { "sample_rate", "1000" }, { "sample_direction", "rx" } } }
+        });
+
+        auto sessions = Portal::SflowOrchInternal::getSflowSampleMap(mock_orch.get());
+        ASSERT_EQ(sessions.size(), 1u);
+        ASSERT_EQ(sessions[1000].ref_count, 2u);
+        ASSERT_EQ(Portal::SflowOrchInternal::getSflowPortInfoMap(mock_orch.get()).size(), 2u);
+
+        Port port;
+        ASSERT_TRUE(gPortsOrch->getPort("Ethernet0", port));
+        sai_attribute_t attr;
+        attr.id = SAI_PORT_ATTR_EGRESS_SAMPLEPACKET_ENABLE;
+        ASSERT_EQ(sai_port_api->get_port_attribute(port.m_port_id, 1, &attr), SAI_STATUS_SUCCESS);
+        ASSERT_EQ(attr.value.oid, sessions[1000].m_sample_id);
+
+        mock_orch.doSflowSessionTableTask({
+            { "Ethernet0", SET_COMMAND, { { "admin_state", "up" }, { "sample_rate", "2000" }, { "sample_direction", "both" } } },
+            { "Ethernet4", SET_COMMAND, { { "admin_state", "up" }, { "sample_rate", "2000" }, { "sample_direction", "rx" } } }
+        });
+
+        sessions = Portal::SflowOrchInternal::getSflowSampleMap(mock_orch.get());
+        ASSERT_EQ(sessions.size(), 1u);
+        ASSERT_EQ(sessions[2000].ref_count, 2u);
+
+        attr.id = SAI_PORT_ATTR_INGRESS_SAMPLEPACKET_ENABLE;
+        ASSERT_EQ(sai_port_api->get_port_attribute(port.m_port_id, 1, &attr), SAI_STATUS_SUCCESS);
+        ASSERT_EQ(attr.value.oid, sessions[2000].m_sample_id);
+
+        mock_orch.doSflowSessionTableTask({
+            { "Ethernet0", DEL_COMMAND, {} },
+            { "Ethernet4", DEL_COMMAND, {} }
+        });
+
+        ASSERT_TRUE(Portal::SflowOrchInternal::getSflowSampleMap(mock_orch.get()).empty());
+        ASSERT_TRUE(Portal::SflowOrchInternal::getSflowPortInfoMap(mock_orch.get()).empty());
+
+        attr.id = SAI_PORT_ATTR_INGRESS_SAMPLEPACKET_ENABLE;
+        ASSERT_EQ(sai_port_api->get_port_attribute(port.m_port_id, 1, &attr), SAI_STATUS_SUCCESS);
+        ASSERT_EQ(attr.value.oid, SAI_NULL_OBJECT_ID);
+    }
+}
@@ -1,3 +1,9 @@
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "srv6orch.h"
+#undef private
 #include "mock_orch_test.h"
 #include "mock_orchagent_main.h"
 #include "mock_sai_api.h"
@@ -21,6 +27,39 @@ using ::testing::_;
 using ::testing::AtLeast;
 using namespace mock_orch_test;
 
+// MySID entry on which the SAI fails to set the counter
+static uint8_t _ut_stub_failing_sid_byte;
+
+static sai_status_t _ut_stub_set_my_sid_entry_attribute(
+    _In_ const sai_my_sid_entry_t *my_sid_entry,
+    _In_ const sai_attribute_t *attr)
+{
+    if (attr->id == SAI_MY_SID_ENTRY_ATTR_COUNTER_ID && my_sid_entry->sid[7] == _ut_stub_failing_sid_byte)
+    {
+        return SAI_STATUS_FAILURE;
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t _ut_stub_set_my_sid_entries_attribute(
+    _In_ uint32_t object_count,
+    _In_ const sai_my_sid_entry_t *my_sid_entry,
+    _In_ const sai_attribute_t *attr_list,
+    _In_ sai_bulk_op_error_mode_t mode,
+    _Out_ sai_status_t *object_statuses)
+{
+    sai_status_t status = SAI_STATUS_SUCCESS;
+    for (uint32_t i = 0; i < object_count; i++)
+    {
+        object_statuses[i] = _ut_stub_set_my_sid_entry_attribute(&my_sid_entry[i], &attr_list[i]);
+        if (object_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+    return status;
+}
+
 class Srv6OrchMySidTest : public MockOrchTest
 {
 protected:
@@ -77,6 +116,47 @@ protected:
         consumer->addToSync(entries);
         static_cast<Orch*>(gSrv6Orch)->doTask(*consumer);
     }
+
+    void enableMySidCounterSupport()
+    {
+        if (gSrv6Orch->getMySidCountersSupported())
+        {
+            return;
+        }
+
+        gSrv6Orch->m_mysid_counters_supported = true;
+        gSrv6Orch->m_counter_db = make_shared<DBConnector>("COUNTERS_DB", 0);
+        gSrv6Orch->m_mysid_counters_table = make_unique<Table>(gSrv6Orch->m_counter_db.get(), COUNTERS_SRV6_NAME_MAP);
+        gSrv6Orch->m_counter_update_timer = new SelectableTimer(timespec { .tv_sec = 1, .tv_nsec = 0 });
+        gSrv6Orch->Orch::addExecutor(new ExecutableTimer(gSrv6Orch->m_counter_update_timer, gSrv6Orch, "SRV6_FLEX_COUNTER_UPDATE_TIMER"));
+    }
+
+    // MySID entry fc00:0:1:<n>::/64, the SID differs from the others in its eighth byte
+    void addMySidEntry(uint8_t n)
+    {
+        MySidEntry mysid = {};
+        mysid.entry.switch_id = gSwitchId;
+        mysid.entry.vr_id = gVirtualRouterId;
+        mysid.entry.locator_block_len = 32;
+        mysid.entry.locator_node_len = 16;
+        mysid.entry.function_len = 16;
+        mysid.entry.args_len = 0;
+        memcpy(mysid.entry.sid, IpAddress("fc00:0:1:" + to_string(n) + "::").getV6Addr(), sizeof(sai_ip6_t));
+        mysid.counter = SAI_NULL_OBJECT_ID;
+        gSrv6Orch->srv6_my_sid_table_["32:16:16:0:fc00:0:1:" + to_string(n) + "::"] = mysid;
+    }
+
+    sai_object_id_t getMySidCounter(uint8_t n)
+    {
+        return gSrv6Orch->srv6_my_sid_table_["32:16:16:0:fc00:0:1:" + to_string(n) + "::"].counter;
+    }
+
+    size_t getCounterNameMapSize()
+    {
+        vector<FieldValueTuple> fvs;
+        gSrv6Orch->m_mysid_counters_table->get("", fvs);
+        return fvs.size();
+    }
 };
 
 TEST_F(Srv6OrchMySidTest, MySidEntryCreation_WithDecapDscpMode)
@@ -113,4 +193,86 @@ TEST_F(Srv6OrchMySidTest, MySidEntryCreation_WithoutDecapDscpMode)
     runAppMySidTask(app_key, "un", "default", "");
 }
 
+TEST_F(Srv6OrchMySidTest, MySidEntryCreation_BulkInOneDrain)
+{
+    ASSERT_NE(gSrv6Orch, nullptr);
+
+    const vector<string> app_keys = {
+        "32:16:16:0:fc00:0:1:1::",
+        "32:16:16:0:fc00:0:1:2::",
+        "32:16:16:0:fc00:0:1:3::"
+    };
+
+    EXPECT_CALL(*mock_sai_srv6_api, create_my_sid_entries(3, _, _, _, _, _))
+        .WillOnce(testing::Invoke([](uint32_t object_count, const sai_my_sid_entry_t *, const uint32_t *,
+                                     const sai_attribute_t **, sai_bulk_op_error_mode_t, sai_status_t *object_statuses) {
+            fill(object_statuses, object_statuses + object_count, SAI_STATUS_SUCCESS);
+            return SAI_STATUS_SUCCESS;
+        }));
+    EXPECT_CALL(*mock_sai_srv6_api, create_my_sid_entry(_, _, _)).Times(0);
+
+    auto* executor = static_cast<Orch*>(gSrv6Orch)->getExecutor(APP_SRV6_MY_SID_TABLE_NAME);
+    auto* consumer = dynamic_cast<Consumer*>(executor);
+    ASSERT_NE(consumer, nullptr);
+    deque<KeyOpFieldsValuesTuple> entries;
+    for (const auto& key : app_keys)
+    {
+        entries.push_back({key, SET_COMMAND, {{"action", "un"}}});
+    }
+    consumer->addToSync(entries);
+    static_cast<Orch*>(gSrv6Orch)->doTask(*consumer);
+
+    ASSERT_TRUE(consumer->m_toSync.empty());
+}
+
+TEST_F(Srv6OrchMySidTest, MySidCounters_BulkFailedInTheMiddle)
+{
+    ASSERT_NE(gSrv6Orch, nullptr);
+
+    enableMySidCounterSupport();
+    ut_sai_srv6_api.set_my_sid_entry_attribute = _ut_stub_set_my_sid_entry_attribute;
+    ut_sai_srv6_api.set_my_sid_entries_attribute = _ut_stub_set_my_sid_entries_attribute;
+
+    addMySidEntry(1);
+    addMySidEntry(2);
+    addMySidEntry(3);
+
+    // The counter of the entry that fails to take it is removed
+    _ut_stub_failing_sid_byte = 2;
+    gSrv6Orch->setCountersState(true);
+    ASSERT_TRUE(gSrv6Orch->getMySidCountersEnabled());
+    ASSERT_NE(getMySidCounter(1), SAI_NULL_OBJECT_ID);
+    ASSERT_EQ(getMySidCounter(2), SAI_NULL_OBJECT_ID);
+    ASSERT_NE(getMySidCounter(3), SAI_NULL_OBJECT_ID);
+    ASSERT_EQ(gSrv6Orch->m_pending_counters.size(), 2);
+    ASSERT_EQ(getCounterNameMapSize(), 2);
+
+    // Counters are created for the entries left without one
+    _ut_stub_failing_sid_byte = 0;
+    gSrv6Orch->addMySidCounters();
+    ASSERT_NE(getMySidCounter(2), SAI_NULL_OBJECT_ID);
+    ASSERT_EQ(gSrv6Orch->m_pending_counters.size(), 3);
+    ASSERT_EQ(getCounterNameMapSize(), 3);
+
+    // The counter that fails to be unbound stays with its entry
+    auto counter = getMySidCounter(2);
+    _ut_stub_failing_sid_byte = 2;
+    gSrv6Orch->setCountersState(false);
+    ASSERT_FALSE(gSrv6Orch->getMySidCountersEnabled());
+    ASSERT_EQ(getMySidCounter(1), SAI_NULL_OBJECT_ID);
+    ASSERT_EQ(getMySidCounter(2), counter);
+    ASSERT_EQ(getMySidCounter(3), SAI_NULL_OBJECT_ID);
+    ASSERT_EQ(gSrv6Orch->m_pending_counters.size(), 1);
+    ASSERT_EQ(gSrv6Orch->m_pending_counters.count(counter), 1);
+    ASSERT_EQ(getCounterNameMapSize(), 1);
+
+    _ut_stub_failing_sid_byte = 0;
+    gSrv6Orch->removeMySidCounters();
+    ASSERT_EQ(getMySidCounter(2), SAI_NULL_OBJECT_ID);
+    ASSERT_TRUE(gSrv6Orch->m_pending_counters.empty());
+    ASSERT_EQ(getCounterNameMapSize(), 0);
+
+    gSrv6Orch->srv6_my_sid_table_.clear();
+}
+
 } // namespace srv6orch_test
@@ -179,6 +179,7 @@ namespace stporch_test
         sai_stp_api->create_stp = mock_create_stp;
         sai_stp_api->remove_stp = mock_remove_stp;
         sai_stp_api->create_stp_port = mock_create_stp_port;
+        sai_stp_api->create_stp_ports = mock_create_stp_ports;
         sai_stp_api->remove_stp_port = mock_remove_stp_port;
         sai_stp_api->set_stp_port_attribute = mock_set_stp_port_attribute;
 
@@ -245,15 +246,29 @@ namespace stporch_test
         static_cast<Orch *>(gStpOrch)->doTask();
 
         entries.clear();
+        // A new STP port is created with its state, one by one when the SAI has no bulk create
+        EXPECT_CALL(mock_sai_stp_,
+            create_stp_ports(_, 1, _, _, _, _, _)).WillOnce(::testing::Return(SAI_STATUS_NOT_IMPLEMENTED));
         EXPECT_CALL(mock_sai_stp_,
             create_stp_port(_, _, 3, _)).WillOnce(::testing::DoAll(::testing::SetArgPointee<0>(stp_port_oid),
                                         ::testing::Return(SAI_STATUS_SUCCESS)));
-        EXPECT_CALL(mock_sai_stp_,
-            set_stp_port_attribute(_,_)).WillOnce(::testing::Return(SAI_STATUS_SUCCESS));
         entries.push_back({"Ethernet0:1", "SET", { {"state", "4"}}});
         consumer = dynamic_cast<Consumer *>(gStpOrch->getExecutor("STP_PORT_STATE_TABLE"));
         consumer->addToSync(entries);
         static_cast<Orch *>(gStpOrch)->doTask();
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_TRUE(gPortsOrch->getPort(ETHERNET0, port));
+        ASSERT_EQ(port.m_stp_port_ids[stp_instance], stp_port_oid);
+
+        entries.clear();
+        EXPECT_CALL(mock_sai_stp_,
+            set_stp_port_attribute(_,_)).WillOnce(::testing::Return(SAI_STATUS_SUCCESS));
+        // The port states are set one by one when the SAI has no bulk set
+        gStpOrch->m_stpPortStateBulkSupported = false;
+        entries.push_back({"Ethernet0:1", "SET", { {"state", "3"}}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gStpOrch)->doTask();
+        ASSERT_TRUE(consumer->m_toSync.empty());
 
         entries.clear();
         entries.push_back({"Ethernet0:1", "SET", { {"state", "true"}}});
@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+#include "subintf.h"
+
+namespace subintf_test
+{
+    using namespace swss;
+
+    struct SubIntfTest : public ::testing::Test
+    {
+        virtual void SetUp() override
+        {
+            subIntf::clearCache();
+        }
+    };
+
+    TEST_F(SubIntfTest, ParsesLongAndShortNames)
+    {
+        subIntf eth("Ethernet0.100");
+        ASSERT_TRUE(eth.isValid());
+        ASSERT_FALSE(eth.isShortName());
+        ASSERT_EQ(eth.parentIntf(), "Ethernet0");
+        ASSERT_EQ(eth.subIntfIdx(), 100);
+        ASSERT_EQ(eth.longName(), "Ethernet0.100");
+        ASSERT_EQ(eth.shortName(), "Eth0.100");
+
+        subIntf po("Po1.10");
+        ASSERT_TRUE(po.isValid());
+        ASSERT_TRUE(po.isShortName());
+        ASSERT_EQ(po.parentIntf(), "PortChannel1");
+        ASSERT_EQ(po.subIntfIdx(), 10);
+        ASSERT_EQ(po.longName(), "PortChannel1.10");
+        ASSERT_EQ(po.shortName(), "Po1.10");
+    }
+
+    TEST_F(SubIntfTest, RejectsInvalidNames)
+    {
+        ASSERT_FALSE(subIntf("Ethernet0").isValid());
+        ASSERT_FALSE(subIntf("Vlan100.10").isValid());
+        ASSERT_EQ(subIntf("Vlan100.10").parentIntf(), "Vlan100");
+        ASSERT_FALSE(subIntf("Ethernet1000000.1000").isValid());
+        ASSERT_EQ(subIntf("Ethernet1000000.1000").longName(), "");
+        ASSERT_EQ(subIntf("Eth0.abc").subIntfIdx(), -1);
+        ASSERT_EQ(subIntf("Eth0.").subIntfIdx(), -1);
+    }
+
+    TEST_F(SubIntfTest, CachesParseResults)
+    {
+        for (int i = 0; i < 10; i++)
+        {
+            subIntf subIf("Eth4.200");
+            ASSERT_EQ(subIf.subIntfIdx(), 200);
+        }
+        ASSERT_EQ(subIntf::cacheSize(), 1u);
+
+        subIntf("Eth8.200");
+        ASSERT_EQ(subIntf::cacheSize(), 2u);
+
+        subIntf::clearCache();
+        ASSERT_EQ(subIntf::cacheSize(), 0u);
+        ASSERT_EQ(subIntf("Eth4.200").longName(), "Ethernet4.200");
+    }
+}
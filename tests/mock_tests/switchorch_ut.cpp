@@ -10,6 +10,8 @@
 #include "mock_response_publisher.h"
 #include "switchorch.h"
 
+#include <thread>
+
 extern void on_switch_asic_sdk_health_event(sai_object_id_t switch_id,
                                             sai_switch_asic_sdk_health_severity_t severity,
                                             sai_timespec_t timestamp,
@@ -176,6 +178,11 @@ namespace switchorch_test
                                             data,
                                             description);
 
+            // The event is recorded by the flush timer
+            ASSERT_EQ(gSwitchOrch->m_pendingAsicSdkHealthEvents.size(), 1);
+            gSwitchOrch->doTask(*gSwitchOrch->m_asicSdkHealthEventFlushTimer);
+            ASSERT_TRUE(gSwitchOrch->m_pendingAsicSdkHealthEvents.empty());
+
             string key;
             if (expected_key.empty())
             {
@@ -385,6 +392,96 @@ namespace switchorch_test
         checkAsicSdkHealthEvent(timestamp);
     }
 
+    TEST_F(SwitchOrchTest, SwitchOrchTestHandleEventBatches)
+    {
+        initSwitchOrch();
+
+        // max_events is cached from the CONFIG_DB updates
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"fatal", "SET",
+                           {
+                               {"max_events", "1000"}
+                           }});
+        auto consumer = dynamic_cast<Consumer *>(gSwitchOrch->getExecutor(CFG_SUPPRESS_ASIC_SDK_HEALTH_EVENT_NAME));
+        consumer->addToSync(entries);
+        entries.clear();
+        static_cast<Orch *>(gSwitchOrch)->doTask();
+        ASSERT_EQ(gSwitchOrch->m_asicSdkHealthEventMaxEvents["fatal"], 1000);
+        gSwitchOrch->m_asicSdkHealthEventSeveritiesToEliminate.clear();
+
+        sai_switch_health_data_t data;
+        memset(&data, 0, sizeof(data));
+        data.data_type = SAI_HEALTH_DATA_TYPE_GENERAL;
+        sai_u8_list_t description = {0, nullptr};
+        size_t count = ASIC_SDK_HEALTH_EVENT_FLUSH_BATCH_SIZE + 1;
+        for (size_t i = 0; i < count; i++)
+        {
+            sai_timespec_t timestamp = {.tv_sec = 1701160447 + i, .tv_nsec = 0};
+            on_switch_asic_sdk_health_event(gSwitchId,
+                                            SAI_SWITCH_ASIC_SDK_HEALTH_SEVERITY_FATAL,
+                                            timestamp,
+                                            SAI_SWITCH_ASIC_SDK_HEALTH_CATEGORY_FW,
+                                            data,
+                                            description);
+        }
+        ASSERT_EQ(gSwitchOrch->m_pendingAsicSdkHealthEvents.size(), count);
+
+        // One batch per timer tick
+        vector<string> keys;
+        gSwitchOrch->doTask(*gSwitchOrch->m_asicSdkHealthEventFlushTimer);
+        gSwitchOrch->m_asicSdkHealthEventTable->getKeys(keys);
+        ASSERT_EQ(keys.size(), ASIC_SDK_HEALTH_EVENT_FLUSH_BATCH_SIZE);
+        ASSERT_EQ(gSwitchOrch->m_pendingAsicSdkHealthEvents.size(), 1);
+        ASSERT_EQ(gSwitchOrch->m_asicSdkHealthEventSeveritiesToEliminate.count("fatal"), 1);
+
+        gSwitchOrch->doTask(*gSwitchOrch->m_asicSdkHealthEventFlushTimer);
+        gSwitchOrch->m_asicSdkHealthEventTable->getKeys(keys);
+        ASSERT_EQ(keys.size(), count);
+        ASSERT_TRUE(gSwitchOrch->m_pendingAsicSdkHealthEvents.empty());
+
+        // Removing the configuration drops the cached max_events
+        entries.push_back({"fatal", "DEL", {}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gSwitchOrch)->doTask();
+        ASSERT_EQ(gSwitchOrch->m_asicSdkHealthEventMaxEvents.count("fatal"), 0);
+    }
+
+    TEST_F(SwitchOrchTest, SwitchOrchTestFlushPendingEventsOnExit)
+    {
+        initSwitchOrch();
+
+        sai_switch_health_data_t data;
+        memset(&data, 0, sizeof(data));
+        data.data_type = SAI_HEALTH_DATA_TYPE_GENERAL;
+        sai_u8_list_t description = {0, nullptr};
+        size_t count = ASIC_SDK_HEALTH_EVENT_FLUSH_BATCH_SIZE + 1;
+
+        // Events are queued by the notification thread while the main thread flushes
+        std::thread notificationThread([&]() {
+            for (size_t i = 0; i < count; i++)
+            {
+                sai_timespec_t timestamp = {.tv_sec = 1701160447 + i, .tv_nsec = 0};
+                on_switch_asic_sdk_health_event(gSwitchId,
+                                                SAI_SWITCH_ASIC_SDK_HEALTH_SEVERITY_FATAL,
+                                                timestamp,
+                                                SAI_SWITCH_ASIC_SDK_HEALTH_CATEGORY_FW,
+                                                data,
+                                                description);
+            }
+        });
+        gSwitchOrch->doTask(*gSwitchOrch->m_asicSdkHealthEventFlushTimer);
+        notificationThread.join();
+        ASSERT_TRUE(gSwitchOrch->isFatalEventReceived());
+
+        // Nothing queued is lost when orchagent exits on the shutdown request
+        gSwitchOrch->flushPendingAsicSdkHealthEvents();
+        ASSERT_TRUE(gSwitchOrch->m_pendingAsicSdkHealthEvents.empty());
+
+        vector<string> keys;
+        gSwitchOrch->m_asicSdkHealthEventTable->getKeys(keys);
+        ASSERT_EQ(keys.size(), count);
+    }
+
     TEST_F(SwitchOrchTest, VxlanSportSecurityCapabilityCheck)
     {
         _hook_sai_apis();
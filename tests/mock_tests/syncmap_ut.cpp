@@ -0,0 +1,125 @@
+#include "syncmap.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+namespace syncmap_test
+{
+    using namespace std;
+    using namespace swss;
+
+    static KeyOpFieldsValuesTuple task(const string &key, const string &op, const string &value = "")
+    {
+        vector<FieldValueTuple> fvs;
+        if (!value.empty())
+        {
+            fvs.emplace_back("field", value);
+        }
+        return KeyOpFieldsValuesTuple(key, op, fvs);
+    }
+
+    static vector<string> keys(const SyncMap &map)
+    {
+        vector<string> result;
+        for (const auto &it : map)
+        {
+            result.push_back(it.first + "/" + kfvOp(it.second));
+        }
+        return result;
+    }
+
+    TEST(SyncMapTest, OrderedModeIteratesInKeyOrder)
+    {
+        SyncMap map;
+        ASSERT_EQ(map.getMode(), SyncMap::Mode::Ordered);
+
+        map.emplace("c", task("c", SET_COMMAND));
+        map.emplace("a", task("a", DEL_COMMAND));
+        map.emplace("b", task("b", SET_COMMAND));
+        map.emplace("a", task("a", SET_COMMAND));
+
+        vector<string> expected = { "a/DEL", "a/SET", "b/SET", "c/SET" };
+        ASSERT_EQ(keys(map), expected);
+        ASSERT_EQ(map.count("a"), 2);
+        ASSERT_EQ(kfvOp(map.find("a")->second), DEL_COMMAND);
+    }
+
+    TEST(SyncMapTest, HashedModeIteratesInArrivalOrder)
+    {
+        SyncMap map;
+        map.setMode(SyncMap::Mode::Hashed);
+
+        map.emplace("c", task("c", SET_COMMAND));
+        map.emplace("a", task("a", DEL_COMMAND));
+        map.emplace("b", task("b", SET_COMMAND));
+        map.emplace("a", task("a", SET_COMMAND));
+
+        // entries of the same key stay adjacent, DEL before SET
+        vector<string> expected = { "c/SET", "a/DEL", "a/SET", "b/SET" };
+        ASSERT_EQ(keys(map), expected);
+
+        auto range = map.equal_range("a");
+        ASSERT_EQ(distance(range.first, range.second), 2);
+    }
+
+    TEST(SyncMapTest, EraseKeepsIndexConsistent)
+    {
+        for (auto mode : { SyncMap::Mode::Ordered, SyncMap::Mode::Hashed })
+        {
+            SyncMap map;
+            map.setMode(mode);
+
+            map.emplace("a", task("a", DEL_COMMAND));
+            map.emplace("a", task("a", SET_COMMAND));
+            map.emplace("b", task("b", SET_COMMAND));
+
+            // erasing the first entry of a key moves the key to its second entry
+            auto it = map.erase(map.find("a"));
+            ASSERT_EQ(kfvOp(it->second), SET_COMMAND);
+            ASSERT_EQ(map.count("a"), 1);
+            ASSERT_EQ(map.find("a"), it);
+
+            map.erase(it);
+            ASSERT_EQ(map.count("a"), 0);
+            ASSERT_EQ(map.find("a"), map.end());
+
+            ASSERT_EQ(map.erase("b"), 1);
+            ASSERT_TRUE(map.empty());
+
+            // the key can be added again after it has been removed
+            map.emplace("a", task("a", SET_COMMAND));
+            ASSERT_EQ(map.size(), 1);
+
+            map.clear();
+            ASSERT_EQ(map.find("a"), map.end());
+        }
+    }
+
+    TEST(SyncMapTest, ReplaceCoalescesInPlace)
+    {
+        SyncMap map;
+        map.setMode(SyncMap::Mode::Hashed);
+
+        map.emplace("a", task("a", DEL_COMMAND));
+        map.emplace("a", task("a", SET_COMMAND, "1"));
+        map.emplace("b", task("b", SET_COMMAND));
+
+        map.replace("a", task("a", DEL_COMMAND));
+
+        vector<string> expected = { "a/DEL", "b/SET" };
+        ASSERT_EQ(keys(map), expected);
+
+        map.replace("c", task("c", DEL_COMMAND));
+        ASSERT_EQ(map.count("c"), 1);
+    }
+
+    TEST(SyncMapTest, ModeCanOnlyChangeWhenEmpty)
+    {
+        SyncMap map;
+        map.emplace("a", task("a", SET_COMMAND));
+
+        ASSERT_THROW(map.setMode(SyncMap::Mode::Hashed), std::logic_error);
+    }
+}
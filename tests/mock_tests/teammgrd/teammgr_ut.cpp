@@ -181,7 +181,7 @@ namespace teammgr_ut
 
     TEST_F(TeamMgrTest, testProcessKilledAfterAddLagFailure)
     {
-        swss::TeamMgr teammgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_lag_tables);
+        swss::TeamMgr teammgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_lag_tables, 1);
         swss::Table cfg_lag_table = swss::Table(m_config_db.get(), CFG_LAG_TABLE_NAME);
         cfg_lag_table.set("PortChannel382", { { "admin_status", "up" },
                                             { "mtu", "9100" },
@@ -189,6 +189,7 @@ namespace teammgr_ut
                                             { "min_links", "2" } });
         teammgr.addExistingData(&cfg_lag_table);
         teammgr.doTask();
+        teammgr.waitTeamdStart();
         ASSERT_NE(mockCallArgs.size(), 0);
         EXPECT_NE(mockCallArgs.front().find("/usr/bin/teamd -r -t PortChannel382"), std::string::npos);
         EXPECT_EQ(mockCallArgs.size(), 1);
@@ -199,7 +200,7 @@ namespace teammgr_ut
 
     TEST_F(TeamMgrTest, testProcessPidFileMissingAfterAddLagFailure)
     {
-        swss::TeamMgr teammgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_lag_tables);
+        swss::TeamMgr teammgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_lag_tables, 1);
         swss::Table cfg_lag_table = swss::Table(m_config_db.get(), CFG_LAG_TABLE_NAME);
         cfg_lag_table.set("PortChannel812", { { "admin_status", "up" },
                                             { "mtu", "9100" },
@@ -208,15 +209,33 @@ namespace teammgr_ut
                                             { "min_links", "1" } });
         teammgr.addExistingData(&cfg_lag_table);
         teammgr.doTask();
+        teammgr.waitTeamdStart();
         ASSERT_NE(mockCallArgs.size(), 0);
         EXPECT_NE(mockCallArgs.front().find("/usr/bin/teamd -r -t PortChannel812"), std::string::npos);
         EXPECT_EQ(mockCallArgs.size(), 1);
         EXPECT_EQ(mockKillCommands.size(), 0);
     }
 
+    TEST_F(TeamMgrTest, testAddLagRetriedAfterFailure)
+    {
+        swss::TeamMgr teammgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_lag_tables, 1);
+        swss::Table cfg_lag_table = swss::Table(m_config_db.get(), CFG_LAG_TABLE_NAME);
+        cfg_lag_table.set("PortChannel812", { { "admin_status", "up" },
+                                            { "mtu", "9100" },
+                                            { "lacp_key", "auto" } });
+        teammgr.addExistingData(&cfg_lag_table);
+        teammgr.doTask();
+        teammgr.waitTeamdStart();
+        ASSERT_EQ(mockCallArgs.size(), 1);
+        teammgr.doTask();
+        teammgr.waitTeamdStart();
+        ASSERT_EQ(mockCallArgs.size(), 2);
+        EXPECT_NE(mockCallArgs.back().find("/usr/bin/teamd -r -t PortChannel812"), std::string::npos);
+    }
+
     TEST_F(TeamMgrTest, testProcessCleanupAfterAddLag)
     {
-        swss::TeamMgr teammgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_lag_tables);
+        swss::TeamMgr teammgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_lag_tables, 1);
         swss::Table cfg_lag_table = swss::Table(m_config_db.get(), CFG_LAG_TABLE_NAME);
         cfg_lag_table.set("PortChannel495", { { "admin_status", "up" },
                                             { "mtu", "9100" },
@@ -224,6 +243,7 @@ namespace teammgr_ut
                                             { "min_links", "2" } });
         teammgr.addExistingData(&cfg_lag_table);
         teammgr.doTask();
+        teammgr.waitTeamdStart();
         ASSERT_EQ(mockCallArgs.size(), 3);
         ASSERT_NE(mockCallArgs.front().find("/usr/bin/teamd -r -t PortChannel495"), std::string::npos);
         teammgr.cleanTeamProcesses();
@@ -234,7 +254,7 @@ namespace teammgr_ut
 
     TEST_F(TeamMgrTest, testProcessPidFileMissingDuringCleanup)
     {
-        swss::TeamMgr teammgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_lag_tables);
+        swss::TeamMgr teammgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_lag_tables, 1);
         swss::Table cfg_lag_table = swss::Table(m_config_db.get(), CFG_LAG_TABLE_NAME);
         cfg_lag_table.set("PortChannel198", { { "admin_status", "up" },
                                             { "mtu", "9100" },
@@ -243,6 +263,7 @@ namespace teammgr_ut
                                             { "min_links", "1" } });
         teammgr.addExistingData(&cfg_lag_table);
         teammgr.doTask();
+        teammgr.waitTeamdStart();
         ASSERT_NE(mockCallArgs.size(), 0);
         EXPECT_NE(mockCallArgs.front().find("/usr/bin/teamd -r -t PortChannel198"), std::string::npos);
         EXPECT_EQ(mockCallArgs.size(), 3);
@@ -252,7 +273,7 @@ namespace teammgr_ut
 
     TEST_F(TeamMgrTest, testSleepDuringCleanup)
     {
-        swss::TeamMgr teammgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_lag_tables);
+        swss::TeamMgr teammgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_lag_tables, 1);
         swss::Table cfg_lag_table = swss::Table(m_config_db.get(), CFG_LAG_TABLE_NAME);
         for (int i = 600; i < 620; i++)
         {
@@ -262,6 +283,7 @@ namespace teammgr_ut
         }
         teammgr.addExistingData(&cfg_lag_table);
         teammgr.doTask();
+        teammgr.waitTeamdStart();
         ASSERT_EQ(mockCallArgs.size(), 60);
         std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
         teammgr.cleanTeamProcesses();
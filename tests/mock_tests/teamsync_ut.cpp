@@ -185,6 +185,77 @@ namespace teamportsync_test
     }
 }
 
+namespace teamportsync_member_test
+{
+    /* Subclass to expose the protected member update helpers for unit testing. */
+    class TeamPortSyncUnderTest : public swss::TeamSync::TeamPortSync
+    {
+    public:
+        TeamPortSyncUnderTest(const std::string &lagName, int ifindex,
+                              swss::ProducerStateTable *lagMemberTable)
+            : swss::TeamSync::TeamPortSync(lagName, ifindex, lagMemberTable) {}
+        using swss::TeamSync::TeamPortSync::setMember;
+        using swss::TeamSync::TeamPortSync::removeMember;
+    };
+
+    struct TeamPortSyncMemberTest : public ::testing::Test
+    {
+        virtual void SetUp() override
+        {
+            callback_sleep = cb_sleep;
+            callback_team_init = cb_team_init;
+            callback_team_change_handler = cb_team_change_handler;
+            callback_teamdctl_connect = cb_teamdctl_connect;
+            callback_teamdctl_config_get_raw_direct = cb_teamdctl_config_get_raw_direct_success;
+            callback_teamdctl_disconnect = cb_teamdctl_disconnect;
+            testing_db::reset();
+        }
+
+        virtual void TearDown() override
+        {
+            callback_sleep = NULL;
+            callback_team_init = NULL;
+            callback_team_change_handler = NULL;
+            callback_teamdctl_connect = NULL;
+            callback_teamdctl_config_get_raw_direct = NULL;
+            callback_teamdctl_disconnect = NULL;
+            testing_db::reset();
+        }
+    };
+
+    /* Verify that only member state changes are written to LAG_MEMBER_TABLE. */
+    TEST_F(TeamPortSyncMemberTest, MemberDeltas)
+    {
+        swss::DBConnector db(0, "localhost", 0, 0);
+        swss::ProducerStateTable lagMemberTable(&db, APP_LAG_MEMBER_TABLE_NAME);
+        swss::Table table(&db, APP_LAG_MEMBER_TABLE_NAME);
+        TeamPortSyncUnderTest sync("testLag", 4, &lagMemberTable);
+        std::string status;
+
+        sync.setMember("Ethernet0", true);
+        ASSERT_TRUE(table.hget("testLag:Ethernet0", "status", status));
+        EXPECT_EQ(status, "enabled");
+        EXPECT_TRUE(sync.m_lagMembers["Ethernet0"]);
+
+        /* An unchanged state is not written again */
+        table.del("testLag:Ethernet0");
+        sync.setMember("Ethernet0", true);
+        EXPECT_FALSE(table.hget("testLag:Ethernet0", "status", status));
+
+        sync.setMember("Ethernet0", false);
+        ASSERT_TRUE(table.hget("testLag:Ethernet0", "status", status));
+        EXPECT_EQ(status, "disabled");
+
+        sync.removeMember("Ethernet0");
+        EXPECT_FALSE(table.hget("testLag:Ethernet0", "status", status));
+        EXPECT_TRUE(sync.m_lagMembers.empty());
+
+        /* Removing an unknown member is a no-op */
+        sync.removeMember("Ethernet4");
+        EXPECT_TRUE(sync.m_lagMembers.empty());
+    }
+}
+
 namespace teamsync_test
 {
     /* Subclass to expose the protected addLag() for unit testing. */
@@ -1,3 +1,6 @@
+#define private public
+#include "tunneldecaporch.h"
+#undef private
 #include "ut_helper.h"
 #include "mock_orchagent_main.h"
 
@@ -41,6 +44,15 @@ namespace tunneldecaporch_test
         return SAI_STATUS_SUCCESS;
     }
 
+    set<sai_object_id_t> _ut_stub_term_entries;
+    // Term the SAI fails to create, by IPv4 destination, and to remove, by id
+    uint32_t _ut_stub_failing_term_dst;
+    sai_object_id_t _ut_stub_failing_term_id;
+    bool _ut_stub_term_bulk_supported;
+    uint32_t _ut_stub_term_create_calls;
+    uint32_t _ut_stub_term_remove_calls;
+    uint32_t _ut_stub_term_bulk_calls;
+
     sai_status_t _ut_stub_sai_create_tunnel_term_table_entry(
         _Out_ sai_object_id_t *tunnel_term_table_entry_id,
         _In_ sai_object_id_t switch_id,
@@ -48,16 +60,93 @@ namespace tunneldecaporch_test
         _In_ const sai_attribute_t *attr_list)
     {
         static sai_object_id_t term_entry_id_counter = 0x400;
+
+        _ut_stub_term_create_calls++;
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            if (attr_list[i].id == SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_DST_IP &&
+                attr_list[i].value.ipaddr.addr_family == SAI_IP_ADDR_FAMILY_IPV4 &&
+                attr_list[i].value.ipaddr.addr.ip4 == _ut_stub_failing_term_dst)
+            {
+                return SAI_STATUS_TABLE_FULL;
+            }
+        }
+
         *tunnel_term_table_entry_id = term_entry_id_counter++;
+        _ut_stub_term_entries.insert(*tunnel_term_table_entry_id);
         return SAI_STATUS_SUCCESS;
     }
 
     sai_status_t _ut_stub_sai_remove_tunnel_term_table_entry(
         _In_ sai_object_id_t tunnel_term_table_entry_id)
     {
+        _ut_stub_term_remove_calls++;
+        if (tunnel_term_table_entry_id == _ut_stub_failing_term_id)
+        {
+            return SAI_STATUS_OBJECT_IN_USE;
+        }
+
+        _ut_stub_term_entries.erase(tunnel_term_table_entry_id);
         return SAI_STATUS_SUCCESS;
     }
 
+    sai_status_t _ut_stub_sai_create_tunnel_term_table_entries(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_term_bulk_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            if (!_ut_stub_term_bulk_supported)
+            {
+                object_statuses[i] = SAI_STATUS_NOT_SUPPORTED;
+                status = SAI_STATUS_NOT_SUPPORTED;
+                continue;
+            }
+
+            object_statuses[i] = _ut_stub_sai_create_tunnel_term_table_entry(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_sai_remove_tunnel_term_table_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_term_bulk_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            if (!_ut_stub_term_bulk_supported)
+            {
+                object_statuses[i] = SAI_STATUS_NOT_SUPPORTED;
+                status = SAI_STATUS_NOT_SUPPORTED;
+                continue;
+            }
+
+            object_statuses[i] = _ut_stub_sai_remove_tunnel_term_table_entry(object_id[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
     sai_status_t _ut_stub_sai_create_router_interface(
         _Out_ sai_object_id_t *router_interface_id,
         _In_ sai_object_id_t switch_id,
@@ -143,6 +232,14 @@ namespace tunneldecaporch_test
             gVirtualRouterId = 0x3000000000001;
             gUnderlayIfId = 0x6000000000001; 
             gMacAddress = MacAddress("20:03:04:05:06:00");
+
+            _ut_stub_term_entries.clear();
+            _ut_stub_failing_term_dst = 0;
+            _ut_stub_failing_term_id = SAI_NULL_OBJECT_ID;
+            _ut_stub_term_bulk_supported = true;
+            _ut_stub_term_create_calls = 0;
+            _ut_stub_term_remove_calls = 0;
+            _ut_stub_term_bulk_calls = 0;
         }
 
         void TearDown() override
@@ -156,6 +253,49 @@ namespace tunneldecaporch_test
             delete gCrmOrch;
             gCrmOrch = nullptr;
         }
+
+        shared_ptr<TunnelDecapOrch> createTunnelDecapOrchWithTunnel(const string &tunnel_name)
+        {
+            vector<string> tunnel_tables = { APP_TUNNEL_DECAP_TABLE_NAME, APP_TUNNEL_DECAP_TERM_TABLE_NAME };
+            auto tunnelDecapOrch = make_shared<TunnelDecapOrch>(
+                m_app_db.get(), m_state_db.get(), m_config_db.get(), tunnel_tables);
+
+            tunnelDecapOrch->termBulker.create_entries = _ut_stub_sai_create_tunnel_term_table_entries;
+            tunnelDecapOrch->termBulker.remove_entries = _ut_stub_sai_remove_tunnel_term_table_entries;
+
+            // The term tests only need the tunnel object the terms point to
+            TunnelEntry tunnel = {};
+            tunnel.tunnel_id = 0x300;
+            tunnel.tunnel_type = "IPINIP";
+            tunnelDecapOrch->tunnelTable[tunnel_name] = tunnel;
+
+            return tunnelDecapOrch;
+        }
+
+        void addTerms(TunnelDecapOrch &orch, const string &tunnel_name, const vector<string> &dst_ips)
+        {
+            for (const auto &dst_ip : dst_ips)
+            {
+                ASSERT_TRUE(orch.addDecapTunnelTermEntry(tunnel_name, "", dst_ip, TUNNEL_TERM_TYPE_P2MP, ""));
+            }
+            orch.flushDecapTunnelTermEntries();
+        }
+
+        void removeTerms(TunnelDecapOrch &orch, const string &tunnel_name, const vector<string> &dst_ips)
+        {
+            for (const auto &dst_ip : dst_ips)
+            {
+                ASSERT_TRUE(orch.removeDecapTunnelTermEntry(tunnel_name, dst_ip));
+            }
+            orch.flushDecapTunnelTermEntries();
+        }
+
+        bool termStateExists(const string &tunnel_name, const string &dst_ip)
+        {
+            Table stateTermTable(m_state_db.get(), STATE_TUNNEL_DECAP_TERM_TABLE_NAME);
+            vector<FieldValueTuple> values;
+            return stateTermTable.get(tunnel_name + "|" + dst_ip, values);
+        }
     };
 
     TEST_F(TunnelDecapOrchTest, TunnelDecapOrch_Creation)
@@ -518,4 +658,84 @@ namespace tunneldecaporch_test
         });
     }
 
+    TEST_F(TunnelDecapOrchTest, TunnelDecapOrch_TermBulkCreateFailedInTheMiddle)
+    {
+        auto tunnelDecapOrch = createTunnelDecapOrchWithTunnel("bulk_create_tunnel");
+        auto &tunnel = tunnelDecapOrch->tunnelTable["bulk_create_tunnel"];
+        _ut_stub_failing_term_dst = inet_addr("10.1.0.2");
+
+        addTerms(*tunnelDecapOrch, "bulk_create_tunnel", { "10.1.0.1/32", "10.1.0.2/32", "10.1.0.3/32" });
+
+        // The terms go in one bulk, the failed one is dropped and not counted
+        ASSERT_EQ(_ut_stub_term_bulk_calls, 1);
+        ASSERT_EQ(_ut_stub_term_entries.size(), 2);
+        ASSERT_EQ(tunnel.tunnel_term_info.size(), 2);
+        ASSERT_EQ(tunnel.ref_count, 2);
+        ASSERT_EQ(tunnel.tunnel_term_info.count(IpPrefix("10.1.0.2/32")), 0);
+        ASSERT_EQ(_ut_stub_term_entries.count(tunnel.tunnel_term_info[IpPrefix("10.1.0.1/32")].tunnel_term_id), 1);
+        ASSERT_EQ(_ut_stub_term_entries.count(tunnel.tunnel_term_info[IpPrefix("10.1.0.3/32")].tunnel_term_id), 1);
+        ASSERT_TRUE(termStateExists("bulk_create_tunnel", "10.1.0.1/32"));
+        ASSERT_FALSE(termStateExists("bulk_create_tunnel", "10.1.0.2/32"));
+        ASSERT_TRUE(termStateExists("bulk_create_tunnel", "10.1.0.3/32"));
+        ASSERT_TRUE(tunnelDecapOrch->termBulkOps.empty());
+    }
+
+    TEST_F(TunnelDecapOrchTest, TunnelDecapOrch_TermBulkRemoveFailedInTheMiddle)
+    {
+        auto tunnelDecapOrch = createTunnelDecapOrchWithTunnel("bulk_remove_tunnel");
+        auto &tunnel = tunnelDecapOrch->tunnelTable["bulk_remove_tunnel"];
+
+        addTerms(*tunnelDecapOrch, "bulk_remove_tunnel", { "10.2.0.1/32", "10.2.0.2/32", "10.2.0.3/32" });
+        ASSERT_EQ(tunnel.ref_count, 3);
+
+        auto failing_id = tunnel.tunnel_term_info[IpPrefix("10.2.0.2/32")].tunnel_term_id;
+        _ut_stub_failing_term_id = failing_id;
+        _ut_stub_term_bulk_calls = 0;
+
+        removeTerms(*tunnelDecapOrch, "bulk_remove_tunnel", { "10.2.0.1/32", "10.2.0.2/32", "10.2.0.3/32" });
+
+        // The terms go in one bulk, the one still in the SAI is kept with its id and counted again
+        ASSERT_EQ(_ut_stub_term_bulk_calls, 1);
+        ASSERT_EQ(_ut_stub_term_entries.size(), 1);
+        ASSERT_EQ(tunnel.tunnel_term_info.size(), 1);
+        ASSERT_EQ(tunnel.tunnel_term_info[IpPrefix("10.2.0.2/32")].tunnel_term_id, failing_id);
+        ASSERT_EQ(tunnel.ref_count, 1);
+        ASSERT_FALSE(termStateExists("bulk_remove_tunnel", "10.2.0.1/32"));
+        ASSERT_TRUE(termStateExists("bulk_remove_tunnel", "10.2.0.2/32"));
+        ASSERT_FALSE(termStateExists("bulk_remove_tunnel", "10.2.0.3/32"));
+
+        _ut_stub_failing_term_id = SAI_NULL_OBJECT_ID;
+        removeTerms(*tunnelDecapOrch, "bulk_remove_tunnel", { "10.2.0.2/32" });
+        ASSERT_TRUE(_ut_stub_term_entries.empty());
+        ASSERT_TRUE(tunnel.tunnel_term_info.empty());
+        ASSERT_EQ(tunnel.ref_count, 0);
+        ASSERT_FALSE(termStateExists("bulk_remove_tunnel", "10.2.0.2/32"));
+    }
+
+    TEST_F(TunnelDecapOrchTest, TunnelDecapOrch_TermBulkNotSupportedFallsBackToSingleCalls)
+    {
+        auto tunnelDecapOrch = createTunnelDecapOrchWithTunnel("no_bulk_tunnel");
+        auto &tunnel = tunnelDecapOrch->tunnelTable["no_bulk_tunnel"];
+        _ut_stub_term_bulk_supported = false;
+        _ut_stub_failing_term_dst = inet_addr("10.3.0.2");
+
+        addTerms(*tunnelDecapOrch, "no_bulk_tunnel", { "10.3.0.1/32", "10.3.0.2/32", "10.3.0.3/32" });
+
+        // Each term is created with its own call, with the same per term result
+        ASSERT_EQ(_ut_stub_term_create_calls, 3);
+        ASSERT_EQ(_ut_stub_term_entries.size(), 2);
+        ASSERT_EQ(tunnel.tunnel_term_info.size(), 2);
+        ASSERT_EQ(tunnel.ref_count, 2);
+        ASSERT_TRUE(termStateExists("no_bulk_tunnel", "10.3.0.1/32"));
+        ASSERT_FALSE(termStateExists("no_bulk_tunnel", "10.3.0.2/32"));
+        ASSERT_TRUE(termStateExists("no_bulk_tunnel", "10.3.0.3/32"));
+
+        removeTerms(*tunnelDecapOrch, "no_bulk_tunnel", { "10.3.0.1/32", "10.3.0.3/32" });
+        ASSERT_EQ(_ut_stub_term_remove_calls, 2);
+        ASSERT_TRUE(_ut_stub_term_entries.empty());
+        ASSERT_TRUE(tunnel.tunnel_term_info.empty());
+        ASSERT_EQ(tunnel.ref_count, 0);
+        ASSERT_FALSE(termStateExists("no_bulk_tunnel", "10.3.0.1/32"));
+    }
+
 } // namespace tunneldecaporch_test
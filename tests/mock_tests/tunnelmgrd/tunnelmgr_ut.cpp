@@ -0,0 +1,252 @@
+#include "gtest/gtest.h"
+#include <map>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <netlink/netlink.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+#include <linux/if_addr.h>
+#include <linux/if_link.h>
+#include <linux/if_tunnel.h>
+#include <linux/rtnetlink.h>
+#include "../mock_table.h"
+#include "warm_restart.h"
+#define private public
+#include "tunnelmgr.h"
+#undef private
+
+extern int (*callback)(const std::string &cmd, std::string &stdout);
+extern std::vector<std::string> mockCallArgs;
+
+/*
+ * Decoded requests sent by TunnelMgr, e.g.
+ * "add ipip tun0 local 10.1.0.32 remote 10.1.0.33", "set tun0 up",
+ * "addr add tun0 10.1.0.32/32", "route replace 10.2.0.0/24 dev tun0"
+ */
+static std::vector<std::string> netlinkCalls;
+static std::map<std::string, unsigned int> ifIndexes;
+static std::vector<std::string> ifNames;
+
+static std::string ifName(int ifindex)
+{
+    if (ifindex <= 0 || ifindex > (int)ifNames.size())
+    {
+        return "";
+    }
+    return ifNames[ifindex - 1];
+}
+
+static std::string ipAddress(int family, struct nlattr *attr)
+{
+    char buf[INET6_ADDRSTRLEN];
+    return inet_ntop(family, nla_data(attr), buf, sizeof(buf)) ? buf : "";
+}
+
+static std::string linkRequest(struct nlmsghdr *hdr)
+{
+    struct ifinfomsg *ifi = (struct ifinfomsg *)nlmsg_data(hdr);
+    struct nlattr *attrs[IFLA_MAX + 1];
+    struct nlattr *info[IFLA_INFO_MAX + 1] = {};
+    std::string request;
+
+    if (nlmsg_parse(hdr, sizeof(*ifi), attrs, IFLA_MAX, NULL) < 0)
+    {
+        return "";
+    }
+    std::string name = attrs[IFLA_IFNAME] ? nla_get_string(attrs[IFLA_IFNAME]) : ifName(ifi->ifi_index);
+
+    if (hdr->nlmsg_type == RTM_DELLINK)
+    {
+        return "del " + name;
+    }
+
+    if (!(hdr->nlmsg_flags & NLM_F_CREATE))
+    {
+        request = "set " + name;
+        if (ifi->ifi_change & IFF_UP)
+        {
+            request += (ifi->ifi_flags & IFF_UP) ? " up" : " down";
+        }
+        return request;
+    }
+
+    if (attrs[IFLA_LINKINFO])
+    {
+        nla_parse_nested(info, IFLA_INFO_MAX, attrs[IFLA_LINKINFO], NULL);
+    }
+    request = std::string("add ") + (info[IFLA_INFO_KIND] ? nla_get_string(info[IFLA_INFO_KIND]) : "") + " " + name;
+    if (info[IFLA_INFO_DATA])
+    {
+        struct nlattr *tun[IFLA_IPTUN_MAX + 1];
+        if (nla_parse_nested(tun, IFLA_IPTUN_MAX, info[IFLA_INFO_DATA], NULL) >= 0)
+        {
+            if (tun[IFLA_IPTUN_LOCAL])
+            {
+                request += " local " + ipAddress(AF_INET, tun[IFLA_IPTUN_LOCAL]);
+            }
+            if (tun[IFLA_IPTUN_REMOTE])
+            {
+                request += " remote " + ipAddress(AF_INET, tun[IFLA_IPTUN_REMOTE]);
+            }
+        }
+    }
+    return request;
+}
+
+static std::string addrRequest(struct nlmsghdr *hdr)
+{
+    struct ifaddrmsg *ifa = (struct ifaddrmsg *)nlmsg_data(hdr);
+    struct nlattr *attrs[IFA_MAX + 1];
+
+    if (nlmsg_parse(hdr, sizeof(*ifa), attrs, IFA_MAX, NULL) < 0 || !attrs[IFA_LOCAL])
+    {
+        return "";
+    }
+    return std::string("addr ") + (hdr->nlmsg_type == RTM_NEWADDR ? "add " : "del ") + ifName(ifa->ifa_index) + " " +
+           ipAddress(ifa->ifa_family, attrs[IFA_LOCAL]) + "/" + std::to_string(ifa->ifa_prefixlen);
+}
+
+static std::string routeRequest(struct nlmsghdr *hdr)
+{
+    struct rtmsg *rtm = (struct rtmsg *)nlmsg_data(hdr);
+    struct nlattr *attrs[RTA_MAX + 1];
+    std::string op = "del";
+
+    if (nlmsg_parse(hdr, sizeof(*rtm), attrs, RTA_MAX, NULL) < 0 || !attrs[RTA_DST])
+    {
+        return "";
+    }
+    if (hdr->nlmsg_type == RTM_NEWROUTE)
+    {
+        op = (hdr->nlmsg_flags & NLM_F_REPLACE) ? "replace" : "add";
+    }
+    return "route " + op + " " + ipAddress(rtm->rtm_family, attrs[RTA_DST]) + "/" + std::to_string(rtm->rtm_dst_len) +
+           (attrs[RTA_OIF] ? " dev " + ifName(nla_get_u32(attrs[RTA_OIF])) : "");
+}
+
+/*
+ * Wrap the netlink socket and interface lookups used by NetDevHelper so
+ * that requests are recorded and acked locally instead of reaching the
+ * kernel. Every interface looked up exists.
+ */
+extern "C" {
+
+int __wrap_nl_connect(struct nl_sock *sk, int protocol)
+{
+    return 0;
+}
+
+unsigned int __wrap_if_nametoindex(const char *ifname)
+{
+    auto it = ifIndexes.find(ifname);
+    if (it != ifIndexes.end())
+    {
+        return it->second;
+    }
+    ifNames.push_back(ifname);
+    ifIndexes[ifname] = (unsigned int)ifNames.size();
+    return (unsigned int)ifNames.size();
+}
+
+int __wrap_nl_send_auto(struct nl_sock *sk, struct nl_msg *msg)
+{
+    struct nlmsghdr *hdr = nlmsg_hdr(msg);
+
+    switch (hdr->nlmsg_type)
+    {
+        case RTM_NEWLINK:
+        case RTM_SETLINK:
+        case RTM_DELLINK:
+            netlinkCalls.push_back(linkRequest(hdr));
+            break;
+        case RTM_NEWADDR:
+        case RTM_DELADDR:
+            netlinkCalls.push_back(addrRequest(hdr));
+            break;
+        case RTM_NEWROUTE:
+        case RTM_DELROUTE:
+            netlinkCalls.push_back(routeRequest(hdr));
+            break;
+        default:
+            break;
+    }
+
+    return (int)hdr->nlmsg_len;
+}
+
+int __wrap_nl_wait_for_ack(struct nl_sock *sk)
+{
+    return 0;
+}
+
+}
+
+int cb(const std::string &cmd, std::string &stdout)
+{
+    mockCallArgs.push_back(cmd);
+    return 0;
+}
+
+// Test Fixture
+namespace tunnelmgr_ut
+{
+    struct TunnelMgrTest : public ::testing::Test
+    {
+        std::shared_ptr<swss::DBConnector> m_config_db;
+        std::shared_ptr<swss::DBConnector> m_app_db;
+        std::shared_ptr<swss::TunnelMgr> m_tunnelMgr;
+
+        virtual void SetUp() override
+        {
+            testing_db::reset();
+            m_config_db = std::make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_app_db = std::make_shared<swss::DBConnector>("APPL_DB", 0);
+
+            swss::WarmStart::initialize("tunnelmgrd", "swss");
+
+            mockCallArgs.clear();
+            netlinkCalls.clear();
+            callback = cb;
+
+            std::vector<std::string> cfg_tunnel_tables = {
+                CFG_TUNNEL_TABLE_NAME,
+                CFG_LOOPBACK_INTERFACE_TABLE_NAME,
+            };
+            m_tunnelMgr = std::make_shared<swss::TunnelMgr>(m_config_db.get(), m_app_db.get(), cfg_tunnel_tables);
+        }
+    };
+
+    TEST_F(TunnelMgrTest, TunnelInterfaceCreatedOverNetlink)
+    {
+        // A tunnel interface left by a previous run is removed at start
+        ASSERT_EQ(netlinkCalls, std::vector<std::string>({ "del tun0" }));
+        netlinkCalls.clear();
+
+        m_tunnelMgr->m_intfCache["Loopback3"] = swss::IpPrefix("10.1.0.32/32");
+        ASSERT_TRUE(m_tunnelMgr->configIpTunnel({ "IPINIP", "10.1.0.32", "10.1.0.33" }));
+
+        std::vector<std::string> expected = {
+            "add ipip tun0 local 10.1.0.32 remote 10.1.0.33",
+            "set tun0 up",
+            "addr add tun0 10.1.0.32/32",
+        };
+        ASSERT_EQ(netlinkCalls, expected);
+        ASSERT_TRUE(mockCallArgs.empty());
+    }
+
+    TEST_F(TunnelMgrTest, TunnelRoutesReplacedAndDeleted)
+    {
+        netlinkCalls.clear();
+
+        ASSERT_TRUE(m_tunnelMgr->doTunnelRouteTask({ "10.2.0.0/24", SET_COMMAND, {} }));
+        ASSERT_TRUE(m_tunnelMgr->doTunnelRouteTask({ "fc00::/64", SET_COMMAND, {} }));
+        ASSERT_TRUE(m_tunnelMgr->doTunnelRouteTask({ "10.2.0.0/24", DEL_COMMAND, {} }));
+
+        std::vector<std::string> expected = {
+            "route replace 10.2.0.0/24 dev tun0",
+            "route replace fc00::/64 dev tun0",
+            "route del 10.2.0.0/24 dev tun0",
+        };
+        ASSERT_EQ(netlinkCalls, expected);
+    }
+}
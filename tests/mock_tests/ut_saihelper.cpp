@@ -1,5 +1,6 @@
 #include "ut_helper.h"
 #include "mock_orchagent_main.h"
+#include "saicapabilitycache.h"
 
 namespace ut_helper
 {
@@ -119,6 +120,8 @@ namespace ut_helper
             return status;
         }
 
+        SaiCapabilityCache::instance().clear();
+
         sai_switch_api = nullptr;
         sai_bridge_api = nullptr;
         sai_virtual_router_api = nullptr;
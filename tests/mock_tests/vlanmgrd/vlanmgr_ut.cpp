@@ -0,0 +1,297 @@
+#include "gtest/gtest.h"
+#include <map>
+#include <set>
+#include <net/if.h>
+#include <netlink/netlink.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+#include <linux/if_bridge.h>
+#include <linux/rtnetlink.h>
+#include "../mock_table.h"
+#include "warm_restart.h"
+#define private public
+#include "vlanmgr.h"
+#undef private
+
+extern int (*callback)(const std::string &cmd, std::string &stdout);
+extern std::vector<std::string> mockCallArgs;
+extern swss::MacAddress gMacAddress;
+
+/* Decoded bridge VLAN requests sent by VlanMgr, e.g. "vlan add Ethernet0 10-12,20 pvid untagged" */
+static std::vector<std::string> netlinkCalls;
+static std::map<std::string, unsigned int> ifIndexes;
+static std::vector<std::string> ifNames;
+/* Ports whose bridge VLAN removal is nacked by the kernel */
+static std::set<std::string> failingDelPorts;
+static int netlinkAckResult = 0;
+
+static std::string ifName(int ifindex)
+{
+    if (ifindex <= 0 || ifindex > (int)ifNames.size())
+    {
+        return "";
+    }
+    return ifNames[ifindex - 1];
+}
+
+static std::string bridgeVlans(struct nlattr *spec)
+{
+    std::string vlans;
+    struct nlattr *attr;
+    int rem;
+
+    nla_for_each_nested(attr, spec, rem)
+    {
+        if (nla_type(attr) != IFLA_BRIDGE_VLAN_INFO)
+        {
+            continue;
+        }
+
+        auto *info = (struct bridge_vlan_info *)nla_data(attr);
+        if (info->flags & BRIDGE_VLAN_INFO_RANGE_END)
+        {
+            vlans += "-" + std::to_string(info->vid);
+        }
+        else
+        {
+            vlans += (vlans.empty() ? "" : ",") + std::to_string(info->vid);
+        }
+        if (!(info->flags & BRIDGE_VLAN_INFO_RANGE_BEGIN))
+        {
+            vlans += (info->flags & BRIDGE_VLAN_INFO_PVID) ? " pvid" : "";
+            vlans += (info->flags & BRIDGE_VLAN_INFO_UNTAGGED) ? " untagged" : "";
+        }
+    }
+    return vlans;
+}
+
+/*
+ * Wrap the netlink socket and interface lookups used by NetDevHelper so
+ * that requests are recorded and acked locally instead of reaching the
+ * kernel. The bridge VLAN dump finds no VLAN left on the port.
+ */
+extern "C" {
+
+int __wrap_nl_connect(struct nl_sock *sk, int protocol)
+{
+    return 0;
+}
+
+unsigned int __wrap_if_nametoindex(const char *ifname)
+{
+    auto it = ifIndexes.find(ifname);
+    if (it != ifIndexes.end())
+    {
+        return it->second;
+    }
+    ifNames.push_back(ifname);
+    ifIndexes[ifname] = (unsigned int)ifNames.size();
+    return (unsigned int)ifNames.size();
+}
+
+int __wrap_nl_send_auto(struct nl_sock *sk, struct nl_msg *msg)
+{
+    struct nlmsghdr *hdr = nlmsg_hdr(msg);
+    struct ifinfomsg *ifi = (struct ifinfomsg *)nlmsg_data(hdr);
+
+    netlinkAckResult = 0;
+    if ((hdr->nlmsg_type == RTM_SETLINK || hdr->nlmsg_type == RTM_DELLINK) && ifi->ifi_family == AF_BRIDGE)
+    {
+        struct nlattr *spec = nlmsg_find_attr(hdr, sizeof(*ifi), IFLA_AF_SPEC);
+        bool add = (hdr->nlmsg_type == RTM_SETLINK);
+        std::string port = ifName(ifi->ifi_index);
+
+        netlinkCalls.push_back(std::string("vlan ") + (add ? "add " : "del ") + port + " " +
+                               (spec ? bridgeVlans(spec) : ""));
+        if (!add && failingDelPorts.count(port))
+        {
+            netlinkAckResult = -NLE_FAILURE;
+        }
+    }
+
+    return (int)hdr->nlmsg_len;
+}
+
+int __wrap_nl_wait_for_ack(struct nl_sock *sk)
+{
+    return netlinkAckResult;
+}
+
+int __wrap_nl_recvmsgs(struct nl_sock *sk, struct nl_cb *cb)
+{
+    return 0;
+}
+
+}
+
+static int countNetlinkCalls(const std::string &prefix)
+{
+    int count = 0;
+    for (const auto &call : netlinkCalls)
+    {
+        if (call.find(prefix) == 0)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+int cb(const std::string &cmd, std::string &stdout)
+{
+    mockCallArgs.push_back(cmd);
+    return 0;
+}
+
+// Test Fixture
+namespace vlanmgr_ut
+{
+    struct VlanMgrTest : public ::testing::Test
+    {
+        std::shared_ptr<swss::DBConnector> m_config_db;
+        std::shared_ptr<swss::DBConnector> m_app_db;
+        std::shared_ptr<swss::DBConnector> m_state_db;
+        std::shared_ptr<swss::VlanMgr> m_vlanMgr;
+
+        virtual void SetUp() override
+        {
+            testing_db::reset();
+            m_config_db = std::make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_app_db = std::make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_state_db = std::make_shared<swss::DBConnector>("STATE_DB", 0);
+
+            swss::WarmStart::initialize("vlanmgrd", "swss");
+
+            gMacAddress = swss::MacAddress("00:11:22:33:44:55");
+            mockCallArgs.clear();
+            netlinkCalls.clear();
+            failingDelPorts.clear();
+            callback = cb;
+
+            std::vector<std::string> cfg_vlan_tables = {
+                CFG_VLAN_TABLE_NAME,
+                CFG_VLAN_MEMBER_TABLE_NAME,
+            };
+            m_vlanMgr = std::make_shared<swss::VlanMgr>(m_config_db.get(), m_app_db.get(), m_state_db.get(),
+                                                        cfg_vlan_tables, std::vector<std::string>());
+
+            std::vector<swss::FieldValueTuple> values = {{"state", "ok"}};
+            for (auto port : {"Ethernet0", "Ethernet4"})
+            {
+                m_vlanMgr->m_statePortTable.set(port, values);
+            }
+            for (auto vlan : {"Vlan10", "Vlan11", "Vlan12", "Vlan20", "Vlan30"})
+            {
+                m_vlanMgr->m_stateVlanTable.set(vlan, values);
+            }
+            netlinkCalls.clear();
+        }
+
+        swss::Consumer *getMemberConsumer()
+        {
+            return dynamic_cast<swss::Consumer *>(m_vlanMgr->getExecutor(CFG_VLAN_MEMBER_TABLE_NAME));
+        }
+
+        void applyMembers(const std::deque<swss::KeyOpFieldsValuesTuple> &entries)
+        {
+            getMemberConsumer()->addToSync(entries);
+            m_vlanMgr->doTask();
+        }
+
+        swss::KeyOpFieldsValuesTuple memberSet(const std::string &vlan, const std::string &port, const std::string &mode)
+        {
+            return { vlan + "|" + port, SET_COMMAND, { { "tagging_mode", mode } } };
+        }
+
+        swss::KeyOpFieldsValuesTuple memberDel(const std::string &vlan, const std::string &port)
+        {
+            return { vlan + "|" + port, DEL_COMMAND, {} };
+        }
+
+        bool memberStateOk(const std::string &vlan, const std::string &port)
+        {
+            return m_vlanMgr->isVlanMemberStateOk(vlan + "|" + port);
+        }
+    };
+
+    TEST_F(VlanMgrTest, MembersProgrammedWithOneRequestPerPort)
+    {
+        applyMembers({
+            memberSet("Vlan10", "Ethernet0", "tagged"),
+            memberSet("Vlan11", "Ethernet0", "tagged"),
+            memberSet("Vlan12", "Ethernet0", "tagged"),
+            memberSet("Vlan30", "Ethernet0", "tagged"),
+            memberSet("Vlan20", "Ethernet0", "untagged"),
+            memberSet("Vlan10", "Ethernet4", "tagged"),
+        });
+
+        // Consecutive tagged VLANs collapse into one range, the PVID comes last
+        ASSERT_EQ(countNetlinkCalls("vlan add Ethernet0 "), 1);
+        ASSERT_EQ(countNetlinkCalls("vlan add Ethernet0 10-12,30,20 pvid untagged"), 1);
+        ASSERT_EQ(countNetlinkCalls("vlan add Ethernet4 10"), 1);
+
+        for (auto vlan : {"Vlan10", "Vlan11", "Vlan12", "Vlan20", "Vlan30"})
+        {
+            ASSERT_TRUE(memberStateOk(vlan, "Ethernet0"));
+        }
+        ASSERT_TRUE(memberStateOk("Vlan10", "Ethernet4"));
+        ASSERT_EQ(m_vlanMgr->m_PortVlanMember["Ethernet0"]["Vlan20"], "untagged");
+        ASSERT_TRUE(getMemberConsumer()->m_toSync.empty());
+    }
+
+    TEST_F(VlanMgrTest, PvidVlansAreNotPartOfARange)
+    {
+        applyMembers({
+            memberSet("Vlan10", "Ethernet0", "untagged"),
+            memberSet("Vlan11", "Ethernet0", "untagged"),
+            memberSet("Vlan12", "Ethernet0", "tagged"),
+        });
+
+        // Each untagged VLAN is its own PVID entry, in order, so the last one wins
+        ASSERT_EQ(countNetlinkCalls("vlan add Ethernet0 "), 1);
+        ASSERT_EQ(countNetlinkCalls("vlan add Ethernet0 12,10 pvid untagged,11 pvid untagged"), 1);
+        ASSERT_TRUE(getMemberConsumer()->m_toSync.empty());
+    }
+
+    TEST_F(VlanMgrTest, FailedRemovalKeepsThePortTasks)
+    {
+        applyMembers({
+            memberSet("Vlan10", "Ethernet0", "tagged"),
+            memberSet("Vlan11", "Ethernet0", "tagged"),
+            memberSet("Vlan10", "Ethernet4", "tagged"),
+        });
+        ASSERT_TRUE(getMemberConsumer()->m_toSync.empty());
+
+        netlinkCalls.clear();
+        failingDelPorts.insert("Ethernet0");
+        applyMembers({
+            memberDel("Vlan10", "Ethernet0"),
+            memberDel("Vlan11", "Ethernet0"),
+            memberSet("Vlan12", "Ethernet0", "tagged"),
+            memberDel("Vlan10", "Ethernet4"),
+        });
+
+        // The port that failed keeps its members and all of its tasks, the other one goes on
+        ASSERT_EQ(countNetlinkCalls("vlan del Ethernet0 10-11"), 1);
+        ASSERT_EQ(countNetlinkCalls("vlan add Ethernet0 "), 0);
+        ASSERT_TRUE(memberStateOk("Vlan10", "Ethernet0"));
+        ASSERT_TRUE(memberStateOk("Vlan11", "Ethernet0"));
+        ASSERT_FALSE(memberStateOk("Vlan12", "Ethernet0"));
+        ASSERT_FALSE(memberStateOk("Vlan10", "Ethernet4"));
+        ASSERT_EQ(getMemberConsumer()->m_toSync.size(), 3);
+
+        netlinkCalls.clear();
+        failingDelPorts.clear();
+        m_vlanMgr->doTask();
+
+        // The removals are retried before the addition of the same port
+        ASSERT_EQ(netlinkCalls.size(), 3);
+        ASSERT_EQ(netlinkCalls[0], "vlan del Ethernet0 10-11");
+        ASSERT_EQ(netlinkCalls[1], "vlan del Ethernet0 1");
+        ASSERT_EQ(netlinkCalls[2], "vlan add Ethernet0 12");
+        ASSERT_FALSE(memberStateOk("Vlan10", "Ethernet0"));
+        ASSERT_FALSE(memberStateOk("Vlan11", "Ethernet0"));
+        ASSERT_TRUE(memberStateOk("Vlan12", "Ethernet0"));
+        ASSERT_TRUE(getMemberConsumer()->m_toSync.empty());
+    }
+}
@@ -0,0 +1,298 @@
+#include "gtest/gtest.h"
+#include <map>
+#include <net/if.h>
+#include <netlink/netlink.h>
+#include <netlink/cache.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+#include <netlink/route/link/vrf.h>
+#include <netlink/route/rule.h>
+#include <linux/fib_rules.h>
+#include <linux/if_link.h>
+#include <linux/rtnetlink.h>
+#include "../mock_table.h"
+#include "warm_restart.h"
+#define private public
+#include "vrfmgr.h"
+#undef private
+
+extern int (*callback)(const std::string &cmd, std::string &stdout);
+extern std::vector<std::string> mockCallArgs;
+
+/*
+ * Decoded link and rule requests sent by VrfMgr, e.g.
+ * "add vrf Vrf1 table 1001 up", "del Vrf1", "rule add inet pref 1001 table 255"
+ */
+static std::vector<std::string> netlinkCalls;
+/* Request nacked by the kernel, matched on the start of the decoded request */
+static std::string failingRequest;
+static int netlinkAckResult = 0;
+
+/* VRF devices and ipv4 rule preferences found in the kernel */
+static std::map<std::string, uint32_t> kernelVrfs;
+static std::vector<uint32_t> kernelRulePrefs;
+
+static std::string linkRequest(struct nlmsghdr *hdr)
+{
+    struct ifinfomsg *ifi = (struct ifinfomsg *)nlmsg_data(hdr);
+    struct nlattr *attrs[IFLA_MAX + 1];
+    struct nlattr *info[IFLA_INFO_MAX + 1] = {};
+    std::string name;
+
+    if (nlmsg_parse(hdr, sizeof(*ifi), attrs, IFLA_MAX, NULL) < 0)
+    {
+        return "";
+    }
+    name = attrs[IFLA_IFNAME] ? nla_get_string(attrs[IFLA_IFNAME]) : std::to_string(ifi->ifi_index);
+
+    if (hdr->nlmsg_type == RTM_DELLINK)
+    {
+        return "del " + name;
+    }
+
+    if (attrs[IFLA_LINKINFO])
+    {
+        nla_parse_nested(info, IFLA_INFO_MAX, attrs[IFLA_LINKINFO], NULL);
+    }
+    std::string request = std::string("add ") + (info[IFLA_INFO_KIND] ? nla_get_string(info[IFLA_INFO_KIND]) : "") +
+                          " " + name;
+    if (info[IFLA_INFO_DATA])
+    {
+        struct nlattr *vrf[IFLA_VRF_MAX + 1];
+        if (nla_parse_nested(vrf, IFLA_VRF_MAX, info[IFLA_INFO_DATA], NULL) >= 0 && vrf[IFLA_VRF_TABLE])
+        {
+            request += " table " + std::to_string(nla_get_u32(vrf[IFLA_VRF_TABLE]));
+        }
+    }
+    if ((ifi->ifi_change & IFF_UP) && (ifi->ifi_flags & IFF_UP))
+    {
+        request += " up";
+    }
+    return request;
+}
+
+static std::string ruleRequest(struct nlmsghdr *hdr)
+{
+    struct fib_rule_hdr *frh = (struct fib_rule_hdr *)nlmsg_data(hdr);
+    struct nlattr *attrs[FRA_MAX + 1];
+    uint32_t table = frh->table;
+
+    if (nlmsg_parse(hdr, sizeof(*frh), attrs, FRA_MAX, NULL) < 0)
+    {
+        return "";
+    }
+    if (attrs[FRA_TABLE])
+    {
+        table = nla_get_u32(attrs[FRA_TABLE]);
+    }
+
+    std::string request = std::string("rule ") + (hdr->nlmsg_type == RTM_NEWRULE ? "add " : "del ") +
+                          (frh->family == AF_INET6 ? "inet6" : "inet");
+    if (attrs[FRA_PRIORITY])
+    {
+        request += " pref " + std::to_string(nla_get_u32(attrs[FRA_PRIORITY]));
+    }
+    if (table)
+    {
+        request += " table " + std::to_string(table);
+    }
+    return request;
+}
+
+/*
+ * Wrap the netlink socket and dumps used by NetDevHelper so that requests
+ * are recorded and acked locally instead of reaching the kernel, and the
+ * dumps return the kernel state set by the test.
+ */
+extern "C" {
+
+int __wrap_nl_connect(struct nl_sock *sk, int protocol)
+{
+    return 0;
+}
+
+int __wrap_nl_send_auto(struct nl_sock *sk, struct nl_msg *msg)
+{
+    struct nlmsghdr *hdr = nlmsg_hdr(msg);
+    std::string request;
+
+    netlinkAckResult = 0;
+    if (hdr->nlmsg_type == RTM_NEWLINK || hdr->nlmsg_type == RTM_DELLINK)
+    {
+        request = linkRequest(hdr);
+    }
+    else if (hdr->nlmsg_type == RTM_NEWRULE || hdr->nlmsg_type == RTM_DELRULE)
+    {
+        request = ruleRequest(hdr);
+    }
+
+    if (!request.empty())
+    {
+        netlinkCalls.push_back(request);
+        if (!failingRequest.empty() && request.find(failingRequest) == 0)
+        {
+            netlinkAckResult = -NLE_FAILURE;
+        }
+    }
+
+    return (int)hdr->nlmsg_len;
+}
+
+int __wrap_nl_wait_for_ack(struct nl_sock *sk)
+{
+    return netlinkAckResult;
+}
+
+int __wrap_rtnl_link_alloc_cache(struct nl_sock *sk, int family, struct nl_cache **result)
+{
+    int err = nl_cache_alloc_name("route/link", result);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    for (const auto &vrf : kernelVrfs)
+    {
+        struct rtnl_link *link = rtnl_link_vrf_alloc();
+        rtnl_link_set_name(link, vrf.first.c_str());
+        rtnl_link_vrf_set_tableid(link, vrf.second);
+        nl_cache_add(*result, (struct nl_object *)link);
+        rtnl_link_put(link);
+    }
+    return 0;
+}
+
+int __wrap_rtnl_rule_alloc_cache(struct nl_sock *sk, int family, struct nl_cache **result)
+{
+    int err = nl_cache_alloc_name("route/rule", result);
+    if (err < 0)
+    {
+        return err;
+    }
+
+    for (auto pref : kernelRulePrefs)
+    {
+        struct rtnl_rule *rule = rtnl_rule_alloc();
+        rtnl_rule_set_family(rule, family);
+        rtnl_rule_set_prio(rule, pref);
+        nl_cache_add(*result, (struct nl_object *)rule);
+        rtnl_rule_put(rule);
+    }
+    return 0;
+}
+
+}
+
+int cb(const std::string &cmd, std::string &stdout)
+{
+    mockCallArgs.push_back(cmd);
+    return 0;
+}
+
+// Test Fixture
+namespace vrfmgr_ut
+{
+    struct VrfMgrTest : public ::testing::Test
+    {
+        std::shared_ptr<swss::DBConnector> m_config_db;
+        std::shared_ptr<swss::DBConnector> m_app_db;
+        std::shared_ptr<swss::DBConnector> m_state_db;
+        std::shared_ptr<swss::VrfMgr> m_vrfMgr;
+
+        virtual void SetUp() override
+        {
+            testing_db::reset();
+            m_config_db = std::make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_app_db = std::make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_state_db = std::make_shared<swss::DBConnector>("STATE_DB", 0);
+
+            swss::WarmStart::initialize("vrfmgrd", "swss");
+
+            mockCallArgs.clear();
+            netlinkCalls.clear();
+            failingRequest.clear();
+            kernelVrfs.clear();
+            kernelRulePrefs = { 1000, 1001, 32766, 32767 };
+            callback = cb;
+        }
+
+        void createVrfMgr()
+        {
+            std::vector<std::string> cfg_vrf_tables = {
+                CFG_VRF_TABLE_NAME,
+                CFG_VNET_TABLE_NAME,
+                CFG_VXLAN_EVPN_NVO_TABLE_NAME,
+                CFG_MGMT_VRF_CONFIG_TABLE_NAME,
+            };
+            m_vrfMgr = std::make_shared<swss::VrfMgr>(m_config_db.get(), m_app_db.get(), m_state_db.get(),
+                                                      cfg_vrf_tables);
+        }
+    };
+
+    TEST_F(VrfMgrTest, ColdStartRemovesStaleVrfsAndMovesTheLocalRule)
+    {
+        kernelVrfs = { { "Vrf1", 1001 }, { "mgmt", 5000 } };
+        kernelRulePrefs = { 0, 1000, 32766, 32767 };
+
+        createVrfMgr();
+
+        // The mgmt VRF is left to hostcfgd, the local table lookup goes after the l3mdev rule
+        std::vector<std::string> expected = {
+            "del Vrf1",
+            "rule add inet pref 1001 table 255",
+            "rule del inet pref 0",
+            "rule add inet6 pref 1001 table 255",
+            "rule del inet6 pref 0",
+        };
+        ASSERT_EQ(netlinkCalls, expected);
+        ASSERT_TRUE(m_vrfMgr->m_vrfTableMap.empty());
+        ASSERT_TRUE(mockCallArgs.empty());
+    }
+
+    TEST_F(VrfMgrTest, LocalRuleLeftAloneOnceMoved)
+    {
+        createVrfMgr();
+
+        ASSERT_TRUE(netlinkCalls.empty());
+    }
+
+    TEST_F(VrfMgrTest, VrfCreatedUpWithAFreeTable)
+    {
+        createVrfMgr();
+
+        ASSERT_TRUE(m_vrfMgr->setLink("Vrf2"));
+        ASSERT_TRUE(m_vrfMgr->setLink("Vrf3"));
+        ASSERT_EQ(m_vrfMgr->m_vrfTableMap["Vrf2"], 1001);
+        ASSERT_EQ(m_vrfMgr->m_vrfTableMap["Vrf3"], 1002);
+
+        // An existing VRF is not created again
+        ASSERT_TRUE(m_vrfMgr->setLink("Vrf2"));
+
+        // The table of a removed VRF is given to the next one
+        ASSERT_TRUE(m_vrfMgr->delLink("Vrf2"));
+        ASSERT_TRUE(m_vrfMgr->setLink("Vrf4"));
+        ASSERT_EQ(m_vrfMgr->m_vrfTableMap["Vrf4"], 1001);
+
+        std::vector<std::string> expected = {
+            "add vrf Vrf2 table 1001 up",
+            "add vrf Vrf3 table 1002 up",
+            "del Vrf2",
+            "add vrf Vrf4 table 1001 up",
+        };
+        ASSERT_EQ(netlinkCalls, expected);
+    }
+
+    TEST_F(VrfMgrTest, FailedVrfCreationReturnsTheTable)
+    {
+        createVrfMgr();
+        failingRequest = "add vrf Vrf2";
+
+        ASSERT_THROW(m_vrfMgr->setLink("Vrf2"), std::runtime_error);
+        ASSERT_EQ(m_vrfMgr->m_vrfTableMap.count("Vrf2"), 0);
+        ASSERT_EQ(m_vrfMgr->m_freeTables.count(1001), 1);
+
+        failingRequest.clear();
+        ASSERT_TRUE(m_vrfMgr->setLink("Vrf3"));
+        ASSERT_EQ(m_vrfMgr->m_vrfTableMap["Vrf3"], 1001);
+    }
+}
@@ -0,0 +1,366 @@
+#include "gtest/gtest.h"
+#include <map>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <netlink/netlink.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+#include <linux/if_bridge.h>
+#include <linux/if_link.h>
+#include <linux/rtnetlink.h>
+#include "../mock_table.h"
+#include "warm_restart.h"
+#define private public
+#include "vxlanmgr.h"
+#undef private
+
+extern int (*callback)(const std::string &cmd, std::string &stdout);
+extern std::vector<std::string> mockCallArgs;
+extern swss::MacAddress gMacAddress;
+
+/*
+ * Decoded link requests sent by VxlanMgr, e.g.
+ * "add vxlan vtep-100 id 1000 port 4789 learning 0 local 10.1.0.1 master Bridge mac 00:11:22:33:44:55"
+ * "set Brvxlan1000 master Vnet1", "vlan add vtep-100 100 pvid untagged", "del vtep-100"
+ */
+static std::vector<std::string> netlinkCalls;
+static std::map<std::string, unsigned int> ifIndexes;
+static std::vector<std::string> ifNames;
+/* Request nacked by the kernel, matched on the start of the decoded request */
+static std::string failingRequest;
+static int netlinkAckResult = 0;
+
+static std::string ifName(int ifindex)
+{
+    if (ifindex <= 0 || ifindex > (int)ifNames.size())
+    {
+        return "";
+    }
+    return ifNames[ifindex - 1];
+}
+
+static std::string ipv4(struct nlattr *attr)
+{
+    char buf[INET_ADDRSTRLEN];
+    return inet_ntop(AF_INET, nla_data(attr), buf, sizeof(buf)) ? buf : "";
+}
+
+static std::string bridgeVlans(struct nlattr *spec)
+{
+    std::string vlans;
+    struct nlattr *attr;
+    int rem;
+
+    nla_for_each_nested(attr, spec, rem)
+    {
+        if (nla_type(attr) != IFLA_BRIDGE_VLAN_INFO)
+        {
+            continue;
+        }
+
+        auto *info = (struct bridge_vlan_info *)nla_data(attr);
+        if (info->flags & BRIDGE_VLAN_INFO_RANGE_END)
+        {
+            vlans += "-" + std::to_string(info->vid);
+        }
+        else
+        {
+            vlans += (vlans.empty() ? "" : ",") + std::to_string(info->vid);
+        }
+        if (!(info->flags & BRIDGE_VLAN_INFO_RANGE_BEGIN))
+        {
+            vlans += (info->flags & BRIDGE_VLAN_INFO_PVID) ? " pvid" : "";
+            vlans += (info->flags & BRIDGE_VLAN_INFO_UNTAGGED) ? " untagged" : "";
+        }
+    }
+    return vlans;
+}
+
+static std::string vxlanInfo(struct nlattr *data)
+{
+    struct nlattr *attrs[IFLA_VXLAN_MAX + 1];
+    std::string info;
+
+    if (nla_parse_nested(attrs, IFLA_VXLAN_MAX, data, NULL) < 0)
+    {
+        return "";
+    }
+    if (attrs[IFLA_VXLAN_ID])
+    {
+        info += " id " + std::to_string(nla_get_u32(attrs[IFLA_VXLAN_ID]));
+    }
+    if (attrs[IFLA_VXLAN_PORT])
+    {
+        info += " port " + std::to_string(ntohs(nla_get_u16(attrs[IFLA_VXLAN_PORT])));
+    }
+    if (attrs[IFLA_VXLAN_LEARNING])
+    {
+        info += " learning " + std::to_string(nla_get_u8(attrs[IFLA_VXLAN_LEARNING]));
+    }
+    if (attrs[IFLA_VXLAN_LOCAL])
+    {
+        info += " local " + ipv4(attrs[IFLA_VXLAN_LOCAL]);
+    }
+    if (attrs[IFLA_VXLAN_GROUP])
+    {
+        info += " remote " + ipv4(attrs[IFLA_VXLAN_GROUP]);
+    }
+    return info;
+}
+
+static std::string linkRequest(struct nlmsghdr *hdr)
+{
+    struct ifinfomsg *ifi = (struct ifinfomsg *)nlmsg_data(hdr);
+    struct nlattr *attrs[IFLA_MAX + 1];
+    std::string request;
+
+    if (nlmsg_parse(hdr, sizeof(*ifi), attrs, IFLA_MAX, NULL) < 0)
+    {
+        return "";
+    }
+
+    if (ifi->ifi_family == AF_BRIDGE)
+    {
+        if (attrs[IFLA_AF_SPEC])
+        {
+            return std::string("vlan ") + (hdr->nlmsg_type == RTM_DELLINK ? "del " : "add ") +
+                   ifName(ifi->ifi_index) + " " + bridgeVlans(attrs[IFLA_AF_SPEC]);
+        }
+        if (attrs[IFLA_PROTINFO])
+        {
+            struct nlattr *learning = nla_find(
+                (struct nlattr *)nla_data(attrs[IFLA_PROTINFO]), nla_len(attrs[IFLA_PROTINFO]), IFLA_BRPORT_LEARNING);
+            return "learning " + ifName(ifi->ifi_index) + (learning && nla_get_u8(learning) ? " on" : " off");
+        }
+        return "";
+    }
+
+    if (hdr->nlmsg_type == RTM_DELLINK)
+    {
+        return "del " + (attrs[IFLA_IFNAME] ? nla_get_string(attrs[IFLA_IFNAME]) : ifName(ifi->ifi_index));
+    }
+
+    if (hdr->nlmsg_flags & NLM_F_CREATE)
+    {
+        struct nlattr *info[IFLA_INFO_MAX + 1] = {};
+
+        if (attrs[IFLA_LINKINFO])
+        {
+            nla_parse_nested(info, IFLA_INFO_MAX, attrs[IFLA_LINKINFO], NULL);
+        }
+        std::string kind = info[IFLA_INFO_KIND] ? nla_get_string(info[IFLA_INFO_KIND]) : "";
+
+        request = "add " + kind + " " + (attrs[IFLA_IFNAME] ? nla_get_string(attrs[IFLA_IFNAME]) : "");
+        if (kind == "vxlan" && info[IFLA_INFO_DATA])
+        {
+            request += vxlanInfo(info[IFLA_INFO_DATA]);
+        }
+    }
+    else
+    {
+        request = "set " + ifName(ifi->ifi_index);
+        if (ifi->ifi_change & IFF_UP)
+        {
+            request += (ifi->ifi_flags & IFF_UP) ? " up" : " down";
+        }
+    }
+
+    if (attrs[IFLA_MASTER])
+    {
+        uint32_t master = nla_get_u32(attrs[IFLA_MASTER]);
+        request += master ? " master " + ifName(master) : " nomaster";
+    }
+    if (attrs[IFLA_ADDRESS])
+    {
+        request += " mac " + swss::MacAddress((const uint8_t *)nla_data(attrs[IFLA_ADDRESS])).to_string();
+    }
+    return request;
+}
+
+/*
+ * Wrap the netlink socket and interface lookups used by NetDevHelper so
+ * that requests are recorded and acked locally instead of reaching the
+ * kernel. Every interface looked up exists.
+ */
+extern "C" {
+
+int __wrap_nl_connect(struct nl_sock *sk, int protocol)
+{
+    return 0;
+}
+
+unsigned int __wrap_if_nametoindex(const char *ifname)
+{
+    auto it = ifIndexes.find(ifname);
+    if (it != ifIndexes.end())
+    {
+        return it->second;
+    }
+    ifNames.push_back(ifname);
+    ifIndexes[ifname] = (unsigned int)ifNames.size();
+    return (unsigned int)ifNames.size();
+}
+
+int __wrap_nl_send_auto(struct nl_sock *sk, struct nl_msg *msg)
+{
+    struct nlmsghdr *hdr = nlmsg_hdr(msg);
+
+    netlinkAckResult = 0;
+    if (hdr->nlmsg_type == RTM_NEWLINK || hdr->nlmsg_type == RTM_SETLINK || hdr->nlmsg_type == RTM_DELLINK)
+    {
+        std::string request = linkRequest(hdr);
+
+        netlinkCalls.push_back(request);
+        if (!failingRequest.empty() && request.find(failingRequest) == 0)
+        {
+            netlinkAckResult = -NLE_FAILURE;
+        }
+    }
+
+    return (int)hdr->nlmsg_len;
+}
+
+int __wrap_nl_wait_for_ack(struct nl_sock *sk)
+{
+    return netlinkAckResult;
+}
+
+int __wrap_nl_recvmsgs(struct nl_sock *sk, struct nl_cb *cb)
+{
+    return 0;
+}
+
+}
+
+int cb(const std::string &cmd, std::string &stdout)
+{
+    mockCallArgs.push_back(cmd);
+    return 0;
+}
+
+// Test Fixture
+namespace vxlanmgr_ut
+{
+    struct VxlanMgrTest : public ::testing::Test
+    {
+        std::shared_ptr<swss::DBConnector> m_config_db;
+        std::shared_ptr<swss::DBConnector> m_app_db;
+        std::shared_ptr<swss::DBConnector> m_state_db;
+        std::shared_ptr<swss::VxlanMgr> m_vxlanMgr;
+
+        virtual void SetUp() override
+        {
+            testing_db::reset();
+            m_config_db = std::make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_app_db = std::make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_state_db = std::make_shared<swss::DBConnector>("STATE_DB", 0);
+
+            swss::WarmStart::initialize("vxlanmgrd", "swss");
+
+            gMacAddress = swss::MacAddress("00:11:22:33:44:55");
+            mockCallArgs.clear();
+            failingRequest.clear();
+            callback = cb;
+
+            std::vector<std::string> cfg_vxlan_tables = {
+                CFG_VNET_TABLE_NAME,
+                CFG_VXLAN_TUNNEL_TABLE_NAME,
+                CFG_VXLAN_TUNNEL_MAP_TABLE_NAME,
+                CFG_VXLAN_EVPN_NVO_TABLE_NAME,
+            };
+            m_vxlanMgr = std::make_shared<swss::VxlanMgr>(m_config_db.get(), m_app_db.get(), m_state_db.get(),
+                                                          cfg_vxlan_tables);
+            netlinkCalls.clear();
+        }
+
+        swss::VxlanMgr::VxlanInfo vnetInfo()
+        {
+            swss::VxlanMgr::VxlanInfo info;
+            info.m_vxlanTunnel = "vtep";
+            info.m_sourceIp = "10.1.0.1";
+            info.m_vnet = "Vnet1";
+            info.m_vni = "2000";
+            info.m_vxlan = "Vxlan2000";
+            info.m_vxlanIf = "Brvxlan2000";
+            info.m_macAddress = "00:aa:bb:cc:dd:ee";
+            return info;
+        }
+    };
+
+    TEST_F(VxlanMgrTest, VlanVniMapNetdeviceCreatedOverNetlink)
+    {
+        m_vxlanMgr->m_EvpnNvoCache["nvo"] = "vtep";
+
+        ASSERT_EQ(m_vxlanMgr->createVxlanNetdevice("vtep", "1000", "10.1.0.1", "", "100"), 0);
+
+        // The device is created with its MAC, learning off and its bridge in one request
+        std::vector<std::string> expected = {
+            "add vxlan vtep-100 id 1000 port 4789 learning 0 local 10.1.0.1 master Bridge mac 00:11:22:33:44:55",
+            "vlan add vtep-100 100 pvid untagged",
+            "vlan del vtep-100 1",
+            "learning vtep-100 off",
+            "set vtep-100 up",
+        };
+        ASSERT_EQ(netlinkCalls, expected);
+        ASSERT_TRUE(mockCallArgs.empty());
+    }
+
+    TEST_F(VxlanMgrTest, VlanVniMapNetdeviceStopsAtTheFirstFailure)
+    {
+        failingRequest = "vlan add vtep-1 1";
+
+        // Without EVPN NVO the bridge port learning is left alone
+        ASSERT_NE(m_vxlanMgr->createVxlanNetdevice("vtep", "1000", "10.1.0.1", "10.2.0.1", "1"), 0);
+
+        std::vector<std::string> expected = {
+            "add vxlan vtep-1 id 1000 port 4789 learning 0 local 10.1.0.1 remote 10.2.0.1 master Bridge mac 00:11:22:33:44:55",
+            "vlan add vtep-1 1 pvid untagged",
+        };
+        ASSERT_EQ(netlinkCalls, expected);
+    }
+
+    TEST_F(VxlanMgrTest, VnetDevicesCreatedOverNetlink)
+    {
+        auto info = vnetInfo();
+
+        ASSERT_TRUE(m_vxlanMgr->createVxlan(info));
+
+        std::vector<std::string> expected = {
+            "add vxlan Vxlan2000 id 2000 port 4789 learning 1 local 10.1.0.1",
+            "set Vxlan2000 up",
+            "add bridge Brvxlan2000",
+            "set Vxlan2000 master Brvxlan2000",
+            "set Brvxlan2000 mac 00:aa:bb:cc:dd:ee",
+            "set Brvxlan2000 master Vnet1",
+            "set Brvxlan2000 up",
+        };
+        ASSERT_EQ(netlinkCalls, expected);
+
+        std::vector<swss::FieldValueTuple> values;
+        ASSERT_TRUE(m_vxlanMgr->m_stateVxlanTable.get(info.m_vxlan, values));
+    }
+
+    TEST_F(VxlanMgrTest, VnetDevicesRolledBackInReverseOrder)
+    {
+        auto info = vnetInfo();
+        failingRequest = "set Brvxlan2000 master Vnet1";
+
+        ASSERT_FALSE(m_vxlanMgr->createVxlan(info));
+
+        std::vector<std::string> expected = {
+            "add vxlan Vxlan2000 id 2000 port 4789 learning 1 local 10.1.0.1",
+            "set Vxlan2000 up",
+            "add bridge Brvxlan2000",
+            "set Vxlan2000 master Brvxlan2000",
+            "set Brvxlan2000 mac 00:aa:bb:cc:dd:ee",
+            "set Brvxlan2000 master Vnet1",
+            "set Vxlan2000 nomaster",
+            "del Brvxlan2000",
+            "del Vxlan2000",
+        };
+        ASSERT_EQ(netlinkCalls, expected);
+
+        std::vector<swss::FieldValueTuple> values;
+        ASSERT_FALSE(m_vxlanMgr->m_stateVxlanTable.get(info.m_vxlan, values));
+    }
+}
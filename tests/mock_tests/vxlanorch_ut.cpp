@@ -28,6 +28,66 @@ namespace vxlanorch_test
     constexpr sai_object_id_t vxlan_tunnel_term_table_entry_oid = 0x1248;
     constexpr sai_object_id_t vxlan_tunnel_map_entry_oid = 0x1256;
 
+    // Bulk tunnel map entry calls, the SAI fails the entries of VNI _ut_stub_failing_vni
+    uint32_t _ut_stub_failing_vni;
+    bool _ut_stub_bulk_supported;
+    uint32_t _ut_stub_bulk_create_calls;
+    uint32_t _ut_stub_bulk_remove_calls;
+
+    sai_status_t _ut_stub_create_tunnel_map_entries(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        if (!_ut_stub_bulk_supported)
+        {
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+
+        sai_status_t status = SAI_STATUS_SUCCESS;
+
+        _ut_stub_bulk_create_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+            object_id[i] = vxlan_tunnel_map_entry_oid + i;
+            for (uint32_t j = 0; j < attr_count[i]; j++)
+            {
+                if (attr_list[i][j].id == SAI_TUNNEL_MAP_ENTRY_ATTR_VNI_ID_VALUE &&
+                    attr_list[i][j].value.u32 == _ut_stub_failing_vni)
+                {
+                    object_id[i] = SAI_NULL_OBJECT_ID;
+                    object_statuses[i] = SAI_STATUS_TABLE_FULL;
+                    status = SAI_STATUS_FAILURE;
+                }
+            }
+        }
+        return status;
+    }
+
+    sai_status_t _ut_stub_remove_tunnel_map_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        if (!_ut_stub_bulk_supported)
+        {
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+
+        _ut_stub_bulk_remove_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
     shared_ptr<swss::DBConnector> m_app_db;
     shared_ptr<swss::DBConnector> m_config_db;
     shared_ptr<swss::DBConnector> m_state_db;
@@ -443,4 +503,122 @@ namespace vxlanorch_test
                 });
         vxlan_orch->delTunnel("vxlan_tunnel_1");
     }
+
+    TEST_F(VxlanOrchTest, TunnelMapEntryBulkCreateFailedInTheMiddle)
+    {
+        _ut_stub_failing_vni = 2000;
+        _ut_stub_bulk_supported = true;
+        _ut_stub_bulk_create_calls = 0;
+        _ut_stub_bulk_remove_calls = 0;
+
+        TunnelMapEntryBulker bulker;
+        bulker.bulker_.create_entries = _ut_stub_create_tunnel_map_entries;
+        bulker.bulker_.remove_entries = _ut_stub_remove_tunnel_map_entries;
+
+        // The entries go in one bulk, not one by one
+        EXPECT_CALL(mock_sai_tunnel_, create_tunnel_map_entry(_, _, _, _)).Times(0);
+        EXPECT_CALL(mock_sai_tunnel_, remove_tunnel_map_entry(_)).Times(0);
+
+        vector<sai_object_id_t> ids(3, vxlan_tunnel_oid);
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            sai_attribute_t attr;
+            attr.id = SAI_TUNNEL_MAP_ENTRY_ATTR_VNI_ID_VALUE;
+            attr.value.u32 = 1000 * (i + 1);
+            bulker.create({ attr }, [&ids, i](sai_object_id_t id) { ids[i] = id; });
+        }
+        bulker.flush();
+
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 1);
+        ASSERT_EQ(ids[0], vxlan_tunnel_map_entry_oid);
+        ASSERT_EQ(ids[1], SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(ids[2], vxlan_tunnel_map_entry_oid + 2);
+
+        vector<bool> removed;
+        bulker.remove(ids[0], [&removed](bool success) { removed.push_back(success); });
+        bulker.remove(ids[1], [&removed](bool success) { removed.push_back(success); });
+        bulker.remove(ids[2], [&removed](bool success) { removed.push_back(success); });
+        bulker.flush();
+
+        // The entry that was never created needs no removal
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 1);
+        ASSERT_EQ(removed, vector<bool>({ true, true, true }));
+    }
+
+    TEST_F(VxlanOrchTest, TunnelMapEntryFallbackWithoutBulkSupport)
+    {
+        _ut_stub_failing_vni = 0;
+        _ut_stub_bulk_supported = false;
+        _ut_stub_bulk_create_calls = 0;
+        _ut_stub_bulk_remove_calls = 0;
+
+        TunnelMapEntryBulker bulker;
+        bulker.bulker_.create_entries = _ut_stub_create_tunnel_map_entries;
+        bulker.bulker_.remove_entries = _ut_stub_remove_tunnel_map_entries;
+
+        // Each entry is programmed on its own, the failed one gets no id
+        EXPECT_CALL(mock_sai_tunnel_, create_tunnel_map_entry(_, _, _, _))
+            .WillOnce(DoAll(
+                        SetArgPointee<0>(vxlan_tunnel_map_entry_oid),
+                        Return(SAI_STATUS_SUCCESS)
+                        ))
+            .WillOnce(DoAll(
+                        SetArgPointee<0>(SAI_NULL_OBJECT_ID),
+                        Return(SAI_STATUS_TABLE_FULL)
+                        ))
+            .WillOnce(DoAll(
+                        SetArgPointee<0>(vxlan_tunnel_map_entry_oid + 2),
+                        Return(SAI_STATUS_SUCCESS)
+                        ));
+
+        vector<sai_object_id_t> ids(3, vxlan_tunnel_oid);
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            sai_attribute_t attr;
+            attr.id = SAI_TUNNEL_MAP_ENTRY_ATTR_VNI_ID_VALUE;
+            attr.value.u32 = 1000 * (i + 1);
+            bulker.create({ attr }, [&ids, i](sai_object_id_t id) { ids[i] = id; });
+        }
+        bulker.flush();
+
+        ASSERT_EQ(_ut_stub_bulk_create_calls, 0);
+        ASSERT_EQ(ids[0], vxlan_tunnel_map_entry_oid);
+        ASSERT_EQ(ids[1], SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(ids[2], vxlan_tunnel_map_entry_oid + 2);
+
+        EXPECT_CALL(mock_sai_tunnel_, remove_tunnel_map_entry(vxlan_tunnel_map_entry_oid))
+            .WillOnce(Return(SAI_STATUS_SUCCESS));
+        EXPECT_CALL(mock_sai_tunnel_, remove_tunnel_map_entry(vxlan_tunnel_map_entry_oid + 2))
+            .WillOnce(Return(SAI_STATUS_OBJECT_IN_USE));
+
+        vector<bool> removed;
+        bulker.remove(ids[0], [&removed](bool success) { removed.push_back(success); });
+        bulker.remove(ids[2], [&removed](bool success) { removed.push_back(success); });
+        bulker.flush();
+
+        ASSERT_EQ(_ut_stub_bulk_remove_calls, 0);
+        ASSERT_EQ(removed, vector<bool>({ true, false }));
+    }
+
+    TEST(VxlanKeyHashTest, TunnelUsersKeyedByAddress)
+    {
+        TunnelUsers users;
+        users[IpAddress("10.0.0.1")].imr_refcnt++;
+        users[IpAddress("2001:db8::1")].mac_refcnt++;
+        users[IpAddress("10.0.0.1")].imr_refcnt++;
+
+        ASSERT_EQ(users.size(), 2);
+        ASSERT_EQ(users[IpAddress("10.0.0.1")].imr_refcnt, 2);
+        ASSERT_EQ(users.count(IpAddress("2001:db8::2")), 0);
+
+        nh_key_t key(IpAddress("10.0.0.1"), MacAddress("00:11:22:33:44:55"), 1000);
+        nh_key_t same(IpAddress("10.0.0.1"), MacAddress("00:11:22:33:44:55"), 1000);
+        ASSERT_EQ(nh_key_hash()(key), nh_key_hash()(same));
+
+        TunnelNHs nhs;
+        nhs[key].ref_count = 1;
+        nhs[nh_key_t(IpAddress("10.0.0.1"), MacAddress("00:11:22:33:44:55"), 1001)].ref_count = 1;
+        ASSERT_EQ(nhs.size(), 2);
+        ASSERT_EQ(nhs.count(same), 1);
+    }
 }
@@ -0,0 +1,109 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "warmcheckpoint.h"
+
+#include <cstdio>
+#include <unistd.h>
+
+namespace warmcheckpoint_test
+{
+    using namespace std;
+
+    struct WarmCheckpointTest : public ::testing::Test
+    {
+        string m_path;
+
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+            m_path = "/tmp/warmcheckpoint_ut." + to_string(getpid());
+        }
+
+        virtual void TearDown() override
+        {
+            unlink(m_path.c_str());
+            ::testing_db::reset();
+        }
+    };
+
+    TEST_F(WarmCheckpointTest, DigestIgnoresOrder)
+    {
+        TableDigest a;
+        a.add({"Ethernet0", SET_COMMAND, { {"mtu", "9100"}, {"speed", "100000"} }});
+        a.add({"Ethernet4", SET_COMMAND, { {"mtu", "1500"} }});
+
+        TableDigest b;
+        b.add({"Ethernet4", SET_COMMAND, { {"mtu", "1500"} }});
+        b.add({"Ethernet0", SET_COMMAND, { {"speed", "100000"}, {"mtu", "9100"} }});
+
+        ASSERT_EQ(a.value(), b.value());
+        ASSERT_EQ(a.count(), 2);
+
+        // A value moved to another field is a change
+        TableDigest c;
+        c.add({"Ethernet0", SET_COMMAND, { {"mtu", "100000"}, {"speed", "9100"} }});
+        c.add({"Ethernet4", SET_COMMAND, { {"mtu", "1500"} }});
+        ASSERT_NE(a.value(), c.value());
+    }
+
+    TEST_F(WarmCheckpointTest, WriteAndLoad)
+    {
+        TableDigest digest;
+        digest.add({"10.0.0.0/24", SET_COMMAND, { {"nexthop", "10.0.0.1"} }});
+
+        WarmCheckpoint checkpoint;
+        checkpoint.addTable("RouteOrch|ROUTE_TABLE", digest);
+        checkpoint.addObjects("RouteOrch|routes", 42);
+        ASSERT_TRUE(checkpoint.write(m_path));
+
+        WarmCheckpoint loaded;
+        ASSERT_TRUE(loaded.load(m_path));
+        ASSERT_EQ(loaded.getTables().size(), 1);
+        ASSERT_EQ(loaded.getTables().at("RouteOrch|ROUTE_TABLE").digest, digest.value());
+        ASSERT_EQ(loaded.getTables().at("RouteOrch|ROUTE_TABLE").count, 1);
+        ASSERT_EQ(loaded.getObjects().at("RouteOrch|routes").count, 42);
+    }
+
+    TEST_F(WarmCheckpointTest, RejectsOtherVersion)
+    {
+        WarmCheckpoint checkpoint;
+        checkpoint.addObjects("RouteOrch|routes", 1);
+        ASSERT_TRUE(checkpoint.write(m_path));
+
+        FILE *file = fopen(m_path.c_str(), "r+b");
+        ASSERT_NE(file, nullptr);
+        uint32_t version = WARM_CHECKPOINT_VERSION + 1;
+        fseek(file, sizeof(uint32_t), SEEK_SET);
+        fwrite(&version, sizeof(version), 1, file);
+        fclose(file);
+
+        WarmCheckpoint loaded;
+        ASSERT_FALSE(loaded.load(m_path));
+        ASSERT_TRUE(loaded.getObjects().empty());
+
+        ASSERT_FALSE(loaded.load(m_path + ".missing"));
+    }
+
+    TEST_F(WarmCheckpointTest, DigestsConsumerTable)
+    {
+        swss::DBConnector appl_db("APPL_DB", 0);
+        swss::Table table(&appl_db, "CHECKPOINT_TABLE");
+        table.set("key0", { {"f", "v0"} });
+        table.set("key1", { {"f", "v1"} });
+
+        Orch orch(&appl_db, "CHECKPOINT_TABLE");
+        vector<ConsumerBase *> consumers;
+        orch.getRefillConsumers(consumers);
+        ASSERT_EQ(consumers.size(), 1);
+
+        TableDigest digest;
+        ASSERT_TRUE(consumers[0]->digestTable(digest));
+
+        TableDigest expected;
+        expected.add({"key1", SET_COMMAND, { {"f", "v1"} }});
+        expected.add({"key0", SET_COMMAND, { {"f", "v0"} }});
+        ASSERT_EQ(digest.value(), expected.value());
+        ASSERT_EQ(digest.count(), 2);
+    }
+}
@@ -0,0 +1,127 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "warmreplay.h"
+
+namespace warmreplay_test
+{
+    using namespace std;
+
+    /* Consumes its tasks once ready() holds, counts its doTask() runs */
+    class ReplayTestOrch : public Orch
+    {
+    public:
+        ReplayTestOrch(swss::DBConnector *db, string tableName, function<bool()> ready)
+            :Orch(db, tableName), m_tableName(tableName), m_ready(ready)
+        {
+        }
+
+        void doTask(Consumer& consumer)
+        {
+            if (m_ready())
+            {
+                consumer.m_toSync.clear();
+            }
+        }
+
+        void add(size_t count)
+        {
+            std::deque<KeyOpFieldsValuesTuple> entries;
+            for (size_t i = 0; i < count; i++)
+            {
+                entries.push_back({"key" + to_string(i), SET_COMMAND, { {"f", "v"} }});
+            }
+            getConsumer(m_tableName)->addToSync(entries);
+        }
+
+        string m_tableName;
+        function<bool()> m_ready;
+    };
+
+    struct WarmReplayTest : public ::testing::Test
+    {
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+        }
+
+        virtual void TearDown() override
+        {
+            ::testing_db::reset();
+        }
+    };
+
+    TEST_F(WarmReplayTest, RunsUntilSettled)
+    {
+        swss::DBConnector appl_db("APPL_DB", 0);
+
+        // The first Orch waits on the second one, listed after it
+        ReplayTestOrch *producer = nullptr;
+        ReplayTestOrch consumer(&appl_db, "REPLAY_CONSUMER_TABLE",
+                                [&producer]() { return !producer->hasPendingTasks(); });
+        ReplayTestOrch producerOrch(&appl_db, "REPLAY_PRODUCER_TABLE", []() { return true; });
+        producer = &producerOrch;
+
+        // Never ready, only retried when something changed
+        ReplayTestOrch blocked(&appl_db, "REPLAY_BLOCKED_TABLE", []() { return false; });
+
+        consumer.add(2);
+        producerOrch.add(3);
+        blocked.add(1);
+
+        map<Orch *, size_t> runs;
+        WarmReplay replay({ &consumer, &producerOrch, &blocked });
+        ASSERT_TRUE(replay.run([&runs](Orch *o, size_t round) {
+            runs[o]++;
+            o->doTask();
+        }));
+
+        ASSERT_FALSE(consumer.hasPendingTasks());
+        ASSERT_FALSE(producerOrch.hasPendingTasks());
+        ASSERT_TRUE(blocked.hasPendingTasks());
+
+        // Round 1 runs all, round 2 the two still pending, round 3 nothing
+        ASSERT_EQ(replay.getRounds(), 3);
+        ASSERT_EQ(runs[&consumer], 2);
+        ASSERT_EQ(runs[&producerOrch], 1);
+        ASSERT_EQ(runs[&blocked], 2);
+        ASSERT_EQ(replay.getRuns(), 5);
+    }
+
+    TEST_F(WarmReplayTest, DeclaredDependenciesOnly)
+    {
+        swss::DBConnector appl_db("APPL_DB", 0);
+
+        bool ready = false;
+        ReplayTestOrch waiting(&appl_db, "REPLAY_WAITING_TABLE", [&ready]() { return ready; });
+        ReplayTestOrch unrelated(&appl_db, "REPLAY_UNRELATED_TABLE", []() { return true; });
+        ReplayTestOrch dependency(&appl_db, "REPLAY_DEPENDENCY_TABLE", []() { return true; });
+        waiting.declareDependencies({ &dependency });
+
+        waiting.add(1);
+        unrelated.add(1);
+
+        // Progress of an Orch it does not depend on doesn't run it again
+        WarmReplay replay({ &waiting, &unrelated, &dependency });
+        ASSERT_TRUE(replay.run([](Orch *o, size_t round) { o->doTask(); }));
+        ASSERT_EQ(replay.getRuns(), 3);
+        ASSERT_TRUE(waiting.hasPendingTasks());
+    }
+
+    TEST_F(WarmReplayTest, StopsAtMaxRounds)
+    {
+        swss::DBConnector appl_db("APPL_DB", 0);
+
+        // Consumes one task per run
+        ReplayTestOrch slow(&appl_db, "REPLAY_SLOW_TABLE", []() { return true; });
+        slow.add(10);
+
+        WarmReplay replay({ &slow }, 4);
+        ASSERT_FALSE(replay.run([&slow](Orch *o, size_t round) {
+            auto consumer = slow.getConsumer(slow.m_tableName);
+            consumer->m_toSync.erase(consumer->m_toSync.begin());
+        }));
+        ASSERT_EQ(replay.getRounds(), 4);
+        ASSERT_EQ(slow.getPendingTaskCount(), 6);
+    }
+}
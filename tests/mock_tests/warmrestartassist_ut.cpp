@@ -61,4 +61,36 @@ namespace warmrestartassist_test
         ASSERT_EQ(fvField(fvVector[0]), "field");
         ASSERT_EQ(fvValue(fvVector[0]), "value1");
     }
+
+    TEST_F(WarmrestartassistTest, warmRestartAssistPackedCache)
+    {
+        Table testTable = Table(m_app_db.get(), APP_WRA_TEST_TABLE_NAME);
+        testTable.set("same", { {"nexthop", "10.0.0.1,10.0.0.3"}, {"ifname", "Ethernet0,Ethernet4"} });
+        testTable.set("stale", { {"nexthop", "10.0.0.5"}, {"ifname", "Ethernet8"} });
+
+        appRestartAssist->readTablesToMap();
+
+        // Field names are interned once for all entries
+        ASSERT_EQ(appRestartAssist->m_fieldNames.size(), 3);
+        auto &cache = appRestartAssist->appTableCacheMap[APP_WRA_TEST_TABLE_NAME];
+        vector<FieldValueTuple> fvVector = { {"nexthop", "10.0.0.1,10.0.0.3"}, {"ifname", "Ethernet0,Ethernet4"} };
+        ASSERT_EQ(appRestartAssist->unpackFieldValues(cache["same"].fieldValues), fvVector);
+
+        appRestartAssist->insertToMap(APP_WRA_TEST_TABLE_NAME, "same", fvVector, false);
+        ASSERT_EQ(cache["same"].state, AppRestartAssist::SAME);
+
+        fvVector = { {"nexthop", string(200, 'x')} };
+        appRestartAssist->insertToMap(APP_WRA_TEST_TABLE_NAME, "new", fvVector, false);
+        ASSERT_EQ(appRestartAssist->unpackFieldValues(cache["new"].fieldValues), fvVector);
+
+        appRestartAssist->reconcile();
+        ASSERT_TRUE(appRestartAssist->appTableCacheMap.empty());
+        ASSERT_TRUE(appRestartAssist->m_fieldNames.empty());
+
+        vector<FieldValueTuple> values;
+        ASSERT_TRUE(testTable.get("same", values));
+        ASSERT_FALSE(testTable.get("stale", values));
+        ASSERT_TRUE(testTable.get("new", values));
+        ASSERT_EQ(fvValue(values[0]), string(200, 'x'));
+    }
 }
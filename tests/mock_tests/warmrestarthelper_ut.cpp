@@ -103,4 +103,77 @@ namespace wrhelper_test
         m_routeTable->hget("1.2.0.0/24", "protocol", val);
         ASSERT_EQ(val, "kernel");
     }
+
+    TEST_F(WRHelperTest, testReconciliationByDigest)
+    {
+        wrHelper->setState(WarmStart::INITIALIZED);
+
+        /* Old-life entries */
+        m_routeTable->set("1.0.0.0/24",
+                        {
+                            {"ifname", "eth1,eth2"},
+                            {"nexthop", "2.0.0.1,2.0.0.2"}
+                        });
+        m_routeTable->set("1.1.0.0/24",
+                        {
+                            {"ifname", "eth1"},
+                            {"nexthop", "2.1.0.0"}
+                        });
+        m_routeTable->set("1.2.0.0/24",
+                        {
+                            {"ifname", "eth1"},
+                            {"nexthop", "2.2.0.0"}
+                        });
+        ASSERT_TRUE(wrHelper->runRestoration());
+
+        /* Same content, in another order */
+        wrHelper->insertRefreshMap({
+                                    "1.0.0.0/24",
+                                    "SET",
+                                    {
+                                        {"nexthop", "2.0.0.2,2.0.0.1"},
+                                        {"ifname", "eth2,eth1"}
+                                    }
+                                });
+        /* Changed, then changed back to the restored content */
+        wrHelper->insertRefreshMap({
+                                    "1.1.0.0/24",
+                                    "SET",
+                                    {
+                                        {"ifname", "eth1"},
+                                        {"nexthop", "2.1.0.1"}
+                                    }
+                                });
+        wrHelper->insertRefreshMap({
+                                    "1.1.0.0/24",
+                                    "SET",
+                                    {
+                                        {"ifname", "eth1"},
+                                        {"nexthop", "2.1.0.0"}
+                                    }
+                                });
+        /* 1.2.0.0/24 is stale, 1.3.0.0/24 is new */
+        wrHelper->insertRefreshMap({
+                                    "1.3.0.0/24",
+                                    "SET",
+                                    {
+                                        {"ifname", "eth1"},
+                                        {"nexthop", "2.3.0.0"}
+                                    }
+                                });
+        wrHelper->reconcile();
+        ASSERT_EQ(wrHelper->getState(), WarmStart::RECONCILED);
+
+        /* Unchanged entries are not rewritten */
+        std::string val;
+        ASSERT_TRUE(m_routeTable->hget("1.0.0.0/24", "nexthop", val));
+        ASSERT_EQ(val, "2.0.0.1,2.0.0.2");
+        ASSERT_TRUE(m_routeTable->hget("1.1.0.0/24", "nexthop", val));
+        ASSERT_EQ(val, "2.1.0.0");
+
+        std::vector<swss::FieldValueTuple> fvs;
+        ASSERT_FALSE(m_routeTable->get("1.2.0.0/24", fvs));
+        ASSERT_TRUE(m_routeTable->hget("1.3.0.0/24", "nexthop", val));
+        ASSERT_EQ(val, "2.3.0.0");
+    }
 }
@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+#include "wpactrl.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <string.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace wpactrl_test
+{
+    using namespace std;
+
+    /* A control socket answering like wpa_supplicant, PONG to PING and OK to the rest */
+    struct WpaCtrlTest : public ::testing::Test
+    {
+        string m_path;
+        int m_fd = -1;
+        thread m_server;
+        atomic<int> m_requests{0};
+
+        virtual void SetUp() override
+        {
+            m_path = "/tmp/wpactrl_ut_" + to_string(getpid());
+            unlink(m_path.c_str());
+
+            m_fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+            ASSERT_GE(m_fd, 0);
+            struct sockaddr_un addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sun_family = AF_UNIX;
+            strncpy(addr.sun_path, m_path.c_str(), sizeof(addr.sun_path) - 1);
+            ASSERT_EQ(::bind(m_fd, (struct sockaddr *)&addr, sizeof(addr)), 0);
+
+            m_server = thread([this]() {
+                char buf[256];
+                struct sockaddr_un from;
+                socklen_t fromlen = sizeof(from);
+                ssize_t len;
+                while ((len = recvfrom(m_fd, buf, sizeof(buf), 0, (struct sockaddr *)&from, &fromlen)) > 0)
+                {
+                    string cmd(buf, static_cast<size_t>(len));
+                    if (cmd == "QUIT")
+                    {
+                        break;
+                    }
+                    m_requests++;
+                    // An event ahead of the reply must be skipped by the client
+                    string event = "<3>CTRL-EVENT-TEST";
+                    sendto(m_fd, event.data(), event.size(), 0, (struct sockaddr *)&from, fromlen);
+                    string reply = cmd == "PING" ? "PONG\n" : "OK " + cmd + "\n";
+                    sendto(m_fd, reply.data(), reply.size(), 0, (struct sockaddr *)&from, fromlen);
+                    fromlen = sizeof(from);
+                }
+            });
+        }
+
+        virtual void TearDown() override
+        {
+            int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+            struct sockaddr_un addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sun_family = AF_UNIX;
+            strncpy(addr.sun_path, m_path.c_str(), sizeof(addr.sun_path) - 1);
+            sendto(fd, "QUIT", 4, 0, (struct sockaddr *)&addr, sizeof(addr));
+            ::close(fd);
+            m_server.join();
+            ::close(m_fd);
+            unlink(m_path.c_str());
+        }
+    };
+
+    TEST_F(WpaCtrlTest, ConnectFailsWithoutServer)
+    {
+        swss::WpaCtrl ctrl(m_path + "_missing");
+        ASSERT_FALSE(ctrl.connect());
+        ASSERT_THROW(ctrl.request("PING"), runtime_error);
+    }
+
+    TEST_F(WpaCtrlTest, RequestKeepsConnection)
+    {
+        swss::WpaCtrl ctrl(m_path);
+        ASSERT_EQ(ctrl.request("PING"), "PONG\n");
+        ASSERT_TRUE(ctrl.isConnected());
+        ASSERT_EQ(ctrl.request("IFNAME=Ethernet0 add_network"), "OK IFNAME=Ethernet0 add_network\n");
+        ASSERT_EQ(m_requests.load(), 2);
+    }
+
+    TEST_F(WpaCtrlTest, PipelinedRepliesInOrder)
+    {
+        swss::WpaCtrl ctrl(m_path);
+        vector<string> cmds;
+        for (size_t i = 0; i < 4 * swss::WpaCtrl::MAX_INFLIGHT + 1; i++)
+        {
+            cmds.push_back("IFNAME=Ethernet0 set_network 0 mka_priority " + to_string(i));
+        }
+
+        auto replies = ctrl.request(cmds);
+        ASSERT_EQ(replies.size(), cmds.size());
+        for (size_t i = 0; i < cmds.size(); i++)
+        {
+            ASSERT_EQ(replies[i], "OK " + cmds[i] + "\n");
+        }
+        ASSERT_EQ(m_requests.load(), static_cast<int>(cmds.size()));
+    }
+}
@@ -339,3 +339,126 @@ TEST(swssrec, signalSafeStatsDumpFormatsOutput)
     EXPECT_NE(output.find("enqueued=1"), string::npos);
     EXPECT_NE(output.find("drained=1"), string::npos);
 }
+
+TEST(swssrec, binaryRecordDecodesToTextLines)
+{
+    char dir_template[] = "/tmp/swss-recorder-ut-XXXXXX";
+    auto dir = mkdtemp(dir_template);
+    ASSERT_NE(dir, nullptr);
+
+    const string dirname(dir);
+    const string filename = "swss-binary.rec";
+    const string fullpath = dirname + "/" + filename;
+    const string prefix = "TEST_TABLE:";
+
+    {
+        SwSSRec recorder;
+        recorder.setRecord(true);
+        recorder.setLocation(dirname);
+        recorder.setFileName(filename);
+        recorder.setBinary(true);
+        recorder.startRec(true);
+
+        deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back(KeyOpFieldsValuesTuple(
+            { "bin-key-0",
+              SET_COMMAND,
+              { { "field1", "value1" }, { "field2", "value2" } } }));
+        entries.push_back(KeyOpFieldsValuesTuple(
+            { "bin-key-1",
+              DEL_COMMAND,
+              {} }));
+        recorder.recordTuplesAsync(prefix, entries);
+
+        // A rotated file starts with its own header and names
+        recorder.setRotate(true);
+        recorder.setAsync(true);
+        recorder.recordTupleAsync(prefix, KeyOpFieldsValuesTuple(
+            { "bin-key-2",
+              SET_COMMAND,
+              { { "field1", "value3" } } }));
+        waitForRecorderStats(recorder, 1, 1);
+        recorder.record("free text");
+    }
+
+    ifstream ifs(fullpath, ios::binary);
+    RecBinaryReader reader(ifs);
+    ASSERT_TRUE(reader.begin());
+
+    vector<string> lines;
+    string line;
+    while (reader.next(line))
+    {
+        lines.push_back(line);
+    }
+    EXPECT_TRUE(reader.complete());
+
+    ASSERT_EQ(lines.size(), 5u);
+    EXPECT_NE(lines[0].find("|recording started"), string::npos);
+    EXPECT_NE(lines[1].find("|TEST_TABLE:bin-key-0|SET|field1:value1|field2:value2"), string::npos);
+    EXPECT_NE(lines[2].find("|TEST_TABLE:bin-key-1|DEL"), string::npos);
+    EXPECT_NE(lines[3].find("|TEST_TABLE:bin-key-2|SET|field1:value3"), string::npos);
+    EXPECT_NE(lines[4].find("|free text"), string::npos);
+
+    ASSERT_EQ(remove(fullpath.c_str()), 0);
+    ASSERT_EQ(rmdir(dirname.c_str()), 0);
+}
+
+TEST(recorder, flightRecorderKeepsLastRecordsUntilDumped)
+{
+    char dir_template[] = "/tmp/swss-recorder-ut-XXXXXX";
+    auto dir = mkdtemp(dir_template);
+    ASSERT_NE(dir, nullptr);
+
+    const string dirname(dir);
+    const string filename = "flight.rec";
+    const string fullpath = dirname + "/" + filename;
+
+    auto readLines = [&fullpath]() {
+        ifstream ifs(fullpath);
+        vector<string> lines;
+        string line;
+        while (getline(ifs, line))
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    };
+
+    {
+        RecWriter writer;
+        writer.setRecord(true);
+        writer.setLocation(dirname);
+        writer.setFileName(filename);
+        writer.setFlightRecorder(256);
+        writer.startRec(true);
+
+        for (int i = 0; i < 100; i++)
+        {
+            writer.record("ts", "TEST_TABLE:key" + to_string(i) + "|SET|field:value");
+        }
+        EXPECT_TRUE(readLines().empty());
+
+        writer.dumpFlightRecorder("test");
+        auto lines = readLines();
+        ASSERT_GE(lines.size(), 3u);
+        EXPECT_NE(lines[0].find("|flight recorder dump: test"), string::npos);
+        // Only complete lines, ending with the last record
+        for (size_t i = 1; i < lines.size(); i++)
+        {
+            EXPECT_EQ(lines[i].find("ts|TEST_TABLE:key"), 0u);
+        }
+        EXPECT_EQ(lines.back(), "ts|TEST_TABLE:key99|SET|field:value");
+
+        // The ring is empty after a dump
+        writer.record("ts", "TEST_TABLE:after|SET|field:value");
+        writer.dumpFlightRecorderSignalSafe(SIGABRT);
+        auto more = readLines();
+        ASSERT_EQ(more.size(), lines.size() + 2);
+        EXPECT_EQ(more[lines.size()], "flight recorder dump: fatal signal " + to_string(SIGABRT));
+        EXPECT_EQ(more.back(), "ts|TEST_TABLE:after|SET|field:value");
+    }
+
+    ASSERT_EQ(remove(fullpath.c_str()), 0);
+    ASSERT_EQ(rmdir(dirname.c_str()), 0);
+}
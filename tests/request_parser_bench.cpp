@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "macaddress.h"
+#include "orch.h"
+#include "request_parser.h"
+
+using namespace swss;
+
+/*
+ * Heap allocations of the whole test binary, to check that a warmed up
+ * parser does not allocate.
+ */
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace request_parser_bench
+{
+    const request_description_t bench_description = {
+        { REQ_T_STRING, REQ_T_MAC_ADDRESS, REQ_T_STRING },
+        {
+            { "v4",            REQ_T_BOOL },
+            { "v6",            REQ_T_BOOL },
+            { "src_mac",       REQ_T_MAC_ADDRESS },
+            { "ttl_action",    REQ_T_PACKET_ACTION },
+            { "ip_opt_action", REQ_T_PACKET_ACTION },
+            { "l3_mc_action",  REQ_T_PACKET_ACTION },
+            { "just_string",   REQ_T_STRING },
+            { "vlan",          REQ_T_VLAN },
+            { "nlist",         REQ_T_SET },
+        },
+        { "just_string" }
+    };
+
+    class BenchRequest : public Request
+    {
+    public:
+        BenchRequest() : Request(bench_description, '|') { }
+    };
+
+    /*
+     * The parser as it was before the compiled schema: one hash map per value
+     * type filled for every request and freed by clear(). Reduced to the
+     * types of the benchmark cases.
+     */
+    class MapRequest
+    {
+    public:
+        void parse(const KeyOpFieldsValuesTuple& request)
+        {
+            operation_ = kfvOp(request);
+            full_key_ = kfvKey(request);
+
+            std::vector<std::string> key_items;
+            size_t start = 0;
+            size_t end = full_key_.find('|');
+            while (end != std::string::npos)
+            {
+                key_items.push_back(full_key_.substr(start, end - start));
+                start = end + 1;
+                end = full_key_.find('|', start);
+            }
+            key_items.push_back(full_key_.substr(start, full_key_.length()));
+
+            for (int i = 0; i < static_cast<int>(key_items.size()); i++)
+            {
+                if (bench_description.key_item_types[i] == REQ_T_MAC_ADDRESS)
+                {
+                    key_item_mac_addresses_[i] = MacAddress(key_items[i]);
+                }
+                else
+                {
+                    key_item_strings_[i] = key_items[i];
+                }
+            }
+
+            for (const auto& fv: kfvFieldsValues(request))
+            {
+                const auto item = bench_description.attr_item_types.find(fvField(fv));
+                attr_names_.insert(fvField(fv));
+                switch (item->second)
+                {
+                    case REQ_T_STRING:
+                        attr_item_strings_[fvField(fv)] = fvValue(fv);
+                        break;
+                    case REQ_T_BOOL:
+                        attr_item_bools_[fvField(fv)] = fvValue(fv) == "true";
+                        break;
+                    case REQ_T_MAC_ADDRESS:
+                        attr_item_mac_addresses_[fvField(fv)] = MacAddress(fvValue(fv));
+                        break;
+                    case REQ_T_PACKET_ACTION:
+                    {
+                        std::unordered_map<std::string, sai_packet_action_t> m = {
+                            {"drop", SAI_PACKET_ACTION_DROP},
+                            {"copy", SAI_PACKET_ACTION_COPY},
+                            {"log", SAI_PACKET_ACTION_LOG},
+                        };
+                        attr_item_packet_actions_[fvField(fv)] = m[fvValue(fv)];
+                        break;
+                    }
+                    case REQ_T_VLAN:
+                        attr_item_vlan_[fvField(fv)] = static_cast<uint16_t>(std::stoul(fvValue(fv).substr(4)));
+                        break;
+                    case REQ_T_SET:
+                    {
+                        std::set<std::string> str_set;
+                        std::string substr;
+                        std::istringstream iss(fvValue(fv));
+                        while (getline(iss, substr, ','))
+                        {
+                            str_set.insert(substr);
+                        }
+                        attr_item_set_[fvField(fv)] = str_set;
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+        }
+
+        void clear()
+        {
+            operation_.clear();
+            full_key_.clear();
+            attr_names_.clear();
+            key_item_strings_.clear();
+            key_item_mac_addresses_.clear();
+            attr_item_strings_.clear();
+            attr_item_bools_.clear();
+            attr_item_mac_addresses_.clear();
+            attr_item_packet_actions_.clear();
+            attr_item_vlan_.clear();
+            attr_item_set_.clear();
+        }
+
+    private:
+        std::string operation_;
+        std::string full_key_;
+        std::unordered_map<int, std::string> key_item_strings_;
+        std::unordered_map<int, MacAddress> key_item_mac_addresses_;
+        std::unordered_set<std::string> attr_names_;
+        std::unordered_map<std::string, std::string> attr_item_strings_;
+        std::unordered_map<std::string, bool> attr_item_bools_;
+        std::unordered_map<std::string, MacAddress> attr_item_mac_addresses_;
+        std::unordered_map<std::string, sai_packet_action_t> attr_item_packet_actions_;
+        std::unordered_map<std::string, uint16_t> attr_item_vlan_;
+        std::unordered_map<std::string, std::set<std::string>> attr_item_set_;
+    };
+
+    // The SET and DEL cases of request_parser_ut.cpp, on a single schema
+    static const std::vector<KeyOpFieldsValuesTuple> bench_cases = {
+        {"key1|02:03:04:05:06:07|key2", "SET",
+            {
+                { "v4", "false" },
+                { "v6", "false" },
+                { "src_mac", "02:03:04:05:06:07" },
+                { "ttl_action", "copy" },
+                { "ip_opt_action", "drop" },
+                { "l3_mc_action", "log" },
+                { "just_string", "test_string" },
+                { "vlan", "Vlan50" },
+            }
+        },
+        {"key3|f2:f3:f4:f5:f6:f7|key4", "SET",
+            {
+                { "v4", "true" },
+                { "src_mac", "f2:f3:f4:f5:f6:f7" },
+                { "ttl_action", "log" },
+                { "ip_opt_action", "copy" },
+                { "l3_mc_action", "log" },
+                { "just_string", "string" },
+                { "vlan", "Vlan1024" },
+            }
+        },
+        {"key5|52:53:54:55:56:57|key6", "DEL",
+            {
+            }
+        },
+    };
+
+    static const KeyOpFieldsValuesTuple set_case {"key1|02:03:04:05:06:07|key2", "SET",
+        {
+            { "just_string", "test_string" },
+            { "nlist", "name1,name2" },
+        }
+    };
+
+    template <typename R>
+    static double nsecPerRequest(R& request, const std::vector<KeyOpFieldsValuesTuple>& cases, size_t rounds)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rounds; r++)
+        {
+            for (const auto& t: cases)
+            {
+                request.parse(t);
+                request.clear();
+            }
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+            / static_cast<double>(rounds * cases.size());
+    }
+
+    template <typename R>
+    static double allocationsPerRequest(R& request, const std::vector<KeyOpFieldsValuesTuple>& cases, size_t rounds)
+    {
+        // Warm up the reusable storage first
+        nsecPerRequest(request, cases, 1);
+
+        uint64_t before = g_allocations.load();
+        nsecPerRequest(request, cases, rounds);
+
+        return static_cast<double>(g_allocations.load() - before) / static_cast<double>(rounds * cases.size());
+    }
+
+    TEST(request_parser_bench, warmParserDoesNotAllocate)
+    {
+        BenchRequest request;
+
+        EXPECT_EQ(allocationsPerRequest(request, bench_cases, 100), 0);
+    }
+
+    TEST(request_parser_bench, attrsDoNotLeakIntoNextRequest)
+    {
+        BenchRequest request;
+
+        request.parse(bench_cases[0]);
+        request.clear();
+        request.parse(bench_cases[1]);
+
+        EXPECT_EQ(request.getAttrFieldNames().count("v6"), 0);
+        EXPECT_THROW(request.getAttrBool("v6"), std::out_of_range);
+        EXPECT_THROW(request.getAttrString("v4"), std::out_of_range);
+        EXPECT_THROW(request.getKeyString(1), std::out_of_range);
+        EXPECT_EQ(request.getAttrVlan("vlan"), 1024);
+    }
+
+    // Run with --gtest_also_run_disabled_tests
+    TEST(request_parser_bench, DISABLED_compiledSchemaVsMaps)
+    {
+        const size_t rounds = 200000;
+        const std::vector<KeyOpFieldsValuesTuple> set_cases = { set_case };
+
+        BenchRequest compiled;
+        MapRequest maps;
+
+        std::cout << "map parser:      " << nsecPerRequest(maps, bench_cases, rounds) << " ns/request, "
+                  << allocationsPerRequest(maps, bench_cases, 1000) << " allocations/request" << std::endl;
+        std::cout << "compiled schema: " << nsecPerRequest(compiled, bench_cases, rounds) << " ns/request, "
+                  << allocationsPerRequest(compiled, bench_cases, 1000) << " allocations/request" << std::endl;
+        std::cout << "map parser, set attribute:      " << nsecPerRequest(maps, set_cases, rounds) << " ns/request" << std::endl;
+        std::cout << "compiled schema, set attribute: " << nsecPerRequest(compiled, set_cases, rounds) << " ns/request" << std::endl;
+    }
+}
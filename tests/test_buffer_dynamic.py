@@ -438,6 +438,58 @@ class TestBufferMgrDyn(object):
 
         self.cleanup_db(dvs)
 
+    def check_headroom_by_lua(self, dvs, profile, speed, cable_length, mtu='9100'):
+        # The headroom buffermgrd calculated natively should be identical to the output of the lua plugin
+        lane_count = len(self.config_db.get_entry('PORT', 'Ethernet0')['lanes'].split(','))
+        _, output = dvs.runcmd("redis-cli --eval /usr/share/swss/buffer_headroom_vs.lua {} , {} {} {} 0 {}".format(
+                               profile, speed, cable_length, mtu, lane_count))
+        expected = dict(re.findall('(xon|xoff|size):([0-9]+)', output))
+        fvs = self.app_db.wait_for_entry("BUFFER_PROFILE_TABLE", profile)
+        for field in ['xon', 'xoff', 'size']:
+            assert fvs[field] == expected[field], \
+                "{} of {} is {} but the lua plugin calculates {}".format(field, profile, fvs[field], expected[field])
+        return fvs
+
+    def test_headroomNativeMatchesLua(self, dvs, testlog):
+        self.setup_db(dvs)
+
+        # Startup interface
+        dvs.port_admin_set('Ethernet0', 'up')
+
+        original_traffic_pattern = self.config_db.get_entry('LOSSLESS_TRAFFIC_PATTERN', 'AZURE')
+        expectedProfile = self.make_lossless_profile_name(self.originalSpeed, self.originalCableLen)
+
+        try:
+            # configure lossless PG 3-4 on interface
+            self.config_db.update_entry('BUFFER_PG', 'Ethernet0|3-4', {'profile': 'NULL'})
+            self.app_db.wait_for_field_match("BUFFER_PG_TABLE", "Ethernet0:3-4", {"profile": expectedProfile})
+            original_fvs = self.check_headroom_by_lua(dvs, expectedProfile, self.originalSpeed, self.originalCableLen)
+
+            # remove the PG so that the profile is removed as well
+            self.config_db.delete_entry('BUFFER_PG', 'Ethernet0|3-4')
+            self.app_db.wait_for_deleted_entry("BUFFER_PROFILE_TABLE", expectedProfile)
+
+            # the headroom memoized with the old traffic pattern should not be reused
+            traffic_pattern = dict(original_traffic_pattern)
+            traffic_pattern['small_packet_percentage'] = '50'
+            self.config_db.update_entry('LOSSLESS_TRAFFIC_PATTERN', 'AZURE', traffic_pattern)
+            time.sleep(2)
+
+            self.config_db.update_entry('BUFFER_PG', 'Ethernet0|3-4', {'profile': 'NULL'})
+            self.app_db.wait_for_field_match("BUFFER_PG_TABLE", "Ethernet0:3-4", {"profile": expectedProfile})
+            fvs = self.check_headroom_by_lua(dvs, expectedProfile, self.originalSpeed, self.originalCableLen)
+            assert fvs['xoff'] != original_fvs['xoff']
+        finally:
+            # clear configuration
+            self.config_db.delete_entry('BUFFER_PG', 'Ethernet0|3-4')
+            self.app_db.wait_for_deleted_entry("BUFFER_PROFILE_TABLE", expectedProfile)
+            self.config_db.update_entry('LOSSLESS_TRAFFIC_PATTERN', 'AZURE', original_traffic_pattern)
+
+            # Shutdown interface
+            dvs.port_admin_set('Ethernet0', 'down')
+
+            self.cleanup_db(dvs)
+
     def test_nonDefaultAlpha(self, dvs, testlog):
         self.setup_db(dvs)
 
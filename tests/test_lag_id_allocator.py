@@ -0,0 +1,99 @@
+import os
+import redis
+
+from swsscommon import swsscommon
+
+LAG_IDS_LUA = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "orchagent", "lagids.lua")
+
+
+class TestLagIdAllocator(object):
+    """Runs the system lag id allocator script against a scratch database.
+
+    The script is what the lag id allocator of orchagent runs in the chassis app db,
+    here it runs in an otherwise unused database of the dvs redis.
+    """
+
+    def init_lag_ids(self, dvs, start, end):
+        self.r = redis.Redis(unix_socket_path=dvs.redis_sock, db=swsscommon.CHASSIS_APP_DB,
+                             encoding="utf-8", decode_responses=True)
+        self.r.flushdb()
+        self.r.set("SYSTEM_LAG_ID_START", str(start))
+        self.r.set("SYSTEM_LAG_ID_END", str(end))
+        for lag_id in range(start, end + 1):
+            self.r.rpush("SYSTEM_LAG_IDS_FREE_LIST", str(lag_id))
+
+        with open(LAG_IDS_LUA) as f:
+            self.script = self.r.register_script(f.read())
+
+    def run(self, *args):
+        return self.script(keys=[], args=list(args))
+
+    def check_lag_ids(self, expected):
+        assert self.r.hgetall("SYSTEM_LAG_ID_TABLE") == {k: str(v) for k, v in expected.items()}
+        assert self.r.smembers("SYSTEM_LAG_ID_SET") == {str(v) for v in expected.values()}
+
+    def test_LagIdAllocation(self, dvs, testlog):
+        self.init_lag_ids(dvs, 1, 4)
+
+        # One run allocates the ids of all the lags, in free list order
+        assert self.run("add_bulk", "PortChannel1", "PortChannel2") == ["PortChannel1:1", "PortChannel2:2"]
+        # A proposed id is used when it is free
+        assert self.run("add", "PortChannel3", "4") == 4
+        self.check_lag_ids({"PortChannel1": 1, "PortChannel2": 2, "PortChannel3": 4})
+        assert self.r.lrange("SYSTEM_LAG_IDS_FREE_LIST", 0, -1) == ["3"]
+
+        # Lags which already have an id keep it
+        assert self.run("add", "PortChannel1", "0") == 1
+        assert self.run("add_bulk", "PortChannel2", "PortChannel3") == ["PortChannel2:2", "PortChannel3:4"]
+        assert self.run("get", "PortChannel2") == 2
+        assert self.run("get", "PortChannel4") == -2
+        self.check_lag_ids({"PortChannel1": 1, "PortChannel2": 2, "PortChannel3": 4})
+
+        self.r.flushdb()
+
+    def test_LagIdReleaseAndReuse(self, dvs, testlog):
+        self.init_lag_ids(dvs, 1, 2)
+
+        assert self.run("add_bulk", "PortChannel1", "PortChannel2") == ["PortChannel1:1", "PortChannel2:2"]
+
+        # A released id goes back to the free list, once
+        assert self.run("del", "PortChannel1") == 1
+        assert self.run("del", "PortChannel1") == 0
+        assert self.r.lrange("SYSTEM_LAG_IDS_FREE_LIST", 0, -1) == ["1"]
+        self.check_lag_ids({"PortChannel2": 2})
+
+        # and is given to the next lag
+        assert self.run("add_bulk", "PortChannel3") == ["PortChannel3:1"]
+        self.check_lag_ids({"PortChannel2": 2, "PortChannel3": 1})
+        assert self.r.llen("SYSTEM_LAG_IDS_FREE_LIST") == 0
+
+        self.r.flushdb()
+
+    def test_LagIdExhaustion(self, dvs, testlog):
+        self.init_lag_ids(dvs, 1, 2)
+
+        # The lags beyond the capacity get no id, the others are allocated in the same run
+        assert self.run("add_bulk", "PortChannel1", "PortChannel2", "PortChannel3") == \
+            ["PortChannel1:1", "PortChannel2:2", "PortChannel3:-1"]
+        assert self.run("add", "PortChannel4", "0") == -1
+        self.check_lag_ids({"PortChannel1": 1, "PortChannel2": 2})
+
+        # An id in use is not given out again, even if it is left in the free list
+        self.r.rpush("SYSTEM_LAG_IDS_FREE_LIST", "2")
+        assert self.run("add", "PortChannel4", "0") == -1
+        self.check_lag_ids({"PortChannel1": 1, "PortChannel2": 2})
+
+        # Releasing an id makes room again
+        assert self.run("del", "PortChannel2") == 2
+        assert self.run("add_bulk", "PortChannel3", "PortChannel4") == ["PortChannel3:2", "PortChannel4:-1"]
+        self.check_lag_ids({"PortChannel1": 1, "PortChannel3": 2})
+
+        assert self.run("bad_op", "PortChannel1") == -3
+
+        self.r.flushdb()
+
+
+# Add Dummy always-pass test at end as workaroud
+# for issue when Flaky fail on final test it invokes module tear-down before retrying
+def test_nonflaky_dummy():
+    pass
@@ -3576,6 +3576,96 @@ class TestVnetOrch(object):
         self.set_admin_status("Ethernet4", "down")
 
 
+    '''
+    Test 37 - Test for next hop groups shared by routes, on BFD state change and route removal
+    '''
+    def test_vnet_orch_37(self, dvs, testlog):
+        vnet_obj = self.get_vnet_obj()
+        tunnel_name = 'tunnel_37'
+        asic_db = swsscommon.DBConnector(swsscommon.ASIC_DB, dvs.redis_sock, 0)
+
+        vnet_obj.fetch_exist_entries(dvs)
+
+        create_vxlan_tunnel(dvs, tunnel_name, '37.37.37.37')
+        create_vnet_entry(dvs, 'Vnet37', tunnel_name, '10037', "")
+
+        vnet_obj.check_vnet_entry(dvs, 'Vnet37')
+        vnet_obj.check_vxlan_tunnel_entry(dvs, tunnel_name, 'Vnet37', '10037')
+
+        vnet_obj.check_vxlan_tunnel(dvs, tunnel_name, '37.37.37.37')
+
+        vnet_obj.fetch_exist_entries(dvs)
+        create_vnet_routes(dvs, "100.100.1.1/32", 'Vnet37', '37.0.0.1,37.0.0.2', ep_monitor='37.1.0.1,37.1.0.2')
+        update_bfd_session_state(dvs, '37.1.0.1', 'Up')
+        update_bfd_session_state(dvs, '37.1.0.2', 'Up')
+        time.sleep(2)
+        route1, nhg1 = vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.1', '37.0.0.2'], tunnel_name)
+        nhg_count = how_many_entries_exist(asic_db, vnet_obj.ASIC_NEXT_HOP_GROUP)
+
+        # A route with the same endpoints shares the next hop group
+        create_vnet_routes(dvs, "100.100.2.1/32", 'Vnet37', '37.0.0.1,37.0.0.2', ep_monitor='37.1.0.1,37.1.0.2')
+        time.sleep(2)
+        route2, _ = vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.1', '37.0.0.2'], tunnel_name, nhg=nhg1)
+        check_state_db_routes(dvs, 'Vnet37', "100.100.2.1/32", ['37.0.0.1', '37.0.0.2'])
+        assert how_many_entries_exist(asic_db, vnet_obj.ASIC_NEXT_HOP_GROUP) == nhg_count
+
+        # A route with an overlapping endpoint set gets a group of its own
+        create_vnet_routes(dvs, "100.100.3.1/32", 'Vnet37', '37.0.0.1,37.0.0.3', ep_monitor='37.1.0.1,37.1.0.3')
+        update_bfd_session_state(dvs, '37.1.0.3', 'Up')
+        time.sleep(2)
+        route3, nhg3 = vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.1', '37.0.0.3'], tunnel_name)
+        assert nhg3 != nhg1
+
+        # An endpoint going down leaves every group it is in, the routes keep their group
+        update_bfd_session_state(dvs, '37.1.0.1', 'Down')
+        time.sleep(2)
+        vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.2'], tunnel_name, route_ids=route1, nhg=nhg1)
+        vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.2'], tunnel_name, route_ids=route2, nhg=nhg1)
+        vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.3'], tunnel_name, route_ids=route3, nhg=nhg3)
+        check_state_db_routes(dvs, 'Vnet37', "100.100.1.1/32", ['37.0.0.2'])
+        check_state_db_routes(dvs, 'Vnet37', "100.100.2.1/32", ['37.0.0.2'])
+        check_state_db_routes(dvs, 'Vnet37', "100.100.3.1/32", ['37.0.0.3'])
+
+        # and joins them all again once it is back up
+        update_bfd_session_state(dvs, '37.1.0.1', 'Up')
+        time.sleep(2)
+        vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.1', '37.0.0.2'], tunnel_name, route_ids=route1, nhg=nhg1)
+        vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.1', '37.0.0.2'], tunnel_name, route_ids=route2, nhg=nhg1)
+        vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.1', '37.0.0.3'], tunnel_name, route_ids=route3, nhg=nhg3)
+
+        # The shared group stays as long as one of its routes does
+        delete_vnet_routes(dvs, "100.100.1.1/32", 'Vnet37')
+        vnet_obj.check_del_vnet_routes(dvs, 'Vnet37', ["100.100.1.1/32"])
+        check_remove_state_db_routes(dvs, 'Vnet37', "100.100.1.1/32")
+        vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.1', '37.0.0.2'], tunnel_name, route_ids=route2, nhg=nhg1)
+
+        delete_vnet_routes(dvs, "100.100.2.1/32", 'Vnet37')
+        vnet_obj.check_del_vnet_routes(dvs, 'Vnet37', ["100.100.2.1/32"])
+        check_remove_state_db_routes(dvs, 'Vnet37', "100.100.2.1/32")
+        vnet_obj.fetch_exist_entries(dvs)
+        assert nhg1 not in vnet_obj.nhgs
+        check_del_bfd_session(dvs, ['37.1.0.2'])
+
+        # A flap after the shared group is gone only updates the remaining group
+        update_bfd_session_state(dvs, '37.1.0.1', 'Down')
+        time.sleep(2)
+        vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.3'], tunnel_name, route_ids=route3, nhg=nhg3)
+        update_bfd_session_state(dvs, '37.1.0.1', 'Up')
+        time.sleep(2)
+        vnet_obj.check_vnet_ecmp_routes(dvs, 'Vnet37', ['37.0.0.1', '37.0.0.3'], tunnel_name, route_ids=route3, nhg=nhg3)
+        check_state_db_routes(dvs, 'Vnet37', "100.100.3.1/32", ['37.0.0.1', '37.0.0.3'])
+
+        delete_vnet_routes(dvs, "100.100.3.1/32", 'Vnet37')
+        vnet_obj.check_del_vnet_routes(dvs, 'Vnet37', ["100.100.3.1/32"])
+        check_remove_state_db_routes(dvs, 'Vnet37', "100.100.3.1/32")
+        vnet_obj.fetch_exist_entries(dvs)
+        assert nhg3 not in vnet_obj.nhgs
+        check_del_bfd_session(dvs, ['37.1.0.1', '37.1.0.3'])
+
+        delete_vnet_entry(dvs, 'Vnet37')
+        vnet_obj.check_del_vnet_entry(dvs, 'Vnet37')
+        delete_vxlan_tunnel(dvs, tunnel_name)
+
 # Add Dummy always-pass test at end as workaroud
 # for issue when Flaky fail on final test it invokes module tear-down before retrying
 def test_nonflaky_dummy():
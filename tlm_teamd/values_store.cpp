@@ -203,20 +203,42 @@ json_t * ValuesStore::load_json(const std::string & data)
 
 ///
 /// Convert json input from all teamds to the temporary storage
+/// The dump of a LAG which is the same as the last parsed one is not parsed again
 /// @param dumps dumps from all teamds. It is a vector of pairs. Each pair
 ///              has a first element - name of the LAG and a second element
 ///              - json dump
-/// @return temporary storage
+/// @param hashes a reference to the dump hashes of all LAGs in dumps
+/// @param unchanged_lags a reference to the names of the LAGs which dumps weren't parsed
+/// @return temporary storage for the parsed LAGs
 ///
-HashOfRecords ValuesStore::from_json(const std::vector<StringPair> & dumps)
+HashOfRecords ValuesStore::from_json(const std::vector<StringPair> & dumps, DumpHashes & hashes,
+                                     std::unordered_set<std::string> & unchanged_lags)
 {
     HashOfRecords storage;
     for (const auto & p: dumps)
     {
         const auto & lag_name = p.first;
         const auto & json_dump = p.second;
+        const auto hash = std::hash<std::string>()(json_dump);
+        hashes.emplace(lag_name, hash);
+
+        const auto it = m_dump_hashes.find(lag_name);
+        if (it != m_dump_hashes.end() && it->second == hash)
+        {
+            unchanged_lags.insert(lag_name);
+            continue;
+        }
+
         json_t * root = load_json(json_dump);
-        extract_values(lag_name, root, storage);
+        try
+        {
+            extract_values(lag_name, root, storage);
+        }
+        catch (...)
+        {
+            json_decref(root);
+            throw;
+        }
         json_decref(root);
     }
 
@@ -226,17 +248,20 @@ HashOfRecords ValuesStore::from_json(const std::vector<StringPair> & dumps)
 ///
 /// Extract a list of stale keys from the storage.
 /// The stale key is a key which a presented in the storage, but not presented
-/// in the temporary storage. That means that the key must be removed
+/// in the temporary storage, and which LAG dump has changed. That means that the key must be removed
 /// @param storage a reference to the temporary storage
+/// @param unchanged_lags a reference to the names of the LAGs which dumps haven't changed
 /// @return list of stale keys
 ///
-std::vector<std::string> ValuesStore::get_old_keys(const HashOfRecords & storage)
+std::vector<std::string> ValuesStore::get_old_keys(const HashOfRecords & storage,
+                                                   const std::unordered_set<std::string> & unchanged_lags)
 {
     std::vector<std::string> old_keys;
     for (const auto & p: m_storage)
     {
         const auto & db_key = p.first;
-        if (storage.find(db_key) == storage.end())
+        if (storage.find(db_key) == storage.end()
+            && unchanged_lags.find(get_lag_name(db_key)) == unchanged_lags.end())
         {
             old_keys.push_back(db_key);
         }
@@ -270,6 +295,34 @@ StringPair ValuesStore::split_key(const std::string & key)
     return std::make_pair(key.substr(0, sep_pos), key.substr(sep_pos + 1));
 }
 
+///
+/// Extract the LAG name from a full key
+/// For example: LAG_MEMBER_TABLE|lag|port would return "lag"
+/// @param key a database key.
+/// @return the LAG name
+///
+std::string ValuesStore::get_lag_name(const std::string & key)
+{
+    const auto & entry_key = split_key(key).second;
+    return entry_key.substr(0, entry_key.find('|'));
+}
+
+///
+/// Get the pipelined table for table_name
+/// @param table_name a name of the table
+/// @return a reference to the table
+///
+swss::Table & ValuesStore::get_table(const std::string & table_name)
+{
+    auto & table = m_tables[table_name];
+    if (!table)
+    {
+        table.reset(new swss::Table(&m_pipeline, table_name, true));
+    }
+
+    return *table;
+}
+
 ///
 /// Remove keys from the db
 /// @param keys a list of keys to remove
@@ -289,8 +342,7 @@ void ValuesStore::remove_keys_db(const std::vector<std::string> & keys)
         // to connect to teamdctl and if it fails we do not delete State Db entry.
         if (table_name == "LAG_TABLE")
             continue;
-        swss::Table table(m_db, table_name);
-        table.del(table_key);
+        get_table(table_name).del(table_key);
     }
 }
 
@@ -299,68 +351,60 @@ void ValuesStore::remove_keys_db(const std::vector<std::string> & keys)
 /// The update is the following:
 /// 1. For each key in the temporary storage we check that we have that key in the storage
 /// 2. if not, we insert the key and value to the storage
-/// 3. if yes, we check that value of the key is not changed. If the value is changed we
-///    replace that value with the value from the temporary storage
-/// This method returns a list of keys which should be updated in the database
+/// 3. if yes, we check every value of the key. The changed values are replaced
+///    with the values from the temporary storage
+/// This method returns the values which should be updated in the database
 /// @param storage the temporary storage
-/// @retorun a list of keys which must be updated in the storage
+/// @retorun the changed values of every key which must be updated in the db
 ///
-std::vector<std::string> ValuesStore::update_storage(const HashOfRecords & storage)
+HashOfRecords ValuesStore::update_storage(const HashOfRecords & storage)
 {
-    std::vector<std::string> to_update;
+    HashOfRecords changes;
 
     for (const auto & entry_pair: storage)
     {
         const auto & entry_key    = entry_pair.first;
         const auto & entry_values = entry_pair.second;
-        if (m_storage.find(entry_key) == m_storage.end())
+        auto it = m_storage.find(entry_key);
+        if (it == m_storage.end())
         {
             m_storage.emplace(entry_pair);
-            to_update.emplace_back(entry_key);
+            changes.emplace(entry_pair);
         }
         else
         {
-            bool is_changed = false;
             for (const auto & row_pair: entry_values)
             {
                 const auto & row_key   = row_pair.first;
                 const auto & row_value = row_pair.second;
-                if (m_storage[entry_key][row_key] != row_value)
+                auto & stored_value = it->second[row_key];
+                if (stored_value != row_value)
                 {
-                    is_changed = true;
-                    break;
+                    stored_value = row_value;
+                    changes[entry_key].emplace(row_pair);
                 }
             }
-
-            if (is_changed)
-            {
-                m_storage.erase(entry_key);
-                m_storage.emplace(entry_pair);
-                to_update.emplace_back(entry_key);
-            }
         }
     }
 
-    return to_update;
+    return changes;
 }
 
 ///
-/// Update values in the db with values from the temporary storage
-/// @param storage a reference to the temporary storage
-/// @param keys_to_refresh a list of keys which must be refreshed in the db
+/// Update the changed values in the db
+/// @param changes a reference to the changed values of every key
 ///
-void ValuesStore::update_db(const HashOfRecords & storage, const std::vector<std::string> & keys_to_refresh)
+void ValuesStore::update_db(const HashOfRecords & changes)
 {
-    for (const auto & key: keys_to_refresh)
+    for (const auto & entry_pair: changes)
     {
         std::vector<swss::FieldValueTuple> fvp;
-        for (const auto & row_pair: storage.at(key))
+        for (const auto & row_pair: entry_pair.second)
         {
             fvp.emplace_back(row_pair);
         }
-        const auto & table_pair = split_key(key);
-        swss::Table table(m_db, table_pair.first);
-        table.set(table_pair.second, fvp);
+        const auto & table_pair = split_key(entry_pair.first);
+        get_table(table_pair.first).set(table_pair.second, fvp);
     }
 }
 
@@ -372,12 +416,16 @@ void ValuesStore::update(const std::vector<StringPair> & dumps)
 {
     try
     {
-        const auto & storage = from_json(dumps);
-        const auto & old_keys = get_old_keys(storage);
+        DumpHashes hashes;
+        std::unordered_set<std::string> unchanged_lags;
+        const auto & storage = from_json(dumps, hashes, unchanged_lags);
+        const auto & old_keys = get_old_keys(storage, unchanged_lags);
         remove_keys_db(old_keys);
         remove_keys_storage(old_keys);
-        const auto & keys_to_refresh = update_storage(storage);
-        update_db(storage, keys_to_refresh);
+        const auto & changes = update_storage(storage);
+        update_db(changes);
+        m_pipeline.flush();
+        m_dump_hashes = std::move(hashes);
     }
     catch (const std::exception & e)
     {
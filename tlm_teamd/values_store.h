@@ -2,19 +2,25 @@
 
 #include <string>
 #include <vector>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <jansson.h>
 
 #include <dbconnector.h>
+#include <redispipeline.h>
+#include <table.h>
 
 using StringPair = std::pair<std::string, std::string>;
 using Records = std::unordered_map<std::string, std::string>;
 using HashOfRecords = std::unordered_map<std::string, Records>;
+using DumpHashes = std::unordered_map<std::string, size_t>;
 
 class ValuesStore
 {
 public:
-    ValuesStore(const swss::DBConnector * db) : m_db(db) {};
+    ValuesStore(const swss::DBConnector * db) : m_db(db), m_pipeline(db) {};
     void update(const std::vector<StringPair> & dumps);
 
 private:
@@ -33,17 +39,24 @@ private:
     std::string unpack_boolean(json_t * root, const std::string & key, const std::string & path);
     std::string unpack_integer(json_t * root, const std::string & key, const std::string & path);
     std::string get_value(json_t * root, const std::string & path, ValuesStore::json_type type);
-    HashOfRecords from_json(const std::vector<StringPair> & dumps);
-    std::vector<std::string> get_old_keys(const HashOfRecords & storage);
+    HashOfRecords from_json(const std::vector<StringPair> & dumps, DumpHashes & hashes,
+                            std::unordered_set<std::string> & unchanged_lags);
+    std::vector<std::string> get_old_keys(const HashOfRecords & storage,
+                                          const std::unordered_set<std::string> & unchanged_lags);
     void remove_keys_storage(const std::vector<std::string> & keys);
     void remove_keys_db(const std::vector<std::string> & keys);
     StringPair split_key(const std::string & key);
-    std::vector<std::string> update_storage(const HashOfRecords & storage);
-    void update_db(const HashOfRecords & storage, const std::vector<std::string> & keys_to_refresh);
+    std::string get_lag_name(const std::string & key);
+    HashOfRecords update_storage(const HashOfRecords & storage);
+    void update_db(const HashOfRecords & changes);
+    swss::Table & get_table(const std::string & table_name);
     void extract_values(const std::string & lag_name, json_t * root, HashOfRecords & storage);
 
     HashOfRecords m_storage;  // our main storage
+    DumpHashes m_dump_hashes; // hash of the last parsed dump of every LAG
     const swss::DBConnector * m_db;
+    swss::RedisPipeline m_pipeline;
+    std::unordered_map<std::string, std::unique_ptr<swss::Table>> m_tables;
 
     const std::vector<std::pair<std::string, ValuesStore::json_type>> m_lag_paths = {
         { "setup.kernel_team_mode_name", ValuesStore::json_type::string  },
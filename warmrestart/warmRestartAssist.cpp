@@ -8,15 +8,6 @@
 using namespace std;
 using namespace swss;
 
-// Translation map from enum to string for cache entry state.
-const AppRestartAssist::cache_state_map AppRestartAssist::cacheStateMap =
-{
-    {STALE,     "STALE"},
-    {SAME,      "SAME"},
-    {NEW,       "NEW"},
-    {DELETE,    "DELETE"}
-};
-
 AppRestartAssist::AppRestartAssist(RedisPipeline *pipelineAppDB, const std::string &appName,
                                    const std::string &dockerName, const uint32_t defaultWarmStartTimerValue):
     m_pipeLine(pipelineAppDB),
@@ -97,24 +88,74 @@ string AppRestartAssist::joinVectorString(const vector<FieldValueTuple> &fv)
     return s;
 }
 
-// Set the cache entry state
-void AppRestartAssist::setCacheEntryState(std::vector<FieldValueTuple> &fvVector,
-    cache_state_t state)
+static void appendVarint(string &out, size_t value)
 {
-    fvVector.back().second = cacheStateMap.at(state);
+    while (value >= 0x80)
+    {
+        out += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+static size_t readVarint(const string &in, size_t &pos)
+{
+    size_t value = 0;
+    for (unsigned shift = 0; pos < in.size(); shift += 7)
+    {
+        auto byte = static_cast<unsigned char>(in[pos++]);
+        value |= static_cast<size_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+        {
+            break;
+        }
+    }
+    return value;
+}
+
+/*
+ * Pack the field/value pairs into <field id><value length><value>..., with
+ * varint encoded ids and lengths. The field names are interned, an entry
+ * costs its values plus a few bytes per field.
+ */
+string AppRestartAssist::packFieldValues(const vector<FieldValueTuple> &fvVector)
+{
+    string packed;
+    for (const auto &fv : fvVector)
+    {
+        auto id = m_fieldIds.emplace(fvField(fv), static_cast<uint32_t>(m_fieldNames.size()));
+        if (id.second)
+        {
+            m_fieldNames.push_back(fvField(fv));
+        }
+
+        appendVarint(packed, id.first->second);
+        appendVarint(packed, fvValue(fv).size());
+        packed += fvValue(fv);
+    }
+
+    // Entries are only appended, keep the capacity down to the content
+    packed.shrink_to_fit();
+    return packed;
 }
 
-// Get the cache entry state
-AppRestartAssist::cache_state_t AppRestartAssist::getCacheEntryState(const std::vector<FieldValueTuple> &fvVector)
+vector<FieldValueTuple> AppRestartAssist::unpackFieldValues(const string &packed) const
 {
-    for (auto &iter : cacheStateMap)
+    vector<FieldValueTuple> fvVector;
+    size_t pos = 0;
+    while (pos < packed.size())
     {
-        if (fvVector.back().second == iter.second)
+        size_t id = readVarint(packed, pos);
+        size_t len = readVarint(packed, pos);
+        if (id >= m_fieldNames.size() || len > packed.size() - pos)
         {
-            return iter.first;
+            throw std::logic_error("cache entry is corrupted");
         }
+
+        fvVector.emplace_back(m_fieldNames[id], packed.substr(pos, len));
+        pos += len;
     }
-    throw std::logic_error("cache entry state is invalid");
+    return fvVector;
 }
 
 void AppRestartAssist::appDataReplayed()
@@ -127,7 +168,7 @@ void AppRestartAssist::warmStartDisabled()
     WarmStart::setWarmStartState(m_appName, WarmStart::WSDISABLED);
 }
 
-// Read table(s) from APPDB and append stale flag then insert to cachemap
+// Read table(s) from APPDB and insert to cachemap with stale flag
 void AppRestartAssist::readTablesToMap()
 {
     vector<string> keys;
@@ -135,7 +176,8 @@ void AppRestartAssist::readTablesToMap()
     for (auto it = m_appTables.begin(); it != m_appTables.end(); it++)
     {
         (it->second)->getKeys(keys);
-        FieldValueTuple state(CACHE_STATE_FIELD, "");
+        auto &cache = appTableCacheMap[it->first];
+        cache.reserve(cache.size() + keys.size());
 
         for (const auto &key: keys)
         {
@@ -147,16 +189,11 @@ void AppRestartAssist::readTablesToMap()
                 continue;
             }
 
-            fv.push_back(state);
-            setCacheEntryState(fv, STALE);
-
-            string s = joinVectorString(fv);
-
             SWSS_LOG_INFO("write to cachemap: %s, key: %s, "
-                   "%s", (it->first).c_str(), key.c_str(), s.c_str());
+                   "%s", (it->first).c_str(), key.c_str(), joinVectorString(fv).c_str());
 
             // insert to the cache map
-            appTableCacheMap[it->first][key] = fv;
+            cache[key] = { packFieldValues(fv), STALE };
         }
         WarmStart::setWarmStartState(m_appName, WarmStart::RESTORED);
         SWSS_LOG_NOTICE("Restored appDB table to %s internal cache map", (it->first).c_str());
@@ -181,34 +218,30 @@ void AppRestartAssist::insertToMap(string tableName, string key, vector<FieldVal
     SWSS_LOG_INFO("Received message %s, key: %s, "
             "%s, delete = %d", tableName.c_str(), key.c_str(), joinVectorString(fvVector).c_str(), delete_key);
 
-    auto found = appTableCacheMap[tableName].find(key);
+    auto &cache = appTableCacheMap[tableName];
+    auto found = cache.find(key);
 
     if (delete_key)
     {
         SWSS_LOG_NOTICE("%s, delete key: %s, ", tableName.c_str(), key.c_str());
         /* mark it as DELETE if exist, otherwise, no-op */
-        if (found != appTableCacheMap[tableName].end())
+        if (found != cache.end())
         {
-            setCacheEntryState(found->second, DELETE);
+            found->second.state = DELETE;
         }
     }
-    else if (found != appTableCacheMap[tableName].end())
+    else if (found != cache.end())
     {
-        // check only the original vector range (exclude cache-state field/value)
-        if(! contains(found->second, fvVector))
+        if(! contains(unpackFieldValues(found->second.fieldValues), fvVector))
         {
             SWSS_LOG_NOTICE("%s, found key: %s, new value ", tableName.c_str(), key.c_str());
 
-            FieldValueTuple state(CACHE_STATE_FIELD, "");
-            fvVector.push_back(state);
-
             // mark as NEW flag
-            setCacheEntryState(fvVector, NEW);
-            appTableCacheMap[tableName][key] = fvVector;
+            found->second = { packFieldValues(fvVector), NEW };
         }
         else
         {
-            auto state = getCacheEntryState(found->second);
+            auto state = found->second.state;
             /*
              * In case an entry has been updated for more than once with the same value but different from the stored one,
              * keep the state as NEW.
@@ -231,7 +264,7 @@ void AppRestartAssist::insertToMap(string tableName, string key, vector<FieldVal
             {
                 SWSS_LOG_INFO("%s, found key: %s, same value", tableName.c_str(), key.c_str());
                 // mark as SAME flag
-                setCacheEntryState(found->second, SAME);
+                found->second.state = SAME;
             }
         }
     }
@@ -239,10 +272,7 @@ void AppRestartAssist::insertToMap(string tableName, string key, vector<FieldVal
     {
         // not found, mark the entry as NEW and insert to map
         SWSS_LOG_NOTICE("%s, not found key: %s, new", tableName.c_str(), key.c_str());
-        FieldValueTuple state(CACHE_STATE_FIELD, "");
-        fvVector.push_back(state);
-        setCacheEntryState(fvVector, NEW);
-        appTableCacheMap[tableName][key] = fvVector;
+        cache[key] = { packFieldValues(fvVector), NEW };
     }
     return;
 }
@@ -254,6 +284,7 @@ void AppRestartAssist::insertToMap(string tableName, string key, vector<FieldVal
  *  if has "STALE/DELETE" flag, delete it from appDB.
  *  else if "NEW" flag,  add it to appDB
  *  else, throw (should never happen)
+ * The writes are batched, RECONCILE_BATCH_SIZE entries per producer state table call.
  */
 void AppRestartAssist::reconcile()
 {
@@ -263,10 +294,34 @@ void AppRestartAssist::reconcile()
     for (auto tableIter = appTableCacheMap.begin(); tableIter != appTableCacheMap.end(); ++tableIter)
     {
         tableName = tableIter->first;
-        for (auto it = (tableIter->second).begin(); it != (tableIter->second).end(); ++it)
+        auto psTable = m_psTables[tableName];
+        auto &cache = tableIter->second;
+
+        vector<string> delKeys;
+        vector<KeyOpFieldsValuesTuple> setEntries;
+        auto flushDel = [&]()
+        {
+            if (!delKeys.empty())
+            {
+                psTable->del(delKeys);
+                delKeys.clear();
+            }
+        };
+        auto flushSet = [&]()
+        {
+            if (!setEntries.empty())
+            {
+                psTable->set(setEntries);
+                setEntries.clear();
+            }
+        };
+
+        // Entries are erased as they are handled, the cache shrinks while the writes go out
+        for (auto it = cache.begin(); it != cache.end(); it = cache.erase(it))
         {
-            string s = joinVectorString(it->second);
-            auto state = getCacheEntryState(it->second);
+            auto state = it->second.state;
+            auto fvVector = unpackFieldValues(it->second.fieldValues);
+            string s = joinVectorString(fvVector);
 
             if (state == SAME)
             {
@@ -280,26 +335,35 @@ void AppRestartAssist::reconcile()
                         tableName.c_str(), it->first.c_str(), s.c_str());
 
                 //delete from appDB
-                m_psTables[tableName]->del(it->first);
+                delKeys.push_back(it->first);
+                if (delKeys.size() >= RECONCILE_BATCH_SIZE)
+                {
+                    flushDel();
+                }
             }
             else if (state == NEW)
             {
                 SWSS_LOG_NOTICE("%s NEW, key: %s, %s",
                         tableName.c_str(), it->first.c_str(), s.c_str());
 
-                //add to appDB, exclude the state
-                it->second.pop_back();
-                m_psTables[tableName]->set(it->first, it->second);
+                //add to appDB
+                setEntries.emplace_back(it->first, SET_COMMAND, std::move(fvVector));
+                if (setEntries.size() >= RECONCILE_BATCH_SIZE)
+                {
+                    flushSet();
+                }
             }
             else
             {
                 throw std::logic_error("cache entry state is invalid");
             }
         }
-        // reconcile finished, clear the map, mark the warmstart state
-        appTableCacheMap[tableName].clear();
+        flushDel();
+        flushSet();
     }
     appTableCacheMap.clear();
+    m_fieldIds.clear();
+    m_fieldNames.clear();
     WarmStart::setWarmStartState(m_appName, WarmStart::RECONCILED);
     m_warmStartInProgress = false;
     return;
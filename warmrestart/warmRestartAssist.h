@@ -91,22 +91,36 @@ public:
     void registerAppTable(const std::string &tableName, ProducerStateTable *psTable);
 
 private:
-    typedef std::map<cache_state_t, std::string> cache_state_map;
-    // Enum to string translation map
-    static const cache_state_map cacheStateMap;
-    const std::string CACHE_STATE_FIELD = "cache-state";
-
     /*
      * Default timer to be 5 seconds
      * Overwritten by application loading this class and configurations in configDB
      * Precedence ascent order: Default -> loading class with value -> configuration
      */
     static const uint32_t DEFAULT_INTERNAL_TIMER_VALUE = 5;
-    typedef std::map<std::string, std::unordered_map<std::string, std::vector<swss::FieldValueTuple>>> AppTableMap;
+
+    // Entries written to a producer state table at once by reconcile()
+    static const size_t RECONCILE_BATCH_SIZE = 1024;
+
+    /*
+     * A cached entry keeps its field/value pairs packed into a single string,
+     * with the field names interned, see packFieldValues(). Large tables are
+     * cached while the application replays them, a vector of string pairs
+     * per entry would take several times the size of the data.
+     */
+    struct CacheEntry
+    {
+        std::string fieldValues;
+        cache_state_t state;
+    };
+    typedef std::map<std::string, std::unordered_map<std::string, CacheEntry>> AppTableMap;
 
     // cache map to store temporary application table
     AppTableMap appTableCacheMap;
 
+    // Interned field names of the cached entries, indexed by field id
+    std::unordered_map<std::string, uint32_t> m_fieldIds;
+    std::vector<std::string> m_fieldNames;
+
     RedisPipeline      *m_pipeLine;
     Tables              m_appTables;  // app tables
     std::string         m_dockerName; // docker name of the application
@@ -117,10 +131,9 @@ private:
     time_t m_reconcileTimer;          // reconcile timer value
     SelectableTimer m_warmStartTimer; // reconcile timer
 
-    // Set or get cache entry state
     std::string joinVectorString(const std::vector<FieldValueTuple> &fv);
-    void setCacheEntryState(std::vector<FieldValueTuple> &fvVector, cache_state_t state);
-    cache_state_t getCacheEntryState(const std::vector<FieldValueTuple> &fvVector);
+    std::string packFieldValues(const std::vector<FieldValueTuple> &fvVector);
+    std::vector<FieldValueTuple> unpackFieldValues(const std::string &packed) const;
     bool contains(const std::vector<FieldValueTuple>& left,
                   const std::vector<FieldValueTuple>& right);
 };
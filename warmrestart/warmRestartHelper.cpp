@@ -65,7 +65,7 @@ bool WarmStartHelper::checkAndStart(void)
     }
 
     /* Cleaning state from previous (unsuccessful) warm-restart attempts */
-    m_restorationVector.clear();
+    m_restorationMap.clear();
     m_refreshMap.clear();
 
     /* Keeping track of warm-reboot active/inactive state */
@@ -98,19 +98,37 @@ uint32_t WarmStartHelper::getRestartTimer(void) const
  * are expected to call this method to upload their associated redisDB state into
  * a temporary buffer, which will eventually serve to resolve any conflict between
  * 'old' and 'new' state.
+ *
+ * Only a digest of each element is kept, holding the full field-value tuples of
+ * millions of routes would take GBs during the restart.
  */
 bool WarmStartHelper::runRestoration()
 {
     SWSS_LOG_NOTICE("Warm-Restart: Initiating AppDB restoration process for %s "
                     "application.", m_appName.c_str());
 
-    m_restorationTable.getContent(m_restorationVector);
+    std::vector<std::string> keys;
+    m_restorationTable.getKeys(keys);
+
+    m_restorationMap.clear();
+    m_restorationMap.reserve(keys.size());
+
+    std::vector<FieldValueTuple> fv;
+    for (const auto &key : keys)
+    {
+        fv.clear();
+        if (!m_restorationTable.get(key, fv))
+        {
+            continue;
+        }
+        m_restorationMap[key] = RestoredEntry{digestFV(fv), false};
+    }
 
     /*
      * If there's no AppDB state to restore, then alert callee right away to avoid
      * iterating through the 'reconciliation' process.
      */
-    if (!m_restorationVector.size())
+    if (!m_restorationMap.size())
     {
         SWSS_LOG_NOTICE("Warm-Restart: No records received from AppDB for %s "
                         "application.", m_appName.c_str());
@@ -122,7 +140,7 @@ bool WarmStartHelper::runRestoration()
 
     SWSS_LOG_NOTICE("Warm-Restart: Received %zu records from AppDB for %s "
                     "application.",
-                    m_restorationVector.size(),
+                    m_restorationMap.size(),
                     m_appName.c_str());
 
     setState(WarmStart::RESTORED);
@@ -134,10 +152,24 @@ bool WarmStartHelper::runRestoration()
 }
 
 
+/*
+ * A refreshed element matching its restored counterpart needs no reconciliation,
+ * it is only flagged as such and not stored.
+ */
 void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
 {
     const std::string key = kfvKey(kfv);
 
+    auto restored = m_restorationMap.find(key);
+    if (restored != m_restorationMap.end() &&
+        kfvOp(kfv) != DEL_COMMAND &&
+        digestFV(kfvFieldsValues(kfv)) == restored->second.digest)
+    {
+        restored->second.refreshed = true;
+        m_refreshMap.erase(key);
+        return;
+    }
+
     m_refreshMap[key] = kfv;
 }
 
@@ -148,6 +180,8 @@ void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
  * generated by the application once it completes its restart cycle. If a
  * state-diff is found between these two, we will be honoring the refreshed
  * one received from the application, and will proceed to push it down to AppDB.
+ *
+ * The diffs are pushed in batches of RECONCILE_BATCH_SIZE elements.
  */
 void WarmStartHelper::reconcile(void)
 {
@@ -156,24 +190,50 @@ void WarmStartHelper::reconcile(void)
 
     assert(getState() == WarmStart::RESTORED);
 
-    for (auto &restoredElem : m_restorationVector)
+    std::vector<std::string>            delBatch;
+    std::vector<KeyOpFieldsValuesTuple> setBatch;
+    size_t deleted = 0, updated = 0, unchanged = 0, added = 0;
+
+    auto flushBatches = [&](bool force)
     {
-        std::string restoredKey  = kfvKey(restoredElem);
-        auto restoredFV          = kfvFieldsValues(restoredElem);
+        if (!delBatch.empty() && (force || delBatch.size() >= RECONCILE_BATCH_SIZE))
+        {
+            m_syncTable->del(delBatch);
+            delBatch.clear();
+        }
+        if (!setBatch.empty() && (force || setBatch.size() >= RECONCILE_BATCH_SIZE))
+        {
+            m_syncTable->set(setBatch);
+            setBatch.clear();
+        }
+    };
+
+    for (auto &restoredElem : m_restorationMap)
+    {
+        const std::string &restoredKey = restoredElem.first;
 
         auto iter = m_refreshMap.find(restoredKey);
 
         /*
-         * If the restored element is not found in the refreshMap, we must
-         * push a delete operation for this entry.
+         * If the restored element is not found in the refreshMap, it was either
+         * refreshed with the same content, or we must push a delete operation
+         * for this entry.
          */
         if (iter == m_refreshMap.end())
         {
+            if (restoredElem.second.refreshed)
+            {
+                SWSS_LOG_INFO("Warm-Restart reconciliation: no changes needed for "
+                              "existing entry %s", restoredKey.c_str());
+                unchanged++;
+                continue;
+            }
+
             SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
+                            restoredKey.c_str());
 
-            m_syncTable->del(restoredKey);
-            continue;
+            delBatch.push_back(restoredKey);
+            deleted++;
         }
 
         /*
@@ -183,9 +243,11 @@ void WarmStartHelper::reconcile(void)
         else if (kfvOp(iter->second) == DEL_COMMAND)
         {
             SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
+                            restoredKey.c_str());
 
-            m_syncTable->del(restoredKey);
+            delBatch.push_back(restoredKey);
+            deleted++;
+            m_refreshMap.erase(iter);
         }
 
         /*
@@ -194,26 +256,29 @@ void WarmStartHelper::reconcile(void)
          */
         else
         {
-            auto refreshedKey = kfvKey(iter->second);
-            auto refreshedFV  = kfvFieldsValues(iter->second);
+            auto &refreshedFV = kfvFieldsValues(iter->second);
 
-            if (compareAllFV(restoredFV, refreshedFV))
+            if (digestFV(refreshedFV) != restoredElem.second.digest)
             {
                 SWSS_LOG_NOTICE("Warm-Restart reconciliation: updating entry %s",
-                                printKFV(refreshedKey, refreshedFV).c_str());
+                                printKFV(restoredKey, refreshedFV).c_str());
 
-                m_syncTable->set(refreshedKey, refreshedFV);
+                setBatch.emplace_back(restoredKey, SET_COMMAND, std::move(refreshedFV));
+                updated++;
             }
             else
             {
                 SWSS_LOG_INFO("Warm-Restart reconciliation: no changes needed for "
                               "existing entry %s",
-                              printKFV(refreshedKey, refreshedFV).c_str());
+                              printKFV(restoredKey, refreshedFV).c_str());
+                unchanged++;
             }
+
+            /* Deleting the just-processed restored entry from the refreshMap */
+            m_refreshMap.erase(iter);
         }
 
-        /* Deleting the just-processed restored entry from the refreshMap */
-        m_refreshMap.erase(restoredKey);
+        flushBatches(false);
     }
 
     /*
@@ -222,9 +287,9 @@ void WarmStartHelper::reconcile(void)
      */
     for (auto &kfv : m_refreshMap)
     {
-        auto refreshedKey = kfvKey(kfv.second);
-        auto refreshedOp  = kfvOp(kfv.second);
-        auto refreshedFV  = kfvFieldsValues(kfv.second);
+        auto &refreshedKey = kfvKey(kfv.second);
+        auto &refreshedOp  = kfvOp(kfv.second);
+        auto &refreshedFV  = kfvFieldsValues(kfv.second);
 
         /*
          * During warm-reboot, apps could receive an 'add' and a 'delete' for an
@@ -243,107 +308,79 @@ void WarmStartHelper::reconcile(void)
             SWSS_LOG_NOTICE("Warm-Restart reconciliation: introducing new entry %s",
                             printKFV(refreshedKey, refreshedFV).c_str());
 
-            m_syncTable->set(refreshedKey, refreshedFV);
+            setBatch.emplace_back(refreshedKey, SET_COMMAND, std::move(refreshedFV));
+            added++;
+            flushBatches(false);
         }
     }
 
+    flushBatches(true);
+
     /* Clearing pending kfv's from refreshMap */
     m_refreshMap.clear();
 
-    /* Clearing restoration vector */
-    m_restorationVector.clear();
+    /* Clearing restoration map */
+    m_restorationMap.clear();
 
     setState(WarmStart::RECONCILED);
 
     SWSS_LOG_NOTICE("Warm-Restart: Concluded reconciliation process for %s "
-                    "application.", m_appName.c_str());
+                    "application: %zu deleted, %zu updated, %zu unchanged, "
+                    "%zu new entries.", m_appName.c_str(),
+                    deleted, updated, unchanged, added);
 }
 
 
-/*
- * Compare all field-value-tuples within two vectors.
- *
- * Example: v1 {nexthop: 10.1.1.1, ifname: eth1}
- *          v2 {nexthop: 10.1.1.2, ifname: eth2, protocol: kernel, weight: 1}
- *
- * Returns:
- *
- *    'false' : If the content of both 'fields' and 'values' fully match
- *    'true'  : No full-match is found
- */
-bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &v1,
-                                   const std::vector<FieldValueTuple> &v2)
+static inline uint64_t mixDigest(uint64_t x)
 {
-    /* Size mismatch implies a diff */
-    if (v1.size() != v2.size())
-    {
-        return true;
-    }
-
-    std::unordered_map<std::string, std::string> v1Map((v1.begin()), v1.end());
-
-     /* Iterate though all v2 tuples to check if their content match v1 ones */
-    for (auto &v2fv : v2)
-    {
-        auto v1Iter = v1Map.find(v2fv.first);
-
-        /* Return true when v2 has a new field */
-        if (v1Iter == v1Map.end())
-        {
-            return true;
-        }
-
-        if (compareOneFV(v1Map[fvField(*v1Iter)], fvValue(v2fv)))
-        {
-            return true;
-        }
-    }
-
-    return false;
+    /* splitmix64 finalizer, spreads the bits before the digests get summed */
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
 }
 
 
 /*
- * Compare the values of a single field-value within two different KFVs.
- *
- * Example: s1 {nexthop: 10.1.1.1, 10.1.1.2}
- *          s2 {nexthop: 10.1.1.2, 10.1.1.1}
+ * Digest of field-value-tuples, equal for two vectors holding the same fields
+ * and values regardless of the order of the fields, or of the elements of the
+ * comma separated values.
  *
- * Example: s1 {Ethernet1, Ethernet2}
- *          s2 {Ethernet2, Ethernet1}
+ * Example: v1 {nexthop: 10.1.1.1,10.1.1.2 | ifname: eth1,eth2}
+ *          v2 {ifname: eth2,eth1 | nexthop: 10.1.1.2,10.1.1.1}
  *
- * Returns:
- *
- *    'false' : If the content of both strings fully matches
- *    'true'  : No full-match is found
+ * Both have the same digest. The element digests are summed, so that their
+ * order does not matter.
  */
-bool WarmStartHelper::compareOneFV(const std::string &s1, const std::string &s2)
+uint64_t WarmStartHelper::digestFV(const std::vector<FieldValueTuple> &fv)
 {
-    if (s1.size() != s2.size())
-    {
-        return true;
-    }
+    std::hash<std::string> hasher;
+    uint64_t digest = mixDigest(fv.size());
 
-    std::vector<std::string> splitValuesS1 = tokenize(s1, ',');
-    std::vector<std::string> splitValuesS2 = tokenize(s2, ',');
-
-    if (splitValuesS1.size() != splitValuesS2.size())
+    for (const auto &fieldValue : fv)
     {
-        return true;
-    }
+        const std::string &value = fvValue(fieldValue);
+        uint64_t valueDigest = mixDigest(value.size());
 
-    std::sort(splitValuesS1.begin(), splitValuesS1.end());
-    std::sort(splitValuesS2.begin(), splitValuesS2.end());
-
-    for (size_t i = 0; i < splitValuesS1.size(); i++)
-    {
-        if (splitValuesS1[i] != splitValuesS2[i])
+        /* Same elements as tokenize(value, ',') */
+        size_t begin = 0;
+        while (begin < value.size())
         {
-            return true;
+            size_t end = value.find(',', begin);
+            if (end == std::string::npos)
+            {
+                end = value.size();
+            }
+            valueDigest += mixDigest(hasher(value.substr(begin, end - begin)));
+            begin = end + 1;
         }
+
+        digest += mixDigest(hasher(fvField(fieldValue)) ^ mixDigest(valueDigest));
     }
 
-    return false;
+    return digest;
 }
 
 
@@ -38,6 +38,9 @@ class WarmStartHelper {
      */
     using kfvMap = std::unordered_map<std::string, KeyOpFieldsValuesTuple>;
 
+    /* Max number of entries pushed to the sync table in one batch when reconciling */
+    static const size_t RECONCILE_BATCH_SIZE = 1024;
+
     void setState(WarmStart::WarmStartState state);
 
     WarmStart::WarmStartState getState(void) const;
@@ -61,14 +64,19 @@ class WarmStartHelper {
 
   private:
 
-    bool compareAllFV(const std::vector<FieldValueTuple> &left,
-                      const std::vector<FieldValueTuple> &right);
+    /* Restored element, reduced to a digest of its field-value tuples */
+    struct RestoredEntry
+    {
+        uint64_t digest;
+        bool     refreshed;    // refreshed with the same content, not kept in m_refreshMap
+    };
 
-    bool compareOneFV(const std::string &v1, const std::string &v2);
+    static uint64_t digestFV(const std::vector<FieldValueTuple> &fv);
 
     ProducerStateTable       *m_syncTable;         // producer-table to sync/push state to
     Table                     m_restorationTable;  // redis table to import current-state from
-    kfvVector                 m_restorationVector; // buffer struct to hold old state
+    std::unordered_map<std::string, RestoredEntry>
+                              m_restorationMap;    // buffer struct to hold old state digests
     kfvMap                    m_refreshMap;        // buffer struct to hold new state
     WarmStart::WarmStartState m_state;             // cached value of warmStart's FSM state
     bool                      m_enabled;           // warm-reboot enabled/disabled status